@@ -23,7 +23,7 @@ public class ISMRuntimeAnimation : ModuleRules
         PrivateDependencyModuleNames.AddRange(
             new string[]
             {
-
+                "ISMRuntimePhysics",
             }
         );
     }
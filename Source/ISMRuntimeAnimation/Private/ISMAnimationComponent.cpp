@@ -1,14 +1,37 @@
 #include "ISMAnimationComponent.h"
+#include "ISMRuntimeAnimation.h"
 #include "ISMAnimationDataAsset.h"
 #include "ISMRuntimeComponent.h"
 #include "ISMAnimationTransformer.h"
+#include "ISMWindFieldSubsystem.h"
+#include "ISMAnimationSubsystem.h"
+#include "ISMPhysicsComponent.h"
 #include "Logging/LogMacros.h"
 #include "ISMRuntimeSubsystem.h"
+#include "Settings/ISMRuntimeSettings.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "Batching/ISMBatchScheduler.h"
 
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "Engine/World.h"
+
+namespace
+{
+	FName MaterialParameterName(FName Prefix, const TCHAR* Suffix)
+	{
+		return FName(*FString::Printf(TEXT("%s_%s"), *Prefix.ToString(), Suffix));
+	}
+
+	FName MaterialLayerParameterName(FName Prefix, int32 LayerIndex, const TCHAR* Suffix)
+	{
+		return FName(*FString::Printf(TEXT("%s_Layer%d_%s"), *Prefix.ToString(), LayerIndex, Suffix));
+	}
+}
 
 UISMAnimationComponent::UISMAnimationComponent()
 {
@@ -40,6 +63,14 @@ void UISMAnimationComponent::BeginPlay()
 		return;
 	}
 
+	// Sway is visual only: a headless server keeps the authored transforms and never ticks us
+	const UISMRuntimeSettings* RuntimeSettings = GetDefault<UISMRuntimeSettings>();
+	if (RuntimeSettings && RuntimeSettings->IsHeadless(GetWorld()))
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
 	UISMRuntimeSubsystem* RuntimeSubsystem = GetWorld()->GetSubsystem<UISMRuntimeSubsystem>();
 	if(!RuntimeSubsystem)
 	{
@@ -51,6 +82,15 @@ void UISMAnimationComponent::BeginPlay()
 	CachedScheduler = RuntimeSubsystem->GetOrCreateBatchSchduler();
 	bWaitingForRuntimeComponent = true;
 
+	if (bUseWindField)
+	{
+		if (UISMWindFieldSubsystem* WindField = GetWorld()->GetSubsystem<UISMWindFieldSubsystem>())
+		{
+			WindField->RegisterConsumer();
+			CachedWindField = WindField;
+		}
+	}
+
 	RuntimeSubsystem->RequestRuntimeComponent(TargetISM, [this](UISMRuntimeComponent* Comp) {
 		OnRuntimeComponentReady(Comp);
 		UE_LOG(LogISMRuntimeAnimation, Log, TEXT("UISMAnimationComponent on actor %s received runtime component for ISM %s."), *GetOwner()->GetName(), *TargetISM->GetName());
@@ -63,25 +103,56 @@ void UISMAnimationComponent::EndPlay(const EEndPlayReason::Type EndReason)
    // tick a dangling pointer.
 	if (Transformer.IsValid())
 	{
-		if (UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get())
+		if (UISMAnimationSubsystem* AnimationSubsystem = CachedAnimationSubsystem.Get())
+		{
+			// The subsystem unregisters it once the last sharing component is gone
+			AnimationSubsystem->ReleaseSharedTransformer(AnimationData, this);
+		}
+		else if (UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get())
 		{
 			Scheduler->UnregisterTransformer(Transformer->GetTransformerName());
 		}
 		Transformer.Reset();
 	}
+	CachedAnimationSubsystem.Reset();
+	SharedTarget.Reset();
 
+	ReleaseWindField();
+	MaterialTarget.Reset();
 	bWaitingForRuntimeComponent = false;
 	Super::EndPlay(EndReason);
 }
 
 void UISMAnimationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	LLM_SCOPE_BYTAG(ISMRuntime_Animation);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	
-	if (bWaitingForRuntimeComponent || !Transformer.IsValid() || bAnimationPaused) 
+	if (bWaitingForRuntimeComponent || !Transformer.IsValid()) 
+		return;
+
+	// One component feeds a shared transformer for everyone, paused or not
+	if (UISMAnimationSubsystem* AnimationSubsystem = CachedAnimationSubsystem.Get())
+	{
+		if (!AnimationSubsystem->IsSharedTransformerDriver(AnimationData, this))
+			return;
+	}
+	else if (bAnimationPaused)
+	{
 		return;
+	}
 
-	Transformer->UpdateFrameParams(BuildFrameParams(DeltaTime));
+	const FISMAnimationFrameParams Params = BuildFrameParams(DeltaTime);
+	Transformer->UpdateFrameParams(Params);
+	if (UISMWindFieldSubsystem* WindField = CachedWindField.Get())
+	{
+		Transformer->UpdateWindField(WindField->GetSnapshot());
+	}
+	if (AnimationData && AnimationData->Reaction.bEnabled)
+	{
+		Transformer->UpdateInfluencers(CollectInfluencers(Params.ReferenceLocation));
+	}
 }
 
 
@@ -93,12 +164,37 @@ void UISMAnimationComponent::SetWindParams(FVector InWindDirection, float InWind
 	}
 	WindDirection = InWindDirection.GetSafeNormal();
 	WindStrength = FMath::Max(0.0f, InWindStrength);
-	
+
+	if (MaterialTarget.IsValid())
+	{
+		PushMaterialWind();
+	}
 }
 
 void UISMAnimationComponent::SetAnimationPaused(bool bPaused)
 {
 	bAnimationPaused = bPaused;
+
+	// The material samples its own clock, so pausing drops to the rest pose instead of holding
+	if (MaterialTarget.IsValid())
+	{
+		PushMaterialParameters();
+		return;
+	}
+
+	// A shared transformer keeps running for the other components; just drop this one's target
+	if (Transformer.IsValid() && SharedTarget.IsValid())
+	{
+		if (bAnimationPaused)
+		{
+			Transformer->RemoveTarget(SharedTarget.Get());
+		}
+		else
+		{
+			Transformer->AddTarget(SharedTarget.Get());
+		}
+	}
+
 	// When un-pausing, mark the transformer dirty immediately so it picks up
 	// on the very next scheduler tick rather than waiting for the next natural dirty cycle.
 	if (!bAnimationPaused && Transformer.IsValid())
@@ -133,6 +229,20 @@ void UISMAnimationComponent::OnRuntimeComponentReady(UISMRuntimeComponent* Runti
 		UE_LOG(LogISMRuntimeAnimation, Warning,TEXT("UISMAnimationComponent on '%s': received null runtime component. Animation will not run."),*GetOwner()->GetName());
 		return;
 	}
+	if (AnimationData && AnimationData->Backend == EISMAnimationBackend::MaterialWPO)
+	{
+		UE_LOG(LogISMRuntimeAnimation, Log, TEXT("UISMAnimationComponent on '%s': runtime component ready, baking material animation."), *GetOwner()->GetName());
+		MaterialTarget = RuntimeComponent;
+		RebakeMaterialAnimation();
+
+		// The material reads one wind vector from its collection; the field is CPU only
+		ReleaseWindField();
+
+		// Nothing left to do per frame
+		SetComponentTickEnabled(false);
+		return;
+	}
+
 	UE_LOG(LogISMRuntimeAnimation, Log, TEXT("UISMAnimationComponent on '%s': runtime component ready, creating transformer."), *GetOwner()->GetName());
 	UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get();
 	if (!Scheduler)
@@ -141,6 +251,27 @@ void UISMAnimationComponent::OnRuntimeComponentReady(UISMRuntimeComponent* Runti
 		return;
 	}
 	
+	if (bShareTransformer)
+	{
+		UISMAnimationSubsystem* AnimationSubsystem = GetWorld()->GetSubsystem<UISMAnimationSubsystem>();
+		Transformer = AnimationSubsystem
+			? AnimationSubsystem->AcquireSharedTransformer(AnimationData, RuntimeComponent, Scheduler, this)
+			: nullptr;
+		if (!Transformer.IsValid())
+		{
+			UE_LOG(LogISMRuntimeAnimation, Warning, TEXT("UISMAnimationComponent on '%s': could not join the shared transformer for %s. Animation will not run."),
+				*GetOwner()->GetName(), *AnimationData->GetName());
+			return;
+		}
+		CachedAnimationSubsystem = AnimationSubsystem;
+		SharedTarget = RuntimeComponent;
+		if (bAnimationPaused)
+		{
+			Transformer->RemoveTarget(RuntimeComponent);
+		}
+		return;
+	}
+
 	Transformer = MakeShared<FISMAnimationTransformer>(RuntimeComponent, AnimationData, AnimationName);
 	if (!Scheduler->RegisterTransformer(Transformer.Get()))
 	{
@@ -184,3 +315,172 @@ FVector UISMAnimationComponent::GetReferenceLocation() const
 	// Last resort: world origin (will disable distance culling effectively)
 	return FVector::ZeroVector;
 }
+
+void UISMAnimationComponent::RebakeMaterialAnimation()
+{
+	UISMRuntimeComponent* RuntimeComponent = MaterialTarget.Get();
+	if (!RuntimeComponent || !AnimationData)
+	{
+		return;
+	}
+
+	BakeMaterialPhases(RuntimeComponent);
+	PushMaterialParameters();
+}
+
+void UISMAnimationComponent::BakeMaterialPhases(UISMRuntimeComponent* RuntimeComponent) const
+{
+	TArray<const FISMAnimationLayer*, TInlineAllocator<UISMAnimationDataAsset::MaxMaterialLayers>> Layers;
+	AnimationData->GetMaterialLayers(Layers);
+
+	const int32 NumLayers = Layers.Num();
+	const int32 NumInstances = RuntimeComponent->GetInstanceCount();
+	if (NumLayers == 0 || NumInstances == 0)
+	{
+		return;
+	}
+
+	const int32 FirstSlot = AnimationData->PhaseCustomDataSlot;
+	RuntimeComponent->SetCustomDataCount(FirstSlot + NumLayers);
+
+	// Same offsets the CPU path computes every frame, computed once
+	TArray<float> Phases;
+	Phases.SetNumUninitialized(NumInstances * NumLayers);
+	for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+	{
+		const FTransform InstanceTransform = RuntimeComponent->GetInstanceTransform(InstanceIndex);
+		for (int32 LayerIndex = 0; LayerIndex < NumLayers; ++LayerIndex)
+		{
+			Phases[InstanceIndex * NumLayers + LayerIndex] =
+				FISMAnimationTransformer::ComputeInstancePhaseOffset(*Layers[LayerIndex], InstanceTransform, InstanceIndex);
+		}
+	}
+
+	RuntimeComponent->WriteInstanceCustomDataRange(0, NumInstances, FirstSlot, NumLayers, Phases);
+}
+
+void UISMAnimationComponent::PushMaterialParameters() const
+{
+	UWorld* World = GetWorld();
+	UMaterialParameterCollectionInstance* Collection = World && AnimationData && AnimationData->MaterialParameters
+		? World->GetParameterCollectionInstance(AnimationData->MaterialParameters)
+		: nullptr;
+	if (!Collection)
+	{
+		UE_LOG(LogISMRuntimeAnimation, Warning, TEXT("UISMAnimationComponent on '%s': material backend has no MaterialParameters collection. Animation will not run."), *GetOwner()->GetName());
+		return;
+	}
+
+	TArray<const FISMAnimationLayer*, TInlineAllocator<UISMAnimationDataAsset::MaxMaterialLayers>> Layers;
+	AnimationData->GetMaterialLayers(Layers);
+
+	const FName Prefix = AnimationData->MaterialParameterPrefix;
+	bool bAllFound = Collection->SetScalarParameterValue(MaterialParameterName(Prefix, TEXT("LayerCount")), bAnimationPaused ? 0.0f : Layers.Num());
+
+	for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); ++LayerIndex)
+	{
+		const FISMAnimationLayer& Layer = *Layers[LayerIndex];
+		const EISMAnimationAxis Axes = static_cast<EISMAnimationAxis>(Layer.ActiveAxes);
+
+		bAllFound &= Collection->SetVectorParameterValue(MaterialLayerParameterName(Prefix, LayerIndex, TEXT("Wave")),
+			FLinearColor(Layer.Amplitude, Layer.Frequency, Layer.PhaseOffset, static_cast<float>(Layer.Waveform)));
+		bAllFound &= Collection->SetVectorParameterValue(MaterialLayerParameterName(Prefix, LayerIndex, TEXT("Axes")),
+			FLinearColor(
+				EnumHasAnyFlags(Axes, EISMAnimationAxis::X) ? 1.0f : 0.0f,
+				EnumHasAnyFlags(Axes, EISMAnimationAxis::Y) ? 1.0f : 0.0f,
+				EnumHasAnyFlags(Axes, EISMAnimationAxis::Z) ? 1.0f : 0.0f,
+				Layer.WindInfluence));
+		bAllFound &= Collection->SetScalarParameterValue(MaterialLayerParameterName(Prefix, LayerIndex, TEXT("Rotation")),
+			Layer.bApplyAsRotation ? 1.0f : 0.0f);
+	}
+
+	const float MaxDistance = AnimationData->MaxAnimationDistance;
+	bAllFound &= Collection->SetVectorParameterValue(MaterialParameterName(Prefix, TEXT("Falloff")),
+		FLinearColor(MaxDistance, MaxDistance > 0.0f ? MaxDistance * AnimationData->FalloffStartFraction : 0.0f, 0.0f, 0.0f));
+
+	if (!bAllFound)
+	{
+		UE_LOG(LogISMRuntimeAnimation, Warning, TEXT("UISMAnimationComponent on '%s': collection %s is missing some '%s_' parameters; those layers will not animate."),
+			*GetOwner()->GetName(), *AnimationData->MaterialParameters->GetName(), *Prefix.ToString());
+	}
+
+	PushMaterialWind();
+}
+
+FISMAnimationInfluencersPtr UISMAnimationComponent::CollectInfluencers(const FVector& ReferenceLocation) const
+{
+	UWorld* World = GetWorld();
+	if (!World || !AnimationData || !AnimationData->Reaction.bEnabled)
+	{
+		return nullptr;
+	}
+
+	const FISMAnimationReactionSettings& Reaction = AnimationData->Reaction;
+	TSharedRef<TArray<FSphere>, ESPMode::ThreadSafe> Influencers = MakeShared<TArray<FSphere>, ESPMode::ThreadSafe>();
+
+	if (Reaction.bReactToPlayers && Reaction.PlayerRadius > 0.0f)
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			if (const APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+			{
+				Influencers->Emplace(Pawn->GetActorLocation(), Reaction.PlayerRadius);
+			}
+		}
+	}
+
+	UISMRuntimeSubsystem* RuntimeSubsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+	if (Reaction.bReactToPhysicsActors && Reaction.PhysicsActorRadiusScale > 0.0f && RuntimeSubsystem)
+	{
+		TArray<AActor*> PhysicsActors;
+		for (UISMRuntimeComponent* Component : RuntimeSubsystem->GetAllComponents())
+		{
+			if (const UISMPhysicsComponent* PhysicsComponent = Cast<UISMPhysicsComponent>(Component))
+			{
+				PhysicsComponent->AppendActivePhysicsActors(PhysicsActors);
+			}
+		}
+
+		// Anything beyond animation range could not bend an animated instance anyway
+		const float MaxDistance = AnimationData->MaxAnimationDistance;
+		for (const AActor* Actor : PhysicsActors)
+		{
+			FVector Origin;
+			FVector Extent;
+			Actor->GetActorBounds(true, Origin, Extent);
+			const float Radius = static_cast<float>(Extent.Size()) * Reaction.PhysicsActorRadiusScale;
+			if (MaxDistance > 0.0f && FVector::DistSquared(Origin, ReferenceLocation) > FMath::Square(MaxDistance + Radius))
+			{
+				continue;
+			}
+			Influencers->Emplace(Origin, Radius);
+		}
+	}
+
+	return Influencers;
+}
+
+void UISMAnimationComponent::ReleaseWindField()
+{
+	if (UISMWindFieldSubsystem* WindField = CachedWindField.Get())
+	{
+		WindField->UnregisterConsumer();
+	}
+	CachedWindField.Reset();
+}
+
+void UISMAnimationComponent::PushMaterialWind() const
+{
+	UWorld* World = GetWorld();
+	if (!World || !AnimationData || !AnimationData->MaterialParameters)
+	{
+		return;
+	}
+
+	if (UMaterialParameterCollectionInstance* Collection = World->GetParameterCollectionInstance(AnimationData->MaterialParameters))
+	{
+		Collection->SetVectorParameterValue(MaterialParameterName(AnimationData->MaterialParameterPrefix, TEXT("Wind")),
+			FLinearColor(WindDirection.X, WindDirection.Y, WindDirection.Z, WindStrength));
+	}
+}
@@ -0,0 +1,119 @@
+#include "ISMAnimationSubsystem.h"
+#include "ISMAnimationComponent.h"
+#include "ISMAnimationDataAsset.h"
+#include "ISMAnimationTransformer.h"
+#include "ISMRuntimeComponent.h"
+#include "Batching/ISMBatchScheduler.h"
+
+bool UISMAnimationSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMAnimationSubsystem::Deinitialize()
+{
+    for (TPair<TObjectKey<UISMAnimationDataAsset>, FSharedTransformer>& Pair : SharedTransformers)
+    {
+        if (UISMBatchSchedulerBase* Scheduler = Pair.Value.Scheduler.Get())
+        {
+            Scheduler->UnregisterTransformer(Pair.Value.Transformer->GetTransformerName());
+        }
+    }
+    SharedTransformers.Reset();
+    Super::Deinitialize();
+}
+
+TSharedPtr<FISMAnimationTransformer> UISMAnimationSubsystem::AcquireSharedTransformer(
+    UISMAnimationDataAsset* Data,
+    UISMRuntimeComponent* RuntimeComponent,
+    UISMBatchSchedulerBase* Scheduler,
+    UISMAnimationComponent* User)
+{
+    if (!Data || !RuntimeComponent || !Scheduler || !User)
+    {
+        return nullptr;
+    }
+
+    FSharedTransformer* Shared = SharedTransformers.Find(TObjectKey<UISMAnimationDataAsset>(Data));
+    if (!Shared)
+    {
+        const FName Name(*FString::Printf(TEXT("ISMAnimation.Shared.%s"), *Data->GetPathName()));
+        TSharedPtr<FISMAnimationTransformer> Transformer = MakeShared<FISMAnimationTransformer>(RuntimeComponent, Data, Name);
+        if (!Scheduler->RegisterTransformer(Transformer.Get()))
+        {
+            UE_LOG(LogISMRuntimeAnimation, Warning, TEXT("UISMAnimationSubsystem: failed to register shared transformer %s."), *Name.ToString());
+            return nullptr;
+        }
+
+        Shared = &SharedTransformers.Add(TObjectKey<UISMAnimationDataAsset>(Data));
+        Shared->Transformer = MoveTemp(Transformer);
+        Shared->Scheduler = Scheduler;
+    }
+    else
+    {
+        Shared->Transformer->AddTarget(RuntimeComponent);
+    }
+
+    Shared->Users.RemoveAll([User](const FSharedUser& Entry) { return Entry.Component.Get() == User; });
+    Shared->Users.Add({ User, RuntimeComponent });
+    return Shared->Transformer;
+}
+
+void UISMAnimationSubsystem::ReleaseSharedTransformer(UISMAnimationDataAsset* Data, UISMAnimationComponent* User)
+{
+    FSharedTransformer* Shared = SharedTransformers.Find(TObjectKey<UISMAnimationDataAsset>(Data));
+    if (!Shared)
+    {
+        return;
+    }
+
+    for (int32 Index = Shared->Users.Num() - 1; Index >= 0; --Index)
+    {
+        const FSharedUser& Entry = Shared->Users[Index];
+        if (Entry.Component.Get() != User && Entry.Component.IsValid())
+        {
+            continue;
+        }
+
+        // Another component may target the same runtime component; keep it animated for them
+        const UISMRuntimeComponent* RuntimeComponent = Entry.RuntimeComponent.Get();
+        Shared->Users.RemoveAt(Index);
+        const bool bStillTargeted = Shared->Users.ContainsByPredicate([RuntimeComponent](const FSharedUser& Other)
+            {
+                return Other.RuntimeComponent.Get() == RuntimeComponent;
+            });
+        if (!bStillTargeted)
+        {
+            Shared->Transformer->RemoveTarget(RuntimeComponent);
+        }
+    }
+
+    if (Shared->Users.Num() > 0)
+    {
+        return;
+    }
+
+    if (UISMBatchSchedulerBase* Scheduler = Shared->Scheduler.Get())
+    {
+        Scheduler->UnregisterTransformer(Shared->Transformer->GetTransformerName());
+    }
+    SharedTransformers.Remove(TObjectKey<UISMAnimationDataAsset>(Data));
+}
+
+bool UISMAnimationSubsystem::IsSharedTransformerDriver(const UISMAnimationDataAsset* Data, const UISMAnimationComponent* User) const
+{
+    const FSharedTransformer* Shared = SharedTransformers.Find(TObjectKey<UISMAnimationDataAsset>(const_cast<UISMAnimationDataAsset*>(Data)));
+    if (!Shared)
+    {
+        return false;
+    }
+
+    for (const FSharedUser& Entry : Shared->Users)
+    {
+        if (Entry.Component.IsValid())
+        {
+            return Entry.Component.Get() == User;
+        }
+    }
+    return false;
+}
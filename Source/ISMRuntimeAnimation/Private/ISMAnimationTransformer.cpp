@@ -1,32 +1,100 @@
 #include "ISMAnimationTransformer.h"
+#include "ISMRuntimeAnimation.h"
 #include "ISMAnimationDataAsset.h"
 #include "Math/UnrealMathUtility.h"
 #include "Curves/CurveFloat.h"
 #include "Logging/LogMacros.h"
 #include "ISMRuntimeComponent.h"
+#include "Algo/BinarySearch.h"
 
 // Defines storage for the category (exactly once per module)
 DEFINE_LOG_CATEGORY(LogISMRuntimeAnimation);
 
+namespace
+{
+    /** Longest gap a reaction spring integrates; a cell back from a long stagger just resumes */
+    constexpr float MaxReactionDeltaTime = 0.25f;
+
+    /** Longest single spring step */
+    constexpr float MaxReactionStep = 1.0f / 60.0f;
+
+    /** Bend (degrees) and rate (degrees/s) under which an instance counts as upright and still */
+    constexpr float ReactionRestThreshold = 0.01f;
+}
+
 // ============================================================
 //  Construction / Destruction
 // ============================================================
 
+FISMAnimationWriteFilter::FISMAnimationWriteFilter(const UISMAnimationDataAsset& Data)
+{
+    if (Data.MutationPositionThreshold <= 0.0f && Data.MutationRotationThreshold <= 0.0f)
+    {
+        return;
+    }
+    MaxDistanceSquared = FMath::Square(static_cast<double>(Data.MutationPositionThreshold));
+    MinQuatDot = FMath::Cos(FMath::DegreesToRadians(static_cast<double>(Data.MutationRotationThreshold)) * 0.5);
+}
+
 FISMAnimationTransformer::FISMAnimationTransformer(
     UISMRuntimeComponent* InTargetComponent,
     UISMAnimationDataAsset* InAnimData,
     FName InTransformerName)
-    : TargetComponent(InTargetComponent)
-    , AnimData(InAnimData)
+    : AnimData(InAnimData)
     , TransformerName(InTransformerName)
     , bDirtyFlag(true)
 {
+    AddTarget(InTargetComponent);
 }
 
 FISMAnimationTransformer::~FISMAnimationTransformer()
 {
 }
 
+// ============================================================
+//  Targets
+// ============================================================
+
+void FISMAnimationTransformer::AddTarget(UISMRuntimeComponent* InTargetComponent)
+{
+    if (!InTargetComponent)
+    {
+        return;
+    }
+
+    FWriteScopeLock Lock(OriginalDataLock);
+    if (!FindTarget(InTargetComponent))
+    {
+        Targets.AddDefaulted_GetRef().Component = InTargetComponent;
+    }
+}
+
+void FISMAnimationTransformer::RemoveTarget(const UISMRuntimeComponent* InTargetComponent)
+{
+    // Chunks already running hold their capture, so dropping it here is safe
+    FWriteScopeLock Lock(OriginalDataLock);
+    Targets.RemoveAllSwap([InTargetComponent](const FTargetState& Target)
+        {
+            return Target.Component.Get() == InTargetComponent || !Target.Component.IsValid();
+        });
+}
+
+int32 FISMAnimationTransformer::GetNumTargets() const
+{
+    FReadScopeLock Lock(OriginalDataLock);
+    return Targets.Num();
+}
+
+FISMAnimationTransformer::FTargetState* FISMAnimationTransformer::FindTarget(const UISMRuntimeComponent* Component)
+{
+    return Targets.FindByPredicate([Component](const FTargetState& Target) { return Target.Component.Get() == Component; });
+}
+
+const FISMAnimationTransformer::FTargetState* FISMAnimationTransformer::FindTarget(const UISMRuntimeComponent* Component) const
+{
+    return Targets.FindByPredicate([Component](const FTargetState& Target) { return Target.Component.Get() == Component; });
+}
+
 // ============================================================
 //  IISMBatchTransformer
 // ============================================================
@@ -59,23 +127,35 @@ void FISMAnimationTransformer::SetDirty()
 
 void FISMAnimationTransformer::ResetCache()
 {
+    FWriteScopeLock Lock(OriginalDataLock);
     bOriginalTransformsInitialized = false;
-    OriginalData.Reset();
+    for (FTargetState& Target : Targets)
+    {
+        Target.OriginalData.Reset();
+        Target.CellCaptures.Reset();
+    }
 }
 
 FISMSnapshotRequest FISMAnimationTransformer::BuildRequest()
 {
     FISMSnapshotRequest Request;
 
-    if (TargetComponent.IsValid())
     {
-        Request.TargetComponents.Add(TargetComponent);
+        FReadScopeLock Lock(OriginalDataLock);
+        for (const FTargetState& Target : Targets)
+        {
+            if (Target.Component.IsValid())
+            {
+                Request.TargetComponents.Add(Target.Component);
+            }
+        }
     }
     
     // We read transforms to compute displaced positions,
     // and write transforms back with animation applied.
     Request.ReadMask = EISMSnapshotField::Transform;
     Request.WriteMask = EISMSnapshotField::Transform;
+    Request.bStructureOfArrays = true;
 
     // Spatial bounds: sphere around reference location limited to animation distance.
   // If MaxAnimationDistance < 0, leave bounds invalid = snapshot all cells.
@@ -85,6 +165,24 @@ FISMSnapshotRequest FISMAnimationTransformer::BuildRequest()
         const FVector Center = FrameParams.ReferenceLocation;
         const float   Radius = Data->MaxAnimationDistance;
         Request.SpatialBounds = FBox::BuildAABB(Center, FVector(Radius));
+
+        // The box still reaches cells in its corners; relevance culls those before they are
+        // snapshotted, and staggers the mid tier across updates nearest first
+        Request.bUseChunkRelevance = true;
+        Request.ChunkRelevance = [AnimDataPtr = AnimData, Center](const FISMChunkRelevanceQuery& Query)
+        {
+            FISMChunkRelevance Relevance;
+            const UISMAnimationDataAsset* RelevanceData = AnimDataPtr.Get();
+            if (!RelevanceData || !Query.Bounds.IsValid)
+            {
+                return Relevance;
+            }
+
+            const float Distance = static_cast<float>(FMath::Sqrt(Query.Bounds.ComputeSquaredDistanceToPoint(Center)));
+            Relevance.Priority = -Distance;
+            Relevance.UpdateInterval = RelevanceData->GetUpdateIntervalForDistance(Distance);
+            return Relevance;
+        };
     }
 
     return Request;
@@ -92,8 +190,10 @@ FISMSnapshotRequest FISMAnimationTransformer::BuildRequest()
 
 void FISMAnimationTransformer::ProcessChunk(FISMBatchSnapshot Chunk, FISMMutationHandle Handle)
 {
+    LLM_SCOPE_BYTAG(ISMRuntime_Animation);
+
     const UISMAnimationDataAsset* Data = AnimData.Get();
-    if (!Data || !Data->HasEnabledLayers())
+    if (!Data || !Data->HasAnyAnimation())
     {
 		UE_LOG(LogISMRuntimeAnimation, Warning, TEXT("Transformer %s has no valid animation data or enabled layers - abandoning handle."), *TransformerName.ToString());
         Handle.Abandon();
@@ -105,58 +205,118 @@ void FISMAnimationTransformer::ProcessChunk(FISMBatchSnapshot Chunk, FISMMutatio
     // Capture frame params by value - this copy is what makes the function thread safe.
     // The game thread may update FrameParams again before this task finishes,
     // but we work from our local snapshot so there's no race.
-    const FISMAnimationFrameParams LocalParams = FrameParams;
+    FISMAnimationFrameParams LocalParams = FrameParams;
 
-	FISMBatchMutationResult Result;
-	Result.TargetComponent = TargetComponent;
+	// Leased so the transform stream is reused across frames
+	FISMBatchMutationResult Result = Handle.AcquireResult();
+	Result.TargetComponent = Chunk.SourceComponent;
 	Result.WrittenFields = EISMSnapshotField::Transform;
-	Result.Mutations.Reserve(Chunk.Instances.Num());
+	Result.Streams.TransformIndices.Reserve(Chunk.Num());
+	Result.Streams.Transforms.Reserve(Chunk.Num());
+
+    const TArray<int32>& ChunkIndices = Chunk.SoA.InstanceIndices;
+
+    // Take the cell's capture; it is immutable, so the lock only covers the map lookup
+    TSharedPtr<const FISMAnimationCellCapture, ESPMode::ThreadSafe> Capture;
+    FISMWindFieldSnapshotPtr LocalWindField;
+    FISMAnimationInfluencersPtr LocalInfluencers;
+    {
+        FReadScopeLock Lock(OriginalDataLock);
+        const FTargetState* Target = FindTarget(Chunk.SourceComponent.Get());
+        if (const TSharedPtr<const FISMAnimationCellCapture, ESPMode::ThreadSafe>* Found = Target ? Target->CellCaptures.Find(Chunk.CellCoordinates) : nullptr)
+        {
+            Capture = *Found;
+        }
+        LocalWindField = WindField;
+        LocalInfluencers = Influencers;
+    }
+
+    // One sample per cell: the field is far coarser than a cell, and the layer kernel wants uniform wind
+    if (LocalWindField.IsValid() && Capture.IsValid())
+    {
+        LocalWindField->Sample(Capture->Centroid, LocalParams.WindDirection, LocalParams.WindStrength);
+    }
+
+    int32 NumLayers = 0;
+    for (const FISMAnimationLayer& Layer : Data->Layers)
+    {
+        NumLayers += Layer.bEnabled ? 1 : 0;
+    }
 
     int32 AnimatedCount = 0;
     int32 SkippedCount = 0;
+    int32 UnchangedCount = 0;
+    const FISMAnimationWriteFilter WriteFilter(*Data);
 
-    for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+    // A layer toggled since capture invalidates the baked offsets until the next issue rebuilds them
+    if (Capture.IsValid() && Capture->NumLayers == NumLayers)
     {
-        const FISMInstanceCaptureData* data = OriginalData.Find(InstSnap.InstanceIndex);
-        if (!data) continue;
-		
-        // Distance falloff - skip or scale based on distance from reference
-        const float Distance = FVector::Dist(
-            data->OriginalTransform.GetLocation(),
-            LocalParams.ReferenceLocation);
+        const FISMAnimationCellCapture& Cell = *Capture;
 
-        const float Falloff = Data->EvaluateFalloff(Distance);
+        // The capture was built from this chunk's layout unless a newer cycle already replaced it
+        const bool bAligned = Cell.InstanceIndices == ChunkIndices;
 
-        if (FMath::IsNearlyZero(Falloff))
+        auto AnimateEntry = [&](int32 EntryIndex, int32 SnapshotIndex)
         {
-            SkippedCount++;
-            continue;
+            const FTransform& RestTransform = Cell.RestTransforms[EntryIndex];
+
+            // Distance falloff - skip or scale based on distance from reference
+            const float Distance = FVector::Dist(RestTransform.GetLocation(), LocalParams.ReferenceLocation);
+            const float Falloff = Data->EvaluateFalloff(Distance);
+            if (FMath::IsNearlyZero(Falloff))
+            {
+                // Leave it at rest rather than frozen mid-sway; once there it stays quiet
+                SkippedCount++;
+                UnchangedCount += WriteIfChanged(Chunk.SoA, SnapshotIndex, RestTransform, WriteFilter, Result) ? 0 : 1;
+                return;
+            }
+
+            // Evaluate all enabled layers and accumulate displacement
+            const float* PhaseOffsets = Cell.PhaseOffsets.GetData() + EntryIndex;
+            const FTransform Animated = EvaluateLayers(RestTransform, PhaseOffsets, Cell.LayerStride, Falloff, LocalParams);
+            UnchangedCount += WriteIfChanged(Chunk.SoA, SnapshotIndex, Animated, WriteFilter, Result) ? 0 : 1;
+            AnimatedCount++;
+        };
+
+        if (bAligned)
+        {
+            // Only this chunk touches the cell's springs this cycle
+            FISMAnimationReactionCell* Reaction = Cell.Reaction.Get();
+            const TConstArrayView<FSphere> CellInfluencers = LocalInfluencers.IsValid() ? TConstArrayView<FSphere>(*LocalInfluencers) : TConstArrayView<FSphere>();
+            if (Reaction && !StepReaction(*Reaction, Cell, CellInfluencers, Data->Reaction, LocalParams.WorldTime))
+            {
+                Reaction = nullptr;
+            }
+            EvaluateCellLayerMajor(Cell, Chunk.SoA, *Data, LocalParams, WriteFilter, Reaction, Result, AnimatedCount, SkippedCount, UnchangedCount);
+        }
+        else
+        {
+            // Chunk indices are sorted, and so is the capture built from an earlier chunk
+            for (int32 SnapshotIndex = 0; SnapshotIndex < ChunkIndices.Num(); SnapshotIndex++)
+            {
+                const int32 EntryIndex = Algo::BinarySearch(Cell.InstanceIndices, ChunkIndices[SnapshotIndex]);
+                if (EntryIndex != INDEX_NONE)
+                {
+                    AnimateEntry(EntryIndex, SnapshotIndex);
+                }
+            }
         }
-
-        // Evaluate all enabled layers and accumulate displacement
-        const FTransform AnimatedTransform = EvaluateLayers(data->OriginalTransform, InstSnap.InstanceIndex, Falloff, LocalParams);
-
-        FISMInstanceMutation Mutation;
-        Mutation.InstanceIndex = InstSnap.InstanceIndex;
-        Mutation.NewTransform = AnimatedTransform;
-        Result.Mutations.Add(Mutation);
-        AnimatedCount++;
     }
 
-    // Update cycle stats atomically (Phase 2: multiple chunks may run concurrently)
-	CycleAnimatedCount += AnimatedCount;
-	CycleSkippedCount += SkippedCount;
+    // Chunks of one cycle run concurrently on the async scheduler
+	CycleAnimatedCount.fetch_add(AnimatedCount, std::memory_order_relaxed);
+	CycleSkippedCount.fetch_add(SkippedCount, std::memory_order_relaxed);
+	CycleUnchangedCount.fetch_add(UnchangedCount, std::memory_order_relaxed);
 
-    Handle.Release(MoveTemp(Result));
+    Handle.Release(MoveTemp(Result), MoveTemp(Chunk));
 }
 
 void FISMAnimationTransformer::OnRequestComplete()
 {
     // Commit cycle stats to the readable Last* values on the game thread
-    LastAnimatedInstanceCount = CycleAnimatedCount;
-    LastSkippedInstanceCount = CycleSkippedCount;
-    CycleAnimatedCount = 0;
-    CycleSkippedCount = 0;
+    LastAnimatedInstanceCount = CycleAnimatedCount.exchange(0);
+    LastSkippedInstanceCount = CycleSkippedCount.exchange(0);
+    LastUnchangedInstanceCount = CycleUnchangedCount.exchange(0);
 }
 
 
@@ -173,17 +333,96 @@ void FISMAnimationTransformer::OnHandleIssued(const FISMBatchSnapshot& Chunk)
 		UE_LOG(LogISMRuntimeAnimation, Warning, TEXT("Transformer %s received empty chunk - abandoning handle."), *TransformerName.ToString());
         return;
     }
-	// We only ever request 1 chunk per handle, so this is safe.
+    const UISMAnimationDataAsset* Data = AnimData.Get();
+    if (!Data)
+    {
+        return;
+    }
+
+    int32 NumLayers = 0;
+    for (const FISMAnimationLayer& Layer : Data->Layers)
+    {
+        NumLayers += Layer.bEnabled ? 1 : 0;
+    }
+
+    // Each cell arrives as its own chunk - capture instances the first time they are seen
+    FWriteScopeLock Lock(OriginalDataLock);
     if (!bOriginalTransformsInitialized)
     {
-        RandomStream.Initialize(AnimData->RandomSeed);
-        OriginalData.Reserve(Chunk.Instances.Num());
-        for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+        RandomStream.Initialize(Data->RandomSeed);
+        bOriginalTransformsInitialized = true;
+    }
+
+    // A target removed since the request was built has nothing to capture into
+    if (FTargetState* Target = FindTarget(Chunk.SourceComponent.Get()))
+    {
+        UpdateCellCapture(*Target, Chunk, NumLayers);
+    }
+}
+
+void FISMAnimationTransformer::UpdateCellCapture(FTargetState& Target, const FISMBatchSnapshot& Chunk, int32 NumLayers)
+{
+    const FISMInstanceSoASnapshot& SoA = Chunk.SoA;
+
+    const UISMAnimationDataAsset* Data = AnimData.Get();
+
+    // Steady state: same instances in the same order as last cycle, nothing to do
+    if (const TSharedPtr<const FISMAnimationCellCapture, ESPMode::ThreadSafe>* Existing = Target.CellCaptures.Find(Chunk.CellCoordinates))
+    {
+        if ((*Existing)->NumLayers == NumLayers && (*Existing)->InstanceIndices == SoA.InstanceIndices
+            && (*Existing)->Reaction.IsValid() == Data->Reaction.bEnabled)
         {
-            OriginalData.Add(InstSnap.InstanceIndex, CaptureInstanceData(InstSnap));
+            return;
         }
-        bOriginalTransformsInitialized = true;
     }
+    TSharedRef<FISMAnimationCellCapture, ESPMode::ThreadSafe> Cell = MakeShared<FISMAnimationCellCapture, ESPMode::ThreadSafe>();
+    Cell->NumLayers = NumLayers;
+    Cell->InstanceIndices = SoA.InstanceIndices;
+    Cell->LayerStride = Align(SoA.Num(), 4);
+    Cell->RestTransforms.Reserve(SoA.Num());
+    Cell->PhaseOffsets.SetNumZeroed(Cell->LayerStride * NumLayers);
+
+    TMap<int32, FISMInstanceCaptureData>& OriginalData = Target.OriginalData;
+    OriginalData.Reserve(OriginalData.Num() + SoA.Num());
+    for (int32 i = 0; i < SoA.Num(); i++)
+    {
+        const int32 InstanceIndex = SoA.InstanceIndices[i];
+
+        // Instances keep the rest pose they were first seen with, even after moving cells
+        const FISMInstanceCaptureData* Rest = OriginalData.Find(InstanceIndex);
+        if (!Rest)
+        {
+            Rest = &OriginalData.Add(InstanceIndex, CaptureInstanceData(SoA.GetTransform(i)));
+        }
+        Cell->RestTransforms.Add(Rest->OriginalTransform);
+        Cell->Centroid += Rest->OriginalTransform.GetLocation();
+        Cell->RestBounds += Rest->OriginalTransform.GetLocation();
+
+        // Phase offsets depend only on the rest pose and index, so they are computed once here
+        int32 LayerSlot = 0;
+        for (const FISMAnimationLayer& Layer : Data->Layers)
+        {
+            if (Layer.bEnabled)
+            {
+                Cell->PhaseOffsets[LayerSlot++ * Cell->LayerStride + i] = ComputeInstancePhaseOffset(Layer, Rest->OriginalTransform, InstanceIndex);
+            }
+        }
+    }
+
+    if (SoA.Num() > 0)
+    {
+        Cell->Centroid /= static_cast<double>(SoA.Num());
+    }
+
+    if (Data->Reaction.bEnabled)
+    {
+        Cell->Reaction = MakeShared<FISMAnimationReactionCell, ESPMode::ThreadSafe>();
+        Cell->Reaction->BendX.SetNumZeroed(SoA.Num());
+        Cell->Reaction->BendY.SetNumZeroed(SoA.Num());
+        Cell->Reaction->VelocityX.SetNumZeroed(SoA.Num());
+        Cell->Reaction->VelocityY.SetNumZeroed(SoA.Num());
+    }
+    Target.CellCaptures.Add(Chunk.CellCoordinates, MoveTemp(Cell));
 }
 
 void FISMAnimationTransformer::OnHandleChunksChanged(const TArray<FISMBatchSnapshot>& Snapshots)
@@ -214,7 +453,19 @@ void FISMAnimationTransformer::UpdateFrameParams(const FISMAnimationFrameParams&
     FrameParams = Params;
 }
 
-FTransform FISMAnimationTransformer::EvaluateLayers(const FTransform& BaseTransform, int32 InstanceIndex, float FalloffScale, const FISMAnimationFrameParams& InFrameParams) const
+void FISMAnimationTransformer::UpdateWindField(FISMWindFieldSnapshotPtr InWindField)
+{
+    FWriteScopeLock Lock(OriginalDataLock);
+    WindField = MoveTemp(InWindField);
+}
+
+void FISMAnimationTransformer::UpdateInfluencers(FISMAnimationInfluencersPtr InInfluencers)
+{
+    FWriteScopeLock Lock(OriginalDataLock);
+    Influencers = MoveTemp(InInfluencers);
+}
+
+FTransform FISMAnimationTransformer::EvaluateLayers(const FTransform& BaseTransform, const float* PhaseOffsets, int32 PhaseStride, float FalloffScale, const FISMAnimationFrameParams& InFrameParams) const
 {
     const UISMAnimationDataAsset* Data = AnimData.Get();
     if (!Data) return BaseTransform;
@@ -229,8 +480,9 @@ FTransform FISMAnimationTransformer::EvaluateLayers(const FTransform& BaseTransf
         FVector  LayerTranslation = FVector::ZeroVector;
         FRotator LayerRotation = FRotator::ZeroRotator;
 
-        EvaluateLayer(Layer, BaseTransform, InstanceIndex, InFrameParams,
+        EvaluateLayer(Layer, *PhaseOffsets, InFrameParams,
             LayerTranslation, LayerRotation);
+        PhaseOffsets += PhaseStride;
 
         // Apply falloff to this layer's contribution
         TotalTranslation += LayerTranslation * FalloffScale;
@@ -258,11 +510,291 @@ FTransform FISMAnimationTransformer::EvaluateLayers(const FTransform& BaseTransf
     return Result;
 }
 
-void FISMAnimationTransformer::EvaluateLayer(const FISMAnimationLayer& Layer, const FTransform& BaseTransform, int32 InstanceIndex, const FISMAnimationFrameParams& InFrameParams, FVector& OutTranslation, FRotator& OutRotation) const
+void FISMAnimationTransformer::EvaluateCellLayerMajor(const FISMAnimationCellCapture& Cell, const FISMInstanceSoASnapshot& Current,
+    const UISMAnimationDataAsset& Data, const FISMAnimationFrameParams& InFrameParams, const FISMAnimationWriteFilter& WriteFilter,
+    const FISMAnimationReactionCell* Reaction, FISMBatchMutationResult& Result, int32& OutAnimatedCount, int32& OutSkippedCount,
+    int32& OutUnchangedCount) const
+{
+    const int32 NumEntries = Cell.InstanceIndices.Num();
+    const int32 Stride = Cell.LayerStride;
+    if (NumEntries == 0)
+    {
+        return;
+    }
+
+    // Falloff may read a curve, so it stays scalar; out-of-range entries get 0 and drop out of every layer
+    TArray<float> Falloffs;
+    Falloffs.SetNumZeroed(Stride);
+    int32 NumInRange = 0;
+    for (int32 i = 0; i < NumEntries; i++)
+    {
+        const float Falloff = Data.EvaluateFalloff(FVector::Dist(Cell.RestTransforms[i].GetLocation(), InFrameParams.ReferenceLocation));
+        if (FMath::IsNearlyZero(Falloff))
+        {
+            // Settle to rest, as the per-entry path does
+            OutUnchangedCount += WriteIfChanged(Current, i, Cell.RestTransforms[i], WriteFilter, Result) ? 0 : 1;
+            continue;
+        }
+        Falloffs[i] = Falloff;
+        ++NumInRange;
+    }
+    OutSkippedCount += NumEntries - NumInRange;
+    if (NumInRange == 0)
+    {
+        return;
+    }
+
+    // Six SoA accumulators: translation X/Y/Z, then rotation Roll/Pitch/Yaw (driven by X/Y/Z)
+    TArray<float> Accumulators;
+    Accumulators.SetNumZeroed(Stride * 6);
+    float* const Translation[3] = { Accumulators.GetData(), Accumulators.GetData() + Stride, Accumulators.GetData() + Stride * 2 };
+    float* const Rotation[3] = { Accumulators.GetData() + Stride * 3, Accumulators.GetData() + Stride * 4, Accumulators.GetData() + Stride * 5 };
+
+    TArray<float> Wave;
+    Wave.SetNumUninitialized(Stride);
+
+    int32 LayerSlot = 0;
+    for (const FISMAnimationLayer& Layer : Data.Layers)
+    {
+        if (!Layer.bEnabled)
+        {
+            continue;
+        }
+        const float* Offsets = Cell.PhaseOffsets.GetData() + LayerSlot++ * Stride;
+
+        const FVector Axis = GetLayerDisplacementAxis(Layer, InFrameParams);
+        if (Axis.IsZero())
+        {
+            continue;
+        }
+
+        SampleWaveformBatch(Layer.Waveform, InFrameParams.WorldTime * Layer.Frequency + Layer.PhaseOffset, Offsets, Stride, Wave.GetData());
+
+        float* const* Target = Layer.bApplyAsRotation ? Rotation : Translation;
+        const VectorRegister4Float Amplitude = VectorSetFloat1(Layer.Amplitude);
+        const VectorRegister4Float AxisX = VectorSetFloat1(static_cast<float>(Axis.X));
+        const VectorRegister4Float AxisY = VectorSetFloat1(static_cast<float>(Axis.Y));
+        const VectorRegister4Float AxisZ = VectorSetFloat1(static_cast<float>(Axis.Z));
+
+        for (int32 i = 0; i < Stride; i += 4)
+        {
+            const VectorRegister4Float Displacement = VectorMultiply(VectorMultiply(VectorLoad(Wave.GetData() + i), Amplitude), VectorLoad(Falloffs.GetData() + i));
+            VectorStore(VectorMultiplyAdd(Displacement, AxisX, VectorLoad(Target[0] + i)), Target[0] + i);
+            VectorStore(VectorMultiplyAdd(Displacement, AxisY, VectorLoad(Target[1] + i)), Target[1] + i);
+            VectorStore(VectorMultiplyAdd(Displacement, AxisZ, VectorLoad(Target[2] + i)), Target[2] + i);
+        }
+    }
+
+    // Compose exactly as EvaluateLayers does
+    for (int32 i = 0; i < NumEntries; i++)
+    {
+        if (Falloffs[i] == 0.0f)
+        {
+            continue;
+        }
+
+        const FTransform& RestTransform = Cell.RestTransforms[i];
+        FTransform Animated = RestTransform;
+
+        const FVector TotalTranslation(Translation[0][i], Translation[1][i], Translation[2][i]);
+        if (TotalTranslation != FVector::ZeroVector)
+        {
+            Animated.SetLocation(RestTransform.GetLocation() + TotalTranslation);
+        }
+
+        const FRotator TotalRotation(Rotation[1][i], Rotation[2][i], Rotation[0][i]);
+        if (!TotalRotation.IsNearlyZero())
+        {
+            Animated.SetRotation(RestTransform.GetRotation() * TotalRotation.Quaternion());
+        }
+
+        // Lean the whole instance about its pivot, in world space, after the layered sway
+        if (Reaction)
+        {
+            const float BendX = Reaction->BendX[i];
+            const float BendY = Reaction->BendY[i];
+            const float BendAngle = FMath::Sqrt(BendX * BendX + BendY * BendY);
+            if (BendAngle > UE_KINDA_SMALL_NUMBER)
+            {
+                const FVector BendAxis(-BendY / BendAngle, BendX / BendAngle, 0.0f);
+                Animated.SetRotation(FQuat(BendAxis, FMath::DegreesToRadians(BendAngle)) * Animated.GetRotation());
+            }
+        }
+
+        OutUnchangedCount += WriteIfChanged(Current, i, Animated, WriteFilter, Result) ? 0 : 1;
+        ++OutAnimatedCount;
+    }
+}
+
+bool FISMAnimationTransformer::StepReaction(FISMAnimationReactionCell& Reaction, const FISMAnimationCellCapture& Cell,
+    TConstArrayView<FSphere> Influencers, const FISMAnimationReactionSettings& Settings, float WorldTime)
+{
+    const float DeltaTime = Reaction.LastUpdateTime < 0.0f ? 0.0f : FMath::Clamp(WorldTime - Reaction.LastUpdateTime, 0.0f, MaxReactionDeltaTime);
+    Reaction.LastUpdateTime = WorldTime;
+
+    // Most cells have no influencer near them
+    TArray<FSphere, TInlineAllocator<8>> Overlapping;
+    for (const FSphere& Influencer : Influencers)
+    {
+        if (Cell.RestBounds.ComputeSquaredDistanceToPoint(Influencer.Center) <= FMath::Square(Influencer.W))
+        {
+            Overlapping.Add(Influencer);
+        }
+    }
+    if (Overlapping.Num() == 0 && Reaction.bSettled)
+    {
+        return false;
+    }
+
+    const int32 NumSteps = FMath::Max(FMath::CeilToInt32(DeltaTime / MaxReactionStep), 1);
+    const float Step = DeltaTime / NumSteps;
+    const float MaxBend = Settings.MaxBendAngle;
+
+    bool bSettled = Overlapping.Num() == 0;
+    for (int32 i = 0; i < Cell.RestTransforms.Num(); i++)
+    {
+        const FVector Location = Cell.RestTransforms[i].GetLocation();
+
+        // Target lean: away from every influencer inside whose radius this instance sits
+        FVector2D Target = FVector2D::ZeroVector;
+        for (const FSphere& Influencer : Overlapping)
+        {
+            const FVector2D Away(Location.X - Influencer.Center.X, Location.Y - Influencer.Center.Y);
+            const double Distance = Away.Size();
+            if (Distance >= Influencer.W)
+            {
+                continue;
+            }
+            const FVector2D Direction = Distance > UE_KINDA_SMALL_NUMBER ? Away / Distance : FVector2D(1.0, 0.0);
+            Target += Direction * (MaxBend * (1.0 - Distance / Influencer.W));
+        }
+        Target = Target.GetClampedToMaxSize(MaxBend);
+
+        float& BendX = Reaction.BendX[i];
+        float& BendY = Reaction.BendY[i];
+        float& VelocityX = Reaction.VelocityX[i];
+        float& VelocityY = Reaction.VelocityY[i];
+
+        // Semi-implicit damped spring, sub-stepped so a throttled or staggered cell stays stable
+        for (int32 StepIndex = 0; StepIndex < NumSteps; StepIndex++)
+        {
+            VelocityX += (Settings.Stiffness * (static_cast<float>(Target.X) - BendX) - Settings.Damping * VelocityX) * Step;
+            VelocityY += (Settings.Stiffness * (static_cast<float>(Target.Y) - BendY) - Settings.Damping * VelocityY) * Step;
+            BendX += VelocityX * Step;
+            BendY += VelocityY * Step;
+        }
+
+        if (FMath::Abs(BendX) > ReactionRestThreshold || FMath::Abs(BendY) > ReactionRestThreshold
+            || FMath::Abs(VelocityX) > ReactionRestThreshold || FMath::Abs(VelocityY) > ReactionRestThreshold)
+        {
+            bSettled = false;
+        }
+    }
+
+    // Snap upright once every entry has come to rest, so the next write is the plain pose
+    if (bSettled)
+    {
+        FMemory::Memzero(Reaction.BendX.GetData(), Reaction.BendX.Num() * sizeof(float));
+        FMemory::Memzero(Reaction.BendY.GetData(), Reaction.BendY.Num() * sizeof(float));
+        FMemory::Memzero(Reaction.VelocityX.GetData(), Reaction.VelocityX.Num() * sizeof(float));
+        FMemory::Memzero(Reaction.VelocityY.GetData(), Reaction.VelocityY.Num() * sizeof(float));
+    }
+    Reaction.bSettled = bSettled;
+    return true;
+}
+
+bool FISMAnimationTransformer::WriteIfChanged(const FISMInstanceSoASnapshot& Current, int32 SnapshotIndex, const FTransform& Target,
+    const FISMAnimationWriteFilter& WriteFilter, FISMBatchMutationResult& Result)
+{
+    // The snapshot holds what was last applied, whoever applied it
+    if (WriteFilter.IsNegligible(Current.Locations[SnapshotIndex], Current.Rotations[SnapshotIndex], Target))
+    {
+        return false;
+    }
+    Result.Streams.AddTransform(Current.InstanceIndices[SnapshotIndex], Target);
+    return true;
+}
+
+void FISMAnimationTransformer::SampleWaveformBatch(EISMAnimationWaveform Waveform, float BasePhase, const float* Offsets, int32 NumPadded, float* OutWave)
+{
+    const VectorRegister4Float Base = VectorSetFloat1(BasePhase);
+    const VectorRegister4Float One = VectorOne();
+
+    // Fractional part the way FMath::Frac takes it: X - Floor(X)
+    auto LoadPhase = [&Base, Offsets](int32 i)
+    {
+        const VectorRegister4Float Phase = VectorAdd(Base, VectorLoad(Offsets + i));
+        return VectorSubtract(Phase, VectorFloor(Phase));
+    };
+
+    switch (Waveform)
+    {
+    case EISMAnimationWaveform::Sine:
+    {
+        const VectorRegister4Float TwoPi = VectorSetFloat1(TWO_PI);
+        for (int32 i = 0; i < NumPadded; i += 4)
+        {
+            VectorStore(VectorSin(VectorMultiply(LoadPhase(i), TwoPi)), OutWave + i);
+        }
+        return;
+    }
+
+    case EISMAnimationWaveform::Triangle:
+    {
+        // Same shape as the scalar piecewise ramp: 1 - 4 * |Frac(P + 0.25) - 0.5|
+        const VectorRegister4Float Quarter = VectorSetFloat1(0.25f);
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+        const VectorRegister4Float Four = VectorSetFloat1(4.0f);
+        for (int32 i = 0; i < NumPadded; i += 4)
+        {
+            VectorRegister4Float Shifted = VectorAdd(LoadPhase(i), Quarter);
+            Shifted = VectorSubtract(Shifted, VectorFloor(Shifted));
+            VectorStore(VectorNegateMultiplyAdd(Four, VectorAbs(VectorSubtract(Shifted, Half)), One), OutWave + i);
+        }
+        return;
+    }
+
+    case EISMAnimationWaveform::Square:
+    {
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+        const VectorRegister4Float MinusOne = VectorSetFloat1(-1.0f);
+        for (int32 i = 0; i < NumPadded; i += 4)
+        {
+            VectorStore(VectorSelect(VectorCompareLT(LoadPhase(i), Half), One, MinusOne), OutWave + i);
+        }
+        return;
+    }
+
+    default:
+        // Perlin has no vector form here; keep it exact with the scalar sampler
+        for (int32 i = 0; i < NumPadded; i++)
+        {
+            OutWave[i] = SampleWaveform(Waveform, BasePhase + Offsets[i]);
+        }
+        return;
+    }
+}
+
+FVector FISMAnimationTransformer::GetLayerDisplacementAxis(const FISMAnimationLayer& Layer, const FISMAnimationFrameParams& InFrameParams)
+{
+    const EISMAnimationAxis Axes = static_cast<EISMAnimationAxis>(Layer.ActiveAxes);
+    const FVector AxisMask(
+        EnumHasAnyFlags(Axes, EISMAnimationAxis::X) ? 1.0 : 0.0,
+        EnumHasAnyFlags(Axes, EISMAnimationAxis::Y) ? 1.0 : 0.0,
+        EnumHasAnyFlags(Axes, EISMAnimationAxis::Z) ? 1.0 : 0.0);
+
+    // EvaluateLayer lerps Mask * D toward Wind * D * Strength; D factors out
+    if (Layer.WindInfluence > 0.0f && !InFrameParams.WindDirection.IsNearlyZero())
+    {
+        return FMath::Lerp(AxisMask, InFrameParams.WindDirection * InFrameParams.WindStrength, static_cast<double>(Layer.WindInfluence));
+    }
+    return AxisMask;
+}
+
+void FISMAnimationTransformer::EvaluateLayer(const FISMAnimationLayer& Layer, float InstanceOffset, const FISMAnimationFrameParams& InFrameParams, FVector& OutTranslation, FRotator& OutRotation) const
 {
     // Compute this instance's phase: base time * frequency + fixed offset + per-instance variation
     const float BasePhase = InFrameParams.WorldTime * Layer.Frequency;
-    const float InstanceOffset = ComputeInstancePhaseOffset(Layer, BaseTransform, InstanceIndex);
     const float TotalPhase = BasePhase + Layer.PhaseOffset + InstanceOffset;
 
     // Sample the waveform - result in [-1, 1]
@@ -387,10 +919,10 @@ float FISMAnimationTransformer::ComputeInstancePhaseOffset(const FISMAnimationLa
     return FMath::Frac(RawOffset * Layer.PhaseVariation);
 }
 
-FISMInstanceCaptureData FISMAnimationTransformer::CaptureInstanceData(FISMInstanceSnapshot InstanceSnapshot) const
+FISMInstanceCaptureData FISMAnimationTransformer::CaptureInstanceData(const FTransform& OriginalTransform) const
 {
     auto data = FISMInstanceCaptureData();
-	data.OriginalTransform = InstanceSnapshot.Transform;
+	data.OriginalTransform = OriginalTransform;
 	data.Rand = RandomStream.FRandRange(AnimData->GetRandomRangeMin(), AnimData->GetRandomRangeMax());
     return data;
 }
@@ -1,5 +1,7 @@
 #include "ISMRuntimeAnimation.h"
 
+LLM_DEFINE_TAG(ISMRuntime_Animation);
+
 #define LOCTEXT_NAMESPACE "FISMRuntimeAnimationModule"
 
 void FISMRuntimeAnimation::StartupModule()
@@ -0,0 +1,149 @@
+#include "ISMWindFieldSubsystem.h"
+#include "ISMRuntimeAnimation.h"
+#include "ISMRuntimeProfiling.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+
+namespace
+{
+    /** Offsets the direction noise from the strength noise so the two do not peak together */
+    const FVector2D WindDirectionNoiseOffset(17.3, -9.1);
+}
+
+void FISMWindFieldSnapshot::Sample(const FVector& Location, FVector& OutDirection, float& OutStrength) const
+{
+    if (Resolution <= 0 || Cells.Num() != Resolution * Resolution)
+    {
+        OutDirection = FVector::ZeroVector;
+        OutStrength = 0.0f;
+        return;
+    }
+
+    const int32 MaxCell = Resolution - 1;
+    const double GridX = FMath::Clamp((Location.X - Origin.X) / CellSize, 0.0, static_cast<double>(MaxCell));
+    const double GridY = FMath::Clamp((Location.Y - Origin.Y) / CellSize, 0.0, static_cast<double>(MaxCell));
+
+    const int32 X0 = FMath::FloorToInt32(GridX);
+    const int32 Y0 = FMath::FloorToInt32(GridY);
+    const int32 X1 = FMath::Min(X0 + 1, MaxCell);
+    const int32 Y1 = FMath::Min(Y0 + 1, MaxCell);
+    const float TX = static_cast<float>(GridX - X0);
+    const float TY = static_cast<float>(GridY - Y0);
+
+    const FVector4f Bottom = FMath::Lerp(Cells[Y0 * Resolution + X0], Cells[Y0 * Resolution + X1], TX);
+    const FVector4f Top = FMath::Lerp(Cells[Y1 * Resolution + X0], Cells[Y1 * Resolution + X1], TX);
+    const FVector4f Blended = FMath::Lerp(Bottom, Top, TY);
+
+    OutDirection = FVector(Blended.X, Blended.Y, Blended.Z).GetSafeNormal();
+    OutStrength = Blended.W;
+}
+
+bool UISMWindFieldSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMWindFieldSubsystem::RegisterConsumer()
+{
+    ++NumConsumers;
+}
+
+void UISMWindFieldSubsystem::UnregisterConsumer()
+{
+    NumConsumers = FMath::Max(NumConsumers - 1, 0);
+}
+
+void UISMWindFieldSubsystem::SetWind(FVector InDirection, float InStrength)
+{
+    BaseDirection = InDirection;
+    BaseStrength = FMath::Max(0.0f, InStrength);
+}
+
+void UISMWindFieldSubsystem::SampleWind(FVector Location, FVector& OutDirection, float& OutStrength) const
+{
+    if (!Snapshot.IsValid())
+    {
+        OutDirection = BaseDirection.GetSafeNormal2D();
+        OutStrength = BaseStrength;
+        return;
+    }
+    Snapshot->Sample(Location, OutDirection, OutStrength);
+}
+
+void UISMWindFieldSubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMWindFieldSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Animation);
+
+    if (NumConsumers == 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // Follow the camera; without one, keep the grid where it was
+    FVector Center = Snapshot.IsValid()
+        ? FVector(Snapshot->Origin + FVector2D(Snapshot->CellSize * (Snapshot->Resolution / 2)), 0.0)
+        : FVector::ZeroVector;
+    if (APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(World, 0))
+    {
+        Center = CameraManager->GetCameraLocation();
+    }
+
+    BuildSnapshot(Center, World->GetTimeSeconds());
+}
+
+void UISMWindFieldSubsystem::BuildSnapshot(const FVector& Center, double Time)
+{
+    const int32 Res = FMath::Clamp(Resolution, 2, 256);
+    const double Size = FMath::Max(static_cast<double>(CellSize), 100.0);
+
+    TSharedRef<FISMWindFieldSnapshot, ESPMode::ThreadSafe> Field = MakeShared<FISMWindFieldSnapshot, ESPMode::ThreadSafe>();
+    Field->Resolution = Res;
+    Field->CellSize = static_cast<float>(Size);
+
+    // Snapped to whole cells so the grid does not shimmer as the camera moves
+    Field->Origin = FVector2D(
+        (FMath::FloorToDouble(Center.X / Size) - Res / 2) * Size,
+        (FMath::FloorToDouble(Center.Y / Size) - Res / 2) * Size);
+    Field->Cells.SetNumUninitialized(Res * Res);
+
+    // Gusts live in wind-aligned coordinates, so the pattern slides along the wind as time passes
+    FVector2D Downwind = FVector2D(BaseDirection.X, BaseDirection.Y).GetSafeNormal();
+    if (Downwind.IsNearlyZero())
+    {
+        Downwind = FVector2D(1.0, 0.0);
+    }
+    const FVector2D Crosswind(-Downwind.Y, Downwind.X);
+
+    const double InvScale = 1.0 / FMath::Max(static_cast<double>(GustScale), 1.0);
+    const double Travel = Time * GustSpeed;
+    const float Strength = FMath::Max(BaseStrength, 0.0f);
+
+    for (int32 Y = 0; Y < Res; ++Y)
+    {
+        for (int32 X = 0; X < Res; ++X)
+        {
+            const FVector2D CellCenter = Field->Origin + FVector2D(X, Y) * Size;
+            const FVector2D NoiseCoord(((CellCenter | Downwind) - Travel) * InvScale, (CellCenter | Crosswind) * InvScale);
+
+            const float Gust = FMath::PerlinNoise2D(NoiseCoord);
+            const float Swing = GustDirectionVariance * FMath::PerlinNoise2D(NoiseCoord + WindDirectionNoiseOffset);
+            const FVector2D Direction = Downwind.GetRotated(Swing);
+
+            Field->Cells[Y * Res + X] = FVector4f(
+                static_cast<float>(Direction.X),
+                static_cast<float>(Direction.Y),
+                0.0f,
+                FMath::Max(Strength * (1.0f + GustStrength * Gust), 0.0f));
+        }
+    }
+
+    Snapshot = MoveTemp(Field);
+}
@@ -10,6 +10,8 @@ class UISMAnimationDataAsset;
 class UISMRuntimeComponent;
 class UInstancedStaticMeshComponent;
 class UISMBatchSchedulerBase;
+class UISMWindFieldSubsystem;
+class UISMAnimationSubsystem;
 class AActor;
 
 /**
@@ -31,11 +33,24 @@ class AActor;
  *   - On EndPlay, unregisters the transformer and releases it
  *
  * Multiple UISMAnimationComponents can target different ISM components on the same actor,
- * or different actors entirely. Each gets its own transformer and scheduler registration.
+ * or different actors entirely. Each gets its own transformer and scheduler registration,
+ * unless bShareTransformer pools them into one transformer per data asset.
  *
  * Wind:
  *   Wind direction and strength can be set directly on this component for simple cases,
  *   or driven externally each frame via SetWindParams() for dynamic weather systems.
+ *   With bUseWindField, the shared UISMWindFieldSubsystem supplies it instead, so one weather
+ *   update reaches every component and gusts stay coherent between them.
+ *
+ * Reaction:
+ *   With AnimationData->Reaction enabled, the component collects players and nearby physics
+ *   actors once per tick and the transformer bends the instances around them.
+ *
+ * Material backend:
+ *   With AnimationData->Backend = MaterialWPO no transformer is created. Per-instance phase
+ *   offsets are baked into custom data once and the layer parameters are pushed to the asset's
+ *   material parameter collection; the component stops ticking and only touches the collection
+ *   again when wind or pause state changes.
  */
 UCLASS(Blueprintable, ClassGroup = (ISMRuntime), meta = (BlueprintSpawnableComponent))
 class ISMRUNTIMEANIMATION_API UISMAnimationComponent : public UActorComponent
@@ -84,6 +99,23 @@ public:
         meta = (ClampMin = "0.0"))
     float WindStrength = 1.0f;
 
+    /**
+     * Take wind from the world's UISMWindFieldSubsystem instead of WindDirection/WindStrength,
+     * sampled per spatial cell so gusts roll across the instances. CPU backend only.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind")
+    bool bUseWindField = false;
+
+    /**
+     * Join the one transformer UISMAnimationSubsystem keeps for AnimationData instead of
+     * registering a transformer of our own, so many components on one asset cost the scheduler
+     * a single request. One sharing component supplies time, reference location and wind for
+     * all of them, so only share between components that agree on those. Stats are the
+     * shared transformer's totals.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation")
+    bool bShareTransformer = false;
+
     /**
      * If true, use the player camera location as the reference point for distance falloff.
      * If false, use this component's owner's location instead.
@@ -129,7 +161,14 @@ public:
      * False until RequestRuntimeComponent callback fires.
      */
     UFUNCTION(BlueprintPure, Category = "ISM Animation")
-    bool IsAnimationActive() const { return Transformer.IsValid(); }
+    bool IsAnimationActive() const { return Transformer.IsValid() || MaterialTarget.IsValid(); }
+
+    /**
+     * Material backend only: bake phase offsets again and re-push every collection parameter.
+     * Call after adding instances or editing the data asset at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Animation")
+    void RebakeMaterialAnimation();
 
     // ===== Debug =====
 
@@ -158,6 +197,25 @@ private:
     /** Get the reference location for distance falloff (camera or owner). */
     FVector GetReferenceLocation() const;
 
+    /** Material backend: write each instance's per-layer phase offset into its custom data. */
+    void BakeMaterialPhases(UISMRuntimeComponent* RuntimeComponent) const;
+
+    /** Material backend: push layer, falloff and wind parameters to the collection. */
+    void PushMaterialParameters() const;
+
+    /** Material backend: push only the wind vector. */
+    void PushMaterialWind() const;
+
+    /** Stop keeping the wind field alive on this component's behalf. */
+    void ReleaseWindField();
+
+    /**
+     * Reactive layer: gather this frame's influencer spheres (player pawns, active ISM physics
+     * actors within animation range) into a fresh list for the transformer. Null when the
+     * asset's reaction is off.
+     */
+    FISMAnimationInfluencersPtr CollectInfluencers(const FVector& ReferenceLocation) const;
+
 
     // ===== State =====
 
@@ -170,6 +228,18 @@ private:
      */
     TWeakObjectPtr<UISMBatchSchedulerBase> CachedScheduler;
 
+    /** Subsystem holding the shared transformer this component joined; null when it owns its own. */
+    TWeakObjectPtr<UISMAnimationSubsystem> CachedAnimationSubsystem;
+
+    /** Runtime component this component added to the shared transformer; for pausing. */
+    TWeakObjectPtr<UISMRuntimeComponent> SharedTarget;
+
+    /** Wind field this component is registered with as a consumer; null without bUseWindField. */
+    TWeakObjectPtr<UISMWindFieldSubsystem> CachedWindField;
+
+    /** Runtime component animated by the material backend; null on the CPU path. */
+    TWeakObjectPtr<UISMRuntimeComponent> MaterialTarget;
+
     /** Whether animation is paused (transformer IsDirty always returns false). */
     bool bAnimationPaused = false;
 
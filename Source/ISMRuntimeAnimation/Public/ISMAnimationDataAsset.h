@@ -5,6 +5,28 @@
 #include "Curves/CurveFloat.h"
 #include "ISMAnimationDataAsset.generated.h"
 
+class UMaterialParameterCollection;
+
+/**
+ * Where animation layers are evaluated.
+ */
+UENUM(BlueprintType)
+enum class EISMAnimationBackend : uint8
+{
+    /**
+     * FISMAnimationTransformer evaluates layers per instance and writes transforms back.
+     * Instance transforms (and everything that reads them) follow the motion.
+     */
+    CPUTransforms   UMETA(DisplayName = "CPU Transforms"),
+
+    /**
+     * Layers are baked once into per-instance custom data and material parameter collection
+     * values, and the mesh material animates them in world position offset. No per-frame CPU
+     * cost and no transform writes; purely visual, so queries and physics see the rest pose.
+     */
+    MaterialWPO     UMETA(DisplayName = "Material WPO"),
+};
+
 /**
  * The mathematical function used to drive animation displacement.
  */
@@ -129,6 +151,51 @@ struct ISMRUNTIMEANIMATION_API FISMAnimationLayer
 };
 
 
+/**
+ * Reactive layer: instances bend away from nearby influencers (players, converted physics
+ * actors) and spring back once they pass. Evaluated on top of the waveform layers.
+ *
+ * Influencer spheres are collected once per frame by UISMAnimationComponent. Only cells whose
+ * rest bounds overlap an influencer, or that are still recovering, pay for the spring.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEANIMATION_API FISMAnimationReactionSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction")
+    bool bEnabled = false;
+
+    /** Tilt (degrees) at an influencer's centre; fades linearly to 0 at its radius */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+    float MaxBendAngle = 35.0f;
+
+    /** Spring pull toward the target tilt (1/s^2). Higher snaps back faster. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction", meta = (ClampMin = "0.0"))
+    float Stiffness = 80.0f;
+
+    /** Velocity damping (1/s). About 2 * sqrt(Stiffness) settles without overshoot; less wobbles. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction", meta = (ClampMin = "0.0"))
+    float Damping = 10.0f;
+
+    /** Bend away from player pawns */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction")
+    bool bReactToPlayers = true;
+
+    /** Influence radius (cm) around each player pawn */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction", meta = (ClampMin = "0.0", EditCondition = "bReactToPlayers"))
+    float PlayerRadius = 150.0f;
+
+    /** Bend away from active ISM physics actors */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction")
+    bool bReactToPhysicsActors = true;
+
+    /** Influence radius of a physics actor as a multiple of its bounding sphere */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reaction", meta = (ClampMin = "0.0", EditCondition = "bReactToPhysicsActors"))
+    float PhysicsActorRadiusScale = 1.5f;
+};
+
+
 /**
  * Data asset defining the complete animation configuration for an ISM animation transformer.
  * Assign to a UISMAnimationComponent to drive procedural instance animation.
@@ -153,6 +220,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
     TArray<FISMAnimationLayer> Layers;
 
+    /** Bend-away reaction to players and physics actors. CPU backend only. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+    FISMAnimationReactionSettings Reaction;
+
 
     // ===== Distance Falloff =====
 
@@ -194,6 +265,74 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance", meta = (ClampMin = "0.0"))
     float UpdateRateHz = 0.0f;
 
+    /**
+     * Distance within which cells animate on every update, as a fraction of MaxAnimationDistance.
+     * Cells beyond it but within MaxAnimationDistance are the mid tier and animate only every
+     * MidTierUpdateInterval-th update, staggered so the tier's cells take turns.
+     * Only used if MaxAnimationDistance > 0.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance",
+        meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float FullRateDistanceFraction = 0.5f;
+
+    /** Updates between animations of a mid tier cell. 1 = every update, no tiering. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance", meta = (ClampMin = "1"))
+    int32 MidTierUpdateInterval = 2;
+
+    /**
+     * Animated poses closer than this (cm) to the instance's current location, and within
+     * MutationRotationThreshold of its rotation, are not written back. Saves apply and upload
+     * cost for instances that barely move (faded out, calm wind). 0 = write every pose.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance", meta = (ClampMin = "0.0"))
+    float MutationPositionThreshold = 0.05f;
+
+    /** Rotation half of the write threshold, in degrees */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance", meta = (ClampMin = "0.0"))
+    float MutationRotationThreshold = 0.05f;
+
+
+    // ===== Backend =====
+
+    /** Most layers this asset can bake for the material backend; later enabled layers are ignored */
+    static constexpr int32 MaxMaterialLayers = 4;
+
+    /**
+     * Where layers are evaluated. MaterialWPO suits pure visual sway (foliage, banners);
+     * keep CPUTransforms for motion that gameplay reads back.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Backend")
+    EISMAnimationBackend Backend = EISMAnimationBackend::CPUTransforms;
+
+    /**
+     * Collection the material backend writes layer parameters into. Its material function reads,
+     * with N the baked layer index (enabled layers in order, up to MaxMaterialLayers):
+     *   {Prefix}_LayerCount          scalar  baked layers
+     *   {Prefix}_Layer{N}_Wave       vector  (Amplitude, Frequency, PhaseOffset, Waveform enum value)
+     *   {Prefix}_Layer{N}_Axes       vector  (X, Y, Z as 0/1, WindInfluence)
+     *   {Prefix}_Layer{N}_Rotation   scalar  1 = apply as rotation
+     *   {Prefix}_Wind                vector  (WindDirection, WindStrength)
+     *   {Prefix}_Falloff             vector  (MaxAnimationDistance, falloff start distance, 0, 0)
+     * The collection must declare these parameters. FalloffCurve is CPU-only; the material
+     * falloff is linear.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Backend",
+        meta = (EditCondition = "Backend == EISMAnimationBackend::MaterialWPO", EditConditionHides))
+    TObjectPtr<UMaterialParameterCollection> MaterialParameters = nullptr;
+
+    /** Prefix of the parameter names above, so several assets can share one collection */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Backend",
+        meta = (EditCondition = "Backend == EISMAnimationBackend::MaterialWPO", EditConditionHides))
+    FName MaterialParameterPrefix = TEXT("ISMAnim");
+
+    /**
+     * First per-instance custom data slot the baked phase offsets go into, one slot per baked
+     * layer. The ISM's custom data count grows to fit if needed.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Backend",
+        meta = (ClampMin = "0", EditCondition = "Backend == EISMAnimationBackend::MaterialWPO", EditConditionHides))
+    int32 PhaseCustomDataSlot = 0;
+
     // ===== Update Rate =====
 
 
@@ -218,6 +357,35 @@ public:
         return false;
     }
 
+    /** Whether the transformer has anything to evaluate: an enabled layer or the reaction. */
+    bool HasAnyAnimation() const
+    {
+        return HasEnabledLayers() || Reaction.bEnabled;
+    }
+
+    /** Enabled layers the material backend bakes, in order */
+    void GetMaterialLayers(TArray<const FISMAnimationLayer*, TInlineAllocator<MaxMaterialLayers>>& OutLayers) const
+    {
+        for (const FISMAnimationLayer& Layer : Layers)
+        {
+            if (Layer.bEnabled && OutLayers.Num() < MaxMaterialLayers)
+            {
+                OutLayers.Add(&Layer);
+            }
+        }
+    }
+
+    /**
+     * Updates between animations of a cell whose nearest point is Distance from the reference:
+     * 1 in the full rate tier, MidTierUpdateInterval in the mid tier, 0 beyond MaxAnimationDistance.
+     */
+    int32 GetUpdateIntervalForDistance(float Distance) const
+    {
+        if (MaxAnimationDistance <= 0.0f) return 1;
+        if (Distance > MaxAnimationDistance) return 0;
+        return Distance <= MaxAnimationDistance * FullRateDistanceFraction ? 1 : FMath::Max(MidTierUpdateInterval, 1);
+    }
+
     /**
      * Evaluate the combined amplitude falloff scalar for a given distance.
      * Returns 1.0 within the inner range, 0.0 beyond MaxAnimationDistance,
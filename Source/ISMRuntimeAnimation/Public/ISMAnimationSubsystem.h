@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ISMAnimationSubsystem.generated.h"
+
+class FISMAnimationTransformer;
+class UISMAnimationComponent;
+class UISMAnimationDataAsset;
+class UISMBatchSchedulerBase;
+class UISMRuntimeComponent;
+
+/**
+ * Shared animation transformers, one per data asset.
+ *
+ * Components with bShareTransformer hand their runtime component to the asset's transformer
+ * instead of registering their own, so twenty components on one asset cost the scheduler one
+ * registration, one request and one dispatch cycle. The first component to join drives the
+ * transformer's frame parameters (time, reference location, wind, influencers); when it leaves
+ * the next one takes over. The transformer is unregistered when its last component leaves.
+ */
+UCLASS()
+class ISMRUNTIMEANIMATION_API UISMAnimationSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual void Deinitialize() override;
+
+    /**
+     * Add RuntimeComponent as a target of the shared transformer for Data, creating and
+     * registering it with Scheduler first if needed. Returns null if registration failed.
+     */
+    TSharedPtr<FISMAnimationTransformer> AcquireSharedTransformer(
+        UISMAnimationDataAsset* Data,
+        UISMRuntimeComponent* RuntimeComponent,
+        UISMBatchSchedulerBase* Scheduler,
+        UISMAnimationComponent* User);
+
+    /** Undo AcquireSharedTransformer for User; the last user out unregisters the transformer. */
+    void ReleaseSharedTransformer(UISMAnimationDataAsset* Data, UISMAnimationComponent* User);
+
+    /** Whether User is the one component pushing frame parameters to Data's transformer */
+    bool IsSharedTransformerDriver(const UISMAnimationDataAsset* Data, const UISMAnimationComponent* User) const;
+
+    /** Shared transformers currently registered */
+    UFUNCTION(BlueprintCallable, Category = "ISM Animation")
+    int32 GetNumSharedTransformers() const { return SharedTransformers.Num(); }
+
+private:
+    struct FSharedUser
+    {
+        TWeakObjectPtr<UISMAnimationComponent> Component;
+        TWeakObjectPtr<UISMRuntimeComponent> RuntimeComponent;
+    };
+
+    struct FSharedTransformer
+    {
+        TSharedPtr<FISMAnimationTransformer> Transformer;
+        TWeakObjectPtr<UISMBatchSchedulerBase> Scheduler;
+
+        /** Join order; the first valid entry drives frame parameters */
+        TArray<FSharedUser> Users;
+    };
+
+    TMap<TObjectKey<UISMAnimationDataAsset>, FSharedTransformer> SharedTransformers;
+};
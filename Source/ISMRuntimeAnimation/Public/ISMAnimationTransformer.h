@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Batching/ISMBatchTransformer.h"
 #include "ISMAnimationDataAsset.h"
+#include "ISMWindFieldSubsystem.h"
+#include <atomic>
 
 // Forward declarations
 class UISMRuntimeComponent;
@@ -63,16 +65,98 @@ struct FISMAnimationFrameParams
     float WindStrength = 1.0f;
 };
 
+/**
+ * Skips writes that would not visibly move an instance: an animated pose within both thresholds
+ * of the instance's current (snapshotted) pose is dropped. Built once per chunk from the data asset.
+ */
+struct FISMAnimationWriteFilter
+{
+    /** Squared position threshold; < 0 disables the filter */
+    double MaxDistanceSquared = -1.0;
+
+    /** |Dot| of two unit quaternions at least this far apart is below it: cos(threshold / 2) */
+    double MinQuatDot = 1.0;
+
+    explicit FISMAnimationWriteFilter(const UISMAnimationDataAsset& Data);
+
+    bool IsNegligible(const FVector& CurrentLocation, const FQuat& CurrentRotation, const FTransform& Target) const
+    {
+        return MaxDistanceSquared >= 0.0
+            && FVector::DistSquared(CurrentLocation, Target.GetLocation()) <= MaxDistanceSquared
+            && FMath::Abs(CurrentRotation | Target.GetRotation()) >= MinQuatDot;
+    }
+};
+
 struct FISMInstanceCaptureData
 {
     FTransform OriginalTransform;
 	float Rand = 0.0f;
 };
 
+/**
+ * Spring state of the reactive layer for one cell, one entry per entry of its capture.
+ * Unlike the capture it points from, this is mutated: by the single chunk that animates the cell
+ * each cycle. A new capture starts a new, settled state.
+ */
+struct FISMAnimationReactionCell
+{
+    /** Tilt of each instance's top (degrees, world XY: the direction it leans) and its rate */
+    TArray<float> BendX;
+    TArray<float> BendY;
+    TArray<float> VelocityX;
+    TArray<float> VelocityY;
+
+    /** WorldTime of the last step; < 0 before the first */
+    float LastUpdateTime = -1.0f;
+
+    /** Every entry is upright and still, so cells away from influencers skip the spring */
+    bool bSettled = true;
+};
+
+/** Influencer spheres collected for one frame; immutable once published */
+using FISMAnimationInfluencersPtr = TSharedPtr<const TArray<FSphere>, ESPMode::ThreadSafe>;
+
+/**
+ * Rest poses of one spatial cell, laid out in the order that cell's chunks list their instances.
+ * Immutable once published, so ProcessChunk walks it by position - no lock held, no per-instance
+ * lookup - and a chunk issued for a newer layout simply publishes a new one.
+ */
+struct FISMAnimationCellCapture
+{
+    /** Instance order the arrays are aligned to: the chunk's (sorted) InstanceIndices at capture */
+    TArray<int32> InstanceIndices;
+
+    /** Rest transform per entry of InstanceIndices */
+    TArray<FTransform> RestTransforms;
+
+    /**
+     * ComputeInstancePhaseOffset of enabled layer L for entry I, at [L * LayerStride + I].
+     * Layer-major and zero padded to whole 4-wide vectors, for the vectorized layer kernel.
+     */
+    TArray<float> PhaseOffsets;
+
+    /** Enabled layers when captured */
+    int32 NumLayers = 0;
+
+    /** Distance between consecutive layers in PhaseOffsets: entry count rounded up to 4 */
+    int32 LayerStride = 0;
+
+    /** Mean rest location; where the cell samples the wind field */
+    FVector Centroid = FVector::ZeroVector;
+
+    /** Bounds of the rest locations, for the influencer overlap test */
+    FBox RestBounds = FBox(ForceInit);
+
+    /** Reaction spring state; null when the asset's reaction is off */
+    TSharedPtr<FISMAnimationReactionCell, ESPMode::ThreadSafe> Reaction;
+};
+
 /**
  * Batch transformer that drives procedural per-instance animation on ISM components.
  *
- * Registered with UISMBatchScheduler by UISMAnimationComponent on BeginPlay.
+ * Registered with UISMBatchScheduler by UISMAnimationComponent on BeginPlay, or by
+ * UISMAnimationSubsystem when it serves every component sharing one data asset. Captures are
+ * kept per target component.
  * Each scheduler tick:
  *   1. BuildRequest declares transform read + write masks and a distance-bounded spatial region
  *   2. Scheduler emits one chunk per spatial cell within range
@@ -82,8 +166,9 @@ struct FISMInstanceCaptureData
  * Threading:
  *   - FrameParams is written on the game thread before dispatch (via UpdateFrameParams)
  *   - ProcessChunk reads FrameParams and AnimData by value/const ref - no locking needed
- *   - PerInstanceState is only read/written from ProcessChunk - chunks for the same
- *     component run sequentially in Phase 1, so no contention
+ *   - Cell captures are published on the game thread in OnHandleIssued while earlier chunks may
+ *     still be running; ProcessChunk takes a reference to its cell's capture under
+ *     OriginalDataLock and reads it after releasing the lock
  *
  * Lifetime:
  *   Owned by UISMAnimationComponent as a TSharedPtr.
@@ -100,11 +185,35 @@ public:
 
     virtual ~FISMAnimationTransformer() override;
 
+    // ===== Targets =====
+
+    /**
+     * Animate another component with this transformer. A transformer shared by every component
+     * using one data asset (UISMAnimationSubsystem) plans all of them in a single request.
+     * Game thread only; no-op if the component is already a target.
+     */
+    void AddTarget(UISMRuntimeComponent* InTargetComponent);
+
+    /** Stop animating a component and drop its captures. Instances keep their last written pose. */
+    void RemoveTarget(const UISMRuntimeComponent* InTargetComponent);
+
+    int32 GetNumTargets() const;
+
 
     // ===== IISMBatchTransformer =====
 
     virtual FName GetTransformerName() const override { return TransformerName; }
 
+    /**
+     * Compute the per-instance phase offset based on the layer's PhaseMode.
+     * Result is in [0, 1] and is added to the base phase before waveform sampling.
+     * Public so the material backend bakes exactly the offsets the CPU path would use.
+     */
+    static float ComputeInstancePhaseOffset(
+        const FISMAnimationLayer& Layer,
+        const FTransform& InstanceTransform,
+        int32 InstanceIndex);
+
 
     void SetDirty();
     /**
@@ -118,8 +227,10 @@ public:
 
     /**
      * Declares transform read + write masks.
-     * Spatial bounds: sphere around FrameParams.ReferenceLocation with radius
+     * Spatial bounds: box around FrameParams.ReferenceLocation with half extent
      * equal to AnimData->MaxAnimationDistance (or unbounded if -1).
+     * With a distance limit, chunk relevance drops cells whose nearest point is out of range
+     * and runs mid tier cells every MidTierUpdateInterval-th update, staggered per cell.
      */
     virtual FISMSnapshotRequest BuildRequest() override;
 
@@ -160,6 +271,18 @@ public:
      */
     void UpdateFrameParams(const FISMAnimationFrameParams& Params);
 
+    /**
+     * Wind field to sample instead of FrameParams' wind, once per cell at its centroid; null
+     * reverts to FrameParams. Game thread only; chunks already running keep the field they took.
+     */
+    void UpdateWindField(FISMWindFieldSnapshotPtr InWindField);
+
+    /**
+     * Influencer spheres the reactive layer bends instances away from this frame. Game thread
+     * only; chunks already running keep the list they took.
+     */
+    void UpdateInfluencers(FISMAnimationInfluencersPtr InInfluencers);
+
 
     // ===== Debug / Stats =====
 
@@ -169,6 +292,9 @@ public:
     /** Number of instances skipped (out of range) in the most recently completed cycle. */
     int32 GetLastSkippedInstanceCount() const { return LastSkippedInstanceCount; }
 
+    /** Number of poses not written in the most recently completed cycle because they were within the write thresholds. */
+    int32 GetLastUnchangedInstanceCount() const { return LastUnchangedInstanceCount; }
+
 
 private:
 
@@ -180,32 +306,86 @@ private:
      * delta transform to add to its base transform.
      * Called per-instance inside ProcessChunk - must be thread safe and allocation-free.
      *
-     * @param BaseTransform     The instance's current world transform (from snapshot)
-     * @param InstanceIndex     Instance index - used for index-based phase variation
+     * @param BaseTransform     The instance's rest transform
+     * @param PhaseOffsets      Captured phase offset of the first enabled layer
+     * @param PhaseStride       Distance to the next enabled layer's offset
      * @param FalloffScale      Distance falloff multiplier [0,1]
      * @param InFrameParams     Copy of frame params (captured at chunk dispatch time)
      */
     FTransform EvaluateLayers(
         const FTransform& BaseTransform,
-        int32 InstanceIndex,
+        const float* PhaseOffsets,
+        int32 PhaseStride,
         float FalloffScale,
         const FISMAnimationFrameParams& InFrameParams) const;
 
+    /**
+     * Layer-major evaluation of a whole cell whose capture is aligned with the chunk.
+     * Falloff is evaluated once per instance, and instances out of range are settled back to
+     * rest; then each layer samples its waveform four instances at a time with vector math and
+     * accumulates into SoA translation and rotation streams, and transforms are composed in a
+     * final pass, tilted by Reaction when given. Without it, same result as EvaluateLayers.
+     * Thread safe and allocation-bounded (a few scratch streams per chunk).
+     */
+    void EvaluateCellLayerMajor(
+        const FISMAnimationCellCapture& Cell,
+        const FISMInstanceSoASnapshot& Current,
+        const UISMAnimationDataAsset& Data,
+        const FISMAnimationFrameParams& InFrameParams,
+        const FISMAnimationWriteFilter& WriteFilter,
+        const FISMAnimationReactionCell* Reaction,
+        FISMBatchMutationResult& Result,
+        int32& OutAnimatedCount,
+        int32& OutSkippedCount,
+        int32& OutUnchangedCount) const;
+
+    /**
+     * Advance a cell's reaction springs to WorldTime against the influencers overlapping it.
+     * Returns false when the cell is settled and nothing overlaps, so there is no bend to apply.
+     */
+    static bool StepReaction(
+        FISMAnimationReactionCell& Reaction,
+        const FISMAnimationCellCapture& Cell,
+        TConstArrayView<FSphere> Influencers,
+        const FISMAnimationReactionSettings& Settings,
+        float WorldTime);
+
+    /**
+     * Add Target for the instance at SnapshotIndex of Current unless WriteFilter finds it
+     * negligible. Returns whether it was written.
+     */
+    static bool WriteIfChanged(
+        const FISMInstanceSoASnapshot& Current,
+        int32 SnapshotIndex,
+        const FTransform& Target,
+        const FISMAnimationWriteFilter& WriteFilter,
+        FISMBatchMutationResult& Result);
+
+    /**
+     * SampleWaveform for NumPadded phases (BasePhase + Offsets[i]), a multiple of 4.
+     * Sine, Triangle and Square run 4-wide; Perlin falls back to the scalar sampler.
+     */
+    static void SampleWaveformBatch(EISMAnimationWaveform Waveform, float BasePhase, const float* Offsets, int32 NumPadded, float* OutWave);
+
+    /**
+     * Per-unit-displacement direction of a layer: its active axes, blended toward the scaled
+     * wind direction by WindInfluence. A layer's displacement is its wave value times this.
+     */
+    static FVector GetLayerDisplacementAxis(const FISMAnimationLayer& Layer, const FISMAnimationFrameParams& InFrameParams);
+
     /**
      * Evaluate a single animation layer for one instance.
      * Returns the displacement vector or rotation delta contributed by this layer.
      *
      * @param Layer             The layer to evaluate
-     * @param BaseTransform     Instance world transform
-     * @param InstanceIndex     For index-based phase variation
+     * @param InstanceOffset    Per-instance phase offset (ComputeInstancePhaseOffset)
      * @param InFrameParams     Frame context (time, wind, etc.)
      * @param OutTranslation    Additive world-space translation from this layer
      * @param OutRotation       Additive local-space rotation from this layer
      */
     void EvaluateLayer(
         const FISMAnimationLayer& Layer,
-        const FTransform& BaseTransform,
-        int32 InstanceIndex,
+        float InstanceOffset,
         const FISMAnimationFrameParams& InFrameParams,
         FVector& OutTranslation,
         FRotator& OutRotation) const;
@@ -216,20 +396,31 @@ private:
      */
     static float SampleWaveform(EISMAnimationWaveform Waveform, float Phase);
 
-    /**
-     * Compute the per-instance phase offset based on the layer's PhaseMode.
-     * Result is in [0, 1] and is added to the base phase before waveform sampling.
-     */
-    static float ComputeInstancePhaseOffset(
-        const FISMAnimationLayer& Layer,
-        const FTransform& InstanceTransform,
-        int32 InstanceIndex);
 
 
     // ===== State =====
 
-    /** The component this transformer writes to. */
-    TWeakObjectPtr<UISMRuntimeComponent> TargetComponent;
+    /** Captures of one target component; instance indices and cells are per component */
+    struct FTargetState
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+
+        /**
+         * Rest pose per instance, captured the first time a chunk containing it is issued.
+         * Only read while building cell captures, so instances keep their rest pose across cells.
+         */
+        TMap<int32, FISMInstanceCaptureData> OriginalData;
+
+        /** Dense per-cell view of OriginalData plus baked phase offsets; what ProcessChunk reads */
+        TMap<FIntVector, TSharedPtr<const FISMAnimationCellCapture, ESPMode::ThreadSafe>> CellCaptures;
+    };
+
+    /** OriginalDataLock held; null if the component is not a target */
+    FTargetState* FindTarget(const UISMRuntimeComponent* Component);
+    const FTargetState* FindTarget(const UISMRuntimeComponent* Component) const;
+
+    /** The components this transformer writes to. Guarded by OriginalDataLock. */
+    TArray<FTargetState> Targets;
 
     /** Animation configuration. Const after construction - safe to read on any thread. */
     TWeakObjectPtr<UISMAnimationDataAsset> AnimData;
@@ -256,15 +447,30 @@ private:
 
     int32 LastAnimatedInstanceCount = 0;
     int32 LastSkippedInstanceCount = 0;
+    int32 LastUnchangedInstanceCount = 0;
 
     /** Accumulators updated during ProcessChunk, committed to Last* on OnRequestComplete. */
-    int32 CycleAnimatedCount = 0;
-    int32 CycleSkippedCount = 0;
+    std::atomic<int32> CycleAnimatedCount{ 0 };
+    std::atomic<int32> CycleSkippedCount{ 0 };
+    std::atomic<int32> CycleUnchangedCount{ 0 };
 
 
-	FISMInstanceCaptureData CaptureInstanceData(FISMInstanceSnapshot InstanceSnapshot) const;
+	FISMInstanceCaptureData CaptureInstanceData(const FTransform& OriginalTransform) const;
     
     FRandomStream RandomStream;
-    TMap<int32, FISMInstanceCaptureData> OriginalData;
+
+    /**
+     * Build and publish a capture for the chunk's cell if its instance layout or the layer
+     * count changed since the last one. Game thread, OriginalDataLock held for write.
+     */
+    void UpdateCellCapture(FTargetState& Target, const FISMBatchSnapshot& Chunk, int32 NumLayers);
+
+    /** Shared world wind; swapped under OriginalDataLock since chunks copy it off the game thread */
+    FISMWindFieldSnapshotPtr WindField;
+
+    /** Reactive layer influencers; swapped under OriginalDataLock like WindField */
+    FISMAnimationInfluencersPtr Influencers;
+
+    mutable FRWLock OriginalDataLock;
 	bool bOriginalTransformsInitialized = false;
 };
\ No newline at end of file
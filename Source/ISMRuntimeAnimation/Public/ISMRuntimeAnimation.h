@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/** LLM tag for this module's hot paths, shown as ISMRuntime/Animation (see ISMRuntimeProfiling.h) */
+LLM_DECLARE_TAG_API(ISMRuntime_Animation, ISMRUNTIMEANIMATION_API);
 
 
 class FISMRuntimeAnimation : public IModuleInterface
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ISMWindFieldSubsystem.generated.h"
+
+/**
+ * One frame of the world wind field: a square XY grid of wind direction and strength centred near
+ * the camera. Immutable once published, so transformers sample it on worker threads without locks.
+ */
+struct ISMRUNTIMEANIMATION_API FISMWindFieldSnapshot
+{
+    /** World XY of the centre of cell (0, 0) */
+    FVector2D Origin = FVector2D::ZeroVector;
+
+    float CellSize = 1000.0f;
+
+    /** Cells per side */
+    int32 Resolution = 0;
+
+    /** Row-major (Y outer): xyz = unit wind direction, w = strength */
+    TArray<FVector4f> Cells;
+
+    /**
+     * Bilinear sample at a world location; locations off the grid take the nearest edge.
+     * The direction is renormalized after blending.
+     */
+    void Sample(const FVector& Location, FVector& OutDirection, float& OutStrength) const;
+};
+
+using FISMWindFieldSnapshotPtr = TSharedPtr<const FISMWindFieldSnapshot, ESPMode::ThreadSafe>;
+
+/**
+ * World wind shared by every animation component that opts in (UISMAnimationComponent::bUseWindField).
+ *
+ * A weather system sets the base wind once per change here instead of on every component. Each
+ * frame the subsystem fills a low resolution grid around the first player's camera: the base wind
+ * modulated by gusts, a noise pattern anchored in world space that rolls downwind at GustSpeed, so
+ * neighbouring instances sway together and a gust visibly travels across a field. The grid is
+ * published as an immutable snapshot each frame; transformers sample it once per cell.
+ *
+ * Only ticks while at least one consumer is registered.
+ */
+UCLASS()
+class ISMRUNTIMEANIMATION_API UISMWindFieldSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMWindFieldSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    // ===== Wind =====
+
+    /** Prevailing wind direction; flattened to XY and normalized when the field is built */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind")
+    FVector BaseDirection = FVector(1.0f, 0.0f, 0.0f);
+
+    /** Prevailing wind strength, in the same units as UISMAnimationComponent::WindStrength */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind", meta = (ClampMin = "0.0"))
+    float BaseStrength = 1.0f;
+
+    /** Strength added at a gust's peak and taken away in its lull, as a fraction of BaseStrength */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind", meta = (ClampMin = "0.0"))
+    float GustStrength = 0.5f;
+
+    /** Speed gusts travel downwind (cm/s) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind", meta = (ClampMin = "0.0"))
+    float GustSpeed = 800.0f;
+
+    /** Typical distance between gust fronts (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind", meta = (ClampMin = "1.0"))
+    float GustScale = 4000.0f;
+
+    /** Largest swing of the wind direction inside a gust, in degrees of yaw */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind", meta = (ClampMin = "0.0", ClampMax = "180.0"))
+    float GustDirectionVariance = 15.0f;
+
+    // ===== Grid =====
+
+    /** Width of a grid cell (cm). Anything finer than a gust front is wasted. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind|Grid", meta = (ClampMin = "100.0"))
+    float CellSize = 1000.0f;
+
+    /** Cells per side; the grid covers CellSize * Resolution around the camera */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Animation|Wind|Grid", meta = (ClampMin = "2", ClampMax = "256"))
+    int32 Resolution = 32;
+
+    /** Set the prevailing wind; gusts keep rolling on top of it */
+    UFUNCTION(BlueprintCallable, Category = "ISM Animation|Wind")
+    void SetWind(FVector InDirection, float InStrength);
+
+    /** Wind at a world location from the latest published field */
+    UFUNCTION(BlueprintCallable, Category = "ISM Animation|Wind")
+    void SampleWind(FVector Location, FVector& OutDirection, float& OutStrength) const;
+
+    /** Latest published field; null until the first tick with a consumer. Game thread. */
+    FISMWindFieldSnapshotPtr GetSnapshot() const { return Snapshot; }
+
+    /** Start or stop keeping the field up to date on behalf of a consumer. Calls must pair. */
+    void RegisterConsumer();
+    void UnregisterConsumer();
+
+private:
+    /** Build the grid for this frame around Center */
+    void BuildSnapshot(const FVector& Center, double Time);
+
+    FISMWindFieldSnapshotPtr Snapshot;
+
+    int32 NumConsumers = 0;
+};
@@ -3,10 +3,172 @@
 #include "Batching/ISMBatchTypes.h"
 #include "ISMRuntimeComponent.h"
 #include "ISMRuntimeSubsystem.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMSpatialIndex.h"
 #include "Misc/ScopeLock.h"
+#include "Algo/AnyOf.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
 
 DEFINE_LOG_CATEGORY(LogISMBatching);
 
+namespace
+{
+    bool SharesTargetComponent(const FISMSnapshotRequest& A, const FISMSnapshotRequest& B)
+    {
+        return Algo::AnyOf(A.TargetComponents, [&B](const TWeakObjectPtr<UISMRuntimeComponent>& Component)
+            {
+                return B.TargetComponents.Contains(Component);
+            });
+    }
+
+    /** Snapshot position of InstanceIndex; chunk plans list instances in ascending index order */
+    int32 FindSnapshotInstance(const FISMBatchSnapshot& Snapshot, int32 InstanceIndex)
+    {
+        if (Snapshot.SoA.Num() > 0)
+            return Algo::BinarySearch(Snapshot.SoA.InstanceIndices, InstanceIndex);
+        return Algo::BinarySearchBy(Snapshot.Instances, InstanceIndex, &FISMInstanceSnapshot::InstanceIndex);
+    }
+}
+
+
+// ============================================================
+//  FISMBatchBufferPool
+// ============================================================
+
+#pragma region POOL
+
+void FISMBatchBufferPool::LeaseResultStorage(FISMBatchMutationResult& Result, int32 ExpectedMutations)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (FreeMutations.Num() > 0)
+            Result.Mutations = FreeMutations.Pop(EAllowShrinking::No);
+        else if (ExpectedMutations > 0)
+            ++NumLeaseMisses;
+        if (FreeStreams.Num() > 0)
+            Result.Streams = FreeStreams.Pop(EAllowShrinking::No);
+    }
+    Result.Mutations.Reserve(ExpectedMutations);
+}
+
+void FISMBatchBufferPool::ReturnResultStorage(FISMBatchMutationResult&& Result)
+{
+    // Element destructors run outside the lock
+    const bool bKeepMutations = Result.Mutations.Max() > 0;
+    const bool bKeepStreams = Result.Streams.TransformIndices.Max() > 0 || Result.Streams.CustomDataWrites.Max() > 0 || Result.Streams.StateFlagsWrites.Max() > 0;
+    Result.Mutations.Reset();
+    Result.Streams.Reset();
+
+    FScopeLock ScopeLock(&Lock);
+    if (bKeepMutations && FreeMutations.Num() < MaxFreeBuffers)
+        FreeMutations.Add(MoveTemp(Result.Mutations));
+    if (bKeepStreams && FreeStreams.Num() < MaxFreeBuffers)
+        FreeStreams.Add(MoveTemp(Result.Streams));
+}
+
+void FISMBatchBufferPool::LeaseSnapshotStorage(FISMBatchSnapshot& Snapshot, bool bStructureOfArrays)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (bStructureOfArrays)
+    {
+        if (FreeSoA.Num() > 0)
+            Snapshot.SoA = FreeSoA.Pop(EAllowShrinking::No);
+        else
+            ++NumLeaseMisses;
+    }
+    else if (FreeInstances.Num() > 0)
+    {
+        Snapshot.Instances = FreeInstances.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        ++NumLeaseMisses;
+    }
+}
+
+void FISMBatchBufferPool::ReturnSnapshotStorage(FISMBatchSnapshot&& Snapshot)
+{
+    FISMInstanceSoASnapshot& SoA = Snapshot.SoA;
+    if (SoA.InstanceIndices.Max() > 0)
+    {
+        SoA.InstanceIndices.Reset();
+        SoA.Locations.Reset();
+        SoA.Rotations.Reset();
+        SoA.Scales.Reset();
+        SoA.CustomData.Reset();
+        SoA.CustomDataStride = 0;
+        SoA.StateFlags.Reset();
+
+        FScopeLock ScopeLock(&Lock);
+        if (FreeSoA.Num() < MaxFreeBuffers)
+            FreeSoA.Add(MoveTemp(SoA));
+    }
+
+    // Entries are kept, not reset, so their custom data arrays survive to the next lease
+    if (Snapshot.Instances.Max() > 0)
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (FreeInstances.Num() < MaxFreeBuffers)
+            FreeInstances.Add(MoveTemp(Snapshot.Instances));
+    }
+}
+
+int32 FISMBatchBufferPool::GetNumFreeMutationBuffers() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FreeMutations.Num();
+}
+
+int32 FISMBatchBufferPool::GetNumFreeStreamBuffers() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FreeStreams.Num();
+}
+
+int32 FISMBatchBufferPool::GetNumFreeSnapshotBuffers() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FreeInstances.Num() + FreeSoA.Num();
+}
+
+uint64 FISMBatchBufferPool::GetNumLeaseMisses() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumLeaseMisses;
+}
+
+SIZE_T FISMBatchBufferPool::GetAllocatedSize() const
+{
+    FScopeLock ScopeLock(&Lock);
+    SIZE_T Size = FreeMutations.GetAllocatedSize() + FreeStreams.GetAllocatedSize()
+        + FreeInstances.GetAllocatedSize() + FreeSoA.GetAllocatedSize();
+    for (const TArray<FISMInstanceMutation>& Mutations : FreeMutations)
+        Size += Mutations.GetAllocatedSize();
+    for (const FISMMutationStreams& Streams : FreeStreams)
+        Size += Streams.GetAllocatedSize();
+    for (const TArray<FISMInstanceSnapshot>& Instances : FreeInstances)
+    {
+        Size += Instances.GetAllocatedSize();
+        for (const FISMInstanceSnapshot& Instance : Instances)
+            Size += Instance.CustomData.GetAllocatedSize();
+    }
+    for (const FISMInstanceSoASnapshot& SoA : FreeSoA)
+        Size += SoA.GetAllocatedSize();
+    return Size;
+}
+
+void FISMBatchBufferPool::Empty()
+{
+    FScopeLock ScopeLock(&Lock);
+    FreeMutations.Empty();
+    FreeStreams.Empty();
+    FreeInstances.Empty();
+    FreeSoA.Empty();
+}
+
+#pragma endregion
+
 
 // ============================================================
 //  UISMBatchSchedulerBase
@@ -14,9 +176,13 @@ DEFINE_LOG_CATEGORY(LogISMBatching);
 
 #pragma region BASE
 
+const FName UISMBatchSchedulerBase::FrameBudgetClient(TEXT("BatchScheduler"));
+
 void UISMBatchSchedulerBase::Initialize(UISMRuntimeSubsystem* InOwningSubsystem)
 {
     OwningSubsystem = InOwningSubsystem;
+    BufferPool = MakeUnique<FISMBatchBufferPool>();
+    BufferPool->MaxFreeBuffers = FMath::Max(BufferPool->MaxFreeBuffers, Settings.MaxConcurrentChunks * 2);
     bInitialized = true;
 }
 
@@ -25,6 +191,9 @@ void UISMBatchSchedulerBase::Deinitialize()
     if (!bInitialized) return;
     bInitialized = false;
     UnregisterAllTransformers();
+    TransformerStages.Empty();
+    DeltaCursors.Empty();
+    BufferPool.Reset();
 }
 
 // ===== Transformer Registry =====
@@ -69,6 +238,7 @@ void UISMBatchSchedulerBase::UnregisterTransformer(FName TransformerName)
         {
             return Entry.Name == TransformerName;
         });
+    DeltaCursors.Remove(TransformerName);
 }
 
 void UISMBatchSchedulerBase::UnregisterAllTransformers()
@@ -85,6 +255,7 @@ void UISMBatchSchedulerBase::UnregisterAllTransformers()
             TEXT("UnregisterAllTransformers: %d cycles still active - clearing."), ActiveCycles.Num());
         ActiveCycles.Empty();
     }
+    ForwardedSnapshots.Empty();
 
     if (RegisteredTransformers.Num() == 0) return;
 
@@ -100,6 +271,48 @@ bool UISMBatchSchedulerBase::IsTransformerRegistered(FName TransformerName) cons
         });
 }
 
+int32 UISMBatchSchedulerBase::GetTransformerPriority(FName TransformerName) const
+{
+    const FISMTransformerEntry* Entry = RegisteredTransformers.FindByPredicate([TransformerName](const FISMTransformerEntry& E)
+        {
+            return E.Name == TransformerName;
+        });
+    return Entry ? Entry->Priority : 0;
+}
+
+int32 UISMBatchSchedulerBase::GetTransformerStage(FName TransformerName) const
+{
+    const int32* Stage = TransformerStages.Find(TransformerName);
+    return Stage ? *Stage : INDEX_NONE;
+}
+
+FISMBatchSchedulerStats UISMBatchSchedulerBase::GetSchedulerStats() const
+{
+    FISMBatchSchedulerStats Stats;
+    Stats.DeferredTransformerCount = NumDeferredTransformers;
+    Stats.InFlightChunkCount = GetInFlightChunkCount();
+    Stats.LastDispatchTimeMs = static_cast<float>(DispatchSecondsThisTick * 1000.0);
+    return Stats;
+}
+
+SIZE_T UISMBatchSchedulerBase::GetAllocatedSize() const
+{
+    SIZE_T Size = RegisteredTransformers.GetAllocatedSize() + InFlightChunks.GetAllocatedSize()
+        + ActiveCycles.GetAllocatedSize() + TransformerStages.GetAllocatedSize() + DeltaCursors.GetAllocatedSize();
+    for (const FISMTransformerRequestCycle& Cycle : ActiveCycles)
+        Size += Cycle.PendingDeltaCursors.GetAllocatedSize();
+    for (const auto& Pair : DeltaCursors)
+        Size += Pair.Value.GetAllocatedSize();
+
+    Size += ForwardedSnapshots.GetAllocatedSize();
+    for (const TPair<uint32, FISMBatchSnapshot>& Pair : ForwardedSnapshots)
+        Size += Pair.Value.GetAllocatedSize();
+
+    if (BufferPool)
+        Size += sizeof(FISMBatchBufferPool) + BufferPool->GetAllocatedSize();
+    return Size;
+}
+
 TArray<FName> UISMBatchSchedulerBase::GetTransformersWithOpenHandles() const
 {
     TArray<FName> Result;
@@ -115,38 +328,497 @@ TArray<FName> UISMBatchSchedulerBase::GetTransformersWithOpenHandles() const
 
 void UISMBatchSchedulerBase::DispatchDirtyTransformers()
 {
-    for (FISMTransformerEntry& Entry : RegisteredTransformers)
+    const double StartTime = FPlatformTime::Seconds();
+    DispatchSecondsThisTick = 0.0;
+    NumDeferredTransformers = 0;
+
+    // Requests first, so the tick's transformers can be ordered into stages before any dispatches
+    TArray<FISMStagedDispatch> Staged;
+    for (const FISMTransformerEntry& Entry : RegisteredTransformers)
     {
         if (!Entry.Transformer || !Entry.bRegistered) continue;
         if (!Entry.Transformer->IsDirty()) continue;
-        DispatchTransformer(Entry);
-        Entry.Transformer->ClearDirty();
+
+        FISMStagedDispatch& Dispatch = Staged.AddDefaulted_GetRef();
+        Dispatch.Transformer = Entry.Transformer;
+        Dispatch.Name = Entry.Name;
+        Dispatch.Request = Entry.Transformer->BuildRequest();
+        Dispatch.DeferredTicks = Entry.DeferredTicks;
+        Dispatch.DispatchCount = Entry.DispatchCount;
+    }
+    if (Staged.IsEmpty()) return;
+
+    AssignDispatchStages(Staged);
+
+    // Links are built bottom-up; a consumer always sits later in Staged than its upstream
+    TArray<TSharedPtr<const FISMChainLink>> ConsumerLinks;
+    ConsumerLinks.SetNum(Staged.Num());
+    for (int32 Idx = Staged.Num() - 1; Idx >= 0; --Idx)
+    {
+        const int32 ConsumerIdx = Staged[Idx].ConsumerIndex;
+        if (ConsumerIdx == INDEX_NONE) continue;
+
+        TSharedRef<FISMChainLink> Link = MakeShared<FISMChainLink>();
+        Link->Transformer = Staged[ConsumerIdx].Transformer;
+        Link->TransformerName = Staged[ConsumerIdx].Name;
+        Link->Request = Staged[ConsumerIdx].Request;
+        Link->Downstream = ConsumerLinks[ConsumerIdx];
+        if (Link->Downstream)
+        {
+            Link->Request.ReadMask |= Link->Downstream->Request.ReadMask;
+            for (const FName& Column : Link->Downstream->Request.ReadColumns)
+                Link->Request.ReadColumns.AddUnique(Column);
+        }
+        ConsumerLinks[Idx] = Link;
+    }
+
+    TArray<int32> DispatchOrder;
+    DispatchOrder.Reserve(Staged.Num());
+    for (int32 Idx = 0; Idx < Staged.Num(); ++Idx)
+        DispatchOrder.Add(Idx);
+    // Entries of one stage never conflict, so carried-over ones can move to the front of theirs
+    DispatchOrder.StableSort([&Staged](int32 A, int32 B)
+        {
+            return Staged[A].Stage < Staged[B].Stage ||
+                (Staged[A].Stage == Staged[B].Stage && Staged[A].DeferredTicks > Staged[B].DeferredTicks);
+        });
+
+    // Every cycle opens first: sync chunks, chained ones included, resolve while dispatching
+    for (const FISMStagedDispatch& Dispatch : Staged)
+        BeginDispatchCycle(Dispatch.Name);
+
+    const double BudgetSeconds = GetDispatchBudgetSeconds();
+    bool bOverBudget = false;
+    TBitArray<> Deferred(false, Staged.Num());
+
+    for (int32 Idx : DispatchOrder)
+    {
+        const FISMStagedDispatch& Dispatch = Staged[Idx];
+
+        // A consumer follows its upstream: chained chunks are already counted when the upstream went,
+        // and have nothing to chain onto when it was deferred
+        const bool bDefer = Dispatch.UpstreamIndex != INDEX_NONE ? Deferred[Dispatch.UpstreamIndex] : bOverBudget;
+        if (bDefer)
+        {
+            Deferred[Idx] = true;
+            continue;
+        }
+
+        TransformerStages.Add(Dispatch.Name, Dispatch.Stage);
+
+        // An earlier transformer's sync chunk may have unregistered this one
+        if (!IsTransformerRegistered(Dispatch.Name)) continue;
+
+        // Components the upstream covers already get chained chunks
+        TConstArrayView<TWeakObjectPtr<UISMRuntimeComponent>> ChainedComponents;
+        if (Dispatch.UpstreamIndex != INDEX_NONE)
+            ChainedComponents = Staged[Dispatch.UpstreamIndex].Request.TargetComponents;
+
+        DispatchTransformer(Dispatch, ConsumerLinks[Idx], ChainedComponents);
+        Dispatch.Transformer->ClearDirty();
+
+        bOverBudget = BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds;
+    }
+
+    for (const FISMStagedDispatch& Dispatch : Staged)
+        EndDispatchCycle(Dispatch.Name);
+
+    // Deferred transformers stay dirty and are picked up again next tick
+    for (int32 Idx = 0; Idx < Staged.Num(); ++Idx)
+    {
+        FISMTransformerEntry* Entry = RegisteredTransformers.FindByPredicate([&Staged, Idx](const FISMTransformerEntry& E)
+            {
+                return E.Name == Staged[Idx].Name;
+            });
+        if (!Entry) continue;
+
+        Entry->DeferredTicks = Deferred[Idx] ? Entry->DeferredTicks + 1 : 0;
+        Entry->DispatchCount += Deferred[Idx] ? 0 : 1;
+        NumDeferredTransformers += Deferred[Idx] ? 1 : 0;
+    }
+
+    ReportFrameBudgetDeferred(NumDeferredTransformers);
+    DispatchSecondsThisTick = FPlatformTime::Seconds() - StartTime;
+}
+
+double UISMBatchSchedulerBase::ClampToFrameBudget(double OwnBudgetSeconds) const
+{
+    const UISMRuntimeSubsystem* Subsystem = OwningSubsystem.Get();
+    return Subsystem ? Subsystem->GetFrameBudget().ClampBudgetSeconds(FrameBudgetClient, OwnBudgetSeconds) : OwnBudgetSeconds;
+}
+
+void UISMBatchSchedulerBase::ReportFrameBudgetDeferred(int32 NumItems) const
+{
+    if (UISMRuntimeSubsystem* Subsystem = OwningSubsystem.Get(); Subsystem && NumItems > 0)
+    {
+        Subsystem->GetFrameBudget().ReportDeferred(FrameBudgetClient, NumItems);
+    }
+}
+
+void UISMBatchSchedulerBase::AssignDispatchStages(TArray<FISMStagedDispatch>& Staged)
+{
+    // Staged is in priority order and every ordering edge points from an earlier entry to a later
+    // one, so a single forward pass settles each stage
+    for (int32 Later = 0; Later < Staged.Num(); ++Later)
+    {
+        FISMStagedDispatch& Dispatch = Staged[Later];
+        const FName Upstream = Dispatch.Request.ConsumesOutputOf;
+
+        for (int32 Earlier = 0; Earlier < Later; ++Earlier)
+        {
+            FISMStagedDispatch& Ahead = Staged[Earlier];
+            const bool bConsumes = !Upstream.IsNone() && Upstream == Ahead.Name;
+            const bool bConflicts = Ahead.Request.ConflictsWith(Dispatch.Request) && SharesTargetComponent(Ahead.Request, Dispatch.Request);
+            if (!bConsumes && !bConflicts) continue;
+
+            Dispatch.Stage = FMath::Max(Dispatch.Stage, Ahead.Stage + 1);
+
+            if (bConsumes && Ahead.ConsumerIndex == INDEX_NONE &&
+                Ahead.Request.bStructureOfArrays == Dispatch.Request.bStructureOfArrays)
+            {
+                Ahead.ConsumerIndex = Later;
+                Dispatch.UpstreamIndex = Earlier;
+            }
+        }
+
+        if (!Upstream.IsNone() && Dispatch.UpstreamIndex == INDEX_NONE)
+        {
+            UE_LOG(LogISMBatching, Verbose, TEXT("DispatchDirtyTransformers: %s cannot consume %s this tick; snapshotting it separately"),
+                *Dispatch.Name.ToString(), *Upstream.ToString());
+        }
     }
 }
 
-void UISMBatchSchedulerBase::DispatchTransformer(FISMTransformerEntry& Entry)
+void UISMBatchSchedulerBase::DispatchTransformer(
+    const FISMStagedDispatch& Dispatch,
+    const TSharedPtr<const FISMChainLink>& Consumer,
+    TConstArrayView<TWeakObjectPtr<UISMRuntimeComponent>> ChainedComponents)
 {
-    IISMBatchTransformer* Transformer = Entry.Transformer;
-    FISMSnapshotRequest Request = Transformer->BuildRequest();
+    if (Dispatch.Request.TargetComponents.IsEmpty()) return;
 
-    TArray<TWeakObjectPtr<UISMRuntimeComponent>> Targets = Request.TargetComponents;
-    if (Targets.IsEmpty()) return;
+    CurrentDispatchName = Dispatch.Name;
+    CurrentDispatchCount = Dispatch.DispatchCount;
+    ++CurrentDispatchSerial;
+
+    // Consumers read this transformer's chunk snapshots, so they must carry the consumers' fields too
+    FISMSnapshotRequest Request = Dispatch.Request;
+    if (Consumer)
+    {
+        Request.ReadMask |= Consumer->Request.ReadMask;
+        for (const FName& Column : Consumer->Request.ReadColumns)
+            Request.ReadColumns.AddUnique(Column);
+    }
+
+    FISMTransformerRequestCycle* Cycle = nullptr;
+    if (IsDeltaRequest(Request))
+    {
+        Cycle = ActiveCycles.FindByPredicate([&Dispatch](const FISMTransformerRequestCycle& C)
+            {
+                return C.TransformerName == Dispatch.Name && C.bDispatching;
+            });
+    }
 
     int32 TotalChunks = 0;
-    for (TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : Targets)
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : Request.TargetComponents)
     {
         UISMRuntimeComponent* Comp = CompPtr.Get();
         if (!Comp) continue;
-        TotalChunks += DispatchComponentChunks(Transformer, Comp, Request, Entry.Name);
+        if (ChainedComponents.Contains(CompPtr)) continue;
+
+        // Anything that changes from here on is newer than the cursor, including this dispatch's own writes
+        if (Cycle)
+            Cycle->PendingDeltaCursors.Add(CompPtr, Comp->CaptureChangeCursor());
+
+        // Sync chunks may unregister transformers and reallocate ActiveCycles
+        TotalChunks += DispatchComponentChunks(Dispatch.Transformer, Comp, Request, Dispatch.Name, Consumer);
+        if (Cycle)
+        {
+            Cycle = ActiveCycles.FindByPredicate([&Dispatch](const FISMTransformerRequestCycle& C)
+                {
+                    return C.TransformerName == Dispatch.Name && C.bDispatching;
+                });
+        }
+    }
+
+    AddDispatchCycleChunks(Dispatch.Name, TotalChunks);
+}
+
+// ===== Chunk Relevance =====
+
+bool UISMBatchSchedulerBase::IsChunkDue(
+    const FISMSnapshotRequest& Request,
+    const UISMRuntimeComponent* Component,
+    const FIntVector& Cell,
+    const FBox& Bounds,
+    float& OutPriority) const
+{
+    OutPriority = 0.0f;
+    const FISMChunkRelevanceFunction& RelevanceFunction = Request.ChunkRelevance ? Request.ChunkRelevance : ChunkRelevanceFunction;
+    if (!Request.bUseChunkRelevance || !RelevanceFunction) return true;
+
+    FISMChunkRelevanceQuery Query;
+    Query.Component = Component;
+    Query.TransformerName = CurrentDispatchName;
+    Query.Cell = Cell;
+    Query.Bounds = Bounds;
+
+    const FISMChunkRelevance Relevance = RelevanceFunction(Query);
+    OutPriority = Relevance.Priority;
+
+    // A skipped delta chunk would advance the cursor past changes nobody saw
+    if (IsDeltaRequest(Request)) return true;
+    if (Relevance.UpdateInterval <= 0) return false;
+    if (Relevance.UpdateInterval == 1) return true;
+
+    // Per-cell phase spreads a tier's cells over its interval instead of updating them all on one dispatch
+    const uint32 Phase = HashCombineFast(GetTypeHash(Cell), PointerHash(Component));
+    return (CurrentDispatchCount + Phase) % static_cast<uint32>(Relevance.UpdateInterval) == 0;
+}
+
+// ===== Delta Snapshots =====
+
+void UISMBatchSchedulerBase::GatherDispatchInstances(
+    const UISMRuntimeComponent* Component,
+    const FISMSnapshotRequest& Request,
+    TArray<int32>& OutIndices) const
+{
+    Component->GetBatchableInstanceIndices(OutIndices);
+    if (!IsDeltaRequest(Request)) return;
+
+    const TMap<TWeakObjectPtr<UISMRuntimeComponent>, uint32>* Cursors = DeltaCursors.Find(CurrentDispatchName);
+    const uint32* Cursor = Cursors ? Cursors->Find(TWeakObjectPtr<UISMRuntimeComponent>(const_cast<UISMRuntimeComponent*>(Component))) : nullptr;
+
+    // No completed dispatch on this component yet - everything is new to the transformer
+    if (!Cursor) return;
+
+    const EISMSnapshotField Fields = Request.GetDeltaFields();
+    OutIndices.RemoveAll([Component, Fields, Cursor](int32 Idx)
+        {
+            return !Component->HasInstanceChangedSince(Idx, Fields, *Cursor);
+        });
+}
+
+FISMChunkRelevance FISMDistanceRelevance::Evaluate(const FISMChunkRelevanceQuery& Query) const
+{
+    FISMChunkRelevance Relevance;
+    if (Viewpoints.IsEmpty() || !Query.Bounds.IsValid) return Relevance;
+
+    double MinDistSq = TNumericLimits<double>::Max();
+    for (const FVector& Viewpoint : Viewpoints)
+        MinDistSq = FMath::Min(MinDistSq, Query.Bounds.ComputeSquaredDistanceToPoint(Viewpoint));
+
+    const float Distance = static_cast<float>(FMath::Sqrt(MinDistSq));
+    Relevance.Priority = -Distance;
+
+    for (const FTier& Tier : Tiers)
+    {
+        Relevance.UpdateInterval = Tier.UpdateInterval;
+        if (Distance <= Tier.MaxDistance) break;
+    }
+    return Relevance;
+}
+
+// ===== Chaining =====
+
+int32 UISMBatchSchedulerBase::CountChainedChunks(
+    const TSharedPtr<const FISMChainLink>& Consumer,
+    const UISMRuntimeComponent* Component,
+    const FIntVector& Cell)
+{
+    int32 ChainDepth = 0;
+    for (const FISMChainLink* Link = Consumer.Get(); Link; Link = Link->Downstream.Get())
+    {
+        if (!Link->Request.TargetComponents.Contains(Component)) break;
+        if (!DoesChunkOverlapRequest(Component, Cell, Link->Request)) break;
+
+        AddDispatchCycleChunks(Link->TransformerName, 1);
+        ++ChainDepth;
+    }
+    return ChainDepth;
+}
+
+void UISMBatchSchedulerBase::AbandonChain(const TSharedPtr<const FISMChainLink>& Consumer, int32 ChainDepth)
+{
+    const FISMChainLink* Link = Consumer.Get();
+    for (int32 Depth = 0; Depth < ChainDepth && Link; ++Depth, Link = Link->Downstream.Get())
+        NotifyChunkResolved(Link->TransformerName, true);
+}
+
+void UISMBatchSchedulerBase::ApplyResultToSnapshot(const FISMBatchMutationResult& Result, FISMBatchSnapshot& Snapshot)
+{
+    const EISMSnapshotField Fields = Result.WrittenFields & Snapshot.PopulatedFields;
+    if (Fields == EISMSnapshotField::None) return;
+
+    const bool bTransform = EnumHasAnyFlags(Fields, EISMSnapshotField::Transform);
+    const bool bCustomData = EnumHasAnyFlags(Fields, EISMSnapshotField::CustomData);
+    const bool bStateFlags = EnumHasAnyFlags(Fields, EISMSnapshotField::StateFlags);
+    FISMInstanceSoASnapshot& SoA = Snapshot.SoA;
+    const bool bSoA = SoA.Num() > 0;
+
+    auto WriteTransform = [&](int32 At, const FTransform& Transform)
+    {
+        if (bSoA)
+        {
+            SoA.Locations[At] = Transform.GetLocation();
+            SoA.Rotations[At] = Transform.GetRotation();
+            SoA.Scales[At] = Transform.GetScale3D();
+        }
+        else
+        {
+            Snapshot.Instances[At].Transform = Transform;
+        }
+    };
+
+    auto WriteCustomData = [&](int32 At, int32 Slot, float Value)
+    {
+        if (bSoA)
+        {
+            if (Slot >= 0 && Slot < SoA.CustomDataStride)
+                SoA.CustomData[At * SoA.CustomDataStride + Slot] = Value;
+        }
+        else if (Snapshot.Instances[At].CustomData.IsValidIndex(Slot))
+        {
+            Snapshot.Instances[At].CustomData[Slot] = Value;
+        }
+    };
+
+    auto WriteStateFlags = [&](int32 At, uint8 SetMask, uint8 ClearMask)
+    {
+        uint8& Flags = bSoA ? SoA.StateFlags[At] : Snapshot.Instances[At].StateFlags;
+        Flags = static_cast<uint8>((Flags & ~ClearMask) | SetMask);
+    };
+
+    // Same order as ApplyMutationResult: mutations, then streams
+    for (const FISMInstanceMutation& Mutation : Result.Mutations)
+    {
+        const int32 At = FindSnapshotInstance(Snapshot, Mutation.InstanceIndex);
+        if (At == INDEX_NONE) continue;
+
+        if (bTransform && Mutation.NewTransform.IsSet())
+            WriteTransform(At, Mutation.NewTransform.GetValue());
+
+        if (bCustomData)
+        {
+            if (Mutation.NewCustomData.IsSet())
+            {
+                const TArray<float>& Row = Mutation.NewCustomData.GetValue();
+                for (int32 Slot = 0; Slot < Row.Num(); ++Slot)
+                    WriteCustomData(At, Slot, Row[Slot]);
+            }
+            for (const TTuple<int32, float>& SlotOverride : Mutation.CustomDataSlotOverrides)
+                WriteCustomData(At, SlotOverride.Key, SlotOverride.Value);
+        }
+
+        if (bStateFlags && Mutation.NewStateFlags.IsSet())
+            WriteStateFlags(At, Mutation.NewStateFlags.GetValue(), 0xFF);
+    }
+
+    const FISMMutationStreams& Streams = Result.Streams;
+    if (bTransform)
+    {
+        const int32 NumWrites = FMath::Min(Streams.TransformIndices.Num(), Streams.Transforms.Num());
+        for (int32 i = 0; i < NumWrites; i++)
+        {
+            const int32 At = FindSnapshotInstance(Snapshot, Streams.TransformIndices[i]);
+            if (At != INDEX_NONE)
+                WriteTransform(At, Streams.Transforms[i]);
+        }
+    }
+
+    if (bCustomData)
+    {
+        for (const FISMCustomDataWrite& Write : Streams.CustomDataWrites)
+        {
+            const int32 At = FindSnapshotInstance(Snapshot, Write.InstanceIndex);
+            if (At != INDEX_NONE)
+                WriteCustomData(At, Write.Slot, Write.Value);
+        }
+    }
+
+    if (bStateFlags)
+    {
+        for (const FISMStateFlagsWrite& Write : Streams.StateFlagsWrites)
+        {
+            const int32 At = FindSnapshotInstance(Snapshot, Write.InstanceIndex);
+            if (At != INDEX_NONE)
+                WriteStateFlags(At, Write.SetMask, Write.ClearMask);
+        }
+    }
+}
+
+void UISMBatchSchedulerBase::StashForwardedSnapshot(FISMBatchMutationResult& Result)
+{
+    if (Result.ForwardedSnapshot.IsEmpty()) return;
+
+    ApplyResultToSnapshot(Result, Result.ForwardedSnapshot);
+    ForwardedSnapshots.Add(Result.ChunkId, MoveTemp(Result.ForwardedSnapshot));
+    Result.ForwardedSnapshot = FISMBatchSnapshot();
+}
+
+bool UISMBatchSchedulerBase::TakeForwardedSnapshot(uint32 ChunkId, FISMBatchSnapshot& OutSnapshot)
+{
+    return ForwardedSnapshots.RemoveAndCopyValue(ChunkId, OutSnapshot);
+}
+
+// ===== Chunk Planning =====
+
+void UISMBatchSchedulerBase::BuildChunkPlans(
+    UISMRuntimeComponent* Component,
+    const FISMSnapshotRequest& Request,
+    TArray<FISMChunkPlan>& OutPlans) const
+{
+    TArray<int32> AllIndices;
+    GatherDispatchInstances(Component, Request, AllIndices);
+    if (AllIndices.IsEmpty()) return;
+
+    const FISMSpatialIndex& SpatialIndex = Component->GetSpatialIndex();
+
+    // Bucket by the position the index holds, which is what the cell coordinates refer to
+    TMap<FIntVector, TArray<int32>> CellInstances;
+    for (int32 Idx : AllIndices)
+    {
+        FVector Position;
+        if (!SpatialIndex.GetInstancePosition(Idx, Position))
+            Position = Component->GetInstanceLocation(Idx);
+        CellInstances.FindOrAdd(SpatialIndex.WorldLocationToCell(Position)).Add(Idx);
     }
 
-    if (TotalChunks > 0)
+    CellInstances.KeySort([](const FIntVector& A, const FIntVector& B)
+        {
+            if (A.X != B.X) return A.X < B.X;
+            if (A.Y != B.Y) return A.Y < B.Y;
+            return A.Z < B.Z;
+        });
+
+    const int32 ChunkCap = FMath::Max(1, Request.MaxInstancesPerChunkOverride > 0
+        ? Request.MaxInstancesPerChunkOverride
+        : Settings.MaxInstancesPerChunk);
+    const bool bCullCells = Request.HasSpatialBounds();
+
+    for (TPair<FIntVector, TArray<int32>>& Cell : CellInstances)
     {
-        FISMTransformerRequestCycle& Cycle = ActiveCycles.AddDefaulted_GetRef();
-        Cycle.TransformerName = Entry.Name;
-        Cycle.TotalChunks = TotalChunks;
-        Cycle.ResolvedChunks = 0;
-        Cycle.bComplete = false;
+        const FBox CellBounds = SpatialIndex.GetCellBounds(Cell.Key);
+        if (bCullCells && !Request.SpatialBounds.Intersect(CellBounds)) continue;
+
+        float Priority = 0.0f;
+        if (!IsChunkDue(Request, Component, Cell.Key, CellBounds, Priority)) continue;
+
+        if (Cell.Value.Num() <= ChunkCap)
+        {
+            FISMChunkPlan& Plan = OutPlans.AddDefaulted_GetRef();
+            Plan.CellCoordinates = Cell.Key;
+            Plan.InstanceIndices = MoveTemp(Cell.Value);
+            Plan.Priority = Priority;
+            continue;
+        }
+
+        for (int32 Start = 0; Start < Cell.Value.Num(); Start += ChunkCap)
+        {
+            FISMChunkPlan& Plan = OutPlans.AddDefaulted_GetRef();
+            Plan.CellCoordinates = Cell.Key;
+            Plan.InstanceIndices.Append(Cell.Value.GetData() + Start, FMath::Min(ChunkCap, Cell.Value.Num() - Start));
+            Plan.Priority = Priority;
+        }
     }
 }
 
@@ -156,124 +828,433 @@ FISMBatchSnapshot UISMBatchSchedulerBase::BuildSnapshot(
     UISMRuntimeComponent* Component,
     FIntVector CellCoords,
     const TArray<int32>& InstanceIndices,
-    EISMSnapshotField ReadMask) const
+    EISMSnapshotField ReadMask,
+    TConstArrayView<FName> ReadColumns,
+    bool bStructureOfArrays) const
 {
+    ISM_TRACE_SCOPE(UISMBatchSchedulerBase::BuildSnapshot);
+    SCOPE_CYCLE_COUNTER(STAT_ISMBuildSnapshot);
+    LLM_SCOPE_BYTAG(ISMRuntime_Batch);
+
     FISMBatchSnapshot Snapshot;
     Snapshot.SourceComponent = Component;
     Snapshot.CellCoordinates = CellCoords;
     Snapshot.PopulatedFields = ReadMask;
-    Snapshot.ComponentGenerationToken = 0;
-    Snapshot.Instances.Reserve(InstanceIndices.Num());
+    Snapshot.ComponentGenerationToken = static_cast<int32>(GetChunkGenerationToken(Component, CellCoords));
+
+    if (BufferPool)
+        BufferPool->LeaseSnapshotStorage(Snapshot, bStructureOfArrays);
+
+    const int32 NumCustomDataFloats = Component->GetNumCustomDataFloats();
+
+    if (bStructureOfArrays)
+    {
+        // Append rather than assign so pooled capacity is kept
+        FISMInstanceSoASnapshot& SoA = Snapshot.SoA;
+        SoA.InstanceIndices.Append(InstanceIndices);
+        const int32 Num = InstanceIndices.Num();
+
+        if (EnumHasAnyFlags(ReadMask, EISMSnapshotField::Transform))
+        {
+            SoA.Locations.SetNumUninitialized(Num);
+            SoA.Rotations.SetNumUninitialized(Num);
+            SoA.Scales.SetNumUninitialized(Num);
+            for (int32 i = 0; i < Num; i++)
+            {
+                const FTransform Transform = Component->GetInstanceTransform(InstanceIndices[i]);
+                SoA.Locations[i] = Transform.GetLocation();
+                SoA.Rotations[i] = Transform.GetRotation();
+                SoA.Scales[i] = Transform.GetScale3D();
+            }
+        }
+
+        // One block read fills the whole row-per-instance buffer
+        if (EnumHasAnyFlags(ReadMask, EISMSnapshotField::CustomData))
+        {
+            SoA.CustomDataStride = NumCustomDataFloats;
+            SoA.CustomData.SetNumUninitialized(Num * NumCustomDataFloats);
+            Component->ReadInstanceCustomData(InstanceIndices, 0, NumCustomDataFloats, SoA.CustomData);
+        }
+
+        if (EnumHasAnyFlags(ReadMask, EISMSnapshotField::StateFlags))
+        {
+            SoA.StateFlags.SetNumUninitialized(Num);
+            Component->GetStateFlags(InstanceIndices, SoA.StateFlags);
+        }
+    }
+    else
+    {
+        // Pooled entries carry the previous chunk's values - every field is overwritten
+        const bool bReadTransform = EnumHasAnyFlags(ReadMask, EISMSnapshotField::Transform);
+        const bool bReadCustomData = EnumHasAnyFlags(ReadMask, EISMSnapshotField::CustomData);
+        const bool bReadStateFlags = EnumHasAnyFlags(ReadMask, EISMSnapshotField::StateFlags);
+        const TConstArrayView<uint8> StateFlags = Component->GetStateFlagsRaw();
+
+        Snapshot.Instances.SetNum(InstanceIndices.Num(), EAllowShrinking::No);
+        for (int32 i = 0; i < InstanceIndices.Num(); i++)
+        {
+            const int32 Idx = InstanceIndices[i];
+            FISMInstanceSnapshot& InstSnap = Snapshot.Instances[i];
+            InstSnap.InstanceIndex = Idx;
+            InstSnap.Transform = bReadTransform ? Component->GetInstanceTransform(Idx) : FTransform::Identity;
+
+            if (bReadCustomData)
+            {
+                InstSnap.CustomData.SetNumUninitialized(NumCustomDataFloats, EAllowShrinking::No);
+                Component->ReadInstanceCustomData(MakeArrayView(&Idx, 1), 0, NumCustomDataFloats, InstSnap.CustomData);
+            }
+            else
+            {
+                InstSnap.CustomData.Reset();
+            }
+
+            InstSnap.StateFlags = bReadStateFlags && StateFlags.IsValidIndex(Idx) ? StateFlags[Idx] : 0;
+        }
+    }
+
+    // Module columns are gathered column-major so each source arena is walked once
+    for (FName ColumnName : ReadColumns)
+    {
+        const FISMInstanceDataColumn* Source = Component->GetInstanceColumns().FindRaw(ColumnName);
+        if (!Source)
+        {
+            continue;
+        }
+
+        FISMInstanceColumnSnapshot& ColumnSnap = Snapshot.Columns.AddDefaulted_GetRef();
+        ColumnSnap.Name = ColumnName;
+        ColumnSnap.ElementSize = Source->ElementSize;
+        ColumnSnap.Data.SetNumZeroed(InstanceIndices.Num() * Source->ElementSize);
+
+        const int32 NumSourceSlots = Source->Num();
+        for (int32 i = 0; i < InstanceIndices.Num(); i++)
+        {
+            if (InstanceIndices[i] >= 0 && InstanceIndices[i] < NumSourceSlots)
+            {
+                FMemory::Memcpy(ColumnSnap.Data.GetData() + static_cast<SIZE_T>(i) * Source->ElementSize,
+                    Source->GetSlot(InstanceIndices[i]), Source->ElementSize);
+            }
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_ISMSnapshotInstances, InstanceIndices.Num());
+    INC_DWORD_STAT_BY(STAT_ISMSnapshotBytes, Snapshot.GetAllocatedSize());
+    return Snapshot;
+}
+
+// ===== Handle Construction =====
+
+FISMMutationHandle UISMBatchSchedulerBase::MakeHandle(
+    TWeakObjectPtr<UISMRuntimeComponent> Component,
+    FIntVector CellCoords,
+    uint32 GenerationToken,
+    double IssuedTime,
+    uint32 ChunkId,
+    bool bForwardSnapshot) const
+{
+    // const_cast is safe here - the handle stores a weak pointer back to this
+    // scheduler and calls virtual methods on it. MakeHandle is logically const
+    // (it doesn't modify scheduler state), but the handle needs a non-const weak ptr.
+    FISMMutationHandle Handle(
+        TWeakObjectPtr<UISMBatchSchedulerBase>(const_cast<UISMBatchSchedulerBase*>(this)),
+        Component,
+        CellCoords,
+        GenerationToken,
+        IssuedTime);
+    Handle.ChunkId = ChunkId;
+    Handle.bForwardSnapshot = bForwardSnapshot;
+    return Handle;
+}
+
+// ===== Buffer Pool =====
+
+void UISMBatchSchedulerBase::LeaseResultStorage(FISMBatchMutationResult& Result, int32 ExpectedMutations) const
+{
+    if (BufferPool)
+        BufferPool->LeaseResultStorage(Result, ExpectedMutations);
+    else
+        Result.Mutations.Reserve(ExpectedMutations);
+}
+
+void UISMBatchSchedulerBase::RecycleSnapshot(FISMBatchSnapshot&& Snapshot) const
+{
+    if (BufferPool)
+        BufferPool->ReturnSnapshotStorage(MoveTemp(Snapshot));
+}
+
+void UISMBatchSchedulerBase::RecycleResult(FISMBatchMutationResult& Result) const
+{
+    // Forwarded snapshots of dropped or unconsumed results come back here too
+    if (!Result.ForwardedSnapshot.IsEmpty())
+        RecycleSnapshot(MoveTemp(Result.ForwardedSnapshot));
+    if (BufferPool)
+        BufferPool->ReturnResultStorage(MoveTemp(Result));
+}
+
+// ===== Generation Tokens =====
+
+uint32 UISMBatchSchedulerBase::GetChunkGenerationToken(const UISMRuntimeComponent* Component, const FIntVector& Cell) const
+{
+    return Component ? Component->GetStructureGeneration() : 0;
+}
+
+bool UISMBatchSchedulerBase::IsResultStale(const FISMBatchMutationResult& Result) const
+{
+    const UISMRuntimeComponent* Comp = Result.TargetComponent.Get();
+    return !Comp || static_cast<uint32>(Result.ComponentGenerationToken) != GetChunkGenerationToken(Comp, Result.CellCoordinates);
+}
+
+// ===== Result Application =====
+
+bool UISMBatchSchedulerBase::ApplyMutationResult(const FISMBatchMutationResult& Result)
+{
+    ISM_TRACE_SCOPE(UISMBatchSchedulerBase::ApplyMutationResult);
+    SCOPE_CYCLE_COUNTER(STAT_ISMApplyMutationResult);
+    LLM_SCOPE_BYTAG(ISMRuntime_Batch);
+
+    UISMRuntimeComponent* Comp = Result.TargetComponent.Get();
+    if (!Comp) return false;
+
+    INC_DWORD_STAT_BY(STAT_ISMMutationsApplied, Result.Mutations.Num());
+
+    const FISMMutationStreams& Streams = Result.Streams;
+
+    if (EnumHasAnyFlags(Result.WrittenFields, EISMSnapshotField::Transform))
+        ApplyTransformWrites(Comp, Result.Mutations, Streams);
+
+    // Custom data is written in place and pushed to the renderer once for the whole result
+    if (EnumHasAnyFlags(Result.WrittenFields, EISMSnapshotField::CustomData))
+    {
+        bool bCustomDataWritten = false;
+
+        for (const FISMInstanceMutation& Mutation : Result.Mutations)
+        {
+            const int32 Idx = Mutation.InstanceIndex;
+            if (Comp->IsInstanceDestroyed(Idx)) continue;
+
+            if (Mutation.NewCustomData.IsSet())
+                bCustomDataWritten |= Comp->WriteInstanceCustomDataRow(Idx, 0, Mutation.NewCustomData.GetValue(), false);
+
+            for (const TTuple<int32, float>& SlotOverride : Mutation.CustomDataSlotOverrides)
+                bCustomDataWritten |= Comp->WriteInstanceCustomDataRow(Idx, SlotOverride.Key, MakeArrayView(&SlotOverride.Value, 1), false);
+        }
+
+        for (const FISMCustomDataWrite& Write : Streams.CustomDataWrites)
+        {
+            if (Comp->IsInstanceDestroyed(Write.InstanceIndex)) continue;
+            bCustomDataWritten |= Comp->WriteInstanceCustomDataRow(Write.InstanceIndex, Write.Slot, MakeArrayView(&Write.Value, 1), false);
+        }
 
-    for (int32 Idx : InstanceIndices)
+        if (bCustomDataWritten)
+            Comp->MarkCustomDataDirty();
+    }
+
+    // Flags go through one batched write: one byte per instance and one notification for the chunk
+    if (EnumHasAnyFlags(Result.WrittenFields, EISMSnapshotField::StateFlags))
     {
-        FISMInstanceSnapshot& InstSnap = Snapshot.Instances.AddDefaulted_GetRef();
-        InstSnap.InstanceIndex = Idx;
+        TArray<FISMStateFlagsWrite> FlagWrites;
+        FlagWrites.Reserve(Streams.StateFlagsWrites.Num());
 
-        if (EnumHasAnyFlags(ReadMask, EISMSnapshotField::Transform))
-            InstSnap.Transform = Component->GetInstanceTransform(Idx);
+        for (const FISMInstanceMutation& Mutation : Result.Mutations)
+        {
+            if (!Mutation.NewStateFlags.IsSet() || Comp->IsInstanceDestroyed(Mutation.InstanceIndex)) continue;
 
-        if (EnumHasAnyFlags(ReadMask, EISMSnapshotField::CustomData))
-            InstSnap.CustomData = Component->GetInstanceCustomData(Idx);
+            const uint8 NewFlags = Mutation.NewStateFlags.GetValue();
+            FlagWrites.Add({ Mutation.InstanceIndex, NewFlags, static_cast<uint8>(~NewFlags) });
+        }
 
-        if (EnumHasAnyFlags(ReadMask, EISMSnapshotField::StateFlags))
-            InstSnap.StateFlags = Component->GetInstanceStateFlags(Idx);
+        for (const FISMStateFlagsWrite& Write : Streams.StateFlagsWrites)
+        {
+            if (Comp->IsInstanceDestroyed(Write.InstanceIndex)) continue;
+            FlagWrites.Add(Write);
+        }
+
+        if (FlagWrites.Num() > 0)
+            Comp->BatchWriteInstanceStateFlags(FlagWrites);
     }
 
-    return Snapshot;
-}
+    // Reported once after the pass, not once per chunk
+    if (Comp->HasPendingInstanceEvents())
+        EventFlushTargets.AddUnique(Comp);
 
-// ===== Handle Construction =====
+    return true;
+}
 
-FISMMutationHandle UISMBatchSchedulerBase::MakeHandle(
-    TWeakObjectPtr<UISMRuntimeComponent> Component,
-    FIntVector CellCoords,
-    uint32 GenerationToken,
-    double IssuedTime) const
+bool UISMBatchSchedulerBase::ApplyExternalResult(const FISMBatchMutationResult& Result)
 {
-    // const_cast is safe here - the handle stores a weak pointer back to this
-    // scheduler and calls virtual methods on it. MakeHandle is logically const
-    // (it doesn't modify scheduler state), but the handle needs a non-const weak ptr.
-    return FISMMutationHandle(
-        TWeakObjectPtr<UISMBatchSchedulerBase>(const_cast<UISMBatchSchedulerBase*>(this)),
-        Component,
-        CellCoords,
-        GenerationToken,
-        IssuedTime);
+    check(IsInGameThread());
+    return ApplyMutationResult(Result);
 }
 
-// ===== Result Application =====
+void UISMBatchSchedulerBase::FlushAppliedInstanceEvents()
+{
+    if (EventFlushTargets.IsEmpty()) return;
 
-bool UISMBatchSchedulerBase::ApplyMutationResult(const FISMBatchMutationResult& Result)
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> Targets = MoveTemp(EventFlushTargets);
+    EventFlushTargets.Reset();
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : Targets)
+    {
+        if (UISMRuntimeComponent* Comp = CompPtr.Get())
+            Comp->FlushInstanceEvents();
+    }
+}
+
+void UISMBatchSchedulerBase::ApplyTransformWrites(
+    UISMRuntimeComponent* Comp,
+    const TArray<FISMInstanceMutation>& Mutations,
+    const FISMMutationStreams& Streams)
 {
-    UISMRuntimeComponent* Comp = Result.TargetComponent.Get();
-    if (!Comp) return false;
+    const int32 NumStreamWrites = FMath::Min(Streams.TransformIndices.Num(), Streams.Transforms.Num());
+    TConstArrayView<int32> StreamIndices(Streams.TransformIndices.GetData(), NumStreamWrites);
+    TConstArrayView<FTransform> StreamTransforms(Streams.Transforms.GetData(), NumStreamWrites);
 
-    for (const FISMInstanceMutation& Mutation : Result.Mutations)
+    const bool bMutationsMove = Algo::AnyOf(Mutations, [](const FISMInstanceMutation& Mutation) { return Mutation.NewTransform.IsSet(); });
+
+    // Pass the stream straight through unless mutations also move or something in it died in flight
+    if (!bMutationsMove)
     {
-        const int32 Idx = Mutation.InstanceIndex;
-        if (Comp->IsInstanceDestroyed(Idx)) continue;
+        if (NumStreamWrites == 0) return;
 
-        if (EnumHasAnyFlags(Result.WrittenFields, EISMSnapshotField::Transform))
+        const bool bAnyDestroyed = Algo::AnyOf(StreamIndices, [Comp](int32 Idx) { return Comp->IsInstanceDestroyed(Idx); });
+        if (!bAnyDestroyed)
         {
-            if (Mutation.NewTransform.IsSet())
-                Comp->UpdateInstanceTransform(Idx, Mutation.NewTransform.GetValue(), true, false);
+            Comp->BatchUpdateInstanceTransforms(StreamIndices, StreamTransforms, false);
+            return;
         }
+    }
 
-        if (EnumHasAnyFlags(Result.WrittenFields, EISMSnapshotField::CustomData))
-        {
-            if (Mutation.NewCustomData.IsSet())
-                Comp->SetInstanceCustomData(Idx, Mutation.NewCustomData.GetValue());
+    // Everything else is gathered into one call so the spatial index rewrites each touched cell once
+    TArray<int32> MovedIndices;
+    TArray<FTransform> MovedTransforms;
+    MovedIndices.Reserve(Mutations.Num() + NumStreamWrites);
+    MovedTransforms.Reserve(Mutations.Num() + NumStreamWrites);
 
-            for (const TTuple<int32, float>& SlotOverride : Mutation.CustomDataSlotOverrides)
-                Comp->SetInstanceCustomDataValue(Idx, SlotOverride.Key, SlotOverride.Value);
+    for (const FISMInstanceMutation& Mutation : Mutations)
+    {
+        if (Mutation.NewTransform.IsSet() && !Comp->IsInstanceDestroyed(Mutation.InstanceIndex))
+        {
+            MovedIndices.Add(Mutation.InstanceIndex);
+            MovedTransforms.Add(Mutation.NewTransform.GetValue());
         }
+    }
 
-        if (EnumHasAnyFlags(Result.WrittenFields, EISMSnapshotField::StateFlags))
+    for (int32 i = 0; i < NumStreamWrites; i++)
+    {
+        if (!Comp->IsInstanceDestroyed(StreamIndices[i]))
         {
-            if (Mutation.NewStateFlags.IsSet())
-            {
-                const uint8 NewFlags = Mutation.NewStateFlags.GetValue();
-                for (uint8 BitIdx = 0; BitIdx < 8; ++BitIdx)
-                {
-                    const EISMInstanceState Flag = static_cast<EISMInstanceState>(1 << BitIdx);
-                    Comp->SetInstanceState(Idx, Flag, (NewFlags & (1 << BitIdx)) != 0);
-                }
-            }
+            MovedIndices.Add(StreamIndices[i]);
+            MovedTransforms.Add(StreamTransforms[i]);
         }
     }
 
-    Comp->SetBatchLocked(false);
-    return true;
+    if (MovedIndices.Num() > 0)
+        Comp->BatchUpdateInstanceTransforms(MovedIndices, MovedTransforms, false);
 }
 
 // ===== Cycle Tracking =====
 
 void UISMBatchSchedulerBase::NotifyChunkResolved(FName TransformerName, bool bWasAbandoned)
 {
+    // Resolutions are not matched to the cycle that issued the chunk, so hold back every open one
+    if (bWasAbandoned)
+    {
+        for (FISMTransformerRequestCycle& Cycle : ActiveCycles)
+            Cycle.bAnyAbandoned |= Cycle.TransformerName == TransformerName;
+    }
+
     for (FISMTransformerRequestCycle& Cycle : ActiveCycles)
     {
         if (Cycle.TransformerName == TransformerName && !Cycle.bComplete)
         {
             Cycle.ResolvedChunks++;
-            if (Cycle.ResolvedChunks >= Cycle.TotalChunks)
-            {
-                Cycle.bComplete = true;
-                for (FISMTransformerEntry& Entry : RegisteredTransformers)
-                {
-                    if (Entry.Name == TransformerName && Entry.Transformer)
-                    {
-                        Entry.Transformer->OnRequestComplete();
-                        break;
-                    }
-                }
-            }
+            if (!Cycle.bDispatching && Cycle.ResolvedChunks >= Cycle.TotalChunks)
+                CompleteCycle(Cycle);
             break;
         }
     }
     ActiveCycles.RemoveAll([](const FISMTransformerRequestCycle& C) { return C.bComplete; });
 }
 
+void UISMBatchSchedulerBase::BeginDispatchCycle(FName TransformerName)
+{
+    FISMTransformerRequestCycle& Cycle = ActiveCycles.AddDefaulted_GetRef();
+    Cycle.TransformerName = TransformerName;
+    Cycle.bDispatching = true;
+}
+
+void UISMBatchSchedulerBase::AddDispatchCycleChunks(FName TransformerName, int32 NumChunks)
+{
+    if (NumChunks <= 0) return;
+
+    for (FISMTransformerRequestCycle& Cycle : ActiveCycles)
+    {
+        if (Cycle.TransformerName == TransformerName && Cycle.bDispatching)
+        {
+            Cycle.TotalChunks += NumChunks;
+            return;
+        }
+    }
+}
+
+void UISMBatchSchedulerBase::EndDispatchCycle(FName TransformerName)
+{
+    for (int32 Idx = 0; Idx < ActiveCycles.Num(); ++Idx)
+    {
+        FISMTransformerRequestCycle& Cycle = ActiveCycles[Idx];
+        if (Cycle.TransformerName != TransformerName || !Cycle.bDispatching) continue;
+
+        Cycle.bDispatching = false;
+        if (Cycle.TotalChunks == 0)
+        {
+            // Nothing to process this tick - no completion callback, as before. Nothing changed
+            // for a delta request either, so its cursors still move on.
+            CommitDeltaCursors(Cycle);
+            ActiveCycles.RemoveAt(Idx);
+        }
+        else if (Cycle.ResolvedChunks >= Cycle.TotalChunks)
+        {
+            CompleteCycle(Cycle);
+            ActiveCycles.RemoveAt(Idx);
+        }
+        return;
+    }
+}
+
+void UISMBatchSchedulerBase::CompleteCycle(FISMTransformerRequestCycle& Cycle)
+{
+    Cycle.bComplete = true;
+    CommitDeltaCursors(Cycle);
+    for (FISMTransformerEntry& Entry : RegisteredTransformers)
+    {
+        if (Entry.Name == Cycle.TransformerName && Entry.Transformer)
+        {
+            Entry.Transformer->OnRequestComplete();
+            break;
+        }
+    }
+}
+
+void UISMBatchSchedulerBase::CommitDeltaCursors(FISMTransformerRequestCycle& Cycle)
+{
+    if (Cycle.PendingDeltaCursors.IsEmpty() || Cycle.bAnyAbandoned) return;
+    if (!IsTransformerRegistered(Cycle.TransformerName)) return;
+
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, uint32>& Cursors = DeltaCursors.FindOrAdd(Cycle.TransformerName);
+    for (const TPair<TWeakObjectPtr<UISMRuntimeComponent>, uint32>& Pending : Cycle.PendingDeltaCursors)
+    {
+        // Overlapping cycles can complete out of order
+        uint32& Cursor = Cursors.FindOrAdd(Pending.Key, 0);
+        Cursor = FMath::Max(Cursor, Pending.Value);
+    }
+    Cycle.PendingDeltaCursors.Reset();
+
+    for (auto It = Cursors.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+            It.RemoveCurrent();
+    }
+}
+
 FISMInFlightChunk& UISMBatchSchedulerBase::TrackNewChunk(
     FName TransformerName,
     TWeakObjectPtr<UISMRuntimeComponent> Component,
@@ -306,31 +1287,61 @@ void UISMBatchSchedulerSync::Tick(float DeltaTime)
 
     // No drain needed - results are applied inline in OnHandleReleased
     DispatchDirtyTransformers();
+    FlushAppliedInstanceEvents();
 }
 
 int32 UISMBatchSchedulerSync::DispatchComponentChunks(
     IISMBatchTransformer* Transformer,
     UISMRuntimeComponent* Component,
     const FISMSnapshotRequest& Request,
-    FName TransformerName)
+    FName TransformerName,
+    const TSharedPtr<const FISMChainLink>& Consumer)
 {
+    float Priority = 0.0f;
+    if (!IsChunkDue(Request, Component, FIntVector::ZeroValue, Component->GetInstanceBounds(), Priority)) return 0;
+
     TArray<int32> AllIndices;
-    const int32 TotalCount = Component->GetInstanceCount();
-    AllIndices.Reserve(TotalCount);
-    for (int32 i = 0; i < TotalCount; ++i)
-    {
-        if (!Component->IsInstanceDestroyed(i) && !Component->IsInstanceConverted(i))
-            AllIndices.Add(i);
-    }
+    GatherDispatchInstances(Component, Request, AllIndices);
     if (AllIndices.IsEmpty()) return 0;
 
-    // No batch lock - we are on the game thread and OnHandleReleased applies
+    const int32 ChainDepth = CountChainedChunks(Consumer, Component, FIntVector::ZeroValue);
+
+    // No staging - we are on the game thread and OnHandleReleased applies
     // results before ProcessChunk returns, so nothing can interleave.
 
-    FISMBatchSnapshot Snapshot = BuildSnapshot(Component, FIntVector::ZeroValue, AllIndices, Request.ReadMask);
+    FISMBatchSnapshot Snapshot = BuildSnapshot(Component, FIntVector::ZeroValue, AllIndices, Request.ReadMask, Request.ReadColumns, Request.bStructureOfArrays);
+    RunChunk(Transformer, TransformerName, Component, MoveTemp(Snapshot), Consumer, ChainDepth);
+
+    return 1;
+}
+
+void UISMBatchSchedulerSync::RunChunk(
+    IISMBatchTransformer* Transformer,
+    FName TransformerName,
+    UISMRuntimeComponent* Component,
+    FISMBatchSnapshot&& Snapshot,
+    const TSharedPtr<const FISMChainLink>& Consumer,
+    int32 ChainDepth)
+{
+    const bool bChained = ChainDepth > 0 && Consumer;
+    const uint32 ChunkId = AllocateChunkId();
+
+    // Kept for the fallback below, in case the transformer does not hand its snapshot back
+    TArray<int32> ChunkIndices;
+    if (bChained && Snapshot.SoA.Num() > 0)
+    {
+        ChunkIndices = Snapshot.SoA.InstanceIndices;
+    }
+    else if (bChained)
+    {
+        ChunkIndices.Reserve(Snapshot.Instances.Num());
+        for (const FISMInstanceSnapshot& Instance : Snapshot.Instances)
+            ChunkIndices.Add(Instance.InstanceIndex);
+    }
+
     Transformer->OnHandleIssued(Snapshot);
 
-    FISMMutationHandle Handle = MakeHandle(Component, FIntVector::ZeroValue, 0, 0.0);
+    FISMMutationHandle Handle = MakeHandle(Component, FIntVector::ZeroValue, static_cast<uint32>(Snapshot.ComponentGenerationToken), 0.0, ChunkId, bChained);
     Transformer->ProcessChunk(MoveTemp(Snapshot), MoveTemp(Handle));
 
     // ProcessChunk has returned which means Release() was called and
@@ -338,7 +1349,28 @@ int32 UISMBatchSchedulerSync::DispatchComponentChunks(
     // Notify cycle tracking so OnRequestComplete fires correctly.
     NotifyChunkResolved(TransformerName, false);
 
-    return 1;
+    if (!bChained) return;
+
+    // The upstream may have unregistered the consumer or destroyed the component
+    if (!IsValid(Component) || !IsTransformerRegistered(Consumer->TransformerName))
+    {
+        AbandonChain(Consumer, ChainDepth);
+        FISMBatchSnapshot Unused;
+        if (TakeForwardedSnapshot(ChunkId, Unused))
+            RecycleSnapshot(MoveTemp(Unused));
+        return;
+    }
+
+    // Already applied above, so a fresh read matches the forwarded snapshot exactly
+    FISMBatchSnapshot Chained;
+    if (!TakeForwardedSnapshot(ChunkId, Chained))
+    {
+        const FISMSnapshotRequest& Request = Consumer->Request;
+        Chained = BuildSnapshot(Component, FIntVector::ZeroValue, ChunkIndices, Request.ReadMask, Request.ReadColumns, Request.bStructureOfArrays);
+    }
+    Chained.ComponentGenerationToken = static_cast<int32>(GetChunkGenerationToken(Component, FIntVector::ZeroValue));
+
+    RunChunk(Consumer->Transformer, Consumer->TransformerName, Component, MoveTemp(Chained), Consumer->Downstream, ChainDepth - 1);
 }
 
 void UISMBatchSchedulerSync::OnHandleReleased(
@@ -349,14 +1381,25 @@ void UISMBatchSchedulerSync::OnHandleReleased(
     // Sync path: apply immediately on the game thread, no staging needed
     Result.CellCoordinates = CellCoords;
     Result.TargetComponent = Component;
-    ApplyMutationResult(Result);
+
+    // Only ProcessChunk itself ran since the snapshot, but it may have recycled a slot
+    if (IsResultStale(Result))
+    {
+        UE_LOG(LogISMBatching, Verbose, TEXT("OnHandleReleased: Discarding result with stale generation token"));
+    }
+    else if (ApplyMutationResult(Result))
+    {
+        StashForwardedSnapshot(Result);
+    }
+    RecycleResult(Result);
 }
 
 void UISMBatchSchedulerSync::OnHandleAbandoned(
     FIntVector CellCoords,
-    TWeakObjectPtr<UISMRuntimeComponent> Component)
+    TWeakObjectPtr<UISMRuntimeComponent> Component,
+    uint32 ChunkId)
 {
-    // Nothing to do for sync - component was never batch locked
+    // Nothing to do for sync - nothing was staged
 }
 
 #pragma endregion
@@ -376,6 +1419,13 @@ void UISMBatchScheduler::Initialize(UISMRuntimeSubsystem* InOwningSubsystem)
 
 void UISMBatchScheduler::Deinitialize()
 {
+    // Launched chunks post into ThreadedState - let them finish before it goes away
+    UE::Tasks::Wait(ChunkTasks);
+    ChunkTasks.Empty();
+    ChunkQueue.Empty();
+    PendingConsumers.Empty();
+    PendingApply.Empty();
+
     // Base sets bInitialized=false and clears transformers/chunks/cycles.
     // OnHandleReleased/Abandoned guard on bInitialized so no new posts
     // can arrive after Super::Deinitialize() returns.
@@ -388,43 +1438,289 @@ void UISMBatchScheduler::Tick(float DeltaTime)
     if (!bInitialized || !ThreadedState) return;
     if (RegisteredTransformers.Num() == 0 &&
         InFlightChunks.Num() == 0 &&
-        ThreadedState->ReleasedResults.Num() == 0 &&
-        ThreadedState->AbandonedChunks.Num() == 0) return;
+        ChunkQueue.Num() == 0 &&
+        PendingApply.Num() == 0 &&
+        !ThreadedState->HasStagedPosts()) return;
 
-    DrainAndApplyResults();
+    // Both drains share one apply budget; dispatch and launch share the dispatch budget
+    ApplySecondsThisTick = 0.0;
+    DrainAndApplyResults(true);
     DispatchDirtyTransformers();
-    DrainAndApplyResults();
+    LaunchQueuedChunks(true);
+    DrainAndApplyResults(true);
+    LastApplySeconds = ApplySecondsThisTick;
+    FlushAppliedInstanceEvents();
+}
+
+FISMBatchSchedulerStats UISMBatchScheduler::GetSchedulerStats() const
+{
+    FISMBatchSchedulerStats Stats = Super::GetSchedulerStats();
+    Stats.QueuedChunkCount = ChunkQueue.Num();
+    Stats.PendingApplyCount = PendingApply.Num();
+    Stats.LastApplyTimeMs = static_cast<float>(LastApplySeconds * 1000.0);
+    return Stats;
+}
+
+SIZE_T UISMBatchScheduler::GetAllocatedSize() const
+{
+    SIZE_T Size = Super::GetAllocatedSize();
+
+    const auto QueuedChunkSize = [](const FQueuedChunk& Queued)
+    {
+        return Queued.Plan.InstanceIndices.GetAllocatedSize() + Queued.ReadColumns.GetAllocatedSize()
+            + Queued.PreparedSnapshot.GetAllocatedSize();
+    };
+
+    Size += ChunkQueue.GetAllocatedSize() + ChunkTasks.GetAllocatedSize() + PendingConsumers.GetAllocatedSize();
+    for (const FQueuedChunk& Queued : ChunkQueue)
+        Size += QueuedChunkSize(Queued);
+    for (const TPair<uint32, FQueuedChunk>& Pair : PendingConsumers)
+        Size += QueuedChunkSize(Pair.Value);
+
+    Size += PendingApply.GetAllocatedSize();
+    for (const FISMBatchMutationResult& Result : PendingApply)
+        Size += Result.GetAllocatedSize();
+
+    // Posted from workers until the next drain
+    if (ThreadedState)
+    {
+        FScopeLock ScopeLock(&ThreadedState->ReleasedResultsLock);
+        Size += ThreadedState->ReleasedResults.GetAllocatedSize();
+        for (const FISMBatchMutationResult& Result : ThreadedState->ReleasedResults)
+            Size += Result.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void UISMBatchScheduler::FlushChunkTasks()
+{
+    if (!bInitialized || !ThreadedState) return;
+
+    // Each pass frees the slots the previous one filled, so the queue shrinks every iteration
+    // Resolving a chained chunk queues its consumer, so the queue can refill between passes
+    while (ChunkQueue.Num() > 0 || ChunkTasks.Num() > 0 || PendingApply.Num() > 0)
+    {
+        const int32 NumLaunched = LaunchQueuedChunks(false);
+        UE::Tasks::Wait(ChunkTasks);
+        ChunkTasks.Reset();
+        const int32 NumInFlight = InFlightChunks.Num();
+        DrainAndApplyResults(false);
+
+        // Chunks held open past ProcessChunk keep their slots and hold back conflicting chunks; stop rather than spin
+        if (NumLaunched == 0 && InFlightChunks.Num() == NumInFlight && ChunkQueue.Num() > 0) break;
+    }
+    FlushAppliedInstanceEvents();
 }
 
 int32 UISMBatchScheduler::DispatchComponentChunks(
     IISMBatchTransformer* Transformer,
     UISMRuntimeComponent* Component,
     const FISMSnapshotRequest& Request,
-    FName TransformerName)
+    FName TransformerName,
+    const TSharedPtr<const FISMChainLink>& Consumer)
 {
-    TArray<int32> AllIndices;
-    const int32 TotalCount = Component->GetInstanceCount();
-    AllIndices.Reserve(TotalCount);
-    for (int32 i = 0; i < TotalCount; ++i)
+    TArray<FISMChunkPlan> Plans;
+    BuildChunkPlans(Component, Request, Plans);
+    if (Plans.IsEmpty()) return 0;
+
+    // Snapshots are deferred to launch so queued chunks read current data
+    ChunkQueue.Reserve(ChunkQueue.Num() + Plans.Num());
+    for (FISMChunkPlan& Plan : Plans)
     {
-        if (!Component->IsInstanceDestroyed(i) && !Component->IsInstanceConverted(i))
-            AllIndices.Add(i);
+        FQueuedChunk& Queued = ChunkQueue.AddDefaulted_GetRef();
+        Queued.Transformer = Transformer;
+        Queued.TransformerName = TransformerName;
+        Queued.Component = Component;
+        Queued.ReadMask = Request.ReadMask;
+        Queued.WriteMask = Request.WriteMask;
+        Queued.ReadColumns = Request.ReadColumns;
+        Queued.bStructureOfArrays = Request.bStructureOfArrays;
+        Queued.ChainDepth = CountChainedChunks(Consumer, Component, Plan.CellCoordinates);
+        Queued.Consumer = Queued.ChainDepth > 0 ? Consumer : nullptr;
+        Queued.DispatchSerial = CurrentDispatchSerial;
+        Queued.Plan = MoveTemp(Plan);
     }
-    if (AllIndices.IsEmpty()) return 0;
 
-    if (!Component->SetBatchLocked(true)) return 0;
+    // The transformer's chunks from every component of this dispatch sit at the tail; order them as a whole
+    if (Request.bUseChunkRelevance)
+    {
+        int32 Start = ChunkQueue.Num() - Plans.Num();
+        while (Start > 0 && ChunkQueue[Start - 1].DispatchSerial == CurrentDispatchSerial)
+            --Start;
 
-    FISMBatchSnapshot Snapshot = BuildSnapshot(Component, FIntVector::ZeroValue, AllIndices, Request.ReadMask);
+        Algo::StableSortBy(MakeArrayView(ChunkQueue.GetData() + Start, ChunkQueue.Num() - Start),
+            [](const FQueuedChunk& Queued) { return -Queued.Plan.Priority; });
+    }
 
-    const double IssuedTime = FPlatformTime::Seconds();
-    TrackNewChunk(TransformerName, Component, FIntVector::ZeroValue, IssuedTime);
+    return Plans.Num();
+}
 
-    Transformer->OnHandleIssued(Snapshot);
+bool UISMBatchScheduler::DoesChunkOverlapRequest(const UISMRuntimeComponent* Component, const FIntVector& Cell, const FISMSnapshotRequest& Request) const
+{
+    return !Request.HasSpatialBounds() || Request.SpatialBounds.Intersect(Component->GetSpatialIndex().GetCellBounds(Cell));
+}
 
-    FISMMutationHandle Handle = MakeHandle(Component, FIntVector::ZeroValue, 0, IssuedTime);
-    Transformer->ProcessChunk(MoveTemp(Snapshot), MoveTemp(Handle));
+UISMBatchScheduler::FQueuedChunk UISMBatchScheduler::MakeConsumerChunk(const FQueuedChunk& Upstream)
+{
+    const FISMChainLink& Link = *Upstream.Consumer;
+
+    FQueuedChunk Chunk;
+    Chunk.Transformer = Link.Transformer;
+    Chunk.TransformerName = Link.TransformerName;
+    Chunk.Component = Upstream.Component;
+    Chunk.Plan = Upstream.Plan;
+    Chunk.ReadMask = Link.Request.ReadMask;
+    Chunk.WriteMask = Link.Request.WriteMask;
+    Chunk.ReadColumns = Link.Request.ReadColumns;
+    Chunk.bStructureOfArrays = Link.Request.bStructureOfArrays;
+    Chunk.ChainDepth = Upstream.ChainDepth - 1;
+    Chunk.Consumer = Chunk.ChainDepth > 0 ? Link.Downstream : nullptr;
+    return Chunk;
+}
 
-    return 1;
+bool UISMBatchScheduler::IsChunkHeldBack(const FQueuedChunk& Queued, TConstArrayView<FQueuedChunk> QueuedAhead) const
+{
+    const FIntVector& Cell = Queued.Plan.CellCoordinates;
+    auto ConflictsWithQueued = [&Queued, &Cell](FName OtherName, const TWeakObjectPtr<UISMRuntimeComponent>& OtherComponent,
+        const FIntVector& OtherCell, EISMSnapshotField OtherRead, EISMSnapshotField OtherWrite)
+    {
+        return OtherName != Queued.TransformerName &&
+            OtherComponent == Queued.Component &&
+            OtherCell == Cell &&
+            FISMSnapshotRequest::AccessConflicts(OtherRead, OtherWrite, Queued.ReadMask, Queued.WriteMask);
+    };
+
+    for (const FISMInFlightChunk& Chunk : InFlightChunks)
+    {
+        if (!Chunk.bReleased && ConflictsWithQueued(Chunk.TransformerName, Chunk.TargetComponent, Chunk.CellCoordinates, Chunk.ReadMask, Chunk.WriteMask))
+            return true;
+    }
+
+    for (const FQueuedChunk& Ahead : QueuedAhead)
+    {
+        if (ConflictsWithQueued(Ahead.TransformerName, Ahead.Component, Ahead.Plan.CellCoordinates, Ahead.ReadMask, Ahead.WriteMask))
+            return true;
+    }
+    return false;
+}
+
+int32 UISMBatchScheduler::LaunchQueuedChunks(bool bBudgeted)
+{
+    ChunkTasks.RemoveAll([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+    if (ChunkQueue.IsEmpty()) return 0;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = bBudgeted ? GetDispatchBudgetSeconds() : 0.0;
+
+    const UE::Tasks::ETaskPriority TaskPriority = Settings.bLaunchChunksAtBackgroundPriority
+        ? UE::Tasks::ETaskPriority::BackgroundNormal
+        : UE::Tasks::ETaskPriority::Normal;
+
+    // Held-back chunks are compacted to the front of the queue, keeping their order
+    int32 NumLaunched = 0;
+    int32 NumKept = 0;
+    int32 Idx = 0;
+    for (; Idx < ChunkQueue.Num(); ++Idx)
+    {
+        if (InFlightChunks.Num() >= Settings.MaxConcurrentChunks) break;
+        if (NumLaunched > 0 && BudgetSeconds > 0.0 &&
+            DispatchSecondsThisTick + (FPlatformTime::Seconds() - StartTime) >= BudgetSeconds) break;
+
+        FQueuedChunk& Queued = ChunkQueue[Idx];
+        UISMRuntimeComponent* Comp = Queued.Component.Get();
+        if (!Comp || !IsTransformerRegistered(Queued.TransformerName))
+        {
+            // Nothing left to process against - count it and its chain as abandoned so the cycles still complete
+            NotifyChunkResolved(Queued.TransformerName, true);
+            AbandonChain(Queued.Consumer, Queued.ChainDepth);
+            if (Queued.bHasPreparedSnapshot)
+                RecycleSnapshot(MoveTemp(Queued.PreparedSnapshot));
+            continue;
+        }
+
+        if (IsChunkHeldBack(Queued, MakeArrayView(ChunkQueue.GetData(), NumKept)))
+        {
+            if (NumKept != Idx)
+                ChunkQueue[NumKept] = MoveTemp(Queued);
+            ++NumKept;
+            continue;
+        }
+
+        const uint32 ChunkId = AllocateChunkId();
+        const FIntVector Cell = Queued.Plan.CellCoordinates;
+
+        FISMBatchSnapshot Snapshot;
+        if (Queued.bHasPreparedSnapshot)
+        {
+            Snapshot = MoveTemp(Queued.PreparedSnapshot);
+            Snapshot.ComponentGenerationToken = static_cast<int32>(GetChunkGenerationToken(Comp, Cell));
+        }
+        else
+        {
+            Snapshot = BuildSnapshot(Comp, Cell, Queued.Plan.InstanceIndices, Queued.ReadMask, Queued.ReadColumns, Queued.bStructureOfArrays);
+        }
+
+        const double IssuedTime = FPlatformTime::Seconds();
+        FISMInFlightChunk& Chunk = TrackNewChunk(Queued.TransformerName, Queued.Component, Cell, IssuedTime);
+        Chunk.ChunkId = ChunkId;
+        Chunk.Priority = GetTransformerPriority(Queued.TransformerName);
+        Chunk.ReadMask = Queued.ReadMask;
+        Chunk.WriteMask = Queued.WriteMask;
+
+        const bool bChained = Queued.ChainDepth > 0 && Queued.Consumer;
+        if (bChained)
+            PendingConsumers.Add(ChunkId, MakeConsumerChunk(Queued));
+
+        Queued.Transformer->OnHandleIssued(Snapshot);
+
+        FISMMutationHandle Handle = MakeHandle(Queued.Component, Cell, static_cast<uint32>(Snapshot.ComponentGenerationToken), IssuedTime, ChunkId, bChained);
+        IISMBatchTransformer* Transformer = Queued.Transformer;
+        ChunkTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+            [Transformer, Snapshot = MoveTemp(Snapshot), Handle = MoveTemp(Handle)]() mutable
+            {
+                Transformer->ProcessChunk(MoveTemp(Snapshot), MoveTemp(Handle));
+            },
+            TaskPriority));
+        ++NumLaunched;
+    }
+
+    ChunkQueue.RemoveAt(NumKept, Idx - NumKept, EAllowShrinking::No);
+    if (bBudgeted)
+        DispatchSecondsThisTick += FPlatformTime::Seconds() - StartTime;
+    return NumLaunched;
+}
+
+void UISMBatchScheduler::ResolveInFlightChunk(uint32 ChunkId, bool bAbandoned)
+{
+    FISMInFlightChunk* Chunk = InFlightChunks.FindByPredicate([ChunkId](const FISMInFlightChunk& C)
+        {
+            return !C.bReleased && C.ChunkId == ChunkId;
+        });
+    if (!Chunk) return;
+
+    Chunk->bReleased = true;
+    Chunk->bAbandoned = bAbandoned;
+    NotifyChunkResolved(Chunk->TransformerName, bAbandoned);
+
+    FQueuedChunk Consumer;
+    if (!PendingConsumers.RemoveAndCopyValue(ChunkId, Consumer)) return;
+
+    // The consumer runs on whatever the upstream chunk left behind, applied or not;
+    // without a forwarded snapshot it reads the component at launch
+    if (!Consumer.Component.IsValid())
+    {
+        NotifyChunkResolved(Consumer.TransformerName, true);
+        AbandonChain(Consumer.Consumer, Consumer.ChainDepth);
+        return;
+    }
+
+    Consumer.bHasPreparedSnapshot = !bAbandoned && TakeForwardedSnapshot(ChunkId, Consumer.PreparedSnapshot);
+    ChunkQueue.Add(MoveTemp(Consumer));
+}
+
+uint32 UISMBatchScheduler::GetChunkGenerationToken(const UISMRuntimeComponent* Component, const FIntVector& Cell) const
+{
+    return Component ? Component->GetCellStructureGeneration(Cell) : 0;
 }
 
 void UISMBatchScheduler::OnHandleReleased(
@@ -439,27 +1735,32 @@ void UISMBatchScheduler::OnHandleReleased(
 
     FScopeLock Lock(&ThreadedState->ReleasedResultsLock);
     ThreadedState->ReleasedResults.Add(MoveTemp(Result));
+    ThreadedState->NumStagedPosts.fetch_add(1, std::memory_order_release);
 }
 
 void UISMBatchScheduler::OnHandleAbandoned(
     FIntVector CellCoords,
-    TWeakObjectPtr<UISMRuntimeComponent> Component)
+    TWeakObjectPtr<UISMRuntimeComponent> Component,
+    uint32 ChunkId)
 {
     if (!bInitialized || !ThreadedState) return;
 
     FAbandonedChunkKey Key;
     Key.Cell = CellCoords;
     Key.Component = Component;
+    Key.ChunkId = ChunkId;
 
     FScopeLock Lock(&ThreadedState->AbandonedChunksLock);
     ThreadedState->AbandonedChunks.Add(Key);
+    ThreadedState->NumStagedPosts.fetch_add(1, std::memory_order_release);
 }
 
-void UISMBatchScheduler::DrainAndApplyResults()
+void UISMBatchScheduler::DrainAndApplyResults(bool bBudgeted)
 {
     if (!bInitialized || !ThreadedState) return;
-    if (ThreadedState->ReleasedResults.Num() == 0 &&
-        ThreadedState->AbandonedChunks.Num() == 0) return;
+    if (!ThreadedState->HasStagedPosts() && PendingApply.IsEmpty()) return;
+
+    const double StartTime = FPlatformTime::Seconds();
 
     // --- Drain released results ---
     // Swap under lock so we hold the lock for minimum time.
@@ -469,48 +1770,64 @@ void UISMBatchScheduler::DrainAndApplyResults()
         FScopeLock Lock(&ThreadedState->ReleasedResultsLock);
         LocalResults = MoveTemp(ThreadedState->ReleasedResults);
         ThreadedState->ReleasedResults.Reset();
+        ThreadedState->NumStagedPosts.fetch_sub(LocalResults.Num(), std::memory_order_relaxed);
     }
 
-    for (const FISMBatchMutationResult& Result : LocalResults)
+    const double BudgetSeconds = bBudgeted ? ClampToFrameBudget(FMath::Max(0.0, Settings.ApplyBudgetMs / 1000.0)) : 0.0;
+    if (BudgetSeconds > 0.0)
     {
-        if (!Result.TargetComponent.IsValid() || Result.TargetComponent.IsStale())
+        // Carried-over results keep their place ahead of same-priority arrivals
+        if (LocalResults.Num() > 0)
         {
-            UE_LOG(LogISMBatching, Warning, TEXT("DrainAndApplyResults: Discarding result with stale component"));
-            continue;
-        }
+            PendingApply.Reserve(PendingApply.Num() + LocalResults.Num());
+            for (FISMBatchMutationResult& Result : LocalResults)
+                PendingApply.Add(MoveTemp(Result));
+            LocalResults.Reset();
 
-        UISMRuntimeComponent* Target = Result.TargetComponent.Get();
-        if (!Target || !Target->IsValidLowLevel() || !IsValid(Target))
-        {
-            UE_LOG(LogISMBatching, Warning, TEXT("DrainAndApplyResults: Discarding result with invalid component"));
-            continue;
-        }
+            TMap<uint32, int32> ChunkPriorities;
+            ChunkPriorities.Reserve(InFlightChunks.Num());
+            for (const FISMInFlightChunk& Chunk : InFlightChunks)
+                ChunkPriorities.Add(Chunk.ChunkId, Chunk.Priority);
 
-        ApplyMutationResult(Result);
+            Algo::StableSortBy(PendingApply, [&ChunkPriorities](const FISMBatchMutationResult& Result)
+                {
+                    const int32* Priority = ChunkPriorities.Find(Result.ChunkId);
+                    return Priority ? -*Priority : 0;
+                });
+        }
 
-        for (FISMInFlightChunk& Chunk : InFlightChunks)
+        // At least one result each tick, so a single oversized result cannot stall the queue
+        int32 NumApplied = 0;
+        for (; NumApplied < PendingApply.Num(); ++NumApplied)
         {
-            if (!Chunk.bReleased &&
-                Chunk.TargetComponent == Result.TargetComponent &&
-                Chunk.CellCoordinates == Result.CellCoordinates)
-            {
-                Chunk.bReleased = true;
-                NotifyChunkResolved(Chunk.TransformerName, false);
-                break;
-            }
+            if (NumApplied > 0 && ApplySecondsThisTick + (FPlatformTime::Seconds() - StartTime) >= BudgetSeconds) break;
+            ApplyDrainedResult(PendingApply[NumApplied]);
         }
+        PendingApply.RemoveAt(0, NumApplied, EAllowShrinking::No);
+        ReportFrameBudgetDeferred(PendingApply.Num());
+    }
+    else
+    {
+        // Unbudgeted, or the budget was turned off with results still carried over
+        for (FISMBatchMutationResult& Result : PendingApply)
+            ApplyDrainedResult(Result);
+        PendingApply.Reset();
+
+        for (FISMBatchMutationResult& Result : LocalResults)
+            ApplyDrainedResult(Result);
     }
 
     // --- Drain abandoned chunks ---
-    if (ThreadedState->AbandonedChunks.Num() > 0)
+    TArray<FAbandonedChunkKey> LocalAbandoned;
     {
-        TArray<FAbandonedChunkKey> LocalAbandoned;
-        {
-            FScopeLock Lock(&ThreadedState->AbandonedChunksLock);
-            LocalAbandoned = MoveTemp(ThreadedState->AbandonedChunks);
-            ThreadedState->AbandonedChunks.Reset();
-        }
+        FScopeLock Lock(&ThreadedState->AbandonedChunksLock);
+        LocalAbandoned = MoveTemp(ThreadedState->AbandonedChunks);
+        ThreadedState->AbandonedChunks.Reset();
+        ThreadedState->NumStagedPosts.fetch_sub(LocalAbandoned.Num(), std::memory_order_relaxed);
+    }
 
+    if (LocalAbandoned.Num() > 0)
+    {
         UE_LOG(LogISMBatching, Warning,
             TEXT("DrainAndApplyResults: Processing %d abandoned chunks"), LocalAbandoned.Num());
 
@@ -519,29 +1836,44 @@ void UISMBatchScheduler::DrainAndApplyResults()
             if (!Key.Component.IsValid())
             {
                 UE_LOG(LogISMBatching, Warning, TEXT("DrainAndApplyResults: Abandoned entry has invalid component"));
-                continue;
             }
 
-            for (FISMInFlightChunk& Chunk : InFlightChunks)
-            {
-                if (!Chunk.bReleased && !Chunk.bAbandoned &&
-                    Chunk.TargetComponent == Key.Component &&
-                    Chunk.CellCoordinates == Key.Cell)
-                {
-                    Chunk.bAbandoned = true;
-                    Chunk.bReleased = true;
-
-                    if (UISMRuntimeComponent* Comp = Key.Component.Get())
-                        Comp->SetBatchLocked(false);
-
-                    NotifyChunkResolved(Chunk.TransformerName, true);
-                    break;
-                }
-            }
+            ResolveInFlightChunk(Key.ChunkId, true);
         }
     }
 
     InFlightChunks.RemoveAll([](const FISMInFlightChunk& C) { return C.bReleased; });
+    if (bBudgeted)
+        ApplySecondsThisTick += FPlatformTime::Seconds() - StartTime;
+}
+
+void UISMBatchScheduler::ApplyDrainedResult(FISMBatchMutationResult& Result)
+{
+    UISMRuntimeComponent* Target = Result.TargetComponent.Get();
+    if (!Result.TargetComponent.IsValid() || Result.TargetComponent.IsStale())
+    {
+        UE_LOG(LogISMBatching, Warning, TEXT("DrainAndApplyResults: Discarding result with stale component"));
+        ResolveInFlightChunk(Result.ChunkId, true);
+    }
+    else if (!Target || !Target->IsValidLowLevel() || !IsValid(Target))
+    {
+        UE_LOG(LogISMBatching, Warning, TEXT("DrainAndApplyResults: Discarding result with invalid component"));
+        ResolveInFlightChunk(Result.ChunkId, true);
+    }
+    else if (IsResultStale(Result))
+    {
+        // A slot in the cell was recycled after the snapshot; drop the whole result
+        UE_LOG(LogISMBatching, Verbose, TEXT("DrainAndApplyResults: Discarding result with stale generation token"));
+        ResolveInFlightChunk(Result.ChunkId, true);
+    }
+    else
+    {
+        ApplyMutationResult(Result);
+        StashForwardedSnapshot(Result);
+        ResolveInFlightChunk(Result.ChunkId, false);
+    }
+
+    RecycleResult(Result);
 }
 
 void UISMBatchScheduler::EnforceHandleTimeouts(double CurrentTime)
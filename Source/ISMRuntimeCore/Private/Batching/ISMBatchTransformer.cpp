@@ -22,8 +22,10 @@ FISMMutationHandle::FISMMutationHandle(FISMMutationHandle&& Other) noexcept
     , TargetComponent(MoveTemp(Other.TargetComponent))
     , CellCoordinates(Other.CellCoordinates)
     , GenerationToken(Other.GenerationToken)
+    , ChunkId(Other.ChunkId)
     , IssuedTimeSeconds(Other.IssuedTimeSeconds)
     , bIsOpen(Other.bIsOpen)
+    , bForwardSnapshot(Other.bForwardSnapshot)
 {
 	// Source handle is now closed - it transferred ownership
     Other.bIsOpen = false;
@@ -43,8 +45,10 @@ FISMMutationHandle& FISMMutationHandle::operator=(FISMMutationHandle&& Other) no
         TargetComponent = MoveTemp(Other.TargetComponent);
         CellCoordinates = Other.CellCoordinates;
         GenerationToken = Other.GenerationToken;
+        ChunkId = Other.ChunkId;
         IssuedTimeSeconds = Other.IssuedTimeSeconds;
         bIsOpen = Other.bIsOpen;
+        bForwardSnapshot = Other.bForwardSnapshot;
 
         Other.bIsOpen = false;
     }
@@ -70,12 +74,50 @@ void FISMMutationHandle::Release(FISMBatchMutationResult&& Result)
 
     bIsOpen = false;
 
+    // The handle, not the transformer, vouches for which snapshot the result came from
+    Result.ComponentGenerationToken = static_cast<int32>(GenerationToken);
+    Result.ChunkId = ChunkId;
+
     if (UISMBatchSchedulerBase* Sched = Scheduler.Get())
     {
         Sched->OnHandleReleased(MoveTemp(Result), CellCoordinates, TargetComponent);
     }
 }
 
+void FISMMutationHandle::Release(FISMBatchMutationResult&& Result, FISMBatchSnapshot&& SpentSnapshot)
+{
+    if (bIsOpen && bForwardSnapshot)
+    {
+        Result.ForwardedSnapshot = MoveTemp(SpentSnapshot);
+    }
+    else if (bIsOpen)
+    {
+        if (UISMBatchSchedulerBase* Sched = Scheduler.Get())
+        {
+            Sched->RecycleSnapshot(MoveTemp(SpentSnapshot));
+        }
+    }
+
+    Release(MoveTemp(Result));
+}
+
+FISMBatchMutationResult FISMMutationHandle::AcquireResult(int32 ExpectedMutations) const
+{
+    FISMBatchMutationResult Result;
+    Result.TargetComponent = TargetComponent;
+    Result.CellCoordinates = CellCoordinates;
+
+    if (UISMBatchSchedulerBase* Sched = Scheduler.Get())
+    {
+        Sched->LeaseResultStorage(Result, ExpectedMutations);
+    }
+    else
+    {
+        Result.Mutations.Reserve(ExpectedMutations);
+    }
+    return Result;
+}
+
 void FISMMutationHandle::Abandon()
 {
     if (!bIsOpen)
@@ -88,6 +130,6 @@ void FISMMutationHandle::Abandon()
 
     if (UISMBatchSchedulerBase* Sched = Scheduler.Get())
     {
-        Sched->OnHandleAbandoned(CellCoordinates, TargetComponent);
+        Sched->OnHandleAbandoned(CellCoordinates, TargetComponent, ChunkId);
     }
 }
@@ -4,4 +4,36 @@
 bool FISMBatchSnapshot::IsValid() const
 {
 	return SourceComponent.IsValid() ;
+}
+
+SIZE_T FISMBatchSnapshot::GetAllocatedSize() const
+{
+	SIZE_T Size = Instances.GetAllocatedSize();
+	for (const FISMInstanceSnapshot& Instance : Instances)
+	{
+		Size += Instance.CustomData.GetAllocatedSize();
+	}
+
+	Size += SoA.GetAllocatedSize();
+
+	Size += Columns.GetAllocatedSize();
+	for (const FISMInstanceColumnSnapshot& Column : Columns)
+	{
+		Size += Column.Data.GetAllocatedSize();
+	}
+	return Size;
+}
+
+SIZE_T FISMBatchMutationResult::GetAllocatedSize() const
+{
+	SIZE_T Size = Mutations.GetAllocatedSize();
+	for (const FISMInstanceMutation& Mutation : Mutations)
+	{
+		if (Mutation.NewCustomData.IsSet())
+		{
+			Size += Mutation.NewCustomData->GetAllocatedSize();
+		}
+		Size += Mutation.CustomDataSlotOverrides.GetAllocatedSize();
+	}
+	return Size + Streams.GetAllocatedSize() + ForwardedSnapshot.GetAllocatedSize();
 }
\ No newline at end of file
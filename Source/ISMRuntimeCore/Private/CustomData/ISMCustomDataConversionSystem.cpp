@@ -4,6 +4,7 @@
 #include "ISMInstanceHandle.h"
 #include "ISMRuntimeComponent.h"
 #include "ISMInstanceDataAsset.h"
+#include "ISMRuntimeProfiling.h"
 #include "Logging/LogMacros.h"
 #include "CustomData/ISMCustomDataSchema.h"
 #include "CustomData/ISMCustomDataSubsystem.h"
@@ -33,6 +34,140 @@ FISMCustomDataConversionResult UISMCustomDataConversionSystem::ResolveAndApply(
     return Result;
 }
 
+int32 UISMCustomDataConversionSystem::ResolveAndApplyBatch(
+    TConstArrayView<FISMInstanceHandle> Handles,
+    TConstArrayView<AActor*> Actors,
+    UWorld* World)
+{
+    check(Handles.Num() == Actors.Num());
+    ISM_TRACE_SCOPE(UISMCustomDataConversionSystem::ResolveAndApplyBatch);
+
+    if (Handles.Num() <= 1)
+    {
+        return Handles.Num() == 1 && Actors[0] && ResolveAndApply(Handles[0], Actors[0], World).bSuccess ? 1 : 0;
+    }
+
+    UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+    UISMCustomDataSubsystem* Sub = GI ? GI->GetSubsystem<UISMCustomDataSubsystem>() : nullptr;
+    if (!Sub)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ISMCustomDataConversionSystem: Skipping batch DMI resolution — UISMCustomDataSubsystem not available"));
+        return 0;
+    }
+
+    // Per component: schema and the template of every slot that takes a DMI
+    struct FComponentContext
+    {
+        const FISMCustomDataSchema* Schema = nullptr;
+        TArray<TPair<int32, UMaterialInterface*>> SlotTemplates;
+    };
+    TMap<const UISMRuntimeComponent*, FComponentContext> Contexts;
+
+    // Per unique signature: what to build the DMI from, and the (entry, slot) pairs it goes to
+    struct FSignatureGroup
+    {
+        UMaterialInterface* Template = nullptr;
+        const FISMCustomDataSchema* Schema = nullptr;
+        int32 SlotIndex = 0;
+        TConstArrayView<float> CustomData;
+        TArray<TPair<int32, int32>> Targets;
+    };
+    TMap<FISMMaterialSignature, FSignatureGroup> Groups;
+    FISMMaterialSignature Key;
+
+    TBitArray<> Applied(false, Handles.Num());
+
+    for (int32 i = 0; i < Handles.Num(); ++i)
+    {
+        const FISMInstanceHandle& Handle = Handles[i];
+        AActor* Actor = Actors[i];
+        if (!Actor || !ShouldAttemptConversion(Handle))
+        {
+            continue;
+        }
+
+        UISMRuntimeComponent* Comp = Handle.Component.Get();
+        if (!Comp || !Comp->ManagedISMComponent)
+        {
+            continue;
+        }
+
+        FComponentContext* Context = Contexts.Find(Comp);
+        if (!Context)
+        {
+            Context = &Contexts.Add(Comp);
+            FName SchemaName;
+            Context->Schema = ResolveSchema(Handle, SchemaName);
+            if (Context->Schema)
+            {
+                for (const int32 SlotIdx : GetApplicableSlots(*Context->Schema, Comp))
+                {
+                    UMaterialInterface* Template = Context->Schema->UsesDMIForSlot(SlotIdx)
+                        ? Comp->ManagedISMComponent->GetMaterial(SlotIdx)
+                        : nullptr;
+                    if (Template)
+                    {
+                        Context->SlotTemplates.Emplace(SlotIdx, Template);
+                    }
+                }
+            }
+        }
+
+        const FISMCustomDataSchema* Schema = Context->Schema;
+        if (!Schema)
+        {
+            continue;
+        }
+
+        // Read in place from the ISM; nothing writes custom data until the batch is applied
+        const TConstArrayView<float> CustomData = Comp->GetInstanceCustomDataView(Handle.InstanceIndex);
+
+        if (Schema->ApplyMode == EISMCustomDataApplyMode::CustomPrimitiveData
+            && ApplyCustomPrimitiveDataToActor(Comp->GetCustomDataGatherTable(), CustomData, Actor))
+        {
+            Applied[i] = true;
+        }
+
+        for (const TPair<int32, UMaterialInterface*>& SlotTemplate : Context->SlotTemplates)
+        {
+            Key.Template = SlotTemplate.Value;
+            Key.MappedValues.SetNumUninitialized(Schema->GetNumMappedValues(), EAllowShrinking::No);
+            Schema->ExtractMappedValues(CustomData, Key.MappedValues);
+
+            FSignatureGroup& Group = Groups.FindOrAdd(Key);
+            if (Group.Targets.IsEmpty())
+            {
+                Group.Template = SlotTemplate.Value;
+                Group.Schema = Schema;
+                Group.SlotIndex = SlotTemplate.Key;
+                Group.CustomData = CustomData;
+            }
+            Group.Targets.Emplace(i, SlotTemplate.Key);
+        }
+    }
+
+    for (const TPair<FISMMaterialSignature, FSignatureGroup>& Pair : Groups)
+    {
+        const FSignatureGroup& Group = Pair.Value;
+        UMaterialInstanceDynamic* DMI = Sub->GetOrCreateDMI(
+            Group.Template, Group.CustomData, *Group.Schema, Group.SlotIndex, Group.Targets.Num());
+        if (!DMI)
+        {
+            continue;
+        }
+
+        for (const TPair<int32, int32>& Target : Group.Targets)
+        {
+            if (ApplyDMIToActorSlot(Actors[Target.Key], Target.Value, DMI))
+            {
+                Applied[Target.Key] = true;
+            }
+        }
+    }
+
+    return Applied.CountSetBits();
+}
+
 FISMCustomDataConversionResult UISMCustomDataConversionSystem::ResolveDMIs(
     const FISMInstanceHandle& InstanceHandle,
     UWorld* World)
@@ -75,14 +210,25 @@ FISMCustomDataConversionResult UISMCustomDataConversionSystem::ResolveDMIs(
 
     Result.ResolvedSchema = Schema;
     Result.ResolvedSchemaName = SchemaName;
+    Result.SourceComponent = Comp;
+    Result.SourceInstanceIndex = InstanceHandle.InstanceIndex;
 
     // Get applicable slots
     const TArray<int32> ApplicableSlots = GetApplicableSlots(*Schema, Comp);
 
     bool bAnyCacheHit = true; // will be false if any slot misses
 
+    // Read in place from the ISM - no per-conversion copy
+    const TConstArrayView<float> CustomData = Comp->GetInstanceCustomDataView(InstanceHandle.InstanceIndex);
+
     for (int32 SlotIdx : ApplicableSlots)
     {
+        // Slots fed by custom primitive data need no DMI
+        if (!Schema->UsesDMIForSlot(SlotIdx))
+        {
+            continue;
+        }
+
         UMaterialInterface* Template = Comp->ManagedISMComponent->GetMaterial(SlotIdx);
         if (!Template)
         {
@@ -92,7 +238,6 @@ FISMCustomDataConversionResult UISMCustomDataConversionSystem::ResolveDMIs(
 
         bool bCacheHit = false;
 
-        TArray<float> CustomData = InstanceHandle.GetCustomDataFromISM();
         UE_LOG(LogTemp, Warning, TEXT("ResolveDMIs: CustomData.Num()=%d, NumSlots=%d, Schema=%s"),
             CustomData.Num(),
             ApplicableSlots.Num(),
@@ -114,7 +259,8 @@ FISMCustomDataConversionResult UISMCustomDataConversionSystem::ResolveDMIs(
     }
 
     Result.bCacheHit = bAnyCacheHit;
-    Result.bSuccess = Result.DMIsBySlot.Num() > 0;
+    Result.bSuccess = Result.DMIsBySlot.Num() > 0
+        || Schema->ApplyMode == EISMCustomDataApplyMode::CustomPrimitiveData;
 
     if (!Result.bSuccess)
     {
@@ -137,6 +283,18 @@ void UISMCustomDataConversionSystem::ApplyToActor(
         return;
     }
 
+    if (Result.ResolvedSchema && Result.ResolvedSchema->ApplyMode == EISMCustomDataApplyMode::CustomPrimitiveData)
+    {
+        const UISMRuntimeComponent* Comp = Result.SourceComponent.Get();
+        if (Comp)
+        {
+            ApplyCustomPrimitiveDataToActor(
+                Comp->GetCustomDataGatherTable(),
+                Comp->GetInstanceCustomDataView(Result.SourceInstanceIndex),
+                ConvertedActor);
+        }
+    }
+
     for (const TTuple<int32, UMaterialInstanceDynamic*>& Entry : Result.DMIsBySlot)
     {
 		UE_LOG(LogTemp, Verbose, TEXT("ISMCustomDataConversionSystem: Applying DMI to actor - Slot: %d, DMI: %s"), Entry.Key, *GetNameSafe(Entry.Value));
@@ -223,33 +381,13 @@ const FISMCustomDataSchema* UISMCustomDataConversionSystem::ResolveSchema(
         return nullptr;
     }
 
-    // Try InstanceDataAsset first
-    if (Comp->InstanceData)
-    {
-        const FName ExplicitName = Comp->InstanceData->SchemaName;
-        const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
-
-        if (ExplicitName != NAME_None && Settings->HasSchema(ExplicitName))
-        {
-            OutSchemaName = ExplicitName;
-            return Settings->ResolveSchema(ExplicitName);
-        }
-    }
-    
-    UE_LOG(LogTemp, Warning, TEXT("ResolveSchema: Comp=%s, InstanceData=%s, SchemaName=%s"),
-        *GetNameSafe(Comp),
-        Comp ? *GetNameSafe(Comp->InstanceData) : TEXT("no comp"),
-        Comp && Comp->InstanceData ? *Comp->InstanceData->SchemaName.ToString() : TEXT("no asset"));
-
-    // Fall back to project default
-    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
-    if (const FISMCustomDataSchema* Default = Settings->GetDefaultSchema())
+    // Resolved once per component: InstanceDataAsset::SchemaName, then the project default
+    const FISMCustomDataSchema* Schema = Comp->GetCustomDataSchema(&OutSchemaName);
+    if (!Schema)
     {
-        OutSchemaName = Settings->DefaultSchemaName;
-        return Default;
+        UE_LOG(LogTemp, Warning, TEXT("ISMCustomDataConversionSystem: No schema specified on InstanceDataAsset, and no project default schema found"));
     }
-    UE_LOG(LogTemp, Warning, TEXT("ISMCustomDataConversionSystem: No schema specified on InstanceDataAsset, and no project default schema found"));
-    return nullptr;
+    return Schema;
 }
 
 TArray<int32> UISMCustomDataConversionSystem::GetApplicableSlots(
@@ -289,7 +427,7 @@ TArray<int32> UISMCustomDataConversionSystem::GetApplicableSlots(
 
 UMaterialInstanceDynamic* UISMCustomDataConversionSystem::ResolvePooledDMI(
     UMaterialInterface* Template,
-    const TArray<float>& CustomData,
+    TConstArrayView<float> CustomData,
     const FISMCustomDataSchema& Schema,
     int32 SlotIndex,
     UISMCustomDataSubsystem* Subsystem,
@@ -385,4 +523,41 @@ bool UISMCustomDataConversionSystem::ApplyDMIToFirstMeshComponent(
         *Actor->GetName());
 
     return false;
-}
\ No newline at end of file
+}
+
+bool UISMCustomDataConversionSystem::ApplyCustomPrimitiveDataToActor(
+    const FISMCustomDataGatherTable& Gather,
+    TConstArrayView<float> CustomData,
+    AActor* Actor)
+{
+    if (!Actor || CustomData.Num() == 0)
+    {
+        return false;
+    }
+
+    UPrimitiveComponent* Target = nullptr;
+    if (Actor->GetClass()->ImplementsInterface(UISMCustomDataMaterialProvider::StaticClass()))
+    {
+        Target = IISMCustomDataMaterialProvider::Execute_GetCustomPrimitiveDataTarget(Actor);
+    }
+    if (!Target)
+    {
+        Target = Actor->FindComponentByClass<UMeshComponent>();
+    }
+    if (!Target)
+    {
+        UE_LOG(LogTemp, Warning,
+            TEXT("ISMCustomDataConversionSystem: No primitive component for custom primitive data on actor %s"),
+            *Actor->GetName());
+        return false;
+    }
+
+    for (const FISMCustomDataGatherTable::FEntry& Entry : Gather.Entries)
+    {
+        const float Value = CustomData.IsValidIndex(Entry.SourceIndex)
+            ? FISMCustomDataChannelDef::QuantizeToStep(CustomData[Entry.SourceIndex], Entry.QuantizationStep)
+            : 0.f;
+        Target->SetCustomPrimitiveDataFloat(Entry.PrimitiveDataIndex, Value);
+    }
+    return true;
+}
@@ -26,22 +26,71 @@ TArray<int32> FISMCustomDataSchema::GetMappedIndices() const
 
 TArray<float> FISMCustomDataSchema::ExtractMappedValues(const TArray<float>& FullCustomData) const
 {
-	TArray<int32> MappedIndices = GetMappedIndices();
 	TArray<float> MappedValues;
-	for (int i = 0; i < MappedIndices.Num(); i++)
+	MappedValues.SetNumUninitialized(GetNumMappedValues());
+	ExtractMappedValues(FullCustomData, MappedValues);
+	return MappedValues;
+}
+
+void FISMCustomDataSchema::ExtractMappedValues(TArrayView<const float> FullCustomData, TArrayView<float> OutMappedValues) const
+{
+	int32 Out = 0;
+	for (const FISMCustomDataChannelDef& Channel : Channels)
 	{
-		int32 idx = MappedIndices[i];
-		if(FullCustomData.IsValidIndex(idx))
+		for (int32 c = 0; c < Channel.GetWidth(); c++)
 		{
-			MappedValues.Add(FullCustomData[idx]);
+			const int32 idx = Channel.DataIndex + c;
+			if(FullCustomData.IsValidIndex(idx))
+			{
+				OutMappedValues[Out++] = Channel.Quantize(FullCustomData[idx]);
+			}
+			else
+			{
+				OutMappedValues[Out++] = 0.f; // Default to 0 for out-of-bounds indices
+				UE_LOG(LogTemp, Warning, TEXT("FullCustomData does not contain index %d required by schema. Defaulting to 0."), idx);
+			}
 		}
-		else
+	}
+}
+
+int32 FISMCustomDataSchema::GetNumMappedValues() const
+{
+	int32 Num = 0;
+	for (const FISMCustomDataChannelDef& Channel : Channels)
+	{
+		Num += Channel.GetWidth();
+	}
+	return Num;
+}
+
+// ============================================================
+//  FISMCustomDataGatherTable
+// ============================================================
+
+void FISMCustomDataGatherTable::Build(const FISMCustomDataSchema& Schema)
+{
+	Entries.Reset(Schema.GetNumMappedValues());
+	for (const FISMCustomDataChannelDef& Channel : Schema.Channels)
+	{
+		for (int32 c = 0; c < Channel.GetWidth(); c++)
 		{
-			MappedValues.Add(0.f); // Default to 0 for out-of-bounds indices
-			UE_LOG(LogTemp, Warning, TEXT("FullCustomData does not contain index %d required by schema. Defaulting to 0."), idx);
+			FEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.SourceIndex = Channel.DataIndex + c;
+			Entry.PrimitiveDataIndex = Channel.GetPrimitiveDataIndex() + c;
+			Entry.QuantizationStep = Channel.QuantizationStep;
 		}
 	}
-	return MappedValues;
+}
+
+void FISMCustomDataGatherTable::Gather(TArrayView<const float> FullCustomData, TArrayView<float> OutMappedValues) const
+{
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		const FEntry& Entry = Entries[i];
+		OutMappedValues[i] = FullCustomData.IsValidIndex(Entry.SourceIndex)
+			? FISMCustomDataChannelDef::QuantizeToStep(FullCustomData[Entry.SourceIndex], Entry.QuantizationStep)
+			: 0.f;
+	}
 }
 
 
@@ -1,8 +1,11 @@
 // ISMCustomDataSubsystem.cpp
 #include "CustomData/ISMCustomDataSubsystem.h"
 #include "Settings/ISMRuntimeSchemaSettings.h"
+#include "Settings/ISMRuntimeSettings.h"
 #include "ISMInstanceHandle.h"
 #include "ISMRuntimeComponent.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMFrameBudget.h"
 #include "ISMInstanceDataAsset.h"
 #include "CustomData/ISMCustomDataSchema.h"
 #include "CustomData/ISMCustomDataConversionSystem.h"
@@ -12,9 +15,11 @@
 #include "Materials/MaterialInterface.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
+#include "Misc/ScopeExit.h"
 
 #if WITH_EDITOR
 #include "ISettingsModule.h"
+#include "UObject/UObjectIterator.h"
 #endif
 
 // ============================================================
@@ -31,9 +36,13 @@ void UISMHotDMIPool::Initialize(UMaterialInterface* InTemplate, int32 InPoolSize
         if (SourceTemplate.Get())
         {
             Slot.DMI = UMaterialInstanceDynamic::Create(SourceTemplate.Get(), this);
+            INC_DWORD_STAT(STAT_ISMDMIsCreated);
         }
         Slot.bClaimed = false;
     }
+    NumClaimed = 0;
+    PeakActive = 0;
+    ExhaustedAcquires = 0;
 }
 
 UMaterialInstanceDynamic* UISMHotDMIPool::Acquire(bool bAllowTransientFallback, int32& OutSlotIndex)
@@ -44,6 +53,7 @@ UMaterialInstanceDynamic* UISMHotDMIPool::Acquire(bool bAllowTransientFallback,
         if (!Slots[i].bClaimed && Slots[i].DMI)
         {
             Slots[i].bClaimed = true;
+            PeakActive = FMath::Max(PeakActive, ++NumClaimed);
             OutSlotIndex = i;
             return Slots[i].DMI;
         }
@@ -51,10 +61,12 @@ UMaterialInstanceDynamic* UISMHotDMIPool::Acquire(bool bAllowTransientFallback,
 
     // Pool exhausted
     OutSlotIndex = INDEX_NONE;
+    ExhaustedAcquires++;
 
     if (bAllowTransientFallback && SourceTemplate.Get())
     {
         // Create a transient DMI not tracked by the pool
+        INC_DWORD_STAT(STAT_ISMDMIsCreated);
         return UMaterialInstanceDynamic::Create(SourceTemplate.Get(), GetTransientPackage());
     }
 
@@ -69,6 +81,10 @@ void UISMHotDMIPool::Release(int32 SlotIndex)
     }
 
     FHotSlot& Slot = Slots[SlotIndex];
+    if (Slot.bClaimed)
+    {
+        --NumClaimed;
+    }
     Slot.bClaimed = false;
 
     // Reset parameters to template defaults so next claimant starts clean
@@ -79,14 +95,44 @@ void UISMHotDMIPool::Release(int32 SlotIndex)
     }
 }
 
-int32 UISMHotDMIPool::GetActiveCount() const
+void UISMHotDMIPool::Grow(int32 NewSize)
+{
+    const int32 OldSize = Slots.Num();
+    if (NewSize <= OldSize)
+    {
+        return;
+    }
+
+    Slots.SetNum(NewSize);
+    for (int32 i = OldSize; i < NewSize; ++i)
+    {
+        if (SourceTemplate.Get())
+        {
+            Slots[i].DMI = UMaterialInstanceDynamic::Create(SourceTemplate.Get(), this);
+            INC_DWORD_STAT(STAT_ISMDMIsCreated);
+        }
+        Slots[i].bClaimed = false;
+    }
+}
+
+int32 UISMHotDMIPool::ShrinkIdle(int32 NewSize)
 {
-    int32 Count = 0;
-    for (const FHotSlot& Slot : Slots)
+    // Claimed slots are addressed by index, so only the unclaimed tail can go
+    int32 Size = Slots.Num();
+    while (Size > FMath::Max(NewSize, 0) && !Slots[Size - 1].bClaimed)
     {
-        if (Slot.bClaimed) { ++Count; }
+        --Size;
     }
-    return Count;
+    Slots.SetNum(Size);
+    return Size;
+}
+
+void UISMHotDMIPool::ConsumeWindowCounters(int32& OutPeakActive, int32& OutExhaustedAcquires)
+{
+    OutPeakActive = PeakActive;
+    OutExhaustedAcquires = ExhaustedAcquires;
+    PeakActive = NumClaimed;
+    ExhaustedAcquires = 0;
 }
 
 // ============================================================
@@ -97,6 +143,11 @@ void UISMCustomDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
 
+    // A headless server converts instances without ever drawing them; no DMI is worth building
+    const UISMRuntimeSettings* RuntimeSettings = GetDefault<UISMRuntimeSettings>();
+    const UGameInstance* GameInstance = GetGameInstance();
+    bHeadless = RuntimeSettings && RuntimeSettings->IsHeadlessFor(GameInstance ? GameInstance->IsDedicatedServerInstance() : IsRunningDedicatedServer());
+
     // Register world tick delegate for eviction and hot handle ticking
     WorldTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
         this, &UISMCustomDataSubsystem::OnWorldTick);
@@ -156,44 +207,17 @@ const FISMCustomDataSchema* UISMCustomDataSubsystem::ResolveSchemaForInstance(
     const FISMInstanceHandle& InstanceHandle,
     FName& OutSchemaName) const
 {
-    OutSchemaName = NAME_None;
-
-    UISMRuntimeComponent* Comp = InstanceHandle.Component.Get();
-    if (!Comp)
-    {
-        return nullptr;
-    }
-
-    // Opt-out check
-    if (Comp->InstanceData && !Comp->InstanceData->bUsePICDConversion)
-    {
-        return nullptr;
-    }
-
-    // Try explicit schema name from asset
-    if (Comp->InstanceData && Comp->InstanceData->SchemaName != NAME_None)
-    {
-        const FISMCustomDataSchema* Schema = ResolveSchema(Comp->InstanceData->SchemaName);
-        if (Schema)
-        {
-            OutSchemaName = Comp->InstanceData->SchemaName;
-            return Schema;
-        }
-    }
+    return ResolveSchemaForComponent(InstanceHandle.Component.Get(), OutSchemaName);
+}
 
-    // Fall back to project default
-    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
-    if (Settings->DefaultSchemaName != NAME_None)
-    {
-        const FISMCustomDataSchema* Schema = ResolveSchema(Settings->DefaultSchemaName);
-        if (Schema)
-        {
-            OutSchemaName = Settings->DefaultSchemaName;
-            return Schema;
-        }
-    }
+const FISMCustomDataSchema* UISMCustomDataSubsystem::ResolveSchemaForComponent(
+    const UISMRuntimeComponent* Comp,
+    FName& OutSchemaName) const
+{
+    OutSchemaName = NAME_None;
 
-    return nullptr;
+    // Resolved once per component, including the InstanceData opt-out and project default fallback
+    return Comp ? Comp->GetCustomDataSchema(&OutSchemaName) : nullptr;
 }
 
 // ============================================================
@@ -202,16 +226,25 @@ const FISMCustomDataSchema* UISMCustomDataSubsystem::ResolveSchemaForInstance(
 
 UMaterialInstanceDynamic* UISMCustomDataSubsystem::GetOrCreateDMI(
     UMaterialInterface* Template,
-    const TArray<float>& CustomData,
+    TConstArrayView<float> CustomData,
     const FISMCustomDataSchema& Schema,
-    int32 SlotIndex)
+    int32 SlotIndex,
+    int32 NumReferences)
 {
-    if (!Template)
+    if (!Template || NumReferences <= 0 || bHeadless)
     {
         return nullptr;
     }
 
-    const FISMMaterialSignature Sig = BuildSignature(Template, CustomData, Schema, SlotIndex);
+    ISM_TRACE_SCOPE(UISMCustomDataSubsystem::GetOrCreateDMI);
+    SCOPE_CYCLE_COUNTER(STAT_ISMAcquireDMI);
+    LLM_SCOPE_BYTAG(ISMRuntime_CustomData);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    ON_SCOPE_EXIT { RecordAcquireTime(StartCycles); };
+
+    BuildSignature(Template, CustomData, Schema, SlotIndex, LookupSignature);
+    const FISMMaterialSignature& Sig = LookupSignature;
 
     // Cache hit
     if (FISMPooledMaterial* Existing = SharedPool.Find(Sig))
@@ -219,9 +252,14 @@ UMaterialInstanceDynamic* UISMCustomDataSubsystem::GetOrCreateDMI(
         if (Existing->DMI && Existing->DMI->IsValidLowLevel() && Existing->DMI->GetRenderProxy())
         {
             Existing->LastUsedFrame = GFrameCounter;
-            Existing->RefCount++;
-            SharedPoolStats.CacheHits++;
-            SharedPoolStats.TotalPooledDMIs = SharedPool.Num();
+            if (Existing->RefCount == 0)
+            {
+                UnlinkIdle(*Existing);
+            }
+            Existing->RefCount += NumReferences;
+            SharedPoolStats.CacheHits += NumReferences;
+            SharedPoolStats.SchemaStats.FindOrAdd(Schema.DisplayName).CacheHits += NumReferences;
+            UpdatePoolSizeStats();
             return Existing->DMI;
         }
 
@@ -231,18 +269,18 @@ UMaterialInstanceDynamic* UISMCustomDataSubsystem::GetOrCreateDMI(
         if (Existing->DMI)
         {
             UE_LOG(LogISMRuntimeCore, Verbose, TEXT("  DMI %s is %s"),*Existing->DMI->GetName(),Existing->DMI->IsValidLowLevel() ? TEXT("valid") : TEXT("invalid"));
-			Existing->DMI->RemoveFromRoot();
         }
-        SharedPool.Remove(Sig);
+        RemoveSharedEntry(Sig);
     }
 
     // Cache miss — create new DMI
     SharedPoolStats.CacheMisses++;
+    SharedPoolStats.SchemaStats.FindOrAdd(Schema.DisplayName).CacheMisses++;
 
-    // Enforce max pool size via LRU eviction before adding
-    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
-    const int32 MaxSize = Settings->DefaultMaxSharedPoolSize;
-    if (MaxSize > 0 && SharedPool.Num() >= MaxSize)
+    // Enforce max pool size via LRU eviction before adding; past the frame's budget the pool
+    // overshoots and OnWorldTick trims it back
+    const int32 MaxSize = GetEffectiveMaxSharedPoolSize();
+    if (MaxSize > 0 && SharedPool.Num() >= MaxSize && IdleEntries.Num() > 0 && ConsumeEvictionBudget())
     {
         EvictLRUEntry();
     }
@@ -252,33 +290,45 @@ UMaterialInstanceDynamic* UISMCustomDataSubsystem::GetOrCreateDMI(
     {
         return nullptr;
     }
-	NewDMI->AddToRoot(); // Prevent GC — manually managed by pool
     FISMPooledMaterial& Entry = SharedPool.Add(Sig);
     Entry.DMI = NewDMI;
+    Entry.ArenaIndex = AdoptDMI(NewDMI);
     Entry.LastUsedFrame = GFrameCounter;
-    Entry.RefCount = 1;
+    Entry.RefCount = NumReferences;
 
-    SharedPoolStats.TotalPooledDMIs = SharedPool.Num();
+    // The batch's other references found the DMI, as separate calls would have
+    SharedPoolStats.CacheHits += NumReferences - 1;
+    SharedPoolStats.SchemaStats.FindOrAdd(Schema.DisplayName).CacheHits += NumReferences - 1;
+
+    UpdatePoolSizeStats();
 
     return NewDMI;
 }
 
 void UISMCustomDataSubsystem::ReleaseDMI(
     UMaterialInterface* Template,
-    const TArray<float>& CustomData,
+    TConstArrayView<float> CustomData,
     const FISMCustomDataSchema& Schema,
     int32 SlotIndex)
 {
-    if (!Template)
+    if (!Template || bHeadless)
     {
         return;
     }
 
-    const FISMMaterialSignature Sig = BuildSignature(Template, CustomData, Schema, SlotIndex);
+    BuildSignature(Template, CustomData, Schema, SlotIndex, LookupSignature);
+    const FISMMaterialSignature& Sig = LookupSignature;
 
-    if (FISMPooledMaterial* Entry = SharedPool.Find(Sig))
+    FISMPooledMaterial* Entry = SharedPool.Find(Sig);
+    if (!Entry || Entry->RefCount == 0)
     {
-        Entry->RefCount = FMath::Max(0, Entry->RefCount - 1);
+        return;
+    }
+
+    if (--Entry->RefCount == 0)
+    {
+        Entry->LastUsedFrame = GFrameCounter;
+        LinkIdle(Sig, *Entry);
     }
 }
 
@@ -291,45 +341,104 @@ void UISMCustomDataSubsystem::EvictStaleDMIs(int32 MaxAgeFrames)
         ? Settings->DefaultEvictionAgeFrames
         : MaxAgeFrames;
 
-    TArray<FISMMaterialSignature> ToRemove;
+    // Only unreferenced entries are on the idle list, oldest first - stop at the first young one
+    while (FISMMaterialLRUList::TDoubleLinkedListNode* Oldest = IdleEntries.GetHead())
+    {
+        const FISMPooledMaterial* Entry = SharedPool.Find(Oldest->GetValue());
+        const uint32 Age = Entry ? GFrameCounter - Entry->LastUsedFrame : 0;
+        if (Entry && EffectiveMaxAge != 0 && Age < static_cast<uint32>(EffectiveMaxAge))
+        {
+            break;
+        }
+
+        EvictLRUEntry();
+    }
+
+    UpdatePoolSizeStats();
+}
+
+void UISMCustomDataSubsystem::FlushSharedPool()
+{
+    // Dropping the arena releases every DMI reference at once; GC collects them together
+    SharedPool.Empty();
+    IdleEntries.Empty();
+    DMIArena.Empty();
+    FreeArenaSlots.Empty();
+    PendingPrewarms.Empty();
+    PendingPrewarmHead = 0;
+    UpdatePoolSizeStats();
+}
 
-    for (auto& Pair : SharedPool)
+void UISMCustomDataSubsystem::QueuePrewarmForComponent(UISMRuntimeComponent* Component)
+{
+    if (!Component || !Component->ManagedISMComponent || !Component->InstanceData || bHeadless)
     {
-        const FISMPooledMaterial& Entry = Pair.Value;
+        return;
+    }
 
-        // Never evict referenced entries
-        if (Entry.RefCount > 0)
+    FName SchemaName;
+    const FISMCustomDataSchema* Schema = ResolveSchemaForComponent(Component, SchemaName);
+    if (!Schema)
+    {
+        return;
+    }
+
+    const UISMInstanceDataAsset* Data = Component->InstanceData;
+
+    // One row per mapped-value signature: rows differing only in unmapped channels share a DMI
+    const FISMCustomDataGatherTable& Gather = Component->GetCustomDataGatherTable();
+    TArray<TArray<float>> Rows;
+    TSet<FISMMaterialSignature> Seen;
+    FISMMaterialSignature Key;
+    auto AddRow = [&](TConstArrayView<float> Row)
+    {
+        Key.MappedValues.SetNumUninitialized(Gather.Num(), EAllowShrinking::No);
+        Gather.Gather(Row, Key.MappedValues);
+        if (!Seen.Contains(Key))
         {
-            continue;
+            Seen.Add(Key);
+            Rows.Emplace(Row);
         }
+    };
+
+    for (const FISMCustomDataPrewarmRow& Declared : Data->PrewarmCustomData)
+    {
+        AddRow(Declared.CustomData);
+    }
 
-        const uint32 Age = GFrameCounter - Entry.LastUsedFrame;
-        if (EffectiveMaxAge == 0 || Age >= static_cast<uint32>(EffectiveMaxAge))
+    const int32 MaxSampled = Data->MaxPrewarmSignatures;
+    const int32 NumDeclared = Rows.Num();
+    for (int32 i = 0; i < Component->GetInstanceCount() && Rows.Num() - NumDeclared < MaxSampled; ++i)
+    {
+        const TConstArrayView<float> Row = Component->GetInstanceCustomDataView(i);
+        if (Row.Num() > 0)
         {
-            ToRemove.Add(Pair.Key);
+            AddRow(Row);
         }
     }
 
-    for (const FISMMaterialSignature& Sig : ToRemove)
+    if (Rows.Num() == 0)
     {
-        SharedPool.Remove(Sig);
-        SharedPoolStats.EvictedEntries++;
+        return;
     }
 
-    SharedPoolStats.TotalPooledDMIs = SharedPool.Num();
-}
-
-void UISMCustomDataSubsystem::FlushSharedPool()
-{
-    for (auto& Pair : SharedPool)
+    for (int32 SlotIdx : UISMCustomDataConversionSystem::GetApplicableSlots(*Schema, Component))
     {
-        if (Pair.Value.DMI)
+        UMaterialInterface* Template = Component->ManagedISMComponent->GetMaterial(SlotIdx);
+        if (!Template)
+        {
+            continue;
+        }
+
+        for (const TArray<float>& Row : Rows)
         {
-            Pair.Value.DMI->RemoveFromRoot();
+            FPendingPrewarm& Pending = PendingPrewarms.AddDefaulted_GetRef();
+            Pending.Template = Template;
+            Pending.CustomData = Row;
+            Pending.SchemaName = SchemaName;
+            Pending.SlotIndex = SlotIdx;
         }
     }
-    SharedPool.Empty();
-    SharedPoolStats.TotalPooledDMIs = 0;
 }
 
 // ============================================================
@@ -342,6 +451,10 @@ FISMHotDMIHandle UISMCustomDataSubsystem::AcquireHotDMI(
     int32 SlotIndex,
     const FISMHotDMIRequest& Request)
 {
+    ISM_TRACE_SCOPE(UISMCustomDataSubsystem::AcquireHotDMI);
+    SCOPE_CYCLE_COUNTER(STAT_ISMAcquireDMI);
+    LLM_SCOPE_BYTAG(ISMRuntime_CustomData);
+
     FISMHotDMIHandle HotHandle;
     HotHandle.InstanceHandle = &Handle;
     HotHandle.MaterialSlotIndex = SlotIndex;
@@ -366,6 +479,11 @@ FISMHotDMIHandle UISMCustomDataSubsystem::AcquireHotDMI(
 
     HotHandle.HotDMI = DMI;
     HotHandle.PoolSlotIndex = SlotIdx;
+    HotHandle.HotId = NextHotId++;
+    if (NextHotId == 0)
+    {
+        NextHotId = 1;
+    }
 
     if (SlotIdx == INDEX_NONE)
     {
@@ -381,7 +499,39 @@ FISMHotDMIHandle UISMCustomDataSubsystem::AcquireHotDMI(
     }
 
     // Track for ticking
-    ActiveHotHandles.Add(&HotHandle);
+    const UISMRuntimeComponent* Comp = Handle.Component.Get();
+    FName SchemaName;
+    const FISMCustomDataSchema* Schema = ResolveSchemaForComponent(Comp, SchemaName);
+    const int32 NumValues = Schema ? Comp->GetCustomDataGatherTable().Num() : 0;
+
+    FHotHandleRows& Rows = HotRows;
+    Rows.Ids.Add(HotHandle.HotId);
+    Rows.Instances.Add(&Handle);
+    Rows.DMIs.Add(DMI);
+    Rows.Pools.Add(Pool);
+    Rows.PoolSlots.Add(SlotIdx);
+    Rows.MaterialSlots.Add(SlotIndex);
+    Rows.Schemas.Add(Schema);
+    Rows.SettleModes.Add(Request.SettleMode);
+    Rows.SettleFrameThresholds.Add(Request.SettleFrameThreshold);
+    Rows.SettleDurations.Add(Request.SettleDuration);
+    Rows.Elapsed.Add(0.f);
+    Rows.StableFrames.Add(0);
+    Rows.ValueOffsets.Add(Rows.Values.Num());
+    Rows.ValueCounts.Add(NumValues);
+    Rows.Values.AddZeroed(NumValues);
+    Rows.Gathered.AddZeroed(NumValues);
+    Rows.Changed.Add(0);
+    Rows.Settled.Add(0);
+
+    // Start the DMI from the instance's current values so the first tick only pushes changes
+    if (Schema && NumValues > 0)
+    {
+        const TConstArrayView<float> CustomData = Comp->GetInstanceCustomDataView(Handle.InstanceIndex);
+        const int32 Offset = Rows.ValueOffsets.Last();
+        Comp->GetCustomDataGatherTable().Gather(CustomData, TArrayView<float>(Rows.Values.GetData() + Offset, NumValues));
+        ApplyCustomDataToMaterial(DMI, CustomData, *Schema, SlotIndex);
+    }
 
     return HotHandle;
 }
@@ -393,94 +543,277 @@ void UISMCustomDataSubsystem::SurrenderHotDMI(FISMHotDMIHandle& HotHandle, UWorl
         return;
     }
 
-    // Remove from active list
-    ActiveHotHandles.Remove(&HotHandle);
+    const int32 Row = HotRows.Find(HotHandle.HotId);
+    if (Row != INDEX_NONE)
+    {
+        SurrenderHotRow(Row, World);
+        const int32 Rows[] = { Row };
+        HotRows.RemoveRows(Rows);
+
+        HotPoolStats.ManualSurrenders++;
+        HotPoolStats.TotalSurrenders++;
+    }
+
+    // Invalidate the handle
+    HotHandle.HotDMI.Reset();
+    HotHandle.PoolSlotIndex = INDEX_NONE;
+    HotHandle.InstanceHandle = nullptr;
+    HotHandle.HotId = 0;
+}
+
+bool UISMCustomDataSubsystem::IsHotDMIActive(const FISMHotDMIHandle& HotHandle) const
+{
+    return HotHandle.HotId != 0 && HotRows.Find(HotHandle.HotId) != INDEX_NONE;
+}
+
+void UISMCustomDataSubsystem::SurrenderHotRow(int32 Row, UWorld* World)
+{
+    FHotHandleRows& Rows = HotRows;
+
+    // Release the slot to the pool it came from — resets parameters to template defaults
+    if (UISMHotDMIPool* Pool = Rows.Pools[Row].Get())
+    {
+        Pool->Release(Rows.PoolSlots[Row]);
+    }
+    Rows.DMIs[Row].Reset();
+
+    HotPoolStats.ActiveHotDMIs = FMath::Max(0, HotPoolStats.ActiveHotDMIs - 1);
+
+    // Resolve and apply the correct shared DMI for the final settled values
+    FISMInstanceHandle* Handle = Rows.Instances[Row];
+    const FISMCustomDataSchema* Schema = Rows.Schemas[Row];
+    const int32 MaterialSlot = Rows.MaterialSlots[Row];
+    if (!Handle || !Handle->IsValid() || !World || !Schema || !Handle->ConvertedActor.IsValid())
+    {
+        return;
+    }
+
+    UISMRuntimeComponent* Comp = Handle->Component.Get();
+    UMaterialInterface* Template = Comp && Comp->ManagedISMComponent
+        ? Comp->ManagedISMComponent->GetMaterial(MaterialSlot)
+        : nullptr;
+    if (!Template)
+    {
+        return;
+    }
 
-    // Find the pool for this DMI's template to release the slot
-    UMaterialInstanceDynamic* HotDMI = HotHandle.HotDMI.Get();
-    if (HotDMI && HotHandle.PoolSlotIndex != INDEX_NONE)
+    UMaterialInstanceDynamic* SharedDMI = GetOrCreateDMI(
+        Template,
+        Comp->GetInstanceCustomDataView(Handle->InstanceIndex),
+        *Schema,
+        MaterialSlot);
+
+    if (SharedDMI)
     {
-        // Find which pool owns this slot
-        for (auto& Pair : HotPools)
+        // Build a minimal result for this single slot
+        FISMCustomDataConversionResult Result;
+        Result.bSuccess = true;
+        Result.ResolvedSchema = Schema;
+        Comp->GetCustomDataSchema(&Result.ResolvedSchemaName);
+        Result.DMIsBySlot.Add(MaterialSlot, SharedDMI);
+        UISMCustomDataConversionSystem::ApplyToActor(Result, Handle->ConvertedActor.Get());
+    }
+}
+
+void UISMCustomDataSubsystem::PushChangedHotParameters(int32 Row)
+{
+    FHotHandleRows& Rows = HotRows;
+    UMaterialInstanceDynamic* DMI = Rows.DMIs[Row].Get();
+    const FISMCustomDataSchema* Schema = Rows.Schemas[Row];
+    if (!DMI || !Schema)
+    {
+        return;
+    }
+
+    const float* Last = Rows.Values.GetData() + Rows.ValueOffsets[Row];
+    const float* Now = Rows.Gathered.GetData() + Rows.ValueOffsets[Row];
+
+    // Gathered values follow channel order, so each channel owns the next GetWidth() floats
+    int32 Offset = 0;
+    for (const FISMCustomDataChannelDef& Channel : Schema->Channels)
+    {
+        const int32 Width = Channel.GetWidth();
+        if (FMemory::Memcmp(Last + Offset, Now + Offset, Width * sizeof(float)) != 0)
         {
-            if (Pair.Value && Pair.Value->GetTemplate())
+            if (Channel.bIsVector)
             {
-                // Release the slot — resets parameters to template defaults
-                Pair.Value->Release(HotHandle.PoolSlotIndex);
-                break;
+                FLinearColor Vec(0.f, 0.f, 0.f, 0.f);
+                FMemory::Memcpy(&Vec.R, Now + Offset, FMath::Min(Width, 4) * sizeof(float));
+                DMI->SetVectorParameterValue(Channel.ParameterName, Vec);
+            }
+            else
+            {
+                DMI->SetScalarParameterValue(Channel.ParameterName, Now[Offset]);
             }
         }
+        Offset += Width;
     }
+}
 
-    HotPoolStats.ActiveHotDMIs = FMath::Max(0, HotPoolStats.ActiveHotDMIs - 1);
+void UISMCustomDataSubsystem::TickHotHandles(float DeltaTime, UWorld* World)
+{
+    FHotHandleRows& Rows = HotRows;
+    const int32 NumRows = Rows.Num();
+    if (NumRows == 0)
+    {
+        return;
+    }
 
-    // Resolve and apply the correct shared DMI for the final settled values
-    FISMInstanceHandle* Handle = HotHandle.InstanceHandle;
-    if (Handle && Handle->IsValid() && World)
+    // Gather: each row's mapped values, straight from the ISM's custom data, into Gathered.
+    // Rows whose instance or DMI is gone settle immediately.
+    for (int32 i = 0; i < NumRows; ++i)
     {
-        // If the instance is currently a converted actor, apply the shared DMI
-        if (Handle->ConvertedActor.IsValid())
+        const FISMInstanceHandle* Handle = Rows.Instances[i];
+        const UISMRuntimeComponent* Comp = Handle ? Handle->Component.Get() : nullptr;
+        if (!Comp || !Rows.DMIs[i].IsValid())
         {
-            FName SchemaName;
-            const FISMCustomDataSchema* Schema = ResolveSchemaForInstance(*Handle, SchemaName);
-            if (Schema && Handle->Component.IsValid() && Handle->Component->ManagedISMComponent)
-            {
-                UMaterialInterface* Template = Handle->Component->ManagedISMComponent->GetMaterial(
-                    HotHandle.MaterialSlotIndex);
+            Rows.Settled[i] = 1;
+            continue;
+        }
+        if (Rows.ValueCounts[i] > 0)
+        {
+            Comp->GetCustomDataGatherTable().Gather(
+                Comp->GetInstanceCustomDataView(Handle->InstanceIndex),
+                TArrayView<float>(Rows.Gathered.GetData() + Rows.ValueOffsets[i], Rows.ValueCounts[i]));
+        }
+    }
 
-                if (Template)
-                {
-                    UMaterialInstanceDynamic* SharedDMI = GetOrCreateDMI(
-                        Template,
-                        Handle->GetCustomDataFromISM(),
-                        *Schema,
-                        HotHandle.MaterialSlotIndex);
-
-                    if (SharedDMI)
-                    {
-                        UISMCustomDataConversionSystem::ApplyToActor(
-                            // Build a minimal result for this single slot
-                            [&]() -> FISMCustomDataConversionResult {
-                                FISMCustomDataConversionResult R;
-                                R.bSuccess = true;
-                                R.ResolvedSchema = Schema;
-                                R.ResolvedSchemaName = SchemaName;
-                                R.DMIsBySlot.Add(HotHandle.MaterialSlotIndex, SharedDMI);
-                                return R;
-                            }(),
-                                Handle->ConvertedActor.Get());
-                    }
-                }
-            }
+    // Diff: one compare per row over its contiguous slice
+    for (int32 i = 0; i < NumRows; ++i)
+    {
+        const int32 Offset = Rows.ValueOffsets[i];
+        Rows.Changed[i] = FMemory::Memcmp(Rows.Values.GetData() + Offset, Rows.Gathered.GetData() + Offset,
+            Rows.ValueCounts[i] * sizeof(float)) != 0;
+    }
+
+    // Push: only rows that changed, only channels that changed
+    for (int32 i = 0; i < NumRows; ++i)
+    {
+        if (Rows.Changed[i] && !Rows.Settled[i])
+        {
+            PushChangedHotParameters(i);
         }
     }
+    FMemory::Memcpy(Rows.Values.GetData(), Rows.Gathered.GetData(), Rows.Values.Num() * sizeof(float));
 
-    // Invalidate the handle
-    HotHandle.HotDMI.Reset();
-    HotHandle.PoolSlotIndex = INDEX_NONE;
-    HotHandle.InstanceHandle = nullptr;
+    // Settle: branch-free passes over the parallel arrays
+    for (int32 i = 0; i < NumRows; ++i)
+    {
+        Rows.StableFrames[i] = Rows.Changed[i] ? 0 : Rows.StableFrames[i] + 1;
+        Rows.Elapsed[i] += DeltaTime;
+    }
+
+    int32 NumAutoDetect = 0;
+    int32 NumTimed = 0;
+    for (int32 i = 0; i < NumRows; ++i)
+    {
+        const bool bAutoDetect = Rows.SettleModes[i] == EISMAnimationSettleMode::AutoDetect
+            && Rows.StableFrames[i] >= Rows.SettleFrameThresholds[i];
+        const bool bTimed = Rows.SettleModes[i] == EISMAnimationSettleMode::Timed
+            && Rows.Elapsed[i] >= Rows.SettleDurations[i];
+        NumAutoDetect += (bAutoDetect && !Rows.Settled[i]) ? 1 : 0;
+        NumTimed += (bTimed && !Rows.Settled[i]) ? 1 : 0;
+        Rows.Settled[i] |= (bAutoDetect | bTimed) ? 1 : 0;
+    }
+
+    // Surrender everything that settled this frame, then compact once
+    TArray<int32, TInlineAllocator<32>> SettledRows;
+    for (int32 i = 0; i < NumRows; ++i)
+    {
+        if (Rows.Settled[i])
+        {
+            SettledRows.Add(i);
+        }
+    }
+    if (SettledRows.Num() == 0)
+    {
+        return;
+    }
+
+    for (int32 Row : SettledRows)
+    {
+        SurrenderHotRow(Row, World);
+    }
+    Rows.RemoveRows(SettledRows);
+
+    HotPoolStats.AutoDetectSurrenders += NumAutoDetect;
+    HotPoolStats.TimedSurrenders += NumTimed;
+    HotPoolStats.TotalSurrenders += NumAutoDetect + NumTimed;
 }
 
-void UISMCustomDataSubsystem::TickHotHandles(float DeltaTime, UWorld* World)
+void UISMCustomDataSubsystem::FHotHandleRows::Reset()
 {
-    // Iterate backwards so we can safely remove surrendered handles
-    for (int32 i = ActiveHotHandles.Num() - 1; i >= 0; --i)
+    *this = FHotHandleRows();
+}
+
+void UISMCustomDataSubsystem::FHotHandleRows::RemoveRows(TConstArrayView<int32> SortedRows)
+{
+    if (SortedRows.Num() == 0)
     {
-        FISMHotDMIHandle* Handle = ActiveHotHandles[i];
-        if (!Handle || !Handle->IsActive())
+        return;
+    }
+
+    // Single forward pass: rows after each removed one slide down, values repack contiguously
+    int32 Write = 0;
+    int32 WriteValue = 0;
+    int32 NextRemoved = 0;
+    for (int32 Read = 0; Read < Num(); ++Read)
+    {
+        if (NextRemoved < SortedRows.Num() && SortedRows[NextRemoved] == Read)
         {
-            ActiveHotHandles.RemoveAtSwap(i, EAllowShrinking::Yes);
+            ++NextRemoved;
             continue;
         }
 
-        Handle->Tick(DeltaTime, World);
-
-        // Surrender may have been triggered by Tick (Timed or AutoDetect settle)
-        if (!Handle->IsActive())
+        const int32 ReadValue = ValueOffsets[Read];
+        const int32 Count = ValueCounts[Read];
+        if (Write != Read)
+        {
+            Ids[Write] = Ids[Read];
+            Instances[Write] = Instances[Read];
+            DMIs[Write] = MoveTemp(DMIs[Read]);
+            Pools[Write] = MoveTemp(Pools[Read]);
+            PoolSlots[Write] = PoolSlots[Read];
+            MaterialSlots[Write] = MaterialSlots[Read];
+            Schemas[Write] = Schemas[Read];
+            SettleModes[Write] = SettleModes[Read];
+            SettleFrameThresholds[Write] = SettleFrameThresholds[Read];
+            SettleDurations[Write] = SettleDurations[Read];
+            Elapsed[Write] = Elapsed[Read];
+            StableFrames[Write] = StableFrames[Read];
+            ValueCounts[Write] = Count;
+            Changed[Write] = Changed[Read];
+            Settled[Write] = Settled[Read];
+        }
+        if (WriteValue != ReadValue)
         {
-            ActiveHotHandles.RemoveAtSwap(i, EAllowShrinking::Yes);
+            FMemory::Memmove(Values.GetData() + WriteValue, Values.GetData() + ReadValue, Count * sizeof(float));
+            FMemory::Memmove(Gathered.GetData() + WriteValue, Gathered.GetData() + ReadValue, Count * sizeof(float));
         }
+        ValueOffsets[Write] = WriteValue;
+        ++Write;
+        WriteValue += Count;
     }
+
+    const int32 NewNum = Write;
+    Ids.SetNum(NewNum, EAllowShrinking::No);
+    Instances.SetNum(NewNum, EAllowShrinking::No);
+    DMIs.SetNum(NewNum, EAllowShrinking::No);
+    Pools.SetNum(NewNum, EAllowShrinking::No);
+    PoolSlots.SetNum(NewNum, EAllowShrinking::No);
+    MaterialSlots.SetNum(NewNum, EAllowShrinking::No);
+    Schemas.SetNum(NewNum, EAllowShrinking::No);
+    SettleModes.SetNum(NewNum, EAllowShrinking::No);
+    SettleFrameThresholds.SetNum(NewNum, EAllowShrinking::No);
+    SettleDurations.SetNum(NewNum, EAllowShrinking::No);
+    Elapsed.SetNum(NewNum, EAllowShrinking::No);
+    StableFrames.SetNum(NewNum, EAllowShrinking::No);
+    ValueOffsets.SetNum(NewNum, EAllowShrinking::No);
+    ValueCounts.SetNum(NewNum, EAllowShrinking::No);
+    Changed.SetNum(NewNum, EAllowShrinking::No);
+    Settled.SetNum(NewNum, EAllowShrinking::No);
+    Values.SetNum(WriteValue, EAllowShrinking::No);
+    Gathered.SetNum(WriteValue, EAllowShrinking::No);
 }
 
 void UISMCustomDataSubsystem::PrewarmHotPool(UMaterialInterface* Template, int32 PoolSize)
@@ -509,7 +842,7 @@ void UISMCustomDataSubsystem::PrewarmHotPool(UMaterialInterface* Template, int32
 
 void UISMCustomDataSubsystem::FlushHotPools()
 {
-    ActiveHotHandles.Empty();
+    HotRows.Reset();
 
     for (auto& Pair : HotPools)
     {
@@ -530,7 +863,7 @@ void UISMCustomDataSubsystem::FlushHotPools()
 void UISMCustomDataSubsystem::ResetStats()
 {
     SharedPoolStats = FISMDMIPoolStats();
-    SharedPoolStats.TotalPooledDMIs = SharedPool.Num();
+    UpdatePoolSizeStats();
 
     HotPoolStats.TotalSurrenders = 0;
     HotPoolStats.TransientFallbackCount = 0;
@@ -538,27 +871,285 @@ void UISMCustomDataSubsystem::ResetStats()
     HotPoolStats.ManualSurrenders = 0;
     HotPoolStats.TimedSurrenders = 0;
     // Preserve ActiveHotDMIs and TotalHotPoolCapacity — those are live state
+
+    // Restart the open window so its deltas are taken against the zeroed counters
+    WindowStartSeconds = FPlatformTime::Seconds();
+    WindowStartHits = 0;
+    WindowStartMisses = 0;
+    WindowStartEvictions = 0;
+    WindowStartFallbacks = 0;
+    AcquireSamples.Reset();
+    NextAcquireSample = 0;
+}
+
+int32 UISMCustomDataSubsystem::GetEffectiveMaxSharedPoolSize() const
+{
+    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
+    if (Settings->bAutoTuneDMIPools && TunedMaxSharedPoolSize > 0)
+    {
+        return TunedMaxSharedPoolSize;
+    }
+    return Settings->DefaultMaxSharedPoolSize;
+}
+
+void UISMCustomDataSubsystem::RecordAcquireTime(uint64 StartCycles)
+{
+    const float Microseconds = static_cast<float>(
+        FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+
+    if (AcquireSamples.Num() < MaxAcquireSamples)
+    {
+        AcquireSamples.Add(Microseconds);
+        return;
+    }
+    AcquireSamples[NextAcquireSample] = Microseconds;
+    NextAcquireSample = (NextAcquireSample + 1) % MaxAcquireSamples;
+}
+
+void UISMCustomDataSubsystem::CloseStatsWindow(double Now)
+{
+    const float Seconds = static_cast<float>(Now - WindowStartSeconds);
+    if (Seconds <= 0.f)
+    {
+        return;
+    }
+
+    const int32 Hits = SharedPoolStats.CacheHits - WindowStartHits;
+    const int32 Misses = SharedPoolStats.CacheMisses - WindowStartMisses;
+    const int32 Evictions = SharedPoolStats.EvictedEntries - WindowStartEvictions;
+    const int32 Fallbacks = HotPoolStats.TransientFallbackCount - WindowStartFallbacks;
+
+    WindowStats.WindowSeconds = Seconds;
+    WindowStats.HitsPerSecond = Hits / Seconds;
+    WindowStats.MissesPerSecond = Misses / Seconds;
+    WindowStats.EvictionsPerSecond = Evictions / Seconds;
+    WindowStats.TransientFallbacksPerSecond = Fallbacks / Seconds;
+    WindowStats.HitRate = (Hits + Misses) > 0 ? static_cast<float>(Hits) / static_cast<float>(Hits + Misses) : 0.f;
+
+    WindowStats.P95AcquireMicroseconds = 0.f;
+    if (AcquireSamples.Num() > 0)
+    {
+        AcquireSamples.Sort();
+        const int32 Rank = FMath::Clamp(FMath::CeilToInt(AcquireSamples.Num() * 0.95f) - 1, 0, AcquireSamples.Num() - 1);
+        WindowStats.P95AcquireMicroseconds = AcquireSamples[Rank];
+    }
+
+    int32 NumDMIs = 0;
+    WindowStats.EstimatedMemoryBytes = EstimatePoolMemory(NumDMIs);
+
+    if (UISMRuntimeDeveloperSettings::Get()->bAutoTuneDMIPools)
+    {
+        AutoTunePools(WindowStats.EstimatedMemoryBytes, NumDMIs, Hits, Misses);
+    }
+
+    WindowStats.SharedPoolCap = GetEffectiveMaxSharedPoolSize();
+    WindowStats.TotalHotPoolCapacity = HotPoolStats.TotalHotPoolCapacity;
+
+    WindowStartSeconds = Now;
+    WindowStartHits = SharedPoolStats.CacheHits;
+    WindowStartMisses = SharedPoolStats.CacheMisses;
+    WindowStartEvictions = SharedPoolStats.EvictedEntries;
+    WindowStartFallbacks = HotPoolStats.TransientFallbackCount;
+    AcquireSamples.Reset();
+    NextAcquireSample = 0;
+}
+
+static int64 EstimateDMIBytes(const UMaterialInstanceDynamic* DMI)
+{
+    // CPU-side object and parameter storage only; render thread resources are not counted
+    return sizeof(UMaterialInstanceDynamic)
+        + DMI->ScalarParameterValues.GetAllocatedSize()
+        + DMI->VectorParameterValues.GetAllocatedSize()
+        + DMI->DoubleVectorParameterValues.GetAllocatedSize()
+        + DMI->TextureParameterValues.GetAllocatedSize();
+}
+
+int64 UISMCustomDataSubsystem::EstimatePoolMemory(int32& OutNumDMIs) const
+{
+    int64 Bytes = 0;
+    OutNumDMIs = 0;
+
+    for (const UMaterialInstanceDynamic* DMI : DMIArena)
+    {
+        if (DMI)
+        {
+            Bytes += EstimateDMIBytes(DMI);
+            ++OutNumDMIs;
+        }
+    }
+
+    // Hot slots are interchangeable copies of one template: measure one, count the rest
+    for (const auto& Pair : HotPools)
+    {
+        const UISMHotDMIPool* Pool = Pair.Value;
+        UMaterialInterface* Template = Pool ? Pool->GetTemplate() : nullptr;
+        if (!Template || Pool->GetPoolSize() == 0)
+        {
+            continue;
+        }
+        int64 SlotBytes = sizeof(UMaterialInstanceDynamic);
+        if (const UMaterialInstance* TemplateInstance = Cast<UMaterialInstance>(Template))
+        {
+            SlotBytes += TemplateInstance->ScalarParameterValues.GetAllocatedSize()
+                + TemplateInstance->VectorParameterValues.GetAllocatedSize();
+        }
+        Bytes += SlotBytes * Pool->GetPoolSize();
+        OutNumDMIs += Pool->GetPoolSize();
+    }
+
+    return Bytes;
+}
+
+SIZE_T UISMCustomDataSubsystem::GetAllocatedSize() const
+{
+    int32 NumDMIs = 0;
+    SIZE_T Size = static_cast<SIZE_T>(EstimatePoolMemory(NumDMIs));
+
+    Size += SharedPool.GetAllocatedSize();
+    for (const TPair<FISMMaterialSignature, FISMPooledMaterial>& Pair : SharedPool)
+    {
+        Size += Pair.Key.MappedValues.GetAllocatedSize();
+    }
+    for (const FISMMaterialSignature& Signature : IdleEntries)
+    {
+        Size += sizeof(FISMMaterialLRUList::TDoubleLinkedListNode) + Signature.MappedValues.GetAllocatedSize();
+    }
+    Size += DMIArena.GetAllocatedSize() + FreeArenaSlots.GetAllocatedSize();
+
+    Size += PendingPrewarms.GetAllocatedSize();
+    for (const FPendingPrewarm& Prewarm : PendingPrewarms)
+    {
+        Size += Prewarm.CustomData.GetAllocatedSize();
+    }
+    Size += SchemaCache.GetAllocatedSize();
+
+    Size += HotPools.GetAllocatedSize();
+    for (const auto& Pair : HotPools)
+    {
+        if (Pair.Value)
+        {
+            Size += Pair.Value->GetAllocatedSize();
+        }
+    }
+
+    const FHotHandleRows& Rows = HotRows;
+    Size += Rows.Ids.GetAllocatedSize() + Rows.Instances.GetAllocatedSize() + Rows.DMIs.GetAllocatedSize()
+        + Rows.Pools.GetAllocatedSize() + Rows.PoolSlots.GetAllocatedSize() + Rows.MaterialSlots.GetAllocatedSize()
+        + Rows.Schemas.GetAllocatedSize() + Rows.SettleModes.GetAllocatedSize() + Rows.SettleFrameThresholds.GetAllocatedSize()
+        + Rows.SettleDurations.GetAllocatedSize() + Rows.Elapsed.GetAllocatedSize() + Rows.StableFrames.GetAllocatedSize()
+        + Rows.ValueOffsets.GetAllocatedSize() + Rows.ValueCounts.GetAllocatedSize() + Rows.Values.GetAllocatedSize()
+        + Rows.Gathered.GetAllocatedSize() + Rows.Changed.GetAllocatedSize() + Rows.Settled.GetAllocatedSize();
+
+    Size += AcquireSamples.GetAllocatedSize();
+    return Size;
+}
+
+int32 UISMCustomDataSubsystem::GetNumPooledDMIs() const
+{
+    int32 NumDMIs = SharedPool.Num();
+    for (const auto& Pair : HotPools)
+    {
+        NumDMIs += Pair.Value ? Pair.Value->GetPoolSize() : 0;
+    }
+    return NumDMIs;
+}
+
+void UISMCustomDataSubsystem::AutoTunePools(int64 MemoryBytes, int32 NumDMIs, int32 WindowHits, int32 WindowMisses)
+{
+    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
+    const int64 BudgetBytes = static_cast<int64>(Settings->DMIPoolMemoryBudgetMB * 1024.0 * 1024.0);
+    const int64 BytesPerDMI = NumDMIs > 0 ? FMath::Max<int64>(MemoryBytes / NumDMIs, 1) : sizeof(UMaterialInstanceDynamic);
+    const int32 BudgetDMIs = static_cast<int32>(FMath::Clamp<int64>(BudgetBytes / BytesPerDMI, 1, MAX_int32));
+    const bool bOverBudget = MemoryBytes > BudgetBytes;
+
+    // Hot pools first: a missing hot slot costs a transient DMI every acquire, a missing shared
+    // entry costs one DMI creation
+    constexpr int32 MaxHotPoolSize = 128;
+    const int32 MinHotPoolSize = FMath::Min(Settings->DefaultHotPoolSizePerTemplate, MaxHotPoolSize);
+    int32 HotCapacity = 0;
+    for (const auto& Pair : HotPools)
+    {
+        if (Pair.Value) { HotCapacity += Pair.Value->GetPoolSize(); }
+    }
+
+    for (auto& Pair : HotPools)
+    {
+        UISMHotDMIPool* Pool = Pair.Value;
+        if (!Pool)
+        {
+            continue;
+        }
+
+        int32 PeakActive = 0;
+        int32 Exhausted = 0;
+        Pool->ConsumeWindowCounters(PeakActive, Exhausted);
+
+        const int32 OldSize = Pool->GetPoolSize();
+        int32 TargetSize = OldSize;
+        if (Exhausted > 0 && !bOverBudget)
+        {
+            const int32 Headroom = FMath::Max(BudgetDMIs - HotCapacity - SharedPool.Num(), 0);
+            TargetSize = FMath::Min3(OldSize + FMath::Max(OldSize / 2, 1), OldSize + Headroom, MaxHotPoolSize);
+            Pool->Grow(TargetSize);
+        }
+        else if (bOverBudget || PeakActive * 2 < OldSize)
+        {
+            // Keep twice the window's peak, never under the project default unless over budget
+            const int32 Floor = bOverBudget ? FMath::Max(PeakActive, 1) : MinHotPoolSize;
+            TargetSize = FMath::Max(PeakActive * 2, Floor);
+            if (bOverBudget)
+            {
+                TargetSize = FMath::Min(TargetSize, OldSize);
+            }
+            Pool->ShrinkIdle(TargetSize);
+        }
+        HotCapacity += Pool->GetPoolSize() - OldSize;
+    }
+    HotPoolStats.TotalHotPoolCapacity = HotCapacity;
+
+    // Shared pool: grow while misses keep the hit rate under target at a full pool, shrink towards
+    // the referenced entries plus a quarter while the rate is comfortably above it
+    const int32 Referenced = SharedPool.Num() - IdleEntries.Num();
+    int32 Cap = GetEffectiveMaxSharedPoolSize();
+    if (Cap <= 0)
+    {
+        Cap = FMath::Max(SharedPool.Num(), 1);
+    }
+
+    const int32 Lookups = WindowHits + WindowMisses;
+    const float HitRate = Lookups > 0 ? static_cast<float>(WindowHits) / static_cast<float>(Lookups) : 1.f;
+    if (WindowMisses > 0 && HitRate < Settings->AutoTuneTargetHitRate && SharedPool.Num() >= Cap)
+    {
+        Cap += FMath::Max(Cap / 4, 1);
+    }
+    else if (HitRate >= FMath::Min(Settings->AutoTuneTargetHitRate + 0.05f, 0.99f))
+    {
+        Cap = FMath::Min(Cap, FMath::Max(Referenced + Referenced / 4, 1));
+    }
+
+    TunedMaxSharedPoolSize = FMath::Clamp(Cap, 1, FMath::Max(BudgetDMIs - HotCapacity, 1));
 }
 
 // ============================================================
 //  Internal Helpers
 // ============================================================
 
-FISMMaterialSignature UISMCustomDataSubsystem::BuildSignature(
+void UISMCustomDataSubsystem::BuildSignature(
     UMaterialInterface* Template,
-    const TArray<float>& CustomData,
+    TConstArrayView<float> CustomData,
     const FISMCustomDataSchema& Schema,
-    int32 SlotIndex) const
+    int32 SlotIndex,
+    FISMMaterialSignature& OutSig) const
 {
-    FISMMaterialSignature Sig;
-    Sig.Template = Template;
-    Sig.MappedValues = Schema.ExtractMappedValues(CustomData);
-    return Sig;
+    // Reuses OutSig's buffer: lookups into the pool allocate nothing, only misses copy the key
+    OutSig.Template = Template;
+    OutSig.MappedValues.SetNumUninitialized(Schema.GetNumMappedValues(), EAllowShrinking::No);
+    Schema.ExtractMappedValues(CustomData, OutSig.MappedValues);
 }
 
 UMaterialInstanceDynamic* UISMCustomDataSubsystem::CreateAndApplyDMI(
     UMaterialInterface* Template,
-    const TArray<float>& CustomData,
+    TConstArrayView<float> CustomData,
     const FISMCustomDataSchema& Schema,
     int32 SlotIndex)
 {
@@ -570,6 +1161,7 @@ UMaterialInstanceDynamic* UISMCustomDataSubsystem::CreateAndApplyDMI(
 			Template ? *Template->GetName() : TEXT("null"));
         return nullptr;
     }
+    INC_DWORD_STAT(STAT_ISMDMIsCreated);
 
     ApplyCustomDataToMaterial(DMI, CustomData, Schema, SlotIndex);
     return DMI;
@@ -577,7 +1169,7 @@ UMaterialInstanceDynamic* UISMCustomDataSubsystem::CreateAndApplyDMI(
 
 void UISMCustomDataSubsystem::ApplyCustomDataToMaterial(
     UMaterialInstanceDynamic* DMI,
-    const TArray<float>& CustomData,
+    TConstArrayView<float> CustomData,
     const FISMCustomDataSchema& Schema,
     int32 SlotIndex) const
 {
@@ -605,7 +1197,7 @@ void UISMCustomDataSubsystem::ApplyCustomDataToMaterial(
                 const int32 Idx = Channel.DataIndex + c;
                 if (CustomData.IsValidIndex(Idx))
                 {
-                    Components[c] = CustomData[Idx];
+                    Components[c] = Channel.Quantize(CustomData[Idx]);
                 }
             }
 
@@ -613,50 +1205,185 @@ void UISMCustomDataSubsystem::ApplyCustomDataToMaterial(
         }
         else
         {
-            DMI->SetScalarParameterValue(Channel.ParameterName, CustomData[Channel.DataIndex]);
+            DMI->SetScalarParameterValue(Channel.ParameterName, Channel.Quantize(CustomData[Channel.DataIndex]));
         }
     }
 }
 
-void UISMCustomDataSubsystem::EvictLRUEntry()
+bool UISMCustomDataSubsystem::EvictLRUEntry()
 {
-    FISMMaterialSignature OldestSig;
-    uint32 OldestFrame = TNumericLimits<uint32>::Max();
-    bool bFound = false;
+    FISMMaterialLRUList::TDoubleLinkedListNode* Oldest = IdleEntries.GetHead();
+    if (!Oldest)
+    {
+        return false;
+    }
 
-    for (const auto& Pair : SharedPool)
+    // Copy out - removing the entry deletes the node
+    const FISMMaterialSignature OldestSig = Oldest->GetValue();
+    if (!SharedPool.Contains(OldestSig))
     {
-        // Only evict unreferenced entries
-        if (Pair.Value.RefCount > 0) { continue; }
+        IdleEntries.RemoveNode(Oldest);
+        return true;
+    }
 
-        if (Pair.Value.LastUsedFrame < OldestFrame)
-        {
-            OldestFrame = Pair.Value.LastUsedFrame;
-            OldestSig = Pair.Key;
-            bFound = true;
-        }
+    RemoveSharedEntry(OldestSig);
+    SharedPoolStats.EvictedEntries++;
+    return true;
+}
+
+bool UISMCustomDataSubsystem::ConsumeEvictionBudget()
+{
+    if (EvictionBudgetFrame != GFrameCounter)
+    {
+        EvictionBudgetFrame = GFrameCounter;
+        EvictionsThisFrame = 0;
+    }
+
+    const int32 Cap = UISMRuntimeDeveloperSettings::Get()->MaxAutoEvictionsPerFrame;
+    if (Cap > 0 && EvictionsThisFrame >= Cap)
+    {
+        return false;
+    }
+    EvictionsThisFrame++;
+    return true;
+}
+
+void UISMCustomDataSubsystem::LinkIdle(const FISMMaterialSignature& Sig, FISMPooledMaterial& Entry)
+{
+    if (Entry.LRUNode)
+    {
+        return;
     }
+    IdleEntries.AddTail(Sig);
+    Entry.LRUNode = IdleEntries.GetTail();
+}
 
-    if (bFound)
+void UISMCustomDataSubsystem::UnlinkIdle(FISMPooledMaterial& Entry)
+{
+    if (Entry.LRUNode)
+    {
+        IdleEntries.RemoveNode(Entry.LRUNode);
+        Entry.LRUNode = nullptr;
+    }
+}
+
+void UISMCustomDataSubsystem::RemoveSharedEntry(const FISMMaterialSignature& Sig)
+{
+    FISMPooledMaterial* Entry = SharedPool.Find(Sig);
+    if (!Entry)
+    {
+        return;
+    }
+
+    UnlinkIdle(*Entry);
+    ReleaseArenaSlot(Entry->ArenaIndex);
+    SharedPool.Remove(Sig);
+    UpdatePoolSizeStats();
+}
+
+int32 UISMCustomDataSubsystem::AdoptDMI(UMaterialInstanceDynamic* DMI)
+{
+    if (FreeArenaSlots.Num() > 0)
     {
-        // Unroot BEFORE removing from map
-        if (FISMPooledMaterial* Entry = SharedPool.Find(OldestSig))
+        const int32 Slot = FreeArenaSlots.Pop(EAllowShrinking::No);
+        DMIArena[Slot] = DMI;
+        return Slot;
+    }
+    return DMIArena.Add(DMI);
+}
+
+void UISMCustomDataSubsystem::ReleaseArenaSlot(int32 ArenaIndex)
+{
+    if (!DMIArena.IsValidIndex(ArenaIndex))
+    {
+        return;
+    }
+    DMIArena[ArenaIndex] = nullptr;
+    FreeArenaSlots.Add(ArenaIndex);
+}
+
+void UISMCustomDataSubsystem::ReserveArena(int32 NumNew)
+{
+    const int32 Growth = NumNew - FreeArenaSlots.Num();
+    if (Growth > 0)
+    {
+        DMIArena.Reserve(DMIArena.Num() + Growth);
+    }
+}
+
+void UISMCustomDataSubsystem::UpdatePoolSizeStats()
+{
+    SharedPoolStats.TotalPooledDMIs = SharedPool.Num();
+    SharedPoolStats.ArenaDMIs = DMIArena.Num() - FreeArenaSlots.Num();
+
+    // Every entry owns exactly one slot, so any surplus is a slot nothing will release
+    SharedPoolStats.LeakedDMIs = SharedPoolStats.ArenaDMIs - SharedPool.Num();
+    ensureMsgf(SharedPoolStats.LeakedDMIs == 0,
+        TEXT("ISMCustomDataSubsystem: %d pooled DMIs have no pool entry"), SharedPoolStats.LeakedDMIs);
+}
+
+void UISMCustomDataSubsystem::ProcessPendingPrewarms()
+{
+    const int32 Budget = UISMRuntimeDeveloperSettings::Get()->MaxPrewarmDMIsPerFrame;
+    const int32 MaxSize = GetEffectiveMaxSharedPoolSize();
+
+    const int32 NumPending = PendingPrewarms.Num() - PendingPrewarmHead;
+    ReserveArena(Budget > 0 ? FMath::Min(Budget, NumPending) : NumPending);
+
+    int32 Built = 0;
+    while (PendingPrewarmHead < PendingPrewarms.Num() && (Budget <= 0 || Built < Budget))
+    {
+        const FPendingPrewarm& Pending = PendingPrewarms[PendingPrewarmHead++];
+
+        UMaterialInterface* Template = Pending.Template.Get();
+        const FISMCustomDataSchema* Schema = ResolveSchema(Pending.SchemaName);
+        if (!Template || !Schema)
         {
-            if (Entry->DMI)
-            {
-                Entry->DMI->RemoveFromRoot();
-            }
+            continue;
+        }
+
+        // A full pool would only evict something live to make room for a guess
+        if (MaxSize > 0 && SharedPool.Num() >= MaxSize)
+        {
+            continue;
+        }
+
+        BuildSignature(Template, Pending.CustomData, *Schema, Pending.SlotIndex, LookupSignature);
+        const FISMMaterialSignature& Sig = LookupSignature;
+        if (SharedPool.Contains(Sig))
+        {
+            continue;
+        }
+
+        UMaterialInstanceDynamic* NewDMI = CreateAndApplyDMI(Template, Pending.CustomData, *Schema, Pending.SlotIndex);
+        if (!NewDMI)
+        {
+            continue;
         }
+        // RefCount 0 but kept off the idle list: the entry joins it on its first release, so the
+        // age-based sweep cannot drop it while the level is still waiting for its first conversion
+        FISMPooledMaterial& Entry = SharedPool.Add(Sig);
+        Entry.DMI = NewDMI;
+        Entry.ArenaIndex = AdoptDMI(NewDMI);
+        Entry.LastUsedFrame = GFrameCounter;
+        Entry.RefCount = 0;
+
+        SharedPoolStats.PrewarmedDMIs++;
+        ++Built;
+    }
 
-        SharedPool.Remove(OldestSig);
-        SharedPoolStats.EvictedEntries++;
-        SharedPoolStats.TotalPooledDMIs = SharedPool.Num();
+    if (PendingPrewarmHead >= PendingPrewarms.Num())
+    {
+        PendingPrewarms.Reset();
+        PendingPrewarmHead = 0;
     }
+
+    UpdatePoolSizeStats();
 }
 
 UISMHotDMIPool* UISMCustomDataSubsystem::GetOrCreateHotPool(UMaterialInterface* Template)
 {
-    if (!Template)
+    if (!Template || bHeadless)
     {
         return nullptr;
     }
@@ -680,63 +1407,83 @@ UISMHotDMIPool* UISMCustomDataSubsystem::GetOrCreateHotPool(UMaterialInterface*
     return NewPool;
 }
 
-void FISMHotDMIHandle::Tick(float DeltaTime, UWorld* World)
+void UISMCustomDataSubsystem::OnWorldTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
 {
-    if (!IsActive())
+    if (!World || TickType == LEVELTICK_TimeOnly)
     {
         return;
     }
-/*    // Auto-detect settle: if the instance's cached custom data matches the request, surrender the hot DMI
-    if (InstanceHandle && InstanceHandle->IsValid())
+
+    FISMFrameBudgetGovernor* FrameBudget = FISMFrameBudgetGovernor::Get(World);
+
+    // Tick hot DMI handles (AutoDetect + Timed settle). Skipped frames carry their time over,
+    // so Timed settles stay on schedule once the frame budget frees up.
     {
-        if (InstanceHandle->CachedCustomData.Num() > 0 &&
-            InstanceHandle->CachedCustomData == Request.ExpectedCustomData)
+        FISMFrameBudgetScope Budget(FrameBudget, TEXT("HotDMI"), EISMFrameBudgetPriority::High);
+        DeferredHotTickSeconds += DeltaSeconds;
+        if (HotRows.Num() == 0 || Budget.HasTime())
         {
-            UISMCustomDataSubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UISMCustomDataSubsystem>();
-            if (Subsystem)
-            {
-                Subsystem->SurrenderHotDMI(*this, World);
-                Subsystem->HotPoolStats.AutoDetectSurrenders++;
-            }
+            TickHotHandles(DeferredHotTickSeconds, World);
+            DeferredHotTickSeconds = 0.0f;
         }
-    }
-    // Timed settle: if this handle has been active for longer than the configured duration, surrender it
-    TimeActive += DeltaTime;
-    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
-    if (Settings->DefaultHotDMISettleTimeSeconds > 0.f &&
-        TimeActive >= Settings->DefaultHotDMISettleTimeSeconds)
-    {
-        UISMCustomDataSubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UISMCustomDataSubsystem>();
-        if (Subsystem)
+        else
         {
-            Subsystem->SurrenderHotDMI(*this, World);
-            Subsystem->HotPoolStats.TimedSurrenders++;
+            Budget.Defer(HotRows.Num());
         }
-    }*/
-}
+    }
 
-void UISMCustomDataSubsystem::OnWorldTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
-{
-    if (!World || TickType == LEVELTICK_TimeOnly)
+    // Prewarming and the eviction sweeps are housekeeping and wait out frames without budget
+    FISMFrameBudgetScope Budget(FrameBudget, TEXT("DMIPoolMaintenance"), EISMFrameBudgetPriority::Low);
+    const bool bMaintenanceTime = Budget.HasTime();
+    if (!bMaintenanceTime)
     {
-        return;
+        // The prewarms plus the sweep itself
+        Budget.Defer(PendingPrewarms.Num() + 1);
     }
 
-    // Tick hot DMI handles (AutoDetect + Timed settle)
-    TickHotHandles(DeltaSeconds, World);
+    if (bMaintenanceTime && PendingPrewarms.Num() > 0)
+    {
+        ProcessPendingPrewarms();
+    }
 
-    // Auto-eviction on configured cadence
+    // Auto-eviction runs every frame: the idle list is age-ordered, so the sweep only looks at
+    // what it evicts plus one entry, and the per-frame budget bounds the burst
     const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
-    if (Settings->DefaultEvictionAgeFrames > 0)
+    const int32 MaxAge = Settings->DefaultEvictionAgeFrames;
+    if (bMaintenanceTime && MaxAge > 0)
     {
-        const uint32 FramesSinceEviction = GFrameCounter - LastEvictionFrame;
-        if (FramesSinceEviction >= static_cast<uint32>(Settings->DefaultEvictionAgeFrames))
+        while (FISMMaterialLRUList::TDoubleLinkedListNode* Oldest = IdleEntries.GetHead())
         {
-            EvictStaleDMIs(-1); // -1 = use project settings value
-            LastEvictionFrame = GFrameCounter;
+            const FISMPooledMaterial* Entry = SharedPool.Find(Oldest->GetValue());
+            if (Entry && GFrameCounter - Entry->LastUsedFrame < static_cast<uint32>(MaxAge))
+            {
+                break;
+            }
+            if (!ConsumeEvictionBudget())
+            {
+                break;
+            }
+            EvictLRUEntry();
         }
     }
-	
+
+    // Windows run on wall time: several worlds tick this subsystem each frame
+    const double Now = FPlatformTime::Seconds();
+    if (WindowStartSeconds <= 0.0)
+    {
+        WindowStartSeconds = Now;
+    }
+    else if (Now - WindowStartSeconds >= Settings->PoolStatsWindowSeconds)
+    {
+        CloseStatsWindow(Now);
+    }
+
+    // Trim a pool that overshot its maximum while the budget was spent, or whose tuned cap shrank
+    const int32 MaxSize = GetEffectiveMaxSharedPoolSize();
+    while (bMaintenanceTime && MaxSize > 0 && SharedPool.Num() > MaxSize && IdleEntries.Num() > 0 && ConsumeEvictionBudget())
+    {
+        EvictLRUEntry();
+    }
 }
 
 #if WITH_EDITOR
@@ -744,8 +1491,12 @@ void UISMCustomDataSubsystem::OnDeveloperSettingsChanged(
     UObject* Settings,
     FPropertyChangedEvent& PropertyChangedEvent)
 {
-    // Schema pointers may have changed — clear cache so next resolve is fresh
+    // Schema pointers may have changed — clear caches so next resolve is fresh
     SchemaCache.Empty();
+    for (TObjectIterator<UISMRuntimeComponent> It; It; ++It)
+    {
+        It->InvalidateCustomDataSchema();
+    }
 }
 #endif
 
@@ -47,35 +47,11 @@ FISMFeedbackParticipant FISMFeedbackParticipant::FromISMComponent(const UISMRunt
         return Participant;
     }
     
-    // Set component and actor references
+    // Set component and actor references; the rest is gathered by Resolve()
     Participant.ParticipantComponent = const_cast<UISMRuntimeComponent*>(ISMComp);
     Participant.Participant = ISMComp->GetOwner();
-    
-    // Get transform - either instance-specific or actor transform
-    if (InstanceIndex != INDEX_NONE && ISMComp->IsValidInstanceIndex(InstanceIndex))
-    {
-        Participant.ParticipantTransform = ISMComp->GetInstanceTransform(InstanceIndex);
-    }
-    else if (Participant.Participant.IsValid())
-    {
-        Participant.ParticipantTransform = Participant.Participant->GetActorTransform();
-    }
-    
-    // Get tags from component
-    Participant.ParticipantTags = ISMComp->ISMComponentTags;
-    
-    // Add instance-specific tags if available
-    if (InstanceIndex != INDEX_NONE)
-    {
-        FGameplayTagContainer InstanceTags = ISMComp->GetInstanceTags(InstanceIndex);
-        Participant.ParticipantTags.AppendTags(InstanceTags);
-    }
-    
-    // Get physical material from managed ISM component
-    if (ISMComp->ManagedISMComponent)
-        Participant.ParticipantPhysicalMaterial = GetPhysicalMaterialFromPrimitive(ISMComp->ManagedISMComponent);
-
-    Participant.TryUpdateTags();
+    Participant.InstanceIndex = InstanceIndex;
+    Participant.bResolved = false;
 
     return Participant;
 }
@@ -89,35 +65,69 @@ FISMFeedbackParticipant FISMFeedbackParticipant::FromActorComponent(const UActor
         return Participant;
     }
     
-    // Set component and actor references
+    // Set component and actor references; the rest is gathered by Resolve()
     Participant.ParticipantComponent = const_cast<UActorComponent*>(ActorComp);
     Participant.Participant = ActorComp->GetOwner();
+    Participant.bResolved = false;
+
+    return Participant;
+}
+
+void FISMFeedbackParticipant::Resolve()
+{
+    if (bResolved)
+    {
+        return;
+    }
+    bResolved = true;
+    
+    // Tags from the component/actor tag interfaces first; TryUpdateTags resets the container
+    TryUpdateTags();
+    
+    if (const UISMRuntimeComponent* ISMComp = Cast<UISMRuntimeComponent>(ParticipantComponent.Get()))
+    {
+        // Get transform - either instance-specific or actor transform
+        if (InstanceIndex != INDEX_NONE && ISMComp->IsValidInstanceIndex(InstanceIndex))
+        {
+            ParticipantTransform = ISMComp->GetInstanceTransform(InstanceIndex);
+            
+            // Add instance-specific tags
+            ParticipantTags.AppendTags(ISMComp->GetInstanceTags(InstanceIndex));
+        }
+        else if (Participant.IsValid())
+        {
+            ParticipantTransform = Participant->GetActorTransform();
+        }
+        
+        // Get physical material from managed ISM component, unless the creator already set one
+        if (ISMComp->ManagedISMComponent && !ParticipantPhysicalMaterial.IsValid())
+        {
+            ParticipantPhysicalMaterial = GetPhysicalMaterialFromPrimitive(ISMComp->ManagedISMComponent);
+        }
+        return;
+    }
     
     // Get transform - try SceneComponent first, fallback to actor transform
-    if (const USceneComponent* SceneComp = Cast<USceneComponent>(ActorComp))
+    if (const USceneComponent* SceneComp = Cast<USceneComponent>(ParticipantComponent.Get()))
     {
-        Participant.ParticipantTransform = SceneComp->GetComponentTransform();
+        ParticipantTransform = SceneComp->GetComponentTransform();
         
-        // Try to get physical material from PrimitiveComponent
-        if (const UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(SceneComp))
+        // Try to get physical material from PrimitiveComponent, unless the creator already set one (hit results)
+        const UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(SceneComp);
+        if (PrimComp && !ParticipantPhysicalMaterial.IsValid())
         {
 #if WITH_EDITOR
-            Participant.ParticipantPhysicalMaterial = PrimComp->GetBodyInstance()
+            ParticipantPhysicalMaterial = PrimComp->GetBodyInstance()
                 ? PrimComp->GetBodyInstance()->GetSimplePhysicalMaterial()
                 : nullptr;
 #endif // WITH_EDITOR
 
         }
     }
-    else if (Participant.Participant.IsValid())
+    else if (Participant.IsValid())
     {
-        Participant.ParticipantTransform = Participant.Participant->GetActorTransform();
+        ParticipantTransform = Participant->GetActorTransform();
     }
-    
-    // Note: ActorComponent doesn't have native tag support
-    // Subclasses can populate ParticipantTags manually if needed
-	Participant.TryUpdateTags();
-    return Participant;
 }
 
 void FISMFeedbackParticipant::TryUpdateTags()
@@ -156,6 +166,20 @@ void FISMFeedbackParticipant::TryUpdateTags()
     }
  }
 
+// ===== FISMFeedbackContext =====
+
+void FISMFeedbackContext::ResolveParticipants()
+{
+    Instigator.Resolve();
+    Subject.Resolve();
+    
+    // Surface material defaults to the subject's
+    if (!PhysicalMaterial.IsValid())
+    {
+        PhysicalMaterial = Subject.ParticipantPhysicalMaterial;
+    }
+}
+
 // ===== FISMFeedbackContext Static Constructors =====
 
 TArray<FTransform> FISMFeedbackContext::GetTransformsForBatchedInstances() const
@@ -187,6 +211,16 @@ TArray<FISMFeedbackBatchedInstanceInfo> FISMFeedbackContext::GetBatchedInstanceI
     if(!ISMComp)
 		return TArray<FISMFeedbackBatchedInstanceInfo>();
     
+    // Several providers/handlers may ask for the same batch in one frame; gather it once
+    const int32 CustomDataCount = FMath::Max(customDataIndexes, 0);
+    if (BatchedInfoMemo.IsValid()
+        && BatchedInfoMemo->Frame == GFrameCounter
+        && BatchedInfoMemo->bWithGameplayTags == bWithGameplayTags
+        && BatchedInfoMemo->CustomDataCount == CustomDataCount)
+    {
+        return BatchedInfoMemo->Infos;
+    }
+    
     auto res = TArray<FISMFeedbackBatchedInstanceInfo>();
     res.Reserve(BatchedInstanceIndices.Num());
 
@@ -194,6 +228,12 @@ TArray<FISMFeedbackBatchedInstanceInfo> FISMFeedbackContext::GetBatchedInstanceI
     {
 		res.Add(FISMFeedbackBatchedInstanceInfo::GetInstanceInfo(ISMComp, BatchedInstanceIndices[i], bWithGameplayTags, customDataIndexes));
     }
+    
+    BatchedInfoMemo = MakeShared<FISMFeedbackBatchedInfoMemo>();
+    BatchedInfoMemo->Frame = GFrameCounter;
+    BatchedInfoMemo->bWithGameplayTags = bWithGameplayTags;
+    BatchedInfoMemo->CustomDataCount = CustomDataCount;
+    BatchedInfoMemo->Infos = res;
     return res;
 }
 
@@ -258,6 +298,7 @@ FISMFeedbackContext FISMFeedbackContext::CreateFromInstance(
     
     // Create subject participant from ISM component
     Context.Subject = FISMFeedbackParticipant::FromISMComponent(ISMComp, InstanceIndex);
+    Context.SubjectInstanceIndex = InstanceIndex;
     
     // Populate spatial data from instance transform
     FTransform InstanceTransform = ISMComp->GetInstanceTransform(InstanceIndex);
@@ -274,12 +315,7 @@ FISMFeedbackContext FISMFeedbackContext::CreateFromInstance(
         Context.StaticMesh = ISMComp->ManagedISMComponent->GetStaticMesh();
     }
     
-    // Set physical material from managed ISM
-    if (ISMComp->ManagedISMComponent)
-    {
-		Context.PhysicalMaterial = Context.Subject.ParticipantPhysicalMaterial.Get();
-    }
-    
+    // Physical material is taken from the subject when participants resolve
     return Context;
 }
 
@@ -390,7 +426,7 @@ FISMFeedbackContext FISMFeedbackContext::CreateFromPrimitive(FGameplayTag Feedba
     {
         Context.Subject = FISMFeedbackParticipant::FromActorComponent(SubjectComp);
 	}
-    Context.ContextTags = Context.Instigator.ParticipantTags;
+    Context.ContextTags = Context.Instigator.GetTags();
 	Context.FeedbackMessageType = messageType;
     return Context;
 }
@@ -0,0 +1,108 @@
+// ISMFeedbackProfiler.cpp
+
+#include "Feedbacks/ISMFeedbackProfiler.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+void FISMFeedbackTimingWindow::Add(float TimeMs, int32 WindowSize)
+{
+    FrameMs += TimeMs;
+    Sum += TimeMs;
+
+    WindowSize = FMath::Max(WindowSize, 1);
+    if (Samples.Num() < WindowSize)
+    {
+        Samples.Add(TimeMs);
+        return;
+    }
+
+    // Window shrank since the last sample
+    if (Samples.Num() > WindowSize)
+    {
+        const float CurrentFrameMs = FrameMs;
+        Reset();
+        FrameMs = CurrentFrameMs;
+        Samples.Add(TimeMs);
+        Sum = TimeMs;
+        return;
+    }
+
+    Next = Next % WindowSize;
+    Sum -= Samples[Next];
+    Samples[Next] = TimeMs;
+    Next = (Next + 1) % WindowSize;
+}
+
+void FISMFeedbackTimingWindow::EndFrame()
+{
+    LastFrameMs = FrameMs;
+    FrameMs = 0.0f;
+}
+
+void FISMFeedbackTimingWindow::Reset()
+{
+    Samples.Reset();
+    Next = 0;
+    Sum = 0.0;
+    FrameMs = 0.0f;
+    LastFrameMs = 0.0f;
+}
+
+FISMFeedbackTimingStats FISMFeedbackTimingWindow::Summarize(FName Name) const
+{
+    FISMFeedbackTimingStats Stats;
+    Stats.Name = Name;
+    Stats.Count = Samples.Num();
+    Stats.LastFrameMs = LastFrameMs;
+    if (Samples.Num() == 0)
+    {
+        return Stats;
+    }
+
+    TArray<float> Sorted(Samples);
+    Sorted.Sort();
+
+    Stats.MeanMs = GetMean();
+    Stats.P95Ms = Sorted[FMath::Clamp(FMath::CeilToInt32(0.95f * Sorted.Num()) - 1, 0, Sorted.Num() - 1)];
+    Stats.MaxMs = Sorted.Last();
+    return Stats;
+}
+
+void FISMFeedbackTimingTable::Add(FName Key, float TimeMs, int32 WindowSize)
+{
+    Windows.FindOrAdd(Key).Add(TimeMs, WindowSize);
+}
+
+void FISMFeedbackTimingTable::EndFrame(int32 CsvCategoryIndex, const TCHAR* CsvPrefix)
+{
+    for (TPair<FName, FISMFeedbackTimingWindow>& Pair : Windows)
+    {
+#if CSV_PROFILER
+        if (CsvCategoryIndex >= 0)
+        {
+            FName* StatName = CsvStatNames.Find(Pair.Key);
+            if (!StatName)
+            {
+                StatName = &CsvStatNames.Add(Pair.Key, FName(*(FString(CsvPrefix) + Pair.Key.ToString())));
+            }
+            FCsvProfiler::RecordCustomStat(*StatName, CsvCategoryIndex, Pair.Value.FrameMs, ECsvCustomStatOp::Set);
+        }
+#endif
+        Pair.Value.EndFrame();
+    }
+}
+
+TArray<FISMFeedbackTimingStats> FISMFeedbackTimingTable::Summarize() const
+{
+    TArray<FISMFeedbackTimingStats> Result;
+    Result.Reserve(Windows.Num());
+    for (const TPair<FName, FISMFeedbackTimingWindow>& Pair : Windows)
+    {
+        Result.Add(Pair.Value.Summarize(Pair.Key));
+    }
+
+    Result.Sort([](const FISMFeedbackTimingStats& A, const FISMFeedbackTimingStats& B)
+    {
+        return A.MeanMs * A.Count > B.MeanMs * B.Count;
+    });
+    return Result;
+}
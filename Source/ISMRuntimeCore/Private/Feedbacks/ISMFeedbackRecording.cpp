@@ -0,0 +1,192 @@
+// ISMFeedbackRecording.cpp
+
+#include "Feedbacks/ISMFeedbackRecording.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    constexpr uint32 FeedbackRecordingMagic = 0x464D5349; // "ISMF"
+    constexpr int32 FeedbackRecordingVersion = 1;
+    constexpr int32 MaxRecordedProviders = 32;
+}
+
+FArchive& operator<<(FArchive& Ar, FISMFeedbackRecordedEvent& Event)
+{
+    uint8 MessageType = static_cast<uint8>(Event.MessageType);
+    Ar << Event.TagIndex << Event.PhysicalMaterialIndex << MessageType;
+    Ar << Event.Location << Event.Normal;
+    Ar << Event.Intensity << Event.Scale << Event.Force;
+    Ar << Event.EventCount << Event.HandledByMask;
+    Event.MessageType = static_cast<EISMFeedbackMessageType>(MessageType);
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FISMFeedbackRecordedFrame& Frame)
+{
+    Ar << Frame.Time << Frame.Events;
+    return Ar;
+}
+
+void FISMFeedbackRecording::BeginFrame(float Time)
+{
+    Frames.AddDefaulted_GetRef().Time = Time;
+}
+
+void FISMFeedbackRecording::AddEvent(const FISMFeedbackContext& Context, uint32 HandledByMask)
+{
+    if (Frames.Num() == 0)
+    {
+        BeginFrame(0.0f);
+    }
+
+    FISMFeedbackRecordedEvent& Event = Frames.Last().Events.AddDefaulted_GetRef();
+    Event.TagIndex = static_cast<uint16>(FindOrAddName(Context.FeedbackTag.GetTagName()));
+    Event.MessageType = Context.FeedbackMessageType;
+    Event.Location = FVector3f(Context.Location);
+    Event.Normal = FVector3f(Context.Normal);
+    Event.Intensity = Context.Intensity;
+    Event.Scale = Context.Scale;
+    Event.Force = Context.Force;
+    Event.EventCount = FMath::Max(Context.EventCount, Context.BatchedInstanceIndices.Num());
+    Event.HandledByMask = HandledByMask;
+
+    if (const UPhysicalMaterial* Material = Context.PhysicalMaterial.Get())
+    {
+        Event.PhysicalMaterialIndex = static_cast<int16>(FindOrAddName(FName(*Material->GetPathName())));
+    }
+}
+
+uint32 FISMFeedbackRecording::GetProviderBit(const UObject* Provider)
+{
+    if (!Provider)
+    {
+        return 0;
+    }
+
+    if (const int32* Index = ProviderIndices.Find(FObjectKey(Provider)))
+    {
+        return 1u << *Index;
+    }
+
+    if (ProviderNames.Num() >= MaxRecordedProviders)
+    {
+        return 0;
+    }
+
+    const int32 Index = ProviderNames.Add(Provider->GetName());
+    ProviderIndices.Add(FObjectKey(Provider), Index);
+    return 1u << Index;
+}
+
+FISMFeedbackContext FISMFeedbackRecording::MakeContext(const FISMFeedbackRecordedEvent& Event) const
+{
+    FISMFeedbackContext Context;
+    if (Names.IsValidIndex(Event.TagIndex))
+    {
+        Context.FeedbackTag = FGameplayTag::RequestGameplayTag(Names[Event.TagIndex], false);
+    }
+    Context.FeedbackMessageType = Event.MessageType;
+    Context.Location = FVector(Event.Location);
+    Context.Normal = FVector(Event.Normal);
+    Context.Intensity = Event.Intensity;
+    Context.Scale = Event.Scale;
+    Context.Force = Event.Force;
+    Context.EventCount = Event.EventCount;
+
+    if (Names.IsValidIndex(Event.PhysicalMaterialIndex))
+    {
+        TStrongObjectPtr<UPhysicalMaterial>& Material = LoadedMaterials.FindOrAdd(Event.PhysicalMaterialIndex);
+        if (!Material.IsValid())
+        {
+            Material.Reset(Cast<UPhysicalMaterial>(FSoftObjectPath(Names[Event.PhysicalMaterialIndex].ToString()).TryLoad()));
+        }
+        Context.PhysicalMaterial = Material.Get();
+    }
+
+    return Context;
+}
+
+int32 FISMFeedbackRecording::GetNumEvents() const
+{
+    int32 Count = 0;
+    for (const FISMFeedbackRecordedFrame& Frame : Frames)
+    {
+        Count += Frame.Events.Num();
+    }
+    return Count;
+}
+
+void FISMFeedbackRecording::Serialize(FArchive& Ar)
+{
+    uint32 Magic = FeedbackRecordingMagic;
+    int32 Version = FeedbackRecordingVersion;
+    Ar << Magic << Version;
+    if (Ar.IsLoading() && (Magic != FeedbackRecordingMagic || Version != FeedbackRecordingVersion))
+    {
+        Ar.SetError();
+        return;
+    }
+
+    // Names as strings: FName serialization in a raw archive would write indices into this session's name table
+    int32 NumNames = Names.Num();
+    Ar << NumNames;
+    if (Ar.IsLoading())
+    {
+        Names.Reset(NumNames);
+    }
+    for (int32 Index = 0; Index < NumNames && !Ar.IsError(); ++Index)
+    {
+        FString Name = Ar.IsLoading() ? FString() : Names[Index].ToString();
+        Ar << Name;
+        if (Ar.IsLoading())
+        {
+            Names.Add(FName(*Name));
+        }
+    }
+
+    Ar << ProviderNames;
+    Ar << Frames;
+
+    if (Ar.IsLoading())
+    {
+        NameIndices.Reset();
+        ProviderIndices.Reset();
+        LoadedMaterials.Reset();
+    }
+}
+
+bool FISMFeedbackRecording::SaveToFile(const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    Serialize(Writer);
+    return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FISMFeedbackRecording::LoadFromFile(const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    Serialize(Reader);
+    return !Reader.IsError();
+}
+
+int32 FISMFeedbackRecording::FindOrAddName(FName Name)
+{
+    if (const int32* Index = NameIndices.Find(Name))
+    {
+        return *Index;
+    }
+
+    const int32 Index = Names.Add(Name);
+    NameIndices.Add(Name, Index);
+    return Index;
+}
@@ -1,12 +1,79 @@
 // ISMFeedbackSubsystem.cpp
 
 #include "Feedbacks/ISMFeedbackSubsystem.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMFrameBudget.h"
+#include "Settings/ISMRuntimeSettings.h"
 #include "DrawDebugHelpers.h"
 #include "Logging/LogMacros.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogISMFeedback, Log, All);
 
+CSV_DEFINE_CATEGORY(ISMFeedback, true);
+
+namespace
+{
+    /** Bucket for coalescing queued feedback */
+    struct FFeedbackCoalesceKey
+    {
+        FGameplayTag Tag;
+        TWeakObjectPtr<UActorComponent> Subject;
+        FIntVector Cell;
+        
+        bool operator==(const FFeedbackCoalesceKey& Other) const
+        {
+            return Tag == Other.Tag && Subject == Other.Subject && Cell == Other.Cell;
+        }
+        
+        friend uint32 GetTypeHash(const FFeedbackCoalesceKey& Key)
+        {
+            return HashCombine(HashCombine(GetTypeHash(Key.Tag), GetTypeHash(Key.Subject)), GetTypeHash(Key.Cell));
+        }
+    };
+    
+    /** Add a context's instances to a merged batch, promoting a single-instance context to a batch */
+    void AppendFeedbackInstances(TArray<int32>& OutIndices, const FISMFeedbackContext& Context)
+    {
+        if (Context.IsBatched())
+        {
+            OutIndices.Append(Context.BatchedInstanceIndices);
+        }
+        else if (Context.SubjectInstanceIndex != INDEX_NONE)
+        {
+            OutIndices.Add(Context.SubjectInstanceIndex);
+        }
+    }
+    
+    /** Fold Source into Target: counts add, location becomes the weighted centroid, intensity and force take the max */
+    void MergeFeedbackContext(FISMFeedbackContext& Target, const FISMFeedbackContext& Source)
+    {
+        const int32 TargetCount = FMath::Max(Target.EventCount, 1);
+        const int32 SourceCount = FMath::Max(Source.EventCount, 1);
+        const int32 TotalCount = TargetCount + SourceCount;
+        
+        Target.Location = (Target.Location * TargetCount + Source.Location * SourceCount) / TotalCount;
+        Target.Intensity = FMath::Max(Target.Intensity, Source.Intensity);
+        Target.Force = FMath::Max(Target.Force, Source.Force);
+        
+        if (!Target.IsBatched())
+        {
+            TArray<int32> Indices;
+            AppendFeedbackInstances(Indices, Target);
+            Target.BatchedInstanceIndices = MoveTemp(Indices);
+        }
+        AppendFeedbackInstances(Target.BatchedInstanceIndices, Source);
+        Target.BatchedInfoMemo.Reset();
+        
+        Target.EventCount = TotalCount;
+    }
+}
+
 // ===== Subsystem Lifecycle =====
 
 void UISMFeedbackSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -17,10 +84,20 @@ void UISMFeedbackSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     
     // Reset statistics
     ResetStats();
+    
+    // Nobody sees or hears feedback on a headless server: requests are dropped on arrival
+    const UISMRuntimeSettings* RuntimeSettings = GetDefault<UISMRuntimeSettings>();
+    bHeadless = RuntimeSettings && RuntimeSettings->IsHeadless(GetWorld());
+    
+    ApplyPerformanceProfile(FISMPerformanceProfiles::GetActive());
+    PerformanceProfileHandle = FISMPerformanceProfiles::OnProfileChanged().AddUObject(this, &UISMFeedbackSubsystem::HandlePerformanceProfileChanged);
 }
 
 void UISMFeedbackSubsystem::Deinitialize()
 {
+    FISMPerformanceProfiles::OnProfileChanged().Remove(PerformanceProfileHandle);
+    PerformanceProfileHandle.Reset();
+    
     // Notify all providers they're being unregistered
     for (const TScriptInterface<IISMFeedbackInterface>& Provider : FeedbackProviders)
     {
@@ -32,13 +109,29 @@ void UISMFeedbackSubsystem::Deinitialize()
     
     FeedbackProviders.Empty();
     ProviderObjects.Empty();
+    DispatchTable.Empty();
+    RelevantFeedbackTags.Reset();
     FeedbackQueue.Empty();
+    Recording.Reset();
+    Replay.Reset();
     
     UE_LOG(LogISMFeedback, Log, TEXT("ISM Feedback Subsystem deinitialized"));
     
     Super::Deinitialize();
 }
 
+void UISMFeedbackSubsystem::ApplyPerformanceProfile(const FISMPerformanceProfileSettings& Profile)
+{
+    const UISMFeedbackSubsystem* Defaults = GetDefault<UISMFeedbackSubsystem>();
+    MaxFeedbackPerFrame = Profile.bOverride_MaxFeedbackPerFrame ? Profile.MaxFeedbackPerFrame : Defaults->MaxFeedbackPerFrame;
+    MinFeedbackSignificance = Profile.bOverride_MinFeedbackSignificance ? Profile.MinFeedbackSignificance : Defaults->MinFeedbackSignificance;
+}
+
+void UISMFeedbackSubsystem::HandlePerformanceProfileChanged(EISMPerformanceProfile Profile, const FISMPerformanceProfileSettings& ProfileSettings)
+{
+    ApplyPerformanceProfile(ProfileSettings);
+}
+
 bool UISMFeedbackSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
 {
     // Support Game, PIE, and Editor Preview worlds
@@ -49,13 +142,25 @@ bool UISMFeedbackSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) con
 
 void UISMFeedbackSubsystem::Tick(float DeltaTime)
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISMFeedbackSubsystem::Tick);
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedback);
     
     // Update frame counter
     CurrentFrame++;
     
     // Reset per-frame stats
     CachedStats.RequestsThisFrame = 0;
+    EndProfilingFrame();
+    
+    if (Recording)
+    {
+        Recording->BeginFrame(static_cast<float>(FPlatformTime::Seconds() - RecordingStartTime));
+    }
+    
+    if (Replay)
+    {
+        TickReplay();
+    }
     
     // Process batched feedback if enabled
     if (bEnableBatching && FeedbackQueue.Num() > 0)
@@ -104,9 +209,14 @@ bool UISMFeedbackSubsystem::RegisterFeedbackProvider(TScriptInterface<IISMFeedba
     
     // Re-sort by priority
     SortProvidersByPriority();
+    DispatchTable.Reset();
     
     // Notify provider
     IISMFeedbackInterface::Execute_OnFeedbackProviderRegistered(Provider.GetObject());
+    if (!RelevantFeedbackTags.IsEmpty())
+    {
+        IISMFeedbackInterface::Execute_OnFeedbackTagsRelevant(Provider.GetObject(), RelevantFeedbackTags);
+    }
     
     // Update stats
     CachedStats.RegisteredProviders = FeedbackProviders.Num();
@@ -137,6 +247,7 @@ void UISMFeedbackSubsystem::UnregisterFeedbackProvider(TScriptInterface<IISMFeed
         // Remove from arrays
         FeedbackProviders.RemoveAt(Index);
         ProviderObjects.RemoveAt(Index);
+        DispatchTable.Reset();
         
         // Update stats
         CachedStats.RegisteredProviders = FeedbackProviders.Num();
@@ -156,6 +267,13 @@ bool UISMFeedbackSubsystem::IsProviderRegistered(TScriptInterface<IISMFeedbackIn
     return FeedbackProviders.Contains(Provider);
 }
 
+void UISMFeedbackSubsystem::InvalidateFeedbackDispatch()
+{
+    // Priority may have changed along with the tags
+    SortProvidersByPriority();
+    DispatchTable.Reset();
+}
+
 void UISMFeedbackSubsystem::SortProvidersByPriority()
 {
     FeedbackProviders.Sort([](const TScriptInterface<IISMFeedbackInterface>& A, const TScriptInterface<IISMFeedbackInterface>& B)
@@ -189,16 +307,52 @@ void UISMFeedbackSubsystem::CleanupInvalidProviders()
     
     if (RemovedCount > 0)
     {
+        DispatchTable.Reset();
         CachedStats.RegisteredProviders = FeedbackProviders.Num();
         UE_LOG(LogISMFeedback, Log, TEXT("Cleaned up %d invalid provider(s)"), RemovedCount);
     }
 }
 
+// ===== Relevance =====
+
+void UISMFeedbackSubsystem::NotifyFeedbackTagsRelevant(const FGameplayTagContainer& FeedbackTags)
+{
+    FGameplayTagContainer NewTags;
+    for (const FGameplayTag& Tag : FeedbackTags)
+    {
+        if (Tag.IsValid() && !RelevantFeedbackTags.HasTagExact(Tag))
+        {
+            NewTags.AddTag(Tag);
+        }
+    }
+    
+    if (NewTags.IsEmpty())
+    {
+        return;
+    }
+    
+    RelevantFeedbackTags.AppendTags(NewTags);
+    
+    for (const TScriptInterface<IISMFeedbackInterface>& Provider : FeedbackProviders)
+    {
+        if (Provider.GetObject())
+        {
+            IISMFeedbackInterface::Execute_OnFeedbackTagsRelevant(Provider.GetObject(), NewTags);
+        }
+    }
+}
+
 // ===== Feedback Requests =====
 
 bool UISMFeedbackSubsystem::RequestFeedback(const FISMFeedbackContext& Context)
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISMFeedbackSubsystem::RequestFeedback);
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::RequestFeedback);
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedback);
+    
+    if (bHeadless)
+    {
+        return false;
+    }
     
     // Validate context
     if (!Context.IsValid())
@@ -223,10 +377,13 @@ bool UISMFeedbackSubsystem::RequestFeedback(const FISMFeedbackContext& Context)
     const double EndTime = FPlatformTime::Seconds();
     
     // Update processing time stats
-    const double ProcessingTimeMs = (EndTime - StartTime) * 1000.0;
-    ProcessingTimeAccumulator += ProcessingTimeMs;
-    ProcessingTimeSamples++;
-    CachedStats.AverageProcessingTimeMs = static_cast<float>(ProcessingTimeAccumulator / ProcessingTimeSamples);
+    const float ProcessingTimeMs = static_cast<float>((EndTime - StartTime) * 1000.0);
+    ProcessingTimeWindow.Add(ProcessingTimeMs, ProfilingWindowSize);
+    CachedStats.AverageProcessingTimeMs = ProcessingTimeWindow.GetMean();
+    if (bProfileFeedbackCosts)
+    {
+        TagTimings.Add(Context.FeedbackTag.GetTagName(), ProcessingTimeMs, ProfilingWindowSize);
+    }
     
     // Update handled/unhandled stats
     if (bHandled)
@@ -250,6 +407,11 @@ bool UISMFeedbackSubsystem::RequestFeedback(const FISMFeedbackContext& Context)
 
 bool UISMFeedbackSubsystem::RequestFeedbackBatched(const FISMFeedbackContext& Context, bool bAllowBatching)
 {
+    if (bHeadless)
+    {
+        return false;
+    }
+    
     // If batching disabled or not allowed, process immediately
     if (!bEnableBatching || !bAllowBatching)
     {
@@ -264,7 +426,13 @@ bool UISMFeedbackSubsystem::RequestFeedbackBatched(const FISMFeedbackContext& Co
 
 void UISMFeedbackSubsystem::RequestMultipleFeedback(const TArray<FISMFeedbackContext>& Contexts)
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISMFeedbackSubsystem::RequestMultipleFeedback);
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::RequestMultipleFeedback);
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedback);
+    
+    if (bHeadless)
+    {
+        return;
+    }
     
     if (bEnableBatching)
     {
@@ -285,28 +453,55 @@ void UISMFeedbackSubsystem::RequestMultipleFeedback(const TArray<FISMFeedbackCon
 
 bool UISMFeedbackSubsystem::RouteToProviders(const FISMFeedbackContext& Context)
 {
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::RouteToProviders);
+    SCOPE_CYCLE_COUNTER(STAT_ISMFeedbackRouting);
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedback);
+    INC_DWORD_STAT(STAT_ISMFeedbacksRouted);
+
     bool bWasHandled = false;
     
-    for (const TScriptInterface<IISMFeedbackInterface>& Provider : FeedbackProviders)
+    // Copied because a provider may register or unregister from inside HandleFeedback,
+    // which resets the table under us
+    const TArray<TWeakObjectPtr<UObject>, TInlineAllocator<8>> Providers(FindOrBuildDispatchList(Context.FeedbackTag));
+    if (Providers.Num() == 0)
     {
-        if (!Provider.GetObject() || !Provider.GetObject()->Implements<UISMFeedbackInterface>())
+        if (Recording)
         {
-            continue;
+            Recording->AddEvent(Context, 0);
         }
-        
-        // Early out if provider can't handle this tag
-        if (!IISMFeedbackInterface::Execute_CanHandleFeedbackTag(Provider.GetObject(), Context.FeedbackTag))
+        return false;
+    }
+    
+    // Immediate requests built from lazy participants; resolve a copy so providers can read the fields
+    TOptional<FISMFeedbackContext> ResolvedContext;
+    if (Context.HasUnresolvedParticipants())
+    {
+        ResolvedContext.Emplace(Context);
+        ResolvedContext->ResolveParticipants();
+    }
+    const FISMFeedbackContext& RoutedContext = ResolvedContext.IsSet() ? ResolvedContext.GetValue() : Context;
+    
+    uint32 HandledByMask = 0;
+    for (const TWeakObjectPtr<UObject>& ProviderObject : Providers)
+    {
+        UObject* Provider = ProviderObject.Get();
+        if (!Provider)
         {
             continue;
         }
         
         // Try to handle feedback
-        const bool bHandled = IISMFeedbackInterface::Execute_HandleFeedback(Provider.GetObject(), Context);
+        const bool bHandled = IISMFeedbackInterface::Execute_HandleFeedback(Provider, RoutedContext);
         
         if (bHandled)
         {
             bWasHandled = true;
             
+            if (Recording)
+            {
+                HandledByMask |= Recording->GetProviderBit(Provider);
+            }
+            
             // If not broadcasting to all, stop at first handler
             if (!bBroadcastToAll)
             {
@@ -315,18 +510,64 @@ bool UISMFeedbackSubsystem::RouteToProviders(const FISMFeedbackContext& Context)
         }
     }
     
+    if (Recording)
+    {
+        Recording->AddEvent(RoutedContext, HandledByMask);
+    }
+    
     return bWasHandled;
 }
 
+const TArray<TWeakObjectPtr<UObject>>& UISMFeedbackSubsystem::FindOrBuildDispatchList(const FGameplayTag& Tag)
+{
+    if (const TArray<TWeakObjectPtr<UObject>>* Cached = DispatchTable.Find(Tag))
+    {
+        return *Cached;
+    }
+    
+    // FeedbackProviders is already in priority order, and registration guarantees the interface
+    TArray<TWeakObjectPtr<UObject>> Providers;
+    for (const TScriptInterface<IISMFeedbackInterface>& Provider : FeedbackProviders)
+    {
+        if (Provider.GetObject() && IISMFeedbackInterface::Execute_CanHandleFeedbackTag(Provider.GetObject(), Tag))
+        {
+            Providers.Add(Provider.GetObject());
+        }
+    }
+    
+    // Nobody takes the exact tag; inherit the nearest parent's handlers
+    if (Providers.Num() == 0)
+    {
+        const FGameplayTag Parent = Tag.RequestDirectParent();
+        if (Parent.IsValid())
+        {
+            Providers = FindOrBuildDispatchList(Parent);
+        }
+    }
+    
+    return DispatchTable.Add(Tag, MoveTemp(Providers));
+}
+
 void UISMFeedbackSubsystem::ProcessFeedbackQueue()
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISMFeedbackSubsystem::ProcessFeedbackQueue);
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::ProcessFeedbackQueue);
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedback);
     
     if (FeedbackQueue.Num() == 0)
     {
         return;
     }
     
+    if (bCoalesceQueuedFeedback)
+    {
+        CoalesceFeedbackQueue();
+    }
+    
+    if (bScoreSignificance)
+    {
+        ScoreFeedbackQueue();
+    }
+    
     // Determine how many to process this frame
     int32 NumToProcess = FeedbackQueue.Num();
     if (MaxFeedbackPerFrame > 0)
@@ -334,14 +575,138 @@ void UISMFeedbackSubsystem::ProcessFeedbackQueue()
         NumToProcess = FMath::Min(NumToProcess, MaxFeedbackPerFrame);
     }
     
-    // Process feedback
-    for (int32 i = 0; i < NumToProcess; i++)
+    // Process feedback; participants are resolved only for requests that survived to this point.
+    // The shared frame budget can stop the frame early, but at least one request always goes out.
+    FISMFrameBudgetScope Budget(FISMFrameBudgetGovernor::Get(GetWorld()), TEXT("Feedback"), EISMFrameBudgetPriority::High);
+    int32 NumProcessed = 0;
+    for (; NumProcessed < NumToProcess; NumProcessed++)
     {
-        RequestFeedback(FeedbackQueue[i]);
+        if (NumProcessed > 0 && !Budget.HasTime())
+        {
+            break;
+        }
+        
+        if (FindOrBuildDispatchList(FeedbackQueue[NumProcessed].FeedbackTag).Num() > 0)
+        {
+            FeedbackQueue[NumProcessed].ResolveParticipants();
+        }
+        RequestFeedback(FeedbackQueue[NumProcessed]);
     }
     
     // Remove processed feedback
-    FeedbackQueue.RemoveAt(0, NumToProcess);
+    FeedbackQueue.RemoveAt(0, NumProcessed);
+    Budget.Defer(FeedbackQueue.Num());
+    
+    // Whatever is left was deferred; one-shots that have waited too long are dropped
+    const int32 NumBeforeExpiry = FeedbackQueue.Num();
+    FeedbackQueue.RemoveAll([this](FISMFeedbackContext& Context)
+    {
+        if (Context.DeferredFrames < 255)
+        {
+            Context.DeferredFrames++;
+        }
+        return !Context.IsContinuous() && Context.DeferredFrames > MaxFeedbackDeferFrames;
+    });
+    CachedStats.CulledRequests += NumBeforeExpiry - FeedbackQueue.Num();
+}
+
+void UISMFeedbackSubsystem::ScoreFeedbackQueue()
+{
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::ScoreFeedbackQueue);
+    
+    UWorld* World = GetWorld();
+    APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    APlayerCameraManager* CameraManager = PlayerController ? PlayerController->PlayerCameraManager.Get() : nullptr;
+    if (!CameraManager)
+    {
+        // Nobody to be significant to (dedicated server, early startup); leave the queue as is
+        return;
+    }
+    
+    const FVector CameraLocation = CameraManager->GetCameraLocation();
+    const FVector CameraForward = CameraManager->GetCameraRotation().Vector();
+    const float CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(CameraManager->GetFOVAngle() * 0.5f));
+    const float InvMaxDistance = 1.0f / FMath::Max(SignificanceMaxDistance, 1.0f);
+    
+    // Close enough to be heard or seen peripherally regardless of facing
+    const float NearbyDistance = SignificanceMaxDistance * 0.05f;
+    
+    const int32 NumBeforeCull = FeedbackQueue.Num();
+    FeedbackQueue.RemoveAll([&](FISMFeedbackContext& Context)
+    {
+        // Continuous lifecycles must arrive complete and in order; never cull or reorder them
+        if (Context.IsContinuous())
+        {
+            Context.Significance = 1.0f;
+            return false;
+        }
+        
+        const FVector ToFeedback = Context.Location - CameraLocation;
+        const float Distance = static_cast<float>(ToFeedback.Size());
+        
+        const float DistanceTerm = 1.0f - FMath::Clamp(Distance * InvMaxDistance, 0.0f, 1.0f);
+        const float IntensityTerm = FMath::Lerp(0.5f, 1.0f, FMath::Clamp(Context.Intensity, 0.0f, 1.0f));
+        
+        const bool bOnScreen = Distance <= NearbyDistance
+            || (ToFeedback / FMath::Max(Distance, UE_KINDA_SMALL_NUMBER) | CameraForward) >= CosHalfFOV;
+        
+        Context.Significance = DistanceTerm * IntensityTerm * (bOnScreen ? 1.0f : OffscreenSignificanceScale);
+        return Context.Significance < MinFeedbackSignificance;
+    });
+    CachedStats.CulledRequests += NumBeforeCull - FeedbackQueue.Num();
+    
+    // Stable so equally significant requests keep their queued order
+    FeedbackQueue.StableSort([](const FISMFeedbackContext& A, const FISMFeedbackContext& B)
+    {
+        return A.Significance > B.Significance;
+    });
+}
+
+void UISMFeedbackSubsystem::CoalesceFeedbackQueue()
+{
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::CoalesceFeedbackQueue);
+    
+    if (FeedbackQueue.Num() < 2)
+    {
+        return;
+    }
+    
+    const double InvCellSize = 1.0 / FMath::Max(static_cast<double>(CoalesceCellSize), 1.0);
+    
+    TMap<FFeedbackCoalesceKey, int32> Buckets;
+    Buckets.Reserve(FeedbackQueue.Num());
+    
+    TArray<FISMFeedbackContext> Coalesced;
+    Coalesced.Reserve(FeedbackQueue.Num());
+    
+    for (FISMFeedbackContext& Context : FeedbackQueue)
+    {
+        // Continuous feedback drives per-request lifecycles; merging would drop STARTED/COMPLETED pairs
+        if (Context.IsContinuous())
+        {
+            Coalesced.Add(MoveTemp(Context));
+            continue;
+        }
+        
+        FFeedbackCoalesceKey Key;
+        Key.Tag = Context.FeedbackTag;
+        Key.Subject = Context.Subject.ParticipantComponent;
+        Key.Cell = FIntVector(
+            FMath::FloorToInt32(Context.Location.X * InvCellSize),
+            FMath::FloorToInt32(Context.Location.Y * InvCellSize),
+            FMath::FloorToInt32(Context.Location.Z * InvCellSize));
+        
+        if (const int32* Existing = Buckets.Find(Key))
+        {
+            MergeFeedbackContext(Coalesced[*Existing], Context);
+            CachedStats.CoalescedRequests++;
+            continue;
+        }
+        
+        Buckets.Add(Key, Coalesced.Add(MoveTemp(Context)));
+    }
+    
+    FeedbackQueue = MoveTemp(Coalesced);
 }
 
 void UISMFeedbackSubsystem::DebugDrawFeedback(const FISMFeedbackContext& Context)
@@ -410,8 +775,157 @@ void UISMFeedbackSubsystem::ResetStats()
     CachedStats.RegisteredProviders = FeedbackProviders.Num();
     CachedStats.HandledRequests = 0;
     CachedStats.UnhandledRequests = 0;
+    CachedStats.CoalescedRequests = 0;
+    CachedStats.CulledRequests = 0;
     CachedStats.AverageProcessingTimeMs = 0.0f;
+    CachedStats.LastFrameProcessingTimeMs = 0.0f;
     
-    ProcessingTimeAccumulator = 0.0;
-    ProcessingTimeSamples = 0;
+    ProcessingTimeWindow.Reset();
+    TagTimings.Reset();
+    HandlerTimings.Reset();
+}
+
+void UISMFeedbackSubsystem::RecordHandlerTiming(FName HandlerName, float TimeMs)
+{
+    if (bProfileFeedbackCosts)
+    {
+        HandlerTimings.Add(HandlerName, TimeMs, ProfilingWindowSize);
+    }
+}
+
+void UISMFeedbackSubsystem::EndProfilingFrame()
+{
+    CachedStats.LastFrameProcessingTimeMs = ProcessingTimeWindow.FrameMs;
+    ProcessingTimeWindow.EndFrame();
+    
+#if CSV_PROFILER
+    const int32 CsvCategory = bProfileFeedbackCosts ? CSV_CATEGORY_INDEX(ISMFeedback) : INDEX_NONE;
+    FCsvProfiler::RecordCustomStat(TEXT("ProcessingMs"), CSV_CATEGORY_INDEX(ISMFeedback), CachedStats.LastFrameProcessingTimeMs, ECsvCustomStatOp::Set);
+#else
+    const int32 CsvCategory = INDEX_NONE;
+#endif
+    
+    TagTimings.EndFrame(CsvCategory, TEXT("Tag_"));
+    HandlerTimings.EndFrame(CsvCategory, TEXT("Handler_"));
+}
+
+// ===== Recording & Replay =====
+
+void UISMFeedbackSubsystem::StartFeedbackRecording()
+{
+    Recording = MakeUnique<FISMFeedbackRecording>();
+    RecordingStartTime = FPlatformTime::Seconds();
+    Recording->BeginFrame(0.0f);
+    
+    UE_LOG(LogISMFeedback, Log, TEXT("Feedback recording started"));
+}
+
+bool UISMFeedbackSubsystem::StopFeedbackRecording(const FString& FilePath)
+{
+    if (!Recording)
+    {
+        return false;
+    }
+    
+    const TUniquePtr<FISMFeedbackRecording> Finished = MoveTemp(Recording);
+    const FString Path = !FilePath.IsEmpty()
+        ? FilePath
+        : FPaths::ProfilingDir() / TEXT("ISMFeedback") / (FDateTime::Now().ToString() + TEXT(".ismfb"));
+    
+    if (!Finished->SaveToFile(Path))
+    {
+        UE_LOG(LogISMFeedback, Warning, TEXT("Failed to write feedback recording to %s"), *Path);
+        return false;
+    }
+    
+    UE_LOG(LogISMFeedback, Log, TEXT("Feedback recording saved: %s (%d frames, %d requests)"),
+        *Path, Finished->Frames.Num(), Finished->GetNumEvents());
+    return true;
+}
+
+bool UISMFeedbackSubsystem::StartFeedbackReplay(const FString& FilePath, bool bMatchRecordedTiming)
+{
+    TUniquePtr<FISMFeedbackRecording> Loaded = MakeUnique<FISMFeedbackRecording>();
+    if (!Loaded->LoadFromFile(FilePath))
+    {
+        UE_LOG(LogISMFeedback, Warning, TEXT("Failed to load feedback recording %s"), *FilePath);
+        return false;
+    }
+    
+    Replay = MoveTemp(Loaded);
+    ReplayFrameIndex = 0;
+    ReplayStartTime = FPlatformTime::Seconds();
+    bReplayMatchesRecordedTiming = bMatchRecordedTiming;
+    ReplayStats = FISMFeedbackReplayStats();
+    
+    UE_LOG(LogISMFeedback, Log, TEXT("Replaying feedback recording %s (%d frames, %d requests)"),
+        *FilePath, Replay->Frames.Num(), Replay->GetNumEvents());
+    return true;
+}
+
+void UISMFeedbackSubsystem::StopFeedbackReplay()
+{
+    if (!Replay)
+    {
+        return;
+    }
+    
+    Replay.Reset();
+    
+    UE_LOG(LogISMFeedback, Log, TEXT("Feedback replay finished: %d frames, %d requests (%d handled, %d no longer handled), %.2f ms total, peak %.3f ms at frame %d"),
+        ReplayStats.FramesReplayed,
+        ReplayStats.EventsReplayed,
+        ReplayStats.HandledEvents,
+        ReplayStats.NewlyUnhandledEvents,
+        ReplayStats.TotalRouteTimeMs,
+        ReplayStats.PeakFrameRouteTimeMs,
+        ReplayStats.PeakFrameIndex);
+}
+
+void UISMFeedbackSubsystem::TickReplay()
+{
+    ISM_TRACE_SCOPE(UISMFeedbackSubsystem::TickReplay);
+    
+    const float Elapsed = static_cast<float>(FPlatformTime::Seconds() - ReplayStartTime);
+    
+    // One frame per tick, or every frame whose recorded time has come
+    do
+    {
+        if (!Replay->Frames.IsValidIndex(ReplayFrameIndex))
+        {
+            StopFeedbackReplay();
+            return;
+        }
+        
+        if (bReplayMatchesRecordedTiming && Replay->Frames[ReplayFrameIndex].Time > Elapsed)
+        {
+            return;
+        }
+        
+        ReplayFrame(Replay->Frames[ReplayFrameIndex]);
+        ReplayFrameIndex++;
+    }
+    while (bReplayMatchesRecordedTiming);
+}
+
+void UISMFeedbackSubsystem::ReplayFrame(const FISMFeedbackRecordedFrame& Frame)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    
+    for (const FISMFeedbackRecordedEvent& Event : Frame.Events)
+    {
+        const bool bHandled = RequestFeedback(Replay->MakeContext(Event));
+        ReplayStats.HandledEvents += bHandled ? 1 : 0;
+        ReplayStats.NewlyUnhandledEvents += (!bHandled && Event.HandledByMask != 0) ? 1 : 0;
+    }
+    
+    const float FrameMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    ReplayStats.TotalRouteTimeMs += FrameMs;
+    if (FrameMs > ReplayStats.PeakFrameRouteTimeMs)
+    {
+        ReplayStats.PeakFrameRouteTimeMs = FrameMs;
+        ReplayStats.PeakFrameIndex = ReplayFrameIndex;
+    }
+    ReplayStats.FramesReplayed++;
+    ReplayStats.EventsReplayed += Frame.Events.Num();
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+// ISMBakedInstanceState.cpp
+
+#include "ISMBakedInstanceState.h"
+#include "ISMRuntimeComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+namespace
+{
+    /** Bump whenever the raw block layout in Serialize changes; older bakes must be re-baked */
+    constexpr int32 BakedStateVersion = 2;
+}
+
+bool UISMBakedInstanceState::IsCompatibleWith(const UISMRuntimeComponent* Component) const
+{
+    if (!Component || !Component->ManagedISMComponent || Transforms.Num() == 0)
+    {
+        return false;
+    }
+
+    const UInstancedStaticMeshComponent* ISM = Component->ManagedISMComponent;
+    return FMath::IsNearlyEqual(SpatialIndexCellSize, Component->SpatialIndexCellSize)
+        && NumCustomDataFloats == ISM->NumCustomDataFloats
+        && ComponentTransform.Equals(ISM->GetComponentTransform())
+        && StateFlags.Num() == Transforms.Num()
+        && CustomData.Num() == Transforms.Num() * NumCustomDataFloats
+        && InstanceTagOffsets.Num() == Transforms.Num() + 1
+        && WorldLocations.Num() == Transforms.Num();
+}
+
+bool UISMBakedInstanceState::IsUpToDateWith(const UISMRuntimeComponent* Component) const
+{
+    return IsCompatibleWith(Component)
+        && Component->ManagedISMComponent->GetInstanceCount() == Transforms.Num()
+        && SourceHash == ComputeSourceHash(Component->ManagedISMComponent);
+}
+
+uint32 UISMBakedInstanceState::ComputeSourceHash(const UInstancedStaticMeshComponent* ISM)
+{
+    if (!ISM)
+    {
+        return 0;
+    }
+
+    uint32 Hash = FCrc::MemCrc32(ISM->PerInstanceSMData.GetData(), ISM->PerInstanceSMData.Num() * ISM->PerInstanceSMData.GetTypeSize());
+    Hash = FCrc::MemCrc32(ISM->PerInstanceSMCustomData.GetData(), ISM->PerInstanceSMCustomData.Num() * sizeof(float), Hash);
+    return Hash;
+}
+
+void UISMBakedInstanceState::Reset()
+{
+    TagTable.Reset();
+    Transforms.Reset();
+    CustomData.Reset();
+    StateFlags.Reset();
+    InstanceTagOffsets.Reset();
+    InstanceTagIds.Reset();
+    CellKeys.Reset();
+    CellOffsets.Reset();
+    CellInstances.Reset();
+    WorldLocations.Reset();
+    BoundsMin.Reset();
+    BoundsMax.Reset();
+    BoundsCellKeys.Reset();
+    BoundsCellBoxes.Reset();
+    BoundsCellCounts.Reset();
+    InstanceBounds = FBox(ForceInit);
+}
+
+void UISMBakedInstanceState::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    int32 Version = BakedStateVersion;
+    Ar << Version;
+    if (Ar.IsLoading() && Version != BakedStateVersion)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMBakedInstanceState: %s was baked with version %d (current %d) - re-bake it"),
+            *GetPathName(), Version, BakedStateVersion);
+        Reset();
+        Ar.SetError();
+        return;
+    }
+
+    Ar << Transforms;
+    CustomData.BulkSerialize(Ar);
+    StateFlags.BulkSerialize(Ar);
+    InstanceTagOffsets.BulkSerialize(Ar);
+    InstanceTagIds.BulkSerialize(Ar);
+    CellKeys.BulkSerialize(Ar);
+    CellOffsets.BulkSerialize(Ar);
+    CellInstances.BulkSerialize(Ar);
+    WorldLocations.BulkSerialize(Ar);
+    BoundsMin.BulkSerialize(Ar);
+    BoundsMax.BulkSerialize(Ar);
+    BoundsCellKeys.BulkSerialize(Ar);
+    Ar << BoundsCellBoxes;
+    BoundsCellCounts.BulkSerialize(Ar);
+}
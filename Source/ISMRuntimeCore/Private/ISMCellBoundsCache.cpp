@@ -0,0 +1,136 @@
+// ISMCellBoundsCache.cpp
+#include "ISMCellBoundsCache.h"
+
+void FISMCellBoundsCache::Reset(float InCellSize)
+{
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    Cells.Reset();
+    DirtyCells.Reset();
+    Union = FBox(ForceInit);
+}
+
+void FISMCellBoundsCache::Add(const FVector& Location)
+{
+    FCell& Cell = Cells.FindOrAdd(LocationToCell(Location));
+    Cell.Box += Location;
+    Cell.Num++;
+    Union += Location;
+}
+
+void FISMCellBoundsCache::ExportCells(TArray<FIntVector>& OutKeys, TArray<FBox>& OutBoxes, TArray<int32>& OutCounts) const
+{
+    OutKeys.Reset(Cells.Num());
+    OutBoxes.Reset(Cells.Num());
+    OutCounts.Reset(Cells.Num());
+    for (const TPair<FIntVector, FCell>& Pair : Cells)
+    {
+        OutKeys.Add(Pair.Key);
+        OutBoxes.Add(Pair.Value.Box);
+        OutCounts.Add(Pair.Value.Num);
+    }
+}
+
+bool FISMCellBoundsCache::ImportCells(float InCellSize, TConstArrayView<FIntVector> Keys, TConstArrayView<FBox> Boxes, TConstArrayView<int32> Counts)
+{
+    Reset(InCellSize);
+    if (Keys.Num() != Boxes.Num() || Keys.Num() != Counts.Num())
+    {
+        return false;
+    }
+
+    Cells.Reserve(Keys.Num());
+    for (int32 i = 0; i < Keys.Num(); ++i)
+    {
+        FCell& Cell = Cells.Add(Keys[i]);
+        Cell.Box = Boxes[i];
+        Cell.Num = Counts[i];
+        Union += Boxes[i];
+    }
+    return true;
+}
+
+void FISMCellBoundsCache::Remove(const FVector& Location)
+{
+    const FIntVector CellCoord = LocationToCell(Location);
+    FCell* Cell = Cells.Find(CellCoord);
+    if (!Cell)
+    {
+        return;
+    }
+
+    if (--Cell->Num <= 0 || TouchesFace(Cell->Box, Location, Location))
+    {
+        DirtyCells.Add(CellCoord);
+    }
+}
+
+void FISMCellBoundsCache::RefreshDirtyCells(TFunctionRef<void(const FBox& CellBox, TFunctionRef<void(const FVector&)> AddPoint)> Gather)
+{
+    if (DirtyCells.Num() == 0)
+    {
+        return;
+    }
+
+    bool bUnionMayShrink = false;
+    for (const FIntVector& CellCoord : DirtyCells)
+    {
+        FCell* Cell = Cells.Find(CellCoord);
+        if (!Cell)
+        {
+            continue;
+        }
+
+        const FVector CellMin(CellCoord.X * CellSize, CellCoord.Y * CellSize, CellCoord.Z * CellSize);
+        FCell Rebuilt;
+        Gather(FBox(CellMin, CellMin + FVector(CellSize)), [this, &CellCoord, &Rebuilt](const FVector& Location)
+            {
+                if (LocationToCell(Location) == CellCoord)
+                {
+                    Rebuilt.Box += Location;
+                    Rebuilt.Num++;
+                }
+            });
+
+        bUnionMayShrink = bUnionMayShrink || TouchesFace(Union, Cell->Box.Min, Cell->Box.Max);
+
+        if (Rebuilt.Num > 0)
+        {
+            *Cell = Rebuilt;
+        }
+        else
+        {
+            Cells.Remove(CellCoord);
+        }
+    }
+    DirtyCells.Reset();
+
+    if (bUnionMayShrink || Cells.Num() == 0)
+    {
+        Union = FBox(ForceInit);
+        for (const TPair<FIntVector, FCell>& Pair : Cells)
+        {
+            Union += Pair.Value.Box;
+        }
+    }
+}
+
+FIntVector FISMCellBoundsCache::LocationToCell(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Location.X / CellSize),
+        FMath::FloorToInt(Location.Y / CellSize),
+        FMath::FloorToInt(Location.Z / CellSize)
+    );
+}
+
+bool FISMCellBoundsCache::TouchesFace(const FBox& Box, const FVector& Min, const FVector& Max)
+{
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        if (Box.Min[Axis] < Box.Max[Axis] && (Min[Axis] <= Box.Min[Axis] || Max[Axis] >= Box.Max[Axis]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
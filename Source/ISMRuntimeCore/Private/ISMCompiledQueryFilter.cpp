@@ -0,0 +1,143 @@
+// ISMCompiledQueryFilter.cpp
+#include "ISMCompiledQueryFilter.h"
+#include "ISMRuntimeComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+FISMCompiledQueryFilter::FISMCompiledQueryFilter(const FISMQueryFilter& InFilter)
+    : Filter(InFilter)
+{
+    for (EISMInstanceState State : Filter.RequiredStates)
+    {
+        RequiredStateMask |= static_cast<uint8>(State);
+        bStatesNeverPass |= State == EISMInstanceState::None;
+    }
+    for (EISMInstanceState State : Filter.ExcludedStates)
+    {
+        ExcludedStateMask |= static_cast<uint8>(State);
+    }
+    bHasRequiredStates = Filter.RequiredStates.Num() > 0;
+
+    bHasTagSets = !Filter.RequiredTags.IsEmpty() || !Filter.ExcludedTags.IsEmpty();
+    bHasTagQuery = !Filter.TagQuery.IsEmpty();
+    bHasAABBFilter = Filter.bFilterByAABB && Filter.AABBOverlapBox.IsValid != 0;
+}
+
+FISMCompiledComponentFilter FISMCompiledQueryFilter::BindComponent(const UISMRuntimeComponent* Component) const
+{
+    FISMCompiledComponentFilter Bound;
+    Bound.Component = Component;
+    if (!Component)
+    {
+        return Bound;
+    }
+
+    for (TSubclassOf<UInterface> InterfaceClass : Filter.RequiredInterfaces)
+    {
+        if (InterfaceClass && !Component->GetClass()->ImplementsInterface(InterfaceClass))
+        {
+            return Bound;
+        }
+    }
+
+    if (Filter.AllowedMeshes.Num() > 0)
+    {
+        UStaticMesh* Mesh = Component->ManagedISMComponent ? Component->ManagedISMComponent->GetStaticMesh() : nullptr;
+        if (!Filter.AllowedMeshes.Contains(Mesh))
+        {
+            return Bound;
+        }
+    }
+
+    if (bHasAABBFilter)
+    {
+        if (Component->bComputeInstanceAABBs)
+        {
+            Bound.bTestAABB = true;
+        }
+        else if (Filter.bExcludeIfAABBUnavailable)
+        {
+            // Component opted out and the caller excludes such components
+            return Bound;
+        }
+    }
+
+    if (bHasTagSets && Component->bCompactInstanceTags)
+    {
+        Component->GetCompactInstanceTags().BuildFilterMasks(Component->ISMComponentTags, Filter.RequiredTags, Filter.ExcludedTags, Bound.TagMasks);
+        if (Bound.TagMasks.bNeverPasses)
+        {
+            return Bound;
+        }
+        Bound.bUseTagMasks = true;
+    }
+
+    Bound.bPasses = true;
+    return Bound;
+}
+
+bool FISMCompiledQueryFilter::PassesInstance(const FISMCompiledComponentFilter& Bound, int32 InstanceIndex) const
+{
+    if (!Bound.bPasses)
+    {
+        return false;
+    }
+
+    const UISMRuntimeComponent* Comp = Bound.Component;
+
+    // Straight from the dense store rather than through the IISMStateProvider virtuals
+    const FISMInstanceStateStore& States = Comp->GetInstanceStateStore();
+    if (!PassesStateFlags(States.Contains(InstanceIndex), States.GetFlags(InstanceIndex)))
+    {
+        return false;
+    }
+
+    if (Bound.bUseTagMasks)
+    {
+        if (!Bound.TagMasks.Passes(Comp->GetCompactInstanceTags().GetEffectiveMask(InstanceIndex)))
+        {
+            return false;
+        }
+    }
+    else if (bHasTagSets && !Comp->InstancePassesTagFilter(InstanceIndex, Filter.RequiredTags, Filter.ExcludedTags))
+    {
+        return false;
+    }
+
+    if (bHasTagQuery && !Filter.TagQuery.Matches(Comp->GetInstanceTags(InstanceIndex)))
+    {
+        return false;
+    }
+
+    if (Bound.bTestAABB)
+    {
+        const FBox InstanceBounds = Comp->GetInstanceWorldBounds(InstanceIndex);
+        if (!InstanceBounds.IsValid || !InstanceBounds.Intersect(Filter.AABBOverlapBox))
+        {
+            return false;
+        }
+    }
+
+    if (Filter.CustomFilter)
+    {
+        FISMInstanceReference Ref;
+        Ref.Component = const_cast<UISMRuntimeComponent*>(Comp);
+        Ref.InstanceIndex = InstanceIndex;
+        Ref.Generation = static_cast<int32>(Comp->GetInstanceGeneration(InstanceIndex));
+        if (!Filter.CustomFilter(Ref))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FISMCompiledQueryFilter::PassesFilter(const FISMInstanceReference& Instance) const
+{
+    if (!Instance.IsValid())
+    {
+        return false;
+    }
+
+    return PassesInstance(BindComponent(Instance.Component.Get()), Instance.InstanceIndex);
+}
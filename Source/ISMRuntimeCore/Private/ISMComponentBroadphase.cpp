@@ -0,0 +1,367 @@
+// ISMComponentBroadphase.cpp
+#include "ISMComponentBroadphase.h"
+#include "ISMRuntimeComponent.h"
+#include "Algo/Sort.h"
+
+FISMComponentBroadphase::FISMComponentBroadphase(float InCellSize)
+    : CellSize(FMath::Max(InCellSize, 100.0f))
+{
+}
+
+void FISMComponentBroadphase::SetCellSize(float InCellSize)
+{
+    const float NewCellSize = FMath::Max(InCellSize, 100.0f);
+    if (NewCellSize == CellSize)
+    {
+        return;
+    }
+
+    CellSize = NewCellSize;
+    for (int32 EntryId = 0; EntryId < Entries.Num(); EntryId++)
+    {
+        if (Entries[EntryId].Component.IsValid())
+        {
+            Unbucket(EntryId);
+            Bucket(EntryId);
+        }
+    }
+}
+
+void FISMComponentBroadphase::Add(UISMRuntimeComponent* Component)
+{
+    if (!Component || EntryByComponent.Contains(Component))
+    {
+        return;
+    }
+
+    const int32 EntryId = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+    Entries[EntryId] = FEntry();
+    Entries[EntryId].Component = Component;
+    EntryByComponent.Add(Component, EntryId);
+
+    Bucket(EntryId);
+}
+
+void FISMComponentBroadphase::Remove(const UISMRuntimeComponent* Component)
+{
+    int32 EntryId = INDEX_NONE;
+    if (!EntryByComponent.RemoveAndCopyValue(Component, EntryId))
+    {
+        return;
+    }
+
+    Unbucket(EntryId);
+    if (Entries[EntryId].bDirty)
+    {
+        DirtyEntries.RemoveSingleSwap(EntryId, EAllowShrinking::No);
+    }
+    Entries[EntryId] = FEntry();
+    FreeEntries.Add(EntryId);
+}
+
+void FISMComponentBroadphase::MarkDirty(const UISMRuntimeComponent* Component)
+{
+    const int32* EntryId = EntryByComponent.Find(Component);
+    if (!EntryId || Entries[*EntryId].bDirty)
+    {
+        return;
+    }
+
+    Entries[*EntryId].bDirty = true;
+    DirtyEntries.Add(*EntryId);
+}
+
+void FISMComponentBroadphase::Flush()
+{
+    for (int32 EntryId : DirtyEntries)
+    {
+        FEntry& Entry = Entries[EntryId];
+        Entry.bDirty = false;
+        Unbucket(EntryId);
+        Bucket(EntryId);
+    }
+    DirtyEntries.Reset();
+}
+
+void FISMComponentBroadphase::RemoveStaleEntries()
+{
+    for (auto It = EntryByComponent.CreateIterator(); It; ++It)
+    {
+        const int32 EntryId = It.Value();
+        if (Entries[EntryId].Component.IsValid())
+        {
+            continue;
+        }
+
+        Unbucket(EntryId);
+        if (Entries[EntryId].bDirty)
+        {
+            DirtyEntries.RemoveSingleSwap(EntryId, EAllowShrinking::No);
+        }
+        Entries[EntryId] = FEntry();
+        FreeEntries.Add(EntryId);
+        It.RemoveCurrent();
+    }
+}
+
+void FISMComponentBroadphase::Reset()
+{
+    Entries.Reset();
+    FreeEntries.Reset();
+    EntryByComponent.Reset();
+    Cells.Reset();
+    ListedEntries.Reset();
+    DirtyEntries.Reset();
+}
+
+void FISMComponentBroadphase::GatherOverlapping(const FBox& Box, FCandidateArray& OutComponents) const
+{
+    OutComponents.Reset();
+    if (!Box.IsValid)
+    {
+        return;
+    }
+
+    TArray<int32, TInlineAllocator<32>> EntryIds;
+    auto Consider = [this, &Box, &EntryIds](int32 EntryId)
+        {
+            const FEntry& Entry = Entries[EntryId];
+            if (Entry.bUnbounded || Entry.Bounds.Intersect(Box))
+            {
+                EntryIds.Add(EntryId);
+            }
+        };
+
+    const FIntVector MinCell = LocationToCell(Box.Min);
+    const FIntVector MaxCell = LocationToCell(Box.Max);
+    const int64 NumRangeCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+    if (NumRangeCells > Cells.Num())
+    {
+        // Query covers more cells than exist - scan the map instead
+        for (const TPair<FIntVector, TArray<int32>>& Pair : Cells)
+        {
+            const FIntVector& C = Pair.Key;
+            if (C.X >= MinCell.X && C.X <= MaxCell.X && C.Y >= MinCell.Y && C.Y <= MaxCell.Y && C.Z >= MinCell.Z && C.Z <= MaxCell.Z)
+            {
+                for (int32 EntryId : Pair.Value)
+                {
+                    Consider(EntryId);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+            {
+                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+                {
+                    if (const TArray<int32>* CellEntries = Cells.Find(FIntVector(X, Y, Z)))
+                    {
+                        for (int32 EntryId : *CellEntries)
+                        {
+                            Consider(EntryId);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (int32 EntryId : ListedEntries)
+    {
+        Consider(EntryId);
+    }
+
+    // Entries spanning several cells were seen once per cell
+    EntryIds.Sort();
+    for (int32 i = 0; i < EntryIds.Num(); i++)
+    {
+        if (i > 0 && EntryIds[i] == EntryIds[i - 1])
+        {
+            continue;
+        }
+
+        if (UISMRuntimeComponent* Component = Entries[EntryIds[i]].Component.Get())
+        {
+            OutComponents.Add(Component);
+        }
+    }
+}
+
+void FISMComponentBroadphase::GatherByDistance(const FVector& Location, float MaxDistance,
+    FCandidateArray& OutComponents, TArray<float, TInlineAllocator<32>>& OutDistancesSq) const
+{
+    OutComponents.Reset();
+    OutDistancesSq.Reset();
+
+    struct FCandidate
+    {
+        UISMRuntimeComponent* Component;
+        int32 EntryId;
+        float DistanceSq;
+    };
+    TArray<FCandidate, TInlineAllocator<32>> Candidates;
+
+    auto Consider = [this, &Location, &Candidates](int32 EntryId, float MaxDistanceSq)
+        {
+            const FEntry& Entry = Entries[EntryId];
+            UISMRuntimeComponent* Component = Entry.Component.Get();
+            if (!Component || (!Entry.bUnbounded && !Entry.Bounds.IsValid))
+            {
+                return;
+            }
+
+            const float DistanceSq = Entry.bUnbounded ? 0.0f : static_cast<float>(Entry.Bounds.ComputeSquaredDistanceToPoint(Location));
+            if (DistanceSq <= MaxDistanceSq)
+            {
+                Candidates.Add({ Component, EntryId, DistanceSq });
+            }
+        };
+
+    if (MaxDistance > 0.0f)
+    {
+        // Bounded search - only the grid cells around Location
+        FCandidateArray InRange;
+        GatherOverlapping(FBox(Location - FVector(MaxDistance), Location + FVector(MaxDistance)), InRange);
+        for (UISMRuntimeComponent* Component : InRange)
+        {
+            Consider(EntryByComponent.FindChecked(Component), FMath::Square(MaxDistance));
+        }
+    }
+    else
+    {
+        for (const TPair<const UISMRuntimeComponent*, int32>& Pair : EntryByComponent)
+        {
+            Consider(Pair.Value, TNumericLimits<float>::Max());
+        }
+    }
+
+    // Ties keep slot order so results stay deterministic
+    Algo::Sort(Candidates, [](const FCandidate& A, const FCandidate& B)
+        {
+            return A.DistanceSq < B.DistanceSq || (A.DistanceSq == B.DistanceSq && A.EntryId < B.EntryId);
+        });
+
+    for (const FCandidate& Candidate : Candidates)
+    {
+        OutComponents.Add(Candidate.Component);
+        OutDistancesSq.Add(Candidate.DistanceSq);
+    }
+}
+
+SIZE_T FISMComponentBroadphase::GetAllocatedSize() const
+{
+    SIZE_T Size = Entries.GetAllocatedSize()
+        + FreeEntries.GetAllocatedSize()
+        + EntryByComponent.GetAllocatedSize()
+        + Cells.GetAllocatedSize()
+        + ListedEntries.GetAllocatedSize()
+        + DirtyEntries.GetAllocatedSize();
+    for (const TPair<FIntVector, TArray<int32>>& Pair : Cells)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+    return Size;
+}
+
+FIntVector FISMComponentBroadphase::LocationToCell(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Location.X / CellSize),
+        FMath::FloorToInt(Location.Y / CellSize),
+        FMath::FloorToInt(Location.Z / CellSize)
+    );
+}
+
+void FISMComponentBroadphase::Bucket(int32 EntryId)
+{
+    FEntry& Entry = Entries[EntryId];
+    const UISMRuntimeComponent* Component = Entry.Component.Get();
+    if (!Component)
+    {
+        return;
+    }
+
+    FBox Bounds(ForceInit);
+    Entry.bUnbounded = !Component->GetBroadphaseBounds(Bounds);
+    Entry.Bounds = Bounds;
+
+    if (Entry.bUnbounded)
+    {
+        Entry.bListed = true;
+        ListedEntries.Add(EntryId);
+        return;
+    }
+
+    // No active instances - nothing to find until the bounds grow again
+    if (!Bounds.IsValid)
+    {
+        return;
+    }
+
+    Entry.MinCell = LocationToCell(Bounds.Min);
+    Entry.MaxCell = LocationToCell(Bounds.Max);
+    const int64 NumCells = int64(Entry.MaxCell.X - Entry.MinCell.X + 1)
+        * int64(Entry.MaxCell.Y - Entry.MinCell.Y + 1)
+        * int64(Entry.MaxCell.Z - Entry.MinCell.Z + 1);
+
+    if (NumCells > MaxCellsPerEntry)
+    {
+        Entry.bListed = true;
+        ListedEntries.Add(EntryId);
+        return;
+    }
+
+    Entry.bInCells = true;
+    for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; X++)
+    {
+        for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; Y++)
+        {
+            for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; Z++)
+            {
+                Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(EntryId);
+            }
+        }
+    }
+}
+
+void FISMComponentBroadphase::Unbucket(int32 EntryId)
+{
+    FEntry& Entry = Entries[EntryId];
+
+    if (Entry.bListed)
+    {
+        ListedEntries.RemoveSingleSwap(EntryId, EAllowShrinking::No);
+        Entry.bListed = false;
+    }
+
+    if (Entry.bInCells)
+    {
+        for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; X++)
+        {
+            for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; Y++)
+            {
+                for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; Z++)
+                {
+                    const FIntVector Cell(X, Y, Z);
+                    if (TArray<int32>* CellEntries = Cells.Find(Cell))
+                    {
+                        CellEntries->RemoveSingleSwap(EntryId, EAllowShrinking::No);
+                        if (CellEntries->Num() == 0)
+                        {
+                            Cells.Remove(Cell);
+                        }
+                    }
+                }
+            }
+        }
+        Entry.bInCells = false;
+    }
+
+    Entry.bUnbounded = false;
+    Entry.Bounds = FBox(ForceInit);
+}
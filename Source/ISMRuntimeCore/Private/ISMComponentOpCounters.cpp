@@ -0,0 +1,111 @@
+#include "ISMComponentOpCounters.h"
+
+float FISMComponentOpStats::GetTotalRate() const
+{
+    float Sum = 0.0f;
+    for (float Rate : RatesPerSecond)
+    {
+        Sum += Rate;
+    }
+    return Sum;
+}
+
+void FISMComponentOpCounters::SetSamplingEnabled(bool bEnabled)
+{
+    bSampling = bEnabled;
+    if (!bEnabled)
+    {
+        Samples.Empty();
+    }
+}
+
+void FISMComponentOpCounters::Reset()
+{
+    for (int32 Op = 0; Op < NumOps; ++Op)
+    {
+        Totals[Op].store(0, std::memory_order_relaxed);
+        WindowStartTotals[Op] = 0;
+        Rates[Op] = 0.0f;
+    }
+    WindowStartSeconds = 0.0;
+    Samples.Reset();
+}
+
+void FISMComponentOpCounters::RecordSample(int32 InstanceIndex)
+{
+    if (Samples.Num() >= MaxSampledInstances && !Samples.Contains(InstanceIndex))
+    {
+        for (auto It = Samples.CreateIterator(); It; ++It)
+        {
+            It.Value() /= 2;
+            if (It.Value() == 0)
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        // Everything was a one-off; start over rather than decay again on the next new index
+        if (Samples.Num() >= MaxSampledInstances)
+        {
+            Samples.Reset();
+        }
+    }
+    ++Samples.FindOrAdd(InstanceIndex);
+}
+
+void FISMComponentOpCounters::GetStats(FISMComponentOpStats& OutStats, int32 MaxHotInstances) const
+{
+    uint64 Current[NumOps];
+    for (int32 Op = 0; Op < NumOps; ++Op)
+    {
+        Current[Op] = Totals[Op].load(std::memory_order_relaxed);
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (WindowStartSeconds <= 0.0)
+    {
+        WindowStartSeconds = Now;
+        FMemory::Memcpy(WindowStartTotals, Current, sizeof(Current));
+    }
+    else if (Now - WindowStartSeconds >= 1.0)
+    {
+        const double Elapsed = Now - WindowStartSeconds;
+        for (int32 Op = 0; Op < NumOps; ++Op)
+        {
+            // A Reset from another caller may leave the total below the window start
+            Rates[Op] = Current[Op] >= WindowStartTotals[Op] ? static_cast<float>((Current[Op] - WindowStartTotals[Op]) / Elapsed) : 0.0f;
+        }
+        WindowStartSeconds = Now;
+        FMemory::Memcpy(WindowStartTotals, Current, sizeof(Current));
+    }
+
+    OutStats.Totals.SetNumUninitialized(NumOps);
+    OutStats.RatesPerSecond.SetNumUninitialized(NumOps);
+    for (int32 Op = 0; Op < NumOps; ++Op)
+    {
+        OutStats.Totals[Op] = static_cast<int64>(Current[Op]);
+        OutStats.RatesPerSecond[Op] = Rates[Op];
+    }
+
+    OutStats.HotInstances.Reset();
+    if (MaxHotInstances <= 0 || Samples.Num() == 0)
+    {
+        return;
+    }
+
+    OutStats.HotInstances.Reserve(Samples.Num());
+    for (const TPair<int32, int32>& Pair : Samples)
+    {
+        FISMHotInstanceSample& Sample = OutStats.HotInstances.AddDefaulted_GetRef();
+        Sample.InstanceIndex = Pair.Key;
+        Sample.Mutations = Pair.Value;
+    }
+    OutStats.HotInstances.Sort([](const FISMHotInstanceSample& A, const FISMHotInstanceSample& B)
+    {
+        return A.Mutations != B.Mutations ? A.Mutations > B.Mutations : A.InstanceIndex < B.InstanceIndex;
+    });
+    if (OutStats.HotInstances.Num() > MaxHotInstances)
+    {
+        OutStats.HotInstances.SetNum(MaxHotInstances);
+    }
+}
@@ -0,0 +1,206 @@
+// ISMComponentTagIndex.cpp
+#include "ISMComponentTagIndex.h"
+#include "ISMRuntimeComponent.h"
+
+namespace
+{
+    /** Set bits of a tag mask, low to high */
+    void GatherMaskBits(const FISMTagMask& Mask, TArray<int32, TInlineAllocator<16>>& OutBits)
+    {
+        for (int32 Word = 0; Word < FISMTagMask::NumWords; Word++)
+        {
+            uint64 Bits = Mask.Words[Word];
+            while (Bits)
+            {
+                OutBits.Add(Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits)));
+                Bits &= Bits - 1;
+            }
+        }
+    }
+}
+
+void FISMComponentTagIndex::Add(UISMRuntimeComponent* Component)
+{
+    if (!Component)
+    {
+        return;
+    }
+
+    int32 Slot = INDEX_NONE;
+    if (const int32* Existing = SlotByComponent.Find(Component))
+    {
+        Slot = *Existing;
+        ClearSlot(Slot);
+    }
+    else if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = SlotComponents.AddDefaulted();
+        IndexedSlots.Add(false);
+        UnindexedSlots.Add(false);
+        for (TBitArray<>& Posting : Postings)
+        {
+            Posting.Add(false);
+        }
+    }
+
+    SlotComponents[Slot] = Component;
+    SlotByComponent.Add(Component, Slot);
+
+    bool bFits = true;
+    for (const FGameplayTag& Tag : Component->ISMComponentTags)
+    {
+        const int32 Bit = TagBits.FindOrAddBit(Tag);
+        if (Bit == INDEX_NONE)
+        {
+            bFits = false;
+            break;
+        }
+        TagBits.SetInstanceBit(Slot, Bit);
+    }
+
+    // New dictionary bits get an empty posting list, including those added before an overflow
+    while (Postings.Num() < TagBits.GetNumTags())
+    {
+        Postings.Emplace(false, SlotComponents.Num());
+    }
+
+    if (!bFits)
+    {
+        TagBits.ClearInstance(Slot);
+        UnindexedSlots[Slot] = true;
+        return;
+    }
+
+    TArray<int32, TInlineAllocator<16>> Bits;
+    GatherMaskBits(TagBits.GetEffectiveMask(Slot), Bits);
+    for (int32 Bit : Bits)
+    {
+        Postings[Bit][Slot] = true;
+    }
+    IndexedSlots[Slot] = true;
+}
+
+void FISMComponentTagIndex::Remove(const UISMRuntimeComponent* Component)
+{
+    int32 Slot = INDEX_NONE;
+    if (!SlotByComponent.RemoveAndCopyValue(Component, Slot))
+    {
+        return;
+    }
+
+    ClearSlot(Slot);
+    SlotComponents[Slot] = nullptr;
+    FreeSlots.Add(Slot);
+}
+
+void FISMComponentTagIndex::RemoveStaleEntries()
+{
+    for (auto It = SlotByComponent.CreateIterator(); It; ++It)
+    {
+        const int32 Slot = It.Value();
+        if (SlotComponents[Slot].IsValid())
+        {
+            continue;
+        }
+
+        ClearSlot(Slot);
+        SlotComponents[Slot] = nullptr;
+        FreeSlots.Add(Slot);
+        It.RemoveCurrent();
+    }
+}
+
+void FISMComponentTagIndex::Reset()
+{
+    TagBits.Reset();
+    SlotComponents.Reset();
+    SlotByComponent.Reset();
+    FreeSlots.Reset();
+    IndexedSlots.Reset();
+    UnindexedSlots.Reset();
+    Postings.Reset();
+}
+
+void FISMComponentTagIndex::BuildFilterMasks(const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& ExcludedTags, FISMTagFilterMasks& OutMasks) const
+{
+    TagBits.BuildFilterMasks(FGameplayTagContainer::EmptyContainer, RequiredTags, ExcludedTags, OutMasks);
+}
+
+bool FISMComponentTagIndex::PassesTagMasks(const UISMRuntimeComponent* Component, const FISMTagFilterMasks& Masks, bool& bOutExact) const
+{
+    const int32* Slot = SlotByComponent.Find(Component);
+    bOutExact = Slot && IndexedSlots[*Slot];
+    return !bOutExact || Masks.Passes(TagBits.GetEffectiveMask(*Slot));
+}
+
+bool FISMComponentTagIndex::ForEachCandidate(const FISMTagFilterMasks& Masks, TFunctionRef<bool(UISMRuntimeComponent*, bool bExact)> Visitor) const
+{
+    TArray<int32, TInlineAllocator<16>> RequiredBits;
+    TArray<int32, TInlineAllocator<16>> ExcludedBits;
+    GatherMaskBits(Masks.Required, RequiredBits);
+    GatherMaskBits(Masks.Excluded, ExcludedBits);
+
+    const int32 NumWords = FMath::DivideAndRoundUp(SlotComponents.Num(), static_cast<int32>(NumBitsPerDWORD));
+    for (int32 Word = 0; Word < NumWords; Word++)
+    {
+        uint32 Indexed = Masks.bNeverPasses ? 0u : IndexedSlots.GetData()[Word];
+        for (int32 Bit : RequiredBits)
+        {
+            Indexed &= Postings[Bit].GetData()[Word];
+        }
+        for (int32 Bit : ExcludedBits)
+        {
+            Indexed &= ~Postings[Bit].GetData()[Word];
+        }
+
+        uint32 Candidates = Indexed | UnindexedSlots.GetData()[Word];
+        while (Candidates)
+        {
+            const uint32 LowBit = Candidates & (~Candidates + 1);
+            const int32 Slot = Word * NumBitsPerDWORD + static_cast<int32>(FMath::CountTrailingZeros(Candidates));
+            Candidates &= Candidates - 1;
+
+            UISMRuntimeComponent* Component = SlotComponents[Slot].Get();
+            if (Component && !Visitor(Component, (Indexed & LowBit) != 0))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+SIZE_T FISMComponentTagIndex::GetAllocatedSize() const
+{
+    SIZE_T Size = TagBits.GetAllocatedSize()
+        + SlotComponents.GetAllocatedSize()
+        + SlotByComponent.GetAllocatedSize()
+        + FreeSlots.GetAllocatedSize()
+        + IndexedSlots.GetAllocatedSize()
+        + UnindexedSlots.GetAllocatedSize()
+        + Postings.GetAllocatedSize();
+    for (const TBitArray<>& Posting : Postings)
+    {
+        Size += Posting.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FISMComponentTagIndex::ClearSlot(int32 Slot)
+{
+    TArray<int32, TInlineAllocator<16>> Bits;
+    GatherMaskBits(TagBits.GetEffectiveMask(Slot), Bits);
+    for (int32 Bit : Bits)
+    {
+        Postings[Bit][Slot] = false;
+    }
+
+    TagBits.ClearInstance(Slot);
+    IndexedSlots[Slot] = false;
+    UnindexedSlots[Slot] = false;
+}
@@ -0,0 +1,133 @@
+// ISMCustomDataJournal.cpp
+#include "ISMCustomDataJournal.h"
+#include "Algo/BinarySearch.h"
+
+void FISMCustomDataJournal::Enable()
+{
+    if (bEnabled)
+    {
+        return;
+    }
+    bEnabled = true;
+    MarkReset();
+}
+
+void FISMCustomDataJournal::Disable()
+{
+    Deltas.Empty();
+    LiveByKey.Empty();
+    NumRetired = 0;
+    bEnabled = false;
+}
+
+void FISMCustomDataJournal::Record(int32 InstanceIndex, int32 Slot, float Value)
+{
+    if (!bEnabled || InstanceIndex < 0 || Slot < 0)
+    {
+        return;
+    }
+
+    const uint64 Key = MakeKey(InstanceIndex, Slot);
+    int32& LiveIndex = LiveByKey.FindOrAdd(Key, INDEX_NONE);
+    if (LiveIndex != INDEX_NONE)
+    {
+        Deltas[LiveIndex].InstanceIndex = INDEX_NONE;
+        NumRetired++;
+    }
+
+    LiveIndex = Deltas.Num();
+    FISMCustomDataDelta& Delta = Deltas.AddDefaulted_GetRef();
+    Delta.InstanceIndex = InstanceIndex;
+    Delta.Slot = Slot;
+    Delta.Value = Value;
+    Delta.Serial = NextSerial++;
+
+    CompactIfSparse();
+}
+
+void FISMCustomDataJournal::RecordRow(int32 InstanceIndex, int32 FirstSlot, TConstArrayView<float> Values)
+{
+    if (!bEnabled)
+    {
+        return;
+    }
+    for (int32 i = 0; i < Values.Num(); ++i)
+    {
+        Record(InstanceIndex, FirstSlot + i, Values[i]);
+    }
+}
+
+void FISMCustomDataJournal::MarkReset()
+{
+    Deltas.Reset();
+    LiveByKey.Reset();
+    NumRetired = 0;
+    ResetSerial = NextSerial;
+}
+
+bool FISMCustomDataJournal::CollectSince(uint32 Watermark, TArray<FISMCustomDataDelta>& OutDeltas) const
+{
+    if (!CanCatchUp(Watermark))
+    {
+        return false;
+    }
+
+    // Deltas are serial-ordered, so everything from the first at-or-after Watermark qualifies
+    const int32 First = Algo::LowerBoundBy(Deltas, Watermark, &FISMCustomDataDelta::Serial);
+    for (int32 i = First; i < Deltas.Num(); ++i)
+    {
+        if (Deltas[i].InstanceIndex != INDEX_NONE)
+        {
+            OutDeltas.Add(Deltas[i]);
+        }
+    }
+    return true;
+}
+
+void FISMCustomDataJournal::Trim(uint32 Watermark)
+{
+    const int32 First = Algo::LowerBoundBy(Deltas, Watermark, &FISMCustomDataDelta::Serial);
+    if (First == 0)
+    {
+        return;
+    }
+
+    for (int32 i = 0; i < First; ++i)
+    {
+        if (Deltas[i].InstanceIndex != INDEX_NONE)
+        {
+            LiveByKey.Remove(MakeKey(Deltas[i].InstanceIndex, Deltas[i].Slot));
+        }
+        else
+        {
+            NumRetired--;
+        }
+    }
+    Deltas.RemoveAt(0, First, EAllowShrinking::No);
+    Compact();
+}
+
+void FISMCustomDataJournal::CompactIfSparse()
+{
+    if (NumRetired > 64 && NumRetired > LiveByKey.Num())
+    {
+        Compact();
+    }
+}
+
+void FISMCustomDataJournal::Compact()
+{
+    int32 Write = 0;
+    for (int32 Read = 0; Read < Deltas.Num(); ++Read)
+    {
+        if (Deltas[Read].InstanceIndex == INDEX_NONE)
+        {
+            continue;
+        }
+        Deltas[Write] = Deltas[Read];
+        LiveByKey.FindChecked(MakeKey(Deltas[Write].InstanceIndex, Deltas[Write].Slot)) = Write;
+        ++Write;
+    }
+    Deltas.SetNum(Write, EAllowShrinking::No);
+    NumRetired = 0;
+}
@@ -0,0 +1,281 @@
+#include "ISMFrameBudget.h"
+#include "ISMRuntimeSubsystem.h"
+#include "Engine/World.h"
+
+namespace
+{
+    /** Weight of the last frame in a client's smoothed demand */
+    constexpr double DemandSmoothing = 0.25;
+
+    /** Demand growth per frame while a client defers work */
+    constexpr double DeferredDemandGrowth = 1.5;
+
+    constexpr double Unbudgeted = TNumericLimits<double>::Max();
+}
+
+// ============================================================
+//  FISMFrameBudgetGovernor
+// ============================================================
+
+void FISMFrameBudgetGovernor::Configure(const FConfig& InConfig)
+{
+    Config = InConfig;
+    Config.OverloadFrames = FMath::Max(Config.OverloadFrames, 1);
+    Config.RecoveryFrames = FMath::Max(Config.RecoveryFrames, 1);
+    Config.MinSliceMs = FMath::Max(Config.MinSliceMs, 0.0f);
+
+    for (FClient& Client : Clients)
+    {
+        const EISMFrameBudgetPriority* Override = Config.PriorityOverrides.Find(Client.Name);
+        Client.Priority = Override ? *Override : Client.DefaultPriority;
+    }
+    SortClients();
+}
+
+FISMFrameBudgetGovernor::FClient* FISMFrameBudgetGovernor::FindClient(FName Name)
+{
+    return Clients.FindByPredicate([Name](const FClient& Client) { return Client.Name == Name; });
+}
+
+const FISMFrameBudgetGovernor::FClient* FISMFrameBudgetGovernor::FindClient(FName Name) const
+{
+    return Clients.FindByPredicate([Name](const FClient& Client) { return Client.Name == Name; });
+}
+
+void FISMFrameBudgetGovernor::SortClients()
+{
+    Clients.Sort([](const FClient& A, const FClient& B)
+    {
+        return A.Priority != B.Priority ? A.Priority < B.Priority : A.RegistrationOrder < B.RegistrationOrder;
+    });
+}
+
+void FISMFrameBudgetGovernor::BeginFrame()
+{
+    const double BudgetSeconds = Config.BudgetMs / 1000.0;
+    const double MinSliceSeconds = Config.MinSliceMs / 1000.0;
+    const double Now = FPlatformTime::Seconds();
+
+    // Close the frame: fold usage into demand, let deferring clients ask for more
+    double TotalUsed = 0.0;
+    double TotalDemand = 0.0;
+    for (FClient& Client : Clients)
+    {
+        const double Used = Client.GetUsedSeconds(Now);
+        if (Client.DeferredItems > 0)
+        {
+            Client.DemandSeconds = FMath::Max(FMath::Max(Client.DemandSeconds, Used) * DeferredDemandGrowth, MinSliceSeconds);
+            if (BudgetSeconds > 0.0)
+            {
+                Client.DemandSeconds = FMath::Min(Client.DemandSeconds, BudgetSeconds);
+            }
+            Client.StarvedFrames = Used < MinSliceSeconds ? Client.StarvedFrames + 1 : 0;
+        }
+        else
+        {
+            Client.DemandSeconds = FMath::Lerp(Client.DemandSeconds, Used, DemandSmoothing);
+            Client.StarvedFrames = 0;
+        }
+
+        TotalUsed += Used;
+        TotalDemand += Client.DemandSeconds;
+
+        Client.LastUsedSeconds = Used;
+        Client.LastDeferredItems = Client.DeferredItems;
+        Client.UsedSeconds = 0.0;
+        Client.WorkStartSeconds = Now;
+        Client.DeferredItems = 0;
+    }
+    LastDemandSeconds = TotalDemand;
+
+    if (!IsEnabled())
+    {
+        SurplusSeconds = 0.0;
+        if (bOverloaded)
+        {
+            bOverloaded = false;
+            OnOverloadChanged.Broadcast(false);
+        }
+        return;
+    }
+
+    // Overload: demand or use over the budget for a run of frames, cleared after a longer calm run
+    const bool bOverBudget = TotalUsed > BudgetSeconds || TotalDemand > BudgetSeconds;
+    OverBudgetFrames = bOverBudget ? OverBudgetFrames + 1 : 0;
+    WithinBudgetFrames = bOverBudget ? 0 : WithinBudgetFrames + 1;
+    if (!bOverloaded && OverBudgetFrames >= Config.OverloadFrames)
+    {
+        bOverloaded = true;
+        OnOverloadChanged.Broadcast(true);
+    }
+    else if (bOverloaded && WithinBudgetFrames >= Config.RecoveryFrames)
+    {
+        bOverloaded = false;
+        OnOverloadChanged.Broadcast(false);
+    }
+
+    // Reserve in priority order; Critical always gets its demand
+    double Remaining = BudgetSeconds;
+    for (FClient& Client : Clients)
+    {
+        if (Client.Priority == EISMFrameBudgetPriority::Critical)
+        {
+            Client.ReservedSeconds = Client.DemandSeconds;
+        }
+        else
+        {
+            Client.ReservedSeconds = FMath::Min(Client.DemandSeconds, FMath::Max(Remaining, 0.0));
+            if (Client.StarvedFrames >= Config.MaxStarvedFrames)
+            {
+                Client.ReservedSeconds = FMath::Max(Client.ReservedSeconds, MinSliceSeconds);
+            }
+        }
+        Remaining -= Client.ReservedSeconds;
+    }
+    SurplusSeconds = FMath::Max(Remaining, 0.0);
+}
+
+double FISMFrameBudgetGovernor::GetRemainingSeconds(FName Name) const
+{
+    if (!IsEnabled())
+    {
+        return Unbudgeted;
+    }
+
+    const FClient* Client = FindClient(Name);
+    if (!Client || Client->Priority == EISMFrameBudgetPriority::Critical)
+    {
+        return Unbudgeted;
+    }
+
+    // Whatever anyone spent beyond their reservation came out of the surplus
+    const double Now = FPlatformTime::Seconds();
+    double SurplusLeft = SurplusSeconds;
+    for (const FClient& Other : Clients)
+    {
+        SurplusLeft -= FMath::Max(Other.GetUsedSeconds(Now) - Other.ReservedSeconds, 0.0);
+    }
+
+    return FMath::Max(Client->ReservedSeconds - Client->GetUsedSeconds(Now), 0.0) + FMath::Max(SurplusLeft, 0.0);
+}
+
+double FISMFrameBudgetGovernor::ClampBudgetSeconds(FName Client, double OwnBudgetSeconds) const
+{
+    const double Remaining = GetRemainingSeconds(Client);
+    if (Remaining >= Unbudgeted)
+    {
+        return OwnBudgetSeconds;
+    }
+
+    const double Clamped = OwnBudgetSeconds > 0.0 ? FMath::Min(OwnBudgetSeconds, Remaining) : Remaining;
+    return FMath::Max(Clamped, UE_SMALL_NUMBER);
+}
+
+void FISMFrameBudgetGovernor::BeginWork(FName Name, EISMFrameBudgetPriority DefaultPriority)
+{
+    FClient* Client = FindClient(Name);
+    if (!Client)
+    {
+        FClient NewClient;
+        NewClient.Name = Name;
+        NewClient.DefaultPriority = DefaultPriority;
+        const EISMFrameBudgetPriority* Override = Config.PriorityOverrides.Find(Name);
+        NewClient.Priority = Override ? *Override : DefaultPriority;
+        NewClient.RegistrationOrder = Clients.Num();
+
+        // A newcomer has no demand yet; its first frame runs on surplus
+        Clients.Add(MoveTemp(NewClient));
+        SortClients();
+        Client = FindClient(Name);
+    }
+
+    if (Client->WorkDepth++ == 0)
+    {
+        Client->WorkStartSeconds = FPlatformTime::Seconds();
+    }
+}
+
+void FISMFrameBudgetGovernor::EndWork(FName Name)
+{
+    FClient* Client = FindClient(Name);
+    if (!Client || Client->WorkDepth <= 0)
+    {
+        return;
+    }
+
+    if (--Client->WorkDepth == 0)
+    {
+        Client->UsedSeconds += FPlatformTime::Seconds() - Client->WorkStartSeconds;
+    }
+}
+
+void FISMFrameBudgetGovernor::ReportDeferred(FName Name, int32 NumItems)
+{
+    if (FClient* Client = FindClient(Name))
+    {
+        Client->DeferredItems += FMath::Max(NumItems, 0);
+    }
+}
+
+FISMFrameBudgetStats FISMFrameBudgetGovernor::GetStats() const
+{
+    FISMFrameBudgetStats Stats;
+    Stats.BudgetMs = IsEnabled() ? Config.BudgetMs : 0.0f;
+    Stats.DemandMs = static_cast<float>(LastDemandSeconds * 1000.0);
+    Stats.bOverloaded = bOverloaded;
+
+    for (const FClient& Client : Clients)
+    {
+        FISMFrameBudgetClientStats& ClientStats = Stats.Clients.AddDefaulted_GetRef();
+        ClientStats.Name = Client.Name;
+        ClientStats.Priority = Client.Priority;
+        ClientStats.ReservedMs = static_cast<float>(Client.ReservedSeconds * 1000.0);
+        ClientStats.UsedMs = static_cast<float>(Client.LastUsedSeconds * 1000.0);
+        ClientStats.DemandMs = static_cast<float>(Client.DemandSeconds * 1000.0);
+        ClientStats.DeferredItems = Client.LastDeferredItems;
+        ClientStats.StarvedFrames = Client.StarvedFrames;
+        Stats.UsedMs += ClientStats.UsedMs;
+    }
+    return Stats;
+}
+
+FISMFrameBudgetGovernor* FISMFrameBudgetGovernor::Get(const UWorld* World)
+{
+    UISMRuntimeSubsystem* Subsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+    return Subsystem ? &Subsystem->GetFrameBudget() : nullptr;
+}
+
+// ============================================================
+//  FISMFrameBudgetScope
+// ============================================================
+
+FISMFrameBudgetScope::FISMFrameBudgetScope(FISMFrameBudgetGovernor* InGovernor, FName InClient, EISMFrameBudgetPriority DefaultPriority)
+    : Governor(InGovernor)
+    , Client(InClient)
+{
+    if (Governor)
+    {
+        Governor->BeginWork(Client, DefaultPriority);
+    }
+}
+
+FISMFrameBudgetScope::~FISMFrameBudgetScope()
+{
+    if (Governor)
+    {
+        Governor->EndWork(Client);
+    }
+}
+
+double FISMFrameBudgetScope::GetRemainingSeconds() const
+{
+    return Governor ? Governor->GetRemainingSeconds(Client) : Unbudgeted;
+}
+
+void FISMFrameBudgetScope::Defer(int32 NumItems)
+{
+    if (Governor && NumItems > 0)
+    {
+        Governor->ReportDeferred(Client, NumItems);
+    }
+}
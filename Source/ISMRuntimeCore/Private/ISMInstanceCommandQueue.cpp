@@ -0,0 +1,102 @@
+// ISMInstanceCommandQueue.cpp
+#include "ISMInstanceCommandQueue.h"
+#include "Misc/ScopeLock.h"
+
+FISMInstanceCommandQueue::FISMInstanceCommandQueue(int32 Capacity)
+{
+    const uint32 NumCells = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(Capacity, 2)));
+    Mask = NumCells - 1;
+
+    Cells = MakeUnique<FCell[]>(NumCells);
+    for (uint32 i = 0; i < NumCells; i++)
+    {
+        Cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool FISMInstanceCommandQueue::TryPushRing(const FISMInstanceCommand& Command)
+{
+    uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        FCell& Cell = Cells[Pos & Mask];
+        const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+        const int64 Diff = static_cast<int64>(Sequence) - static_cast<int64>(Pos);
+
+        if (Diff == 0)
+        {
+            // Free for this lap; the exchange reloads Pos when another producer got there first
+            if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                Cell.Command = Command;
+                Cell.Sequence.store(Pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (Diff < 0)
+        {
+            // Still holds the previous lap's command: the consumer is a full ring behind
+            return false;
+        }
+        else
+        {
+            Pos = EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void FISMInstanceCommandQueue::Push(const FISMInstanceCommand& Command)
+{
+    if (!bOverflowing.load(std::memory_order_acquire) && TryPushRing(Command))
+    {
+        return;
+    }
+
+    // Raised under the lock, after the append, so this thread's next push also lands here
+    FScopeLock Lock(&OverflowLock);
+    Overflow.Add(Command);
+    bOverflowing.store(true, std::memory_order_release);
+    NumOverflowed.fetch_add(1, std::memory_order_relaxed);
+}
+
+int32 FISMInstanceCommandQueue::Drain(TArray<FISMInstanceCommand>& OutCommands)
+{
+    const int32 NumBefore = OutCommands.Num();
+
+    for (;;)
+    {
+        FCell& Cell = Cells[DequeuePos & Mask];
+        if (Cell.Sequence.load(std::memory_order_acquire) != DequeuePos + 1)
+        {
+            // Empty, or claimed by a producer that has not published yet
+            break;
+        }
+
+        OutCommands.Add(Cell.Command);
+        Cell.Sequence.store(DequeuePos + Mask + 1, std::memory_order_release);
+        ++DequeuePos;
+    }
+
+    // Spilled commands are newer than their thread's ring commands; hold them while a claimed cell is unpublished
+    if (bOverflowing.load(std::memory_order_acquire) && EnqueuePos.load(std::memory_order_acquire) == DequeuePos)
+    {
+        FScopeLock Lock(&OverflowLock);
+        OutCommands.Append(Overflow);
+        Overflow.Reset();
+        bOverflowing.store(false, std::memory_order_release);
+    }
+
+    return OutCommands.Num() - NumBefore;
+}
+
+bool FISMInstanceCommandQueue::IsEmpty() const
+{
+    return Cells[DequeuePos & Mask].Sequence.load(std::memory_order_acquire) != DequeuePos + 1
+        && !bOverflowing.load(std::memory_order_acquire);
+}
+
+SIZE_T FISMInstanceCommandQueue::GetAllocatedSize() const
+{
+    FScopeLock Lock(&OverflowLock);
+    return static_cast<SIZE_T>(GetCapacity()) * sizeof(FCell) + Overflow.GetAllocatedSize();
+}
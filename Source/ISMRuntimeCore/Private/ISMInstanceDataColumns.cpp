@@ -0,0 +1,104 @@
+// ISMInstanceDataColumns.cpp
+#include "ISMInstanceDataColumns.h"
+#include "ISMRuntimeComponent.h"
+
+namespace
+{
+    void FillDefaults(FISMInstanceDataColumn& Column, int32 FirstSlot, int32 EndSlot)
+    {
+        for (int32 Slot = FirstSlot; Slot < EndSlot; Slot++)
+        {
+            FMemory::Memcpy(Column.GetSlot(Slot), Column.DefaultValue.GetData(), Column.ElementSize);
+        }
+    }
+}
+
+FISMInstanceDataColumn* FISMInstanceDataColumns::RegisterRaw(FName Name, int32 ElementSize, const void* DefaultValue)
+{
+    if (FISMInstanceDataColumn* Existing = FindRaw(Name))
+    {
+        if (Existing->ElementSize != ElementSize)
+        {
+            UE_LOG(LogISMRuntimeCore, Warning, TEXT("FISMInstanceDataColumns: Column '%s' already registered with element size %d (requested %d)"),
+                *Name.ToString(), Existing->ElementSize, ElementSize);
+            return nullptr;
+        }
+        return Existing;
+    }
+
+    FISMInstanceDataColumn& Column = Columns.AddDefaulted_GetRef();
+    Column.Name = Name;
+    Column.ElementSize = ElementSize;
+    Column.DefaultValue.SetNumUninitialized(ElementSize);
+    FMemory::Memcpy(Column.DefaultValue.GetData(), DefaultValue, ElementSize);
+
+    Column.Data.SetNumUninitialized(NumSlots * ElementSize);
+    FillDefaults(Column, 0, NumSlots);
+    return &Column;
+}
+
+bool FISMInstanceDataColumns::Unregister(FName Name)
+{
+    return Columns.RemoveAll([Name](const FISMInstanceDataColumn& Column) { return Column.Name == Name; }) > 0;
+}
+
+FISMInstanceDataColumn* FISMInstanceDataColumns::FindRaw(FName Name)
+{
+    return Columns.FindByPredicate([Name](const FISMInstanceDataColumn& Column) { return Column.Name == Name; });
+}
+
+const FISMInstanceDataColumn* FISMInstanceDataColumns::FindRaw(FName Name) const
+{
+    return Columns.FindByPredicate([Name](const FISMInstanceDataColumn& Column) { return Column.Name == Name; });
+}
+
+void FISMInstanceDataColumns::SetNumSlots(int32 InNumSlots)
+{
+    const int32 OldNumSlots = NumSlots;
+    NumSlots = FMath::Max(0, InNumSlots);
+
+    for (FISMInstanceDataColumn& Column : Columns)
+    {
+        Column.Data.SetNumUninitialized(NumSlots * Column.ElementSize, EAllowShrinking::No);
+        FillDefaults(Column, OldNumSlots, NumSlots);
+    }
+}
+
+void FISMInstanceDataColumns::ResetSlot(int32 InstanceIndex)
+{
+    if (InstanceIndex < 0)
+    {
+        return;
+    }
+
+    if (InstanceIndex >= NumSlots)
+    {
+        // Grows and fills the new tail, including InstanceIndex
+        SetNumSlots(InstanceIndex + 1);
+        return;
+    }
+
+    for (FISMInstanceDataColumn& Column : Columns)
+    {
+        FillDefaults(Column, InstanceIndex, InstanceIndex + 1);
+    }
+}
+
+void FISMInstanceDataColumns::ResetData()
+{
+    for (FISMInstanceDataColumn& Column : Columns)
+    {
+        Column.Data.Empty();
+    }
+    NumSlots = 0;
+}
+
+SIZE_T FISMInstanceDataColumns::GetAllocatedSize() const
+{
+    SIZE_T Size = Columns.GetAllocatedSize();
+    for (const FISMInstanceDataColumn& Column : Columns)
+    {
+        Size += Column.Data.GetAllocatedSize() + Column.DefaultValue.GetAllocatedSize();
+    }
+    return Size;
+}
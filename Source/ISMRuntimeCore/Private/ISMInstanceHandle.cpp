@@ -2,6 +2,7 @@
 #include "ISMInstanceHandle.h"
 
 #include "ISMRuntimeComponent.h"
+#include "ISMRuntimeProfiling.h"
 #include "Interfaces/ISMConvertible.h"
 #include "GameplayTagContainer.h"
 #include "GameFramework/Actor.h"
@@ -21,7 +22,13 @@
 
 bool FISMInstanceHandle::IsValid() const
 {
-    return Component.IsValid() && InstanceIndex != INDEX_NONE;
+    return Component.IsValid() && InstanceIndex != INDEX_NONE && !IsStale();
+}
+
+bool FISMInstanceHandle::IsStale() const
+{
+    const UISMRuntimeComponent* Comp = Component.Get();
+    return Comp && static_cast<uint32>(Generation) != Comp->GetInstanceGeneration(InstanceIndex);
 }
 
 bool FISMInstanceHandle::IsConvertedToActor() const
@@ -35,15 +42,13 @@ bool FISMInstanceHandle::IsConvertedToActor() const
         return false;
     }
     
-    const FISMInstanceState* InstanceState = Component->GetInstanceState(InstanceIndex);
-	
-    if (!InstanceState)
+    if (!Component->HasInstanceState(InstanceIndex))
     {
 		UE_LOG(LogISMRuntimeCore, Warning, TEXT("FISMInstanceHandle::IsConvertedToActor - Invalid instance state for index %d"), InstanceIndex);
         return false;
     }
 
-	return InstanceState->HasFlag(EISMInstanceState::Converting);
+	return Component->IsInstanceInState(InstanceIndex, EISMInstanceState::Converting);
 }
 
 AActor* FISMInstanceHandle::GetConvertedActor() const
@@ -99,7 +104,10 @@ FGameplayTagContainer FISMInstanceHandle::GetInstanceTags() const
 
 AActor* FISMInstanceHandle::ConvertToActor(const FISMConversionContext& ConversionContext)
 {
-  
+    ISM_TRACE_SCOPE(FISMInstanceHandle::ConvertToActor);
+    SCOPE_CYCLE_COUNTER(STAT_ISMConversion);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
     if (!IsValid())
     {
 		UE_LOG(LogISMRuntimeCore, Warning, TEXT("FISMInstanceHandle::ConvertToActor - Invalid instance handle"));
@@ -126,13 +134,12 @@ AActor* FISMInstanceHandle::ConvertToActor(const FISMConversionContext& Conversi
             return nullptr;
         };
 
-    const FISMInstanceState* InstanceState = Comp->GetInstanceState(InstanceIndex);
-    if (!InstanceState)
+    if (!Comp->HasInstanceState(InstanceIndex))
     {
 		return Fail(TEXT("Invalid instance state"));
     }
 
-	if (InstanceState->HasFlag(EISMInstanceState::Converting))
+	if (Comp->IsInstanceInState(InstanceIndex, EISMInstanceState::Converting))
     {
 		return Fail(TEXT("Instance is already converting"));
     }
@@ -155,6 +162,7 @@ AActor* FISMInstanceHandle::ConvertToActor(const FISMConversionContext& Conversi
     if (Actor)
     {
         SetConvertedActor(Actor, ActorCounter);
+        INC_DWORD_STAT(STAT_ISMInstancesConverted);
 
         // Resolve and apply pooled DMIs based on cached custom data
         // UISMCustomDataConversionSystem handles schema resolution and pool lookup
@@ -194,6 +202,7 @@ bool FISMInstanceHandle::ReturnToISM(bool bDestroyActor, bool bUpdateTransform)
     if (!Actor)
     {
         Comp->SetInstanceState(InstanceIndex, EISMInstanceState::Converting, false);
+        Comp->NotifyHandleConversionChanged(InstanceIndex, nullptr);
         Comp->ShowInstance(InstanceIndex);
         return Fail(TEXT("Converted Actor is null"));
     }
@@ -215,36 +224,7 @@ bool FISMInstanceHandle::ReturnToISM(bool bDestroyActor, bool bUpdateTransform)
     
 
     // Release the DMI reference in the shared pool (decrements ref count)
-    UWorld* World = Comp->GetWorld();
-    if (World)
-    {
-        UGameInstance* GI = World->GetGameInstance();
-        if (UISMCustomDataSubsystem* Sub = GI ? GI->GetSubsystem<UISMCustomDataSubsystem>() : nullptr)
-        {
-            FName SchemaName;
-            if (const FISMCustomDataSchema* Schema = Sub->ResolveSchemaForInstance(*this, SchemaName))
-            {
-                // Release per slot
-                const int32 NumSlots = Comp->ManagedISMComponent
-                    ? Comp->ManagedISMComponent->GetNumMaterials()
-                    : 1;
-
-                for (int32 SlotIdx = 0; SlotIdx < NumSlots; ++SlotIdx)
-                {
-                    if (!Schema->AppliesToSlot(SlotIdx)) { continue; }
-
-                    UMaterialInterface* Template = Comp->ManagedISMComponent
-                        ? Comp->ManagedISMComponent->GetMaterial(SlotIdx)
-                        : nullptr;
-
-                    if (Template)
-                    {
-                        Sub->ReleaseDMI(Template, GetCustomDataFromISM(), *Schema, SlotIdx);
-                    }
-                }
-            }
-        }
-    }
+    ReleaseCustomDataMaterials();
 
 
 
@@ -274,11 +254,55 @@ bool FISMInstanceHandle::ReturnToISM(bool bDestroyActor, bool bUpdateTransform)
         Actor->Destroy();
     }
     ConvertedActor.Reset();
+    Comp->NotifyHandleConversionChanged(InstanceIndex, nullptr);
 
 
     return true;
 }
 
+void FISMInstanceHandle::ReleaseCustomDataMaterials() const
+{
+    UISMRuntimeComponent* Comp = Component.Get();
+    UWorld* World = Comp ? Comp->GetWorld() : nullptr;
+    if (!World)
+    {
+        return;
+    }
+
+    UGameInstance* GI = World->GetGameInstance();
+    UISMCustomDataSubsystem* Sub = GI ? GI->GetSubsystem<UISMCustomDataSubsystem>() : nullptr;
+    if (!Sub)
+    {
+        return;
+    }
+
+    FName SchemaName;
+    const FISMCustomDataSchema* Schema = Sub->ResolveSchemaForInstance(*this, SchemaName);
+    if (!Schema)
+    {
+        return;
+    }
+
+    // Release per slot
+    const int32 NumSlots = Comp->ManagedISMComponent
+        ? Comp->ManagedISMComponent->GetNumMaterials()
+        : 1;
+
+    for (int32 SlotIdx = 0; SlotIdx < NumSlots; ++SlotIdx)
+    {
+        if (!Schema->AppliesToSlot(SlotIdx)) { continue; }
+
+        UMaterialInterface* Template = Comp->ManagedISMComponent
+            ? Comp->ManagedISMComponent->GetMaterial(SlotIdx)
+            : nullptr;
+
+        if (Template)
+        {
+            Sub->ReleaseDMI(Template, GetCustomDataFromISM(), *Schema, SlotIdx);
+        }
+    }
+}
+
 void FISMInstanceHandle::SetConvertedActor(AActor* Actor, int32 counter)
 {
     if (!Actor)
@@ -287,6 +311,7 @@ void FISMInstanceHandle::SetConvertedActor(AActor* Actor, int32 counter)
 
     if (UISMRuntimeComponent* Comp = Component.Get())
     {
+        Comp->NotifyHandleConversionChanged(InstanceIndex, Actor, counter);
         Comp->AddInstanceTag(InstanceIndex,
             FGameplayTag::RequestGameplayTag(FName("ISM.State.Converted")));
 
@@ -304,6 +329,7 @@ void FISMInstanceHandle::ClearConvertedActor()
 
     if (UISMRuntimeComponent* Comp = Component.Get())
     {
+        Comp->NotifyHandleConversionChanged(InstanceIndex, nullptr);
         Comp->RemoveInstanceTag(InstanceIndex,
             FGameplayTag::RequestGameplayTag(FName("ISM.State.Converted")));
     }
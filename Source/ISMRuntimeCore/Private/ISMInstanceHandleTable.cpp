@@ -0,0 +1,91 @@
+// ISMInstanceHandleTable.cpp
+#include "ISMInstanceHandleTable.h"
+
+FISMInstanceHandle& FISMInstanceHandleTable::FindOrAdd(int32 InstanceIndex, bool& bOutAdded)
+{
+    check(InstanceIndex >= 0);
+
+    const int32 Existing = GetSlot(InstanceIndex);
+    bOutAdded = Existing == INDEX_NONE;
+    if (!bOutAdded)
+    {
+        return Handles[Existing];
+    }
+
+    if (InstanceIndex >= Slots.Num())
+    {
+        const int32 OldNum = Slots.Num();
+        Slots.SetNumUninitialized(InstanceIndex + 1);
+        for (int32 i = OldNum; i < Slots.Num(); i++)
+        {
+            Slots[i] = INDEX_NONE;
+        }
+    }
+
+    const int32 Slot = Handles.AddDefaulted();
+    ConvertedPositions.Add(INDEX_NONE);
+    Slots[InstanceIndex] = Slot;
+    return Handles[Slot];
+}
+
+void FISMInstanceHandleTable::Remove(int32 InstanceIndex)
+{
+    const int32 Slot = GetSlot(InstanceIndex);
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    SetConverted(InstanceIndex, false);
+
+    // Last handle fills the hole
+    const int32 LastSlot = Handles.Num() - 1;
+    if (Slot != LastSlot)
+    {
+        const int32 MovedIndex = Handles[LastSlot].InstanceIndex;
+        Handles[Slot] = MoveTemp(Handles[LastSlot]);
+        ConvertedPositions[Slot] = ConvertedPositions[LastSlot];
+        Slots[MovedIndex] = Slot;
+    }
+    Handles.Pop(EAllowShrinking::No);
+    ConvertedPositions.Pop(EAllowShrinking::No);
+    Slots[InstanceIndex] = INDEX_NONE;
+}
+
+void FISMInstanceHandleTable::Empty()
+{
+    Handles.Empty();
+    Slots.Empty();
+    ConvertedPositions.Empty();
+    ConvertedInstances.Empty();
+}
+
+void FISMInstanceHandleTable::SetConverted(int32 InstanceIndex, bool bConverted)
+{
+    const int32 Slot = GetSlot(InstanceIndex);
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    const int32 Position = ConvertedPositions[Slot];
+    if (bConverted == (Position != INDEX_NONE))
+    {
+        return;
+    }
+
+    if (bConverted)
+    {
+        ConvertedPositions[Slot] = ConvertedInstances.Add(InstanceIndex);
+        return;
+    }
+
+    // Last converted entry fills the hole
+    const int32 LastIndex = ConvertedInstances.Last();
+    ConvertedInstances.RemoveAtSwap(Position, 1, EAllowShrinking::No);
+    if (LastIndex != InstanceIndex)
+    {
+        ConvertedPositions[Slots[LastIndex]] = Position;
+    }
+    ConvertedPositions[Slot] = INDEX_NONE;
+}
@@ -3,6 +3,7 @@
 
 #include "ISMRuntimeComponent.h"
 #include "ISMInstanceState.h"
+#include "Async/ParallelFor.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogISMIndex, Log, All);
 
@@ -12,7 +13,22 @@ DEFINE_LOG_CATEGORY_STATIC(LogISMIndex, Log, All);
 
 UISMInstanceIndex::UISMInstanceIndex()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Only ticks while deferred changes are waiting
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UISMInstanceIndex::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    FlushPendingChanges();
+    ProcessPendingBuilds(BuildTimeSliceMs);
+    if (PendingBuilds.IsEmpty())
+    {
+        SetComponentTickEnabled(false);
+    }
 }
 
 // ============================================================
@@ -28,13 +44,46 @@ void UISMInstanceIndex::RegisterWithComponent(UISMRuntimeComponent* Component)
         return;
     }
 
+    if (!BindComponent(Component)) return;
+    QueueBuilds(MakeArrayView(&Component, 1));
+
+    UE_LOG(LogISMIndex, Verbose,
+        TEXT("UISMInstanceIndex: registered with %s (%d existing instances)"),
+        *Component->GetName(), Component->GetInstanceCount());
+}
+
+void UISMInstanceIndex::RegisterWithComponents(const TArray<UISMRuntimeComponent*>& Components)
+{
+    TArray<UISMRuntimeComponent*> Bound;
+    Bound.Reserve(Components.Num());
+    for (UISMRuntimeComponent* Component : Components)
+    {
+        if (BindComponent(Component))
+        {
+            Bound.Add(Component);
+        }
+    }
+    QueueBuilds(Bound);
+
+    UE_LOG(LogISMIndex, Verbose,
+        TEXT("UISMInstanceIndex: registered with %d components"), Bound.Num());
+}
+
+bool UISMInstanceIndex::BindComponent(UISMRuntimeComponent* Component)
+{
+    if (!Component) return false;
+
     // Avoid double registration
     for (const TWeakObjectPtr<UISMRuntimeComponent>& Existing : RegisteredComponents)
     {
-        if (Existing.Get() == Component) return;
+        if (Existing.Get() == Component) return false;
     }
 
     RegisteredComponents.Add(Component);
+    if (bUseDenseIds)
+    {
+        FindOrAddDenseSlot(Component);
+    }
 
     // Subscribe to all relevant delegates
     FComponentDelegateHandles Handles;
@@ -45,14 +94,13 @@ void UISMInstanceIndex::RegisterWithComponent(UISMRuntimeComponent* Component)
     Handles.Destroyed = Component->OnInstanceDestroyedNative.AddUObject(
         this, &UISMInstanceIndex::HandleDestroyed);
 
-    Handles.TagChanged = Component->OnInstanceTagsChangedNative.AddLambda(
-        [this](UISMRuntimeComponent* Comp, int32 Idx)
-        {
-            HandleTagChanged(Comp, Idx);
-        });
+    Handles.TagChanged = Component->OnInstanceTagsChangedNative.AddUObject(
+        this, &UISMInstanceIndex::HandleTagChanged);
+
+    // Batch calls report here instead of through the per-instance events above
+    Handles.BatchChanged = Component->OnInstancesChangedBatchNative.AddUObject(
+        this, &UISMInstanceIndex::HandleInstancesChangedBatch);
 
-    // Ownership/possession/attachment — only bind if the component exposes them
-    // These are native multicast delegates on the component
     Handles.OwnershipChanged = Component->OnInstanceOwnerChangedNative.AddUObject(
         this, &UISMInstanceIndex::HandleOwnershipChanged);
 
@@ -63,35 +111,22 @@ void UISMInstanceIndex::RegisterWithComponent(UISMRuntimeComponent* Component)
         this, &UISMInstanceIndex::HandleAttachmentChanged);
 
     DelegateHandles.Add(Component, Handles);
-
-    // Build initial index from existing instances
-    const int32 Count = Component->GetInstanceCount();
-    for (int32 i = 0; i < Count; ++i)
-    {
-        if (!Component->IsInstanceDestroyed(i))
-        {
-            IndexHandle(Component, i);
-        }
-    }
-
-    UE_LOG(LogISMIndex, Verbose,
-        TEXT("UISMInstanceIndex: registered with %s (%d existing instances indexed)"),
-        *Component->GetName(), Count);
+    return true;
 }
 
 void UISMInstanceIndex::UnregisterFromComponent(UISMRuntimeComponent* Component)
 {
     if (!Component) return;
 
+    PendingBuilds.Remove(Component);
+
     // Unbind delegates
     if (FComponentDelegateHandles* Handles = DelegateHandles.Find(Component))
     {
         Component->OnInstanceStateChangedNative.Remove(Handles->StateChanged);
         Component->OnInstanceDestroyedNative.Remove(Handles->Destroyed);
-        // Tag/ownership delegates are dynamic — remove via handle not supported
-        // on DECLARE_DYNAMIC_MULTICAST_DELEGATE, so we remove the lambda-bound ones
-        // by clearing the entire delegate if it was the only subscriber, or accept
-        // slight overhead. For production, migrate to native delegates for all events.
+        Component->OnInstanceTagsChangedNative.Remove(Handles->TagChanged);
+        Component->OnInstancesChangedBatchNative.Remove(Handles->BatchChanged);
         Component->OnInstanceOwnerChangedNative.Remove(Handles->OwnershipChanged);
         Component->OnInstancePossessionChangedNative.Remove(Handles->PossessionChanged);
         Component->OnInstanceAttachmentChangedNative.Remove(Handles->AttachmentChanged);
@@ -104,6 +139,25 @@ void UISMInstanceIndex::UnregisterFromComponent(UISMRuntimeComponent* Component)
         return Ptr.Get() == Component;
     });
 
+    FPendingChanges Pending;
+    if (PendingChanges.RemoveAndCopyValue(Component, Pending))
+    {
+        NumPendingChanges -= Pending.Dirty.CountSetBits();
+    }
+
+    if (bUseDenseIds)
+    {
+        int32 Slot = INDEX_NONE;
+        if (DenseSlotByComponent.RemoveAndCopyValue(Component, Slot))
+        {
+            ClearDenseSlot(Slot);
+            DenseSlotComponents[Slot] = nullptr;
+            DenseFreeSlots.Add(Slot);
+        }
+        RefreshViews();
+        return;
+    }
+
     // Remove all handles that belonged to this component
     for (auto It = HandleToKeys.CreateIterator(); It; ++It)
     {
@@ -121,6 +175,7 @@ void UISMInstanceIndex::UnregisterFromComponent(UISMRuntimeComponent* Component)
             It.RemoveCurrent();
         }
     }
+    RefreshViews();
 }
 
 void UISMInstanceIndex::UnregisterAll()
@@ -139,6 +194,35 @@ void UISMInstanceIndex::UnregisterAll()
     }
     Index.Reset();
     HandleToKeys.Reset();
+    ResetDenseStorage();
+    ClearPendingChanges();
+    PendingBuilds.Reset();
+    RefreshViews();
+}
+
+void UISMInstanceIndex::SetUseDenseIds(bool bEnable)
+{
+    if (bUseDenseIds == bEnable) return;
+
+    bUseDenseIds = bEnable;
+    RebuildIndex();
+}
+
+void UISMInstanceIndex::GetDenseIdsForTag(FGameplayTag Key, TArray<uint64>& OutIds) const
+{
+    ReconcilePendingChanges();
+    OutIds.Reset();
+    const FDenseKeySet* Set = DenseIndex.Find(Key);
+    if (!Set) return;
+
+    OutIds.Reserve(Set->Num);
+    for (int32 Slot = 0; Slot < Set->SlotBits.Num(); ++Slot)
+    {
+        for (TConstSetBitIterator<> It(Set->SlotBits[Slot]); It; ++It)
+        {
+            OutIds.Add((static_cast<uint64>(Slot) << 32) | static_cast<uint32>(It.GetIndex()));
+        }
+    }
 }
 
 // ============================================================
@@ -147,9 +231,24 @@ void UISMInstanceIndex::UnregisterAll()
 
 TArray<FISMInstanceHandle> UISMInstanceIndex::GetHandlesForTag(FGameplayTag Key) const
 {
+    ReconcilePendingChanges();
+    if (bUseDenseIds)
+    {
+        TArray<FISMInstanceHandle> Result;
+        if (const FDenseKeySet* Set = DenseIndex.Find(Key))
+        {
+            const TPair<const UISMInstanceIndex*, const FDenseKeySet*> Only(this, Set);
+            IntersectDense(MakeArrayView(&Only, 1), Result);
+        }
+        SortHandles(Result, ResultOrder);
+        return Result;
+    }
+
     if (const TSet<FISMInstanceHandle>* Set = Index.Find(Key))
     {
-        return Set->Array();
+        TArray<FISMInstanceHandle> Result = Set->Array();
+        SortHandles(Result, ResultOrder);
+        return Result;
     }
     return {};
 }
@@ -157,8 +256,29 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::GetHandlesForTag(FGameplayTag Key)
 TArray<FISMInstanceHandle> UISMInstanceIndex::GetHandlesForAllTags(
     const FGameplayTagContainer& Keys) const
 {
+    ReconcilePendingChanges();
     if (Keys.IsEmpty()) return {};
 
+    if (bUseDenseIds)
+    {
+        TArray<TPair<const UISMInstanceIndex*, const FDenseKeySet*>> DenseSets;
+        for (const FGameplayTag& Key : Keys)
+        {
+            const FDenseKeySet* Set = DenseIndex.Find(Key);
+            if (!Set) return {};
+            DenseSets.Add({ this, Set });
+        }
+        DenseSets.Sort([](const TPair<const UISMInstanceIndex*, const FDenseKeySet*>& A, const TPair<const UISMInstanceIndex*, const FDenseKeySet*>& B)
+        {
+            return A.Value->Num < B.Value->Num;
+        });
+
+        TArray<FISMInstanceHandle> Result;
+        IntersectDense(DenseSets, Result);
+        SortHandles(Result, ResultOrder);
+        return Result;
+    }
+
     // Collect the TSet pointers, sort ascending by size
     TArray<const TSet<FISMInstanceHandle>*> Sets;
     for (const FGameplayTag& Key : Keys)
@@ -194,12 +314,44 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::GetHandlesForAllTags(
         }
         if (bInAll) Result.Add(Handle);
     }
+    SortHandles(Result, ResultOrder);
     return Result;
 }
 
 TArray<FISMInstanceHandle> UISMInstanceIndex::GetHandlesForAnyTag(
     const FGameplayTagContainer& Keys) const
 {
+    ReconcilePendingChanges();
+    if (bUseDenseIds)
+    {
+        // OR per component slot, so a handle under several keys comes out once
+        TArray<TBitArray<>> Union;
+        for (const FGameplayTag& Key : Keys)
+        {
+            const FDenseKeySet* Set = DenseIndex.Find(Key);
+            if (!Set) continue;
+
+            if (Union.Num() < Set->SlotBits.Num()) Union.SetNum(Set->SlotBits.Num());
+            for (int32 Slot = 0; Slot < Set->SlotBits.Num(); ++Slot)
+            {
+                Union[Slot].CombineWithBitwiseOR(Set->SlotBits[Slot], EBitwiseOperatorFlags::MaxSize);
+            }
+        }
+
+        TArray<FISMInstanceHandle> Result;
+        for (int32 Slot = 0; Slot < Union.Num(); ++Slot)
+        {
+            UISMRuntimeComponent* Comp = GetDenseSlotComponent(Slot);
+            if (!Comp) continue;
+            for (TConstSetBitIterator<> It(Union[Slot]); It; ++It)
+            {
+                Result.Add(Comp->GetInstanceHandle(It.GetIndex()));
+            }
+        }
+        SortHandles(Result, ResultOrder);
+        return Result;
+    }
+
     TSet<FISMInstanceHandle> Union;
     for (const FGameplayTag& Key : Keys)
     {
@@ -208,12 +360,74 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::GetHandlesForAnyTag(
             Union.Append(*Set);
         }
     }
-    return Union.Array();
+    TArray<FISMInstanceHandle> Result = Union.Array();
+    SortHandles(Result, ResultOrder);
+    return Result;
+}
+
+void UISMInstanceIndex::SortHandles(TArray<FISMInstanceHandle>& Handles, EISMIndexResultOrder Order)
+{
+    if (Order == EISMIndexResultOrder::Unordered || Handles.Num() < 2) return;
+
+    // Keys are computed once per handle; the spatial key costs a position lookup
+    struct FSortEntry
+    {
+        uint32 ComponentId;
+        uint64 CellCode;
+        FISMInstanceHandle Handle;
+    };
+
+    TArray<FSortEntry> Entries;
+    Entries.Reserve(Handles.Num());
+    for (const FISMInstanceHandle& Handle : Handles)
+    {
+        const UISMRuntimeComponent* Comp = Handle.Component.Get();
+        uint64 CellCode = 0;
+        if (Comp && Order == EISMIndexResultOrder::BySpatialCell)
+        {
+            const FISMSpatialIndex& Spatial = Comp->GetSpatialIndex();
+            FVector Position;
+            if (Spatial.GetInstancePosition(Handle.InstanceIndex, Position))
+            {
+                // Bias into the 21-bit unsigned range per axis Morton codes take
+                const FIntVector Cell = Spatial.WorldLocationToCell(Position) + FIntVector(1 << 20);
+                CellCode = FISMSpatialIndex::EncodeMorton3D(
+                    static_cast<uint32>(Cell.X), static_cast<uint32>(Cell.Y), static_cast<uint32>(Cell.Z));
+            }
+        }
+        Entries.Add({ Comp ? Comp->GetUniqueID() : 0u, CellCode, Handle });
+    }
+
+    Entries.Sort([](const FSortEntry& A, const FSortEntry& B)
+    {
+        if (A.ComponentId != B.ComponentId) return A.ComponentId < B.ComponentId;
+        if (A.CellCode != B.CellCode) return A.CellCode < B.CellCode;
+        return A.Handle.InstanceIndex < B.Handle.InstanceIndex;
+    });
+
+    for (int32 i = 0; i < Entries.Num(); ++i)
+    {
+        Handles[i] = Entries[i].Handle;
+    }
 }
 
 bool UISMInstanceIndex::IsHandleIndexed(FGameplayTag Key,
     const FISMInstanceHandle& Handle) const
 {
+    ReconcilePendingChanges();
+    return ContainsHandle(Key, Handle);
+}
+
+bool UISMInstanceIndex::ContainsHandle(FGameplayTag Key, const FISMInstanceHandle& Handle) const
+{
+    if (bUseDenseIds)
+    {
+        const UISMRuntimeComponent* Comp = Handle.Component.Get();
+        const TBitArray<>* Bits = FindDenseBits(Key, Comp);
+        return Bits && Bits->IsValidIndex(Handle.InstanceIndex) && (*Bits)[Handle.InstanceIndex] &&
+            Handle.Generation == static_cast<int32>(Comp->GetInstanceGeneration(Handle.InstanceIndex));
+    }
+
     if (const TSet<FISMInstanceHandle>* Set = Index.Find(Key))
     {
         return Set->Contains(Handle);
@@ -223,6 +437,13 @@ bool UISMInstanceIndex::IsHandleIndexed(FGameplayTag Key,
 
 int32 UISMInstanceIndex::GetCountForTag(FGameplayTag Key) const
 {
+    ReconcilePendingChanges();
+    if (bUseDenseIds)
+    {
+        const FDenseKeySet* Set = DenseIndex.Find(Key);
+        return Set ? Set->Num : 0;
+    }
+
     if (const TSet<FISMInstanceHandle>* Set = Index.Find(Key))
     {
         return Set->Num();
@@ -232,16 +453,78 @@ int32 UISMInstanceIndex::GetCountForTag(FGameplayTag Key) const
 
 TArray<FGameplayTag> UISMInstanceIndex::GetActiveKeys() const
 {
+    ReconcilePendingChanges();
     TArray<FGameplayTag> Keys;
+    if (bUseDenseIds)
+    {
+        DenseIndex.GetKeys(Keys);
+        return Keys;
+    }
     Index.GetKeys(Keys);
     return Keys;
 }
 
 int32 UISMInstanceIndex::GetTotalIndexedCount() const
 {
+    ReconcilePendingChanges();
+    if (bUseDenseIds)
+    {
+        int32 Total = 0;
+        TBitArray<> Any;
+        for (int32 Slot = 0; Slot < DenseSlotComponents.Num(); ++Slot)
+        {
+            Any.Reset();
+            for (const TPair<FGameplayTag, FDenseKeySet>& Pair : DenseIndex)
+            {
+                if (Pair.Value.SlotBits.IsValidIndex(Slot))
+                    Any.CombineWithBitwiseOR(Pair.Value.SlotBits[Slot], EBitwiseOperatorFlags::MaxSize);
+            }
+            Total += Any.CountSetBits();
+        }
+        return Total;
+    }
+
     return HandleToKeys.Num();
 }
 
+SIZE_T UISMInstanceIndex::GetAllocatedSize() const
+{
+    SIZE_T Size = Index.GetAllocatedSize() + HandleToKeys.GetAllocatedSize();
+    for (const TPair<FGameplayTag, TSet<FISMInstanceHandle>>& Pair : Index)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+    for (const TPair<FISMInstanceHandle, TSet<FGameplayTag>>& Pair : HandleToKeys)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+
+    Size += DenseIndex.GetAllocatedSize();
+    for (const TPair<FGameplayTag, FDenseKeySet>& Pair : DenseIndex)
+    {
+        Size += Pair.Value.SlotBits.GetAllocatedSize();
+        for (const TBitArray<>& Bits : Pair.Value.SlotBits)
+        {
+            Size += Bits.GetAllocatedSize();
+        }
+    }
+    Size += DenseSlotComponents.GetAllocatedSize() + DenseSlotByComponent.GetAllocatedSize() + DenseFreeSlots.GetAllocatedSize();
+
+    Size += ViewsByKey.GetAllocatedSize();
+    for (const auto& Pair : ViewsByKey)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+
+    Size += RegisteredComponents.GetAllocatedSize() + DelegateHandles.GetAllocatedSize()
+        + PendingBuilds.GetAllocatedSize() + KeyBuffer.GetAllocatedSize() + PendingChanges.GetAllocatedSize();
+    for (const auto& Pair : PendingChanges)
+    {
+        Size += Pair.Value.Dirty.GetAllocatedSize() + Pair.Value.Removed.GetAllocatedSize();
+    }
+    return Size;
+}
+
 // ============================================================
 //  Spatial Intersection
 // ============================================================
@@ -251,6 +534,24 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::IntersectWithSpatial(
     const TArray<int32>& SpatialCandidates,
     UISMRuntimeComponent* Component) const
 {
+    ReconcilePendingChanges();
+
+    if (bUseDenseIds)
+    {
+        const TBitArray<>* Bits = FindDenseBits(Key, Component);
+        if (!Bits || SpatialCandidates.IsEmpty()) return {};
+
+        TArray<FISMInstanceHandle> Result;
+        for (int32 InstanceIndex : SpatialCandidates)
+        {
+            if (Bits->IsValidIndex(InstanceIndex) && (*Bits)[InstanceIndex])
+            {
+                Result.Add(Component->GetInstanceHandle(InstanceIndex));
+            }
+        }
+        return Result;
+    }
+
     const TSet<FISMInstanceHandle>* Set = Index.Find(Key);
     if (!Set || Set->IsEmpty() || SpatialCandidates.IsEmpty())
     {
@@ -280,6 +581,16 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::Intersect(
     const UISMInstanceIndex* IndexB, FGameplayTag KeyB)
 {
     if (!IndexA || !IndexB) return {};
+    IndexA->ReconcilePendingChanges();
+    IndexB->ReconcilePendingChanges();
+
+    if (IndexA->bUseDenseIds || IndexB->bUseDenseIds)
+    {
+        TArray<FISMIndexQuery> Queries;
+        Queries.Emplace(const_cast<UISMInstanceIndex*>(IndexA), KeyA);
+        Queries.Emplace(const_cast<UISMInstanceIndex*>(IndexB), KeyB);
+        return IntersectAll(Queries);
+    }
 
     const TSet<FISMInstanceHandle>* SetA = IndexA->GetSetForKey(KeyA);
     const TSet<FISMInstanceHandle>* SetB = IndexB->GetSetForKey(KeyB);
@@ -306,6 +617,41 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::IntersectAll(
 {
     if (Queries.IsEmpty()) return {};
 
+    bool bAllDense = true;
+    bool bAnyDense = false;
+    for (const FISMIndexQuery& Q : Queries)
+    {
+        if (!Q.Index) continue;
+        Q.Index->ReconcilePendingChanges();
+        bAllDense &= Q.Index->bUseDenseIds;
+        bAnyDense |= Q.Index->bUseDenseIds;
+    }
+
+    if (bAnyDense && !bAllDense)
+    {
+        return IntersectByProbing(Queries);
+    }
+
+    if (bAnyDense)
+    {
+        TArray<TPair<const UISMInstanceIndex*, const FDenseKeySet*>> DenseSets;
+        for (const FISMIndexQuery& Q : Queries)
+        {
+            if (!Q.Index) continue;
+            const FDenseKeySet* Set = Q.Index->DenseIndex.Find(Q.Key);
+            if (!Set) return {};
+            DenseSets.Add({ Q.Index, Set });
+        }
+        DenseSets.Sort([](const TPair<const UISMInstanceIndex*, const FDenseKeySet*>& A, const TPair<const UISMInstanceIndex*, const FDenseKeySet*>& B)
+        {
+            return A.Value->Num < B.Value->Num;
+        });
+
+        TArray<FISMInstanceHandle> Result;
+        IntersectDense(DenseSets, Result);
+        return Result;
+    }
+
     // Gather valid set pointers paired with their sizes for sorting
     TArray<TPair<const TSet<FISMInstanceHandle>*, int32>> Sets;
     for (const FISMIndexQuery& Q : Queries)
@@ -353,11 +699,20 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::IntersectSpatialWithIndexes(
 {
     if (SpatialCandidates.IsEmpty() || !Component) return {};
 
-    // Gather index sets, bail early if any is empty
+    // Gather index sets, bail early if any is empty. Dense indexes resolve to the component's bits.
     TArray<const TSet<FISMInstanceHandle>*> Sets;
+    TArray<const TBitArray<>*> DenseBits;
     for (const FISMIndexQuery& Q : Queries)
     {
         if (!Q.Index) continue;
+        Q.Index->ReconcilePendingChanges();
+        if (Q.Index->bUseDenseIds)
+        {
+            const TBitArray<>* Bits = Q.Index->FindDenseBits(Q.Key, Component);
+            if (!Bits) return {};
+            DenseBits.Add(Bits);
+            continue;
+        }
         const TSet<FISMInstanceHandle>* Set = Q.Index->GetSetForKey(Q.Key);
         if (!Set || Set->IsEmpty()) return {};
         Sets.Add(Set);
@@ -367,10 +722,20 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::IntersectSpatialWithIndexes(
     TArray<FISMInstanceHandle> Result;
     for (int32 InstanceIndex : SpatialCandidates)
     {
+        bool bPassesAll = true;
+        for (const TBitArray<>* Bits : DenseBits)
+        {
+            if (!Bits->IsValidIndex(InstanceIndex) || !(*Bits)[InstanceIndex])
+            {
+                bPassesAll = false;
+                break;
+            }
+        }
+        if (!bPassesAll) continue;
+
         FISMInstanceHandle Candidate = Component->GetInstanceHandle(InstanceIndex);
         if (!Candidate.IsValid()) continue;
 
-        bool bPassesAll = true;
         for (const TSet<FISMInstanceHandle>* Set : Sets)
         {
             if (!Set->Contains(Candidate))
@@ -385,18 +750,266 @@ TArray<FISMInstanceHandle> UISMInstanceIndex::IntersectSpatialWithIndexes(
 }
 
 // ============================================================
-//  Maintenance
+//  Intersection Views
 // ============================================================
 
-void UISMInstanceIndex::RebuildIndex()
+TSharedRef<FISMIndexIntersectionView> UISMInstanceIndex::CreateIntersectionView(const TArray<FISMIndexQuery>& Queries)
 {
-    Index.Reset();
-    HandleToKeys.Reset();
+    TSharedRef<FISMIndexIntersectionView> View = MakeShared<FISMIndexIntersectionView>();
+    for (const FISMIndexQuery& Q : Queries)
+    {
+        if (!Q.Index) continue;
+        View->Queries.Add({ Q.Index, Q.Key });
 
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : RegisteredComponents)
+        TArray<TWeakPtr<FISMIndexIntersectionView>>& KeyViews = Q.Index->ViewsByKey.FindOrAdd(Q.Key);
+        KeyViews.AddUnique(View);
+    }
+    View->Recompute();
+    return View;
+}
+
+void UISMInstanceIndex::NotifyViewsAdded(FGameplayTag Key, const FISMInstanceHandle& Handle)
+{
+    TArray<TWeakPtr<FISMIndexIntersectionView>>* KeyViews = ViewsByKey.Find(Key);
+    if (!KeyViews) return;
+
+    for (int32 i = KeyViews->Num() - 1; i >= 0; --i)
     {
-        UISMRuntimeComponent* Comp = CompPtr.Get();
-        if (!Comp) continue;
+        const TSharedPtr<FISMIndexIntersectionView> View = (*KeyViews)[i].Pin();
+        if (!View)
+        {
+            KeyViews->RemoveAtSwap(i, 1, EAllowShrinking::No);
+            continue;
+        }
+        if (View->PassesAll(Handle))
+        {
+            View->Handles.Add(Handle);
+        }
+    }
+    if (KeyViews->IsEmpty()) ViewsByKey.Remove(Key);
+}
+
+void UISMInstanceIndex::NotifyViewsRemoved(FGameplayTag Key, const FISMInstanceHandle& Handle)
+{
+    TArray<TWeakPtr<FISMIndexIntersectionView>>* KeyViews = ViewsByKey.Find(Key);
+    if (!KeyViews) return;
+
+    for (int32 i = KeyViews->Num() - 1; i >= 0; --i)
+    {
+        const TSharedPtr<FISMIndexIntersectionView> View = (*KeyViews)[i].Pin();
+        if (!View)
+        {
+            KeyViews->RemoveAtSwap(i, 1, EAllowShrinking::No);
+            continue;
+        }
+        View->Handles.Remove(Handle);
+    }
+    if (KeyViews->IsEmpty()) ViewsByKey.Remove(Key);
+}
+
+void UISMInstanceIndex::RefreshViews()
+{
+    if (ViewsByKey.IsEmpty()) return;
+
+    // A view reading several keys of this index is listed once per key
+    TSet<FISMIndexIntersectionView*> Refreshed;
+    for (auto It = ViewsByKey.CreateIterator(); It; ++It)
+    {
+        TArray<TWeakPtr<FISMIndexIntersectionView>>& KeyViews = It.Value();
+        for (int32 i = KeyViews.Num() - 1; i >= 0; --i)
+        {
+            const TSharedPtr<FISMIndexIntersectionView> View = KeyViews[i].Pin();
+            if (!View)
+            {
+                KeyViews.RemoveAtSwap(i, 1, EAllowShrinking::No);
+                continue;
+            }
+
+            bool bAlreadyRefreshed = false;
+            Refreshed.Add(View.Get(), &bAlreadyRefreshed);
+            if (!bAlreadyRefreshed)
+            {
+                View->Recompute();
+            }
+        }
+        if (KeyViews.IsEmpty()) It.RemoveCurrent();
+    }
+}
+
+const FISMIndexViewSet& FISMIndexIntersectionView::GetHandles() const
+{
+    static const FISMIndexViewSet Empty;
+    if (!IsValid())
+    {
+        return Empty;
+    }
+
+    for (const FViewQuery& Q : Queries)
+    {
+        Q.Index->ReconcilePendingChanges();
+    }
+    return Handles;
+}
+
+bool FISMIndexIntersectionView::IsValid() const
+{
+    for (const FViewQuery& Q : Queries)
+    {
+        if (!Q.Index.IsValid()) return false;
+    }
+    return true;
+}
+
+bool FISMIndexIntersectionView::PassesAll(const FISMInstanceHandle& Handle) const
+{
+    for (const FViewQuery& Q : Queries)
+    {
+        const UISMInstanceIndex* QueryIndex = Q.Index.Get();
+        if (!QueryIndex || !QueryIndex->ContainsHandle(Q.Key, Handle)) return false;
+    }
+    return true;
+}
+
+void FISMIndexIntersectionView::Recompute()
+{
+    Handles.Reset();
+
+    TArray<FISMIndexQuery> Resolved;
+    for (const FViewQuery& Q : Queries)
+    {
+        UISMInstanceIndex* QueryIndex = Q.Index.Get();
+        if (!QueryIndex) return;
+        Resolved.Emplace(QueryIndex, Q.Key);
+    }
+
+    for (const FISMInstanceHandle& Handle : UISMInstanceIndex::IntersectAll(Resolved))
+    {
+        Handles.Add(Handle);
+    }
+}
+
+// ============================================================
+//  Bulk Build
+// ============================================================
+
+void UISMInstanceIndex::CompletePendingBuilds()
+{
+    ProcessPendingBuilds(0.0f);
+}
+
+void UISMInstanceIndex::QueueBuilds(TArrayView<UISMRuntimeComponent* const> Components)
+{
+    if (Components.IsEmpty()) return;
+
+    if (BuildTimeSliceMs <= 0.0f || !IsRegistered())
+    {
+        BuildComponents(Components);
+        return;
+    }
+
+    for (UISMRuntimeComponent* Component : Components)
+    {
+        PendingBuilds.AddUnique(Component);
+    }
+    SetComponentTickEnabled(true);
+}
+
+void UISMInstanceIndex::ProcessPendingBuilds(float BudgetMs)
+{
+    if (PendingBuilds.IsEmpty()) return;
+
+    // Without a budget everything goes through one parallel gather
+    const int32 ChunkSize = BudgetMs > 0.0f
+        ? (bParallelBuild ? FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads()) : 1)
+        : PendingBuilds.Num();
+    const double EndTime = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+
+    TArray<UISMRuntimeComponent*> Chunk;
+    while (PendingBuilds.Num() > 0)
+    {
+        Chunk.Reset();
+        const int32 Take = FMath::Min(ChunkSize, PendingBuilds.Num());
+        for (int32 i = 0; i < Take; ++i)
+        {
+            if (UISMRuntimeComponent* Comp = PendingBuilds[i].Get())
+            {
+                Chunk.Add(Comp);
+            }
+        }
+        PendingBuilds.RemoveAt(0, Take, EAllowShrinking::No);
+
+        BuildComponents(Chunk);
+
+        if (BudgetMs > 0.0f && FPlatformTime::Seconds() >= EndTime) break;
+    }
+}
+
+void UISMInstanceIndex::BuildComponents(TArrayView<UISMRuntimeComponent* const> Components)
+{
+    TArray<FComponentBuild> Builds;
+    Builds.SetNum(Components.Num());
+    for (int32 i = 0; i < Components.Num(); ++i)
+    {
+        Builds[i].Component = Components[i];
+    }
+
+    // Each task owns one component, so GatherKeys never sees a component another task is reading
+    ParallelFor(Builds.Num(), [this, &Builds](int32 BuildIdx)
+    {
+        GatherComponent(Builds[BuildIdx]);
+    }, (bParallelBuild && Builds.Num() > 1) ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    for (FComponentBuild& Build : Builds)
+    {
+        MergeComponentBuild(Build);
+    }
+    RefreshViews();
+}
+
+void UISMInstanceIndex::GatherComponent(FComponentBuild& Build) const
+{
+    UISMRuntimeComponent* Comp = Build.Component;
+    if (!Comp) return;
+
+    TArray<FGameplayTag> Keys;
+    const int32 Count = Comp->GetInstanceCount();
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (Comp->IsInstanceDestroyed(i)) continue;
+
+        const FISMInstanceHandle Handle = Comp->GetInstanceHandle(i);
+        if (!Handle.IsValid()) continue;
+
+        Keys.Reset();
+        if (!GatherKeys(Handle, Keys))
+        {
+            Build.HandlesByKey.Reset();
+            return;
+        }
+
+        ++Build.NumLive;
+        for (const FGameplayTag& Key : Keys)
+        {
+            if (Key.IsValid())
+            {
+                Build.HandlesByKey.FindOrAdd(Key).Add(Handle);
+            }
+        }
+    }
+    Build.bGathered = true;
+}
+
+void UISMInstanceIndex::MergeComponentBuild(FComponentBuild& Build)
+{
+    UISMRuntimeComponent* Comp = Build.Component;
+    if (!Comp) return;
+
+    if (!Build.bGathered)
+    {
+        if (bUseDenseIds)
+        {
+            FindOrAddDenseSlot(Comp);
+        }
 
         const int32 Count = Comp->GetInstanceCount();
         for (int32 i = 0; i < Count; ++i)
@@ -406,11 +1019,115 @@ void UISMInstanceIndex::RebuildIndex()
                 IndexHandle(Comp, i);
             }
         }
+        return;
     }
+
+    if (bUseDenseIds)
+    {
+        const int32 Slot = FindOrAddDenseSlot(Comp);
+        const int32 Count = Comp->GetInstanceCount();
+        for (TPair<FGameplayTag, TArray<FISMInstanceHandle>>& Pair : Build.HandlesByKey)
+        {
+            FDenseKeySet& Set = DenseIndex.FindOrAdd(Pair.Key);
+            if (Set.SlotBits.Num() <= Slot) Set.SlotBits.SetNum(Slot + 1);
+
+            TBitArray<>& Bits = Set.SlotBits[Slot];
+            if (Bits.Num() < Count) Bits.Add(false, Count - Bits.Num());
+            for (const FISMInstanceHandle& Handle : Pair.Value)
+            {
+                if (!Bits[Handle.InstanceIndex])
+                {
+                    Bits[Handle.InstanceIndex] = true;
+                    Set.Num++;
+                }
+            }
+        }
+        return;
+    }
+
+    HandleToKeys.Reserve(HandleToKeys.Num() + Build.NumLive);
+    for (TPair<FGameplayTag, TArray<FISMInstanceHandle>>& Pair : Build.HandlesByKey)
+    {
+        TSet<FISMInstanceHandle>& Set = Index.FindOrAdd(Pair.Key);
+        Set.Reserve(Set.Num() + Pair.Value.Num());
+        for (const FISMInstanceHandle& Handle : Pair.Value)
+        {
+            Set.Add(Handle);
+            HandleToKeys.FindOrAdd(Handle).Add(Pair.Key);
+        }
+    }
+}
+
+// ============================================================
+//  Maintenance
+// ============================================================
+
+void UISMInstanceIndex::RebuildIndex()
+{
+    // Everything is re-read from the components, pending or not
+    Index.Reset();
+    HandleToKeys.Reset();
+    ResetDenseStorage();
+    ClearPendingChanges();
+    PendingBuilds.Reset();
+
+    TArray<UISMRuntimeComponent*> Components;
+    Components.Reserve(RegisteredComponents.Num());
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : RegisteredComponents)
+    {
+        if (UISMRuntimeComponent* Comp = CompPtr.Get())
+        {
+            Components.Add(Comp);
+        }
+    }
+    QueueBuilds(Components);
+
+    // Views over components still queued catch up when their build lands
+    RefreshViews();
 }
 
 void UISMInstanceIndex::PruneStaleHandles()
 {
+    FlushPendingChanges();
+
+    if (bUseDenseIds)
+    {
+        for (auto It = DenseSlotByComponent.CreateIterator(); It; ++It)
+        {
+            const int32 Slot = It.Value();
+            if (DenseSlotComponents[Slot].IsValid()) continue;
+
+            ClearDenseSlot(Slot);
+            DenseSlotComponents[Slot] = nullptr;
+            DenseFreeSlots.Add(Slot);
+            It.RemoveCurrent();
+        }
+
+        // Bits of destroyed instances, in case a destruction event was missed
+        TArray<int32> Destroyed;
+        for (auto It = DenseIndex.CreateIterator(); It; ++It)
+        {
+            FDenseKeySet& Set = It.Value();
+            for (int32 Slot = 0; Slot < Set.SlotBits.Num(); ++Slot)
+            {
+                const UISMRuntimeComponent* Comp = GetDenseSlotComponent(Slot);
+                if (!Comp) continue;
+
+                Destroyed.Reset();
+                for (TConstSetBitIterator<> Bit(Set.SlotBits[Slot]); Bit; ++Bit)
+                {
+                    if (Comp->IsInstanceDestroyed(Bit.GetIndex()))
+                        Destroyed.Add(Bit.GetIndex());
+                }
+                for (int32 InstanceIndex : Destroyed)
+                    ClearDenseBit(Set, Slot, InstanceIndex);
+            }
+            if (Set.Num == 0) It.RemoveCurrent();
+        }
+        RefreshViews();
+        return;
+    }
+
     TArray<FISMInstanceHandle> ToRemove;
     for (const auto& Pair : HandleToKeys)
     {
@@ -423,6 +1140,9 @@ void UISMInstanceIndex::PruneStaleHandles()
     {
         RemoveFromAllKeys(Handle);
     }
+
+    // Views match handles by slot, so removing a stale generation may have dropped a live one
+    RefreshViews();
 }
 
 // ============================================================
@@ -433,16 +1153,58 @@ void UISMInstanceIndex::AddToKey(FGameplayTag Key, const FISMInstanceHandle& Han
 {
     if (!Key.IsValid() || !Handle.IsValid()) return;
 
-    Index.FindOrAdd(Key).Add(Handle);
+    if (bUseDenseIds)
+    {
+        UISMRuntimeComponent* Comp = Handle.Component.Get();
+        const int32 Slot = FindOrAddDenseSlot(Comp);
+
+        FDenseKeySet& Set = DenseIndex.FindOrAdd(Key);
+        if (Set.SlotBits.Num() <= Slot) Set.SlotBits.SetNum(Slot + 1);
+
+        TBitArray<>& Bits = Set.SlotBits[Slot];
+        if (Bits.Num() <= Handle.InstanceIndex)
+        {
+            // Size to the component up front so a registration pass does not grow bit by bit
+            const int32 NewNum = FMath::Max(Handle.InstanceIndex + 1, Comp->GetInstanceCount());
+            Bits.Add(false, NewNum - Bits.Num());
+        }
+        if (!Bits[Handle.InstanceIndex])
+        {
+            Bits[Handle.InstanceIndex] = true;
+            Set.Num++;
+            NotifyViewsAdded(Key, Handle);
+        }
+        return;
+    }
+
+    bool bAlreadyFiled = false;
+    Index.FindOrAdd(Key).Add(Handle, &bAlreadyFiled);
     HandleToKeys.FindOrAdd(Handle).Add(Key);
+    if (!bAlreadyFiled)
+    {
+        NotifyViewsAdded(Key, Handle);
+    }
 }
 
 void UISMInstanceIndex::RemoveFromKey(FGameplayTag Key, const FISMInstanceHandle& Handle)
 {
+    if (bUseDenseIds)
+    {
+        FDenseKeySet* Set = DenseIndex.Find(Key);
+        if (!Set) return;
+        if (ClearDenseBit(*Set, FindDenseSlot(Handle.Component.Get()), Handle.InstanceIndex))
+        {
+            if (Set->Num == 0) DenseIndex.Remove(Key);
+            NotifyViewsRemoved(Key, Handle);
+        }
+        return;
+    }
+
     if (TSet<FISMInstanceHandle>* Set = Index.Find(Key))
     {
-        Set->Remove(Handle);
+        const bool bRemoved = Set->Remove(Handle) > 0;
         if (Set->IsEmpty()) Index.Remove(Key);
+        if (bRemoved) NotifyViewsRemoved(Key, Handle);
     }
 
     if (TSet<FGameplayTag>* Keys = HandleToKeys.Find(Handle))
@@ -454,6 +1216,24 @@ void UISMInstanceIndex::RemoveFromKey(FGameplayTag Key, const FISMInstanceHandle
 
 void UISMInstanceIndex::RemoveFromAllKeys(const FISMInstanceHandle& Handle)
 {
+    if (bUseDenseIds)
+    {
+        const int32 Slot = FindDenseSlot(Handle.Component.Get());
+        if (Slot == INDEX_NONE) return;
+
+        for (auto It = DenseIndex.CreateIterator(); It; ++It)
+        {
+            if (!ClearDenseBit(It.Value(), Slot, Handle.InstanceIndex)) continue;
+
+            NotifyViewsRemoved(It.Key(), Handle);
+            if (It.Value().Num == 0)
+            {
+                It.RemoveCurrent();
+            }
+        }
+        return;
+    }
+
     TSet<FGameplayTag>* Keys = HandleToKeys.Find(Handle);
     if (!Keys) return;
 
@@ -464,19 +1244,165 @@ void UISMInstanceIndex::RemoveFromAllKeys(const FISMInstanceHandle& Handle)
             Set->Remove(Handle);
             if (Set->IsEmpty()) Index.Remove(Key);
         }
+        NotifyViewsRemoved(Key, Handle);
     }
     HandleToKeys.Remove(Handle);
 }
 
 const TSet<FISMInstanceHandle>* UISMInstanceIndex::GetSetForKey(FGameplayTag Key) const
 {
+    ReconcilePendingChanges();
     return Index.Find(Key);
 }
 
+// ============================================================
+//  Private: Dense storage
+// ============================================================
+
+int32 UISMInstanceIndex::FindDenseSlot(const UISMRuntimeComponent* Component) const
+{
+    const int32* Slot = Component ? DenseSlotByComponent.Find(Component) : nullptr;
+    return Slot ? *Slot : INDEX_NONE;
+}
+
+int32 UISMInstanceIndex::FindOrAddDenseSlot(UISMRuntimeComponent* Component)
+{
+    if (const int32* Existing = DenseSlotByComponent.Find(Component))
+    {
+        return *Existing;
+    }
+
+    const int32 Slot = DenseFreeSlots.Num() > 0 ? DenseFreeSlots.Pop(EAllowShrinking::No) : DenseSlotComponents.AddDefaulted();
+    DenseSlotComponents[Slot] = Component;
+    DenseSlotByComponent.Add(Component, Slot);
+    return Slot;
+}
+
+void UISMInstanceIndex::ClearDenseSlot(int32 Slot)
+{
+    for (auto It = DenseIndex.CreateIterator(); It; ++It)
+    {
+        FDenseKeySet& Set = It.Value();
+        if (!Set.SlotBits.IsValidIndex(Slot)) continue;
+
+        Set.Num -= Set.SlotBits[Slot].CountSetBits();
+        Set.SlotBits[Slot].Empty();
+        if (Set.Num == 0) It.RemoveCurrent();
+    }
+}
+
+const TBitArray<>* UISMInstanceIndex::FindDenseBits(FGameplayTag Key, const UISMRuntimeComponent* Component) const
+{
+    const FDenseKeySet* Set = DenseIndex.Find(Key);
+    const int32 Slot = FindDenseSlot(Component);
+    return Set && Set->SlotBits.IsValidIndex(Slot) ? &Set->SlotBits[Slot] : nullptr;
+}
+
+bool UISMInstanceIndex::ClearDenseBit(FDenseKeySet& Set, int32 Slot, int32 InstanceIndex)
+{
+    if (!Set.SlotBits.IsValidIndex(Slot)) return false;
+
+    TBitArray<>& Bits = Set.SlotBits[Slot];
+    if (!Bits.IsValidIndex(InstanceIndex) || !Bits[InstanceIndex]) return false;
+
+    Bits[InstanceIndex] = false;
+    Set.Num--;
+    return true;
+}
+
+void UISMInstanceIndex::IntersectDense(
+    TConstArrayView<TPair<const UISMInstanceIndex*, const FDenseKeySet*>> Sets,
+    TArray<FISMInstanceHandle>& OutHandles)
+{
+    if (Sets.IsEmpty()) return;
+
+    const UISMInstanceIndex* Driver = Sets[0].Key;
+    const FDenseKeySet& First = *Sets[0].Value;
+    OutHandles.Reserve(OutHandles.Num() + First.Num);
+
+    TBitArray<> Acc;
+    for (int32 Slot = 0; Slot < First.SlotBits.Num(); ++Slot)
+    {
+        UISMRuntimeComponent* Comp = Driver->GetDenseSlotComponent(Slot);
+        if (!Comp || First.SlotBits[Slot].Num() == 0) continue;
+
+        // Other indexes number their components independently - match by component
+        const TBitArray<>* Single = &First.SlotBits[Slot];
+        if (Sets.Num() > 1)
+        {
+            Acc = First.SlotBits[Slot];
+            for (int32 i = 1; i < Sets.Num() && Acc.Num() > 0; ++i)
+            {
+                const int32 OtherSlot = Sets[i].Key->FindDenseSlot(Comp);
+                if (!Sets[i].Value->SlotBits.IsValidIndex(OtherSlot))
+                {
+                    Acc.Empty();
+                    break;
+                }
+                Acc.CombineWithBitwiseAND(Sets[i].Value->SlotBits[OtherSlot], EBitwiseOperatorFlags::MinSize);
+            }
+            Single = &Acc;
+        }
+
+        for (TConstSetBitIterator<> It(*Single); It; ++It)
+        {
+            OutHandles.Add(Comp->GetInstanceHandle(It.GetIndex()));
+        }
+    }
+}
+
+TArray<FISMInstanceHandle> UISMInstanceIndex::IntersectByProbing(const TArray<FISMIndexQuery>& Queries)
+{
+    TArray<const FISMIndexQuery*> Sorted;
+    for (const FISMIndexQuery& Q : Queries)
+    {
+        if (!Q.Index) continue;
+        if (Q.Index->GetCountForTag(Q.Key) == 0) return {};
+        Sorted.Add(&Q);
+    }
+    if (Sorted.IsEmpty()) return {};
+
+    Sorted.Sort([](const FISMIndexQuery& A, const FISMIndexQuery& B)
+    {
+        return A.Index->GetCountForTag(A.Key) < B.Index->GetCountForTag(B.Key);
+    });
+
+    TArray<FISMInstanceHandle> Result = Sorted[0]->Index->GetHandlesForTag(Sorted[0]->Key);
+    for (int32 i = 1; i < Sorted.Num() && Result.Num() > 0; ++i)
+    {
+        const FISMIndexQuery& Q = *Sorted[i];
+        Result.RemoveAll([&Q](const FISMInstanceHandle& Handle)
+        {
+            return !Q.Index->IsHandleIndexed(Q.Key, Handle);
+        });
+    }
+    return Result;
+}
+
+void UISMInstanceIndex::ResetDenseStorage()
+{
+    DenseIndex.Reset();
+    DenseSlotComponents.Reset();
+    DenseSlotByComponent.Reset();
+    DenseFreeSlots.Reset();
+}
+
 // ============================================================
 //  Private: Index a single handle
 // ============================================================
 
+void UISMInstanceIndex::OnHandleChanged(const FISMInstanceHandle& Handle)
+{
+    KeyBuffer.Reset();
+    if (!GatherKeys(Handle, KeyBuffer)) return;
+
+    RemoveFromAllKeys(Handle);
+    for (const FGameplayTag& Key : KeyBuffer)
+    {
+        AddToKey(Key, Handle);
+    }
+}
+
 void UISMInstanceIndex::IndexHandle(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
     FISMInstanceHandle Handle = Component->GetInstanceHandle(InstanceIndex);
@@ -492,33 +1418,117 @@ void UISMInstanceIndex::IndexHandle(UISMRuntimeComponent* Component, int32 Insta
 
 void UISMInstanceIndex::HandleStateChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
-    IndexHandle(Component, InstanceIndex);
+    NoteInstanceChanged(Component, InstanceIndex, false);
 }
 
 void UISMInstanceIndex::HandleDestroyed(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
-    FISMInstanceHandle Handle = Component->GetInstanceHandle(InstanceIndex);
-    OnHandleRemoved(Handle);
+    NoteInstanceChanged(Component, InstanceIndex, true);
 }
 
 void UISMInstanceIndex::HandleTagChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
-    IndexHandle(Component, InstanceIndex);
+    NoteInstanceChanged(Component, InstanceIndex, false);
 }
 
 void UISMInstanceIndex::HandleOwnershipChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
-    IndexHandle(Component, InstanceIndex);
+    NoteInstanceChanged(Component, InstanceIndex, false);
 }
 
 void UISMInstanceIndex::HandlePossessionChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
-    IndexHandle(Component, InstanceIndex);
+    NoteInstanceChanged(Component, InstanceIndex, false);
 }
 
 void UISMInstanceIndex::HandleAttachmentChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
 {
-    IndexHandle(Component, InstanceIndex);
+    NoteInstanceChanged(Component, InstanceIndex, false);
+}
+
+void UISMInstanceIndex::HandleInstancesChangedBatch(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices)
+{
+    // A batched destroy also changes state, and the per-instance path re-indexes after the removal
+    for (int32 InstanceIndex : InstanceIndices)
+    {
+        NoteInstanceChanged(Component, InstanceIndex, false);
+    }
+}
+
+// ============================================================
+//  Private: Deferred maintenance
+// ============================================================
+
+void UISMInstanceIndex::NoteInstanceChanged(UISMRuntimeComponent* Component, int32 InstanceIndex, bool bRemoved)
+{
+    if (!bDeferMaintenance)
+    {
+        if (bRemoved)
+        {
+            OnHandleRemoved(Component->GetInstanceHandle(InstanceIndex));
+        }
+        else
+        {
+            IndexHandle(Component, InstanceIndex);
+        }
+        return;
+    }
+
+    if (!Component || InstanceIndex < 0) return;
+
+    FPendingChanges& Pending = PendingChanges.FindOrAdd(Component);
+    if (Pending.Dirty.Num() <= InstanceIndex)
+    {
+        const int32 NewNum = FMath::Max(InstanceIndex + 1, Component->GetInstanceCount());
+        Pending.Dirty.Add(false, NewNum - Pending.Dirty.Num());
+        Pending.Removed.Add(false, NewNum - Pending.Removed.Num());
+    }
+
+    // Replaying only the last event per instance gives the same entries as replaying them all
+    if (!Pending.Dirty[InstanceIndex])
+    {
+        Pending.Dirty[InstanceIndex] = true;
+        if (NumPendingChanges++ == 0)
+        {
+            SetComponentTickEnabled(true);
+        }
+    }
+    Pending.Removed[InstanceIndex] = bRemoved;
+}
+
+void UISMInstanceIndex::FlushPendingChanges()
+{
+    if (NumPendingChanges == 0) return;
+
+    // Subclass callbacks may query the index; start from a clean slate so they see no pending work
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, FPendingChanges> Flushing = MoveTemp(PendingChanges);
+    PendingChanges.Reset();
+    NumPendingChanges = 0;
+
+    for (TPair<TWeakObjectPtr<UISMRuntimeComponent>, FPendingChanges>& Pair : Flushing)
+    {
+        UISMRuntimeComponent* Comp = Pair.Key.Get();
+        if (!Comp) continue;
+
+        for (TConstSetBitIterator<> It(Pair.Value.Dirty); It; ++It)
+        {
+            const int32 InstanceIndex = It.GetIndex();
+            if (Pair.Value.Removed[InstanceIndex])
+            {
+                OnHandleRemoved(Comp->GetInstanceHandle(InstanceIndex));
+            }
+            else
+            {
+                IndexHandle(Comp, InstanceIndex);
+            }
+        }
+    }
+}
+
+void UISMInstanceIndex::ClearPendingChanges()
+{
+    PendingChanges.Reset();
+    NumPendingChanges = 0;
 }
 
 // ============================================================
@@ -542,21 +1552,18 @@ UISMStateIndex::UISMStateIndex()
         FGameplayTag::RequestGameplayTag("ISM.State.Collected"));
 }
 
-void UISMStateIndex::OnHandleChanged(const FISMInstanceHandle& Handle)
+bool UISMStateIndex::GatherKeys(const FISMInstanceHandle& Handle, TArray<FGameplayTag>& OutKeys) const
 {
-    RemoveFromAllKeys(Handle);
-
-    UISMRuntimeComponent* Comp = Handle.Component.Get();
-    if (!Comp) return;
-
-    const FISMInstanceState* State = Comp->GetInstanceState(Handle.InstanceIndex);
-    if (!State) return;
+    const UISMRuntimeComponent* Comp = Handle.Component.Get();
+    if (!Comp || !Comp->HasInstanceState(Handle.InstanceIndex)) return true;
 
+    const uint8 StateFlags = Comp->GetInstanceStateFlags(Handle.InstanceIndex);
     for (const auto& Pair : StateTagMap)
     {
-        if (State->HasFlag(Pair.Key) && Pair.Value.IsValid())
+        if ((StateFlags & static_cast<uint8>(Pair.Key)) != 0 && Pair.Value.IsValid())
         {
-            AddToKey(Pair.Value, Handle);
+            OutKeys.Add(Pair.Value);
         }
     }
+    return true;
 }
\ No newline at end of file
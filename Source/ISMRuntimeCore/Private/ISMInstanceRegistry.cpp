@@ -0,0 +1,140 @@
+// ISMInstanceRegistry.cpp
+#include "ISMInstanceRegistry.h"
+#include "ISMRuntimeComponent.h"
+
+int32 FISMInstanceRegistry::Add(UISMRuntimeComponent* Component)
+{
+    if (!Component)
+    {
+        return INDEX_NONE;
+    }
+
+    if (const int32* Existing = SlotByComponent.Find(Component))
+    {
+        if (Slots[*Existing].Component.Get() == Component)
+        {
+            return *Existing;
+        }
+
+        // A destroyed component's address was reused before RemoveStaleEntries ran
+        FreeSlot(*Existing);
+        SlotByComponent.Remove(Component);
+    }
+
+    int32 Slot = INDEX_NONE;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        if (Slots.Num() >= static_cast<int32>(FISMGlobalInstanceId::MaxSlots))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FISMInstanceRegistry: slot limit reached, %s gets no global IDs"),
+                *Component->GetName());
+            return INDEX_NONE;
+        }
+        Slot = Slots.AddDefaulted();
+        Slots[Slot].Generation = 1;
+    }
+
+    Slots[Slot].Component = Component;
+    SlotByComponent.Add(Component, Slot);
+    return Slot;
+}
+
+void FISMInstanceRegistry::Remove(const UISMRuntimeComponent* Component)
+{
+    int32 Slot = INDEX_NONE;
+    if (SlotByComponent.RemoveAndCopyValue(Component, Slot))
+    {
+        FreeSlot(Slot);
+    }
+}
+
+void FISMInstanceRegistry::RemoveStaleEntries()
+{
+    for (auto It = SlotByComponent.CreateIterator(); It; ++It)
+    {
+        const int32 Slot = It.Value();
+        if (Slots[Slot].Component.IsValid())
+        {
+            continue;
+        }
+
+        FreeSlot(Slot);
+        It.RemoveCurrent();
+    }
+}
+
+void FISMInstanceRegistry::Reset()
+{
+    Slots.Reset();
+    SlotByComponent.Reset();
+    FreeSlots.Reset();
+}
+
+void FISMInstanceRegistry::FreeSlot(int32 Slot)
+{
+    FSlot& Entry = Slots[Slot];
+    Entry.Component = nullptr;
+
+    // Skip 0 on wrap so a packed ID is never all zero
+    Entry.Generation = (Entry.Generation + 1) & FISMGlobalInstanceId::SlotGenerationMask;
+    if (Entry.Generation == 0)
+    {
+        Entry.Generation = 1;
+    }
+    FreeSlots.Add(Slot);
+}
+
+FISMGlobalInstanceId FISMInstanceRegistry::MakeId(const UISMRuntimeComponent* Component, int32 InstanceIndex) const
+{
+    if (InstanceIndex < 0)
+    {
+        return FISMGlobalInstanceId();
+    }
+
+    const int32 Slot = FindSlot(Component);
+    if (Slot == INDEX_NONE)
+    {
+        return FISMGlobalInstanceId();
+    }
+    return FISMGlobalInstanceId(static_cast<uint32>(Slot), Slots[Slot].Generation, InstanceIndex);
+}
+
+UISMRuntimeComponent* FISMInstanceRegistry::ResolveComponent(FISMGlobalInstanceId Id) const
+{
+    if (!Id.IsValid())
+    {
+        return nullptr;
+    }
+
+    const int32 Slot = static_cast<int32>(Id.GetSlot());
+    if (!Slots.IsValidIndex(Slot) || Slots[Slot].Generation != Id.GetSlotGeneration())
+    {
+        return nullptr;
+    }
+    return Slots[Slot].Component.Get();
+}
+
+FISMInstanceHandle FISMInstanceRegistry::ResolveHandle(FISMGlobalInstanceId Id) const
+{
+    FISMInstanceHandle Handle;
+    UISMRuntimeComponent* Component = ResolveComponent(Id);
+    const int32 InstanceIndex = Id.GetInstanceIndex();
+    if (!Component || InstanceIndex < 0 || InstanceIndex >= Component->GetInstanceCount())
+    {
+        return Handle;
+    }
+
+    Handle.Component = Component;
+    Handle.InstanceIndex = InstanceIndex;
+    Handle.Generation = static_cast<int32>(Component->GetInstanceGeneration(InstanceIndex));
+    return Handle;
+}
+
+SIZE_T FISMInstanceRegistry::GetAllocatedSize() const
+{
+    return Slots.GetAllocatedSize() + SlotByComponent.GetAllocatedSize() + FreeSlots.GetAllocatedSize();
+}
@@ -0,0 +1,411 @@
+// ISMInstanceStateStore.cpp
+#include "ISMInstanceStateStore.h"
+
+void FISMInstanceStateStore::Reset()
+{
+    Flags.Empty();
+    Present.Empty();
+    BoundsMin.Empty();
+    BoundsMax.Empty();
+    BoundsValid.Empty();
+    PresentCount = 0;
+
+    FMemory::Memzero(FlagCounts);
+    ActiveCount = 0;
+    LiveSlots.Empty();
+    DestroyedSlots.Empty();
+
+    LastUpdateFrames.Empty();
+    Generations.Empty();
+    LastVisibleTransforms.Empty();
+    ModuleData.Empty();
+}
+
+void FISMInstanceStateStore::Reserve(int32 NumInstances)
+{
+    Flags.Reserve(NumInstances);
+    Present.Reserve(NumInstances);
+    BoundsMin.Reserve(NumInstances);
+    BoundsMax.Reserve(NumInstances);
+    BoundsValid.Reserve(NumInstances);
+    LiveSlots.Reserve(NumInstances);
+    DestroyedSlots.Reserve(NumInstances);
+    LastUpdateFrames.Reserve(NumInstances);
+    Generations.Reserve(NumInstances);
+}
+
+void FISMInstanceStateStore::ResetIntact(int32 NumInstances, uint32 FrameNumber)
+{
+    Reset();
+    AddIntactRange(0, NumInstances, FrameNumber);
+}
+
+void FISMInstanceStateStore::AddIntactRange(int32 FirstIndex, int32 NumInstances, uint32 FrameNumber)
+{
+    if (FirstIndex < 0 || NumInstances <= 0)
+    {
+        return;
+    }
+
+    EnsureSlot(FirstIndex + NumInstances - 1);
+
+    const uint8 IntactFlags = static_cast<uint8>(EISMInstanceState::Intact);
+    FMemory::Memset(Flags.GetData() + FirstIndex, IntactFlags, NumInstances);
+    Present.SetRange(FirstIndex, NumInstances, true);
+    BoundsValid.SetRange(FirstIndex, NumInstances, false);
+    LiveSlots.SetRange(FirstIndex, NumInstances, true);
+    DestroyedSlots.SetRange(FirstIndex, NumInstances, false);
+    for (int32 Index = FirstIndex; Index < FirstIndex + NumInstances; ++Index)
+    {
+        LastUpdateFrames[Index] = FrameNumber;
+    }
+
+    PresentCount += NumInstances;
+    AccumulateFlags(IntactFlags, NumInstances);
+}
+
+void FISMInstanceStateStore::ResetFromFlags(TConstArrayView<uint8> SlotFlags, uint32 FrameNumber)
+{
+    ResetIntact(SlotFlags.Num(), FrameNumber);
+
+    const uint8 IntactFlags = static_cast<uint8>(EISMInstanceState::Intact);
+    for (int32 Index = 0; Index < SlotFlags.Num(); ++Index)
+    {
+        if (SlotFlags[Index] != IntactFlags)
+        {
+            WriteFlags(Index, SlotFlags[Index]);
+        }
+    }
+}
+
+void FISMInstanceStateStore::ExtractDelta(FISMInstanceStateDelta& OutDelta)
+{
+    OutDelta.Reset();
+    OutDelta.NumSlots = Flags.Num();
+
+    const uint8 IntactFlags = static_cast<uint8>(EISMInstanceState::Intact);
+    for (int32 Index = 0; Index < Flags.Num(); ++Index)
+    {
+        if (Present[Index] && (Flags[Index] != IntactFlags || Generations[Index] != 0))
+        {
+            OutDelta.Indices.Add(Index);
+            OutDelta.Flags.Add(Flags[Index]);
+            OutDelta.Generations.Add(Generations[Index]);
+        }
+    }
+
+    OutDelta.LastVisibleTransforms = MoveTemp(LastVisibleTransforms);
+    OutDelta.ModuleData = MoveTemp(ModuleData);
+    Reset();
+}
+
+void FISMInstanceStateStore::ApplyDelta(FISMInstanceStateDelta&& Delta, uint32 FrameNumber)
+{
+    ResetIntact(Delta.NumSlots, FrameNumber);
+
+    for (int32 i = 0; i < Delta.Indices.Num(); ++i)
+    {
+        const int32 Index = Delta.Indices[i];
+        if (Contains(Index))
+        {
+            WriteFlags(Index, Delta.Flags[i]);
+            Generations[Index] = Delta.Generations[i];
+        }
+    }
+
+    LastVisibleTransforms = MoveTemp(Delta.LastVisibleTransforms);
+    ModuleData = MoveTemp(Delta.ModuleData);
+    Delta.Reset();
+}
+
+void FISMInstanceStateStore::EnsureSlot(int32 InstanceIndex)
+{
+    const int32 NewNum = InstanceIndex + 1;
+    if (NewNum <= Flags.Num())
+    {
+        return;
+    }
+
+    Flags.SetNumZeroed(NewNum);
+    Present.Add(false, NewNum - Present.Num());
+    BoundsMin.SetNumZeroed(NewNum);
+    BoundsMax.SetNumZeroed(NewNum);
+    BoundsValid.Add(false, NewNum - BoundsValid.Num());
+    LiveSlots.Add(false, NewNum - LiveSlots.Num());
+    DestroyedSlots.Add(false, NewNum - DestroyedSlots.Num());
+    LastUpdateFrames.SetNumZeroed(NewNum);
+    Generations.SetNumZeroed(NewNum);
+}
+
+void FISMInstanceStateStore::Add(int32 InstanceIndex, uint32 FrameNumber)
+{
+    if (InstanceIndex < 0)
+    {
+        return;
+    }
+
+    EnsureSlot(InstanceIndex);
+
+    if (!Present[InstanceIndex])
+    {
+        Present[InstanceIndex] = true;
+        PresentCount++;
+        // Counted from zero flags so WriteFlags can treat it like any other slot
+        AccumulateFlags(0, 1);
+    }
+    else
+    {
+        // Slot reuse - invalidate handles to the previous occupant
+        Generations[InstanceIndex]++;
+    }
+
+    WriteFlags(InstanceIndex, static_cast<uint8>(EISMInstanceState::Intact));
+    BoundsValid[InstanceIndex] = false;
+    LastUpdateFrames[InstanceIndex] = FrameNumber;
+
+    if (LastVisibleTransforms.Num() > 0)
+    {
+        LastVisibleTransforms.Remove(InstanceIndex);
+    }
+    if (ModuleData.Num() > 0)
+    {
+        ModuleData.Remove(InstanceIndex);
+    }
+}
+
+void FISMInstanceStateStore::SetFlag(int32 InstanceIndex, EISMInstanceState Flag, bool bValue)
+{
+    if (!Contains(InstanceIndex))
+    {
+        return;
+    }
+
+    const uint8 OldFlags = Flags[InstanceIndex];
+    WriteFlags(InstanceIndex, bValue
+        ? (OldFlags | static_cast<uint8>(Flag))
+        : (OldFlags & ~static_cast<uint8>(Flag)));
+}
+
+void FISMInstanceStateStore::SetFlags(int32 InstanceIndex, uint8 NewFlags)
+{
+    if (!Contains(InstanceIndex))
+    {
+        return;
+    }
+
+    WriteFlags(InstanceIndex, NewFlags);
+}
+
+void FISMInstanceStateStore::WriteFlags(int32 InstanceIndex, uint8 NewFlags)
+{
+    // A slot just made present has neither bitset bit yet and must go through
+    const uint8 OldFlags = Flags[InstanceIndex];
+    if (OldFlags == NewFlags && LiveSlots[InstanceIndex] != DestroyedSlots[InstanceIndex])
+    {
+        return;
+    }
+
+    AccumulateFlags(OldFlags, -1);
+    AccumulateFlags(NewFlags, 1);
+    Flags[InstanceIndex] = NewFlags;
+
+    const bool bDestroyed = (NewFlags & static_cast<uint8>(EISMInstanceState::Destroyed)) != 0;
+    LiveSlots[InstanceIndex] = !bDestroyed;
+    DestroyedSlots[InstanceIndex] = bDestroyed;
+}
+
+void FISMInstanceStateStore::AccumulateFlags(uint8 SlotFlags, int32 Sign)
+{
+    for (int32 Bit = 0; Bit < 8; Bit++)
+    {
+        FlagCounts[Bit] += ((SlotFlags >> Bit) & 1) * Sign;
+    }
+    ActiveCount += (SlotFlags & InactiveMask) == 0 ? Sign : 0;
+}
+
+int32 FISMInstanceStateStore::GetFlagCount(EISMInstanceState Flag) const
+{
+    const uint32 Bits = static_cast<uint32>(Flag);
+    return Bits != 0 ? FlagCounts[FMath::CountTrailingZeros(Bits)] : 0;
+}
+
+void FISMInstanceStateStore::MarkDestroyed(int32 InstanceIndex)
+{
+    SetFlag(InstanceIndex, EISMInstanceState::Intact, false);
+    SetFlag(InstanceIndex, EISMInstanceState::Damaged, false);
+    SetFlag(InstanceIndex, EISMInstanceState::Destroyed, true);
+}
+
+void FISMInstanceStateStore::GatherFlags(TConstArrayView<int32> InstanceIndices, TArrayView<uint8> OutFlags) const
+{
+    check(OutFlags.Num() >= InstanceIndices.Num());
+
+    const int32 Count = Flags.Num();
+    const uint8* Data = Flags.GetData();
+    for (int32 i = 0; i < InstanceIndices.Num(); i++)
+    {
+        const int32 InstanceIndex = InstanceIndices[i];
+        OutFlags[i] = static_cast<uint32>(InstanceIndex) < static_cast<uint32>(Count) ? Data[InstanceIndex] : 0;
+    }
+}
+
+int32 FISMInstanceStateStore::CountWithoutFlags(uint8 ExcludeMask) const
+{
+    const int32 Count = Flags.Num();
+    const uint8* Data = Flags.GetData();
+
+    // Eight flag bytes per step: a byte's high bit ends up set iff (byte & mask) != 0
+    const uint64 Mask = 0x0101010101010101ULL * ExcludeMask;
+    const uint64 Low7 = 0x7f7f7f7f7f7f7f7fULL;
+
+    int32 Matching = 0;
+    int32 i = 0;
+    for (; i + 8 <= Count; i += 8)
+    {
+        uint64 Word;
+        FMemory::Memcpy(&Word, Data + i, sizeof(Word));
+        const uint64 Hit = Word & Mask;
+        const uint64 NonZero = (((Hit & Low7) + Low7) | Hit) & ~Low7;
+        Matching += 8 - FMath::CountBits(NonZero);
+    }
+    for (; i < Count; i++)
+    {
+        Matching += (Data[i] & ExcludeMask) == 0 ? 1 : 0;
+    }
+
+    // Absent slots hold zero flags and always pass - take them back out
+    return Matching - (Count - PresentCount);
+}
+
+void FISMInstanceStateStore::GatherWithoutFlags(uint8 ExcludeMask, TArray<int32>& OutIndices) const
+{
+    const int32 Count = Flags.Num();
+    const bool bAllPresent = (PresentCount == Count);
+
+    OutIndices.Reserve(OutIndices.Num() + Count);
+    for (int32 i = 0; i < Count; i++)
+    {
+        if ((Flags[i] & ExcludeMask) == 0 && (bAllPresent || Present[i]))
+        {
+            OutIndices.Add(i);
+        }
+    }
+}
+
+void FISMInstanceStateStore::SetWorldBounds(int32 InstanceIndex, const FBox& Bounds)
+{
+    if (InstanceIndex < 0)
+    {
+        return;
+    }
+
+    EnsureSlot(InstanceIndex);
+    BoundsMin[InstanceIndex] = FVector3f(Bounds.Min);
+    BoundsMax[InstanceIndex] = FVector3f(Bounds.Max);
+    BoundsValid[InstanceIndex] = true;
+}
+
+void FISMInstanceStateStore::AdoptWorldBounds(TConstArrayView<FVector3f> InBoundsMin, TConstArrayView<FVector3f> InBoundsMax)
+{
+    const int32 NumInstances = FMath::Min3(InBoundsMin.Num(), InBoundsMax.Num(), Flags.Num());
+    if (NumInstances <= 0)
+    {
+        return;
+    }
+
+    FMemory::Memcpy(BoundsMin.GetData(), InBoundsMin.GetData(), NumInstances * sizeof(FVector3f));
+    FMemory::Memcpy(BoundsMax.GetData(), InBoundsMax.GetData(), NumInstances * sizeof(FVector3f));
+    BoundsValid.SetRange(0, NumInstances, true);
+}
+
+void FISMInstanceStateStore::SetLastVisibleTransform(int32 InstanceIndex, const FTransform& Transform)
+{
+    if (!Contains(InstanceIndex))
+    {
+        return;
+    }
+
+    LastVisibleTransforms.Add(InstanceIndex, Transform);
+}
+
+void FISMInstanceStateStore::RefreshLastVisibleTransform(int32 InstanceIndex, const FTransform& Transform)
+{
+    if (FTransform* LastVisible = LastVisibleTransforms.Find(InstanceIndex))
+    {
+        *LastVisible = Transform;
+    }
+}
+
+void FISMInstanceStateStore::SetModuleData(int32 InstanceIndex, void* Data)
+{
+    if (!Contains(InstanceIndex))
+    {
+        return;
+    }
+
+    if (Data)
+    {
+        ModuleData.Add(InstanceIndex, Data);
+    }
+    else
+    {
+        ModuleData.Remove(InstanceIndex);
+    }
+}
+
+FISMInstanceState FISMInstanceStateStore::ToInstanceState(int32 InstanceIndex) const
+{
+    FISMInstanceState State;
+    if (!Contains(InstanceIndex))
+    {
+        return State;
+    }
+
+    State.StateFlags = Flags[InstanceIndex];
+    State.LastUpdateFrame = static_cast<int>(LastUpdateFrames[InstanceIndex]);
+
+    State.bBoundsValid = GetWorldBounds(InstanceIndex, State.WorldBounds);
+
+    if (const FTransform* LastVisible = GetLastVisibleTransform(InstanceIndex))
+    {
+        State.LastVisibleTransform = *LastVisible;
+        State.bHasLastVisibleTransform = true;
+    }
+
+    State.ModuleData = GetModuleData(InstanceIndex);
+    return State;
+}
+
+SIZE_T FISMInstanceStateStore::GetAllocatedSize() const
+{
+    return Flags.GetAllocatedSize()
+        + Present.GetAllocatedSize()
+        + BoundsMin.GetAllocatedSize()
+        + BoundsMax.GetAllocatedSize()
+        + BoundsValid.GetAllocatedSize()
+        + LiveSlots.GetAllocatedSize()
+        + DestroyedSlots.GetAllocatedSize()
+        + LastUpdateFrames.GetAllocatedSize()
+        + Generations.GetAllocatedSize()
+        + LastVisibleTransforms.GetAllocatedSize()
+        + ModuleData.GetAllocatedSize();
+}
+
+void FISMInstanceStateDelta::Reset()
+{
+    NumSlots = 0;
+    Indices.Empty();
+    Flags.Empty();
+    Generations.Empty();
+    LastVisibleTransforms.Empty();
+    ModuleData.Empty();
+}
+
+SIZE_T FISMInstanceStateDelta::GetAllocatedSize() const
+{
+    return Indices.GetAllocatedSize()
+        + Flags.GetAllocatedSize()
+        + Generations.GetAllocatedSize()
+        + LastVisibleTransforms.GetAllocatedSize()
+        + ModuleData.GetAllocatedSize();
+}
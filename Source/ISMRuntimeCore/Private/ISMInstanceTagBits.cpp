@@ -0,0 +1,194 @@
+// ISMInstanceTagBits.cpp
+#include "ISMInstanceTagBits.h"
+
+int32 FISMInstanceTagBits::FindOrAddBit(FGameplayTag Tag)
+{
+    if (!Tag.IsValid())
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Existing = FindBit(Tag);
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    // Includes Tag itself
+    const FGameplayTagContainer Parents = Tag.GetGameplayTagParents();
+
+    int32 NumMissing = 0;
+    for (const FGameplayTag& Parent : Parents)
+    {
+        NumMissing += TagToBit.Contains(Parent) ? 0 : 1;
+    }
+    if (Tags.Num() + NumMissing > FISMTagMask::MaxBits)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 FirstNewBit = Tags.Num();
+    for (const FGameplayTag& Parent : Parents)
+    {
+        if (!TagToBit.Contains(Parent))
+        {
+            TagToBit.Add(Parent, Tags.Add(Parent));
+        }
+    }
+
+    // Every ancestor of a new tag is in Parents, so its expansion is the subset it matches
+    ExpandedMasks.SetNum(Tags.Num());
+    for (int32 Bit = FirstNewBit; Bit < Tags.Num(); Bit++)
+    {
+        FISMTagMask& Expanded = ExpandedMasks[Bit];
+        for (const FGameplayTag& Parent : Parents)
+        {
+            if (Tags[Bit].MatchesTag(Parent))
+            {
+                Expanded.SetBit(TagToBit.FindChecked(Parent));
+            }
+        }
+    }
+
+    return TagToBit.FindChecked(Tag);
+}
+
+bool FISMInstanceTagBits::SetInstanceBit(int32 InstanceIndex, int32 Bit)
+{
+    if (InstanceIndex < 0 || !Tags.IsValidIndex(Bit))
+    {
+        return false;
+    }
+
+    if (InstanceIndex >= ExplicitMasks.Num())
+    {
+        ExplicitMasks.SetNum(InstanceIndex + 1);
+        EffectiveMasks.SetNum(InstanceIndex + 1);
+    }
+
+    FISMTagMask& Explicit = ExplicitMasks[InstanceIndex];
+    if (Explicit.TestBit(Bit))
+    {
+        return false;
+    }
+
+    Explicit.SetBit(Bit);
+    EffectiveMasks[InstanceIndex] |= ExpandedMasks[Bit];
+    return true;
+}
+
+bool FISMInstanceTagBits::RemoveTag(int32 InstanceIndex, FGameplayTag Tag)
+{
+    const int32 Bit = FindBit(Tag);
+    if (Bit == INDEX_NONE || !ExplicitMasks.IsValidIndex(InstanceIndex) || !ExplicitMasks[InstanceIndex].TestBit(Bit))
+    {
+        return false;
+    }
+
+    ExplicitMasks[InstanceIndex].ClearBit(Bit);
+
+    // A parent bit may still be implied by a sibling tag
+    RebuildEffectiveMask(InstanceIndex);
+    return true;
+}
+
+bool FISMInstanceTagBits::ClearInstance(int32 InstanceIndex)
+{
+    if (!HasAnyTags(InstanceIndex))
+    {
+        return false;
+    }
+
+    ExplicitMasks[InstanceIndex] = FISMTagMask();
+    EffectiveMasks[InstanceIndex] = FISMTagMask();
+    return true;
+}
+
+void FISMInstanceTagBits::AppendTags(int32 InstanceIndex, FGameplayTagContainer& OutTags) const
+{
+    if (!HasAnyTags(InstanceIndex))
+    {
+        return;
+    }
+
+    const FISMTagMask& Explicit = ExplicitMasks[InstanceIndex];
+    for (int32 Word = 0; Word < FISMTagMask::NumWords; Word++)
+    {
+        for (uint64 Bits = Explicit.Words[Word]; Bits != 0; Bits &= Bits - 1)
+        {
+            OutTags.AddTag(Tags[Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits))]);
+        }
+    }
+}
+
+void FISMInstanceTagBits::BuildFilterMasks(const FGameplayTagContainer& ComponentTags,
+    const FGameplayTagContainer& RequiredTags,
+    const FGameplayTagContainer& ExcludedTags,
+    FISMTagFilterMasks& OutMasks) const
+{
+    OutMasks = FISMTagFilterMasks();
+
+    for (const FGameplayTag& Tag : RequiredTags)
+    {
+        if (ComponentTags.HasTag(Tag))
+        {
+            continue;
+        }
+
+        // Any instance holding Tag or a child of it would have put Tag in the dictionary
+        const int32 Bit = FindBit(Tag);
+        if (Bit == INDEX_NONE)
+        {
+            OutMasks.bNeverPasses = true;
+            return;
+        }
+        OutMasks.Required.SetBit(Bit);
+    }
+
+    for (const FGameplayTag& Tag : ExcludedTags)
+    {
+        if (ComponentTags.HasTag(Tag))
+        {
+            OutMasks.bNeverPasses = true;
+            return;
+        }
+
+        const int32 Bit = FindBit(Tag);
+        if (Bit != INDEX_NONE)
+        {
+            OutMasks.Excluded.SetBit(Bit);
+        }
+    }
+}
+
+void FISMInstanceTagBits::Reset()
+{
+    Tags.Empty();
+    TagToBit.Empty();
+    ExpandedMasks.Empty();
+    ExplicitMasks.Empty();
+    EffectiveMasks.Empty();
+}
+
+SIZE_T FISMInstanceTagBits::GetAllocatedSize() const
+{
+    return Tags.GetAllocatedSize()
+        + TagToBit.GetAllocatedSize()
+        + ExpandedMasks.GetAllocatedSize()
+        + ExplicitMasks.GetAllocatedSize()
+        + EffectiveMasks.GetAllocatedSize();
+}
+
+void FISMInstanceTagBits::RebuildEffectiveMask(int32 InstanceIndex)
+{
+    const FISMTagMask& Explicit = ExplicitMasks[InstanceIndex];
+    FISMTagMask Effective;
+    for (int32 Word = 0; Word < FISMTagMask::NumWords; Word++)
+    {
+        for (uint64 Bits = Explicit.Words[Word]; Bits != 0; Bits &= Bits - 1)
+        {
+            Effective |= ExpandedMasks[Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits))];
+        }
+    }
+    EffectiveMasks[InstanceIndex] = Effective;
+}
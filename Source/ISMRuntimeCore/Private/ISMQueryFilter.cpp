@@ -3,6 +3,7 @@
 
 // ISMQueryFilter.cpp
 #include "ISMQueryFilter.h"
+#include "ISMCompiledQueryFilter.h"
 #include "ISMRuntimeComponent.h"
 #include "ISMInstanceHandle.h"
 #include "ISMInstanceState.h"
@@ -23,22 +24,14 @@ bool FISMQueryFilter::PassesFilter(const FISMInstanceReference& Instance) const
 
     // ===== Gameplay Tag Filtering =====
 
-    FGameplayTagContainer InstanceTags = Comp->GetInstanceTags(Instance.InstanceIndex);
-
-    // Required tags check
-    if (RequiredTags.Num() > 0 && !InstanceTags.HasAll(RequiredTags))
-    {
-        return false;
-    }
-
-    // Excluded tags check
-    if (ExcludedTags.Num() > 0 && InstanceTags.HasAny(ExcludedTags))
+    // Required/excluded tags are tested in place - no merged container
+    if (!Comp->InstancePassesTagFilter(Instance.InstanceIndex, RequiredTags, ExcludedTags))
     {
         return false;
     }
 
-    // Tag query check (most flexible)
-    if (!TagQuery.IsEmpty() && !TagQuery.Matches(InstanceTags))
+    // Tag query check (most flexible) - needs the full effective container
+    if (!TagQuery.IsEmpty() && !TagQuery.Matches(Comp->GetInstanceTags(Instance.InstanceIndex)))
     {
         return false;
     }
@@ -60,9 +53,7 @@ bool FISMQueryFilter::PassesFilter(const FISMInstanceReference& Instance) const
 
     // ===== State Filtering =====
 
-    const FISMInstanceState* State = Comp->GetInstanceState(Instance.InstanceIndex);
-
-    if (!PassesStateFilter(State))
+    if (!PassesStateFilter(Comp->HasInstanceState(Instance.InstanceIndex), Comp->GetInstanceStateFlags(Instance.InstanceIndex)))
     {
         return false;
     }
@@ -112,7 +103,7 @@ bool FISMQueryFilter::PassesFilter(const FISMInstanceReference& Instance) const
     return true;
 }
 
-bool FISMQueryFilter::PassesComponentFilter(UISMRuntimeComponent* Component) const
+bool FISMQueryFilter::PassesComponentFilter(UISMRuntimeComponent* Component, bool bTagSetsMatched) const
 {
     if (!Component)
     {
@@ -122,13 +113,13 @@ bool FISMQueryFilter::PassesComponentFilter(UISMRuntimeComponent* Component) con
     // ===== Tag Filtering (Component Level) =====
 
     // Required tags - component must have ALL of them
-    if (RequiredTags.Num() > 0 && !Component->ISMComponentTags.HasAll(RequiredTags))
+    if (!bTagSetsMatched && RequiredTags.Num() > 0 && !Component->ISMComponentTags.HasAll(RequiredTags))
     {
         return false;
     }
 
     // Excluded tags - component must have NONE of them
-    if (ExcludedTags.Num() > 0 && Component->ISMComponentTags.HasAny(ExcludedTags))
+    if (!bTagSetsMatched && ExcludedTags.Num() > 0 && Component->ISMComponentTags.HasAny(ExcludedTags))
     {
         return false;
     }
@@ -170,9 +161,9 @@ bool FISMQueryFilter::PassesComponentFilter(UISMRuntimeComponent* Component) con
     return true;
 }
 
-bool FISMQueryFilter::PassesStateFilter(const FISMInstanceState* State) const
+bool FISMQueryFilter::PassesStateFilter(bool bHasState, uint8 StateFlags) const
 {
-    if (!State)
+    if (!bHasState)
     {
         // If no state exists, check if we require specific states
         return RequiredStates.Num() == 0;
@@ -181,7 +172,7 @@ bool FISMQueryFilter::PassesStateFilter(const FISMInstanceState* State) const
     // Required states - instance must have ALL of them
     for (EISMInstanceState RequiredState : RequiredStates)
     {
-        if (!State->HasFlag(RequiredState))
+        if ((StateFlags & static_cast<uint8>(RequiredState)) == 0)
         {
             return false;
         }
@@ -190,11 +181,16 @@ bool FISMQueryFilter::PassesStateFilter(const FISMInstanceState* State) const
     // Excluded states - instance must have NONE of them
     for (EISMInstanceState ExcludedState : ExcludedStates)
     {
-        if (State->HasFlag(ExcludedState))
+        if ((StateFlags & static_cast<uint8>(ExcludedState)) != 0)
         {
             return false;
         }
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+FISMCompiledQueryFilter FISMQueryFilter::Compile() const
+{
+    return FISMCompiledQueryFilter(*this);
+}
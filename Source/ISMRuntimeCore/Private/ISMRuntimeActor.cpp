@@ -3,6 +3,7 @@
 #include "ISMRuntimeActor.h"
 #include "Feedbacks/ISMFeedbackTags.h"
 #include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
 #include "ISMInstanceDataAsset.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/PrimitiveComponent.h"
@@ -303,10 +304,7 @@ TArray<FISMInstanceHandle> AISMRuntimeActor::QueryInstancesInRadius(
 
         for (int32 InstanceIndex : Instances)
         {
-            FISMInstanceHandle Handle;
-            Handle.InstanceIndex = InstanceIndex;
-            Handle.Component = Comp;
-            Results.Add(Handle);
+            Results.Add(UISMRuntimeSubsystem::MakeInstanceReference(Comp, InstanceIndex));
         }
     }
 
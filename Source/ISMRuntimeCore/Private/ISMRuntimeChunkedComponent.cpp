@@ -0,0 +1,454 @@
+// ISMRuntimeChunkedComponent.cpp
+#include "ISMRuntimeChunkedComponent.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMInstanceDataAsset.h"
+#include "ISMQueryFilter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Algo/Count.h"
+
+UISMRuntimeChunkedComponent::UISMRuntimeChunkedComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    ChunkClass = UISMRuntimeComponent::StaticClass();
+}
+
+void UISMRuntimeChunkedComponent::EndPlay(const EEndPlayReason::Type EndReason)
+{
+    ResetChunks();
+
+    Super::EndPlay(EndReason);
+}
+
+// ===== Instances =====
+
+int32 UISMRuntimeChunkedComponent::AddInstance(const FTransform& Transform, bool bTriggerFeedbacks)
+{
+    const int32 Chunk = FindOrAddOpenChunk(GetRegion(Transform.GetLocation()), 1);
+    if (Chunk == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    // May recycle a destroyed slot of the chunk, which BindLocalIndex takes from its old logical owner
+    const int32 LocalIndex = Chunks[Chunk].Component->AddInstance(Transform, true, bTriggerFeedbacks, this);
+    if (LocalIndex == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 LogicalIndex = Locations.AddElement(FISMChunkedInstanceLocation());
+    BindLocalIndex(Chunk, LocalIndex, LogicalIndex);
+    return LogicalIndex;
+}
+
+TArray<int32> UISMRuntimeChunkedComponent::BatchAddInstances(const TArray<FTransform>& Transforms, TConstArrayView<float> CustomData, int32 CustomDataStride)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeChunkedComponent::BatchAddInstances);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
+    TArray<int32> LogicalIndices;
+    LogicalIndices.Init(INDEX_NONE, Transforms.Num());
+
+    if (CustomDataStride < 0 || (CustomDataStride > 0 && CustomData.Num() != Transforms.Num() * CustomDataStride))
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeChunkedComponent: %s got %d custom data floats for %d instances of stride %d"),
+            *GetName(), CustomData.Num(), Transforms.Num(), CustomDataStride);
+        return LogicalIndices;
+    }
+    if (Transforms.Num() == 0)
+    {
+        return LogicalIndices;
+    }
+
+    // Bucket by region, keeping input order inside each bucket
+    TMap<FIntPoint, TArray<int32>> InputsByRegion;
+    for (int32 i = 0; i < Transforms.Num(); i++)
+    {
+        InputsByRegion.FindOrAdd(GetRegion(Transforms[i].GetLocation())).Add(i);
+    }
+
+    // Where each input landed; logical indices are only taken for those once the chunks are done
+    TArray<FISMChunkedInstanceLocation> Placed;
+    Placed.SetNum(Transforms.Num());
+    int32 NumPlaced = 0;
+
+    TArray<FTransform> ChunkTransforms;
+    TArray<float> ChunkCustomData;
+    bool bFailed = false;
+    for (const TPair<FIntPoint, TArray<int32>>& Pair : InputsByRegion)
+    {
+        const TArray<int32>& Inputs = Pair.Value;
+        for (int32 Start = 0; Start < Inputs.Num() && !bFailed;)
+        {
+            const int32 Chunk = FindOrAddOpenChunk(Pair.Key, 1);
+            if (Chunk == INDEX_NONE)
+            {
+                bFailed = true;
+                break;
+            }
+
+            // Fill the open chunk up to its limit; the rest open the next one
+            UISMRuntimeComponent* Component = Chunks[Chunk].Component;
+            const int32 NumTaken = FMath::Min(Inputs.Num() - Start, MaxInstancesPerChunk - Component->GetInstanceCount());
+
+            ChunkTransforms.Reset(NumTaken);
+            ChunkCustomData.Reset(NumTaken * CustomDataStride);
+            for (int32 i = Start; i < Start + NumTaken; i++)
+            {
+                ChunkTransforms.Add(Transforms[Inputs[i]]);
+                if (CustomDataStride > 0)
+                {
+                    ChunkCustomData.Append(CustomData.Slice(Inputs[i] * CustomDataStride, CustomDataStride));
+                }
+            }
+
+            const TArray<int32> LocalIndices = Component->BulkAppendInstances(ChunkTransforms, ChunkCustomData, CustomDataStride);
+            if (LocalIndices.Num() != NumTaken)
+            {
+                bFailed = true;
+                break;
+            }
+
+            for (int32 i = 0; i < NumTaken; i++)
+            {
+                Placed[Inputs[Start + i]] = { Chunk, LocalIndices[i] };
+            }
+            NumPlaced += NumTaken;
+            Start += NumTaken;
+        }
+        if (bFailed)
+        {
+            break;
+        }
+    }
+
+    // Logical indices follow input order whatever chunk each instance lands in
+    if (NumPlaced > 0)
+    {
+        int32 NextLogical = Locations.Add(NumPlaced);
+        for (int32 Input = 0; Input < Transforms.Num(); Input++)
+        {
+            if (Placed[Input].IsValid())
+            {
+                BindLocalIndex(Placed[Input].Chunk, Placed[Input].LocalIndex, NextLogical);
+                LogicalIndices[Input] = NextLogical++;
+            }
+        }
+    }
+
+    return LogicalIndices;
+}
+
+int32 UISMRuntimeChunkedComponent::AdoptInstances(UInstancedStaticMeshComponent* Source, bool bClearSource)
+{
+    if (!Source || Source->GetInstanceCount() == 0)
+    {
+        return 0;
+    }
+
+    const int32 NumInstances = Source->GetInstanceCount();
+    TArray<FTransform> Transforms;
+    Transforms.SetNumUninitialized(NumInstances);
+    for (int32 i = 0; i < NumInstances; i++)
+    {
+        Source->GetInstanceTransform(i, Transforms[i], true);
+    }
+
+    const int32 Stride = Source->NumCustomDataFloats;
+    const bool bCopyCustomData = Stride > 0 && Source->PerInstanceSMCustomData.Num() == NumInstances * Stride;
+
+    const TArray<int32> LogicalIndices = BatchAddInstances(Transforms,
+        bCopyCustomData ? TConstArrayView<float>(Source->PerInstanceSMCustomData) : TConstArrayView<float>(),
+        bCopyCustomData ? Stride : 0);
+
+    if (bClearSource)
+    {
+        Source->ClearInstances();
+    }
+
+    return LogicalIndices.Num() - Algo::Count(LogicalIndices, INDEX_NONE);
+}
+
+void UISMRuntimeChunkedComponent::DestroyInstance(int32 LogicalIndex, bool bTriggerFeedbacks)
+{
+    int32 LocalIndex;
+    if (UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex))
+    {
+        Component->DestroyInstance(LocalIndex, false, bTriggerFeedbacks, this);
+    }
+}
+
+void UISMRuntimeChunkedComponent::BatchDestroyInstances(TConstArrayView<int32> LogicalIndices, bool bTriggerFeedbacks)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeChunkedComponent::BatchDestroyInstances);
+
+    TMap<int32, TArray<int32>> LocalByChunk;
+    for (const int32 LogicalIndex : LogicalIndices)
+    {
+        int32 LocalIndex;
+        if (ResolveInstance(LogicalIndex, LocalIndex))
+        {
+            LocalByChunk.FindOrAdd(Locations[LogicalIndex].Chunk).Add(LocalIndex);
+        }
+    }
+
+    for (const TPair<int32, TArray<int32>>& Pair : LocalByChunk)
+    {
+        Chunks[Pair.Key].Component->BatchDestroyInstances(Pair.Value, false, bTriggerFeedbacks, this);
+    }
+}
+
+void UISMRuntimeChunkedComponent::UpdateInstanceTransform(int32 LogicalIndex, const FTransform& NewTransform)
+{
+    int32 LocalIndex;
+    if (UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex))
+    {
+        // Widens the chunk's bounds (a cell-local refresh) so queries still reach an instance moved out of its region
+        Component->UpdateInstanceTransform(LocalIndex, NewTransform, true, true, true, this);
+    }
+}
+
+void UISMRuntimeChunkedComponent::SetInstanceState(int32 LogicalIndex, EISMInstanceState State, bool bValue)
+{
+    int32 LocalIndex;
+    if (UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex))
+    {
+        Component->SetInstanceState(LocalIndex, State, bValue);
+    }
+}
+
+void UISMRuntimeChunkedComponent::SetInstanceCustomDataValue(int32 LogicalIndex, int32 DataIndex, float Value)
+{
+    int32 LocalIndex;
+    if (UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex))
+    {
+        Component->SetInstanceCustomDataValue(LocalIndex, DataIndex, Value);
+    }
+}
+
+bool UISMRuntimeChunkedComponent::IsInstanceDestroyed(int32 LogicalIndex) const
+{
+    int32 LocalIndex;
+    const UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex);
+    return !Component || Component->IsInstanceDestroyed(LocalIndex);
+}
+
+FTransform UISMRuntimeChunkedComponent::GetInstanceTransform(int32 LogicalIndex) const
+{
+    int32 LocalIndex;
+    const UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex);
+    return Component ? Component->GetInstanceTransform(LocalIndex) : FTransform::Identity;
+}
+
+FISMInstanceHandle UISMRuntimeChunkedComponent::GetInstanceHandle(int32 LogicalIndex) const
+{
+    int32 LocalIndex;
+    UISMRuntimeComponent* Component = ResolveInstance(LogicalIndex, LocalIndex);
+    return Component ? Component->GetInstanceHandle(LocalIndex) : FISMInstanceHandle();
+}
+
+void UISMRuntimeChunkedComponent::QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter, TArray<int32>& OutLogicalIndices) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeChunkedComponent::QueryInstances);
+
+    const float RadiusSq = Radius * Radius;
+    TArray<int32> LocalIndices;
+    for (const FISMInstanceChunk& Chunk : Chunks)
+    {
+        if (!Chunk.Component)
+        {
+            continue;
+        }
+
+        // The runtime component's bounds follow every add and move at once; the ISM's own wait for
+        // the render update, which headless worlds never run
+        const UISMRuntimeComponent* Component = Chunk.Component;
+        if (Component->IsBoundsValid() && Component->GetInstanceBounds().ComputeSquaredDistanceToPoint(Location) > RadiusSq)
+        {
+            continue;
+        }
+
+        LocalIndices.Reset();
+        Chunk.Component->QueryInstances(Location, Radius, Filter, LocalIndices);
+        for (const int32 LocalIndex : LocalIndices)
+        {
+            if (Chunk.LogicalIndices.IsValidIndex(LocalIndex) && Chunk.LogicalIndices[LocalIndex] != INDEX_NONE)
+            {
+                OutLogicalIndices.Add(Chunk.LogicalIndices[LocalIndex]);
+            }
+        }
+    }
+}
+
+// ===== Logical Space =====
+
+int32 UISMRuntimeChunkedComponent::GetActiveInstanceCount() const
+{
+    int32 NumActive = 0;
+    for (const FISMInstanceChunk& Chunk : Chunks)
+    {
+        NumActive += Chunk.Component ? Chunk.Component->GetActiveInstanceCount() : 0;
+    }
+    return NumActive;
+}
+
+int32 UISMRuntimeChunkedComponent::GetLogicalIndex(const UISMRuntimeComponent* Chunk, int32 LocalIndex) const
+{
+    const int32* ChunkIndex = ChunkByComponent.Find(Chunk);
+    if (!ChunkIndex)
+    {
+        return INDEX_NONE;
+    }
+
+    const TArray<int32>& LogicalIndices = Chunks[*ChunkIndex].LogicalIndices;
+    return LogicalIndices.IsValidIndex(LocalIndex) ? LogicalIndices[LocalIndex] : INDEX_NONE;
+}
+
+// ===== Chunks =====
+
+FIntPoint UISMRuntimeChunkedComponent::GetRegion(const FVector& Location) const
+{
+    const float Size = FMath::Max(ChunkSize, 1.0f);
+    return FIntPoint(FMath::FloorToInt(Location.X / Size), FMath::FloorToInt(Location.Y / Size));
+}
+
+void UISMRuntimeChunkedComponent::ResetChunks()
+{
+    for (FISMInstanceChunk& Chunk : Chunks)
+    {
+        if (Chunk.Component)
+        {
+            Chunk.Component->DestroyComponent();
+        }
+        if (Chunk.ISM)
+        {
+            Chunk.ISM->DestroyComponent();
+        }
+    }
+
+    Chunks.Empty();
+    Locations.Empty();
+    OpenChunkByRegion.Empty();
+    ChunkByComponent.Empty();
+}
+
+SIZE_T UISMRuntimeChunkedComponent::GetAllocatedSize() const
+{
+    SIZE_T Size = Chunks.GetAllocatedSize() + Locations.GetAllocatedSize()
+        + OpenChunkByRegion.GetAllocatedSize() + ChunkByComponent.GetAllocatedSize();
+    for (const FISMInstanceChunk& Chunk : Chunks)
+    {
+        Size += Chunk.LogicalIndices.GetAllocatedSize();
+    }
+    return Size;
+}
+
+int32 UISMRuntimeChunkedComponent::FindOrAddOpenChunk(const FIntPoint& Region, int32 NumNew)
+{
+    if (const int32* Open = OpenChunkByRegion.Find(Region))
+    {
+        const UISMRuntimeComponent* Component = Chunks[*Open].Component;
+        if (Component && Component->GetInstanceCount() + NumNew <= MaxInstancesPerChunk)
+        {
+            return *Open;
+        }
+    }
+
+    const int32 Chunk = CreateChunk(Region);
+    if (Chunk != INDEX_NONE)
+    {
+        OpenChunkByRegion.Add(Region, Chunk);
+    }
+    return Chunk;
+}
+
+int32 UISMRuntimeChunkedComponent::CreateChunk(const FIntPoint& Region)
+{
+    AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return INDEX_NONE;
+    }
+
+    LLM_SCOPE_BYTAG(ISMRuntime);
+
+    const int32 ChunkIndex = Chunks.Num();
+    const FString BaseName = FString::Printf(TEXT("%s_Chunk_%d_%d"), *GetName(), Region.X, Region.Y);
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Owner,
+        MakeUniqueObjectName(Owner, UInstancedStaticMeshComponent::StaticClass(), FName(*(BaseName + TEXT("_ISM")))), RF_Transient);
+    ISM->NumCustomDataFloats = NumCustomDataFloats;
+    ISM->SetCollisionProfileName(CollisionProfileName);
+    if (USceneComponent* Root = Owner->GetRootComponent())
+    {
+        ISM->SetupAttachment(Root);
+    }
+    Owner->AddInstanceComponent(ISM);
+    ISM->RegisterComponent();
+
+    UClass* Class = ChunkClass ? ChunkClass.Get() : UISMRuntimeComponent::StaticClass();
+    UISMRuntimeComponent* Component = NewObject<UISMRuntimeComponent>(Owner, Class,
+        MakeUniqueObjectName(Owner, Class, FName(*BaseName)), RF_Transient);
+    Component->ManagedISMComponent = ISM;
+    if (InstanceData)
+    {
+        Component->SetInstanceDataAsset(InstanceData);
+    }
+    Owner->AddInstanceComponent(Component);
+    Component->RegisterComponent();
+
+    if (!Component->InitializeInstances())
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeChunkedComponent: %s could not initialize chunk %s"), *GetName(), *BaseName);
+        Component->DestroyComponent();
+        ISM->DestroyComponent();
+        return INDEX_NONE;
+    }
+
+    FISMInstanceChunk& Chunk = Chunks.AddDefaulted_GetRef();
+    Chunk.Component = Component;
+    Chunk.ISM = ISM;
+    Chunk.Region = Region;
+    ChunkByComponent.Add(Component, ChunkIndex);
+    return ChunkIndex;
+}
+
+void UISMRuntimeChunkedComponent::BindLocalIndex(int32 Chunk, int32 LocalIndex, int32 LogicalIndex)
+{
+    TArray<int32>& LogicalIndices = Chunks[Chunk].LogicalIndices;
+    if (LocalIndex >= LogicalIndices.Num())
+    {
+        LogicalIndices.Reserve(FMath::Min(FMath::Max(LocalIndex + 1, LogicalIndices.Num() * 2), MaxInstancesPerChunk));
+        while (LogicalIndices.Num() <= LocalIndex)
+        {
+            LogicalIndices.Add(INDEX_NONE);
+        }
+    }
+    else if (LogicalIndices[LocalIndex] != INDEX_NONE)
+    {
+        // A recycled slot: its previous occupant is gone
+        Locations[LogicalIndices[LocalIndex]] = FISMChunkedInstanceLocation();
+    }
+
+    LogicalIndices[LocalIndex] = LogicalIndex;
+    Locations[LogicalIndex] = { Chunk, LocalIndex };
+}
+
+UISMRuntimeComponent* UISMRuntimeChunkedComponent::ResolveInstance(int32 LogicalIndex, int32& OutLocalIndex) const
+{
+    if (LogicalIndex < 0 || LogicalIndex >= Locations.Num())
+    {
+        return nullptr;
+    }
+
+    const FISMChunkedInstanceLocation& Location = Locations[LogicalIndex];
+    if (!Location.IsValid() || !Chunks.IsValidIndex(Location.Chunk))
+    {
+        return nullptr;
+    }
+
+    OutLocalIndex = Location.LocalIndex;
+    return Chunks[Location.Chunk].Component;
+}
@@ -2,20 +2,85 @@
 // Published by Procedural Architect
 // ISMRuntimeComponent.cpp
 #include "ISMRuntimeComponent.h"
+#include "ISMBakedInstanceState.h"
 #include "ISMRuntimeSubsystem.h"
+#include "ISMRuntimeProfiling.h"
 #include "ISMInstanceDataAsset.h"
+#include "ISMNearestSelection.h"
+#include "ISMCompiledQueryFilter.h"
+#include "Batching/ISMBatchTypes.h"
 #include "GameplayTagContainer.h"
 #include "Feedbacks/ISMFeedbackContext.h"
 #include "Feedbacks/ISMFeedbackTags.h"
 #include "Feedbacks/ISMFeedbackSubsystem.h"
+#include "CustomData/ISMCustomDataSubsystem.h"
+#include "Settings/ISMRuntimeSchemaSettings.h"
+#include "Settings/ISMRuntimeSettings.h"
+#include "Engine/GameInstance.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "GameplayTagsManager.h"
 #include "Engine/World.h"
+#include "Algo/StableSort.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 DEFINE_LOG_CATEGORY(LogISMRuntimeCore);
 DEFINE_LOG_CATEGORY(LogISMTrace);
 
+namespace
+{
+    /** Below this many instances InitializeInstances reads transforms on the calling thread */
+    constexpr int32 ParallelInitMinInstances = 2048;
+
+    /** What InitializeInstances computes per instance before touching any shared state */
+    struct FInstanceInitData
+    {
+        TArray<FVector> Locations;
+
+        /** Base-grid cell per location, when requested */
+        TArray<FIntVector> Cells;
+
+        /** World AABBs; empty when the component records none */
+        TArray<FBox> Bounds;
+    };
+
+    /**
+     * Locations, base cells (bWithCells) and, for a valid LocalBounds, AABBs of ISM instances [FirstIndex, FirstIndex + NumInstances).
+     * Reads PerInstanceSMData directly - GetInstanceTransform range-checks and copies per call.
+     */
+    void ReadInstanceInitData(const UInstancedStaticMeshComponent& ISM, const FISMSpatialIndex& SpatialIndex, const FBox& LocalBounds,
+        int32 FirstIndex, int32 NumInstances, bool bWithCells, FInstanceInitData& Out)
+    {
+        const TArray<FInstancedStaticMeshInstanceData>& SMData = ISM.PerInstanceSMData;
+        const FTransform ComponentTransform = ISM.GetComponentTransform();
+        const bool bComputeBounds = LocalBounds.IsValid != 0;
+
+        Out.Locations.SetNumUninitialized(NumInstances);
+        Out.Cells.SetNumUninitialized(bWithCells ? NumInstances : 0);
+        Out.Bounds.SetNumUninitialized(bComputeBounds ? NumInstances : 0);
+
+        // Every index writes only its own slots; small ranges are not worth waking the workers for
+        ParallelFor(NumInstances, [&](int32 i)
+            {
+                const FTransform WorldTransform = FTransform(SMData[FirstIndex + i].Transform) * ComponentTransform;
+                Out.Locations[i] = WorldTransform.GetLocation();
+                if (bWithCells)
+                {
+                    Out.Cells[i] = SpatialIndex.WorldLocationToCell(Out.Locations[i]);
+                }
+                if (bComputeBounds)
+                {
+                    Out.Bounds[i] = LocalBounds.TransformBy(WorldTransform);
+                }
+            }, NumInstances >= ParallelInitMinInstances ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+    }
+}
+
 
 UISMRuntimeComponent::UISMRuntimeComponent()
 {
@@ -30,30 +95,67 @@ void UISMRuntimeComponent::BeginPlay()
 {
     Super::BeginPlay();
 
-    // Auto-initialize on begin play
+    // Auto-initialize on begin play; time-sliced components are built by the subsystem's init queue
     if (!bIsInitialized)
     {
-        InitializeInstances();
-        RecalculateInstanceBounds();
+        UWorld* World = GetWorld();
+        StartInitialization(UsesTimeSlicedInit() && World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr);
     }
     
     // Register with subsystem
     RegisterWithSubsystem();
+
+    // Managed tick mode: hand a tick function that started enabled over to the subsystem
+    if (UsesManagedTick() && IsComponentTickEnabled())
+    {
+        ManagedTickInterval = PrimaryComponentTick.TickInterval;
+        SetComponentTickEnabled(false);
+        SetRuntimeTickEnabled(true);
+    }
+    
+    // Let feedback providers start streaming the assets behind our tags
+    const FISMFeedbackTags EffectiveFeedbackTags = GetEffectiveFeedbackTags();
+    if (EffectiveFeedbackTags.HasAnyTags() && !bHeadless)
+    {
+        if (UISMFeedbackSubsystem* FeedbackSubsystem = GetFeedbackSubsystem())
+        {
+            FeedbackSubsystem->NotifyFeedbackTagsRelevant(EffectiveFeedbackTags.GetAllTags());
+        }
+    }
 }
 
 void UISMRuntimeComponent::EndPlay(const EEndPlayReason::Type EndReason)
 {
+    // Listeners still hear what changed before the component goes away
+    FlushInstanceEvents();
+
     // Unregister from subsystem
+    SetRuntimeTickEnabled(false);
     UnregisterFromSubsystem();
 
     // Return all converted instances
     ReturnAllConvertedInstances(true, false);
 
-    // Clear all data
+    // Clear all data; a queued initialization is dropped with it
+    bInitializing = false;
+    InitInstanceCount = 0;
+    NumInitializedInstances = 0;
+    bIsDormant = false;
+    DormantState.Reset();
     InstanceHandles.Empty();
-    InstanceStates.Empty();
+    InstanceStates.Reset();
+    InstanceColumns.ResetData();
     PerInstanceTags.Empty();
+    CompactInstanceTags.Reset();
     SpatialIndex.Clear();
+    BumpAllCellStructureGenerations();
+    ChangeTracker.Reset();
+    CustomDataJournal.MarkReset();
+    CellBounds.Reset(SpatialIndexCellSize);
+    {
+        FWriteScopeLock WriteLock(SnapshotLock);
+        SpatialIndexSnapshot.Reset();
+    }
 
     Super::EndPlay(EndReason);
 }
@@ -72,987 +174,3707 @@ void UISMRuntimeComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
             return; // Skip this tick
         }
 
+        DeltaTime = TimeSinceLastTick;
         TimeSinceLastTick = 0.0f;
     }
 
-    // Subclasses can override to add custom tick logic
+    if (HasParallelRuntimeTick())
+    {
+        TickRuntimeParallel(DeltaTime);
+    }
+    TickRuntime(DeltaTime);
 }
 
-bool UISMRuntimeComponent::InitializeInstances()
+bool UISMRuntimeComponent::UsesManagedTick() const
 {
-    if (bIsInitialized)
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    return bUseManagedTick || (Settings && Settings->bManagedComponentTick);
+}
+
+bool UISMRuntimeComponent::UsesTimeSlicedInit() const
+{
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    return bTimeSlicedInit || (Settings && Settings->bTimeSlicedComponentInit);
+}
+
+bool UISMRuntimeComponent::IsInstanceInitialized(int32 InstanceIndex) const
+{
+    if (bInitializing)
     {
-        return true; // Already initialized
+        return InstanceIndex >= 0 && InstanceIndex < NumInitializedInstances;
     }
+    return bIsInitialized && IsValidInstanceIndex(InstanceIndex);
+}
 
-    if (!ManagedISMComponent)
+void UISMRuntimeComponent::SetRuntimeTickEnabled(bool bEnabled)
+{
+    UWorld* World = GetWorld();
+    UISMRuntimeSubsystem* Subsystem = CachedSubsystem.IsValid() ? CachedSubsystem.Get()
+        : (World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr);
+    if (!UsesManagedTick() || !Subsystem)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: No ManagedISMComponent set on %s"), *GetOwner()->GetName());
-        return false;
+        SetComponentTickEnabled(bEnabled);
+        return;
     }
 
-    // Apply data asset settings if available
-    if (InstanceData)
+    if (bEnabled)
     {
-        if (InstanceData->StaticMesh && !ManagedISMComponent->GetStaticMesh())
-        {
-            ManagedISMComponent->SetStaticMesh(InstanceData->StaticMesh);
-        }
-
-        // Apply material overrides
-        for (int32 i = 0; i < InstanceData->MaterialOverrides.Num(); i++)
-        {
-            if (InstanceData->MaterialOverrides[i])
-            {
-                ManagedISMComponent->SetMaterial(i, InstanceData->MaterialOverrides[i]);
-            }
-        }
+        Subsystem->RegisterManagedTick(this);
+    }
+    else
+    {
+        Subsystem->UnregisterManagedTick(this);
+    }
+}
 
-        // Use recommended cell size from data asset
-        if (InstanceData->RecommendedCellSize > 0.0f)
-        {
-            SpatialIndexCellSize = InstanceData->RecommendedCellSize;
-        }
+void UISMRuntimeComponent::SetRuntimeTickInterval(float Interval)
+{
+    if (!UsesManagedTick())
+    {
+        SetComponentTickInterval(Interval);
+        return;
     }
 
-    // Build component tags (let subclasses add their specific tags)
-    BuildComponentTags();
+    // The subsystem picks the new interval up after the next tick
+    ManagedTickInterval = FMath::Max(Interval, 0.0f);
+}
 
-    // Initialize spatial index
-    SpatialIndex = FISMSpatialIndex(SpatialIndexCellSize);
+bool UISMRuntimeComponent::IsRuntimeTickEnabled() const
+{
+    return ManagedTickIndex != INDEX_NONE || IsComponentTickEnabled();
+}
 
-    // Index all existing instances
-    int32 InstanceCount = ManagedISMComponent->GetInstanceCount();
-    TArray<FVector> InstanceLocations;
-    InstanceLocations.Reserve(InstanceCount);
+float UISMRuntimeComponent::GetManagedTickInterval() const
+{
+    return FMath::Max(ManagedTickInterval, bEnableTickOptimization ? TickInterval : 0.0f);
+}
 
-    for (int32 i = 0; i < InstanceCount; i++)
-    {
-        FTransform InstanceTransform;
-        ManagedISMComponent->GetInstanceTransform(i, InstanceTransform, true);
-        if (ManagedISMComponent->NumCustomDataFloats > 0)
-        {
-            TArray<float> CustomData;
-			CustomData.Reserve(ManagedISMComponent->NumCustomDataFloats);
-			
-			//InstanceCustomDataCache.Add(i, CustomData);
-        }
-        InstanceLocations.Add(InstanceTransform.GetLocation());
+void UISMRuntimeComponent::ApplyMortonOrder()
+{
+    InitialIndexRemap.Reset();
 
-        // Initialize state for this instance
-        FISMInstanceState& State = InstanceStates.Add(i);
-        State.LastUpdateFrame = GFrameCounter;
-        State.CachedTransform = InstanceTransform;
-        State.bTransformCached = true;
-        State.LastVisibleTransform = InstanceTransform;
-        State.bHasLastVisibleTransform = (InstanceTransform.GetScale3D() != FVector::ZeroVector);
+    const int32 InstanceCount = ManagedISMComponent->GetInstanceCount();
+    if (InstanceCount < 2)
+    {
+        return;
     }
 
-    // Build spatial index from all instances
-    SpatialIndex.Rebuild(InstanceLocations);
-
-    bIsInitialized = true;
-
-    // Enable tick if needed
-    if (TickInterval > 0.0f || !bEnableTickOptimization)
+    TArray<FTransform> Transforms;
+    Transforms.SetNum(InstanceCount);
+    FBox LocationBounds(EForceInit::ForceInit);
+    for (int32 i = 0; i < InstanceCount; i++)
     {
-        PrimaryComponentTick.SetTickFunctionEnable(true);
+        ManagedISMComponent->GetInstanceTransform(i, Transforms[i], true);
+        LocationBounds += Transforms[i].GetLocation();
     }
-    
-    RecalculateInstanceBounds();
-
-    if (!RegisterWithSubsystem())
-        return false;
-
-    // Notify subclasses
-    OnInitializationComplete();
-
-    UE_LOG(LogTemp, Log, TEXT("ISMRuntimeComponent: Initialized %d instances on %s"),
-        InstanceCount, *GetOwner()->GetName());
 
+    // Quantize into the 21-bit-per-axis Morton grid over the instances' own bounds
+    const FVector Extent = LocationBounds.GetSize();
+    const FVector Scale(
+        Extent.X > UE_KINDA_SMALL_NUMBER ? 2097151.0 / Extent.X : 0.0,
+        Extent.Y > UE_KINDA_SMALL_NUMBER ? 2097151.0 / Extent.Y : 0.0,
+        Extent.Z > UE_KINDA_SMALL_NUMBER ? 2097151.0 / Extent.Z : 0.0);
 
-    return true;
-}
+    TArray<TPair<uint64, int32>> Codes;
+    Codes.Reserve(InstanceCount);
+    for (int32 i = 0; i < InstanceCount; i++)
+    {
+        const FVector Q = (Transforms[i].GetLocation() - LocationBounds.Min) * Scale;
+        Codes.Emplace(FISMSpatialIndex::EncodeMorton3D(
+            static_cast<uint32>(Q.X), static_cast<uint32>(Q.Y), static_cast<uint32>(Q.Z)), i);
+    }
 
-#pragma region REDIRECTS
+    // Stable so coincident instances keep their authored order
+    Algo::StableSortBy(Codes, [](const TPair<uint64, int32>& Code) { return Code.Key; });
 
-void UISMRuntimeComponent::AddRedirector(UPrimitiveComponent* Component)
-{
-    if (Component || Component && !Redirectors.Contains(Component))
+    bool bAlreadyOrdered = true;
+    InitialIndexRemap.SetNumUninitialized(InstanceCount);
+    for (int32 NewIndex = 0; NewIndex < InstanceCount; NewIndex++)
     {
-        Redirectors.Add(Component);
-        if (CachedSubsystem.IsValid())
-        {
-            CachedSubsystem->RegisterComponentRedirect(Component, this);
-        }
+        InitialIndexRemap[Codes[NewIndex].Value] = NewIndex;
+        bAlreadyOrdered &= (Codes[NewIndex].Value == NewIndex);
     }
-}
 
-void UISMRuntimeComponent::RegisterAllRedirects()
-{
-    if (!CachedSubsystem.IsValid())
+    if (bAlreadyOrdered)
     {
         return;
     }
-    for (UPrimitiveComponent* Redirector : Redirectors)
-    {
-        if (Redirector)
-        {
-            CachedSubsystem->RegisterComponentRedirect(Redirector, this);
-        }
-    }
-}
 
-void UISMRuntimeComponent::UnregisterAllRedirects()
-{
-    if (!CachedSubsystem.IsValid())
+    TArray<FTransform> SortedTransforms;
+    SortedTransforms.Reserve(InstanceCount);
+    for (const TPair<uint64, int32>& Code : Codes)
     {
-        return;
+        SortedTransforms.Add(Transforms[Code.Value]);
     }
-    for (UPrimitiveComponent* Redirector : Redirectors)
+
+    // Custom data moves with its instance
+    const int32 NumCustomData = ManagedISMComponent->NumCustomDataFloats;
+    if (NumCustomData > 0 && ManagedISMComponent->PerInstanceSMCustomData.Num() == InstanceCount * NumCustomData)
     {
-        if (Redirector)
+        const TArray<float> OldCustomData = ManagedISMComponent->PerInstanceSMCustomData;
+        for (int32 NewIndex = 0; NewIndex < InstanceCount; NewIndex++)
         {
-            CachedSubsystem->UnregisterComponentRedirect(Redirector, this);
+            const int32 OldIndex = Codes[NewIndex].Value;
+            ManagedISMComponent->SetCustomData(NewIndex,
+                TArrayView<const float>(OldCustomData.GetData() + OldIndex * NumCustomData, NumCustomData));
         }
     }
-}
-
-#pragma endregion
 
+    ManagedISMComponent->BatchUpdateInstancesTransforms(0, SortedTransforms, true, !bHeadless, true);
 
+    UE_LOG(LogISMRuntimeCore, Verbose, TEXT("ISMRuntimeComponent: Morton-ordered %d instances on %s"),
+        InstanceCount, *GetNameSafe(GetOwner()));
+}
 
-void UISMRuntimeComponent::BuildComponentTags()
+int32 UISMRuntimeComponent::GetRemappedInitialIndex(int32 OriginalIndex) const
 {
-    // Base implementation does nothing
-    // Subclasses override to add their specific tags
-
-    // Apply default tags from data asset
-    if (InstanceData)
+    if (InitialIndexRemap.Num() == 0)
     {
-        ISMComponentTags.AppendTags(InstanceData->DefaultTags);
+        return OriginalIndex;
     }
-}
 
-void UISMRuntimeComponent::OnInitializationComplete()
-{
-    // Base implementation does nothing
-    // Subclasses can override for post-init logic
+    return InitialIndexRemap.IsValidIndex(OriginalIndex) ? InitialIndexRemap[OriginalIndex] : INDEX_NONE;
 }
 
-void UISMRuntimeComponent::DestroyInstance(int32 InstanceIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+bool UISMRuntimeComponent::BakeState(UISMBakedInstanceState* Target) const
 {
-    if (!IsValidInstanceIndex(InstanceIndex))
+    if (!Target || !ManagedISMComponent || !bIsInitialized)
     {
-        return;
+        return false;
     }
-    
-    // Get state
-    FISMInstanceState* State = InstanceStates.Find(InstanceIndex);
-    if (!State)
+
+    Target->Reset();
+    const int32 InstanceCount = ManagedISMComponent->GetInstanceCount();
+    const int32 Stride = ManagedISMComponent->NumCustomDataFloats;
+    Target->ComponentTransform = ManagedISMComponent->GetComponentTransform();
+    Target->SpatialIndexCellSize = SpatialIndexCellSize;
+    Target->NumCustomDataFloats = Stride;
+
+    Target->Transforms.SetNum(InstanceCount);
+    Target->StateFlags.SetNumUninitialized(InstanceCount);
+    Target->InstanceTagOffsets.Reserve(InstanceCount + 1);
+
+    TMap<FGameplayTag, int32> TagIds;
+    FGameplayTagContainer InstanceTags;
+    for (int32 i = 0; i < InstanceCount; i++)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: No state found for instance %d"), InstanceIndex);
-        return;
+        ManagedISMComponent->GetInstanceTransform(i, Target->Transforms[i], false);
+        Target->StateFlags[i] = InstanceStates.GetFlags(i);
+
+        Target->InstanceTagOffsets.Add(Target->InstanceTagIds.Num());
+        InstanceTags.Reset();
+        AppendPerInstanceTags(i, InstanceTags);
+        for (const FGameplayTag& Tag : InstanceTags)
+        {
+            const int32 TagId = TagIds.FindOrAdd(Tag, Target->TagTable.Num());
+            if (TagId == Target->TagTable.Num())
+            {
+                Target->TagTable.Add(Tag);
+            }
+            Target->InstanceTagIds.Add(static_cast<uint16>(TagId));
+        }
     }
-    
-    // Already destroyed?
-    if (State->HasFlag(EISMInstanceState::Destroyed))
+    Target->InstanceTagOffsets.Add(Target->InstanceTagIds.Num());
+
+    if (Target->TagTable.Num() > MAX_uint16)
     {
-        return;
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: Cannot bake %s - %d distinct instance tags (max %d)"),
+            *GetName(), Target->TagTable.Num(), MAX_uint16);
+        Target->Reset();
+        return false;
     }
-    
-    // Cache location before destruction (for bounds check)
-    FVector InstanceLocation = GetInstanceLocation(InstanceIndex);
-    bool bWasOnBoundsEdge = IsLocationOnBoundsEdge(InstanceLocation);
-    
-    // Notify subclass
-    OnInstancePreDestroy(InstanceIndex);
-    
-    // Mark as destroyed
-    State->MarkDestroyed();
-    
-    // Add destroyed tag
-    AddInstanceTag(InstanceIndex, FGameplayTag::RequestGameplayTag("ISM.State.Destroyed"));
-    
-    // Remove intact tag
-    RemoveInstanceTag(InstanceIndex, FGameplayTag::RequestGameplayTag("ISM.State.Intact"));
-    
-    // Hide the instance (scale to zero - cheapest method)
-    FTransform HiddenTransform;
-    ManagedISMComponent->GetInstanceTransform(InstanceIndex, HiddenTransform, true);
-    HiddenTransform.SetScale3D(FVector::ZeroVector);
-    
-    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, HiddenTransform, true, true);
-    
-    // Update cached transform
-    State->CachedTransform = HiddenTransform;
-    State->bTransformCached = true;
-    
-    // Broadcast events
-    BroadcastDestruction(InstanceIndex);
-    BroadcastStateChange(InstanceIndex);
-    
-    // Notify subclass
-    OnInstancePostDestroy(InstanceIndex);
-    
-    // ★ EXPLICIT bounds update (only if requested AND instance was on edge)
-    if (bUpdateBounds && bWasOnBoundsEdge)
+
+    Target->CustomData = ManagedISMComponent->PerInstanceSMCustomData;
+    Target->CustomData.SetNumZeroed(InstanceCount * Stride);
+
+    SpatialIndex.ExportCells(Target->CellKeys, Target->CellOffsets, Target->CellInstances);
+
+    // Everything InitializeInstances would derive from the transforms, so the runtime just adopts it
+    Target->WorldLocations.SetNumUninitialized(InstanceCount);
+    for (int32 i = 0; i < InstanceCount; i++)
+    {
+        Target->WorldLocations[i] = (Target->Transforms[i] * Target->ComponentTransform).GetLocation();
+    }
+
+    bool bAllBounds = InstanceCount > 0;
+    for (int32 i = 0; i < InstanceCount && bAllBounds; i++)
     {
-        RecalculateInstanceBounds(); // O(n) - but explicit!
+        bAllBounds = InstanceStates.HasWorldBounds(i);
     }
-    else if (bBoundsValid && !bWasOnBoundsEdge)
+    if (bAllBounds)
     {
-        // Instance was inside bounds, removal doesn't affect bounds
-        // No recalculation needed - O(1)
+        Target->BoundsMin.SetNumUninitialized(InstanceCount);
+        Target->BoundsMax.SetNumUninitialized(InstanceCount);
+        for (int32 i = 0; i < InstanceCount; i++)
+        {
+            FBox Bounds;
+            InstanceStates.GetWorldBounds(i, Bounds);
+            Target->BoundsMin[i] = FVector3f(Bounds.Min);
+            Target->BoundsMax[i] = FVector3f(Bounds.Max);
+        }
     }
 
-    if(bTriggerFeedbacks)
-		TriggerFeedbackOnDestroyInternal(InstanceIndex, InstigatorComponent);
+    CellBounds.ExportCells(Target->BoundsCellKeys, Target->BoundsCellBoxes, Target->BoundsCellCounts);
+    Target->InstanceBounds = CachedInstanceBounds;
+    Target->SourceHash = UISMBakedInstanceState::ComputeSourceHash(ManagedISMComponent);
+
+    Target->MarkPackageDirty();
+    UE_LOG(LogISMRuntimeCore, Log, TEXT("ISMRuntimeComponent: Baked %d instances, %d cells of %s into %s"),
+        InstanceCount, Target->CellKeys.Num(), *GetName(), *GetNameSafe(Target));
+    return true;
 }
 
-void UISMRuntimeComponent::HideInstance(int32 InstanceIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+namespace
 {
-    if (!IsValidInstanceIndex(InstanceIndex))
+    constexpr uint32 RuntimeStateMagic = 0x53534D49; // "ISMS"
+    constexpr int32 RuntimeStateVersion = 1;
+
+    /** How SaveRuntimeState wrote custom data */
+    enum class ERuntimeStateCustomData : uint8
     {
-        return;
-    }
-    
-    FISMInstanceState* State = InstanceStates.Find(InstanceIndex);
-    if (!State)
+        None,
+        Deltas,
+        Full
+    };
+
+    /** Index of Tag in the save's dictionary, adding it on first use */
+    int32 FindOrAddDictionaryTag(TArray<FGameplayTag>& Dictionary, TMap<FGameplayTag, int32>& Ids, const FGameplayTag& Tag)
     {
-        return;
+        if (const int32* Id = Ids.Find(Tag))
+        {
+            return *Id;
+        }
+        const int32 Id = Dictionary.Add(Tag);
+        Ids.Add(Tag, Id);
+        return Id;
     }
-    
-    FTransform CurrentTransform;
-    ManagedISMComponent->GetInstanceTransform(InstanceIndex, CurrentTransform, true);
 
-    // Already hidden?
-    if (State->HasFlag(EISMInstanceState::Hidden)  
-        && CurrentTransform.GetScale3D() == FVector::ZeroVector)
+    /** Empty for INDEX_NONE or ids outside the dictionary */
+    FGameplayTag GetDictionaryTag(const TArray<FGameplayTag>& Dictionary, int32 Id)
     {
-        return;
+        return Dictionary.IsValidIndex(Id) ? Dictionary[Id] : FGameplayTag();
     }
-    
-    // Cache location before hiding
-    FVector InstanceLocation = GetInstanceLocation(InstanceIndex);
-    bool bWasOnBoundsEdge = IsLocationOnBoundsEdge(InstanceLocation);
-    
-    // Mark as hidden
-    State->SetFlag(EISMInstanceState::Hidden, true);
-    
-    // Preserve the current visible transform so ShowInstance can restore it later.
-    if (CurrentTransform.GetScale3D() != FVector::ZeroVector)
+
+    /**
+     * Check the element count a container or string serializes ahead of its payload before it is
+     * read, so a corrupt count cannot drive a huge allocation. The count has to be ExpectedNum
+     * (INDEX_NONE for any) and its payload of BytesPerItem each has to fit in what is left of Ar.
+     * Leaves Ar where it was, or in error.
+     */
+    bool CheckRuntimeStateCount(FArchive& Ar, int64 ExpectedNum, int64 BytesPerItem, bool bBits = false)
     {
-        State->LastVisibleTransform = CurrentTransform;
-        State->bHasLastVisibleTransform = true;
+        const int64 Start = Ar.Tell();
+        int32 Num = 0;
+        Ar << Num;
+        Ar.Seek(Start);
+
+        const int64 NumItems = bBits ? FMath::DivideAndRoundUp<int64>(Num, NumBitsPerDWORD) : Num;
+        if (Ar.IsError() || Num < 0 || (ExpectedNum != INDEX_NONE && Num != ExpectedNum)
+            || NumItems * BytesPerItem > Ar.TotalSize() - Start - static_cast<int64>(sizeof(int32)))
+        {
+            Ar.SetError();
+            return false;
+        }
+        return true;
     }
 
-    // Scale to zero
-    FTransform HiddenTransform = CurrentTransform;
-    HiddenTransform.SetScale3D(FVector::ZeroVector);
-    
-    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, HiddenTransform, true, true);
-    State->CachedTransform = HiddenTransform;
-    State->bTransformCached = true;
-    
-    BroadcastStateChange(InstanceIndex);
-    
-    // Explicit bounds update
-    if (bUpdateBounds && bWasOnBoundsEdge)
+    /** FString length check: negative counts are UTF-16 */
+    bool CheckRuntimeStateString(FArchive& Ar)
     {
-        RecalculateInstanceBounds();
-    }
+        const int64 Start = Ar.Tell();
+        int32 Num = 0;
+        Ar << Num;
+        Ar.Seek(Start);
 
-    if(bTriggerFeedbacks)
-		TriggerFeedbackOnHideInternal(InstanceIndex, InstigatorComponent);
+        const int64 Bytes = Num < 0 ? -static_cast<int64>(Num) * 2 : static_cast<int64>(Num);
+        if (Ar.IsError() || Bytes > Ar.TotalSize() - Start - static_cast<int64>(sizeof(int32)))
+        {
+            Ar.SetError();
+            return false;
+        }
+        return true;
+    }
 }
 
-void UISMRuntimeComponent::ShowInstance(int32 InstanceIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+bool UISMRuntimeComponent::SaveRuntimeState(TArray<uint8>& OutData)
 {
-    if (!IsValidInstanceIndex(InstanceIndex))
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::SaveRuntimeState);
+    WakeIfDormant();
+
+    OutData.Reset();
+    if (!ManagedISMComponent || !bIsInitialized)
     {
-        return;
+        return false;
     }
-    
-    FISMInstanceState* State = InstanceStates.Find(InstanceIndex);
-    if (!State)
+
+    const int32 InstanceCount = GetInstanceCount();
+    const int32 Stride = ManagedISMComponent->NumCustomDataFloats;
+
+    FMemoryWriter Ar(OutData);
+    uint32 SaveMagic = RuntimeStateMagic;
+    int32 SaveVersion = RuntimeStateVersion;
+    int32 SaveInstanceCount = InstanceCount;
+    int32 SaveStride = Stride;
+    Ar << SaveMagic << SaveVersion << SaveInstanceCount << SaveStride;
+
+    // Flags: one bit plane per flag any instance has
+    uint8 UsedFlags = 0;
+    for (int32 i = 0; i < InstanceCount; i++)
     {
-        return;
+        UsedFlags |= InstanceStates.GetFlags(i);
+    }
+    Ar << UsedFlags;
+    for (int32 Bit = 0; Bit < 8; Bit++)
+    {
+        const uint8 Flag = static_cast<uint8>(1 << Bit);
+        if ((UsedFlags & Flag) == 0)
+        {
+            continue;
+        }
+        TBitArray<> Plane(false, InstanceCount);
+        for (int32 i = 0; i < InstanceCount; i++)
+        {
+            Plane[i] = (InstanceStates.GetFlags(i) & Flag) != 0;
+        }
+        Ar << Plane;
     }
-    
-    FTransform CurrentTransform;
-    ManagedISMComponent->GetInstanceTransform(InstanceIndex, CurrentTransform, true);
 
-    // Not hidden?
-    if (!State->HasFlag(EISMInstanceState::Hidden) && 
-        CurrentTransform.GetScale3D() != FVector::ZeroVector)
+    // Tags: the dictionary first, then which instances have tags and a dictionary-wide bitset each
+    TArray<FGameplayTag> Dictionary;
+    TMap<FGameplayTag, int32> TagIds;
+    TArray<TPair<int32, TArray<int32>>> TaggedInstances;
+    FGameplayTagContainer InstanceTags;
+    for (int32 i = 0; i < InstanceCount; i++)
     {
-        return;
+        InstanceTags.Reset();
+        AppendPerInstanceTags(i, InstanceTags);
+        if (InstanceTags.IsEmpty())
+        {
+            continue;
+        }
+        TArray<int32>& Ids = TaggedInstances.Emplace_GetRef(i, TArray<int32>()).Value;
+        for (const FGameplayTag& Tag : InstanceTags)
+        {
+            Ids.Add(FindOrAddDictionaryTag(Dictionary, TagIds, Tag));
+        }
     }
-    
-    // Mark as not hidden
-    State->SetFlag(EISMInstanceState::Hidden, false);
 
-    // Restore the pre-hide transform that HideInstance preserved.
-    FTransform VisibleTransform = State->bHasLastVisibleTransform
-        ? State->LastVisibleTransform
-        : CurrentTransform;
+    // Owner and possessor tags share the dictionary
+    TArray<TTuple<int32, int32, int32>> Ownership;
+    for (const FISMInstanceHandle& Handle : InstanceHandles.GetHandles())
+    {
+        if (Handle.IsOwned() || Handle.IsPossessed())
+        {
+            Ownership.Emplace(Handle.InstanceIndex,
+                Handle.IsOwned() ? FindOrAddDictionaryTag(Dictionary, TagIds, Handle.GetOwnerTag()) : INDEX_NONE,
+                Handle.IsPossessed() ? FindOrAddDictionaryTag(Dictionary, TagIds, Handle.GetPossessorTag()) : INDEX_NONE);
+        }
+    }
+    Ownership.Sort([](const TTuple<int32, int32, int32>& A, const TTuple<int32, int32, int32>& B) { return A.Get<0>() < B.Get<0>(); });
 
-    if (VisibleTransform.GetScale3D() == FVector::ZeroVector)
+    // Names as strings: FName serialization in a raw archive would write indices into this session's name table
+    int32 NumTags = Dictionary.Num();
+    Ar << NumTags;
+    for (const FGameplayTag& Tag : Dictionary)
     {
-        VisibleTransform.SetScale3D(FVector::OneVector);
+        FString TagName = Tag.ToString();
+        Ar << TagName;
     }
-    
-    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, VisibleTransform, true, true);
-    
-    State->CachedTransform = VisibleTransform;
-    State->bTransformCached = true;
-    State->LastVisibleTransform = VisibleTransform;
-    State->bHasLastVisibleTransform = true;
-    
-    BroadcastStateChange(InstanceIndex);
-    
-    // Expand bounds to include newly shown instance (O(1))
-    if (bUpdateBounds)
+
+    TBitArray<> Tagged(false, InstanceCount);
+    TBitArray<> TagBits(false, TaggedInstances.Num() * NumTags);
+    for (int32 Row = 0; Row < TaggedInstances.Num(); Row++)
     {
-        ExpandBoundsToInclude(VisibleTransform.GetLocation());
+        Tagged[TaggedInstances[Row].Key] = true;
+        for (int32 Id : TaggedInstances[Row].Value)
+        {
+            TagBits[Row * NumTags + Id] = true;
+        }
     }
+    Ar << Tagged << TagBits;
 
-    if(bTriggerFeedbacks)
-		TriggerFeedbackOnShowInternal(InstanceIndex, InstigatorComponent);
+    int32 NumOwnership = Ownership.Num();
+    Ar << NumOwnership;
+    for (TTuple<int32, int32, int32>& Entry : Ownership)
+    {
+        Ar << Entry.Get<0>() << Entry.Get<1>() << Entry.Get<2>();
+    }
+
+    // Custom data: what changed since initialization when the journal can tell, else all of it
+    TArray<FISMCustomDataDelta> Deltas;
+    ERuntimeStateCustomData CustomDataMode = ERuntimeStateCustomData::None;
+    if (Stride > 0)
+    {
+        CustomDataMode = CustomDataJournal.CollectSince(CustomDataSaveWatermark, Deltas) && Stride <= MAX_uint16
+            ? ERuntimeStateCustomData::Deltas : ERuntimeStateCustomData::Full;
+    }
+    uint8 CustomDataByte = static_cast<uint8>(CustomDataMode);
+    Ar << CustomDataByte;
+    if (CustomDataMode == ERuntimeStateCustomData::Deltas)
+    {
+        Deltas.Sort([](const FISMCustomDataDelta& A, const FISMCustomDataDelta& B)
+        {
+            return A.InstanceIndex != B.InstanceIndex ? A.InstanceIndex < B.InstanceIndex : A.Slot < B.Slot;
+        });
+        int32 NumDeltas = Deltas.Num();
+        Ar << NumDeltas;
+        for (FISMCustomDataDelta& Delta : Deltas)
+        {
+            uint16 Slot = static_cast<uint16>(Delta.Slot);
+            Ar << Delta.InstanceIndex << Slot << Delta.Value;
+        }
+    }
+    else if (CustomDataMode == ERuntimeStateCustomData::Full)
+    {
+        TArray<float> CustomData = ManagedISMComponent->PerInstanceSMCustomData;
+        CustomData.SetNumZeroed(InstanceCount * Stride);
+        Ar << CustomData;
+    }
+
+    UE_LOG(LogISMRuntimeCore, Verbose, TEXT("ISMRuntimeComponent: Saved runtime state of %s - %d instances, %d tags, %d custom data deltas, %d bytes"),
+        *GetName(), InstanceCount, NumTags, Deltas.Num(), OutData.Num());
+    return true;
 }
 
-void UISMRuntimeComponent::UpdateInstanceTransform(int32 InstanceIndex, const FTransform& NewTransform, 
-    bool bUpdateSpatialIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+bool UISMRuntimeComponent::LoadRuntimeState(const TArray<uint8>& Data)
 {
-    if (!IsValidInstanceIndex(InstanceIndex))
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::LoadRuntimeState);
+    WakeIfDormant();
+
+    if (!ManagedISMComponent || !bIsInitialized)
     {
-        return;
+        return false;
+    }
+
+    const int32 InstanceCount = GetInstanceCount();
+    const int32 Stride = ManagedISMComponent->NumCustomDataFloats;
+
+    // Read everything before applying anything, so a bad blob leaves the component untouched
+    FMemoryReader Ar(Data);
+    uint32 SavedMagic = 0;
+    int32 SavedVersion = 0;
+    int32 SavedInstanceCount = 0;
+    int32 SavedStride = 0;
+    Ar << SavedMagic << SavedVersion << SavedInstanceCount << SavedStride;
+    if (Ar.IsError() || SavedMagic != RuntimeStateMagic || SavedVersion != RuntimeStateVersion)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: LoadRuntimeState on %s - not runtime state data, or an unsupported version"), *GetName());
+        return false;
+    }
+    if (SavedInstanceCount != InstanceCount || SavedStride != Stride)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: LoadRuntimeState on %s - saved %d instances with %d custom data floats, component has %d with %d"),
+            *GetName(), SavedInstanceCount, SavedStride, InstanceCount, Stride);
+        return false;
     }
-    
-    // Get old location for spatial index update
-    FVector OldLocation = GetInstanceLocation(InstanceIndex);
-    FVector NewLocation = NewTransform.GetLocation();
-    
-    // Update ISM
-    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, NewTransform, true, true);
-    UpdateInstanceWorldBounds(InstanceIndex, NewTransform);
 
-    // Update cached state
-    if (FISMInstanceState* State = InstanceStates.Find(InstanceIndex))
+    TArray<uint8> TargetFlags;
+    TargetFlags.SetNumZeroed(InstanceCount);
+    uint8 UsedFlags = 0;
+    Ar << UsedFlags;
+    for (int32 Bit = 0; Bit < 8 && !Ar.IsError(); Bit++)
     {
-        State->CachedTransform = NewTransform;
-        State->bTransformCached = true;
-        if (NewTransform.GetScale3D() != FVector::ZeroVector)
+        const uint8 Flag = static_cast<uint8>(1 << Bit);
+        if ((UsedFlags & Flag) == 0)
+        {
+            continue;
+        }
+        TBitArray<> Plane;
+        if (!CheckRuntimeStateCount(Ar, InstanceCount, sizeof(uint32), true))
         {
-            State->LastVisibleTransform = NewTransform;
-            State->bHasLastVisibleTransform = true;
+            break;
+        }
+        Ar << Plane;
+        for (TConstSetBitIterator<> It(Plane); It; ++It)
+        {
+            TargetFlags[It.GetIndex()] |= Flag;
         }
-        State->LastUpdateFrame = GFrameCounter;
     }
-    
-    // Update spatial index
-    if (bUpdateSpatialIndex)
+
+    int32 NumTags = 0;
+    Ar << NumTags;
+    TArray<FGameplayTag> Dictionary;
+    if (NumTags < 0 || NumTags > Data.Num())
     {
-        SpatialIndex.UpdateInstance(InstanceIndex, OldLocation, NewLocation);
+        Ar.SetError();
     }
-    
-    // Update bounds
-    if (bUpdateBounds)
+    for (int32 i = 0; i < NumTags && !Ar.IsError(); i++)
     {
-        bool bOldWasOnEdge = IsLocationOnBoundsEdge(OldLocation);
-        
-        if (bOldWasOnEdge)
+        FString TagName;
+        if (!CheckRuntimeStateString(Ar))
+        {
+            break;
+        }
+        Ar << TagName;
+        const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*TagName), false);
+        if (!Tag.IsValid())
+        {
+            UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: LoadRuntimeState on %s - tag %s no longer exists and is dropped"), *GetName(), *TagName);
+        }
+        Dictionary.Add(Tag);
+    }
+
+    // Containers allocate from their stored size, so every size is checked before it is read
+    TBitArray<> Tagged;
+    TBitArray<> TagBits;
+    if (!Ar.IsError() && CheckRuntimeStateCount(Ar, InstanceCount, sizeof(uint32), true))
+    {
+        Ar << Tagged;
+        if (!Ar.IsError() && CheckRuntimeStateCount(Ar, static_cast<int64>(Tagged.CountSetBits()) * NumTags, sizeof(uint32), true))
+        {
+            Ar << TagBits;
+        }
+    }
+
+    int32 NumOwnership = 0;
+    Ar << NumOwnership;
+    TArray<TTuple<int32, int32, int32>> Ownership;
+    if (NumOwnership < 0 || NumOwnership > InstanceCount)
+    {
+        Ar.SetError();
+    }
+    for (int32 i = 0; i < NumOwnership && !Ar.IsError(); i++)
+    {
+        TTuple<int32, int32, int32>& Entry = Ownership.AddDefaulted_GetRef();
+        Ar << Entry.Get<0>() << Entry.Get<1>() << Entry.Get<2>();
+    }
+
+    uint8 CustomDataByte = 0;
+    Ar << CustomDataByte;
+    TArray<FISMCustomDataDelta> Deltas;
+    TArray<float> CustomData;
+    const ERuntimeStateCustomData CustomDataMode = static_cast<ERuntimeStateCustomData>(CustomDataByte);
+    if (CustomDataMode == ERuntimeStateCustomData::Deltas)
+    {
+        int32 NumDeltas = 0;
+        Ar << NumDeltas;
+        if (NumDeltas < 0 || NumDeltas > Data.Num())
+        {
+            Ar.SetError();
+        }
+        for (int32 i = 0; i < NumDeltas && !Ar.IsError(); i++)
+        {
+            FISMCustomDataDelta& Delta = Deltas.AddDefaulted_GetRef();
+            uint16 Slot = 0;
+            Ar << Delta.InstanceIndex << Slot << Delta.Value;
+            Delta.Slot = Slot;
+        }
+    }
+    else if (CustomDataMode == ERuntimeStateCustomData::Full)
+    {
+        if (!Ar.IsError() && CheckRuntimeStateCount(Ar, static_cast<int64>(InstanceCount) * Stride, sizeof(float)))
+        {
+            Ar << CustomData;
+        }
+    }
+
+    const int32 NumTagged = Tagged.CountSetBits();
+    const bool bValid = !Ar.IsError()
+        && Tagged.Num() == InstanceCount && TagBits.Num() == NumTagged * NumTags
+        && CustomDataByte <= static_cast<uint8>(ERuntimeStateCustomData::Full)
+        && (CustomDataMode != ERuntimeStateCustomData::Full || CustomData.Num() == InstanceCount * Stride)
+        && !Deltas.ContainsByPredicate([&](const FISMCustomDataDelta& Delta) { return !IsValidInstanceIndex(Delta.InstanceIndex) || Delta.Slot >= Stride; })
+        && !Ownership.ContainsByPredicate([&](const TTuple<int32, int32, int32>& Entry) { return !IsValidInstanceIndex(Entry.Get<0>()); });
+    if (!bValid)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: LoadRuntimeState on %s - malformed data"), *GetName());
+        return false;
+    }
+
+    // Deltas are relative to the initialized values, which are not kept: a component whose own
+    // journal shows writes since initialization that the blob does not overwrite cannot be brought
+    // to the saved state. The visibility slot is rewritten from the flags below either way.
+    if (CustomDataMode == ERuntimeStateCustomData::Deltas && !CustomDataJournal.IsEnabled())
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: LoadRuntimeState on %s - custom data deltas need bEnableCustomDataJournal on the loading component too"), *GetName());
+        return false;
+    }
+    if (CustomDataMode == ERuntimeStateCustomData::Deltas)
+    {
+        TArray<FISMCustomDataDelta> LocalDeltas;
+        bool bFresh = CustomDataJournal.CollectSince(CustomDataSaveWatermark, LocalDeltas);
+        if (bFresh && LocalDeltas.Num() > 0)
+        {
+            TSet<uint64> SavedSlots;
+            SavedSlots.Reserve(Deltas.Num());
+            for (const FISMCustomDataDelta& Delta : Deltas)
+            {
+                SavedSlots.Add((static_cast<uint64>(Delta.InstanceIndex) << 32) | Delta.Slot);
+            }
+            bFresh = !LocalDeltas.ContainsByPredicate([&](const FISMCustomDataDelta& Delta)
+            {
+                return Delta.Slot != VisibilityCustomDataSlot
+                    && !SavedSlots.Contains((static_cast<uint64>(Delta.InstanceIndex) << 32) | Delta.Slot);
+            });
+        }
+        if (!bFresh)
+        {
+            UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: LoadRuntimeState on %s - custom data deltas need a freshly initialized component, and this one has changed since"), *GetName());
+            return false;
+        }
+    }
+
+    // Visibility first, while the old flags still say which instances are in the cell bounds
+    TArray<int32> Revealed;
+    TArray<int32> VisibilityIndices;
+    TArray<FTransform> VisibilityTransforms;
+    TArray<int32> SlotVisibilityChanges;
+    const bool bCustomDataVisibility = UsesCustomDataVisibility();
+    const uint8 HiddenMask = static_cast<uint8>(EISMInstanceState::Destroyed | EISMInstanceState::Hidden);
+    for (int32 i = 0; i < InstanceCount; i++)
+    {
+        const bool bShouldBeVisible = (TargetFlags[i] & HiddenMask) == 0;
+        bool bShouldKeepScale = bShouldBeVisible;
+        if (bCustomDataVisibility)
+        {
+            if ((GetInstanceCustomDataValue(i, VisibilityCustomDataSlot) == 0.0f) != bShouldBeVisible)
+            {
+                SlotVisibilityChanges.Add(i);
+            }
+            // Hidden instances keep their transform; destroyed ones are scaled away regardless
+            bShouldKeepScale = (TargetFlags[i] & static_cast<uint8>(EISMInstanceState::Destroyed)) == 0;
+        }
+
+        FTransform Current;
+        ManagedISMComponent->GetInstanceTransform(i, Current, true);
+        const bool bScaled = Current.GetScale3D() != FVector::ZeroVector;
+        if (bScaled == bShouldKeepScale)
+        {
+            continue;
+        }
+
+        if (bShouldKeepScale)
         {
-            // Old location was on edge, need full recalculation
-            RecalculateInstanceBounds();
+            const FTransform* LastVisible = InstanceStates.GetLastVisibleTransform(i);
+            if (LastVisible)
+            {
+                Current = *LastVisible;
+            }
+            if (Current.GetScale3D() == FVector::ZeroVector)
+            {
+                Current.SetScale3D(FVector::OneVector);
+            }
+            Revealed.Add(i);
         }
         else
         {
-            // Old location wasn't on edge, just expand to include new location
-            ExpandBoundsToInclude(NewLocation);
+            Current.SetScale3D(FVector::ZeroVector);
         }
+        VisibilityIndices.Add(i);
+        VisibilityTransforms.Add(Current);
     }
-    
-    if(bTriggerFeedbacks)
-		TriggerFeedbackOnTransformUpdateInternal(InstanceIndex, InstigatorComponent);
+
+    BeginNativeBatch();
+    BatchUpdateInstanceTransforms(VisibilityIndices, VisibilityTransforms, false, false);
+    for (int32 InstanceIndex : SlotVisibilityChanges)
+    {
+        WriteInstanceVisibility(InstanceIndex, (TargetFlags[InstanceIndex] & HiddenMask) == 0);
+    }
+    for (int32 InstanceIndex : Revealed)
+    {
+        InstanceStates.ClearLastVisibleTransform(InstanceIndex);
+    }
+
+    TArray<FISMStateFlagsWrite> FlagWrites;
+    FlagWrites.Reserve(InstanceCount);
+    for (int32 i = 0; i < InstanceCount; i++)
+    {
+        if (InstanceStates.GetFlags(i) != TargetFlags[i])
+        {
+            FlagWrites.Add({ i, TargetFlags[i], 0xFF });
+        }
+    }
+    BatchWriteInstanceStateFlags(FlagWrites);
+
+    // Tags: per dictionary tag, the instances gaining and losing it
+    TArray<FGameplayTagContainer> TargetTags;
+    TargetTags.SetNum(InstanceCount);
+    int32 Row = 0;
+    for (TConstSetBitIterator<> It(Tagged); It; ++It, ++Row)
+    {
+        for (int32 Id = 0; Id < NumTags; Id++)
+        {
+            if (TagBits[Row * NumTags + Id] && Dictionary[Id].IsValid())
+            {
+                TargetTags[It.GetIndex()].AddTagFast(Dictionary[Id]);
+            }
+        }
+    }
+
+    TMap<FGameplayTag, TArray<int32>> TagsToAdd;
+    TMap<FGameplayTag, TArray<int32>> TagsToRemove;
+    FGameplayTagContainer CurrentTags;
+    for (int32 i = 0; i < InstanceCount; i++)
+    {
+        CurrentTags.Reset();
+        AppendPerInstanceTags(i, CurrentTags);
+        for (const FGameplayTag& Tag : CurrentTags)
+        {
+            if (!TargetTags[i].HasTagExact(Tag))
+            {
+                TagsToRemove.FindOrAdd(Tag).Add(i);
+            }
+        }
+        for (const FGameplayTag& Tag : TargetTags[i])
+        {
+            if (!CurrentTags.HasTagExact(Tag))
+            {
+                TagsToAdd.FindOrAdd(Tag).Add(i);
+            }
+        }
+    }
+    for (const TPair<FGameplayTag, TArray<int32>>& Pair : TagsToRemove)
+    {
+        BatchRemoveInstanceTag(Pair.Value, Pair.Key);
+    }
+    for (const TPair<FGameplayTag, TArray<int32>>& Pair : TagsToAdd)
+    {
+        BatchAddInstanceTag(Pair.Value, Pair.Key);
+    }
+
+    // Ownership: saved entries applied, everything else released
+    TSet<int32> SavedOwnership;
+    for (const TTuple<int32, int32, int32>& Entry : Ownership)
+    {
+        const int32 InstanceIndex = Entry.Get<0>();
+        SavedOwnership.Add(InstanceIndex);
+        const FGameplayTag OwnerTag = GetDictionaryTag(Dictionary, Entry.Get<1>());
+        const FGameplayTag PossessorTag = GetDictionaryTag(Dictionary, Entry.Get<2>());
+
+        // Handle looked up again after each broadcast, in case a listener added handles
+        if (OwnerTag.IsValid())
+        {
+            GetOrCreateHandle(InstanceIndex).SetOwner(OwnerTag);
+        }
+        else if (GetOrCreateHandle(InstanceIndex).IsOwned())
+        {
+            GetOrCreateHandle(InstanceIndex).ClearOwner();
+        }
+        if (PossessorTag.IsValid())
+        {
+            GetOrCreateHandle(InstanceIndex).SetPossessor(PossessorTag);
+        }
+        else if (GetOrCreateHandle(InstanceIndex).IsPossessed())
+        {
+            GetOrCreateHandle(InstanceIndex).ClearPossessor();
+        }
+    }
+    // Collected first: the clears broadcast, and listeners may create handles
+    TArray<int32> Released;
+    for (const FISMInstanceHandle& Handle : InstanceHandles.GetHandles())
+    {
+        if (!SavedOwnership.Contains(Handle.InstanceIndex) && (Handle.IsOwned() || Handle.IsPossessed()))
+        {
+            Released.Add(Handle.InstanceIndex);
+        }
+    }
+    for (int32 InstanceIndex : Released)
+    {
+        if (GetOrCreateHandle(InstanceIndex).IsOwned())
+        {
+            GetOrCreateHandle(InstanceIndex).ClearOwner();
+        }
+        if (GetOrCreateHandle(InstanceIndex).IsPossessed())
+        {
+            GetOrCreateHandle(InstanceIndex).ClearPossessor();
+        }
+    }
+
+    // Custom data is written in place and pushed with the same render state update as the transforms
+    bool bCustomDataWritten = false;
+    if (CustomDataMode == ERuntimeStateCustomData::Deltas)
+    {
+        for (const FISMCustomDataDelta& Delta : Deltas)
+        {
+            bCustomDataWritten |= WriteInstanceCustomDataRow(Delta.InstanceIndex, Delta.Slot, MakeArrayView(&Delta.Value, 1), false);
+        }
+    }
+    else if (CustomDataMode == ERuntimeStateCustomData::Full && InstanceCount > 0)
+    {
+        bCustomDataWritten = WriteInstanceCustomDataRange(0, InstanceCount, 0, Stride, CustomData, false);
+    }
+    EndNativeBatch();
+
+    if (bCustomDataWritten && VisibilityIndices.Num() == 0)
+    {
+        MarkCustomDataDirty();
+    }
+
+    UE_LOG(LogISMRuntimeCore, Verbose, TEXT("ISMRuntimeComponent: Loaded runtime state of %s - %d visibility changes, %d flag writes, %d custom data deltas"),
+        *GetName(), VisibilityIndices.Num(), FlagWrites.Num(), Deltas.Num());
+    return true;
 }
 
-void UISMRuntimeComponent::BatchDestroyInstances(const TArray<int32>& InstanceIndices, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+bool UISMRuntimeComponent::InitializeFromBakedState()
 {
-    if (InstanceIndices.Num() == 0)
+    const UISMBakedInstanceState* Baked = BakedState;
+    const int32 InstanceCount = Baked->GetNumInstances();
+    const int32 Stride = Baked->NumCustomDataFloats;
+
+    // The level's own copy of the same instances is updated in place; anything else is replaced
+    if (ManagedISMComponent->GetInstanceCount() == InstanceCount)
     {
-        return;
+        ManagedISMComponent->BatchUpdateInstancesTransforms(0, Baked->Transforms, false, !bHeadless, true);
     }
-    
-    // Destroy all instances without bounds updates
-    for (int32 Index : InstanceIndices)
+    else
     {
-        DestroyInstance(Index, false); // Don't update bounds per-instance
+        ManagedISMComponent->ClearInstances();
+        ManagedISMComponent->AddInstances(Baked->Transforms, false, false, false);
     }
-    
-    // Single bounds recalculation at the end if requested
-    if (bUpdateBounds)
+
+    if (Stride > 0 && ManagedISMComponent->PerInstanceSMCustomData.Num() == Baked->CustomData.Num())
     {
-        RecalculateInstanceBounds();
+        FMemory::Memcpy(ManagedISMComponent->PerInstanceSMCustomData.GetData(), Baked->CustomData.GetData(), Baked->CustomData.Num() * sizeof(float));
+        MarkCustomDataDirty();
     }
-    if (bTriggerFeedbacks)
+
+    // The bake is already in its final order
+    InitialIndexRemap.Reset();
+
+    InstanceStates.ResetFromFlags(Baked->StateFlags, GFrameCounter);
+
+    InstanceColumns.ResetData();
+    InstanceColumns.SetNumSlots(InstanceCount);
+
+    // Baked tags replace the authored ones; the dictionary takes each distinct tag once
+    PerInstanceTags.Reset();
+    CompactInstanceTags.Reset();
+    TArray<int32> TagBits;
+    if (bCompactInstanceTags)
     {
-		TriggerFeedbackBatchedOnDestroyInternal(InstanceIndices, InstigatorComponent);  
+        TagBits.Reserve(Baked->TagTable.Num());
+        for (const FGameplayTag& Tag : Baked->TagTable)
+        {
+            const int32 Bit = CompactInstanceTags.FindOrAddBit(Tag);
+            if (Bit == INDEX_NONE)
+            {
+                UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: Baked tags of %s do not fit the compact dictionary - using per-instance tag containers"),
+                    *GetName());
+                CompactInstanceTags.Reset();
+                bCompactInstanceTags = false;
+                break;
+            }
+            TagBits.Add(Bit);
+        }
     }
+
+    for (int32 i = 0; i < InstanceCount; i++)
+    {
+        const int32 First = Baked->InstanceTagOffsets[i];
+        const int32 Last = Baked->InstanceTagOffsets[i + 1];
+        if (First == Last)
+        {
+            continue;
+        }
+
+        if (bCompactInstanceTags)
+        {
+            for (int32 Tag = First; Tag < Last; Tag++)
+            {
+                CompactInstanceTags.SetInstanceBit(i, TagBits[Baked->InstanceTagIds[Tag]]);
+            }
+        }
+        else
+        {
+            FGameplayTagContainer& Tags = PerInstanceTags.FindOrAdd(i);
+            for (int32 Tag = First; Tag < Last; Tag++)
+            {
+                Tags.AddTag(Baked->TagTable[Baked->InstanceTagIds[Tag]]);
+            }
+        }
+    }
+
+    if (!SpatialIndex.ImportCells(Baked->CellKeys, Baked->CellOffsets, Baked->CellInstances, Baked->WorldLocations))
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: Baked spatial cells of %s are malformed - rebuilding the index"), *GetName());
+        SpatialIndex.Rebuild(Baked->WorldLocations);
+    }
+
+    // Baked AABBs are only valid for the local bounds this component records now; otherwise derive them
+    const FBox LocalBounds = GetInitLocalBounds();
+    if (LocalBounds.IsValid && Baked->HasInstanceBounds())
+    {
+        InstanceStates.AdoptWorldBounds(Baked->BoundsMin, Baked->BoundsMax);
+        SpatialIndex.AdoptInstanceBounds(Baked->BoundsMin, Baked->BoundsMax);
+    }
+    else if (LocalBounds.IsValid)
+    {
+        for (int32 i = 0; i < InstanceCount; i++)
+        {
+            UpdateInstanceWorldBounds(i, Baked->Transforms[i] * Baked->ComponentTransform);
+        }
+    }
+
+    const bool bCellBoundsBuilt = CellBounds.ImportCells(SpatialIndex.GetCellSize(), Baked->BoundsCellKeys, Baked->BoundsCellBoxes, Baked->BoundsCellCounts)
+        && CellBounds.GetCellCount() > 0;
+    if (!bCellBoundsBuilt)
+    {
+        CellBounds.Reset(SpatialIndex.GetCellSize());
+    }
+
+    UE_LOG(LogISMRuntimeCore, Verbose, TEXT("ISMRuntimeComponent: Initialized %d instances of %s from %s"),
+        InstanceCount, *GetName(), *GetNameSafe(Baked));
+    return bCellBoundsBuilt;
+}
+
+void UISMRuntimeComponent::InitializeInstancesFromComponent(FISMInstanceStateDelta* RestoreState)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::InitializeInstancesFromComponent);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
+    const int32 InstanceCount = ManagedISMComponent->PerInstanceSMData.Num();
+    FInstanceInitData Init;
+    ReadInstanceInitData(*ManagedISMComponent, SpatialIndex, GetInitLocalBounds(), 0, InstanceCount, true, Init);
+
+    if (RestoreState)
+    {
+        // Waking from dormancy: module columns were kept, only the store comes back
+        RestoreState->NumSlots = InstanceCount;
+        InstanceStates.ApplyDelta(MoveTemp(*RestoreState), GFrameCounter);
+    }
+    else
+    {
+        InstanceStates.ResetIntact(InstanceCount, GFrameCounter);
+
+        // Registered columns restart from their defaults
+        InstanceColumns.ResetData();
+        InstanceColumns.SetNumSlots(InstanceCount);
+    }
+
+    SpatialIndex.Rebuild(Init.Locations, Init.Cells);
+
+    // Rebuild starts clean - record AABBs so overlap queries need no padding
+    for (int32 i = 0; i < Init.Bounds.Num(); i++)
+    {
+        InstanceStates.SetWorldBounds(i, Init.Bounds[i]);
+        SpatialIndex.SetInstanceBounds(i, Init.Bounds[i]);
+    }
+
+    // Every new instance starts active, so the cell bounds come straight from the locations
+    CellBounds.Reset(SpatialIndex.GetCellSize());
+    for (int32 i = 0; i < Init.Locations.Num(); i++)
+    {
+        if (!RestoreState || InstanceStates.IsActive(i))
+        {
+            CellBounds.Add(Init.Locations[i]);
+        }
+    }
+}
+
+FBox UISMRuntimeComponent::GetInitLocalBounds() const
+{
+    // Same gates as UpdateInstanceWorldBounds
+    return (bComputeInstanceAABBs && InstanceData) ? InstanceData->GetEffectiveLocalBounds() : FBox(ForceInit);
+}
+
+void UISMRuntimeComponent::BeginInstanceRanges()
+{
+    InitInstanceCount = ManagedISMComponent->PerInstanceSMData.Num();
+    NumInitializedInstances = 0;
+    bInitializing = true;
+
+    InstanceStates.Reset();
+    InstanceStates.Reserve(InitInstanceCount);
+    InstanceColumns.ResetData();
+    InstanceColumns.SetNumSlots(InitInstanceCount);
+    SpatialIndex.Clear();
+    CellBounds.Reset(SpatialIndex.GetCellSize());
+}
+
+bool UISMRuntimeComponent::StepInitialization(int32 MaxInstances)
+{
+    if (!bInitializing)
+    {
+        return true;
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::StepInitialization);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
+    // Instances the ISM lost since the init began are simply not built
+    const int32 EndIndex = FMath::Min(InitInstanceCount, ManagedISMComponent ? ManagedISMComponent->PerInstanceSMData.Num() : 0);
+    const int32 FirstIndex = NumInitializedInstances;
+    const int32 NumInstances = FMath::Clamp(EndIndex - FirstIndex, 0, FMath::Max(MaxInstances, 1));
+
+    if (NumInstances > 0)
+    {
+        FInstanceInitData Init;
+        ReadInstanceInitData(*ManagedISMComponent, SpatialIndex, GetInitLocalBounds(), FirstIndex, NumInstances, false, Init);
+
+        InstanceStates.AddIntactRange(FirstIndex, NumInstances, GFrameCounter);
+
+        TArray<int32> Indices;
+        Indices.SetNumUninitialized(NumInstances);
+        for (int32 i = 0; i < NumInstances; i++)
+        {
+            Indices[i] = FirstIndex + i;
+        }
+        SpatialIndex.AddInstances(Indices, Init.Locations);
+
+        for (int32 i = 0; i < Init.Bounds.Num(); i++)
+        {
+            InstanceStates.SetWorldBounds(FirstIndex + i, Init.Bounds[i]);
+            SpatialIndex.SetInstanceBounds(FirstIndex + i, Init.Bounds[i]);
+        }
+        for (const FVector& Location : Init.Locations)
+        {
+            CellBounds.Add(Location);
+        }
+
+        // The range is queryable from here on
+        NumInitializedInstances = FirstIndex + NumInstances;
+        ++InstanceQueryRevision;
+        PublishCellBounds();
+    }
+
+    if (NumInitializedInstances < EndIndex)
+    {
+        return false;
+    }
+
+    bInitializing = false;
+    InitInstanceCount = 0;
+    if (CompleteInitialization(true) && CachedSubsystem)
+    {
+        // Registered for queries at BeginPlay; the RequestRuntimeComponent callbacks waited for this
+        CachedSubsystem->NotifyComponentInitialized(this);
+    }
+    return true;
+}
+
+bool UISMRuntimeComponent::InitializeInstances()
+{
+    // A time-sliced initialization in progress is finished here and now
+    if (bInitializing)
+    {
+        StepInitialization(MAX_int32);
+        return bIsInitialized;
+    }
+
+    return StartInitialization(nullptr);
+}
+
+bool UISMRuntimeComponent::StartInitialization(UISMRuntimeSubsystem* InitQueue)
+{
+    if (bIsInitialized || bInitializing)
+    {
+        return true; // Already initialized
+    }
+    if (!ManagedISMComponent)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: No ManagedISMComponent set on %s"), *GetOwner()->GetName());
+        return false;
+    }
+
+    const UISMRuntimeSettings* RuntimeSettings = GetDefault<UISMRuntimeSettings>();
+    bHeadless = RuntimeSettings && RuntimeSettings->IsHeadless(GetWorld());
+
+    // Apply data asset settings if available
+    if (InstanceData)
+    {
+        if (InstanceData->StaticMesh && !ManagedISMComponent->GetStaticMesh())
+        {
+            ManagedISMComponent->SetStaticMesh(InstanceData->StaticMesh);
+        }
+
+        // Apply material overrides; a headless component never draws them
+        for (int32 i = 0; i < InstanceData->MaterialOverrides.Num() && !bHeadless; i++)
+        {
+            if (InstanceData->MaterialOverrides[i])
+            {
+                ManagedISMComponent->SetMaterial(i, InstanceData->MaterialOverrides[i]);
+            }
+        }
+
+        // Use recommended cell size from data asset
+        if (InstanceData->RecommendedCellSize > 0.0f)
+        {
+            SpatialIndexCellSize = InstanceData->RecommendedCellSize;
+        }
+    }
+
+    // Build component tags (let subclasses add their specific tags)
+    BuildComponentTags();
+
+    bInitializedFromBakedState = BakedState && BakedState->IsCompatibleWith(this);
+    if (BakedState && !bInitializedFromBakedState)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: %s does not match %s (moved, or cell size / custom data changed since the bake) - building state at runtime"),
+            *GetNameSafe(BakedState), *GetName());
+    }
+
+    // Authored per-instance tags move into the compact masks
+    if (!bInitializedFromBakedState && bCompactInstanceTags && PerInstanceTags.Num() > 0)
+    {
+        TMap<int32, FGameplayTagContainer> AuthoredTags = MoveTemp(PerInstanceTags);
+        PerInstanceTags.Reset();
+        for (const TPair<int32, FGameplayTagContainer>& Pair : AuthoredTags)
+        {
+            for (const FGameplayTag& Tag : Pair.Value)
+            {
+                AddInstanceTag(Pair.Key, Tag);
+            }
+        }
+    }
+
+    // Initialize spatial index
+    SpatialIndex = FISMSpatialIndex(SpatialIndexCellSize,
+        bUseFlatSpatialIndex ? EISMSpatialIndexStorage::Flat : EISMSpatialIndexStorage::Hashed);
+    SpatialIndex.SetHierarchyLevels(SpatialIndexLevels);
+    SpatialIndex.SetQueryTelemetryEnabled(bSpatialQueryTelemetry);
+    OpCounters.SetSamplingEnabled(bSampleHotInstances);
+    BumpAllCellStructureGenerations();
+    ChangeTracker.MarkAllChanged(0xFF);
+    if (bEnableCustomDataJournal)
+    {
+        CustomDataJournal.Enable();
+    }
+    CustomDataJournal.MarkReset();
+    CustomDataSaveWatermark = CustomDataJournal.GetWatermark();
+
+    bool bCellBoundsBuilt = true;
+    if (bInitializedFromBakedState)
+    {
+        bCellBoundsBuilt = InitializeFromBakedState();
+    }
+    else
+    {
+        // Make index order follow space before any per-instance state is built
+        if (bMortonOrderInstances)
+        {
+            ApplyMortonOrder();
+        }
+
+        // Queued: the subsystem builds the instances in ranges over the next frames
+        if (InitQueue && ManagedISMComponent->PerInstanceSMData.Num() > 0)
+        {
+            BeginInstanceRanges();
+            InitQueue->QueueComponentInitialization(this);
+            return true;
+        }
+
+        InitializeInstancesFromComponent();
+    }
+
+    return CompleteInitialization(bCellBoundsBuilt);
+}
+
+bool UISMRuntimeComponent::CompleteInitialization(bool bCellBoundsBuilt)
+{
+    SyncSpatialTagMasks();
+
+    bIsInitialized = true;
+
+    // Enable tick if needed
+    if (TickInterval > 0.0f || !bEnableTickOptimization)
+    {
+        SetRuntimeTickEnabled(true);
+    }
+    
+    if (bCellBoundsBuilt)
+    {
+        PublishCellBounds();
+    }
+    else
+    {
+        RecalculateInstanceBounds();
+    }
+
+    if (!RegisterWithSubsystem())
+        return false;
+
+    // Resolve the PICD schema once; conversions read it from here
+    ResolveCustomDataSchema();
+
+    // Build shared pool DMIs over the next frames rather than on the first conversion
+    if (InstanceData && InstanceData->bPrewarmSharedDMIs && !bHeadless)
+    {
+        UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+        if (UISMCustomDataSubsystem* CustomDataSubsystem = GI ? GI->GetSubsystem<UISMCustomDataSubsystem>() : nullptr)
+        {
+            CustomDataSubsystem->QueuePrewarmForComponent(this);
+        }
+    }
+
+    // Notify subclasses
+    OnInitializationComplete();
+
+    UE_LOG(LogTemp, Log, TEXT("ISMRuntimeComponent: Initialized %d instances on %s"),
+        GetInstanceCount(), *GetOwner()->GetName());
+
+
+    return true;
+}
+
+float UISMRuntimeComponent::GetEffectiveDormancyDistance() const
+{
+    if (DormancyDistance > 0.0f)
+    {
+        return DormancyDistance;
+    }
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    return Settings ? Settings->DefaultDormancyDistance : 0.0f;
+}
+
+bool UISMRuntimeComponent::EnterDormancy()
+{
+    if (!bIsInitialized || bInitializing || bIsDormant || bBatchLocked || !ManagedISMComponent)
+    {
+        return false;
+    }
+
+    // Converted instances live on as actors that report back through their handles
+    if (InstanceStates.GetFlagCount(EISMInstanceState::Converting) > 0 || GetConvertedInstances().Num() > 0)
+    {
+        return false;
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::EnterDormancy);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
+    DormantBounds = CachedInstanceBounds;
+    InstanceStates.ExtractDelta(DormantState);
+
+    // Handles outside keep their generation, which the delta preserves; the map is only a cache
+    InstanceHandles.Empty();
+    SpatialIndex.Clear();
+    BumpAllCellStructureGenerations();
+    CellBounds.Reset(SpatialIndex.GetCellSize());
+    {
+        FWriteScopeLock WriteLock(SnapshotLock);
+        SpatialIndexSnapshot.Reset();
+    }
+
+    bTickBeforeDormancy = IsRuntimeTickEnabled();
+    SetRuntimeTickEnabled(false);
+
+    bIsDormant = true;
+    ++InstanceQueryRevision;
+    if (UISMRuntimeSubsystem* Subsystem = CachedSubsystem.Get())
+    {
+        Subsystem->NotifyComponentDormancyChanged(this);
+    }
+
+    UE_LOG(LogISMRuntimeCore, Verbose, TEXT("ISMRuntimeComponent: %s went dormant, keeping %d changed instances"),
+        *GetName(), DormantState.Indices.Num());
+    return true;
+}
+
+bool UISMRuntimeComponent::WakeFromDormancy()
+{
+    if (!bIsDormant)
+    {
+        return false;
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::WakeFromDormancy);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
+    bIsDormant = false;
+    if (ManagedISMComponent)
+    {
+        InitializeInstancesFromComponent(&DormantState);
+        SyncSpatialTagMasks();
+    }
+    DormantState.Reset();
+    DormantBounds = FBox(ForceInit);
+
+    ++InstanceQueryRevision;
+    PublishCellBounds();
+
+    // Back into the broadphase at the rebuilt bounds
+    if (UISMRuntimeSubsystem* Subsystem = CachedSubsystem.Get())
+    {
+        Subsystem->NotifyComponentDormancyChanged(this);
+    }
+
+    if (bTickBeforeDormancy)
+    {
+        SetRuntimeTickEnabled(true);
+    }
+
+    UE_LOG(LogISMRuntimeCore, Verbose, TEXT("ISMRuntimeComponent: %s woke from dormancy"), *GetName());
+    return true;
+}
+
+#pragma region REDIRECTS
+
+void UISMRuntimeComponent::AddRedirector(UPrimitiveComponent* Component)
+{
+    if (Component || Component && !Redirectors.Contains(Component))
+    {
+        Redirectors.Add(Component);
+        if (CachedSubsystem.IsValid())
+        {
+            CachedSubsystem->RegisterComponentRedirect(Component, this);
+        }
+    }
+}
+
+void UISMRuntimeComponent::RegisterAllRedirects()
+{
+    if (!CachedSubsystem.IsValid())
+    {
+        return;
+    }
+    for (UPrimitiveComponent* Redirector : Redirectors)
+    {
+        if (Redirector)
+        {
+            CachedSubsystem->RegisterComponentRedirect(Redirector, this);
+        }
+    }
+}
+
+void UISMRuntimeComponent::UnregisterAllRedirects()
+{
+    if (!CachedSubsystem.IsValid())
+    {
+        return;
+    }
+    for (UPrimitiveComponent* Redirector : Redirectors)
+    {
+        if (Redirector)
+        {
+            CachedSubsystem->UnregisterComponentRedirect(Redirector, this);
+        }
+    }
+}
+
+#pragma endregion
+
+
+
+void UISMRuntimeComponent::BuildComponentTags()
+{
+    // Base implementation does nothing
+    // Subclasses override to add their specific tags
+
+    // Apply default tags from data asset
+    if (InstanceData)
+    {
+        ISMComponentTags.AppendTags(InstanceData->DefaultTags);
+    }
+}
+
+void UISMRuntimeComponent::OnInitializationComplete()
+{
+    // Base implementation does nothing
+    // Subclasses can override for post-init logic
+}
+
+void UISMRuntimeComponent::DestroyInstance(int32 InstanceIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::DestroyInstance);
+    SCOPE_CYCLE_COUNTER(STAT_ISMDestroyInstance);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+    WakeIfDormant();
+
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
+    }
+    
+    // Get state
+    if (!InstanceStates.Contains(InstanceIndex))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: No state found for instance %d"), InstanceIndex);
+        return;
+    }
+    
+    // Already destroyed?
+    if (InstanceStates.HasFlag(InstanceIndex, EISMInstanceState::Destroyed))
+    {
+        return;
+    }
+    
+    // Cache location before destruction (for bounds update)
+    const FVector InstanceLocation = GetInstanceLocation(InstanceIndex);
+    const bool bWasActive = IsInstanceActive(InstanceIndex);
+    
+    // Notify subclass
+    OnInstancePreDestroy(InstanceIndex);
+    
+    // Mark as destroyed
+    InstanceStates.MarkDestroyed(InstanceIndex);
+    INC_DWORD_STAT(STAT_ISMInstancesDestroyed);
+    OpCounters.Count(EISMComponentOp::Destroy);
+    
+    // Add destroyed tag
+    AddInstanceTag(InstanceIndex, FGameplayTag::RequestGameplayTag("ISM.State.Destroyed"));
+    
+    // Remove intact tag
+    RemoveInstanceTag(InstanceIndex, FGameplayTag::RequestGameplayTag("ISM.State.Intact"));
+    
+    // Scale to zero even with a visibility slot: only that drops the instance's collision.
+    // The slot is still written so the material agrees.
+    if (UsesCustomDataVisibility())
+    {
+        WriteInstanceVisibility(InstanceIndex, false);
+    }
+    FTransform HiddenTransform;
+    ManagedISMComponent->GetInstanceTransform(InstanceIndex, HiddenTransform, true);
+    HiddenTransform.SetScale3D(FVector::ZeroVector);
+
+    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, HiddenTransform, true, !bHeadless);
+    ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::Transform));
+    
+    // Broadcast events
+    BroadcastDestruction(InstanceIndex);
+    BroadcastStateChange(InstanceIndex);
+    
+    // Notify subclass
+    OnInstancePostDestroy(InstanceIndex);
+    
+    // Only the instance's cell can shrink; it is rescanned on the next refresh
+    if (bWasActive)
+    {
+        CellBounds.Remove(InstanceLocation);
+    }
+    if (bUpdateBounds)
+    {
+        RefreshInstanceBounds();
+    }
+
+    if(bTriggerFeedbacks)
+		TriggerFeedbackOnDestroyInternal(InstanceIndex, InstigatorComponent);
+}
+
+void UISMRuntimeComponent::HideInstance(int32 InstanceIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
+    }
+    
+    if (!InstanceStates.Contains(InstanceIndex))
+    {
+        return;
+    }
+    
+    const bool bCustomDataVisibility = UsesCustomDataVisibility();
+    FTransform CurrentTransform;
+    ManagedISMComponent->GetInstanceTransform(InstanceIndex, CurrentTransform, true);
+
+    // Already hidden?
+    if (InstanceStates.HasFlag(InstanceIndex, EISMInstanceState::Hidden)  
+        && (bCustomDataVisibility || CurrentTransform.GetScale3D() == FVector::ZeroVector))
+    {
+        return;
+    }
+    
+    // Cache location before hiding
+    const FVector InstanceLocation = GetInstanceLocation(InstanceIndex);
+    const bool bWasActive = IsInstanceActive(InstanceIndex);
+    
+    // Mark as hidden
+    InstanceStates.SetFlag(InstanceIndex, EISMInstanceState::Hidden, true);
+
+    if (bCustomDataVisibility)
+    {
+        // The transform stays; only the visibility slot changes
+        WriteInstanceVisibility(InstanceIndex, false);
+    }
+    else
+    {
+        // Preserve the current visible transform so ShowInstance can restore it later.
+        if (CurrentTransform.GetScale3D() != FVector::ZeroVector)
+        {
+            InstanceStates.SetLastVisibleTransform(InstanceIndex, CurrentTransform);
+        }
+
+        // Scale to zero
+        FTransform HiddenTransform = CurrentTransform;
+        HiddenTransform.SetScale3D(FVector::ZeroVector);
+
+        ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, HiddenTransform, true, !bHeadless);
+        ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::Transform));
+    }
+    
+    BroadcastStateChange(InstanceIndex);
+    
+    // Explicit bounds update
+    if (bWasActive)
+    {
+        CellBounds.Remove(InstanceLocation);
+    }
+    if (bUpdateBounds)
+    {
+        RefreshInstanceBounds();
+    }
+
+    if(bTriggerFeedbacks)
+		TriggerFeedbackOnHideInternal(InstanceIndex, InstigatorComponent);
+}
+
+void UISMRuntimeComponent::ShowInstance(int32 InstanceIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
+    }
+    
+    if (!InstanceStates.Contains(InstanceIndex))
+    {
+        return;
+    }
+    
+    const bool bCustomDataVisibility = UsesCustomDataVisibility();
+    FTransform CurrentTransform;
+    ManagedISMComponent->GetInstanceTransform(InstanceIndex, CurrentTransform, true);
+
+    // Not hidden?
+    if (!InstanceStates.HasFlag(InstanceIndex, EISMInstanceState::Hidden) && 
+        CurrentTransform.GetScale3D() != FVector::ZeroVector &&
+        (!bCustomDataVisibility || GetInstanceCustomDataValue(InstanceIndex, VisibilityCustomDataSlot) == 0.0f))
+    {
+        return;
+    }
+    
+    // Mark as not hidden
+    const bool bWasActive = IsInstanceActive(InstanceIndex);
+    InstanceStates.SetFlag(InstanceIndex, EISMInstanceState::Hidden, false);
+
+    if (bCustomDataVisibility)
+    {
+        WriteInstanceVisibility(InstanceIndex, true);
+    }
+
+    // Restore the pre-hide transform that HideInstance preserved; with the visibility slot only
+    // instances scaled away some other way need it
+    FTransform VisibleTransform = CurrentTransform;
+    if (!bCustomDataVisibility || CurrentTransform.GetScale3D() == FVector::ZeroVector)
+    {
+        const FTransform* LastVisibleTransform = InstanceStates.GetLastVisibleTransform(InstanceIndex);
+        VisibleTransform = LastVisibleTransform ? *LastVisibleTransform : CurrentTransform;
+
+        if (VisibleTransform.GetScale3D() == FVector::ZeroVector)
+        {
+            VisibleTransform.SetScale3D(FVector::OneVector);
+        }
+
+        ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, VisibleTransform, true, !bHeadless);
+        ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::Transform));
+        InstanceStates.ClearLastVisibleTransform(InstanceIndex);
+    }
+    
+    BroadcastStateChange(InstanceIndex);
+    
+    if (!bWasActive && IsInstanceActive(InstanceIndex))
+    {
+        CellBounds.Add(VisibleTransform.GetLocation());
+        SyncBroadphaseBounds();
+    }
+
+    // Expand bounds to include newly shown instance (O(1))
+    if (bUpdateBounds)
+    {
+        ExpandBoundsToInclude(VisibleTransform.GetLocation());
+    }
+
+    if(bTriggerFeedbacks)
+		TriggerFeedbackOnShowInternal(InstanceIndex, InstigatorComponent);
+}
+
+void UISMRuntimeComponent::BatchShowInstances(const TArray<int32>& InstanceIndices, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (InstanceIndices.Num() == 0)
+    {
+        return;
+    }
+
+    // Only instances that were hidden go into the feedback batch
+    TArray<int32> Shown;
+    Shown.Reserve(InstanceIndices.Num());
+
+    BeginNativeBatch();
+    for (int32 Index : InstanceIndices)
+    {
+        if (IsValidInstanceIndex(Index) && InstanceStates.Contains(Index) && InstanceStates.HasFlag(Index, EISMInstanceState::Hidden))
+        {
+            Shown.Add(Index);
+        }
+        ShowInstance(Index, bUpdateBounds, false);
+    }
+    EndNativeBatch();
+
+    if (bTriggerFeedbacks)
+    {
+        TriggerFeedbackBatchedOnShowInternal(Shown, InstigatorComponent);
+    }
+}
+
+void UISMRuntimeComponent::BatchHideInstances(const TArray<int32>& InstanceIndices, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (InstanceIndices.Num() == 0)
+    {
+        return;
+    }
+
+    // Only instances that were visible go into the feedback batch
+    TArray<int32> Hidden;
+    Hidden.Reserve(InstanceIndices.Num());
+
+    BeginNativeBatch();
+    for (int32 Index : InstanceIndices)
+    {
+        if (IsValidInstanceIndex(Index) && InstanceStates.Contains(Index) && !InstanceStates.HasFlag(Index, EISMInstanceState::Hidden))
+        {
+            Hidden.Add(Index);
+        }
+        HideInstance(Index, false, false);
+    }
+    EndNativeBatch();
+
+    if (bUpdateBounds)
+    {
+        RefreshInstanceBounds();
+    }
+    if (bTriggerFeedbacks)
+    {
+        TriggerFeedbackBatchedOnHideInternal(Hidden, InstigatorComponent);
+    }
+}
+
+bool UISMRuntimeComponent::UsesCustomDataVisibility() const
+{
+    return ManagedISMComponent && VisibilityCustomDataSlot >= 0 && VisibilityCustomDataSlot < ManagedISMComponent->NumCustomDataFloats;
+}
+
+void UISMRuntimeComponent::WriteInstanceVisibility(int32 InstanceIndex, bool bVisible)
+{
+    const float Value = bVisible ? 0.0f : 1.0f;
+    const bool bDeferUpload = NativeBatchDepth > 0;
+    if (WriteInstanceCustomDataRow(InstanceIndex, VisibilityCustomDataSlot, MakeArrayView(&Value, 1), !bDeferUpload) && bDeferUpload)
+    {
+        bVisibilityUploadPending = true;
+    }
+}
+
+void UISMRuntimeComponent::UpdateInstanceTransform(int32 InstanceIndex, const FTransform& NewTransform, 
+    bool bUpdateSpatialIndex, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
+    }
+    OpCounters.Count(EISMComponentOp::TransformUpdate);
+    OpCounters.SampleMutation(InstanceIndex);
+    
+    // Get old location for spatial index update
+    FVector OldLocation = GetInstanceLocation(InstanceIndex);
+    FVector NewLocation = NewTransform.GetLocation();
+    
+    // Zero scale hides the instance; keep what ShowInstance should bring back
+    if (NewTransform.GetScale3D() == FVector::ZeroVector)
+    {
+        FTransform OldTransform;
+        ManagedISMComponent->GetInstanceTransform(InstanceIndex, OldTransform, true);
+        if (OldTransform.GetScale3D() != FVector::ZeroVector)
+        {
+            InstanceStates.SetLastVisibleTransform(InstanceIndex, OldTransform);
+        }
+    }
+    else
+    {
+        InstanceStates.RefreshLastVisibleTransform(InstanceIndex, NewTransform);
+    }
+
+    // Update ISM
+    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, NewTransform, true, !bHeadless);
+    UpdateInstanceWorldBounds(InstanceIndex, NewTransform);
+    ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::Transform));
+
+    InstanceStates.SetLastUpdateFrame(InstanceIndex, GFrameCounter);
+    
+    // Update spatial index
+    if (bUpdateSpatialIndex)
+    {
+        SpatialIndex.UpdateInstance(InstanceIndex, OldLocation, NewLocation);
+    }
+    NoteCellCrossing(InstanceIndex, OldLocation, NewLocation);
+    
+    if (IsInstanceActive(InstanceIndex))
+    {
+        CellBounds.Remove(OldLocation);
+        CellBounds.Add(NewLocation);
+        SyncBroadphaseBounds();
+    }
+
+    // Update bounds - rescans the old cell only if the instance held one of its faces
+    if (bUpdateBounds)
+    {
+        RefreshInstanceBounds();
+    }
+    
+    if(bTriggerFeedbacks)
+		TriggerFeedbackOnTransformUpdateInternal(InstanceIndex, InstigatorComponent);
+}
+
+void UISMRuntimeComponent::BatchDestroyInstances(const TArray<int32>& InstanceIndices, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::BatchDestroyInstances);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+    WakeIfDormant();
+
+    if (InstanceIndices.Num() == 0)
+    {
+        return;
+    }
+    
+    // Destroy all instances without bounds updates; native listeners get one batch event
+    BeginNativeBatch();
+    for (int32 Index : InstanceIndices)
+    {
+        DestroyInstance(Index, false); // Don't update bounds per-instance
+    }
+    EndNativeBatch();
+    
+    // Single bounds refresh at the end if requested
+    if (bUpdateBounds)
+    {
+        RefreshInstanceBounds();
+    }
+    if (bTriggerFeedbacks)
+    {
+		TriggerFeedbackBatchedOnDestroyInternal(InstanceIndices, InstigatorComponent);  
+    }
+}
+
+void UISMRuntimeComponent::BatchUpdateInstanceTransforms(TArrayView<const int32> InstanceIndices, TArrayView<const FTransform> NewTransforms,
+    bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (InstanceIndices.Num() != NewTransforms.Num())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: BatchUpdateInstanceTransforms - %d indices but %d transforms"),
+            InstanceIndices.Num(), NewTransforms.Num());
+        return;
+    }
+
+    if (!ManagedISMComponent || InstanceIndices.Num() == 0)
+    {
+        return;
+    }
+
+    OpCounters.Count(EISMComponentOp::TransformUpdate, InstanceIndices.Num());
+    if (OpCounters.IsSamplingEnabled())
+    {
+        for (int32 InstanceIndex : InstanceIndices)
+        {
+            OpCounters.SampleMutation(InstanceIndex);
+        }
+    }
+
+    TArray<FISMSpatialIndexMove> Moves;
+    Moves.Reserve(InstanceIndices.Num());
+    TArray<int32> MoveSources;
+    MoveSources.Reserve(InstanceIndices.Num());
+    TArray<FTransform> RunTransforms;
+
+    // Pass 1: ISM writes. Runs of consecutive indices go through one batched ISM call;
+    // nothing marks render state dirty until every instance is written.
+    int32 RunStart = 0;
+    while (RunStart < InstanceIndices.Num())
+    {
+        const int32 FirstIndex = InstanceIndices[RunStart];
+        if (!IsValidInstanceIndex(FirstIndex))
+        {
+            RunStart++;
+            continue;
+        }
+
+        int32 RunEnd = RunStart + 1;
+        while (RunEnd < InstanceIndices.Num()
+            && InstanceIndices[RunEnd] == FirstIndex + (RunEnd - RunStart)
+            && IsValidInstanceIndex(InstanceIndices[RunEnd]))
+        {
+            RunEnd++;
+        }
+
+        for (int32 i = RunStart; i < RunEnd; i++)
+        {
+            const int32 InstanceIndex = InstanceIndices[i];
+            const FTransform& NewTransform = NewTransforms[i];
+
+            FTransform OldTransform;
+            ManagedISMComponent->GetInstanceTransform(InstanceIndex, OldTransform, true);
+
+            // Zero scale hides the instance; keep what ShowInstance should bring back
+            if (NewTransform.GetScale3D() == FVector::ZeroVector)
+            {
+                if (OldTransform.GetScale3D() != FVector::ZeroVector)
+                {
+                    InstanceStates.SetLastVisibleTransform(InstanceIndex, OldTransform);
+                }
+            }
+            else
+            {
+                InstanceStates.RefreshLastVisibleTransform(InstanceIndex, NewTransform);
+            }
+
+            FISMSpatialIndexMove& Move = Moves.AddDefaulted_GetRef();
+            Move.InstanceIndex = InstanceIndex;
+            Move.OldLocation = OldTransform.GetLocation();
+            Move.NewLocation = NewTransform.GetLocation();
+            MoveSources.Add(i);
+
+            if (IsInstanceActive(InstanceIndex))
+            {
+                CellBounds.Remove(Move.OldLocation);
+                CellBounds.Add(Move.NewLocation);
+            }
+        }
+
+        if (RunEnd - RunStart == 1)
+        {
+            ManagedISMComponent->UpdateInstanceTransform(FirstIndex, NewTransforms[RunStart], true, false);
+        }
+        else
+        {
+            RunTransforms.Reset();
+            RunTransforms.Append(NewTransforms.GetData() + RunStart, RunEnd - RunStart);
+            ManagedISMComponent->BatchUpdateInstancesTransforms(FirstIndex, RunTransforms, true, false);
+        }
+
+        RunStart = RunEnd;
+    }
+
+    if (Moves.Num() == 0)
+    {
+        return;
+    }
+
+    if (!bHeadless)
+    {
+        ManagedISMComponent->MarkRenderStateDirty();
+    }
+
+    // Pass 2: per-instance AABBs and state, then the spatial index in one ApplyMoves
+    const uint32 FrameNumber = GFrameCounter;
+    for (int32 MoveIdx = 0; MoveIdx < Moves.Num(); MoveIdx++)
+    {
+        const int32 InstanceIndex = Moves[MoveIdx].InstanceIndex;
+        UpdateInstanceWorldBounds(InstanceIndex, NewTransforms[MoveSources[MoveIdx]]);
+        InstanceStates.SetLastUpdateFrame(InstanceIndex, FrameNumber);
+        ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::Transform));
+        NoteCellCrossing(InstanceIndex, Moves[MoveIdx].OldLocation, Moves[MoveIdx].NewLocation);
+    }
+
+    SpatialIndex.ApplyMoves(Moves);
+    SyncBroadphaseBounds();
+
+    // Component bounds: one refresh over the cells the moves left behind
+    if (bUpdateBounds)
+    {
+        RefreshInstanceBounds();
+    }
+
+    if (bTriggerFeedbacks)
+    {
+        TArray<int32> MovedIndices;
+        MovedIndices.Reserve(Moves.Num());
+        for (const FISMSpatialIndexMove& Move : Moves)
+        {
+            MovedIndices.Add(Move.InstanceIndex);
+        }
+        TriggerFeedbackBatchedOnTransformUpdateInternal(MovedIndices, InstigatorComponent);
+    }
+}
+
+int32 UISMRuntimeComponent::ReturnConvertedInstances(TArrayView<const FISMInstanceHandle> Handles, TArrayView<const FTransform> FinalTransforms,
+    bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    if (Handles.Num() != FinalTransforms.Num())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: ReturnConvertedInstances - %d handles but %d transforms"),
+            Handles.Num(), FinalTransforms.Num());
+        return 0;
+    }
+
+    if (!ManagedISMComponent || Handles.Num() == 0)
+    {
+        return 0;
+    }
+
+    const FGameplayTag ConvertingTag = FGameplayTag::RequestGameplayTag(FName("ISM.State.Converting"));
+    const FGameplayTag ConvertedTag = FGameplayTag::RequestGameplayTag(FName("ISM.State.Converted"));
+
+    // (instance index, source slot) so the transform write can run in index order
+    TArray<TPair<int32, int32>> Returned;
+    Returned.Reserve(Handles.Num());
+
+    for (int32 i = 0; i < Handles.Num(); i++)
+    {
+        const FISMInstanceHandle& Handle = Handles[i];
+        if (Handle.Component.Get() != this || !Handle.IsValid() || !InstanceStates.Contains(Handle.InstanceIndex))
+        {
+            continue;
+        }
+        const int32 InstanceIndex = Handle.InstanceIndex;
+
+        Handle.ReleaseCustomDataMaterials();
+        RemoveInstanceTag(InstanceIndex, ConvertingTag);
+        RemoveInstanceTag(InstanceIndex, ConvertedTag);
+        SetInstanceState(InstanceIndex, EISMInstanceState::Converting, false);
+        NotifyHandleConversionChanged(InstanceIndex, nullptr);
+
+        // Show without restoring the pre-hide transform: the final transform replaces it below.
+        // The bounds entry goes in at the hidden location so the transform write moves it.
+        const bool bWasActive = IsInstanceActive(InstanceIndex);
+        InstanceStates.SetFlag(InstanceIndex, EISMInstanceState::Hidden, false);
+        InstanceStates.ClearLastVisibleTransform(InstanceIndex);
+        if (UsesCustomDataVisibility())
+        {
+            // The transform write below pushes render state anyway
+            const float Shown = 0.0f;
+            WriteInstanceCustomDataRow(InstanceIndex, VisibilityCustomDataSlot, MakeArrayView(&Shown, 1), false);
+        }
+        if (!bWasActive && IsInstanceActive(InstanceIndex))
+        {
+            CellBounds.Add(GetInstanceLocation(InstanceIndex));
+        }
+        BroadcastStateChange(InstanceIndex);
+
+        Returned.Emplace(InstanceIndex, i);
+    }
+
+    if (Returned.Num() == 0)
+    {
+        return 0;
+    }
+
+    Returned.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Key < B.Key; });
+
+    TArray<int32> Indices;
+    TArray<FTransform> Transforms;
+    Indices.Reserve(Returned.Num());
+    Transforms.Reserve(Returned.Num());
+    for (const TPair<int32, int32>& Entry : Returned)
+    {
+        // A duplicate would be written twice in one run; the first return wins
+        if (Indices.Num() > 0 && Indices.Last() == Entry.Key)
+        {
+            continue;
+        }
+
+        FTransform FinalTransform = FinalTransforms[Entry.Value];
+        if (FinalTransform.GetScale3D() == FVector::ZeroVector)
+        {
+            FinalTransform.SetScale3D(FVector::OneVector);
+        }
+        Indices.Add(Entry.Key);
+        Transforms.Add(FinalTransform);
+    }
+
+    BatchUpdateInstanceTransforms(Indices, Transforms, false, bTriggerFeedbacks, InstigatorComponent);
+    return Indices.Num();
+}
+
+int32 UISMRuntimeComponent::AddInstance(const FTransform& Transform, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    WakeIfDormant();
+
+    if (!ManagedISMComponent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Cannot add instance - no managed ISM component"));
+        return INDEX_NONE;
+    }
+
+    if (!bIsInitialized)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: Adding instance before initialization on %s"),
+            *GetOwner()->GetName());
+    }
+
+    // Reuse a destroyed slot instead of growing the ISM
+    const int32 RecycledIndex = FindRecyclableInstanceSlot();
+    if (RecycledIndex != INDEX_NONE)
+    {
+        RecycleInstanceSlot(RecycledIndex, Transform);
+        SyncBroadphaseBounds();
+
+        if (bUpdateBounds)
+        {
+            ExpandBoundsToInclude(Transform.GetLocation());
+        }
+
+        if(bTriggerFeedbacks)
+            TriggerFeedbackOnSpawnInternal(RecycledIndex, InstigatorComponent);
+
+        OnInstanceAdded(RecycledIndex, Transform);
+        return RecycledIndex;
+    }
+
+    // Add to ISM component
+    int32 NewIndex = ManagedISMComponent->AddInstance(Transform);
+
+    if (NewIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Failed to add instance to ISM"));
+        return INDEX_NONE;
+    }
+
+    // Initialize state for new instance
+    InitializeNewInstance(NewIndex, Transform);
+
+    // Add to spatial index
+    SpatialIndex.AddInstance(NewIndex, Transform.GetLocation());
+    CellBounds.Add(Transform.GetLocation());
+    SyncBroadphaseBounds();
+
+    // Update bounds (O(1) - just expand)
+    if (bUpdateBounds)
+    {
+        ExpandBoundsToInclude(Transform.GetLocation());
+    }
+
+    if(bTriggerFeedbacks)
+		TriggerFeedbackOnSpawnInternal(NewIndex, InstigatorComponent);
+
+    // Notify subclass
+    OnInstanceAdded(NewIndex, Transform);
+
+    return NewIndex;
+}
+
+TArray<int32> UISMRuntimeComponent::BatchAddInstances(const TArray<FTransform>& Transforms, bool bUpdateBounds, bool bReturnInstances, bool bRegenerateNavigation, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::BatchAddInstances);
+    SCOPE_CYCLE_COUNTER(STAT_ISMAddInstances);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+    WakeIfDormant();
+
+    TArray<int32> NewIndices;
+    NewIndices.Reserve(Transforms.Num());
+    
+    if (!ManagedISMComponent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Cannot add instances - no managed ISM component"));
+        // Return array of INDEX_NONE
+        for (int32 i = 0; i < Transforms.Num(); i++)
+        {
+            NewIndices.Add(INDEX_NONE);
+        }
+        return NewIndices;
+    }
+
+    if (!bIsInitialized)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: Batch adding instances before initialization on %s"),
+            *GetOwner()->GetName());
+    }
+
+    // Track bounds expansion
+    FBox NewInstancesBounds(EForceInit::ForceInit);
+    bool bHasValidInstances = false;
+    auto TrackBounds = [&](const FVector& Location)
+        {
+            if (!bUpdateBounds)
+            {
+                return;
+            }
+            if (bHasValidInstances)
+            {
+                NewInstancesBounds += Location;
+            }
+            else
+            {
+                NewInstancesBounds = FBox(Location, Location);
+                bHasValidInstances = true;
+            }
+        };
+
+    NewIndices.Init(INDEX_NONE, Transforms.Num());
+
+    // Fill destroyed slots first, whatever is left gets appended
+    TArray<FTransform> AppendTransforms;
+    TArray<int32> AppendSources;
+    for (int32 i = 0; i < Transforms.Num(); i++)
+    {
+        const int32 RecycledIndex = FindRecyclableInstanceSlot();
+        if (RecycledIndex == INDEX_NONE)
+        {
+            AppendTransforms.Reserve(Transforms.Num() - i);
+            AppendSources.Reserve(Transforms.Num() - i);
+            for (int32 j = i; j < Transforms.Num(); j++)
+            {
+                AppendTransforms.Add(Transforms[j]);
+                AppendSources.Add(j);
+            }
+            break;
+        }
+
+        RecycleInstanceSlot(RecycledIndex, Transforms[i]);
+        TrackBounds(Transforms[i].GetLocation());
+        OnInstanceAdded(RecycledIndex, Transforms[i]);
+        NewIndices[i] = RecycledIndex;
+    }
+
+    if (AppendTransforms.Num() > 0)
+    {
+        // Add remaining instances to ISM in batch (more efficient than individual adds)
+        TArray<int32> AddedIndices = ManagedISMComponent->AddInstances(AppendTransforms, bReturnInstances, true, bRegenerateNavigation);
+
+        if (AddedIndices.Num() != AppendTransforms.Num())
+        {
+            UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Batch add returned unexpected number of indices"));
+            return NewIndices;
+        }
+
+        // Initialize state and spatial index for each new instance
+        for (int32 i = 0; i < AddedIndices.Num(); i++)
+        {
+            int32 NewIndex = AddedIndices[i];
+
+            if (NewIndex == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const FTransform& Transform = AppendTransforms[i];
+
+            // Initialize state
+            InitializeNewInstance(NewIndex, Transform);
+
+            // Add to spatial index
+            SpatialIndex.AddInstance(NewIndex, Transform.GetLocation());
+            CellBounds.Add(Transform.GetLocation());
+
+            TrackBounds(Transform.GetLocation());
+
+            // Notify subclass
+            OnInstanceAdded(NewIndex, Transform);
+
+            NewIndices[AppendSources[i]] = NewIndex;
+        }
+    }
+
+    // Update bounds once for all new instances (O(1))
+    if (bUpdateBounds && bHasValidInstances)
+    {
+        if (bBoundsValid)
+        {
+            CachedInstanceBounds += NewInstancesBounds.ExpandBy(BoundsPadding);
+        }
+        else
+        {
+            CachedInstanceBounds = NewInstancesBounds.ExpandBy(BoundsPadding);
+            bBoundsValid = true;
+        }
+    }
+    SyncBroadphaseBounds();
+    INC_DWORD_STAT_BY(STAT_ISMInstancesAdded, Transforms.Num());
+    BroadcastBatchedInstancesAdded(NewIndices);
+
+    if (bTriggerFeedbacks)
+    {
+        TArray<int32> Spawned;
+        Spawned.Reserve(NewIndices.Num());
+        for (int32 Index : NewIndices)
+        {
+            if (Index != INDEX_NONE)
+            {
+                Spawned.Add(Index);
+            }
+        }
+        TriggerFeedbackBatchedOnSpawnInternal(Spawned, InstigatorComponent);
+    }
+    UE_LOG(LogTemp, Verbose, TEXT("ISMRuntimeComponent: Batch added %d instances"), NewIndices.Num());
+
+    return NewIndices;
+}
+
+TArray<int32> UISMRuntimeComponent::BulkAppendInstances(const TArray<FTransform>& Transforms, TConstArrayView<float> CustomData,
+    int32 CustomDataStride, bool bUpdateBounds)
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::BulkAppendInstances);
+    SCOPE_CYCLE_COUNTER(STAT_ISMAddInstances);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+    WakeIfDormant();
+
+    TArray<int32> NewIndices;
+    if (!ManagedISMComponent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Cannot add instances - no managed ISM component"));
+        return NewIndices;
+    }
+
+    const int32 NumNew = Transforms.Num();
+    if (NumNew == 0)
+    {
+        return NewIndices;
+    }
+
+    if (CustomDataStride < 0 || (CustomDataStride > 0 && CustomData.Num() != NumNew * CustomDataStride))
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: Bulk append on %s got %d custom data floats for %d instances of stride %d"),
+            *GetName(), CustomData.Num(), NumNew, CustomDataStride);
+        return NewIndices;
+    }
+
+    // Grow every per-instance array once up front
+    const int32 FirstIndex = ManagedISMComponent->GetInstanceCount();
+    const int32 Stride = ManagedISMComponent->NumCustomDataFloats;
+    ManagedISMComponent->PerInstanceSMData.Reserve(FirstIndex + NumNew);
+    ManagedISMComponent->PerInstanceSMCustomData.Reserve((FirstIndex + NumNew) * Stride);
+    InstanceStates.Reserve(FirstIndex + NumNew);
+
+    const TArray<int32> AddedIndices = ManagedISMComponent->AddInstances(Transforms, true, true, false);
+    if (AddedIndices.Num() != NumNew || AddedIndices[0] != FirstIndex || AddedIndices.Last() != FirstIndex + NumNew - 1)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Bulk append returned unexpected indices"));
+        return NewIndices;
+    }
+
+    // The new rows are contiguous: one copy when the strides match, one per row otherwise
+    if (Stride > 0 && CustomDataStride > 0)
+    {
+        float* Dest = ManagedISMComponent->PerInstanceSMCustomData.GetData() + FirstIndex * Stride;
+        if (CustomDataStride == Stride)
+        {
+            FMemory::Memcpy(Dest, CustomData.GetData(), NumNew * Stride * sizeof(float));
+        }
+        else
+        {
+            const int32 NumCopied = FMath::Min(Stride, CustomDataStride);
+            for (int32 Row = 0; Row < NumNew; Row++)
+            {
+                FMemory::Memcpy(Dest + Row * Stride, CustomData.GetData() + Row * CustomDataStride, NumCopied * sizeof(float));
+            }
+        }
+        MarkCustomDataDirty();
+    }
+
+    NewIndices.SetNumUninitialized(NumNew);
+    TArray<FVector> Locations;
+    Locations.SetNumUninitialized(NumNew);
+    FBox NewInstancesBounds(EForceInit::ForceInit);
+
+    // Per-instance native events (the intact tag) collect into one batch event
+    BeginNativeBatch();
+    for (int32 i = 0; i < NumNew; i++)
+    {
+        const int32 NewIndex = FirstIndex + i;
+        NewIndices[i] = NewIndex;
+        Locations[i] = Transforms[i].GetLocation();
+
+        InitializeNewInstance(NewIndex, Transforms[i]);
+        CellBounds.Add(Locations[i]);
+        NewInstancesBounds += Locations[i];
+    }
+
+    SpatialIndex.AddInstances(NewIndices, Locations);
+
+    for (int32 i = 0; i < NumNew; i++)
+    {
+        OnInstanceAdded(NewIndices[i], Transforms[i]);
+    }
+
+    if (bUpdateBounds)
+    {
+        if (bBoundsValid)
+        {
+            CachedInstanceBounds += NewInstancesBounds.ExpandBy(BoundsPadding);
+        }
+        else
+        {
+            CachedInstanceBounds = NewInstancesBounds.ExpandBy(BoundsPadding);
+            bBoundsValid = true;
+        }
+    }
+    SyncBroadphaseBounds();
+    EndNativeBatch();
+
+    BroadcastBatchedInstancesAdded(NewIndices);
+    INC_DWORD_STAT_BY(STAT_ISMInstancesAdded, NumNew);
+    UE_LOG(LogTemp, Verbose, TEXT("ISMRuntimeComponent: Bulk appended %d instances"), NumNew);
+
+    return NewIndices;
+}
+
+int32 UISMRuntimeComponent::AddInstanceWithCustomData(const FTransform& Transform, const TArray<float>& CustomData, bool bUpdateBounds)
+{
+    int32 NewIndex = AddInstance(Transform, bUpdateBounds);
+
+    if (NewIndex != INDEX_NONE && CustomData.Num() > 0)
+    {
+        SetInstanceCustomData(NewIndex, CustomData);
+    }
+
+    return NewIndex;
+}
+
+void UISMRuntimeComponent::InitializeNewInstance(int32 InstanceIndex, const FTransform& Transform)
+{
+    // Create state entry
+    // Create state entry (starts as intact)
+    InstanceStates.Add(InstanceIndex, GFrameCounter);
+    InstanceColumns.ResetSlot(InstanceIndex);
+
+	UpdateInstanceWorldBounds(InstanceIndex, Transform);
+
+    // New and recycled slots are new to every consumer
+    ChangeTracker.MarkChanged(InstanceIndex, 0xFF);
+
+    // Add default state tag
+    AddInstanceTag(InstanceIndex, FGameplayTag::RequestGameplayTag("ISM.State.Intact"));
+
+    OpCounters.Count(EISMComponentOp::Add);
+}
+
+int32 UISMRuntimeComponent::FindRecyclableInstanceSlot() const
+{
+    // In-flight batch snapshots still refer to destroyed indices by number
+    if (!bRecycleDestroyedInstances || bBatchLocked)
+    {
+        return INDEX_NONE;
+    }
+
+    if (InstanceStates.FindDestroyedSlot() == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    for (TConstSetBitIterator<> It(InstanceStates.GetDestroyedSlots()); It; ++It)
+    {
+        const int32 SlotIndex = It.GetIndex();
+        if (IsValidInstanceIndex(SlotIndex) && !IsInstanceConverted(SlotIndex))
+        {
+            return SlotIndex;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+void UISMRuntimeComponent::RecycleInstanceSlot(int32 InstanceIndex, const FTransform& Transform)
+{
+    const FVector OldLocation = GetInstanceLocation(InstanceIndex);
+
+    ManagedISMComponent->UpdateInstanceTransform(InstanceIndex, Transform, true, !bHeadless);
+
+    // Drop everything the previous occupant left behind
+    const int32 NumCustomData = ManagedISMComponent->NumCustomDataFloats;
+    if (NumCustomData > 0)
+    {
+        TArray<float> ZeroData;
+        ZeroData.SetNumZeroed(NumCustomData);
+        ManagedISMComponent->SetCustomData(InstanceIndex, ZeroData, !bHeadless);
+    }
+
+    const bool bHadCompactTags = CompactInstanceTags.ClearInstance(InstanceIndex);
+    if (PerInstanceTags.Remove(InstanceIndex) > 0 || bHadCompactTags)
+    {
+        BroadcastTagChange(InstanceIndex);
+    }
+    InstanceHandles.Remove(InstanceIndex);
+
+    InitializeNewInstance(InstanceIndex, Transform);
+    SpatialIndex.UpdateInstance(InstanceIndex, OldLocation, Transform.GetLocation());
+
+    // In-flight batch results may still list this index for its previous occupant
+    BumpCellStructureGeneration(InstanceIndex, OldLocation, Transform.GetLocation());
+
+    // The destroyed occupant already left CellBounds
+    CellBounds.Add(Transform.GetLocation());
+}
+
+uint32 UISMRuntimeComponent::GetCellStructureGeneration(const FIntVector& Cell) const
+{
+    const uint32* CellGeneration = CellStructureGenerations.Find(Cell);
+    return CellGeneration ? FMath::Max(*CellGeneration, StructureGenerationFloor) : StructureGenerationFloor;
+}
+
+void UISMRuntimeComponent::BumpCellStructureGeneration(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation)
+{
+    if (CellCrossedSlots.IsValidIndex(InstanceIndex) && CellCrossedSlots[InstanceIndex])
+    {
+        // Older snapshots of cells the slot passed through may list it too
+        CellCrossedSlots[InstanceIndex] = false;
+        BumpAllCellStructureGenerations();
+        return;
+    }
+
+    ++StructureGeneration;
+    CellStructureGenerations.Add(SpatialIndex.WorldLocationToCell(OldLocation), StructureGeneration);
+    CellStructureGenerations.Add(SpatialIndex.WorldLocationToCell(NewLocation), StructureGeneration);
+}
+
+void UISMRuntimeComponent::BumpAllCellStructureGenerations()
+{
+    StructureGenerationFloor = ++StructureGeneration;
+    CellStructureGenerations.Reset();
+
+    // Every earlier snapshot is stale now, so where slots used to be no longer matters
+    CellCrossedSlots.Reset();
+}
+
+void UISMRuntimeComponent::NoteCellCrossing(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation)
+{
+    if (CellCrossedSlots.IsValidIndex(InstanceIndex) && CellCrossedSlots[InstanceIndex])
+    {
+        return;
+    }
+
+    if (SpatialIndex.WorldLocationToCell(OldLocation) == SpatialIndex.WorldLocationToCell(NewLocation))
+    {
+        return;
+    }
+
+    if (InstanceIndex >= CellCrossedSlots.Num())
+    {
+        CellCrossedSlots.Add(false, InstanceIndex + 1 - CellCrossedSlots.Num());
+    }
+    CellCrossedSlots[InstanceIndex] = true;
+}
+
+void UISMRuntimeComponent::OnInstanceAdded(int32 InstanceIndex, const FTransform& Transform)
+{
+    // Base implementation does nothing
+    // Subclasses override for custom initialization
+}
+
+
+
+
+void UISMRuntimeComponent::RecalculateInstanceBounds()
+{
+    CellBounds.Reset(SpatialIndex.GetCellSize());
+    
+    if (!ManagedISMComponent)
+    {
+        CachedInstanceBounds = FBox(EForceInit::ForceInit);
+        bBoundsValid = false;
+        return;
+    }
+    
+    // O(n) operation - iterate all instances
+    for (int32 i = 0; i < ManagedISMComponent->GetInstanceCount(); i++)
+    {
+        // Skip destroyed/inactive instances
+        if (!IsInstanceActive(i))
+        {
+            continue;
+        }
+        
+        CellBounds.Add(GetInstanceLocation(i));
+    }
+    
+    PublishCellBounds();
+}
+
+void UISMRuntimeComponent::RefreshInstanceBounds()
+{
+    CellBounds.RefreshDirtyCells([this](const FBox& CellBox, TFunctionRef<void(const FVector&)> AddPoint)
+        {
+            SpatialIndex.ForEachInstanceInBox(CellBox, [this, &AddPoint](int32 InstanceIndex)
+                {
+                    FVector Position;
+                    if (IsInstanceActive(InstanceIndex) && SpatialIndex.GetInstancePosition(InstanceIndex, Position))
+                    {
+                        AddPoint(Position);
+                    }
+                    return true;
+                });
+        });
+
+    PublishCellBounds();
+}
+
+void UISMRuntimeComponent::PublishCellBounds()
+{
+    const FBox& Union = CellBounds.GetBounds();
+
+    // Add padding to account for instance mesh size
+    bBoundsValid = Union.IsValid != 0;
+    CachedInstanceBounds = bBoundsValid ? Union.ExpandBy(BoundsPadding) : FBox(EForceInit::ForceInit);
+
+    SyncBroadphaseBounds();
+}
+
+bool UISMRuntimeComponent::GetBroadphaseBounds(FBox& OutBounds) const
+{
+    OutBounds = FBox(ForceInit);
+    if (!bIsInitialized || SpatialIndex.GetOversizedInstanceCount() > 0)
+    {
+        return false;
+    }
+
+    // CellBounds holds pivots; MaxBoundsReach covers every non-oversized AABB around its pivot
+    const FBox& Union = CellBounds.GetBounds();
+    if (Union.IsValid)
+    {
+        OutBounds = Union.ExpandBy(SpatialIndex.GetMaxBoundsReach());
+    }
+    return true;
+}
+
+void UISMRuntimeComponent::SyncBroadphaseBounds()
+{
+    FBox Bounds;
+    const bool bUnbounded = !GetBroadphaseBounds(Bounds);
+    if (bUnbounded == bReportedBroadphaseUnbounded && Bounds.Equals(ReportedBroadphaseBounds, 0.0)
+        && Bounds.IsValid == ReportedBroadphaseBounds.IsValid)
+    {
+        return;
+    }
+
+    ReportedBroadphaseBounds = Bounds;
+    bReportedBroadphaseUnbounded = bUnbounded;
+    if (UISMRuntimeSubsystem* Subsystem = CachedSubsystem.Get())
+    {
+        Subsystem->MarkComponentBoundsDirty(this);
+    }
+}
+
+void UISMRuntimeComponent::ExpandBoundsToInclude(const FVector& Location)
+{
+    if (bBoundsValid)
+    {
+        // O(1) - just expand existing bounds, padded like RecalculateInstanceBounds
+        CachedInstanceBounds += FBox(Location, Location).ExpandBy(BoundsPadding);
+    }
+    else
+    {
+        // Initialize bounds with this location
+        CachedInstanceBounds = FBox(Location, Location);
+        CachedInstanceBounds = CachedInstanceBounds.ExpandBy(BoundsPadding);
+        bBoundsValid = true;
+    }
+}
+
+bool UISMRuntimeComponent::IsLocationOnBoundsEdge(const FVector& Location, float Tolerance) const
+{
+    if (!bBoundsValid)
+    {
+        return false; // No bounds = can't be on edge
+    }
+    
+    // Check if location is within Tolerance of any face of the bounds
+    FVector Min = CachedInstanceBounds.Min;
+    FVector Max = CachedInstanceBounds.Max;
+    
+    // Check each axis
+    bool bOnMinX = FMath::Abs(Location.X - Min.X) <= Tolerance;
+    bool bOnMaxX = FMath::Abs(Location.X - Max.X) <= Tolerance;
+    bool bOnMinY = FMath::Abs(Location.Y - Min.Y) <= Tolerance;
+    bool bOnMaxY = FMath::Abs(Location.Y - Max.Y) <= Tolerance;
+    bool bOnMinZ = FMath::Abs(Location.Z - Min.Z) <= Tolerance;
+    bool bOnMaxZ = FMath::Abs(Location.Z - Max.Z) <= Tolerance;
+    
+    // On edge if on any face
+    return bOnMinX || bOnMaxX || bOnMinY || bOnMaxY || bOnMinZ || bOnMaxZ;
+}
+
+
+
+
+
+
+bool UISMRuntimeComponent::IsInstanceDestroyed(int32 InstanceIndex) const
+{
+    return InstanceStates.HasFlag(InstanceIndex, EISMInstanceState::Destroyed);
+}
+
+bool UISMRuntimeComponent::IsInstanceActive(int32 InstanceIndex) const
+{
+    return InstanceStates.IsActive(InstanceIndex);
+}
+
+int32 UISMRuntimeComponent::GetInstanceCount() const
+{
+    return ManagedISMComponent ? ManagedISMComponent->GetInstanceCount() : 0;
+}
+
+int32 UISMRuntimeComponent::GetActiveInstanceCount() const
+{
+    return InstanceStates.GetActiveCount();
+}
+
+int32 UISMRuntimeComponent::GetInstanceCountInState(EISMInstanceState State) const
+{
+    return InstanceStates.GetFlagCount(State);
+}
+
+FTransform UISMRuntimeComponent::GetInstanceTransform(int32 InstanceIndex) const
+{
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return FTransform::Identity;
+    }
+
+    // Get from ISM
+    FTransform Transform;
+    ManagedISMComponent->GetInstanceTransform(InstanceIndex, Transform, true);
+
+    return Transform;
+}
+
+FVector UISMRuntimeComponent::GetInstanceLocation(int32 InstanceIndex) const
+{
+    return GetInstanceTransform(InstanceIndex).GetLocation();
+}
+
+
+
+TArray<int32> UISMRuntimeComponent::GetInstancesInRadius(const FVector& Location, float Radius, bool bIncludeDestroyed) const
+{
+    TArray<int32> Results;
+    GetInstancesInRadius(Location, Radius, Results, bIncludeDestroyed);
+    return Results;
+}
+
+void UISMRuntimeComponent::GetInstancesInRadius(const FVector& Location, float Radius, TArray<int32>& OutIndices, bool bIncludeDestroyed) const
+{
+    ForEachInstanceInRadius(Location, Radius, [&OutIndices](int32 Index)
+        {
+            OutIndices.Add(Index);
+            return true;
+        }, bIncludeDestroyed);
+}
+
+bool UISMRuntimeComponent::ForEachInstanceInRadius(const FVector& Location, float Radius, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::ForEachInstanceInRadius);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    // Exact test runs against the index's packed positions - no false positives
+    int32 NumVisited = 0;
+    const bool bCompleted = SpatialIndex.ForEachInstanceInRadius(Location, Radius, [this, &Visitor, bIncludeDestroyed, &NumVisited](int32 Index)
+        {
+            if (!bIncludeDestroyed && !IsInstanceActive(Index))
+            {
+                return true;
+            }
+            ++NumVisited;
+            return Visitor(Index);
+        });
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, NumVisited);
+    return bCompleted;
+}
+
+void UISMRuntimeComponent::ForEachInstanceInRadiusBatch(TConstArrayView<FISMSpatialSphereQuery> Queries, TFunctionRef<void(int32, int32)> Visitor, bool bIncludeDestroyed) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::ForEachInstanceInRadiusBatch);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query, Queries.Num());
+
+    int32 NumVisited = 0;
+    SpatialIndex.ForEachInstanceInRadiusBatch(Queries, [this, &Visitor, bIncludeDestroyed, &NumVisited](int32 QueryIdx, int32 Index)
+        {
+            if (bIncludeDestroyed || IsInstanceActive(Index))
+            {
+                ++NumVisited;
+                Visitor(QueryIdx, Index);
+            }
+        });
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, NumVisited);
+}
+
+TArray<int32> UISMRuntimeComponent::GetInstancesInBox(const FBox& Box, bool bIncludeDestroyed) const
+{
+    TArray<int32> Results;
+    GetInstancesInBox(Box, Results, bIncludeDestroyed);
+    return Results;
+}
+
+void UISMRuntimeComponent::GetInstancesInBox(const FBox& Box, TArray<int32>& OutIndices, bool bIncludeDestroyed) const
+{
+    ForEachInstanceInBox(Box, [&OutIndices](int32 Index)
+        {
+            OutIndices.Add(Index);
+            return true;
+        }, bIncludeDestroyed);
+}
+
+bool UISMRuntimeComponent::ForEachInstanceInBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::ForEachInstanceInBox);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    int32 NumVisited = 0;
+    const bool bCompleted = SpatialIndex.ForEachInstanceInBox(Box, [this, &Visitor, bIncludeDestroyed, &NumVisited](int32 Index)
+        {
+            if (!bIncludeDestroyed && !IsInstanceActive(Index))
+            {
+                return true;
+            }
+            ++NumVisited;
+            return Visitor(Index);
+        });
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, NumVisited);
+    return bCompleted;
+}
+
+bool UISMRuntimeComponent::ForEachInstanceInRadiusWithTags(const FVector& Location, float Radius, const FISMTagMask& RequiredTagMask, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed) const
+{
+    if (!bCompactInstanceTags)
+    {
+        return ForEachInstanceInRadius(Location, Radius, Visitor, bIncludeDestroyed);
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::ForEachInstanceInRadiusWithTags);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    int32 NumVisited = 0;
+    const bool bCompleted = SpatialIndex.ForEachInstanceInRadiusWithTags(Location, Radius, RequiredTagMask, [this, &Visitor, bIncludeDestroyed, &NumVisited](int32 Index)
+        {
+            if (!bIncludeDestroyed && !IsInstanceActive(Index))
+            {
+                return true;
+            }
+            ++NumVisited;
+            return Visitor(Index);
+        });
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, NumVisited);
+    return bCompleted;
+}
+
+bool UISMRuntimeComponent::ForEachInstanceInBoxWithTags(const FBox& Box, const FISMTagMask& RequiredTagMask, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed) const
+{
+    if (!bCompactInstanceTags)
+    {
+        return ForEachInstanceInBox(Box, Visitor, bIncludeDestroyed);
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::ForEachInstanceInBoxWithTags);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    int32 NumVisited = 0;
+    const bool bCompleted = SpatialIndex.ForEachInstanceInBoxWithTags(Box, RequiredTagMask, [this, &Visitor, bIncludeDestroyed, &NumVisited](int32 Index)
+        {
+            if (!bIncludeDestroyed && !IsInstanceActive(Index))
+            {
+                return true;
+            }
+            ++NumVisited;
+            return Visitor(Index);
+        });
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, NumVisited);
+    return bCompleted;
+}
+
+int32 UISMRuntimeComponent::GetNearestInstance(const FVector& Location, float MaxDistance, bool bIncludeDestroyed) const
+{
+    TArray<FISMSpatialNeighbor> Neighbors;
+    FindNearestInstances(Location, 1, MaxDistance, [this, bIncludeDestroyed](int32 Index)
+        {
+            return bIncludeDestroyed || IsInstanceActive(Index);
+        }, Neighbors);
+
+    return Neighbors.Num() > 0 ? Neighbors[0].InstanceIndex : INDEX_NONE;
+}
+
+TArray<int32> UISMRuntimeComponent::GetNearestInstances(const FVector& Location, int32 Count, float MaxDistance, bool bIncludeDestroyed) const
+{
+    TArray<FISMSpatialNeighbor> Neighbors;
+    FindNearestInstances(Location, Count, MaxDistance, [this, bIncludeDestroyed](int32 Index)
+        {
+            return bIncludeDestroyed || IsInstanceActive(Index);
+        }, Neighbors);
+
+    TArray<int32> Results;
+    Results.Reserve(Neighbors.Num());
+    for (const FISMSpatialNeighbor& Neighbor : Neighbors)
+    {
+        Results.Add(Neighbor.InstanceIndex);
+    }
+
+    return Results;
+}
+
+void UISMRuntimeComponent::FindNearestInstances(const FVector& Location, int32 Count, float MaxDistance,
+    TFunctionRef<bool(int32)> Filter, TArray<FISMSpatialNeighbor>& OutNeighbors) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::FindNearestInstances);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    SpatialIndex.FindKNearest(Location, Count, OutNeighbors, MaxDistance, Filter);
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, OutNeighbors.Num());
+}
+
+TArray<int32> UISMRuntimeComponent::TraceInstances(const FVector& Start, const FVector& End, float Radius, bool bFirstHitOnly, bool bIncludeDestroyed) const
+{
+    TArray<FISMSpatialRayHit> Hits;
+    TraceInstances(Start, End, Radius, bFirstHitOnly, [this, bIncludeDestroyed](int32 Index)
+        {
+            return bIncludeDestroyed || IsInstanceActive(Index);
+        }, Hits);
+
+    TArray<int32> Results;
+    Results.Reserve(Hits.Num());
+    for (const FISMSpatialRayHit& Hit : Hits)
+    {
+        Results.Add(Hit.InstanceIndex);
+    }
+
+    return Results;
+}
+
+void UISMRuntimeComponent::TraceInstances(const FVector& Start, const FVector& End, float Radius, bool bFirstHitOnly,
+    TFunctionRef<bool(int32)> Filter, TArray<FISMSpatialRayHit>& OutHits) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::TraceInstances);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    SpatialIndex.QueryRay(Start, End, Radius, OutHits, bFirstHitOnly, Filter);
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, OutHits.Num());
+}
+
+void UISMRuntimeComponent::TraceInstancesRefined(const FVector& Start, const FVector& End, float Radius, bool bFirstHitOnly,
+    TFunctionRef<bool(int32, float&)> Refine, TArray<FISMSpatialRayHit>& OutHits) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::TraceInstancesRefined);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    SpatialIndex.QueryRayRefined(Start, End, Radius, OutHits, bFirstHitOnly, Refine);
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, OutHits.Num());
+}
+
+bool UISMRuntimeComponent::IntersectInstanceOrientedBounds(int32 InstanceIndex, const FVector& Start, const FVector& Dir, float MaxDistance, float Radius,
+    float& OutDistance, FVector& OutNormal) const
+{
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return false;
+    }
+
+    // Same local box the instance AABBs are built from, falling back to the raw mesh bounds
+    FBox LocalBounds(ForceInit);
+    if (InstanceData)
+    {
+        LocalBounds = InstanceData->GetEffectiveLocalBounds();
+    }
+    else if (const UStaticMesh* Mesh = ManagedISMComponent ? ManagedISMComponent->GetStaticMesh() : nullptr)
+    {
+        LocalBounds = Mesh->GetBoundingBox();
+    }
+
+    const FTransform Transform = GetInstanceTransform(InstanceIndex);
+    const FVector Scale = Transform.GetScale3D();
+    if (!LocalBounds.IsValid || Scale.IsNearlyZero())
+    {
+        return false;
+    }
+
+    // Into instance space; the unnormalized local direction keeps the ray parameter in world units
+    const FVector LocalStart = Transform.InverseTransformPosition(Start);
+    const FVector LocalDir = Transform.InverseTransformVector(Dir);
+    const FVector Inflate(
+        Radius / FMath::Max(FMath::Abs(Scale.X), UE_KINDA_SMALL_NUMBER),
+        Radius / FMath::Max(FMath::Abs(Scale.Y), UE_KINDA_SMALL_NUMBER),
+        Radius / FMath::Max(FMath::Abs(Scale.Z), UE_KINDA_SMALL_NUMBER));
+    const FVector BoxMin = LocalBounds.Min - Inflate;
+    const FVector BoxMax = LocalBounds.Max + Inflate;
+
+    double TEnter = 0.0;
+    double TExit = MaxDistance;
+    int32 EnterAxis = INDEX_NONE;
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        if (FMath::IsNearlyZero(LocalDir[Axis]))
+        {
+            // Parallel to this slab: must already be inside it
+            if (LocalStart[Axis] < BoxMin[Axis] || LocalStart[Axis] > BoxMax[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        double T0 = (BoxMin[Axis] - LocalStart[Axis]) / LocalDir[Axis];
+        double T1 = (BoxMax[Axis] - LocalStart[Axis]) / LocalDir[Axis];
+        if (T0 > T1)
+        {
+            Swap(T0, T1);
+        }
+
+        if (T0 > TEnter)
+        {
+            TEnter = T0;
+            EnterAxis = Axis;
+        }
+        TExit = FMath::Min(TExit, T1);
+        if (TEnter > TExit)
+        {
+            return false;
+        }
+    }
+
+    OutDistance = static_cast<float>(TEnter);
+    if (EnterAxis == INDEX_NONE)
+    {
+        OutNormal = -Dir;
+        return true;
+    }
+
+    // Entered the face opposing the local direction; mirrored axes flip it back
+    FVector LocalNormal = FVector::ZeroVector;
+    LocalNormal[EnterAxis] = (LocalDir[EnterAxis] > 0.0 ? -1.0 : 1.0) * FMath::Sign(Scale[EnterAxis]);
+    OutNormal = Transform.TransformVectorNoScale(LocalNormal).GetSafeNormal();
+    return true;
+}
+
+void UISMRuntimeComponent::SetSpatialQueryTelemetryEnabled(bool bEnabled)
+{
+    bSpatialQueryTelemetry = bEnabled;
+    SpatialIndex.SetQueryTelemetryEnabled(bEnabled);
+}
+
+void UISMRuntimeComponent::ResetSpatialQueryTelemetry()
+{
+    SpatialIndex.ResetQueryTelemetry();
+}
+
+FISMSpatialIndexHealth UISMRuntimeComponent::GetSpatialIndexHealth() const
+{
+    FISMSpatialIndexHealth Health;
+    Health.Component = const_cast<UISMRuntimeComponent*>(this);
+    Health.CellSize = SpatialIndex.GetCellSize();
+    Health.CellCount = SpatialIndex.GetCellCount();
+    Health.AverageInstancesPerCell = SpatialIndex.GetAverageInstancesPerCell();
+    Health.MaxInstancesPerCell = SpatialIndex.GetMaxInstancesPerCell();
+    SpatialIndex.GetCellOccupancyHistogram(Health.CellOccupancyHistogram);
+
+    const FISMSpatialQueryTelemetry* Telemetry = SpatialIndex.GetQueryTelemetry();
+    Health.bTelemetryEnabled = Telemetry != nullptr;
+    if (!Telemetry)
+    {
+        return Health;
+    }
+
+    const uint64 NumQueries = Telemetry->NumQueries.load(std::memory_order_relaxed);
+    const uint64 NumCandidates = Telemetry->NumCandidates.load(std::memory_order_relaxed);
+    const uint64 NumHits = Telemetry->NumHits.load(std::memory_order_relaxed);
+
+    Health.QueryCount = static_cast<int64>(NumQueries);
+    Health.MeanCandidatesPerQuery = NumQueries > 0 ? static_cast<float>(static_cast<double>(NumCandidates) / NumQueries) : 0.0f;
+    Health.FalsePositiveRatio = NumCandidates > 0 ? static_cast<float>(1.0 - FMath::Min(static_cast<double>(NumHits) / NumCandidates, 1.0)) : 0.0f;
+    Health.MedianQueryRadius = Telemetry->GetMedianRadius();
+    Health.RecommendedCellSize = SpatialIndex.GetRecommendedCellSize();
+    return Health;
 }
 
-int32 UISMRuntimeComponent::AddInstance(const FTransform& Transform, bool bUpdateBounds, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+FISMComponentOpStats UISMRuntimeComponent::GetOpStats(int32 MaxHotInstances) const
 {
-    if (!ManagedISMComponent)
+    FISMComponentOpStats Stats;
+    Stats.Component = const_cast<UISMRuntimeComponent*>(this);
+    OpCounters.GetStats(Stats, MaxHotInstances);
+    return Stats;
+}
+
+void UISMRuntimeComponent::SetHotInstanceSampling(bool bEnabled)
+{
+    bSampleHotInstances = bEnabled;
+    OpCounters.SetSamplingEnabled(bEnabled);
+}
+
+void UISMRuntimeComponent::ResetOpCounters()
+{
+    OpCounters.Reset();
+}
+
+FISMComponentMemoryStats UISMRuntimeComponent::GetMemoryStats() const
+{
+    FISMComponentMemoryStats Stats;
+    Stats.Component = const_cast<UISMRuntimeComponent*>(this);
+    Stats.InstanceCount = GetInstanceCount();
+    Stats.InstanceStateBytes = static_cast<int64>(InstanceStates.GetAllocatedSize() + InstanceColumns.GetAllocatedSize()
+        + DormantState.GetAllocatedSize());
+
+    SIZE_T TagBytes = CompactInstanceTags.GetAllocatedSize() + PerInstanceTags.GetAllocatedSize();
+    for (const TPair<int32, FGameplayTagContainer>& Pair : PerInstanceTags)
     {
-        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Cannot add instance - no managed ISM component"));
-        return INDEX_NONE;
+        TagBytes += Pair.Value.GetGameplayTagArray().GetAllocatedSize();
     }
+    Stats.TagBytes = static_cast<int64>(TagBytes);
 
-    if (!bIsInitialized)
+    Stats.HandleBytes = static_cast<int64>(InstanceHandles.GetAllocatedSize() + InitialIndexRemap.GetAllocatedSize());
+
+    // The snapshot is a full copy of the index for as long as any reader holds it
+    SIZE_T SpatialBytes = SpatialIndex.GetAllocatedSize() + CellBounds.GetAllocatedSize()
+        + CellStructureGenerations.GetAllocatedSize() + CellCrossedSlots.GetAllocatedSize();
+    if (const FISMSpatialIndexSnapshot Snapshot = GetSpatialIndexSnapshot())
     {
-        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: Adding instance before initialization on %s"),
-            *GetOwner()->GetName());
+        SpatialBytes += sizeof(FISMSpatialIndex) + Snapshot->GetAllocatedSize();
     }
+    Stats.SpatialIndexBytes = static_cast<int64>(SpatialBytes);
 
-    // Add to ISM component
-    int32 NewIndex = ManagedISMComponent->AddInstance(Transform);
-
-    if (NewIndex == INDEX_NONE)
+    Stats.OtherBytes = static_cast<int64>(ChangeTracker.GetAllocatedSize() + CustomDataJournal.GetAllocatedSize()
+        + NativeBatchInstances.GetAllocatedSize());
+    for (const TBitArray<>& Pending : PendingInstanceEvents)
     {
-        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Failed to add instance to ISM"));
-        return INDEX_NONE;
+        Stats.OtherBytes += static_cast<int64>(Pending.GetAllocatedSize());
     }
 
-    // Initialize state for new instance
-    InitializeNewInstance(NewIndex, Transform);
+    Stats.TotalBytes = Stats.InstanceStateBytes + Stats.TagBytes + Stats.HandleBytes + Stats.SpatialIndexBytes + Stats.OtherBytes;
+    return Stats;
+}
 
-    // Add to spatial index
-    SpatialIndex.AddInstance(NewIndex, Transform.GetLocation());
+SIZE_T UISMRuntimeComponent::GetAllocatedSize() const
+{
+    return static_cast<SIZE_T>(GetMemoryStats().TotalBytes);
+}
 
-    // Update bounds (O(1) - just expand)
-    if (bUpdateBounds)
+FISMSpatialIndexSnapshot UISMRuntimeComponent::GetSpatialIndexSnapshot() const
+{
+    FReadScopeLock ReadLock(SnapshotLock);
+    return SpatialIndexSnapshot;
+}
+
+void UISMRuntimeComponent::PublishSpatialIndexSnapshot()
+{
+    check(IsInGameThread());
+
+    if (SpatialIndexSnapshot.IsValid() && SnapshotRevision == SpatialIndex.GetRevision())
     {
-        ExpandBoundsToInclude(Transform.GetLocation());
+        return;
     }
 
-    if(bTriggerFeedbacks)
-		TriggerFeedbackOnSpawnInternal(NewIndex, InstigatorComponent);
+    // Copy outside the lock; readers holding the old snapshot keep it alive until they let go
+    FISMSpatialIndexSnapshot NewSnapshot = MakeShared<FISMSpatialIndex, ESPMode::ThreadSafe>(SpatialIndex);
+    SnapshotRevision = SpatialIndex.GetRevision();
 
-    // Notify subclass
-    OnInstanceAdded(NewIndex, Transform);
+    FWriteScopeLock WriteLock(SnapshotLock);
+    SpatialIndexSnapshot = MoveTemp(NewSnapshot);
+}
 
-    return NewIndex;
+TArray<int32> UISMRuntimeComponent::QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter) const
+{
+    TArray<int32> Results;
+    QueryInstances(Location, Radius, Filter, Results);
+    return Results;
 }
 
-TArray<int32> UISMRuntimeComponent::BatchAddInstances(const TArray<FTransform>& Transforms, bool bUpdateBounds, bool bReturnInstances, bool bRegenerateNavigation, bool bTriggerFeedbacks, const UActorComponent* InstigatorComponent)
+void UISMRuntimeComponent::QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter, TArray<int32>& OutIndices) const
 {
-    TArray<int32> NewIndices;
-    NewIndices.Reserve(Transforms.Num());
-    
-    if (!ManagedISMComponent)
-    {
-        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Cannot add instances - no managed ISM component"));
-        // Return array of INDEX_NONE
-        for (int32 i = 0; i < Transforms.Num(); i++)
-        {
-            NewIndices.Add(INDEX_NONE);
-        }
-        return NewIndices;
-    }
+    QueryInstances(Location, Radius, Filter.Compile(), OutIndices);
+}
 
-    if (!bIsInitialized)
+void UISMRuntimeComponent::QueryInstances(const FVector& Location, float Radius, const FISMCompiledQueryFilter& Filter, TArray<int32>& OutIndices) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::QueryInstances);
+    SCOPE_CYCLE_COUNTER(STAT_ISMSpatialQuery);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+
+    // Component-constant checks once; candidates then stream straight from the spatial index into the mask tests
+    const FISMCompiledComponentFilter Bound = Filter.BindComponent(this);
+    if (!Bound.bPasses)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: Batch adding instances before initialization on %s"),
-            *GetOwner()->GetName());
+        return;
     }
 
-    // Add all instances to ISM in batch (more efficient than individual adds)
-    TArray<int32> AddedIndices = ManagedISMComponent->AddInstances(Transforms, bReturnInstances, true, bRegenerateNavigation);
+    // Required compact tags prune whole spatial cells; an empty mask walks every cell
+    const FISMTagMask RequiredTagMask = Bound.GetRequiredTagMask();
 
-    if (AddedIndices.Num() != Transforms.Num())
+    const int32 FirstResult = OutIndices.Num();
+    const int32 MaxResults = Filter.GetFilter().MaxResults;
+
+    if (!Filter.GetFilter().bSortByDistance)
     {
-        UE_LOG(LogTemp, Error, TEXT("ISMRuntimeComponent: Batch add returned unexpected number of indices"));
-        return NewIndices;
-    }
+        SpatialIndex.ForEachInstanceInRadiusWithTags(Location, Radius, RequiredTagMask, [&Filter, &Bound, &OutIndices, FirstResult, MaxResults](int32 Index)
+            {
+                if (!Filter.PassesInstance(Bound, Index))
+                {
+                    return true;
+                }
 
-    // Track bounds expansion
-    FBox NewInstancesBounds(EForceInit::ForceInit);
-    bool bHasValidInstances = false;
+                OutIndices.Add(Index);
 
-    // Initialize state and spatial index for each new instance
-    for (int32 i = 0; i < AddedIndices.Num(); i++)
-    {
-        int32 NewIndex = AddedIndices[i];
+                // Check max results limit
+                return MaxResults <= 0 || OutIndices.Num() - FirstResult < MaxResults;
+            });
+        INC_DWORD_STAT_BY(STAT_ISMQueryResults, OutIndices.Num() - FirstResult);
+        return;
+    }
 
-        if (NewIndex == INDEX_NONE)
+    // Sorted: keep the MaxResults nearest, so every candidate is considered
+    TISMNearestSelection<int32> Nearest(MaxResults);
+    SpatialIndex.ForEachInstanceInRadiusWithTags(Location, Radius, RequiredTagMask, [this, &Filter, &Bound, &Nearest, &Location](int32 Index)
         {
-            NewIndices.Add(INDEX_NONE);
-            continue;
-        }
-
-        const FTransform& Transform = Transforms[i];
+            if (Filter.PassesInstance(Bound, Index))
+            {
+                Nearest.Add(Index, static_cast<float>(FVector::DistSquared(GetInstanceLocation(Index), Location)));
+            }
+            return true;
+        });
+    Nearest.AppendSorted(OutIndices);
+    INC_DWORD_STAT_BY(STAT_ISMQueryResults, OutIndices.Num() - FirstResult);
+}
 
-        // Initialize state
-        InitializeNewInstance(NewIndex, Transform);
+// ===== Gameplay Tags =====
 
-        // Add to spatial index
-        SpatialIndex.AddInstance(NewIndex, Transform.GetLocation());
+void UISMRuntimeComponent::AddInstanceTag(int32 InstanceIndex, FGameplayTag Tag)
+{
+    if (!IsValidInstanceIndex(InstanceIndex) || !Tag.IsValid())
+    {
+        return;
+    }
 
-        // Track bounds
-        if (bUpdateBounds)
+    if (bCompactInstanceTags)
+    {
+        const int32 Bit = CompactInstanceTags.FindOrAddBit(Tag);
+        if (Bit != INDEX_NONE)
         {
-            if (bHasValidInstances)
+            if (CompactInstanceTags.SetInstanceBit(InstanceIndex, Bit))
             {
-                NewInstancesBounds += Transform.GetLocation();
-            }
-            else
-            {
-                NewInstancesBounds = FBox(Transform.GetLocation(), Transform.GetLocation());
-                bHasValidInstances = true;
+                BroadcastTagChange(InstanceIndex);
             }
+            return;
         }
 
-        // Notify subclass
-        OnInstanceAdded(NewIndex, Transform);
-        
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISMRuntimeComponent: Compact tag dictionary full (%d tags) on %s, adding '%s' - falling back to per-instance tag containers"),
+            CompactInstanceTags.GetNumTags(), *GetName(), *Tag.ToString());
+        MigrateCompactTagsToContainers();
+    }
+
+    FGameplayTagContainer& InstanceTags = PerInstanceTags.FindOrAdd(InstanceIndex);
+
+    if (!InstanceTags.HasTag(Tag))
+    {
+        InstanceTags.AddTag(Tag);
+        BroadcastTagChange(InstanceIndex);
+    }
+}
 
-        NewIndices.Add(NewIndex);
+void UISMRuntimeComponent::RemoveInstanceTag(int32 InstanceIndex, FGameplayTag Tag)
+{
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
     }
 
-    // Update bounds once for all new instances (O(1))
-    if (bUpdateBounds && bHasValidInstances)
+    if (bCompactInstanceTags)
     {
-        if (bBoundsValid)
+        if (CompactInstanceTags.RemoveTag(InstanceIndex, Tag))
         {
-            CachedInstanceBounds += NewInstancesBounds;
+            BroadcastTagChange(InstanceIndex);
         }
-        else
+        return;
+    }
+
+    if (FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex))
+    {
+        if (InstanceTags->HasTag(Tag))
         {
-            CachedInstanceBounds = NewInstancesBounds.ExpandBy(BoundsPadding);
-            bBoundsValid = true;
+            InstanceTags->RemoveTag(Tag);
+            BroadcastTagChange(InstanceIndex);
+
+            // Clean up empty containers
+            if (InstanceTags->IsEmpty())
+            {
+                PerInstanceTags.Remove(InstanceIndex);
+            }
         }
     }
-    BroadcastBatchedInstancesAdded(NewIndices);
-    UE_LOG(LogTemp, Verbose, TEXT("ISMRuntimeComponent: Batch added %d instances"), NewIndices.Num());
-
-    return NewIndices;
 }
 
-int32 UISMRuntimeComponent::AddInstanceWithCustomData(const FTransform& Transform, const TArray<float>& CustomData, bool bUpdateBounds)
+void UISMRuntimeComponent::BatchAddInstanceTag(const TArray<int32>& InstanceIndices, FGameplayTag Tag)
 {
-    int32 NewIndex = AddInstance(Transform, bUpdateBounds);
-
-    if (NewIndex != INDEX_NONE && CustomData.Num() > 0)
+    if (InstanceIndices.Num() == 0 || !Tag.IsValid())
     {
-        SetInstanceCustomData(NewIndex, CustomData);
+        return;
     }
 
-    return NewIndex;
+    BeginNativeBatch();
+    for (int32 Index : InstanceIndices)
+    {
+        AddInstanceTag(Index, Tag);
+    }
+    EndNativeBatch();
 }
 
-void UISMRuntimeComponent::InitializeNewInstance(int32 InstanceIndex, const FTransform& Transform)
+void UISMRuntimeComponent::BatchRemoveInstanceTag(const TArray<int32>& InstanceIndices, FGameplayTag Tag)
 {
-    // Create state entry
-    FISMInstanceState& State = InstanceStates.Add(InstanceIndex);
-    State.LastUpdateFrame = GFrameCounter;
-    State.CachedTransform = Transform;
-    State.bTransformCached = true;
-    State.LastVisibleTransform = Transform;
-    State.bHasLastVisibleTransform = (Transform.GetScale3D() != FVector::ZeroVector);
+    if (InstanceIndices.Num() == 0)
+    {
+        return;
+    }
 
-    // Start as intact
-    State.SetFlag(EISMInstanceState::Intact, true);
+    BeginNativeBatch();
+    for (int32 Index : InstanceIndices)
+    {
+        RemoveInstanceTag(Index, Tag);
+    }
+    EndNativeBatch();
+}
 
-	UpdateInstanceWorldBounds(InstanceIndex, Transform);
+bool UISMRuntimeComponent::InstanceHasTag(int32 InstanceIndex, FGameplayTag Tag) const
+{
+    if (ISMComponentTags.HasTag(Tag))
+    {
+        return true;
+    }
 
-    // Add default state tag
-    AddInstanceTag(InstanceIndex, FGameplayTag::RequestGameplayTag("ISM.State.Intact"));
+    if (bCompactInstanceTags)
+    {
+        return CompactInstanceTags.HasTag(InstanceIndex, Tag);
+    }
 
+    const FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex);
+    return InstanceTags && InstanceTags->HasTag(Tag);
 }
 
-void UISMRuntimeComponent::OnInstanceAdded(int32 InstanceIndex, const FTransform& Transform)
+FGameplayTagContainer UISMRuntimeComponent::GetInstanceTags(int32 InstanceIndex) const
 {
-    // Base implementation does nothing
-    // Subclasses override for custom initialization
+    return GetEffectiveTagsForInstance(InstanceIndex);
 }
 
-
-
-
-void UISMRuntimeComponent::RecalculateInstanceBounds()
+bool UISMRuntimeComponent::InstancePassesTagFilter(int32 InstanceIndex, const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& ExcludedTags) const
 {
-    CachedInstanceBounds = FBox(EForceInit::ForceInit);
-    
-    if (!ManagedISMComponent)
+    if (RequiredTags.IsEmpty() && ExcludedTags.IsEmpty())
     {
-        bBoundsValid = false;
-        return;
+        return true;
     }
-    
-    bool bHasActiveInstances = false;
-    
-    // O(n) operation - iterate all instances
-    for (int32 i = 0; i < ManagedISMComponent->GetInstanceCount(); i++)
+
+    if (bCompactInstanceTags)
     {
-        // Skip destroyed/inactive instances
-        if (!IsInstanceActive(i))
-        {
-            continue;
-        }
-        
-        FVector Location = GetInstanceLocation(i);
-        
-        if (bHasActiveInstances)
-        {
-            CachedInstanceBounds += Location;
-        }
-        else
-        {
-            CachedInstanceBounds = FBox(Location, Location);
-            bHasActiveInstances = true;
-        }
+        FISMTagFilterMasks Masks;
+        CompactInstanceTags.BuildFilterMasks(ISMComponentTags, RequiredTags, ExcludedTags, Masks);
+        return Masks.Passes(CompactInstanceTags.GetEffectiveMask(InstanceIndex));
     }
-    
-    // Add padding to account for instance mesh size
-    if (bHasActiveInstances)
+
+    // Test both containers in place rather than merging them
+    const FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex);
+
+    for (const FGameplayTag& Tag : RequiredTags)
     {
-        CachedInstanceBounds = CachedInstanceBounds.ExpandBy(BoundsPadding);
-        bBoundsValid = true;
+        if (!ISMComponentTags.HasTag(Tag) && !(InstanceTags && InstanceTags->HasTag(Tag)))
+        {
+            return false;
+        }
     }
-    else
+
+    for (const FGameplayTag& Tag : ExcludedTags)
     {
-        bBoundsValid = false;
+        if (ISMComponentTags.HasTag(Tag) || (InstanceTags && InstanceTags->HasTag(Tag)))
+        {
+            return false;
+        }
     }
+
+    return true;
 }
 
-void UISMRuntimeComponent::ExpandBoundsToInclude(const FVector& Location)
+FGameplayTagContainer UISMRuntimeComponent::GetEffectiveTagsForInstance(int32 InstanceIndex) const
 {
-    if (bBoundsValid)
+    FGameplayTagContainer EffectiveTags = ISMComponentTags;
+    AppendPerInstanceTags(InstanceIndex, EffectiveTags);
+    return EffectiveTags;
+}
+
+void UISMRuntimeComponent::AppendPerInstanceTags(int32 InstanceIndex, FGameplayTagContainer& OutTags) const
+{
+    if (bCompactInstanceTags)
     {
-        // O(1) - just expand existing bounds
-        CachedInstanceBounds += Location;
+        CompactInstanceTags.AppendTags(InstanceIndex, OutTags);
     }
-    else
+    else if (const FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex))
     {
-        // Initialize bounds with this location
-        CachedInstanceBounds = FBox(Location, Location);
-        CachedInstanceBounds = CachedInstanceBounds.ExpandBy(BoundsPadding);
-        bBoundsValid = true;
+        OutTags.AppendTags(*InstanceTags);
     }
 }
 
-bool UISMRuntimeComponent::IsLocationOnBoundsEdge(const FVector& Location, float Tolerance) const
+void UISMRuntimeComponent::MigrateCompactTagsToContainers()
 {
-    if (!bBoundsValid)
+    for (int32 i = 0; i < CompactInstanceTags.Num(); i++)
     {
-        return false; // No bounds = can't be on edge
+        if (CompactInstanceTags.HasAnyTags(i))
+        {
+            CompactInstanceTags.AppendTags(i, PerInstanceTags.FindOrAdd(i));
+        }
+    }
+
+    CompactInstanceTags.Reset();
+    bCompactInstanceTags = false;
+    SpatialIndex.ClearInstanceTagMasks();
+}
+
+void UISMRuntimeComponent::SyncSpatialTagMasks()
+{
+    SpatialIndex.ClearInstanceTagMasks();
+    if (!bCompactInstanceTags)
+    {
+        return;
+    }
+
+    for (int32 i = 0; i < CompactInstanceTags.Num(); i++)
+    {
+        if (CompactInstanceTags.HasAnyTags(i))
+        {
+            SpatialIndex.SetInstanceTagMask(i, CompactInstanceTags.GetEffectiveMask(i));
+        }
     }
-    
-    // Check if location is within Tolerance of any face of the bounds
-    FVector Min = CachedInstanceBounds.Min;
-    FVector Max = CachedInstanceBounds.Max;
-    
-    // Check each axis
-    bool bOnMinX = FMath::Abs(Location.X - Min.X) <= Tolerance;
-    bool bOnMaxX = FMath::Abs(Location.X - Max.X) <= Tolerance;
-    bool bOnMinY = FMath::Abs(Location.Y - Min.Y) <= Tolerance;
-    bool bOnMaxY = FMath::Abs(Location.Y - Max.Y) <= Tolerance;
-    bool bOnMinZ = FMath::Abs(Location.Z - Min.Z) <= Tolerance;
-    bool bOnMaxZ = FMath::Abs(Location.Z - Max.Z) <= Tolerance;
-    
-    // On edge if on any face
-    return bOnMinX || bOnMaxX || bOnMinY || bOnMaxY || bOnMinZ || bOnMaxZ;
 }
 
 
+// ===== Custom Data =====
 
+TArray<float> UISMRuntimeComponent::GetInstanceCustomData(int32 InstanceIndex) const
+{
+    TArray<float> CustomData;
 
+    if (!ManagedISMComponent || !IsValidInstanceIndex(InstanceIndex))
+    {
+        return CustomData;
+    }
 
+    const int32 NumCustomDataFloats = ManagedISMComponent->NumCustomDataFloats;
+    if (NumCustomDataFloats == 0)
+    {
+        return CustomData;
+    }
 
-bool UISMRuntimeComponent::IsInstanceDestroyed(int32 InstanceIndex) const
-{
-    const FISMInstanceState* State = InstanceStates.Find(InstanceIndex);
-    return State && State->HasFlag(EISMInstanceState::Destroyed);
+    CustomData.SetNumUninitialized(NumCustomDataFloats);
+    ReadInstanceCustomData(MakeArrayView(&InstanceIndex, 1), 0, NumCustomDataFloats, CustomData);
+    return CustomData;
 }
 
-bool UISMRuntimeComponent::IsInstanceActive(int32 InstanceIndex) const
+void UISMRuntimeComponent::SetInstanceCustomData(int32 InstanceIndex, const TArray<float>& CustomData)
 {
-    const FISMInstanceState* State = InstanceStates.Find(InstanceIndex);
-    return State && State->IsActive();
+    WriteInstanceCustomDataRow(InstanceIndex, 0, CustomData);
 }
 
-int32 UISMRuntimeComponent::GetInstanceCount() const
+int32 UISMRuntimeComponent::GetNumCustomDataFloats() const
 {
-    return ManagedISMComponent ? ManagedISMComponent->GetInstanceCount() : 0;
+    return ManagedISMComponent ? ManagedISMComponent->NumCustomDataFloats : 0;
 }
 
-int32 UISMRuntimeComponent::GetActiveInstanceCount() const
+namespace
 {
-    int32 ActiveCount = 0;
-
-    for (const auto& Pair : InstanceStates)
+    // Slots of one instance row that are backed by PerInstanceSMCustomData, clipped to [FirstSlot, FirstSlot + NumSlots)
+    int32 NumStoredCustomDataSlots(const UInstancedStaticMeshComponent* ISM, int32 InstanceIndex, int32 FirstSlot, int32 NumSlots)
     {
-        if (Pair.Value.IsActive())
-        {
-            ActiveCount++;
-        }
+        const int32 NumCustomDataFloats = ISM->NumCustomDataFloats;
+        const int32 RowStart = InstanceIndex * NumCustomDataFloats;
+        const int32 RowEnd = FMath::Min(RowStart + NumCustomDataFloats, ISM->PerInstanceSMCustomData.Num());
+        return FMath::Clamp(FMath::Min(RowEnd - RowStart - FirstSlot, NumSlots), 0, NumSlots);
     }
-
-    return ActiveCount;
 }
 
-FTransform UISMRuntimeComponent::GetInstanceTransform(int32 InstanceIndex) const
+const FISMCustomDataSchema* UISMRuntimeComponent::GetCustomDataSchema(FName* OutSchemaName) const
 {
-    if (!IsValidInstanceIndex(InstanceIndex))
+    if (!bCustomDataSchemaResolved)
     {
-        return FTransform::Identity;
+        ResolveCustomDataSchema();
     }
-
-    // Get from ISM
-    FTransform Transform;
-    ManagedISMComponent->GetInstanceTransform(InstanceIndex, Transform, true);
-
-    return Transform;
+    if (OutSchemaName)
+    {
+        *OutSchemaName = CustomDataSchemaName;
+    }
+    return CustomDataSchema;
 }
 
-FVector UISMRuntimeComponent::GetInstanceLocation(int32 InstanceIndex) const
+const FISMCustomDataGatherTable& UISMRuntimeComponent::GetCustomDataGatherTable() const
 {
-    return GetInstanceTransform(InstanceIndex).GetLocation();
+    if (!bCustomDataSchemaResolved)
+    {
+        ResolveCustomDataSchema();
+    }
+    return CustomDataGatherTable;
 }
 
-
-
-TArray<int32> UISMRuntimeComponent::GetInstancesInRadius(const FVector& Location, float Radius, bool bIncludeDestroyed) const
+void UISMRuntimeComponent::ResolveCustomDataSchema() const
 {
-    TArray<int32> Results;
-    SpatialIndex.QueryRadius(Location, Radius, Results);
+    bCustomDataSchemaResolved = true;
+    CustomDataSchema = nullptr;
+    CustomDataSchemaName = NAME_None;
+    CustomDataGatherTable.Reset();
 
-    // Filter destroyed instances if requested
-    if (!bIncludeDestroyed)
+    if (InstanceData && !InstanceData->bUsePICDConversion)
     {
-        Results = Results.FilterByPredicate([this](int32 Index)
-            {
-                return IsInstanceActive(Index);
-            });
+        return;
     }
 
-    return Results;
+    const UISMRuntimeDeveloperSettings* Settings = UISMRuntimeDeveloperSettings::Get();
+    if (InstanceData && InstanceData->SchemaName != NAME_None)
+    {
+        CustomDataSchema = Settings->ResolveSchema(InstanceData->SchemaName);
+        CustomDataSchemaName = InstanceData->SchemaName;
+    }
+    if (!CustomDataSchema && Settings->DefaultSchemaName != NAME_None)
+    {
+        CustomDataSchema = Settings->ResolveSchema(Settings->DefaultSchemaName);
+        CustomDataSchemaName = Settings->DefaultSchemaName;
+    }
+
+    if (!CustomDataSchema)
+    {
+        CustomDataSchemaName = NAME_None;
+        return;
+    }
+    CustomDataGatherTable.Build(*CustomDataSchema);
 }
 
-TArray<int32> UISMRuntimeComponent::GetInstancesInBox(const FBox& Box, bool bIncludeDestroyed) const
+TConstArrayView<float> UISMRuntimeComponent::GetInstanceCustomDataView(int32 InstanceIndex) const
 {
-    TArray<int32> Results;
-    SpatialIndex.QueryBox(Box, Results);
+    if (!ManagedISMComponent || !IsValidInstanceIndex(InstanceIndex))
+    {
+        return TConstArrayView<float>();
+    }
 
-    // Filter destroyed instances if requested
-    if (!bIncludeDestroyed)
+    const int32 NumCustomDataFloats = ManagedISMComponent->NumCustomDataFloats;
+    if (NumStoredCustomDataSlots(ManagedISMComponent, InstanceIndex, 0, NumCustomDataFloats) != NumCustomDataFloats)
     {
-        Results = Results.FilterByPredicate([this](int32 Index)
-            {
-                return IsInstanceActive(Index);
-            });
+        return TConstArrayView<float>();
     }
 
-    return Results;
+    return TConstArrayView<float>(ManagedISMComponent->PerInstanceSMCustomData.GetData() + InstanceIndex * NumCustomDataFloats, NumCustomDataFloats);
 }
 
-int32 UISMRuntimeComponent::GetNearestInstance(const FVector& Location, float MaxDistance, bool bIncludeDestroyed) const
+bool UISMRuntimeComponent::ReadInstanceCustomData(TConstArrayView<int32> InstanceIndices, int32 FirstSlot, int32 NumSlots, TArrayView<float> OutValues) const
 {
-    // Build location array for FindNearestInstance
-    TArray<FVector> InstanceLocations;
-    int32 InstanceCount = GetInstanceCount();
-    InstanceLocations.Reserve(InstanceCount);
+    if (FirstSlot < 0 || NumSlots < 0 || OutValues.Num() != InstanceIndices.Num() * NumSlots)
+    {
+        return false;
+    }
 
-    for (int32 i = 0; i < InstanceCount; i++)
+    const float* Source = ManagedISMComponent ? ManagedISMComponent->PerInstanceSMCustomData.GetData() : nullptr;
+    const int32 NumCustomDataFloats = GetNumCustomDataFloats();
+
+    for (int32 Row = 0; Row < InstanceIndices.Num(); Row++)
     {
-        // Skip destroyed instances if requested
-        if (!bIncludeDestroyed && IsInstanceDestroyed(i))
+        const int32 InstanceIndex = InstanceIndices[Row];
+        float* Dest = OutValues.GetData() + Row * NumSlots;
+
+        const int32 NumStored = Source && IsValidInstanceIndex(InstanceIndex)
+            ? NumStoredCustomDataSlots(ManagedISMComponent, InstanceIndex, FirstSlot, NumSlots)
+            : 0;
+
+        if (NumStored > 0)
         {
-            InstanceLocations.Add(FVector(MAX_FLT, MAX_FLT, MAX_FLT)); // Push far away
+            FMemory::Memcpy(Dest, Source + InstanceIndex * NumCustomDataFloats + FirstSlot, NumStored * sizeof(float));
         }
-        else
+        if (NumStored < NumSlots)
         {
-            InstanceLocations.Add(GetInstanceLocation(i));
+            FMemory::Memzero(Dest + NumStored, (NumSlots - NumStored) * sizeof(float));
         }
     }
 
-    return SpatialIndex.FindNearestInstance(Location, InstanceLocations, MaxDistance);
+    return true;
 }
 
-TArray<int32> UISMRuntimeComponent::QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter) const
+bool UISMRuntimeComponent::ReadInstanceCustomDataRange(int32 FirstInstance, int32 NumInstances, int32 FirstSlot, int32 NumSlots, TArrayView<float> OutValues) const
 {
-    // Get candidates from spatial index
-    TArray<int32> Candidates;
-    SpatialIndex.QueryRadius(Location, Radius, Candidates);
-	if (Candidates.Num() == 0)
+    if (NumInstances < 0 || NumSlots < 0 || OutValues.Num() != NumInstances * NumSlots)
     {
-        return Candidates; 
+        return false;
     }
 
-    // Create instance references and filter
-    TArray<int32> Results;
-    Results.Reserve(Candidates.Num());
-
-    for (int32 Index : Candidates)
+    for (int32 Row = 0; Row < NumInstances; Row++)
     {
-        FISMInstanceReference Ref;
-        Ref.Component = const_cast<UISMRuntimeComponent*>(this);
-        Ref.InstanceIndex = Index;
-
-        if (Filter.PassesFilter(Ref))
+        const int32 InstanceIndex = FirstInstance + Row;
+        if (!ReadInstanceCustomData(MakeArrayView(&InstanceIndex, 1), FirstSlot, NumSlots, OutValues.Slice(Row * NumSlots, NumSlots)))
         {
-            Results.Add(Index);
-
-            // Check max results limit
-            if (Filter.MaxResults > 0 && Results.Num() >= Filter.MaxResults)
-            {
-                break;
-            }
+            return false;
         }
     }
 
-    // Sort by distance if requested
-    if (Filter.bSortByDistance && Results.Num() > 0)
-    {
-        Results.Sort([this, &Location](int32 A, int32 B)
-            {
-                float DistA = FVector::DistSquared(GetInstanceLocation(A), Location);
-                float DistB = FVector::DistSquared(GetInstanceLocation(B), Location);
-                return DistA < DistB;
-            });
-    }
-
-    return Results;
+    return true;
 }
 
-// ===== Gameplay Tags =====
-
-void UISMRuntimeComponent::AddInstanceTag(int32 InstanceIndex, FGameplayTag Tag)
+bool UISMRuntimeComponent::WriteInstanceCustomData(TConstArrayView<int32> InstanceIndices, int32 FirstSlot, int32 NumSlots,
+    TConstArrayView<float> Values, bool bMarkRenderStateDirty)
 {
-    if (!IsValidInstanceIndex(InstanceIndex) || !Tag.IsValid())
+    if (FirstSlot < 0 || NumSlots < 0 || Values.Num() != InstanceIndices.Num() * NumSlots)
     {
-        return;
+        return false;
     }
 
-    FGameplayTagContainer& InstanceTags = PerInstanceTags.FindOrAdd(InstanceIndex);
+    bool bAnyWritten = false;
+    for (int32 Row = 0; Row < InstanceIndices.Num(); Row++)
+    {
+        bAnyWritten |= WriteInstanceCustomDataRow(InstanceIndices[Row], FirstSlot, Values.Slice(Row * NumSlots, NumSlots), false);
+    }
 
-    if (!InstanceTags.HasTag(Tag))
+    if (bAnyWritten && bMarkRenderStateDirty)
     {
-        InstanceTags.AddTag(Tag);
-        BroadcastTagChange(InstanceIndex);
+        MarkCustomDataDirty();
     }
+    return true;
 }
 
-void UISMRuntimeComponent::RemoveInstanceTag(int32 InstanceIndex, FGameplayTag Tag)
+bool UISMRuntimeComponent::WriteInstanceCustomDataRange(int32 FirstInstance, int32 NumInstances, int32 FirstSlot, int32 NumSlots,
+    TConstArrayView<float> Values, bool bMarkRenderStateDirty)
 {
-    if (!IsValidInstanceIndex(InstanceIndex))
+    if (FirstSlot < 0 || NumInstances < 0 || NumSlots < 0 || Values.Num() != NumInstances * NumSlots)
     {
-        return;
+        return false;
     }
 
-    if (FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex))
+    bool bAnyWritten = false;
+    for (int32 Row = 0; Row < NumInstances; Row++)
     {
-        if (InstanceTags->HasTag(Tag))
-        {
-            InstanceTags->RemoveTag(Tag);
-            BroadcastTagChange(InstanceIndex);
+        bAnyWritten |= WriteInstanceCustomDataRow(FirstInstance + Row, FirstSlot, Values.Slice(Row * NumSlots, NumSlots), false);
+    }
 
-            // Clean up empty containers
-            if (InstanceTags->IsEmpty())
-            {
-                PerInstanceTags.Remove(InstanceIndex);
-            }
-        }
+    if (bAnyWritten && bMarkRenderStateDirty)
+    {
+        MarkCustomDataDirty();
     }
+    return true;
 }
 
-bool UISMRuntimeComponent::InstanceHasTag(int32 InstanceIndex, FGameplayTag Tag) const
+bool UISMRuntimeComponent::WriteInstanceCustomDataRow(int32 InstanceIndex, int32 FirstSlot, TConstArrayView<float> Values, bool bMarkRenderStateDirty)
 {
-    return GetInstanceTags(InstanceIndex).HasTag(Tag);
-}
+    if (!ManagedISMComponent || !IsValidInstanceIndex(InstanceIndex) || FirstSlot < 0)
+    {
+        return false;
+    }
 
-FGameplayTagContainer UISMRuntimeComponent::GetInstanceTags(int32 InstanceIndex) const
-{
-    return GetEffectiveTagsForInstance(InstanceIndex);
-}
+    const int32 NumStored = NumStoredCustomDataSlots(ManagedISMComponent, InstanceIndex, FirstSlot, Values.Num());
+    if (NumStored == 0)
+    {
+        return false;
+    }
 
-FGameplayTagContainer UISMRuntimeComponent::GetEffectiveTagsForInstance(int32 InstanceIndex) const
-{
-    FGameplayTagContainer EffectiveTags = ISMComponentTags;
+    float* Dest = ManagedISMComponent->PerInstanceSMCustomData.GetData() + InstanceIndex * ManagedISMComponent->NumCustomDataFloats + FirstSlot;
+    FMemory::Memcpy(Dest, Values.GetData(), NumStored * sizeof(float));
+    ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::CustomData));
+    OpCounters.Count(EISMComponentOp::CustomDataWrite);
+    OpCounters.SampleMutation(InstanceIndex);
+    CustomDataJournal.RecordRow(InstanceIndex, FirstSlot, Values.Left(NumStored));
 
-    if (const FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex))
+    if (bMarkRenderStateDirty)
     {
-        EffectiveTags.AppendTags(*InstanceTags);
+        MarkCustomDataDirty();
     }
-
-    return EffectiveTags;
+    return true;
 }
 
-
-// ===== Custom Data =====
-
-TArray<float> UISMRuntimeComponent::GetInstanceCustomData(int32 InstanceIndex) const
+int32 UISMRuntimeComponent::WriteCustomDataSlot(int32 Slot, TConstArrayView<float> Values, int32 FirstInstance, bool bMarkRenderStateDirty)
 {
-    TArray<float> CustomData;
+    if (!ManagedISMComponent || Slot < 0 || FirstInstance < 0)
+    {
+        return 0;
+    }
 
-    if (!ManagedISMComponent || !IsValidInstanceIndex(InstanceIndex))
+    const int32 Stride = ManagedISMComponent->NumCustomDataFloats;
+    if (Slot >= Stride)
     {
-        return CustomData;
+        return 0;
     }
 
-    int32 NumCustomDataFloats = ManagedISMComponent->NumCustomDataFloats;
-    if (NumCustomDataFloats == 0)
+    // Only instances whose whole row is stored; the ISM keeps rows for every instance it has
+    const int32 NumStoredRows = ManagedISMComponent->PerInstanceSMCustomData.Num() / Stride;
+    const int32 LastInstance = FMath::Min3(FirstInstance + Values.Num(), GetInstanceCount(), NumStoredRows);
+    const int32 NumWritten = LastInstance - FirstInstance;
+    if (NumWritten <= 0)
     {
-        return CustomData;
+        return 0;
     }
 
-    CustomData.Reserve(NumCustomDataFloats);
+    const bool bPartial = bMarkRenderStateDirty && !bHeadless
+        && NumWritten <= FMath::FloorToInt32(PartialCustomDataUploadFraction * GetInstanceCount());
+    if (bPartial)
+    {
+        // The ISM's own setter records each instance for incremental upload
+        for (int32 i = 0; i < NumWritten; ++i)
+        {
+            ManagedISMComponent->SetCustomDataValue(FirstInstance + i, Slot, Values[i], false);
+            ChangeTracker.MarkChanged(FirstInstance + i, static_cast<uint8>(EISMSnapshotField::CustomData));
+            CustomDataJournal.Record(FirstInstance + i, Slot, Values[i]);
+        }
+        return NumWritten;
+    }
 
-    int32 StartIndex = InstanceIndex * NumCustomDataFloats;
-    for (int32 i = 0; i < NumCustomDataFloats; i++)
+    float* Dest = ManagedISMComponent->PerInstanceSMCustomData.GetData() + FirstInstance * Stride + Slot;
+    for (int32 i = 0; i < NumWritten; ++i)
+    {
+        Dest[i * Stride] = Values[i];
+    }
+    if (CustomDataJournal.IsEnabled())
     {
-        int32 DataIndex = StartIndex + i;
-        if (ManagedISMComponent->PerInstanceSMCustomData.IsValidIndex(DataIndex))
+        for (int32 i = 0; i < NumWritten; ++i)
         {
-            CustomData.Add(ManagedISMComponent->PerInstanceSMCustomData[DataIndex]);
+            CustomDataJournal.Record(FirstInstance + i, Slot, Values[i]);
         }
-        else
+    }
+
+    if (NumWritten == GetInstanceCount())
+    {
+        ChangeTracker.MarkAllChanged(static_cast<uint8>(EISMSnapshotField::CustomData));
+    }
+    else
+    {
+        for (int32 i = 0; i < NumWritten; ++i)
         {
-            CustomData.Add(0.0f);
+            ChangeTracker.MarkChanged(FirstInstance + i, static_cast<uint8>(EISMSnapshotField::CustomData));
         }
     }
 
-    return CustomData;
+    if (bMarkRenderStateDirty)
+    {
+        MarkCustomDataDirty();
+    }
+    return NumWritten;
 }
 
-void UISMRuntimeComponent::SetInstanceCustomData(int32 InstanceIndex, const TArray<float>& CustomData)
+int32 UISMRuntimeComponent::FillCustomDataSlot(int32 Slot, float Value, bool bMarkRenderStateDirty)
 {
-    if (!ManagedISMComponent || !IsValidInstanceIndex(InstanceIndex))
+    if (!ManagedISMComponent || Slot < 0 || Slot >= ManagedISMComponent->NumCustomDataFloats)
     {
-        return;
+        return 0;
     }
 
-    int32 NumCustomDataFloats = ManagedISMComponent->NumCustomDataFloats;
-    if (NumCustomDataFloats == 0)
+    const int32 Stride = ManagedISMComponent->NumCustomDataFloats;
+    const int32 NumWritten = FMath::Min(GetInstanceCount(), ManagedISMComponent->PerInstanceSMCustomData.Num() / Stride);
+    float* Dest = ManagedISMComponent->PerInstanceSMCustomData.GetData() + Slot;
+    for (int32 i = 0; i < NumWritten; ++i)
     {
-        return;
+        Dest[i * Stride] = Value;
     }
-
-    int32 StartIndex = InstanceIndex * NumCustomDataFloats;
-
-    for (int32 i = 0; i < FMath::Min(CustomData.Num(), NumCustomDataFloats); i++)
+    if (CustomDataJournal.IsEnabled())
     {
-        int32 DataIndex = StartIndex + i;
-        if (ManagedISMComponent->PerInstanceSMCustomData.IsValidIndex(DataIndex))
+        for (int32 i = 0; i < NumWritten; ++i)
         {
-            ManagedISMComponent->PerInstanceSMCustomData[DataIndex] = CustomData[i];
+            CustomDataJournal.Record(i, Slot, Value);
         }
     }
 
-    ManagedISMComponent->MarkRenderStateDirty();
+    ChangeTracker.MarkAllChanged(static_cast<uint8>(EISMSnapshotField::CustomData));
+    if (NumWritten > 0 && bMarkRenderStateDirty)
+    {
+        MarkCustomDataDirty();
+    }
+    return NumWritten;
+}
 
+void UISMRuntimeComponent::MarkCustomDataDirty()
+{
+    // Headless components keep the values for reads, snapshots and conversions but never draw them
+    if (ManagedISMComponent && !bHeadless)
+    {
+        ManagedISMComponent->MarkRenderStateDirty();
+    }
 }
 
 float UISMRuntimeComponent::GetInstanceCustomDataValue(int32 InstanceIndex, int32 DataIndex) const
@@ -1091,13 +3913,7 @@ void UISMRuntimeComponent::SetInstanceCustomDataValue(int32 InstanceIndex, int32
         return;
     }
 
-    int32 ArrayIndex = InstanceIndex * NumCustomDataFloats + DataIndex;
-
-    if (ManagedISMComponent->PerInstanceSMCustomData.IsValidIndex(ArrayIndex))
-    {
-        ManagedISMComponent->PerInstanceSMCustomData[ArrayIndex] = Value;
-        ManagedISMComponent->MarkRenderStateDirty();
-    }
+    WriteInstanceCustomDataRow(InstanceIndex, DataIndex, MakeArrayView(&Value, 1));
 }
 
 void UISMRuntimeComponent::SetCustomDataCount(int32 DesiredCount, bool bResetExisting, float DefaultValue)
@@ -1112,6 +3928,8 @@ void UISMRuntimeComponent::SetCustomDataCount(int32 DesiredCount, bool bResetExi
         // Rebuild from scratch at the requested size.
         // UInstancedStaticMeshComponent::SetNumCustomDataFloats clears all instance data.
         ManagedISMComponent->SetNumCustomDataFloats(DesiredCount);
+        ChangeTracker.MarkAllChanged(static_cast<uint8>(EISMSnapshotField::CustomData));
+        CustomDataJournal.MarkReset();
 
         // Fill every instance with DefaultValue
         if (DefaultValue != 0.0f)
@@ -1124,7 +3942,7 @@ void UISMRuntimeComponent::SetCustomDataCount(int32 DesiredCount, bool bResetExi
                     ManagedISMComponent->SetCustomDataValue(i, SlotIdx, DefaultValue, /*bMarkRenderStateDirty=*/false);
                 }
             }
-            ManagedISMComponent->MarkRenderStateDirty();
+            MarkCustomDataDirty();
         }
 
         
@@ -1143,36 +3961,30 @@ void UISMRuntimeComponent::SetCustomDataCount(int32 DesiredCount, bool bResetExi
     const int32 InstanceCount = ManagedISMComponent->GetInstanceCount();
 
     // Step 1: snapshot existing data before resize clears it
-    TMap<int32, TArray<float>> ExistingData;
-    ExistingData.Reserve(ManagedISMComponent->GetInstanceCount());
-	for (int i = 0; i < InstanceCount; ++i)
-    {
-		ExistingData.Add(i, GetInstanceCustomData(i));
-    }
+    const TArray<float> ExistingData = ManagedISMComponent->PerInstanceSMCustomData;
 
     // Step 2: resize - this resets all instance custom data to 0 internally
     ManagedISMComponent->SetNumCustomDataFloats(DesiredCount);
 
     // Step 3: rewrite preserved data + fill new slots
+    TArray<float> Row;
+    Row.SetNumUninitialized(DesiredCount);
     for (int32 i = 0; i < InstanceCount; ++i)
     {
-        const TArray<float>* OldData = ExistingData.Find(i);
-
-        for (int32 SlotIdx = 0; SlotIdx < DesiredCount; ++SlotIdx)
+        const int32 NumPreserved = FMath::Clamp(ExistingData.Num() - i * CurrentCount, 0, CurrentCount);
+        FMemory::Memcpy(Row.GetData(), ExistingData.GetData() + i * CurrentCount, NumPreserved * sizeof(float));
+        for (int32 SlotIdx = NumPreserved; SlotIdx < DesiredCount; ++SlotIdx)
         {
-            float Value = DefaultValue;
-
-            if (OldData && SlotIdx < OldData->Num())
-            {
-                // Preserve existing value
-                Value = (*OldData)[SlotIdx];
-            }
-
-            ManagedISMComponent->SetCustomDataValue(i, SlotIdx, Value, false);
+            Row[SlotIdx] = DefaultValue;
         }
+
+        WriteInstanceCustomDataRow(i, 0, Row, false);
     }
 
-    ManagedISMComponent->MarkRenderStateDirty();
+    // New slot layout: journal consumers resync from a snapshot rather than replay every row
+    CustomDataJournal.MarkReset();
+
+    MarkCustomDataDirty();
 }
 
 
@@ -1182,39 +3994,132 @@ void UISMRuntimeComponent::SetCustomDataCount(int32 DesiredCount, bool bResetExi
 
 uint8 UISMRuntimeComponent::GetInstanceStateFlags(int32 InstanceIndex) const
 {
-    const FISMInstanceState* State = GetInstanceState(InstanceIndex);
-    return State ? State->StateFlags : 0;
+    return InstanceStates.GetFlags(InstanceIndex);
+}
+
+void UISMRuntimeComponent::GetStateFlags(TConstArrayView<int32> InstanceIndices, TArrayView<uint8> OutFlags) const
+{
+    InstanceStates.GatherFlags(InstanceIndices, OutFlags);
 }
 
 bool UISMRuntimeComponent::IsInstanceInState(int32 InstanceIndex, EISMInstanceState State) const
 {
-    const FISMInstanceState* InstanceState = GetInstanceState(InstanceIndex);
-    return InstanceState && InstanceState->HasFlag(State);
+    return InstanceStates.HasFlag(InstanceIndex, State);
 }
 
 void UISMRuntimeComponent::SetInstanceState(int32 InstanceIndex, EISMInstanceState State, bool bValue)
 {
-    FISMInstanceState* InstanceState = GetInstanceStateMutable(InstanceIndex);
-    if (InstanceState)
+    WakeIfDormant();
+
+    if (InstanceStates.Contains(InstanceIndex))
     {
-        InstanceState->SetFlag(State, bValue);
+        const bool bWasActive = IsInstanceActive(InstanceIndex);
+        InstanceStates.SetFlag(InstanceIndex, State, bValue);
+
+        const bool bIsActive = IsInstanceActive(InstanceIndex);
+        if (bWasActive != bIsActive)
+        {
+            if (bIsActive)
+            {
+                CellBounds.Add(GetInstanceLocation(InstanceIndex));
+                SyncBroadphaseBounds();
+            }
+            else
+            {
+                CellBounds.Remove(GetInstanceLocation(InstanceIndex));
+            }
+        }
+
         BroadcastStateChange(InstanceIndex);
     }
 }
 
-const FISMInstanceState* UISMRuntimeComponent::GetInstanceState(int32 InstanceIndex) const
-{
-    return InstanceStates.Find(InstanceIndex);
-}
+void UISMRuntimeComponent::BatchWriteInstanceStateFlags(TConstArrayView<FISMStateFlagsWrite> Writes)
+{
+    WakeIfDormant();
+
+    TArray<int32> ChangedInstances;
+    bool bAnyActivated = false;
+
+    for (const FISMStateFlagsWrite& Write : Writes)
+    {
+        const int32 InstanceIndex = Write.InstanceIndex;
+        if (!InstanceStates.Contains(InstanceIndex))
+        {
+            continue;
+        }
+
+        const uint8 OldFlags = InstanceStates.GetFlags(InstanceIndex);
+        const uint8 NewFlags = (OldFlags & ~Write.ClearMask) | Write.SetMask;
+        if (NewFlags == OldFlags)
+        {
+            continue;
+        }
+
+        const bool bWasActive = IsInstanceActive(InstanceIndex);
+        InstanceStates.SetFlags(InstanceIndex, NewFlags);
+
+        const bool bIsActive = IsInstanceActive(InstanceIndex);
+        if (bWasActive != bIsActive)
+        {
+            if (bIsActive)
+            {
+                CellBounds.Add(GetInstanceLocation(InstanceIndex));
+                bAnyActivated = true;
+            }
+            else
+            {
+                CellBounds.Remove(GetInstanceLocation(InstanceIndex));
+            }
+        }
+
+        ChangedInstances.Add(InstanceIndex);
+    }
+
+    if (bAnyActivated)
+    {
+        SyncBroadphaseBounds();
+    }
+
+    if (ChangedInstances.Num() == 0)
+    {
+        return;
+    }
+
+    // Repeated writes to one instance report it once
+    ChangedInstances.Sort();
+    ChangedInstances.SetNum(Algo::Unique(ChangedInstances), EAllowShrinking::No);
+    BroadcastBatchedStateChange(ChangedInstances);
+}
+
+bool UISMRuntimeComponent::HasInstanceState(int32 InstanceIndex) const
+{
+    return InstanceStates.Contains(InstanceIndex);
+}
+
+bool UISMRuntimeComponent::GetInstanceState(int32 InstanceIndex, FISMInstanceState& OutState) const
+{
+    if (!InstanceStates.Contains(InstanceIndex))
+    {
+        return false;
+    }
+
+    OutState = InstanceStates.ToInstanceState(InstanceIndex);
 
-FISMInstanceState* UISMRuntimeComponent::GetInstanceStateMutable(int32 InstanceIndex)
-{
-    return InstanceStates.Find(InstanceIndex);
+    // Transforms live on the ISM; fill the cached copy from there
+    if (ManagedISMComponent && ManagedISMComponent->IsValidInstance(InstanceIndex))
+    {
+        ManagedISMComponent->GetInstanceTransform(InstanceIndex, OutState.CachedTransform, true);
+        OutState.bTransformCached = true;
+    }
+    return true;
 }
 
 const FISMInstanceState UISMRuntimeComponent::GetInstanceStateConst(int32 InstanceIndex) const
 {
-    return *InstanceStates.Find(InstanceIndex);
+    FISMInstanceState State;
+    GetInstanceState(InstanceIndex, State);
+    return State;
 }
 
 
@@ -1250,10 +4155,11 @@ void UISMRuntimeComponent::UpdateInstanceWorldBounds(int32 InstanceIndex, const
     // all 8 corners and re-fitting, which is exactly what we want.
     FBox WorldBounds = LocalBounds.TransformBy(Transform);
 
-    // Write into the instance state (creates entry if not present)
-    FISMInstanceState& State = InstanceStates.FindOrAdd(InstanceIndex);
-    State.WorldBounds = WorldBounds;
-    State.bBoundsValid = true;
+    // Write into the instance state
+    InstanceStates.SetWorldBounds(InstanceIndex, WorldBounds);
+
+    // Keep the bounds-aware overlap queries in step
+    SpatialIndex.SetInstanceBounds(InstanceIndex, WorldBounds);
 }
 
 
@@ -1289,17 +4195,9 @@ FBox UISMRuntimeComponent::GetInstanceWorldBounds(int32 InstanceIndex) const
         return FBox(EForceInit::ForceInit);
     }
 
-    const FISMInstanceState* State = GetInstanceState(InstanceIndex);
-    if (!State )
-    {
-        return FBox(EForceInit::ForceInit);
-    }
-	if (!State->bBoundsValid)
-    {
-        return FBox(EForceInit::ForceInit);
-    }
-
-    return State->WorldBounds;
+    FBox WorldBounds(EForceInit::ForceInit);
+    InstanceStates.GetWorldBounds(InstanceIndex, WorldBounds);
+    return WorldBounds;
 }
 
 
@@ -1312,50 +4210,46 @@ TArray<int32> UISMRuntimeComponent::GetInstancesOverlappingBox(
     bool bIncludeDestroyed) const
 {
     TArray<int32> Results;
+    GetInstancesOverlappingBox(Box, Results, bIncludeDestroyed);
+    return Results;
+}
 
+void UISMRuntimeComponent::GetInstancesOverlappingBox(const FBox& Box, TArray<int32>& OutIndices, bool bIncludeDestroyed) const
+{
+    ForEachInstanceOverlappingBox(Box, [&OutIndices](int32 Index)
+        {
+            OutIndices.Add(Index);
+            return true;
+        }, bIncludeDestroyed);
+}
+
+bool UISMRuntimeComponent::ForEachInstanceOverlappingBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed) const
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
     if (!bComputeInstanceAABBs)
     {
 		UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: Cannot perform box query - AABB computation is disabled"));
-        return Results;
-    }
-
-    // Expand the candidate search box by the max local extent so instances
-    // whose centers are outside Box but whose AABBs overlap it are included
-    // as candidates. The precise AABB intersection test is the second pass.
-    FBox CandidateBox = Box;
-    if (InstanceData)
-    {
-        FBox LocalBounds = InstanceData->GetEffectiveLocalBounds();
-        if (LocalBounds.IsValid)
-        {
-            // GetExtent() is half-size. Expand by full extent to be safe
-            // since scale can push the bounds further than the local extent.
-            // A more precise expansion would track max scale, but this is
-            // conservative and correct.
-            FVector MaxExtent = LocalBounds.GetExtent();
-            CandidateBox = Box.ExpandBy(MaxExtent);
-        }
+        return true;
     }
 
-    TArray<int32> Candidates = GetInstancesInBox(CandidateBox, bIncludeDestroyed);
-	UE_LOG(LogTemp, Verbose, TEXT("ISMRuntimeComponent: Box query found %d candidates"), Candidates.Num());
-    Results.Reserve(Candidates.Num());
-    for (int32 CandidateIndex : Candidates)
-    {
-        const FISMInstanceState* State = GetInstanceState(CandidateIndex);
-        if (!State || !State->bBoundsValid)
+    // The index records every instance AABB, so Box needs no padding here
+    return SpatialIndex.ForEachInstanceOverlappingBox(Box, [this, &Box, &Visitor, bIncludeDestroyed](int32 CandidateIndex)
         {
-			UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: No valid bounds for instance %d during box query"), CandidateIndex);
-            continue;
-        }
+            if (!bIncludeDestroyed && !IsInstanceActive(CandidateIndex))
+            {
+                return true;
+            }
 
-        if (State->WorldBounds.Intersect(Box))
-        {
-            Results.Add(CandidateIndex);
-        }
-    }
+            FBox WorldBounds;
+            if (!InstanceStates.GetWorldBounds(CandidateIndex, WorldBounds))
+            {
+				UE_LOG(LogTemp, Warning, TEXT("ISMRuntimeComponent: No valid bounds for instance %d during box query"), CandidateIndex);
+                return true;
+            }
 
-    return Results;
+            return !WorldBounds.Intersect(Box) || Visitor(CandidateIndex);
+        });
 }
 
 
@@ -1369,41 +4263,44 @@ TArray<int32> UISMRuntimeComponent::GetInstancesOverlappingSphere(
     bool bIncludeDestroyed) const
 {
     TArray<int32> Results;
+    GetInstancesOverlappingSphere(Center, Radius, Results, bIncludeDestroyed);
+    return Results;
+}
 
-    if (!bComputeInstanceAABBs || Radius <= 0.0f)
-    {
-        return Results;
-    }
+void UISMRuntimeComponent::GetInstancesOverlappingSphere(const FVector& Center, float Radius, TArray<int32>& OutIndices, bool bIncludeDestroyed) const
+{
+    ForEachInstanceOverlappingSphere(Center, Radius, [&OutIndices](int32 Index)
+        {
+            OutIndices.Add(Index);
+            return true;
+        }, bIncludeDestroyed);
+}
 
-    float CandidateRadius = Radius;
-    if (InstanceData)
+bool UISMRuntimeComponent::ForEachInstanceOverlappingSphere(const FVector& Center, float Radius, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed) const
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+    OpCounters.Count(EISMComponentOp::Query);
+    if (!bComputeInstanceAABBs || Radius <= 0.0f)
     {
-        FBox LocalBounds = InstanceData->GetEffectiveLocalBounds();
-        if (LocalBounds.IsValid)
-        {
-            CandidateRadius += LocalBounds.GetExtent().Size();
-        }
+        return true;
     }
 
-    TArray<int32> Candidates = GetInstancesInRadius(Center, CandidateRadius, bIncludeDestroyed);
-
-    Results.Reserve(Candidates.Num());
-    for (int32 CandidateIndex : Candidates)
-    {
-        const FISMInstanceState* State = GetInstanceState(CandidateIndex);
-        if (!State || !State->bBoundsValid)
+    const float RadiusSq = FMath::Square(Radius);
+    return SpatialIndex.ForEachInstanceOverlappingSphere(Center, Radius, [this, &Center, RadiusSq, &Visitor, bIncludeDestroyed](int32 CandidateIndex)
         {
-            continue;
-        }
+            if (!bIncludeDestroyed && !IsInstanceActive(CandidateIndex))
+            {
+                return true;
+            }
 
-        float DistSq = State->WorldBounds.ComputeSquaredDistanceToPoint(Center);
-        if (DistSq <= FMath::Square(Radius))
-        {
-            Results.Add(CandidateIndex);
-        }
-    }
+            FBox WorldBounds;
+            if (!InstanceStates.GetWorldBounds(CandidateIndex, WorldBounds))
+            {
+                return true;
+            }
 
-    return Results;
+            return WorldBounds.ComputeSquaredDistanceToPoint(Center) > RadiusSq || Visitor(CandidateIndex);
+        });
 }
 
 
@@ -1416,37 +4313,32 @@ TArray<int32> UISMRuntimeComponent::GetInstancesOverlappingInstance(
     bool bIncludeDestroyed) const
 {
     TArray<int32> Results;
+    GetInstancesOverlappingInstance(InstanceIndex, Results, bIncludeDestroyed);
+    return Results;
+}
 
+void UISMRuntimeComponent::GetInstancesOverlappingInstance(int32 InstanceIndex, TArray<int32>& OutIndices, bool bIncludeDestroyed) const
+{
     if (!bComputeInstanceAABBs || !IsValidInstanceIndex(InstanceIndex))
     {
-        return Results;
+        return;
     }
 
-    const FISMInstanceState* QueryState = GetInstanceState(InstanceIndex);
-    if (!QueryState || !QueryState->bBoundsValid)
+    FBox QueryBounds;
+    if (!InstanceStates.GetWorldBounds(InstanceIndex, QueryBounds))
     {
-        return Results;
+        return;
     }
 
-    FBox QueryBounds = QueryState->WorldBounds;
-
-    // Use the box query to get candidates, then filter by AABB intersection
-    TArray<int32> Candidates = GetInstancesOverlappingBox(QueryBounds, bIncludeDestroyed);
-
-    Results.Reserve(Candidates.Num());
-
-    for (int32 CandidateIndex : Candidates)
-    {
-        // Exclude the query instance itself
-        if (CandidateIndex == InstanceIndex)
+    // Box query over the instance's own AABB, minus the instance itself
+    ForEachInstanceOverlappingBox(QueryBounds, [InstanceIndex, &OutIndices](int32 CandidateIndex)
         {
-            continue;
-        }
-
-        Results.Add(CandidateIndex);
-    }
-
-    return Results;
+            if (CandidateIndex != InstanceIndex)
+            {
+                OutIndices.Add(CandidateIndex);
+            }
+            return true;
+        }, bIncludeDestroyed);
 }
 
 
@@ -1466,15 +4358,13 @@ bool UISMRuntimeComponent::DoInstancesOverlap(int32 IndexA, int32 IndexB) const
         return false;
     }
 
-    const FISMInstanceState* StateA = GetInstanceState(IndexA);
-    const FISMInstanceState* StateB = GetInstanceState(IndexB);
-
-    if (!StateA || !StateA->bBoundsValid || !StateB || !StateB->bBoundsValid)
+    FBox BoundsA, BoundsB;
+    if (!InstanceStates.GetWorldBounds(IndexA, BoundsA) || !InstanceStates.GetWorldBounds(IndexB, BoundsB))
     {
         return false;
     }
 
-    return StateA->WorldBounds.Intersect(StateB->WorldBounds);
+    return BoundsA.Intersect(BoundsB);
 }
 
 
@@ -1494,13 +4384,13 @@ bool UISMRuntimeComponent::DoesInstanceOverlapBox(int32 InstanceIndex, const FBo
         return false;
     }
 
-    const FISMInstanceState* State = GetInstanceState(InstanceIndex);
-    if (!State || !State->bBoundsValid)
+    FBox WorldBounds;
+    if (!InstanceStates.GetWorldBounds(InstanceIndex, WorldBounds))
     {
         return false;
     }
 
-    return State->WorldBounds.Intersect(Box);
+    return WorldBounds.Intersect(Box);
 }
 
 
@@ -1516,26 +4406,54 @@ FISMInstanceHandle UISMRuntimeComponent::GetInstanceHandle(int32 InstanceIndex)
 
 FISMInstanceHandle& UISMRuntimeComponent::GetOrCreateHandle(int32 InstanceIndex)
 {
-    if (!InstanceHandles.Contains(InstanceIndex))
+    WakeIfDormant();
+
+    if (InstanceIndex < 0)
+    {
+        InvalidHandle = FISMInstanceHandle();
+        return InvalidHandle;
+    }
+
+    bool bAdded = false;
+    FISMInstanceHandle& Handle = InstanceHandles.FindOrAdd(InstanceIndex, bAdded);
+    if (bAdded)
+    {
+        Handle.Component = this;
+        Handle.InstanceIndex = InstanceIndex;
+        Handle.Generation = static_cast<int32>(InstanceStates.GetGeneration(InstanceIndex));
+    }
+
+    return Handle;
+}
+
+void UISMRuntimeComponent::NotifyHandleConversionChanged(int32 InstanceIndex, AActor* ConvertedActor, int32 ActivationCount)
+{
+    if (!IsValidInstanceIndex(InstanceIndex) || (!ConvertedActor && !InstanceHandles.Contains(InstanceIndex)))
     {
-        auto NewHandle = FISMInstanceHandle();
-		NewHandle.Component = this;
-		NewHandle.InstanceIndex = InstanceIndex;
-        InstanceHandles.Add(InstanceIndex, NewHandle);
+        return;
     }
 
-    return InstanceHandles[InstanceIndex];
+    FISMInstanceHandle& Stored = GetOrCreateHandle(InstanceIndex);
+    Stored.ConvertedActor = ConvertedActor;
+    if (ConvertedActor)
+    {
+        Stored.CachedActorActivationCount = ActivationCount;
+    }
+    InstanceHandles.SetConverted(InstanceIndex, ConvertedActor != nullptr);
 }
 
 TArray<FISMInstanceHandle> UISMRuntimeComponent::GetConvertedInstances() const
 {
     TArray<FISMInstanceHandle> ConvertedHandles;
+    ConvertedHandles.Reserve(InstanceHandles.GetConvertedInstances().Num());
 
-    for (const auto& Pair : InstanceHandles)
+    // Listed entries whose actor died without a return drop out through IsConvertedToActor
+    for (int32 InstanceIndex : InstanceHandles.GetConvertedInstances())
     {
-        if (Pair.Value.IsConvertedToActor())
+        const FISMInstanceHandle* Handle = InstanceHandles.Find(InstanceIndex);
+        if (Handle && Handle->IsConvertedToActor())
         {
-            ConvertedHandles.Add(Pair.Value);
+            ConvertedHandles.Add(*Handle);
         }
     }
 
@@ -1562,8 +4480,59 @@ bool UISMRuntimeComponent::IsInstanceConverted(int32 InstanceIndex) const
     return false;
 }
 
+void UISMRuntimeComponent::GetBatchableInstanceIndices(TArray<int32>& OutIndices) const
+{
+    // Converted instances are few - take them from the converted list instead of probing per index
+    TSet<int32> ConvertedIndices;
+    for (int32 InstanceIndex : InstanceHandles.GetConvertedInstances())
+    {
+        if (IsInstanceConverted(InstanceIndex))
+        {
+            ConvertedIndices.Add(InstanceIndex);
+        }
+    }
+    const bool bAnyConverting = InstanceStates.GetFlagCount(EISMInstanceState::Converting) > 0;
+
+    const int32 InstanceCount = GetInstanceCount();
+    OutIndices.Reserve(OutIndices.Num() + InstanceStates.Num() - InstanceStates.GetFlagCount(EISMInstanceState::Destroyed));
+
+    // Live bitset skips destroyed slots a word at a time
+    for (TConstSetBitIterator<> It(InstanceStates.GetLiveSlots()); It; ++It)
+    {
+        const int32 InstanceIndex = It.GetIndex();
+        if (InstanceIndex >= InstanceCount)
+        {
+            break;
+        }
+        if (bAnyConverting && InstanceStates.HasFlag(InstanceIndex, EISMInstanceState::Converting))
+        {
+            continue;
+        }
+        if (ConvertedIndices.Num() == 0 || !ConvertedIndices.Contains(InstanceIndex))
+        {
+            OutIndices.Add(InstanceIndex);
+        }
+    }
+}
+
 // ===== Subsystem Integration =====
 
+bool UISMRuntimeComponent::HasInstanceChangedSince(int32 InstanceIndex, EISMSnapshotField Fields, uint32 Cursor) const
+{
+    return ChangeTracker.HasChangedSince(InstanceIndex, static_cast<uint8>(Fields), Cursor);
+}
+
+void UISMRuntimeComponent::MarkInstanceChanged(int32 InstanceIndex, EISMSnapshotField Fields)
+{
+    ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(Fields));
+
+    // The journal needs values, not just the fact of a change: take the whole row as it is now
+    if (static_cast<uint8>(Fields) & static_cast<uint8>(EISMSnapshotField::CustomData))
+    {
+        CustomDataJournal.RecordRow(InstanceIndex, 0, GetInstanceCustomDataView(InstanceIndex));
+    }
+}
+
 bool UISMRuntimeComponent::RegisterWithSubsystem()
 {
     if (UWorld* World = GetWorld())
@@ -1599,6 +4568,7 @@ bool UISMRuntimeComponent::IsValidInstanceIndex(int32 InstanceIndex) const
 
 void UISMRuntimeComponent::BroadcastBatchedInstancesAdded(const TArray<int32>& Instances)
 {
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnBatchInstancesAddedNative.Broadcast(this, Instances);
 }
 
@@ -1607,41 +4577,291 @@ void UISMRuntimeComponent::BroadcastInstanceAdded(int32 InstanceIndex)
     if (!IsValidInstanceIndex(InstanceIndex)){
         return;
     }
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnInstanceAddedNative.Broadcast(this,InstanceIndex);
 }
 void UISMRuntimeComponent::BroadcastStateChange(int32 InstanceIndex)
 {
+    ++InstanceQueryRevision;
     if (!IsValidInstanceIndex(InstanceIndex)) {
         return;
     }
+    ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::StateFlags));
+    if (DeferInstanceEvent(EISMInstanceEvent::StateChanged, InstanceIndex))
+    {
+        return;
+    }
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnInstanceStateChanged.Broadcast(this, InstanceIndex);
-    OnInstanceStateChangedNative.Broadcast(this, InstanceIndex);
+    BroadcastNativeOrBatch(OnInstanceStateChangedNative, InstanceIndex);
+}
+
+void UISMRuntimeComponent::BroadcastBatchedStateChange(const TArray<int32>& Instances)
+{
+    ++InstanceQueryRevision;
+    if (bCoalesceInstanceEvents)
+    {
+        // The flush reports these through OnBatchInstanceStatesChangedNative with everything else
+        for (int32 InstanceIndex : Instances)
+        {
+            ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::StateFlags));
+            DeferInstanceEvent(EISMInstanceEvent::StateChanged, InstanceIndex);
+        }
+        return;
+    }
+
+    BeginNativeBatch();
+    for (int32 InstanceIndex : Instances)
+    {
+        ChangeTracker.MarkChanged(InstanceIndex, static_cast<uint8>(EISMSnapshotField::StateFlags));
+        OnInstanceStateChanged.Broadcast(this, InstanceIndex);
+        BroadcastNativeOrBatch(OnInstanceStateChangedNative, InstanceIndex);
+    }
+    EndNativeBatch();
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast, Instances.Num() + 1);
+    OnBatchInstanceStatesChangedNative.Broadcast(this, Instances);
+}
+
+void UISMRuntimeComponent::BeginNativeBatch()
+{
+    ++NativeBatchDepth;
+}
+
+void UISMRuntimeComponent::EndNativeBatch()
+{
+    check(NativeBatchDepth > 0);
+    if (--NativeBatchDepth > 0)
+    {
+        return;
+    }
+
+    // One upload for every visibility write of the batch
+    if (bVisibilityUploadPending)
+    {
+        bVisibilityUploadPending = false;
+        MarkCustomDataDirty();
+    }
+
+    if (NativeBatchInstances.Num() == 0)
+    {
+        return;
+    }
+
+    // Listeners may start another batch, so broadcast from a local copy
+    TArray<int32> Instances = MoveTemp(NativeBatchInstances);
+    Instances.Sort();
+    Instances.SetNum(Algo::Unique(Instances), EAllowShrinking::No);
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
+    OnInstancesChangedBatchNative.Broadcast(this, Instances);
+}
+
+bool UISMRuntimeComponent::DeferInstanceEvent(EISMInstanceEvent Event, int32 InstanceIndex)
+{
+    if (!bCoalesceInstanceEvents || InstanceIndex < 0)
+    {
+        return false;
+    }
+
+    TBitArray<>& Pending = PendingInstanceEvents[static_cast<int32>(Event)];
+    if (InstanceIndex >= Pending.Num())
+    {
+        Pending.Add(false, FMath::Max(InstanceIndex + 1, GetInstanceCount()) - Pending.Num());
+    }
+    Pending[InstanceIndex] = true;
+
+    if (PendingInstanceEventKinds == 0)
+    {
+        if (UISMRuntimeSubsystem* Subsystem = CachedSubsystem.Get())
+        {
+            Subsystem->QueueInstanceEventFlush(this);
+        }
+    }
+    PendingInstanceEventKinds |= 1 << static_cast<int32>(Event);
+    return true;
+}
+
+void UISMRuntimeComponent::FlushInstanceEvents()
+{
+    if (PendingInstanceEventKinds == 0)
+    {
+        return;
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeComponent::FlushInstanceEvents);
+
+    // Listeners may raise new events; those go to the next flush
+    constexpr int32 NumEvents = static_cast<int32>(EISMInstanceEvent::Num);
+    TBitArray<> Pending[NumEvents];
+    for (int32 Event = 0; Event < NumEvents; ++Event)
+    {
+        Pending[Event] = MoveTemp(PendingInstanceEvents[Event]);
+        PendingInstanceEvents[Event].Reset();
+    }
+    PendingInstanceEventKinds = 0;
+
+    TArray<int32> Instances[NumEvents];
+    for (int32 Event = 0; Event < NumEvents; ++Event)
+    {
+        for (TConstSetBitIterator<> It(Pending[Event]); It; ++It)
+        {
+            if (IsValidInstanceIndex(It.GetIndex()))
+            {
+                Instances[Event].Add(It.GetIndex());
+            }
+        }
+    }
+
+    const TArray<int32>& StateChanged = Instances[static_cast<int32>(EISMInstanceEvent::StateChanged)];
+    const TArray<int32>& Destroyed = Instances[static_cast<int32>(EISMInstanceEvent::Destroyed)];
+    const TArray<int32>& TagsChanged = Instances[static_cast<int32>(EISMInstanceEvent::TagsChanged)];
+    const TArray<int32>& OwnerChanged = Instances[static_cast<int32>(EISMInstanceEvent::OwnerChanged)];
+    const TArray<int32>& PossessionChanged = Instances[static_cast<int32>(EISMInstanceEvent::PossessionChanged)];
+    const TArray<int32>& AttachmentChanged = Instances[static_cast<int32>(EISMInstanceEvent::AttachmentChanged)];
+
+    // Blueprint events per instance, only when something is bound to them
+    int32 NumBroadcasts = 0;
+    if (OnInstanceStateChanged.IsBound())
+    {
+        for (int32 InstanceIndex : StateChanged)
+        {
+            OnInstanceStateChanged.Broadcast(this, InstanceIndex);
+        }
+        NumBroadcasts += StateChanged.Num();
+    }
+    if (OnInstanceDestroyed.IsBound())
+    {
+        for (int32 InstanceIndex : Destroyed)
+        {
+            OnInstanceDestroyed.Broadcast(this, InstanceIndex);
+        }
+        NumBroadcasts += Destroyed.Num();
+    }
+    if (OnInstanceTagsChanged.IsBound())
+    {
+        for (int32 InstanceIndex : TagsChanged)
+        {
+            OnInstanceTagsChanged.Broadcast(this, InstanceIndex);
+        }
+        NumBroadcasts += TagsChanged.Num();
+    }
+    if (OnInstanceOwnerChanged.IsBound())
+    {
+        for (int32 InstanceIndex : OwnerChanged)
+        {
+            OnInstanceOwnerChanged.Broadcast(this, InstanceIndex, GetInstanceHandle(InstanceIndex).GetOwnerTag());
+        }
+        NumBroadcasts += OwnerChanged.Num();
+    }
+    if (OnInstancePossessionChanged.IsBound())
+    {
+        for (int32 InstanceIndex : PossessionChanged)
+        {
+            const FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
+            OnInstancePossessionChanged.Broadcast(this, InstanceIndex, Handle.GetPossessorTag(), Handle.GetPossessorActor());
+        }
+        NumBroadcasts += PossessionChanged.Num();
+    }
+    if (OnInstanceAttachmentChanged.IsBound())
+    {
+        for (int32 InstanceIndex : AttachmentChanged)
+        {
+            const FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
+            OnInstanceAttachmentChanged.Broadcast(this, InstanceIndex, Handle.GetAttachParent(), Handle.GetAttachSocket());
+        }
+        NumBroadcasts += AttachmentChanged.Num();
+    }
+
+    // Native events with the spans; state, destroyed and tag changes as one batch, like a batch call
+    for (int32 Event = 0; Event < NumEvents; ++Event)
+    {
+        if (Instances[Event].Num() > 0)
+        {
+            OnInstanceEventsFlushedNative.Broadcast(this, static_cast<EISMInstanceEvent>(Event), Instances[Event]);
+            ++NumBroadcasts;
+        }
+    }
+    if (StateChanged.Num() > 0)
+    {
+        OnBatchInstanceStatesChangedNative.Broadcast(this, StateChanged);
+        ++NumBroadcasts;
+    }
+
+    TArray<int32> Changed;
+    Changed.Reserve(StateChanged.Num() + Destroyed.Num() + TagsChanged.Num());
+    Changed.Append(StateChanged);
+    Changed.Append(Destroyed);
+    Changed.Append(TagsChanged);
+    if (Changed.Num() > 0)
+    {
+        Changed.Sort();
+        Changed.SetNum(Algo::Unique(Changed), EAllowShrinking::No);
+        OnInstancesChangedBatchNative.Broadcast(this, Changed);
+        ++NumBroadcasts;
+    }
+
+    // These have no batch event, so their native listeners still hear once per instance
+    for (int32 InstanceIndex : OwnerChanged)
+    {
+        OnInstanceOwnerChangedNative.Broadcast(this, InstanceIndex);
+    }
+    for (int32 InstanceIndex : PossessionChanged)
+    {
+        OnInstancePossessionChangedNative.Broadcast(this, InstanceIndex);
+    }
+    for (int32 InstanceIndex : AttachmentChanged)
+    {
+        OnInstanceAttachmentChangedNative.Broadcast(this, InstanceIndex);
+    }
+    NumBroadcasts += OwnerChanged.Num() + PossessionChanged.Num() + AttachmentChanged.Num();
+
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast, NumBroadcasts);
 }
 
 void UISMRuntimeComponent::BroadcastDestruction(int32 InstanceIndex)
 {
+    ++InstanceQueryRevision;
     if (!IsValidInstanceIndex(InstanceIndex)) {
         return;
     }
+    if (DeferInstanceEvent(EISMInstanceEvent::Destroyed, InstanceIndex))
+    {
+        return;
+    }
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnInstanceDestroyed.Broadcast(this, InstanceIndex);
-    OnInstanceDestroyedNative.Broadcast(this, InstanceIndex);
+    BroadcastNativeOrBatch(OnInstanceDestroyedNative, InstanceIndex);
 }
 
 void UISMRuntimeComponent::BroadcastTagChange(int32 InstanceIndex)
 {
+    ++InstanceQueryRevision;
     if (!IsValidInstanceIndex(InstanceIndex)) {
         return;
     }
+    if (bCompactInstanceTags)
+    {
+        SpatialIndex.SetInstanceTagMask(InstanceIndex, CompactInstanceTags.GetEffectiveMask(InstanceIndex));
+    }
+    if (DeferInstanceEvent(EISMInstanceEvent::TagsChanged, InstanceIndex))
+    {
+        return;
+    }
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnInstanceTagsChanged.Broadcast(this, InstanceIndex);
-    OnInstanceTagsChangedNative.Broadcast(this, InstanceIndex);
+    BroadcastNativeOrBatch(OnInstanceTagsChangedNative, InstanceIndex);
 }
 
 void UISMRuntimeComponent::BroadcastOwnershipChange(int32 InstanceIndex)
 {
     if (!IsValidInstanceIndex(InstanceIndex)){
         return;
+    }
+    if (DeferInstanceEvent(EISMInstanceEvent::OwnerChanged, InstanceIndex))
+    {
+        return;
     }
 	FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnInstanceOwnerChanged.Broadcast(this, InstanceIndex, Handle.GetOwnerTag());
     OnInstanceOwnerChangedNative.Broadcast(this, InstanceIndex);
 }
@@ -1651,7 +4871,12 @@ void UISMRuntimeComponent::BroadcastPossessionChange(int32 InstanceIndex)
 	if (!IsValidInstanceIndex(InstanceIndex)){
         return;
     }
+    if (DeferInstanceEvent(EISMInstanceEvent::PossessionChanged, InstanceIndex))
+    {
+        return;
+    }
     FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
     OnInstancePossessionChanged.Broadcast(this, InstanceIndex, Handle.GetPossessorTag(), Handle.GetPossessorActor());
     OnInstancePossessionChangedNative.Broadcast(this, InstanceIndex);
 }
@@ -1661,7 +4886,12 @@ void UISMRuntimeComponent::BroadcastAttachmentChange(int32 InstanceIndex)
     if (!IsValidInstanceIndex(InstanceIndex)){
         return;
     }
+    if (DeferInstanceEvent(EISMInstanceEvent::AttachmentChanged, InstanceIndex))
+    {
+        return;
+    }
     FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
 	OnInstanceAttachmentChanged.Broadcast(this, InstanceIndex, Handle.GetAttachParent(), Handle.GetAttachSocket());
     OnInstanceAttachmentChangedNative.Broadcast(this, InstanceIndex);
 }
@@ -1671,6 +4901,7 @@ void UISMRuntimeComponent::BroadcastInstanceReleased(int32 InstanceIndex)
     if (!IsValidInstanceIndex(InstanceIndex)) {
         return;
     }
+    OpCounters.Count(EISMComponentOp::DelegateBroadcast);
 	OnInstanceReleased.Broadcast(this, InstanceIndex);
 }
 
@@ -1768,6 +4999,21 @@ void UISMRuntimeComponent::TriggerFeedbackBatchedOnDestroyInternal(TArray<int> I
     TriggerFeedbackBatchedInternal([&](const FISMFeedbackTags& Tags) { return Tags.GetBatchDestroyTag(); }, InstanceIndexes, Instigator);
 }
 
+void UISMRuntimeComponent::TriggerFeedbackBatchedOnShowInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator)
+{
+    TriggerFeedbackBatchedInternal([&](const FISMFeedbackTags& Tags) { return Tags.OnShow; }, InstanceIndexes, Instigator);
+}
+
+void UISMRuntimeComponent::TriggerFeedbackBatchedOnHideInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator)
+{
+    TriggerFeedbackBatchedInternal([&](const FISMFeedbackTags& Tags) { return Tags.OnHide; }, InstanceIndexes, Instigator);
+}
+
+void UISMRuntimeComponent::TriggerFeedbackBatchedOnTransformUpdateInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator)
+{
+    TriggerFeedbackBatchedInternal([&](const FISMFeedbackTags& Tags) { return Tags.OnTransformUpdate; }, InstanceIndexes, Instigator);
+}
+
 void UISMRuntimeComponent::TriggerFeedbackBatchedOnSpawnInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator)
 {
     TriggerFeedbackBatchedInternal([&](const FISMFeedbackTags& Tags) { return Tags.GetBatchSpawnTag(); }, InstanceIndexes, Instigator);
@@ -1778,6 +5024,9 @@ void UISMRuntimeComponent::TriggerFeedbackBatchedOnSpawnInternal(TArray<int> Ins
 
 void UISMRuntimeComponent::TriggerFeedbackInternal(TFunctionRef<FGameplayTag(const FISMFeedbackTags&)> SelectTag, int InstanceIndex, const UActorComponent* Instigator)
 {
+    if (bHeadless) {
+        return;
+    }
     UISMFeedbackSubsystem* Subsystem = GetFeedbackSubsystem();
     if (!Subsystem) {
         return;
@@ -1788,12 +5037,13 @@ void UISMRuntimeComponent::TriggerFeedbackInternal(TFunctionRef<FGameplayTag(con
         return;
     }
     FISMFeedbackParticipant InstigatorParticipant = FISMFeedbackParticipant::FromActorComponent(Instigator ? Instigator : this);
-    Subsystem->RequestFeedback(FISMFeedbackContext::CreateFromInstance(TargetTag, this, InstanceIndex).WithInstigator(InstigatorParticipant));
+    // Queued so a burst of per-instance events (explosions, mass conversion) can be coalesced
+    Subsystem->RequestFeedbackBatched(FISMFeedbackContext::CreateFromInstance(TargetTag, this, InstanceIndex).WithInstigator(InstigatorParticipant));
 }
 
 void UISMRuntimeComponent::TriggerFeedbackBatchedInternal(TFunctionRef<FGameplayTag(const FISMFeedbackTags&)> SelectTag, TArray<int> InstanceIndexes, const UActorComponent* Instigator)
 {
-    if (InstanceIndexes.Num() == 0) {
+    if (InstanceIndexes.Num() == 0 || bHeadless) {
         return;
     }
     UISMFeedbackSubsystem* Subsystem = GetFeedbackSubsystem();
@@ -1807,7 +5057,7 @@ void UISMRuntimeComponent::TriggerFeedbackBatchedInternal(TFunctionRef<FGameplay
         return;
     }
 
-    Subsystem->RequestFeedback(FISMFeedbackContext::CreateFromInstanceBatched(TargetTag, this, InstanceIndexes).WithInstigator(FISMFeedbackParticipant::FromActorComponent(Instigator ? Instigator : this)));
+    Subsystem->RequestFeedbackBatched(FISMFeedbackContext::CreateFromInstanceBatched(TargetTag, this, InstanceIndexes).WithInstigator(FISMFeedbackParticipant::FromActorComponent(Instigator ? Instigator : this)));
 
 }
 
@@ -2,11 +2,40 @@
 // Published by Procedural Architect
 
 #include "ISMRuntimeCore.h"
+#include "ISMRuntimeProfiling.h"
 #include "GameplayTagsManager.h"
 //#include "IPluginManager.h"
 
 #define LOCTEXT_NAMESPACE "FISMRuntimeCoreModule"
 
+UE_TRACE_CHANNEL_DEFINE(ISMRuntimeChannel);
+
+DEFINE_STAT(STAT_ISMSpatialQuery);
+DEFINE_STAT(STAT_ISMAddInstances);
+DEFINE_STAT(STAT_ISMDestroyInstance);
+DEFINE_STAT(STAT_ISMBuildSnapshot);
+DEFINE_STAT(STAT_ISMApplyMutationResult);
+DEFINE_STAT(STAT_ISMAcquireDMI);
+DEFINE_STAT(STAT_ISMFeedbackRouting);
+DEFINE_STAT(STAT_ISMConversion);
+
+DEFINE_STAT(STAT_ISMInstancesAdded);
+DEFINE_STAT(STAT_ISMInstancesDestroyed);
+DEFINE_STAT(STAT_ISMQueryResults);
+DEFINE_STAT(STAT_ISMSnapshotInstances);
+DEFINE_STAT(STAT_ISMSnapshotBytes);
+DEFINE_STAT(STAT_ISMMutationsApplied);
+DEFINE_STAT(STAT_ISMDMIsCreated);
+DEFINE_STAT(STAT_ISMFeedbacksRouted);
+DEFINE_STAT(STAT_ISMInstancesConverted);
+
+LLM_DEFINE_TAG(ISMRuntime);
+LLM_DEFINE_TAG(ISMRuntime_Query);
+LLM_DEFINE_TAG(ISMRuntime_Instances);
+LLM_DEFINE_TAG(ISMRuntime_Batch);
+LLM_DEFINE_TAG(ISMRuntime_CustomData);
+LLM_DEFINE_TAG(ISMRuntime_Feedback);
+
 void FISMRuntimeCoreModule::StartupModule()
 {
     UE_LOG(LogTemp, Log, TEXT("ISMRuntimeCore: Module started"));
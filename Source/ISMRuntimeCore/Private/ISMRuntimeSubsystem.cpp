@@ -5,13 +5,26 @@
 #include "ISMRuntimeComponent.h"
 #include "ISMInstanceHandle.h"
 #include "ISMInstanceState.h"
+#include "ISMRuntimeProfiling.h"
 #include "CollisionQueryParams.h"
 #include "Settings/ISMRuntimeSettings.h"
 #include "Batching/ISMBatchScheduler.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "ISMQueryFilter.h"
+#include "ISMNearestSelection.h"
+#include "ISMCompiledQueryFilter.h"
+#include "ISMInstanceIndex.h"
+#include "CustomData/ISMCustomDataSubsystem.h"
 #include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
 #include "Logging/LogMacros.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "Misc/App.h"
+#include "Misc/ScopeLock.h"
 
 
 #pragma region SUBSYSTEM_LIFECYCLE
@@ -28,16 +41,54 @@ void UISMRuntimeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     
     CachedStats = FISMRuntimeStats();
     StatsUpdateFrame = 0;
+    StaleRedirects = MakeUnique<FISMStaleRedirectQueue>();
     InitializeBatchScheduler();
 
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    InstanceCommands = MakeUnique<FISMInstanceCommandQueue>(Settings ? Settings->InstanceCommandQueueCapacity : 4096);
+    ComponentBroadphase.SetCellSize(Settings ? Settings->ComponentBroadphaseCellSize : 25600.0f);
+
+    // Frame budget and scheduler settings come from the project settings through the active profile
+    ApplyPerformanceProfile(FISMPerformanceProfiles::GetActive());
+    PerformanceProfileHandle = FISMPerformanceProfiles::OnProfileChanged().AddUObject(this, &UISMRuntimeSubsystem::HandlePerformanceProfileChanged);
+
+    WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UISMRuntimeSubsystem::HandleWorldTickStart);
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UISMRuntimeSubsystem::HandlePostGarbageCollect);
 }
 
 void UISMRuntimeSubsystem::Deinitialize()
 {
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+    WorldTickStartHandle.Reset();
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+    PostGarbageCollectHandle.Reset();
+    FISMPerformanceProfiles::OnProfileChanged().Remove(PerformanceProfileHandle);
+    PerformanceProfileHandle.Reset();
+
     bBatchSchedulerInitialized = false;
+    for (const FManagedTick& Tick : ManagedTicks)
+    {
+        if (UISMRuntimeComponent* Comp = Tick.Component.Get())
+        {
+            Comp->ManagedTickIndex = INDEX_NONE;
+        }
+    }
+    ManagedTicks.Empty();
+
     // Clean up all registered components
     AllComponents.Empty();
-    ComponentsByTag.Empty();
+    LiveComponents.Empty();
+    bLiveComponentsDirty = true;
+    ComponentTagIndex.Reset();
+    InstanceRegistry.Reset();
+    ComponentBroadphase.Reset();
+    PendingQueryBatches.Empty();
+    SphereSubscriptions.Empty();
+    RedirectEntries.Empty();
+    RedirectSlotByPrimitive.Empty();
+    StaleRedirects.Reset();
+    InstanceCommands.Reset();
+    DrainedInstanceCommands.Empty();
 
     if(BatchScheduler && IsValid(BatchScheduler))
     {
@@ -60,15 +111,127 @@ bool UISMRuntimeSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) cons
 
 bool UISMRuntimeSubsystem::IsTickable() const
 {
-    return BatchScheduler && BatchScheduler->HasPendingWork();
+    if (BatchScheduler && BatchScheduler->HasPendingWork())
+    {
+        return true;
+    }
+
+    if (PendingQueryBatches.Num() > 0)
+    {
+        return true;
+    }
+
+    if (ManagedTicks.Num() > 0)
+    {
+        return true;
+    }
+
+    if (InitQueue.Num() > 0 || EventFlushQueue.Num() > 0)
+    {
+        return true;
+    }
+
+    if (InstanceCommands && !InstanceCommands->IsEmpty())
+    {
+        return true;
+    }
+
+    if (StaleRedirects)
+    {
+        FScopeLock Lock(&StaleRedirects->Lock);
+        if (StaleRedirects->Slots.Num() > 0)
+        {
+            return true;
+        }
+    }
+
+    // Snapshot publishers need the per-frame swap even when the scheduler is idle, dormancy its viewer checks
+    for (const UISMRuntimeComponent* Comp : GetLiveComponents())
+    {
+        if (Comp->bPublishSpatialIndexSnapshot || Comp->bAllowDormancy)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void UISMRuntimeSubsystem::HandleWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if (TickedWorld == GetWorld())
+    {
+        FrameBudget.BeginFrame();
+    }
 }
 
 void UISMRuntimeSubsystem::Tick(float DeltaTime)
 {
+    LLM_SCOPE_BYTAG(ISMRuntime);
+
+    if (InitQueue.Num() > 0)
+    {
+        TickComponentInitialization();
+    }
+
+    // Before the scheduler, so worker commands land with this frame's other mutations
+    FlushInstanceCommands();
+
     if (BatchScheduler)
     {
+        // The scheduler clamps its dispatch and apply budgets to what this scope has left
+        FISMFrameBudgetScope Budget(&FrameBudget, UISMBatchSchedulerBase::FrameBudgetClient, EISMFrameBudgetPriority::Normal);
         BatchScheduler->Tick(DeltaTime);
 	}
+
+    CleanupRedirectMap();
+
+    if (ManagedTicks.Num() > 0)
+    {
+        TickManagedComponents();
+    }
+
+    TickComponentDormancy(DeltaTime);
+
+    // Swap read snapshots once per frame, after this frame's mutations have landed
+    for (UISMRuntimeComponent* Comp : GetLiveComponents())
+    {
+        if (Comp->bPublishSpatialIndexSnapshot && Comp->IsISMInitialized())
+        {
+            Comp->PublishSpatialIndexSnapshot();
+        }
+    }
+
+    // Deferred query batches see this frame's mutations. Callbacks may submit new batches for next frame.
+    if (PendingQueryBatches.Num() > 0)
+    {
+        TArray<FPendingQueryBatch> Batches = MoveTemp(PendingQueryBatches);
+        PendingQueryBatches.Reset();
+
+        FISMQueryBatchResults BatchResults;
+        for (FPendingQueryBatch& Batch : Batches)
+        {
+            SubmitQueryBatch(Batch.Queries, BatchResults, true);
+            if (Batch.OnComplete)
+            {
+                Batch.OnComplete(BatchResults);
+            }
+        }
+    }
+
+    // Last, so the coalesced events cover everything this tick changed
+    if (EventFlushQueue.Num() > 0)
+    {
+        TArray<TWeakObjectPtr<UISMRuntimeComponent>> Queue = MoveTemp(EventFlushQueue);
+        EventFlushQueue.Reset();
+        for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : Queue)
+        {
+            if (UISMRuntimeComponent* Comp = CompPtr.Get())
+            {
+                Comp->FlushInstanceEvents();
+            }
+        }
+    }
 }
 
 UISMBatchSchedulerBase* UISMRuntimeSubsystem::GetOrCreateBatchSchduler()
@@ -80,6 +243,41 @@ UISMBatchSchedulerBase* UISMRuntimeSubsystem::GetOrCreateBatchSchduler()
     return BatchScheduler;
 }
 
+void UISMRuntimeSubsystem::ApplyPerformanceProfile(const FISMPerformanceProfileSettings& Profile)
+{
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+
+    // Whatever the profile leaves alone goes back to the project settings / the scheduler class defaults,
+    // so switching back to Default restores them
+    FISMFrameBudgetGovernor::FConfig BudgetConfig;
+    if (Settings)
+    {
+        BudgetConfig.BudgetMs = Settings->bEnableFrameBudget ? Settings->FrameBudgetMs : 0.0f;
+        BudgetConfig.OverloadFrames = Settings->FrameBudgetOverloadFrames;
+        BudgetConfig.RecoveryFrames = Settings->FrameBudgetRecoveryFrames;
+        BudgetConfig.MinSliceMs = Settings->FrameBudgetMinSliceMs;
+        BudgetConfig.MaxStarvedFrames = Settings->FrameBudgetMaxStarvedFrames;
+        BudgetConfig.PriorityOverrides = Settings->FrameBudgetPriorities;
+    }
+    if (Profile.bOverride_FrameBudgetMs)
+    {
+        BudgetConfig.BudgetMs = Profile.FrameBudgetMs;
+    }
+    FrameBudget.Configure(BudgetConfig);
+
+    if (BatchScheduler)
+    {
+        FISMBatchSchedulerSettings SchedulerSettings = BatchScheduler->GetClass()->GetDefaultObject<UISMBatchSchedulerBase>()->Settings;
+        Profile.ApplyTo(SchedulerSettings);
+        BatchScheduler->Settings = SchedulerSettings;
+    }
+}
+
+void UISMRuntimeSubsystem::HandlePerformanceProfileChanged(EISMPerformanceProfile Profile, const FISMPerformanceProfileSettings& ProfileSettings)
+{
+    ApplyPerformanceProfile(ProfileSettings);
+}
+
 
 
 
@@ -96,21 +294,26 @@ bool UISMRuntimeSubsystem::RegisterRuntimeComponent(UISMRuntimeComponent* Compon
     }
 
     // Check if already registered
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& ExistingComp : AllComponents)
+    const int32 ExistingIndex = Component->RegisteredComponentIndex;
+    if (AllComponents.IsValidIndex(ExistingIndex) && AllComponents[ExistingIndex].Get() == Component)
     {
-        if (ExistingComp.Get() == Component)
-        {
-            return true; // Already registered
-        }
+        return true;
     }
 
     // Add to main list
-    AllComponents.Add(Component);
+    Component->RegisteredComponentIndex = AllComponents.Add(Component);
+    bLiveComponentsDirty = true;
 
-	FirePendingCallbacksForISM(Component->ManagedISMComponent, Component);
+    // A component still being built by the init queue is findable once NotifyComponentInitialized runs
+    if (!Component->IsISMInitializing())
+    {
+        FirePendingCallbacksForISM(Component->ManagedISMComponent, Component);
+    }
 
     // Index by tags
     RebuildTagIndexForComponent(Component);
+    ComponentBroadphase.Add(Component);
+    InstanceRegistry.Add(Component);
     
     UE_LOG(LogTemp, Verbose, TEXT("ISMRuntimeSubsystem: Registered component %s with %d instances"),
         *Component->GetOwner()->GetName(),
@@ -126,307 +329,1284 @@ void UISMRuntimeSubsystem::UnregisterRuntimeComponent(UISMRuntimeComponent* Comp
         return;
     }
     
-    // Remove from main list
-    AllComponents.RemoveAll([Component](const TWeakObjectPtr<UISMRuntimeComponent>& Comp)
-    {
-        return Comp.Get() == Component;
-    });
-    
-    // Remove from tag index
-    for (auto& Pair : ComponentsByTag)
-    {
-        Pair.Value.RemoveAll([Component](const TWeakObjectPtr<UISMRuntimeComponent>& Comp)
-        {
-            return Comp.Get() == Component;
-        });
-    }
-    
-    // Clean up empty tag entries
-    TArray<FGameplayTag> EmptyTags;
-    for (const auto& Pair : ComponentsByTag)
+    UnregisterManagedTick(Component);
+
+    // Remove from main list; the last entry fills the hole
+    const int32 Index = Component->RegisteredComponentIndex;
+    if (AllComponents.IsValidIndex(Index) && AllComponents[Index].Get() == Component)
     {
-        if (Pair.Value.Num() == 0)
+        AllComponents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        if (AllComponents.IsValidIndex(Index))
         {
-            EmptyTags.Add(Pair.Key);
+            if (UISMRuntimeComponent* Moved = AllComponents[Index].Get())
+            {
+                Moved->RegisteredComponentIndex = Index;
+            }
         }
+        bLiveComponentsDirty = true;
     }
+    Component->RegisteredComponentIndex = INDEX_NONE;
+    ComponentBroadphase.Remove(Component);
     
-    for (const FGameplayTag& Tag : EmptyTags)
-    {
-        ComponentsByTag.Remove(Tag);
-    }
+    // Remove from tag index
+    ComponentTagIndex.Remove(Component);
+    InstanceRegistry.Remove(Component);
     
     UE_LOG(LogTemp, Verbose, TEXT("ISMRuntimeSubsystem: Unregistered component %s"),
         *Component->GetOwner()->GetName());
 }
 
-TArray<UISMRuntimeComponent*> UISMRuntimeSubsystem::GetAllComponents() const
+void UISMRuntimeSubsystem::RegisterManagedTick(UISMRuntimeComponent* Component)
 {
-    TArray<UISMRuntimeComponent*> ValidComponents;
-    ValidComponents.Reserve(AllComponents.Num());
-    
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : AllComponents)
+    if (!Component || Component->ManagedTickIndex != INDEX_NONE)
     {
-        if (UISMRuntimeComponent* Comp = CompPtr.Get())
-        {
-            ValidComponents.Add(Comp);
-        }
+        return;
     }
-    
-    return ValidComponents;
+
+    const UWorld* World = GetWorld();
+    const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+    Component->ManagedTickIndex = ManagedTicks.Num();
+    FManagedTick& Tick = ManagedTicks.AddDefaulted_GetRef();
+    Tick.Component = Component;
+    Tick.NextTickSeconds = Now;
+    Tick.LastTickSeconds = Now;
 }
 
-TArray<UISMRuntimeComponent*> UISMRuntimeSubsystem::GetComponentsWithTag(FGameplayTag Tag) const
+void UISMRuntimeSubsystem::UnregisterManagedTick(UISMRuntimeComponent* Component)
 {
-    TArray<UISMRuntimeComponent*> ValidComponents;
-    
-    if (const TArray<TWeakObjectPtr<UISMRuntimeComponent>>* Components = ComponentsByTag.Find(Tag))
+    if (!Component || !ManagedTicks.IsValidIndex(Component->ManagedTickIndex))
     {
-        ValidComponents.Reserve(Components->Num());
-        
-        for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : *Components)
+        return;
+    }
+
+    const int32 Index = Component->ManagedTickIndex;
+    Component->ManagedTickIndex = INDEX_NONE;
+    ManagedTicks.RemoveAtSwap(Index, EAllowShrinking::No);
+    if (ManagedTicks.IsValidIndex(Index))
+    {
+        if (UISMRuntimeComponent* Moved = ManagedTicks[Index].Component.Get())
         {
-            if (UISMRuntimeComponent* Comp = CompPtr.Get())
-            {
-                ValidComponents.Add(Comp);
-            }
+            Moved->ManagedTickIndex = Index;
         }
     }
-    
-    return ValidComponents;
 }
 
+void UISMRuntimeSubsystem::TickManagedComponents()
+{
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::TickManagedComponents);
+    LLM_SCOPE_BYTAG(ISMRuntime);
 
-#pragma endregion
-
-
-#pragma region QUERIES
+    const UWorld* World = GetWorld();
+    const double Now = World ? World->GetTimeSeconds() : 0.0;
 
-void UISMRuntimeSubsystem::RequestRuntimeComponent(UInstancedStaticMeshComponent* ISM, TFunction<void(UISMRuntimeComponent*)> Callback)
-{
-	if (ISMToRuntimeComponentMap.Contains(ISM))
-    {
-        // Already exists - call immediately
-        if (UISMRuntimeComponent* ExistingComp = ISMToRuntimeComponentMap[ISM].Get())
-        {
-            Callback(ExistingComp);
-            return;
-        }
-    }
-    else
+    // Gather the due components; slots of destroyed ones are dropped on the way
+    TArray<UISMRuntimeComponent*> Due;
+    TArray<float> DueDeltas;
+    for (int32 Index = ManagedTicks.Num() - 1; Index >= 0; --Index)
     {
-        if (!PendingRuntimeComponentCallbacks.Contains(ISM))
+        const FManagedTick& Tick = ManagedTicks[Index];
+        UISMRuntimeComponent* Comp = Tick.Component.Get();
+        if (!Comp)
         {
-            PendingRuntimeComponentCallbacks.Add(ISM, TArray<TFunction<void(UISMRuntimeComponent*)>>());
+            ManagedTicks.RemoveAtSwap(Index, EAllowShrinking::No);
+            if (UISMRuntimeComponent* Moved = ManagedTicks.IsValidIndex(Index) ? ManagedTicks[Index].Component.Get() : nullptr)
+            {
+                Moved->ManagedTickIndex = Index;
+            }
+            continue;
         }
-        PendingRuntimeComponentCallbacks[ISM].Add(Callback);
-    }
-}
 
-TArray<FISMInstanceReference> UISMRuntimeSubsystem::QueryInstancesInRadius(
-    const FVector& Location,
-    float Radius,
-    const FISMQueryFilter& Filter) const
-{
-    TArray<FISMInstanceReference> Results;
-    
-    // Get components to search (use tag filtering if available)
-    TArray<UISMRuntimeComponent*> ComponentsToSearch;
-    
-    if (!Filter.RequiredTags.IsEmpty())
-    {
-        // Find components with required tags
-        TSet<UISMRuntimeComponent*> ComponentSet;
-        
-        for (const FGameplayTag& Tag : Filter.RequiredTags)
+        if (Tick.NextTickSeconds <= Now)
         {
-            TArray<UISMRuntimeComponent*> TaggedComponents = GetComponentsWithTag(Tag);
-            ComponentSet.Append(TaggedComponents);
+            Due.Add(Comp);
+            DueDeltas.Add(static_cast<float>(Now - Tick.LastTickSeconds));
         }
-        
-        ComponentsToSearch = ComponentSet.Array();
     }
-    else
+    if (Due.Num() == 0)
     {
-        // Search all components
-        ComponentsToSearch = GetAllComponents();
+        return;
     }
-    
-    // Query each component
-    for (UISMRuntimeComponent* Comp : ComponentsToSearch)
+
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    const int32 BatchSize = Settings && Settings->ManagedTickBatchSize > 0 ? Settings->ManagedTickBatchSize : Due.Num();
+    const bool bParallel = !Settings || Settings->bParallelManagedTick;
+
+    // Components that do not get a batch this frame stay due and tick next frame with the longer delta
+    FISMFrameBudgetScope Budget(&FrameBudget, TEXT("ComponentTick"), EISMFrameBudgetPriority::Normal);
+    TArray<int32> ParallelItems;
+    int32 BatchStart = 0;
+    for (; BatchStart < Due.Num(); BatchStart += BatchSize)
     {
-        if (!Comp)
+        if (BatchStart > 0 && !Budget.HasTime())
         {
-            continue;
+            break;
         }
-        
-        // Pre-filter by component-level criteria
-        if (!Filter.PassesComponentFilter(Comp))
+        const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Due.Num());
+
+        ParallelItems.Reset();
+        for (int32 Item = BatchStart; Item < BatchEnd; ++Item)
         {
-            continue;
+            if (Due[Item]->HasParallelRuntimeTick())
+            {
+                ParallelItems.Add(Item);
+            }
         }
-        
-        // Query this component's spatial index
-        TArray<int32> InstanceIndices = Comp->GetInstancesInRadius(Location, Radius, false);
-        
-        // Filter instances and convert to references
-        for (int32 Index : InstanceIndices)
+        if (ParallelItems.Num() > 0)
         {
-            FISMInstanceReference Ref;
-            Ref.Component = Comp;
-            Ref.InstanceIndex = Index;
-            
-            if (Filter.PassesFilter(Ref))
-            {
-                Results.Add(Ref);
-                
-                // Check max results
-                if (Filter.MaxResults > 0 && Results.Num() >= Filter.MaxResults)
+            ParallelFor(ParallelItems.Num(), [&Due, &DueDeltas, &ParallelItems](int32 ParallelIdx)
                 {
-                    return Results;
-                }
-            }
+                    const int32 Item = ParallelItems[ParallelIdx];
+                    Due[Item]->TickRuntimeParallel(DueDeltas[Item]);
+                }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
         }
-    }
-    
-    // Sort by distance if requested
-    if (Filter.bSortByDistance && Results.Num() > 0)
-    {
-        Results.Sort([&Location](const FISMInstanceReference& A, const FISMInstanceReference& B)
+
+        for (int32 Item = BatchStart; Item < BatchEnd; ++Item)
         {
-            float DistA = FVector::DistSquared(A.GetLocation(), Location);
-            float DistB = FVector::DistSquared(B.GetLocation(), Location);
-            return DistA < DistB;
-        });
+            // An earlier tick in the batch may have stopped this one's, or destroyed it
+            UISMRuntimeComponent* Comp = Due[Item];
+            if (!IsValid(Comp) || !ManagedTicks.IsValidIndex(Comp->ManagedTickIndex))
+            {
+                continue;
+            }
+
+            FManagedTick& Tick = ManagedTicks[Comp->ManagedTickIndex];
+            Tick.LastTickSeconds = Now;
+            Tick.NextTickSeconds = Now + Comp->GetManagedTickInterval();
+            Comp->TickRuntime(DueDeltas[Item]);
+        }
     }
-    
-    return Results;
+    Budget.Defer(Due.Num() - FMath::Min(BatchStart, Due.Num()));
 }
 
-TArray<FISMInstanceReference> UISMRuntimeSubsystem::QueryInstancesInBox(
-    const FBox& Box,
-    const FISMQueryFilter& Filter) const
+void UISMRuntimeSubsystem::QueueComponentInitialization(UISMRuntimeComponent* Component)
 {
-    TArray<FISMInstanceReference> Results;
-    
-    // Get components to search
-    TArray<UISMRuntimeComponent*> ComponentsToSearch;
-    
-    if (!Filter.RequiredTags.IsEmpty())
+    if (Component && Component->IsISMInitializing())
     {
-        TSet<UISMRuntimeComponent*> ComponentSet;
-        
-        for (const FGameplayTag& Tag : Filter.RequiredTags)
-        {
-            TArray<UISMRuntimeComponent*> TaggedComponents = GetComponentsWithTag(Tag);
-            ComponentSet.Append(TaggedComponents);
-        }
-        
-        ComponentsToSearch = ComponentSet.Array();
+        InitQueue.AddUnique(Component);
     }
-    else
+}
+
+void UISMRuntimeSubsystem::QueueInstanceEventFlush(UISMRuntimeComponent* Component)
+{
+    if (Component)
     {
-        ComponentsToSearch = GetAllComponents();
+        EventFlushQueue.AddUnique(Component);
     }
-    
-    // Query each component
-    for (UISMRuntimeComponent* Comp : ComponentsToSearch)
+}
+
+void UISMRuntimeSubsystem::EnqueueInstanceCommand(const FISMInstanceCommand& Command)
+{
+    if (InstanceCommands && Command.Id.IsValid())
     {
-        if (!Comp)
-        {
-            continue;
-        }
-        
-        if (!Filter.PassesComponentFilter(Comp))
-        {
-            continue;
-        }
-        
-        TArray<int32> InstanceIndices = Comp->GetInstancesInBox(Box, false);
-        
-        for (int32 Index : InstanceIndices)
-        {
-            FISMInstanceReference Ref;
-            Ref.Component = Comp;
-            Ref.InstanceIndex = Index;
-            
-            if (Filter.PassesFilter(Ref))
-            {
-                Results.Add(Ref);
-                
-                if (Filter.MaxResults > 0 && Results.Num() >= Filter.MaxResults)
-                {
-                    return Results;
-                }
-            }
-        }
+        InstanceCommands->Push(Command);
     }
-    
-    return Results;
 }
 
-
-TArray<FISMInstanceHandle> UISMRuntimeSubsystem::QueryInstancesOverlappingBox(
-    const FBox& Box,
-    const FISMQueryFilter& Filter) const
+int32 UISMRuntimeSubsystem::FlushInstanceCommands()
 {
-    TArray<FISMInstanceHandle> Results;
+    check(IsInGameThread());
 
-    if (!Box.IsValid)
+    if (!InstanceCommands || InstanceCommands->IsEmpty())
     {
-        return Results;
+        return 0;
     }
 
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : AllComponents)
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::FlushInstanceCommands);
+
+    DrainedInstanceCommands.Reset();
+    if (InstanceCommands->Drain(DrainedInstanceCommands) == 0)
     {
-        UISMRuntimeComponent* Comp = CompPtr.Get();
-        if (!Comp || !Comp->IsISMInitialized())
-        {
-            continue;
-        }
+        return 0;
+    }
 
-        // Component-level filter first (tags, interfaces) — cheap
-        if (!Filter.PassesComponentFilter(Comp))
+    struct FComponentCommands
+    {
+        FISMBatchMutationResult Result;
+        TArray<int32> Destroys;
+        TArray<int32> QuietDestroys;
+    };
+    TMap<UISMRuntimeComponent*, FComponentCommands> ByComponent;
+
+    int32 NumApplied = 0;
+    for (const FISMInstanceCommand& Command : DrainedInstanceCommands)
+    {
+        UISMRuntimeComponent* Comp = InstanceRegistry.ResolveComponent(Command.Id);
+        const int32 InstanceIndex = Command.Id.GetInstanceIndex();
+        if (!Comp || !Comp->IsValidInstanceIndex(InstanceIndex))
         {
             continue;
         }
 
-        // If this component opted out of AABB and the filter requires AABB data, skip it
-        if (!Comp->bComputeInstanceAABBs && Filter.bFilterByAABB && Filter.bExcludeIfAABBUnavailable)
+        // The slot was recycled after the command was issued
+        if (Command.Generation != INDEX_NONE && Comp->GetInstanceGeneration(InstanceIndex) != static_cast<uint32>(Command.Generation))
         {
             continue;
         }
 
-        // Coarse: does the query box overlap this component's aggregate bounds?
-        // Avoids per-instance work for distant components entirely.
-        if (Comp->IsBoundsValid())
+        FComponentCommands& Commands = ByComponent.FindOrAdd(Comp);
+        switch (Command.Type)
         {
-            // We'd love CachedInstanceBounds here — expose a getter if not already public
-            // For now fall through; individual GetInstancesOverlappingBox handles the rest
+        case EISMInstanceCommandType::Destroy:
+            (Command.bTriggerFeedbacks ? Commands.Destroys : Commands.QuietDestroys).Add(InstanceIndex);
+            break;
+        case EISMInstanceCommandType::WriteStateFlags:
+            Commands.Result.Streams.AddStateFlags(InstanceIndex, Command.SetMask, Command.ClearMask);
+            Commands.Result.WrittenFields |= EISMSnapshotField::StateFlags;
+            break;
+        case EISMInstanceCommandType::SetCustomData:
+            Commands.Result.Streams.AddCustomData(InstanceIndex, Command.CustomDataSlot, Command.CustomDataValue);
+            Commands.Result.WrittenFields |= EISMSnapshotField::CustomData;
+            break;
+        }
+        ++NumApplied;
+    }
+
+    UISMBatchSchedulerBase* Scheduler = GetOrCreateBatchSchduler();
+    for (TPair<UISMRuntimeComponent*, FComponentCommands>& Pair : ByComponent)
+    {
+        UISMRuntimeComponent* Comp = Pair.Key;
+        FComponentCommands& Commands = Pair.Value;
+
+        // Writes before destroys: the apply path skips destroyed instances
+        if (Scheduler && Commands.Result.WrittenFields != EISMSnapshotField::None)
+        {
+            Commands.Result.TargetComponent = Comp;
+            Scheduler->ApplyExternalResult(Commands.Result);
+        }
+        if (Commands.Destroys.Num() > 0)
+        {
+            Comp->BatchDestroyInstances(Commands.Destroys, false, true);
+        }
+        if (Commands.QuietDestroys.Num() > 0)
+        {
+            Comp->BatchDestroyInstances(Commands.QuietDestroys, false, false);
+        }
+
+        if (Comp->HasPendingInstanceEvents())
+        {
+            QueueInstanceEventFlush(Comp);
+        }
+    }
+
+    return NumApplied;
+}
+
+void UISMRuntimeSubsystem::FlushComponentInitialization()
+{
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> Queue = MoveTemp(InitQueue);
+    InitQueue.Reset();
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : Queue)
+    {
+        if (UISMRuntimeComponent* Comp = CompPtr.Get())
+        {
+            Comp->StepInitialization(MAX_int32);
+        }
+    }
+}
+
+void UISMRuntimeSubsystem::TickComponentInitialization()
+{
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::TickComponentInitialization);
+    LLM_SCOPE_BYTAG(ISMRuntime_Instances);
+
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    const int32 SliceInstances = Settings ? FMath::Max(Settings->ComponentInitSliceInstances, 1) : 16384;
+    const double OwnBudgetSeconds = (Settings ? Settings->ComponentInitBudgetMs : 2.0f) / 1000.0;
+
+    // One step always runs so a starved queue still drains; later steps stop at either budget
+    FISMFrameBudgetScope Budget(&FrameBudget, TEXT("ComponentInit"), EISMFrameBudgetPriority::Normal);
+    const double EndSeconds = FPlatformTime::Seconds() + Budget.ClampBudgetSeconds(OwnBudgetSeconds);
+    int32 NumSteps = 0;
+    int32 NumDone = 0;
+    for (; NumDone < InitQueue.Num(); ++NumSteps)
+    {
+        if (NumSteps > 0 && (FPlatformTime::Seconds() >= EndSeconds || !Budget.HasTime()))
+        {
+            break;
+        }
+
+        // Dropped by EndPlay, or finished through InitializeInstances in the meantime
+        UISMRuntimeComponent* Comp = InitQueue[NumDone].Get();
+        if (!Comp || !Comp->IsISMInitializing() || Comp->StepInitialization(SliceInstances))
+        {
+            ++NumDone;
+        }
+    }
+    InitQueue.RemoveAt(0, NumDone, EAllowShrinking::No);
+    Budget.Defer(InitQueue.Num());
+}
+
+void UISMRuntimeSubsystem::NotifyComponentInitialized(UISMRuntimeComponent* Component)
+{
+    if (Component)
+    {
+        FirePendingCallbacksForISM(Component->ManagedISMComponent, Component);
+    }
+}
+
+void UISMRuntimeSubsystem::TickComponentDormancy(float DeltaTime)
+{
+    DormancyCheckTimer -= DeltaTime;
+    if (DormancyCheckTimer > 0.0f)
+    {
+        return;
+    }
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    DormancyCheckTimer = Settings ? Settings->DormancyCheckInterval : 0.5f;
+
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    TArray<FVector, TInlineAllocator<8>> ViewLocations;
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PC = It->Get())
+        {
+            FVector Location;
+            FRotator Rotation;
+            PC->GetPlayerViewPoint(Location, Rotation);
+            ViewLocations.Add(Location);
+        }
+    }
+
+    // Out of budget: carry on next frame rather than a whole interval later
+    if (!UpdateComponentDormancy(ViewLocations))
+    {
+        DormancyCheckTimer = 0.0f;
+    }
+}
+
+bool UISMRuntimeSubsystem::UpdateComponentDormancy(TConstArrayView<FVector> ViewLocations)
+{
+    if (ViewLocations.Num() == 0)
+    {
+        return true;
+    }
+
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::UpdateComponentDormancy);
+    LLM_SCOPE_BYTAG(ISMRuntime);
+
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    const double WakeFraction = Settings ? Settings->DormancyWakeFraction : 0.8f;
+
+    // Entering and waking are O(instances); one transition always runs, later ones stop at the budget
+    FISMFrameBudgetScope Budget(&FrameBudget, TEXT("Dormancy"), EISMFrameBudgetPriority::Low);
+    int32 NumTransitions = 0;
+    for (int32 i = 0; i < AllComponents.Num(); ++i)
+    {
+        UISMRuntimeComponent* Comp = AllComponents[i].Get();
+        if (!Comp || !Comp->bAllowDormancy || !Comp->IsISMInitialized())
+        {
+            continue;
+        }
+
+        const double Distance = Comp->GetEffectiveDormancyDistance();
+        if (Distance <= 0.0)
+        {
+            continue;
+        }
+
+        // Nothing active to measure against: use the owner
+        FBox Bounds = Comp->GetDormancyBounds();
+        if (!Bounds.IsValid)
+        {
+            const AActor* Owner = Comp->GetOwner();
+            const FVector OwnerLocation = Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+            Bounds = FBox(OwnerLocation, OwnerLocation);
+        }
+
+        double NearestDistSq = TNumericLimits<double>::Max();
+        for (const FVector& ViewLocation : ViewLocations)
+        {
+            NearestDistSq = FMath::Min(NearestDistSq, Bounds.ComputeSquaredDistanceToPoint(ViewLocation));
+        }
+
+        const bool bWake = Comp->IsDormant() && NearestDistSq <= FMath::Square(Distance * WakeFraction);
+        const bool bSleep = !Comp->IsDormant() && NearestDistSq > FMath::Square(Distance);
+        if (!bWake && !bSleep)
+        {
+            continue;
+        }
+
+        if (NumTransitions > 0 && !Budget.HasTime())
+        {
+            Budget.Defer(1);
+            return false;
+        }
+
+        if (bWake ? Comp->WakeFromDormancy() : Comp->EnterDormancy())
+        {
+            ++NumTransitions;
+        }
+    }
+    return true;
+}
+
+int32 UISMRuntimeSubsystem::GetNumDormantComponents() const
+{
+    int32 NumDormant = 0;
+    for (const UISMRuntimeComponent* Comp : GetLiveComponents())
+    {
+        if (Comp->IsDormant())
+        {
+            ++NumDormant;
+        }
+    }
+    return NumDormant;
+}
+
+void UISMRuntimeSubsystem::NotifyComponentDormancyChanged(UISMRuntimeComponent* Component)
+{
+    if (!Component)
+    {
+        return;
+    }
+
+    if (Component->IsDormant())
+    {
+        ComponentBroadphase.Remove(Component);
+    }
+    else
+    {
+        ComponentBroadphase.Add(Component);
+    }
+}
+
+void UISMRuntimeSubsystem::MarkComponentBoundsDirty(const UISMRuntimeComponent* Component)
+{
+    ComponentBroadphase.MarkDirty(Component);
+}
+
+TConstArrayView<UISMRuntimeComponent*> UISMRuntimeSubsystem::GetLiveComponents() const
+{
+    if (bLiveComponentsDirty)
+    {
+        LiveComponents.Reset(AllComponents.Num());
+        for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : AllComponents)
+        {
+            if (UISMRuntimeComponent* Comp = CompPtr.Get())
+            {
+                LiveComponents.Add(Comp);
+            }
+        }
+        bLiveComponentsDirty = false;
+    }
+    return LiveComponents;
+}
+
+TArray<UISMRuntimeComponent*> UISMRuntimeSubsystem::GetComponentsWithTag(FGameplayTag Tag) const
+{
+    TArray<UISMRuntimeComponent*> ValidComponents;
+    if (!Tag.IsValid())
+    {
+        return ValidComponents;
+    }
+
+    FISMTagFilterMasks Masks;
+    ComponentTagIndex.BuildFilterMasks(FGameplayTagContainer(Tag), FGameplayTagContainer::EmptyContainer, Masks);
+    ComponentTagIndex.ForEachCandidate(Masks, [&ValidComponents, Tag](UISMRuntimeComponent* Comp, bool bExact)
+    {
+        if (bExact || Comp->ISMComponentTags.HasTag(Tag))
+        {
+            ValidComponents.Add(Comp);
+        }
+        return true;
+    });
+    
+    return ValidComponents;
+}
+
+
+#pragma endregion
+
+
+#pragma region QUERIES
+
+void UISMRuntimeSubsystem::RequestRuntimeComponent(UInstancedStaticMeshComponent* ISM, TFunction<void(UISMRuntimeComponent*)> Callback)
+{
+	if (ISMToRuntimeComponentMap.Contains(ISM))
+    {
+        // Already exists - call immediately
+        if (UISMRuntimeComponent* ExistingComp = ISMToRuntimeComponentMap[ISM].Get())
+        {
+            Callback(ExistingComp);
+            return;
+        }
+    }
+    else
+    {
+        if (!PendingRuntimeComponentCallbacks.Contains(ISM))
+        {
+            PendingRuntimeComponentCallbacks.Add(ISM, TArray<TFunction<void(UISMRuntimeComponent*)>>());
+        }
+        PendingRuntimeComponentCallbacks[ISM].Add(Callback);
+    }
+}
+
+TArray<FISMInstanceReference> UISMRuntimeSubsystem::QueryInstancesInRadius(
+    const FVector& Location,
+    float Radius,
+    const FISMQueryFilter& Filter) const
+{
+    TArray<FISMInstanceReference> Results;
+    QueryInstancesInRadius(Location, Radius, Filter, Results);
+    return Results;
+}
+
+void UISMRuntimeSubsystem::QueryInstancesInRadius(
+    const FVector& Location,
+    float Radius,
+    const FISMQueryFilter& Filter,
+    TArray<FISMInstanceReference>& OutResults) const
+{
+    QueryInstancesInRadius(Location, Radius, Filter.Compile(), OutResults);
+}
+
+void UISMRuntimeSubsystem::QueryInstancesInRadius(
+    const FVector& Location,
+    float Radius,
+    const FISMCompiledQueryFilter& Filter,
+    TArray<FISMInstanceReference>& OutResults) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::QueryInstancesInRadius);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+
+    const FBox QueryBounds(Location - FVector(Radius), Location + FVector(Radius));
+    auto RadiusQuery = [&Location, Radius](UISMRuntimeComponent* Comp, const FISMCompiledComponentFilter& Bound, TFunctionRef<bool(int32)> Emit)
+    {
+        return Comp->ForEachInstanceInRadiusWithTags(Location, Radius, Bound.GetRequiredTagMask(), Emit);
+    };
+
+    if (!Filter.GetFilter().bSortByDistance)
+    {
+        ForEachComponentInstance(QueryBounds, Filter, Filter.GetFilter().MaxResults, RadiusQuery, &MakeInstanceReference,
+            [&OutResults](const FISMInstanceReference& Ref)
+            {
+                OutResults.Add(Ref);
+                return true;
+            });
+        return;
+    }
+
+    // MaxResults selects the nearest passing instances, so every candidate has to be seen
+    TISMNearestSelection<FISMInstanceReference> Nearest(Filter.GetFilter().MaxResults);
+    ForEachComponentInstance(QueryBounds, Filter, -1, RadiusQuery, &MakeInstanceReference,
+        [&Nearest, &Location](const FISMInstanceReference& Ref)
+        {
+            Nearest.Add(Ref, static_cast<float>(FVector::DistSquared(Ref.GetLocation(), Location)));
+            return true;
+        });
+    Nearest.AppendSorted(OutResults);
+}
+
+bool UISMRuntimeSubsystem::ForEachInstanceInRadius(
+    const FVector& Location,
+    float Radius,
+    const FISMQueryFilter& Filter,
+    TFunctionRef<bool(const FISMInstanceReference&)> Visitor) const
+{
+    return ForEachInstanceInRadius(Location, Radius, Filter.Compile(), Visitor);
+}
+
+bool UISMRuntimeSubsystem::ForEachInstanceInRadius(
+    const FVector& Location,
+    float Radius,
+    const FISMCompiledQueryFilter& Filter,
+    TFunctionRef<bool(const FISMInstanceReference&)> Visitor) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::ForEachInstanceInRadius);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+
+    const FBox QueryBounds(Location - FVector(Radius), Location + FVector(Radius));
+
+    return ForEachComponentInstance(QueryBounds, Filter, Filter.GetFilter().MaxResults,
+        [&Location, Radius](UISMRuntimeComponent* Comp, const FISMCompiledComponentFilter& Bound, TFunctionRef<bool(int32)> Emit)
+        {
+            // Query this component's spatial index, filtering as candidates stream out
+            return Comp->ForEachInstanceInRadiusWithTags(Location, Radius, Bound.GetRequiredTagMask(), Emit);
+        },
+        &MakeInstanceReference, Visitor);
+}
+
+FISMQueryBatchResults UISMRuntimeSubsystem::SubmitQueryBatch(
+    const TArray<FISMQueryDescriptor>& Queries,
+    bool bAllowParallel) const
+{
+    FISMQueryBatchResults Results;
+    SubmitQueryBatch(TConstArrayView<FISMQueryDescriptor>(Queries), Results, bAllowParallel);
+    return Results;
+}
+
+void UISMRuntimeSubsystem::SubmitQueryBatch(
+    TConstArrayView<FISMQueryDescriptor> Queries,
+    FISMQueryBatchResults& OutResults,
+    bool bAllowParallel) const
+{
+    OutResults.Reset();
+    if (Queries.Num() == 0)
+    {
+        return;
+    }
+
+    // Group queries by the components they touch, so each component runs its whole group in one pass
+    struct FComponentGroup
+    {
+        UISMRuntimeComponent* Component = nullptr;
+        TArray<int32, TInlineAllocator<8>> QueryIndices;
+
+        /** (query index, instance index) pairs that passed the query's filter */
+        TArray<TPair<int32, int32>> Hits;
+    };
+    TArray<FComponentGroup> Groups;
+    TMap<UISMRuntimeComponent*, int32> GroupByComponent;
+
+    for (int32 QueryIdx = 0; QueryIdx < Queries.Num(); QueryIdx++)
+    {
+        const FISMQueryDescriptor& Query = Queries[QueryIdx];
+        if (Query.Radius < 0.0f)
+        {
+            continue;
+        }
+
+        const FBox QueryBounds(Query.Center - FVector(Query.Radius), Query.Center + FVector(Query.Radius));
+        ForEachQueryComponent(QueryBounds, Query.Filter, [&Groups, &GroupByComponent, QueryIdx](UISMRuntimeComponent* Comp)
+        {
+            int32& GroupIdx = GroupByComponent.FindOrAdd(Comp, INDEX_NONE);
+            if (GroupIdx == INDEX_NONE)
+            {
+                GroupIdx = Groups.AddDefaulted();
+                Groups[GroupIdx].Component = Comp;
+            }
+            Groups[GroupIdx].QueryIndices.Add(QueryIdx);
+            return true;
+        });
+    }
+
+    TArray<FISMCompiledQueryFilter> Filters;
+    Filters.Reserve(Queries.Num());
+    for (const FISMQueryDescriptor& Query : Queries)
+    {
+        Filters.Emplace(Query.Filter);
+    }
+
+    // Each group only writes its own hits, so groups can run on worker threads
+    auto RunGroup = [&Groups, &Queries, &Filters](int32 GroupIdx)
+    {
+        FComponentGroup& Group = Groups[GroupIdx];
+        UISMRuntimeComponent* Comp = Group.Component;
+
+        TArray<FISMSpatialSphereQuery, TInlineAllocator<8>> Spheres;
+        TArray<FISMCompiledComponentFilter, TInlineAllocator<8>> Bound;
+        for (int32 QueryIdx : Group.QueryIndices)
+        {
+            Spheres.Add({ Queries[QueryIdx].Center, Queries[QueryIdx].Radius });
+            Bound.Add(Filters[QueryIdx].BindComponent(Comp));
+        }
+
+        Comp->ForEachInstanceInRadiusBatch(Spheres, [&Group, &Filters, &Bound](int32 LocalIdx, int32 Index)
+        {
+            const int32 QueryIdx = Group.QueryIndices[LocalIdx];
+            if (Filters[QueryIdx].PassesInstance(Bound[LocalIdx], Index))
+            {
+                Group.Hits.Emplace(QueryIdx, Index);
+            }
+        });
+    };
+
+    if (ShouldRunParallel(bAllowParallel, Groups.Num()))
+    {
+        ParallelFor(Groups.Num(), RunGroup);
+    }
+    else
+    {
+        for (int32 GroupIdx = 0; GroupIdx < Groups.Num(); GroupIdx++)
+        {
+            RunGroup(GroupIdx);
+        }
+    }
+
+    // Sorted queries select their nearest hits; the rest count in group order, honoring MaxResults
+    TArray<TOptional<TISMNearestSelection<FISMInstanceHandle>>> Nearest;
+    Nearest.SetNum(Queries.Num());
+    TArray<int32> Counts;
+    Counts.SetNumZeroed(Queries.Num());
+    for (const FComponentGroup& Group : Groups)
+    {
+        for (const TPair<int32, int32>& Hit : Group.Hits)
+        {
+            const FISMQueryDescriptor& Query = Queries[Hit.Key];
+            if (Query.Filter.bSortByDistance)
+            {
+                if (!Nearest[Hit.Key].IsSet())
+                {
+                    Nearest[Hit.Key].Emplace(Query.Filter.MaxResults);
+                }
+                const FISMInstanceHandle Ref = MakeInstanceReference(Group.Component, Hit.Value);
+                Nearest[Hit.Key]->Add(Ref, static_cast<float>(FVector::DistSquared(Ref.GetLocation(), Query.Center)));
+            }
+            else if (Query.Filter.MaxResults <= 0 || Counts[Hit.Key] < Query.Filter.MaxResults)
+            {
+                Counts[Hit.Key]++;
+            }
+        }
+    }
+
+    OutResults.Offsets.SetNumUninitialized(Queries.Num() + 1);
+    OutResults.Offsets[0] = 0;
+    for (int32 QueryIdx = 0; QueryIdx < Queries.Num(); QueryIdx++)
+    {
+        if (Nearest[QueryIdx].IsSet())
+        {
+            Counts[QueryIdx] = Nearest[QueryIdx]->Num();
+        }
+        OutResults.Offsets[QueryIdx + 1] = OutResults.Offsets[QueryIdx] + Counts[QueryIdx];
+    }
+    OutResults.Results.SetNum(OutResults.Offsets.Last());
+
+    TArray<int32> Written;
+    Written.SetNumZeroed(Queries.Num());
+    for (const FComponentGroup& Group : Groups)
+    {
+        for (const TPair<int32, int32>& Hit : Group.Hits)
+        {
+            if (!Queries[Hit.Key].Filter.bSortByDistance && Written[Hit.Key] < Counts[Hit.Key])
+            {
+                OutResults.Results[OutResults.Offsets[Hit.Key] + Written[Hit.Key]++] = MakeInstanceReference(Group.Component, Hit.Value);
+            }
+        }
+    }
+
+    TArray<FISMInstanceHandle> Sorted;
+    for (int32 QueryIdx = 0; QueryIdx < Queries.Num(); QueryIdx++)
+    {
+        if (!Nearest[QueryIdx].IsSet())
+        {
+            continue;
+        }
+
+        Sorted.Reset();
+        Nearest[QueryIdx]->AppendSorted(Sorted);
+        for (int32 i = 0; i < Sorted.Num(); i++)
+        {
+            OutResults.Results[OutResults.Offsets[QueryIdx] + i] = Sorted[i];
+        }
+    }
+}
+
+void UISMRuntimeSubsystem::SubmitQueryBatchDeferred(
+    TArray<FISMQueryDescriptor> Queries,
+    TFunction<void(const FISMQueryBatchResults&)> OnComplete)
+{
+    FPendingQueryBatch& Batch = PendingQueryBatches.AddDefaulted_GetRef();
+    Batch.Queries = MoveTemp(Queries);
+    Batch.OnComplete = MoveTemp(OnComplete);
+}
+
+int32 UISMRuntimeSubsystem::SubscribeSphere(const FVector& Center, float Radius, const FISMQueryFilter& Filter)
+{
+    const int32 Id = NextSphereSubscriptionId++;
+    FSphereSubscription& Subscription = SphereSubscriptions.Add(Id);
+    Subscription.Center = Center;
+    Subscription.Radius = FMath::Max(Radius, 0.0f);
+    Subscription.Filter = Filter.Compile();
+    return Id;
+}
+
+bool UISMRuntimeSubsystem::UpdateSphereSubscription(int32 SubscriptionId, const FVector& Center, float Radius, FISMSphereSubscriptionDelta& OutDelta)
+{
+    OutDelta.Reset();
+
+    FSphereSubscription* Subscription = SphereSubscriptions.Find(SubscriptionId);
+    if (!Subscription)
+    {
+        return false;
+    }
+
+    Radius = FMath::Max(Radius, 0.0f);
+    const FISMSpatialSphereQuery From{ Subscription->Center, Subscription->Radius };
+    const FISMSpatialSphereQuery To{ Center, Radius };
+
+    auto MakeExitedReference = [](UISMRuntimeComponent* Comp, int32 Index, int32 Generation)
+    {
+        FISMInstanceReference Ref;
+        Ref.Component = Comp;
+        Ref.InstanceIndex = Index;
+        Ref.Generation = Generation;
+        return Ref;
+    };
+
+    // Components the new sphere can reach; the old sphere's are covered so stale members are seen
+    FBox QueryBounds = FBox::BuildAABB(Center, FVector(Radius));
+    if (Subscription->bPrimed)
+    {
+        QueryBounds += FBox::BuildAABB(From.Center, FVector(From.Radius));
+    }
+
+    TArray<FSphereSubscriptionComponent> Updated;
+    Updated.Reserve(Subscription->Components.Num());
+
+    const FISMCompiledQueryFilter& Compiled = Subscription->Filter;
+    ForEachQueryComponent(QueryBounds, Compiled.GetFilter(), [&](UISMRuntimeComponent* Comp)
+    {
+        const FISMCompiledComponentFilter Bound = Compiled.BindComponent(Comp);
+        if (!Bound.bPasses || !Comp->IsISMQueryable())
+        {
+            return true;
+        }
+
+        FSphereSubscriptionComponent* Previous = Subscription->Components.FindByPredicate([Comp](const FSphereSubscriptionComponent& Entry)
+            {
+                return Entry.Component.Get() == Comp;
+            });
+
+        FSphereSubscriptionComponent& Entry = Updated.AddDefaulted_GetRef();
+        Entry.Component = Comp;
+        Entry.QueryRevision = Comp->GetQueryRevision();
+
+        if (Previous && Subscription->bPrimed && Previous->QueryRevision == Entry.QueryRevision)
+        {
+            // Nothing changed under the sphere: patch the members with the shell between old and new
+            Entry.Members = MoveTemp(Previous->Members);
+            Comp->GetSpatialIndex().ForEachInstanceRadiusDelta(From, To, [&](int32 Index, bool bEntered)
+                {
+                    if (!bEntered)
+                    {
+                        int32 Generation = 0;
+                        if (Entry.Members.RemoveAndCopyValue(Index, Generation))
+                        {
+                            OutDelta.Exited.Add(MakeExitedReference(Comp, Index, Generation));
+                        }
+                    }
+                    else if (!Entry.Members.Contains(Index) && Comp->IsInstanceActive(Index) && Compiled.PassesInstance(Bound, Index))
+                    {
+                        const FISMInstanceReference Ref = MakeInstanceReference(Comp, Index);
+                        Entry.Members.Add(Index, Ref.Generation);
+                        OutDelta.Entered.Add(Ref);
+                    }
+                });
+        }
+        else
+        {
+            // First look, or the component changed: full query, then diff against the old members
+            TMap<int32, int32> OldMembers = Previous ? MoveTemp(Previous->Members) : TMap<int32, int32>();
+            Comp->ForEachInstanceInRadius(Center, Radius, [&](int32 Index)
+                {
+                    if (Compiled.PassesInstance(Bound, Index))
+                    {
+                        const int32 Generation = static_cast<int32>(Comp->GetInstanceGeneration(Index));
+                        const int32* OldGeneration = OldMembers.Find(Index);
+                        if (OldGeneration && *OldGeneration == Generation)
+                        {
+                            OldMembers.Remove(Index);
+                        }
+                        else
+                        {
+                            // New, or a reused slot - the old occupant is reported as exited below
+                            OutDelta.Entered.Add(MakeInstanceReference(Comp, Index));
+                        }
+                        Entry.Members.Add(Index, Generation);
+                    }
+                    return true;
+                });
+
+            for (const TPair<int32, int32>& Member : OldMembers)
+            {
+                OutDelta.Exited.Add(MakeExitedReference(Comp, Member.Key, Member.Value));
+            }
+        }
+        return true;
+    });
+
+    // Components out of reach, filtered out, or destroyed: everything they still hold has left
+    for (const FSphereSubscriptionComponent& Stale : Subscription->Components)
+    {
+        if (Stale.Members.IsEmpty())
+        {
+            continue;
+        }
+
+        UISMRuntimeComponent* Comp = Stale.Component.Get();
+        for (const TPair<int32, int32>& Member : Stale.Members)
+        {
+            OutDelta.Exited.Add(MakeExitedReference(Comp, Member.Key, Member.Value));
+        }
+    }
+
+    Subscription->Components = MoveTemp(Updated);
+    Subscription->Center = Center;
+    Subscription->Radius = Radius;
+    Subscription->bPrimed = true;
+    return true;
+}
+
+void UISMRuntimeSubsystem::UnsubscribeSphere(int32 SubscriptionId)
+{
+    SphereSubscriptions.Remove(SubscriptionId);
+}
+
+void UISMRuntimeSubsystem::GetSphereSubscriptionInstances(int32 SubscriptionId, TArray<FISMInstanceHandle>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    const FSphereSubscription* Subscription = SphereSubscriptions.Find(SubscriptionId);
+    if (!Subscription)
+    {
+        return;
+    }
+
+    for (const FSphereSubscriptionComponent& Entry : Subscription->Components)
+    {
+        UISMRuntimeComponent* Comp = Entry.Component.Get();
+        if (!Comp)
+        {
+            continue;
+        }
+
+        for (const TPair<int32, int32>& Member : Entry.Members)
+        {
+            FISMInstanceReference Ref;
+            Ref.Component = Comp;
+            Ref.InstanceIndex = Member.Key;
+            Ref.Generation = Member.Value;
+            OutInstances.Add(Ref);
+        }
+    }
+}
+
+TArray<FISMInstanceReference> UISMRuntimeSubsystem::QueryInstancesInBox(
+    const FBox& Box,
+    const FISMQueryFilter& Filter) const
+{
+    TArray<FISMInstanceReference> Results;
+    QueryInstancesInBox(Box, Filter, Results);
+    return Results;
+}
+
+void UISMRuntimeSubsystem::QueryInstancesInBox(
+    const FBox& Box,
+    const FISMQueryFilter& Filter,
+    TArray<FISMInstanceReference>& OutResults) const
+{
+    QueryInstancesInBox(Box, Filter.Compile(), OutResults);
+}
+
+void UISMRuntimeSubsystem::QueryInstancesInBox(
+    const FBox& Box,
+    const FISMCompiledQueryFilter& Filter,
+    TArray<FISMInstanceReference>& OutResults) const
+{
+    ForEachInstanceInBox(Box, Filter, [&OutResults](const FISMInstanceReference& Ref)
+    {
+        OutResults.Add(Ref);
+        return true;
+    });
+}
+
+bool UISMRuntimeSubsystem::ForEachInstanceInBox(
+    const FBox& Box,
+    const FISMQueryFilter& Filter,
+    TFunctionRef<bool(const FISMInstanceReference&)> Visitor) const
+{
+    return ForEachInstanceInBox(Box, Filter.Compile(), Visitor);
+}
+
+bool UISMRuntimeSubsystem::ForEachInstanceInBox(
+    const FBox& Box,
+    const FISMCompiledQueryFilter& Filter,
+    TFunctionRef<bool(const FISMInstanceReference&)> Visitor) const
+{
+    return ForEachComponentInstance(Box, Filter, Filter.GetFilter().MaxResults,
+        [&Box](UISMRuntimeComponent* Comp, const FISMCompiledComponentFilter& Bound, TFunctionRef<bool(int32)> Emit)
+        {
+            return Comp->ForEachInstanceInBoxWithTags(Box, Bound.GetRequiredTagMask(), Emit);
+        },
+        &MakeInstanceReference, Visitor);
+}
+
+bool UISMRuntimeSubsystem::ForEachQueryComponent(
+    const FISMQueryFilter& Filter,
+    TFunctionRef<bool(UISMRuntimeComponent*)> Visitor) const
+{
+    if (Filter.RequiredTags.IsEmpty() && Filter.ExcludedTags.IsEmpty())
+    {
+        // Search all components
+        for (UISMRuntimeComponent* Comp : GetLiveComponents())
+        {
+            if (Filter.PassesComponentFilter(Comp) && !Visitor(Comp))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Candidates come from the tag posting lists; only unindexed components need the container test
+    FISMTagFilterMasks Masks;
+    ComponentTagIndex.BuildFilterMasks(Filter.RequiredTags, Filter.ExcludedTags, Masks);
+    return ComponentTagIndex.ForEachCandidate(Masks, [&Filter, &Visitor](UISMRuntimeComponent* Comp, bool bExact)
+    {
+        return !Filter.PassesComponentFilter(Comp, bExact) || Visitor(Comp);
+    });
+}
+
+bool UISMRuntimeSubsystem::ForEachQueryComponent(
+    const FBox& QueryBounds,
+    const FISMQueryFilter& Filter,
+    TFunctionRef<bool(UISMRuntimeComponent*)> Visitor) const
+{
+    ComponentBroadphase.Flush();
+
+    FISMComponentBroadphase::FCandidateArray Candidates;
+    ComponentBroadphase.GatherOverlapping(QueryBounds, Candidates);
+
+    const bool bHasTagSets = !Filter.RequiredTags.IsEmpty() || !Filter.ExcludedTags.IsEmpty();
+    FISMTagFilterMasks Masks;
+    if (bHasTagSets)
+    {
+        ComponentTagIndex.BuildFilterMasks(Filter.RequiredTags, Filter.ExcludedTags, Masks);
+    }
+
+    for (UISMRuntimeComponent* Comp : Candidates)
+    {
+        bool bExact = !bHasTagSets;
+        if (bHasTagSets && !ComponentTagIndex.PassesTagMasks(Comp, Masks, bExact))
+        {
+            continue;
+        }
+
+        if (Filter.PassesComponentFilter(Comp, bExact) && !Visitor(Comp))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UISMRuntimeSubsystem::ForEachComponentInstance(
+    const FBox& QueryBounds,
+    const FISMCompiledQueryFilter& Filter,
+    int32 MaxResults,
+    TFunctionRef<bool(UISMRuntimeComponent*, const FISMCompiledComponentFilter&, TFunctionRef<bool(int32)>)> ComponentQuery,
+    TFunctionRef<FISMInstanceHandle(UISMRuntimeComponent*, int32)> MakeRef,
+    TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::ForEachComponentInstance);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+
+    const FISMQueryFilter& SourceFilter = Filter.GetFilter();
+    int32 NumVisited = 0;
+
+    // Filter on the index; only passing instances get a reference built
+    auto VisitComponent = [&](UISMRuntimeComponent* Comp)
+    {
+        const FISMCompiledComponentFilter Bound = Filter.BindComponent(Comp);
+        if (!Bound.bPasses)
+        {
+            return true;
+        }
+
+        return ComponentQuery(Comp, Bound, [&](int32 Index)
+        {
+            if (!Filter.PassesInstance(Bound, Index))
+            {
+                return true;
+            }
+
+            if (!Visitor(MakeRef(Comp, Index)))
+            {
+                return false;
+            }
+
+            return MaxResults <= 0 || ++NumVisited < MaxResults;
+        });
+    };
+
+    if (!SourceFilter.bAllowParallel)
+    {
+        return ForEachQueryComponent(QueryBounds, SourceFilter, VisitComponent);
+    }
+
+    TArray<UISMRuntimeComponent*, TInlineAllocator<64>> Components;
+    ForEachQueryComponent(QueryBounds, SourceFilter, [&Components](UISMRuntimeComponent* Comp)
+    {
+        Components.Add(Comp);
+        return true;
+    });
+
+    if (!ShouldRunParallel(SourceFilter, Components.Num()))
+    {
+        for (UISMRuntimeComponent* Comp : Components)
+        {
+            if (!VisitComponent(Comp))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // One run of passing indices per component, appended to the worker's own buffer
+    struct FComponentRun
+    {
+        int32 ComponentIdx;
+        int32 First;
+        int32 Num;
+    };
+    struct FQueryContext
+    {
+        TArray<int32> Indices;
+        TArray<FComponentRun> Runs;
+    };
+
+    TArray<FQueryContext> Contexts;
+    ParallelForWithTaskContext(Contexts, Components.Num(), [&](FQueryContext& Context, int32 ComponentIdx)
+    {
+        UISMRuntimeComponent* Comp = Components[ComponentIdx];
+        const FISMCompiledComponentFilter Bound = Filter.BindComponent(Comp);
+        if (!Bound.bPasses)
+        {
+            return;
         }
 
-        // Per-instance AABB test
-        TArray<int32> Overlapping = Comp->GetInstancesOverlappingBox(Box, false);
+        const int32 First = Context.Indices.Num();
+        ComponentQuery(Comp, Bound, [&](int32 Index)
+        {
+            if (Filter.PassesInstance(Bound, Index))
+            {
+                Context.Indices.Add(Index);
+            }
+
+            // No component can contribute more than MaxResults
+            return MaxResults <= 0 || Context.Indices.Num() - First < MaxResults;
+        });
+
+        if (Context.Indices.Num() > First)
+        {
+            Context.Runs.Add({ ComponentIdx, First, Context.Indices.Num() - First });
+        }
+    });
 
-        for (int32 Idx : Overlapping)
+    // Merge in candidate order so results match the serial path
+    TArray<TPair<int32, int32>, TInlineAllocator<64>> RunOrder;
+    for (int32 ContextIdx = 0; ContextIdx < Contexts.Num(); ContextIdx++)
+    {
+        for (int32 RunIdx = 0; RunIdx < Contexts[ContextIdx].Runs.Num(); RunIdx++)
         {
-            FISMInstanceHandle Handle = Comp->GetInstanceHandle(Idx);
+            RunOrder.Emplace(ContextIdx, RunIdx);
+        }
+    }
+    Algo::SortBy(RunOrder, [&Contexts](const TPair<int32, int32>& Run)
+    {
+        return Contexts[Run.Key].Runs[Run.Value].ComponentIdx;
+    });
+
+    for (const TPair<int32, int32>& RunRef : RunOrder)
+    {
+        const FQueryContext& Context = Contexts[RunRef.Key];
+        const FComponentRun& Run = Context.Runs[RunRef.Value];
+        UISMRuntimeComponent* Comp = Components[Run.ComponentIdx];
 
-            if (Filter.PassesFilter(Handle))
+        for (int32 i = Run.First; i < Run.First + Run.Num; i++)
+        {
+            if (!Visitor(MakeRef(Comp, Context.Indices[i])))
             {
-                Results.Add(Handle);
+                return false;
             }
 
-            if (Filter.MaxResults > 0 && Results.Num() >= Filter.MaxResults)
+            if (MaxResults > 0 && ++NumVisited >= MaxResults)
             {
-                return Results;
+                return false;
             }
         }
     }
 
+    return true;
+}
+
+bool UISMRuntimeSubsystem::ShouldRunParallel(const FISMQueryFilter& Filter, int32 NumItems)
+{
+    return ShouldRunParallel(Filter.bAllowParallel, NumItems);
+}
+
+bool UISMRuntimeSubsystem::ShouldRunParallel(bool bAllowParallel, int32 NumItems)
+{
+    if (!bAllowParallel || NumItems < 2 || !FApp::ShouldUseThreadingForPerformance())
+    {
+        return false;
+    }
+
+    const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
+    return NumItems >= (Settings ? Settings->ParallelQueryMinItems : 16);
+}
+
+FISMInstanceHandle UISMRuntimeSubsystem::MakeInstanceReference(UISMRuntimeComponent* Comp, int32 Index)
+{
+    FISMInstanceReference Ref;
+    Ref.Component = Comp;
+    Ref.InstanceIndex = Index;
+    Ref.Generation = static_cast<int32>(Comp->GetInstanceGeneration(Index));
+    return Ref;
+}
+
+
+TArray<FISMInstanceHandle> UISMRuntimeSubsystem::QueryInstancesOverlappingBox(
+    const FBox& Box,
+    const FISMQueryFilter& Filter) const
+{
+    TArray<FISMInstanceHandle> Results;
+    QueryInstancesOverlappingBox(Box, Filter, Results);
     return Results;
 }
 
+void UISMRuntimeSubsystem::QueryInstancesOverlappingBox(
+    const FBox& Box,
+    const FISMQueryFilter& Filter,
+    TArray<FISMInstanceHandle>& OutResults) const
+{
+    ForEachInstanceOverlappingBox(Box, Filter, [&OutResults](const FISMInstanceReference& Ref)
+    {
+        OutResults.Add(Ref);
+        return true;
+    });
+}
+
+bool UISMRuntimeSubsystem::ForEachInstanceOverlappingBox(
+    const FBox& Box,
+    const FISMQueryFilter& Filter,
+    TFunctionRef<bool(const FISMInstanceReference&)> Visitor) const
+{
+    ISM_TRACE_SCOPE(UISMRuntimeSubsystem::ForEachInstanceOverlappingBox);
+    LLM_SCOPE_BYTAG(ISMRuntime_Query);
+
+    if (!Box.IsValid)
+    {
+        return true;
+    }
+
+    // Component-level filter first (tags, interfaces, AABB availability) — cheap
+    return ForEachComponentInstance(Box, Filter.Compile(), Filter.MaxResults,
+        [&Box](UISMRuntimeComponent* Comp, const FISMCompiledComponentFilter&, TFunctionRef<bool(int32)> Emit)
+        {
+            if (!Comp->IsISMQueryable())
+            {
+                return true;
+            }
+
+            // Per-instance AABB test
+            return Comp->ForEachInstanceOverlappingBox(Box, Emit);
+        },
+        [](UISMRuntimeComponent* Comp, int32 Index)
+        {
+            // Registered handle, so converted instances report their actor
+            return Comp->GetInstanceHandle(Index);
+        },
+        Visitor);
+}
+
 
 // ============================================================
 //  QueryInstancesOverlappingInstance
@@ -471,50 +1651,111 @@ FISMInstanceReference UISMRuntimeSubsystem::FindNearestInstance(
     const FISMQueryFilter& Filter,
     float MaxDistance) const
 {
-    FISMInstanceReference NearestRef;
-    float NearestDistSq = MaxDistance > 0.0f ? (MaxDistance * MaxDistance) : MAX_FLT;
-    
-    // Get components to search
-    TArray<UISMRuntimeComponent*> ComponentsToSearch = GetAllComponents();
-    
-    for (UISMRuntimeComponent* Comp : ComponentsToSearch)
+    TArray<FISMInstanceHandle> Nearest = FindNearestInstances(Location, 1, Filter, MaxDistance);
+    return Nearest.Num() > 0 ? Nearest[0] : FISMInstanceReference();
+}
+
+TArray<FISMInstanceHandle> UISMRuntimeSubsystem::FindNearestInstances(
+    const FVector& Location,
+    int32 Count,
+    const FISMQueryFilter& Filter,
+    float MaxDistance) const
+{
+    TArray<FISMInstanceHandle> Results;
+
+    if (Count <= 0)
     {
-        if (!Comp)
+        return Results;
+    }
+
+    struct FNearestCandidate
+    {
+        float DistanceSq;
+        FISMInstanceReference Ref;
+    };
+
+    // Global bounded max-heap: HeapTop() is the current K-th nearest across all components
+    TArray<FNearestCandidate> Heap;
+    Heap.Reserve(Count);
+    auto FartherFirst = [](const FNearestCandidate& A, const FNearestCandidate& B)
+    {
+        return A.DistanceSq > B.DistanceSq;
+    };
+
+    TArray<FISMSpatialNeighbor> Neighbors;
+
+    // Components nearest bounds first, so the heap fills early and distant ones are cut off
+    ComponentBroadphase.Flush();
+    FISMComponentBroadphase::FCandidateArray Candidates;
+    TArray<float, TInlineAllocator<32>> CandidateDistancesSq;
+    ComponentBroadphase.GatherByDistance(Location, MaxDistance, Candidates, CandidateDistancesSq);
+
+    for (int32 CandidateIdx = 0; CandidateIdx < Candidates.Num(); CandidateIdx++)
+    {
+        if (Heap.Num() == Count && CandidateDistancesSq[CandidateIdx] >= Heap.HeapTop().DistanceSq)
+        {
+            break;
+        }
+
+        UISMRuntimeComponent* Comp = Candidates[CandidateIdx];
+        if (!Comp->IsISMQueryable())
         {
             continue;
         }
-        
+
         if (!Filter.PassesComponentFilter(Comp))
         {
             continue;
         }
-        
-        // Query nearby instances
-        float SearchRadius = MaxDistance > 0.0f ? MaxDistance : 5000.0f;
-        TArray<int32> CandidateIndices = Comp->GetInstancesInRadius(Location, SearchRadius, false);
-        
-        for (int32 Index : CandidateIndices)
+
+        // Nothing farther than the current K-th result can make the cut
+        float SearchDistance = MaxDistance;
+        if (Heap.Num() == Count)
         {
-            FISMInstanceReference Ref;
-            Ref.Component = Comp;
-            Ref.InstanceIndex = Index;
-            
-            if (!Filter.PassesFilter(Ref))
+            SearchDistance = FMath::Max(FMath::Sqrt(Heap.HeapTop().DistanceSq), KINDA_SMALL_NUMBER);
+        }
+
+        Comp->FindNearestInstances(Location, Count, SearchDistance, [Comp, &Filter](int32 Index)
             {
-                continue;
-            }
-            
-            float DistSq = FVector::DistSquared(Location, Ref.GetLocation());
-            
-            if (DistSq < NearestDistSq)
+                if (!Comp->IsInstanceActive(Index))
+                {
+                    return false;
+                }
+
+                return Filter.PassesFilter(MakeInstanceReference(Comp, Index));
+            }, Neighbors);
+
+        for (const FISMSpatialNeighbor& Neighbor : Neighbors)
+        {
+            if (Heap.Num() == Count)
             {
-                NearestDistSq = DistSq;
-                NearestRef = Ref;
+                if (Neighbor.DistanceSq >= Heap.HeapTop().DistanceSq)
+                {
+                    // Neighbors are sorted nearest first - the rest are no better
+                    break;
+                }
+                Heap.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
             }
+
+            FNearestCandidate Candidate;
+            Candidate.DistanceSq = Neighbor.DistanceSq;
+            Candidate.Ref = MakeInstanceReference(Comp, Neighbor.InstanceIndex);
+            Heap.HeapPush(Candidate, FartherFirst);
         }
     }
-    
-    return NearestRef;
+
+    Heap.Sort([](const FNearestCandidate& A, const FNearestCandidate& B)
+    {
+        return A.DistanceSq < B.DistanceSq;
+    });
+
+    Results.Reserve(Heap.Num());
+    for (const FNearestCandidate& Candidate : Heap)
+    {
+        Results.Add(Candidate.Ref);
+    }
+
+    return Results;
 }
 
 
@@ -527,45 +1768,235 @@ UISMRuntimeComponent* UISMRuntimeSubsystem::FindComponentForInstance(const FISMI
 }
 
 
-#pragma endregion
+#pragma endregion
+
+
+#pragma region ISM_INSTANCE_STATS
+
+FISMRuntimeStats UISMRuntimeSubsystem::GetRuntimeStats() const
+{
+    // Update stats if stale
+    if (StatsUpdateFrame != GFrameCounter)
+    {
+        const_cast<UISMRuntimeSubsystem*>(this)->UpdateStatistics();
+    }
+    
+    return CachedStats;
+}
+
+void UISMRuntimeSubsystem::UpdateStatistics()
+{
+    // Clean up invalid components first
+    const_cast<UISMRuntimeSubsystem*>(this)->CleanupInvalidComponents();
+    
+    CachedStats.RegisteredComponentCount = 0;
+    CachedStats.TotalInstanceCount = 0;
+    CachedStats.ActiveInstanceCount = 0;
+    CachedStats.DestroyedInstanceCount = 0;
+    CachedStats.SpatialIndexMemoryBytes = 0;
+    CachedStats.SpatialIndexCellCount = 0;
+    CachedStats.InstanceStateMemoryBytes = 0;
+    CachedStats.SpatialIndexHealth.Reset();
+    CachedStats.TotalMemoryBytes = 0;
+    CachedStats.ComponentMemory.Reset();
+    CachedStats.SystemMemory.Reset();
+    
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : AllComponents)
+    {
+        if (UISMRuntimeComponent* Comp = CompPtr.Get())
+        {
+            CachedStats.RegisteredComponentCount++;
+            CachedStats.TotalInstanceCount += Comp->GetInstanceCount();
+            CachedStats.ActiveInstanceCount += Comp->GetActiveInstanceCount();
+            CachedStats.DestroyedInstanceCount += (Comp->GetInstanceCount() - Comp->GetActiveInstanceCount());
+            CachedStats.SpatialIndexMemoryBytes += static_cast<int64>(Comp->GetSpatialIndex().GetAllocatedSize());
+            CachedStats.SpatialIndexCellCount += Comp->GetSpatialIndex().GetCellCount();
+            CachedStats.InstanceStateMemoryBytes += static_cast<int64>(
+                Comp->GetInstanceStateStore().GetAllocatedSize()
+                + Comp->GetInstanceColumns().GetAllocatedSize()
+                + Comp->GetCompactInstanceTags().GetAllocatedSize());
+
+            if (Comp->GetSpatialIndex().GetQueryTelemetry())
+            {
+                CachedStats.SpatialIndexHealth.Add(Comp->GetSpatialIndexHealth());
+            }
+
+            const FISMComponentMemoryStats& Memory = CachedStats.ComponentMemory.Add_GetRef(Comp->GetMemoryStats());
+            CachedStats.TotalMemoryBytes += Memory.TotalBytes;
+        }
+    }
+
+    CachedStats.ComponentMemory.Sort([](const FISMComponentMemoryStats& A, const FISMComponentMemoryStats& B)
+    {
+        return A.TotalBytes > B.TotalBytes;
+    });
+
+    GatherSystemMemoryStats(CachedStats.SystemMemory);
+    for (const FISMMemoryStatEntry& Entry : CachedStats.SystemMemory)
+    {
+        CachedStats.TotalMemoryBytes += Entry.Bytes;
+    }
+    
+    StatsUpdateFrame = GFrameCounter;
+}
+
+void UISMRuntimeSubsystem::GatherSystemMemoryStats(TArray<FISMMemoryStatEntry>& OutEntries) const
+{
+    FISMMemoryStatEntry& Subsystem = OutEntries.AddDefaulted_GetRef();
+    Subsystem.Name = TEXT("RuntimeSubsystem");
+    Subsystem.Count = AllComponents.Num();
+    Subsystem.Bytes = static_cast<int64>(AllComponents.GetAllocatedSize() + LiveComponents.GetAllocatedSize() + ComponentTagIndex.GetAllocatedSize()
+        + InstanceRegistry.GetAllocatedSize() + ComponentBroadphase.GetAllocatedSize()
+        + ISMToRuntimeComponentMap.GetAllocatedSize() + PendingRuntimeComponentCallbacks.GetAllocatedSize()
+        + RedirectEntries.GetAllocatedSize() + RedirectSlotByPrimitive.GetAllocatedSize());
+
+    if (BatchScheduler)
+    {
+        FISMMemoryStatEntry& Scheduler = OutEntries.AddDefaulted_GetRef();
+        Scheduler.Name = TEXT("BatchScheduler");
+        Scheduler.Count = BatchScheduler->GetInFlightChunkCount();
+        Scheduler.Bytes = static_cast<int64>(BatchScheduler->GetAllocatedSize());
+    }
+
+    // Indexes are opt-in actor components the subsystem never sees registered, so find this world's
+    const UWorld* World = GetWorld();
+    FISMMemoryStatEntry Indexes;
+    Indexes.Name = TEXT("InstanceIndexes");
+    for (TObjectIterator<UISMInstanceIndex> It(RF_ClassDefaultObject | RF_ArchetypeObject); It; ++It)
+    {
+        if (It->GetWorld() == World)
+        {
+            Indexes.Bytes += static_cast<int64>(It->GetAllocatedSize());
+            ++Indexes.Count;
+        }
+    }
+    if (Indexes.Count > 0)
+    {
+        OutEntries.Add(MoveTemp(Indexes));
+    }
+
+    const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    if (const UISMCustomDataSubsystem* CustomData = GameInstance ? GameInstance->GetSubsystem<UISMCustomDataSubsystem>() : nullptr)
+    {
+        FISMMemoryStatEntry& Pools = OutEntries.AddDefaulted_GetRef();
+        Pools.Name = TEXT("CustomDataDMIPools");
+        Pools.Count = CustomData->GetNumPooledDMIs();
+        Pools.Bytes = static_cast<int64>(CustomData->GetAllocatedSize());
+    }
+
+    OnGatherMemoryStats.Broadcast(OutEntries);
+}
+
+void UISMRuntimeSubsystem::LogMemoryReport(int32 MaxComponents) const
+{
+    const FISMRuntimeStats Stats = GetRuntimeStats();
+    const auto ToKB = [](int64 Bytes) { return static_cast<double>(Bytes) / 1024.0; };
+
+    UE_LOG(LogISMRuntimeCore, Display, TEXT("ISM memory for %s: %.1f KB total, %d components, %d instances"),
+        *GetNameSafe(GetWorld()), ToKB(Stats.TotalMemoryBytes), Stats.RegisteredComponentCount, Stats.TotalInstanceCount);
+
+    for (const FISMMemoryStatEntry& Entry : Stats.SystemMemory)
+    {
+        UE_LOG(LogISMRuntimeCore, Display, TEXT("  %-24s %10.1f KB  (%d)"), *Entry.Name, ToKB(Entry.Bytes), Entry.Count);
+    }
+
+    UE_LOG(LogISMRuntimeCore, Display, TEXT("  %-48s %9s %10s %10s %10s %10s %10s %10s"),
+        TEXT("Component"), TEXT("Instances"), TEXT("Total KB"), TEXT("State"), TEXT("Tags"), TEXT("Handles"), TEXT("Spatial"), TEXT("Other"));
+
+    const int32 NumToLog = MaxComponents > 0 ? FMath::Min(MaxComponents, Stats.ComponentMemory.Num()) : Stats.ComponentMemory.Num();
+    for (int32 i = 0; i < NumToLog; ++i)
+    {
+        const FISMComponentMemoryStats& Memory = Stats.ComponentMemory[i];
+        const FString Name = Memory.Component
+            ? FString::Printf(TEXT("%s.%s"), *GetNameSafe(Memory.Component->GetOwner()), *Memory.Component->GetName())
+            : FString(TEXT("None"));
+        UE_LOG(LogISMRuntimeCore, Display, TEXT("  %-48s %9d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f"),
+            *Name, Memory.InstanceCount, ToKB(Memory.TotalBytes), ToKB(Memory.InstanceStateBytes), ToKB(Memory.TagBytes),
+            ToKB(Memory.HandleBytes), ToKB(Memory.SpatialIndexBytes), ToKB(Memory.OtherBytes));
+    }
+    if (NumToLog < Stats.ComponentMemory.Num())
+    {
+        UE_LOG(LogISMRuntimeCore, Display, TEXT("  ... %d more components"), Stats.ComponentMemory.Num() - NumToLog);
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GISMMemReportCommand(
+    TEXT("ISM.MemReport"),
+    TEXT("Log ISM Runtime memory for this world: subsystems, indexes, pools and each component, largest first. Optional arg: max components to list."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+    {
+        UISMRuntimeSubsystem* Subsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+        if (!Subsystem)
+        {
+            UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISM.MemReport: no ISM runtime subsystem in this world"));
+            return;
+        }
+        Subsystem->LogMemoryReport(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0);
+    }));
+
+void UISMRuntimeSubsystem::LogOpReport(int32 MaxComponents, int32 MaxHotInstances) const
+{
+    TArray<FISMComponentOpStats> AllStats;
+    AllStats.Reserve(AllComponents.Num());
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& WeakComp : AllComponents)
+    {
+        if (const UISMRuntimeComponent* Comp = WeakComp.Get())
+        {
+            AllStats.Add(Comp->GetOpStats(MaxHotInstances));
+        }
+    }
+    AllStats.Sort([](const FISMComponentOpStats& A, const FISMComponentOpStats& B)
+    {
+        return A.GetTotalRate() > B.GetTotalRate();
+    });
 
+    UE_LOG(LogISMRuntimeCore, Display, TEXT("ISM operations for %s: %d components (totals, /s over the last window)"),
+        *GetNameSafe(GetWorld()), AllStats.Num());
+    UE_LOG(LogISMRuntimeCore, Display, TEXT("  %-48s %18s %18s %18s %18s %18s %18s"),
+        TEXT("Component"), TEXT("Add"), TEXT("Destroy"), TEXT("Transform"), TEXT("CustomData"), TEXT("Query"), TEXT("Delegate"));
 
-#pragma region ISM_INSTANCE_STATS
+    const int32 NumToLog = MaxComponents > 0 ? FMath::Min(MaxComponents, AllStats.Num()) : AllStats.Num();
+    for (int32 i = 0; i < NumToLog; ++i)
+    {
+        const FISMComponentOpStats& Stats = AllStats[i];
+        const FString Name = FString::Printf(TEXT("%s.%s"), *GetNameSafe(Stats.Component->GetOwner()), *Stats.Component->GetName());
 
-FISMRuntimeStats UISMRuntimeSubsystem::GetRuntimeStats() const
-{
-    // Update stats if stale
-    if (StatsUpdateFrame != GFrameCounter)
+        FString Columns;
+        for (int32 Op = 0; Op < FISMComponentOpCounters::NumOps; ++Op)
+        {
+            Columns += FString::Printf(TEXT(" %10lld %7.1f"), Stats.Totals[Op], Stats.RatesPerSecond[Op]);
+        }
+        UE_LOG(LogISMRuntimeCore, Display, TEXT("  %-48s%s"), *Name, *Columns);
+
+        if (Stats.HotInstances.Num() > 0)
+        {
+            FString Hot;
+            for (const FISMHotInstanceSample& Sample : Stats.HotInstances)
+            {
+                Hot += FString::Printf(TEXT(" %d(%d)"), Sample.InstanceIndex, Sample.Mutations);
+            }
+            UE_LOG(LogISMRuntimeCore, Display, TEXT("    hot instances:%s"), *Hot);
+        }
+    }
+    if (NumToLog < AllStats.Num())
     {
-        const_cast<UISMRuntimeSubsystem*>(this)->UpdateStatistics();
+        UE_LOG(LogISMRuntimeCore, Display, TEXT("  ... %d more components"), AllStats.Num() - NumToLog);
     }
-    
-    return CachedStats;
 }
 
-void UISMRuntimeSubsystem::UpdateStatistics()
-{
-    // Clean up invalid components first
-    const_cast<UISMRuntimeSubsystem*>(this)->CleanupInvalidComponents();
-    
-    CachedStats.RegisteredComponentCount = 0;
-    CachedStats.TotalInstanceCount = 0;
-    CachedStats.ActiveInstanceCount = 0;
-    CachedStats.DestroyedInstanceCount = 0;
-    
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : AllComponents)
+static FAutoConsoleCommandWithWorldAndArgs GISMOpReportCommand(
+    TEXT("ISM.OpReport"),
+    TEXT("Log per-component operation counts and rates for this world, busiest first. Optional args: max components, max hot instances each. Rates cover the window since the previous report."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
     {
-        if (UISMRuntimeComponent* Comp = CompPtr.Get())
+        UISMRuntimeSubsystem* Subsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+        if (!Subsystem)
         {
-            CachedStats.RegisteredComponentCount++;
-            CachedStats.TotalInstanceCount += Comp->GetInstanceCount();
-            CachedStats.ActiveInstanceCount += Comp->GetActiveInstanceCount();
-            CachedStats.DestroyedInstanceCount += (Comp->GetInstanceCount() - Comp->GetActiveInstanceCount());
+            UE_LOG(LogISMRuntimeCore, Warning, TEXT("ISM.OpReport: no ISM runtime subsystem in this world"));
+            return;
         }
-    }
-    
-    StatsUpdateFrame = GFrameCounter;
-}
+        Subsystem->LogOpReport(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 4);
+    }));
 
 UISMRuntimeComponent* UISMRuntimeSubsystem::FindComponentForISM(TWeakObjectPtr<UInstancedStaticMeshComponent> ISM) const
 {
@@ -587,50 +2018,46 @@ UISMRuntimeComponent* UISMRuntimeSubsystem::FindComponentForISM(TWeakObjectPtr<U
 
 void UISMRuntimeSubsystem::CleanupInvalidComponents()
 {
-    // Remove invalid component references
-    AllComponents.RemoveAll([](const TWeakObjectPtr<UISMRuntimeComponent>& Comp)
+    // Remove invalid component references, then renumber the survivors
+    const int32 NumRemoved = AllComponents.RemoveAll([](const TWeakObjectPtr<UISMRuntimeComponent>& Comp)
     {
         return !Comp.IsValid();
     });
-    
-    // Clean up tag index
-    for (auto& Pair : ComponentsByTag)
+    if (NumRemoved > 0)
     {
-        Pair.Value.RemoveAll([](const TWeakObjectPtr<UISMRuntimeComponent>& Comp)
+        for (int32 i = 0; i < AllComponents.Num(); ++i)
         {
-            return !Comp.IsValid();
-        });
+            AllComponents[i]->RegisteredComponentIndex = i;
+        }
+        bLiveComponentsDirty = true;
     }
-}
+    ComponentBroadphase.RemoveStaleEntries();
 
-void UISMRuntimeSubsystem::RebuildTagIndexForComponent(UISMRuntimeComponent* Component)
-{
-    if (!Component)
-    {
-        return;
-    }
-    
-    // Add component to tag index for all its tags
-    for (const FGameplayTag& Tag : Component->ISMComponentTags)
+    // ISMs or components collected since they registered; a stale entry would also block the
+    // ISM's next registration
+    for (auto It = ISMToRuntimeComponentMap.CreateIterator(); It; ++It)
     {
-        TArray<TWeakObjectPtr<UISMRuntimeComponent>>& Components = ComponentsByTag.FindOrAdd(Tag);
-        
-        // Only add if not already present
-        bool bAlreadyIndexed = false;
-        for (const TWeakObjectPtr<UISMRuntimeComponent>& ExistingComp : Components)
-        {
-            if (ExistingComp.Get() == Component)
-            {
-                bAlreadyIndexed = true;
-                break;
-            }
-        }
-        
-        if (!bAlreadyIndexed)
+        if (!It.Key().IsValid() || !It.Value().IsValid())
         {
-            Components.Add(Component);
+            It.RemoveCurrent();
         }
     }
+    
+    // Clean up tag index
+    ComponentTagIndex.RemoveStaleEntries();
+    InstanceRegistry.RemoveStaleEntries();
+}
+
+void UISMRuntimeSubsystem::HandlePostGarbageCollect()
+{
+    // Raw pointers in the live view may now dangle even where no weak entry went stale
+    bLiveComponentsDirty = true;
+    CleanupInvalidComponents();
+}
+
+void UISMRuntimeSubsystem::RebuildTagIndexForComponent(UISMRuntimeComponent* Component)
+{
+    ComponentTagIndex.Add(Component);
 }
 #pragma endregion
 
@@ -669,16 +2096,34 @@ void UISMRuntimeSubsystem::RegisterComponentRedirect(
         return;
     }
 
-    TArray<TWeakObjectPtr<UISMRuntimeComponent>>& Entry =
-        ComponentRedirectMap.FindOrAdd(PhysicsComponent);
+    // Drop slots hits found stale before adding more
+    CleanupRedirectMap();
+
+    int32 Slot = INDEX_NONE;
+    if (!FindRedirectEntry(PhysicsComponent, Slot))
+    {
+        if (Slot != INDEX_NONE)
+        {
+            // Entry left behind by an earlier registration of this primitive
+            RemoveRedirectSlot(Slot);
+        }
+
+        FISMRedirectEntry NewEntry;
+        NewEntry.Source = PhysicsComponent;
+        NewEntry.SourceKey = TObjectKey<UPrimitiveComponent>(PhysicsComponent);
+        Slot = RedirectEntries.Add(MoveTemp(NewEntry));
+        RedirectSlotByPrimitive.Add(TObjectKey<UPrimitiveComponent>(PhysicsComponent), Slot);
+    }
+
+    FISMRedirectEntry* Entry = &RedirectEntries[Slot];
 
     // Avoid duplicates
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& Existing : Entry)
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& Existing : Entry->Targets)
     {
         if (Existing.Get() == ISMComponent) return;
     }
 
-    Entry.Add(ISMComponent);
+    Entry->Targets.Add(ISMComponent);
 
     UE_LOG(LogISMTrace, Verbose,
         TEXT("RegisterComponentRedirect: %s → %s"),
@@ -691,19 +2136,18 @@ void UISMRuntimeSubsystem::UnregisterComponentRedirect(
 {
     if (!PhysicsComponent || !ISMComponent) return;
 
-    TArray<TWeakObjectPtr<UISMRuntimeComponent>>* Entry =
-        ComponentRedirectMap.Find(PhysicsComponent);
+    int32 Slot = INDEX_NONE;
+    if (!FindRedirectEntry(PhysicsComponent, Slot)) return;
 
-    if (!Entry) return;
-
-    Entry->RemoveAll([ISMComponent](const TWeakObjectPtr<UISMRuntimeComponent>& Ptr)
+    FISMRedirectEntry& Entry = RedirectEntries[Slot];
+    Entry.Targets.RemoveAll([ISMComponent](const TWeakObjectPtr<UISMRuntimeComponent>& Ptr)
         {
             return Ptr.Get() == ISMComponent;
         });
 
-    if (Entry->IsEmpty())
+    if (Entry.Targets.IsEmpty())
     {
-        ComponentRedirectMap.Remove(PhysicsComponent);
+        RemoveRedirectSlot(Slot);
     }
 }
 
@@ -711,38 +2155,93 @@ void UISMRuntimeSubsystem::UnregisterAllRedirectsForComponent(
     UPrimitiveComponent* PhysicsComponent)
 {
     if (!PhysicsComponent) return;
-    ComponentRedirectMap.Remove(PhysicsComponent);
+
+    int32 Slot = INDEX_NONE;
+    if (FindRedirectEntry(PhysicsComponent, Slot))
+    {
+        RemoveRedirectSlot(Slot);
+    }
+}
+
+const UISMRuntimeSubsystem::FISMRedirectEntry* UISMRuntimeSubsystem::FindRedirectEntry(
+    const UPrimitiveComponent* Primitive,
+    int32& OutSlot) const
+{
+    OutSlot = INDEX_NONE;
+    const int32* Slot = RedirectSlotByPrimitive.Find(TObjectKey<UPrimitiveComponent>(Primitive));
+    if (!Slot)
+    {
+        return nullptr;
+    }
+
+    // The key matched, but the entry's weak pointer may not resolve during teardown
+    OutSlot = *Slot;
+    const FISMRedirectEntry& Entry = RedirectEntries[OutSlot];
+    if (Entry.Source.Get() != Primitive)
+    {
+        MarkRedirectStale(OutSlot);
+        return nullptr;
+    }
+
+    return &Entry;
+}
+
+void UISMRuntimeSubsystem::MarkRedirectStale(int32 Slot) const
+{
+    if (StaleRedirects)
+    {
+        FScopeLock Lock(&StaleRedirects->Lock);
+        StaleRedirects->Slots.AddUnique(Slot);
+    }
+}
+
+void UISMRuntimeSubsystem::RemoveRedirectSlot(int32 Slot)
+{
+    if (!RedirectEntries.IsValidIndex(Slot))
+    {
+        return;
+    }
+
+    // Through the stored key - Source may already be dead
+    const TObjectKey<UPrimitiveComponent> SourceKey = RedirectEntries[Slot].SourceKey;
+    const int32* Mapped = RedirectSlotByPrimitive.Find(SourceKey);
+    if (Mapped && *Mapped == Slot)
+    {
+        RedirectSlotByPrimitive.Remove(SourceKey);
+    }
+    RedirectEntries.RemoveAt(Slot);
 }
 
 void UISMRuntimeSubsystem::CleanupRedirectMap()
 {
-    // Remove entries where the proxy component has been destroyed
-    for (auto It = ComponentRedirectMap.CreateIterator(); It; ++It)
+    if (!StaleRedirects)
+    {
+        return;
+    }
+
+    TArray<int32> Slots;
+    {
+        FScopeLock Lock(&StaleRedirects->Lock);
+        Slots = MoveTemp(StaleRedirects->Slots);
+        StaleRedirects->Slots.Reset();
+    }
+
+    for (int32 Slot : Slots)
     {
-        if (!It.Key().IsValid())
+        if (!RedirectEntries.IsValidIndex(Slot))
         {
-            It.RemoveCurrent();
             continue;
         }
 
-        // Remove stale ISM component refs within each entry
-        It.Value().RemoveAll([](const TWeakObjectPtr<UISMRuntimeComponent>& Ptr)
+        FISMRedirectEntry& Entry = RedirectEntries[Slot];
+        Entry.Targets.RemoveAll([](const TWeakObjectPtr<UISMRuntimeComponent>& Ptr)
             {
                 return !Ptr.IsValid();
             });
 
-        if (It.Value().IsEmpty())
-        {
-            It.RemoveCurrent();
-        }
-    }
-
-    // Remove stale entries from ISMToRuntimeMap
-    for (auto It = ISMToRuntimeComponentMap.CreateIterator(); It; ++It)
-    {
-        if (!It.Key().IsValid() || !It.Value().IsValid())
+        if (!Entry.Source.IsValid() || Entry.Targets.IsEmpty())
         {
-            It.RemoveCurrent();
+            RemoveRedirectSlot(Slot);
         }
     }
 }
@@ -760,7 +2259,9 @@ void UISMRuntimeSubsystem::InitializeBatchScheduler()
     }
     bBatchSchedulerInitialized = true;
     const UISMRuntimeSettings* Settings = GetDefault<UISMRuntimeSettings>();
-    bool useAsyncScheduler = Settings ? Settings->bUseAsyncBatchScheduler : false;
+    const FISMPerformanceProfileSettings& Profile = FISMPerformanceProfiles::GetActive();
+    bool useAsyncScheduler = Profile.bOverride_UseAsyncBatchScheduler ? Profile.bUseAsyncBatchScheduler
+        : (Settings ? Settings->bUseAsyncBatchScheduler : false);
     if (useAsyncScheduler)
     {
         BatchScheduler = NewObject<UISMBatchScheduler>(this);
@@ -780,6 +2281,25 @@ FISMTraceResult UISMRuntimeSubsystem::ResolveHitToISMHandle(
     const FHitResult& Hit,
     const FISMQueryFilter& Filter,
     float RedirectSearchRadius) const
+{
+    FISMTraceResult Result = ResolveHitCandidate(Hit, Filter, RedirectSearchRadius);
+    RegisterTraceHandle(Result);
+    return Result;
+}
+
+void UISMRuntimeSubsystem::RegisterTraceHandle(FISMTraceResult& Result)
+{
+    if (UISMRuntimeComponent* Comp = Result.Handle.Component.Get())
+    {
+        // Registered handle, so converted instances report their actor
+        Result.Handle = Comp->GetInstanceHandle(Result.Handle.InstanceIndex);
+    }
+}
+
+FISMTraceResult UISMRuntimeSubsystem::ResolveHitCandidate(
+    const FHitResult& Hit,
+    const FISMQueryFilter& Filter,
+    float RedirectSearchRadius) const
 {
     FISMTraceResult Result;
     Result.PhysicsHit = Hit;
@@ -815,7 +2335,10 @@ FISMTraceResult UISMRuntimeSubsystem::ResolveHitToISMHandle(
             return Result;
         }
 
-        FISMInstanceHandle Candidate = OwningRuntime->GetInstanceHandle(Hit.Item);
+        FISMInstanceReference Candidate;
+        Candidate.Component = OwningRuntime;
+        Candidate.InstanceIndex = Hit.Item;
+        Candidate.Generation = static_cast<int32>(OwningRuntime->GetInstanceGeneration(Hit.Item));
         if (!Candidate.IsValid())
         {
             return Result;
@@ -840,10 +2363,10 @@ FISMTraceResult UISMRuntimeSubsystem::ResolveHitToISMHandle(
 
     if (!HitPrimitive) return Result;
 
-    const TArray<TWeakObjectPtr<UISMRuntimeComponent>>* RedirectTargets =
-        ComponentRedirectMap.Find(TWeakObjectPtr<UPrimitiveComponent>(HitPrimitive));
+    int32 RedirectSlot = INDEX_NONE;
+    const FISMRedirectEntry* Redirect = FindRedirectEntry(HitPrimitive, RedirectSlot);
 
-    if (!RedirectTargets || RedirectTargets->IsEmpty())
+    if (!Redirect || Redirect->Targets.IsEmpty())
     {
         UE_LOG(LogISMTrace, Verbose,
             TEXT("ResolveHit: hit %s — no redirect registered"),
@@ -851,12 +2374,12 @@ FISMTraceResult UISMRuntimeSubsystem::ResolveHitToISMHandle(
         return Result;
     }
 
-    return ResolveRedirectHit(Hit, *RedirectTargets, Filter, RedirectSearchRadius);
+    return ResolveRedirectHit(Hit, RedirectSlot, Filter, RedirectSearchRadius);
 }
 
 FISMTraceResult UISMRuntimeSubsystem::ResolveRedirectHit(
     const FHitResult& Hit,
-    const TArray<TWeakObjectPtr<UISMRuntimeComponent>>& Candidates,
+    int32 RedirectSlot,
     const FISMQueryFilter& Filter,
     float RedirectSearchRadius) const
 {
@@ -867,10 +2390,15 @@ FISMTraceResult UISMRuntimeSubsystem::ResolveRedirectHit(
     const FVector ImpactPoint = Hit.ImpactPoint;
     float BestDistSq = FLT_MAX;
 
-    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : Candidates)
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& CompPtr : RedirectEntries[RedirectSlot].Targets)
     {
         UISMRuntimeComponent* Comp = CompPtr.Get();
-        if (!Comp) continue;
+        if (!Comp)
+        {
+            // Destroyed target - drop it next cleanup
+            MarkRedirectStale(RedirectSlot);
+            continue;
+        }
 
         if (!Filter.PassesComponentFilter(Comp)) continue;
 
@@ -892,7 +2420,10 @@ FISMTraceResult UISMRuntimeSubsystem::ResolveRedirectHit(
 
         for (int32 InstanceIndex : NearbyInstances)
         {
-            FISMInstanceHandle Candidate = Comp->GetInstanceHandle(InstanceIndex);
+            FISMInstanceReference Candidate;
+            Candidate.Component = Comp;
+            Candidate.InstanceIndex = InstanceIndex;
+            Candidate.Generation = static_cast<int32>(Comp->GetInstanceGeneration(InstanceIndex));
             if (!Candidate.IsValid()) continue;
             if (!Filter.PassesFilter(Candidate)) continue;
 
@@ -971,14 +2502,46 @@ bool UISMRuntimeSubsystem::LineTraceISMMulti(
         return false;
     }
 
+    ResolveHitsSorted(Hits, Filter, RedirectSearchRadius, OutResults);
+    return !OutResults.IsEmpty();
+}
+
+void UISMRuntimeSubsystem::ResolveHitsSorted(
+    const TArray<FHitResult>& Hits,
+    const FISMQueryFilter& Filter,
+    float RedirectSearchRadius,
+    TArray<FISMTraceResult>& OutResults) const
+{
     OutResults.Reset();
 
-    for (const FHitResult& Hit : Hits)
+    if (ShouldRunParallel(Filter, Hits.Num()))
+    {
+        // Resolution is read-only; handles are registered back on this thread
+        TArray<FISMTraceResult> Resolved;
+        Resolved.SetNum(Hits.Num());
+        ParallelFor(Hits.Num(), [this, &Hits, &Resolved, &Filter, RedirectSearchRadius](int32 HitIdx)
+            {
+                Resolved[HitIdx] = ResolveHitCandidate(Hits[HitIdx], Filter, RedirectSearchRadius);
+            });
+
+        for (FISMTraceResult& Result : Resolved)
+        {
+            RegisterTraceHandle(Result);
+            if (Result.IsValid())
+            {
+                OutResults.Add(MoveTemp(Result));
+            }
+        }
+    }
+    else
     {
-        FISMTraceResult Resolved = ResolveHitToISMHandle(Hit, Filter, RedirectSearchRadius);
-        if (Resolved.IsValid())
+        for (const FHitResult& Hit : Hits)
         {
-            OutResults.Add(Resolved);
+            FISMTraceResult Resolved = ResolveHitToISMHandle(Hit, Filter, RedirectSearchRadius);
+            if (Resolved.IsValid())
+            {
+                OutResults.Add(Resolved);
+            }
         }
     }
 
@@ -987,8 +2550,6 @@ bool UISMRuntimeSubsystem::LineTraceISMMulti(
         {
             return A.InstanceDistance < B.InstanceDistance;
         });
-
-    return !OutResults.IsEmpty();
 }
 
 // ============================================================
@@ -1021,6 +2582,196 @@ bool UISMRuntimeSubsystem::SweepISM(
     return OutResult.IsValid();
 }
 
+// ============================================================
+//  Async traces
+// ============================================================
+
+FTraceHandle UISMRuntimeSubsystem::AsyncLineTraceISM(
+    const FVector& Start,
+    const FVector& End,
+    ECollisionChannel TraceChannel,
+    const FISMQueryFilter& Filter,
+    float RedirectSearchRadius,
+    TFunction<void(const TArray<FISMTraceResult>&)> OnComplete,
+    bool bMultiTrace,
+    const FCollisionQueryParams& Params)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("AsyncLineTraceISM: no world"));
+        return FTraceHandle();
+    }
+
+    const FTraceDelegate Delegate = FTraceDelegate::CreateUObject(
+        this, &UISMRuntimeSubsystem::HandleAsyncTraceDone, Filter, RedirectSearchRadius, MoveTemp(OnComplete));
+
+    return World->AsyncLineTraceByChannel(
+        bMultiTrace ? EAsyncTraceType::Multi : EAsyncTraceType::Single,
+        Start, End, TraceChannel, Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+}
+
+FTraceHandle UISMRuntimeSubsystem::AsyncSweepISM(
+    const FVector& Start,
+    const FVector& End,
+    float SweepRadius,
+    ECollisionChannel TraceChannel,
+    const FISMQueryFilter& Filter,
+    float RedirectSearchRadius,
+    TFunction<void(const TArray<FISMTraceResult>&)> OnComplete,
+    bool bMultiTrace,
+    const FCollisionQueryParams& Params)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        UE_LOG(LogISMRuntimeCore, Warning, TEXT("AsyncSweepISM: no world"));
+        return FTraceHandle();
+    }
+
+    const FTraceDelegate Delegate = FTraceDelegate::CreateUObject(
+        this, &UISMRuntimeSubsystem::HandleAsyncTraceDone, Filter, RedirectSearchRadius, MoveTemp(OnComplete));
+
+    return World->AsyncSweepByChannel(
+        bMultiTrace ? EAsyncTraceType::Multi : EAsyncTraceType::Single,
+        Start, End, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius),
+        Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+}
+
+void UISMRuntimeSubsystem::HandleAsyncTraceDone(
+    const FTraceHandle& TraceHandle,
+    FTraceDatum& TraceDatum,
+    FISMQueryFilter Filter,
+    float RedirectSearchRadius,
+    TFunction<void(const TArray<FISMTraceResult>&)> OnComplete)
+{
+    // Delivered on the game thread, so hits resolve against current instance state
+    TArray<FISMTraceResult> Results;
+    ResolveHitsSorted(TraceDatum.OutHits, Filter, RedirectSearchRadius, Results);
+
+    if (OnComplete)
+    {
+        OnComplete(Results);
+    }
+}
+
+// ============================================================
+//  GridTraceISM
+// ============================================================
+
+bool UISMRuntimeSubsystem::GridTraceISM(
+    const FVector& Start,
+    const FVector& End,
+    float Radius,
+    TArray<FISMTraceResult>& OutResults,
+    const FISMQueryFilter& Filter,
+    bool bFirstHitOnly,
+    bool bTestOrientedBounds) const
+{
+    OutResults.Reset();
+
+    const FVector Delta = End - Start;
+    const float Length = static_cast<float>(Delta.Size());
+    if (Length <= KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+    const FVector Dir = Delta / Length;
+
+    // Shortened to the best hit so far when only the first hit matters
+    FVector TraceEnd = End;
+    TArray<FISMSpatialRayHit> Hits;
+    TMap<int32, FVector> HitNormals;
+
+    FBox SweptBounds(ForceInit);
+    SweptBounds += Start;
+    SweptBounds += End;
+
+    const FISMCompiledQueryFilter Compiled = Filter.Compile();
+    ForEachQueryComponent(SweptBounds.ExpandBy(Radius), Filter, [&](UISMRuntimeComponent* Comp)
+    {
+        if (!Comp->IsISMQueryable())
+        {
+            return true;
+        }
+
+        const FISMCompiledComponentFilter Bound = Compiled.BindComponent(Comp);
+        if (!Bound.bPasses)
+        {
+            return true;
+        }
+
+        const float TraceLength = static_cast<float>(FVector::Dist(Start, TraceEnd));
+        HitNormals.Reset();
+        Comp->TraceInstancesRefined(Start, TraceEnd, Radius, bFirstHitOnly, [&](int32 Index, float& InOutDistance)
+            {
+                if (!Comp->IsInstanceActive(Index) || !Compiled.PassesInstance(Bound, Index))
+                {
+                    return false;
+                }
+
+                if (!bTestOrientedBounds)
+                {
+                    return true;
+                }
+
+                // Narrow phase: the oriented mesh box can only start at or after the AABB entry
+                float BoxDistance = 0.0f;
+                FVector Normal = -Dir;
+                if (!Comp->IntersectInstanceOrientedBounds(Index, Start, Dir, TraceLength, Radius, BoxDistance, Normal))
+                {
+                    return false;
+                }
+                InOutDistance = FMath::Max(InOutDistance, BoxDistance);
+                HitNormals.Add(Index, Normal);
+                return true;
+            }, Hits);
+
+        for (const FISMSpatialRayHit& Hit : Hits)
+        {
+            FISMTraceResult& Result = bFirstHitOnly && OutResults.Num() > 0 ? OutResults[0] : OutResults.AddDefaulted_GetRef();
+            Result = FISMTraceResult();
+            Result.Handle = MakeInstanceReference(Comp, Hit.InstanceIndex);
+            Result.ResolveMethod = EISMTraceResolveMethod::SpatialGrid;
+            Result.InstanceDistance = Hit.Distance;
+
+            const FVector* Normal = HitNormals.Find(Hit.InstanceIndex);
+            FHitResult& PhysicsHit = Result.PhysicsHit;
+            PhysicsHit.bBlockingHit = true;
+            PhysicsHit.TraceStart = Start;
+            PhysicsHit.TraceEnd = End;
+            PhysicsHit.Distance = Hit.Distance;
+            PhysicsHit.Time = Hit.Distance / Length;
+            PhysicsHit.Location = Start + Dir * Hit.Distance;
+            PhysicsHit.ImpactPoint = Normal ? PhysicsHit.Location - *Normal * Radius : PhysicsHit.Location;
+            PhysicsHit.Normal = Normal ? *Normal : -Dir;
+            PhysicsHit.ImpactNormal = PhysicsHit.Normal;
+            PhysicsHit.Item = Hit.InstanceIndex;
+            PhysicsHit.Component = Comp->ManagedISMComponent;
+
+            if (bFirstHitOnly)
+            {
+                // Later components only need to search up to here
+                TraceEnd = PhysicsHit.Location;
+            }
+        }
+        return true;
+    });
+
+    OutResults.Sort([](const FISMTraceResult& A, const FISMTraceResult& B)
+        {
+            return A.InstanceDistance < B.InstanceDistance;
+        });
+
+    // Handles are registered only for the hits that are returned
+    for (FISMTraceResult& Result : OutResults)
+    {
+        RegisterTraceHandle(Result);
+    }
+
+    return !OutResults.IsEmpty();
+}
+
 bool UISMRuntimeSubsystem::LineTraceISM(const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, FISMTraceResult& OutResult, const FISMQueryFilter& Filter, float RedirectSearchRadius) const
 {
     return LineTraceISM(Start, End, TraceChannel, OutResult, Filter, FCollisionQueryParams::DefaultQueryParam, RedirectSearchRadius);
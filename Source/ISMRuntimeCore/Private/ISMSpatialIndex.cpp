@@ -4,9 +4,11 @@
 // ISMSpatialIndex.cpp
 #include "ISMSpatialIndex.h"
 #include "DrawDebugHelpers.h"
+#include "Algo/BinarySearch.h"
 
-FISMSpatialIndex::FISMSpatialIndex(float InCellSize)
+FISMSpatialIndex::FISMSpatialIndex(float InCellSize, EISMSpatialIndexStorage InStorage)
     : CellSize(InCellSize)
+    , Storage(InStorage)
 {
     ensure(CellSize > 0.0f);
 
@@ -14,185 +16,2526 @@ FISMSpatialIndex::FISMSpatialIndex(float InCellSize)
     Cells.Reserve(64);
 }
 
+template<typename VisitorType>
+void FISMSpatialIndex::ForEachCellInRange(const FIntVector& MinCell, const FIntVector& MaxCell, VisitorType&& Visitor) const
+{
+    if (Storage == EISMSpatialIndexStorage::Flat && FlatCellKeys.Num() > 0)
+    {
+        // Keys are sorted X,Y,Z so each (X,Y) column is one contiguous run:
+        // one binary search per column, then a linear walk along Z.
+        for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+            {
+                int32 Pos = Algo::LowerBound(FlatCellKeys, FIntVector(X, Y, MinCell.Z), &FISMSpatialIndex::CellKeyLess);
+
+                while (Pos < FlatCellKeys.Num())
+                {
+                    const FIntVector& Key = FlatCellKeys[Pos];
+                    if (Key.X != X || Key.Y != Y || Key.Z > MaxCell.Z)
+                    {
+                        break;
+                    }
+
+                    const int32 Start = FlatCellOffsets[Pos];
+                    const int32 Count = FlatCellOffsets[Pos + 1] - Start;
+                    Visitor(Key, TArrayView<const int32>(FlatInstances.GetData() + Start, Count));
+                    Pos++;
+                }
+            }
+        }
+    }
+
+    // Hashed cells (primary store in Hashed mode, overlay in Flat mode)
+    ForEachHashedCellInRange(Cells, MinCell, MaxCell, Visitor);
+}
+
+template<typename VisitorType>
+void FISMSpatialIndex::ForEachHashedCellInRange(const TMap<FIntVector, TArray<int32>>& InCells, const FIntVector& MinCell, const FIntVector& MaxCell, VisitorType&& Visitor)
+{
+    if (InCells.Num() == 0)
+    {
+        return;
+    }
+
+    // When the map holds fewer cells than the query range spans, scanning
+    // the map directly beats probing every coordinate in the range.
+    const int64 RangeCells =
+        int64(MaxCell.X - MinCell.X + 1) *
+        int64(MaxCell.Y - MinCell.Y + 1) *
+        int64(MaxCell.Z - MinCell.Z + 1);
+
+    if (RangeCells > InCells.Num())
+    {
+        for (const auto& Pair : InCells)
+        {
+            const FIntVector& Key = Pair.Key;
+            if (Key.X >= MinCell.X && Key.X <= MaxCell.X &&
+                Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y &&
+                Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+            {
+                Visitor(Key, TArrayView<const int32>(Pair.Value));
+            }
+        }
+        return;
+    }
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+            {
+                const FIntVector CellCoord(X, Y, Z);
+                if (const TArray<int32>* Cell = InCells.Find(CellCoord))
+                {
+                    Visitor(CellCoord, TArrayView<const int32>(*Cell));
+                }
+            }
+        }
+    }
+}
+
+template<typename VisitorType>
+void FISMSpatialIndex::ForEachCellOverlapping(const FVector& Min, const FVector& Max, VisitorType&& Visitor) const
+{
+    const float HalfExtent = static_cast<float>((Max - Min).GetMax() * 0.5);
+    const int32 Level = SelectQueryLevel(HalfExtent);
+
+    if (Level == INDEX_NONE)
+    {
+        ForEachCellInRange(WorldLocationToCell(Min), WorldLocationToCell(Max), Visitor);
+        return;
+    }
+
+    const FISMSpatialGridLevel& GridLevel = CoarseLevels[Level];
+    ForEachHashedCellInRange(GridLevel.Cells,
+        LocationToCell(Min, GridLevel.CellSize),
+        LocationToCell(Max, GridLevel.CellSize),
+        Visitor);
+}
+
+template<typename VisitorType>
+void FISMSpatialIndex::ForEachCellInRing(const FIntVector& C, int32 Ring, VisitorType&& Visitor) const
+{
+    if (Ring == 0)
+    {
+        ForEachCellInRange(C, C, Visitor);
+        return;
+    }
+
+    const int32 R = Ring;
+
+    // Six non-overlapping slabs: full Z caps, then Y walls without the caps, then X walls without either
+    ForEachCellInRange(FIntVector(C.X - R, C.Y - R, C.Z - R), FIntVector(C.X + R, C.Y + R, C.Z - R), Visitor);
+    ForEachCellInRange(FIntVector(C.X - R, C.Y - R, C.Z + R), FIntVector(C.X + R, C.Y + R, C.Z + R), Visitor);
+    ForEachCellInRange(FIntVector(C.X - R, C.Y - R, C.Z - R + 1), FIntVector(C.X + R, C.Y - R, C.Z + R - 1), Visitor);
+    ForEachCellInRange(FIntVector(C.X - R, C.Y + R, C.Z - R + 1), FIntVector(C.X + R, C.Y + R, C.Z + R - 1), Visitor);
+    ForEachCellInRange(FIntVector(C.X - R, C.Y - R + 1, C.Z - R + 1), FIntVector(C.X - R, C.Y + R - 1, C.Z + R - 1), Visitor);
+    ForEachCellInRange(FIntVector(C.X + R, C.Y - R + 1, C.Z - R + 1), FIntVector(C.X + R, C.Y + R - 1, C.Z + R - 1), Visitor);
+}
+
+template<typename SinkType>
+bool FISMSpatialIndex::VisitCellInstancesInSphere(TArrayView<const int32> CellInstances, const FVector3f& Center, float RadiusSq, SinkType&& Sink) const
+{
+    const int32 Num = CellInstances.Num();
+    const int32 NumPositions = PositionsX.Num();
+    const float* RESTRICT PX = PositionsX.GetData();
+    const float* RESTRICT PY = PositionsY.GetData();
+    const float* RESTRICT PZ = PositionsZ.GetData();
+
+    const VectorRegister4Float CX = VectorSetFloat1(Center.X);
+    const VectorRegister4Float CY = VectorSetFloat1(Center.Y);
+    const VectorRegister4Float CZ = VectorSetFloat1(Center.Z);
+    const VectorRegister4Float R2 = VectorSetFloat1(RadiusSq);
+
+    int32 i = 0;
+
+    // 4 instances per iteration. Tombstones and unknown slots get MAX_flt
+    // coordinates, which square to +inf and always fail the test.
+    for (; i + 4 <= Num; i += 4)
+    {
+        alignas(16) float X[4];
+        alignas(16) float Y[4];
+        alignas(16) float Z[4];
+
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            const int32 Idx = CellInstances[i + Lane];
+            const bool bValid = Idx >= 0 && Idx < NumPositions;
+            X[Lane] = bValid ? PX[Idx] : MAX_flt;
+            Y[Lane] = bValid ? PY[Idx] : MAX_flt;
+            Z[Lane] = bValid ? PZ[Idx] : MAX_flt;
+        }
+
+        const VectorRegister4Float DX = VectorSubtract(VectorLoadAligned(X), CX);
+        const VectorRegister4Float DY = VectorSubtract(VectorLoadAligned(Y), CY);
+        const VectorRegister4Float DZ = VectorSubtract(VectorLoadAligned(Z), CZ);
+
+        VectorRegister4Float DistSq = VectorMultiply(DX, DX);
+        DistSq = VectorMultiplyAdd(DY, DY, DistSq);
+        DistSq = VectorMultiplyAdd(DZ, DZ, DistSq);
+
+        const int32 Mask = VectorMaskBits(VectorCompareLE(DistSq, R2));
+        if (Mask == 0)
+        {
+            continue;
+        }
+
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            if (Mask & (1 << Lane))
+            {
+                if (!Sink(CellInstances[i + Lane]))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Scalar tail
+    for (; i < Num; i++)
+    {
+        const int32 Idx = CellInstances[i];
+        if (Idx < 0 || Idx >= NumPositions)
+        {
+            continue;
+        }
+
+        const float DX = PX[Idx] - Center.X;
+        const float DY = PY[Idx] - Center.Y;
+        const float DZ = PZ[Idx] - Center.Z;
+        if (DX * DX + DY * DY + DZ * DZ <= RadiusSq)
+        {
+            if (!Sink(Idx))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template<typename SinkType>
+bool FISMSpatialIndex::VisitCellInstancesInBox(TArrayView<const int32> CellInstances, const FVector3f& Min, const FVector3f& Max, SinkType&& Sink) const
+{
+    const int32 Num = CellInstances.Num();
+    const int32 NumPositions = PositionsX.Num();
+    const float* RESTRICT PX = PositionsX.GetData();
+    const float* RESTRICT PY = PositionsY.GetData();
+    const float* RESTRICT PZ = PositionsZ.GetData();
+
+    const VectorRegister4Float MinX = VectorSetFloat1(Min.X);
+    const VectorRegister4Float MinY = VectorSetFloat1(Min.Y);
+    const VectorRegister4Float MinZ = VectorSetFloat1(Min.Z);
+    const VectorRegister4Float MaxX = VectorSetFloat1(Max.X);
+    const VectorRegister4Float MaxY = VectorSetFloat1(Max.Y);
+    const VectorRegister4Float MaxZ = VectorSetFloat1(Max.Z);
+
+    int32 i = 0;
+
+    for (; i + 4 <= Num; i += 4)
+    {
+        alignas(16) float X[4];
+        alignas(16) float Y[4];
+        alignas(16) float Z[4];
+
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            const int32 Idx = CellInstances[i + Lane];
+            const bool bValid = Idx >= 0 && Idx < NumPositions;
+            X[Lane] = bValid ? PX[Idx] : MAX_flt;
+            Y[Lane] = bValid ? PY[Idx] : MAX_flt;
+            Z[Lane] = bValid ? PZ[Idx] : MAX_flt;
+        }
+
+        const VectorRegister4Float VX = VectorLoadAligned(X);
+        const VectorRegister4Float VY = VectorLoadAligned(Y);
+        const VectorRegister4Float VZ = VectorLoadAligned(Z);
+
+        VectorRegister4Float Inside = VectorBitwiseAnd(VectorCompareGE(VX, MinX), VectorCompareLE(VX, MaxX));
+        Inside = VectorBitwiseAnd(Inside, VectorBitwiseAnd(VectorCompareGE(VY, MinY), VectorCompareLE(VY, MaxY)));
+        Inside = VectorBitwiseAnd(Inside, VectorBitwiseAnd(VectorCompareGE(VZ, MinZ), VectorCompareLE(VZ, MaxZ)));
+
+        const int32 Mask = VectorMaskBits(Inside);
+        if (Mask == 0)
+        {
+            continue;
+        }
+
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            if (Mask & (1 << Lane))
+            {
+                if (!Sink(CellInstances[i + Lane]))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    for (; i < Num; i++)
+    {
+        const int32 Idx = CellInstances[i];
+        if (Idx < 0 || Idx >= NumPositions)
+        {
+            continue;
+        }
+
+        if (PX[Idx] >= Min.X && PX[Idx] <= Max.X &&
+            PY[Idx] >= Min.Y && PY[Idx] <= Max.Y &&
+            PZ[Idx] >= Min.Z && PZ[Idx] <= Max.Z)
+        {
+            if (!Sink(Idx))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template<typename TestType, typename SinkType>
+bool FISMSpatialIndex::VisitOverlapping(const FVector& Min, const FVector& Max, TestType&& Test, SinkType&& Sink) const
+{
+    // Anything bucketed further than MaxBoundsReach outside the query cannot touch it
+    const FVector Pad(MaxBoundsReach);
+    bool bContinue = true;
+
+    ForEachCellOverlapping(Min - Pad, Max + Pad, [this, &Test, &Sink, &bContinue](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        for (int32 Idx : CellInstances)
+        {
+            if (!bContinue)
+            {
+                return;
+            }
+
+            // Skip tombstones, and oversized instances which are tested once below
+            if (Idx < 0 || (BoundsOversized.IsValidIndex(Idx) && BoundsOversized[Idx]))
+            {
+                continue;
+            }
+
+            if (Test(Idx))
+            {
+                bContinue = Sink(Idx);
+            }
+        }
+    });
+
+    for (int32 Idx : OversizedInstances)
+    {
+        if (!bContinue)
+        {
+            break;
+        }
+
+        if (Test(Idx))
+        {
+            bContinue = Sink(Idx);
+        }
+    }
+
+    return bContinue;
+}
+
 void FISMSpatialIndex::AddInstance(int32 InstanceIndex, const FVector& Location)
 {
-    FIntVector CellCoord = WorldLocationToCell(Location);
+    StorePosition(InstanceIndex, Location);
+
+    // Coarse levels mirror the base grid; only add when the base actually gained an entry
+    if (AddToBaseGrid(InstanceIndex, WorldLocationToCell(Location)) && CoarseLevels.Num() > 0)
+    {
+        AddToCoarseLevels(InstanceIndex, Location);
+    }
+}
+
+void FISMSpatialIndex::AddInstances(TConstArrayView<int32> InstanceIndices, TConstArrayView<FVector> Locations)
+{
+    checkf(InstanceIndices.Num() == Locations.Num(), TEXT("FISMSpatialIndex::AddInstances: %d indices for %d locations"),
+        InstanceIndices.Num(), Locations.Num());
+    if (InstanceIndices.Num() == 0)
+    {
+        return;
+    }
+
+    ++Revision;
+
+    // Size the packed position streams once for the whole batch
+    int32 MaxIndex = INDEX_NONE;
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        MaxIndex = FMath::Max(MaxIndex, InstanceIndex);
+    }
+    if (MaxIndex >= PositionsX.Num())
+    {
+        PositionsX.SetNumZeroed(MaxIndex + 1);
+        PositionsY.SetNumZeroed(MaxIndex + 1);
+        PositionsZ.SetNumZeroed(MaxIndex + 1);
+        PositionValid.SetNum(MaxIndex + 1, false);
+    }
+
+    TArray<TPair<FIntVector, int32>> Pairs;
+    Pairs.Reserve(InstanceIndices.Num());
+    for (int32 i = 0; i < InstanceIndices.Num(); i++)
+    {
+        const int32 InstanceIndex = InstanceIndices[i];
+        if (InstanceIndex < 0)
+        {
+            continue;
+        }
+
+        const FIntVector CellCoord = WorldLocationToCell(Locations[i]);
+        StorePosition(InstanceIndex, Locations[i]);
+        GrowOccupiedCells(CellCoord);
+        NoteInstanceTagCell(InstanceIndex, CellCoord);
+        Pairs.Emplace(CellCoord, InstanceIndex);
+
+        for (FISMSpatialGridLevel& Level : CoarseLevels)
+        {
+            Level.Cells.FindOrAdd(LocationToCell(Locations[i], Level.CellSize)).Add(InstanceIndex);
+        }
+    }
+
+    // One map lookup per cell run; the indices are new, so no per-entry dedup
+    Pairs.Sort([](const TPair<FIntVector, int32>& A, const TPair<FIntVector, int32>& B)
+    {
+        if (A.Key != B.Key)
+        {
+            return CellKeyLess(A.Key, B.Key);
+        }
+        return A.Value < B.Value;
+    });
+
+    for (int32 RunStart = 0; RunStart < Pairs.Num();)
+    {
+        int32 RunEnd = RunStart + 1;
+        while (RunEnd < Pairs.Num() && Pairs[RunEnd].Key == Pairs[RunStart].Key)
+        {
+            ++RunEnd;
+        }
+
+        // Flat storage takes new entries in the hashed overlay until the next compaction
+        TArray<int32>& Cell = Cells.FindOrAdd(Pairs[RunStart].Key);
+        Cell.Reserve(Cell.Num() + RunEnd - RunStart);
+        for (int32 i = RunStart; i < RunEnd; i++)
+        {
+            Cell.Add(Pairs[i].Value);
+        }
+        RunStart = RunEnd;
+    }
+
+    if (Storage == EISMSpatialIndexStorage::Flat)
+    {
+        OverlayInstanceCount += Pairs.Num();
+        if (ShouldCompactFlat())
+        {
+            CompactFlatStorage();
+        }
+    }
+}
+
+bool FISMSpatialIndex::AddToBaseGrid(int32 InstanceIndex, const FIntVector& CellCoord)
+{
+    ++Revision;
+
+    GrowOccupiedCells(CellCoord);
+    NoteInstanceTagCell(InstanceIndex, CellCoord);
+
+    if (Storage == EISMSpatialIndexStorage::Flat)
+    {
+        // Already present in the contiguous buffer?
+        const int32 FlatCell = FindFlatCell(CellCoord);
+        if (FlatCell != INDEX_NONE)
+        {
+            for (int32 i = FlatCellOffsets[FlatCell]; i < FlatCellOffsets[FlatCell + 1]; i++)
+            {
+                if (FlatInstances[i] == InstanceIndex)
+                {
+                    return false;
+                }
+            }
+        }
+
+        // New entries go to the hashed overlay until the next compaction
+        TArray<int32>& Overlay = Cells.FindOrAdd(CellCoord);
+        const int32 PrevNum = Overlay.Num();
+        Overlay.AddUnique(InstanceIndex);
+        const bool bAdded = Overlay.Num() > PrevNum;
+        OverlayInstanceCount += Overlay.Num() - PrevNum;
+
+        if (ShouldCompactFlat())
+        {
+            CompactFlatStorage();
+        }
+        return bAdded;
+    }
+
+    // Get or create cell
+    TArray<int32>& Cell = Cells.FindOrAdd(CellCoord);
+
+    // Avoid duplicates (shouldn't happen in normal usage, but be safe)
+    const int32 PrevNum = Cell.Num();
+    Cell.AddUnique(InstanceIndex);
+    return Cell.Num() > PrevNum;
+}
+
+void FISMSpatialIndex::RemoveInstance(int32 InstanceIndex, const FVector& Location)
+{
+    if (!RemoveFromBaseGrid(InstanceIndex, WorldLocationToCell(Location)))
+    {
+        return;
+    }
+
+    if (PositionValid.IsValidIndex(InstanceIndex))
+    {
+        PositionValid[InstanceIndex] = false;
+    }
+
+    ClearInstanceBounds(InstanceIndex);
+
+    if (CoarseLevels.Num() > 0)
+    {
+        RemoveFromCoarseLevels(InstanceIndex, Location);
+    }
+
+    // Streaming churn: give memory back periodically instead of only ever growing
+    RemovalsSinceShrink++;
+    if (AutoShrinkMinRemovals > 0 && RemovalsSinceShrink >= FMath::Max(AutoShrinkMinRemovals, PositionsX.Num() / 4))
+    {
+        Shrink();
+    }
+}
+
+bool FISMSpatialIndex::RemoveFromBaseGrid(int32 InstanceIndex, const FIntVector& CellCoord)
+{
+    ++Revision;
+
+    if (TArray<int32>* Cell = Cells.Find(CellCoord))
+    {
+        // Remove the instance
+        const int32 NumRemoved = Cell->Remove(InstanceIndex);
+
+        // Clean up empty cells to save memory
+        if (Cell->Num() == 0)
+        {
+            Cells.Remove(CellCoord);
+        }
+
+        if (Storage == EISMSpatialIndexStorage::Flat)
+        {
+            OverlayInstanceCount -= NumRemoved;
+        }
+
+        if (NumRemoved > 0 || Storage != EISMSpatialIndexStorage::Flat)
+        {
+            return NumRemoved > 0;
+        }
+    }
+
+    if (Storage != EISMSpatialIndexStorage::Flat)
+    {
+        return false;
+    }
+
+    // Tombstone the entry in place - keeps the buffer layout stable
+    const int32 FlatCell = FindFlatCell(CellCoord);
+    if (FlatCell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    bool bRemoved = false;
+    for (int32 i = FlatCellOffsets[FlatCell]; i < FlatCellOffsets[FlatCell + 1]; i++)
+    {
+        if (FlatInstances[i] == InstanceIndex)
+        {
+            FlatInstances[i] = INDEX_NONE;
+            FlatTombstoneCount++;
+            bRemoved = true;
+            break;
+        }
+    }
+
+    if (ShouldCompactFlat())
+    {
+        CompactFlatStorage();
+    }
+    return bRemoved;
+}
+
+void FISMSpatialIndex::UpdateInstance(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation)
+{
+    FIntVector OldCell = WorldLocationToCell(OldLocation);
+    FIntVector NewCell = WorldLocationToCell(NewLocation);
+
+    // Only update if cell changed (common case: instance moves within same cell)
+    if (OldCell != NewCell)
+    {
+        // Re-bucket directly rather than Remove+Add so recorded bounds survive the move
+        if (RemoveFromBaseGrid(InstanceIndex, OldCell) && CoarseLevels.Num() > 0)
+        {
+            RemoveFromCoarseLevels(InstanceIndex, OldLocation);
+        }
+
+        StorePosition(InstanceIndex, NewLocation);
+
+        if (AddToBaseGrid(InstanceIndex, NewCell) && CoarseLevels.Num() > 0)
+        {
+            AddToCoarseLevels(InstanceIndex, NewLocation);
+        }
+    }
+    else
+    {
+        // Same cell - exact queries still need the new position
+        StorePosition(InstanceIndex, NewLocation);
+    }
+}
+
+/** Sort (cell, instance) pairs and visit each cell's run as a sorted view of instance indices */
+template<typename VisitorType>
+static void ForEachCellGroup(TArray<TPair<FIntVector, int32>>& Pairs, VisitorType&& Visitor)
+{
+    Pairs.Sort([](const TPair<FIntVector, int32>& A, const TPair<FIntVector, int32>& B)
+    {
+        if (A.Key.X != B.Key.X) return A.Key.X < B.Key.X;
+        if (A.Key.Y != B.Key.Y) return A.Key.Y < B.Key.Y;
+        if (A.Key.Z != B.Key.Z) return A.Key.Z < B.Key.Z;
+        return A.Value < B.Value;
+    });
+
+    TArray<int32> Group;
+    for (int32 Start = 0; Start < Pairs.Num();)
+    {
+        int32 End = Start;
+        Group.Reset();
+        while (End < Pairs.Num() && Pairs[End].Key == Pairs[Start].Key)
+        {
+            Group.Add(Pairs[End].Value);
+            End++;
+        }
+
+        Visitor(Pairs[Start].Key, TArrayView<const int32>(Group));
+        Start = End;
+    }
+}
+
+int32 FISMSpatialIndex::RemoveGroupFromCell(TArray<int32>& Cell, TArrayView<const int32> SortedGroup)
+{
+    // Cells are unordered, so swap-removal keeps this a single pass
+    return Cell.RemoveAllSwap([SortedGroup](int32 Idx)
+    {
+        return Algo::BinarySearch(SortedGroup, Idx) != INDEX_NONE;
+    }, EAllowShrinking::No);
+}
+
+int32 FISMSpatialIndex::AddGroupToCell(TArray<int32>& Cell, TArrayView<const int32> SortedGroup)
+{
+    // One pass over the existing cell to find group members already present
+    TBitArray<> Present(false, SortedGroup.Num());
+    for (int32 Idx : Cell)
+    {
+        const int32 GroupPos = Algo::BinarySearch(SortedGroup, Idx);
+        if (GroupPos != INDEX_NONE)
+        {
+            Present[GroupPos] = true;
+        }
+    }
+
+    const int32 PrevNum = Cell.Num();
+    Cell.Reserve(PrevNum + SortedGroup.Num());
+    for (int32 GroupPos = 0; GroupPos < SortedGroup.Num(); GroupPos++)
+    {
+        // Sorted input: skip duplicate moves of the same instance
+        if (!Present[GroupPos] && (GroupPos == 0 || SortedGroup[GroupPos] != SortedGroup[GroupPos - 1]))
+        {
+            Cell.Add(SortedGroup[GroupPos]);
+        }
+    }
+
+    return Cell.Num() - PrevNum;
+}
+
+void FISMSpatialIndex::ApplyMoves(TArrayView<const FISMSpatialIndexMove> Moves)
+{
+    ++Revision;
+
+    TArray<TPair<FIntVector, int32>> Removals;
+    TArray<TPair<FIntVector, int32>> Additions;
+
+    for (const FISMSpatialIndexMove& Move : Moves)
+    {
+        const FIntVector OldCell = WorldLocationToCell(Move.OldLocation);
+        const FIntVector NewCell = WorldLocationToCell(Move.NewLocation);
+
+        // Positions (and bounds reach) update immediately; only cell changes are deferred
+        StorePosition(Move.InstanceIndex, Move.NewLocation);
+
+        if (OldCell != NewCell)
+        {
+            Removals.Emplace(OldCell, Move.InstanceIndex);
+            Additions.Emplace(NewCell, Move.InstanceIndex);
+        }
+    }
+
+    if (Removals.Num() == 0)
+    {
+        return;
+    }
+
+    // Removals first so swaps between two cells settle correctly
+    ForEachCellGroup(Removals, [this](const FIntVector& CellCoord, TArrayView<const int32> Group)
+    {
+        if (TArray<int32>* Cell = Cells.Find(CellCoord))
+        {
+            const int32 NumRemoved = RemoveGroupFromCell(*Cell, Group);
+            if (Storage == EISMSpatialIndexStorage::Flat)
+            {
+                OverlayInstanceCount -= NumRemoved;
+            }
+            if (Cell->Num() == 0)
+            {
+                Cells.Remove(CellCoord);
+            }
+        }
+
+        if (Storage == EISMSpatialIndexStorage::Flat)
+        {
+            const int32 FlatCell = FindFlatCell(CellCoord);
+            if (FlatCell != INDEX_NONE)
+            {
+                for (int32 i = FlatCellOffsets[FlatCell]; i < FlatCellOffsets[FlatCell + 1]; i++)
+                {
+                    if (FlatInstances[i] != INDEX_NONE && Algo::BinarySearch(Group, FlatInstances[i]) != INDEX_NONE)
+                    {
+                        FlatInstances[i] = INDEX_NONE;
+                        FlatTombstoneCount++;
+                    }
+                }
+            }
+        }
+    });
+
+    ForEachCellGroup(Additions, [this](const FIntVector& CellCoord, TArrayView<const int32> Group)
+    {
+        GrowOccupiedCells(CellCoord);
+        for (int32 InstanceIndex : Group)
+        {
+            NoteInstanceTagCell(InstanceIndex, CellCoord);
+        }
+
+        TArray<int32> Remaining(Group);
+        if (Storage == EISMSpatialIndexStorage::Flat)
+        {
+            // Entries still live in the contiguous buffer need no overlay copy
+            const int32 FlatCell = FindFlatCell(CellCoord);
+            if (FlatCell != INDEX_NONE)
+            {
+                for (int32 i = FlatCellOffsets[FlatCell]; i < FlatCellOffsets[FlatCell + 1]; i++)
+                {
+                    const int32 GroupPos = FlatInstances[i] != INDEX_NONE ? Algo::BinarySearch(Remaining, FlatInstances[i]) : INDEX_NONE;
+                    if (GroupPos != INDEX_NONE)
+                    {
+                        Remaining.RemoveAt(GroupPos, 1, EAllowShrinking::No);
+                    }
+                }
+            }
+        }
+
+        if (Remaining.Num() > 0)
+        {
+            const int32 NumAdded = AddGroupToCell(Cells.FindOrAdd(CellCoord), Remaining);
+            if (Storage == EISMSpatialIndexStorage::Flat)
+            {
+                OverlayInstanceCount += NumAdded;
+            }
+        }
+    });
+
+    if (CoarseLevels.Num() > 0)
+    {
+        for (FISMSpatialGridLevel& Level : CoarseLevels)
+        {
+            // Nested levels: most base-cell changes stay inside the same coarse cell
+            TArray<TPair<FIntVector, int32>> LevelRemovals;
+            TArray<TPair<FIntVector, int32>> LevelAdditions;
+
+            for (const FISMSpatialIndexMove& Move : Moves)
+            {
+                const FIntVector OldCell = LocationToCell(Move.OldLocation, Level.CellSize);
+                const FIntVector NewCell = LocationToCell(Move.NewLocation, Level.CellSize);
+                if (OldCell != NewCell)
+                {
+                    LevelRemovals.Emplace(OldCell, Move.InstanceIndex);
+                    LevelAdditions.Emplace(NewCell, Move.InstanceIndex);
+                }
+            }
+
+            ForEachCellGroup(LevelRemovals, [&Level](const FIntVector& CellCoord, TArrayView<const int32> Group)
+            {
+                if (TArray<int32>* Cell = Level.Cells.Find(CellCoord))
+                {
+                    RemoveGroupFromCell(*Cell, Group);
+                    if (Cell->Num() == 0)
+                    {
+                        Level.Cells.Remove(CellCoord);
+                    }
+                }
+            });
+
+            ForEachCellGroup(LevelAdditions, [&Level](const FIntVector& CellCoord, TArrayView<const int32> Group)
+            {
+                Level.Cells.FindOrAdd(CellCoord).Append(Group.GetData(), Group.Num());
+            });
+        }
+    }
+
+    if (ShouldCompactFlat())
+    {
+        CompactFlatStorage();
+    }
+}
+
+void FISMSpatialIndex::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    // Calculate AABB of the sphere
+    FVector Min = Center - FVector(Radius);
+    FVector Max = Center + FVector(Radius);
+
+    FIntVector MinCell = WorldLocationToCell(Min);
+    FIntVector MaxCell = WorldLocationToCell(Max);
+
+    // Reserve approximate space
+    int64 EstimatedResults = int64(MaxCell.X - MinCell.X + 1) *
+        int64(MaxCell.Y - MinCell.Y + 1) *
+        int64(MaxCell.Z - MinCell.Z + 1) * 10; // Assume ~10 per cell
+    OutInstances.Reserve(static_cast<int32>(FMath::Min<int64>(EstimatedResults, PositionsX.Num())));
+
+    // Iterate overlapping cells (on the coarsest useful level when hierarchical)
+    ForEachCellOverlapping(Min, Max, [&OutInstances](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        AppendCellInstances(CellInstances, OutInstances);
+    });
+
+    // Note: Results may include instances outside the sphere.
+    // Caller should do precise distance check if needed.
+}
+
+void FISMSpatialIndex::QueryBox(const FBox& Box, TArray<int32>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    FIntVector MinCell = WorldLocationToCell(Box.Min);
+    FIntVector MaxCell = WorldLocationToCell(Box.Max);
+
+    // Reserve approximate space
+    int64 EstimatedResults = int64(MaxCell.X - MinCell.X + 1) *
+        int64(MaxCell.Y - MinCell.Y + 1) *
+        int64(MaxCell.Z - MinCell.Z + 1) * 10;
+    OutInstances.Reserve(static_cast<int32>(FMath::Min<int64>(EstimatedResults, PositionsX.Num())));
+
+    ForEachCellOverlapping(Box.Min, Box.Max, [&OutInstances](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        AppendCellInstances(CellInstances, OutInstances);
+    });
+}
+
+void FISMSpatialIndex::QueryRadiusExact(const FVector& Center, float Radius, TArray<int32>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    if (Radius < 0.0f)
+    {
+        return;
+    }
+
+    const FVector3f Center3f(Center);
+    const float RadiusSq = Radius * Radius;
+
+    int32 NumCandidates = 0;
+    ForEachCellOverlapping(Center - FVector(Radius), Center + FVector(Radius), [this, &Center3f, RadiusSq, &OutInstances, &NumCandidates](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        NumCandidates += CellInstances.Num();
+        AppendCellInstancesInSphere(CellInstances, Center3f, RadiusSq, OutInstances);
+    });
+    RecordQuery(Radius, NumCandidates, OutInstances.Num());
+}
+
+void FISMSpatialIndex::QueryBoxExact(const FBox& Box, TArray<int32>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    if (!Box.IsValid)
+    {
+        return;
+    }
+
+    const FVector3f Min3f(Box.Min);
+    const FVector3f Max3f(Box.Max);
+
+    int32 NumCandidates = 0;
+    ForEachCellOverlapping(Box.Min, Box.Max, [this, &Min3f, &Max3f, &OutInstances, &NumCandidates](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        NumCandidates += CellInstances.Num();
+        AppendCellInstancesInBox(CellInstances, Min3f, Max3f, OutInstances);
+    });
+    RecordQuery(Box.GetExtent().GetMax(), NumCandidates, OutInstances.Num());
+}
+
+bool FISMSpatialIndex::GetInstancePosition(int32 InstanceIndex, FVector& OutPosition) const
+{
+    if (!PositionValid.IsValidIndex(InstanceIndex) || !PositionValid[InstanceIndex])
+    {
+        return false;
+    }
+
+    OutPosition = FVector(PositionsX[InstanceIndex], PositionsY[InstanceIndex], PositionsZ[InstanceIndex]);
+    return true;
+}
+
+void FISMSpatialIndex::StorePosition(int32 InstanceIndex, const FVector& Location)
+{
+    ++Revision;
+
+    if (InstanceIndex < 0)
+    {
+        return;
+    }
+
+    if (InstanceIndex >= PositionsX.Num())
+    {
+        // Grow geometrically - BatchAdd appends indices sequentially
+        const int32 NewNum = FMath::Max(InstanceIndex + 1, PositionsX.Num() + PositionsX.Num() / 2);
+        PositionsX.SetNumZeroed(NewNum);
+        PositionsY.SetNumZeroed(NewNum);
+        PositionsZ.SetNumZeroed(NewNum);
+        PositionValid.SetNum(NewNum, false);
+    }
+
+    PositionsX[InstanceIndex] = static_cast<float>(Location.X);
+    PositionsY[InstanceIndex] = static_cast<float>(Location.Y);
+    PositionsZ[InstanceIndex] = static_cast<float>(Location.Z);
+    PositionValid[InstanceIndex] = true;
+
+    // Reach is measured from the pivot, so it follows every position change
+    if (BoundsValid.IsValidIndex(InstanceIndex) && BoundsValid[InstanceIndex])
+    {
+        RefreshBoundsReach(InstanceIndex);
+    }
+}
+
+void FISMSpatialIndex::SetInstanceBounds(int32 InstanceIndex, const FBox& WorldBounds)
+{
+    ++Revision;
+
+    if (InstanceIndex < 0)
+    {
+        return;
+    }
+
+    if (!WorldBounds.IsValid)
+    {
+        ClearInstanceBounds(InstanceIndex);
+        return;
+    }
+
+    EnsureBoundsCapacity(InstanceIndex);
+    BoundsMin[InstanceIndex] = FVector3f(WorldBounds.Min);
+    BoundsMax[InstanceIndex] = FVector3f(WorldBounds.Max);
+    BoundsValid[InstanceIndex] = true;
+
+    RefreshBoundsReach(InstanceIndex);
+}
+
+void FISMSpatialIndex::AdoptInstanceBounds(TConstArrayView<FVector3f> InBoundsMin, TConstArrayView<FVector3f> InBoundsMax)
+{
+    ++Revision;
+
+    const int32 NumInstances = FMath::Min(InBoundsMin.Num(), InBoundsMax.Num());
+    BoundsMin = InBoundsMin.Left(NumInstances);
+    BoundsMax = InBoundsMax.Left(NumInstances);
+    BoundsValid.Init(true, NumInstances);
+    BoundsOversized.Init(false, NumInstances);
+    OversizedInstances.Reset();
+    MaxBoundsReach = 0.0f;
+
+    for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+    {
+        RefreshBoundsReach(InstanceIndex);
+    }
+}
+
+void FISMSpatialIndex::ClearInstanceBounds(int32 InstanceIndex)
+{
+    ++Revision;
+
+    if (!BoundsValid.IsValidIndex(InstanceIndex) || !BoundsValid[InstanceIndex])
+    {
+        return;
+    }
+
+    BoundsValid[InstanceIndex] = false;
+
+    if (BoundsOversized[InstanceIndex])
+    {
+        BoundsOversized[InstanceIndex] = false;
+        OversizedInstances.RemoveSingleSwap(InstanceIndex, EAllowShrinking::No);
+    }
+}
+
+void FISMSpatialIndex::SetInstanceTagMask(int32 InstanceIndex, const FISMTagMask& Mask)
+{
+    if (InstanceIndex < 0)
+    {
+        return;
+    }
+
+    if (InstanceIndex >= InstanceTagMasks.Num())
+    {
+        InstanceTagMasks.SetNumZeroed(InstanceIndex + 1);
+    }
+    InstanceTagMasks[InstanceIndex] = Mask;
+
+    if (!bTrackTagMasks)
+    {
+        // First mask: file every indexed instance's cell once, then keep the unions up incrementally
+        bTrackTagMasks = true;
+        RebuildCellTagMasks();
+        return;
+    }
+
+    // Not in the index yet - AddToBaseGrid merges the mask when it arrives
+    if (Mask.IsEmpty() || !PositionValid.IsValidIndex(InstanceIndex) || !PositionValid[InstanceIndex] || !InstanceTagCells.IsValidIndex(InstanceIndex))
+    {
+        return;
+    }
+
+    CellTagMasks.FindOrAdd(InstanceTagCells[InstanceIndex]) |= Mask;
+}
+
+void FISMSpatialIndex::ClearInstanceTagMasks()
+{
+    InstanceTagMasks.Empty();
+    InstanceTagCells.Empty();
+    CellTagMasks.Empty();
+    bTrackTagMasks = false;
+}
+
+void FISMSpatialIndex::NoteInstanceTagCell(int32 InstanceIndex, const FIntVector& CellCoord)
+{
+    if (!bTrackTagMasks || InstanceIndex < 0)
+    {
+        return;
+    }
+
+    if (InstanceIndex >= InstanceTagCells.Num())
+    {
+        InstanceTagCells.SetNumZeroed(FMath::Max(InstanceIndex + 1, PositionsX.Num()));
+    }
+    InstanceTagCells[InstanceIndex] = CellCoord;
+
+    if (InstanceTagMasks.IsValidIndex(InstanceIndex) && !InstanceTagMasks[InstanceIndex].IsEmpty())
+    {
+        CellTagMasks.FindOrAdd(CellCoord) |= InstanceTagMasks[InstanceIndex];
+    }
+}
+
+void FISMSpatialIndex::RebuildCellTagMasks()
+{
+    CellTagMasks.Reset();
+
+    auto FileCell = [this](const FIntVector& CellCoord, TArrayView<const int32> CellInstances)
+    {
+        for (int32 InstanceIndex : CellInstances)
+        {
+            if (InstanceIndex != INDEX_NONE)
+            {
+                NoteInstanceTagCell(InstanceIndex, CellCoord);
+            }
+        }
+    };
+
+    for (int32 FlatCell = 0; FlatCell < FlatCellKeys.Num(); FlatCell++)
+    {
+        const int32 Start = FlatCellOffsets[FlatCell];
+        FileCell(FlatCellKeys[FlatCell], TArrayView<const int32>(FlatInstances.GetData() + Start, FlatCellOffsets[FlatCell + 1] - Start));
+    }
+
+    for (const auto& Pair : Cells)
+    {
+        FileCell(Pair.Key, TArrayView<const int32>(Pair.Value));
+    }
+}
+
+void FISMSpatialIndex::EnsureBoundsCapacity(int32 InstanceIndex)
+{
+    if (InstanceIndex < BoundsMin.Num())
+    {
+        return;
+    }
+
+    const int32 NewNum = FMath::Max(InstanceIndex + 1, BoundsMin.Num() + BoundsMin.Num() / 2);
+    BoundsMin.SetNumZeroed(NewNum);
+    BoundsMax.SetNumZeroed(NewNum);
+    BoundsValid.SetNum(NewNum, false);
+    BoundsOversized.SetNum(NewNum, false);
+}
+
+void FISMSpatialIndex::RefreshBoundsReach(int32 InstanceIndex)
+{
+    // Needs both a pivot and bounds; whichever arrives second completes the picture
+    if (!PositionValid.IsValidIndex(InstanceIndex) || !PositionValid[InstanceIndex])
+    {
+        return;
+    }
+
+    const FVector3f Pivot(PositionsX[InstanceIndex], PositionsY[InstanceIndex], PositionsZ[InstanceIndex]);
+    const FVector3f ToMin = Pivot - BoundsMin[InstanceIndex];
+    const FVector3f ToMax = BoundsMax[InstanceIndex] - Pivot;
+    const float Reach = FMath::Max(ToMin.GetMax(), ToMax.GetMax());
+
+    const bool bOversized = Reach > CellSize;
+    if (bOversized != BoundsOversized[InstanceIndex])
+    {
+        BoundsOversized[InstanceIndex] = bOversized;
+        if (bOversized)
+        {
+            OversizedInstances.Add(InstanceIndex);
+        }
+        else
+        {
+            OversizedInstances.RemoveSingleSwap(InstanceIndex, EAllowShrinking::No);
+        }
+    }
+
+    if (!bOversized)
+    {
+        MaxBoundsReach = FMath::Max(MaxBoundsReach, Reach);
+    }
+}
+
+bool FISMSpatialIndex::InstanceOverlapsBox(int32 InstanceIndex, const FVector3f& Min, const FVector3f& Max) const
+{
+    if (BoundsValid.IsValidIndex(InstanceIndex) && BoundsValid[InstanceIndex])
+    {
+        const FVector3f& BMin = BoundsMin[InstanceIndex];
+        const FVector3f& BMax = BoundsMax[InstanceIndex];
+        return BMin.X <= Max.X && BMax.X >= Min.X &&
+            BMin.Y <= Max.Y && BMax.Y >= Min.Y &&
+            BMin.Z <= Max.Z && BMax.Z >= Min.Z;
+    }
+
+    if (InstanceIndex >= PositionsX.Num())
+    {
+        return false;
+    }
+
+    const float X = PositionsX[InstanceIndex];
+    const float Y = PositionsY[InstanceIndex];
+    const float Z = PositionsZ[InstanceIndex];
+    return X >= Min.X && X <= Max.X && Y >= Min.Y && Y <= Max.Y && Z >= Min.Z && Z <= Max.Z;
+}
+
+bool FISMSpatialIndex::InstanceOverlapsSphere(int32 InstanceIndex, const FVector3f& Center, float RadiusSq) const
+{
+    if (BoundsValid.IsValidIndex(InstanceIndex) && BoundsValid[InstanceIndex])
+    {
+        // Closest point on the box to the sphere center
+        const FVector3f Closest(
+            FMath::Clamp(Center.X, BoundsMin[InstanceIndex].X, BoundsMax[InstanceIndex].X),
+            FMath::Clamp(Center.Y, BoundsMin[InstanceIndex].Y, BoundsMax[InstanceIndex].Y),
+            FMath::Clamp(Center.Z, BoundsMin[InstanceIndex].Z, BoundsMax[InstanceIndex].Z));
+        return FVector3f::DistSquared(Closest, Center) <= RadiusSq;
+    }
+
+    if (InstanceIndex >= PositionsX.Num())
+    {
+        return false;
+    }
+
+    const FVector3f Position(PositionsX[InstanceIndex], PositionsY[InstanceIndex], PositionsZ[InstanceIndex]);
+    return FVector3f::DistSquared(Position, Center) <= RadiusSq;
+}
+
+void FISMSpatialIndex::QueryOverlappingBox(const FBox& Box, TArray<int32>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    if (!Box.IsValid)
+    {
+        return;
+    }
+
+    const FVector3f Min3f(Box.Min);
+    const FVector3f Max3f(Box.Max);
+
+    VisitOverlapping(Box.Min, Box.Max, [this, &Min3f, &Max3f](int32 Idx)
+    {
+        return InstanceOverlapsBox(Idx, Min3f, Max3f);
+    }, [&OutInstances](int32 Idx)
+    {
+        OutInstances.Add(Idx);
+        return true;
+    });
+}
+
+void FISMSpatialIndex::QueryOverlappingSphere(const FVector& Center, float Radius, TArray<int32>& OutInstances) const
+{
+    OutInstances.Reset();
+
+    if (Radius < 0.0f)
+    {
+        return;
+    }
+
+    const FVector3f Center3f(Center);
+    const float RadiusSq = Radius * Radius;
+
+    VisitOverlapping(Center - FVector(Radius), Center + FVector(Radius), [this, &Center3f, RadiusSq](int32 Idx)
+    {
+        return InstanceOverlapsSphere(Idx, Center3f, RadiusSq);
+    }, [&OutInstances](int32 Idx)
+    {
+        OutInstances.Add(Idx);
+        return true;
+    });
+}
+
+bool FISMSpatialIndex::ForEachInstanceInRadius(const FVector& Center, float Radius, TFunctionRef<bool(int32)> Visitor) const
+{
+    if (Radius < 0.0f)
+    {
+        return true;
+    }
+
+    const FVector3f Center3f(Center);
+    const float RadiusSq = Radius * Radius;
+    bool bContinue = true;
+    int32 NumCandidates = 0;
+    int32 NumHits = 0;
+    auto CountingVisitor = [&Visitor, &NumHits](int32 Idx)
+    {
+        ++NumHits;
+        return Visitor(Idx);
+    };
+
+    ForEachCellOverlapping(Center - FVector(Radius), Center + FVector(Radius), [this, &Center3f, RadiusSq, &CountingVisitor, &bContinue, &NumCandidates](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        // Cells keep coming after a stop; skipping them is cheaper than threading an exit through the walkers
+        if (bContinue)
+        {
+            NumCandidates += CellInstances.Num();
+            bContinue = VisitCellInstancesInSphere(CellInstances, Center3f, RadiusSq, CountingVisitor);
+        }
+    });
+
+    RecordQuery(Radius, NumCandidates, NumHits);
+    return bContinue;
+}
+
+bool FISMSpatialIndex::ForEachInstanceInBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor) const
+{
+    if (!Box.IsValid)
+    {
+        return true;
+    }
+
+    const FVector3f Min3f(Box.Min);
+    const FVector3f Max3f(Box.Max);
+    bool bContinue = true;
+    int32 NumCandidates = 0;
+    int32 NumHits = 0;
+    auto CountingVisitor = [&Visitor, &NumHits](int32 Idx)
+    {
+        ++NumHits;
+        return Visitor(Idx);
+    };
+
+    ForEachCellOverlapping(Box.Min, Box.Max, [this, &Min3f, &Max3f, &CountingVisitor, &bContinue, &NumCandidates](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        if (bContinue)
+        {
+            NumCandidates += CellInstances.Num();
+            bContinue = VisitCellInstancesInBox(CellInstances, Min3f, Max3f, CountingVisitor);
+        }
+    });
+
+    RecordQuery(Box.GetExtent().GetMax(), NumCandidates, NumHits);
+    return bContinue;
+}
+
+bool FISMSpatialIndex::ForEachInstanceInRadiusWithTags(const FVector& Center, float Radius, const FISMTagMask& RequiredMask, TFunctionRef<bool(int32)> Visitor) const
+{
+    if (RequiredMask.IsEmpty())
+    {
+        return ForEachInstanceInRadius(Center, Radius, Visitor);
+    }
+
+    if (Radius < 0.0f || !bTrackTagMasks)
+    {
+        return true;
+    }
+
+    const FVector3f Center3f(Center);
+    const float RadiusSq = Radius * Radius;
+    bool bContinue = true;
+
+    // Unions live on the base grid, so the walk stays there whatever the query size
+    ForEachCellInRange(WorldLocationToCell(Center - FVector(Radius)), WorldLocationToCell(Center + FVector(Radius)),
+        [this, &Center3f, RadiusSq, &RequiredMask, &Visitor, &bContinue](const FIntVector& CellCoord, TArrayView<const int32> CellInstances)
+    {
+        if (!bContinue || !CellMayHaveTags(CellCoord, RequiredMask))
+        {
+            return;
+        }
+
+        bContinue = VisitCellInstancesInSphere(CellInstances, Center3f, RadiusSq, [this, &RequiredMask, &Visitor](int32 Idx)
+        {
+            return !InstanceHasTags(Idx, RequiredMask) || Visitor(Idx);
+        });
+    });
+
+    return bContinue;
+}
+
+bool FISMSpatialIndex::ForEachInstanceInBoxWithTags(const FBox& Box, const FISMTagMask& RequiredMask, TFunctionRef<bool(int32)> Visitor) const
+{
+    if (RequiredMask.IsEmpty())
+    {
+        return ForEachInstanceInBox(Box, Visitor);
+    }
+
+    if (!Box.IsValid || !bTrackTagMasks)
+    {
+        return true;
+    }
+
+    const FVector3f Min3f(Box.Min);
+    const FVector3f Max3f(Box.Max);
+    bool bContinue = true;
+
+    ForEachCellInRange(WorldLocationToCell(Box.Min), WorldLocationToCell(Box.Max),
+        [this, &Min3f, &Max3f, &RequiredMask, &Visitor, &bContinue](const FIntVector& CellCoord, TArrayView<const int32> CellInstances)
+    {
+        if (!bContinue || !CellMayHaveTags(CellCoord, RequiredMask))
+        {
+            return;
+        }
+
+        bContinue = VisitCellInstancesInBox(CellInstances, Min3f, Max3f, [this, &RequiredMask, &Visitor](int32 Idx)
+        {
+            return !InstanceHasTags(Idx, RequiredMask) || Visitor(Idx);
+        });
+    });
+
+    return bContinue;
+}
+
+void FISMSpatialIndex::ForEachInstanceInRadiusBatch(TConstArrayView<FISMSpatialSphereQuery> Queries, TFunctionRef<void(int32, int32)> Visitor) const
+{
+    // (cell view, query) pairs; a cell view is identified by its instance storage
+    struct FCellVisit
+    {
+        const int32* Instances;
+        int32 NumInstances;
+        int32 QueryIdx;
+    };
+    TArray<FCellVisit> Visits;
+
+    for (int32 QueryIdx = 0; QueryIdx < Queries.Num(); QueryIdx++)
+    {
+        const FISMSpatialSphereQuery& Query = Queries[QueryIdx];
+        if (Query.Radius < 0.0f)
+        {
+            continue;
+        }
+
+        const FVector Min = Query.Center - FVector(Query.Radius);
+        const FVector Max = Query.Center + FVector(Query.Radius);
+        if (SelectQueryLevel(Query.Radius) != INDEX_NONE)
+        {
+            ForEachInstanceInRadius(Query.Center, Query.Radius, [&Visitor, QueryIdx](int32 Idx)
+            {
+                Visitor(QueryIdx, Idx);
+                return true;
+            });
+            continue;
+        }
+
+        ForEachCellInRange(WorldLocationToCell(Min), WorldLocationToCell(Max), [&Visits, QueryIdx](const FIntVector&, TArrayView<const int32> CellInstances)
+        {
+            if (CellInstances.Num() > 0)
+            {
+                Visits.Add({ CellInstances.GetData(), CellInstances.Num(), QueryIdx });
+            }
+        });
+    }
+
+    Visits.Sort([](const FCellVisit& A, const FCellVisit& B)
+    {
+        const UPTRINT PtrA = reinterpret_cast<UPTRINT>(A.Instances);
+        const UPTRINT PtrB = reinterpret_cast<UPTRINT>(B.Instances);
+        return PtrA != PtrB ? PtrA < PtrB : A.QueryIdx < B.QueryIdx;
+    });
+
+    for (const FCellVisit& Visit : Visits)
+    {
+        const FISMSpatialSphereQuery& Query = Queries[Visit.QueryIdx];
+        const int32 QueryIdx = Visit.QueryIdx;
+        VisitCellInstancesInSphere(TArrayView<const int32>(Visit.Instances, Visit.NumInstances),
+            FVector3f(Query.Center), Query.Radius * Query.Radius, [&Visitor, QueryIdx](int32 Idx)
+            {
+                Visitor(QueryIdx, Idx);
+                return true;
+            });
+    }
+}
+
+void FISMSpatialIndex::ForEachInstanceRadiusDelta(const FISMSpatialSphereQuery& From, const FISMSpatialSphereQuery& To, TFunctionRef<void(int32, bool)> Visitor) const
+{
+    const float FromRadius = FMath::Max(From.Radius, 0.0f);
+    const float ToRadius = FMath::Max(To.Radius, 0.0f);
+    const FVector3f FromCenter(From.Center);
+    const FVector3f ToCenter(To.Center);
+    const float FromRadiusSq = FromRadius * FromRadius;
+    const float ToRadiusSq = ToRadius * ToRadius;
+
+    // Cell classification is padded so float rounding in the per-instance test can never
+    // disagree with a skipped cell
+    const float Margin = 1.0f + CellSize * 1e-4f;
+    const float FromInnerSq = FMath::Square(FMath::Max(FromRadius - Margin, 0.0f));
+    const float ToInnerSq = FMath::Square(FMath::Max(ToRadius - Margin, 0.0f));
+    const float FromOuterSq = FMath::Square(FromRadius + Margin);
+    const float ToOuterSq = FMath::Square(ToRadius + Margin);
+    const int32 NumPositions = PositionsX.Num();
+
+    auto VisitCell = [&](const FIntVector& Cell, TArrayView<const int32> CellInstances)
+    {
+        if (CellInstances.Num() == 0)
+        {
+            return;
+        }
+
+        const FBox CellBox(FVector(Cell) * CellSize, FVector(Cell + FIntVector(1)) * CellSize);
+        const bool bTouchesFrom = FMath::SphereAABBIntersection(From.Center, FromOuterSq, CellBox);
+        const bool bTouchesTo = FMath::SphereAABBIntersection(To.Center, ToOuterSq, CellBox);
+        if (!bTouchesFrom && !bTouchesTo)
+        {
+            return;
+        }
+
+        // Wholly inside both spheres: every instance stays a member
+        const FVector Extent = CellBox.GetExtent();
+        const FVector FromFar = (CellBox.GetCenter() - From.Center).GetAbs() + Extent;
+        const FVector ToFar = (CellBox.GetCenter() - To.Center).GetAbs() + Extent;
+        if (FromFar.SizeSquared() <= FromInnerSq && ToFar.SizeSquared() <= ToInnerSq)
+        {
+            return;
+        }
+
+        for (int32 Idx : CellInstances)
+        {
+            if (Idx < 0 || Idx >= NumPositions)
+            {
+                continue;
+            }
+
+            const FVector3f Position(PositionsX[Idx], PositionsY[Idx], PositionsZ[Idx]);
+            const bool bInFrom = (Position - FromCenter).SizeSquared() <= FromRadiusSq;
+            const bool bInTo = (Position - ToCenter).SizeSquared() <= ToRadiusSq;
+            if (bInFrom != bInTo)
+            {
+                Visitor(Idx, bInTo);
+            }
+        }
+    };
+
+    const FBox FromBox = FBox::BuildAABB(From.Center, FVector(FromRadius));
+    const FBox ToBox = FBox::BuildAABB(To.Center, FVector(ToRadius));
+    if (FromBox.Intersect(ToBox))
+    {
+        const FBox Union = FromBox + ToBox;
+        ForEachCellInRange(WorldLocationToCell(Union.Min), WorldLocationToCell(Union.Max), VisitCell);
+        return;
+    }
+
+    // Jumped clear of the old sphere: two ranges instead of the box spanning both.
+    // The ranges can still share cells at the seam; those are only visited with the first.
+    const FIntVector FromMinCell = WorldLocationToCell(FromBox.Min);
+    const FIntVector FromMaxCell = WorldLocationToCell(FromBox.Max);
+    ForEachCellInRange(FromMinCell, FromMaxCell, VisitCell);
+    ForEachCellInRange(WorldLocationToCell(ToBox.Min), WorldLocationToCell(ToBox.Max), [&](const FIntVector& Cell, TArrayView<const int32> CellInstances)
+    {
+        const bool bInFromRange =
+            Cell.X >= FromMinCell.X && Cell.X <= FromMaxCell.X &&
+            Cell.Y >= FromMinCell.Y && Cell.Y <= FromMaxCell.Y &&
+            Cell.Z >= FromMinCell.Z && Cell.Z <= FromMaxCell.Z;
+        if (!bInFromRange)
+        {
+            VisitCell(Cell, CellInstances);
+        }
+    });
+}
+
+bool FISMSpatialIndex::ForEachInstanceOverlappingBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor) const
+{
+    if (!Box.IsValid)
+    {
+        return true;
+    }
+
+    const FVector3f Min3f(Box.Min);
+    const FVector3f Max3f(Box.Max);
+
+    return VisitOverlapping(Box.Min, Box.Max, [this, &Min3f, &Max3f](int32 Idx)
+    {
+        return InstanceOverlapsBox(Idx, Min3f, Max3f);
+    }, Visitor);
+}
+
+bool FISMSpatialIndex::ForEachInstanceOverlappingSphere(const FVector& Center, float Radius, TFunctionRef<bool(int32)> Visitor) const
+{
+    if (Radius < 0.0f)
+    {
+        return true;
+    }
+
+    const FVector3f Center3f(Center);
+    const float RadiusSq = Radius * Radius;
+
+    return VisitOverlapping(Center - FVector(Radius), Center + FVector(Radius), [this, &Center3f, RadiusSq](int32 Idx)
+    {
+        return InstanceOverlapsSphere(Idx, Center3f, RadiusSq);
+    }, Visitor);
+}
+
+void FISMSpatialIndex::AppendCellInstancesInSphere(TArrayView<const int32> CellInstances, const FVector3f& Center, float RadiusSq, TArray<int32>& OutInstances) const
+{
+    VisitCellInstancesInSphere(CellInstances, Center, RadiusSq, [&OutInstances](int32 Idx)
+    {
+        OutInstances.Add(Idx);
+        return true;
+    });
+}
+
+void FISMSpatialIndex::AppendCellInstancesInBox(TArrayView<const int32> CellInstances, const FVector3f& Min, const FVector3f& Max, TArray<int32>& OutInstances) const
+{
+    VisitCellInstancesInBox(CellInstances, Min, Max, [&OutInstances](int32 Idx)
+    {
+        OutInstances.Add(Idx);
+        return true;
+    });
+}
+
+int32 FISMSpatialIndex::FindNearestInstance(
+    const FVector& Location,
+    const TArray<FVector>& InstanceLocations,
+    float MaxDistance) const
+{
+    // Start with a reasonable search radius
+    float SearchRadius = MaxDistance > 0.0f ? MaxDistance : CellSize * 2.0f;
+
+    int32 NearestIndex = INDEX_NONE;
+    float NearestDistSq = MaxDistance > 0.0f ? (MaxDistance * MaxDistance) : MAX_FLT;
+
+    // Expand search if needed
+    const int32 MaxSearchIterations = 5; // Prevent infinite loops
+    int32 SearchIteration = 0;
+
+    while (NearestIndex == INDEX_NONE && SearchIteration < MaxSearchIterations)
+    {
+        TArray<int32> CandidateIndices;
+        QueryRadius(Location, SearchRadius, CandidateIndices);
+
+        // Check actual distances
+        for (int32 CandidateIndex : CandidateIndices)
+        {
+            if (!InstanceLocations.IsValidIndex(CandidateIndex))
+            {
+                continue;
+            }
+
+            float DistSq = FVector::DistSquared(Location, InstanceLocations[CandidateIndex]);
+
+            if (DistSq < NearestDistSq)
+            {
+                NearestDistSq = DistSq;
+                NearestIndex = CandidateIndex;
+            }
+        }
+
+        // If we found something or we're at max distance, stop
+        if (NearestIndex != INDEX_NONE || (MaxDistance > 0.0f && SearchRadius >= MaxDistance))
+        {
+            break;
+        }
+
+        // Expand search radius
+        SearchRadius *= 2.0f;
+        SearchIteration++;
+    }
+
+    return NearestIndex;
+}
+
+bool FISMSpatialIndex::InstanceRayEntry(int32 InstanceIndex, const FVector3f& Origin, const FVector3f& InvDir, float MaxT, float Inflate, float& OutT) const
+{
+    FVector3f BoxMin;
+    FVector3f BoxMax;
+    if (BoundsValid.IsValidIndex(InstanceIndex) && BoundsValid[InstanceIndex])
+    {
+        BoxMin = BoundsMin[InstanceIndex];
+        BoxMax = BoundsMax[InstanceIndex];
+    }
+    else if (InstanceIndex < PositionsX.Num())
+    {
+        BoxMin = BoxMax = FVector3f(PositionsX[InstanceIndex], PositionsY[InstanceIndex], PositionsZ[InstanceIndex]);
+    }
+    else
+    {
+        return false;
+    }
+
+    BoxMin -= FVector3f(Inflate);
+    BoxMax += FVector3f(Inflate);
+
+    float TEnter = 0.0f;
+    float TExit = MaxT;
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        if (InvDir[Axis] == 0.0f)
+        {
+            // Parallel to this slab: must already be inside it
+            if (Origin[Axis] < BoxMin[Axis] || Origin[Axis] > BoxMax[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float T0 = (BoxMin[Axis] - Origin[Axis]) * InvDir[Axis];
+        float T1 = (BoxMax[Axis] - Origin[Axis]) * InvDir[Axis];
+        if (T0 > T1)
+        {
+            Swap(T0, T1);
+        }
+
+        TEnter = FMath::Max(TEnter, T0);
+        TExit = FMath::Min(TExit, T1);
+        if (TEnter > TExit)
+        {
+            return false;
+        }
+    }
+
+    OutT = TEnter;
+    return true;
+}
+
+void FISMSpatialIndex::QueryRay(const FVector& Start, const FVector& End, float Radius, TArray<FISMSpatialRayHit>& OutHits, bool bFirstHitOnly) const
+{
+    QueryRay(Start, End, Radius, OutHits, bFirstHitOnly, [](int32) { return true; });
+}
+
+void FISMSpatialIndex::QueryRay(const FVector& Start, const FVector& End, float Radius, TArray<FISMSpatialRayHit>& OutHits, bool bFirstHitOnly,
+    TFunctionRef<bool(int32)> Filter) const
+{
+    QueryRayRefined(Start, End, Radius, OutHits, bFirstHitOnly, [&Filter](int32 Idx, float&)
+    {
+        return Filter(Idx);
+    });
+}
+
+void FISMSpatialIndex::QueryRayRefined(const FVector& Start, const FVector& End, float Radius, TArray<FISMSpatialRayHit>& OutHits, bool bFirstHitOnly,
+    TFunctionRef<bool(int32, float&)> Refine) const
+{
+    OutHits.Reset();
+
+    const FVector Delta = End - Start;
+    const float Length = static_cast<float>(Delta.Size());
+    if (Length <= KINDA_SMALL_NUMBER)
+    {
+        return;
+    }
+
+    Radius = FMath::Max(Radius, 0.0f);
+    const FVector Dir = Delta / Length;
+    const FVector3f Origin3f(Start);
+    // Zero marks an axis the ray is parallel to
+    const FVector3f InvDir(
+        Dir.X != 0.0 ? 1.0f / static_cast<float>(Dir.X) : 0.0f,
+        Dir.Y != 0.0 ? 1.0f / static_cast<float>(Dir.Y) : 0.0f,
+        Dir.Z != 0.0 ? 1.0f / static_cast<float>(Dir.Z) : 0.0f);
+
+    auto TestInstance = [this, &Origin3f, &InvDir, Length, Radius, &Refine, &OutHits](int32 Idx)
+    {
+        float T = 0.0f;
+        if (InstanceRayEntry(Idx, Origin3f, InvDir, Length, Radius, T) && Refine(Idx, T))
+        {
+            FISMSpatialRayHit& Hit = OutHits.AddDefaulted_GetRef();
+            Hit.InstanceIndex = Idx;
+            Hit.Distance = T;
+        }
+    };
+
+    // Oversized instances are never found through the cell walk
+    for (int32 Idx : OversizedInstances)
+    {
+        TestInstance(Idx);
+    }
+
+    // Any hit at ray parameter t has its pivot within Pad of the ray point at t, so visiting
+    // a block of BlockRadius cells around each DDA cell finds every hit by the time the walk gets there
+    const float Pad = MaxBoundsReach + Radius;
+    const int32 BlockRadius = FMath::CeilToInt(Pad / CellSize);
+    TSet<FIntVector> VisitedCells;
+
+    auto VisitCell = [this, &TestInstance](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        for (int32 Idx : CellInstances)
+        {
+            if (Idx >= 0 && !(BoundsOversized.IsValidIndex(Idx) && BoundsOversized[Idx]))
+            {
+                TestInstance(Idx);
+            }
+        }
+    };
+
+    auto VisitBlock = [this, BlockRadius, &VisitedCells, &VisitCell](const FIntVector& DDACell)
+    {
+        if (BlockRadius == 0)
+        {
+            ForEachCellInRange(DDACell, DDACell, VisitCell);
+            return;
+        }
+
+        const FIntVector Span(BlockRadius);
+        const FIntVector BlockMin = DDACell - Span;
+        const FIntVector BlockMax = DDACell + Span;
+        for (int32 X = BlockMin.X; X <= BlockMax.X; X++)
+        {
+            for (int32 Y = BlockMin.Y; Y <= BlockMax.Y; Y++)
+            {
+                for (int32 Z = BlockMin.Z; Z <= BlockMax.Z; Z++)
+                {
+                    const FIntVector CellCoord(X, Y, Z);
+                    bool bAlreadyVisited = false;
+                    VisitedCells.Add(CellCoord, &bAlreadyVisited);
+                    if (!bAlreadyVisited)
+                    {
+                        ForEachCellInRange(CellCoord, CellCoord, VisitCell);
+                    }
+                }
+            }
+        }
+    };
+
+    // Amanatides-Woo traversal over base cells
+    FIntVector Cell = WorldLocationToCell(Start);
+    const FIntVector EndCell = WorldLocationToCell(End);
+    FIntVector Step;
+    FVector3f TMax;
+    FVector3f TDelta;
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        const double D = Dir[Axis];
+        Step[Axis] = D > 0.0 ? 1 : (D < 0.0 ? -1 : 0);
+        if (Step[Axis] == 0)
+        {
+            TMax[Axis] = MAX_flt;
+            TDelta[Axis] = MAX_flt;
+            continue;
+        }
+
+        const double Boundary = (Cell[Axis] + (Step[Axis] > 0 ? 1 : 0)) * static_cast<double>(CellSize);
+        TMax[Axis] = static_cast<float>((Boundary - Start[Axis]) / D);
+        TDelta[Axis] = static_cast<float>(CellSize / FMath::Abs(D));
+    }
+
+    const int32 MaxSteps = FMath::Abs(EndCell.X - Cell.X) + FMath::Abs(EndCell.Y - Cell.Y) + FMath::Abs(EndCell.Z - Cell.Z) + 1;
+    float TCellEnter = 0.0f;
+    float BestT = MAX_flt;
+    int32 NumTested = 0;
+
+    for (int32 StepIdx = 0; StepIdx < MaxSteps; StepIdx++)
+    {
+        // Every hit closer than this cell's entry has already been found
+        if (bFirstHitOnly && BestT <= TCellEnter)
+        {
+            break;
+        }
+
+        VisitBlock(Cell);
+
+        if (bFirstHitOnly)
+        {
+            for (; NumTested < OutHits.Num(); NumTested++)
+            {
+                BestT = FMath::Min(BestT, OutHits[NumTested].Distance);
+            }
+        }
+
+        if (Cell == EndCell)
+        {
+            break;
+        }
+
+        const int32 Axis = (TMax.X < TMax.Y) ? (TMax.X < TMax.Z ? 0 : 2) : (TMax.Y < TMax.Z ? 1 : 2);
+        if (TMax[Axis] > Length)
+        {
+            break;
+        }
+
+        TCellEnter = TMax[Axis];
+        Cell[Axis] += Step[Axis];
+        TMax[Axis] += TDelta[Axis];
+    }
+
+    OutHits.Sort([](const FISMSpatialRayHit& A, const FISMSpatialRayHit& B)
+    {
+        return A.Distance < B.Distance;
+    });
+
+    if (bFirstHitOnly && OutHits.Num() > 1)
+    {
+        OutHits.SetNum(1, EAllowShrinking::No);
+    }
+}
+
+void FISMSpatialIndex::FindKNearest(const FVector& Location, int32 K, TArray<FISMSpatialNeighbor>& OutNeighbors, float MaxDistance) const
+{
+    FindKNearest(Location, K, OutNeighbors, MaxDistance, [](int32) { return true; });
+}
+
+void FISMSpatialIndex::FindKNearest(
+    const FVector& Location,
+    int32 K,
+    TArray<FISMSpatialNeighbor>& OutNeighbors,
+    float MaxDistance,
+    TFunctionRef<bool(int32)> Filter) const
+{
+    OutNeighbors.Reset();
+
+    if (K <= 0 || !bHasOccupiedCells)
+    {
+        return;
+    }
+
+    const float MaxDistSq = MaxDistance > 0.0f ? MaxDistance * MaxDistance : MAX_flt;
+    const FIntVector CenterCell = WorldLocationToCell(Location);
+    const FVector3f Loc3f(Location);
+
+    // Rings before FirstRing / after LastRing contain no occupied cell
+    int32 FirstRing = 0;
+    int32 LastRing = 0;
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        const int32 Center = CenterCell[Axis];
+        FirstRing = FMath::Max(FirstRing, FMath::Max(OccupiedMinCell[Axis] - Center, Center - OccupiedMaxCell[Axis]));
+        LastRing = FMath::Max(LastRing, FMath::Max(Center - OccupiedMinCell[Axis], OccupiedMaxCell[Axis] - Center));
+    }
+    if (MaxDistance > 0.0f)
+    {
+        LastRing = FMath::Min(LastRing, FMath::CeilToInt(MaxDistance / CellSize) + 1);
+    }
+
+    // Max-heap on distance: HeapTop() is the current K-th nearest
+    auto FartherFirst = [](const FISMSpatialNeighbor& A, const FISMSpatialNeighbor& B)
+    {
+        return A.DistanceSq > B.DistanceSq;
+    };
+
+    OutNeighbors.Reserve(K);
+
+    auto VisitCell = [this, K, MaxDistSq, &Loc3f, &Filter, &FartherFirst, &OutNeighbors](const FIntVector&, TArrayView<const int32> CellInstances)
+    {
+        for (int32 Idx : CellInstances)
+        {
+            if (Idx < 0 || Idx >= PositionsX.Num())
+            {
+                continue;
+            }
+
+            const float DX = PositionsX[Idx] - Loc3f.X;
+            const float DY = PositionsY[Idx] - Loc3f.Y;
+            const float DZ = PositionsZ[Idx] - Loc3f.Z;
+            const float DistSq = DX * DX + DY * DY + DZ * DZ;
+
+            if (DistSq > MaxDistSq || (OutNeighbors.Num() == K && DistSq >= OutNeighbors.HeapTop().DistanceSq))
+            {
+                continue;
+            }
+
+            // Filter last - it may be far more expensive than the distance test
+            if (!Filter(Idx))
+            {
+                continue;
+            }
+
+            if (OutNeighbors.Num() == K)
+            {
+                OutNeighbors.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
+            }
+
+            FISMSpatialNeighbor Neighbor;
+            Neighbor.InstanceIndex = Idx;
+            Neighbor.DistanceSq = DistSq;
+            OutNeighbors.HeapPush(Neighbor, FartherFirst);
+        }
+    };
+
+    for (int32 Ring = FirstRing; Ring <= LastRing; Ring++)
+    {
+        if (Ring > 0)
+        {
+            // Everything in this ring lies outside the cube of cells within Ring-1,
+            // so its distance is at least the distance to that cube's nearest face
+            float RingDist = MAX_flt;
+            for (int32 Axis = 0; Axis < 3; Axis++)
+            {
+                const float CubeMin = (CenterCell[Axis] - (Ring - 1)) * CellSize;
+                const float CubeMax = (CenterCell[Axis] + Ring) * CellSize;
+                RingDist = FMath::Min(RingDist, FMath::Min(Loc3f[Axis] - CubeMin, CubeMax - Loc3f[Axis]));
+            }
+
+            const float RingDistSq = FMath::Square(FMath::Max(RingDist, 0.0f));
+            if (RingDistSq > MaxDistSq || (OutNeighbors.Num() == K && RingDistSq >= OutNeighbors.HeapTop().DistanceSq))
+            {
+                break;
+            }
+        }
+
+        ForEachCellInRing(CenterCell, Ring, VisitCell);
+    }
+
+    OutNeighbors.Sort([](const FISMSpatialNeighbor& A, const FISMSpatialNeighbor& B)
+    {
+        return A.DistanceSq < B.DistanceSq;
+    });
+}
+
+void FISMSpatialIndex::GrowOccupiedCells(const FIntVector& CellCoord)
+{
+    if (!bHasOccupiedCells)
+    {
+        OccupiedMinCell = CellCoord;
+        OccupiedMaxCell = CellCoord;
+        bHasOccupiedCells = true;
+        return;
+    }
+
+    OccupiedMinCell = FIntVector(
+        FMath::Min(OccupiedMinCell.X, CellCoord.X),
+        FMath::Min(OccupiedMinCell.Y, CellCoord.Y),
+        FMath::Min(OccupiedMinCell.Z, CellCoord.Z));
+    OccupiedMaxCell = FIntVector(
+        FMath::Max(OccupiedMaxCell.X, CellCoord.X),
+        FMath::Max(OccupiedMaxCell.Y, CellCoord.Y),
+        FMath::Max(OccupiedMaxCell.Z, CellCoord.Z));
+}
+
+void FISMSpatialIndex::Clear()
+{
+    ++Revision;
+    Cells.Empty();
+    FlatCellKeys.Empty();
+    FlatCellOffsets.Empty();
+    FlatInstances.Empty();
+    FlatTombstoneCount = 0;
+    OverlayInstanceCount = 0;
+    PositionsX.Empty();
+    PositionsY.Empty();
+    PositionsZ.Empty();
+    PositionValid.Empty();
+    BoundsMin.Empty();
+    BoundsMax.Empty();
+    BoundsValid.Empty();
+    BoundsOversized.Empty();
+    OversizedInstances.Empty();
+    MaxBoundsReach = 0.0f;
+    InstanceTagMasks.Empty();
+    InstanceTagCells.Empty();
+    CellTagMasks.Empty();
+    bTrackTagMasks = false;
+    bHasOccupiedCells = false;
+    RemovalsSinceShrink = 0;
+
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
+    {
+        Level.Cells.Empty();
+    }
+}
+
+void FISMSpatialIndex::Rebuild(const TArray<FVector>& InstanceLocations)
+{
+    TArray<FIntVector> InstanceCells;
+    InstanceCells.SetNumUninitialized(InstanceLocations.Num());
+    for (int32 i = 0; i < InstanceLocations.Num(); i++)
+    {
+        InstanceCells[i] = WorldLocationToCell(InstanceLocations[i]);
+    }
+
+    Rebuild(InstanceLocations, InstanceCells);
+}
+
+void FISMSpatialIndex::Rebuild(TConstArrayView<FVector> InstanceLocations, TConstArrayView<FIntVector> InstanceCells)
+{
+    Clear();
+
+    if (!ensure(InstanceCells.Num() == InstanceLocations.Num()))
+    {
+        return;
+    }
+
+    // Size the packed position streams once up front; every index is written below
+    const int32 NumInstances = InstanceLocations.Num();
+    PositionsX.SetNumUninitialized(NumInstances);
+    PositionsY.SetNumUninitialized(NumInstances);
+    PositionsZ.SetNumUninitialized(NumInstances);
+    PositionValid.Init(true, NumInstances);
+    for (int32 i = 0; i < NumInstances; i++)
+    {
+        PositionsX[i] = static_cast<float>(InstanceLocations[i].X);
+        PositionsY[i] = static_cast<float>(InstanceLocations[i].Y);
+        PositionsZ[i] = static_cast<float>(InstanceLocations[i].Z);
+    }
+
+    if (Storage == EISMSpatialIndexStorage::Flat)
+    {
+        // Build the contiguous buffer directly - no per-cell allocations
+        TArray<TPair<FIntVector, int32>> Pairs;
+        Pairs.Reserve(NumInstances);
+        for (int32 i = 0; i < NumInstances; i++)
+        {
+            Pairs.Emplace(InstanceCells[i], i);
+        }
+
+        BuildFlatFromPairs(Pairs);
+    }
+    else
+    {
+        // Reserve space based on instance count
+        Cells.Reserve(FMath::Max(64, NumInstances / 10));
+
+        // Indices are unique, so skip AddToBaseGrid's duplicate scan of each cell
+        for (int32 i = 0; i < NumInstances; i++)
+        {
+            GrowOccupiedCells(InstanceCells[i]);
+            Cells.FindOrAdd(InstanceCells[i]).Add(i);
+        }
+    }
+
+    // Coarse levels: indices are unique per Rebuild, so plain Add without dedup
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
+    {
+        for (int32 i = 0; i < NumInstances; i++)
+        {
+            Level.Cells.FindOrAdd(LocationToCell(InstanceLocations[i], Level.CellSize)).Add(i);
+        }
+    }
+
+    ++Revision;
+}
+
+void FISMSpatialIndex::ExportCells(TArray<FIntVector>& OutCellKeys, TArray<int32>& OutCellOffsets, TArray<int32>& OutInstances) const
+{
+    TArray<TPair<FIntVector, int32>> Pairs;
+    Pairs.Reserve(FlatInstances.Num() - FlatTombstoneCount + OverlayInstanceCount);
+
+    for (int32 CellIdx = 0; CellIdx < FlatCellKeys.Num(); CellIdx++)
+    {
+        for (int32 i = FlatCellOffsets[CellIdx]; i < FlatCellOffsets[CellIdx + 1]; i++)
+        {
+            if (FlatInstances[i] != INDEX_NONE)
+            {
+                Pairs.Emplace(FlatCellKeys[CellIdx], FlatInstances[i]);
+            }
+        }
+    }
+
+    // Hashed cells, or the Flat overlay
+    for (const auto& Pair : Cells)
+    {
+        for (int32 InstanceIndex : Pair.Value)
+        {
+            Pairs.Emplace(Pair.Key, InstanceIndex);
+        }
+    }
+
+    Pairs.Sort([](const TPair<FIntVector, int32>& A, const TPair<FIntVector, int32>& B)
+    {
+        if (A.Key != B.Key)
+        {
+            return CellKeyLess(A.Key, B.Key);
+        }
+        return A.Value < B.Value;
+    });
+
+    OutCellKeys.Reset();
+    OutCellOffsets.Reset();
+    OutInstances.Reset(Pairs.Num());
+    for (const TPair<FIntVector, int32>& Pair : Pairs)
+    {
+        if (OutCellKeys.Num() == 0 || OutCellKeys.Last() != Pair.Key)
+        {
+            OutCellKeys.Add(Pair.Key);
+            OutCellOffsets.Add(OutInstances.Num());
+        }
+        OutInstances.Add(Pair.Value);
+    }
+    OutCellOffsets.Add(OutInstances.Num());
+}
+
+bool FISMSpatialIndex::ImportCells(TConstArrayView<FIntVector> CellKeys, TConstArrayView<int32> CellOffsets, TConstArrayView<int32> Instances,
+    TConstArrayView<FVector> InstanceLocations)
+{
+    Clear();
+
+    // Same shape ExportCells writes: ascending keys, monotonic offsets covering every instance
+    if (CellOffsets.Num() != CellKeys.Num() + 1 || CellOffsets[0] != 0 || CellOffsets.Last() != Instances.Num())
+    {
+        return false;
+    }
+    for (int32 CellIdx = 0; CellIdx < CellKeys.Num(); CellIdx++)
+    {
+        if (CellOffsets[CellIdx] > CellOffsets[CellIdx + 1] || (CellIdx > 0 && !CellKeyLess(CellKeys[CellIdx - 1], CellKeys[CellIdx])))
+        {
+            return false;
+        }
+    }
+    for (const int32 InstanceIndex : Instances)
+    {
+        if (!InstanceLocations.IsValidIndex(InstanceIndex))
+        {
+            return false;
+        }
+    }
+
+    PositionsX.SetNumZeroed(InstanceLocations.Num());
+    PositionsY.SetNumZeroed(InstanceLocations.Num());
+    PositionsZ.SetNumZeroed(InstanceLocations.Num());
+    PositionValid.Init(false, InstanceLocations.Num());
+    for (const int32 InstanceIndex : Instances)
+    {
+        StorePosition(InstanceIndex, InstanceLocations[InstanceIndex]);
+    }
+
+    for (const FIntVector& CellCoord : CellKeys)
+    {
+        GrowOccupiedCells(CellCoord);
+    }
+
+    if (Storage == EISMSpatialIndexStorage::Flat)
+    {
+        FlatCellKeys.Append(CellKeys.GetData(), CellKeys.Num());
+        FlatCellOffsets.Append(CellOffsets.GetData(), CellOffsets.Num());
+        FlatInstances.Append(Instances.GetData(), Instances.Num());
+    }
+    else
+    {
+        Cells.Reserve(CellKeys.Num());
+        for (int32 CellIdx = 0; CellIdx < CellKeys.Num(); CellIdx++)
+        {
+            TArray<int32>& Cell = Cells.Add(CellKeys[CellIdx]);
+            Cell.Append(Instances.GetData() + CellOffsets[CellIdx], CellOffsets[CellIdx + 1] - CellOffsets[CellIdx]);
+        }
+    }
+
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
+    {
+        for (const int32 InstanceIndex : Instances)
+        {
+            Level.Cells.FindOrAdd(LocationToCell(InstanceLocations[InstanceIndex], Level.CellSize)).Add(InstanceIndex);
+        }
+    }
+
+    ++Revision;
+    return true;
+}
+
+void FISMSpatialIndex::SetHierarchyLevels(int32 NumLevels, int32 LevelScale)
+{
+    ++Revision;
+
+    NumLevels = FMath::Clamp(NumLevels, 1, MaxHierarchyLevels);
+    LevelScale = FMath::Max(2, LevelScale);
+
+    CoarseLevels.Reset();
+    CoarseLevels.SetNum(NumLevels - 1);
+
+    float LevelCellSize = CellSize;
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
+    {
+        // Integer scale keeps levels nested: a base-cell move that stays in its
+        // cell can never change the coarse cell either
+        LevelCellSize *= static_cast<float>(LevelScale);
+        Level.CellSize = LevelCellSize;
+    }
 
-    // Get or create cell
-    TArray<int32>& Cell = Cells.FindOrAdd(CellCoord);
+    if (CoarseLevels.Num() == 0)
+    {
+        return;
+    }
 
-    // Avoid duplicates (shouldn't happen in normal usage, but be safe)
-    Cell.AddUnique(InstanceIndex);
+    // Populate from stored positions of everything currently indexed
+    for (TConstSetBitIterator<> It(PositionValid); It; ++It)
+    {
+        const int32 i = It.GetIndex();
+        AddToCoarseLevels(i, FVector(PositionsX[i], PositionsY[i], PositionsZ[i]));
+    }
 }
 
-void FISMSpatialIndex::RemoveInstance(int32 InstanceIndex, const FVector& Location)
+int32 FISMSpatialIndex::SelectQueryLevel(float HalfExtent) const
 {
-    FIntVector CellCoord = WorldLocationToCell(Location);
-
-    if (TArray<int32>* Cell = Cells.Find(CellCoord))
+    // Base cells already at least half the query extent: at most ~6 cells per axis
+    if (CoarseLevels.Num() == 0 || CellSize * 2.0f >= HalfExtent)
     {
-        // Remove the instance
-        Cell->Remove(InstanceIndex);
+        return INDEX_NONE;
+    }
 
-        // Clean up empty cells to save memory
-        if (Cell->Num() == 0)
+    for (int32 LevelIdx = 0; LevelIdx < CoarseLevels.Num(); LevelIdx++)
+    {
+        if (CoarseLevels[LevelIdx].CellSize * 2.0f >= HalfExtent)
         {
-            Cells.Remove(CellCoord);
+            return LevelIdx;
         }
     }
+
+    return CoarseLevels.Num() - 1;
 }
 
-void FISMSpatialIndex::UpdateInstance(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation)
+FIntVector FISMSpatialIndex::LocationToCell(const FVector& Location, float InCellSize)
 {
-    FIntVector OldCell = WorldLocationToCell(OldLocation);
-    FIntVector NewCell = WorldLocationToCell(NewLocation);
+    return FIntVector(
+        FMath::FloorToInt(Location.X / InCellSize),
+        FMath::FloorToInt(Location.Y / InCellSize),
+        FMath::FloorToInt(Location.Z / InCellSize)
+    );
+}
 
-    // Only update if cell changed (common case: instance moves within same cell)
-    if (OldCell != NewCell)
+void FISMSpatialIndex::AddToCoarseLevels(int32 InstanceIndex, const FVector& Location)
+{
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
     {
-        RemoveInstance(InstanceIndex, OldLocation);
-        AddInstance(InstanceIndex, NewLocation);
+        Level.Cells.FindOrAdd(LocationToCell(Location, Level.CellSize)).Add(InstanceIndex);
     }
 }
 
-void FISMSpatialIndex::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutInstances) const
+void FISMSpatialIndex::RemoveFromCoarseLevels(int32 InstanceIndex, const FVector& Location)
 {
-    OutInstances.Reset();
-
-    // Calculate AABB of the sphere
-    FVector Min = Center - FVector(Radius);
-    FVector Max = Center + FVector(Radius);
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
+    {
+        const FIntVector CellCoord = LocationToCell(Location, Level.CellSize);
+        if (TArray<int32>* Cell = Level.Cells.Find(CellCoord))
+        {
+            // Coarse cells are unordered - swap removal avoids shifting large arrays
+            Cell->RemoveSingleSwap(InstanceIndex, EAllowShrinking::No);
+            if (Cell->Num() == 0)
+            {
+                Level.Cells.Remove(CellCoord);
+            }
+        }
+    }
+}
 
-    FIntVector MinCell = WorldLocationToCell(Min);
-    FIntVector MaxCell = WorldLocationToCell(Max);
+void FISMSpatialIndex::SetStorageMode(EISMSpatialIndexStorage NewStorage)
+{
+    ++Revision;
 
-    // Reserve approximate space
-    int32 EstimatedResults = (MaxCell.X - MinCell.X + 1) *
-        (MaxCell.Y - MinCell.Y + 1) *
-        (MaxCell.Z - MinCell.Z + 1) * 10; // Assume ~10 per cell
-    OutInstances.Reserve(EstimatedResults);
+    if (NewStorage == Storage)
+    {
+        return;
+    }
 
-    // Iterate overlapping cells
-    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    if (NewStorage == EISMSpatialIndexStorage::Flat)
     {
-        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        // Hashed -> Flat: everything currently in Cells becomes the flat buffer
+        TArray<TPair<FIntVector, int32>> Pairs;
+        Pairs.Reserve(GetTotalInstances());
+
+        for (const auto& Pair : Cells)
         {
-            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+            for (int32 InstanceIndex : Pair.Value)
             {
-                FIntVector CellCoord(X, Y, Z);
+                Pairs.Emplace(Pair.Key, InstanceIndex);
+            }
+        }
 
-                if (const TArray<int32>* Cell = Cells.Find(CellCoord))
-                {
-                    OutInstances.Append(*Cell);
-                }
+        Cells.Empty();
+        OverlayInstanceCount = 0;
+        Storage = NewStorage;
+        BuildFlatFromPairs(Pairs);
+        return;
+    }
+
+    // Flat -> Hashed: fold flat entries into the overlay map, which becomes the primary store
+    for (int32 CellIdx = 0; CellIdx < FlatCellKeys.Num(); CellIdx++)
+    {
+        TArray<int32>& Cell = Cells.FindOrAdd(FlatCellKeys[CellIdx]);
+        for (int32 i = FlatCellOffsets[CellIdx]; i < FlatCellOffsets[CellIdx + 1]; i++)
+        {
+            if (FlatInstances[i] != INDEX_NONE)
+            {
+                Cell.AddUnique(FlatInstances[i]);
             }
         }
+
+        if (Cell.Num() == 0)
+        {
+            Cells.Remove(FlatCellKeys[CellIdx]);
+        }
     }
 
-    // Note: Results may include instances outside the sphere.
-    // Caller should do precise distance check if needed.
+    FlatCellKeys.Empty();
+    FlatCellOffsets.Empty();
+    FlatInstances.Empty();
+    FlatTombstoneCount = 0;
+    OverlayInstanceCount = 0;
+    Storage = NewStorage;
 }
 
-void FISMSpatialIndex::QueryBox(const FBox& Box, TArray<int32>& OutInstances) const
+void FISMSpatialIndex::CompactFlatStorage()
 {
-    OutInstances.Reset();
+    if (Storage != EISMSpatialIndexStorage::Flat)
+    {
+        return;
+    }
 
-    FIntVector MinCell = WorldLocationToCell(Box.Min);
-    FIntVector MaxCell = WorldLocationToCell(Box.Max);
+    if (FlatTombstoneCount == 0 && OverlayInstanceCount == 0)
+    {
+        return;
+    }
 
-    // Reserve approximate space
-    int32 EstimatedResults = (MaxCell.X - MinCell.X + 1) *
-        (MaxCell.Y - MinCell.Y + 1) *
-        (MaxCell.Z - MinCell.Z + 1) * 10;
-    OutInstances.Reserve(EstimatedResults);
+    TArray<TPair<FIntVector, int32>> Pairs;
+    Pairs.Reserve(FlatInstances.Num() - FlatTombstoneCount + OverlayInstanceCount);
 
-    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    for (int32 CellIdx = 0; CellIdx < FlatCellKeys.Num(); CellIdx++)
     {
-        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        for (int32 i = FlatCellOffsets[CellIdx]; i < FlatCellOffsets[CellIdx + 1]; i++)
         {
-            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+            if (FlatInstances[i] != INDEX_NONE)
             {
-                if (const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z)))
-                {
-                    OutInstances.Append(*Cell);
-                }
+                Pairs.Emplace(FlatCellKeys[CellIdx], FlatInstances[i]);
             }
         }
     }
+
+    for (const auto& Pair : Cells)
+    {
+        for (int32 InstanceIndex : Pair.Value)
+        {
+            Pairs.Emplace(Pair.Key, InstanceIndex);
+        }
+    }
+
+    Cells.Reset();
+    OverlayInstanceCount = 0;
+    BuildFlatFromPairs(Pairs);
 }
 
-int32 FISMSpatialIndex::FindNearestInstance(
-    const FVector& Location,
-    const TArray<FVector>& InstanceLocations,
-    float MaxDistance) const
+void FISMSpatialIndex::BuildFlatFromPairs(TArray<TPair<FIntVector, int32>>& Pairs)
 {
-    // Start with a reasonable search radius
-    float SearchRadius = MaxDistance > 0.0f ? MaxDistance : CellSize * 2.0f;
-
-    int32 NearestIndex = INDEX_NONE;
-    float NearestDistSq = MaxDistance > 0.0f ? (MaxDistance * MaxDistance) : MAX_FLT;
+    // Sort by cell, then instance index so each cell's slice is deterministic
+    Pairs.Sort([](const TPair<FIntVector, int32>& A, const TPair<FIntVector, int32>& B)
+    {
+        if (A.Key != B.Key)
+        {
+            return CellKeyLess(A.Key, B.Key);
+        }
+        return A.Value < B.Value;
+    });
 
-    // Expand search if needed
-    const int32 MaxSearchIterations = 5; // Prevent infinite loops
-    int32 SearchIteration = 0;
+    FlatCellKeys.Reset();
+    FlatCellOffsets.Reset();
+    FlatInstances.Reset(Pairs.Num());
+    FlatTombstoneCount = 0;
 
-    while (NearestIndex == INDEX_NONE && SearchIteration < MaxSearchIterations)
+    for (int32 i = 0; i < Pairs.Num(); i++)
     {
-        TArray<int32> CandidateIndices;
-        QueryRadius(Location, SearchRadius, CandidateIndices);
-
-        // Check actual distances
-        for (int32 CandidateIndex : CandidateIndices)
+        const bool bNewCell = FlatCellKeys.Num() == 0 || FlatCellKeys.Last() != Pairs[i].Key;
+        if (bNewCell)
         {
-            if (!InstanceLocations.IsValidIndex(CandidateIndex))
-            {
-                continue;
-            }
+            GrowOccupiedCells(Pairs[i].Key);
+            FlatCellKeys.Add(Pairs[i].Key);
+            FlatCellOffsets.Add(FlatInstances.Num());
+        }
+        else if (FlatInstances.Last() == Pairs[i].Value)
+        {
+            // Duplicate (cell, instance) - keep one
+            continue;
+        }
 
-            float DistSq = FVector::DistSquared(Location, InstanceLocations[CandidateIndex]);
+        FlatInstances.Add(Pairs[i].Value);
+    }
 
-            if (DistSq < NearestDistSq)
-            {
-                NearestDistSq = DistSq;
-                NearestIndex = CandidateIndex;
-            }
-        }
+    FlatCellOffsets.Add(FlatInstances.Num());
+}
 
-        // If we found something or we're at max distance, stop
-        if (NearestIndex != INDEX_NONE || (MaxDistance > 0.0f && SearchRadius >= MaxDistance))
+bool FISMSpatialIndex::ShouldCompactFlat() const
+{
+    // Fold pending edits back once they reach 1/8 of the flat buffer (min 64)
+    // so the overlay never dominates query cost
+    const int32 Threshold = FMath::Max(64, FlatInstances.Num() / 8);
+    return (FlatTombstoneCount + OverlayInstanceCount) > Threshold;
+}
+
+int32 FISMSpatialIndex::FindFlatCell(const FIntVector& CellCoord) const
+{
+    const int32 Pos = Algo::LowerBound(FlatCellKeys, CellCoord, &FISMSpatialIndex::CellKeyLess);
+    if (FlatCellKeys.IsValidIndex(Pos) && FlatCellKeys[Pos] == CellCoord)
+    {
+        return Pos;
+    }
+    return INDEX_NONE;
+}
+
+void FISMSpatialIndex::AppendCellInstances(TArrayView<const int32> CellInstances, TArray<int32>& OutInstances)
+{
+    for (int32 InstanceIndex : CellInstances)
+    {
+        if (InstanceIndex != INDEX_NONE)
         {
-            break;
+            OutInstances.Add(InstanceIndex);
         }
+    }
+}
 
-        // Expand search radius
-        SearchRadius *= 2.0f;
-        SearchIteration++;
+int32 FISMSpatialIndex::GetCellCount() const
+{
+    if (Storage != EISMSpatialIndexStorage::Flat)
+    {
+        return Cells.Num();
     }
 
-    return NearestIndex;
+    // Overlay cells that also exist in the flat buffer are only counted once
+    int32 Count = FlatCellKeys.Num();
+    for (const auto& Pair : Cells)
+    {
+        if (FindFlatCell(Pair.Key) == INDEX_NONE)
+        {
+            Count++;
+        }
+    }
+    return Count;
 }
 
-void FISMSpatialIndex::Clear()
+void FISMSpatialIndex::ShrinkCellSlack(TArray<int32>& Cell)
 {
-    Cells.Empty();
+    if (Cell.GetSlack() > FMath::Max(4, Cell.Num()))
+    {
+        Cell.Shrink();
+    }
 }
 
-void FISMSpatialIndex::Rebuild(const TArray<FVector>& InstanceLocations)
+void FISMSpatialIndex::Shrink()
 {
-    Clear();
+    RemovalsSinceShrink = 0;
 
-    // Reserve space based on instance count
-    Cells.Reserve(FMath::Max(64, InstanceLocations.Num() / 10));
+    if (Storage == EISMSpatialIndexStorage::Flat && (FlatTombstoneCount > 0 || OverlayInstanceCount > 0))
+    {
+        CompactFlatStorage();
+    }
 
-    for (int32 i = 0; i < InstanceLocations.Num(); i++)
+    for (auto& Pair : Cells)
+    {
+        ShrinkCellSlack(Pair.Value);
+    }
+    Cells.Compact();
+    Cells.Shrink();
+
+    for (FISMSpatialGridLevel& Level : CoarseLevels)
+    {
+        for (auto& Pair : Level.Cells)
+        {
+            ShrinkCellSlack(Pair.Value);
+        }
+        Level.Cells.Compact();
+        Level.Cells.Shrink();
+    }
+
+    FlatCellKeys.Shrink();
+    FlatCellOffsets.Shrink();
+    FlatInstances.Shrink();
+    OversizedInstances.Shrink();
+
+    // Drop the bits removals and moves left behind in the tag unions
+    if (bTrackTagMasks)
+    {
+        RebuildCellTagMasks();
+        CellTagMasks.Shrink();
+    }
+
+    // Drop trailing slots that no longer hold an instance (position or bounds)
+    const int32 LastUsed = FMath::Max(PositionValid.FindLast(true), BoundsValid.FindLast(true));
+
+    const int32 NewPositionNum = FMath::Min(PositionsX.Num(), LastUsed + 1);
+    PositionsX.SetNum(NewPositionNum, EAllowShrinking::Yes);
+    PositionsY.SetNum(NewPositionNum, EAllowShrinking::Yes);
+    PositionsZ.SetNum(NewPositionNum, EAllowShrinking::Yes);
+    PositionValid.SetNum(NewPositionNum, false);
+
+    const int32 NewBoundsNum = FMath::Min(BoundsMin.Num(), LastUsed + 1);
+    BoundsMin.SetNum(NewBoundsNum, EAllowShrinking::Yes);
+    BoundsMax.SetNum(NewBoundsNum, EAllowShrinking::Yes);
+    BoundsValid.SetNum(NewBoundsNum, false);
+    BoundsOversized.SetNum(NewBoundsNum, false);
+}
+
+SIZE_T FISMSpatialIndex::GetAllocatedSize() const
+{
+    SIZE_T Size = Cells.GetAllocatedSize();
+    for (const auto& Pair : Cells)
+    {
+        Size += Pair.Value.GetAllocatedSize();
+    }
+
+    for (const FISMSpatialGridLevel& Level : CoarseLevels)
     {
-        AddInstance(i, InstanceLocations[i]);
+        Size += Level.Cells.GetAllocatedSize();
+        for (const auto& Pair : Level.Cells)
+        {
+            Size += Pair.Value.GetAllocatedSize();
+        }
     }
+
+    Size += CoarseLevels.GetAllocatedSize();
+    Size += FlatCellKeys.GetAllocatedSize() + FlatCellOffsets.GetAllocatedSize() + FlatInstances.GetAllocatedSize();
+    Size += PositionsX.GetAllocatedSize() + PositionsY.GetAllocatedSize() + PositionsZ.GetAllocatedSize();
+    Size += PositionValid.GetAllocatedSize();
+    Size += BoundsMin.GetAllocatedSize() + BoundsMax.GetAllocatedSize();
+    Size += BoundsValid.GetAllocatedSize() + BoundsOversized.GetAllocatedSize();
+    Size += OversizedInstances.GetAllocatedSize();
+    Size += InstanceTagMasks.GetAllocatedSize() + InstanceTagCells.GetAllocatedSize() + CellTagMasks.GetAllocatedSize();
+    return Size;
+}
+
+uint64 FISMSpatialIndex::EncodeMorton3D(uint32 X, uint32 Y, uint32 Z)
+{
+    // Spread 21 bits so each is followed by two zero bits
+    auto SpreadBits = [](uint64 V)
+    {
+        V &= 0x1fffff;
+        V = (V | (V << 32)) & 0x1f00000000ffffULL;
+        V = (V | (V << 16)) & 0x1f0000ff0000ffULL;
+        V = (V | (V << 8)) & 0x100f00f00f00f00fULL;
+        V = (V | (V << 4)) & 0x10c30c30c30c30c3ULL;
+        V = (V | (V << 2)) & 0x1249249249249249ULL;
+        return V;
+    };
+
+    return SpreadBits(X) | (SpreadBits(Y) << 1) | (SpreadBits(Z) << 2);
 }
 
 int32 FISMSpatialIndex::GetTotalInstances() const
 {
-    int32 Total = 0;
+    int32 Total = FlatInstances.Num() - FlatTombstoneCount;
     for (const auto& Pair : Cells)
     {
         Total += Pair.Value.Num();
@@ -202,18 +2545,25 @@ int32 FISMSpatialIndex::GetTotalInstances() const
 
 float FISMSpatialIndex::GetAverageInstancesPerCell() const
 {
-    if (Cells.Num() == 0)
+    const int32 CellCount = GetCellCount();
+    if (CellCount == 0)
     {
         return 0.0f;
     }
 
-    return static_cast<float>(GetTotalInstances()) / static_cast<float>(Cells.Num());
+    return static_cast<float>(GetTotalInstances()) / static_cast<float>(CellCount);
 }
 
 int32 FISMSpatialIndex::GetMaxInstancesPerCell() const
 {
     int32 MaxCount = 0;
 
+    // Flat counts include tombstones - close enough for tuning purposes
+    for (int32 CellIdx = 0; CellIdx < FlatCellKeys.Num(); CellIdx++)
+    {
+        MaxCount = FMath::Max(MaxCount, FlatCellOffsets[CellIdx + 1] - FlatCellOffsets[CellIdx]);
+    }
+
     for (const auto& Pair : Cells)
     {
         MaxCount = FMath::Max(MaxCount, Pair.Value.Num());
@@ -222,6 +2572,108 @@ int32 FISMSpatialIndex::GetMaxInstancesPerCell() const
     return MaxCount;
 }
 
+void FISMSpatialIndex::GetCellOccupancyHistogram(TArray<int32>& OutBuckets, int32 NumBuckets) const
+{
+    OutBuckets.Reset();
+    OutBuckets.SetNumZeroed(FMath::Max(NumBuckets, 1));
+    const int32 LastBucket = OutBuckets.Num() - 1;
+
+    auto AddCell = [&OutBuckets, LastBucket](int32 Count)
+    {
+        if (Count > 0)
+        {
+            OutBuckets[FMath::Min(static_cast<int32>(FMath::FloorLog2(static_cast<uint32>(Count))), LastBucket)]++;
+        }
+    };
+
+    for (int32 CellIdx = 0; CellIdx < FlatCellKeys.Num(); CellIdx++)
+    {
+        AddCell(FlatCellOffsets[CellIdx + 1] - FlatCellOffsets[CellIdx]);
+    }
+
+    for (const auto& Pair : Cells)
+    {
+        AddCell(Pair.Value.Num());
+    }
+}
+
+void FISMSpatialIndex::SetQueryTelemetryEnabled(bool bEnabled)
+{
+    if (!bEnabled)
+    {
+        QueryTelemetry.Reset();
+    }
+    else if (!QueryTelemetry.IsValid())
+    {
+        QueryTelemetry = MakeShared<FISMSpatialQueryTelemetry, ESPMode::ThreadSafe>();
+    }
+}
+
+void FISMSpatialIndex::ResetQueryTelemetry()
+{
+    if (QueryTelemetry.IsValid())
+    {
+        QueryTelemetry->Reset();
+    }
+}
+
+float FISMSpatialIndex::GetRecommendedCellSize() const
+{
+    return QueryTelemetry.IsValid() ? 2.0f * QueryTelemetry->GetMedianRadius() : 0.0f;
+}
+
+void FISMSpatialQueryTelemetry::Record(float Radius, int32 InNumCandidates, int32 InNumHits)
+{
+    NumQueries.fetch_add(1, std::memory_order_relaxed);
+    NumCandidates.fetch_add(static_cast<uint64>(InNumCandidates), std::memory_order_relaxed);
+    NumHits.fetch_add(static_cast<uint64>(InNumHits), std::memory_order_relaxed);
+    RadiusBuckets[GetRadiusBucket(Radius)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void FISMSpatialQueryTelemetry::Reset()
+{
+    NumQueries.store(0, std::memory_order_relaxed);
+    NumCandidates.store(0, std::memory_order_relaxed);
+    NumHits.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint32>& Bucket : RadiusBuckets)
+    {
+        Bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int32 FISMSpatialQueryTelemetry::GetRadiusBucket(float Radius)
+{
+    if (!(Radius >= MinBucketRadius * 2.0f))
+    {
+        return 0;
+    }
+    const int32 Bucket = FMath::FloorToInt32(FMath::Log2(Radius / MinBucketRadius));
+    return FMath::Clamp(Bucket, 0, NumRadiusBuckets - 1);
+}
+
+float FISMSpatialQueryTelemetry::GetMedianRadius() const
+{
+    uint64 Counts[NumRadiusBuckets];
+    uint64 Total = 0;
+    for (int32 Bucket = 0; Bucket < NumRadiusBuckets; Bucket++)
+    {
+        Counts[Bucket] = RadiusBuckets[Bucket].load(std::memory_order_relaxed);
+        Total += Counts[Bucket];
+    }
+
+    uint64 Seen = 0;
+    for (int32 Bucket = 0; Bucket < NumRadiusBuckets; Bucket++)
+    {
+        Seen += Counts[Bucket];
+        if (Total > 0 && Seen * 2 >= Total)
+        {
+            // Geometric center of [Min * 2^B, Min * 2^(B+1))
+            return MinBucketRadius * FMath::Pow(2.0f, Bucket + 0.5f);
+        }
+    }
+    return 0.0f;
+}
+
 FIntVector FISMSpatialIndex::WorldLocationToCell(const FVector& Location) const
 {
     // Use floor to ensure negative coordinates work correctly
@@ -254,18 +2706,15 @@ void FISMSpatialIndex::DebugDraw(UWorld* World, float Duration, bool bShowInstan
         return;
     }
 
-    for (const auto& Pair : Cells)
+    auto DrawCell = [&](const FIntVector& CellCoord, int32 NumInstances)
     {
-        const FIntVector& CellCoord = Pair.Key;
-        const TArray<int32>& Instances = Pair.Value;
-
         FBox CellBox = GetCellBounds(CellCoord);
 
         // Color based on instance density
         // Green = few instances (good)
         // Yellow = medium
         // Red = many instances (might want smaller cells)
-        float Density = FMath::Clamp(Instances.Num() / 50.0f, 0.0f, 1.0f);
+        float Density = FMath::Clamp(NumInstances / 50.0f, 0.0f, 1.0f);
         FColor Color = FLinearColor::LerpUsingHSV(
             FLinearColor::Green,
             FLinearColor::Red,
@@ -290,7 +2739,7 @@ void FISMSpatialIndex::DebugDraw(UWorld* World, float Duration, bool bShowInstan
             DrawDebugString(
                 World,
                 CellBox.GetCenter(),
-                FString::Printf(TEXT("%d"), Instances.Num()),
+                FString::Printf(TEXT("%d"), NumInstances),
                 nullptr,
                 FColor::White,
                 Duration,
@@ -298,6 +2747,16 @@ void FISMSpatialIndex::DebugDraw(UWorld* World, float Duration, bool bShowInstan
                 1.2f
             );
         }
+    };
+
+    for (int32 CellIdx = 0; CellIdx < FlatCellKeys.Num(); CellIdx++)
+    {
+        DrawCell(FlatCellKeys[CellIdx], FlatCellOffsets[CellIdx + 1] - FlatCellOffsets[CellIdx]);
+    }
+
+    for (const auto& Pair : Cells)
+    {
+        DrawCell(Pair.Key, Pair.Value.Num());
     }
 #endif
 }
\ No newline at end of file
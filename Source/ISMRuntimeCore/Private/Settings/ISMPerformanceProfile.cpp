@@ -0,0 +1,194 @@
+#include "Settings/ISMPerformanceProfile.h"
+#include "Settings/ISMRuntimeSettings.h"
+#include "Batching/ISMBatchScheduler.h"
+#include "HAL/IConsoleManager.h"
+
+FISMPerformanceProfileSettings FISMPerformanceProfileSettings::GetBuiltIn(EISMPerformanceProfile Profile)
+{
+    FISMPerformanceProfileSettings Settings;
+
+    switch (Profile)
+    {
+    case EISMPerformanceProfile::HighEnd:
+        // Plenty of cores and frame time: go wide and keep more effects and actors alive
+        Settings.bOverride_UseAsyncBatchScheduler = true;
+        Settings.bUseAsyncBatchScheduler = true;
+        Settings.bOverride_MaxConcurrentChunks = true;
+        Settings.MaxConcurrentChunks = 64;
+        Settings.bOverride_FrameBudgetMs = true;
+        Settings.FrameBudgetMs = 6.0f;
+        Settings.bOverride_MaxFeedbackPerFrame = true;
+        Settings.MaxFeedbackPerFrame = -1;
+        Settings.PoolSizeScale = 1.5f;
+        Settings.PhysicsActorLimitScale = 1.5f;
+        Settings.PhysicsDistanceScale = 1.25f;
+        break;
+
+    case EISMPerformanceProfile::VR:
+        // Missing a 90Hz frame is worse than deferring work: tight, sliced budgets everywhere
+        Settings.bOverride_UseAsyncBatchScheduler = true;
+        Settings.bUseAsyncBatchScheduler = true;
+        Settings.bOverride_DispatchBudgetMs = true;
+        Settings.DispatchBudgetMs = 0.5f;
+        Settings.bOverride_ApplyBudgetMs = true;
+        Settings.ApplyBudgetMs = 0.5f;
+        Settings.bOverride_FrameBudgetMs = true;
+        Settings.FrameBudgetMs = 2.0f;
+        Settings.bOverride_MaxFeedbackPerFrame = true;
+        Settings.MaxFeedbackPerFrame = 32;
+        Settings.bOverride_MinFeedbackSignificance = true;
+        Settings.MinFeedbackSignificance = 0.05f;
+        Settings.PhysicsActorLimitScale = 0.5f;
+        Settings.PhysicsDistanceScale = 0.75f;
+        break;
+
+    case EISMPerformanceProfile::Handheld:
+        // Few cores, little memory, thermal limits: smaller chunks at background priority, smaller pools
+        Settings.bOverride_UseAsyncBatchScheduler = true;
+        Settings.bUseAsyncBatchScheduler = true;
+        Settings.bOverride_MaxConcurrentChunks = true;
+        Settings.MaxConcurrentChunks = 8;
+        Settings.bOverride_MaxInstancesPerChunk = true;
+        Settings.MaxInstancesPerChunk = 1024;
+        Settings.bOverride_LaunchChunksAtBackgroundPriority = true;
+        Settings.bLaunchChunksAtBackgroundPriority = true;
+        Settings.bOverride_FrameBudgetMs = true;
+        Settings.FrameBudgetMs = 3.0f;
+        Settings.bOverride_MaxFeedbackPerFrame = true;
+        Settings.MaxFeedbackPerFrame = 16;
+        Settings.bOverride_MinFeedbackSignificance = true;
+        Settings.MinFeedbackSignificance = 0.1f;
+        Settings.PoolSizeScale = 0.5f;
+        Settings.PhysicsActorLimitScale = 0.35f;
+        Settings.PhysicsDistanceScale = 0.5f;
+        break;
+
+    case EISMPerformanceProfile::Server:
+        // Throughput over latency, nobody watching: big chunks, no frame budget, almost no feedback
+        Settings.bOverride_UseAsyncBatchScheduler = true;
+        Settings.bUseAsyncBatchScheduler = true;
+        Settings.bOverride_MaxConcurrentChunks = true;
+        Settings.MaxConcurrentChunks = 64;
+        Settings.bOverride_MaxInstancesPerChunk = true;
+        Settings.MaxInstancesPerChunk = 8192;
+        Settings.bOverride_FrameBudgetMs = true;
+        Settings.FrameBudgetMs = 0.0f;
+        Settings.bOverride_MaxFeedbackPerFrame = true;
+        Settings.MaxFeedbackPerFrame = 8;
+        break;
+
+    case EISMPerformanceProfile::Default:
+    default:
+        break;
+    }
+
+    return Settings;
+}
+
+void FISMPerformanceProfileSettings::ApplyTo(FISMBatchSchedulerSettings& Settings) const
+{
+    if (bOverride_MaxConcurrentChunks)
+    {
+        Settings.MaxConcurrentChunks = MaxConcurrentChunks;
+    }
+    if (bOverride_MaxInstancesPerChunk)
+    {
+        Settings.MaxInstancesPerChunk = MaxInstancesPerChunk;
+    }
+    if (bOverride_LaunchChunksAtBackgroundPriority)
+    {
+        Settings.bLaunchChunksAtBackgroundPriority = bLaunchChunksAtBackgroundPriority;
+    }
+    if (bOverride_DispatchBudgetMs)
+    {
+        Settings.DispatchBudgetMs = DispatchBudgetMs;
+    }
+    if (bOverride_ApplyBudgetMs)
+    {
+        Settings.ApplyBudgetMs = ApplyBudgetMs;
+    }
+}
+
+// ===== Active Profile =====
+
+namespace ISMPerformanceProfile
+{
+    struct FState
+    {
+        bool bInitialized = false;
+        EISMPerformanceProfile Profile = EISMPerformanceProfile::Default;
+        FISMPerformanceProfileSettings Settings;
+        FOnISMPerformanceProfileChanged OnChanged;
+    };
+
+    static FState& GetState()
+    {
+        static FState State;
+        if (!State.bInitialized)
+        {
+            State.bInitialized = true;
+            const UISMRuntimeSettings* RuntimeSettings = GetDefault<UISMRuntimeSettings>();
+            State.Profile = RuntimeSettings ? RuntimeSettings->PerformanceProfile : EISMPerformanceProfile::Default;
+            State.Settings = FISMPerformanceProfiles::Resolve(State.Profile);
+        }
+        return State;
+    }
+}
+
+EISMPerformanceProfile FISMPerformanceProfiles::GetActiveProfile()
+{
+    return ISMPerformanceProfile::GetState().Profile;
+}
+
+const FISMPerformanceProfileSettings& FISMPerformanceProfiles::GetActive()
+{
+    return ISMPerformanceProfile::GetState().Settings;
+}
+
+FISMPerformanceProfileSettings FISMPerformanceProfiles::Resolve(EISMPerformanceProfile Profile)
+{
+    const UISMRuntimeSettings* RuntimeSettings = GetDefault<UISMRuntimeSettings>();
+    if (const FISMPerformanceProfileSettings* Override = RuntimeSettings ? RuntimeSettings->PerformanceProfileOverrides.Find(Profile) : nullptr)
+    {
+        return *Override;
+    }
+    return FISMPerformanceProfileSettings::GetBuiltIn(Profile);
+}
+
+void FISMPerformanceProfiles::SetActiveProfile(EISMPerformanceProfile Profile)
+{
+    check(IsInGameThread());
+
+    ISMPerformanceProfile::FState& State = ISMPerformanceProfile::GetState();
+    State.Profile = Profile;
+    State.Settings = Resolve(Profile);
+
+    UE_LOG(LogTemp, Log, TEXT("ISMRuntime: performance profile %s"), *UEnum::GetValueAsString(Profile));
+    State.OnChanged.Broadcast(State.Profile, State.Settings);
+}
+
+FOnISMPerformanceProfileChanged& FISMPerformanceProfiles::OnProfileChanged()
+{
+    return ISMPerformanceProfile::GetState().OnChanged;
+}
+
+static FAutoConsoleCommand GISMPerformanceProfileCommand(
+    TEXT("ISM.PerformanceProfile"),
+    TEXT("Switch the ISMRuntime performance profile: ISM.PerformanceProfile <Default|HighEnd|VR|Handheld|Server>. No argument prints the active one."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() == 0)
+        {
+            UE_LOG(LogTemp, Display, TEXT("ISMRuntime: performance profile is %s"), *UEnum::GetValueAsString(FISMPerformanceProfiles::GetActiveProfile()));
+            return;
+        }
+
+        const UEnum* Enum = StaticEnum<EISMPerformanceProfile>();
+        const int64 Value = Enum->GetValueByNameString(Args[0]);
+        if (Value == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ISM.PerformanceProfile: unknown profile '%s'"), *Args[0]);
+            return;
+        }
+        FISMPerformanceProfiles::SetActiveProfile(static_cast<EISMPerformanceProfile>(Value));
+    }));
@@ -2,6 +2,7 @@
 // Published by Procedural Architect
 
 #include "Settings/ISMRuntimeSettings.h"
+#include "Engine/World.h"
 
 
 
@@ -24,4 +25,23 @@
 //{
 //	return FText();
 //}
-#endif
\ No newline at end of file
+#endif
+
+bool UISMRuntimeSettings::IsHeadless(const UWorld* World) const
+{
+    return IsHeadlessFor(World ? World->GetNetMode() == NM_DedicatedServer : IsRunningDedicatedServer());
+}
+
+bool UISMRuntimeSettings::IsHeadlessFor(bool bDedicatedServer) const
+{
+    switch (HeadlessMode)
+    {
+    case EISMHeadlessMode::Always:
+        return true;
+    case EISMHeadlessMode::Never:
+        return false;
+    case EISMHeadlessMode::Auto:
+    default:
+        return bDedicatedServer;
+    }
+}
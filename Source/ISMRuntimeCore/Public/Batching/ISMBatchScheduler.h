@@ -5,6 +5,8 @@
 #include "Batching/ISMBatchTypes.h"
 #include "Logging/LogMacros.h"
 #include "Batching/ISMBatchTransformer.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "ISMBatchScheduler.generated.h"
 
 // Forward declarations
@@ -29,9 +31,33 @@ struct ISMRUNTIMECORE_API FISMBatchSchedulerSettings
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Batch|Safety", meta = (ClampMin = "0.5"))
     float HandleTimeoutSeconds = 5.0f;
 
+    /** Async scheduler: chunks launched on the task graph but not yet resolved. Extra chunks wait for later ticks. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Batch|Performance", meta = (ClampMin = "1"))
     int32 MaxConcurrentChunks = 32;
 
+    /**
+     * Async scheduler: launch chunks as background tasks instead of normal priority.
+     * Suits transformers whose results can land a few frames late (PCG); leave off for per-frame work (wind sway)
+     * so results are usually drained the same or next frame.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Batch|Performance")
+    bool bLaunchChunksAtBackgroundPriority = false;
+
+    /**
+     * Game-thread time per tick for dispatching dirty transformers, 0 = unbudgeted. Once spent, the remaining
+     * transformers stay dirty and go first in their stage next tick; at least one dispatches every tick.
+     * Sync: includes ProcessChunk and apply. Async: includes building and launching chunk snapshots.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Batch|Performance", meta = (ClampMin = "0.0", Units = "ms"))
+    float DispatchBudgetMs = 0.0f;
+
+    /**
+     * Async scheduler: game-thread time per tick for applying results, 0 = unbudgeted. Results over budget wait
+     * for later ticks, higher transformer priority first, and keep their chunk slot until applied.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Batch|Performance", meta = (ClampMin = "0.0", Units = "ms"))
+    float ApplyBudgetMs = 0.0f;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Batch|Debug")
     bool bWarnOnHandleTimeout = true;
 
@@ -40,6 +66,58 @@ struct ISMRUNTIMECORE_API FISMBatchSchedulerSettings
 };
 
 
+/**
+ * Ready-made relevance by distance to a set of viewpoints (cameras, players). Nearer chunks get
+ * higher priority; the update interval comes from the first tier whose MaxDistance reaches the
+ * chunk, or the last tier beyond them all. Viewpoints are not gathered automatically - refresh
+ * them before the scheduler ticks. Game thread only.
+ */
+struct ISMRUNTIMECORE_API FISMDistanceRelevance
+{
+    struct FTier
+    {
+        float MaxDistance = 0.0f;
+        int32 UpdateInterval = 1;
+    };
+
+    TArray<FVector> Viewpoints;
+
+    /** Ascending MaxDistance */
+    TArray<FTier> Tiers;
+
+    FISMChunkRelevance Evaluate(const FISMChunkRelevanceQuery& Query) const;
+};
+
+
+/** Scheduler backlog and game-thread cost, for tuning the frame budgets */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMBatchSchedulerStats
+{
+    GENERATED_BODY()
+
+    /** Dirty transformers the dispatch budget left for a later tick */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 DeferredTransformerCount = 0;
+
+    /** Async: planned chunks waiting for a launch slot, a conflicting chunk, or budget */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 QueuedChunkCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 InFlightChunkCount = 0;
+
+    /** Async: results received and waiting for apply budget */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 PendingApplyCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float LastDispatchTimeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float LastApplyTimeMs = 0.0f;
+};
+
+
 // ============================================================
 //  Internal Tracking Structs  (shared by both implementations)
 // ============================================================
@@ -50,6 +128,12 @@ struct FISMTransformerEntry
     FName                 Name;
     int32                 Priority = 0;
     bool                  bRegistered = false;
+
+    /** Consecutive ticks the dispatch budget skipped this transformer while dirty */
+    int32                 DeferredTicks = 0;
+
+    /** Dispatches so far; the time base for chunk update intervals */
+    uint32                DispatchCount = 0;
 };
 
 struct FISMInFlightChunk
@@ -57,17 +141,120 @@ struct FISMInFlightChunk
     FName                                TransformerName;
     TWeakObjectPtr<UISMRuntimeComponent> TargetComponent;
     FIntVector                           CellCoordinates;
+    uint32                               ChunkId = 0;
+    int32                                Priority = 0;
+    EISMSnapshotField                    ReadMask = EISMSnapshotField::None;
+    EISMSnapshotField                    WriteMask = EISMSnapshotField::None;
     double                               IssuedTimeSeconds = 0.0;
     bool                                 bReleased = false;
     bool                                 bAbandoned = false;
 };
 
+/** Instances of one spatial cell, at most one chunk cap's worth. Sub-chunks of a split cell share coordinates. */
+struct FISMChunkPlan
+{
+    FIntVector    CellCoordinates = FIntVector::ZeroValue;
+    TArray<int32> InstanceIndices;
+
+    /** From the chunk relevance function when the request uses it */
+    float         Priority = 0.0f;
+};
+
 struct FISMTransformerRequestCycle
 {
     FName  TransformerName;
     int32  TotalChunks = 0;
     int32  ResolvedChunks = 0;
     bool   bComplete = false;
+
+    /** Chunks are still being counted; sync chunks resolve before dispatch finishes */
+    bool   bDispatching = false;
+
+    /** Some chunk was abandoned or discarded, so the cycle's delta cursors are not committed */
+    bool   bAnyAbandoned = false;
+
+    /** Change cursors captured at dispatch for bDeltaOnly requests, committed when the cycle completes */
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, uint32> PendingDeltaCursors;
+};
+
+/**
+ * A transformer consuming another's chunks this tick (FISMSnapshotRequest::ConsumesOutputOf).
+ * Each accepted upstream chunk gets one chunk of Transformer, built from the upstream snapshot
+ * with the upstream result applied. Links chain when the consumer is itself consumed; Request
+ * carries the read fields of everything further down so one snapshot serves the whole chain.
+ */
+struct FISMChainLink
+{
+    IISMBatchTransformer*           Transformer = nullptr;
+    FName                           TransformerName;
+    FISMSnapshotRequest             Request;
+    TSharedPtr<const FISMChainLink> Downstream;
+};
+
+/** One dirty transformer's request for this tick, with its place in the stage order */
+struct FISMStagedDispatch
+{
+    IISMBatchTransformer* Transformer = nullptr;
+    FName                 Name;
+    FISMSnapshotRequest   Request;
+
+    /** 0 runs first; a transformer is staged after every earlier-ranked one it conflicts with or consumes */
+    int32                 Stage = 0;
+
+    /** From the registry entry; carried-over transformers dispatch first within their stage */
+    int32                 DeferredTicks = 0;
+    uint32                DispatchCount = 0;
+
+    /** Index of the staged transformer consuming this one's output, or of the one this consumes */
+    int32                 ConsumerIndex = INDEX_NONE;
+    int32                 UpstreamIndex = INDEX_NONE;
+};
+
+
+// ============================================================
+//  Buffer Pool
+//
+//  Snapshot and mutation arrays handed back by transformers are kept
+//  with their capacity and leased to the next chunk, so continuous
+//  transformers reach zero allocations once chunk sizes settle.
+//  Leased and returned from worker threads, hence the lock.
+// ============================================================
+
+struct ISMRUNTIMECORE_API FISMBatchBufferPool
+{
+    /** Free arrays kept per kind; extras are freed on return */
+    int32 MaxFreeBuffers = 64;
+
+    /** Move pooled, empty Mutations and Streams storage into a fresh result */
+    void LeaseResultStorage(FISMBatchMutationResult& Result, int32 ExpectedMutations);
+    void ReturnResultStorage(FISMBatchMutationResult&& Result);
+
+    /**
+     * Move pooled storage into a fresh snapshot for the requested layout. Per-instance entries keep
+     * their custom data allocations, so the caller must overwrite every field of every entry it uses.
+     */
+    void LeaseSnapshotStorage(FISMBatchSnapshot& Snapshot, bool bStructureOfArrays);
+    void ReturnSnapshotStorage(FISMBatchSnapshot&& Snapshot);
+
+    int32 GetNumFreeMutationBuffers() const;
+    int32 GetNumFreeStreamBuffers() const;
+    int32 GetNumFreeSnapshotBuffers() const;
+
+    /** Leases that found no pooled array of their kind, so the caller allocates fresh storage */
+    uint64 GetNumLeaseMisses() const;
+
+    /** Heap bytes held by the free arrays, custom data of kept snapshot entries included */
+    SIZE_T GetAllocatedSize() const;
+
+    void Empty();
+
+private:
+    mutable FCriticalSection                Lock;
+    uint64                                  NumLeaseMisses = 0;
+    TArray<TArray<FISMInstanceMutation>>    FreeMutations;
+    TArray<FISMMutationStreams>             FreeStreams;
+    TArray<TArray<FISMInstanceSnapshot>>    FreeInstances;
+    TArray<FISMInstanceSoASnapshot>         FreeSoA;
 };
 
 
@@ -97,19 +284,51 @@ public:
     void  UnregisterTransformer(FName TransformerName);
     void  UnregisterAllTransformers();
     bool  IsTransformerRegistered(FName TransformerName) const;
+    int32 GetTransformerPriority(FName TransformerName) const;
     int32 GetRegisteredTransformerCount() const { return RegisteredTransformers.Num(); }
     bool  HasPendingWork() const { return GetRegisteredTransformerCount() > 0; }
 
+    /**
+     * Relevance function for requests with bUseChunkRelevance, called on the game thread once per
+     * planned cell. A request's own FISMSnapshotRequest::ChunkRelevance takes precedence. Null
+     * (the default) treats every chunk as due with equal priority.
+     */
+    void SetChunkRelevanceFunction(FISMChunkRelevanceFunction InFunction) { ChunkRelevanceFunction = MoveTemp(InFunction); }
+
+    // ===== External Results =====
+
+    /**
+     * Apply a result built outside the transformer pipeline - no snapshot, chunk or generation
+     * token - on the game thread now, through the same batched path as transformer results.
+     * For systems that keep their own copy of instance state (e.g. the Mass bridge); the caller
+     * makes sure every index is a live instance of TargetComponent.
+     */
+    bool ApplyExternalResult(const FISMBatchMutationResult& Result);
+
     // ===== Tick =====
 
     virtual void Tick(float DeltaTime) PURE_VIRTUAL(UISMBatchSchedulerBase::Tick, );
 
     // ===== Stats =====
 
+    /** Stage the transformer was given at its last dispatch, INDEX_NONE if it has not dispatched */
+    int32 GetTransformerStage(FName TransformerName) const;
+
+    virtual FISMBatchSchedulerStats GetSchedulerStats() const;
+
     virtual int32 GetInFlightChunkCount() const { return InFlightChunks.Num(); }
     virtual int32 GetPendingResultCount()  const { return InFlightChunks.Num(); }
     TArray<FName> GetTransformersWithOpenHandles() const;
 
+    /** Recycled snapshot/mutation storage. Null before Initialize. */
+    const FISMBatchBufferPool* GetBufferPool() const { return BufferPool.Get(); }
+
+    /** Heap bytes held by tracking state, forwarded snapshots and the buffer pool; subclasses add staged work */
+    virtual SIZE_T GetAllocatedSize() const;
+
+    /** Name the scheduler's work is timed under in the owning subsystem's frame budget */
+    static const FName FrameBudgetClient;
+
 protected:
 
     // ===== Handle Callbacks =====
@@ -121,43 +340,165 @@ protected:
 
     friend struct FISMMutationHandle;
 
+    /** Buffer pool access for handles - callable from any thread */
+    void LeaseResultStorage(FISMBatchMutationResult& Result, int32 ExpectedMutations) const;
+    void RecycleSnapshot(FISMBatchSnapshot&& Snapshot) const;
+
     virtual void OnHandleReleased(FISMBatchMutationResult&& Result, FIntVector CellCoords,
         TWeakObjectPtr<UISMRuntimeComponent> Component) PURE_VIRTUAL(UISMBatchSchedulerBase::OnHandleReleased, );
 
     virtual void OnHandleAbandoned(FIntVector CellCoords,
-        TWeakObjectPtr<UISMRuntimeComponent> Component) PURE_VIRTUAL(UISMBatchSchedulerBase::OnHandleAbandoned, );
+        TWeakObjectPtr<UISMRuntimeComponent> Component, uint32 ChunkId) PURE_VIRTUAL(UISMBatchSchedulerBase::OnHandleAbandoned, );
 
     // ===== Dispatch (shared) =====
 
+    /**
+     * Build every dirty transformer's request, order them into stages and dispatch stage by stage
+     * until Settings.DispatchBudgetMs is spent. Sets DispatchSecondsThisTick.
+     */
     void DispatchDirtyTransformers();
-    void DispatchTransformer(FISMTransformerEntry& Entry);
+
+    /** Dispatch budget in seconds, 0 = unbudgeted; clamped to what the frame budget has left */
+    double GetDispatchBudgetSeconds() const { return ClampToFrameBudget(FMath::Max(0.0, Settings.DispatchBudgetMs / 1000.0)); }
+
+    /** OwnBudgetSeconds (0 = unbudgeted) tightened by the owning subsystem's frame budget, if one is running */
+    double ClampToFrameBudget(double OwnBudgetSeconds) const;
+
+    /** Tell the frame budget NumItems were left for a later tick */
+    void ReportFrameBudgetDeferred(int32 NumItems) const;
+
+    /**
+     * Stage Staged, which is in priority order: after every earlier entry it conflicts with on a
+     * shared component, and after the transformer it consumes. Pairs each honoured consumer with
+     * its upstream.
+     */
+    static void AssignDispatchStages(TArray<FISMStagedDispatch>& Staged);
+
+    /** Dispatch one staged request; Consumer is the chain hanging off its chunks, if any */
+    void DispatchTransformer(const FISMStagedDispatch& Dispatch, const TSharedPtr<const FISMChainLink>& Consumer,
+        TConstArrayView<TWeakObjectPtr<UISMRuntimeComponent>> ChainedComponents);
 
     /**
      * Builds the snapshot for one component and calls ProcessChunk on the transformer.
      * Subclasses provide the correct handle type via the friend relationship.
-     * Sync:  no batch lock, results applied before function returns.
-     * Async: batch locks the component, results staged for next tick drain.
+     * Sync:  results applied before function returns.
+     * Async: results staged for next tick drain; staleness is caught by generation token.
+     * Consumer, when set, gets a chunk of its own for every chunk it accepts.
      */
     virtual int32 DispatchComponentChunks(
         IISMBatchTransformer* Transformer,
         UISMRuntimeComponent* Component,
         const FISMSnapshotRequest& Request,
-        FName TransformerName) PURE_VIRTUAL(UISMBatchSchedulerBase::DispatchComponentChunks, return 0;);
+        FName TransformerName,
+        const TSharedPtr<const FISMChainLink>& Consumer) PURE_VIRTUAL(UISMBatchSchedulerBase::DispatchComponentChunks, return 0;);
+
+    /**
+     * Whether the chunk at Cell is due in the current dispatch, per the relevance function when
+     * Request uses it. OutPriority is the chunk's priority, 0 when relevance is not used.
+     */
+    bool IsChunkDue(const FISMSnapshotRequest& Request, const UISMRuntimeComponent* Component,
+        const FIntVector& Cell, const FBox& Bounds, float& OutPriority) const;
+
+    // ===== Delta Snapshots (shared) =====
+
+    static bool IsDeltaRequest(const FISMSnapshotRequest& Request)
+    {
+        return Request.bDeltaOnly && Request.GetDeltaFields() != EISMSnapshotField::None;
+    }
+
+    /**
+     * Batchable instances of Component the current dispatch covers: all of them, or for a delta
+     * request those changed since the transformer's committed cursor on the component.
+     */
+    void GatherDispatchInstances(const UISMRuntimeComponent* Component, const FISMSnapshotRequest& Request, TArray<int32>& OutIndices) const;
+
+    // ===== Chaining (shared) =====
+
+    /** Whether a chunk of Component at Cell falls inside Request's bounds. Whole-component chunks always do. */
+    virtual bool DoesChunkOverlapRequest(const UISMRuntimeComponent* Component, const FIntVector& Cell, const FISMSnapshotRequest& Request) const { return true; }
+
+    /**
+     * Walk Consumer's chain for an upstream chunk of Component at Cell and count one chunk into
+     * each accepting transformer's cycle. Returns how many links accepted; the walk stops at the
+     * first link that does not, since everything after it consumes that link's output.
+     */
+    int32 CountChainedChunks(const TSharedPtr<const FISMChainLink>& Consumer, const UISMRuntimeComponent* Component, const FIntVector& Cell);
+
+    /** Resolve ChainDepth counted chunks of Consumer's chain as abandoned */
+    void AbandonChain(const TSharedPtr<const FISMChainLink>& Consumer, int32 ChainDepth);
+
+    /** Apply Result's writes to the matching instances of Snapshot, for fields the snapshot carries */
+    static void ApplyResultToSnapshot(const FISMBatchMutationResult& Result, FISMBatchSnapshot& Snapshot);
+
+    /** After applying Result: keep its forwarded snapshot, patched with the result, for the chunk's consumer */
+    void StashForwardedSnapshot(FISMBatchMutationResult& Result);
+
+    /** Take the patched snapshot stashed for upstream ChunkId, if its result was applied */
+    bool TakeForwardedSnapshot(uint32 ChunkId, FISMBatchSnapshot& OutSnapshot);
+
+    uint32 AllocateChunkId() { return ++LastChunkId == 0 ? ++LastChunkId : LastChunkId; }
+
+    /**
+     * Groups a component's batchable instances by spatial index cell, drops cells that do not
+     * overlap the request's SpatialBounds, and splits cells over the chunk cap into sub-chunks.
+     * Plans come out in cell order so dispatch is deterministic.
+     */
+    void BuildChunkPlans(
+        UISMRuntimeComponent* Component,
+        const FISMSnapshotRequest& Request,
+        TArray<FISMChunkPlan>& OutPlans) const;
 
     FISMBatchSnapshot BuildSnapshot(
         UISMRuntimeComponent* Component,
         FIntVector CellCoords,
         const TArray<int32>& InstanceIndices,
-        EISMSnapshotField ReadMask) const;
+        EISMSnapshotField ReadMask,
+        TConstArrayView<FName> ReadColumns = TConstArrayView<FName>(),
+        bool bStructureOfArrays = false) const;
+
+    // ===== Generation Tokens (shared) =====
+
+    /**
+     * Structural generation a chunk of Component at Cell is issued with. Default covers the whole
+     * component, for schedulers that snapshot it as one chunk; the async scheduler uses the cell's.
+     */
+    virtual uint32 GetChunkGenerationToken(const UISMRuntimeComponent* Component, const FIntVector& Cell) const;
+
+    /** Result's token no longer matches its chunk - an index it names may have been recycled */
+    bool IsResultStale(const FISMBatchMutationResult& Result) const;
 
     // ===== Result Application (shared) =====
 
     bool ApplyMutationResult(const FISMBatchMutationResult& Result);
 
+    /** Flush the coalesced instance events of components results were applied to since the last call */
+    void FlushAppliedInstanceEvents();
+
+    /** Mutation and stream transforms in a single bulk update; destroyed instances are skipped */
+    static void ApplyTransformWrites(
+        UISMRuntimeComponent* Comp,
+        const TArray<FISMInstanceMutation>& Mutations,
+        const FISMMutationStreams& Streams);
+
+    /** Hand an applied or discarded result's mutation and stream storage back to the pool */
+    void RecycleResult(FISMBatchMutationResult& Result) const;
+
     // ===== Cycle Tracking (shared) =====
 
     void NotifyChunkResolved(FName TransformerName, bool bWasAbandoned);
 
+    /** Open a cycle for TransformerName whose chunk count is filled in during dispatch */
+    void BeginDispatchCycle(FName TransformerName);
+    void AddDispatchCycleChunks(FName TransformerName, int32 NumChunks);
+
+    /** Stop counting; completes the cycle if its chunks already resolved, drops it if it has none */
+    void EndDispatchCycle(FName TransformerName);
+
+    void CompleteCycle(FISMTransformerRequestCycle& Cycle);
+
+    /** Advance the transformer's delta cursors to the ones Cycle captured, unless it lost a chunk */
+    void CommitDeltaCursors(FISMTransformerRequestCycle& Cycle);
+
     FISMInFlightChunk& TrackNewChunk(
         FName TransformerName,
         TWeakObjectPtr<UISMRuntimeComponent> Component,
@@ -174,7 +515,9 @@ protected:
         TWeakObjectPtr<UISMRuntimeComponent> Component,
         FIntVector CellCoords,
         uint32 GenerationToken,
-        double IssuedTime) const;
+        double IssuedTime,
+        uint32 ChunkId = 0,
+        bool bForwardSnapshot = false) const;
 
     // ===== State =====
 
@@ -182,7 +525,35 @@ protected:
     TArray<FISMTransformerEntry>         RegisteredTransformers;
     TArray<FISMInFlightChunk>            InFlightChunks;
     TArray<FISMTransformerRequestCycle>  ActiveCycles;
+
+    /** Stage of each transformer at its last dispatch */
+    TMap<FName, int32>                   TransformerStages;
+
+    /** Per transformer and component: change cursor of the last fully applied delta dispatch */
+    TMap<FName, TMap<TWeakObjectPtr<UISMRuntimeComponent>, uint32>> DeltaCursors;
+
+    /** Game-thread dispatch time this tick; the async scheduler adds its launch time */
+    double                               DispatchSecondsThisTick = 0.0;
+    int32                                NumDeferredTransformers = 0;
+
+    FISMChunkRelevanceFunction           ChunkRelevanceFunction;
+
+    /** Set for the transformer being dispatched: its DispatchCount, and a serial unique to this dispatch */
+    FName                                CurrentDispatchName;
+    uint32                               CurrentDispatchCount = 0;
+    uint32                               CurrentDispatchSerial = 0;
+
+    /** Components with bCoalesceInstanceEvents that applied results are waiting to flush */
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> EventFlushTargets;
+
+    /** Patched upstream snapshots awaiting their consumer chunk, by upstream chunk id. Game thread only. */
+    TMap<uint32, FISMBatchSnapshot>      ForwardedSnapshots;
+
+    uint32                               LastChunkId = 0;
     bool                                 bInitialized = false;
+
+    // Heap-allocated for the same CDO reason as UISMBatchScheduler::FThreadedState
+    TUniquePtr<FISMBatchBufferPool>      BufferPool;
 };
 
 
@@ -210,22 +581,43 @@ protected:
         TWeakObjectPtr<UISMRuntimeComponent> Component) override;
 
     virtual void OnHandleAbandoned(FIntVector CellCoords,
-        TWeakObjectPtr<UISMRuntimeComponent> Component) override;
+        TWeakObjectPtr<UISMRuntimeComponent> Component, uint32 ChunkId) override;
 
     virtual int32 DispatchComponentChunks(
         IISMBatchTransformer* Transformer,
         UISMRuntimeComponent* Component,
         const FISMSnapshotRequest& Request,
-        FName TransformerName) override;
+        FName TransformerName,
+        const TSharedPtr<const FISMChainLink>& Consumer) override;
+
+private:
+
+    /** Process one whole-component chunk, then the chunks chained onto it, each applied before the next */
+    void RunChunk(
+        IISMBatchTransformer* Transformer,
+        FName TransformerName,
+        UISMRuntimeComponent* Component,
+        FISMBatchSnapshot&& Snapshot,
+        const TSharedPtr<const FISMChainLink>& Consumer,
+        int32 ChainDepth);
 };
 
 
 // ============================================================
 //  Async Scheduler
 //
-//  ProcessChunk may hand work to a background thread.
+//  Each component is split into per-cell chunks (see BuildChunkPlans).
+//  Chunks are queued at dispatch and launched on the task graph, at most
+//  MaxConcurrentChunks in flight; the rest launch on later ticks.
+//  Components are not batch locked: each chunk carries its cell's
+//  structural generation and results for cells that changed since their
+//  snapshot are dropped at drain, so other cells keep mutating freely.
 //  OnHandleReleased posts results to a thread-safe staging area.
 //  Results are applied on the game thread during the next Tick drain.
+//  A chunk is held in the queue while another transformer's chunk with a
+//  conflicting read/write mask on the same (component, cell) is in flight
+//  or queued ahead of it. Chained consumer chunks are queued as their
+//  upstream chunk resolves.
 //
 //  FCriticalSection lives in FThreadedState (heap-allocated) to avoid
 //  UObject CDO construction corrupting the mutex handle and poisoning
@@ -243,19 +635,33 @@ public:
     virtual void Deinitialize() override;
     virtual void Tick(float DeltaTime) override;
 
+    virtual int32 GetPendingResultCount() const override { return InFlightChunks.Num() + ChunkQueue.Num() + PendingConsumers.Num(); }
+    virtual SIZE_T GetAllocatedSize() const override;
+    virtual FISMBatchSchedulerStats GetSchedulerStats() const override;
+
+    /**
+     * Launch every queued chunk and block until each launched ProcessChunk has returned,
+     * then apply the staged results. Ignores the dispatch and apply budgets. Transformers that finish on their own threads after
+     * ProcessChunk returns are not waited for.
+     */
+    void FlushChunkTasks();
+
 protected:
 
     virtual void OnHandleReleased(FISMBatchMutationResult&& Result, FIntVector CellCoords,
         TWeakObjectPtr<UISMRuntimeComponent> Component) override;
 
     virtual void OnHandleAbandoned(FIntVector CellCoords,
-        TWeakObjectPtr<UISMRuntimeComponent> Component) override;
+        TWeakObjectPtr<UISMRuntimeComponent> Component, uint32 ChunkId) override;
 
     virtual int32 DispatchComponentChunks(
         IISMBatchTransformer* Transformer,
         UISMRuntimeComponent* Component,
         const FISMSnapshotRequest& Request,
-        FName TransformerName) override;
+        FName TransformerName,
+        const TSharedPtr<const FISMChainLink>& Consumer) override;
+
+    virtual bool DoesChunkOverlapRequest(const UISMRuntimeComponent* Component, const FIntVector& Cell, const FISMSnapshotRequest& Request) const override;
 
 private:
 
@@ -263,9 +669,55 @@ private:
     {
         FIntVector                           Cell;
         TWeakObjectPtr<UISMRuntimeComponent> Component;
+        uint32                               ChunkId = 0;
     };
 
-    void DrainAndApplyResults();
+    /** A planned chunk waiting for a concurrency slot. The snapshot is built at launch. */
+    struct FQueuedChunk
+    {
+        IISMBatchTransformer*                Transformer = nullptr;
+        FName                                TransformerName;
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+        FISMChunkPlan                        Plan;
+        EISMSnapshotField                    ReadMask = EISMSnapshotField::None;
+        EISMSnapshotField                    WriteMask = EISMSnapshotField::None;
+        TArray<FName>                        ReadColumns;
+        bool                                 bStructureOfArrays = false;
+
+        /** Consumers chained onto this chunk, ChainDepth of them already counted into their cycles */
+        TSharedPtr<const FISMChainLink>      Consumer;
+        int32                                ChainDepth = 0;
+
+        /** CurrentDispatchSerial at queue time; the dispatch's chunks are ordered by Plan.Priority */
+        uint32                               DispatchSerial = 0;
+
+        /** Upstream snapshot with the upstream result applied; built at launch when absent */
+        FISMBatchSnapshot                    PreparedSnapshot;
+        bool                                 bHasPreparedSnapshot = false;
+    };
+
+    /** Queue entry for the consumer's chunk of the same instances as Upstream */
+    static FQueuedChunk MakeConsumerChunk(const FQueuedChunk& Upstream);
+
+    /** Another transformer's in-flight or earlier-queued chunk on the same cell conflicts with Queued */
+    bool IsChunkHeldBack(const FQueuedChunk& Queued, TConstArrayView<FQueuedChunk> QueuedAhead) const;
+
+    /**
+     * Snapshot and launch queued chunks until MaxConcurrentChunks are in flight or, with bBudgeted, the
+     * rest of the tick's dispatch budget is spent (at least one still launches). Returns how many launched.
+     */
+    int32 LaunchQueuedChunks(bool bBudgeted);
+
+    virtual uint32 GetChunkGenerationToken(const UISMRuntimeComponent* Component, const FIntVector& Cell) const override;
+
+    /** Mark the in-flight chunk resolved and queue or abandon its chained consumer */
+    void ResolveInFlightChunk(uint32 ChunkId, bool bAbandoned);
+
+    /** Move staged posts to the game thread and apply results, within the tick's apply budget when bBudgeted */
+    void DrainAndApplyResults(bool bBudgeted);
+
+    /** Apply or drop one drained result and resolve its chunk */
+    void ApplyDrainedResult(FISMBatchMutationResult& Result);
     void EnforceHandleTimeouts(double CurrentTime); // TODO Phase 2
 
     // See class comment above for why these live in a TUniquePtr
@@ -276,7 +728,24 @@ private:
 
         FCriticalSection                AbandonedChunksLock;
         TArray<FAbandonedChunkKey>      AbandonedChunks;
+
+        /** Results plus abandons posted and not yet drained - lets the game thread skip both locks */
+        std::atomic<int32>              NumStagedPosts{ 0 };
+
+        bool HasStagedPosts() const { return NumStagedPosts.load(std::memory_order_acquire) > 0; }
     };
 
     TUniquePtr<FThreadedState> ThreadedState;
+
+    // Game thread only
+    TArray<FQueuedChunk>                                ChunkQueue;
+    TArray<UE::Tasks::FTask>                            ChunkTasks;
+
+    /** Consumer chunks waiting for their upstream chunk, by upstream chunk id */
+    TMap<uint32, FQueuedChunk>                          PendingConsumers;
+
+    /** Drained results carried over by the apply budget, highest transformer priority first */
+    TArray<FISMBatchMutationResult>                     PendingApply;
+    double                                              ApplySecondsThisTick = 0.0;
+    double                                              LastApplySeconds = 0.0;
 };
\ No newline at end of file
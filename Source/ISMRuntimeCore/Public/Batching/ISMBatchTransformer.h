@@ -58,6 +58,21 @@ struct ISMRUNTIMECORE_API FISMMutationHandle
      */
     void Release(FISMBatchMutationResult&& Result);
 
+    /**
+     * Release, also handing the chunk's snapshot back to the scheduler's buffer pool.
+     * Continuous transformers should prefer this so the next tick's snapshot reuses the storage.
+     * When another transformer consumes this one's output, the snapshot is forwarded to it instead
+     * (see FISMSnapshotRequest::ConsumesOutputOf); the snapshot must be the one this handle came with.
+     */
+    void Release(FISMBatchMutationResult&& Result, FISMBatchSnapshot&& SpentSnapshot);
+
+    /**
+     * A result whose Mutations array and Streams are leased from the scheduler's buffer pool, with
+     * room for at least ExpectedMutations. They go back to the pool once the scheduler has applied it.
+     * Safe to call from ProcessChunk on any thread.
+     */
+    FISMBatchMutationResult AcquireResult(int32 ExpectedMutations = 0) const;
+
     /**
      * Abandon this lease without submitting any changes.
      * The chunk is left unchanged and the lease is freed.
@@ -97,8 +112,12 @@ private:
     TWeakObjectPtr<UISMRuntimeComponent>   TargetComponent;
     FIntVector                             CellCoordinates = FIntVector::ZeroValue;
     uint32                                 GenerationToken = 0;
+    uint32                                 ChunkId = 0;
     double                                 IssuedTimeSeconds = 0.0;
     bool                                   bIsOpen = false;
+
+    /** A downstream transformer consumes this chunk - Release(Result, Snapshot) forwards the snapshot */
+    bool                                   bForwardSnapshot = false;
 };
 
 
@@ -134,7 +153,8 @@ class UISMBatchTransformer : public UInterface
  *
  * Threading contract:
  *   - BuildRequest()      : called on game thread
- *   - ProcessChunk()      : called on any thread (task graph) - NO UObject access allowed
+ *   - ProcessChunk()      : called on any thread (task graph) - NO UObject access allowed;
+ *                           the async scheduler runs several chunks of one request concurrently
  *   - OnRequestComplete() : called on game thread after all chunks are applied
  *
  * V1 constraints:
@@ -158,8 +178,9 @@ public:
     virtual FName GetTransformerName() const = 0;
 
     /**
-     * Priority used when two transformers have conflicting write masks on the same cell.
-     * Higher value = higher priority (runs first, other transformer queues behind it).
+     * Priority used when two transformers have conflicting read/write masks on the same component.
+     * Higher value = higher priority: it runs in an earlier stage, and the other transformer's
+     * chunks for a cell wait until this one's chunks for that cell are applied.
      * Default 0. Most transformers should leave this at default.
      */
     virtual int32 GetPriority() const { return 0; }
@@ -207,6 +228,7 @@ public:
     /**
      * Process a single chunk (one spatial cell of one component).
      * Called on a background thread in the async scheduler - NO UObject access permitted.
+     * Chunks of the same request may be processed in parallel, so shared transformer state needs its own locking.
      * Called on the game thread in the sync scheduler.
      * The snapshot is passed by value; the transformer owns this copy.
      *
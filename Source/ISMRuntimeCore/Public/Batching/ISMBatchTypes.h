@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "ISMInstanceState.h"
 #include "ISMBatchTypes.generated.h"
 
 // Forward declarations
@@ -35,6 +36,55 @@ ENUM_CLASS_FLAGS(EISMSnapshotField)
 //  Per-Instance Snapshot Data
 // ============================================================
 
+/**
+ * Copy of one registered instance data column (see FISMInstanceDataColumns) for the
+ * instances in a batch snapshot. Data holds ElementSize bytes per snapshot instance,
+ * in chunk order (FISMBatchSnapshot::Instances or FISMBatchSnapshot::SoA).
+ */
+struct FISMInstanceColumnSnapshot
+{
+    FName Name;
+    int32 ElementSize = 0;
+    TArray<uint8> Data;
+};
+
+/**
+ * Structure-of-arrays copy of a chunk's instances, filled instead of FISMBatchSnapshot::Instances
+ * when the request sets bStructureOfArrays. Each field is one allocation in chunk order, so
+ * transformers can run vectorized loops over it. Fields outside the ReadMask stay empty.
+ * CustomData is row per instance - CustomDataStride floats per row.
+ */
+struct FISMInstanceSoASnapshot
+{
+    TArray<int32>   InstanceIndices;
+    TArray<FVector> Locations;
+    TArray<FQuat>   Rotations;
+    TArray<FVector> Scales;
+    TArray<float>   CustomData;
+    int32           CustomDataStride = 0;
+    TArray<uint8>   StateFlags;
+
+    int32 Num() const { return InstanceIndices.Num(); }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return InstanceIndices.GetAllocatedSize() + Locations.GetAllocatedSize() + Rotations.GetAllocatedSize()
+            + Scales.GetAllocatedSize() + CustomData.GetAllocatedSize() + StateFlags.GetAllocatedSize();
+    }
+
+    /** Requires EISMSnapshotField::Transform in the ReadMask */
+    FTransform GetTransform(int32 SnapshotIndex) const
+    {
+        return FTransform(Rotations[SnapshotIndex], Locations[SnapshotIndex], Scales[SnapshotIndex]);
+    }
+
+    /** Requires EISMSnapshotField::CustomData in the ReadMask */
+    TConstArrayView<float> GetCustomData(int32 SnapshotIndex) const
+    {
+        return TConstArrayView<float>(CustomData.GetData() + SnapshotIndex * CustomDataStride, CustomDataStride);
+    }
+};
+
 /**
  * Read-only snapshot of a single instance's data at the moment the snapshot was taken.
  * Fields are only populated if the corresponding bit was set in the request's ReadMask.
@@ -88,10 +138,10 @@ struct ISMRUNTIMECORE_API FISMBatchSnapshot
     TWeakObjectPtr<UISMRuntimeComponent> SourceComponent;
 
     /**
-     * Generation token captured at snapshot time.
+     * Generation token captured at snapshot time (see UISMRuntimeComponent::GetCellStructureGeneration).
      * The scheduler validates this before applying results.
-     * If the component has been modified (instances removed) since the snapshot,
-     * the token will not match and the result is discarded as stale.
+     * If a slot the snapshot may list has been recycled since, the token will
+     * not match and the result is discarded as stale.
      */
     UPROPERTY( BlueprintReadOnly, Category = "ISM Batch")
     int32 ComponentGenerationToken = 0;
@@ -104,17 +154,39 @@ struct ISMRUNTIMECORE_API FISMBatchSnapshot
     UPROPERTY(BlueprintReadOnly, Category = "ISM Batch")
     EISMSnapshotField PopulatedFields = EISMSnapshotField::None;
 
-    /** Per-instance data for all active instances in this cell. */
+    /** Per-instance data for all active instances in this cell. Empty when the request asked for SoA. */
     UPROPERTY(BlueprintReadOnly, Category = "ISM Batch")
     TArray<FISMInstanceSnapshot> Instances;
 
+    /** Structure-of-arrays instance data, filled instead of Instances when requested. Native only. */
+    FISMInstanceSoASnapshot SoA;
+
+    /** Module data columns named in the request's ReadColumns. Native only. */
+    TArray<FISMInstanceColumnSnapshot> Columns;
+
+    /** Column value for Instances[SnapshotIndex], or nullptr if the column was not copied or T does not match */
+    template<typename T>
+    const T* GetColumnValue(FName ColumnName, int32 SnapshotIndex) const
+    {
+        const FISMInstanceColumnSnapshot* Column = Columns.FindByPredicate(
+            [ColumnName](const FISMInstanceColumnSnapshot& C) { return C.Name == ColumnName; });
+        if (!Column || Column->ElementSize != sizeof(T) || !Instances.IsValidIndex(SnapshotIndex))
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(Column->Data.GetData() + static_cast<SIZE_T>(SnapshotIndex) * sizeof(T));
+    }
+
     /** Whether this snapshot contains any instances. */
-    bool IsEmpty() const { return Instances.Num() == 0; }
+    bool IsEmpty() const { return Num() == 0; }
 
-    /** Number of instances in this chunk. */
-    int32 Num() const { return Instances.Num(); }
+    /** Number of instances in this chunk, in whichever layout was requested. */
+    int32 Num() const { return Instances.Num() + SoA.Num(); }
 
     bool IsValid() const;
+
+    /** Heap bytes held by the instance data, both layouts and columns included */
+    SIZE_T GetAllocatedSize() const;
 };
 
 
@@ -170,6 +242,68 @@ struct ISMRUNTIMECORE_API FISMInstanceMutation
 };
 
 
+// ============================================================
+//  Mutation Streams  (compact alternative to FISMInstanceMutation)
+// ============================================================
+
+/** One custom data slot write */
+struct FISMCustomDataWrite
+{
+    int32 InstanceIndex = INDEX_NONE;
+    int32 Slot = 0;
+    float Value = 0.0f;
+};
+
+/**
+ * Typed per-field write streams, one flat array per kind of write. A transformer that writes one
+ * field per instance fills one stream instead of an FISMInstanceMutation with optionals and a heap
+ * array each; the scheduler applies each stream in a single loop. Streams apply after Mutations,
+ * in stream order, and are still gated by the result's WrittenFields. Native only.
+ */
+struct FISMMutationStreams
+{
+    /** Transform stream: parallel arrays, passed straight to the component's batched update */
+    TArray<int32>      TransformIndices;
+    TArray<FTransform> Transforms;
+
+    TArray<FISMCustomDataWrite> CustomDataWrites;
+    TArray<FISMStateFlagsWrite> StateFlagsWrites;
+
+    void AddTransform(int32 InstanceIndex, const FTransform& NewTransform)
+    {
+        TransformIndices.Add(InstanceIndex);
+        Transforms.Add(NewTransform);
+    }
+
+    void AddCustomData(int32 InstanceIndex, int32 Slot, float Value)
+    {
+        CustomDataWrites.Add({ InstanceIndex, Slot, Value });
+    }
+
+    void AddStateFlags(int32 InstanceIndex, uint8 SetMask, uint8 ClearMask)
+    {
+        StateFlagsWrites.Add({ InstanceIndex, SetMask, ClearMask });
+    }
+
+    bool IsEmpty() const { return TransformIndices.IsEmpty() && CustomDataWrites.IsEmpty() && StateFlagsWrites.IsEmpty(); }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return TransformIndices.GetAllocatedSize() + Transforms.GetAllocatedSize()
+            + CustomDataWrites.GetAllocatedSize() + StateFlagsWrites.GetAllocatedSize();
+    }
+
+    /** Empty every stream, keeping capacity */
+    void Reset()
+    {
+        TransformIndices.Reset();
+        Transforms.Reset();
+        CustomDataWrites.Reset();
+        StateFlagsWrites.Reset();
+    }
+};
+
+
 // ============================================================
 //  Batch Mutation Result  (transformer's response to one chunk)
 // ============================================================
@@ -189,8 +323,8 @@ struct ISMRUNTIMECORE_API FISMBatchMutationResult
 
     /**
      * Token from the FISMBatchSnapshot this result corresponds to.
-     * The scheduler matches this against the current component generation token
-     * before applying. Stale results are silently discarded.
+     * Stamped by FISMMutationHandle::Release; the scheduler matches it against
+     * the chunk's current generation before applying. Stale results are silently discarded.
      */
     UPROPERTY(BlueprintReadOnly, Category = "ISM Batch")
     int32 ComponentGenerationToken = 0;
@@ -215,10 +349,55 @@ struct ISMRUNTIMECORE_API FISMBatchMutationResult
     UPROPERTY(BlueprintReadWrite, Category = "ISM Batch")
     TArray<FISMInstanceMutation> Mutations;
 
+    /** Compact per-field writes, applied after Mutations. Native only. */
+    FISMMutationStreams Streams;
+
+    /** Stamped by FISMMutationHandle::Release; tells apart sub-chunks sharing a cell. Native only. */
+    uint32 ChunkId = 0;
+
+    /**
+     * The chunk's snapshot, handed back on release when a downstream transformer consumes this
+     * chunk (FISMSnapshotRequest::ConsumesOutputOf). The scheduler applies the result to it and
+     * passes it on instead of re-reading the component. Native only.
+     */
+    FISMBatchSnapshot ForwardedSnapshot;
+
     /** Convenience: whether there is anything to apply. */
-    bool IsEmpty() const { return Mutations.IsEmpty(); }
+    bool IsEmpty() const { return Mutations.IsEmpty() && Streams.IsEmpty(); }
+
+    /** Heap bytes held by the mutations, streams and forwarded snapshot */
+    SIZE_T GetAllocatedSize() const;
+};
+
+
+// ============================================================
+//  Chunk Relevance
+// ============================================================
+
+/** A chunk about to be planned, as seen by the chunk relevance function */
+struct FISMChunkRelevanceQuery
+{
+    const UISMRuntimeComponent* Component = nullptr;
+    FName                       TransformerName;
+
+    /** Spatial cell of the chunk; ZeroValue for whole-component chunks */
+    FIntVector                  Cell = FIntVector::ZeroValue;
+
+    /** World bounds of the cell, or of the component's instances for whole-component chunks */
+    FBox                        Bounds = FBox(ForceInit);
 };
 
+struct FISMChunkRelevance
+{
+    /** Higher launches first among the transformer's chunks of one dispatch */
+    float Priority = 0.0f;
+
+    /** Process on every Nth dispatch of the transformer; 1 = every dispatch, <= 0 = skip this dispatch */
+    int32 UpdateInterval = 1;
+};
+
+using FISMChunkRelevanceFunction = TFunction<FISMChunkRelevance(const FISMChunkRelevanceQuery&)>;
+
 
 // ============================================================
 //  Snapshot Request
@@ -265,6 +444,10 @@ struct ISMRUNTIMECORE_API FISMSnapshotRequest
     UPROPERTY(BlueprintReadWrite, Category = "ISM Batch")
     EISMSnapshotField WriteMask = EISMSnapshotField::None;
 
+    /** Registered instance data columns to copy into FISMBatchSnapshot::Columns (read only). */
+    UPROPERTY(BlueprintReadWrite, Category = "ISM Batch")
+    TArray<FName> ReadColumns;
+
     /**
      * Hard cap on instances per chunk.
      * 0 = use subsystem default (recommended).
@@ -274,6 +457,66 @@ struct ISMRUNTIMECORE_API FISMSnapshotRequest
     UPROPERTY(BlueprintReadWrite, Category = "ISM Batch")
     int32 MaxInstancesPerChunkOverride = 0;
 
+    /**
+     * Fill FISMBatchSnapshot::SoA instead of Instances: one array per field and a flat custom data
+     * buffer, rather than an FISMInstanceSnapshot with its own custom data allocation per instance.
+     * Native only; Blueprint transformers read Instances.
+     */
+    bool bStructureOfArrays = false;
+
+    /**
+     * Transformer whose output this one consumes. When both dispatch in the same tick this one
+     * runs in a later stage, and each of its chunks is the upstream chunk's snapshot with the
+     * upstream result applied in memory, instead of a fresh read of the component. Chained chunks
+     * follow the upstream's cell split; target components the upstream does not cover are chunked
+     * as usual. Only honoured when the upstream ranks ahead in priority (registration order on
+     * ties), uses the same bStructureOfArrays layout and has no other consumer this tick.
+     * Otherwise only the stage ordering applies. Native only.
+     */
+    FName ConsumesOutputOf;
+
+    /**
+     * Ask the scheduler's chunk relevance function (UISMBatchSchedulerBase::SetChunkRelevanceFunction)
+     * how urgent each chunk is: higher priority chunks launch first and chunks with an update interval
+     * of N are processed on every Nth dispatch of this transformer, staggered across cells. For
+     * continuous work such as animation; leave off for one-shot work, whose skipped chunks would be
+     * lost. Native only.
+     */
+    bool bUseChunkRelevance = false;
+
+    /**
+     * Relevance for this request's chunks in place of the scheduler-wide function, for transformers
+     * that know their own range (distance tiers around their own reference point). Only consulted
+     * with bUseChunkRelevance. Called on the game thread during planning. Native only.
+     */
+    FISMChunkRelevanceFunction ChunkRelevance;
+
+    /**
+     * Snapshot only the instances whose DeltaFields changed since this transformer's last completed
+     * dispatch on the component; the first dispatch sees everything. The scheduler keeps one change
+     * cursor per transformer and component and only advances it when every chunk of the cycle was
+     * applied, so discarded or abandoned work is offered again. The transformer's own writes count
+     * as changes - narrow DeltaFields to the fields others write to avoid re-processing them.
+     * Update intervals from chunk relevance are ignored, since a skipped delta would be lost. Native only.
+     */
+    bool bDeltaOnly = false;
+
+    /** Fields bDeltaOnly watches; None = ReadMask */
+    EISMSnapshotField DeltaFields = EISMSnapshotField::None;
+
+    EISMSnapshotField GetDeltaFields() const { return DeltaFields != EISMSnapshotField::None ? DeltaFields : ReadMask; }
+
     /** Whether this request has a valid spatial bounds filter set. */
     bool HasSpatialBounds() const { return SpatialBounds.IsValid != 0; }
+
+    /** One side writes a field the other reads or writes, so they must not run on a cell at once */
+    static bool AccessConflicts(EISMSnapshotField ReadA, EISMSnapshotField WriteA, EISMSnapshotField ReadB, EISMSnapshotField WriteB)
+    {
+        return EnumHasAnyFlags(WriteA, ReadB | WriteB) || EnumHasAnyFlags(WriteB, ReadA);
+    }
+
+    bool ConflictsWith(const FISMSnapshotRequest& Other) const
+    {
+        return AccessConflicts(ReadMask, WriteMask, Other.ReadMask, Other.WriteMask);
+    }
 };
\ No newline at end of file
@@ -47,6 +47,13 @@ struct ISMRUNTIMECORE_API FISMCustomDataConversionResult
 
     /** Whether a new DMI was created (cache miss) or reused (cache hit) */
     bool bCacheHit = false;
+
+    /**
+     * Instance the result was resolved for. CustomPrimitiveData schemas read its custom data
+     * when the result is applied, so nothing is copied at resolve time.
+     */
+    TWeakObjectPtr<UISMRuntimeComponent> SourceComponent;
+    int32 SourceInstanceIndex = INDEX_NONE;
 };
 
 /**
@@ -68,6 +75,9 @@ struct ISMRUNTIMECORE_API FISMCustomDataConversionResult
  *   5. For slots not handled by the interface, apply DMI directly to
  *      the first UMeshComponent found on the actor
  *
+ * Schemas in CustomPrimitiveData mode skip steps 3-5 for every slot not listed in
+ * DMIFallbackSlots: the mapped values are written to the actor mesh's custom primitive data.
+ *
  * This class has no state — all inputs come in, results go out.
  * Instance as a UObject only for UE reflection; all methods are static.
  */
@@ -91,6 +101,22 @@ public:
         AActor* ConvertedActor,
         UWorld* World);
 
+    /**
+     * ResolveAndApply for many conversions at once, e.g. a physics burst. Handles[i] converts
+     * to Actors[i]. Schema, applicable slots and slot templates are resolved once per component,
+     * instances are grouped by material signature, and each unique signature is acquired from
+     * the pool once, taking one reference per actor slot it is applied to.
+     *
+     * @param Handles           The instances being converted
+     * @param Actors            The converted actors, parallel to Handles; null entries are skipped
+     * @param World             World context for subsystem access
+     * @return                  Number of actors that received materials or custom primitive data
+     */
+    static int32 ResolveAndApplyBatch(
+        TConstArrayView<FISMInstanceHandle> Handles,
+        TConstArrayView<AActor*> Actors,
+        UWorld* World);
+
     /**
      * Resolve DMIs without applying them to any actor.
      * Useful for pre-resolving materials before an actor is spawned,
@@ -178,7 +204,7 @@ private:
      */
     static UMaterialInstanceDynamic* ResolvePooledDMI(
         UMaterialInterface* Template,
-        const TArray<float>& CustomData,
+        TConstArrayView<float> CustomData,
         const FISMCustomDataSchema& Schema,
         int32 SlotIndex,
         UISMCustomDataSubsystem* Subsystem,
@@ -195,6 +221,18 @@ private:
         int32 SlotIndex,
         UMaterialInstanceDynamic* DMI);
 
+    /**
+     * CustomPrimitiveData mode: write each gather table entry into the actor's custom primitive
+     * data at its PrimitiveDataIndex. Targets IISMCustomDataMaterialProvider::GetCustomPrimitiveDataTarget
+     * if the actor provides one, else its first UMeshComponent.
+     *
+     * @return true if a target component received the values
+     */
+    static bool ApplyCustomPrimitiveDataToActor(
+        const FISMCustomDataGatherTable& Gather,
+        TConstArrayView<float> CustomData,
+        AActor* Actor);
+
     /**
      * Fallback: find the first UMeshComponent on an actor and apply material directly.
      * Used when the actor doesn't implement IISMCustomDataMaterialProvider.
@@ -4,6 +4,8 @@
 #include "UObject/Interface.h"
 #include "ISMCustomDataMaterialProvider.generated.h"
 
+class UPrimitiveComponent;
+
 UINTERFACE(MinimalAPI, BlueprintType)
 class UISMCustomDataMaterialProvider : public UInterface
 {
@@ -70,4 +72,14 @@ public:
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ISM Custom Data")
     bool ShouldSkipSlot(int32 SlotIndex) const;
     virtual bool ShouldSkipSlot_Implementation(int32 SlotIndex) const { return false; }
+
+    /**
+     * Optional: the component that receives custom primitive data when the schema's ApplyMode
+     * is CustomPrimitiveData.
+     *
+     * Default: nullptr (the first UMeshComponent on the actor).
+     */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ISM Custom Data")
+    UPrimitiveComponent* GetCustomPrimitiveDataTarget() const;
+    virtual UPrimitiveComponent* GetCustomPrimitiveDataTarget_Implementation() const { return nullptr; }
 };
\ No newline at end of file
@@ -10,6 +10,21 @@
 //  Schema Channel Definition
 // ============================================================
 
+/** How a schema carries instance custom data onto a converted actor's mesh */
+UENUM(BlueprintType)
+enum class EISMCustomDataApplyMode : uint8
+{
+    /** Parameterize a pooled DMI per distinct signature and swap it onto each applicable slot */
+    DynamicMaterial,
+
+    /**
+     * Write mapped values straight into the mesh's custom primitive data. No DMI, no material
+     * swap and no allocation; the mesh keeps batching with its siblings. Requires materials that
+     * read the parameters through "Use Custom Primitive Data".
+     */
+    CustomPrimitiveData
+};
+
 /**
  * Defines how a single PICD channel (or consecutive channels for vectors)
  * maps to a named material parameter.
@@ -53,6 +68,32 @@ struct ISMRUNTIMECORE_API FISMCustomDataChannelDef
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Channel")
     FString Description;
 
+    /**
+     * Pooling tolerance. Values are snapped to multiples of this step before the DMI pool
+     * signature is built, and shared DMIs are created from the snapped values, so instances
+     * within half a step of each other share one DMI. Vectors snap per component.
+     * 0 = exact values (every distinct value gets its own DMI).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Channel", meta = (ClampMin = "0.0"))
+    float QuantizationStep = 0.0f;
+
+    /**
+     * Custom primitive data index this channel is written to in CustomPrimitiveData mode
+     * (vectors use consecutive indices). INDEX_NONE = same as DataIndex.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Channel", meta = (ClampMin = "-1"))
+    int32 PrimitiveDataIndex = INDEX_NONE;
+
+    int32 GetPrimitiveDataIndex() const { return PrimitiveDataIndex != INDEX_NONE ? PrimitiveDataIndex : DataIndex; }
+
+    /** Value as pooled: snapped to QuantizationStep, with -0 folded into 0 so equal buckets hash equally */
+    float Quantize(float Value) const { return QuantizeToStep(Value, QuantizationStep); }
+
+    static float QuantizeToStep(float Value, float Step)
+    {
+        return Step > 0.0f ? FMath::RoundToFloat(Value / Step) * Step + 0.0f : Value;
+    }
+
     /** Total number of data indices consumed by this channel definition */
     int32 GetWidth() const { return bIsVector ? ComponentCount : 1; }
 
@@ -127,6 +168,18 @@ struct ISMRUNTIMECORE_API FISMCustomDataSchema
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Schema")
     TArray<int32> ApplicableSlots;
 
+    /** How converted actors receive the mapped values */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Schema")
+    EISMCustomDataApplyMode ApplyMode = EISMCustomDataApplyMode::DynamicMaterial;
+
+    /**
+     * In CustomPrimitiveData mode, applicable slots whose material cannot read custom primitive
+     * data and still get a pooled DMI.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Schema",
+              meta = (EditCondition = "ApplyMode == EISMCustomDataApplyMode::CustomPrimitiveData"))
+    TArray<int32> DMIFallbackSlots;
+
     // ===== Helpers =====
 
     /** True if this schema has at least one channel defined */
@@ -138,6 +191,12 @@ struct ISMRUNTIMECORE_API FISMCustomDataSchema
         return ApplicableSlots.Num() == 0 || ApplicableSlots.Contains(SlotIndex);
     }
 
+    /** True if an applicable slot is served by a pooled DMI rather than custom primitive data */
+    bool UsesDMIForSlot(int32 SlotIndex) const
+    {
+        return ApplyMode == EISMCustomDataApplyMode::DynamicMaterial || DMIFallbackSlots.Contains(SlotIndex);
+    }
+
     /**
      * Get the channel definition that occupies a given data index.
      * Returns nullptr if no channel covers that index.
@@ -152,9 +211,50 @@ struct ISMRUNTIMECORE_API FISMCustomDataSchema
     TArray<int32> GetMappedIndices() const;
 
     /**
-     * Extract only the mapped values from a full custom data array.
+     * Extract only the mapped values from a full custom data array, quantized per channel.
      * Used to build the pool signature — unmapped indices are excluded.
      */
     TArray<float> ExtractMappedValues(const TArray<float>& FullCustomData) const;
+
+    /**
+     * Allocation-free ExtractMappedValues: writes into OutMappedValues, which must hold at least
+     * GetNumMappedValues() floats. Indices missing from FullCustomData read as 0.
+     */
+    void ExtractMappedValues(TArrayView<const float> FullCustomData, TArrayView<float> OutMappedValues) const;
+
+    /** Floats ExtractMappedValues produces: the summed width of all channels */
+    int32 GetNumMappedValues() const;
+};
+
+// ============================================================
+//  Gather Table
+// ============================================================
+
+/**
+ * A schema flattened to one entry per mapped float, in ExtractMappedValues order. Built once per
+ * component when its schema is resolved, so conversions gather straight into caller buffers (or
+ * into custom primitive data) without walking channel definitions.
+ */
+struct ISMRUNTIMECORE_API FISMCustomDataGatherTable
+{
+    struct FEntry
+    {
+        /** Custom data index read */
+        int32 SourceIndex = 0;
+
+        /** Custom primitive data index written in CustomPrimitiveData mode */
+        int32 PrimitiveDataIndex = 0;
+
+        float QuantizationStep = 0.0f;
+    };
+
+    TArray<FEntry> Entries;
+
+    void Build(const FISMCustomDataSchema& Schema);
+    void Reset() { Entries.Reset(); }
+    int32 Num() const { return Entries.Num(); }
+
+    /** Same values as FISMCustomDataSchema::ExtractMappedValues. OutMappedValues must hold Num() floats. */
+    void Gather(TArrayView<const float> FullCustomData, TArrayView<float> OutMappedValues) const;
 };
 
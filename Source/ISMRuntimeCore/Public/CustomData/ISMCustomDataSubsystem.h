@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/List.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "CustomData/ISMCustomDataSchema.h"
 #include "ISMCustomDataSubsystem.generated.h"
@@ -8,6 +9,7 @@
 // Forward declarations
 struct FISMInstanceHandle;
 struct FISMCustomDataConversionResult;
+class UISMRuntimeComponent;
 
 // ============================================================
 //  FISMMaterialSignature
@@ -42,26 +44,53 @@ struct ISMRUNTIMECORE_API FISMMaterialSignature
 //  FISMPooledMaterial
 // ============================================================
 
+typedef TDoubleLinkedList<FISMMaterialSignature> FISMMaterialLRUList;
+
 /** Single entry in the shared DMI pool with LRU and ref-count tracking. */
 USTRUCT()
 struct FISMPooledMaterial
 {
     GENERATED_BODY()
 
-    UPROPERTY()
+    /** Kept alive by the subsystem's DMIArena slot, not by this (unreflected) map entry */
     UMaterialInstanceDynamic* DMI = nullptr;
 
-    /** GFrameCounter value when this entry was last requested */
+    /** Slot in UISMCustomDataSubsystem::DMIArena holding DMI's GC reference */
+    int32 ArenaIndex = INDEX_NONE;
+
+    /** GFrameCounter value when this entry was last requested or released */
     uint32 LastUsedFrame = 0;
 
     /** Live instance count using this DMI. Entry is eviction-eligible when 0. */
     int32 RefCount = 0;
+
+    /** Node in the subsystem's idle list while RefCount is 0, else null */
+    FISMMaterialLRUList::TDoubleLinkedListNode* LRUNode = nullptr;
 };
 
 // ============================================================
 //  Statistics structs
 // ============================================================
 
+/** Shared pool lookups made with one schema */
+USTRUCT(BlueprintType)
+struct FISMDMISchemaPoolStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 CacheHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 CacheMisses = 0;
+
+    float GetHitRate() const
+    {
+        const int32 Total = CacheHits + CacheMisses;
+        return Total > 0 ? static_cast<float>(CacheHits) / static_cast<float>(Total) : 0.f;
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FISMDMIPoolStats
 {
@@ -79,6 +108,25 @@ struct FISMDMIPoolStats
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
     int32 EvictedEntries = 0;
 
+    /** Entries built ahead of use from the prewarm queue */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 PrewarmedDMIs = 0;
+
+    /** DMIs the subsystem's arena holds a GC reference to */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 ArenaDMIs = 0;
+
+    /** Arena DMIs no pool entry owns. Anything but 0 is a pool bookkeeping leak. */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 LeakedDMIs = 0;
+
+    /**
+     * Hits and misses per schema, keyed by schema DisplayName. Use to tune channel
+     * QuantizationStep: a schema with a low hit rate is creating a DMI per instance.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    TMap<FString, FISMDMISchemaPoolStats> SchemaStats;
+
     float GetHitRate() const
     {
         const int32 Total = CacheHits + CacheMisses;
@@ -120,6 +168,48 @@ struct FISMHotPoolStats
     int32 TotalSurrenders = 0;
 };
 
+/** Pool activity over the last completed stats window (PoolStatsWindowSeconds in project settings) */
+USTRUCT(BlueprintType)
+struct FISMDMIPoolWindowStats
+{
+    GENERATED_BODY()
+
+    /** Measured length of the window; 0 until the first window closes */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float WindowSeconds = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float HitsPerSecond = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float MissesPerSecond = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float EvictionsPerSecond = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float TransientFallbacksPerSecond = 0.f;
+
+    /** Shared pool hit rate within the window, 0-1 */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float HitRate = 0.f;
+
+    /** 95th percentile GetOrCreateDMI time in microseconds, hits and misses together */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float P95AcquireMicroseconds = 0.f;
+
+    /** Estimated CPU-side bytes held by shared and hot pool DMIs at the end of the window */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 EstimatedMemoryBytes = 0;
+
+    /** Shared pool cap in force at the end of the window. 0 = unlimited. */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 SharedPoolCap = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 TotalHotPoolCapacity = 0;
+};
+
 // ============================================================
 //  Hot DMI types
 // ============================================================
@@ -160,8 +250,12 @@ struct ISMRUNTIMECORE_API FISMHotDMIRequest
 /**
  * An exclusive, writeable DMI handle for a currently-animating instance.
  * Returned by UISMCustomDataSubsystem::AcquireHotDMI.
- * Surrender via UISMCustomDataSubsystem::SurrenderHotDMI when animation
- * settles — the subsystem then resolves the correct shared pooled DMI.
+ *
+ * The handle is a value ticket: settle tracking lives in the subsystem, keyed by HotId, so
+ * copies of the handle can be stored anywhere. Surrender via UISMCustomDataSubsystem::
+ * SurrenderHotDMI when animation settles - the subsystem then resolves the correct shared
+ * pooled DMI. After an automatic (Timed/AutoDetect) surrender a stored copy still reads as
+ * IsActive(); ask UISMCustomDataSubsystem::IsHotDMIActive for the live state.
  */
 USTRUCT(BlueprintType)
 struct ISMRUNTIMECORE_API FISMHotDMIHandle
@@ -189,21 +283,11 @@ struct ISMRUNTIMECORE_API FISMHotDMIHandle
     /** The request parameters that created this handle */
     FISMHotDMIRequest Request;
 
-    // ===== Internal settle tracking =====
-
-    float ElapsedTime = 0.f;
-    int32 StableFrameCount = 0;
-    TArray<float> LastMappedValues;
-
-    /** True if this handle is currently live */
-    bool IsActive() const { return HotDMI.IsValid(); }
+    /** Id of the subsystem's tracking row for this handle. 0 = never acquired or surrendered. */
+    uint32 HotId = 0;
 
-    /**
-     * Per-frame tick. Advances Timed/AutoDetect settle counters.
-     * Calls SurrenderHotDMI internally when condition is met.
-     * Called automatically by UISMCustomDataSubsystem::TickHotHandles.
-     */
-    void Tick(float DeltaTime, UWorld* World);
+    /** True if this handle was acquired and not surrendered through this copy */
+    bool IsActive() const { return HotId != 0 && HotDMI.IsValid(); }
 };
 
 // ============================================================
@@ -238,11 +322,23 @@ public:
     void Release(int32 SlotIndex);
 
     /** Number of currently claimed slots */
-    int32 GetActiveCount() const;
+    int32 GetActiveCount() const { return NumClaimed; }
 
     /** Total slot capacity */
     int32 GetPoolSize() const { return Slots.Num(); }
 
+    /** Slot array bytes; the DMIs themselves are counted by UISMCustomDataSubsystem::GetAllocatedSize */
+    SIZE_T GetAllocatedSize() const { return Slots.GetAllocatedSize(); }
+
+    /** Add slots up to NewSize without disturbing claimed ones */
+    void Grow(int32 NewSize);
+
+    /** Drop unclaimed slots from the end until NewSize is reached or a claimed slot is hit. Returns the new size. */
+    int32 ShrinkIdle(int32 NewSize);
+
+    /** Most slots claimed at once and acquires that found the pool full since the last call; resets both */
+    void ConsumeWindowCounters(int32& OutPeakActive, int32& OutExhaustedAcquires);
+
     /** The template material all DMIs in this pool were created from */
     UMaterialInterface* GetTemplate() const { return SourceTemplate.Get(); }
 
@@ -256,6 +352,9 @@ private:
 
     TWeakObjectPtr<UMaterialInterface> SourceTemplate;
     TArray<FHotSlot> Slots;
+    int32 NumClaimed = 0;
+    int32 PeakActive = 0;
+    int32 ExhaustedAcquires = 0;
 };
 
 // ============================================================
@@ -306,6 +405,11 @@ public:
         const FISMInstanceHandle& InstanceHandle,
         FName& OutSchemaName) const;
 
+    /** As ResolveSchemaForInstance, for every instance of a component. Cached on the component. */
+    const FISMCustomDataSchema* ResolveSchemaForComponent(
+        const UISMRuntimeComponent* Component,
+        FName& OutSchemaName) const;
+
     // ===== Shared DMI Pool =====
 
     /**
@@ -316,13 +420,16 @@ public:
      * @param CustomData    Full PICD values for the instance
      * @param Schema        Defines which channels to apply and how to pack them
      * @param SlotIndex     Material slot index (used for schema ApplicableSlots check)
+     * @param NumReferences References taken at once, for batches sharing one signature; each
+     *                      is released by its own ReleaseDMI
      * @return              Valid DMI, or nullptr if Template is null
      */
     UMaterialInstanceDynamic* GetOrCreateDMI(
         UMaterialInterface* Template,
-        const TArray<float>& CustomData,
+        TConstArrayView<float> CustomData,
         const FISMCustomDataSchema& Schema,
-        int32 SlotIndex = 0);
+        int32 SlotIndex = 0,
+        int32 NumReferences = 1);
 
     /**
      * Decrement ref count for a pooled DMI.
@@ -330,7 +437,7 @@ public:
      */
     void ReleaseDMI(
         UMaterialInterface* Template,
-        const TArray<float>& CustomData,
+        TConstArrayView<float> CustomData,
         const FISMCustomDataSchema& Schema,
         int32 SlotIndex = 0);
 
@@ -349,6 +456,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Custom Data|Shared Pool")
     FISMDMIPoolStats GetSharedPoolStats() const { return SharedPoolStats; }
 
+    /**
+     * Queue shared pool DMIs for a component's declared and sampled custom data signatures
+     * (see UISMInstanceDataAsset::bPrewarmSharedDMIs). Built MaxPrewarmDMIsPerFrame at a time
+     * from OnWorldTick; entries already pooled are skipped. Called from InitializeInstances.
+     */
+    void QueuePrewarmForComponent(UISMRuntimeComponent* Component);
+
+    /** Prewarm DMIs queued but not built yet */
+    UFUNCTION(BlueprintCallable, Category = "ISM Custom Data|Shared Pool")
+    int32 GetNumPendingPrewarms() const { return PendingPrewarms.Num() - PendingPrewarmHead; }
+
     // ===== Hot DMI Pool =====
 
     /**
@@ -376,11 +494,19 @@ public:
     void SurrenderHotDMI(FISMHotDMIHandle& HotHandle, UWorld* World);
 
     /**
-     * Tick all active hot handles for Timed/AutoDetect auto-surrender.
+     * Tick all active hot handles in one batch: gather each instance's mapped custom data, diff it
+     * against what its hot DMI last received, push only the changed parameters, then evaluate
+     * Timed/AutoDetect settling across all handles and surrender the settled ones together.
      * Called automatically from OnWorldTick.
      */
     void TickHotHandles(float DeltaTime, UWorld* World);
 
+    /** False once a handle was surrendered, manually or by its settle mode */
+    bool IsHotDMIActive(const FISMHotDMIHandle& HotHandle) const;
+
+    /** Hot handles currently tracked */
+    int32 GetNumActiveHotHandles() const { return HotRows.Num(); }
+
     /**
      * Pre-warm a hot pool to avoid first-acquisition cost.
      * Called automatically on first AcquireHotDMI for a given template.
@@ -402,12 +528,69 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Custom Data")
     void ResetStats();
 
+    /** Rates, acquire time and memory estimate from the last completed stats window */
+    UFUNCTION(BlueprintCallable, Category = "ISM Custom Data")
+    FISMDMIPoolWindowStats GetPoolWindowStats() const { return WindowStats; }
+
+    /**
+     * Bytes held by both pools now: the DMI estimate behind WindowStats.EstimatedMemoryBytes plus the
+     * pool, LRU, prewarm and hot row bookkeeping. Game instance wide, so shared by every world.
+     */
+    SIZE_T GetAllocatedSize() const;
+
+    /** DMIs in the shared arena and hot pool slots */
+    int32 GetNumPooledDMIs() const;
+
+    /**
+     * Shared pool cap in force: the auto-tuned cap when bAutoTuneDMIPools is set and a window
+     * has been tuned, DefaultMaxSharedPoolSize otherwise. 0 = unlimited.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Custom Data|Shared Pool")
+    int32 GetEffectiveMaxSharedPoolSize() const;
+
+    /** Headless (UISMRuntimeSettings::HeadlessMode): no DMI is created, acquired or prewarmed */
+    bool IsHeadless() const { return bHeadless; }
+
 private:
+    bool bHeadless = false;
+
     // ===== Shared Pool =====
 
     TMap<FISMMaterialSignature, FISMPooledMaterial> SharedPool;
     FISMDMIPoolStats SharedPoolStats;
-    uint32 LastEvictionFrame = 0;
+
+    /**
+     * The only GC reference to shared pool DMIs: one reflected array instead of a rooted object
+     * per entry. Each entry owns one slot by ArenaIndex; freed slots are nulled and reused, and a
+     * flush drops the whole array at once.
+     */
+    UPROPERTY(Transient)
+    TArray<UMaterialInstanceDynamic*> DMIArena;
+
+    TArray<int32> FreeArenaSlots;
+
+    /**
+     * Unreferenced pool entries, least recently released first. Entries join at the tail when
+     * their last reference is released and leave when requested again, so LastUsedFrame ascends
+     * from head to tail: eviction pops the head and the stale sweep stops at the first young entry.
+     */
+    FISMMaterialLRUList IdleEntries;
+
+    /** Automatic evictions spent this frame, against MaxAutoEvictionsPerFrame */
+    uint32 EvictionBudgetFrame = 0;
+    int32 EvictionsThisFrame = 0;
+
+    struct FPendingPrewarm
+    {
+        TWeakObjectPtr<UMaterialInterface> Template;
+        TArray<float> CustomData;
+        FName SchemaName;
+        int32 SlotIndex = 0;
+    };
+
+    /** FIFO of DMIs to build ahead of use; PendingPrewarmHead is the next one */
+    TArray<FPendingPrewarm> PendingPrewarms;
+    int32 PendingPrewarmHead = 0;
 
     // ===== Schema Cache =====
 
@@ -419,11 +602,75 @@ private:
     UPROPERTY()
     TMap<TWeakObjectPtr<UMaterialInterface>, UISMHotDMIPool*> HotPools;
 
-    /** Non-owning pointers to live FISMHotDMIHandles (stack/member lifetime) */
-    TArray<FISMHotDMIHandle*> ActiveHotHandles;
+    /**
+     * Settle tracking for every active hot handle, one row per handle in parallel arrays so the
+     * per-frame diff and settle passes stream through contiguous memory. Mapped values are
+     * stored flat: row i owns [ValueOffsets[i], ValueOffsets[i] + ValueCounts[i]) of Values.
+     */
+    struct FHotHandleRows
+    {
+        TArray<uint32> Ids;
+        TArray<FISMInstanceHandle*> Instances;
+        TArray<TWeakObjectPtr<UMaterialInstanceDynamic>> DMIs;
+        TArray<TWeakObjectPtr<UISMHotDMIPool>> Pools;
+        TArray<int32> PoolSlots;
+        TArray<int32> MaterialSlots;
+        TArray<const FISMCustomDataSchema*> Schemas;
+
+        TArray<EISMAnimationSettleMode> SettleModes;
+        TArray<int32> SettleFrameThresholds;
+        TArray<float> SettleDurations;
+        TArray<float> Elapsed;
+        TArray<int32> StableFrames;
+
+        TArray<int32> ValueOffsets;
+        TArray<int32> ValueCounts;
+
+        /** Mapped values each hot DMI last received */
+        TArray<float> Values;
+
+        /** This frame's gathered values, laid out as Values */
+        TArray<float> Gathered;
+
+        /** Per-row flags written by the tick passes */
+        TArray<uint8> Changed;
+        TArray<uint8> Settled;
+
+        int32 Num() const { return Ids.Num(); }
+        int32 Find(uint32 Id) const { return Ids.Find(Id); }
+        void Reset();
+
+        /** Drop rows (ascending indices) in one compaction pass */
+        void RemoveRows(TConstArrayView<int32> SortedRows);
+    };
+
+    FHotHandleRows HotRows;
+    uint32 NextHotId = 1;
 
     FISMHotPoolStats HotPoolStats;
 
+    /** Hot handle tick time from frames the frame budget skipped, added to the next tick */
+    float DeferredHotTickSeconds = 0.0f;
+
+    // ===== Windowed Stats / Auto-Tune =====
+
+    FISMDMIPoolWindowStats WindowStats;
+
+    /** Start of the open window and the cumulative counters as they were then */
+    double WindowStartSeconds = 0.0;
+    int32 WindowStartHits = 0;
+    int32 WindowStartMisses = 0;
+    int32 WindowStartEvictions = 0;
+    int32 WindowStartFallbacks = 0;
+
+    /** Ring of recent GetOrCreateDMI times in microseconds; once full, the oldest sample is overwritten */
+    static constexpr int32 MaxAcquireSamples = 512;
+    TArray<float> AcquireSamples;
+    int32 NextAcquireSample = 0;
+
+    /** Shared pool cap chosen by auto-tuning; 0 until the first tuned window */
+    int32 TunedMaxSharedPoolSize = 0;
+
     // ===== Delegate Handles =====
 
     FDelegateHandle WorldTickHandle;
@@ -434,28 +681,75 @@ private:
 
     // ===== Helpers =====
 
-    FISMMaterialSignature BuildSignature(
+    void BuildSignature(
         UMaterialInterface* Template,
-        const TArray<float>& CustomData,
+        TConstArrayView<float> CustomData,
         const FISMCustomDataSchema& Schema,
-        int32 SlotIndex) const;
+        int32 SlotIndex,
+        FISMMaterialSignature& OutSig) const;
+
+    /** Scratch key for pool lookups, so a cache hit builds its signature without allocating */
+    FISMMaterialSignature LookupSignature;
 
     UMaterialInstanceDynamic* CreateAndApplyDMI(
         UMaterialInterface* Template,
-        const TArray<float>& CustomData,
+        TConstArrayView<float> CustomData,
         const FISMCustomDataSchema& Schema,
         int32 SlotIndex);
 
     void ApplyCustomDataToMaterial(
         UMaterialInstanceDynamic* DMI,
-        const TArray<float>& CustomData,
+        TConstArrayView<float> CustomData,
         const FISMCustomDataSchema& Schema,
         int32 SlotIndex) const;
 
-    void EvictLRUEntry();
+    /** Evict the least recently released idle entry. False if none is idle. */
+    bool EvictLRUEntry();
+
+    /** Take an automatic eviction from this frame's budget; false once it is spent */
+    bool ConsumeEvictionBudget();
+
+    /** Move an entry onto / off the idle list */
+    void LinkIdle(const FISMMaterialSignature& Sig, FISMPooledMaterial& Entry);
+    void UnlinkIdle(FISMPooledMaterial& Entry);
+
+    /** Release an entry's arena slot and drop it, unlinking it first */
+    void RemoveSharedEntry(const FISMMaterialSignature& Sig);
+
+    /** Hand a new DMI's GC reference to the arena. Returns its slot. */
+    int32 AdoptDMI(UMaterialInstanceDynamic* DMI);
+
+    /** Null an arena slot for reuse; the DMI is collected on the next GC pass */
+    void ReleaseArenaSlot(int32 ArenaIndex);
+
+    /** Make room for NumNew DMIs up front so a batch of creations does not regrow the arena */
+    void ReserveArena(int32 NumNew);
+
+    /** Refresh TotalPooledDMIs, ArenaDMIs and LeakedDMIs */
+    void UpdatePoolSizeStats();
+
+    /** Build up to MaxPrewarmDMIsPerFrame queued prewarm entries */
+    void ProcessPendingPrewarms();
 
     UISMHotDMIPool* GetOrCreateHotPool(UMaterialInterface* Template);
 
+    /** Release row's hot slot and hand its instance the shared DMI for its final values. Row stays until RemoveRows. */
+    void SurrenderHotRow(int32 Row, UWorld* World);
+
+    /** Push the parameters of Row whose gathered values differ from the last pushed ones */
+    void PushChangedHotParameters(int32 Row);
+
+    void RecordAcquireTime(uint64 StartCycles);
+
+    /** Fill WindowStats from the window ending at Now, auto-tune if enabled, and open the next window */
+    void CloseStatsWindow(double Now);
+
+    /** Estimated CPU-side bytes held by pooled DMIs; OutNumDMIs counts those measured */
+    int64 EstimatePoolMemory(int32& OutNumDMIs) const;
+
+    /** Resize hot pools and pick TunedMaxSharedPoolSize against DMIPoolMemoryBudgetMB */
+    void AutoTunePools(int64 MemoryBytes, int32 NumDMIs, int32 WindowHits, int32 WindowMisses);
+
     void OnWorldTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
 
 #if WITH_EDITOR
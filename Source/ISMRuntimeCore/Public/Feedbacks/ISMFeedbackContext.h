@@ -69,6 +69,10 @@ struct ISMRUNTIMECORE_API FISMFeedbackBatchedInstanceInfo
  * - Snapshot pattern: Stores transform at feedback creation time to prevent stale data
  * - Dual reference: Actor + Component for precise attribution
  * - Tags + PhysMat: Enables material-specific feedback routing
+ * - Lazy: FromISMComponent/FromActorComponent only record the component (and instance).
+ *   Transform, tags and physical material are gathered by Resolve(), which the feedback
+ *   subsystem calls just before a request reaches a provider - requests culled, merged or
+ *   with no provider never pay for them. Read through GetTransform()/GetTags() when in doubt.
  *
  * Examples:
  * - Player harvesting tree: Participant = Player + ToolComponent
@@ -100,6 +104,16 @@ struct ISMRUNTIMECORE_API FISMFeedbackParticipant
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Feedback|Participant")
     TWeakObjectPtr<UPhysicalMaterial> ParticipantPhysicalMaterial = nullptr;
 
+    /** Instance on an ISM runtime component this participant stands for (INDEX_NONE = the component itself) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Feedback|Participant")
+    int32 InstanceIndex = INDEX_NONE;
+
+    /**
+     * Whether transform, tags and physical material have been gathered.
+     * False only for participants built by FromISMComponent/FromActorComponent until Resolve().
+     */
+    bool bResolved = true;
+
     /** Check if this participant has valid data */
     bool IsValid() const
     {
@@ -114,8 +128,32 @@ struct ISMRUNTIMECORE_API FISMFeedbackParticipant
 
 
     void TryUpdateTags();
-    
-    
+
+    /** Gather transform, tags and physical material from the recorded component once */
+    void Resolve();
+
+    /** Transform snapshot, resolving the participant first if needed */
+    const FTransform& GetTransform() const
+    {
+        const_cast<FISMFeedbackParticipant*>(this)->Resolve();
+        return ParticipantTransform;
+    }
+
+    /** Tags, resolving the participant first if needed */
+    const FGameplayTagContainer& GetTags() const
+    {
+        const_cast<FISMFeedbackParticipant*>(this)->Resolve();
+        return ParticipantTags;
+    }
+};
+
+/** Per-frame memo of FISMFeedbackContext::GetBatchedInstanceInfo, shared by copies of a context */
+struct FISMFeedbackBatchedInfoMemo
+{
+    uint64 Frame = 0;
+    bool bWithGameplayTags = false;
+    int32 CustomDataCount = 0;
+    TArray<FISMFeedbackBatchedInstanceInfo> Infos;
 };
 
 /**
@@ -316,6 +354,38 @@ struct ISMRUNTIMECORE_API FISMFeedbackContext
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Feedback|ISMRuntime|BatchedOperations")
 	TArray<int32> BatchedInstanceIndices;
 
+    /**
+     * Instance on the subject ISM component this feedback was created for.
+     * Set by CreateFromInstance; lets the subsystem fold per-instance requests into a batch.
+     */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Feedback|ISMRuntime|BatchedOperations")
+    int32 SubjectInstanceIndex = INDEX_NONE;
+
+    /**
+     * Number of feedback events this context stands for.
+     * 1 for a plain request, the instance count for a batched one, and the sum of the merged
+     * requests when the subsystem coalesces queued feedback. Location is then their centroid
+     * and Intensity/Force their maximum - spawn one effect scaled by this count instead of many.
+     */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Feedback|ISMRuntime|BatchedOperations")
+    int32 EventCount = 1;
+
+    // ===== Significance =====
+
+    /**
+     * How much this feedback matters to the local player (0-1), from distance to the camera,
+     * intensity and whether it is on screen. Scored by UISMFeedbackSubsystem for queued requests;
+     * immediate requests keep 1. Providers use it to spend per-frame budgets on what is noticed.
+     */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Feedback|Significance")
+    float Significance = 1.0f;
+
+    /** Frames this request has waited in the feedback queue past its first processing pass */
+    uint8 DeferredFrames = 0;
+
+    /** Memo for GetBatchedInstanceInfo; reset whenever BatchedInstanceIndices changes */
+    mutable TSharedPtr<FISMFeedbackBatchedInfoMemo> BatchedInfoMemo;
+
     // ===== Custom Parameters =====
 
     /**
@@ -359,6 +429,12 @@ struct ISMRUNTIMECORE_API FISMFeedbackContext
     /** Check if this context has a valid subject */
     bool HasSubject() const { return Subject.IsValid(); }
 
+    /** Resolve Instigator and Subject so their transform, tags and material fields can be read directly */
+    void ResolveParticipants();
+
+    /** Whether either participant still has deferred data */
+    bool HasUnresolvedParticipants() const { return !Instigator.bResolved || !Subject.bResolved; }
+
     /** Check if this is a continuous feedback message (not ONE_SHOT) */
     bool IsContinuous() const { return FeedbackMessageType != EISMFeedbackMessageType::ONE_SHOT; }
 
@@ -448,6 +524,8 @@ struct ISMRUNTIMECORE_API FISMFeedbackContext
     {
         FISMFeedbackContext NewContext = *this;
 		NewContext.BatchedInstanceIndices = indexes;
+        NewContext.EventCount = FMath::Max(indexes.Num(), 1);
+        NewContext.BatchedInfoMemo.Reset();
         return NewContext;
     }
 
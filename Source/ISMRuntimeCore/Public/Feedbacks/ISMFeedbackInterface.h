@@ -171,4 +171,14 @@ public:
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ISM Feedback")
     void OnFeedbackProviderUnregistered();
     virtual void OnFeedbackProviderUnregistered_Implementation() {}
+    
+    /**
+     * Optional: Called when something that can request these tags appears in the world
+     * (e.g. an ISM runtime component with feedback tags begins play), and on registration
+     * with every tag made relevant so far.
+     * Use to stream in the assets behind those tags before the first request arrives.
+     */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ISM Feedback")
+    void OnFeedbackTagsRelevant(const FGameplayTagContainer& FeedbackTags);
+    virtual void OnFeedbackTagsRelevant_Implementation(const FGameplayTagContainer& FeedbackTags) {}
 };
\ No newline at end of file
@@ -0,0 +1,90 @@
+// ISMFeedbackProfiler.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMFeedbackProfiler.generated.h"
+
+/**
+ * Timing summary for one feedback tag or handler over the profiler's sliding window
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMFeedbackTimingStats
+{
+    GENERATED_BODY()
+
+    /** Feedback tag or handler name */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    FName Name;
+
+    /** Samples in the window */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 Count = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float MeanMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float P95Ms = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float MaxMs = 0.0f;
+
+    /** Time spent in the last completed frame */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float LastFrameMs = 0.0f;
+};
+
+/**
+ * The most recent N timing samples of one tag or handler, oldest overwritten first.
+ */
+struct ISMRUNTIMECORE_API FISMFeedbackTimingWindow
+{
+    /** Ring buffer, at most the profiler's window size */
+    TArray<float> Samples;
+
+    /** Next slot to overwrite once full */
+    int32 Next = 0;
+
+    /** Sum of Samples, kept up to date so the mean is O(1) */
+    double Sum = 0.0;
+
+    /** Accumulated in the current frame */
+    float FrameMs = 0.0f;
+
+    /** Total of the last completed frame */
+    float LastFrameMs = 0.0f;
+
+    void Add(float TimeMs, int32 WindowSize);
+
+    /** Close the current frame */
+    void EndFrame();
+
+    void Reset();
+
+    float GetMean() const { return Samples.Num() > 0 ? static_cast<float>(Sum / Samples.Num()) : 0.0f; }
+
+    /** Count, mean, p95 and max over the window */
+    FISMFeedbackTimingStats Summarize(FName Name) const;
+};
+
+/**
+ * Per-key sliding-window timings, for the feedback subsystem's per-tag and per-handler costs.
+ */
+struct ISMRUNTIMECORE_API FISMFeedbackTimingTable
+{
+    TMap<FName, FISMFeedbackTimingWindow> Windows;
+
+    void Add(FName Key, float TimeMs, int32 WindowSize);
+
+    /** Close the frame of every key; when CsvCategoryIndex >= 0, publish each key's frame time as a CSV custom stat */
+    void EndFrame(int32 CsvCategoryIndex, const TCHAR* CsvPrefix);
+
+    void Reset() { Windows.Reset(); CsvStatNames.Reset(); }
+
+    /** Every key's summary, costliest (mean * count) first */
+    TArray<FISMFeedbackTimingStats> Summarize() const;
+
+private:
+    /** Prefixed CSV stat name per key, built once */
+    TMap<FName, FName> CsvStatNames;
+};
@@ -0,0 +1,99 @@
+// ISMFeedbackRecording.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Feedbacks/ISMFeedbackContext.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/StrongObjectPtr.h"
+
+/**
+ * One routed feedback request, as captured by the recorder.
+ * Only what routing and handlers read without live participants: tag, spatial data,
+ * magnitudes, batch size, physical material and which providers handled it.
+ */
+struct ISMRUNTIMECORE_API FISMFeedbackRecordedEvent
+{
+    /** Index into FISMFeedbackRecording::Names */
+    uint16 TagIndex = 0;
+
+    /** Index into FISMFeedbackRecording::Names, or INDEX_NONE */
+    int16 PhysicalMaterialIndex = INDEX_NONE;
+
+    EISMFeedbackMessageType MessageType = EISMFeedbackMessageType::ONE_SHOT;
+
+    FVector3f Location = FVector3f::ZeroVector;
+    FVector3f Normal = FVector3f::UpVector;
+
+    float Intensity = 1.0f;
+    float Scale = 1.0f;
+    float Force = 0.0f;
+
+    /** Events the request stood for (coalesced or batched) */
+    int32 EventCount = 1;
+
+    /** Bit N set = FISMFeedbackRecording::ProviderNames[N] handled it */
+    uint32 HandledByMask = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FISMFeedbackRecordedEvent& Event);
+};
+
+/** Everything routed during one engine frame */
+struct ISMRUNTIMECORE_API FISMFeedbackRecordedFrame
+{
+    /** Seconds since recording started */
+    float Time = 0.0f;
+
+    TArray<FISMFeedbackRecordedEvent> Events;
+
+    friend FArchive& operator<<(FArchive& Ar, FISMFeedbackRecordedFrame& Frame);
+};
+
+/**
+ * A capture of routed feedback, frame by frame, for replaying real gameplay load offline.
+ *
+ * Tags and physical materials are stored once in a name table and referenced by index,
+ * so an event costs about 50 bytes on disk. Frames with no requests are kept (empty) so
+ * replay preserves the original pacing.
+ */
+struct ISMRUNTIMECORE_API FISMFeedbackRecording
+{
+    /** Gameplay tag names and physical material paths */
+    TArray<FName> Names;
+
+    /** Provider object names, in first-handled order; at most 32 */
+    TArray<FString> ProviderNames;
+
+    TArray<FISMFeedbackRecordedFrame> Frames;
+
+    /** Start a new frame at Time */
+    void BeginFrame(float Time);
+
+    /** Append a routed context to the current frame */
+    void AddEvent(const FISMFeedbackContext& Context, uint32 HandledByMask);
+
+    /** Bit for Provider in HandledByMask, registering its name on first use; 0 once 32 are known */
+    uint32 GetProviderBit(const UObject* Provider);
+
+    /** Rebuild a routable context from an event; participants are left empty */
+    FISMFeedbackContext MakeContext(const FISMFeedbackRecordedEvent& Event) const;
+
+    int32 GetNumEvents() const;
+
+    void Serialize(FArchive& Ar);
+
+    bool SaveToFile(const FString& FilePath);
+    bool LoadFromFile(const FString& FilePath);
+
+private:
+    int32 FindOrAddName(FName Name);
+
+    /** Name table lookup while recording */
+    TMap<FName, int32> NameIndices;
+
+    /** Provider bit lookup while recording */
+    TMap<FObjectKey, int32> ProviderIndices;
+
+    /** Physical materials loaded for MakeContext, per name index */
+    mutable TMap<int32, TStrongObjectPtr<UPhysicalMaterial>> LoadedMaterials;
+};
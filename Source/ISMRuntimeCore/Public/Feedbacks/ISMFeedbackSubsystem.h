@@ -6,6 +6,9 @@
 #include "GameplayTagContainer.h"
 #include "Feedbacks/ISMFeedbackContext.h"
 #include "Feedbacks/ISMFeedbackInterface.h"
+#include "Feedbacks/ISMFeedbackRecording.h"
+#include "Feedbacks/ISMFeedbackProfiler.h"
+#include "Settings/ISMPerformanceProfile.h"
 #include "ISMFeedbackSubsystem.generated.h"
 
 /**
@@ -36,9 +39,58 @@ struct FISMFeedbackStats
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
     int32 UnhandledRequests = 0;
     
-    /** Average time spent processing feedback requests (milliseconds) */
+    /** Number of queued requests dropped for low significance or for waiting too long */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 CulledRequests = 0;
+    
+    /** Number of queued requests merged into another request instead of being routed on their own */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 CoalescedRequests = 0;
+    
+    /** Average time spent processing a feedback request over the last ProfilingWindowSize requests (milliseconds) */
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
     float AverageProcessingTimeMs = 0.0f;
+    
+    /** Time spent routing requests in the last completed frame (milliseconds) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float LastFrameProcessingTimeMs = 0.0f;
+};
+
+/**
+ * Results of replaying a feedback recording
+ */
+USTRUCT(BlueprintType)
+struct FISMFeedbackReplayStats
+{
+    GENERATED_BODY()
+    
+    /** Recorded frames fed back through routing so far */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 FramesReplayed = 0;
+    
+    /** Recorded requests routed so far */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 EventsReplayed = 0;
+    
+    /** Replayed requests at least one provider handled */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 HandledEvents = 0;
+    
+    /** Requests handled when recorded but not on replay (missing provider, handler or asset) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 NewlyUnhandledEvents = 0;
+    
+    /** Time spent routing and in handlers, summed over all replayed frames (milliseconds) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float TotalRouteTimeMs = 0.0f;
+    
+    /** Slowest replayed frame (milliseconds) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float PeakFrameRouteTimeMs = 0.0f;
+    
+    /** Recorded frame that took PeakFrameRouteTimeMs */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 PeakFrameIndex = INDEX_NONE;
 };
 
 /**
@@ -124,6 +176,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
     bool IsProviderRegistered(TScriptInterface<IISMFeedbackInterface> Provider) const;
     
+    /**
+     * Drop the cached tag -> provider routing.
+     * Call when a registered provider changes what CanHandleFeedbackTag or
+     * GetFeedbackPriority return; registration changes invalidate automatically.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    void InvalidateFeedbackDispatch();
+    
+    // ===== Relevance =====
+    
+    /**
+     * Announce feedback tags that may be requested soon so providers can stream their assets.
+     * Only tags not announced before are forwarded; providers registering later receive the
+     * full set.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    void NotifyFeedbackTagsRelevant(const FGameplayTagContainer& FeedbackTags);
+    
+    /** Every tag announced through NotifyFeedbackTagsRelevant */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    FGameplayTagContainer GetRelevantFeedbackTags() const { return RelevantFeedbackTags; }
+    
     // ===== Feedback Requests =====
     
     /**
@@ -156,6 +230,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
     void RequestMultipleFeedback(const TArray<FISMFeedbackContext>& Contexts);
     
+    /** Headless world (UISMRuntimeSettings::HeadlessMode): every request is dropped unrouted */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    bool IsHeadless() const { return bHeadless; }
+    
     // ===== Configuration =====
     
     /**
@@ -172,6 +250,47 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Performance", meta=(EditCondition="bEnableBatching"))
     int32 MaxFeedbackPerFrame = -1;
     
+    /**
+     * Merge queued one-shot requests that share a tag, subject component and spatial cell
+     * into a single request before routing.
+     * The merged context carries EventCount, the centroid location, the max intensity and
+     * all subject instance indices, so a provider spawns one burst instead of hundreds.
+     * Continuous (STARTED/UPDATED/...) feedback is never merged.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Performance", meta=(EditCondition="bEnableBatching"))
+    bool bCoalesceQueuedFeedback = true;
+    
+    /** Size of the spatial cells used to bucket requests for coalescing (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Performance", meta=(EditCondition="bEnableBatching && bCoalesceQueuedFeedback", ClampMin="1.0"))
+    float CoalesceCellSize = 500.0f;
+    
+    /**
+     * Score queued requests against the first player's camera before routing.
+     * The queue is processed most significant first, so when MaxFeedbackPerFrame (or a
+     * provider's own budget) runs out it is the distant, faint, off-screen feedback that waits.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Significance", meta=(EditCondition="bEnableBatching"))
+    bool bScoreSignificance = true;
+    
+    /** Distance from the camera at which the distance term reaches zero (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Significance", meta=(EditCondition="bEnableBatching && bScoreSignificance", ClampMin="1.0"))
+    float SignificanceMaxDistance = 15000.0f;
+    
+    /** Multiplier applied to feedback outside the camera's field of view */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Significance", meta=(EditCondition="bEnableBatching && bScoreSignificance", ClampMin="0.0", ClampMax="1.0"))
+    float OffscreenSignificanceScale = 0.3f;
+    
+    /** Queued requests scoring below this are dropped without reaching a provider */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Significance", meta=(EditCondition="bEnableBatching && bScoreSignificance", ClampMin="0.0", ClampMax="1.0"))
+    float MinFeedbackSignificance = 0.02f;
+    
+    /**
+     * Frames a request may be deferred by MaxFeedbackPerFrame before it is dropped.
+     * Late one-shot feedback reads as a bug; it is better lost than played a second late.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Significance", meta=(EditCondition="bEnableBatching", ClampMin="0"))
+    int32 MaxFeedbackDeferFrames = 3;
+    
     /**
      * Whether to broadcast feedback to ALL providers (true) or stop at first handler (false).
      * True = All providers get the feedback (good for audio + VFX + analytics)
@@ -199,6 +318,17 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Debug", meta=(EditCondition="bDebugDrawFeedback"))
     float DebugDrawDuration = 2.0f;
     
+    /**
+     * Keep per-tag and per-handler timing windows (see GetFeedbackTagTimings) and publish
+     * each tag's and handler's frame cost to the ISMFeedback CSV profiler category.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Debug")
+    bool bProfileFeedbackCosts = true;
+    
+    /** Samples kept per tag or handler, and for AverageProcessingTimeMs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Feedback|Debug", meta=(ClampMin="1", ClampMax="4096"))
+    int32 ProfilingWindowSize = 256;
+    
     // ===== Statistics =====
     
     /**
@@ -213,6 +343,61 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
     void ResetStats();
     
+    /** Routing cost per feedback tag over the sliding window, costliest first */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    TArray<FISMFeedbackTimingStats> GetFeedbackTagTimings() const { return TagTimings.Summarize(); }
+    
+    /** Execution cost per handler (inclusive of children) over the sliding window, costliest first */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    TArray<FISMFeedbackTimingStats> GetFeedbackHandlerTimings() const { return HandlerTimings.Summarize(); }
+    
+    /** Add a handler execution sample; called by providers when bProfileFeedbackCosts is on */
+    void RecordHandlerTiming(FName HandlerName, float TimeMs);
+    
+    // ===== Recording & Replay =====
+    
+    /**
+     * Start capturing every routed request (after coalescing and culling), one recorded frame
+     * per tick. Restarts the capture if one is running.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    void StartFeedbackRecording();
+    
+    /**
+     * Stop capturing and write the binary log.
+     * 
+     * @param FilePath - Destination; empty = Saved/Profiling/ISMFeedback/<timestamp>.ismfb
+     * @return True if a recording was running and the file was written
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    bool StopFeedbackRecording(const FString& FilePath);
+    
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    bool IsRecordingFeedback() const { return Recording.IsValid(); }
+    
+    /**
+     * Feed a recorded log back through routing and the providers registered in this world,
+     * timing each frame. Replayed requests carry no participants; handlers that need them
+     * see what an unattributed request looks like.
+     * 
+     * @param FilePath - Log written by StopFeedbackRecording
+     * @param bMatchRecordedTiming - Replay frames at their recorded times; false = one recorded frame per tick
+     * @return True if the log loaded
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    bool StartFeedbackReplay(const FString& FilePath, bool bMatchRecordedTiming = false);
+    
+    /** Stop a replay early; stats are kept */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    void StopFeedbackReplay();
+    
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    bool IsReplayingFeedback() const { return Replay.IsValid(); }
+    
+    /** Stats of the running or last finished replay */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback|Recording")
+    FISMFeedbackReplayStats GetFeedbackReplayStats() const { return ReplayStats; }
+    
 protected:
     // ===== Provider Management =====
     
@@ -222,12 +407,28 @@ protected:
     /** Weak pointers for cleanup detection */
     TArray<TWeakObjectPtr<UObject>> ProviderObjects;
     
+    /** Tags announced as relevant so far */
+    FGameplayTagContainer RelevantFeedbackTags;
+    
     /** Sort providers by priority */
     void SortProvidersByPriority();
     
     /** Clean up invalid provider references */
     void CleanupInvalidProviders();
     
+    // ===== Dispatch Table =====
+    
+    /**
+     * Providers that accept each requested tag, in priority order.
+     * Built lazily the first time a tag is routed. A tag no provider accepts inherits the
+     * list of its nearest parent that has one, so "Feedback.Impact.Wood" falls back to
+     * the "Feedback.Impact" handlers.
+     */
+    TMap<FGameplayTag, TArray<TWeakObjectPtr<UObject>>> DispatchTable;
+    
+    /** Cached provider list for Tag, building it (and its parents' lists) on a miss */
+    const TArray<TWeakObjectPtr<UObject>>& FindOrBuildDispatchList(const FGameplayTag& Tag);
+    
     // ===== Batching =====
     
     /** Queued feedback requests (when batching enabled) */
@@ -236,14 +437,44 @@ protected:
     /** Process queued feedback requests */
     void ProcessFeedbackQueue();
     
+    /** Merge queued one-shot requests per tag, subject and spatial cell, keeping first-queued order */
+    void CoalesceFeedbackQueue();
+    
+    /** Score the queue against the local camera, drop what falls below MinFeedbackSignificance and sort the rest most significant first */
+    void ScoreFeedbackQueue();
+    
     // ===== Internal Processing =====
     
-    /** Route a single feedback request to providers */
+    /** Route a single feedback request to the providers cached for its tag */
     bool RouteToProviders(const FISMFeedbackContext& Context);
     
     /** Draw debug visualization for a feedback request */
     void DebugDrawFeedback(const FISMFeedbackContext& Context);
     
+    // ===== Recording & Replay =====
+    
+    /** Capture in progress, if any */
+    TUniquePtr<FISMFeedbackRecording> Recording;
+    
+    double RecordingStartTime = 0.0;
+    
+    /** Log being replayed, if any */
+    TUniquePtr<FISMFeedbackRecording> Replay;
+    
+    int32 ReplayFrameIndex = 0;
+    
+    double ReplayStartTime = 0.0;
+    
+    bool bReplayMatchesRecordedTiming = false;
+    
+    FISMFeedbackReplayStats ReplayStats;
+    
+    /** Route the recorded frames due this tick */
+    void TickReplay();
+    
+    /** Route one recorded frame and time it */
+    void ReplayFrame(const FISMFeedbackRecordedFrame& Frame);
+    
     // ===== Statistics =====
     
     /** Cached statistics */
@@ -253,9 +484,26 @@ protected:
     /** Frame number for per-frame stat tracking */
     uint64 CurrentFrame = 0;
     
-    /** Processing time accumulator for averaging */
-    double ProcessingTimeAccumulator = 0.0;
+    /** Recent per-request processing times, for AverageProcessingTimeMs */
+    FISMFeedbackTimingWindow ProcessingTimeWindow;
+    
+    /** Per feedback tag routing times */
+    FISMFeedbackTimingTable TagTimings;
+    
+    /** Per handler execution times, reported by providers */
+    FISMFeedbackTimingTable HandlerTimings;
+    
+    /** Close the frame on the timing windows and publish CSV stats */
+    void EndProfilingFrame();
+    
+    bool bHeadless = false;
+    
+    // ===== Performance Profile =====
+    
+    FDelegateHandle PerformanceProfileHandle;
+    
+    /** Take MaxFeedbackPerFrame and MinFeedbackSignificance from the profile where it overrides them, else from the class defaults */
+    void ApplyPerformanceProfile(const FISMPerformanceProfileSettings& Profile);
     
-    /** Number of samples for averaging */
-    int32 ProcessingTimeSamples = 0;
+    void HandlePerformanceProfileChanged(EISMPerformanceProfile Profile, const FISMPerformanceProfileSettings& ProfileSettings);
 };
\ No newline at end of file
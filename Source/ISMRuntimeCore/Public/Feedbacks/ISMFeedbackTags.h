@@ -192,6 +192,20 @@ public:
      * Usage: ComponentTags.MergeWith(DataAssetTags);
      * Result: Data asset tags override component defaults where specified
      */
+    /** Every valid tag this set can request, batch tags included */
+    FGameplayTagContainer GetAllTags() const
+    {
+        FGameplayTagContainer Tags;
+        for (const FGameplayTag& Tag : { OnSpawn, OnDestroy, OnHide, OnShow, OnTransformUpdate, GetBatchSpawnTag(), GetBatchDestroyTag() })
+        {
+            if (Tag.IsValid())
+            {
+                Tags.AddTag(Tag);
+            }
+        }
+        return Tags;
+    }
+    
     FISMFeedbackTags OverrideWith(const FISMFeedbackTags& Other) const
     {
         FISMFeedbackTags Merged = *this;
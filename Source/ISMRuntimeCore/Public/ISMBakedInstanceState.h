@@ -0,0 +1,114 @@
+// ISMBakedInstanceState.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "ISMBakedInstanceState.generated.h"
+
+class UISMRuntimeComponent;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Cooked runtime state of one UISMRuntimeComponent, e.g. the result of a Precompute PCG graph.
+ *
+ * Written by UISMRuntimeComponent::BakeState (in the editor, after the graph has applied) and
+ * read by InitializeInstances when assigned as the component's BakedState: instances, custom
+ * data, state flags and tags are loaded as whole arrays and the spatial index takes the baked
+ * cells as they are, so level start skips the graph run, the index build and tag setup.
+ * World pivots, per-instance AABBs and the cell bounds are precomputed too, so static content
+ * adopts its bounds instead of transforming every instance (see FISMBakeUtilities in ISMRuntimeEditor).
+ *
+ * A bake is only used by a component whose transform, custom data stride and spatial index cell
+ * size match the ones it was baked with (see IsCompatibleWith); otherwise the component
+ * initializes from its ISM as usual. Index storage and coarse levels may differ from the bake's.
+ *
+ * The arrays are not UPROPERTYs: Serialize writes them as raw blocks so loading is a memcpy
+ * per array. TagTable stays a UPROPERTY so the cook sees tag references.
+ */
+UCLASS(BlueprintType)
+class ISMRUNTIMECORE_API UISMBakedInstanceState : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // ===== Bake Settings =====
+
+    /** Component world transform at bake time; spatial cells are in world space */
+    UPROPERTY(VisibleAnywhere, Category = "Baked State")
+    FTransform ComponentTransform;
+
+    UPROPERTY(VisibleAnywhere, Category = "Baked State")
+    float SpatialIndexCellSize = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Baked State")
+    int32 NumCustomDataFloats = 0;
+
+    /** Every per-instance tag any instance carries; InstanceTagIds index into this */
+    UPROPERTY(VisibleAnywhere, Category = "Baked State")
+    TArray<FGameplayTag> TagTable;
+
+    /** ComputeSourceHash of the ISM the bake was taken from, for the editor's stale bake check */
+    UPROPERTY(VisibleAnywhere, Category = "Baked State")
+    uint32 SourceHash = 0;
+
+    /** Padded bounds of the active instances at bake time (UISMRuntimeComponent::GetInstanceBounds) */
+    UPROPERTY(VisibleAnywhere, Category = "Baked State")
+    FBox InstanceBounds = FBox(ForceInit);
+
+    // ===== Per-Instance Data =====
+
+    /** Component-space transforms, one per instance */
+    TArray<FTransform> Transforms;
+
+    /** NumCustomDataFloats per instance */
+    TArray<float> CustomData;
+
+    /** EISMInstanceState bits per instance */
+    TArray<uint8> StateFlags;
+
+    /** Instance N's tags are InstanceTagIds[InstanceTagOffsets[N] .. InstanceTagOffsets[N + 1]) */
+    TArray<int32> InstanceTagOffsets;
+    TArray<uint16> InstanceTagIds;
+
+    // ===== Spatial Index (FISMSpatialIndex::ExportCells layout) =====
+
+    TArray<FIntVector> CellKeys;
+    TArray<int32> CellOffsets;
+    TArray<int32> CellInstances;
+
+    // ===== Precomputed Bounds =====
+
+    /** World pivot of every instance: Transforms[N] * ComponentTransform */
+    TArray<FVector> WorldLocations;
+
+    /** World AABB per instance; empty when the component records none (bComputeInstanceAABBs off or no local bounds) */
+    TArray<FVector3f> BoundsMin;
+    TArray<FVector3f> BoundsMax;
+
+    /** Cell bounds of the active instances (FISMCellBoundsCache::ExportCells layout) */
+    TArray<FIntVector> BoundsCellKeys;
+    TArray<FBox> BoundsCellBoxes;
+    TArray<int32> BoundsCellCounts;
+
+    /** Number of baked instances */
+    UFUNCTION(BlueprintCallable, Category = "Baked State")
+    int32 GetNumInstances() const { return Transforms.Num(); }
+
+    /** Whether Component can initialize from this bake */
+    bool IsCompatibleWith(const UISMRuntimeComponent* Component) const;
+
+    /** Whether per-instance AABBs were baked */
+    bool HasInstanceBounds() const { return BoundsMin.Num() == GetNumInstances() && BoundsMax.Num() == GetNumInstances(); }
+
+    /** Compatible, and taken from the instances and custom data Component's ISM holds now */
+    bool IsUpToDateWith(const UISMRuntimeComponent* Component) const;
+
+    /** Hash of an ISM's instance transforms and custom data */
+    static uint32 ComputeSourceHash(const UInstancedStaticMeshComponent* ISM);
+
+    /** Drop all baked data */
+    void Reset();
+
+    virtual void Serialize(FArchive& Ar) override;
+};
@@ -0,0 +1,71 @@
+// ISMCellBoundsCache.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Exact bounds of a point set, kept as one box per grid cell plus their union.
+ *
+ * Adding a point grows its cell box and the union. Removing one only marks its cell dirty when
+ * the point held a face of the cell box (or was its last point) - an interior point cannot
+ * shrink it. Flat axes, where every point sits on both faces, are ignored. RefreshDirtyCells
+ * rebuilds dirty cells from the caller's own storage, and the union is re-taken over cells only
+ * when a rebuilt cell touched its surface. Removal cost is O(points in the cell + cells) instead
+ * of O(points).
+ */
+class ISMRUNTIMECORE_API FISMCellBoundsCache
+{
+public:
+    /** Drop every cell and switch to a new cell size */
+    void Reset(float InCellSize);
+
+    void Add(const FVector& Location);
+
+    /** Forget a point previously passed to Add */
+    void Remove(const FVector& Location);
+
+    bool HasDirtyCells() const { return DirtyCells.Num() > 0; }
+
+    /**
+     * Rebuild every dirty cell. Gather is called once per dirty cell with the cell's world box and
+     * must report each live point inside it; points outside the cell (e.g. on a shared face) are ignored.
+     */
+    void RefreshDirtyCells(TFunctionRef<void(const FBox& CellBox, TFunctionRef<void(const FVector&)> AddPoint)> Gather);
+
+    /** Union of all cell boxes; invalid when empty. Conservative while cells are dirty. */
+    const FBox& GetBounds() const { return Union; }
+
+    int32 GetCellCount() const { return Cells.Num(); }
+
+    /** Every cell's box and point count, e.g. for a bake. Dirty cells export as they stand, still conservative. */
+    void ExportCells(TArray<FIntVector>& OutKeys, TArray<FBox>& OutBoxes, TArray<int32>& OutCounts) const;
+
+    /**
+     * Replace the contents with cells from ExportCells at InCellSize; the union is re-taken over them.
+     * @return false (cache left empty) if the arrays differ in length
+     */
+    bool ImportCells(float InCellSize, TConstArrayView<FIntVector> Keys, TConstArrayView<FBox> Boxes, TConstArrayView<int32> Counts);
+
+    float GetCellSize() const { return CellSize; }
+
+    SIZE_T GetAllocatedSize() const { return Cells.GetAllocatedSize() + DirtyCells.GetAllocatedSize(); }
+
+private:
+    FIntVector LocationToCell(const FVector& Location) const;
+
+    /** Whether [Min, Max] reaches a face of Box on any axis along which Box has extent */
+    static bool TouchesFace(const FBox& Box, const FVector& Min, const FVector& Max);
+
+    struct FCell
+    {
+        FBox Box = FBox(ForceInit);
+
+        /** Points added minus points removed since the last rebuild */
+        int32 Num = 0;
+    };
+
+    float CellSize = 1000.0f;
+    TMap<FIntVector, FCell> Cells;
+    TSet<FIntVector> DirtyCells;
+    FBox Union = FBox(ForceInit);
+};
@@ -0,0 +1,92 @@
+// ISMCompiledQueryFilter.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMQueryFilter.h"
+#include "ISMInstanceTagBits.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Component-constant half of a compiled filter, produced by FISMCompiledQueryFilter::BindComponent.
+ * Small and copyable so parallel queries can keep one per component on the stack.
+ * Valid for one query: rebind after the component's tags or settings change.
+ */
+struct ISMRUNTIMECORE_API FISMCompiledComponentFilter
+{
+    const UISMRuntimeComponent* Component = nullptr;
+
+    /** Required/excluded tags against the component's compact tag dictionary */
+    FISMTagFilterMasks TagMasks;
+
+    /** Some instance of the component can pass */
+    bool bPasses = false;
+
+    /** TagMasks are exact; otherwise tag sets fall back to the container test */
+    bool bUseTagMasks = false;
+
+    /** Instance AABBs must be tested against the filter box */
+    bool bTestAABB = false;
+
+    /** Instance tag bits every passing instance has, for spatial walks that prune by cell. Empty without tag masks. */
+    FISMTagMask GetRequiredTagMask() const
+    {
+        return bUseTagMasks ? TagMasks.Required : FISMTagMask();
+    }
+};
+
+/**
+ * FISMQueryFilter flattened into a predicate for per-instance loops.
+ *
+ * Compiling turns state lists into two flag bytes and records which checks are active. Binding to a
+ * component does the component-constant work once - interface and mesh checks, AABB availability,
+ * and tag masks against the component's compact tag dictionary. PassesInstance is then a handful
+ * of mask tests, with TagQuery, AABB and CustomFilter only evaluated when set.
+ *
+ * Holds its own copy of the source filter, so one compiled filter can be kept and reused across
+ * frames. PassesInstance gives the same answer as FISMQueryFilter::PassesFilter on a current
+ * reference to the instance.
+ */
+class ISMRUNTIMECORE_API FISMCompiledQueryFilter
+{
+public:
+    FISMCompiledQueryFilter() = default;
+    explicit FISMCompiledQueryFilter(const FISMQueryFilter& InFilter);
+
+    const FISMQueryFilter& GetFilter() const { return Filter; }
+
+    /** Evaluate the parts of the filter that do not vary per instance */
+    FISMCompiledComponentFilter BindComponent(const UISMRuntimeComponent* Component) const;
+
+    /** Per-instance test against a bound component */
+    bool PassesInstance(const FISMCompiledComponentFilter& Bound, int32 InstanceIndex) const;
+
+    /** Binds and tests in one call - for one-off references, not loops */
+    bool PassesFilter(const FISMInstanceReference& Instance) const;
+
+    /** Instance flag test; bHasState false = instance has no state entry */
+    bool PassesStateFlags(bool bHasState, uint8 StateFlags) const
+    {
+        if (!bHasState)
+        {
+            return !bHasRequiredStates;
+        }
+        return !bStatesNeverPass && (StateFlags & RequiredStateMask) == RequiredStateMask && (StateFlags & ExcludedStateMask) == 0;
+    }
+
+private:
+    FISMQueryFilter Filter;
+
+    uint8 RequiredStateMask = 0;
+    uint8 ExcludedStateMask = 0;
+
+    /** RequiredStates was not empty - instances without state never pass */
+    bool bHasRequiredStates = false;
+
+    /** RequiredStates listed EISMInstanceState::None, which no flag byte satisfies */
+    bool bStatesNeverPass = false;
+
+    bool bHasTagSets = false;
+    bool bHasTagQuery = false;
+    bool bHasAABBFilter = false;
+};
@@ -0,0 +1,102 @@
+// ISMComponentBroadphase.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Uniform grid over the bounds of registered runtime components, owned by UISMRuntimeSubsystem.
+ *
+ * World queries ask it for the components their bounds can touch instead of querying every
+ * registered component. Components report bounds changes with MarkDirty; dirty entries are
+ * re-bucketed by Flush before the next query. Entries spanning more than MaxCellsPerEntry
+ * cells, and components that cannot report bounds, are kept on a short list tested per query.
+ */
+class ISMRUNTIMECORE_API FISMComponentBroadphase
+{
+public:
+    /** Candidate lists rarely hold more than a handful of components */
+    using FCandidateArray = TArray<UISMRuntimeComponent*, TInlineAllocator<32>>;
+
+    static constexpr int32 MaxCellsPerEntry = 64;
+
+    explicit FISMComponentBroadphase(float InCellSize = 25600.0f);
+
+    /** Change the grid cell size and re-bucket every entry */
+    void SetCellSize(float InCellSize);
+
+    float GetCellSize() const { return CellSize; }
+
+    /** Start tracking a component at its current bounds. No-op if already tracked. */
+    void Add(UISMRuntimeComponent* Component);
+
+    void Remove(const UISMRuntimeComponent* Component);
+
+    /** Re-read the component's bounds on the next Flush */
+    void MarkDirty(const UISMRuntimeComponent* Component);
+
+    /** Re-bucket dirty entries */
+    void Flush();
+
+    /** Drop entries whose component was destroyed without unregistering */
+    void RemoveStaleEntries();
+
+    void Reset();
+
+    /**
+     * Components whose bounds intersect Box, plus every unbounded component, in registration
+     * slot order without duplicates. Flush first.
+     */
+    void GatherOverlapping(const FBox& Box, FCandidateArray& OutComponents) const;
+
+    /**
+     * Components whose bounds lie within MaxDistance of Location (all, if MaxDistance <= 0),
+     * nearest bounds first. Unbounded components sort at distance 0. Flush first.
+     * @param OutDistancesSq Squared distance from Location to each component's bounds
+     */
+    void GatherByDistance(const FVector& Location, float MaxDistance, FCandidateArray& OutComponents, TArray<float, TInlineAllocator<32>>& OutDistancesSq) const;
+
+    /** Tracked components */
+    int32 Num() const { return EntryByComponent.Num(); }
+
+    int32 GetCellCount() const { return Cells.Num(); }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+        FBox Bounds = FBox(ForceInit);
+        FIntVector MinCell = FIntVector::ZeroValue;
+        FIntVector MaxCell = FIntVector::ZeroValue;
+
+        /** Listed in Cells over [MinCell, MaxCell] */
+        bool bInCells = false;
+
+        /** On ListedEntries: too large for the grid, or no bounds available */
+        bool bListed = false;
+
+        /** Component could not report bounds - visited by every query */
+        bool bUnbounded = false;
+
+        bool bDirty = false;
+    };
+
+    FIntVector LocationToCell(const FVector& Location) const;
+
+    /** Read the component's bounds and insert the entry into the grid or the list */
+    void Bucket(int32 EntryId);
+    void Unbucket(int32 EntryId);
+
+    float CellSize;
+
+    TArray<FEntry> Entries;
+    TArray<int32> FreeEntries;
+    TMap<const UISMRuntimeComponent*, int32> EntryByComponent;
+
+    TMap<FIntVector, TArray<int32>> Cells;
+    TArray<int32> ListedEntries;
+    TArray<int32> DirtyEntries;
+};
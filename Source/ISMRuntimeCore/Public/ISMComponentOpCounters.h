@@ -0,0 +1,117 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+#include "ISMComponentOpCounters.generated.h"
+
+class UISMRuntimeComponent;
+
+/** Operations a runtime component counts (UISMRuntimeComponent::GetOpStats) */
+UENUM(BlueprintType)
+enum class EISMComponentOp : uint8
+{
+    Add,
+    Destroy,
+    TransformUpdate,
+    CustomDataWrite,
+
+    /** Spatial and nearest queries answered by the component */
+    Query,
+    DelegateBroadcast,
+
+    MAX UMETA(Hidden)
+};
+
+/** One of the most frequently mutated instances, from sampling */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMHotInstanceSample
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Counters")
+    int32 InstanceIndex = INDEX_NONE;
+
+    /** Sampled transform and custom data writes; a lower bound once the sample table has decayed */
+    UPROPERTY(BlueprintReadOnly, Category = "Counters")
+    int32 Mutations = 0;
+};
+
+/** Operation totals and rates of one component */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMComponentOpStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Counters")
+    UISMRuntimeComponent* Component = nullptr;
+
+    /** Since the component initialized or the counters were last reset, indexed by EISMComponentOp */
+    UPROPERTY(BlueprintReadOnly, Category = "Counters")
+    TArray<int64> Totals;
+
+    /** Per second over the last completed window of at least a second, indexed by EISMComponentOp */
+    UPROPERTY(BlueprintReadOnly, Category = "Counters")
+    TArray<float> RatesPerSecond;
+
+    /** Most mutated instances first; empty unless hot instance sampling is on */
+    UPROPERTY(BlueprintReadOnly, Category = "Counters")
+    TArray<FISMHotInstanceSample> HotInstances;
+
+    int64 GetTotal(EISMComponentOp Op) const { return Totals.IsValidIndex(static_cast<int32>(Op)) ? Totals[static_cast<int32>(Op)] : 0; }
+    float GetRate(EISMComponentOp Op) const { return RatesPerSecond.IsValidIndex(static_cast<int32>(Op)) ? RatesPerSecond[static_cast<int32>(Op)] : 0.0f; }
+
+    /** Sum of all rates, for ranking components */
+    float GetTotalRate() const;
+};
+
+/**
+ * Per-component operation counters: a relaxed atomic add per operation, so const queries on
+ * worker threads may count too. Rates are taken lazily when stats are read.
+ *
+ * Hot instance sampling (game thread) keeps a bounded table of mutation counts per instance
+ * index; when it fills up every count is halved and the zeros dropped, so indexes mutated in
+ * bursts or steadily stay while one-offs age out.
+ */
+class ISMRUNTIMECORE_API FISMComponentOpCounters
+{
+public:
+    static constexpr int32 NumOps = static_cast<int32>(EISMComponentOp::MAX);
+
+    /** Instance indexes the sample table holds before it decays */
+    static constexpr int32 MaxSampledInstances = 256;
+
+    void Count(EISMComponentOp Op, int32 Num = 1)
+    {
+        Totals[static_cast<int32>(Op)].fetch_add(static_cast<uint64>(FMath::Max(Num, 0)), std::memory_order_relaxed);
+    }
+
+    /** Count a mutation of InstanceIndex in the hot instance table, when sampling is on */
+    void SampleMutation(int32 InstanceIndex)
+    {
+        if (bSampling)
+        {
+            RecordSample(InstanceIndex);
+        }
+    }
+
+    void SetSamplingEnabled(bool bEnabled);
+    bool IsSamplingEnabled() const { return bSampling; }
+
+    void Reset();
+
+    /** Totals, rates and the MaxHotInstances most mutated instances; closes the rate window if a second has passed */
+    void GetStats(FISMComponentOpStats& OutStats, int32 MaxHotInstances) const;
+
+private:
+    void RecordSample(int32 InstanceIndex);
+
+    std::atomic<uint64> Totals[NumOps] = {};
+
+    bool bSampling = false;
+    TMap<int32, int32> Samples;
+
+    /** Rate window: totals and time at its start, and the rates of the last closed window */
+    mutable uint64 WindowStartTotals[NumOps] = {};
+    mutable double WindowStartSeconds = 0.0;
+    mutable float Rates[NumOps] = {};
+};
@@ -0,0 +1,74 @@
+// ISMComponentTagIndex.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ISMInstanceTagBits.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Component-level tag index owned by UISMRuntimeSubsystem.
+ *
+ * Each registered component gets a dense slot and a tag bitmask (ISMComponentTags plus their
+ * parents, so matching is hierarchical like FGameplayTagContainer::HasAll). Every dictionary bit
+ * also keeps a posting list - a bit per slot - so candidate selection for a required/excluded
+ * filter is a word AND over the posting lists, with no allocation.
+ *
+ * A component whose tags do not fit the 128-bit dictionary is tracked as unindexed; callers must
+ * run the full container test on it.
+ */
+class ISMRUNTIMECORE_API FISMComponentTagIndex
+{
+public:
+    /** Start tracking a component's current ISMComponentTags. Re-reads the tags if already tracked. */
+    void Add(UISMRuntimeComponent* Component);
+
+    void Remove(const UISMRuntimeComponent* Component);
+
+    /** Drop slots whose component was destroyed without unregistering */
+    void RemoveStaleEntries();
+
+    void Reset();
+
+    /** Translate a filter's required/excluded tags into dictionary masks. Allocation free. */
+    void BuildFilterMasks(const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& ExcludedTags, FISMTagFilterMasks& OutMasks) const;
+
+    /**
+     * Tag test for one tracked component.
+     * @param bOutExact Set false when the component is unindexed (or untracked) - the result is then
+     *                  always true and the caller must test the tag containers itself
+     */
+    bool PassesTagMasks(const UISMRuntimeComponent* Component, const FISMTagFilterMasks& Masks, bool& bOutExact) const;
+
+    /**
+     * Visit, in slot order, every indexed component passing Masks and every unindexed component.
+     * Visitor receives bExact = false for unindexed ones. Return false from Visitor to stop;
+     * returns false if stopped.
+     */
+    bool ForEachCandidate(const FISMTagFilterMasks& Masks, TFunctionRef<bool(UISMRuntimeComponent*, bool bExact)> Visitor) const;
+
+    /** Tracked components */
+    int32 Num() const { return SlotByComponent.Num(); }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    void ClearSlot(int32 Slot);
+
+    /** Component-level masks; the "instance" index is the component slot */
+    FISMInstanceTagBits TagBits;
+
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> SlotComponents;
+    TMap<const UISMRuntimeComponent*, int32> SlotByComponent;
+    TArray<int32> FreeSlots;
+
+    /** Per slot: tags fit the dictionary, so the mask is exact */
+    TBitArray<> IndexedSlots;
+
+    /** Per slot: tracked, but tags overflowed the dictionary */
+    TBitArray<> UnindexedSlots;
+
+    /** Per dictionary bit: the indexed slots whose mask has it. Sized like SlotComponents. */
+    TArray<TBitArray<>> Postings;
+};
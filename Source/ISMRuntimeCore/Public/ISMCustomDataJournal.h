@@ -0,0 +1,82 @@
+// ISMCustomDataJournal.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One journaled custom data write: the slot's value as of the write's serial */
+struct FISMCustomDataDelta
+{
+    int32  InstanceIndex = INDEX_NONE;
+    int32  Slot = 0;
+    float  Value = 0.0f;
+    uint32 Serial = 0;
+};
+
+/**
+ * Opt-in per-component record of custom data writes at slot granularity, for consumers (saves,
+ * replication, PCG export) that want the values that changed rather than a diff of all custom data.
+ *
+ * Every write appends an (instance, slot, value) delta stamped with a serial; a newer write to the
+ * same slot retires the older delta, so the journal holds at most one live delta per slot
+ * (last write wins) and deltas stay in serial order. A watermark is just a serial: CollectSince
+ * returns the live deltas written at or after it. Layout changes the journal cannot express as
+ * deltas (custom data count changes, reinitialization) raise a reset serial instead, and
+ * consumers holding an older watermark must take a full snapshot.
+ */
+class ISMRUNTIMECORE_API FISMCustomDataJournal
+{
+public:
+    bool IsEnabled() const { return bEnabled; }
+
+    /** Start journaling. Everything before counts as a reset: the first watermark needs a full snapshot. */
+    void Enable();
+
+    /** Stop journaling and drop all deltas */
+    void Disable();
+
+    /** Watermark a consumer stores after reading: later writes are at or after it */
+    uint32 GetWatermark() const { return NextSerial; }
+
+    void Record(int32 InstanceIndex, int32 Slot, float Value);
+
+    /** Record Values written to consecutive slots from FirstSlot */
+    void RecordRow(int32 InstanceIndex, int32 FirstSlot, TConstArrayView<float> Values);
+
+    /** Deltas cannot describe what changed; every watermark before now needs a full snapshot */
+    void MarkReset();
+
+    /** True if a consumer at Watermark can catch up from deltas alone */
+    bool CanCatchUp(uint32 Watermark) const { return bEnabled && Watermark >= ResetSerial; }
+
+    /**
+     * Append the live deltas written at or after Watermark, oldest first.
+     * @return false (and appends nothing) if the consumer needs a full snapshot instead
+     */
+    bool CollectSince(uint32 Watermark, TArray<FISMCustomDataDelta>& OutDeltas) const;
+
+    /** Drop deltas older than Watermark once every consumer has read past it */
+    void Trim(uint32 Watermark);
+
+    /** Live deltas held */
+    int32 Num() const { return LiveByKey.Num(); }
+
+    SIZE_T GetAllocatedSize() const { return Deltas.GetAllocatedSize() + LiveByKey.GetAllocatedSize(); }
+
+private:
+    static uint64 MakeKey(int32 InstanceIndex, int32 Slot)
+    {
+        return (static_cast<uint64>(static_cast<uint32>(InstanceIndex)) << 32) | static_cast<uint32>(Slot);
+    }
+
+    /** Squeeze out retired deltas once they outnumber live ones */
+    void CompactIfSparse();
+    void Compact();
+
+    /** Serial-ordered; retired deltas keep their place with InstanceIndex = INDEX_NONE */
+    TArray<FISMCustomDataDelta> Deltas;
+    TMap<uint64, int32> LiveByKey;
+    int32  NumRetired = 0;
+    uint32 NextSerial = 1;
+    uint32 ResetSerial = 1;
+    bool   bEnabled = false;
+};
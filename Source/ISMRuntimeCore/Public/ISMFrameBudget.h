@@ -0,0 +1,230 @@
+#pragma once
+#include "CoreMinimal.h"
+
+#include "ISMFrameBudget.generated.h"
+
+class UWorld;
+
+/**
+ * Order in which ISMRuntime systems are served from the shared frame budget (UISMRuntimeSettings).
+ * Critical work always runs; its time is taken off the top and squeezes the rest.
+ */
+UENUM(BlueprintType)
+enum class EISMFrameBudgetPriority : uint8
+{
+    Critical,
+    High,
+    Normal,
+
+    /** Housekeeping that can wait: pool cleanup, prewarming, eviction sweeps */
+    Low,
+};
+
+/** One system's share of the last completed frame */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMFrameBudgetClientStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    FName Name;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    EISMFrameBudgetPriority Priority = EISMFrameBudgetPriority::Normal;
+
+    /** Time set aside for the client before surplus sharing */
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    float ReservedMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    float UsedMs = 0.0f;
+
+    /** Smoothed time the client asks for; grows while it defers work */
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    float DemandMs = 0.0f;
+
+    /** Work items the client reported leaving for a later frame */
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    int32 DeferredItems = 0;
+
+    /** Consecutive frames it deferred work without getting a minimum slice */
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    int32 StarvedFrames = 0;
+};
+
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMFrameBudgetStats
+{
+    GENERATED_BODY()
+
+    /** 0 when the governor is disabled */
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    float BudgetMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    float UsedMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    float DemandMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    bool bOverloaded = false;
+
+    /** Highest priority first */
+    UPROPERTY(BlueprintReadOnly, Category = "Frame Budget")
+    TArray<FISMFrameBudgetClientStats> Clients;
+};
+
+/** Fires when demand has stayed over the budget long enough to count as overload, and again on recovery */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnISMFrameBudgetOverloadChanged, bool /*bOverloaded*/);
+
+/**
+ * One game-thread time budget per frame shared by the ISMRuntime systems (batch scheduler,
+ * feedback queue, physics conversions, actor pools, hot DMIs), owned by UISMRuntimeSubsystem.
+ *
+ * Each frame is split up front from what the clients used or asked for recently: in priority order
+ * each client reserves up to its demand, and what nobody reserved is surplus for the first client
+ * to run out. A client measures its work with FISMFrameBudgetScope, stops when HasTime turns
+ * false, and reports what it left with Defer so its demand grows. Clients that keep deferring
+ * without getting time are granted a minimum slice after MaxStarvedFrames, so nothing stalls.
+ *
+ * Game thread only. With BudgetMs at 0 every client is unbudgeted.
+ */
+class ISMRUNTIMECORE_API FISMFrameBudgetGovernor
+{
+public:
+    struct FConfig
+    {
+        /** Total ms per frame, 0 = disabled */
+        float BudgetMs = 0.0f;
+
+        /** Consecutive over-budget frames before the overload signal */
+        int32 OverloadFrames = 3;
+
+        /** Consecutive frames within budget before overload clears */
+        int32 RecoveryFrames = 30;
+
+        /** Least a client that deferred work asks for, and the slice a starved client is granted */
+        float MinSliceMs = 0.1f;
+
+        int32 MaxStarvedFrames = 8;
+
+        /** Replaces the priority a client registers with */
+        TMap<FName, EISMFrameBudgetPriority> PriorityOverrides;
+    };
+
+    void Configure(const FConfig& InConfig);
+    const FConfig& GetConfig() const { return Config; }
+
+    bool IsEnabled() const { return Config.BudgetMs > 0.0f; }
+
+    /** Close the previous frame's accounting, update the overload signal and split this frame's budget */
+    void BeginFrame();
+
+    /** Seconds Client may still spend this frame; TNumericLimits<double>::Max() when unbudgeted or Critical */
+    double GetRemainingSeconds(FName Client) const;
+
+    bool HasTime(FName Client) const { return GetRemainingSeconds(Client) > 0.0; }
+
+    /**
+     * The tighter of a system's own per-frame budget in seconds (0 = none) and Client's remaining time,
+     * in the same convention: 0 = unbudgeted. Out of time comes back as the smallest positive budget,
+     * so systems that always make some progress still do.
+     */
+    double ClampBudgetSeconds(FName Client, double OwnBudgetSeconds) const;
+
+    /** Start timing Client's work, registering it on first use. Nests. */
+    void BeginWork(FName Client, EISMFrameBudgetPriority DefaultPriority);
+    void EndWork(FName Client);
+
+    /** Client left NumItems for a later frame */
+    void ReportDeferred(FName Client, int32 NumItems);
+
+    bool IsOverloaded() const { return bOverloaded; }
+
+    /** Figures of the last completed frame */
+    FISMFrameBudgetStats GetStats() const;
+
+    FOnISMFrameBudgetOverloadChanged OnOverloadChanged;
+
+    /** The governor of World's UISMRuntimeSubsystem, or null */
+    static FISMFrameBudgetGovernor* Get(const UWorld* World);
+
+private:
+    struct FClient
+    {
+        FName Name;
+        EISMFrameBudgetPriority Priority = EISMFrameBudgetPriority::Normal;
+        EISMFrameBudgetPriority DefaultPriority = EISMFrameBudgetPriority::Normal;
+        int32 RegistrationOrder = 0;
+
+        double ReservedSeconds = 0.0;
+        double DemandSeconds = 0.0;
+
+        /** Closed work this frame; open work runs from WorkStartSeconds */
+        double UsedSeconds = 0.0;
+        double WorkStartSeconds = 0.0;
+        int32 WorkDepth = 0;
+        int32 DeferredItems = 0;
+        int32 StarvedFrames = 0;
+
+        double LastUsedSeconds = 0.0;
+        int32 LastDeferredItems = 0;
+
+        double GetUsedSeconds(double Now) const { return UsedSeconds + (WorkDepth > 0 ? Now - WorkStartSeconds : 0.0); }
+    };
+
+    FClient* FindClient(FName Name);
+    const FClient* FindClient(FName Name) const;
+
+    /** Priority first, registration order within a priority */
+    void SortClients();
+
+    FConfig Config;
+    TArray<FClient> Clients;
+
+    /** Budget no client reserved this frame */
+    double SurplusSeconds = 0.0;
+
+    double LastDemandSeconds = 0.0;
+    int32 OverBudgetFrames = 0;
+    int32 WithinBudgetFrames = 0;
+    bool bOverloaded = false;
+};
+
+/**
+ * Times a block of a client's work against the frame budget.
+ *
+ *     FISMFrameBudgetScope Budget(FISMFrameBudgetGovernor::Get(World), TEXT("Feedback"), EISMFrameBudgetPriority::High);
+ *     while (Queue.Num() > 0 && Budget.HasTime()) { ... }
+ *     Budget.Defer(Queue.Num());
+ *
+ * A null governor (no runtime subsystem) leaves the work unbudgeted.
+ */
+class ISMRUNTIMECORE_API FISMFrameBudgetScope
+{
+public:
+    FISMFrameBudgetScope(FISMFrameBudgetGovernor* InGovernor, FName InClient, EISMFrameBudgetPriority DefaultPriority);
+    ~FISMFrameBudgetScope();
+
+    FISMFrameBudgetScope(const FISMFrameBudgetScope&) = delete;
+    FISMFrameBudgetScope& operator=(const FISMFrameBudgetScope&) = delete;
+
+    double GetRemainingSeconds() const;
+    bool HasTime() const { return GetRemainingSeconds() > 0.0; }
+
+    /** Whether the budget constrains this client at all */
+    bool IsBudgeted() const { return GetRemainingSeconds() < TNumericLimits<double>::Max(); }
+
+    /** See FISMFrameBudgetGovernor::ClampBudgetSeconds */
+    double ClampBudgetSeconds(double OwnBudgetSeconds) const
+    {
+        return Governor ? Governor->ClampBudgetSeconds(Client, OwnBudgetSeconds) : OwnBudgetSeconds;
+    }
+
+    void Defer(int32 NumItems);
+
+private:
+    FISMFrameBudgetGovernor* Governor = nullptr;
+    FName Client;
+};
@@ -0,0 +1,129 @@
+// ISMInstanceChangeTracker.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Per-field change stamps for a component's instances, read through cursors.
+ *
+ * Each tracked field keeps one stamp per instance: the tracker serial at the instance's last change.
+ * CaptureCursor hands out the current serial and advances it, so an instance has changed since a
+ * cursor exactly when one of its stamps is newer than the cursor. One cursor per consumer is all the
+ * state a consumer needs; the tracker does not know its consumers.
+ *
+ * Off until the first cursor is captured, at which point every instance counts as changed for
+ * cursor 0. Reset turns tracking off again without rewinding the serial. Whole-field changes (resizes, reinitialization) raise a per-field floor instead of
+ * touching every stamp. Field bits match EISMSnapshotField: Transform, CustomData, StateFlags.
+ */
+class FISMInstanceChangeTracker
+{
+public:
+    static constexpr int32 NumFields = 3;
+
+    bool IsEnabled() const { return bEnabled; }
+
+    /** Enable tracking if needed and return a cursor that every later change is newer than */
+    uint32 CaptureCursor()
+    {
+        if (!bEnabled)
+        {
+            // Serial never goes back, so cursors from before a Reset see everything as changed
+            bEnabled = true;
+            Serial = FMath::Max(Serial, 1u);
+            for (uint32& Floor : Floors)
+            {
+                Floor = Serial;
+            }
+        }
+        return Serial++;
+    }
+
+    void MarkChanged(int32 InstanceIndex, uint8 FieldMask)
+    {
+        if (!bEnabled || InstanceIndex < 0)
+        {
+            return;
+        }
+
+        for (int32 Field = 0; Field < NumFields; ++Field)
+        {
+            if ((FieldMask & (1 << Field)) == 0)
+            {
+                continue;
+            }
+
+            TArray<uint32>& FieldStamps = Stamps[Field];
+            if (InstanceIndex >= FieldStamps.Num())
+            {
+                FieldStamps.SetNumZeroed(FMath::Max(InstanceIndex + 1, FieldStamps.Num() * 2), EAllowShrinking::No);
+            }
+            FieldStamps[InstanceIndex] = Serial;
+        }
+    }
+
+    void MarkAllChanged(uint8 FieldMask)
+    {
+        if (!bEnabled)
+        {
+            return;
+        }
+
+        for (int32 Field = 0; Field < NumFields; ++Field)
+        {
+            if (FieldMask & (1 << Field))
+            {
+                Floors[Field] = Serial;
+            }
+        }
+    }
+
+    /** True when untracked, so callers that never enabled tracking see every instance */
+    bool HasChangedSince(int32 InstanceIndex, uint8 FieldMask, uint32 Cursor) const
+    {
+        if (!bEnabled)
+        {
+            return true;
+        }
+
+        for (int32 Field = 0; Field < NumFields; ++Field)
+        {
+            if ((FieldMask & (1 << Field)) == 0)
+            {
+                continue;
+            }
+
+            const TArray<uint32>& FieldStamps = Stamps[Field];
+            const uint32 Stamp = FieldStamps.IsValidIndex(InstanceIndex) ? FieldStamps[InstanceIndex] : 0;
+            if (FMath::Max(Stamp, Floors[Field]) > Cursor)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Reset()
+    {
+        for (TArray<uint32>& FieldStamps : Stamps)
+        {
+            FieldStamps.Empty();
+        }
+        bEnabled = false;
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Size = 0;
+        for (const TArray<uint32>& FieldStamps : Stamps)
+        {
+            Size += FieldStamps.GetAllocatedSize();
+        }
+        return Size;
+    }
+
+private:
+    TArray<uint32> Stamps[NumFields];
+    uint32         Floors[NumFields] = {};
+    uint32         Serial = 0;
+    bool           bEnabled = false;
+};
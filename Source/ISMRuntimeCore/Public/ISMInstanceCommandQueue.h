@@ -0,0 +1,140 @@
+// ISMInstanceCommandQueue.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ISMInstanceRegistry.h"
+#include "ISMInstanceState.h"
+#include <atomic>
+
+enum class EISMInstanceCommandType : uint8
+{
+    Destroy,
+    WriteStateFlags,
+    SetCustomData
+};
+
+/**
+ * One instance mutation pushed from any thread and applied on the game thread by
+ * UISMRuntimeSubsystem. Plain data, 24 bytes: the instance is named by its FISMGlobalInstanceId
+ * so pushing never touches a UObject or weak pointer.
+ */
+struct FISMInstanceCommand
+{
+    FISMGlobalInstanceId Id;
+
+    /** Instance generation the command was issued for; INDEX_NONE applies it to whatever occupies the slot */
+    int32 Generation = INDEX_NONE;
+
+    /** SetCustomData: slot and value */
+    int32 CustomDataSlot = 0;
+    float CustomDataValue = 0.0f;
+
+    EISMInstanceCommandType Type = EISMInstanceCommandType::Destroy;
+
+    /** WriteStateFlags: flags to raise and lower, as FISMStateFlagsWrite */
+    uint8 SetMask = 0;
+    uint8 ClearMask = 0;
+
+    /** Destroy: play the instance's destruction feedbacks */
+    bool bTriggerFeedbacks = true;
+
+    static FISMInstanceCommand MakeDestroy(FISMGlobalInstanceId Id, int32 Generation = INDEX_NONE, bool bTriggerFeedbacks = true)
+    {
+        FISMInstanceCommand Command;
+        Command.Id = Id;
+        Command.Generation = Generation;
+        Command.Type = EISMInstanceCommandType::Destroy;
+        Command.bTriggerFeedbacks = bTriggerFeedbacks;
+        return Command;
+    }
+
+    static FISMInstanceCommand MakeStateFlags(FISMGlobalInstanceId Id, uint8 SetMask, uint8 ClearMask, int32 Generation = INDEX_NONE)
+    {
+        FISMInstanceCommand Command;
+        Command.Id = Id;
+        Command.Generation = Generation;
+        Command.Type = EISMInstanceCommandType::WriteStateFlags;
+        Command.SetMask = SetMask;
+        Command.ClearMask = ClearMask;
+        return Command;
+    }
+
+    /** Same effect as UISMRuntimeComponent::SetInstanceState */
+    static FISMInstanceCommand MakeSetState(FISMGlobalInstanceId Id, EISMInstanceState State, bool bValue, int32 Generation = INDEX_NONE)
+    {
+        const uint8 Bits = static_cast<uint8>(State);
+        return MakeStateFlags(Id, bValue ? Bits : 0, bValue ? 0 : Bits, Generation);
+    }
+
+    /** Same effect as UISMRuntimeComponent::SetInstanceCustomDataValue */
+    static FISMInstanceCommand MakeCustomData(FISMGlobalInstanceId Id, int32 Slot, float Value, int32 Generation = INDEX_NONE)
+    {
+        FISMInstanceCommand Command;
+        Command.Id = Id;
+        Command.Generation = Generation;
+        Command.Type = EISMInstanceCommandType::SetCustomData;
+        Command.CustomDataSlot = Slot;
+        Command.CustomDataValue = Value;
+        return Command;
+    }
+};
+
+/**
+ * Multi-producer single-consumer queue of FISMInstanceCommands.
+ *
+ * A fixed ring of cells with per-cell sequence numbers: a push claims a cell with one
+ * compare-exchange and publishes it with a release store, so producers never lock or allocate. A
+ * push that finds the ring full spills to a locked overflow list instead of failing, and later
+ * pushes follow it there until the consumer drains, so commands from one thread stay in order.
+ *
+ * Push from any thread; Drain from one thread only (the game thread, through UISMRuntimeSubsystem).
+ */
+class ISMRUNTIMECORE_API FISMInstanceCommandQueue
+{
+public:
+    /** Capacity is rounded up to a power of two */
+    explicit FISMInstanceCommandQueue(int32 Capacity = 4096);
+
+    FISMInstanceCommandQueue(const FISMInstanceCommandQueue&) = delete;
+    FISMInstanceCommandQueue& operator=(const FISMInstanceCommandQueue&) = delete;
+
+    /** Thread-safe. Never fails; a full ring costs a lock. */
+    void Push(const FISMInstanceCommand& Command);
+
+    /** Consumer only. Appends every published command to OutCommands in push order; returns how many. */
+    int32 Drain(TArray<FISMInstanceCommand>& OutCommands);
+
+    /** Consumer only. Nothing published or spilled; a push still in flight is not seen. */
+    bool IsEmpty() const;
+
+    int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+    /** Pushes that went to the overflow list since construction */
+    uint64 GetNumOverflowed() const { return NumOverflowed.load(std::memory_order_relaxed); }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FCell
+    {
+        /** Equals the push position when free, position + 1 once published */
+        std::atomic<uint64> Sequence{ 0 };
+        FISMInstanceCommand Command;
+    };
+
+    /** Claim a ring cell and publish Command. False when the ring is full. */
+    bool TryPushRing(const FISMInstanceCommand& Command);
+
+    TUniquePtr<FCell[]> Cells;
+    uint64 Mask = 0;
+
+    // Producers and the consumer hammer different counters; keep them off each other's cache lines
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePos = 0;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<bool> bOverflowing{ false };
+    std::atomic<uint64> NumOverflowed{ 0 };
+    mutable FCriticalSection OverflowLock;
+    TArray<FISMInstanceCommand> Overflow;
+};
@@ -8,6 +8,16 @@
 
 
 
+/** One custom data row (PICD values from index 0) to build a shared pool DMI for ahead of time */
+USTRUCT(BlueprintType)
+struct FISMCustomDataPrewarmRow
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PICD Conversion")
+    TArray<float> CustomData;
+};
+
 /**
  * Data asset defining properties and behavior for ISM instances.
  * Allows designers to configure instance behavior without code changes.
@@ -161,6 +171,28 @@ public:
             GetOptions = "GetAvailableSchemaNames"))
     FName SchemaName = NAME_None;
 
+    /**
+     * Build this asset's shared pool DMIs while the level loads instead of on first conversion.
+     *
+     * At InitializeInstances the component queues one DMI per applicable material slot for each
+     * row in PrewarmCustomData, plus each distinct signature found scanning its instances' custom
+     * data (up to MaxPrewarmSignatures). UISMCustomDataSubsystem builds the queue a few DMIs per
+     * frame. Prewarmed entries are not evicted before their first use.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual|PICD Conversion",
+        meta = (EditCondition = "bUsePICDConversion", DisplayName = "Prewarm Shared DMIs"))
+    bool bPrewarmSharedDMIs = false;
+
+    /** Custom data rows to prewarm regardless of what the placed instances hold (e.g. damage states) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual|PICD Conversion",
+        meta = (EditCondition = "bUsePICDConversion && bPrewarmSharedDMIs"))
+    TArray<FISMCustomDataPrewarmRow> PrewarmCustomData;
+
+    /** Cap on distinct signatures sampled from placed instances, per component. 0 = declared rows only. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual|PICD Conversion",
+        meta = (EditCondition = "bUsePICDConversion && bPrewarmSharedDMIs", ClampMin = "0"))
+    int32 MaxPrewarmSignatures = 64;
+
     
     /**
  * Resolve the active schema for this asset.
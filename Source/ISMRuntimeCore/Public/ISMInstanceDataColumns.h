@@ -0,0 +1,105 @@
+// ISMInstanceDataColumns.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+/**
+ * One named per-instance data column: a contiguous byte arena holding one fixed-size
+ * POD element per instance slot. New and recycled slots are filled from DefaultValue.
+ */
+struct ISMRUNTIMECORE_API FISMInstanceDataColumn
+{
+    FName Name;
+
+    /** sizeof the registered element type */
+    int32 ElementSize = 0;
+
+    /** Bytes written into new and reset slots */
+    TArray<uint8> DefaultValue;
+
+    /** ElementSize * NumSlots bytes */
+    TArray<uint8, TAlignedHeapAllocator<16>> Data;
+
+    int32 Num() const { return ElementSize > 0 ? Data.Num() / ElementSize : 0; }
+
+    uint8* GetSlot(int32 InstanceIndex) { return Data.GetData() + static_cast<SIZE_T>(InstanceIndex) * ElementSize; }
+    const uint8* GetSlot(int32 InstanceIndex) const { return Data.GetData() + static_cast<SIZE_T>(InstanceIndex) * ElementSize; }
+};
+
+/**
+ * Registry of typed per-instance module data, owned by UISMRuntimeComponent.
+ *
+ * Modules register a trivially copyable type under a name once and get a dense array indexed
+ * by instance index, with no per-instance heap allocations. All columns are kept at the same
+ * slot count as the component's instance state.
+ *
+ * Views returned by the typed accessors are invalidated when instances are added.
+ * Re-fetch them after AddInstance / BatchAddInstances.
+ */
+class ISMRUNTIMECORE_API FISMInstanceDataColumns
+{
+public:
+    /**
+     * Register (or fetch, if already registered with the same element size) a column.
+     * @return Column view, or an empty view if Name is taken by a different element size.
+     */
+    template<typename T>
+    TArrayView<T> Register(FName Name, const T& DefaultValue = T())
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Instance data columns hold trivially copyable types only");
+        static_assert(alignof(T) <= 16, "Instance data column elements must not need more than 16-byte alignment");
+
+        FISMInstanceDataColumn* Column = RegisterRaw(Name, sizeof(T), &DefaultValue);
+        return Column ? MakeView<T>(*Column) : TArrayView<T>();
+    }
+
+    /** Typed view of a registered column; empty if missing or the element size does not match */
+    template<typename T>
+    TArrayView<T> Get(FName Name)
+    {
+        FISMInstanceDataColumn* Column = FindRaw(Name);
+        return Column && Column->ElementSize == sizeof(T) ? MakeView<T>(*Column) : TArrayView<T>();
+    }
+
+    template<typename T>
+    TArrayView<const T> Get(FName Name) const
+    {
+        const FISMInstanceDataColumn* Column = FindRaw(Name);
+        return Column && Column->ElementSize == sizeof(T) ? MakeView<const T>(*Column) : TArrayView<const T>();
+    }
+
+    /** Remove a column and free its storage */
+    bool Unregister(FName Name);
+
+    FISMInstanceDataColumn* FindRaw(FName Name);
+    const FISMInstanceDataColumn* FindRaw(FName Name) const;
+
+    /** All registered columns, in registration order */
+    const TArray<FISMInstanceDataColumn>& GetColumns() const { return Columns; }
+
+    /** Grow or shrink every column to NumSlots, filling new slots with defaults */
+    void SetNumSlots(int32 NumSlots);
+
+    /** Reset one slot to defaults in every column (grows columns if needed) */
+    void ResetSlot(int32 InstanceIndex);
+
+    /** Drop every column's data but keep registrations */
+    void ResetData();
+
+    int32 GetNumSlots() const { return NumSlots; }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    FISMInstanceDataColumn* RegisterRaw(FName Name, int32 ElementSize, const void* DefaultValue);
+
+    template<typename T>
+    static TArrayView<T> MakeView(const FISMInstanceDataColumn& Column)
+    {
+        return TArrayView<T>(reinterpret_cast<T*>(const_cast<uint8*>(Column.Data.GetData())), Column.Num());
+    }
+
+    TArray<FISMInstanceDataColumn> Columns;
+    int32 NumSlots = 0;
+};
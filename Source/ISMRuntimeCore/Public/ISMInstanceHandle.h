@@ -66,6 +66,13 @@ struct ISMRUNTIMECORE_API FISMInstanceHandle
     UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime")
     int32 InstanceIndex = INDEX_NONE;
 
+    /**
+     * Slot generation this handle was issued for. A destroyed slot that gets recycled
+     * bumps its generation, so handles to the previous occupant stop being valid.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime")
+    int32 Generation = 0;
+
     /** Weak pointer to the component that owns this instance */
     UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime")
     TWeakObjectPtr<UISMRuntimeComponent> Component;
@@ -88,9 +95,12 @@ struct ISMRUNTIMECORE_API FISMInstanceHandle
 
     // ===== State Queries =====
 
-    /** True if handle points to a valid component and instance index */
+    /** True if handle points to a valid component and instance index, and the slot has not been recycled */
     bool IsValid() const;
 
+    /** True if the slot this handle pointed at has since been recycled for a different instance */
+    bool IsStale() const;
+
     /** True if this instance is currently represented as an actor */
     bool IsConvertedToActor() const;
 
@@ -124,6 +134,12 @@ struct ISMRUNTIMECORE_API FISMInstanceHandle
      */
     bool ReturnToISM(bool bDestroyActor = true, bool bUpdateTransform = true);
 
+    /**
+     * Release the pooled DMI references this instance's custom data holds, one per affected slot.
+     * Part of ReturnToISM; exposed for batched returns that skip the per-instance path.
+     */
+    void ReleaseCustomDataMaterials() const;
+
     /**
      * Set the converted actor reference. Called by ConvertToActor after the actor
      * is successfully spawned. Fires OnInstanceConvertedToActor delegate.
@@ -187,7 +203,7 @@ struct ISMRUNTIMECORE_API FISMInstanceHandle
 
     bool operator==(const FISMInstanceHandle& Other) const
     {
-        return Component == Other.Component && InstanceIndex == Other.InstanceIndex;
+        return Component == Other.Component && InstanceIndex == Other.InstanceIndex && Generation == Other.Generation;
     }
 
     bool operator!=(const FISMInstanceHandle& Other) const
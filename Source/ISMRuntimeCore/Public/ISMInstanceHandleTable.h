@@ -0,0 +1,81 @@
+// ISMInstanceHandleTable.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMInstanceHandle.h"
+
+/**
+ * A component's stored handles as a sparse set: handles packed in a dense array, plus an
+ * instance index -> dense slot table, so lookups are one array read and iteration touches only
+ * handles that exist. Instances converted to actors are listed separately, so walking them costs
+ * O(converted) rather than a scan of every handle.
+ *
+ * Removing a handle moves the last one into its slot, so references and slots are invalidated by
+ * Add and Remove, like TMap's.
+ */
+class ISMRUNTIMECORE_API FISMInstanceHandleTable
+{
+public:
+    FISMInstanceHandle* Find(int32 InstanceIndex)
+    {
+        const int32 Slot = GetSlot(InstanceIndex);
+        return Slot != INDEX_NONE ? &Handles[Slot] : nullptr;
+    }
+
+    const FISMInstanceHandle* Find(int32 InstanceIndex) const
+    {
+        const int32 Slot = GetSlot(InstanceIndex);
+        return Slot != INDEX_NONE ? &Handles[Slot] : nullptr;
+    }
+
+    bool Contains(int32 InstanceIndex) const { return GetSlot(InstanceIndex) != INDEX_NONE; }
+
+    /** Handle of InstanceIndex, default-constructed (bOutAdded) if it had none */
+    FISMInstanceHandle& FindOrAdd(int32 InstanceIndex, bool& bOutAdded);
+
+    /** Drop InstanceIndex's handle and its converted entry */
+    void Remove(int32 InstanceIndex);
+
+    void Empty();
+
+    int32 Num() const { return Handles.Num(); }
+
+    /** Every stored handle, in no particular order */
+    TArrayView<FISMInstanceHandle> GetHandles() { return Handles; }
+    TConstArrayView<FISMInstanceHandle> GetHandles() const { return Handles; }
+
+    /** Record whether InstanceIndex's handle is converted; no-op without a handle */
+    void SetConverted(int32 InstanceIndex, bool bConverted);
+
+    bool IsListedConverted(int32 InstanceIndex) const
+    {
+        const int32 Slot = GetSlot(InstanceIndex);
+        return Slot != INDEX_NONE && ConvertedPositions[Slot] != INDEX_NONE;
+    }
+
+    /** Instances marked converted through SetConverted, in no particular order */
+    TConstArrayView<int32> GetConvertedInstances() const { return ConvertedInstances; }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Handles.GetAllocatedSize() + Slots.GetAllocatedSize()
+            + ConvertedPositions.GetAllocatedSize() + ConvertedInstances.GetAllocatedSize();
+    }
+
+private:
+    int32 GetSlot(int32 InstanceIndex) const
+    {
+        return Slots.IsValidIndex(InstanceIndex) ? Slots[InstanceIndex] : INDEX_NONE;
+    }
+
+    /** Dense handles */
+    TArray<FISMInstanceHandle> Handles;
+
+    /** Instance index -> slot in Handles, INDEX_NONE without a handle; grown on demand */
+    TArray<int32> Slots;
+
+    /** Per slot in Handles: position in ConvertedInstances, or INDEX_NONE */
+    TArray<int32> ConvertedPositions;
+
+    TArray<int32> ConvertedInstances;
+};
@@ -8,7 +8,21 @@
 #include "ISMInstanceHandle.h"
 #include "ISMInstanceIndex.generated.h"
 
+class UISMInstanceIndex;
 
+/** Order of the handle arrays returned by index queries */
+UENUM(BlueprintType)
+enum class EISMIndexResultOrder : uint8
+{
+    /** Set iteration order. Cheapest; random with respect to memory and space. */
+    Unordered,
+
+    /** Grouped by component, ascending instance index within each component */
+    ByComponent,
+
+    /** Grouped by component, then by spatial cell in Morton order, then by instance index */
+    BySpatialCell
+};
 
 /**
  * Query descriptor for multi-index intersection.
@@ -30,6 +44,61 @@ struct ISMRUNTIMECORE_API FISMIndexQuery
         : Index(InIndex), Key(InKey) {}
 };
 
+/** Set funcs matching handles by component and instance index only, so a view holds one entry per instance */
+struct FISMInstanceSlotKeyFuncs : BaseKeyFuncs<FISMInstanceHandle, FISMInstanceHandle, false>
+{
+    static const FISMInstanceHandle& GetSetKey(const FISMInstanceHandle& Element) { return Element; }
+    static bool Matches(const FISMInstanceHandle& A, const FISMInstanceHandle& B)
+    {
+        return A.Component == B.Component && A.InstanceIndex == B.InstanceIndex;
+    }
+    static uint32 GetKeyHash(const FISMInstanceHandle& Key) { return GetTypeHash(Key); }
+};
+
+typedef TSet<FISMInstanceHandle, FISMInstanceSlotKeyFuncs> FISMIndexViewSet;
+
+/**
+ * Live result of an IntersectAll query, created by UISMInstanceIndex::CreateIntersectionView.
+ *
+ * Every index the query reads from keeps a weak reference to the view under the queried key. When
+ * a handle is filed under or removed from that key, the index probes the handle against the view's
+ * other keys and patches the result, so upkeep is O(queries) per key change and reading is O(1).
+ * Bulk changes (rebuild, unregister, prune) recompute the view from scratch.
+ *
+ * Drop the last reference to unregister. If one of the indexes is destroyed the view reads empty.
+ */
+class ISMRUNTIMECORE_API FISMIndexIntersectionView
+{
+public:
+    /** Current result. Reconciles deferred indexes first, which is free when nothing is pending. */
+    const FISMIndexViewSet& GetHandles() const;
+
+    int32 Num() const { return GetHandles().Num(); }
+
+    bool Contains(const FISMInstanceHandle& Handle) const { return GetHandles().Contains(Handle); }
+
+    /** False once an index the view reads from has been destroyed */
+    bool IsValid() const;
+
+private:
+    friend class UISMInstanceIndex;
+
+    struct FViewQuery
+    {
+        TWeakObjectPtr<UISMInstanceIndex> Index;
+        FGameplayTag Key;
+    };
+
+    /** Whether every query's index files Handle under its key, without reconciling */
+    bool PassesAll(const FISMInstanceHandle& Handle) const;
+
+    /** Replace the result with a full IntersectAll */
+    void Recompute();
+
+    TArray<FViewQuery> Queries;
+    FISMIndexViewSet Handles;
+};
+
 /**
  * Opt-in secondary index over ISM instance handles, keyed by gameplay tag.
  *
@@ -44,6 +113,10 @@ struct ISMRUNTIMECORE_API FISMIndexQuery
  *   UISMTagIndex        — keys by per-instance gameplay tags
  *
  * Designed for fast set-based queries and intersection with spatial results.
+ *
+ * With bUseDenseIds each key is stored as one bitmap over instance indices per registered
+ * component instead, addressed by dense ID (component slot << 32 | instance index). No handle is
+ * hashed on add, remove or probe, and intersections between dense indexes are word ANDs.
  */
 UCLASS(Abstract, Blueprintable, ClassGroup=(ISMRuntime),
     meta=(BlueprintSpawnableComponent))
@@ -54,6 +127,67 @@ class ISMRUNTIMECORE_API UISMInstanceIndex : public UActorComponent
 public:
     UISMInstanceIndex();
 
+    // ===== Storage Mode =====
+
+    /**
+     * Store keys as per-component bitmaps over instance indices instead of handle sets.
+     * Costs one bit per instance per key and component, so it pays off when keys cover a good share
+     * of the instances or are intersected often. Entries are matched by slot and the instance's
+     * current generation. Set before registering, or use SetUseDenseIds to convert.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ISM Index")
+    bool bUseDenseIds = false;
+
+    /** Switch storage mode and rebuild from the registered components */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    void SetUseDenseIds(bool bEnable);
+
+    /**
+     * Defer maintenance: change callbacks only mark the instance dirty, and the index re-files
+     * dirty instances at the next query or at the end of the frame (TG_PostUpdateWork, when the
+     * index is registered). A burst of events then costs one re-index per instance.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ISM Index")
+    bool bDeferMaintenance = false;
+
+    /** Re-file every instance marked dirty since the last reconcile */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    void FlushPendingChanges();
+
+    /** Instances waiting for a deferred re-index */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    int32 GetNumPendingChanges() const { return NumPendingChanges; }
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /**
+     * Dense IDs (component slot << 32 | instance index) filed under Key, ascending. Dense mode only;
+     * skips handle construction. Resolve the slot with GetDenseSlotComponent.
+     */
+    void GetDenseIdsForTag(FGameplayTag Key, TArray<uint64>& OutIds) const;
+
+    UISMRuntimeComponent* GetDenseSlotComponent(int32 Slot) const
+    {
+        return DenseSlotComponents.IsValidIndex(Slot) ? DenseSlotComponents[Slot].Get() : nullptr;
+    }
+
+    // ===== Result Order =====
+
+    /**
+     * Order applied to GetHandlesForTag / GetHandlesForAllTags / GetHandlesForAnyTag results.
+     * Sorted results let batch consumers (destroy, feedback, physics conversion) walk each
+     * component's instance data front to back and split the array into per-component runs.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Index")
+    EISMIndexResultOrder ResultOrder = EISMIndexResultOrder::Unordered;
+
+    /**
+     * Sort handles into the given order in place. For results of the static intersections.
+     * Components are ordered by unique ID, so the order is stable across calls.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    static void SortHandles(UPARAM(ref) TArray<FISMInstanceHandle>& Handles, EISMIndexResultOrder Order);
+
     // ===== Registration =====
 
     /**
@@ -65,6 +199,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Index")
     void RegisterWithComponent(UISMRuntimeComponent* Component);
 
+    /**
+     * Subscribe to several components with one bulk build: each component's keys are gathered
+     * on a worker thread, then merged into presized sets. Use on level load instead of a loop of
+     * RegisterWithComponent.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    void RegisterWithComponents(const TArray<UISMRuntimeComponent*>& Components);
+
     /** Unsubscribe from a component and remove its handles from the index */
     UFUNCTION(BlueprintCallable, Category = "ISM Index")
     void UnregisterFromComponent(UISMRuntimeComponent* Component);
@@ -73,6 +215,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Index")
     void UnregisterAll();
 
+    // ===== Bulk Build =====
+
+    /** Gather keys for registrations and rebuilds on worker threads, one task per component */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ISM Index")
+    bool bParallelBuild = true;
+
+    /**
+     * Spread registration and rebuild work over frames, spending about this many milliseconds
+     * per tick (0 = build immediately). Needs a registered index to tick; change events keep
+     * being applied meanwhile, and a query finishes the outstanding build before it reads.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ISM Index", meta = (ClampMin = "0.0"))
+    float BuildTimeSliceMs = 0.0f;
+
+    /** Components registered or rebuilt but not built yet (BuildTimeSliceMs) */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    int32 GetNumPendingBuilds() const { return PendingBuilds.Num(); }
+
+    /** Finish every outstanding time-sliced build now */
+    UFUNCTION(BlueprintCallable, Category = "ISM Index")
+    void CompletePendingBuilds();
+
     // ===== Single-Index Queries =====
 
     /** Get all handles filed under a specific tag key. O(1) lookup, O(n) copy. */
@@ -111,6 +275,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Index")
     int32 GetTotalIndexedCount() const;
 
+    /** Heap bytes held by the key storage, subscriptions and pending work. Live views are owned by their holders. */
+    SIZE_T GetAllocatedSize() const;
+
     // ===== Spatial Intersection =====
 
     /**
@@ -154,12 +321,21 @@ public:
      * Intersect spatial candidates with multiple logical indexes.
      * Spatial result is treated as the first (potentially large) candidate set.
      * Each logical index filters it down further. O(k * n_indexes).
+     * For tag keys on bCompactInstanceTags components, UISMRuntimeComponent::ForEachInstanceInRadiusWithTags
+     * (and the subsystem's filtered queries built on it) skips untagged cells during the walk instead.
      */
     static TArray<FISMInstanceHandle> IntersectSpatialWithIndexes(
         const TArray<int32>& SpatialCandidates,
         UISMRuntimeComponent* Component,
         const TArray<FISMIndexQuery>& Queries);
 
+    /**
+     * Register a memoized IntersectAll: the returned view holds the current intersection and the
+     * indexes keep it up to date as handles are filed and removed. For queries asked every tick.
+     * Null indexes are ignored, as in IntersectAll.
+     */
+    static TSharedRef<FISMIndexIntersectionView> CreateIntersectionView(const TArray<FISMIndexQuery>& Queries);
+
     // ===== Maintenance =====
 
     /** Force full rebuild from all registered components */
@@ -175,9 +351,18 @@ protected:
 
     /**
      * Called when a handle should be considered for indexing.
-     * Subclass determines which key(s) to file it under via AddToKey.
+     * Default re-files the handle under the keys from GatherKeys; override to file it by hand
+     * via AddToKey.
      */
-    virtual void OnHandleChanged(const FISMInstanceHandle& Handle) {}
+    virtual void OnHandleChanged(const FISMInstanceHandle& Handle);
+
+    /**
+     * Keys a handle belongs under, appended to the (empty) OutKeys. Used by OnHandleChanged and by
+     * the bulk build, which calls it on worker threads: read only Handle and its component - a
+     * component is only ever gathered by one task at a time. Return false if the subclass files
+     * handles through OnHandleChanged alone; the bulk build then indexes per handle.
+     */
+    virtual bool GatherKeys(const FISMInstanceHandle& Handle, TArray<FGameplayTag>& OutKeys) const { return false; }
 
     /**
      * Called when a handle must be removed from the index entirely.
@@ -201,6 +386,23 @@ protected:
     const TSet<FISMInstanceHandle>* GetSetForKey(FGameplayTag Key) const;
 
 private:
+    friend class FISMIndexIntersectionView;
+
+    /** IsHandleIndexed without reconciling deferred changes */
+    bool ContainsHandle(FGameplayTag Key, const FISMInstanceHandle& Handle) const;
+
+    // ===== Intersection Views =====
+
+    /** Views that read Key from this index. Expired entries are dropped as the key is touched. */
+    TMap<FGameplayTag, TArray<TWeakPtr<FISMIndexIntersectionView>>> ViewsByKey;
+
+    /** Handle was just filed under / removed from Key */
+    void NotifyViewsAdded(FGameplayTag Key, const FISMInstanceHandle& Handle);
+    void NotifyViewsRemoved(FGameplayTag Key, const FISMInstanceHandle& Handle);
+
+    /** Recompute every live view of this index, after changes too large to patch */
+    void RefreshViews();
+
     // ===== Index Storage =====
 
     /** Primary index: tag key → set of handles */
@@ -212,6 +414,42 @@ private:
      */
     TMap<FISMInstanceHandle, TSet<FGameplayTag>> HandleToKeys;
 
+    // ===== Dense Storage (bUseDenseIds) =====
+
+    struct FDenseKeySet
+    {
+        /** Per component slot: one bit per instance index filed under the key */
+        TArray<TBitArray<>> SlotBits;
+        int32 Num = 0;
+    };
+
+    /** Replaces Index; no reverse map - RemoveFromAllKeys clears one bit per key */
+    TMap<FGameplayTag, FDenseKeySet> DenseIndex;
+
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> DenseSlotComponents;
+    TMap<const UISMRuntimeComponent*, int32> DenseSlotByComponent;
+    TArray<int32> DenseFreeSlots;
+
+    int32 FindDenseSlot(const UISMRuntimeComponent* Component) const;
+    int32 FindOrAddDenseSlot(UISMRuntimeComponent* Component);
+
+    /** Clear Slot from every key and drop keys left empty */
+    void ClearDenseSlot(int32 Slot);
+
+    /** Bits filed under Key for Component, or nullptr */
+    const TBitArray<>* FindDenseBits(FGameplayTag Key, const UISMRuntimeComponent* Component) const;
+
+    /** Clear one bit; returns true if it was set */
+    static bool ClearDenseBit(FDenseKeySet& Set, int32 Slot, int32 InstanceIndex);
+
+    /** AND the sets (ascending by size; the first one's index owns the slot space) into handles */
+    static void IntersectDense(TConstArrayView<TPair<const UISMInstanceIndex*, const FDenseKeySet*>> Sets, TArray<FISMInstanceHandle>& OutHandles);
+
+    /** Probe intersection for queries that mix storage modes: enumerate the smallest, test the rest */
+    static TArray<FISMInstanceHandle> IntersectByProbing(const TArray<FISMIndexQuery>& Queries);
+
+    void ResetDenseStorage();
+
     // ===== Subscription Tracking =====
 
     UPROPERTY()
@@ -222,6 +460,7 @@ private:
         FDelegateHandle StateChanged;
         FDelegateHandle Destroyed;
         FDelegateHandle TagChanged;
+        FDelegateHandle BatchChanged;
         FDelegateHandle OwnershipChanged;
         FDelegateHandle PossessionChanged;
         FDelegateHandle AttachmentChanged;
@@ -236,9 +475,74 @@ private:
     void HandleOwnershipChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
     void HandlePossessionChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
     void HandleAttachmentChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
+    void HandleInstancesChangedBatch(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices);
 
     /** Build index entries for a single handle — calls OnHandleChanged */
     void IndexHandle(UISMRuntimeComponent* Component, int32 InstanceIndex);
+
+    // ===== Bulk Build =====
+
+    /** One component's keys, gathered off the game thread */
+    struct FComponentBuild
+    {
+        UISMRuntimeComponent* Component = nullptr;
+        TMap<FGameplayTag, TArray<FISMInstanceHandle>> HandlesByKey;
+        int32 NumLive = 0;
+
+        /** False when GatherKeys is unsupported - merged per handle instead */
+        bool bGathered = false;
+    };
+
+    /** Subscribe to a component's events; false if null or already registered */
+    bool BindComponent(UISMRuntimeComponent* Component);
+
+    /** Build now, or queue for the tick when BuildTimeSliceMs is set */
+    void QueueBuilds(TArrayView<UISMRuntimeComponent* const> Components);
+
+    /** Gather (in parallel) and merge the given components, then refresh views */
+    void BuildComponents(TArrayView<UISMRuntimeComponent* const> Components);
+
+    void GatherComponent(FComponentBuild& Build) const;
+    void MergeComponentBuild(FComponentBuild& Build);
+
+    /** Build queued components for about BudgetMs (everything if BudgetMs <= 0) */
+    void ProcessPendingBuilds(float BudgetMs);
+
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> PendingBuilds;
+
+    /** OnHandleChanged scratch */
+    TArray<FGameplayTag> KeyBuffer;
+
+    // ===== Deferred Maintenance (bDeferMaintenance) =====
+
+    struct FPendingChanges
+    {
+        TBitArray<> Dirty;
+
+        /** Last event for the instance was its destruction, so it is removed rather than re-filed */
+        TBitArray<> Removed;
+    };
+
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, FPendingChanges> PendingChanges;
+    int32 NumPendingChanges = 0;
+
+    /** Re-index now, or mark dirty in deferred mode */
+    void NoteInstanceChanged(UISMRuntimeComponent* Component, int32 InstanceIndex, bool bRemoved);
+
+    /** Flush before reading; queries are const but the pending work is not */
+    void ReconcilePendingChanges() const
+    {
+        if (PendingBuilds.Num() > 0)
+        {
+            const_cast<UISMInstanceIndex*>(this)->CompletePendingBuilds();
+        }
+        if (NumPendingChanges > 0)
+        {
+            const_cast<UISMInstanceIndex*>(this)->FlushPendingChanges();
+        }
+    }
+
+    void ClearPendingChanges();
 };
 
 
@@ -256,13 +560,13 @@ class ISMRUNTIMECORE_API UISMOwnershipIndex : public UISMInstanceIndex
 {
     GENERATED_BODY()
 protected:
-    virtual void OnHandleChanged(const FISMInstanceHandle& Handle) override
+    virtual bool GatherKeys(const FISMInstanceHandle& Handle, TArray<FGameplayTag>& OutKeys) const override
     {
-        RemoveFromAllKeys(Handle);
         if (Handle.IsOwned())
         {
-            AddToKey(Handle.GetOwnerTag(), Handle);
+            OutKeys.Add(Handle.GetOwnerTag());
         }
+        return true;
     }
 };
 
@@ -276,13 +580,13 @@ class ISMRUNTIMECORE_API UISMPossessionIndex : public UISMInstanceIndex
 {
     GENERATED_BODY()
 protected:
-    virtual void OnHandleChanged(const FISMInstanceHandle& Handle) override
+    virtual bool GatherKeys(const FISMInstanceHandle& Handle, TArray<FGameplayTag>& OutKeys) const override
     {
-        RemoveFromAllKeys(Handle);
         if (Handle.IsPossessed())
         {
-            AddToKey(Handle.GetPossessorTag(), Handle);
+            OutKeys.Add(Handle.GetPossessorTag());
         }
+        return true;
     }
 };
 
@@ -315,7 +619,7 @@ public:
     TMap<EISMInstanceState, FGameplayTag> StateTagMap;
 
 protected:
-    virtual void OnHandleChanged(const FISMInstanceHandle& Handle) override;
+    virtual bool GatherKeys(const FISMInstanceHandle& Handle, TArray<FGameplayTag>& OutKeys) const override;
 };
 
 /**
@@ -329,23 +633,12 @@ class ISMRUNTIMECORE_API UISMTagIndex : public UISMInstanceIndex
 {
     GENERATED_BODY()
 protected:
-    virtual void OnHandleChanged(const FISMInstanceHandle& Handle) override
+    virtual bool GatherKeys(const FISMInstanceHandle& Handle, TArray<FGameplayTag>& OutKeys) const override
     {
-        RemoveFromAllKeys(Handle);
-
-        if (UISMRuntimeComponent* Comp = Handle.Component.Get())
+        if (const UISMRuntimeComponent* Comp = Handle.Component.Get())
         {
-            FGameplayTagContainer Tags = Comp->GetInstanceTags(Handle.InstanceIndex);
-            Tags.GetGameplayTagArray(TagBuffer);
-
-            for (const FGameplayTag& Tag : TagBuffer)
-            {
-                AddToKey(Tag, Handle);
-            }
+            OutKeys.Append(Comp->GetInstanceTags(Handle.InstanceIndex).GetGameplayTagArray());
         }
+        return true;
     }
-
-private:
-    // Reusable buffer — avoids allocation per call
-    mutable TArray<FGameplayTag> TagBuffer;
 };
\ No newline at end of file
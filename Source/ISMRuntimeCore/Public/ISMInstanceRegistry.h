@@ -0,0 +1,104 @@
+// ISMInstanceRegistry.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMInstanceHandle.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Packed world-wide instance ID issued by FISMInstanceRegistry.
+ *
+ * Bits 63..42 hold the component's registry slot, 41..32 the slot's generation (bumped each time
+ * the slot is reused, never 0) and 31..0 the instance index. Zero is the invalid ID. IDs name an
+ * instance slot, not a generation of it: pair with FISMInstanceHandle::Generation to detect reuse.
+ */
+struct FISMGlobalInstanceId
+{
+    static constexpr int32  SlotBits = 22;
+    static constexpr int32  SlotGenerationBits = 10;
+    static constexpr uint32 MaxSlots = 1u << SlotBits;
+    static constexpr uint32 SlotGenerationMask = (1u << SlotGenerationBits) - 1;
+
+    uint64 Packed = 0;
+
+    FISMGlobalInstanceId() = default;
+    explicit FISMGlobalInstanceId(uint64 InPacked) : Packed(InPacked) {}
+    FISMGlobalInstanceId(uint32 Slot, uint32 SlotGeneration, int32 InstanceIndex)
+        : Packed((static_cast<uint64>(Slot) << (64 - SlotBits))
+            | (static_cast<uint64>(SlotGeneration & SlotGenerationMask) << 32)
+            | static_cast<uint32>(InstanceIndex))
+    {}
+
+    bool IsValid() const { return Packed != 0; }
+
+    uint32 GetSlot() const { return static_cast<uint32>(Packed >> (64 - SlotBits)); }
+    uint32 GetSlotGeneration() const { return static_cast<uint32>(Packed >> 32) & SlotGenerationMask; }
+    int32 GetInstanceIndex() const { return static_cast<int32>(static_cast<uint32>(Packed)); }
+
+    bool operator==(const FISMGlobalInstanceId& Other) const { return Packed == Other.Packed; }
+    bool operator!=(const FISMGlobalInstanceId& Other) const { return Packed != Other.Packed; }
+
+    friend uint32 GetTypeHash(const FISMGlobalInstanceId& Id) { return GetTypeHash(Id.Packed); }
+};
+
+/**
+ * World-wide instance registry owned by UISMRuntimeSubsystem.
+ *
+ * Each registered component gets a dense slot and a slot generation. An instance's
+ * FISMGlobalInstanceId is then plain integer data - hashing and comparing it never touches a weak
+ * pointer - and resolves back to its component with one array read. Unregistering bumps the slot
+ * generation, so IDs issued before then resolve to nothing even after the slot is reused.
+ */
+class ISMRUNTIMECORE_API FISMInstanceRegistry
+{
+public:
+    /** Give a component a slot. Returns the existing slot if already registered, INDEX_NONE when full. */
+    int32 Add(UISMRuntimeComponent* Component);
+
+    void Remove(const UISMRuntimeComponent* Component);
+
+    /** Free slots whose component was destroyed without unregistering */
+    void RemoveStaleEntries();
+
+    void Reset();
+
+    /** Slot of a registered component, or INDEX_NONE */
+    int32 FindSlot(const UISMRuntimeComponent* Component) const
+    {
+        const int32* Slot = SlotByComponent.Find(Component);
+        return Slot ? *Slot : INDEX_NONE;
+    }
+
+    /** ID of one instance of a registered component; invalid if the component is not registered */
+    FISMGlobalInstanceId MakeId(const UISMRuntimeComponent* Component, int32 InstanceIndex) const;
+
+    FISMGlobalInstanceId MakeId(const FISMInstanceHandle& Handle) const
+    {
+        return MakeId(Handle.Component.Get(), Handle.InstanceIndex);
+    }
+
+    /** Component an ID was issued for, or null once it unregistered or was destroyed. O(1). */
+    UISMRuntimeComponent* ResolveComponent(FISMGlobalInstanceId Id) const;
+
+    /** Handle to the instance an ID names, at the instance's current generation. Invalid if unresolvable. */
+    FISMInstanceHandle ResolveHandle(FISMGlobalInstanceId Id) const;
+
+    /** Registered components */
+    int32 Num() const { return SlotByComponent.Num(); }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FSlot
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+        uint32 Generation = 0;
+    };
+
+    void FreeSlot(int32 Slot);
+
+    TArray<FSlot> Slots;
+    TMap<const UISMRuntimeComponent*, int32> SlotByComponent;
+    TArray<int32> FreeSlots;
+};
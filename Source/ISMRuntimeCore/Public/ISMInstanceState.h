@@ -21,6 +21,14 @@ enum class EISMInstanceState : uint8
 };
 ENUM_CLASS_FLAGS(EISMInstanceState)
 
+/** Flags to raise and lower on one instance. Bits in both masks end up set. */
+struct FISMStateFlagsWrite
+{
+    int32 InstanceIndex = INDEX_NONE;
+    uint8 SetMask = 0;
+    uint8 ClearMask = 0;
+};
+
 /**
  * Runtime state data for a single ISM instance
  */
@@ -55,7 +63,7 @@ struct ISMRUNTIMECORE_API FISMInstanceState
     /** Whether WorldBounds is currently valid */
     bool bBoundsValid = false;
     
-    /** Custom data pointer for module-specific state (damage values, resource data, etc.) */
+    /** Custom data pointer for module-specific state. Prefer UISMRuntimeComponent::RegisterInstanceColumn for new modules. */
     void* ModuleData = nullptr;
     
     FISMInstanceState()
@@ -0,0 +1,267 @@
+// ISMInstanceStateStore.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMInstanceState.h"
+
+/**
+ * What a dormant component keeps of its FISMInstanceStateStore (see FISMInstanceStateStore::ExtractDelta):
+ * only the slots that differ from a freshly added Intact slot, plus the cold side tables.
+ */
+struct ISMRUNTIMECORE_API FISMInstanceStateDelta
+{
+    /** Slot count of the store it was taken from */
+    int32 NumSlots = 0;
+
+    /** Parallel arrays, one entry per slot whose flags or generation differ from a fresh slot */
+    TArray<int32> Indices;
+    TArray<uint8> Flags;
+    TArray<uint32> Generations;
+
+    TMap<int32, FTransform> LastVisibleTransforms;
+    TMap<int32, void*> ModuleData;
+
+    bool IsEmpty() const { return NumSlots == 0; }
+
+    void Reset();
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Dense structure-of-arrays storage for per-instance runtime state, indexed by instance index.
+ *
+ * Hot data lives in contiguous arrays, about 33 bytes per instance: flags, float world
+ * bounds, update frame and slot generation. Flag scans walk bytes linearly and bounds tests touch
+ * no transforms. Cold data (pre-hide transforms, module data) sits in sparse side tables keyed by
+ * index. Entries exist only while an instance is hidden or has module data attached.
+ *
+ * Slots that were never added read as "no state" (Contains() == false, flags 0).
+ *
+ * Every flag write goes through the store, so per-flag counts, the active count and the
+ * live/destroyed slot bitsets are kept incrementally and read in O(1).
+ */
+struct ISMRUNTIMECORE_API FISMInstanceStateStore
+{
+    /** Drop all state and free every array */
+    void Reset();
+
+    /** Pre-size the hot arrays for NumInstances slots */
+    void Reserve(int32 NumInstances);
+
+    /**
+     * Drop all state and create slots 0 .. NumInstances - 1 as Intact in one pass.
+     * Same result as Reset() followed by Add() for every index, without the per-slot writes.
+     */
+    void ResetIntact(int32 NumInstances, uint32 FrameNumber);
+
+    /**
+     * Create slots FirstIndex .. FirstIndex + NumInstances - 1 as Intact in one pass.
+     * None of them may have state yet - used to build a store range by range.
+     */
+    void AddIntactRange(int32 FirstIndex, int32 NumInstances, uint32 FrameNumber);
+
+    /** Drop all state and create one slot per entry of SlotFlags with those flags, e.g. from a bake */
+    void ResetFromFlags(TConstArrayView<uint8> SlotFlags, uint32 FrameNumber);
+
+    /**
+     * Move the state that cannot be rebuilt from the ISM into OutDelta and free every array.
+     * Bounds and update frames are dropped. Slots without state are not recorded: every slot
+     * is assumed present, as after InitializeInstances.
+     */
+    void ExtractDelta(FISMInstanceStateDelta& OutDelta);
+
+    /** Rebuild the store from ExtractDelta's result: ResetIntact over Delta.NumSlots, then the recorded slots */
+    void ApplyDelta(FISMInstanceStateDelta&& Delta, uint32 FrameNumber);
+
+    /**
+     * Create (or reset) the state slot for InstanceIndex. New state starts Intact.
+     * Resetting a slot that already had state bumps its generation.
+     */
+    void Add(int32 InstanceIndex, uint32 FrameNumber);
+
+    /** How many times InstanceIndex has been reused. Handles compare against this to detect staleness. */
+    uint32 GetGeneration(int32 InstanceIndex) const
+    {
+        return Generations.IsValidIndex(InstanceIndex) ? Generations[InstanceIndex] : 0;
+    }
+
+    /** Whether InstanceIndex has a state slot */
+    bool Contains(int32 InstanceIndex) const
+    {
+        return Present.IsValidIndex(InstanceIndex) && Present[InstanceIndex];
+    }
+
+    /** Number of slots (highest added index + 1) */
+    int32 Num() const { return Flags.Num(); }
+
+    /** Number of slots with state */
+    int32 NumPresent() const { return PresentCount; }
+
+    // ===== Flags (hot) =====
+
+    uint8 GetFlags(int32 InstanceIndex) const
+    {
+        return Flags.IsValidIndex(InstanceIndex) ? Flags[InstanceIndex] : 0;
+    }
+
+    /** GetFlags for each of InstanceIndices into the matching element of OutFlags */
+    void GatherFlags(TConstArrayView<int32> InstanceIndices, TArrayView<uint8> OutFlags) const;
+
+    /** Flag byte per slot, Num() long */
+    TConstArrayView<uint8> GetFlagsView() const { return Flags; }
+
+    bool HasFlag(int32 InstanceIndex, EISMInstanceState Flag) const
+    {
+        return (GetFlags(InstanceIndex) & static_cast<uint8>(Flag)) != 0;
+    }
+
+    /** Set or clear one flag. No-op for slots without state. */
+    void SetFlag(int32 InstanceIndex, EISMInstanceState Flag, bool bValue);
+
+    /** Replace the whole flag byte in one write. No-op for slots without state. */
+    void SetFlags(int32 InstanceIndex, uint8 NewFlags);
+
+    /** Same transition as FISMInstanceState::MarkDestroyed */
+    void MarkDestroyed(int32 InstanceIndex);
+
+    /** Present and none of Destroyed/Collected/Hidden - matches FISMInstanceState::IsActive */
+    bool IsActive(int32 InstanceIndex) const
+    {
+        return Contains(InstanceIndex) && (Flags[InstanceIndex] & InactiveMask) == 0;
+    }
+
+    /** Number of present slots that are active. O(1). */
+    int32 GetActiveCount() const { return ActiveCount; }
+
+    /** Number of present slots with Flag set. O(1). */
+    int32 GetFlagCount(EISMInstanceState Flag) const;
+
+    /** One bit per slot: present and not destroyed. Iterate with TConstSetBitIterator. */
+    const TBitArray<>& GetLiveSlots() const { return LiveSlots; }
+
+    /** One bit per slot: present and destroyed - the free list for slot recycling */
+    const TBitArray<>& GetDestroyedSlots() const { return DestroyedSlots; }
+
+    /** Lowest destroyed slot, or INDEX_NONE if there is none */
+    int32 FindDestroyedSlot() const
+    {
+        return FlagCounts[DestroyedBit] > 0 ? DestroyedSlots.Find(true) : INDEX_NONE;
+    }
+
+    /** Count present slots with none of the bits in ExcludeMask set. One pass over the flag bytes. */
+    int32 CountWithoutFlags(uint8 ExcludeMask) const;
+
+    /** Append every present index with none of the bits in ExcludeMask set */
+    void GatherWithoutFlags(uint8 ExcludeMask, TArray<int32>& OutIndices) const;
+
+    /** Flags that make an instance inactive */
+    static constexpr uint8 InactiveMask =
+        static_cast<uint8>(EISMInstanceState::Destroyed) |
+        static_cast<uint8>(EISMInstanceState::Collected) |
+        static_cast<uint8>(EISMInstanceState::Hidden);
+
+    // ===== Bounds (hot) =====
+
+    /** Record the world AABB. Stored in single precision, like FISMSpatialIndex positions. */
+    void SetWorldBounds(int32 InstanceIndex, const FBox& Bounds);
+
+    /** SetWorldBounds for slots 0 .. N - 1 in one copy, e.g. from a bake. Slots past Num() are ignored. */
+    void AdoptWorldBounds(TConstArrayView<FVector3f> InBoundsMin, TConstArrayView<FVector3f> InBoundsMax);
+
+    /** World AABB; false if none has been recorded */
+    bool GetWorldBounds(int32 InstanceIndex, FBox& OutBounds) const
+    {
+        if (!BoundsValid.IsValidIndex(InstanceIndex) || !BoundsValid[InstanceIndex])
+        {
+            return false;
+        }
+        OutBounds = FBox(FVector(BoundsMin[InstanceIndex]), FVector(BoundsMax[InstanceIndex]));
+        return true;
+    }
+
+    bool HasWorldBounds(int32 InstanceIndex) const
+    {
+        return BoundsValid.IsValidIndex(InstanceIndex) && BoundsValid[InstanceIndex];
+    }
+
+    // ===== Cold data =====
+
+    void SetLastUpdateFrame(int32 InstanceIndex, uint32 FrameNumber)
+    {
+        if (Contains(InstanceIndex))
+        {
+            LastUpdateFrames[InstanceIndex] = FrameNumber;
+        }
+    }
+
+    uint32 GetLastUpdateFrame(int32 InstanceIndex) const
+    {
+        return LastUpdateFrames.IsValidIndex(InstanceIndex) ? LastUpdateFrames[InstanceIndex] : 0;
+    }
+
+    /** Remember the transform to restore on show */
+    void SetLastVisibleTransform(int32 InstanceIndex, const FTransform& Transform);
+
+    /** Update the remembered visible transform only if one is already being tracked */
+    void RefreshLastVisibleTransform(int32 InstanceIndex, const FTransform& Transform);
+
+    /** Forget the pre-hide transform once it has been restored */
+    void ClearLastVisibleTransform(int32 InstanceIndex) { LastVisibleTransforms.Remove(InstanceIndex); }
+
+    /** Pre-hide transform, or nullptr if none was recorded */
+    const FTransform* GetLastVisibleTransform(int32 InstanceIndex) const
+    {
+        return LastVisibleTransforms.Find(InstanceIndex);
+    }
+
+    /** Attach module data; nullptr removes the entry */
+    void SetModuleData(int32 InstanceIndex, void* Data);
+    void* GetModuleData(int32 InstanceIndex) const
+    {
+        void* const* Data = ModuleData.Find(InstanceIndex);
+        return Data ? *Data : nullptr;
+    }
+
+    /** Number of entries in the cold side tables */
+    int32 GetColdEntryCount() const { return LastVisibleTransforms.Num() + ModuleData.Num(); }
+
+    /** Assemble the AoS view of one slot. CachedTransform is left for the caller to fill. */
+    FISMInstanceState ToInstanceState(int32 InstanceIndex) const;
+
+    /** Heap bytes held by all arrays */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    /** Grow every allocated array so InstanceIndex is addressable */
+    void EnsureSlot(int32 InstanceIndex);
+
+    /** Replace a present slot's flags, keeping counters and bitsets in step */
+    void WriteFlags(int32 InstanceIndex, uint8 NewFlags);
+
+    /** Add (Sign = 1) or remove (Sign = -1) one slot's flags from the counters; |Sign| > 1 counts that many slots */
+    void AccumulateFlags(uint8 SlotFlags, int32 Sign);
+
+    static constexpr int32 DestroyedBit = 2;
+
+    // Hot
+    TArray<uint8> Flags;
+    TBitArray<> Present;
+    TArray<FVector3f> BoundsMin;
+    TArray<FVector3f> BoundsMax;
+    TBitArray<> BoundsValid;
+    int32 PresentCount = 0;
+
+    // Incremental counts over present slots
+    int32 FlagCounts[8] = {};
+    int32 ActiveCount = 0;
+    TBitArray<> LiveSlots;
+    TBitArray<> DestroyedSlots;
+
+    TArray<uint32> LastUpdateFrames;
+    TArray<uint32> Generations;
+
+    // Cold - sparse, only instances that need them have entries
+    TMap<int32, FTransform> LastVisibleTransforms;
+    TMap<int32, void*> ModuleData;
+};
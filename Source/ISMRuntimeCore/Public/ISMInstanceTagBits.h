@@ -0,0 +1,157 @@
+// ISMInstanceTagBits.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+/**
+ * Fixed 128-bit tag set. Bit meaning comes from the FISMInstanceTagBits dictionary that produced it.
+ */
+struct ISMRUNTIMECORE_API FISMTagMask
+{
+    static constexpr int32 NumWords = 2;
+    static constexpr int32 MaxBits = NumWords * 64;
+
+    uint64 Words[NumWords] = {};
+
+    void SetBit(int32 Bit) { Words[Bit >> 6] |= (1ULL << (Bit & 63)); }
+    void ClearBit(int32 Bit) { Words[Bit >> 6] &= ~(1ULL << (Bit & 63)); }
+    bool TestBit(int32 Bit) const { return (Words[Bit >> 6] & (1ULL << (Bit & 63))) != 0; }
+
+    bool IsEmpty() const { return (Words[0] | Words[1]) == 0; }
+
+    /** Every bit of Other is set here */
+    bool HasAll(const FISMTagMask& Other) const
+    {
+        return (Words[0] & Other.Words[0]) == Other.Words[0]
+            && (Words[1] & Other.Words[1]) == Other.Words[1];
+    }
+
+    /** At least one bit of Other is set here */
+    bool HasAny(const FISMTagMask& Other) const
+    {
+        return ((Words[0] & Other.Words[0]) | (Words[1] & Other.Words[1])) != 0;
+    }
+
+    FISMTagMask& operator|=(const FISMTagMask& Other)
+    {
+        Words[0] |= Other.Words[0];
+        Words[1] |= Other.Words[1];
+        return *this;
+    }
+
+    bool operator==(const FISMTagMask& Other) const
+    {
+        return Words[0] == Other.Words[0] && Words[1] == Other.Words[1];
+    }
+};
+
+/**
+ * Required/excluded tag filter translated into masks for one component.
+ * Tags already satisfied (or violated) by the component's own tags are folded in up front.
+ */
+struct ISMRUNTIMECORE_API FISMTagFilterMasks
+{
+    FISMTagMask Required;
+    FISMTagMask Excluded;
+
+    /** No instance of the component can pass - a required tag is unknown or an excluded tag is on the component */
+    bool bNeverPasses = false;
+
+    bool Passes(const FISMTagMask& InstanceMask) const
+    {
+        return !bNeverPasses && InstanceMask.HasAll(Required) && !InstanceMask.HasAny(Excluded);
+    }
+};
+
+/**
+ * Compact per-instance gameplay tags: a component-local dictionary of up to 128 tags and two
+ * bitmasks per instance slot.
+ *
+ * The explicit mask holds the tags that were added. The effective mask also has the bits of each
+ * tag's parents, so hierarchical matching (a required "A" is met by "A.B") is a word AND, like
+ * FGameplayTagContainer::HasAll. Parents take dictionary bits too.
+ *
+ * Queries never allocate. Adding a tag the dictionary has not seen yet may allocate.
+ */
+class ISMRUNTIMECORE_API FISMInstanceTagBits
+{
+public:
+    /** Bit for Tag, or INDEX_NONE if the dictionary does not hold it */
+    int32 FindBit(FGameplayTag Tag) const
+    {
+        const int32* Bit = TagToBit.Find(Tag);
+        return Bit ? *Bit : INDEX_NONE;
+    }
+
+    /**
+     * Bit for Tag, adding it and any missing parents to the dictionary.
+     * @return INDEX_NONE if the tag and its parents do not fit in the remaining bits.
+     */
+    int32 FindOrAddBit(FGameplayTag Tag);
+
+    /** Set an explicit tag bit. @return true if the instance did not have it. */
+    bool SetInstanceBit(int32 InstanceIndex, int32 Bit);
+
+    /** Clear an explicit tag. @return true if the instance had it. */
+    bool RemoveTag(int32 InstanceIndex, FGameplayTag Tag);
+
+    /** Drop every tag of one instance. @return true if it had any. */
+    bool ClearInstance(int32 InstanceIndex);
+
+    /** Hierarchical test - true if the instance has Tag or one of its children */
+    bool HasTag(int32 InstanceIndex, FGameplayTag Tag) const
+    {
+        const int32 Bit = FindBit(Tag);
+        return Bit != INDEX_NONE && GetEffectiveMask(InstanceIndex).TestBit(Bit);
+    }
+
+    bool HasAnyTags(int32 InstanceIndex) const
+    {
+        return ExplicitMasks.IsValidIndex(InstanceIndex) && !ExplicitMasks[InstanceIndex].IsEmpty();
+    }
+
+    /** Explicit tags plus their parents, as bits */
+    const FISMTagMask& GetEffectiveMask(int32 InstanceIndex) const
+    {
+        static const FISMTagMask Empty;
+        return EffectiveMasks.IsValidIndex(InstanceIndex) ? EffectiveMasks[InstanceIndex] : Empty;
+    }
+
+    /** Add the instance's explicit tags to OutTags */
+    void AppendTags(int32 InstanceIndex, FGameplayTagContainer& OutTags) const;
+
+    /**
+     * Translate a required/excluded filter for instances whose component carries ComponentTags.
+     * Allocation free.
+     */
+    void BuildFilterMasks(const FGameplayTagContainer& ComponentTags,
+        const FGameplayTagContainer& RequiredTags,
+        const FGameplayTagContainer& ExcludedTags,
+        FISMTagFilterMasks& OutMasks) const;
+
+    /** Dictionary tags in bit order */
+    const TArray<FGameplayTag>& GetDictionary() const { return Tags; }
+
+    int32 GetNumTags() const { return Tags.Num(); }
+
+    /** Instance slots with a mask */
+    int32 Num() const { return ExplicitMasks.Num(); }
+
+    /** Drop every mask and the dictionary */
+    void Reset();
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    void RebuildEffectiveMask(int32 InstanceIndex);
+
+    TArray<FGameplayTag> Tags;
+    TMap<FGameplayTag, int32> TagToBit;
+
+    /** Per dictionary bit: the bit itself plus its parents' bits */
+    TArray<FISMTagMask> ExpandedMasks;
+
+    TArray<FISMTagMask> ExplicitMasks;
+    TArray<FISMTagMask> EffectiveMasks;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include "CoreMinimal.h"
+
+#include "ISMMemoryStats.generated.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Heap memory held by one runtime component, by category (UISMRuntimeComponent::GetMemoryStats).
+ * Counts container allocations only; the component object and the ISM it drives are excluded.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMComponentMemoryStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    UISMRuntimeComponent* Component = nullptr;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int32 InstanceCount = 0;
+
+    /** State store and module data columns */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 InstanceStateBytes = 0;
+
+    /** Per-instance tags, compact and container */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 TagBytes = 0;
+
+    /** Cached instance handles and the init-time index remap */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 HandleBytes = 0;
+
+    /** Live index, published snapshot and per-cell bounds and generations */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 SpatialIndexBytes = 0;
+
+    /** Change tracker, custom data journal and batch scratch */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 OtherBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 TotalBytes = 0;
+};
+
+/** Heap memory held by one system outside the components: instance indexes, pools, caches */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMMemoryStatEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    FString Name;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 Bytes = 0;
+
+    /** Objects the entry covers (indexes, pools, in-flight chunks), for context */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int32 Count = 0;
+};
@@ -0,0 +1,89 @@
+// ISMNearestSelection.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/Sort.h"
+
+/**
+ * Keeps the K nearest of a stream of candidates, with each candidate's squared distance cached
+ * next to it so it is computed once.
+ *
+ * With a capacity the survivors are kept in a bounded max-heap: a candidate costs O(log K) and
+ * only beats the current worst. Without one (capacity <= 0) every candidate is kept. Either way
+ * only the survivors are sorted. Equal distances keep arrival order, so results are deterministic.
+ */
+template<typename ElementType>
+class TISMNearestSelection
+{
+public:
+    /** @param InCapacity Number of nearest candidates to keep; <= 0 keeps all */
+    explicit TISMNearestSelection(int32 InCapacity = 0)
+        : Capacity(InCapacity)
+    {
+    }
+
+    void Add(const ElementType& Element, float DistanceSq)
+    {
+        const FEntry Entry{ Element, DistanceSq, NextSequence++ };
+        if (Capacity <= 0)
+        {
+            Entries.Add(Entry);
+            return;
+        }
+
+        if (Entries.Num() < Capacity)
+        {
+            Entries.HeapPush(Entry, FWorstFirst());
+        }
+        else if (DistanceSq < Entries.HeapTop().DistanceSq)
+        {
+            Entries.HeapPopDiscard(FWorstFirst(), EAllowShrinking::No);
+            Entries.HeapPush(Entry, FWorstFirst());
+        }
+    }
+
+    /** Squared distance a candidate must beat to be kept */
+    float GetWorstDistanceSq() const
+    {
+        return Capacity > 0 && Entries.Num() >= Capacity ? Entries.HeapTop().DistanceSq : TNumericLimits<float>::Max();
+    }
+
+    int32 Num() const { return Entries.Num(); }
+
+    /** Sort the survivors nearest first and append them to Out */
+    template<typename AllocatorType>
+    void AppendSorted(TArray<ElementType, AllocatorType>& Out)
+    {
+        Algo::Sort(Entries, [](const FEntry& A, const FEntry& B)
+            {
+                return A.DistanceSq < B.DistanceSq || (A.DistanceSq == B.DistanceSq && A.Sequence < B.Sequence);
+            });
+
+        Out.Reserve(Out.Num() + Entries.Num());
+        for (const FEntry& Entry : Entries)
+        {
+            Out.Add(Entry.Element);
+        }
+    }
+
+private:
+    struct FEntry
+    {
+        ElementType Element;
+        float DistanceSq;
+        int32 Sequence;
+    };
+
+    /** Heap order with the farthest (latest on ties) candidate on top */
+    struct FWorstFirst
+    {
+        bool operator()(const FEntry& A, const FEntry& B) const
+        {
+            return A.DistanceSq > B.DistanceSq || (A.DistanceSq == B.DistanceSq && A.Sequence > B.Sequence);
+        }
+    };
+
+    TArray<FEntry> Entries;
+    int32 Capacity = 0;
+    int32 NextSequence = 0;
+};
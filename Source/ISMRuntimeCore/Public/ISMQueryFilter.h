@@ -6,6 +6,8 @@
 #include "ISMInstanceHandle.h"
 #include "ISMQueryFilter.generated.h"
 
+class FISMCompiledQueryFilter;
+
 /**
  * Filter for querying ISM instances with various criteria
  */
@@ -56,7 +58,7 @@ struct ISMRUNTIMECORE_API FISMQueryFilter
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filter|Limits")
     int32 MaxResults = -1;
     
-    /** Sort results by distance (closest first) */
+    /** Sort results by distance (closest first). Radius queries then keep the MaxResults nearest. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filter|Limits")
     bool bSortByDistance = false;
 
@@ -77,6 +79,16 @@ struct ISMRUNTIMECORE_API FISMQueryFilter
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filter|AABB")
     bool bExcludeIfAABBUnavailable = false;
     
+    // ===== Execution =====
+
+    /**
+     * Fan per-component lookups and filter evaluation out across worker threads once enough
+     * components are involved (see UISMRuntimeSettings::ParallelQueryMinItems). Results are merged in the
+     * same order as the serial path. CustomFilter must be safe to call from worker threads.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filter|Execution")
+    bool bAllowParallel = false;
+    
     // ===== Custom Filter (C++ only) =====
     
     /** Custom filter function for advanced filtering logic */
@@ -87,9 +99,15 @@ struct ISMRUNTIMECORE_API FISMQueryFilter
     /** Check if an instance passes all filter criteria */
     bool PassesFilter(const FISMInstanceReference& Instance) const;
     
-    /** Check if a component passes component-level filters (before checking instances) */
-    bool PassesComponentFilter(class UISMRuntimeComponent* Component) const;
+    /**
+     * Check if a component passes component-level filters (before checking instances).
+     * @param bTagSetsMatched Caller already tested RequiredTags/ExcludedTags (e.g. via the subsystem tag index)
+     */
+    bool PassesComponentFilter(class UISMRuntimeComponent* Component, bool bTagSetsMatched = false) const;
     
-    /** Check if instance passes state filters */
-    bool PassesStateFilter(const struct FISMInstanceState* State) const;
+    /** Check if instance passes state filters (bHasState false = instance has no state entry) */
+    bool PassesStateFilter(bool bHasState, uint8 StateFlags) const;
+
+    /** Flatten into a predicate for per-instance loops (see FISMCompiledQueryFilter). The result owns a copy of this filter. */
+    FISMCompiledQueryFilter Compile() const;
 };
\ No newline at end of file
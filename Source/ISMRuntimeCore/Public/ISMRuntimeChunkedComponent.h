@@ -0,0 +1,206 @@
+// ISMRuntimeChunkedComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Containers/ChunkedArray.h"
+#include "ISMInstanceHandle.h"
+#include "ISMInstanceState.h"
+#include "ISMRuntimeChunkedComponent.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UISMInstanceDataAsset;
+class UISMRuntimeComponent;
+struct FISMQueryFilter;
+
+/** Where one logical instance of a UISMRuntimeChunkedComponent lives */
+struct FISMChunkedInstanceLocation
+{
+    int32 Chunk = INDEX_NONE;
+    int32 LocalIndex = INDEX_NONE;
+
+    bool IsValid() const { return Chunk != INDEX_NONE; }
+};
+
+/** One chunk: an ISM and the runtime component managing it, for one region of the grid */
+USTRUCT()
+struct FISMInstanceChunk
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TObjectPtr<UISMRuntimeComponent> Component = nullptr;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UInstancedStaticMeshComponent> ISM = nullptr;
+
+    FIntPoint Region = FIntPoint::ZeroValue;
+
+    /** Local instance index -> logical index */
+    TArray<int32> LogicalIndices;
+};
+
+/**
+ * One logical instance space stored as many fixed-size chunks, for instance counts a single
+ * UISMRuntimeComponent handles badly (a few hundred thousand and up).
+ *
+ * Instances are placed by XY region of ChunkSize; each region gets its own ISM and runtime
+ * component, with a new chunk opened when one reaches MaxInstancesPerChunk. A mutation therefore
+ * only grows, dirties and uploads its own chunk's arrays and render data, recomputes that chunk's
+ * bounds and takes that chunk's scheduler state, and the chunks are ordinary registered components:
+ * subsystem queries, traces and conversions see them directly.
+ *
+ * Logical indices are stable and never reused while the component lives. Instances stay in the
+ * chunk they were added to; moving one out of its region only widens that chunk's bounds. Chunk
+ * events and handles carry local indices - map them back with GetLogicalIndex.
+ */
+UCLASS(Blueprintable, ClassGroup=(ISMRuntime), meta=(BlueprintSpawnableComponent))
+class ISMRUNTIMECORE_API UISMRuntimeChunkedComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UISMRuntimeChunkedComponent();
+
+    virtual void EndPlay(const EEndPlayReason::Type EndReason) override;
+
+    // ===== Configuration =====
+
+    /** Runtime component class each chunk is created as; its defaults configure every chunk */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Chunked")
+    TSubclassOf<UISMRuntimeComponent> ChunkClass;
+
+    /** Data asset every chunk uses; its mesh and materials go on the chunk ISMs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Chunked")
+    TObjectPtr<UISMInstanceDataAsset> InstanceData = nullptr;
+
+    /** Custom data floats per instance on the chunk ISMs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Chunked", meta = (ClampMin = "0"))
+    int32 NumCustomDataFloats = 0;
+
+    /** Collision profile of the chunk ISMs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Chunked")
+    FName CollisionProfileName = TEXT("BlockAll");
+
+    /** Edge of one XY region in cm (256m = 25600cm). Chunks never span regions. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Chunked", meta = (ClampMin = "100.0", Units = "cm"))
+    float ChunkSize = 25600.0f;
+
+    /** Instances one chunk takes before its region opens another; bounds every per-chunk array */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Chunked", meta = (ClampMin = "1"))
+    int32 MaxInstancesPerChunk = 65536;
+
+    // ===== Instances =====
+
+    /** Add one instance at a world transform. Returns its logical index, or INDEX_NONE on failure. */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    int32 AddInstance(const FTransform& Transform, bool bTriggerFeedbacks = true);
+
+    /**
+     * Add many instances: grouped by region and appended to each chunk with one
+     * UISMRuntimeComponent::BulkAppendInstances, so each touched chunk uploads once.
+     * @param CustomData Optional, CustomDataStride floats per instance
+     * @return Logical indices parallel to Transforms, consecutive in input order over the instances
+     * added; INDEX_NONE for any that failed, which take no logical index
+     */
+    TArray<int32> BatchAddInstances(const TArray<FTransform>& Transforms, TConstArrayView<float> CustomData = {}, int32 CustomDataStride = 0);
+
+    /**
+     * Move the instances of an existing ISM (transforms and custom data) into chunks, e.g. to split
+     * placed content at BeginPlay. Returns how many were adopted; Source is cleared if asked.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    int32 AdoptInstances(UInstancedStaticMeshComponent* Source, bool bClearSource = true);
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    void DestroyInstance(int32 LogicalIndex, bool bTriggerFeedbacks = true);
+
+    /** Destroy many instances with one BatchDestroyInstances per touched chunk */
+    void BatchDestroyInstances(TConstArrayView<int32> LogicalIndices, bool bTriggerFeedbacks = true);
+
+    /** Move an instance; it stays in its chunk, whose bounds widen to keep it queryable */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    void UpdateInstanceTransform(int32 LogicalIndex, const FTransform& NewTransform);
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    void SetInstanceState(int32 LogicalIndex, EISMInstanceState State, bool bValue);
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    void SetInstanceCustomDataValue(int32 LogicalIndex, int32 DataIndex, float Value);
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    bool IsInstanceDestroyed(int32 LogicalIndex) const;
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    FTransform GetInstanceTransform(int32 LogicalIndex) const;
+
+    /** Handle into the instance's chunk component; invalid for an unknown index */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    FISMInstanceHandle GetInstanceHandle(int32 LogicalIndex) const;
+
+    /**
+     * Logical instances within Radius of Location, visiting only chunks whose runtime component
+     * bounds (UISMRuntimeComponent::GetInstanceBounds, current as of the last add or move) reach it
+     */
+    void QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter, TArray<int32>& OutLogicalIndices) const;
+
+    // ===== Logical Space =====
+
+    /** Logical indices issued, destroyed ones included */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    int32 GetInstanceCount() const { return Locations.Num(); }
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    int32 GetActiveInstanceCount() const;
+
+    FISMChunkedInstanceLocation GetInstanceLocation(int32 LogicalIndex) const
+    {
+        return LogicalIndex >= 0 && LogicalIndex < Locations.Num() ? Locations[LogicalIndex] : FISMChunkedInstanceLocation();
+    }
+
+    /** Logical index of a chunk's local instance, INDEX_NONE if Chunk is not one of ours */
+    int32 GetLogicalIndex(const UISMRuntimeComponent* Chunk, int32 LocalIndex) const;
+
+    int32 GetLogicalIndex(const FISMInstanceHandle& Handle) const { return GetLogicalIndex(Handle.Component.Get(), Handle.InstanceIndex); }
+
+    // ===== Chunks =====
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    int32 GetNumChunks() const { return Chunks.Num(); }
+
+    UISMRuntimeComponent* GetChunkComponent(int32 Chunk) const { return Chunks.IsValidIndex(Chunk) ? Chunks[Chunk].Component.Get() : nullptr; }
+
+    const FISMInstanceChunk* GetChunk(int32 Chunk) const { return Chunks.IsValidIndex(Chunk) ? &Chunks[Chunk] : nullptr; }
+
+    /** Region a world location falls in */
+    FIntPoint GetRegion(const FVector& Location) const;
+
+    /** Destroy every chunk component and forget all instances */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Chunked")
+    void ResetChunks();
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    /** Chunk of Region with room for NumNew more instances, creating one if needed. INDEX_NONE on failure. */
+    int32 FindOrAddOpenChunk(const FIntPoint& Region, int32 NumNew);
+
+    int32 CreateChunk(const FIntPoint& Region);
+
+    /** Record LocalIndex of Chunk as LogicalIndex, forgetting whichever logical instance held a recycled slot */
+    void BindLocalIndex(int32 Chunk, int32 LocalIndex, int32 LogicalIndex);
+
+    /** Live chunk component of a logical instance, or null */
+    UISMRuntimeComponent* ResolveInstance(int32 LogicalIndex, int32& OutLocalIndex) const;
+
+    UPROPERTY(Transient)
+    TArray<FISMInstanceChunk> Chunks;
+
+    /** Logical index -> chunk and local index. Chunked so growth never moves what is already stored. */
+    TChunkedArray<FISMChunkedInstanceLocation> Locations;
+
+    /** Chunk accepting new instances, per region */
+    TMap<FIntPoint, int32> OpenChunkByRegion;
+
+    TMap<const UISMRuntimeComponent*, int32> ChunkByComponent;
+};
@@ -5,7 +5,18 @@
 #include "Components/PrimitiveComponent.h"
 #include "GameplayTagContainer.h"
 #include "ISMSpatialIndex.h"
+#include "ISMSpatialIndexHealth.h"
+#include "ISMMemoryStats.h"
+#include "ISMComponentOpCounters.h"
+#include "ISMInstanceStateStore.h"
+#include "ISMInstanceDataColumns.h"
+#include "ISMInstanceTagBits.h"
+#include "ISMInstanceHandleTable.h"
+#include "ISMCellBoundsCache.h"
+#include "ISMInstanceChangeTracker.h"
+#include "ISMCustomDataJournal.h"
 #include "Feedbacks/ISMFeedbackTags.h"
+#include "CustomData/ISMCustomDataSchema.h"
 #include "ISMInstanceHandle.h"
 #include "Delegates/DelegateCombinations.h"
 #include "Interfaces/ISMStateProvider.h"
@@ -15,10 +26,13 @@
 // Forward declarations
 class UInstancedStaticMeshComponent;
 class UISMInstanceDataAsset;
+class UISMBakedInstanceState;
 
 struct FISMQueryFilter;
+class FISMCompiledQueryFilter;
 struct FISMInstanceState;
 struct FISMFeedbackParticipant;
+enum class EISMSnapshotField : uint8;
 
 // Declares a log category symbol other .cpp files can reference
 DECLARE_LOG_CATEGORY_EXTERN(LogISMRuntimeCore, Log, All);
@@ -44,11 +58,28 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInstanceReleased, class UISMRunt
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBatchInstancesAddedNative, class UISMRuntimeComponent*, const TArray<int32>&);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstanceAddedNative, class UISMRuntimeComponent*, int32);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstanceStateChangedNative, class UISMRuntimeComponent*, int32);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBatchInstanceStatesChangedNative, class UISMRuntimeComponent*, const TArray<int32>&);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstanceDestroyedNative, class UISMRuntimeComponent*, int32);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstancesChangedBatchNative, class UISMRuntimeComponent*, TArrayView<const int32>);
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstanceOwnerChangedNative, class UISMRuntimeComponent*, int32);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstancePossessionChangedNative, class UISMRuntimeComponent*, int32);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstanceAttachmentChangedNative, class UISMRuntimeComponent*, int32);
+
+/** Instance event kinds collected by bCoalesceInstanceEvents */
+enum class EISMInstanceEvent : uint8
+{
+    StateChanged,
+    Destroyed,
+    TagsChanged,
+    OwnerChanged,
+    PossessionChanged,
+    AttachmentChanged,
+    Num
+};
+
+/** One coalesced event kind: every instance it happened to since the last flush, sorted and distinct */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnInstanceEventsFlushedNative, class UISMRuntimeComponent*, EISMInstanceEvent, TArrayView<const int32>);
 /**
 * 
 * 
@@ -90,6 +121,89 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance", meta = (ClampMin = "100.0"))
     float SpatialIndexCellSize = 1000.0f;
 
+    /**
+     * Store the spatial index as sorted cells over one contiguous instance buffer
+     * instead of a hash map of per-cell arrays. Faster queries on large, mostly
+     * static components; incremental adds/removes are batched into periodic compactions.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bUseFlatSpatialIndex = false;
+
+    /**
+     * WriteCustomDataSlot calls touching at most this fraction of instances upload only the
+     * written instances; larger writes re-upload all custom data at once, which is cheaper
+     * than tracking most of the component instance by instance. 0 = always upload everything.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float PartialCustomDataUploadFraction = 0.1f;
+
+    /**
+     * Journal custom data writes from InitializeInstances on (see GetCustomDataJournal). Also makes
+     * SaveRuntimeState write custom data as deltas, which LoadRuntimeState only takes on a
+     * component with the journal enabled.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bEnableCustomDataJournal = false;
+
+    /**
+     * Number of spatial index resolutions (1 = single grid).
+     * Each extra level adds a grid 4x coarser so large-radius queries (explosions)
+     * stay cheap while SpatialIndexCellSize stays tuned for small ones (collectors).
+     * ClampMax is FISMSpatialIndex::MaxHierarchyLevels.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance", meta = (ClampMin = "1", ClampMax = "6"))
+    int32 SpatialIndexLevels = 1;
+
+    /**
+     * Record spatial query telemetry (query count, candidates walked, exact hits, radius
+     * distribution) from InitializeInstances on, for GetSpatialIndexHealth and its cell size
+     * recommendation. A few atomic adds per radius/box query.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bSpatialQueryTelemetry = false;
+
+    /**
+     * Sample which instance indexes take the most transform and custom data writes, for the
+     * HotInstances of GetOpStats. Operation totals and rates are always counted.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bSampleHotInstances = false;
+
+    /**
+     * Publish an immutable copy of the spatial index once per frame (from the subsystem tick)
+     * so worker threads can query it via GetSpatialIndexSnapshot while the game thread mutates.
+     * Costs one index copy per frame in which the index changed.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bPublishSpatialIndexSnapshot = false;
+
+    /**
+     * Reorder the managed ISM's instances by Morton (Z-order) code of their location during
+     * InitializeInstances, so instance index order follows space. Spatial queries, batch chunks
+     * and per-instance arrays then walk memory coherently.
+     * Indices captured before initialization must be translated with GetRemappedInitialIndex.
+     * Pointless for HISM components, which keep their own spatial order.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bMortonOrderInstances = false;
+
+    /**
+     * AddInstance / BatchAddInstances reuse the slots of destroyed instances instead of growing the ISM,
+     * so respawning fields keep a fixed instance buffer. Handles issued for the old occupant go stale.
+     * The recycled slot gets fresh state, tags, custom data and handle. Slots are not reused
+     * while the component is batch locked, since in-flight snapshots address them by index.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bRecycleDestroyedInstances = false;
+
+    /**
+     * Cooked runtime state to start from (see UISMBakedInstanceState / BakeState). When compatible,
+     * InitializeInstances loads instances, custom data, state flags, tags and spatial index cells
+     * from it instead of building them, and skips Morton ordering (the bake already has its order).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    TObjectPtr<UISMBakedInstanceState> BakedState = nullptr;
+
 #pragma endregion
 
     
@@ -109,6 +223,15 @@ public:
     UPROPERTY()
     TMap<int32, FGameplayTagContainer> PerInstanceTags;
 
+    /**
+     * Keep per-instance tags as bitmasks over a component-local dictionary of up to 128 tags
+     * instead of PerInstanceTags. Tag filters then test machine words with no allocations.
+     * If the dictionary fills up, the tags move back to PerInstanceTags and this turns off.
+     * Set before InitializeInstances.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Tags")
+    bool bCompactInstanceTags = false;
+
     /** Add a tag to a specific instance */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
     void AddInstanceTag(int32 InstanceIndex, FGameplayTag Tag);
@@ -117,6 +240,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
     void RemoveInstanceTag(int32 InstanceIndex, FGameplayTag Tag);
 
+    /** Add a tag to several instances; native listeners get one OnInstancesChangedBatchNative */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
+    void BatchAddInstanceTag(const TArray<int32>& InstanceIndices, FGameplayTag Tag);
+
+    /** Remove a tag from several instances; native listeners get one OnInstancesChangedBatchNative */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
+    void BatchRemoveInstanceTag(const TArray<int32>& InstanceIndices, FGameplayTag Tag);
+
     /** Check if a specific instance has a tag */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
     bool InstanceHasTag(int32 InstanceIndex, FGameplayTag Tag) const;
@@ -125,6 +256,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
     FGameplayTagContainer GetInstanceTags(int32 InstanceIndex) const;
 
+    /**
+     * Whether the instance's effective tags (component + instance) contain all RequiredTags and none
+     * of ExcludedTags. Same result as testing GetInstanceTags(), without building the container.
+     */
+    bool InstancePassesTagFilter(int32 InstanceIndex, const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& ExcludedTags) const;
+
+    /** Compact tag storage, populated while bCompactInstanceTags is on */
+    const FISMInstanceTagBits& GetCompactInstanceTags() const { return CompactInstanceTags; }
+
     /** Check if component has a tag */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Tags")
     bool HasTag(FGameplayTag Tag) const { return ISMComponentTags.HasTag(Tag); }
@@ -160,10 +300,7 @@ public:
     void GetOwnedGameplayTagsForInstance(FGameplayTagContainer& TagContainer, int32 InstanceIndex) const
     {
         TagContainer.AppendTags(ISMComponentTags);
-        if (const FGameplayTagContainer* InstanceTags = PerInstanceTags.Find(InstanceIndex))
-        {
-            TagContainer.AppendTags(*InstanceTags);
-        }
+        AppendPerInstanceTags(InstanceIndex, TagContainer);
     }
 
 #pragma endregion
@@ -176,9 +313,57 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
     virtual bool InitializeInstances();
 
+    /**
+     * Write this component's current runtime state into Target, e.g. in the editor after a
+     * Precompute PCG graph has applied. Cold state (pre-hide transforms, module data) is not baked.
+     * @return false if not initialized or the state does not fit the bake format
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
+    bool BakeState(UISMBakedInstanceState* Target) const;
+
+    /** Whether InitializeInstances started from BakedState */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
+    bool WasInitializedFromBakedState() const { return bInitializedFromBakedState; }
+
+    /**
+     * Write the runtime state a save game needs into OutData, in a compact versioned binary format:
+     * state flags as one bit plane per flag in use, instance tags as a dictionary plus a bitset per
+     * tagged instance, owner/possessor tags, and custom data as sparse deltas since initialization
+     * (bEnableCustomDataJournal) or in full. Transforms and cold state are not saved. Wakes a
+     * dormant component.
+     * @return false if not initialized
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Save")
+    bool SaveRuntimeState(TArray<uint8>& OutData);
+
+    /**
+     * Apply a SaveRuntimeState blob to this component, which must have the same instances (e.g. the
+     * same level, freshly initialized). Hides and shows go through one batched transform write,
+     * flags through BatchWriteInstanceStateFlags and tags through the batch tag calls, with one
+     * render state update. Destruction events and feedbacks are not replayed. Custom data saved as
+     * deltas needs bEnableCustomDataJournal here as well as on the saving component, and only
+     * applies while this component's journal shows no writes since initialization beyond the
+     * slots the blob sets; a played component needs a full save. Every stored size is checked
+     * against the instances and the data before anything is allocated for it.
+     * @return false (and changes nothing) if the data is malformed, does not match the instances, or
+     * holds custom data deltas this component cannot reach the saved state from
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Save")
+    bool LoadRuntimeState(const TArray<uint8>& Data);
+
 
     bool IsValidInstanceIndex(int32 InstanceIndex) const;
 
+    /**
+     * Translate an instance index from before InitializeInstances to its current index.
+     * Identity unless bMortonOrderInstances reordered the instances.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
+    int32 GetRemappedInitialIndex(int32 OriginalIndex) const;
+
+    /** Original index -> current index table built by the Morton reorder (empty if none ran) */
+    const TArray<int32>& GetInitialIndexRemap() const { return InitialIndexRemap; }
+
 
     /**
      * Hide an instance without destroying it.
@@ -198,6 +383,43 @@ public:
     virtual void ShowInstance(int32 InstanceIndex, bool bUpdateBounds = false, 
         bool bTriggerFeedbacks = true, const UActorComponent* InstigatorComponent = nullptr);
 
+    /**
+     * Show many hidden instances at once.
+     * Native listeners get one batch event and a single batched OnShow feedback is raised.
+     * @param InstanceIndices Instances to show; ones that are not hidden are skipped
+     * @param bUpdateBounds Whether to expand bounds to include the shown instances (O(1) each)
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
+    void BatchShowInstances(const TArray<int32>& InstanceIndices, bool bUpdateBounds = false,
+        bool bTriggerFeedbacks = true, const UActorComponent* InstigatorComponent = nullptr);
+
+    /**
+     * Hide many instances at once.
+     * Native listeners get one batch event and a single batched OnHide feedback is raised. With
+     * VisibilityCustomDataSlot the whole call is one custom data upload.
+     * @param InstanceIndices Instances to hide; ones already hidden are skipped
+     * @param bUpdateBounds Whether to recalculate bounds once after hiding (expensive O(n) operation)
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
+    void BatchHideInstances(const TArray<int32>& InstanceIndices, bool bUpdateBounds = false,
+        bool bTriggerFeedbacks = true, const UActorComponent* InstigatorComponent = nullptr);
+
+    /**
+     * Custom data slot the material reads as "instance hidden": 0 visible (the default value), 1 hidden.
+     * When set, HideInstance and ShowInstance write this slot instead of scaling the transform to
+     * zero, so instances keep their transforms and a batch hide/show is one custom data upload
+     * instead of a transform rewrite per instance. The material has to act on it (masked opacity,
+     * or WPO collapsing the instance). Hidden instances therefore keep their collision and still
+     * block traces and physics; DestroyInstance writes the slot and also scales to zero, so
+     * destroyed instances lose their collision. INDEX_NONE, or a slot past the component's custom
+     * data count, keeps zero-scale hiding.
+     */
+    UPROPERTY(EditAnywhere, Category = "ISM Runtime|Custom Data")
+    int32 VisibilityCustomDataSlot = INDEX_NONE;
+
+    /** Hide and show go through VisibilityCustomDataSlot */
+    bool UsesCustomDataVisibility() const;
+
 
     
             /**
@@ -212,6 +434,33 @@ public:
                 bool bUpdateSpatialIndex = true, bool bUpdateBounds = false, 
                 bool bTriggerFeedbacks = true, const UActorComponent* InstigatorComponent = nullptr);
         
+            /**
+             * Update many instance transforms at once.
+             * Same per-instance result as UpdateInstanceTransform, but consecutive indices are written
+             * with one batched ISM call and render state is marked dirty once. AABBs are refreshed in
+             * one pass, the spatial index in one FISMSpatialIndex::ApplyMoves call, component bounds
+             * recalculated at most once, and a single batched OnTransformUpdate feedback is raised.
+             * @param InstanceIndices Instances to update (each at most once); sort them to get longer runs
+             * @param NewTransforms New transforms, parallel to InstanceIndices
+             * @param bUpdateBounds Whether to recalculate bounds (expensive O(n) operation, default false)
+             */
+            void BatchUpdateInstanceTransforms(TArrayView<const int32> InstanceIndices, TArrayView<const FTransform> NewTransforms,
+                bool bUpdateBounds = false, bool bTriggerFeedbacks = true, const UActorComponent* InstigatorComponent = nullptr);
+
+            /**
+             * Bring many converted instances back from their actors at once.
+             * Per instance this does what FISMInstanceHandle::ReturnToISM does to the ISM side - DMI
+             * release, conversion tags and state cleared, instance shown - but the final transforms
+             * are written through one BatchUpdateInstanceTransforms instead of a transform update and
+             * a show each. The actors are left alone, and OnReleaseConvertedActor and
+             * OnInstanceReturnedToISM are not fired: the caller owns the actors and its bookkeeping.
+             * @param Handles Converted instances of this component (others are skipped)
+             * @param FinalTransforms Transforms to return at, parallel to Handles
+             * @return Number of instances returned
+             */
+            int32 ReturnConvertedInstances(TArrayView<const FISMInstanceHandle> Handles, TArrayView<const FTransform> FinalTransforms,
+                bool bTriggerFeedbacks = true, const UActorComponent* InstigatorComponent = nullptr);
+
           /**
             * Destroy an instance (hides it and marks as destroyed, but index remains valid).
             * @param InstanceIndex The instance to destroy
@@ -268,6 +517,21 @@ public:
         UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
         int32 AddInstanceWithCustomData(const FTransform& Transform, const TArray<float>& CustomData, bool bUpdateBounds = true);
 
+        /**
+         * Append a large generated set (e.g. a PCG spawn) in one pass.
+         * Unlike BatchAddInstances this never reuses destroyed slots, so the new instances are
+         * consecutive: the ISM takes all transforms in one AddInstances, custom data is copied as one
+         * block, the spatial index takes a single bulk insert, and listeners get one
+         * OnBatchInstancesAddedNative and one OnInstancesChangedBatchNative instead of per-instance
+         * native events. No spawn feedbacks are triggered.
+         * @param Transforms World transforms for the new instances
+         * @param CustomData Optional, CustomDataStride floats per instance; slots beyond the ISM's are dropped, missing ones stay 0
+         * @param bUpdateBounds Whether to expand bounds to include the new instances
+         * @return Indices of the new instances (consecutive), empty if failed
+         */
+        TArray<int32> BulkAppendInstances(const TArray<FTransform>& Transforms, TConstArrayView<float> CustomData = {},
+            int32 CustomDataStride = 0, bool bUpdateBounds = true);
+
 
 
 
@@ -287,6 +551,10 @@ public:
         /** Get number of active instances (excludes destroyed) */
         UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
         int32 GetActiveInstanceCount() const;
+
+        /** Get number of instances with a state flag set. O(1), counts are kept incrementally. */
+        UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
+        int32 GetInstanceCountInState(EISMInstanceState State) const;
     
         // ===== Transform Access =====
     
@@ -320,32 +588,217 @@ public:
 #pragma region SPATIAL_QUERIES
 public:
     
-    /** Find instances within radius of a location */
+    /** Find instances within radius of a location (exact pivot-distance test, no false positives) */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
     TArray<int32> GetInstancesInRadius(const FVector& Location, float Radius, bool bIncludeDestroyed = false) const;
 
-    /** Find instances within a box */
+    /** Find instances whose pivot lies within a box (exact test, no false positives) */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
     TArray<int32> GetInstancesInBox(const FBox& Box, bool bIncludeDestroyed = false) const;
 
+    /**
+     * Native forms of GetInstancesInRadius / GetInstancesInBox that append to a caller-owned array.
+     * OutIndices is not cleared, so one buffer can be reused across frames and components.
+     */
+    void GetInstancesInRadius(const FVector& Location, float Radius, TArray<int32>& OutIndices, bool bIncludeDestroyed = false) const;
+    void GetInstancesInBox(const FBox& Box, TArray<int32>& OutIndices, bool bIncludeDestroyed = false) const;
+
+    /**
+     * Visit instances within radius without materializing a result array.
+     * Visitor returns false to stop. Must not add or remove instances on this component.
+     * @return false if the visitor stopped early
+     */
+    bool ForEachInstanceInRadius(const FVector& Location, float Radius, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed = false) const;
+
+    /** Visitor form of GetInstancesInBox (see ForEachInstanceInRadius) */
+    bool ForEachInstanceInBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed = false) const;
+
+    /**
+     * ForEachInstanceInRadius limited to instances whose effective compact tag mask has every bit of
+     * RequiredTagMask (bits from GetCompactInstanceTags, e.g. FISMTagFilterMasks::Required). Spatial
+     * cells holding no instance with those tags are skipped during the walk. Without
+     * bCompactInstanceTags the mask is ignored and every instance in range is visited.
+     */
+    bool ForEachInstanceInRadiusWithTags(const FVector& Location, float Radius, const FISMTagMask& RequiredTagMask, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed = false) const;
+
+    /** Box form of ForEachInstanceInRadiusWithTags */
+    bool ForEachInstanceInBoxWithTags(const FBox& Box, const FISMTagMask& RequiredTagMask, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed = false) const;
+
+    /**
+     * Many radius queries in one pass over the spatial index (see FISMSpatialIndex::ForEachInstanceInRadiusBatch).
+     * Visitor receives (query index, instance index); order within one query is unspecified.
+     */
+    void ForEachInstanceInRadiusBatch(TConstArrayView<FISMSpatialSphereQuery> Queries, TFunctionRef<void(int32, int32)> Visitor, bool bIncludeDestroyed = false) const;
+
     /** Find the nearest instance to a location */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
     int32 GetNearestInstance(const FVector& Location, float MaxDistance = -1.0f, bool bIncludeDestroyed = false) const;
 
+    /** Find up to Count instances nearest to a location, nearest first */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    TArray<int32> GetNearestInstances(const FVector& Location, int32 Count, float MaxDistance = -1.0f, bool bIncludeDestroyed = false) const;
+
+    /**
+     * k-nearest-neighbour query with a caller-supplied filter (see FISMSpatialIndex::FindKNearest).
+     * Used by the subsystem to merge results across components.
+     */
+    void FindNearestInstances(const FVector& Location, int32 Count, float MaxDistance,
+        TFunctionRef<bool(int32)> Filter, TArray<FISMSpatialNeighbor>& OutNeighbors) const;
+
+    /**
+     * Trace a segment through this component's spatial grid, no physics query involved.
+     * Hits are instance AABBs (see FISMSpatialIndex::QueryRay), sorted along the ray.
+     * @param Radius Sweep radius (0 = line trace)
+     * @param bFirstHitOnly Return at most the first hit, stopping the grid walk early
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    TArray<int32> TraceInstances(const FVector& Start, const FVector& End, float Radius = 0.0f, bool bFirstHitOnly = false, bool bIncludeDestroyed = false) const;
+
+    /** TraceInstances with a caller-supplied filter and hit distances. Used by the subsystem. */
+    void TraceInstances(const FVector& Start, const FVector& End, float Radius, bool bFirstHitOnly,
+        TFunctionRef<bool(int32)> Filter, TArray<FISMSpatialRayHit>& OutHits) const;
+
+    /** TraceInstances with a narrow phase that can reject hits or push them along the ray (see FISMSpatialIndex::QueryRayRefined) */
+    void TraceInstancesRefined(const FVector& Start, const FVector& End, float Radius, bool bFirstHitOnly,
+        TFunctionRef<bool(int32, float&)> Refine, TArray<FISMSpatialRayHit>& OutHits) const;
+
+    /**
+     * Ray test against an instance's local bounds (the data asset's, else the mesh's) under its full
+     * transform - an oriented box, so tighter than the world AABB for rotated instances.
+     * Radius inflates the box like TraceInstances.
+     * @param Dir Unit ray direction
+     * @param OutDistance Entry distance along Dir; 0 if Start is inside
+     * @param OutNormal World normal of the entered face; -Dir if Start is inside
+     * @return false on a miss, beyond MaxDistance, or when no local bounds are available
+     */
+    bool IntersectInstanceOrientedBounds(int32 InstanceIndex, const FVector& Start, const FVector& Dir, float MaxDistance, float Radius,
+        float& OutDistance, FVector& OutNormal) const;
+
+    /** Read-only access to the live spatial index (game thread) */
+    const FISMSpatialIndex& GetSpatialIndex() const { return SpatialIndex; }
+
+    /** Turn spatial query telemetry on or off at runtime (see bSpatialQueryTelemetry) */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    void SetSpatialQueryTelemetryEnabled(bool bEnabled);
+
+    /** Zero the recorded spatial query telemetry, e.g. after changing SpatialIndexCellSize */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    void ResetSpatialQueryTelemetry();
+
+    /** Cell occupancy plus, with telemetry on, query statistics and a recommended SpatialIndexCellSize */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    FISMSpatialIndexHealth GetSpatialIndexHealth() const;
+
+    /** Heap memory held by this component's instance data, tags, handles and spatial index */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    FISMComponentMemoryStats GetMemoryStats() const;
+
+    /** Operation totals and per-second rates, plus the most mutated instances when sampling (see bSampleHotInstances) */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    FISMComponentOpStats GetOpStats(int32 MaxHotInstances = 8) const;
+
+    /** Turn hot instance sampling on or off at runtime; turning it off drops the samples */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    void SetHotInstanceSampling(bool bEnabled);
+
+    /** Zero the operation counters and hot instance samples */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    void ResetOpCounters();
+
+    /** GetMemoryStats().TotalBytes */
+    SIZE_T GetAllocatedSize() const;
+
+    /**
+     * Changes whenever a filtered query on this component could answer differently: spatial index
+     * edits, state flag changes, destruction and tag changes. Incremental queries (sphere
+     * subscriptions) compare it to skip the full re-query when only the query shape moved.
+     */
+    uint64 GetQueryRevision() const { return SpatialIndex.GetRevision() + InstanceQueryRevision; }
+
+    /** Release spatial index memory left behind by instance churn (see FISMSpatialIndex::Shrink) */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    void ShrinkSpatialIndex() { SpatialIndex.Shrink(); }
+
+    /**
+     * Latest published spatial index snapshot. Safe to call from any thread.
+     * Null until the first PublishSpatialIndexSnapshot. Positions lag the live index by up to a frame.
+     */
+    FISMSpatialIndexSnapshot GetSpatialIndexSnapshot() const;
+
+    /**
+     * Copy the live index into a new snapshot if it changed since the last publish.
+     * Game thread only; called by the subsystem each frame when bPublishSpatialIndexSnapshot is set.
+     */
+    void PublishSpatialIndexSnapshot();
+
     /** Query instances with advanced filter */
     TArray<int32> QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter) const;
 
+    /**
+     * QueryInstances appending to OutIndices. MaxResults counts appended entries; sorting covers only them.
+     * With bSortByDistance, MaxResults keeps the nearest passing instances.
+     */
+    void QueryInstances(const FVector& Location, float Radius, const FISMQueryFilter& Filter, TArray<int32>& OutIndices) const;
+
+    /** As above with a filter compiled once by the caller (FISMQueryFilter::Compile) */
+    void QueryInstances(const FVector& Location, float Radius, const FISMCompiledQueryFilter& Filter, TArray<int32>& OutIndices) const;
+
     // ===== State Management (IISMStateProvider) =====
 
     virtual uint8 GetInstanceStateFlags(int32 InstanceIndex) const override;
     virtual bool IsInstanceInState(int32 InstanceIndex, EISMInstanceState State) const override;
-    virtual const FISMInstanceState* GetInstanceState(int32 InstanceIndex) const override;
+    virtual bool HasInstanceState(int32 InstanceIndex) const override;
+    virtual bool GetInstanceState(int32 InstanceIndex, FISMInstanceState& OutState) const override;
+    virtual void GetStateFlags(TConstArrayView<int32> InstanceIndices, TArrayView<uint8> OutFlags) const override;
+    virtual TConstArrayView<uint8> GetStateFlagsRaw() const override { return InstanceStates.GetFlagsView(); }
     
     ///Sets the instance state FLAG, but DOES NOT actually apply hide/show/destroy changes.  use HideInstance,ShowInstance,DestroyInstance instead 
     virtual void SetInstanceState(int32 InstanceIndex, EISMInstanceState State, bool bValue) override;
+
+    /**
+     * Apply many flag writes with one flag-byte write per instance. Writes apply in order, so
+     * repeats on an instance compose; instances without state are skipped. Cell bounds only move
+     * on active transitions and the broadphase syncs once. Instances whose flags changed get one
+     * OnInstanceStateChanged each and one OnBatchInstanceStatesChangedNative for the whole call.
+     * Like SetInstanceState this only sets flags - it does not hide, show or destroy.
+     */
+    void BatchWriteInstanceStateFlags(TConstArrayView<FISMStateFlagsWrite> Writes);
     
-    /** Get mutable instance state (non-const version) */
-    FISMInstanceState* GetInstanceStateMutable(int32 InstanceIndex);
+    /** Dense per-instance state arrays, for bulk flag and bounds scans */
+    const FISMInstanceStateStore& GetInstanceStateStore() const { return InstanceStates; }
+
+    // ===== Module Data Columns =====
+
+    /**
+     * Register a per-instance data column for module state (damage, collection progress, ...).
+     * T must be trivially copyable. Every instance slot gets DefaultValue, including slots added
+     * or recycled later. Calling again with the same name and type returns the existing column.
+     * The returned view is invalidated when instances are added.
+     */
+    template<typename T>
+    TArrayView<T> RegisterInstanceColumn(FName ColumnName, const T& DefaultValue = T())
+    {
+        InstanceColumns.SetNumSlots(FMath::Max(InstanceColumns.GetNumSlots(), InstanceStates.Num()));
+        return InstanceColumns.Register<T>(ColumnName, DefaultValue);
+    }
+
+    /** Dense view of a registered column indexed by instance; empty if not registered as T */
+    template<typename T>
+    TArrayView<T> GetInstanceColumn(FName ColumnName) { return InstanceColumns.Get<T>(ColumnName); }
+
+    template<typename T>
+    TArrayView<const T> GetInstanceColumn(FName ColumnName) const { return InstanceColumns.Get<T>(ColumnName); }
+
+    /** Pointer to one instance's value in a column, or nullptr */
+    template<typename T>
+    T* GetInstanceColumnValue(FName ColumnName, int32 InstanceIndex)
+    {
+        TArrayView<T> Column = InstanceColumns.Get<T>(ColumnName);
+        return Column.IsValidIndex(InstanceIndex) ? &Column[InstanceIndex] : nullptr;
+    }
+
+    /** The column registry, for batch snapshots and tooling */
+    const FISMInstanceDataColumns& GetInstanceColumns() const { return InstanceColumns; }
     
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
     const FISMInstanceState GetInstanceStateConst(int32 InstanceIndex) const;
@@ -373,6 +826,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|AABB")
     TArray<int32> GetInstancesOverlappingInstance(int32 InstanceIndex, bool bIncludeDestroyed = false) const;
 
+    // Native forms of the AABB queries appending to a caller-owned array (not cleared).
+    void GetInstancesOverlappingBox(const FBox& Box, TArray<int32>& OutIndices, bool bIncludeDestroyed = false) const;
+    void GetInstancesOverlappingSphere(const FVector& Center, float Radius, TArray<int32>& OutIndices, bool bIncludeDestroyed = false) const;
+    void GetInstancesOverlappingInstance(int32 InstanceIndex, TArray<int32>& OutIndices, bool bIncludeDestroyed = false) const;
+
+    // Visitor forms of the AABB queries. Visitor returns false to stop; returns false if stopped.
+    bool ForEachInstanceOverlappingBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed = false) const;
+    bool ForEachInstanceOverlappingSphere(const FVector& Center, float Radius, TFunctionRef<bool(int32)> Visitor, bool bIncludeDestroyed = false) const;
+
     // Check if two specific instances overlap each other.
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|AABB")
     bool DoInstancesOverlap(int32 IndexA, int32 IndexB) const;
@@ -408,6 +870,47 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
     bool IsInstanceConverted(int32 InstanceIndex) const;
 
+    /** Reuse count of an instance slot; see FISMInstanceHandle::Generation */
+    uint32 GetInstanceGeneration(int32 InstanceIndex) const { return InstanceStates.GetGeneration(InstanceIndex); }
+
+    /**
+     * Structural generation of one spatial-index cell, for dropping stale batch results. It
+     * changes when a slot that a snapshot of the cell may list is recycled, so an index in an
+     * older result could now name a different instance. Destroying an instance does not change
+     * it - results already skip destroyed indices. Values come from one per-component counter
+     * and never repeat; cells untouched by a change keep their generation.
+     */
+    uint32 GetCellStructureGeneration(const FIntVector& Cell) const;
+
+    /** Generation of the whole component; changes with every cell generation */
+    uint32 GetStructureGeneration() const { return StructureGeneration; }
+
+    /** Every instance that is neither destroyed nor converted, in index order. Scans the dense flag array. */
+    void GetBatchableInstanceIndices(TArray<int32>& OutIndices) const;
+
+    /**
+     * Start per-field change tracking if it is off and return a cursor: HasInstanceChangedSince is
+     * true for the instances whose Fields change after this call. Tracking costs a stamp per
+     * instance and field once on, and nothing before. Cursor 0 precedes every change.
+     */
+    uint32 CaptureChangeCursor() { return ChangeTracker.CaptureCursor(); }
+
+    /** True for every instance while tracking is off */
+    bool HasInstanceChangedSince(int32 InstanceIndex, EISMSnapshotField Fields, uint32 Cursor) const;
+
+    bool IsChangeTrackingEnabled() const { return ChangeTracker.IsEnabled(); }
+
+    /** Record a change made behind the component's back, e.g. straight to the managed ISM */
+    void MarkInstanceChanged(int32 InstanceIndex, EISMSnapshotField Fields);
+
+    /**
+     * Slot-level (instance, slot, value) record of custom data writes, for saves, replication and
+     * export that want deltas since a watermark instead of a diff of all custom data. Off unless
+     * bEnableCustomDataJournal is set or the journal is enabled directly.
+     */
+    const FISMCustomDataJournal& GetCustomDataJournal() const { return CustomDataJournal; }
+    FISMCustomDataJournal& GetCustomDataJournal() { return CustomDataJournal; }
+
 #pragma endregion
     
     // ===== Custom Data =====
@@ -427,6 +930,68 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Custom Data")
     void SetCustomDataCount(int32 DesiredCount, bool bResetExisting = false, float DefaultValue = 1.0);
 
+    /** Custom data floats per instance on the managed ISM */
+    int32 GetNumCustomDataFloats() const;
+
+    /** Read-only view of one instance's custom data in the ISM's own storage. Empty if the instance has none. */
+    TConstArrayView<float> GetInstanceCustomDataView(int32 InstanceIndex) const;
+
+    /**
+     * Copy slots [FirstSlot, FirstSlot + NumSlots) of each listed instance into OutValues, row per
+     * instance: OutValues[Row * NumSlots + Slot]. Slots the instance does not have read as 0.
+     * @return false if OutValues does not hold InstanceIndices.Num() * NumSlots floats.
+     */
+    bool ReadInstanceCustomData(TConstArrayView<int32> InstanceIndices, int32 FirstSlot, int32 NumSlots, TArrayView<float> OutValues) const;
+
+    /** ReadInstanceCustomData for the contiguous instances [FirstInstance, FirstInstance + NumInstances) */
+    bool ReadInstanceCustomDataRange(int32 FirstInstance, int32 NumInstances, int32 FirstSlot, int32 NumSlots, TArrayView<float> OutValues) const;
+
+    /**
+     * Write a row-per-instance block laid out as in ReadInstanceCustomData. Slots past the ISM's
+     * custom data count are ignored. The render state is marked dirty once for the whole block.
+     * @return false if Values does not hold InstanceIndices.Num() * NumSlots floats.
+     */
+    bool WriteInstanceCustomData(TConstArrayView<int32> InstanceIndices, int32 FirstSlot, int32 NumSlots,
+        TConstArrayView<float> Values, bool bMarkRenderStateDirty = true);
+
+    /** WriteInstanceCustomData for the contiguous instances [FirstInstance, FirstInstance + NumInstances) */
+    bool WriteInstanceCustomDataRange(int32 FirstInstance, int32 NumInstances, int32 FirstSlot, int32 NumSlots,
+        TConstArrayView<float> Values, bool bMarkRenderStateDirty = true);
+
+    /** Write Values into slots starting at FirstSlot of one instance. @return true if any slot was written. */
+    bool WriteInstanceCustomDataRow(int32 InstanceIndex, int32 FirstSlot, TConstArrayView<float> Values, bool bMarkRenderStateDirty = true);
+
+    /**
+     * Write one custom data slot for the contiguous instances [FirstInstance, FirstInstance + Values.Num()),
+     * e.g. a snow or burn mask for a whole field. Instances past the end are ignored.
+     *
+     * Ranges up to PartialCustomDataUploadFraction of the component go through the ISM's
+     * per-instance path, which the renderer uploads incrementally. Larger ones are written in
+     * place with one strided pass and pushed with a single full upload.
+     * @return number of instances written
+     */
+    int32 WriteCustomDataSlot(int32 Slot, TConstArrayView<float> Values, int32 FirstInstance = 0, bool bMarkRenderStateDirty = true);
+
+    /** Set one custom data slot to Value on every instance (always a full upload) */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Custom Data")
+    int32 FillCustomDataSlot(int32 Slot, float Value, bool bMarkRenderStateDirty = true);
+
+    /** Push custom data written with bMarkRenderStateDirty = false to the renderer */
+    void MarkCustomDataDirty();
+
+    /**
+     * PICD schema for this component's instances: InstanceData's SchemaName, else the project
+     * default. Resolved once (at InitializeInstances) instead of by name on every conversion.
+     * Null if InstanceData opts out of PICD conversion or nothing resolves.
+     */
+    const FISMCustomDataSchema* GetCustomDataSchema(FName* OutSchemaName = nullptr) const;
+
+    /** GetCustomDataSchema() flattened for allocation-free gathers. Empty without a schema. */
+    const FISMCustomDataGatherTable& GetCustomDataGatherTable() const;
+
+    /** Drop the resolved schema so the next query resolves it again (InstanceData or schema table changed) */
+    void InvalidateCustomDataSchema() { bCustomDataSchemaResolved = false; }
+
     // ===== Events =====
 #pragma region EVENTS
 
@@ -450,8 +1015,19 @@ public:
     FOnBatchInstancesAddedNative OnBatchInstancesAddedNative;
     FOnInstanceAddedNative OnInstanceAddedNative;
     FOnInstanceStateChangedNative OnInstanceStateChangedNative;
+    FOnBatchInstanceStatesChangedNative OnBatchInstanceStatesChangedNative;
     FOnInstanceDestroyedNative OnInstanceDestroyedNative;
 
+    /**
+     * One event per batch call (BatchWriteInstanceStateFlags, BatchDestroyInstances) listing each
+     * instance whose state, tags or destruction changed, sorted and distinct. Inside a batch call the
+     * per-instance native state/destroyed/tag events do not fire; the Blueprint events still do.
+     */
+    FOnInstancesChangedBatchNative OnInstancesChangedBatchNative;
+
+    /** Per event kind, once per FlushInstanceEvents; only fires with bCoalesceInstanceEvents */
+    FOnInstanceEventsFlushedNative OnInstanceEventsFlushedNative;
+
 
     /** Called when releasing a converted actor back to ISM (allows pooling) */
     FOnReleaseConvertedActor OnReleaseConvertedActor;
@@ -477,6 +1053,23 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "ISM Runtime|Events")
 	FOnInstanceReleased OnInstanceReleased;
 
+    /**
+     * Defer the state, destroyed, tag, owner, possession and attachment events: each change only sets
+     * the instance's bit for its event kind, and FlushInstanceEvents reports every kind once - through
+     * OnInstanceEventsFlushedNative, OnBatchInstanceStatesChangedNative and OnInstancesChangedBatchNative
+     * with the instance spans, and per instance to the native owner/possession/attachment and bound
+     * Blueprint events. An instance changed many times in a frame is reported once, with the state it
+     * ended up in. The subsystem flushes at the end of its tick and the batch scheduler after applying
+     * results; queries, change cursors and tag masks do not wait for the flush.
+     */
+    UPROPERTY(EditAnywhere, Category = "ISM Runtime|Events")
+    bool bCoalesceInstanceEvents = false;
+
+    /** Report the events deferred by bCoalesceInstanceEvents now. Events raised by listeners wait for the next flush. */
+    void FlushInstanceEvents();
+
+    bool HasPendingInstanceEvents() const { return PendingInstanceEventKinds != 0; }
+
 #pragma endregion
 
 
@@ -489,6 +1082,89 @@ public:
     UPROPERTY(EditAnywhere, Category = "ISM Runtime|Performance", meta=(EditCondition="bEnableTickOptimization"))
     float TickInterval = 0.0f; // 0 = every frame
 
+    /**
+     * Ticked by UISMRuntimeSubsystem instead of a tick function of its own: only while it has work,
+     * batched with the other managed components and after the world's tick groups. Also on for every
+     * component when UISMRuntimeSettings::bManagedComponentTick is set.
+     */
+    UPROPERTY(EditAnywhere, Category = "ISM Runtime|Performance")
+    bool bUseManagedTick = false;
+
+    bool UsesManagedTick() const;
+
+    /**
+     * BeginPlay queues initialization in UISMRuntimeSubsystem instead of building every instance at
+     * once: the subsystem builds ranges of instances over the next frames within its frame budget.
+     * Initialized ranges are queryable at once (IsInstanceInitialized); RequestRuntimeComponent callbacks
+     * wait for the last range. Also on for every component when UISMRuntimeSettings::bTimeSlicedComponentInit
+     * is set. Baked components initialize at once.
+     */
+    UPROPERTY(EditAnywhere, Category = "ISM Runtime|Performance")
+    bool bTimeSlicedInit = false;
+
+    bool UsesTimeSlicedInit() const;
+
+    /**
+     * Set at initialization from UISMRuntimeSettings::HeadlessMode (dedicated servers by default).
+     * A headless component keeps the whole authoritative state - flags, tags, spatial index, AABBs,
+     * and the ISM's transforms and custom data for queries, collision and conversions - but never
+     * invalidates the ISM's render state, applies material overrides, prewarms DMIs or routes feedback.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    bool IsHeadless() const { return bHeadless; }
+
+    /**
+     * Let UISMRuntimeSubsystem put the component to sleep while no player is within DormancyDistance
+     * (see EnterDormancy), so memory and CPU follow the play area rather than the world size
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance")
+    bool bAllowDormancy = false;
+
+    /** Viewer distance beyond which the component goes dormant. 0 = UISMRuntimeSettings::DefaultDormancyDistance. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Performance", meta = (EditCondition = "bAllowDormancy", ClampMin = "0.0", Units = "cm"))
+    float DormancyDistance = 0.0f;
+
+    float GetEffectiveDormancyDistance() const;
+
+    /**
+     * Compact the runtime state: keep the state flags, generations and cold tables that differ from a
+     * fresh instance (FISMInstanceStateDelta), drop the AABBs, spatial index, cell bounds and handles,
+     * leave the subsystem's broadphase and stop the runtime tick. The ISM and its transforms stay untouched.
+     * While dormant, queries and state reads see no instances; mutations wake the component first.
+     * @return false if not initialized, already dormant, batch locked or holding converted instances
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    bool EnterDormancy();
+
+    /** Rebuild the state dropped by EnterDormancy from the ISM and the kept delta. @return false if not dormant */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    bool WakeFromDormancy();
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    bool IsDormant() const { return bIsDormant; }
+
+    /** Bounds the subsystem measures viewer distance to; kept from before EnterDormancy while dormant */
+    FBox GetDormancyBounds() const { return bIsDormant ? DormantBounds : CachedInstanceBounds; }
+
+    /**
+     * Start or stop the runtime tick (TickRuntime). Goes to the component tick function, or to the
+     * subsystem in managed tick mode; use these rather than SetComponentTickEnabled/Interval.
+     */
+    void SetRuntimeTickEnabled(bool bEnabled);
+    void SetRuntimeTickInterval(float Interval);
+    bool IsRuntimeTickEnabled() const;
+
+    /** Per-frame work of the component, from either tick path. Subclasses override this rather than TickComponent. */
+    virtual void TickRuntime(float DeltaTime) {}
+
+    /**
+     * Part of the managed tick that may run off the game thread, in parallel across components, before
+     * this frame's TickRuntime. Only touch this component's own data. Opt in with HasParallelRuntimeTick;
+     * in component tick mode it runs inline.
+     */
+    virtual void TickRuntimeParallel(float DeltaTime) {}
+    virtual bool HasParallelRuntimeTick() const { return false; }
+
 
     // ===== Redirectors =====
 
@@ -502,6 +1178,18 @@ public:
     // ===== Accessors =====
 	bool IsISMInitialized() const { return bIsInitialized; }
 
+    /** Time-sliced initialization in progress; see bTimeSlicedInit */
+    bool IsISMInitializing() const { return bInitializing; }
+
+    /** Fully initialized, or partially with its initialized ranges indexed */
+    bool IsISMQueryable() const { return bIsInitialized || bInitializing; }
+
+    /** Instances with state and in the spatial index: all of them once initialized, the built ranges before */
+    int32 GetNumInitializedInstances() const { return bInitializing ? NumInitializedInstances : (bIsInitialized ? GetInstanceCount() : 0); }
+
+    /** Whether InstanceIndex has been built yet; ranges complete from index 0 up */
+    bool IsInstanceInitialized(int32 InstanceIndex) const;
+
 
     void SetInstanceDataAsset(UISMInstanceDataAsset* NewDataAsset)
     {
@@ -553,9 +1241,103 @@ protected:
 /** Spatial index for fast queries */
     FISMSpatialIndex SpatialIndex;
 
-    /** Per-instance state (sparse map - only active instances) */
-    UPROPERTY()
-    TMap<int32, FISMInstanceState> InstanceStates;
+    /** Last published read-only copy of SpatialIndex (swapped under SnapshotLock) */
+    FISMSpatialIndexSnapshot SpatialIndexSnapshot;
+
+    /** Revision of SpatialIndex captured in SpatialIndexSnapshot */
+    uint64 SnapshotRevision = 0;
+
+    /** Non-spatial half of GetQueryRevision, bumped by the state/destruction/tag broadcasts */
+    uint64 InstanceQueryRevision = 0;
+
+    /** Per-operation counts for GetOpStats; mutable so const queries count too */
+    mutable FISMComponentOpCounters OpCounters;
+
+    /** Per-cell values behind GetCellStructureGeneration; cells absent here are at the floor */
+    TMap<FIntVector, uint32> CellStructureGenerations;
+
+    /** Last value handed out to any cell */
+    uint32 StructureGeneration = 0;
+
+    /** Generation every cell is at least at; raised when all cells change together */
+    uint32 StructureGenerationFloor = 0;
+
+    /**
+     * Slots whose instance has changed cell since the slot was last filled. An older snapshot of
+     * another cell may list them, so recycling one changes every cell instead of just its own.
+     */
+    TBitArray<> CellCrossedSlots;
+
+    /** Slot recycle: new generation for the cells it leaves and enters */
+    void BumpCellStructureGeneration(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation);
+
+    /** New generation for every cell, e.g. after the spatial index is rebuilt or cleared */
+    void BumpAllCellStructureGenerations();
+
+    /** Remember that InstanceIndex left its cell, if the move crosses a cell boundary */
+    void NoteCellCrossing(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation);
+
+    /** Per-field change stamps behind CaptureChangeCursor */
+    FISMInstanceChangeTracker ChangeTracker;
+
+    FISMCustomDataJournal CustomDataJournal;
+
+    /** Journal watermark as of InitializeInstances; SaveRuntimeState writes custom data deltas since it */
+    uint32 CustomDataSaveWatermark = 0;
+
+    /** Open batch calls; while non-zero the per-instance native events collect into NativeBatchInstances */
+    int32 NativeBatchDepth = 0;
+
+    /** Instances reported by the next OnInstancesChangedBatchNative */
+    TArray<int32> NativeBatchInstances;
+
+    /** Visibility written inside a batch call; EndNativeBatch uploads the custom data once */
+    bool bVisibilityUploadPending = false;
+
+    /** See IsHeadless */
+    bool bHeadless = false;
+
+    /** Write VisibilityCustomDataSlot of InstanceIndex; the upload waits for the outermost EndNativeBatch */
+    void WriteInstanceVisibility(int32 InstanceIndex, bool bVisible);
+
+    /** Start collecting per-instance native events (nests) */
+    void BeginNativeBatch();
+
+    /** Close a BeginNativeBatch; the outermost one uploads pending visibility and broadcasts OnInstancesChangedBatchNative */
+    void EndNativeBatch();
+
+    /** Per event kind: instances with an event waiting for FlushInstanceEvents */
+    TBitArray<> PendingInstanceEvents[static_cast<int32>(EISMInstanceEvent::Num)];
+
+    /** Bit per EISMInstanceEvent with pending instances */
+    uint8 PendingInstanceEventKinds = 0;
+
+    /** Coalescing: record Event for InstanceIndex and queue the flush. False if events fire immediately. */
+    bool DeferInstanceEvent(EISMInstanceEvent Event, int32 InstanceIndex);
+
+    /** Per-instance native event, or a batch entry while a batch call is open */
+    template <typename DelegateType>
+    void BroadcastNativeOrBatch(DelegateType& Delegate, int32 InstanceIndex)
+    {
+        if (NativeBatchDepth > 0)
+        {
+            NativeBatchInstances.Add(InstanceIndex);
+            return;
+        }
+        Delegate.Broadcast(this, InstanceIndex);
+    }
+
+    /** Guards the SpatialIndexSnapshot pointer swap - not the index contents */
+    mutable FRWLock SnapshotLock;
+
+    /** Per-instance state, dense SoA indexed by instance index */
+    FISMInstanceStateStore InstanceStates;
+
+    /** Module-registered per-instance columns, kept at InstanceStates' slot count */
+    FISMInstanceDataColumns InstanceColumns;
+
+    /** Per-instance tags while bCompactInstanceTags is on */
+    FISMInstanceTagBits CompactInstanceTags;
 
     /** Cached subsystem reference */
     TWeakObjectPtr<class UISMRuntimeSubsystem> CachedSubsystem;
@@ -563,11 +1345,92 @@ protected:
     /** Whether this component has been initialized */
     bool bIsInitialized = false;
 
+    /** Time-sliced initialization: instances [0, NumInitializedInstances) of InitInstanceCount are built */
+    bool bInitializing = false;
+    int32 InitInstanceCount = 0;
+    int32 NumInitializedInstances = 0;
+
+    /** Dormancy: what InstanceStates kept, the bounds to measure viewers against and whether to restart the tick */
+    bool bIsDormant = false;
+    bool bTickBeforeDormancy = false;
+    FISMInstanceStateDelta DormantState;
+    FBox DormantBounds = FBox(ForceInit);
+
+    /** Mutation entry points call this so a dormant component rehydrates on demand */
+    void WakeIfDormant()
+    {
+        if (bIsDormant)
+        {
+            WakeFromDormancy();
+        }
+    }
+
     /** Time accumulator for tick interval */
     float TimeSinceLastTick = 0.0f;
 
-    /** Map of instance index to handle (for tracking conversions) */
-    TMap<int32, FISMInstanceHandle> InstanceHandles;
+    /** Managed tick mode: slot in the subsystem's tick list, INDEX_NONE while not ticking */
+    int32 ManagedTickIndex = INDEX_NONE;
+
+    /** Position in the subsystem's registered component list, INDEX_NONE while unregistered */
+    int32 RegisteredComponentIndex = INDEX_NONE;
+    float ManagedTickInterval = 0.0f;
+    friend class UISMRuntimeSubsystem;
+
+    /** Seconds between managed ticks: the runtime tick interval, or TickInterval if longer */
+    float GetManagedTickInterval() const;
+
+    /** Stored handles by instance index, with the converted ones listed (for tracking conversions) */
+    FISMInstanceHandleTable InstanceHandles;
+
+    /** What GetOrCreateHandle returns for negative indices */
+    FISMInstanceHandle InvalidHandle;
+
+    /** Original index -> current index after the init-time Morton reorder (empty = identity) */
+    TArray<int32> InitialIndexRemap;
+
+    bool bInitializedFromBakedState = false;
+
+    /**
+     * InitializeInstances body for a compatible BakedState: instances, state, tags, spatial index and AABBs
+     * @return whether the baked cell bounds were adopted (otherwise they are rebuilt from the instances)
+     */
+    bool InitializeFromBakedState();
+
+    /**
+     * InitializeInstances body without a bake: reads PerInstanceSMData directly, computes locations,
+     * cells and AABBs in a ParallelFor, then fills state, spatial index and CellBounds in one pass each.
+     * The caller publishes CellBounds.
+     * With RestoreState (waking from dormancy) the store is rebuilt from that delta instead, module
+     * columns are kept and CellBounds covers only the active instances.
+     */
+    void InitializeInstancesFromComponent(FISMInstanceStateDelta* RestoreState = nullptr);
+
+    /** InitializeInstances up to building the instances. With InitQueue, queues time-sliced initialization there. */
+    bool StartInitialization(class UISMRuntimeSubsystem* InitQueue);
+
+    /** InitializeInstances after the instances are built: tag masks, bounds, registration, subclass notification */
+    bool CompleteInitialization(bool bCellBoundsBuilt);
+
+    /** Empty state, index and CellBounds for StepInitialization to fill range by range */
+    void BeginInstanceRanges();
+
+    /**
+     * Build the next MaxInstances instances of a time-sliced initialization, and complete it after the last range.
+     * @return true when nothing is left to build
+     */
+    bool StepInitialization(int32 MaxInstances);
+
+    /** Local AABB that instance world bounds are built from; invalid when the component records none */
+    FBox GetInitLocalBounds() const;
+
+    /** Sort the managed ISM's instances (transforms + custom data) by Morton code. Fills InitialIndexRemap. */
+    void ApplyMortonOrder();
+
+    /** Destroyed slot AddInstance may reuse, or INDEX_NONE */
+    int32 FindRecyclableInstanceSlot() const;
+
+    /** Reset a destroyed slot to a fresh instance at Transform */
+    void RecycleInstanceSlot(int32 InstanceIndex, const FTransform& Transform);
 #pragma endregion
 
 
@@ -577,10 +1440,22 @@ protected:
     /** Get effective tags for an instance (component + per-instance) */
     FGameplayTagContainer GetEffectiveTagsForInstance(int32 InstanceIndex) const;
 
+    /** Append only the instance-specific tags, from whichever storage is active */
+    void AppendPerInstanceTags(int32 InstanceIndex, FGameplayTagContainer& OutTags) const;
+
+    /** Move compact tags into PerInstanceTags and turn bCompactInstanceTags off */
+    void MigrateCompactTagsToContainers();
+
+    /** Hand every instance's compact tag mask to the spatial index, e.g. after it was rebuilt */
+    void SyncSpatialTagMasks();
+
     void BroadcastBatchedInstancesAdded(const TArray<int32>& Instances);
     void BroadcastInstanceAdded(int32 InstanceIndex);
     /** Broadcast state change event */
     void BroadcastStateChange(int32 InstanceIndex);
+
+    /** Broadcast state change events for a set of distinct instances */
+    void BroadcastBatchedStateChange(const TArray<int32>& Instances);
     
     /** Broadcast destruction event */
     void BroadcastDestruction(int32 InstanceIndex);
@@ -594,6 +1469,13 @@ protected:
         void BroadcastPossessionChange(int32 InstanceIndex);
         void BroadcastAttachmentChange(int32 InstanceIndex);
         void BroadcastInstanceReleased(int32 InstanceIndex);
+
+        /**
+         * A handle (stored or a copy) converted to ConvertedActor, or returned when null. Keeps the
+         * stored handle and the converted list in step so IsInstanceConverted and
+         * GetConvertedInstances see conversions made through copies.
+         */
+        void NotifyHandleConversionChanged(int32 InstanceIndex, AActor* ConvertedActor, int32 ActivationCount = -1);
     
 
     /** Get or create a handle for an instance */
@@ -618,6 +1500,18 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Bounds")
     void RecalculateInstanceBounds();
 
+    /**
+     * Bring bounds up to date after removals and moves.
+     * Bounds are kept per spatial cell; only cells that lost a boundary instance are rescanned,
+     * then the union is re-taken. O(instances in dirty cells + cells) - cheap when nothing changed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Bounds")
+    void RefreshInstanceBounds();
+
+    /** Bounds of all active instances, padded by BoundsPadding. Only meaningful while IsBoundsValid(). */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Bounds")
+    FBox GetInstanceBounds() const { return CachedInstanceBounds; }
+
     /**
      * Incrementally expand bounds to include a new location.
      * O(1) operation - safe to call frequently.
@@ -636,6 +1530,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Bounds")
     bool IsBoundsValid() const { return bBoundsValid; }
 
+    /**
+     * Conservative world box for the subsystem broadphase: every active instance's AABB.
+     * Independent of bUpdateBounds. Invalid box when there are no active instances.
+     * @return false if the component cannot bound its instances (not initialized, or oversized
+     *         instances present) and must be visited by every world query
+     */
+    bool GetBroadphaseBounds(FBox& OutBounds) const;
+
 protected:
     /** Cached bounds of all active instances */
     UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime|Bounds")
@@ -644,13 +1546,25 @@ protected:
     /** Whether cached bounds are currently valid */
     bool bBoundsValid = false;
 
+    /** Unpadded per-cell bounds of active instances; CachedInstanceBounds is their padded union */
+    FISMCellBoundsCache CellBounds;
+
+    /** Copy CellBounds' union into CachedInstanceBounds / bBoundsValid */
+    void PublishCellBounds();
+
+    /** Tell the subsystem broadphase when GetBroadphaseBounds changed since it was last reported */
+    void SyncBroadphaseBounds();
+
+    FBox ReportedBroadphaseBounds = FBox(ForceInit);
+    bool bReportedBroadphaseUnbounded = false;
+
     /** Padding to add to bounds (accounts for instance size/scale) */
     UPROPERTY(EditAnywhere, Category = "ISM Runtime|Performance", meta = (ClampMin = "0.0"))
     float BoundsPadding = 100.0f;
 
     /**
      * Check if a location is on the edge of the bounds.
-     * Used to determine if removing an instance requires full bounds recalculation.
+     * Instance removal no longer needs this; CellBounds tracks which cells can shrink.
      */
     bool IsLocationOnBoundsEdge(const FVector& Location, float Tolerance = 10.0f) const;
 #pragma endregion
@@ -660,9 +1574,9 @@ protected:
     
 public:
     /**
-     * Whether this component is currently held by an open batch mutation handle.
-     * While locked, destroyed instance slots are not recycled - their indices are
-     * reserved until the handle is released.
+     * Whether destroyed instance slots are currently reserved. While locked they are not
+     * recycled. The batch schedulers do not take it - in-flight results are checked against
+     * GetCellStructureGeneration instead - but callers holding indices across frames can.
      */
     bool IsBatchLocked() const { return bBatchLocked; }
 	bool SetBatchLocked(bool bLocked) 
@@ -673,6 +1587,14 @@ public:
 private:
     bool bBatchLocked = false;
 
+    void ResolveCustomDataSchema() const;
+
+    /** Points into the schema table owned by UISMRuntimeDeveloperSettings */
+    mutable const FISMCustomDataSchema* CustomDataSchema = nullptr;
+    mutable FName CustomDataSchemaName;
+    mutable FISMCustomDataGatherTable CustomDataGatherTable;
+    mutable bool bCustomDataSchemaResolved = false;
+
 
 
 
@@ -725,6 +1647,9 @@ protected:
         void TriggerFeedbackOnTransformUpdateInternal(int InstanceIndex, const UActorComponent* Instigator);
         void TriggerFeedbackBatchedOnSpawnInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator);
         void TriggerFeedbackBatchedOnDestroyInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator);
+        void TriggerFeedbackBatchedOnShowInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator);
+        void TriggerFeedbackBatchedOnHideInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator);
+        void TriggerFeedbackBatchedOnTransformUpdateInternal(TArray<int> InstanceIndexes, const UActorComponent* Instigator);
 
         void TriggerFeedbackInternal(TFunctionRef<FGameplayTag(const FISMFeedbackTags&)> SelectTag, int InstanceIndex, const UActorComponent* Instigator);
         void TriggerFeedbackBatchedInternal(TFunctionRef<FGameplayTag(const FISMFeedbackTags&)> SelectTag, TArray<int> InstanceIndexes, const UActorComponent* Instigator);
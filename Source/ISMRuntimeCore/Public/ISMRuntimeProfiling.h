@@ -0,0 +1,52 @@
+// ISMRuntimeProfiling.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Profiling shared by every ISMRuntime module. Timing scopes go on the ISMRuntime trace channel
+// (-trace=cpu,ISMRuntime, or "Trace.Enable ISMRuntime" at runtime) so a capture can focus on the
+// plugin; the cycle and counter stats below show under "stat ISMRuntime" and in Insights with the
+// stats channel. Counters reset every frame. Defined in ISMRuntimeCore.cpp.
+
+UE_TRACE_CHANNEL_EXTERN(ISMRuntimeChannel, ISMRUNTIMECORE_API);
+
+/** CPU timing scope on the ISMRuntime channel; free while the channel is off */
+#define ISM_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, ISMRuntimeChannel)
+
+DECLARE_STATS_GROUP(TEXT("ISM Runtime"), STATGROUP_ISMRuntime, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Query"), STAT_ISMSpatialQuery, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add Instances"), STAT_ISMAddInstances, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Destroy Instance"), STAT_ISMDestroyInstance, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Snapshot"), STAT_ISMBuildSnapshot, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Mutation Result"), STAT_ISMApplyMutationResult, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DMI Acquire"), STAT_ISMAcquireDMI, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Feedback Routing"), STAT_ISMFeedbackRouting, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Instance Conversion"), STAT_ISMConversion, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Instances Added"), STAT_ISMInstancesAdded, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Instances Destroyed"), STAT_ISMInstancesDestroyed, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Results"), STAT_ISMQueryResults, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Snapshot Instances"), STAT_ISMSnapshotInstances, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Snapshot Bytes"), STAT_ISMSnapshotBytes, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Mutations Applied"), STAT_ISMMutationsApplied, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("DMIs Created"), STAT_ISMDMIsCreated, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Feedbacks Routed"), STAT_ISMFeedbacksRouted, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Instances Converted"), STAT_ISMInstancesConverted, STATGROUP_ISMRuntime, ISMRUNTIMECORE_API);
+
+// Allocation tracking. Hot paths open an LLM_SCOPE_BYTAG next to their cycle stat so allocations made
+// inside them are charged to the subsystem, as ISMRuntime/<Area> under the ISMRuntime parent (other
+// modules add ISMRuntime/<Module>). Opt in with -llm for "stat LLMFULL" and "memreport -llm", or
+// -trace=memory,memtag for Memory Insights; the scopes cost nothing otherwise and compile out of
+// shipping builds.
+
+LLM_DECLARE_TAG_API(ISMRuntime, ISMRUNTIMECORE_API);
+LLM_DECLARE_TAG_API(ISMRuntime_Query, ISMRUNTIMECORE_API);
+LLM_DECLARE_TAG_API(ISMRuntime_Instances, ISMRUNTIMECORE_API);
+LLM_DECLARE_TAG_API(ISMRuntime_Batch, ISMRUNTIMECORE_API);
+LLM_DECLARE_TAG_API(ISMRuntime_CustomData, ISMRUNTIMECORE_API);
+LLM_DECLARE_TAG_API(ISMRuntime_Feedback, ISMRUNTIMECORE_API);
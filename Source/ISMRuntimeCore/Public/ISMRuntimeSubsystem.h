@@ -3,16 +3,29 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
 #include "ISMInstanceHandle.h"
 #include "ISMQueryFilter.h"
+#include "ISMCompiledQueryFilter.h"
 #include "CollisionQueryParams.h"
+#include "WorldCollision.h"
 #include "ISMTraceResult.h"
+#include "ISMComponentBroadphase.h"
+#include "ISMComponentTagIndex.h"
+#include "ISMInstanceRegistry.h"
+#include "ISMInstanceCommandQueue.h"
+#include "ISMSpatialIndexHealth.h"
+#include "ISMMemoryStats.h"
+#include "ISMFrameBudget.h"
+#include "Settings/ISMPerformanceProfile.h"
 #include "ISMRuntimeSubsystem.generated.h"
 
 // Forward declarations
 class UISMRuntimeComponent;
 class UISMBatchSchedulerBase;
 
+/** Appends memory entries for systems living outside ISMRuntimeCore (see UISMRuntimeSubsystem::OnGatherMemoryStats) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGatherISMMemoryStats, TArray<FISMMemoryStatEntry>&);
 
 
 
@@ -39,6 +52,34 @@ struct FISMRuntimeStats
     
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
     float LastFrameProcessingTimeMs = 0.0f;
+
+    /** Heap memory held by all components' spatial indices, in bytes */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 SpatialIndexMemoryBytes = 0;
+
+    /** Number of allocated spatial index cells across all components */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 SpatialIndexCellCount = 0;
+
+    /** Heap memory held by all components' per-instance state arrays and module columns, in bytes */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 InstanceStateMemoryBytes = 0;
+
+    /** Spatial index health of each component recording query telemetry (bSpatialQueryTelemetry) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    TArray<FISMSpatialIndexHealth> SpatialIndexHealth;
+
+    /** Sum of ComponentMemory and SystemMemory, in bytes */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 TotalMemoryBytes = 0;
+
+    /** Heap memory of each registered component, largest first */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    TArray<FISMComponentMemoryStats> ComponentMemory;
+
+    /** Subsystem structures, batch scheduler, instance indexes, DMI pools and module-reported systems such as actor pools */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    TArray<FISMMemoryStatEntry> SystemMemory;
 };
 
 
@@ -70,6 +111,79 @@ struct FISMComponentMapping
     TArray<UPrimitiveComponent*> CollisionProxies;
 };
 
+/** One radius query of a SubmitQueryBatch call */
+USTRUCT(BlueprintType)
+struct FISMQueryDescriptor
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Query")
+    FVector Center = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Query", meta = (ClampMin = "0.0"))
+    float Radius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Runtime|Query")
+    FISMQueryFilter Filter;
+};
+
+/**
+ * Results table of a SubmitQueryBatch call.
+ * Results holds every query's hits back to back; query i owns [Offsets[i], Offsets[i + 1]).
+ */
+USTRUCT(BlueprintType)
+struct FISMQueryBatchResults
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime|Query")
+    TArray<FISMInstanceHandle> Results;
+
+    /** Num() + 1 entries, or empty for an empty batch */
+    UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime|Query")
+    TArray<int32> Offsets;
+
+    /** Number of queries in the batch */
+    int32 Num() const { return FMath::Max(Offsets.Num() - 1, 0); }
+
+    TConstArrayView<FISMInstanceHandle> GetQueryResults(int32 QueryIdx) const
+    {
+        if (!Offsets.IsValidIndex(QueryIdx + 1) || QueryIdx < 0)
+        {
+            return TConstArrayView<FISMInstanceHandle>();
+        }
+        return TConstArrayView<FISMInstanceHandle>(Results.GetData() + Offsets[QueryIdx], Offsets[QueryIdx + 1] - Offsets[QueryIdx]);
+    }
+
+    void Reset()
+    {
+        Results.Reset();
+        Offsets.Reset();
+    }
+};
+
+/** Instances that entered or left a sphere subscription since its previous update */
+USTRUCT(BlueprintType)
+struct FISMSphereSubscriptionDelta
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime|Query")
+    TArray<FISMInstanceHandle> Entered;
+
+    /** References as they were on entry - the instance may since have been destroyed or reused */
+    UPROPERTY(BlueprintReadOnly, Category = "ISM Runtime|Query")
+    TArray<FISMInstanceHandle> Exited;
+
+    bool IsEmpty() const { return Entered.IsEmpty() && Exited.IsEmpty(); }
+
+    void Reset()
+    {
+        Entered.Reset();
+        Exited.Reset();
+    }
+};
+
 
 
 /**
@@ -116,12 +230,31 @@ public:
     
     /** Unregister a runtime component from this subsystem */
     void UnregisterRuntimeComponent(UISMRuntimeComponent* Component);
+
+    /** Re-read a registered component's broadphase bounds before the next world query */
+    void MarkComponentBoundsDirty(const UISMRuntimeComponent* Component);
+
+    // ===== Managed Tick =====
+
+    /**
+     * Tick Component from this subsystem until unregistered, every GetManagedTickInterval seconds.
+     * Called through UISMRuntimeComponent::SetRuntimeTickEnabled in managed tick mode.
+     */
+    void RegisterManagedTick(UISMRuntimeComponent* Component);
+    void UnregisterManagedTick(UISMRuntimeComponent* Component);
+    int32 GetNumManagedTicks() const { return ManagedTicks.Num(); }
     
     /** Get all registered components */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
-    TArray<UISMRuntimeComponent*> GetAllComponents() const;
+    TArray<UISMRuntimeComponent*> GetAllComponents() const { return TArray<UISMRuntimeComponent*>(GetLiveComponents()); }
+
+    /**
+     * Registered components without a copy or weak pointer resolves. Rebuilt only when a component
+     * registers or unregisters, or after garbage collection; do not hold the view across either.
+     */
+    TConstArrayView<UISMRuntimeComponent*> GetLiveComponents() const;
     
-    /** Get components with specific tag */
+    /** Get components carrying Tag or one of its children */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime")
     TArray<UISMRuntimeComponent*> GetComponentsWithTag(FGameplayTag Tag) const;
     
@@ -136,6 +269,34 @@ public:
      * Safe to call before or after ISMRuntimeActor::BeginPlay.
      */
     void RequestRuntimeComponent(UInstancedStaticMeshComponent* ISM,TFunction<void(UISMRuntimeComponent*)> Callback);
+
+    // ===== Time-Sliced Initialization =====
+
+    /** Build Component's instances in ranges over the next ticks (UISMRuntimeComponent::bTimeSlicedInit) */
+    void QueueComponentInitialization(UISMRuntimeComponent* Component);
+
+    /** Finish every queued initialization now, e.g. before a save or a load screen ends */
+    void FlushComponentInitialization();
+
+    int32 GetNumQueuedInitializations() const { return InitQueue.Num(); }
+
+    // ===== Coalesced Events =====
+
+    /** Flush Component's deferred instance events at the end of this tick (UISMRuntimeComponent::bCoalesceInstanceEvents) */
+    void QueueInstanceEventFlush(UISMRuntimeComponent* Component);
+
+    // ===== Dormancy =====
+
+    /**
+     * Put components with bAllowDormancy and no view location within their dormancy distance to sleep,
+     * and wake dormant ones a view location has come back near. Tick runs this every
+     * DormancyCheckInterval with the player view points; without any view location nothing changes.
+     * @return false if the frame budget ran out before every component was visited
+     */
+    bool UpdateComponentDormancy(TConstArrayView<FVector> ViewLocations);
+
+    /** Registered components currently dormant. O(components). */
+    int32 GetNumDormantComponents() const;
     
     // ===== Global Queries =====
     
@@ -159,6 +320,18 @@ public:
         const FISMQueryFilter& Filter,
         float MaxDistance = -1.0f) const;
 
+    /**
+     * Find up to Count instances nearest to a location across all components, nearest first.
+     * Each component runs a ring-expanding k-NN bounded by the current global K-th distance,
+     * so later components stop almost immediately once the result set is tight.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    TArray<FISMInstanceHandle> FindNearestInstances(
+        const FVector& Location,
+        int32 Count,
+        const FISMQueryFilter& Filter,
+        float MaxDistance = -1.0f) const;
+
 
     /** Find all instances across all components whose AABB overlaps the given box */
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
@@ -172,8 +345,126 @@ public:
         const FISMInstanceHandle& Handle,
         const FISMQueryFilter& Filter) const;
     
+    /**
+     * Native forms of the global queries that append to a caller-owned array (not cleared).
+     * MaxResults counts appended entries; bSortByDistance sorts only those. With both set, the
+     * radius query appends the MaxResults nearest passing instances.
+     */
+    void QueryInstancesInRadius(const FVector& Location, float Radius, const FISMQueryFilter& Filter, TArray<FISMInstanceHandle>& OutResults) const;
+    void QueryInstancesInBox(const FBox& Box, const FISMQueryFilter& Filter, TArray<FISMInstanceHandle>& OutResults) const;
+    void QueryInstancesOverlappingBox(const FBox& Box, const FISMQueryFilter& Filter, TArray<FISMInstanceHandle>& OutResults) const;
+
+    /**
+     * Visit filtered instances across all components without materializing results.
+     * MaxResults is honored, bSortByDistance is ignored. Visitor returns false to stop and
+     * must not add or remove instances or components.
+     * @return false if the visitor stopped early
+     */
+    bool ForEachInstanceInRadius(const FVector& Location, float Radius, const FISMQueryFilter& Filter,
+        TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const;
+    bool ForEachInstanceInBox(const FBox& Box, const FISMQueryFilter& Filter,
+        TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const;
+    bool ForEachInstanceOverlappingBox(const FBox& Box, const FISMQueryFilter& Filter,
+        TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const;
+
+    /**
+     * Forms taking a filter compiled once by the caller (FISMQueryFilter::Compile), for callers
+     * that run the same filter every frame.
+     */
+    void QueryInstancesInRadius(const FVector& Location, float Radius, const FISMCompiledQueryFilter& Filter, TArray<FISMInstanceHandle>& OutResults) const;
+    void QueryInstancesInBox(const FBox& Box, const FISMCompiledQueryFilter& Filter, TArray<FISMInstanceHandle>& OutResults) const;
+    bool ForEachInstanceInRadius(const FVector& Location, float Radius, const FISMCompiledQueryFilter& Filter,
+        TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const;
+    bool ForEachInstanceInBox(const FBox& Box, const FISMCompiledQueryFilter& Filter,
+        TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const;
+
+    /**
+     * Run many radius queries at once. Queries are grouped by the components they touch, and each
+     * component walks its spatial cells once for its whole group (see
+     * UISMRuntimeComponent::ForEachInstanceInRadiusBatch). Per query, results match
+     * QueryInstancesInRadius as a set and honor MaxResults and bSortByDistance; without
+     * bSortByDistance the order within a query is unspecified.
+     * @param bAllowParallel Fan component groups out to worker threads when there are enough of them
+     */
+    void SubmitQueryBatch(TConstArrayView<FISMQueryDescriptor> Queries, FISMQueryBatchResults& OutResults, bool bAllowParallel = false) const;
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query", meta = (DisplayName = "Submit Query Batch"))
+    FISMQueryBatchResults SubmitQueryBatch(const TArray<FISMQueryDescriptor>& Queries, bool bAllowParallel = false) const;
+
+    /**
+     * Deferred form of SubmitQueryBatch. The batch runs during the next subsystem tick, after that
+     * frame's batched mutations have been applied, with component groups fanned out to worker
+     * threads; OnComplete is then called on the game thread.
+     */
+    void SubmitQueryBatchDeferred(TArray<FISMQueryDescriptor> Queries, TFunction<void(const FISMQueryBatchResults&)> OnComplete);
+
+    // ===== Sphere Subscriptions =====
+
+    /**
+     * Register a persistent radius query for a moving sphere. Nothing is reported until the first
+     * UpdateSphereSubscription, which reports every matching instance as entered.
+     * Filter is compiled and kept; MaxResults and bSortByDistance do not apply.
+     * @return Subscription id, never INDEX_NONE
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    int32 SubscribeSphere(const FVector& Center, float Radius, const FISMQueryFilter& Filter);
+
+    /**
+     * Move a subscription and report which instances entered or left it.
+     * While a component's GetQueryRevision is unchanged only the shell between the old and new
+     * sphere is tested (FISMSpatialIndex::ForEachInstanceRadiusDelta), so a stationary or slowly
+     * moving subscription costs little however dense the instances are. A component whose
+     * instances changed is re-queried in full, once. CustomFilter results are cached per instance
+     * until then.
+     * @return false for an unknown id
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    bool UpdateSphereSubscription(int32 SubscriptionId, const FVector& Center, float Radius, FISMSphereSubscriptionDelta& OutDelta);
+
+    /** Drop a subscription. Its current members are not reported as exited. */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    void UnsubscribeSphere(int32 SubscriptionId);
+
+    /** Current members of a subscription, as of its last update */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Query")
+    void GetSphereSubscriptionInstances(int32 SubscriptionId, TArray<FISMInstanceHandle>& OutInstances) const;
+
     /** Find component that owns a specific instance */
     UISMRuntimeComponent* FindComponentForInstance(const FISMInstanceReference& Instance) const;
+
+    /**
+     * Plain (unregistered) reference to one instance, carrying its current generation. Build query
+     * results and targets through this so they stay valid after bRecycleDestroyedInstances reuses a slot.
+     */
+    static FISMInstanceHandle MakeInstanceReference(UISMRuntimeComponent* Comp, int32 Index);
+
+    // ===== Global Instance IDs =====
+
+    /**
+     * Registry giving every registered component a dense slot, so instances have packed
+     * FISMGlobalInstanceIds: integer keys for cross-system maps and a compact wire format.
+     */
+    const FISMInstanceRegistry& GetInstanceRegistry() const { return InstanceRegistry; }
+
+    /** Global ID of a handle's instance; invalid if its component is not registered */
+    FISMGlobalInstanceId GetGlobalInstanceId(const FISMInstanceHandle& Handle) const { return InstanceRegistry.MakeId(Handle); }
+
+    /** Handle at the instance's current generation, or invalid once its component unregistered */
+    FISMInstanceHandle ResolveGlobalInstanceId(FISMGlobalInstanceId Id) const { return InstanceRegistry.ResolveHandle(Id); }
+
+    // ===== Off-Game-Thread Commands =====
+
+    /**
+     * Queue an instance mutation from any thread, without locking or allocating. Commands apply at
+     * the start of the next Tick, grouped per component through the batched paths: one
+     * BatchWriteInstanceStateFlags, one custom data push and one BatchDestroyInstances per component.
+     * Name instances with GetGlobalInstanceId on the game thread and hand the IDs to the worker;
+     * commands whose component unregistered, or whose Generation no longer matches, are dropped.
+     */
+    void EnqueueInstanceCommand(const FISMInstanceCommand& Command);
+
+    /** Apply the queued commands now. Game thread only. Returns how many applied. */
+    int32 FlushInstanceCommands();
     
     // ===== Statistics =====
     
@@ -183,18 +474,70 @@ public:
     
     /** Refresh statistics (called automatically each frame) */
     void UpdateStatistics();
+
+    /**
+     * Broadcast by UpdateStatistics so modules that own memory outside the components can report
+     * it into FISMRuntimeStats::SystemMemory. Bind from the module's world subsystem.
+     */
+    FOnGatherISMMemoryStats OnGatherMemoryStats;
+
+    /** Log the memory roll-up with its per-component breakdown (console: ISM.MemReport [MaxComponents]) */
+    void LogMemoryReport(int32 MaxComponents = 0) const;
+
+    /** Log each component's operation totals and rates, busiest first (console: ISM.OpReport [MaxComponents] [MaxHotInstances]) */
+    void LogOpReport(int32 MaxComponents = 0, int32 MaxHotInstances = 4) const;
+
+    // ===== Frame Budget =====
+
+    /** Shared per-frame time budget of the ISMRuntime systems in this world (see UISMRuntimeSettings) */
+    FISMFrameBudgetGovernor& GetFrameBudget() { return FrameBudget; }
+
+    // ===== Performance Profile =====
+
+    /**
+     * Reconfigure this world's frame budget and batch scheduler from a performance profile: what it
+     * overrides replaces the project settings and scheduler class defaults, the rest returns to them.
+     * Called at Initialize and whenever FISMPerformanceProfiles switches.
+     */
+    void ApplyPerformanceProfile(const FISMPerformanceProfileSettings& Profile);
+    const FISMFrameBudgetGovernor& GetFrameBudget() const { return FrameBudget; }
+
+    /** Demand has run over the frame budget for FrameBudgetOverloadFrames; a cue to shed optional gameplay load */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    bool IsFrameBudgetOverloaded() const { return FrameBudget.IsOverloaded(); }
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Performance")
+    FISMFrameBudgetStats GetFrameBudgetStats() const { return FrameBudget.GetStats(); }
     
 	UISMRuntimeComponent* FindComponentForISM(TWeakObjectPtr<UInstancedStaticMeshComponent> ISM) const;
 
 protected:
     // ===== Component Storage =====
     
-    /** All registered components */
+    /**
+     * All registered components, packed. Each component keeps its position in
+     * RegisteredComponentIndex, so registering checks membership and unregistering removes it
+     * in O(1); the last entry moves into the hole.
+     */
     UPROPERTY()
     TArray<TWeakObjectPtr<UISMRuntimeComponent>> AllComponents;
+
+    /** AllComponents resolved, behind GetLiveComponents */
+    mutable TArray<UISMRuntimeComponent*> LiveComponents;
+    mutable bool bLiveComponentsDirty = true;
+
+    /** Destroyed components leave their weak entries stale; drop them and the cached view */
+    void HandlePostGarbageCollect();
+    FDelegateHandle PostGarbageCollectHandle;
     
-    /** Components indexed by tag for fast lookup */
-    TMap<FGameplayTag, TArray<TWeakObjectPtr<UISMRuntimeComponent>>> ComponentsByTag;
+    /** Per-component tag bitmasks and tag posting lists, for query candidate selection */
+    FISMComponentTagIndex ComponentTagIndex;
+
+    /** Component slots behind FISMGlobalInstanceId */
+    FISMInstanceRegistry InstanceRegistry;
+
+    /** Grid over component bounds - spatial world queries only visit components it returns */
+    mutable FISMComponentBroadphase ComponentBroadphase;
     
     // Populated by RegisterRuntimeComponent - fast lookup for RequestRuntimeComponent
     TMap<TWeakObjectPtr<UInstancedStaticMeshComponent>, TWeakObjectPtr<UISMRuntimeComponent>> ISMToRuntimeComponentMap;
@@ -203,18 +546,123 @@ protected:
 
     /** Cached statistics */
     FISMRuntimeStats CachedStats;
+
+    /** Fill the SystemMemory entries of the stats, then let modules append theirs */
+    void GatherSystemMemoryStats(TArray<FISMMemoryStatEntry>& OutEntries) const;
+
+    struct FManagedTick
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+        double NextTickSeconds = 0.0;
+        double LastTickSeconds = 0.0;
+    };
+
+    /** Components in managed tick mode with work; each holds its slot in ManagedTickIndex */
+    TArray<FManagedTick> ManagedTicks;
+
+    /** Tick the due managed components in batches, parallel sections first, within the frame budget */
+    void TickManagedComponents();
+
+    /** Components waiting for or part way through time-sliced initialization, oldest first */
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> InitQueue;
+
+    /** Components with deferred instance events, flushed at the end of Tick */
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> EventFlushQueue;
+
+    /** Step the init queue within ComponentInitBudgetMs and the frame budget */
+    void TickComponentInitialization();
+
+    /** A queued component finished: make it findable by its ISM and run the callbacks waiting for it */
+    void NotifyComponentInitialized(UISMRuntimeComponent* Component);
+
+    /** Seconds until the next dormancy pass */
+    float DormancyCheckTimer = 0.0f;
+
+    /** Gather the player view points and run UpdateComponentDormancy every DormancyCheckInterval */
+    void TickComponentDormancy(float DeltaTime);
+
+    /** A component entered or left dormancy: take it out of or put it back into the broadphase */
+    void NotifyComponentDormancyChanged(UISMRuntimeComponent* Component);
+
+    FISMFrameBudgetGovernor FrameBudget;
+    FDelegateHandle WorldTickStartHandle;
+
+    FDelegateHandle PerformanceProfileHandle;
+    void HandlePerformanceProfileChanged(EISMPerformanceProfile Profile, const FISMPerformanceProfileSettings& ProfileSettings);
+
+    /** Opens each frame of FrameBudget; bound in Initialize since the subsystem only ticks while it has work */
+    void HandleWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
     
     /** Frame number when stats were last updated */
     uint32 StatsUpdateFrame = 0;
+
+    struct FPendingQueryBatch
+    {
+        TArray<FISMQueryDescriptor> Queries;
+        TFunction<void(const FISMQueryBatchResults&)> OnComplete;
+    };
+
+    /** Batches from SubmitQueryBatchDeferred, run on the next tick */
+    TArray<FPendingQueryBatch> PendingQueryBatches;
+
+    /** Members of one subscription within one component */
+    struct FSphereSubscriptionComponent
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+
+        /** Component query revision the members were last brought up to date against */
+        uint64 QueryRevision = 0;
+
+        /** Instance index -> generation on entry */
+        TMap<int32, int32> Members;
+    };
+
+    struct FSphereSubscription
+    {
+        FVector Center = FVector::ZeroVector;
+        float Radius = 0.0f;
+        FISMCompiledQueryFilter Filter;
+        TArray<FSphereSubscriptionComponent> Components;
+
+        /** Center/Radius have been evaluated at least once */
+        bool bPrimed = false;
+    };
+
+    TMap<int32, FSphereSubscription> SphereSubscriptions;
+    int32 NextSphereSubscriptionId = 0;
 	
     // ===== Helper Functions =====
     
     /** Clean up invalid component references */
     void CleanupInvalidComponents();
     
-    /** Rebuild tag index for a component */
+    /** Re-read a component's ISMComponentTags into the tag index */
     void RebuildTagIndexForComponent(UISMRuntimeComponent* Component);
 
+    /** Visit registered components passing Filter's component-level checks, using the tag index when it can */
+    bool ForEachQueryComponent(const FISMQueryFilter& Filter, TFunctionRef<bool(UISMRuntimeComponent*)> Visitor) const;
+
+    /** As above, limited to components whose broadphase bounds intersect QueryBounds */
+    bool ForEachQueryComponent(const FBox& QueryBounds, const FISMQueryFilter& Filter, TFunctionRef<bool(UISMRuntimeComponent*)> Visitor) const;
+
+    /**
+     * Shared body of the spatial instance queries. ComponentQuery runs one component's spatial lookup,
+     * streaming instance indices to its callback; it gets the component's binding so the lookup can
+     * prune by compact tag masks. MakeRef builds the reference handed to Visitor, for
+     * passing instances only. Components whose binding fails are skipped without a lookup.
+     * Serial by default; with bAllowParallel, lookups and filtering run on worker threads
+     * into per-thread buffers, then Visitor and MakeRef run here in candidate order.
+     * @param MaxResults Overrides the filter's limit (sorted queries collect everything first)
+     */
+    bool ForEachComponentInstance(const FBox& QueryBounds, const FISMCompiledQueryFilter& Filter, int32 MaxResults,
+        TFunctionRef<bool(UISMRuntimeComponent*, const FISMCompiledComponentFilter&, TFunctionRef<bool(int32)>)> ComponentQuery,
+        TFunctionRef<FISMInstanceHandle(UISMRuntimeComponent*, int32)> MakeRef,
+        TFunctionRef<bool(const FISMInstanceHandle&)> Visitor) const;
+
+    /** Whether a bAllowParallel query over NumItems components or hits should fan out */
+    static bool ShouldRunParallel(const FISMQueryFilter& Filter, int32 NumItems);
+    static bool ShouldRunParallel(bool bAllowParallel, int32 NumItems);
+
     /**
      * Called at the end of RegisterRuntimeComponent.
      * Checks PendingRuntimeComponentCallbacks for this ISM and fires any waiting callbacks.
@@ -251,8 +699,51 @@ protected:
     void UnregisterAllRedirectsForComponent(UPrimitiveComponent* PhysicsComponent);
 
     private:
+    /** Redirect targets for one proxy primitive */
+    struct FISMRedirectEntry
+    {
+        TWeakObjectPtr<UPrimitiveComponent> Source;
+        TArray<TWeakObjectPtr<UISMRuntimeComponent>> Targets;
+
+        /** Source's key at registration, to clear RedirectSlotByPrimitive after Source dies */
+        TObjectKey<UPrimitiveComponent> SourceKey;
+    };
+
     // Private — managed entirely through the register/unregister API
-    TMap<TWeakObjectPtr<UPrimitiveComponent>, TArray<TWeakObjectPtr<UISMRuntimeComponent>>> ComponentRedirectMap;
+    TSparseArray<FISMRedirectEntry> RedirectEntries;
+
+    /**
+     * Primitive -> RedirectEntries slot, sized to the registered redirects rather than the UObject
+     * index space. TObjectKey carries the object serial, so a recycled object index never finds a
+     * destroyed primitive's slot.
+     */
+    TMap<TObjectKey<UPrimitiveComponent>, int32> RedirectSlotByPrimitive;
+
+    /** Slots found stale on a hit - hits may resolve on workers, so the queue is locked */
+    struct FISMStaleRedirectQueue
+    {
+        FCriticalSection Lock;
+        TArray<int32> Slots;
+    };
+
+    // Heap-allocated for the same reason as FThreadedState in ISMBatchScheduler.h:
+    // a lock stored inline is corrupted by CDO construction
+    TUniquePtr<FISMStaleRedirectQueue> StaleRedirects;
+
+    /** Commands pushed by EnqueueInstanceCommand. Heap-allocated like StaleRedirects. */
+    TUniquePtr<FISMInstanceCommandQueue> InstanceCommands;
+
+    /** FlushInstanceCommands' drain buffer, kept between frames */
+    TArray<FISMInstanceCommand> DrainedInstanceCommands;
+
+    /** Live entry for a hit primitive, or null. Read-only apart from flagging stale slots - safe on workers. */
+    const FISMRedirectEntry* FindRedirectEntry(const UPrimitiveComponent* Primitive, int32& OutSlot) const;
+
+    /** Queue a slot for CleanupRedirectMap */
+    void MarkRedirectStale(int32 Slot) const;
+
+    /** Remove a slot and its ID table entry */
+    void RemoveRedirectSlot(int32 Slot);
 
 #pragma region ISM_AWARE_TRACES
                public:
@@ -308,6 +799,42 @@ protected:
                    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Trace")
                    bool SweepISM(const FVector& Start, const FVector& End, float Radius, ECollisionChannel TraceChannel, struct FISMTraceResult& OutResult, const FISMQueryFilter& Filter,
                        float RedirectSearchRadius) const;
+
+                   /**
+                    * Trace against ISM instances by walking each component's spatial grid - pure CPU, so it
+                    * works on ISMs with collision disabled (e.g. dedicated servers). No physics scene query
+                    * and no redirect lookup, so non-ISM geometry never blocks.
+                    * Results are sorted by distance and carry registered handles. PhysicsHit holds the trace,
+                    * location, time, Item and Component; normals are only meaningful with bTestOrientedBounds.
+                    * @param Radius Sweep radius (0 = line trace)
+                    * @param bFirstHitOnly Return only the nearest hit; later components stop at it
+                    * @param bTestOrientedBounds After the world AABB test, test the mesh bounds under the instance
+                    *                            transform - tighter for rotated instances, and yields face normals
+                    */
+                   UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Trace")
+                   bool GridTraceISM(const FVector& Start, const FVector& End, float Radius, TArray<FISMTraceResult>& OutResults,
+                       const FISMQueryFilter& Filter, bool bFirstHitOnly = true, bool bTestOrientedBounds = false) const;
+
+                   /**
+                    * Async LineTraceISM / LineTraceISMMulti on the world's async trace queue, so the physics
+                    * query overlaps the frame instead of stalling the caller. Hits are resolved on the game
+                    * thread when the result arrives - normally next frame - and OnComplete then receives them
+                    * sorted by instance distance (at most one for a single trace, none on a miss).
+                    * Filter is copied. OnComplete is dropped if the subsystem goes away first.
+                    * @param bMultiTrace Report every hit along the trace, as LineTraceISMMulti
+                    */
+                   FTraceHandle AsyncLineTraceISM(const FVector& Start, const FVector& End, ECollisionChannel TraceChannel,
+                       const FISMQueryFilter& Filter, float RedirectSearchRadius,
+                       TFunction<void(const TArray<FISMTraceResult>&)> OnComplete,
+                       bool bMultiTrace = false,
+                       const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+                   /** Async SweepISM - same delivery as AsyncLineTraceISM */
+                   FTraceHandle AsyncSweepISM(const FVector& Start, const FVector& End, float Radius, ECollisionChannel TraceChannel,
+                       const FISMQueryFilter& Filter, float RedirectSearchRadius,
+                       TFunction<void(const TArray<FISMTraceResult>&)> OnComplete,
+                       bool bMultiTrace = false,
+                       const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
                     
               protected:
                   
@@ -321,17 +848,47 @@ protected:
                       const FISMQueryFilter& Filter,
                       float RedirectSearchRadius) const;
 
+                  /**
+                   * Read-only part of ResolveHitToISMHandle, safe on worker threads.
+                   * Result.Handle is a plain reference; pass it to RegisterTraceHandle on the game thread.
+                   */
+                  FISMTraceResult ResolveHitCandidate(
+                      const FHitResult& Hit,
+                      const FISMQueryFilter& Filter,
+                      float RedirectSearchRadius) const;
+
+                  /** Swap a resolved plain reference for the component's registered handle */
+                  static void RegisterTraceHandle(FISMTraceResult& Result);
+
+                  /** Resolve physics hits to registered handles, keeping valid ones sorted by instance distance */
+                  void ResolveHitsSorted(
+                      const TArray<FHitResult>& Hits,
+                      const FISMQueryFilter& Filter,
+                      float RedirectSearchRadius,
+                      TArray<FISMTraceResult>& OutResults) const;
+
+                  /** FTraceDelegate target for the async traces; the request travels as delegate payload */
+                  void HandleAsyncTraceDone(
+                      const FTraceHandle& TraceHandle,
+                      FTraceDatum& TraceDatum,
+                      FISMQueryFilter Filter,
+                      float RedirectSearchRadius,
+                      TFunction<void(const TArray<FISMTraceResult>&)> OnComplete);
+
                   /**
                    * Resolve redirect: given a hit on a proxy component, find the nearest
                    * ISM instance within RedirectSearchRadius of the impact point.
                    */
                   FISMTraceResult ResolveRedirectHit(
                       const FHitResult& Hit,
-                      const TArray<TWeakObjectPtr<UISMRuntimeComponent>>& Candidates,
+                      int32 RedirectSlot,
                       const FISMQueryFilter& Filter,
                       float RedirectSearchRadius) const;
 
-                  /** Prune stale entries from ComponentRedirectMap and ISMToRuntimeMap */
+                  /**
+                   * Drop redirect slots that hits found stale - destroyed proxies, recycled object indices,
+                   * or destroyed targets. Only visits flagged slots; runs from Tick and the register API.
+                   */
                   void CleanupRedirectMap();
 
 
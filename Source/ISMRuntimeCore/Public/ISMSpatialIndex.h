@@ -2,12 +2,121 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ISMInstanceTagBits.h"
+
+#include <atomic>
+
+/**
+ * Backing storage layout for FISMSpatialIndex.
+ *
+ * Hashed: TMap of cell -> TArray. Cheap incremental add/remove, one allocation per cell.
+ * Flat:   Sorted cell keys with a single contiguous instance buffer (CSR offsets).
+ *         Queries walk memory linearly. Built by Rebuild(); incremental adds land in a
+ *         small hashed overlay and removes leave tombstones until the next compaction.
+ */
+enum class EISMSpatialIndexStorage : uint8
+{
+    Hashed,
+    Flat
+};
+
+/**
+ * One coarse resolution of a hierarchical FISMSpatialIndex.
+ * Holds every instance again at CellSize = base * LevelScale^Level, so large
+ * queries can touch a handful of big cells instead of thousands of small ones.
+ */
+struct FISMSpatialGridLevel
+{
+    /** Cell size of this level in world units */
+    float CellSize = 0.0f;
+
+    /** Cell coordinate -> instance indices (unordered) */
+    TMap<FIntVector, TArray<int32>> Cells;
+};
+
+/** One instance relocation for FISMSpatialIndex::ApplyMoves */
+struct FISMSpatialIndexMove
+{
+    /** Instance index being moved */
+    int32 InstanceIndex = INDEX_NONE;
+
+    /** Location the instance is currently indexed at */
+    FVector OldLocation = FVector::ZeroVector;
+
+    /** Location to index it at */
+    FVector NewLocation = FVector::ZeroVector;
+};
+
+/** One result of a k-nearest-neighbour query */
+struct FISMSpatialNeighbor
+{
+    /** Instance index within the owning index */
+    int32 InstanceIndex = INDEX_NONE;
+
+    /** Squared distance from the query location to the instance's stored position */
+    float DistanceSq = 0.0f;
+};
+
+/** One sphere of a batched radius query */
+struct FISMSpatialSphereQuery
+{
+    FVector Center = FVector::ZeroVector;
+    float Radius = 0.0f;
+};
+
+/** One result of a grid ray/sweep query */
+struct FISMSpatialRayHit
+{
+    /** Instance index within the owning index */
+    int32 InstanceIndex = INDEX_NONE;
+
+    /** Distance along the ray at which it enters the instance's (radius-inflated) AABB. 0 if Start is inside. */
+    float Distance = 0.0f;
+};
+
+/**
+ * Query counters of one spatial index (see FISMSpatialIndex::SetQueryTelemetryEnabled).
+ * Shared by the index and its copies, so snapshot queries on worker threads count too;
+ * updated with relaxed atomics.
+ */
+struct ISMRUNTIMECORE_API FISMSpatialQueryTelemetry
+{
+    /** Bucket B holds query radii in [MinBucketRadius * 2^B, MinBucketRadius * 2^(B+1)); both ends are open */
+    static constexpr int32 NumRadiusBuckets = 16;
+    static constexpr float MinBucketRadius = 64.0f;
+
+    std::atomic<uint64> NumQueries{ 0 };
+
+    /** Instance slots walked in the cells the queries touched */
+    std::atomic<uint64> NumCandidates{ 0 };
+
+    /** Candidates that passed the exact test */
+    std::atomic<uint64> NumHits{ 0 };
+
+    std::atomic<uint32> RadiusBuckets[NumRadiusBuckets] = {};
+
+    void Record(float Radius, int32 InNumCandidates, int32 InNumHits);
+    void Reset();
+
+    static int32 GetRadiusBucket(float Radius);
+
+    /** Median query radius, as the geometric center of its bucket; 0 with nothing recorded */
+    float GetMedianRadius() const;
+};
 
 /**
  * Simple spatial hash for fast instance queries.
  * Divides world into uniform grid cells and stores instance indices per cell.
  *
- * Thread Safety: NOT thread-safe. Assumes single-threaded access.
+ * Optionally hierarchical (SetHierarchyLevels): coarse grids above the base grid let
+ * queries of any radius touch a bounded number of cells.
+ * Optionally bounds-aware (SetInstanceBounds): overlap queries test recorded AABBs
+ * and pad only by the largest tracked reach, so callers never pad by mesh size.
+ *
+ * Thread Safety: Const queries may run concurrently on any number of threads, but
+ * never alongside a mutation. Off-thread readers should query an immutable snapshot
+ * (FISMSpatialIndexSnapshot, see UISMRuntimeComponent::GetSpatialIndexSnapshot)
+ * while the game thread keeps mutating the live index.
  * Performance: O(1) add/remove, O(k) query where k = instances in overlapping cells
  */
 class ISMRUNTIMECORE_API FISMSpatialIndex
@@ -18,7 +127,7 @@ public:
      * @param InCellSize Size of each grid cell in world units (default 1000cm = 10m)
      * Rule of thumb: Use 2x your typical query radius
      */
-    explicit FISMSpatialIndex(float InCellSize = 1000.0f);
+    explicit FISMSpatialIndex(float InCellSize = 1000.0f, EISMSpatialIndexStorage InStorage = EISMSpatialIndexStorage::Hashed);
 
     /**
      * Add an instance to the spatial index.
@@ -28,6 +137,16 @@ public:
      */
     void AddInstance(int32 InstanceIndex, const FVector& Location);
 
+    /**
+     * Add many instances at once, e.g. a bulk spawn.
+     * Sorts the batch by cell and appends each cell's run in one go; Flat storage folds it into the
+     * contiguous buffer with a single compaction once the overlay grows past its threshold.
+     * Time Complexity: O(k log k) for k new instances
+     * @param InstanceIndices Instances to add; must not already be in the index
+     * @param Locations World location of each, parallel to InstanceIndices
+     */
+    void AddInstances(TConstArrayView<int32> InstanceIndices, TConstArrayView<FVector> Locations);
+
     /**
      * Remove an instance from the spatial index.
      * Time Complexity: O(n) where n = instances in the cell (typically small)
@@ -46,6 +165,16 @@ public:
      */
     void UpdateInstance(int32 InstanceIndex, const FVector& OldLocation, const FVector& NewLocation);
 
+    /**
+     * Apply many UpdateInstance calls at once.
+     * Cell changes are grouped by source and destination cell so each touched cell array
+     * is rewritten in a single pass, instead of one linear search per moved instance.
+     * Same-cell moves only refresh the stored position. Each instance should appear at most once.
+     * Time Complexity: O(m log m + sum of touched cell sizes) where m = moves
+     * @param Moves Instance relocations
+     */
+    void ApplyMoves(TArrayView<const FISMSpatialIndexMove> Moves);
+
     /**
      * Query instances within a sphere.
      * Returns ALL instances in cells that overlap the sphere (may include false positives).
@@ -65,6 +194,147 @@ public:
      */
     void QueryBox(const FBox& Box, TArray<int32>& OutInstances) const;
 
+    /**
+     * Query instances whose stored position lies inside the sphere.
+     * Exact variant of QueryRadius: the distance test runs inside the cell walk
+     * against the index's packed X/Y/Z position arrays (4-wide SIMD), so callers
+     * get no false positives and never need to re-fetch transforms.
+     * Time Complexity: O(k*c) where k = cells overlapped, c = avg instances per cell
+     * @param Center Center of the query sphere
+     * @param Radius Radius of the query sphere
+     * @param OutInstances Array to populate with instance indices (will be cleared first)
+     */
+    void QueryRadiusExact(const FVector& Center, float Radius, TArray<int32>& OutInstances) const;
+
+    /**
+     * Query instances whose stored position lies inside the box.
+     * Exact variant of QueryBox (see QueryRadiusExact).
+     * @param Box The query box
+     * @param OutInstances Array to populate with instance indices (will be cleared first)
+     */
+    void QueryBoxExact(const FBox& Box, TArray<int32>& OutInstances) const;
+
+    /**
+     * Visit instances whose stored position lies inside the sphere, without building a result array.
+     * Same test and order as QueryRadiusExact.
+     * @param Visitor Called per instance; return false to stop
+     * @return false if the visitor stopped the walk
+     */
+    bool ForEachInstanceInRadius(const FVector& Center, float Radius, TFunctionRef<bool(int32)> Visitor) const;
+
+    /** Visitor form of QueryBoxExact (see ForEachInstanceInRadius) */
+    bool ForEachInstanceInBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor) const;
+
+    /**
+     * Run many ForEachInstanceInRadius queries in one pass.
+     * Base-grid cells are gathered for every query and sorted, so each cell is walked once for
+     * all the queries that touch it while its instances are hot in cache. Queries large enough
+     * to use a coarse level run on their own.
+     * Same exact test as ForEachInstanceInRadius; order within one query is unspecified.
+     * @param Visitor Called with (query index, instance index) per hit
+     */
+    void ForEachInstanceInRadiusBatch(TConstArrayView<FISMSpatialSphereQuery> Queries, TFunctionRef<void(int32, int32)> Visitor) const;
+
+    /**
+     * Visit instances inside exactly one of two spheres - the enter/exit delta of a moving radius query.
+     * Cells wholly inside both spheres or touching neither are skipped without reading their instances,
+     * so a small move tests the instances near the two sphere surfaces rather than the whole volume.
+     * Tests stored positions like ForEachInstanceInRadius. A membership set kept from From is only
+     * patched correctly if the index has not changed since (see GetRevision); otherwise re-query.
+     * Base grid only.
+     * @param Visitor Called with (instance index, true if inside To - entered; false if inside only From - exited)
+     */
+    void ForEachInstanceRadiusDelta(const FISMSpatialSphereQuery& From, const FISMSpatialSphereQuery& To, TFunctionRef<void(int32, bool)> Visitor) const;
+
+    /**
+     * Record an instance's tag bits for the tag-pruned queries.
+     * Each base cell keeps the union of its instances' masks, so a query for tags no instance of a
+     * cell carries skips the cell without reading it. Unions only grow between Shrink/Rebuild calls
+     * (removals and moves out leave their bits behind), which costs a wasted cell visit, never a hit.
+     * Bit meaning is the caller's, e.g. a component's compact tag dictionary.
+     * The first call turns tag tracking on. Cleared by Clear, Rebuild and ClearInstanceTagMasks.
+     */
+    void SetInstanceTagMask(int32 InstanceIndex, const FISMTagMask& Mask);
+
+    /** Forget every recorded tag mask and turn tag tracking off */
+    void ClearInstanceTagMasks();
+
+    /** Whether SetInstanceTagMask has been called since the last clear */
+    bool HasInstanceTagMasks() const { return bTrackTagMasks; }
+
+    /**
+     * ForEachInstanceInRadius limited to instances whose tag mask has every bit of RequiredMask.
+     * Cells whose union lacks a required bit are skipped, and the per-instance mask test runs inside
+     * the cell walk ahead of the position test's visitor. Base grid only.
+     * An empty RequiredMask visits everything ForEachInstanceInRadius would. Without tag tracking no
+     * instance has a non-empty mask.
+     * @return false if the visitor stopped the walk
+     */
+    bool ForEachInstanceInRadiusWithTags(const FVector& Center, float Radius, const FISMTagMask& RequiredMask, TFunctionRef<bool(int32)> Visitor) const;
+
+    /** Box form of ForEachInstanceInRadiusWithTags */
+    bool ForEachInstanceInBoxWithTags(const FBox& Box, const FISMTagMask& RequiredMask, TFunctionRef<bool(int32)> Visitor) const;
+
+    /**
+     * Get the position the index currently holds for an instance.
+     * This is the location passed to the most recent Add/Update/Rebuild.
+     * @return false if the instance is not currently in the index
+     */
+    bool GetInstancePosition(int32 InstanceIndex, FVector& OutPosition) const;
+
+    /**
+     * Record an instance's world-space AABB for the overlap queries.
+     * Instances stay bucketed by their pivot; the index tracks how far any AABB reaches
+     * past its pivot and widens overlap queries by exactly that much. Instances reaching
+     * further than one cell are kept on a short oversized list instead, so a single huge
+     * mesh cannot inflate every query.
+     * May be called before or after AddInstance. Cleared by RemoveInstance, Clear and Rebuild.
+     * @param InstanceIndex The instance index
+     * @param WorldBounds World-space AABB (invalid box clears the recorded bounds)
+     */
+    void SetInstanceBounds(int32 InstanceIndex, const FBox& WorldBounds);
+
+    /**
+     * SetInstanceBounds for instances 0 .. N - 1 in one pass, e.g. from a bake, replacing every recorded AABB.
+     * Call after the positions are in the index so the reach is measured right away.
+     */
+    void AdoptInstanceBounds(TConstArrayView<FVector3f> InBoundsMin, TConstArrayView<FVector3f> InBoundsMax);
+
+    /** Forget an instance's AABB. Overlap queries fall back to its stored position. */
+    void ClearInstanceBounds(int32 InstanceIndex);
+
+    /**
+     * Query instances whose AABB intersects the box.
+     * Correct without caller-side padding; instances without recorded bounds are tested by position.
+     * @param Box The query box
+     * @param OutInstances Array to populate with instance indices (will be cleared first)
+     */
+    void QueryOverlappingBox(const FBox& Box, TArray<int32>& OutInstances) const;
+
+    /**
+     * Query instances whose AABB intersects the sphere.
+     * Correct without caller-side padding; instances without recorded bounds are tested by position.
+     * @param Center Center of the query sphere
+     * @param Radius Radius of the query sphere
+     * @param OutInstances Array to populate with instance indices (will be cleared first)
+     */
+    void QueryOverlappingSphere(const FVector& Center, float Radius, TArray<int32>& OutInstances) const;
+
+    /** Visitor form of QueryOverlappingBox. Return false from Visitor to stop; returns false if stopped. */
+    bool ForEachInstanceOverlappingBox(const FBox& Box, TFunctionRef<bool(int32)> Visitor) const;
+
+    /** Visitor form of QueryOverlappingSphere. Return false from Visitor to stop; returns false if stopped. */
+    bool ForEachInstanceOverlappingSphere(const FVector& Center, float Radius, TFunctionRef<bool(int32)> Visitor) const;
+
+    /**
+     * Padding applied to overlap queries: the largest pivot-to-AABB reach of any
+     * non-oversized instance. Only grows until the next Clear/Rebuild. Never exceeds the cell size.
+     */
+    float GetMaxBoundsReach() const { return MaxBoundsReach; }
+
+    /** Number of instances whose AABB reaches further than one cell from their pivot */
+    int32 GetOversizedInstanceCount() const { return OversizedInstances.Num(); }
+
     /**
      * Find the nearest instance to a location.
      * WARNING: This requires checking actual distances, so can be expensive.
@@ -79,6 +349,53 @@ public:
         const TArray<FVector>& InstanceLocations,
         float MaxDistance = -1.0f) const;
 
+    /**
+     * Walk the grid along a segment (3D-DDA) and collect instances whose AABB it hits.
+     * No physics scene query: tests the bounds recorded with SetInstanceBounds (the stored
+     * position for instances without bounds), inflated by Radius for sphere/capsule sweeps.
+     * The inflation is a box, so sweeps are conservative near AABB corners.
+     * Time Complexity: O(cells along the segment + candidates in them)
+     * @param Start Segment start
+     * @param End Segment end
+     * @param Radius Sweep radius (0 = line trace)
+     * @param OutHits Hits sorted by distance along the ray (will be cleared first)
+     * @param bFirstHitOnly Stop at the first AABB hit - the walk ends as soon as no later cell can beat it
+     */
+    void QueryRay(const FVector& Start, const FVector& End, float Radius, TArray<FISMSpatialRayHit>& OutHits, bool bFirstHitOnly = false) const;
+
+    /** QueryRay with a filter. Return false to skip an instance (only called for instances the ray hits). */
+    void QueryRay(const FVector& Start, const FVector& End, float Radius, TArray<FISMSpatialRayHit>& OutHits, bool bFirstHitOnly,
+        TFunctionRef<bool(int32)> Filter) const;
+
+    /**
+     * QueryRay with a narrow phase. Refine receives each AABB hit with its entry distance and may
+     * reject it or move the distance further along the ray (never closer - the early-out for
+     * bFirstHitOnly relies on AABB entry being a lower bound).
+     */
+    void QueryRayRefined(const FVector& Start, const FVector& End, float Radius, TArray<FISMSpatialRayHit>& OutHits, bool bFirstHitOnly,
+        TFunctionRef<bool(int32 InstanceIndex, float& InOutDistance)> Refine) const;
+
+    /**
+     * Find up to K instances nearest to a location, by stored position.
+     * Walks base-grid cells ring by ring around the query cell, keeping the best K in a
+     * bounded max-heap, and stops as soon as the next ring cannot beat the K-th distance.
+     * Time Complexity: O(c log K) where c = instances in the rings visited
+     * @param Location Query location
+     * @param K Maximum number of results
+     * @param OutNeighbors Results, nearest first (will be cleared first)
+     * @param MaxDistance Maximum search distance (-1 for unlimited)
+     * @param Filter Return false to skip an instance (e.g. destroyed); only called for instances that would make the cut
+     */
+    void FindKNearest(
+        const FVector& Location,
+        int32 K,
+        TArray<FISMSpatialNeighbor>& OutNeighbors,
+        float MaxDistance,
+        TFunctionRef<bool(int32)> Filter) const;
+
+    /** FindKNearest without a filter */
+    void FindKNearest(const FVector& Location, int32 K, TArray<FISMSpatialNeighbor>& OutNeighbors, float MaxDistance = -1.0f) const;
+
     /**
      * Clear all data from the index.
      * Time Complexity: O(n) where n = total instances
@@ -93,17 +410,119 @@ public:
      */
     void Rebuild(const TArray<FVector>& InstanceLocations);
 
+    /**
+     * Rebuild from locations whose base-grid cells (WorldLocationToCell) the caller already
+     * computed, e.g. in the same ParallelFor that produced the locations.
+     * Time Complexity: O(n log n) for Flat storage, O(n) for Hashed
+     * @param InstanceCells Base cell of every location, same length as InstanceLocations
+     */
+    void Rebuild(TConstArrayView<FVector> InstanceLocations, TConstArrayView<FIntVector> InstanceCells);
+
+    /**
+     * Base grid as sorted cells over one instance array (the Flat layout, whatever the storage):
+     * cell N holds OutInstances[OutCellOffsets[N] .. OutCellOffsets[N + 1]).
+     * Time Complexity: O(n log n)
+     */
+    void ExportCells(TArray<FIntVector>& OutCellKeys, TArray<int32>& OutCellOffsets, TArray<int32>& OutInstances) const;
+
+    /**
+     * Rebuild from cells produced by ExportCells at this cell size, skipping the sort:
+     * Flat storage takes the arrays as its buffer directly.
+     * Time Complexity: O(n)
+     * @param InstanceLocations Location of every instance, indexed by instance index
+     * @return false (index left empty) if the cells are malformed or name instances outside InstanceLocations
+     */
+    bool ImportCells(TConstArrayView<FIntVector> CellKeys, TConstArrayView<int32> CellOffsets, TConstArrayView<int32> Instances,
+        TConstArrayView<FVector> InstanceLocations);
+
+    /**
+     * Switch storage layout. Existing contents are preserved.
+     * Time Complexity: O(n log n) when switching to Flat, O(n) when switching to Hashed
+     */
+    void SetStorageMode(EISMSpatialIndexStorage NewStorage);
+
+    /** Get the current storage layout */
+    EISMSpatialIndexStorage GetStorageMode() const { return Storage; }
+
+    /**
+     * Fold the flat overlay and tombstones back into the contiguous buffer.
+     * Called automatically once pending edits exceed a fraction of the flat size.
+     * No-op in Hashed mode.
+     */
+    void CompactFlatStorage();
+
+    /**
+     * Enable multi-resolution queries.
+     * Adds NumLevels-1 coarse grids above the base grid, each LevelScale times larger.
+     * Every query picks the finest level whose cells are at least half the query extent,
+     * so both 3m and 50m queries touch a bounded number of cells with one base cell size.
+     * Costs one extra index entry per instance per coarse level.
+     * Time Complexity: O(n * levels)
+     * @param NumLevels Total levels including the base grid (1 = flat grid, the default), up to MaxHierarchyLevels
+     * @param LevelScale Cell size multiplier between consecutive levels
+     */
+    void SetHierarchyLevels(int32 NumLevels, int32 LevelScale = 4);
+
+    /** Most levels SetHierarchyLevels keeps; UISMRuntimeComponent::SpatialIndexLevels clamps to the same */
+    static constexpr int32 MaxHierarchyLevels = 6;
+
+    /** Get total number of levels, including the base grid */
+    int32 GetHierarchyLevelCount() const { return CoarseLevels.Num() + 1; }
+
+    /**
+     * Release memory left behind by churn: trims cell-array slack past the threshold,
+     * compacts the cell maps' sparse storage, folds pending flat edits, and drops
+     * trailing unused slots from the per-instance arrays.
+     * Runs automatically once enough removals accumulate (see SetAutoShrinkThreshold).
+     * Time Complexity: O(n + cells)
+     */
+    void Shrink();
+
+    /**
+     * Minimum number of removals between automatic Shrink calls.
+     * The effective threshold is max(MinRemovals, slots / 4), so large indices shrink proportionally less often.
+     * @param MinRemovals 0 disables automatic shrinking
+     */
+    void SetAutoShrinkThreshold(int32 MinRemovals) { AutoShrinkMinRemovals = FMath::Max(0, MinRemovals); }
+
+    /** Heap memory owned by the index, in bytes (cells, flat buffers, positions, bounds, coarse levels) */
+    SIZE_T GetAllocatedSize() const;
+
+    /**
+     * Interleave the low 21 bits of three coordinates into a 63-bit Morton (Z-order) code.
+     * Sorting by this code keeps spatially close points close in memory.
+     */
+    static uint64 EncodeMorton3D(uint32 X, uint32 Y, uint32 Z);
+
     // ===== Debug / Statistics =====
 
     /** Get number of cells currently allocated */
-    int32 GetCellCount() const { return Cells.Num(); }
+    int32 GetCellCount() const;
 
     /** Get total number of instance references stored (may have duplicates) */
     int32 GetTotalInstances() const;
 
+    /**
+     * Monotonic counter bumped by every mutation.
+     * Lets snapshot publishers skip the copy when nothing changed.
+     */
+    uint64 GetRevision() const { return Revision; }
+
     /** Get the cell size */
     float GetCellSize() const { return CellSize; }
 
+    /**
+     * Convert world location to base-grid cell coordinate.
+     * Uses floor division to ensure consistent cell assignment.
+     */
+    FIntVector WorldLocationToCell(const FVector& Location) const;
+
+    /**
+     * Get world-space bounds of a base-grid cell.
+     * Useful for debug visualization and cell culling.
+     */
+    FBox GetCellBounds(const FIntVector& CellCoord) const;
+
     /**
      * Get average instances per cell (for tuning cell size).
      * Lower is better - aim for 10-50 instances per cell.
@@ -116,24 +535,172 @@ public:
      */
     int32 GetMaxInstancesPerCell() const;
 
+    /**
+     * Cell occupancy histogram: OutBuckets[B] counts base cells holding [2^B, 2^(B+1)) instances,
+     * the last bucket everything above. Flat counts include tombstones.
+     */
+    void GetCellOccupancyHistogram(TArray<int32>& OutBuckets, int32 NumBuckets = 8) const;
+
     /**
      * Debug draw the spatial grid.
      * Only works in editor builds.
      */
     void DebugDraw(class UWorld* World, float Duration = 0.0f, bool bShowInstanceCounts = true) const;
 
+    // ===== Query Telemetry =====
+
+    /**
+     * Count radius and box queries - candidates walked, exact hits and the radius distribution.
+     * Copies of the index (snapshots) keep counting into the same block. Off by default; while
+     * on, each query costs a few relaxed atomic adds. Enabling again keeps the counters.
+     */
+    void SetQueryTelemetryEnabled(bool bEnabled);
+
+    /** Counters, or null while telemetry is off */
+    const FISMSpatialQueryTelemetry* GetQueryTelemetry() const { return QueryTelemetry.Get(); }
+
+    /** Zero the counters */
+    void ResetQueryTelemetry();
+
+    /**
+     * Cell size suggested by the recorded queries: twice the median query radius, the
+     * "2x your typical query radius" rule. 0 while nothing has been recorded.
+     */
+    float GetRecommendedCellSize() const;
+
 private:
     /**
-     * Convert world location to cell coordinate.
-     * Uses floor division to ensure consistent cell assignment.
+     * Visit every non-empty cell in [MinCell, MaxCell], regardless of storage mode.
+     * Visitor receives the cell coordinate and a view of its instance slots.
+     * Flat slots may contain INDEX_NONE tombstones - callers must skip them.
      */
-    FIntVector WorldLocationToCell(const FVector& Location) const;
+    template<typename VisitorType>
+    void ForEachCellInRange(const FIntVector& MinCell, const FIntVector& MaxCell, VisitorType&& Visitor) const;
 
     /**
-     * Get world-space bounds of a cell.
-     * Useful for debug visualization.
+     * Visit cells overlapping the world-space range [Min, Max] on the level best suited
+     * to its extent. Falls through to ForEachCellInRange on the base grid.
      */
-    FBox GetCellBounds(const FIntVector& CellCoord) const;
+    template<typename VisitorType>
+    void ForEachCellOverlapping(const FVector& Min, const FVector& Max, VisitorType&& Visitor) const;
+
+    /** Visit hashed cells in [MinCell, MaxCell], scanning the map when it is smaller than the range */
+    template<typename VisitorType>
+    static void ForEachHashedCellInRange(const TMap<FIntVector, TArray<int32>>& InCells, const FIntVector& MinCell, const FIntVector& MaxCell, VisitorType&& Visitor);
+
+    /** Visit the shell of base cells at Chebyshev distance Ring from CenterCell */
+    template<typename VisitorType>
+    void ForEachCellInRing(const FIntVector& CenterCell, int32 Ring, VisitorType&& Visitor) const;
+
+    /** Expand the occupied cell range to include CellCoord */
+    void GrowOccupiedCells(const FIntVector& CellCoord);
+
+    /** Pick the coarse level for a query of the given half extent. INDEX_NONE = base grid. */
+    int32 SelectQueryLevel(float HalfExtent) const;
+
+    /** Floor-divide a location into a cell coordinate for an arbitrary cell size */
+    static FIntVector LocationToCell(const FVector& Location, float InCellSize);
+
+    /** Insert into the base grid. Returns false if the instance was already in that cell. */
+    bool AddToBaseGrid(int32 InstanceIndex, const FIntVector& CellCoord);
+
+    /** Remove from the base grid. Returns false if the instance was not in that cell. */
+    bool RemoveFromBaseGrid(int32 InstanceIndex, const FIntVector& CellCoord);
+
+    /** Remove a sorted group of instances from one cell in a single pass. Returns the number removed. */
+    static int32 RemoveGroupFromCell(TArray<int32>& Cell, TArrayView<const int32> SortedGroup);
+
+    /** Add a sorted group of instances to one cell, skipping ones already present. Returns the number added. */
+    static int32 AddGroupToCell(TArray<int32>& Cell, TArrayView<const int32> SortedGroup);
+
+    /** Trim a cell array whose slack exceeds both 4 and its own size */
+    static void ShrinkCellSlack(TArray<int32>& Cell);
+
+    /** Add/remove an instance from every coarse level */
+    void AddToCoarseLevels(int32 InstanceIndex, const FVector& Location);
+    void RemoveFromCoarseLevels(int32 InstanceIndex, const FVector& Location);
+
+    /** Append all live entries of a cell view to OutInstances */
+    static void AppendCellInstances(TArrayView<const int32> CellInstances, TArray<int32>& OutInstances);
+
+    /** Append entries of a cell view whose stored position is within RadiusSq of Center */
+    void AppendCellInstancesInSphere(TArrayView<const int32> CellInstances, const FVector3f& Center, float RadiusSq, TArray<int32>& OutInstances) const;
+
+    /** Append entries of a cell view whose stored position is inside [Min, Max] */
+    void AppendCellInstancesInBox(TArrayView<const int32> CellInstances, const FVector3f& Min, const FVector3f& Max, TArray<int32>& OutInstances) const;
+
+    /** Pass entries of a cell view within RadiusSq of Center to Sink (4-wide). Returns false once Sink returns false. */
+    template<typename SinkType>
+    bool VisitCellInstancesInSphere(TArrayView<const int32> CellInstances, const FVector3f& Center, float RadiusSq, SinkType&& Sink) const;
+
+    /** Pass entries of a cell view inside [Min, Max] to Sink (4-wide). Returns false once Sink returns false. */
+    template<typename SinkType>
+    bool VisitCellInstancesInBox(TArrayView<const int32> CellInstances, const FVector3f& Min, const FVector3f& Max, SinkType&& Sink) const;
+
+    /** Remember the base cell an instance was filed under and merge its tag mask into that cell */
+    void NoteInstanceTagCell(int32 InstanceIndex, const FIntVector& CellCoord);
+
+    /** Recompute every cell's tag union (and each instance's cell) from the current contents */
+    void RebuildCellTagMasks();
+
+    /** Whether some instance filed under CellCoord may carry every bit of RequiredMask */
+    bool CellMayHaveTags(const FIntVector& CellCoord, const FISMTagMask& RequiredMask) const
+    {
+        const FISMTagMask* CellMask = CellTagMasks.Find(CellCoord);
+        return CellMask && CellMask->HasAll(RequiredMask);
+    }
+
+    bool InstanceHasTags(int32 InstanceIndex, const FISMTagMask& RequiredMask) const
+    {
+        return InstanceTagMasks.IsValidIndex(InstanceIndex) && InstanceTagMasks[InstanceIndex].HasAll(RequiredMask);
+    }
+
+    /** Record an instance's position in the packed arrays, growing them as needed */
+    void StorePosition(int32 InstanceIndex, const FVector& Location);
+
+    /** Grow the packed bounds arrays to hold InstanceIndex */
+    void EnsureBoundsCapacity(int32 InstanceIndex);
+
+    /** Recompute an instance's pivot-to-AABB reach and its oversized classification */
+    void RefreshBoundsReach(int32 InstanceIndex);
+
+    /** Whether an instance's AABB (or position, without bounds) intersects [Min, Max] */
+    bool InstanceOverlapsBox(int32 InstanceIndex, const FVector3f& Min, const FVector3f& Max) const;
+
+    /**
+     * Slab test of a ray against an instance's AABB (or position, without bounds) inflated by Inflate.
+     * InvDir components of 0 mark axes the ray is parallel to.
+     * @return false if the ray misses within [0, MaxT]; OutT = entry parameter
+     */
+    bool InstanceRayEntry(int32 InstanceIndex, const FVector3f& Origin, const FVector3f& InvDir, float MaxT, float Inflate, float& OutT) const;
+
+    /** Whether an instance's AABB (or position, without bounds) is within RadiusSq of Center */
+    bool InstanceOverlapsSphere(int32 InstanceIndex, const FVector3f& Center, float RadiusSq) const;
+
+    /**
+     * Shared cell walk for the overlap queries: visits [Min, Max] padded by MaxBoundsReach,
+     * then the oversized list. Test decides inclusion per instance; Sink returns false to stop.
+     * @return false if Sink stopped the walk
+     */
+    template<typename TestType, typename SinkType>
+    bool VisitOverlapping(const FVector& Min, const FVector& Max, TestType&& Test, SinkType&& Sink) const;
+
+    /** Locate a cell in the flat key array. Returns INDEX_NONE if absent. */
+    int32 FindFlatCell(const FIntVector& CellCoord) const;
+
+    /** Rebuild the flat buffers from a list of (cell, instance) pairs. Pairs are sorted in place. */
+    void BuildFlatFromPairs(TArray<TPair<FIntVector, int32>>& Pairs);
+
+    /** Whether pending overlay/tombstone edits are large enough to warrant compaction */
+    bool ShouldCompactFlat() const;
+
+    /** Lexicographic X,Y,Z ordering used for the flat key array */
+    static bool CellKeyLess(const FIntVector& A, const FIntVector& B)
+    {
+        if (A.X != B.X) return A.X < B.X;
+        if (A.Y != B.Y) return A.Y < B.Y;
+        return A.Z < B.Z;
+    }
 
     /** Size of each cell in world units (centimeters) */
     float CellSize;
@@ -146,4 +713,100 @@ private:
      * - Predictable performance
      */
     TMap<FIntVector, TArray<int32>> Cells;
-};
\ No newline at end of file
+
+    /** Active storage layout. In Flat mode, Cells acts as the overlay for incremental adds. */
+    EISMSpatialIndexStorage Storage = EISMSpatialIndexStorage::Hashed;
+
+    /** Flat mode: sorted (X,Y,Z) cell keys */
+    TArray<FIntVector> FlatCellKeys;
+
+    /** Flat mode: FlatCellKeys.Num() + 1 offsets into FlatInstances */
+    TArray<int32> FlatCellOffsets;
+
+    /** Flat mode: contiguous instance buffer, INDEX_NONE marks removed entries */
+    TArray<int32> FlatInstances;
+
+    /** Flat mode: number of INDEX_NONE slots in FlatInstances */
+    int32 FlatTombstoneCount = 0;
+
+    /** Flat mode: number of instances held in the hashed overlay */
+    int32 OverlayInstanceCount = 0;
+
+    /**
+     * Packed per-instance positions (indexed by instance index), used by the exact queries.
+     * Kept as separate X/Y/Z streams so the SIMD test loads one lane per instance.
+     * Single precision: adequate for gameplay queries, not for sub-mm tests at LWC scale.
+     */
+    TArray<float> PositionsX;
+    TArray<float> PositionsY;
+    TArray<float> PositionsZ;
+
+    /** Whether a slot in the position arrays belongs to an instance currently in the index */
+    TBitArray<> PositionValid;
+
+    /** Per-instance world AABBs (indexed by instance index), used by the overlap queries */
+    TArray<FVector3f> BoundsMin;
+    TArray<FVector3f> BoundsMax;
+
+    /** Whether an instance has recorded bounds */
+    TBitArray<> BoundsValid;
+
+    /** Whether an instance is on the oversized list (skipped during the cell walk) */
+    TBitArray<> BoundsOversized;
+
+    /** Instances whose AABB reaches further than CellSize from their pivot */
+    TArray<int32> OversizedInstances;
+
+    /** Largest pivot-to-AABB reach among non-oversized instances */
+    float MaxBoundsReach = 0.0f;
+
+    /**
+     * Conservative range of base cells that have held instances since the last Clear.
+     * Bounds the ring expansion of FindKNearest. Only grows.
+     */
+    FIntVector OccupiedMinCell = FIntVector::ZeroValue;
+    FIntVector OccupiedMaxCell = FIntVector::ZeroValue;
+    bool bHasOccupiedCells = false;
+
+    /** Per-instance tag masks (indexed by instance index), see SetInstanceTagMask */
+    TArray<FISMTagMask> InstanceTagMasks;
+
+    /** Base cell each instance was last filed under while tag tracking was on */
+    TArray<FIntVector> InstanceTagCells;
+
+    /** Base cell -> union of its instances' tag masks. Cells with an empty union have no entry. */
+    TMap<FIntVector, FISMTagMask> CellTagMasks;
+
+    /** SetInstanceTagMask has been called since the last clear */
+    bool bTrackTagMasks = false;
+
+    /** Coarse levels for hierarchical queries, finest first. Empty = single-resolution grid. */
+    TArray<FISMSpatialGridLevel> CoarseLevels;
+
+    /** Removals since the last Shrink */
+    int32 RemovalsSinceShrink = 0;
+
+    /** See SetAutoShrinkThreshold */
+    int32 AutoShrinkMinRemovals = 1024;
+
+    /** Mutation counter (see GetRevision) */
+    uint64 Revision = 0;
+
+    /** See SetQueryTelemetryEnabled; survives Clear */
+    TSharedPtr<FISMSpatialQueryTelemetry, ESPMode::ThreadSafe> QueryTelemetry;
+
+    void RecordQuery(float Radius, int32 NumCandidates, int32 NumHits) const
+    {
+        if (QueryTelemetry.IsValid())
+        {
+            QueryTelemetry->Record(Radius, NumCandidates, NumHits);
+        }
+    }
+};
+
+/**
+ * Immutable, reference-counted copy of a spatial index for worker-thread readers.
+ * Publishers swap in a new copy once per frame; readers keep whichever version they
+ * grabbed alive until they drop the reference (RCU-style), so no reader ever blocks a writer.
+ */
+typedef TSharedPtr<const FISMSpatialIndex, ESPMode::ThreadSafe> FISMSpatialIndexSnapshot;
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include "CoreMinimal.h"
+
+#include "ISMSpatialIndexHealth.generated.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Spatial index tuning snapshot of one component (UISMRuntimeComponent::GetSpatialIndexHealth).
+ * Query figures come from telemetry recorded since bSpatialQueryTelemetry was turned on or last reset.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMSpatialIndexHealth
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    UISMRuntimeComponent* Component = nullptr;
+
+    /** Query telemetry is being recorded; the query figures below are 0 otherwise */
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    bool bTelemetryEnabled = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    int64 QueryCount = 0;
+
+    /** Instance slots walked per radius/box query */
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    float MeanCandidatesPerQuery = 0.0f;
+
+    /** Share of walked candidates that failed the exact test; high values mean cells are too large for the queries */
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    float FalsePositiveRatio = 0.0f;
+
+    /** Median query radius (bucketed) */
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    float MedianQueryRadius = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    float CellSize = 0.0f;
+
+    /** Twice the median query radius; 0 until queries have been recorded */
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    float RecommendedCellSize = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    int32 CellCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    float AverageInstancesPerCell = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    int32 MaxInstancesPerCell = 0;
+
+    /** Entry B counts cells holding [2^B, 2^(B+1)) instances; the last entry everything above */
+    UPROPERTY(BlueprintReadOnly, Category = "Spatial Index")
+    TArray<int32> CellOccupancyHistogram;
+};
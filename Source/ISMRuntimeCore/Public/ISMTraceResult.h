@@ -11,7 +11,10 @@ enum class EISMTraceResolveMethod : uint8
     Direct,
 
     /** Trace hit a redirect component — instance resolved by AABB proximity */
-    Redirect
+    Redirect,
+
+    /** No physics query — the segment walked the ISM spatial grid and hit the instance AABB */
+    SpatialGrid
 };
 
 
@@ -28,6 +28,32 @@ public:
     /** Set a state flag value for an instance */
     virtual void SetInstanceState(int32 InstanceIndex, EISMInstanceState State, bool bValue) = 0;
     
-    /** Get the full state struct for an instance */
-    virtual const FISMInstanceState* GetInstanceState(int32 InstanceIndex) const = 0;
+    /** Whether the instance has any state recorded */
+    virtual bool HasInstanceState(int32 InstanceIndex) const = 0;
+    
+    /** Copy out the full state struct for an instance. Returns false if it has no state. */
+    virtual bool GetInstanceState(int32 InstanceIndex, FISMInstanceState& OutState) const = 0;
+
+    // ===== Bulk access =====
+
+    /**
+     * Flags of each of InstanceIndices into the matching element of OutFlags (0 without state), in one
+     * call instead of one virtual call per instance. OutFlags must be at least as long as InstanceIndices.
+     * The default just loops GetInstanceStateFlags; providers with dense storage override it.
+     */
+    virtual void GetStateFlags(TConstArrayView<int32> InstanceIndices, TArrayView<uint8> OutFlags) const
+    {
+        check(OutFlags.Num() >= InstanceIndices.Num());
+        for (int32 i = 0; i < InstanceIndices.Num(); ++i)
+        {
+            OutFlags[i] = GetInstanceStateFlags(InstanceIndices[i]);
+        }
+    }
+
+    /**
+     * Flag byte of every instance, indexed by instance index, for scans that read flags directly.
+     * May be shorter than the instance count; indices past the end have no state. Empty when the
+     * provider has no contiguous storage - use GetStateFlags. Invalidated when instances are added.
+     */
+    virtual TConstArrayView<uint8> GetStateFlagsRaw() const { return TConstArrayView<uint8>(); }
 };
\ No newline at end of file
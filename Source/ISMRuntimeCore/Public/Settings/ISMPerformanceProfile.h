@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMPerformanceProfile.generated.h"
+
+struct FISMBatchSchedulerSettings;
+
+/** Target hardware a set of coordinated performance defaults is tuned for */
+UENUM(BlueprintType)
+enum class EISMPerformanceProfile : uint8
+{
+    /** Project settings and assets as authored: nothing overridden, every scale 1 */
+    Default,
+    HighEnd,
+    VR,
+    Handheld,
+    Server
+};
+
+/**
+ * Performance defaults for every ISMRuntime module at once.
+ *
+ * Overrides replace one knob while set and leave the authored value alone otherwise, in the
+ * bOverride_ style of FPostProcessSettings. Scales multiply the limits authored per asset and per
+ * component (pool sizes, physics limiters), so a profile retunes all of them without touching any.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMECORE_API FISMPerformanceProfileSettings
+{
+    GENERATED_BODY()
+
+    // ===== Batching =====
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (InlineEditConditionToggle))
+    bool bOverride_UseAsyncBatchScheduler = false;
+
+    /** Worlds that start after a switch create this scheduler; running worlds keep theirs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (EditCondition = "bOverride_UseAsyncBatchScheduler"))
+    bool bUseAsyncBatchScheduler = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (InlineEditConditionToggle))
+    bool bOverride_MaxConcurrentChunks = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (EditCondition = "bOverride_MaxConcurrentChunks", ClampMin = "1"))
+    int32 MaxConcurrentChunks = 32;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (InlineEditConditionToggle))
+    bool bOverride_MaxInstancesPerChunk = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (EditCondition = "bOverride_MaxInstancesPerChunk", ClampMin = "64"))
+    int32 MaxInstancesPerChunk = 2048;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (InlineEditConditionToggle))
+    bool bOverride_LaunchChunksAtBackgroundPriority = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (EditCondition = "bOverride_LaunchChunksAtBackgroundPriority"))
+    bool bLaunchChunksAtBackgroundPriority = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (InlineEditConditionToggle))
+    bool bOverride_DispatchBudgetMs = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (EditCondition = "bOverride_DispatchBudgetMs", ClampMin = "0.0", Units = "ms"))
+    float DispatchBudgetMs = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (InlineEditConditionToggle))
+    bool bOverride_ApplyBudgetMs = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batching", meta = (EditCondition = "bOverride_ApplyBudgetMs", ClampMin = "0.0", Units = "ms"))
+    float ApplyBudgetMs = 0.0f;
+
+    // ===== Frame Budget =====
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (InlineEditConditionToggle))
+    bool bOverride_FrameBudgetMs = false;
+
+    /** Shared ISMRuntime game-thread budget per frame; 0 turns the governor off */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frame Budget", meta = (EditCondition = "bOverride_FrameBudgetMs", ClampMin = "0.0", Units = "ms"))
+    float FrameBudgetMs = 4.0f;
+
+    // ===== Feedback =====
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Feedback", meta = (InlineEditConditionToggle))
+    bool bOverride_MaxFeedbackPerFrame = false;
+
+    /** UISMFeedbackSubsystem::MaxFeedbackPerFrame; -1 is unlimited */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Feedback", meta = (EditCondition = "bOverride_MaxFeedbackPerFrame", ClampMin = "-1"))
+    int32 MaxFeedbackPerFrame = -1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Feedback", meta = (InlineEditConditionToggle))
+    bool bOverride_MinFeedbackSignificance = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Feedback", meta = (EditCondition = "bOverride_MinFeedbackSignificance", ClampMin = "0.0", ClampMax = "1.0"))
+    float MinFeedbackSignificance = 0.02f;
+
+    // ===== Scales =====
+
+    /** Multiplies every pool data asset's InitialPoolSize and MaxPoolSize (unlimited stays unlimited) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scales", meta = (ClampMin = "0.0"))
+    float PoolSizeScale = 1.0f;
+
+    /** Multiplies every physics component's MaxConcurrentActors (unlimited stays unlimited) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scales", meta = (ClampMin = "0.0"))
+    float PhysicsActorLimitScale = 1.0f;
+
+    /** Multiplies every physics component's MaxSimulationDistance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scales", meta = (ClampMin = "0.0"))
+    float PhysicsDistanceScale = 1.0f;
+
+    /** Tuned values of a profile before project overrides */
+    static FISMPerformanceProfileSettings GetBuiltIn(EISMPerformanceProfile Profile);
+
+    /** Write the overridden scheduler fields into Settings */
+    void ApplyTo(FISMBatchSchedulerSettings& Settings) const;
+
+    /** A count limit scaled by Scale; 0 (unlimited) stays 0 and a set limit stays at least 1 */
+    static int32 ScaleLimit(int32 Limit, float Scale)
+    {
+        return Limit > 0 ? FMath::Max(1, FMath::RoundToInt32(Limit * Scale)) : Limit;
+    }
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnISMPerformanceProfileChanged, EISMPerformanceProfile /*Profile*/, const FISMPerformanceProfileSettings& /*Settings*/);
+
+/**
+ * The performance profile in effect for the process. Starts as UISMRuntimeSettings::PerformanceProfile;
+ * SetActiveProfile (console: ISM.PerformanceProfile <Name>) switches it at runtime and every module
+ * reconfigures from OnProfileChanged - scheduler, frame budget and feedback caps on the spot, pool
+ * and physics limits from their next read.
+ */
+class ISMRUNTIMECORE_API FISMPerformanceProfiles
+{
+public:
+    static EISMPerformanceProfile GetActiveProfile();
+
+    static const FISMPerformanceProfileSettings& GetActive();
+
+    /** A profile's values: the project's override from UISMRuntimeSettings if it has one, else the built-in */
+    static FISMPerformanceProfileSettings Resolve(EISMPerformanceProfile Profile);
+
+    /** Game thread. Re-applies and broadcasts even if Profile is already active, so edited overrides take effect. */
+    static void SetActiveProfile(EISMPerformanceProfile Profile);
+
+    static FOnISMPerformanceProfileChanged& OnProfileChanged();
+};
@@ -85,6 +85,49 @@ public:
               meta = (DisplayName = "DMI Eviction Age (Frames)", ClampMin = "0"))
     int32 DefaultEvictionAgeFrames = 600;
 
+    /**
+     * Cap on shared pool entries evicted automatically per frame - by the stale sweep and by
+     * cache misses on a full pool - so a conversion burst cannot hitch. A full pool grows past
+     * its maximum once the cap is spent and is trimmed back over the following frames.
+     * 0 = unlimited. Explicit EvictStaleDMIs calls are not capped.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "DMI Pool",
+              meta = (DisplayName = "Max Automatic Evictions Per Frame", ClampMin = "0"))
+    int32 MaxAutoEvictionsPerFrame = 16;
+
+    /**
+     * Shared pool DMIs built per frame from the prewarm queue filled by data assets with
+     * bPrewarmSharedDMIs. Spreads level-load DMI creation over several frames. 0 = drain in one frame.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "DMI Pool",
+              meta = (DisplayName = "Max Prewarmed DMIs Per Frame", ClampMin = "0"))
+    int32 MaxPrewarmDMIsPerFrame = 4;
+
+    /** Length of the window FISMDMIPoolWindowStats rates and acquire time percentiles are measured over */
+    UPROPERTY(Config, EditAnywhere, Category = "DMI Pool",
+              meta = (DisplayName = "Pool Stats Window (Seconds)", ClampMin = "0.5"))
+    float PoolStatsWindowSeconds = 5.f;
+
+    /**
+     * Size the shared pool cap and hot pools from measured use at the end of every stats window,
+     * within DMIPoolMemoryBudgetMB, instead of using the fixed sizes above. Hot pools that ran out
+     * grow and quiet ones shrink; the shared cap grows while the hit rate is under
+     * AutoTuneTargetHitRate and shrinks towards the referenced entry count while it is well above.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "DMI Pool",
+              meta = (DisplayName = "Auto-Tune DMI Pools"))
+    bool bAutoTuneDMIPools = false;
+
+    /** Estimated CPU-side memory the shared and hot pools may hold together while auto-tuning */
+    UPROPERTY(Config, EditAnywhere, Category = "DMI Pool",
+              meta = (DisplayName = "DMI Pool Memory Budget (MB)", ClampMin = "1", EditCondition = "bAutoTuneDMIPools"))
+    float DMIPoolMemoryBudgetMB = 64.f;
+
+    /** Shared pool hit rate auto-tuning grows the cap to reach */
+    UPROPERTY(Config, EditAnywhere, Category = "DMI Pool",
+              meta = (DisplayName = "Auto-Tune Target Hit Rate", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bAutoTuneDMIPools"))
+    float AutoTuneTargetHitRate = 0.9f;
+
     // ===== Helpers (callable at runtime, no subsystem needed) =====
 
     /** Get the singleton settings instance */
@@ -2,8 +2,22 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "ISMFrameBudget.h"
+#include "Settings/ISMPerformanceProfile.h"
 #include "ISMRuntimeSettings.generated.h"
 
+class UWorld;
+
+/** When runtime components skip render-side work (see UISMRuntimeSettings::HeadlessMode) */
+UENUM()
+enum class EISMHeadlessMode : uint8
+{
+    /** Headless in dedicated server worlds */
+    Auto,
+    /** Always headless, e.g. for simulation builds or server-side testing in the editor */
+    Always,
+    Never
+};
 
 UCLASS(Abstract, config = Game, defaultconfig)
 class ISMRUNTIMECORE_API UISMRuntimeSettingsBase : public UDeveloperSettings
@@ -41,6 +55,133 @@ public:
     /** Default maximum query results */
     UPROPERTY(config, EditAnywhere, Category = "Performance")
     int32 DefaultMaxQueryResults = 1000;
+
+    /** Cell size in cm of the subsystem's grid over component bounds (256m = 25600cm) */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="100.0"))
+    float ComponentBroadphaseCellSize = 25600.0f;
+
+    /** Candidate components (or trace hits) a bAllowParallel query needs before it goes wide */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="1"))
+    int32 ParallelQueryMinItems = 16;
+
+    /**
+     * Tick every runtime component from UISMRuntimeSubsystem (UISMRuntimeComponent::bUseManagedTick)
+     * rather than from thousands of tick functions that mostly find nothing to do
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance")
+    bool bManagedComponentTick = false;
+
+    /** Managed components ticked per batch; the frame budget is checked between batches. 0 = one batch. */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="0"))
+    int32 ManagedTickBatchSize = 64;
+
+    /** Run each batch's TickRuntimeParallel sections across worker threads */
+    UPROPERTY(config, EditAnywhere, Category = "Performance")
+    bool bParallelManagedTick = true;
+
+    /**
+     * Initialize every runtime component through UISMRuntimeSubsystem's init queue, in instance ranges
+     * over several frames (UISMRuntimeComponent::bTimeSlicedInit), so a streamed-in cell does not build
+     * all of its components in one frame
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance")
+    bool bTimeSlicedComponentInit = false;
+
+    /** Instances built per step of a time-sliced initialization; the budget is checked between steps */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="1"))
+    int32 ComponentInitSliceInstances = 16384;
+
+    /** Game-thread time per frame for the init queue, on top of the shared frame budget. At least one step runs per frame. */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="0.0", Units="ms"))
+    float ComponentInitBudgetMs = 2.0f;
+
+    /**
+     * Viewer distance in cm beyond which a component with bAllowDormancy goes dormant, when it sets no
+     * DormancyDistance of its own. Measured from the player view points to the component's bounds.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="0.0", Units="cm"))
+    float DefaultDormancyDistance = 100000.0f;
+
+    /** A dormant component wakes once a viewer comes within this fraction of its dormancy distance */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="0.0", ClampMax="1.0"))
+    float DormancyWakeFraction = 0.8f;
+
+    /** Seconds between the subsystem's dormancy passes over dormancy-enabled components */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="0.0", Units="s"))
+    float DormancyCheckInterval = 0.5f;
+
+    /**
+     * Commands UISMRuntimeSubsystem::EnqueueInstanceCommand holds between game-thread drains before
+     * pushes spill to a locked overflow list. Rounded up to a power of two; 24 bytes per command.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta=(ClampMin="64"))
+    int32 InstanceCommandQueueCapacity = 4096;
+
+    // ===== Frame Budget =====
+
+    /**
+     * Share one game-thread time budget per frame between the batch scheduler, feedback queue,
+     * physics conversions, actor pools and hot DMIs (FISMFrameBudgetGovernor). Systems draw from it
+     * in priority order and defer what does not fit, on top of their own per-system limits.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget")
+    bool bEnableFrameBudget = false;
+
+    /** Total ISMRuntime game-thread time per frame */
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta=(EditCondition="bEnableFrameBudget", ClampMin="0.1", Units="ms"))
+    float FrameBudgetMs = 4.0f;
+
+    /**
+     * Priority per system, replacing its default. Names: BatchScheduler, ComponentTick, ComponentInit, Dormancy (Low), Feedback (High by default),
+     * PhysicsConversion, PhysicsLimiters, ActorPools (Low), HotDMI (High), DMIPoolMaintenance (Low).
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta=(EditCondition="bEnableFrameBudget"))
+    TMap<FName, EISMFrameBudgetPriority> FrameBudgetPriorities;
+
+    /** Consecutive frames over budget before the overload signal fires */
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta=(EditCondition="bEnableFrameBudget", ClampMin="1"))
+    int32 FrameBudgetOverloadFrames = 3;
+
+    /** Consecutive frames within budget before overload clears */
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta=(EditCondition="bEnableFrameBudget", ClampMin="1"))
+    int32 FrameBudgetRecoveryFrames = 30;
+
+    /** Time a system that keeps deferring is granted after FrameBudgetMaxStarvedFrames frames without any */
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta=(EditCondition="bEnableFrameBudget", ClampMin="0.0", Units="ms"))
+    float FrameBudgetMinSliceMs = 0.1f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta=(EditCondition="bEnableFrameBudget", ClampMin="1"))
+    int32 FrameBudgetMaxStarvedFrames = 8;
+
+    // ===== Performance Profile =====
+
+    /**
+     * Coordinated defaults for the scheduler, frame budget, feedback caps, pool sizes and physics
+     * limiters, applied at startup. Switch at runtime with FISMPerformanceProfiles::SetActiveProfile
+     * or ISM.PerformanceProfile; Default keeps everything as authored.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance Profile")
+    EISMPerformanceProfile PerformanceProfile = EISMPerformanceProfile::Default;
+
+    /** Project values replacing a built-in profile's */
+    UPROPERTY(config, EditAnywhere, Category = "Performance Profile")
+    TMap<EISMPerformanceProfile, FISMPerformanceProfileSettings> PerformanceProfileOverrides;
+    
+    // ===== Headless =====
+
+    /**
+     * Headless worlds keep the authoritative runtime state - flags, tags, spatial index, bounds,
+     * transforms and custom data - but skip its render side: render state invalidation, custom-data
+     * visibility writes, DMI creation and feedback routing.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Headless")
+    EISMHeadlessMode HeadlessMode = EISMHeadlessMode::Auto;
+
+    /** Whether World runs headless under HeadlessMode */
+    bool IsHeadless(const UWorld* World) const;
+
+    /** The same for a game instance or process that is, or is not, a dedicated server */
+    bool IsHeadlessFor(bool bDedicatedServer) const;
     
     // ===== Debug =====
     
@@ -60,6 +201,15 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Debug")
     bool bLogPerformanceWarnings = true;
     
+    // ===== Editor =====
+
+    /**
+     * Rebake a runtime component's BakedState when its level is saved and the ISM no longer matches
+     * the bake (e.g. the PCG graph regenerated). Cooks only warn about stale bakes.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Editor")
+    bool bRebakeStaleStateOnSave = true;
+
     // ===== Features =====
     
     /** Enable automatic tick optimization */
@@ -14,7 +14,9 @@ public class ISMRuntimeCoreTests : ModuleRules
             "CoreUObject",
             "Engine",
             "GameplayTags",
-            "ISMRuntimeCore"
+            "Json",
+            "ISMRuntimeCore",
+            "ISMRuntimeResource"
         });
         
         // Only compile in editor builds
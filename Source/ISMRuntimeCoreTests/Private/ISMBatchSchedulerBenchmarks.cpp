@@ -0,0 +1,407 @@
+// ISMBatchSchedulerBenchmarks.cpp
+// Batch scheduler benchmarks - companion to ISMBatchSchedulerTests.cpp, which covers correctness
+//
+// Each benchmark builds one synthetic component and runs three transformers through both the sync
+// scheduler (UISMBatchSchedulerSync) and the async one (UISMBatchScheduler):
+//   - NoOp        : reads state flags, releases empty results
+//   - Animation   : reads and writes every transform through the transform stream
+//   - CustomData  : reads custom data, bumps slot 0 through the custom data stream
+//
+// Per scenario, averaged over the measured cycles after a warm-up:
+//   DispatchMs    : game-thread dispatch time (sync: the whole inline cycle)
+//   ApplyMs       : result application time (sync: time spent in Release)
+//   SnapshotBytes : heap bytes of the snapshots handed to the transformer
+//   PoolMisses    : buffer pool leases that had to allocate, per cycle
+//   LatencyMs     : dispatch to OnRequestComplete, and the ticks it took
+//
+// Results are logged and written to Saved/Automation/ISMBatchBenchmarks/<Instances>.csv and .json
+// for nightly comparison. 10k and 100k run under the perf filter, 1M under the stress filter.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+#include "Batching/ISMBatchScheduler.h"
+#include "Batching/ISMBatchTransformer.h"
+#include "Batching/ISMBatchTypes.h"
+
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+
+#include <atomic>
+
+namespace ISMBatchBenchmark
+{
+    enum class EWorkload : uint8
+    {
+        NoOp,
+        Animation,
+        CustomData,
+    };
+
+    const TCHAR* WorkloadName(EWorkload Workload)
+    {
+        switch (Workload)
+        {
+        case EWorkload::Animation:  return TEXT("Animation");
+        case EWorkload::CustomData: return TEXT("CustomData");
+        default:                    return TEXT("NoOp");
+        }
+    }
+
+    /**
+     * Transformer with a fixed per-instance workload. Always releases through the pooled path, as
+     * a continuous transformer would. ProcessChunk runs on workers for the async scheduler, so the
+     * counters are atomic.
+     */
+    struct FBenchmarkTransformer : public IISMBatchTransformer
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> TargetComponent;
+        EWorkload Workload = EWorkload::NoOp;
+        float     Time = 0.0f;
+
+        std::atomic<int64> SnapshotBytes{ 0 };
+        std::atomic<int64> ReleaseCycles{ 0 };
+        std::atomic<int32> NumChunks{ 0 };
+        int32              CompleteCount = 0;
+
+        void ResetCounters()
+        {
+            SnapshotBytes = 0;
+            ReleaseCycles = 0;
+            NumChunks = 0;
+        }
+
+        void SetDirty() { bDirty = true; }
+
+        virtual FName GetTransformerName() const override { return FName("ISMBatchBenchmark.Transformer"); }
+        virtual bool IsDirty() const override { return bDirty; }
+        virtual void ClearDirty() override { bDirty = false; }
+        virtual void OnRequestComplete() override { CompleteCount++; }
+
+        virtual FISMSnapshotRequest BuildRequest() override
+        {
+            FISMSnapshotRequest Request;
+            Request.TargetComponents.Add(TargetComponent);
+            switch (Workload)
+            {
+            case EWorkload::Animation:
+                Request.ReadMask = EISMSnapshotField::Transform;
+                Request.WriteMask = EISMSnapshotField::Transform;
+                break;
+            case EWorkload::CustomData:
+                Request.ReadMask = EISMSnapshotField::CustomData;
+                Request.WriteMask = EISMSnapshotField::CustomData;
+                break;
+            default:
+                Request.ReadMask = EISMSnapshotField::StateFlags;
+                break;
+            }
+            return Request;
+        }
+
+        virtual void ProcessChunk(FISMBatchSnapshot Chunk, FISMMutationHandle Handle) override
+        {
+            SnapshotBytes += static_cast<int64>(Chunk.GetAllocatedSize());
+            ++NumChunks;
+
+            FISMBatchMutationResult Result = Handle.AcquireResult();
+            Result.TargetComponent = Chunk.SourceComponent;
+
+            if (Workload == EWorkload::Animation)
+            {
+                Result.WrittenFields = EISMSnapshotField::Transform;
+                const FQuat Spin(FVector::UpVector, 0.01f);
+                for (const FISMInstanceSnapshot& Instance : Chunk.Instances)
+                {
+                    FTransform Transform = Instance.Transform;
+                    Transform.SetRotation(Spin * Transform.GetRotation());
+                    Result.Streams.AddTransform(Instance.InstanceIndex, Transform);
+                }
+            }
+            else if (Workload == EWorkload::CustomData)
+            {
+                Result.WrittenFields = EISMSnapshotField::CustomData;
+                for (const FISMInstanceSnapshot& Instance : Chunk.Instances)
+                {
+                    const float Value = Instance.CustomData.Num() > 0 ? Instance.CustomData[0] : 0.0f;
+                    Result.Streams.AddCustomData(Instance.InstanceIndex, 0, Value + 1.0f);
+                }
+            }
+
+            // The sync scheduler applies inside Release
+            const uint64 ReleaseStart = FPlatformTime::Cycles64();
+            Handle.Release(MoveTemp(Result), MoveTemp(Chunk));
+            ReleaseCycles += static_cast<int64>(FPlatformTime::Cycles64() - ReleaseStart);
+        }
+
+    private:
+        bool bDirty = true;
+    };
+
+    struct FScenarioResult
+    {
+        FString   Scheduler;
+        EWorkload Workload = EWorkload::NoOp;
+        int32     NumInstances = 0;
+        int32     NumCycles = 0;
+        double    ChunksPerCycle = 0.0;
+        double    DispatchMs = 0.0;
+        double    ApplyMs = 0.0;
+        double    SnapshotBytes = 0.0;
+        double    PoolMisses = 0.0;
+        double    LatencyMs = 0.0;
+        double    MaxLatencyMs = 0.0;
+        double    LatencyTicks = 0.0;
+    };
+
+    /** Transient world with one runtime component holding NumInstances on a 100 unit grid */
+    struct FBenchmarkWorld
+    {
+        UWorld*               World = nullptr;
+        UISMRuntimeSubsystem* Subsystem = nullptr;
+        UISMRuntimeComponent* Component = nullptr;
+
+        explicit FBenchmarkWorld(int32 NumInstances)
+        {
+            World = UWorld::CreateWorld(EWorldType::Game, false);
+            check(World);
+            Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+            check(Subsystem);
+
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.ObjectFlags = RF_Transient;
+            AActor* Owner = World->SpawnActor<AActor>(SpawnParams);
+            check(Owner);
+
+            UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Owner, NAME_None, RF_Transient);
+            Owner->AddInstanceComponent(ISM);
+            ISM->RegisterComponent();
+
+            Component = NewObject<UISMRuntimeComponent>(Owner, NAME_None, RF_Transient);
+            Component->ManagedISMComponent = ISM;
+            Owner->AddInstanceComponent(Component);
+            Component->RegisterComponent();
+            Component->InitializeInstances();
+
+            const int32 Side = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumInstances))));
+            TArray<FTransform> Transforms;
+            Transforms.Reserve(NumInstances);
+            for (int32 i = 0; i < NumInstances; ++i)
+            {
+                Transforms.Add(FTransform(FVector((i % Side) * 100.0f, (i / Side) * 100.0f, 0.0f)));
+            }
+            Component->BatchAddInstances(Transforms, false, true);
+            Component->SetCustomDataCount(1, true, 0.0f);
+        }
+
+        ~FBenchmarkWorld()
+        {
+            if (World)
+            {
+                World->DestroyWorld(false);
+            }
+        }
+    };
+
+    FScenarioResult RunScenario(FBenchmarkWorld& Bench, bool bAsync, EWorkload Workload, int32 NumWarmup, int32 NumMeasured)
+    {
+        FScenarioResult Out;
+        Out.Scheduler = bAsync ? TEXT("Async") : TEXT("Sync");
+        Out.Workload = Workload;
+        Out.NumInstances = Bench.Component->GetInstanceCount();
+
+        UISMBatchSchedulerBase* Scheduler = bAsync
+            ? static_cast<UISMBatchSchedulerBase*>(NewObject<UISMBatchScheduler>(Bench.Subsystem))
+            : static_cast<UISMBatchSchedulerBase*>(NewObject<UISMBatchSchedulerSync>(Bench.Subsystem));
+        Scheduler->Initialize(Bench.Subsystem);
+
+        FBenchmarkTransformer Transformer;
+        Transformer.TargetComponent = Bench.Component;
+        Transformer.Workload = Workload;
+        Scheduler->RegisterTransformer(&Transformer);
+
+        const FISMBatchBufferPool* Pool = Scheduler->GetBufferPool();
+
+        for (int32 Cycle = 0; Cycle < NumWarmup + NumMeasured; ++Cycle)
+        {
+            const bool bMeasured = Cycle >= NumWarmup;
+            Transformer.ResetCounters();
+            Transformer.SetDirty();
+
+            const int32 CompletesBefore = Transformer.CompleteCount;
+            const uint64 MissesBefore = Pool ? Pool->GetNumLeaseMisses() : 0;
+            const double StartTime = FPlatformTime::Seconds();
+
+            double DispatchMs = 0.0;
+            double ApplyMs = 0.0;
+            int32  NumTicks = 0;
+
+            // Tick like frames until the cycle is applied; async chunks run on workers meanwhile
+            do
+            {
+                const double TickStart = FPlatformTime::Seconds();
+                Scheduler->Tick(0.016f);
+                const double TickMs = (FPlatformTime::Seconds() - TickStart) * 1000.0;
+                ++NumTicks;
+
+                if (bAsync)
+                {
+                    const FISMBatchSchedulerStats Stats = Scheduler->GetSchedulerStats();
+                    DispatchMs += Stats.LastDispatchTimeMs;
+                    ApplyMs += Stats.LastApplyTimeMs;
+                    if (Transformer.CompleteCount == CompletesBefore)
+                    {
+                        FPlatformProcess::Sleep(0.0f);
+                    }
+                }
+                else
+                {
+                    DispatchMs += TickMs;
+                }
+            }
+            while (Transformer.CompleteCount == CompletesBefore && NumTicks < 10000);
+
+            const double LatencyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+            if (!bAsync)
+            {
+                ApplyMs = FPlatformTime::ToMilliseconds64(static_cast<uint64>(Transformer.ReleaseCycles.load()));
+            }
+
+            if (!bMeasured)
+            {
+                continue;
+            }
+
+            Out.NumCycles++;
+            Out.ChunksPerCycle += Transformer.NumChunks.load();
+            Out.DispatchMs += DispatchMs;
+            Out.ApplyMs += ApplyMs;
+            Out.SnapshotBytes += static_cast<double>(Transformer.SnapshotBytes.load());
+            Out.PoolMisses += Pool ? static_cast<double>(Pool->GetNumLeaseMisses() - MissesBefore) : 0.0;
+            Out.LatencyMs += LatencyMs;
+            Out.MaxLatencyMs = FMath::Max(Out.MaxLatencyMs, LatencyMs);
+            Out.LatencyTicks += NumTicks;
+        }
+
+        if (bAsync)
+        {
+            static_cast<UISMBatchScheduler*>(Scheduler)->FlushChunkTasks();
+        }
+        Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+        Scheduler->Deinitialize();
+
+        if (Out.NumCycles > 0)
+        {
+            const double Inv = 1.0 / Out.NumCycles;
+            Out.ChunksPerCycle *= Inv;
+            Out.DispatchMs *= Inv;
+            Out.ApplyMs *= Inv;
+            Out.SnapshotBytes *= Inv;
+            Out.PoolMisses *= Inv;
+            Out.LatencyMs *= Inv;
+            Out.LatencyTicks *= Inv;
+        }
+        return Out;
+    }
+
+    void WriteReport(const TArray<FScenarioResult>& Results, int32 NumInstances, FAutomationTestBase& Test)
+    {
+        FString Csv = TEXT("Scheduler,Workload,Instances,Cycles,ChunksPerCycle,DispatchMs,ApplyMs,SnapshotBytes,PoolMisses,LatencyMs,MaxLatencyMs,LatencyTicks\n");
+        FString Json = TEXT("[\n");
+
+        for (int32 Idx = 0; Idx < Results.Num(); ++Idx)
+        {
+            const FScenarioResult& R = Results[Idx];
+            Csv += FString::Printf(TEXT("%s,%s,%d,%d,%.1f,%.3f,%.3f,%.0f,%.1f,%.3f,%.3f,%.1f\n"),
+                *R.Scheduler, WorkloadName(R.Workload), R.NumInstances, R.NumCycles, R.ChunksPerCycle,
+                R.DispatchMs, R.ApplyMs, R.SnapshotBytes, R.PoolMisses, R.LatencyMs, R.MaxLatencyMs, R.LatencyTicks);
+
+            Json += FString::Printf(TEXT("  {\"scheduler\": \"%s\", \"workload\": \"%s\", \"instances\": %d, \"cycles\": %d, ")
+                TEXT("\"chunks_per_cycle\": %.1f, \"dispatch_ms\": %.3f, \"apply_ms\": %.3f, \"snapshot_bytes\": %.0f, ")
+                TEXT("\"pool_misses\": %.1f, \"latency_ms\": %.3f, \"max_latency_ms\": %.3f, \"latency_ticks\": %.1f}%s\n"),
+                *R.Scheduler, WorkloadName(R.Workload), R.NumInstances, R.NumCycles, R.ChunksPerCycle,
+                R.DispatchMs, R.ApplyMs, R.SnapshotBytes, R.PoolMisses, R.LatencyMs, R.MaxLatencyMs, R.LatencyTicks,
+                Idx + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+
+            Test.AddInfo(FString::Printf(TEXT("%s/%s %d: dispatch %.3fms, apply %.3fms, snapshot %.0f bytes, %.1f pool misses, latency %.3fms over %.1f ticks"),
+                *R.Scheduler, WorkloadName(R.Workload), R.NumInstances, R.DispatchMs, R.ApplyMs, R.SnapshotBytes,
+                R.PoolMisses, R.LatencyMs, R.LatencyTicks));
+        }
+        Json += TEXT("]\n");
+
+        const FString Dir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("ISMBatchBenchmarks"));
+        const FString BaseName = FPaths::Combine(Dir, FString::Printf(TEXT("%d"), NumInstances));
+        if (!FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv"))) ||
+            !FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json"))))
+        {
+            Test.AddWarning(FString::Printf(TEXT("Could not write benchmark report to %s"), *Dir));
+        }
+    }
+
+    bool RunSuite(FAutomationTestBase& Test, int32 NumInstances, int32 NumMeasured)
+    {
+        FBenchmarkWorld Bench(NumInstances);
+        if (!Test.TestEqual(TEXT("Benchmark component populated"), Bench.Component->GetInstanceCount(), NumInstances))
+        {
+            return false;
+        }
+
+        TArray<FScenarioResult> Results;
+        for (bool bAsync : { false, true })
+        {
+            for (EWorkload Workload : { EWorkload::NoOp, EWorkload::Animation, EWorkload::CustomData })
+            {
+                FScenarioResult Result = RunScenario(Bench, bAsync, Workload, 2, NumMeasured);
+                Test.TestEqual(FString::Printf(TEXT("%s/%s completed every cycle"), *Result.Scheduler, WorkloadName(Workload)),
+                    Result.NumCycles, NumMeasured);
+                Results.Add(MoveTemp(Result));
+            }
+        }
+
+        WriteReport(Results, NumInstances, Test);
+        return true;
+    }
+}
+
+
+// ============================================================
+//  Benchmarks
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Benchmark_10k,
+    "ISMRuntime.Batch.Benchmark.10k",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FISMBatch_Benchmark_10k::RunTest(const FString& Parameters)
+{
+    return ISMBatchBenchmark::RunSuite(*this, 10000, 16);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Benchmark_100k,
+    "ISMRuntime.Batch.Benchmark.100k",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FISMBatch_Benchmark_100k::RunTest(const FString& Parameters)
+{
+    return ISMBatchBenchmark::RunSuite(*this, 100000, 8);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Benchmark_1M,
+    "ISMRuntime.Batch.Benchmark.1M",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::StressFilter)
+
+bool FISMBatch_Benchmark_1M::RunTest(const FString& Parameters)
+{
+    return ISMBatchBenchmark::RunSuite(*this, 1000000, 4);
+}
@@ -7,9 +7,21 @@
 //   3. An abandoned handle writes nothing to the component
 //   4. A mutation targeting a destroyed instance index is silently skipped
 //
-// Phase 2+ concerns (spatial chunking, slot-reuse locking, timeouts, priority)
-// are explicitly out of scope here. Each test uses a single component with all
-// instances treated as one chunk.
+// Phase 2 - Async chunking
+//   5. The async scheduler splits by cell, caps chunk size and culls by bounds
+//   6. A structure-of-arrays request fills SoA with flat per-field arrays
+//   7. Spent snapshots and applied mutation arrays are recycled across ticks
+//   8. Transform, custom data and state flag streams are applied
+//   9. State flag writes from one chunk notify listeners in a single batched event
+//  10. A result whose chunk saw a slot recycled is dropped by its generation token
+//  11. Conflicting write masks are ordered into stages and every cycle completes
+//  12. A chained consumer's async chunks are built from the upstream chunks' output
+//  13. The dispatch budget carries dirty transformers over and runs them first next tick
+//  14. Chunk relevance orders chunks nearest first and thins out far ones by update interval
+//  15. A delta-only request snapshots just the instances changed since its last dispatch
+//
+// Phase 1 tests run on the sync scheduler, where every component is one chunk.
+// Slot-reuse locking, timeouts and priority are out of scope here.
 //
 // Test infrastructure:
 //   - FISMTestTransformer  : synchronous mock transformer, configurable per-test
@@ -64,6 +76,22 @@ struct FISMTestTransformer : public IISMBatchTransformer
     EISMSnapshotField ReadMask  = EISMSnapshotField::CustomData;
     EISMSnapshotField WriteMask = EISMSnapshotField::CustomData;
 
+    /** Forwarded to the request. Defaults snapshot every cell at the scheduler's chunk cap. */
+    FBox  SpatialBounds = FBox(EForceInit::ForceInit);
+    int32 MaxInstancesPerChunkOverride = 0;
+    bool  bStructureOfArrays = false;
+
+    /** Release through the pooled path: leased result, snapshot handed back */
+    bool bRecycleBuffers = false;
+
+    /** Registry identity and ordering; give each transformer in a multi-transformer test its own name */
+    FName Name = FName("ISMBatchTest.MockTransformer");
+    int32 Priority = 0;
+    FName ConsumesOutputOf;
+    bool  bUseChunkRelevance = false;
+    FISMChunkRelevanceFunction ChunkRelevance;
+    bool  bDeltaOnly = false;
+
     /**
      * Called once per chunk received. Return the result to submit, or an empty
      * FISMBatchMutationResult with no mutations to simulate abandonment via Release.
@@ -76,14 +104,19 @@ struct FISMTestTransformer : public IISMBatchTransformer
     TArray<FISMBatchSnapshot> ReceivedChunks;
     int32 AbandonCount  = 0;
     int32 ReleaseCount  = 0;
+    int32 CompleteCount = 0;
 
     // ----- IISMBatchTransformer -----
 
     virtual FName GetTransformerName() const override
     {
-        return FName("ISMBatchTest.MockTransformer");
+        return Name;
     }
 
+    virtual int32 GetPriority() const override { return Priority; }
+
+    virtual void OnRequestComplete() override { CompleteCount++; }
+
     virtual bool IsDirty() const override { return bDirty; }
 
     virtual void ClearDirty() override { bDirty = false; }
@@ -97,7 +130,13 @@ struct FISMTestTransformer : public IISMBatchTransformer
         }
         Request.ReadMask  = ReadMask;
         Request.WriteMask = WriteMask;
-        // No spatial bounds = snapshot all cells (Phase 1: treated as one chunk)
+        Request.SpatialBounds = SpatialBounds;
+        Request.MaxInstancesPerChunkOverride = MaxInstancesPerChunkOverride;
+        Request.bStructureOfArrays = bStructureOfArrays;
+        Request.ConsumesOutputOf = ConsumesOutputOf;
+        Request.bUseChunkRelevance = bUseChunkRelevance;
+        Request.ChunkRelevance = ChunkRelevance;
+        Request.bDeltaOnly = bDeltaOnly;
         return Request;
     }
 
@@ -105,7 +144,16 @@ struct FISMTestTransformer : public IISMBatchTransformer
     {
         ReceivedChunks.Add(Chunk);
 
-        if (ResultBuilder)
+        if (ResultBuilder && bRecycleBuffers)
+        {
+            FISMBatchMutationResult Built = ResultBuilder(Chunk);
+            FISMBatchMutationResult Result = Handle.AcquireResult(Chunk.Num());
+            Result.WrittenFields = Built.WrittenFields;
+            Result.Mutations.Append(Built.Mutations);
+            Handle.Release(MoveTemp(Result), MoveTemp(Chunk));
+            ReleaseCount++;
+        }
+        else if (ResultBuilder)
         {
             FISMBatchMutationResult Result = ResultBuilder(Chunk);
             Handle.Release(MoveTemp(Result));
@@ -126,6 +174,7 @@ struct FISMTestTransformer : public IISMBatchTransformer
         ReceivedChunks.Reset();
         AbandonCount = 0;
         ReleaseCount = 0;
+        CompleteCount = 0;
         bDirty       = true;
         ResultBuilder = nullptr;
     }
@@ -477,4 +526,865 @@ bool FISMBatch_Test_DestroyedInstanceSkipped::RunTest(const FString& Parameters)
 
     F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
     return true;
-}
\ No newline at end of file
+}
+
+
+// ============================================================
+//  Test 5: Async scheduler chunks by cell, cap and bounds
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_AsyncChunksSplitByCell,
+    "ISMRuntime.Batch.Phase2.AsyncChunksSplitByCellAndCap",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_AsyncChunksSplitByCell::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+
+    // Default 1000 cell size: five instances in cell 0, two in cell 5, one in cell -5
+    TArray<FTransform> Transforms;
+    for (int32 i = 0; i < 5; ++i)
+    {
+        Transforms.Add(FTransform(FVector(i * 100.0f, 0.0f, 0.0f)));
+    }
+    Transforms.Add(FTransform(FVector(5000.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(5100.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(-5000.0f, 0.0f, 0.0f)));
+    const TArray<int32> Indices = F.RuntimeComponent->BatchAddInstances(Transforms, false, true);
+    const int32 CulledIndex = Indices.Last();
+
+    UISMBatchScheduler* AsyncScheduler = NewObject<UISMBatchScheduler>(F.Subsystem);
+    AsyncScheduler->Initialize(F.Subsystem);
+    // One chunk in flight at a time keeps the mock transformer single-threaded
+    AsyncScheduler->Settings.MaxConcurrentChunks = 1;
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.MaxInstancesPerChunkOverride = 2;
+    Transformer.SpatialBounds = FBox(FVector(-100.0f, -100.0f, -100.0f), FVector(6000.0f, 100.0f, 100.0f));
+    Transformer.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    AsyncScheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    AsyncScheduler->Tick(0.016f);
+    TestFalse(TEXT("Outstanding chunks do not batch lock the component"), F.RuntimeComponent->IsBatchLocked());
+    AsyncScheduler->FlushChunkTasks();
+
+    // ----- Assert -----
+
+    // Cell 0 splits 2 + 2 + 1, cell 5 is one chunk of 2, cell -5 is culled
+    TestEqual(TEXT("Four chunks issued"), Transformer.ReceivedChunks.Num(), 4);
+    TestEqual(TEXT("Every chunk released"), Transformer.ReleaseCount, 4);
+
+    int32 TotalInstances = 0;
+    for (const FISMBatchSnapshot& Chunk : Transformer.ReceivedChunks)
+    {
+        TestTrue(TEXT("Chunk respects the override cap"), Chunk.Instances.Num() <= 2);
+        TotalInstances += Chunk.Instances.Num();
+
+        for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+        {
+            TestNotEqual(TEXT("Instance outside the bounds is not snapshotted"), InstSnap.InstanceIndex, CulledIndex);
+            const FIntVector ExpectedCell = InstSnap.InstanceIndex == Indices[5] || InstSnap.InstanceIndex == Indices[6]
+                ? FIntVector(5, 0, 0)
+                : FIntVector::ZeroValue;
+            TestEqual(TEXT("Instance is chunked with its cell"), Chunk.CellCoordinates, ExpectedCell);
+        }
+    }
+    TestEqual(TEXT("All in-bounds instances covered"), TotalInstances, 7);
+
+    TestEqual(TEXT("Nothing left pending"), AsyncScheduler->GetPendingResultCount(), 0);
+
+    AsyncScheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    AsyncScheduler->Deinitialize();
+    return true;
+}
+
+
+// ============================================================
+//  Test 6: Structure-of-arrays snapshot layout
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_StructureOfArraysSnapshot,
+    "ISMRuntime.Batch.Phase2.StructureOfArraysSnapshot",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_StructureOfArraysSnapshot::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    const TArray<int32> Indices = F.AddInstances(3, /*CustomDataValue=*/4.0f);
+    F.RuntimeComponent->SetInstanceCustomDataValue(Indices[2], 0, 6.0f);
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent    = F.RuntimeComponent;
+    Transformer.ReadMask           = EISMSnapshotField::Transform | EISMSnapshotField::CustomData;
+    Transformer.bStructureOfArrays = true;
+    Transformer.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    F.Scheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    F.Tick();
+
+    // ----- Assert -----
+    if (!TestEqual(TEXT("One chunk"), Transformer.ReceivedChunks.Num(), 1))
+    {
+        return false;
+    }
+
+    const FISMBatchSnapshot& Chunk = Transformer.ReceivedChunks[0];
+    const FISMInstanceSoASnapshot& SoA = Chunk.SoA;
+
+    TestEqual(TEXT("Per-instance array left empty"), Chunk.Instances.Num(), 0);
+    TestEqual(TEXT("Chunk counts SoA instances"), Chunk.Num(), 3);
+    TestEqual(TEXT("Locations sized to the chunk"), SoA.Locations.Num(), 3);
+    TestEqual(TEXT("Rotations sized to the chunk"), SoA.Rotations.Num(), 3);
+    TestEqual(TEXT("Scales sized to the chunk"), SoA.Scales.Num(), 3);
+    TestEqual(TEXT("State flags not read"), SoA.StateFlags.Num(), 0);
+    TestTrue(TEXT("Stride covers the custom data slot"), SoA.CustomDataStride >= 1);
+    TestEqual(TEXT("Flat custom data buffer"), SoA.CustomData.Num(), 3 * SoA.CustomDataStride);
+
+    for (int32 i = 0; i < SoA.Num(); ++i)
+    {
+        const int32 InstanceIndex = SoA.InstanceIndices[i];
+        TestTrue(TEXT("Location matches the component"),
+            SoA.Locations[i].Equals(F.RuntimeComponent->GetInstanceLocation(InstanceIndex)));
+        TestEqual(TEXT("Custom data row matches the component"),
+            SoA.GetCustomData(i)[0], F.RuntimeComponent->GetInstanceCustomDataValue(InstanceIndex, 0));
+    }
+
+    F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    return true;
+}
+
+
+// ============================================================
+//  Test 7: Snapshot and mutation buffers are recycled
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_BuffersRecycled,
+    "ISMRuntime.Batch.Phase2.BuffersRecycledAcrossTicks",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_BuffersRecycled::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    const TArray<int32> Indices = F.AddInstances(3, /*CustomDataValue=*/1.0f);
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.bRecycleBuffers = true;
+    Transformer.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.WrittenFields = EISMSnapshotField::CustomData;
+        for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+        {
+            FISMInstanceMutation& Mutation = Result.Mutations.AddDefaulted_GetRef();
+            Mutation.InstanceIndex = InstSnap.InstanceIndex;
+            Mutation.CustomDataSlotOverrides.Add(MakeTuple(0, InstSnap.CustomData[0] + 1.0f));
+        }
+        return Result;
+    };
+
+    F.Scheduler->RegisterTransformer(&Transformer);
+    const FISMBatchBufferPool* Pool = F.Scheduler->GetBufferPool();
+    if (!TestNotNull(TEXT("Scheduler owns a buffer pool"), Pool))
+    {
+        return false;
+    }
+
+    // ----- Act -----
+    F.Tick();
+    const int32 SnapshotsAfterFirst = Pool->GetNumFreeSnapshotBuffers();
+    const int32 MutationsAfterFirst = Pool->GetNumFreeMutationBuffers();
+
+    Transformer.SetDirty();
+    F.Tick();
+
+    // ----- Assert -----
+    TestEqual(TEXT("Spent snapshot returned to the pool"), SnapshotsAfterFirst, 1);
+    TestEqual(TEXT("Applied mutation array returned to the pool"), MutationsAfterFirst, 1);
+
+    // Second tick leased both back out and returned them - the pool did not grow
+    TestEqual(TEXT("Snapshot storage reused"), Pool->GetNumFreeSnapshotBuffers(), 1);
+    TestEqual(TEXT("Mutation storage reused"), Pool->GetNumFreeMutationBuffers(), 1);
+
+    // Recycled entries must not leak the previous chunk's values
+    TestEqual(TEXT("Two chunks seen"), Transformer.ReceivedChunks.Num(), 2);
+    for (int32 Idx : Indices)
+    {
+        TestEqual(TEXT("Both cycles applied"), F.RuntimeComponent->GetInstanceCustomDataValue(Idx, 0), 3.0f);
+    }
+
+    F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    return true;
+}
+
+
+// ============================================================
+//  Test 8: Mutation streams are applied
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_MutationStreamsApplied,
+    "ISMRuntime.Batch.Phase2.MutationStreamsApplied",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_MutationStreamsApplied::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    const TArray<int32> Indices = F.AddInstances(3, /*CustomDataValue=*/1.0f);
+    F.RuntimeComponent->SetInstanceState(Indices[2], EISMInstanceState::Hidden, true);
+
+    const FVector MovedLocation(0.0f, 500.0f, 0.0f);
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.WriteMask = EISMSnapshotField::Transform | EISMSnapshotField::CustomData | EISMSnapshotField::StateFlags;
+    Transformer.ResultBuilder = [&](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        Result.WrittenFields = Transformer.WriteMask;
+        Result.Streams.AddTransform(Indices[0], FTransform(MovedLocation));
+        Result.Streams.AddCustomData(Indices[1], 0, 42.0f);
+        Result.Streams.AddStateFlags(Indices[2], static_cast<uint8>(EISMInstanceState::Damaged), static_cast<uint8>(EISMInstanceState::Hidden));
+        return Result;
+    };
+
+    F.Scheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    F.Tick();
+
+    // ----- Assert -----
+    TestTrue(TEXT("Transform stream moved the instance"),
+        F.RuntimeComponent->GetInstanceLocation(Indices[0]).Equals(MovedLocation));
+    TestEqual(TEXT("Custom data stream wrote the slot"),
+        F.RuntimeComponent->GetInstanceCustomDataValue(Indices[1], 0), 42.0f);
+    TestEqual(TEXT("Untouched instance keeps its data"),
+        F.RuntimeComponent->GetInstanceCustomDataValue(Indices[0], 0), 1.0f);
+    TestTrue(TEXT("Set mask raised the flag"),
+        F.RuntimeComponent->IsInstanceInState(Indices[2], EISMInstanceState::Damaged));
+    TestFalse(TEXT("Clear mask lowered the flag"),
+        F.RuntimeComponent->IsInstanceInState(Indices[2], EISMInstanceState::Hidden));
+
+    F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    return true;
+}
+
+
+// ============================================================
+//  Test 9: State changes are batched per chunk
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_StateChangesBatchedPerChunk,
+    "ISMRuntime.Batch.Phase2.StateChangesBatchedPerChunk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_StateChangesBatchedPerChunk::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    const TArray<int32> Indices = F.AddInstances(4, /*CustomDataValue=*/0.0f);
+
+    const uint8 Damaged = static_cast<uint8>(EISMInstanceState::Damaged);
+    const uint8 DamagedFlags = F.RuntimeComponent->GetInstanceStateFlags(Indices[0]) | Damaged;
+
+    int32 BatchBroadcasts = 0;
+    TArray<int32> BatchedInstances;
+    F.RuntimeComponent->OnBatchInstanceStatesChangedNative.AddLambda(
+        [&](UISMRuntimeComponent*, const TArray<int32>& Changed)
+        {
+            ++BatchBroadcasts;
+            BatchedInstances = Changed;
+        });
+
+    int32 NativeInstanceBroadcasts = 0;
+    F.RuntimeComponent->OnInstanceStateChangedNative.AddLambda(
+        [&](UISMRuntimeComponent*, int32) { ++NativeInstanceBroadcasts; });
+
+    int32 ChangedBatchBroadcasts = 0;
+    TArray<int32> ChangedBatchInstances;
+    F.RuntimeComponent->OnInstancesChangedBatchNative.AddLambda(
+        [&](UISMRuntimeComponent*, TArrayView<const int32> Changed)
+        {
+            ++ChangedBatchBroadcasts;
+            ChangedBatchInstances = TArray<int32>(Changed);
+        });
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.WriteMask = EISMSnapshotField::StateFlags;
+    Transformer.ResultBuilder = [&](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        Result.WrittenFields = Transformer.WriteMask;
+
+        // Two whole-byte writes, a stream write repeating one of them, and one no-op
+        for (int32 i = 0; i < 2; i++)
+        {
+            FISMInstanceMutation Mutation;
+            Mutation.InstanceIndex = Indices[i];
+            Mutation.NewStateFlags = DamagedFlags;
+            Result.Mutations.Add(Mutation);
+        }
+        Result.Streams.AddStateFlags(Indices[1], static_cast<uint8>(EISMInstanceState::Reserved1), 0);
+        Result.Streams.AddStateFlags(Indices[2], 0, static_cast<uint8>(EISMInstanceState::Converting));
+        return Result;
+    };
+
+    F.Scheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    F.Tick();
+
+    // ----- Assert -----
+    TestEqual(TEXT("One batched event for the chunk"), BatchBroadcasts, 1);
+    TestEqual(TEXT("Batched event lists each changed instance once"), BatchedInstances, TArray<int32>{ Indices[0], Indices[1] });
+    TestEqual(TEXT("Per-instance native events fold into the batch event"), NativeInstanceBroadcasts, 0);
+    TestEqual(TEXT("One changed-instances event for the chunk"), ChangedBatchBroadcasts, 1);
+    TestEqual(TEXT("Changed-instances event matches the state batch"), ChangedBatchInstances, BatchedInstances);
+    TestTrue(TEXT("Whole-byte write applied"),
+        F.RuntimeComponent->IsInstanceInState(Indices[0], EISMInstanceState::Damaged));
+    TestTrue(TEXT("Repeated writes compose"),
+        F.RuntimeComponent->IsInstanceInState(Indices[1], EISMInstanceState::Damaged)
+        && F.RuntimeComponent->IsInstanceInState(Indices[1], EISMInstanceState::Reserved1));
+    TestEqual(TEXT("Untouched instance keeps its flags"),
+        F.RuntimeComponent->GetInstanceStateFlags(Indices[3]), F.RuntimeComponent->GetInstanceStateFlags(Indices[2]));
+
+    F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    return true;
+}
+
+
+// ============================================================
+//  Test 10: Stale generation token drops the result
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_StaleGenerationDropped,
+    "ISMRuntime.Batch.Phase2.StaleGenerationResultDropped",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_StaleGenerationDropped::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    F.RuntimeComponent->bRecycleDestroyedInstances = true;
+    const TArray<int32> Indices = F.AddInstances(3, /*CustomDataValue=*/1.0f);
+    const int32 RecycledIndex = Indices[1];
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.ResultBuilder = [&](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        // Slot reuse while the chunk is out: the snapshot's index 1 is now another instance
+        F.RuntimeComponent->DestroyInstance(RecycledIndex);
+        F.RuntimeComponent->AddInstance(FTransform(FVector(0.0f, 800.0f, 0.0f)));
+
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        Result.WrittenFields = EISMSnapshotField::CustomData;
+        for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+        {
+            FISMInstanceMutation Mutation;
+            Mutation.InstanceIndex = InstSnap.InstanceIndex;
+            Mutation.NewCustomData = TArray<float>{ 9.0f };
+            Result.Mutations.Add(Mutation);
+        }
+        return Result;
+    };
+
+    F.Scheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    F.Tick();
+
+    // ----- Assert -----
+    TestEqual(TEXT("Chunk was released"), Transformer.ReleaseCount, 1);
+    TestEqual(TEXT("Slot was recycled"), F.RuntimeComponent->GetInstanceCount(), 3);
+    TestEqual(TEXT("Recycled occupant is not written"),
+        F.RuntimeComponent->GetInstanceCustomDataValue(RecycledIndex, 0), 0.0f);
+    TestEqual(TEXT("Stale result dropped whole"),
+        F.RuntimeComponent->GetInstanceCustomDataValue(Indices[0], 0), 1.0f);
+
+    F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    return true;
+}
+
+
+// ============================================================
+//  Test 11: Conflicting write masks are staged
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_ConflictingMasksStaged,
+    "ISMRuntime.Batch.Phase2.ConflictingMasksStaged",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_ConflictingMasksStaged::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    const TArray<int32> Indices = F.AddInstances(3, /*CustomDataValue=*/1.0f);
+
+    auto WriteCustomData = [](float Value)
+    {
+        return [Value](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+        {
+            FISMBatchMutationResult Result;
+            Result.TargetComponent = Chunk.SourceComponent;
+            Result.WrittenFields = EISMSnapshotField::CustomData;
+            for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+            {
+                Result.Streams.AddCustomData(InstSnap.InstanceIndex, 0, Value);
+            }
+            return Result;
+        };
+    };
+
+    // Writer and Reader both touch custom data; Flagger only touches state flags
+    FISMTestTransformer Writer;
+    Writer.Name = FName("ISMBatchTest.Writer");
+    Writer.Priority = 2;
+    Writer.TargetComponent = F.RuntimeComponent;
+    Writer.ResultBuilder = WriteCustomData(4.0f);
+
+    FISMTestTransformer Reader;
+    Reader.Name = FName("ISMBatchTest.Reader");
+    Reader.Priority = 1;
+    Reader.TargetComponent = F.RuntimeComponent;
+    Reader.WriteMask = EISMSnapshotField::Transform;
+    Reader.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    FISMTestTransformer Flagger;
+    Flagger.Name = FName("ISMBatchTest.Flagger");
+    Flagger.TargetComponent = F.RuntimeComponent;
+    Flagger.ReadMask = EISMSnapshotField::StateFlags;
+    Flagger.WriteMask = EISMSnapshotField::StateFlags;
+    Flagger.ResultBuilder = Reader.ResultBuilder;
+
+    F.Scheduler->RegisterTransformer(&Writer);
+    F.Scheduler->RegisterTransformer(&Reader);
+    F.Scheduler->RegisterTransformer(&Flagger);
+
+    // ----- Act -----
+    F.Tick();
+
+    // ----- Assert -----
+    TestEqual(TEXT("Writer runs in the first stage"), F.Scheduler->GetTransformerStage(Writer.Name), 0);
+    TestEqual(TEXT("Reader waits for the writer"), F.Scheduler->GetTransformerStage(Reader.Name), 1);
+    TestEqual(TEXT("Disjoint transformer is not held back"), F.Scheduler->GetTransformerStage(Flagger.Name), 0);
+
+    if (TestEqual(TEXT("Reader got one chunk"), Reader.ReceivedChunks.Num(), 1))
+    {
+        for (const FISMInstanceSnapshot& InstSnap : Reader.ReceivedChunks[0].Instances)
+        {
+            TestEqual(TEXT("Reader sees the writer's output"), InstSnap.CustomData[0], 4.0f);
+        }
+    }
+
+    // Sync chunks resolve during dispatch; their cycles must still complete
+    TestEqual(TEXT("Writer cycle completed"), Writer.CompleteCount, 1);
+    TestEqual(TEXT("Reader cycle completed"), Reader.CompleteCount, 1);
+    TestEqual(TEXT("Flagger cycle completed"), Flagger.CompleteCount, 1);
+
+    F.Scheduler->UnregisterTransformer(Writer.Name);
+    F.Scheduler->UnregisterTransformer(Reader.Name);
+    F.Scheduler->UnregisterTransformer(Flagger.Name);
+    return true;
+}
+
+
+// ============================================================
+//  Test 12: Chained consumer reuses the upstream's chunks
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_ChainedConsumer,
+    "ISMRuntime.Batch.Phase2.ChainedConsumerUsesUpstreamOutput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_ChainedConsumer::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+
+    // Two cells of two instances each
+    TArray<FTransform> Transforms;
+    Transforms.Add(FTransform(FVector(0.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(100.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(5000.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(5100.0f, 0.0f, 0.0f)));
+    const TArray<int32> Indices = F.RuntimeComponent->BatchAddInstances(Transforms, false, true);
+    F.RuntimeComponent->SetCustomDataCount(1, true, 0.0f);
+    for (int32 Idx : Indices)
+    {
+        F.RuntimeComponent->SetInstanceCustomDataValue(Idx, 0, 1.0f);
+    }
+
+    UISMBatchScheduler* AsyncScheduler = NewObject<UISMBatchScheduler>(F.Subsystem);
+    AsyncScheduler->Initialize(F.Subsystem);
+    // One chunk in flight at a time keeps the mock transformers single-threaded
+    AsyncScheduler->Settings.MaxConcurrentChunks = 1;
+
+    // Upstream hands its snapshot back so the consumer's chunk is patched rather than re-read
+    FISMTestTransformer Density;
+    Density.Name = FName("ISMBatchTest.Density");
+    Density.Priority = 1;
+    Density.TargetComponent = F.RuntimeComponent;
+    Density.bRecycleBuffers = true;
+    Density.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.WrittenFields = EISMSnapshotField::CustomData;
+        for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+        {
+            FISMInstanceMutation& Mutation = Result.Mutations.AddDefaulted_GetRef();
+            Mutation.InstanceIndex = InstSnap.InstanceIndex;
+            Mutation.CustomDataSlotOverrides.Add(MakeTuple(0, InstSnap.CustomData[0] + 1.0f));
+        }
+        return Result;
+    };
+
+    FISMTestTransformer Animation;
+    Animation.Name = FName("ISMBatchTest.Animation");
+    Animation.TargetComponent = F.RuntimeComponent;
+    Animation.ConsumesOutputOf = Density.Name;
+    Animation.ReadMask = EISMSnapshotField::CustomData | EISMSnapshotField::Transform;
+    Animation.WriteMask = EISMSnapshotField::Transform;
+    Animation.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    AsyncScheduler->RegisterTransformer(&Density);
+    AsyncScheduler->RegisterTransformer(&Animation);
+
+    // ----- Act -----
+    AsyncScheduler->Tick(0.016f);
+    AsyncScheduler->FlushChunkTasks();
+
+    // ----- Assert -----
+    TestEqual(TEXT("Consumer is staged after its upstream"), AsyncScheduler->GetTransformerStage(Animation.Name), 1);
+    TestEqual(TEXT("Upstream chunked per cell"), Density.ReceivedChunks.Num(), 2);
+    TestEqual(TEXT("One consumer chunk per upstream chunk"), Animation.ReceivedChunks.Num(), 2);
+
+    for (int32 i = 0; i < Animation.ReceivedChunks.Num() && i < Density.ReceivedChunks.Num(); ++i)
+    {
+        const FISMBatchSnapshot& Chunk = Animation.ReceivedChunks[i];
+        TestEqual(TEXT("Consumer chunk follows the upstream split"), Chunk.Num(), Density.ReceivedChunks[i].Num());
+        TestTrue(TEXT("Upstream read the consumer's fields"), EnumHasAllFlags(Chunk.PopulatedFields, Animation.ReadMask));
+        for (const FISMInstanceSnapshot& InstSnap : Chunk.Instances)
+        {
+            TestEqual(TEXT("Consumer sees the upstream's output"), InstSnap.CustomData[0], 2.0f);
+        }
+    }
+
+    TestEqual(TEXT("Upstream cycle completed"), Density.CompleteCount, 1);
+    TestEqual(TEXT("Consumer cycle completed"), Animation.CompleteCount, 1);
+    TestEqual(TEXT("Nothing left pending"), AsyncScheduler->GetPendingResultCount(), 0);
+
+    AsyncScheduler->UnregisterTransformer(Density.Name);
+    AsyncScheduler->UnregisterTransformer(Animation.Name);
+    AsyncScheduler->Deinitialize();
+    return true;
+}
+
+
+// ============================================================
+//  Test 13: Dispatch budget carries transformers over
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_DispatchBudgetCarryOver,
+    "ISMRuntime.Batch.Phase2.DispatchBudgetCarriesOver",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_DispatchBudgetCarryOver::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    F.AddInstances(3, /*CustomDataValue=*/1.0f);
+
+    // Any dispatch overruns this, so exactly one transformer goes per tick
+    F.Scheduler->Settings.DispatchBudgetMs = 0.000001f;
+
+    auto EmptyResult = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    // Disjoint masks keep both in stage 0
+    FISMTestTransformer High;
+    High.Name = FName("ISMBatchTest.High");
+    High.Priority = 1;
+    High.TargetComponent = F.RuntimeComponent;
+    High.ResultBuilder = EmptyResult;
+
+    FISMTestTransformer Low;
+    Low.Name = FName("ISMBatchTest.Low");
+    Low.TargetComponent = F.RuntimeComponent;
+    Low.ReadMask = EISMSnapshotField::StateFlags;
+    Low.WriteMask = EISMSnapshotField::StateFlags;
+    Low.ResultBuilder = EmptyResult;
+
+    F.Scheduler->RegisterTransformer(&High);
+    F.Scheduler->RegisterTransformer(&Low);
+
+    // ----- Act -----
+    F.Tick();
+    const int32 HighAfterFirst = High.ReceivedChunks.Num();
+    const int32 LowAfterFirst = Low.ReceivedChunks.Num();
+    const FISMBatchSchedulerStats StatsAfterFirst = F.Scheduler->GetSchedulerStats();
+
+    High.SetDirty();
+    F.Tick();
+
+    // ----- Assert -----
+    TestEqual(TEXT("Higher priority dispatches first"), HighAfterFirst, 1);
+    TestEqual(TEXT("Over-budget transformer is deferred"), LowAfterFirst, 0);
+    TestEqual(TEXT("Deferral is reported"), StatsAfterFirst.DeferredTransformerCount, 1);
+    TestTrue(TEXT("Dispatch time is reported"), StatsAfterFirst.LastDispatchTimeMs > 0.0f);
+
+    // The carried-over transformer goes ahead of the re-dirtied higher priority one
+    TestEqual(TEXT("Carried-over transformer dispatched"), Low.ReceivedChunks.Num(), 1);
+    TestEqual(TEXT("Re-dirtied transformer now waits"), High.ReceivedChunks.Num(), 1);
+    TestTrue(TEXT("Waiting transformer stays dirty"), High.IsDirty());
+    TestEqual(TEXT("Carried-over cycle completed"), Low.CompleteCount, 1);
+
+    F.Scheduler->UnregisterTransformer(High.Name);
+    F.Scheduler->UnregisterTransformer(Low.Name);
+    return true;
+}
+
+
+// ============================================================
+//  Test 14: Distance relevance orders and thins chunks
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_ChunkRelevance,
+    "ISMRuntime.Batch.Phase2.ChunkRelevanceOrdersAndThins",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_ChunkRelevance::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+
+    // Default 1000 cell size: cells 0, 5 and -5, one instance each
+    TArray<FTransform> Transforms;
+    Transforms.Add(FTransform(FVector(0.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(5000.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(-5000.0f, 0.0f, 0.0f)));
+    const TArray<int32> Indices = F.RuntimeComponent->BatchAddInstances(Transforms, false, true);
+
+    UISMBatchScheduler* AsyncScheduler = NewObject<UISMBatchScheduler>(F.Subsystem);
+    AsyncScheduler->Initialize(F.Subsystem);
+    // One chunk in flight at a time makes launch order observable
+    AsyncScheduler->Settings.MaxConcurrentChunks = 1;
+
+    // Viewer at x = 10000: cell 5 is 4000 away, cell 0 9000, cell -5 14000
+    TSharedRef<FISMDistanceRelevance> Relevance = MakeShared<FISMDistanceRelevance>();
+    Relevance->Viewpoints.Add(FVector(10000.0f, 0.0f, 0.0f));
+    Relevance->Tiers.Add({ 6000.0f, 1 });
+    Relevance->Tiers.Add({ 12000.0f, 2 });
+    Relevance->Tiers.Add({ 100000.0f, 0 });
+    AsyncScheduler->SetChunkRelevanceFunction([Relevance](const FISMChunkRelevanceQuery& Query)
+        {
+            return Relevance->Evaluate(Query);
+        });
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.bUseChunkRelevance = true;
+    Transformer.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    AsyncScheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    TMap<FIntVector, int32> ChunksPerCell;
+    FIntVector FirstCell = FIntVector(INT32_MAX);
+    for (int32 Dispatch = 0; Dispatch < 4; ++Dispatch)
+    {
+        Transformer.SetDirty();
+        AsyncScheduler->Tick(0.016f);
+        AsyncScheduler->FlushChunkTasks();
+
+        if (Dispatch == 0 && Transformer.ReceivedChunks.Num() > 0)
+        {
+            FirstCell = Transformer.ReceivedChunks[0].CellCoordinates;
+        }
+    }
+    for (const FISMBatchSnapshot& Chunk : Transformer.ReceivedChunks)
+    {
+        ChunksPerCell.FindOrAdd(Chunk.CellCoordinates)++;
+    }
+
+    // ----- Assert -----
+    TestEqual(TEXT("Nearest chunk launches first"), FirstCell, FIntVector(5, 0, 0));
+    TestEqual(TEXT("Near cell updates every dispatch"), ChunksPerCell.FindRef(FIntVector(5, 0, 0)), 4);
+    TestEqual(TEXT("Mid cell updates every other dispatch"), ChunksPerCell.FindRef(FIntVector::ZeroValue), 2);
+    TestEqual(TEXT("Far cell is skipped"), ChunksPerCell.FindRef(FIntVector(-5, 0, 0)), 0);
+    TestEqual(TEXT("Nothing left pending"), AsyncScheduler->GetPendingResultCount(), 0);
+
+    AsyncScheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    AsyncScheduler->Deinitialize();
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_RequestChunkRelevance,
+    "ISMRuntime.Batch.Phase2.RequestChunkRelevanceOverridesScheduler",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_RequestChunkRelevance::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+
+    // Cells 0 and 5, one instance each
+    TArray<FTransform> Transforms;
+    Transforms.Add(FTransform(FVector(0.0f, 0.0f, 0.0f)));
+    Transforms.Add(FTransform(FVector(5000.0f, 0.0f, 0.0f)));
+    F.RuntimeComponent->BatchAddInstances(Transforms, false, true);
+
+    UISMBatchScheduler* AsyncScheduler = NewObject<UISMBatchScheduler>(F.Subsystem);
+    AsyncScheduler->Initialize(F.Subsystem);
+
+    // The scheduler-wide function would skip everything
+    AsyncScheduler->SetChunkRelevanceFunction([](const FISMChunkRelevanceQuery&)
+        {
+            FISMChunkRelevance Relevance;
+            Relevance.UpdateInterval = 0;
+            return Relevance;
+        });
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.bUseChunkRelevance = true;
+    Transformer.ChunkRelevance = [](const FISMChunkRelevanceQuery& Query)
+    {
+        // Only the origin cell is in this transformer's range
+        FISMChunkRelevance Relevance;
+        Relevance.UpdateInterval = Query.Cell == FIntVector::ZeroValue ? 1 : 0;
+        return Relevance;
+    };
+    Transformer.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    AsyncScheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    Transformer.SetDirty();
+    AsyncScheduler->Tick(0.016f);
+    AsyncScheduler->FlushChunkTasks();
+
+    // ----- Assert -----
+    TestEqual(TEXT("Request relevance decides which cells are planned"), Transformer.ReceivedChunks.Num(), 1);
+    if (Transformer.ReceivedChunks.Num() == 1)
+    {
+        TestEqual(TEXT("The in-range cell is the one snapshotted"), Transformer.ReceivedChunks[0].CellCoordinates, FIntVector::ZeroValue);
+    }
+
+    AsyncScheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    AsyncScheduler->Deinitialize();
+    return true;
+}
+
+// ============================================================
+//  Test 15: Delta-only snapshots carry just the changed instances
+// ============================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMBatch_Test_DeltaOnlySnapshots,
+    "ISMRuntime.Batch.Phase2.DeltaOnlySnapshots",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter)
+
+bool FISMBatch_Test_DeltaOnlySnapshots::RunTest(const FString& Parameters)
+{
+    // ----- Arrange -----
+    FISMBatchTestFixture F;
+    const TArray<int32> Indices = F.AddInstances(4, 1.0f);
+
+    FISMTestTransformer Transformer;
+    Transformer.TargetComponent = F.RuntimeComponent;
+    Transformer.bDeltaOnly = true;
+    // Reads custom data and writes nothing, so only outside changes show up
+    Transformer.WriteMask = EISMSnapshotField::None;
+    Transformer.ResultBuilder = [](const FISMBatchSnapshot& Chunk) -> FISMBatchMutationResult
+    {
+        FISMBatchMutationResult Result;
+        Result.TargetComponent = Chunk.SourceComponent;
+        return Result;
+    };
+
+    F.Scheduler->RegisterTransformer(&Transformer);
+
+    // ----- Act -----
+    F.Tick();
+    const int32 FirstNum = Transformer.ReceivedChunks.Num() > 0 ? Transformer.ReceivedChunks[0].Num() : 0;
+
+    F.RuntimeComponent->SetInstanceCustomDataValue(Indices[2], 0, 5.0f);
+    Transformer.ReceivedChunks.Reset();
+    Transformer.SetDirty();
+    F.Tick();
+    const bool bGotDelta = Transformer.ReceivedChunks.Num() == 1 && Transformer.ReceivedChunks[0].Num() == 1;
+    const int32 DeltaIndex = bGotDelta ? Transformer.ReceivedChunks[0].Instances[0].InstanceIndex : INDEX_NONE;
+
+    Transformer.ReceivedChunks.Reset();
+    Transformer.SetDirty();
+    F.Tick();
+
+    // ----- Assert -----
+    TestEqual(TEXT("First dispatch sees every instance"), FirstNum, Indices.Num());
+    TestTrue(TEXT("Second dispatch gets one chunk with one instance"), bGotDelta);
+    TestEqual(TEXT("Delta is the changed instance"), DeltaIndex, Indices[2]);
+    TestEqual(TEXT("Nothing changed, nothing dispatched"), Transformer.ReceivedChunks.Num(), 0);
+    TestEqual(TEXT("Both non-empty cycles completed"), Transformer.CompleteCount, 2);
+
+    F.Scheduler->UnregisterTransformer(Transformer.GetTransformerName());
+    return true;
+}
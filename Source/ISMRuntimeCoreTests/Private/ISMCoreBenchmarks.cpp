@@ -0,0 +1,587 @@
+// ISMCoreBenchmarks.cpp
+// Core operation benchmarks - companion to ISMSpatialIndexTests.cpp and ISMRuntimeSubsystemTests.cpp,
+// which cover correctness. ISMBatchSchedulerBenchmarks.cpp covers the batch scheduler.
+//
+// Each scenario generates a synthetic world (instance count, density in instances per hectare,
+// optional clustering) with FISMTestHelpers::GenerateClusteredLocations and a fixed seed, then times:
+//   Index.Insert / Index.Rebuild        : bulk FISMSpatialIndex construction, per instance
+//   Index.Radius / Box / KNN / Overlap  : FISMSpatialIndex queries around instance locations
+//   Component.BatchAdd                  : BatchAddInstances into a 4x4 grid of runtime components
+//   Component.TagRadius                 : compact instance tag masked radius queries
+//   Subsystem.Radius / Subsystem.Tags   : world-wide queries, unfiltered and through the component tag index
+//   Component.BatchDestroy              : BatchDestroyInstances of 10% of every component
+//
+// Results are logged and written to Saved/Automation/ISMCoreBenchmarks/<Scenario>.csv and .json.
+// When <BaselineDir>/<Scenario>.json exists, each operation's UsPerOp is compared against it and a
+// slowdown beyond the tolerance fails the test. Command line:
+//   -ISMBenchBaselineDir=<Dir>  baseline directory (default Saved/Automation/ISMCoreBenchmarks/Baseline)
+//   -ISMBenchTolerance=<Ratio>  allowed slowdown (default 0.25 = 25%)
+//   -ISMBenchUpdateBaseline     write this run's results as the new baseline
+// 10k and 100k scenarios run under the perf filter, 500k and 2M under the stress filter.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMSpatialIndex.h"
+#include "ISMQueryFilter.h"
+#include "ISMCompiledQueryFilter.h"
+#include "ISMTestHelpers.h"
+
+namespace ISMCoreBenchmark
+{
+    /** One synthetic world */
+    struct FWorldSpec
+    {
+        const TCHAR* Name = TEXT("");
+        int32 NumInstances = 0;
+
+        /** Instances per hectare (100m x 100m); sets the world's extent */
+        float Density = 100.0f;
+
+        /** 0 for a uniform spread */
+        int32 NumClusters = 0;
+        float ClusterRadius = 0.0f;
+
+        bool bStress = false;
+    };
+
+    const FWorldSpec Specs[] =
+    {
+        { TEXT("10k.Uniform"),    10000,   100.0f, 0,    0.0f,     false },
+        { TEXT("10k.Clustered"),  10000,   100.0f, 16,   5000.0f,  false },
+        { TEXT("100k.Uniform"),   100000,  100.0f, 0,    0.0f,     false },
+        { TEXT("100k.Clustered"), 100000,  100.0f, 64,   8000.0f,  false },
+        { TEXT("100k.Dense"),     100000,  2000.0f, 0,   0.0f,     false },
+        { TEXT("500k.Uniform"),   500000,  100.0f, 0,    0.0f,     true },
+        { TEXT("2M.Uniform"),     2000000, 100.0f, 0,    0.0f,     true },
+        { TEXT("2M.Clustered"),   2000000, 100.0f, 512,  10000.0f, true },
+    };
+
+    constexpr int32 Seed = 1337;
+    constexpr float CellSize = 1000.0f;
+    constexpr float QueryRadius = 2000.0f;
+    constexpr int32 NumQueries = 2000;
+    constexpr int32 NumWarmupQueries = 200;
+    constexpr int32 NumNeighbors = 16;
+    constexpr int32 TilesPerSide = 4;
+
+    /** Operations shorter than this in total are too noisy to compare against a baseline */
+    constexpr double MinComparableMs = 0.5;
+
+    struct FOpResult
+    {
+        FString Name;
+        int32   NumOps = 0;
+        int64   NumResults = 0;
+        double  TotalMs = 0.0;
+
+        double UsPerOp() const { return NumOps > 0 ? TotalMs * 1000.0 / NumOps : 0.0; }
+    };
+
+    /** Times Body, which returns the number of results it produced */
+    FOpResult Measure(const TCHAR* Name, int32 NumOps, TFunctionRef<int64()> Body)
+    {
+        FOpResult Out;
+        Out.Name = Name;
+        Out.NumOps = NumOps;
+
+        const double Start = FPlatformTime::Seconds();
+        Out.NumResults = Body();
+        Out.TotalMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+        return Out;
+    }
+
+    FBox MakeWorldBounds(const FWorldSpec& Spec)
+    {
+        const double Hectares = Spec.NumInstances / FMath::Max(Spec.Density, 1.0f);
+        const double HalfSide = 0.5 * FMath::Sqrt(Hectares) * 10000.0;
+        return FBox(FVector(-HalfSide, -HalfSide, 0.0), FVector(HalfSide, HalfSide, 500.0));
+    }
+
+    /** Transient world with a TilesPerSide x TilesPerSide grid of runtime components, alternating tree and rock tags */
+    struct FBenchmarkWorld
+    {
+        UWorld* World = nullptr;
+        UISMRuntimeSubsystem* Subsystem = nullptr;
+        TArray<UISMRuntimeComponent*> Components;
+
+        FBenchmarkWorld()
+        {
+            World = UWorld::CreateWorld(EWorldType::Game, false);
+            check(World);
+            Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+            check(Subsystem);
+
+            const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+            const FGameplayTag RockTag = FGameplayTag::RequestGameplayTag("ISM.Type.Rock");
+
+            for (int32 Tile = 0; Tile < TilesPerSide * TilesPerSide; ++Tile)
+            {
+                FActorSpawnParameters SpawnParams;
+                SpawnParams.ObjectFlags = RF_Transient;
+                AActor* Owner = World->SpawnActor<AActor>(SpawnParams);
+                check(Owner);
+
+                UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Owner, NAME_None, RF_Transient);
+                Owner->AddInstanceComponent(ISM);
+                ISM->RegisterComponent();
+
+                UISMRuntimeComponent* Component = NewObject<UISMRuntimeComponent>(Owner, NAME_None, RF_Transient);
+                Component->ManagedISMComponent = ISM;
+                Component->SpatialIndexCellSize = CellSize;
+                Component->bCompactInstanceTags = true;
+                Component->ISMComponentTags.AddTag(Tile % 2 == 0 ? TreeTag : RockTag);
+                Owner->AddInstanceComponent(Component);
+                Component->RegisterComponent();
+                Component->InitializeInstances();
+
+                Components.Add(Component);
+            }
+        }
+
+        ~FBenchmarkWorld()
+        {
+            if (World)
+            {
+                World->DestroyWorld(false);
+            }
+        }
+
+        static int32 TileOf(const FVector& Location, const FBox& Bounds)
+        {
+            const FVector Size = Bounds.GetSize();
+            const int32 X = FMath::Clamp(FMath::FloorToInt32((Location.X - Bounds.Min.X) / Size.X * TilesPerSide), 0, TilesPerSide - 1);
+            const int32 Y = FMath::Clamp(FMath::FloorToInt32((Location.Y - Bounds.Min.Y) / Size.Y * TilesPerSide), 0, TilesPerSide - 1);
+            return Y * TilesPerSide + X;
+        }
+    };
+
+    TArray<FOpResult> RunIndexOps(const TArray<FVector>& Locations, const TArray<FVector>& QueryCenters)
+    {
+        TArray<FOpResult> Results;
+
+        TArray<int32> Indices;
+        Indices.SetNumUninitialized(Locations.Num());
+        for (int32 i = 0; i < Indices.Num(); ++i)
+        {
+            Indices[i] = i;
+        }
+
+        FISMSpatialIndex Index(CellSize);
+        Results.Add(Measure(TEXT("Index.Insert"), Locations.Num(), [&]()
+            {
+                Index.AddInstances(Indices, Locations);
+                return static_cast<int64>(Index.GetTotalInstances());
+            }));
+
+        Results.Add(Measure(TEXT("Index.Rebuild"), Locations.Num(), [&]()
+            {
+                Index.Rebuild(Locations);
+                return static_cast<int64>(Index.GetTotalInstances());
+            }));
+
+        TArray<int32> Found;
+        auto RunQueries = [&](TFunctionRef<void(const FVector&)> Query)
+            {
+                int64 NumFound = 0;
+                for (int32 i = 0; i < QueryCenters.Num(); ++i)
+                {
+                    Query(QueryCenters[i]);
+                    NumFound += Found.Num();
+                }
+                return NumFound;
+            };
+
+        // Warm caches and the output array's capacity once before the first timed query pass
+        for (int32 i = 0; i < FMath::Min(NumWarmupQueries, QueryCenters.Num()); ++i)
+        {
+            Index.QueryRadiusExact(QueryCenters[i], QueryRadius, Found);
+        }
+
+        Results.Add(Measure(TEXT("Index.Radius"), QueryCenters.Num(), [&]()
+            {
+                return RunQueries([&](const FVector& Center) { Index.QueryRadiusExact(Center, QueryRadius, Found); });
+            }));
+
+        Results.Add(Measure(TEXT("Index.Box"), QueryCenters.Num(), [&]()
+            {
+                return RunQueries([&](const FVector& Center) { Index.QueryBoxExact(FBox::BuildAABB(Center, FVector(QueryRadius)), Found); });
+            }));
+
+        TArray<FISMSpatialNeighbor> Neighbors;
+        Results.Add(Measure(TEXT("Index.KNN"), QueryCenters.Num(), [&]()
+            {
+                int64 NumFound = 0;
+                for (const FVector& Center : QueryCenters)
+                {
+                    Index.FindKNearest(Center, NumNeighbors, Neighbors);
+                    NumFound += Neighbors.Num();
+                }
+                return NumFound;
+            }));
+
+        // Mostly prop-sized bounds with a few oversized instances, as a mixed level would have
+        FRandomStream Stream(Seed);
+        for (int32 i = 0; i < Locations.Num(); ++i)
+        {
+            const float Extent = (i % 100 == 0) ? 4000.0f : Stream.FRandRange(50.0f, 300.0f);
+            Index.SetInstanceBounds(i, FBox::BuildAABB(Locations[i], FVector(Extent)));
+        }
+
+        Results.Add(Measure(TEXT("Index.Overlap"), QueryCenters.Num(), [&]()
+            {
+                return RunQueries([&](const FVector& Center) { Index.QueryOverlappingBox(FBox::BuildAABB(Center, FVector(QueryRadius)), Found); });
+            }));
+
+        return Results;
+    }
+
+    TArray<FOpResult> RunWorldOps(const TArray<FVector>& Locations, const TArray<FVector>& QueryCenters, const FBox& Bounds)
+    {
+        TArray<FOpResult> Results;
+        FBenchmarkWorld Bench;
+
+        TArray<TArray<FTransform>> TileTransforms;
+        TileTransforms.SetNum(Bench.Components.Num());
+        for (const FVector& Location : Locations)
+        {
+            TileTransforms[FBenchmarkWorld::TileOf(Location, Bounds)].Add(FTransform(Location));
+        }
+
+        Results.Add(Measure(TEXT("Component.BatchAdd"), Locations.Num(), [&]()
+            {
+                int64 NumAdded = 0;
+                for (int32 Tile = 0; Tile < Bench.Components.Num(); ++Tile)
+                {
+                    Bench.Components[Tile]->BatchAddInstances(TileTransforms[Tile], true, false, false, false);
+                    NumAdded += Bench.Components[Tile]->GetInstanceCount();
+                }
+                return NumAdded;
+            }));
+
+        // A quarter of every component's instances get an instance tag
+        const FGameplayTag OakTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree.Oak");
+        TArray<FISMTagMask> OakMasks;
+        for (UISMRuntimeComponent* Component : Bench.Components)
+        {
+            TArray<int32> Tagged;
+            for (int32 i = 0; i < Component->GetInstanceCount(); i += 4)
+            {
+                Tagged.Add(i);
+            }
+            Component->BatchAddInstanceTag(Tagged, OakTag);
+
+            FGameplayTagContainer Required;
+            Required.AddTag(OakTag);
+            FISMTagFilterMasks Masks;
+            Component->GetCompactInstanceTags().BuildFilterMasks(Component->ISMComponentTags, Required, FGameplayTagContainer(), Masks);
+            OakMasks.Add(Masks.Required);
+        }
+
+        TArray<int32> QueryTiles;
+        QueryTiles.Reserve(QueryCenters.Num());
+        for (const FVector& Center : QueryCenters)
+        {
+            QueryTiles.Add(FBenchmarkWorld::TileOf(Center, Bounds));
+        }
+
+        Results.Add(Measure(TEXT("Component.TagRadius"), QueryCenters.Num(), [&]()
+            {
+                int64 NumFound = 0;
+                for (int32 i = 0; i < QueryCenters.Num(); ++i)
+                {
+                    const int32 Tile = QueryTiles[i];
+                    Bench.Components[Tile]->ForEachInstanceInRadiusWithTags(QueryCenters[i], QueryRadius, OakMasks[Tile],
+                        [&NumFound](int32) { ++NumFound; return true; });
+                }
+                return NumFound;
+            }));
+
+        TArray<FISMInstanceHandle> Handles;
+        const FISMCompiledQueryFilter Unfiltered = FISMQueryFilter().Compile();
+        Results.Add(Measure(TEXT("Subsystem.Radius"), QueryCenters.Num(), [&]()
+            {
+                int64 NumFound = 0;
+                for (const FVector& Center : QueryCenters)
+                {
+                    Handles.Reset();
+                    Bench.Subsystem->QueryInstancesInRadius(Center, QueryRadius, Unfiltered, Handles);
+                    NumFound += Handles.Num();
+                }
+                return NumFound;
+            }));
+
+        FISMQueryFilter TreeFilter;
+        TreeFilter.RequiredTags.AddTag(FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree"));
+        const FISMCompiledQueryFilter TreesOnly = TreeFilter.Compile();
+        Results.Add(Measure(TEXT("Subsystem.Tags"), QueryCenters.Num(), [&]()
+            {
+                int64 NumFound = 0;
+                for (const FVector& Center : QueryCenters)
+                {
+                    Handles.Reset();
+                    Bench.Subsystem->QueryInstancesInRadius(Center, QueryRadius, TreesOnly, Handles);
+                    NumFound += Handles.Num();
+                }
+                return NumFound;
+            }));
+
+        TArray<TArray<int32>> ToDestroy;
+        int32 NumToDestroy = 0;
+        FRandomStream Stream(Seed);
+        for (UISMRuntimeComponent* Component : Bench.Components)
+        {
+            TArray<int32>& Indices = ToDestroy.AddDefaulted_GetRef();
+            for (int32 i = 0; i < Component->GetInstanceCount(); ++i)
+            {
+                if (Stream.FRand() < 0.1f)
+                {
+                    Indices.Add(i);
+                }
+            }
+            NumToDestroy += Indices.Num();
+        }
+
+        Results.Add(Measure(TEXT("Component.BatchDestroy"), FMath::Max(NumToDestroy, 1), [&]()
+            {
+                for (int32 Tile = 0; Tile < Bench.Components.Num(); ++Tile)
+                {
+                    Bench.Components[Tile]->BatchDestroyInstances(ToDestroy[Tile], false, false);
+                }
+                return static_cast<int64>(NumToDestroy);
+            }));
+
+        return Results;
+    }
+
+    FString GetBaselineDir()
+    {
+        FString Dir;
+        if (!FParse::Value(FCommandLine::Get(), TEXT("ISMBenchBaselineDir="), Dir))
+        {
+            Dir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("ISMCoreBenchmarks"), TEXT("Baseline"));
+        }
+        return Dir;
+    }
+
+    /** UsPerOp by operation name from a report written by WriteReport; empty if there is none */
+    TMap<FString, double> LoadBaseline(const FString& Path)
+    {
+        TMap<FString, double> Baseline;
+
+        FString Json;
+        if (!FFileHelper::LoadFileToString(Json, *Path))
+        {
+            return Baseline;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Entries;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        if (!FJsonSerializer::Deserialize(Reader, Entries))
+        {
+            return Baseline;
+        }
+
+        for (const TSharedPtr<FJsonValue>& Entry : Entries)
+        {
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            FString Name;
+            double UsPerOp = 0.0;
+            if (Entry.IsValid() && Entry->TryGetObject(Object) && (*Object)->TryGetStringField(TEXT("op"), Name)
+                && (*Object)->TryGetNumberField(TEXT("us_per_op"), UsPerOp))
+            {
+                Baseline.Add(Name, UsPerOp);
+            }
+        }
+        return Baseline;
+    }
+
+    void WriteReport(const FWorldSpec& Spec, const TArray<FOpResult>& Results, const TMap<FString, double>& Baseline, FAutomationTestBase& Test)
+    {
+        FString Csv = TEXT("Scenario,Op,Instances,Ops,Results,TotalMs,UsPerOp,BaselineUsPerOp,Ratio\n");
+        FString Json = TEXT("[\n");
+
+        for (int32 Idx = 0; Idx < Results.Num(); ++Idx)
+        {
+            const FOpResult& R = Results[Idx];
+            const double* BaselineUs = Baseline.Find(R.Name);
+            const double Ratio = (BaselineUs && *BaselineUs > 0.0) ? R.UsPerOp() / *BaselineUs : 0.0;
+
+            Csv += FString::Printf(TEXT("%s,%s,%d,%d,%lld,%.3f,%.4f,%.4f,%.3f\n"),
+                Spec.Name, *R.Name, Spec.NumInstances, R.NumOps, R.NumResults, R.TotalMs, R.UsPerOp(),
+                BaselineUs ? *BaselineUs : 0.0, Ratio);
+
+            Json += FString::Printf(TEXT("  {\"scenario\": \"%s\", \"op\": \"%s\", \"instances\": %d, \"ops\": %d, \"results\": %lld, ")
+                TEXT("\"total_ms\": %.3f, \"us_per_op\": %.4f, \"baseline_us_per_op\": %.4f, \"ratio\": %.3f}%s\n"),
+                Spec.Name, *R.Name, Spec.NumInstances, R.NumOps, R.NumResults, R.TotalMs, R.UsPerOp(),
+                BaselineUs ? *BaselineUs : 0.0, Ratio, Idx + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+
+            Test.AddInfo(FString::Printf(TEXT("%s %s: %.3fms over %d ops, %.4fus per op, %lld results"),
+                Spec.Name, *R.Name, R.TotalMs, R.NumOps, R.UsPerOp(), R.NumResults));
+        }
+        Json += TEXT("]\n");
+
+        const FString Dir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("ISMCoreBenchmarks"));
+        const FString BaseName = FPaths::Combine(Dir, Spec.Name);
+        if (!FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv"))) ||
+            !FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json"))))
+        {
+            Test.AddWarning(FString::Printf(TEXT("Could not write benchmark report to %s"), *Dir));
+        }
+
+        if (FParse::Param(FCommandLine::Get(), TEXT("ISMBenchUpdateBaseline")))
+        {
+            const FString BaselinePath = FPaths::Combine(GetBaselineDir(), FString(Spec.Name) + TEXT(".json"));
+            if (!FFileHelper::SaveStringToFile(Json, *BaselinePath))
+            {
+                Test.AddWarning(FString::Printf(TEXT("Could not write benchmark baseline %s"), *BaselinePath));
+            }
+        }
+    }
+
+    void CompareToBaseline(const FWorldSpec& Spec, const TArray<FOpResult>& Results, const TMap<FString, double>& Baseline, FAutomationTestBase& Test)
+    {
+        if (Baseline.Num() == 0)
+        {
+            Test.AddInfo(FString::Printf(TEXT("%s: no baseline in %s, run with -ISMBenchUpdateBaseline to record one"), Spec.Name, *GetBaselineDir()));
+            return;
+        }
+
+        float Tolerance = 0.25f;
+        FParse::Value(FCommandLine::Get(), TEXT("ISMBenchTolerance="), Tolerance);
+
+        for (const FOpResult& R : Results)
+        {
+            const double* BaselineUs = Baseline.Find(R.Name);
+            if (!BaselineUs || *BaselineUs <= 0.0 || R.TotalMs < MinComparableMs)
+            {
+                continue;
+            }
+
+            const double Ratio = R.UsPerOp() / *BaselineUs;
+            if (Ratio > 1.0 + Tolerance)
+            {
+                Test.AddError(FString::Printf(TEXT("%s %s regressed: %.4fus per op against a %.4fus baseline (%.0f%% slower, tolerance %.0f%%)"),
+                    Spec.Name, *R.Name, R.UsPerOp(), *BaselineUs, (Ratio - 1.0) * 100.0, Tolerance * 100.0f));
+            }
+        }
+    }
+
+    const FWorldSpec* FindSpec(const FString& Name)
+    {
+        for (const FWorldSpec& Spec : Specs)
+        {
+            if (Name == Spec.Name)
+            {
+                return &Spec;
+            }
+        }
+        return nullptr;
+    }
+
+    void GetScenarios(bool bStress, TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands)
+    {
+        for (const FWorldSpec& Spec : Specs)
+        {
+            if (Spec.bStress == bStress)
+            {
+                OutBeautifiedNames.Add(Spec.Name);
+                OutTestCommands.Add(Spec.Name);
+            }
+        }
+    }
+
+    bool RunScenario(FAutomationTestBase& Test, const FString& Parameters)
+    {
+        const FWorldSpec* Spec = FindSpec(Parameters);
+        if (!Spec)
+        {
+            Test.AddError(FString::Printf(TEXT("Unknown benchmark scenario '%s'"), *Parameters));
+            return false;
+        }
+
+        const FBox Bounds = MakeWorldBounds(*Spec);
+        const TArray<FVector> Locations = FISMTestHelpers::GenerateClusteredLocations(
+            Spec->NumInstances, Bounds, Spec->NumClusters, Spec->ClusterRadius, Seed);
+
+        // Queries are issued where instances are, as gameplay queries would be
+        FRandomStream Stream(Seed + 1);
+        TArray<FVector> QueryCenters;
+        QueryCenters.Reserve(NumQueries);
+        for (int32 i = 0; i < NumQueries; ++i)
+        {
+            QueryCenters.Add(Locations[Stream.RandHelper(Locations.Num())]);
+        }
+
+        TArray<FOpResult> Results = RunIndexOps(Locations, QueryCenters);
+        if (!Test.TestEqual(TEXT("Spatial index holds every instance"), Results[0].NumResults, static_cast<int64>(Spec->NumInstances)))
+        {
+            return false;
+        }
+
+        // The unfiltered world-wide query must see what the per-index one did
+        TArray<FOpResult> WorldResults = RunWorldOps(Locations, QueryCenters, Bounds);
+        Test.TestEqual(TEXT("Components hold every instance"), WorldResults[0].NumResults, static_cast<int64>(Spec->NumInstances));
+        const FOpResult* IndexRadius = Results.FindByPredicate([](const FOpResult& R) { return R.Name == TEXT("Index.Radius"); });
+        const FOpResult* SubsystemRadius = WorldResults.FindByPredicate([](const FOpResult& R) { return R.Name == TEXT("Subsystem.Radius"); });
+        if (IndexRadius && SubsystemRadius)
+        {
+            Test.TestEqual(TEXT("Subsystem radius queries match the spatial index"), SubsystemRadius->NumResults, IndexRadius->NumResults);
+        }
+        Results.Append(MoveTemp(WorldResults));
+
+        const TMap<FString, double> Baseline = LoadBaseline(FPaths::Combine(GetBaselineDir(), FString(Spec->Name) + TEXT(".json")));
+        WriteReport(*Spec, Results, Baseline, Test);
+        CompareToBaseline(*Spec, Results, Baseline, Test);
+        return true;
+    }
+}
+
+
+// ============================================================
+//  Benchmarks
+// ============================================================
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+    FISMCore_Benchmark,
+    "ISMRuntime.Core.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+void FISMCore_Benchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    ISMCoreBenchmark::GetScenarios(false, OutBeautifiedNames, OutTestCommands);
+}
+
+bool FISMCore_Benchmark::RunTest(const FString& Parameters)
+{
+    return ISMCoreBenchmark::RunScenario(*this, Parameters);
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+    FISMCore_Benchmark_Stress,
+    "ISMRuntime.Core.Benchmark.Stress",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::StressFilter)
+
+void FISMCore_Benchmark_Stress::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    ISMCoreBenchmark::GetScenarios(true, OutBeautifiedNames, OutTestCommands);
+}
+
+bool FISMCore_Benchmark_Stress::RunTest(const FString& Parameters)
+{
+    return ISMCoreBenchmark::RunScenario(*this, Parameters);
+}
@@ -1045,4 +1045,65 @@ bool FISMAABBSubsystemOverlapInstanceCrossComponentTest::RunTest(const FString&
 
     World->DestroyWorld(false);
     return true;
-}
\ No newline at end of file
+}
+// ---------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMAABBGridTraceOrientedBoundsTest,
+    "ISMRuntime.Core.AABB.Subsystem.GridTraceOrientedBoundsRejectsAABBOnlyHits",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMAABBGridTraceOrientedBoundsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - One cube yawed 45 degrees, so its world AABB is much larger than the cube
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UISMInstanceDataAsset* DataAsset = NewObject<UISMInstanceDataAsset>();
+    UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    DataAsset->StaticMesh = CubeMesh;
+    DataAsset->RefreshCachedBounds();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->SetStaticMesh(CubeMesh);
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->RegisterComponent();
+    ISM->AddInstance(FTransform(FRotator(0, 45, 0), FVector::ZeroVector));
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->InstanceData = DataAsset;
+    RuntimeComp->bComputeInstanceAABBs = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    // Runs parallel to a cube face, 60 units out: inside the AABB corner, outside the cube
+    const FVector Diagonal = FVector(1, 1, 0).GetSafeNormal();
+    const FVector Offset = FVector(1, -1, 0).GetSafeNormal() * 60.0f;
+    const FVector MissStart = Offset - Diagonal * 500.0f;
+    const FVector MissEnd = Offset + Diagonal * 500.0f;
+
+    FISMQueryFilter Filter;
+    TArray<FISMTraceResult> Results;
+
+    // ACT / ASSERT - AABB mode hits, oriented mode rejects
+    TestTrue("AABB trace hits the yawed cube's corner region", Subsystem->GridTraceISM(MissStart, MissEnd, 0.0f, Results, Filter, true, false));
+    TestFalse("Oriented trace misses the cube itself", Subsystem->GridTraceISM(MissStart, MissEnd, 0.0f, Results, Filter, true, true));
+
+    // ACT - Straight at a face, with collision disabled on the ISM
+    const bool bHit = Subsystem->GridTraceISM(-Diagonal * 500.0f, Diagonal * 500.0f, 0.0f, Results, Filter, true, true);
+
+    // ASSERT - Entered at the face, normal facing back along the ray
+    TestTrue("Oriented trace hits through the face", bHit);
+    if (bHit)
+    {
+        TestTrue("Hit resolves to the instance", Results[0].Handle.IsValid() && Results[0].Handle.InstanceIndex == 0);
+        TestTrue("Entry distance is at the face", FMath::IsNearlyEqual(Results[0].InstanceDistance, 450.0f, 1.0f));
+        TestTrue("Normal opposes the ray", Results[0].PhysicsHit.ImpactNormal.Equals(-Diagonal, 0.01f));
+    }
+
+    World->DestroyWorld(false);
+    return true;
+}
@@ -1,8 +1,14 @@
 // ISMInstanceHandleTests.cpp
 #include "ISMInstanceHandle.h"
+#include "ISMInstanceHandleTable.h"
 #include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMQueryFilter.h"
+#include "ISMResourceComponent.h"
+#include "ISMCollectorComponent.h"
 #include "ISMTestHelpers.h"
 #include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FISMInstanceHandleBasicTest,
@@ -67,4 +73,200 @@ bool FISMInstanceHandleConversionTest::RunTest(const FString& Parameters)
     TestActor->Destroy();
     
     return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceHandleGenerationTest,
+    "ISMRuntime.Core.InstanceHandle.StaleAfterRecycle",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceHandleGenerationTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FISMTestHelpers::CreateTestWorld();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 3; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* Component = NewObject<UISMRuntimeComponent>(TestActor);
+    Component->ManagedISMComponent = ISM;
+    Component->bRecycleDestroyedInstances = true;
+    Component->RegisterComponent();
+    Component->InitializeInstances();
+
+    FISMInstanceHandle OldHandle = Component->GetInstanceHandle(1);
+    Component->DestroyInstance(1);
+    TestTrue("Destroyed but not recycled handle is still valid", OldHandle.IsValid());
+
+    // ACT - Batch add reuses the destroyed slot before appending
+    TArray<FTransform> Spawns = { FTransform(FVector(900, 0, 0)), FTransform(FVector(1000, 0, 0)) };
+    TArray<int32> NewIndices = Component->BatchAddInstances(Spawns, false, true);
+
+    // ASSERT
+    TestEqual("First spawn recycled slot 1", NewIndices[0], 1);
+    TestEqual("Second spawn appended", NewIndices[1], 3);
+    TestTrue("Old handle is stale", OldHandle.IsStale());
+    TestFalse("Stale handle is not valid", OldHandle.IsValid());
+
+    FISMInstanceHandle NewHandle = Component->GetInstanceHandle(1);
+    TestTrue("Fresh handle is valid", NewHandle.IsValid());
+    TestTrue("Handles to different generations differ", NewHandle != OldHandle);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceHandleTableTest,
+    "ISMRuntime.Core.InstanceHandle.HandleTable",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceHandleTableTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    FISMInstanceHandleTable Table;
+    bool bAdded = false;
+    for (int32 InstanceIndex : { 10, 3, 7 })
+    {
+        Table.FindOrAdd(InstanceIndex, bAdded).InstanceIndex = InstanceIndex;
+        TestTrue("New handle added", bAdded);
+    }
+    Table.FindOrAdd(3, bAdded);
+    TestFalse("Existing handle found", bAdded);
+    Table.SetConverted(10, true);
+    Table.SetConverted(7, true);
+
+    // ASSERT
+    TestEqual("Three handles", Table.Num(), 3);
+    TestNull("No handle for an untouched index", Table.Find(4));
+    TestNull("No handle past the table", Table.Find(1000));
+    TestEqual("Two converted", Table.GetConvertedInstances().Num(), 2);
+
+    // ACT - Removing the first slot moves the last handle into it
+    Table.Remove(10);
+
+    // ASSERT
+    TestFalse("Removed", Table.Contains(10));
+    TestTrue("Moved handle still found", Table.Find(7) && Table.Find(7)->InstanceIndex == 7);
+    TestTrue("Moved handle still listed converted", Table.IsListedConverted(7));
+    TestEqual("Removed handle left the converted list", Table.GetConvertedInstances().Num(), 1);
+
+    // ACT
+    Table.SetConverted(7, false);
+    Table.SetConverted(3, false);
+
+    // ASSERT
+    TestEqual("Converted list empty", Table.GetConvertedInstances().Num(), 0);
+    TestEqual("Handles kept", Table.Num(), 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceHandleCopyConversionTest,
+    "ISMRuntime.Core.InstanceHandle.ConversionThroughCopies",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceHandleCopyConversionTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FISMTestHelpers::CreateTestWorld();
+    UISMRuntimeComponent* Component = FISMTestHelpers::CreateTestComponent(World, 20, 100.0f);
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    // ACT - Convert through a copy, as pooled and physics conversions do
+    FISMInstanceHandle Copy = Component->GetInstanceHandle(4);
+    Copy.SetConvertedActor(TestActor, 1);
+
+    // ASSERT - The component sees it without a scan
+    TestTrue("Instance converted", Component->IsInstanceConverted(4));
+    TestEqual("One converted instance", Component->GetConvertedInstances().Num(), 1);
+    TestEqual("Stored handle has the actor", Component->GetInstanceHandle(4).GetConvertedActor(), TestActor);
+    TestFalse("Other instances unaffected", Component->IsInstanceConverted(5));
+
+    // ACT - Return through another copy
+    FISMInstanceHandle Other = Component->GetInstanceHandle(4);
+    Other.ClearConvertedActor();
+
+    // ASSERT
+    TestFalse("Instance returned", Component->IsInstanceConverted(4));
+    TestEqual("No converted instances", Component->GetConvertedInstances().Num(), 0);
+
+    // Cleanup
+    TestActor->Destroy();
+    FISMTestHelpers::DestroyTestWorld(World);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceHandleRecycledSlotQueriesTest,
+    "ISMRuntime.Core.InstanceHandle.RecycledSlotQueries",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceHandleRecycledSlotQueriesTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A resource whose slot 0 is destroyed and reused at the origin
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* ResourceActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(ResourceActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 3; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMResourceComponent* Resource = NewObject<UISMResourceComponent>(ResourceActor);
+    Resource->ManagedISMComponent = ISM;
+    Resource->bRecycleDestroyedInstances = true;
+    Resource->RegisterComponent();
+    Resource->InitializeInstances();
+
+    Resource->DestroyInstance(0);
+    const int32 Recycled = Resource->AddInstance(FTransform(FVector::ZeroVector));
+    TestEqual("Slot reused", Recycled, 0);
+    TestTrue("Slot generation advanced", Resource->GetInstanceGeneration(0) > 0);
+
+    // ACT - k-NN across the subsystem
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    const TArray<FISMInstanceHandle> Nearest = Subsystem->FindNearestInstances(FVector::ZeroVector, 1, FISMQueryFilter());
+
+    // ASSERT - The new occupant passes the filter and comes back current
+    TestEqual("Recycled instance found", Nearest.Num(), 1);
+    if (Nearest.Num() == 1)
+    {
+        TestEqual("Nearest is the recycled slot", Nearest[0].InstanceIndex, 0);
+        TestTrue("Result is valid", Nearest[0].IsValid());
+    }
+
+    // ACT - Radius detection from a collector at the origin
+    AActor* CollectorActor = World->SpawnActor<AActor>();
+    UISMCollectorComponent* Collector = NewObject<UISMCollectorComponent>(CollectorActor);
+    Collector->DetectionMode = ECollectionDetectionMode::Radius;
+    Collector->bUseSharedDetection = false;
+    Collector->bOnlyDetectValidTargets = false;
+    Collector->DetectionInterval = 0.0f;
+    Collector->RegisterComponent();
+    Collector->TickComponent(0.1f, LEVELTICK_All, nullptr);
+
+    // ASSERT
+    TestTrue("Collector targets the recycled instance", Collector->HasValidTarget());
+    TestEqual("Targeted slot", Collector->GetTargetedInstance().InstanceIndex, 0);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
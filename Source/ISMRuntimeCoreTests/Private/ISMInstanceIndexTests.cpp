@@ -0,0 +1,417 @@
+// ISMInstanceIndexTests.cpp
+#include "ISMInstanceIndex.h"
+#include "ISMRuntimeComponent.h"
+#include "GameplayTagContainer.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+
+namespace
+{
+    TArray<int32> SortedIndices(const TArray<FISMInstanceHandle>& Handles)
+    {
+        TArray<int32> Indices;
+        for (const FISMInstanceHandle& Handle : Handles)
+        {
+            Indices.Add(Handle.InstanceIndex);
+        }
+        Indices.Sort();
+        return Indices;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceIndexDenseModeTest,
+    "ISMRuntime.Core.InstanceIndex.DenseMatchesHashed",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceIndexDenseModeTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Every third instance is a tree; one hashed and one dense tag index over the same component
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 30; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+    const FGameplayTag IntactTag = FGameplayTag::RequestGameplayTag("ISM.State.Intact");
+
+    UISMTagIndex* Hashed = NewObject<UISMTagIndex>(TestActor);
+    UISMTagIndex* Dense = NewObject<UISMTagIndex>(TestActor);
+    Dense->bUseDenseIds = true;
+    Hashed->RegisterWithComponent(RuntimeComp);
+    Dense->RegisterWithComponent(RuntimeComp);
+
+    for (int32 i = 0; i < 30; i += 3)
+    {
+        RuntimeComp->AddInstanceTag(i, TreeTag);
+    }
+
+    // ACT - Untagging must clear the dense bit
+    RuntimeComp->RemoveInstanceTag(3, TreeTag);
+
+    FGameplayTagContainer Both;
+    Both.AddTag(TreeTag);
+    Both.AddTag(IntactTag);
+
+    // ASSERT
+    TestEqual("Tree counts match", Dense->GetCountForTag(TreeTag), Hashed->GetCountForTag(TreeTag));
+    TestEqual("Untagged tree is gone", Dense->GetCountForTag(TreeTag), 9);
+    TestEqual("Tree handles match", SortedIndices(Dense->GetHandlesForTag(TreeTag)), SortedIndices(Hashed->GetHandlesForTag(TreeTag)));
+    TestEqual("All-tags intersection matches", SortedIndices(Dense->GetHandlesForAllTags(Both)), SortedIndices(Hashed->GetHandlesForAllTags(Both)));
+    TestEqual("Any-tag union matches", SortedIndices(Dense->GetHandlesForAnyTag(Both)), SortedIndices(Hashed->GetHandlesForAnyTag(Both)));
+    TestEqual("Distinct handle totals match", Dense->GetTotalIndexedCount(), Hashed->GetTotalIndexedCount());
+
+    const FISMInstanceHandle Tree6 = RuntimeComp->GetInstanceHandle(6);
+    TestTrue("Dense probe finds a tree", Dense->IsHandleIndexed(TreeTag, Tree6));
+    TestFalse("Dense probe rejects a non-tree", Dense->IsHandleIndexed(TreeTag, RuntimeComp->GetInstanceHandle(7)));
+
+    TArray<FISMIndexQuery> Mixed;
+    Mixed.Emplace(Dense, TreeTag);
+    Mixed.Emplace(Hashed, IntactTag);
+    TestEqual("Mixed-mode intersection matches", SortedIndices(UISMInstanceIndex::IntersectAll(Mixed)), SortedIndices(Hashed->GetHandlesForAllTags(Both)));
+
+    Dense->SetUseDenseIds(false);
+    TestEqual("Converting back rebuilds the same index", SortedIndices(Dense->GetHandlesForTag(TreeTag)), SortedIndices(Hashed->GetHandlesForTag(TreeTag)));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceIndexDeferredTest,
+    "ISMRuntime.Core.InstanceIndex.DeferredMaintenance",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceIndexDeferredTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - An immediate and a deferred tag index over the same component
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 20; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+
+    UISMTagIndex* Immediate = NewObject<UISMTagIndex>(TestActor);
+    UISMTagIndex* Deferred = NewObject<UISMTagIndex>(TestActor);
+    Deferred->bDeferMaintenance = true;
+    Immediate->RegisterWithComponent(RuntimeComp);
+    Deferred->RegisterWithComponent(RuntimeComp);
+
+    // ACT - Several events per instance: tag everything, then untag the odd ones
+    for (int32 i = 0; i < 20; i++)
+    {
+        RuntimeComp->AddInstanceTag(i, TreeTag);
+    }
+    for (int32 i = 1; i < 20; i += 2)
+    {
+        RuntimeComp->RemoveInstanceTag(i, TreeTag);
+    }
+    const int32 PendingBeforeQuery = Deferred->GetNumPendingChanges();
+
+    // ASSERT
+    TestEqual("One pending entry per touched instance", PendingBeforeQuery, 20);
+    TestEqual("Query reconciles to the immediate result", SortedIndices(Deferred->GetHandlesForTag(TreeTag)), SortedIndices(Immediate->GetHandlesForTag(TreeTag)));
+    TestEqual("Nothing pending after the query", Deferred->GetNumPendingChanges(), 0);
+    TestEqual("Even instances remain", Deferred->GetCountForTag(TreeTag), 10);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceIndexBatchEventTest,
+    "ISMRuntime.Core.InstanceIndex.BatchDestroyUsesBatchEvent",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceIndexBatchEventTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A tag index over a component, plus counters on the native events
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 10; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FGameplayTag DestroyedTag = FGameplayTag::RequestGameplayTag("ISM.State.Destroyed");
+
+    UISMTagIndex* Index = NewObject<UISMTagIndex>(TestActor);
+    Index->RegisterWithComponent(RuntimeComp);
+
+    int32 PerInstanceBroadcasts = 0;
+    RuntimeComp->OnInstanceDestroyedNative.AddLambda([&](UISMRuntimeComponent*, int32) { ++PerInstanceBroadcasts; });
+    int32 BatchBroadcasts = 0;
+    RuntimeComp->OnInstancesChangedBatchNative.AddLambda([&](UISMRuntimeComponent*, TArrayView<const int32>) { ++BatchBroadcasts; });
+
+    // ACT
+    RuntimeComp->BatchDestroyInstances({ 1, 3, 5, 7 }, true, false, nullptr);
+    RuntimeComp->DestroyInstance(9, true);
+
+    // ASSERT
+    TestEqual("Batch destroy broadcasts once", BatchBroadcasts, 1);
+    TestEqual("Only the single destroy fires per instance", PerInstanceBroadcasts, 1);
+    TestEqual("Index sees every destroyed instance", SortedIndices(Index->GetHandlesForTag(DestroyedTag)), TArray<int32>{ 1, 3, 5, 7, 9 });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceIndexIntersectionViewTest,
+    "ISMRuntime.Core.InstanceIndex.IntersectionView",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceIndexIntersectionViewTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Trees in an immediate index, damaged instances in a deferred one
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 20; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+    const FGameplayTag DamagedTag = FGameplayTag::RequestGameplayTag("ISM.State.Damaged");
+
+    UISMTagIndex* Trees = NewObject<UISMTagIndex>(TestActor);
+    UISMTagIndex* Damaged = NewObject<UISMTagIndex>(TestActor);
+    Damaged->bDeferMaintenance = true;
+    Trees->RegisterWithComponent(RuntimeComp);
+    Damaged->RegisterWithComponent(RuntimeComp);
+
+    for (int32 i = 0; i < 20; i += 2)
+    {
+        RuntimeComp->AddInstanceTag(i, TreeTag);
+    }
+    for (int32 i = 0; i < 20; i += 3)
+    {
+        RuntimeComp->AddInstanceTag(i, DamagedTag);
+    }
+
+    TArray<FISMIndexQuery> Queries;
+    Queries.Emplace(Trees, TreeTag);
+    Queries.Emplace(Damaged, DamagedTag);
+    TSharedRef<FISMIndexIntersectionView> View = UISMInstanceIndex::CreateIntersectionView(Queries);
+
+    auto ViewIndices = [&View]()
+    {
+        return SortedIndices(View->GetHandles().Array());
+    };
+
+    // ASSERT - Built from the current state
+    TestEqual("View starts as the intersection", ViewIndices(), SortedIndices(UISMInstanceIndex::IntersectAll(Queries)));
+    TestEqual("Trees that are damaged", ViewIndices(), TArray<int32>{ 0, 6, 12, 18 });
+
+    // ACT - Changes on either side are patched in
+    RuntimeComp->AddInstanceTag(4, DamagedTag);
+    RuntimeComp->RemoveInstanceTag(6, TreeTag);
+    RuntimeComp->RemoveInstanceTag(18, DamagedTag);
+    RuntimeComp->AddInstanceTag(9, TreeTag);
+
+    // ASSERT
+    TestEqual("Patched view matches a fresh intersection", ViewIndices(), SortedIndices(UISMInstanceIndex::IntersectAll(Queries)));
+    TestEqual("Patched view contents", ViewIndices(), TArray<int32>{ 0, 4, 9, 12 });
+    TestTrue("Contains probes the view", View->Contains(RuntimeComp->GetInstanceHandle(9)));
+
+    // ACT - A bulk change recomputes
+    Trees->RebuildIndex();
+
+    // ASSERT
+    TestEqual("Rebuild keeps the view in step", ViewIndices(), TArray<int32>{ 0, 4, 9, 12 });
+    TestTrue("Both indexes alive", View->IsValid());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceIndexResultOrderTest,
+    "ISMRuntime.Core.InstanceIndex.ResultOrder",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceIndexResultOrderTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Two components; instances laid out so index order and cell order disagree
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UISMTagIndex* Index = NewObject<UISMTagIndex>(TestActor);
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+
+    TArray<UISMRuntimeComponent*> Components;
+    for (int32 c = 0; c < 2; c++)
+    {
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < 16; i++)
+        {
+            ISM->AddInstance(FTransform(FVector((15 - i) * 2000.0f, 0, 0)));
+        }
+
+        UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+        RuntimeComp->ManagedISMComponent = ISM;
+        RuntimeComp->RegisterComponent();
+        RuntimeComp->InitializeInstances();
+        Index->RegisterWithComponent(RuntimeComp);
+        for (int32 i = 0; i < 16; i++)
+        {
+            RuntimeComp->AddInstanceTag(i, TreeTag);
+        }
+        Components.Add(RuntimeComp);
+    }
+
+    // ACT
+    Index->ResultOrder = EISMIndexResultOrder::ByComponent;
+    const TArray<FISMInstanceHandle> ByComponent = Index->GetHandlesForTag(TreeTag);
+    Index->ResultOrder = EISMIndexResultOrder::BySpatialCell;
+    const TArray<FISMInstanceHandle> BySpatialCell = Index->GetHandlesForTag(TreeTag);
+
+    // ASSERT - One run per component, ascending indices within it
+    TestEqual("Every handle returned", ByComponent.Num(), 32);
+    int32 Runs = 1;
+    for (int32 i = 1; i < ByComponent.Num(); i++)
+    {
+        if (ByComponent[i].Component != ByComponent[i - 1].Component)
+        {
+            ++Runs;
+            continue;
+        }
+        TestTrue("Ascending instance index", ByComponent[i].InstanceIndex > ByComponent[i - 1].InstanceIndex);
+    }
+    TestEqual("One run per component", Runs, 2);
+
+    // ASSERT - Cells along +X come out in ascending X, i.e. descending instance index here
+    TestEqual("Every handle returned spatially", BySpatialCell.Num(), 32);
+    for (int32 i = 1; i < BySpatialCell.Num(); i++)
+    {
+        if (BySpatialCell[i].Component == BySpatialCell[i - 1].Component)
+        {
+            TestTrue("Ascending cell", BySpatialCell[i].InstanceIndex < BySpatialCell[i - 1].InstanceIndex);
+        }
+    }
+
+    TArray<FISMInstanceHandle> Resorted = BySpatialCell;
+    UISMInstanceIndex::SortHandles(Resorted, EISMIndexResultOrder::ByComponent);
+    TestTrue("SortHandles matches the query order", Resorted == ByComponent);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceIndexBulkBuildTest,
+    "ISMRuntime.Core.InstanceIndex.BulkBuild",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceIndexBulkBuildTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Three tagged components
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+
+    TArray<UISMRuntimeComponent*> Components;
+    for (int32 c = 0; c < 3; c++)
+    {
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < 50; i++)
+        {
+            ISM->AddInstance(FTransform(FVector(i * 100.0f, c * 1000.0f, 0)));
+        }
+
+        UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+        RuntimeComp->ManagedISMComponent = ISM;
+        RuntimeComp->RegisterComponent();
+        RuntimeComp->InitializeInstances();
+        for (int32 i = c; i < 50; i += 4)
+        {
+            RuntimeComp->AddInstanceTag(i, TreeTag);
+        }
+        Components.Add(RuntimeComp);
+    }
+    Components[2]->DestroyInstance(2, true);
+
+    UISMTagIndex* Serial = NewObject<UISMTagIndex>(TestActor);
+    Serial->bParallelBuild = false;
+    for (UISMRuntimeComponent* Comp : Components)
+    {
+        Serial->RegisterWithComponent(Comp);
+    }
+
+    // ACT - Parallel bulk registration, hashed and dense
+    UISMTagIndex* Bulk = NewObject<UISMTagIndex>(TestActor);
+    Bulk->RegisterWithComponents(Components);
+    UISMTagIndex* BulkDense = NewObject<UISMTagIndex>(TestActor);
+    BulkDense->bUseDenseIds = true;
+    BulkDense->RegisterWithComponents(Components);
+
+    Bulk->ResultOrder = EISMIndexResultOrder::ByComponent;
+    BulkDense->ResultOrder = EISMIndexResultOrder::ByComponent;
+    Serial->ResultOrder = EISMIndexResultOrder::ByComponent;
+
+    // ASSERT
+    TestTrue("Bulk build matches serial", Bulk->GetHandlesForTag(TreeTag) == Serial->GetHandlesForTag(TreeTag));
+    TestTrue("Dense bulk build matches serial", BulkDense->GetHandlesForTag(TreeTag) == Serial->GetHandlesForTag(TreeTag));
+    TestFalse("Destroyed instance is skipped", Bulk->IsHandleIndexed(TreeTag, Components[2]->GetInstanceHandle(2)));
+
+    Components[0]->AddInstanceTag(1, TreeTag);
+    TestTrue("Events still apply after a bulk build", Bulk->IsHandleIndexed(TreeTag, Components[0]->GetInstanceHandle(1)));
+
+    // ACT - Time-sliced rebuild on a registered index finishes when queried
+    UISMTagIndex* Sliced = NewObject<UISMTagIndex>(TestActor);
+    Sliced->BuildTimeSliceMs = 0.5f;
+    Sliced->RegisterComponent();
+    Sliced->RegisterWithComponents(Components);
+    const int32 QueuedBuilds = Sliced->GetNumPendingBuilds();
+    Sliced->ResultOrder = EISMIndexResultOrder::ByComponent;
+    const TArray<FISMInstanceHandle> SlicedResult = Sliced->GetHandlesForTag(TreeTag);
+
+    // ASSERT
+    TestEqual("Registration queued every component", QueuedBuilds, 3);
+    TestEqual("Query completed the build", Sliced->GetNumPendingBuilds(), 0);
+    TestTrue("Sliced build matches serial", SlicedResult == Bulk->GetHandlesForTag(TreeTag));
+
+    return true;
+}
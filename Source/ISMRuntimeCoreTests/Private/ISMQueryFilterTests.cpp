@@ -1,8 +1,12 @@
 // ISMQueryFilterTests.cpp
 #include "ISMQueryFilter.h"
+#include "ISMCompiledQueryFilter.h"
 #include "ISMRuntimeComponent.h"
 #include "GameplayTagContainer.h"
 #include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FISMQueryFilterTagTest,
@@ -28,4 +32,75 @@ bool FISMQueryFilterTagTest::RunTest(const FString& Parameters)
     TestFalse("Component with excluded tag should fail", Filter.PassesComponentFilter(Component));
     
     return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMQueryFilterCompiledTest,
+    "ISMRuntime.Core.QueryFilter.Compiled",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMQueryFilterCompiledTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Instances with a mix of compact tags and states
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 6; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bCompactInstanceTags = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+    const FGameplayTag DestroyedTag = FGameplayTag::RequestGameplayTag("ISM.State.Destroyed");
+    RuntimeComp->AddInstanceTag(0, TreeTag);
+    RuntimeComp->AddInstanceTag(1, TreeTag);
+    RuntimeComp->AddInstanceTag(2, TreeTag);
+    RuntimeComp->AddInstanceTag(2, DestroyedTag);
+    RuntimeComp->SetInstanceState(1, EISMInstanceState::Damaged, true);
+    RuntimeComp->SetInstanceState(3, EISMInstanceState::Damaged, true);
+
+    TArray<FISMQueryFilter> Filters;
+    Filters.AddDefaulted(4);
+    Filters[0].RequiredTags.AddTag(FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation"));
+    Filters[0].ExcludedTags.AddTag(DestroyedTag);
+    Filters[1].ExcludedStates.Add(EISMInstanceState::Damaged);
+    Filters[2].RequiredTags.AddTag(TreeTag);
+    Filters[2].RequiredStates.Add(EISMInstanceState::Damaged);
+    Filters[3].CustomFilter = [](const FISMInstanceReference& Ref) { return Ref.InstanceIndex % 2 == 0; };
+
+    // ACT / ASSERT - Compiled predicate agrees with PassesFilter on every instance
+    for (int32 f = 0; f < Filters.Num(); f++)
+    {
+        const FISMCompiledQueryFilter Compiled = Filters[f].Compile();
+        const FISMCompiledComponentFilter Bound = Compiled.BindComponent(RuntimeComp);
+        TestTrue(FString::Printf(TEXT("Filter %d binds"), f), Bound.bPasses);
+
+        for (int32 i = 0; i < RuntimeComp->GetInstanceCount(); i++)
+        {
+            FISMInstanceReference Ref;
+            Ref.Component = RuntimeComp;
+            Ref.InstanceIndex = i;
+            Ref.Generation = static_cast<int32>(RuntimeComp->GetInstanceGeneration(i));
+            TestEqual(FString::Printf(TEXT("Filter %d, instance %d"), f, i), Compiled.PassesInstance(Bound, i), Filters[f].PassesFilter(Ref));
+        }
+    }
+
+    // ASSERT - Unknown required tag fails the whole component at bind time
+    FISMQueryFilter Unmatched;
+    Unmatched.RequiredTags.AddTag(FGameplayTag::RequestGameplayTag("ISM.Type.Rock"));
+    TestFalse("Unknown required tag rejects the component", Unmatched.Compile().BindComponent(RuntimeComp).bPasses);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
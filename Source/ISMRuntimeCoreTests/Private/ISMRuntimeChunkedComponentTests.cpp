@@ -0,0 +1,154 @@
+// ISMRuntimeChunkedComponentTests.cpp
+#include "ISMRuntimeChunkedComponent.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMQueryFilter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMChunkedComponentPlacementTest,
+    "ISMRuntime.Core.Chunked.Placement",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMChunkedComponentPlacementTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - 10m regions of at most four instances
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UISMRuntimeChunkedComponent* Chunked = NewObject<UISMRuntimeChunkedComponent>(TestActor);
+    Chunked->ChunkSize = 1000.0f;
+    Chunked->MaxInstancesPerChunk = 4;
+    Chunked->NumCustomDataFloats = 1;
+    Chunked->RegisterComponent();
+
+    // Six instances in region (0,0), four in region (5,0)
+    TArray<FTransform> Transforms;
+    TArray<float> CustomData;
+    for (int32 i = 0; i < 10; i++)
+    {
+        const float X = i < 6 ? i * 100.0f : 5000.0f + (i - 6) * 100.0f;
+        Transforms.Add(FTransform(FVector(X, 0, 0)));
+        CustomData.Add(static_cast<float>(i));
+    }
+
+    // ACT
+    const TArray<int32> Logical = Chunked->BatchAddInstances(Transforms, CustomData, 1);
+
+    // ASSERT - Region (0,0) overflowed into a second chunk
+    TestEqual("Every instance added", Logical.Num(), 10);
+    TestFalse("No adds failed", Logical.Contains(INDEX_NONE));
+    TestEqual("Logical space", Chunked->GetInstanceCount(), 10);
+    TestEqual("Chunks: two for the full region, one for the other", Chunked->GetNumChunks(), 3);
+
+    for (int32 Chunk = 0; Chunk < Chunked->GetNumChunks(); Chunk++)
+    {
+        const UISMRuntimeComponent* Component = Chunked->GetChunkComponent(Chunk);
+        TestTrue("Chunk within its limit", Component && Component->GetInstanceCount() <= 4);
+    }
+
+    TestTrue("Transform read through the logical index",
+        Chunked->GetInstanceTransform(Logical[7]).GetLocation().Equals(FVector(5100.0f, 0, 0)));
+
+    const FISMInstanceHandle Handle = Chunked->GetInstanceHandle(Logical[3]);
+    TestTrue("Handle names a chunk", Handle.IsValid());
+    TestEqual("Handle maps back", Chunked->GetLogicalIndex(Handle), Logical[3]);
+    TestEqual("Custom data landed in the chunk",
+        Handle.Component->GetInstanceCustomDataValue(Handle.InstanceIndex, 0), 3.0f);
+
+    // ACT - Mutations route to the owning chunk only
+    Chunked->BatchDestroyInstances({ Logical[1], Logical[8] });
+    Chunked->SetInstanceState(Logical[2], EISMInstanceState::Damaged, true);
+
+    TestTrue("Destroyed in region (0,0)", Chunked->IsInstanceDestroyed(Logical[1]));
+    TestTrue("Destroyed in region (5,0)", Chunked->IsInstanceDestroyed(Logical[8]));
+    TestFalse("Neighbour untouched", Chunked->IsInstanceDestroyed(Logical[0]));
+    TestEqual("Active count spans chunks", Chunked->GetActiveInstanceCount(), 8);
+
+    const FISMInstanceHandle Damaged = Chunked->GetInstanceHandle(Logical[2]);
+    TestTrue("State set in the chunk", Damaged.Component->IsInstanceInState(Damaged.InstanceIndex, EISMInstanceState::Damaged));
+
+    // ACT - Queries only return logical indices of the chunks they reach
+    TArray<int32> Found;
+    Chunked->QueryInstances(FVector(5000.0f, 0, 0), 150.0f, FISMQueryFilter(), Found);
+    TestEqual("Query hits region (5,0) only", Found.Num(), 2);
+    TestTrue("Query returns logical indices", Found.Contains(Logical[6]) && Found.Contains(Logical[7]));
+
+    // ACT - Move an instance out of its region; it stays in its chunk and is found the same frame
+    Chunked->UpdateInstanceTransform(Logical[0], FTransform(FVector(20000.0f, 0, 0)));
+    Found.Reset();
+    Chunked->QueryInstances(FVector(20000.0f, 0, 0), 50.0f, FISMQueryFilter(), Found);
+    TestEqual("Moved instance found outside its region", Found.Num(), 1);
+    TestTrue("Moved instance keeps its logical index", Found.Contains(Logical[0]));
+    TestEqual("Moved instance kept its chunk", Chunked->GetInstanceLocation(Logical[0]).Chunk, Chunked->GetInstanceLocation(Logical[2]).Chunk);
+
+    // ACT - The full region opens another chunk; the logical index keeps growing
+    const int32 Added = Chunked->AddInstance(FTransform(FVector(5500.0f, 0, 0)));
+    TestEqual("Next logical index", Added, 10);
+    TestEqual("Full region opened a chunk", Chunked->GetNumChunks(), 4);
+
+    // ACT - Reset tears the chunk components down
+    UISMRuntimeComponent* FirstChunk = Chunked->GetChunkComponent(0);
+    Chunked->ResetChunks();
+    TestEqual("No chunks after reset", Chunked->GetNumChunks(), 0);
+    TestEqual("No instances after reset", Chunked->GetInstanceCount(), 0);
+    TestFalse("Chunk component destroyed", FirstChunk->IsRegistered());
+
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMChunkedComponentAdoptTest,
+    "ISMRuntime.Core.Chunked.AdoptInstances",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMChunkedComponentAdoptTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A monolithic ISM spread over three regions
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* Source = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    Source->NumCustomDataFloats = 1;
+    Source->RegisterComponent();
+    for (int32 i = 0; i < 30; i++)
+    {
+        const int32 Index = Source->AddInstance(FTransform(FVector((i % 3) * 2000.0f, i * 10.0f, 0)), true);
+        Source->SetCustomDataValue(Index, 0, static_cast<float>(i));
+    }
+
+    UISMRuntimeChunkedComponent* Chunked = NewObject<UISMRuntimeChunkedComponent>(TestActor);
+    Chunked->ChunkSize = 1000.0f;
+    Chunked->NumCustomDataFloats = 1;
+    Chunked->RegisterComponent();
+
+    // ACT
+    const int32 NumAdopted = Chunked->AdoptInstances(Source);
+
+    // ASSERT
+    TestEqual("All adopted", NumAdopted, 30);
+    TestEqual("Source cleared", Source->GetInstanceCount(), 0);
+    TestEqual("One chunk per region", Chunked->GetNumChunks(), 3);
+
+    // Adoption keeps source order, so logical index i is source instance i
+    const FISMInstanceHandle Handle = Chunked->GetInstanceHandle(17);
+    TestTrue("Adopted instance resolves", Handle.IsValid());
+    TestEqual("Custom data adopted", Handle.Component->GetInstanceCustomDataValue(Handle.InstanceIndex, 0), 17.0f);
+    TestTrue("Transform adopted", Chunked->GetInstanceTransform(17).GetLocation().Equals(FVector(4000.0f, 170.0f, 0)));
+
+    // Every chunk is an ordinary registered runtime component
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    TestTrue("Chunks registered with the subsystem", Subsystem->GetLiveComponents().Contains(Chunked->GetChunkComponent(0)));
+
+    World->DestroyWorld(false);
+
+    return true;
+}
@@ -3,6 +3,10 @@
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Misc/AutomationTest.h"
 #include "ISMTestHelpers.h"
+#include "ISMQueryFilter.h"
+#include "ISMBakedInstanceState.h"
+#include "Settings/ISMRuntimeSettings.h"
+#include "Feedbacks/ISMFeedbackSubsystem.h"
 #include "Engine/World.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "GameFramework/Actor.h"
@@ -361,6 +365,57 @@ bool FISMRuntimeComponentBatchAddTest::RunTest(const FString& Parameters)
     return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentBulkAppendTest,
+    "ISMRuntime.Core.Component.BulkAppendInstances",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentBulkAppendTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* RuntimeComp = FISMTestHelpers::CreateTestComponent(World, 10);
+    RuntimeComp->ManagedISMComponent->SetNumCustomDataFloats(2);
+
+    TArray<FTransform> Transforms;
+    TArray<float> CustomData;
+    for (int32 i = 0; i < 200; i++)
+    {
+        Transforms.Add(FTransform(FVector(i * 50.0f, 1000.0f, 0.0f)));
+        CustomData.Add(static_cast<float>(i));
+        CustomData.Add(-static_cast<float>(i));
+    }
+
+    int32 AddedBroadcasts = 0;
+    int32 BatchBroadcasts = 0;
+    RuntimeComp->OnBatchInstancesAddedNative.AddLambda([&](UISMRuntimeComponent*, const TArray<int32>&) { ++AddedBroadcasts; });
+    RuntimeComp->OnInstancesChangedBatchNative.AddLambda([&](UISMRuntimeComponent*, TArrayView<const int32>) { ++BatchBroadcasts; });
+
+    // ACT
+    const TArray<int32> NewIndices = RuntimeComp->BulkAppendInstances(Transforms, CustomData, 2);
+
+    // ASSERT
+    TestEqual("Should return 200 indices", NewIndices.Num(), 200);
+    TestEqual("Should have 210 instances", RuntimeComp->GetInstanceCount(), 210);
+    TestEqual("All should be active", RuntimeComp->GetActiveInstanceCount(), 210);
+    TestEqual("New instances follow the existing ones", NewIndices.Num() > 0 ? NewIndices[0] : INDEX_NONE, 10);
+    TestEqual("One batch-added event", AddedBroadcasts, 1);
+    TestEqual("One batch-changed event", BatchBroadcasts, 1);
+
+    const TConstArrayView<float> Row = RuntimeComp->GetInstanceCustomDataView(NewIndices.Last());
+    TestEqual("Custom data copied", Row.Num() == 2 ? Row[1] : 0.0f, -199.0f);
+
+    TArray<int32> Found = RuntimeComp->GetInstancesInBox(FBox(FVector(-1.0f, 999.0f, -1.0f), FVector(10001.0f, 1001.0f, 1.0f)));
+    TestEqual("Spatial index holds the new instances", Found.Num(), 200);
+    TestTrue("Intact tag applied", RuntimeComp->InstanceHasTag(NewIndices[0], FGameplayTag::RequestGameplayTag("ISM.State.Intact")));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FISMRuntimeComponentAddPerformanceTest,
     "ISMRuntime.Core.Component.AddPerformance",
@@ -416,4 +471,1317 @@ bool FISMRuntimeComponentAddPerformanceTest::RunTest(const FString& Parameters)
     World->DestroyWorld(false);
 
     return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentSpatialSnapshotTest,
+    "ISMRuntime.Core.Component.SpatialIndexSnapshot",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentSpatialSnapshotTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        FTransform Transform;
+        Transform.SetLocation(FVector(i * 100.0f, 0, 0));
+        ISM->AddInstance(Transform);
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    TestFalse("No snapshot before first publish", RuntimeComp->GetSpatialIndexSnapshot().IsValid());
+
+    // ACT - Publish, then move an instance on the live index
+    RuntimeComp->PublishSpatialIndexSnapshot();
+    FISMSpatialIndexSnapshot Before = RuntimeComp->GetSpatialIndexSnapshot();
+
+    FTransform Moved;
+    Moved.SetLocation(FVector(50000, 0, 0));
+    RuntimeComp->UpdateInstanceTransform(0, Moved);
+
+    // ASSERT - Held snapshot is stable; the next publish sees the move
+    TArray<int32> Results;
+    Before->QueryRadiusExact(FVector::ZeroVector, 10.0f, Results);
+    TestTrue("Old snapshot still has instance at origin", Results.Contains(0));
+
+    RuntimeComp->PublishSpatialIndexSnapshot();
+    FISMSpatialIndexSnapshot After = RuntimeComp->GetSpatialIndexSnapshot();
+    TestTrue("Publish after a change swaps the snapshot", After != Before);
+
+    After->QueryRadiusExact(FVector(50000, 0, 0), 10.0f, Results);
+    TestTrue("New snapshot sees the move", Results.Contains(0));
+
+    RuntimeComp->PublishSpatialIndexSnapshot();
+    TestTrue("Unchanged index keeps the same snapshot", RuntimeComp->GetSpatialIndexSnapshot() == After);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentMortonOrderTest,
+    "ISMRuntime.Core.Component.MortonOrder",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentMortonOrderTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Instances added in reverse spatial order
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+
+    const int32 NumInstances = 16;
+    TArray<FVector> OriginalLocations;
+    for (int32 i = 0; i < NumInstances; i++)
+    {
+        const FVector Location((NumInstances - 1 - i) * 100.0f, (i % 4) * 100.0f, 0);
+        OriginalLocations.Add(Location);
+        ISM->AddInstance(FTransform(Location));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bMortonOrderInstances = true;
+    RuntimeComp->RegisterComponent();
+
+    // ACT
+    RuntimeComp->InitializeInstances();
+
+    // ASSERT - Remap is a permutation and follows the instances
+    const TArray<int32>& Remap = RuntimeComp->GetInitialIndexRemap();
+    TestEqual("Remap covers every instance", Remap.Num(), NumInstances);
+
+    TBitArray<> Seen(false, NumInstances);
+    for (int32 Original = 0; Original < NumInstances; Original++)
+    {
+        const int32 NewIndex = RuntimeComp->GetRemappedInitialIndex(Original);
+        TestTrue("Remapped index is valid", ISM->IsValidInstance(NewIndex));
+        TestFalse("Remapped index is unique", Seen[NewIndex]);
+        Seen[NewIndex] = true;
+
+        TestTrue("Instance moved with its remapped index",
+            RuntimeComp->GetInstanceLocation(NewIndex).Equals(OriginalLocations[Original], 0.1f));
+    }
+
+    TestEqual("Morton code of origin is zero", FISMSpatialIndex::EncodeMorton3D(0, 0, 0), (uint64)0);
+    TestEqual("X occupies the lowest bit", FISMSpatialIndex::EncodeMorton3D(1, 0, 0), (uint64)1);
+    TestEqual("Z occupies the third bit", FISMSpatialIndex::EncodeMorton3D(0, 0, 1), (uint64)4);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceStateStoreTest,
+    "ISMRuntime.Core.Component.InstanceStateStore",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceStateStoreTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - 21 slots so the flag count crosses the 8-byte fast path; slot 20 left empty
+    FISMInstanceStateStore Store;
+    for (int32 i = 0; i < 20; i++)
+    {
+        Store.Add(i, 1);
+    }
+    Store.SetWorldBounds(20, FBox(FVector(-1), FVector(1)));
+
+    // ACT
+    Store.MarkDestroyed(3);
+    Store.SetFlag(9, EISMInstanceState::Hidden, true);
+    Store.SetFlag(17, EISMInstanceState::Collected, true);
+    Store.SetFlag(20, EISMInstanceState::Hidden, true);
+
+    // ASSERT
+    TestEqual("Slots", Store.Num(), 21);
+    TestFalse("Bounds alone do not create state", Store.Contains(20));
+    TestEqual("Absent slot keeps zero flags", Store.GetFlags(20), (uint8)0);
+    TestTrue("New state starts intact", Store.HasFlag(0, EISMInstanceState::Intact));
+    TestFalse("Destroy clears intact", Store.HasFlag(3, EISMInstanceState::Intact));
+    TestEqual("Active count", Store.CountWithoutFlags(FISMInstanceStateStore::InactiveMask), 17);
+
+    TArray<int32> NotDestroyed;
+    Store.GatherWithoutFlags(static_cast<uint8>(EISMInstanceState::Destroyed), NotDestroyed);
+    TestEqual("Gather skips destroyed and absent", NotDestroyed.Num(), 19);
+    TestFalse("Gather skipped index 3", NotDestroyed.Contains(3));
+
+    TestNull("No pre-hide transform until one is stored", Store.GetLastVisibleTransform(9));
+    Store.SetLastVisibleTransform(9, FTransform(FVector(5, 0, 0)));
+    TestNotNull("Pre-hide transform stored", Store.GetLastVisibleTransform(9));
+    TestNull("Other slots still untracked", Store.GetLastVisibleTransform(8));
+    TestEqual("Side table holds only the hidden instance", Store.GetColdEntryCount(), 1);
+
+    FISMInstanceState State = Store.ToInstanceState(9);
+    TestTrue("AoS view carries flags", State.HasFlag(EISMInstanceState::Hidden));
+    TestTrue("AoS view carries pre-hide transform", State.bHasLastVisibleTransform);
+
+    Store.ClearLastVisibleTransform(9);
+    TestEqual("Side table empties on show", Store.GetColdEntryCount(), 0);
+
+    FBox Bounds;
+    TestTrue("Bounds recorded on slot 20", Store.GetWorldBounds(20, Bounds));
+    TestTrue("Bounds round-trip", Bounds.Max.Equals(FVector(1)));
+    TestFalse("No bounds on slot 0", Store.GetWorldBounds(0, Bounds));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentRecycleSlotsTest,
+    "ISMRuntime.Core.Component.RecycleDestroyedSlots",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentRecycleSlotsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+
+    for (int32 i = 0; i < 5; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bRecycleDestroyedInstances = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    // ACT - Destroy and hide, then add
+    RuntimeComp->DestroyInstance(1);
+    RuntimeComp->DestroyInstance(3);
+    RuntimeComp->HideInstance(4);
+
+    // ASSERT - Counters track the transitions
+    TestEqual("Active count", RuntimeComp->GetActiveInstanceCount(), 2);
+    TestEqual("Destroyed count", RuntimeComp->GetInstanceCountInState(EISMInstanceState::Destroyed), 2);
+    TestEqual("Hidden count", RuntimeComp->GetInstanceCountInState(EISMInstanceState::Hidden), 1);
+
+    TArray<int32> Batchable;
+    RuntimeComp->GetBatchableInstanceIndices(Batchable);
+    TestEqual("Batchable skips destroyed", Batchable, TArray<int32>({ 0, 2, 4 }));
+
+    const FVector NewLocation(5000, 0, 0);
+    const int32 Recycled = RuntimeComp->AddInstance(FTransform(NewLocation));
+    TestEqual("Lowest destroyed slot reused", Recycled, 1);
+    TestEqual("ISM did not grow", ISM->GetInstanceCount(), 5);
+    TestTrue("Recycled instance is active", RuntimeComp->IsInstanceActive(Recycled));
+    TestFalse("Destroyed tag cleared", RuntimeComp->InstanceHasTag(Recycled, FGameplayTag::RequestGameplayTag("ISM.State.Destroyed")));
+    TestEqual("Active count after recycle", RuntimeComp->GetActiveInstanceCount(), 3);
+
+    TArray<int32> Nearby = RuntimeComp->GetInstancesInRadius(NewLocation, 10.0f);
+    TestTrue("Spatial index moved the recycled slot", Nearby.Contains(Recycled));
+
+    // Batch lock blocks recycling
+    RuntimeComp->SetBatchLocked(true);
+    const int32 Appended = RuntimeComp->AddInstance(FTransform(FVector(6000, 0, 0)));
+    RuntimeComp->SetBatchLocked(false);
+    TestEqual("Locked component appends", Appended, 5);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentCellStructureGenerationTest,
+    "ISMRuntime.Core.Component.CellStructureGenerations",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentCellStructureGenerationTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Four instances in cell 0, one in cell 5 (1000 unit cells)
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 4; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+    ISM->AddInstance(FTransform(FVector(5000, 0, 0)));
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bRecycleDestroyedInstances = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FIntVector Cell0(0, 0, 0);
+    const FIntVector Cell5(5, 0, 0);
+    const FIntVector Cell9(9, 0, 0);
+    const uint32 Cell0Before = RuntimeComp->GetCellStructureGeneration(Cell0);
+    const uint32 Cell5Before = RuntimeComp->GetCellStructureGeneration(Cell5);
+
+    // ACT / ASSERT - Destroying keeps the index meaning the same instance
+    RuntimeComp->DestroyInstance(1);
+    TestEqual("Destroy leaves the cell generation", RuntimeComp->GetCellStructureGeneration(Cell0), Cell0Before);
+
+    // Recycling slot 1 into cell 9 changes the cells it left and entered, nothing else
+    const uint32 Cell9Before = RuntimeComp->GetCellStructureGeneration(Cell9);
+    TestEqual("Slot recycled", RuntimeComp->AddInstance(FTransform(FVector(9000, 0, 0))), 1);
+    TestNotEqual("Left cell changed", RuntimeComp->GetCellStructureGeneration(Cell0), Cell0Before);
+    TestNotEqual("Entered cell changed", RuntimeComp->GetCellStructureGeneration(Cell9), Cell9Before);
+    TestEqual("Unrelated cell kept its generation", RuntimeComp->GetCellStructureGeneration(Cell5), Cell5Before);
+
+    // A slot that crossed cells may sit in an older snapshot of either, so its recycle changes every cell
+    RuntimeComp->UpdateInstanceTransform(2, FTransform(FVector(5500, 0, 0)));
+    TestEqual("Moving changes no generation", RuntimeComp->GetCellStructureGeneration(Cell5), Cell5Before);
+    RuntimeComp->DestroyInstance(2);
+    const uint32 Cell9AfterRecycle = RuntimeComp->GetCellStructureGeneration(Cell9);
+    TestEqual("Crossed slot recycled", RuntimeComp->AddInstance(FTransform(FVector(100, 0, 0))), 2);
+    TestNotEqual("Cell the slot moved through changed", RuntimeComp->GetCellStructureGeneration(Cell5), Cell5Before);
+    TestNotEqual("Every other cell changed too", RuntimeComp->GetCellStructureGeneration(Cell9), Cell9AfterRecycle);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentInstanceColumnsTest,
+    "ISMRuntime.Core.Component.InstanceColumns",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentInstanceColumnsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 3; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bRecycleDestroyedInstances = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FName HealthColumn(TEXT("Test.Health"));
+
+    // ACT
+    TArrayView<float> Health = RuntimeComp->RegisterInstanceColumn<float>(HealthColumn, 100.0f);
+
+    // ASSERT - Dense, defaulted, typed
+    TestEqual("Column covers existing instances", Health.Num(), 3);
+    TestEqual("Default applied", Health[2], 100.0f);
+    Health[1] = 25.0f;
+
+    TestEqual("Re-register returns the same column", RuntimeComp->RegisterInstanceColumn<float>(HealthColumn)[1], 25.0f);
+    TestEqual("Mismatched type is rejected", RuntimeComp->GetInstanceColumn<double>(HealthColumn).Num(), 0);
+
+    const int32 Added = RuntimeComp->AddInstance(FTransform(FVector(500, 0, 0)));
+    TArrayView<float> Grown = RuntimeComp->GetInstanceColumn<float>(HealthColumn);
+    TestEqual("Column grows with instances", Grown.Num(), 4);
+    TestEqual("Added instance gets default", Grown[Added], 100.0f);
+
+    RuntimeComp->DestroyInstance(1);
+    const int32 Recycled = RuntimeComp->AddInstance(FTransform(FVector(600, 0, 0)));
+    TestEqual("Slot recycled", Recycled, 1);
+    TestEqual("Recycled slot reset to default", *RuntimeComp->GetInstanceColumnValue<float>(HealthColumn, Recycled), 100.0f);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentCompactTagsTest,
+    "ISMRuntime.Core.Component.CompactInstanceTags",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentCompactTagsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 3; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bCompactInstanceTags = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+    const FGameplayTag VegetationTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation");
+    const FGameplayTag DestroyedTag = FGameplayTag::RequestGameplayTag("ISM.State.Destroyed");
+
+    // ACT
+    RuntimeComp->AddInstanceTag(0, TreeTag);
+    RuntimeComp->AddInstanceTag(1, TreeTag);
+    RuntimeComp->AddInstanceTag(1, DestroyedTag);
+
+    FGameplayTagContainer Required(VegetationTag);
+    FGameplayTagContainer Excluded(DestroyedTag);
+
+    // ASSERT - Stored as masks, matched hierarchically
+    TestTrue("Tags held compactly", RuntimeComp->PerInstanceTags.Num() == 0);
+    TestTrue("Parent tag matches child", RuntimeComp->InstanceHasTag(0, VegetationTag));
+    TestTrue("Instance 0 passes", RuntimeComp->InstancePassesTagFilter(0, Required, Excluded));
+    TestFalse("Instance 1 excluded", RuntimeComp->InstancePassesTagFilter(1, Required, Excluded));
+    TestFalse("Instance 2 lacks required tag", RuntimeComp->InstancePassesTagFilter(2, Required, Excluded));
+    TestTrue("Container view agrees", RuntimeComp->GetInstanceTags(1).HasTag(DestroyedTag));
+
+    FISMQueryFilter Filter;
+    Filter.RequiredTags = Required;
+    Filter.ExcludedTags = Excluded;
+    FISMInstanceReference Ref;
+    Ref.Component = RuntimeComp;
+    Ref.InstanceIndex = 0;
+    TestTrue("Query filter uses compact tags", Filter.PassesFilter(Ref));
+
+    // ACT - Removing the only child clears the implied parent
+    RuntimeComp->RemoveInstanceTag(0, TreeTag);
+
+    // ASSERT
+    TestFalse("Parent no longer implied", RuntimeComp->InstanceHasTag(0, VegetationTag));
+
+    // ACT - Component tags count for every instance
+    RuntimeComp->ISMComponentTags.AddTag(TreeTag);
+
+    // ASSERT
+    TestTrue("Component tag satisfies requirement", RuntimeComp->InstancePassesTagFilter(2, Required, Excluded));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentQuerySinkTest,
+    "ISMRuntime.Core.Component.QueryIntoCallerBuffers",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentQuerySinkTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 10; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 50.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+    RuntimeComp->DestroyInstance(2);
+
+    // ACT - Append overload keeps existing entries
+    TArray<int32> Buffer;
+    Buffer.Add(-7);
+    RuntimeComp->GetInstancesInRadius(FVector::ZeroVector, 225.0f, Buffer);
+
+    const TArray<int32> ByValue = RuntimeComp->GetInstancesInRadius(FVector::ZeroVector, 225.0f);
+
+    // ASSERT
+    TestEqual("Existing entry kept", Buffer[0], -7);
+    TestEqual("Appended the same results", Buffer.Num() - 1, ByValue.Num());
+    TestEqual("Destroyed instance skipped", ByValue.Num(), 4);
+    TestFalse("Destroyed index absent", Buffer.Contains(2));
+
+    // ACT - Visitor stops when asked
+    int32 Visited = 0;
+    const bool bCompleted = RuntimeComp->ForEachInstanceInRadius(FVector::ZeroVector, 1000.0f, [&Visited](int32)
+        {
+            return ++Visited < 3;
+        });
+
+    // ASSERT
+    TestFalse("Visitor stopped early", bCompleted);
+    TestEqual("Visited until stop", Visited, 3);
+
+    // ACT - Filtered query respects MaxResults per call
+    FISMQueryFilter Filter;
+    Filter.MaxResults = 2;
+    Buffer.Reset();
+    RuntimeComp->QueryInstances(FVector::ZeroVector, 1000.0f, Filter, Buffer);
+    RuntimeComp->QueryInstances(FVector::ZeroVector, 1000.0f, Filter, Buffer);
+
+    // ASSERT
+    TestEqual("MaxResults counts appended entries", Buffer.Num(), 4);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentBatchUpdateTransformsTest,
+    "ISMRuntime.Core.Component.BatchUpdateInstanceTransforms",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentBatchUpdateTransformsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 6; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    // Run 1..3, a lone 5, an invalid index and a hide via zero scale
+    const TArray<int32> Indices = { 1, 2, 3, 5, 99, 0 };
+    TArray<FTransform> Transforms;
+    for (int32 i = 0; i < 5; i++)
+    {
+        Transforms.Add(FTransform(FVector(0, 5000.0f + i * 100.0f, 0)));
+    }
+    Transforms.Add(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector));
+
+    // ACT
+    RuntimeComp->BatchUpdateInstanceTransforms(Indices, Transforms, true);
+
+    // ASSERT
+    TestTrue("Run start moved", RuntimeComp->GetInstanceLocation(1).Equals(FVector(0, 5000, 0)));
+    TestTrue("Run end moved", RuntimeComp->GetInstanceLocation(3).Equals(FVector(0, 5200, 0)));
+    TestTrue("Lone index moved", RuntimeComp->GetInstanceLocation(5).Equals(FVector(0, 5300, 0)));
+    TestTrue("Untouched instance stays", RuntimeComp->GetInstanceLocation(4).Equals(FVector(400, 0, 0)));
+
+    const TArray<int32> NearOldSpot = RuntimeComp->GetInstancesInRadius(FVector(200, 0, 0), 50.0f);
+    TestEqual("Spatial index forgot old position", NearOldSpot.Num(), 0);
+    const TArray<int32> NearNewSpot = RuntimeComp->GetInstancesInRadius(FVector(0, 5100, 0), 50.0f);
+    TestEqual("Spatial index knows new position", NearNewSpot.Num(), 1);
+
+    TestNotNull("Zero scale remembers visible transform",
+        RuntimeComp->GetInstanceStateStore().GetLastVisibleTransform(0));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentBulkCustomDataTest,
+    "ISMRuntime.Core.Component.BulkCustomData",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentBulkCustomDataTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 4; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+    RuntimeComp->SetCustomDataCount(3, true, 0.0f);
+
+    // ACT - Write slots 1..2 of instances 1, 3 and an invalid index
+    const TArray<int32> Indices = { 1, 3, 99 };
+    const TArray<float> Block = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    const bool bWrote = RuntimeComp->WriteInstanceCustomData(Indices, 1, 2, Block);
+
+    // ASSERT
+    TestTrue("Block written", bWrote);
+    TestEqual("Slot 0 untouched", RuntimeComp->GetInstanceCustomDataValue(1, 0), 0.0f);
+    TestEqual("Row 0 slot 1", RuntimeComp->GetInstanceCustomDataValue(1, 1), 1.0f);
+    TestEqual("Row 1 slot 2", RuntimeComp->GetInstanceCustomDataValue(3, 2), 4.0f);
+
+    const TConstArrayView<float> View = RuntimeComp->GetInstanceCustomDataView(3);
+    TestEqual("View spans every slot", View.Num(), 3);
+    TestEqual("View reads in place", View[1], 3.0f);
+
+    // ACT - Range read past the last slot and the last instance zero-fills
+    TArray<float> Out;
+    Out.SetNumUninitialized(3 * 3);
+    const bool bRead = RuntimeComp->ReadInstanceCustomDataRange(2, 3, 1, 3, Out);
+
+    // ASSERT
+    TestTrue("Range read", bRead);
+    TestEqual("Row 1 slot 1", Out[3], 3.0f);
+    TestEqual("Row 1 slot 2", Out[4], 4.0f);
+    TestEqual("Missing slot reads 0", Out[5], 0.0f);
+    TestEqual("Missing instance reads 0", Out[6], 0.0f);
+
+    // ACT / ASSERT - Mismatched buffer is rejected
+    TestFalse("Short buffer rejected", RuntimeComp->ReadInstanceCustomData(Indices, 0, 3, TArrayView<float>(Out.GetData(), 4)));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentCustomDataSlotTest,
+    "ISMRuntime.Core.Component.CustomDataSlotWrite",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentCustomDataSlotTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 20; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+    RuntimeComp->SetCustomDataCount(3, true, 0.0f);
+
+    // ACT - Fill one slot on every instance
+    const int32 NumFilled = RuntimeComp->FillCustomDataSlot(2, 0.5f);
+
+    // ASSERT
+    TestEqual("Every instance filled", NumFilled, 20);
+    TestEqual("First instance", RuntimeComp->GetInstanceCustomDataValue(0, 2), 0.5f);
+    TestEqual("Last instance", RuntimeComp->GetInstanceCustomDataValue(19, 2), 0.5f);
+    TestEqual("Other slots untouched", RuntimeComp->GetInstanceCustomDataValue(7, 1), 0.0f);
+
+    // ACT - Small range takes the per-instance upload path, large one the in-place path
+    RuntimeComp->PartialCustomDataUploadFraction = 0.1f;
+    const TArray<float> Small = { 1.0f, 2.0f };
+    const int32 NumSmall = RuntimeComp->WriteCustomDataSlot(0, Small, 4);
+
+    TArray<float> Large;
+    for (int32 i = 0; i < 30; i++)
+    {
+        Large.Add(10.0f + i);
+    }
+    const int32 NumLarge = RuntimeComp->WriteCustomDataSlot(1, Large, 5);
+
+    // ASSERT
+    TestEqual("Small range written", NumSmall, 2);
+    TestEqual("Small range first", RuntimeComp->GetInstanceCustomDataValue(4, 0), 1.0f);
+    TestEqual("Small range second", RuntimeComp->GetInstanceCustomDataValue(5, 0), 2.0f);
+    TestEqual("Small range stops", RuntimeComp->GetInstanceCustomDataValue(6, 0), 0.0f);
+
+    TestEqual("Large range clipped to instance count", NumLarge, 15);
+    TestEqual("Large range first", RuntimeComp->GetInstanceCustomDataValue(5, 1), 10.0f);
+    TestEqual("Large range last", RuntimeComp->GetInstanceCustomDataValue(19, 1), 24.0f);
+    TestEqual("Before range untouched", RuntimeComp->GetInstanceCustomDataValue(4, 1), 0.0f);
+    TestEqual("Neighbouring slot untouched", RuntimeComp->GetInstanceCustomDataValue(19, 2), 0.5f);
+
+    // ACT / ASSERT - Out-of-range slot writes nothing
+    TestEqual("Slot past count rejected", RuntimeComp->WriteCustomDataSlot(3, Small), 0);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentCustomDataJournalTest,
+    "ISMRuntime.Core.Component.CustomDataJournal",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentCustomDataJournalTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 4; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bEnableCustomDataJournal = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+    RuntimeComp->SetCustomDataCount(2, true, 0.0f);
+
+    const FISMCustomDataJournal& Journal = RuntimeComp->GetCustomDataJournal();
+    TestTrue("Journal on", Journal.IsEnabled());
+    TestFalse("Watermark from before the layout change needs a snapshot", Journal.CanCatchUp(0));
+
+    // ACT - Write one slot twice and another once
+    const uint32 Watermark = Journal.GetWatermark();
+    RuntimeComp->SetInstanceCustomDataValue(1, 0, 3.0f);
+    RuntimeComp->SetInstanceCustomDataValue(2, 1, 4.0f);
+    RuntimeComp->SetInstanceCustomDataValue(1, 0, 5.0f);
+
+    TArray<FISMCustomDataDelta> Deltas;
+    const bool bCaughtUp = RuntimeComp->GetCustomDataJournal().CollectSince(Watermark, Deltas);
+
+    // ASSERT - Last write wins, oldest surviving delta first
+    TestTrue("Caught up from deltas", bCaughtUp);
+    TestEqual("One delta per written slot", Deltas.Num(), 2);
+    if (Deltas.Num() == 2)
+    {
+        TestEqual("Older delta first", Deltas[0].InstanceIndex, 2);
+        TestEqual("Rewritten slot keeps its last value", Deltas[1].Value, 5.0f);
+    }
+
+    // ACT - A consumer past the writes sees nothing; trimming keeps later deltas
+    const uint32 Later = Journal.GetWatermark();
+    Deltas.Reset();
+    RuntimeComp->GetCustomDataJournal().CollectSince(Later, Deltas);
+    TestEqual("Nothing after the latest watermark", Deltas.Num(), 0);
+
+    RuntimeComp->SetInstanceCustomDataValue(3, 1, 6.0f);
+    RuntimeComp->GetCustomDataJournal().Trim(Later);
+
+    // ASSERT
+    TestEqual("Trim drops deltas older than the watermark", Journal.Num(), 1);
+    Deltas.Reset();
+    RuntimeComp->GetCustomDataJournal().CollectSince(Later, Deltas);
+    TestEqual("Newer delta survives", Deltas.Num(), 1);
+
+    // ACT / ASSERT - Layout change forces a snapshot
+    RuntimeComp->SetCustomDataCount(3);
+    TestFalse("Resize invalidates old watermarks", Journal.CanCatchUp(Later));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentIncrementalBoundsTest,
+    "ISMRuntime.Core.Component.IncrementalBounds",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentIncrementalBoundsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Two instances share a cell, the third sits in the next one
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    ISM->AddInstance(FTransform(FVector(100, 0, 0)));
+    ISM->AddInstance(FTransform(FVector(500, 0, 0)));
+    ISM->AddInstance(FTransform(FVector(1500, 0, 0)));
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->SpatialIndexCellSize = 1000.0f;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    const float Padding = 100.0f - RuntimeComp->GetInstanceBounds().Min.X;
+
+    // ACT - Removing the far instance empties its cell
+    RuntimeComp->DestroyInstance(2, true);
+
+    // ASSERT
+    TestTrue("Bounds still valid", RuntimeComp->IsBoundsValid());
+    TestEqual("Max shrank to the remaining cell", RuntimeComp->GetInstanceBounds().Max.X, 500.0f + Padding);
+
+    // ACT - Removing a face of the remaining cell rescans it
+    RuntimeComp->HideInstance(0, true);
+
+    // ASSERT
+    TestEqual("Min shrank within the cell", RuntimeComp->GetInstanceBounds().Min.X, 500.0f - Padding);
+
+    // ACT - Moving the last instance grows bounds to its new spot only
+    RuntimeComp->UpdateInstanceTransform(1, FTransform(FVector(-2000, 0, 0)), true, true);
+
+    // ASSERT
+    TestEqual("Min follows the move", RuntimeComp->GetInstanceBounds().Min.X, -2000.0f - Padding);
+    TestEqual("Max follows the move", RuntimeComp->GetInstanceBounds().Max.X, -2000.0f + Padding);
+
+    // ACT - No active instances left
+    RuntimeComp->DestroyInstance(1, true);
+
+    // ASSERT
+    TestFalse("Bounds invalid when empty", RuntimeComp->IsBoundsValid());
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentBatchShowTest,
+    "ISMRuntime.Core.Component.BatchShowInstances",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentBatchShowTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* RuntimeComp = FISMTestHelpers::CreateTestComponent(World, 10);
+    const FVector Location = RuntimeComp->GetInstanceLocation(3);
+
+    RuntimeComp->HideInstance(3);
+    RuntimeComp->HideInstance(5);
+
+    // ACT - Visible and invalid indices are skipped
+    RuntimeComp->BatchShowInstances({ 3, 4, 5, 999 }, true);
+
+    // ASSERT
+    TestFalse("Instance 3 shown", RuntimeComp->IsInstanceHidden(3));
+    TestFalse("Instance 5 shown", RuntimeComp->IsInstanceHidden(5));
+    TestEqual("No hidden instances left", RuntimeComp->GetInstanceCountInState(EISMInstanceState::Hidden), 0);
+    TestEqual("Shown instance restored in place", RuntimeComp->GetInstanceLocation(3), Location);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentOpCountersTest,
+    "ISMRuntime.Core.Component.OpCounters",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentOpCountersTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* RuntimeComp = FISMTestHelpers::CreateTestComponent(World, 10);
+    RuntimeComp->ResetOpCounters();
+    RuntimeComp->SetHotInstanceSampling(true);
+
+    // ACT - Instance 2 moves most, instance 5 once; then an add, a destroy and a query
+    for (int32 i = 0; i < 4; ++i)
+    {
+        RuntimeComp->UpdateInstanceTransform(2, FTransform(FVector(i * 10.0f, 0, 0)));
+    }
+    RuntimeComp->UpdateInstanceTransform(5, FTransform(FVector(0, 500, 0)));
+    RuntimeComp->AddInstance(FTransform(FVector(0, 0, 1000)));
+    RuntimeComp->DestroyInstance(7);
+    RuntimeComp->GetInstancesInRadius(FVector::ZeroVector, 100.0f);
+
+    const FISMComponentOpStats Stats = RuntimeComp->GetOpStats(2);
+
+    // ASSERT
+    TestEqual("Transform updates counted", Stats.GetTotal(EISMComponentOp::TransformUpdate), 5LL);
+    TestEqual("Add counted", Stats.GetTotal(EISMComponentOp::Add), 1LL);
+    TestEqual("Destroy counted", Stats.GetTotal(EISMComponentOp::Destroy), 1LL);
+    TestEqual("Query counted", Stats.GetTotal(EISMComponentOp::Query), 1LL);
+    TestTrue("Destroy broadcast counted", Stats.GetTotal(EISMComponentOp::DelegateBroadcast) >= 1);
+    TestEqual("Two hot instances returned", Stats.HotInstances.Num(), 2);
+    if (Stats.HotInstances.Num() == 2)
+    {
+        TestEqual("Most mutated first", Stats.HotInstances[0].InstanceIndex, 2);
+        TestEqual("Its mutation count", Stats.HotInstances[0].Mutations, 4);
+        TestEqual("Then the single move", Stats.HotInstances[1].InstanceIndex, 5);
+    }
+
+    // ACT - Sampling off drops the samples; reset zeroes the totals
+    RuntimeComp->SetHotInstanceSampling(false);
+    RuntimeComp->ResetOpCounters();
+    const FISMComponentOpStats Cleared = RuntimeComp->GetOpStats(2);
+
+    // ASSERT
+    TestEqual("No samples without sampling", Cleared.HotInstances.Num(), 0);
+    TestEqual("Totals reset", Cleared.GetTotal(EISMComponentOp::TransformUpdate), 0LL);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentParallelInitTest,
+    "ISMRuntime.Core.Component.ParallelInitialize",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentParallelInitTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE / ACT - Enough instances for InitializeInstances to go wide
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* RuntimeComp = FISMTestHelpers::CreateTestComponent(World, 5000, 100.0f);
+
+    // ASSERT - State, spatial index and bounds match the ISM's instances
+    TestEqual("Should have 5000 instances", RuntimeComp->GetInstanceCount(), 5000);
+    TestEqual("All should be active initially", RuntimeComp->GetActiveInstanceCount(), 5000);
+    TestEqual("Location read from the instance data", RuntimeComp->GetInstanceLocation(4321), FVector(100.0f, 43200.0f, 0.0f));
+    TestEqual("Radius query finds the corner instances", RuntimeComp->GetInstancesInRadius(FVector::ZeroVector, 150.0f).Num(), 4);
+
+    TArray<int32> FarCorner = RuntimeComp->GetInstancesInRadius(FVector(900.0f, 49900.0f, 0.0f), 10.0f);
+    TestEqual("Last instance indexed", FarCorner.Num(), 1);
+    TestTrue("Last instance index", FarCorner.Num() == 1 && FarCorner[0] == 4999);
+
+    TestTrue("Bounds valid", RuntimeComp->IsBoundsValid());
+    TestTrue("Bounds cover every instance",
+        RuntimeComp->GetInstanceBounds().IsInsideOrOn(FVector(0.0f, 0.0f, 0.0f)) &&
+        RuntimeComp->GetInstanceBounds().IsInsideOrOn(FVector(900.0f, 49900.0f, 0.0f)));
+
+    // ACT - Slots behave like ones created through Add
+    RuntimeComp->DestroyInstance(10);
+
+    // ASSERT
+    TestEqual("Destroy updates the active count", RuntimeComp->GetActiveInstanceCount(), 4999);
+    TestFalse("Destroyed instance inactive", RuntimeComp->IsInstanceActive(10));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentBakedBoundsTest,
+    "ISMRuntime.Core.Component.BakedBounds",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentBakedBoundsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Bake an initialized component with one destroyed instance
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* Source = FISMTestHelpers::CreateTestComponent(World, 50, 100.0f);
+    Source->DestroyInstance(3);
+
+    UISMBakedInstanceState* Baked = NewObject<UISMBakedInstanceState>();
+    TestTrue("Bake succeeds", Source->BakeState(Baked));
+    TestEqual("World locations baked", Baked->WorldLocations.Num(), 50);
+    TestTrue("Cell bounds baked", Baked->BoundsCellKeys.Num() > 0);
+    TestTrue("Component bounds baked", Baked->InstanceBounds.IsValid != 0);
+
+    // ACT - Start a second, empty component from the bake
+    AActor* TestActor = World->SpawnActor<AActor>();
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->BakedState = Baked;
+    RuntimeComp->RegisterComponent();
+    ISM->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+
+    // ASSERT - Index, state and bounds come straight from the bake
+    TestTrue("Initialized from the bake", RuntimeComp->WasInitializedFromBakedState());
+    TestEqual("Instances restored", RuntimeComp->GetInstanceCount(), 50);
+    TestEqual("Destroyed instance stays destroyed", RuntimeComp->GetActiveInstanceCount(), 49);
+    TestEqual("Radius query uses the baked cells", RuntimeComp->GetInstancesInRadius(FVector::ZeroVector, 150.0f).Num(), 4);
+    TestTrue("Bounds valid", RuntimeComp->IsBoundsValid());
+    TestTrue("Bounds match the source", RuntimeComp->GetInstanceBounds().Equals(Source->GetInstanceBounds()));
+    TestTrue("Bake is up to date with the restored ISM", Baked->IsUpToDateWith(RuntimeComp));
+
+    // ACT - Editing the ISM makes the bake stale
+    RuntimeComp->UpdateInstanceTransform(0, FTransform(FVector(-500.0f, 0.0f, 0.0f)));
+
+    // ASSERT
+    TestFalse("Moved instance invalidates the bake", Baked->IsUpToDateWith(RuntimeComp));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentSaveLoadStateTest,
+    "ISMRuntime.Core.Component.SaveLoadRuntimeState",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentSaveLoadStateTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Two components over the same instances; play on one of them
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* Played = FISMTestHelpers::CreateTestComponent(World, 40, 100.0f);
+    UISMRuntimeComponent* Fresh = FISMTestHelpers::CreateTestComponent(World, 40, 100.0f);
+    Played->SetCustomDataCount(2, true, 0.0f);
+    Fresh->SetCustomDataCount(2, true, 0.0f);
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+    const FGameplayTag OwnerTag = FGameplayTag::RequestGameplayTag("ISM.State.Selected");
+    Played->DestroyInstance(3);
+    Played->HideInstance(5);
+    Played->AddInstanceTag(7, TreeTag);
+    Played->GetOrCreateHandle(8).SetOwner(OwnerTag);
+    Played->SetInstanceCustomDataValue(9, 1, 0.5f);
+
+    TArray<uint8> Saved;
+    TestTrue("Save succeeds", Played->SaveRuntimeState(Saved));
+    TestTrue("Save is compact", Saved.Num() > 0 && Saved.Num() < 40 * 16);
+
+    // ACT
+    TestTrue("Load succeeds", Fresh->LoadRuntimeState(Saved));
+
+    // ASSERT - Flags, visibility, tags, ownership and custom data carried over
+    TestEqual("Active count", Fresh->GetActiveInstanceCount(), Played->GetActiveInstanceCount());
+    TestTrue("Destroyed restored", Fresh->IsInstanceInState(3, EISMInstanceState::Destroyed));
+    TestTrue("Hidden restored", Fresh->IsInstanceInState(5, EISMInstanceState::Hidden));
+    FTransform HiddenTransform;
+    Fresh->ManagedISMComponent->GetInstanceTransform(5, HiddenTransform, true);
+    TestEqual("Hidden instance scaled away", HiddenTransform.GetScale3D(), FVector::ZeroVector);
+    TestTrue("Tag restored", Fresh->InstanceHasTag(7, TreeTag));
+    TestTrue("Destroyed tag restored", Fresh->InstanceHasTag(3, FGameplayTag::RequestGameplayTag("ISM.State.Destroyed")));
+    TestTrue("Owner restored", Fresh->GetOrCreateHandle(8).IsOwnedBy(OwnerTag));
+    TestEqual("Custom data restored", Fresh->GetInstanceCustomDataValue(9, 1), 0.5f);
+    TestFalse("Destroyed instance left out of queries", Fresh->GetInstancesInRadius(FVector(300.0f, 0.0f, 0.0f), 10.0f).Contains(3));
+
+    // ACT - Loading an untouched save brings the instances back
+    TArray<uint8> Untouched;
+    UISMRuntimeComponent* Pristine = FISMTestHelpers::CreateTestComponent(World, 40, 100.0f);
+    Pristine->SetCustomDataCount(2, true, 0.0f);
+    Pristine->SaveRuntimeState(Untouched);
+    TestTrue("Reload succeeds", Fresh->LoadRuntimeState(Untouched));
+
+    // ASSERT
+    TestEqual("All active again", Fresh->GetActiveInstanceCount(), 40);
+    Fresh->ManagedISMComponent->GetInstanceTransform(5, HiddenTransform, true);
+    TestEqual("Hidden instance shown", HiddenTransform.GetScale3D(), FVector::OneVector);
+    TestFalse("Tag removed", Fresh->InstanceHasTag(7, TreeTag));
+    TestFalse("Owner released", Fresh->GetOrCreateHandle(8).IsOwned());
+
+    // ASSERT - Mismatched or malformed data changes nothing
+    UISMRuntimeComponent* Smaller = FISMTestHelpers::CreateTestComponent(World, 20, 100.0f);
+    TestFalse("Instance count mismatch rejected", Smaller->LoadRuntimeState(Saved));
+    TArray<uint8> Truncated(Saved.GetData(), Saved.Num() / 2);
+    TestFalse("Truncated data rejected", Fresh->LoadRuntimeState(Truncated));
+    TestEqual("Rejected load left state alone", Fresh->GetActiveInstanceCount(), 40);
+
+    // ASSERT - A corrupt size is refused before anything is allocated for it
+    TArray<uint8> HugePlane = Saved;
+    const int32 HugeCount = MAX_int32;
+    FMemory::Memcpy(HugePlane.GetData() + 4 * sizeof(int32) + sizeof(uint8), &HugeCount, sizeof(int32));
+    TestFalse("Oversized bit plane rejected", Fresh->LoadRuntimeState(HugePlane));
+
+    // ARRANGE - Journaled components save custom data as deltas since initialization
+    auto CreateJournaledComponent = [World]()
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+        ISM->RegisterComponent();
+        ISM->SetNumCustomDataFloats(2);
+        for (int32 i = 0; i < 10; i++)
+        {
+            ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+        }
+        UISMRuntimeComponent* Component = NewObject<UISMRuntimeComponent>(Actor);
+        Component->ManagedISMComponent = ISM;
+        Component->bEnableCustomDataJournal = true;
+        Component->RegisterComponent();
+        Component->InitializeInstances();
+        return Component;
+    };
+    UISMRuntimeComponent* JournaledPlayed = CreateJournaledComponent();
+    UISMRuntimeComponent* JournaledFresh = CreateJournaledComponent();
+    JournaledPlayed->SetInstanceCustomDataValue(2, 1, 0.5f);
+    TArray<uint8> SavedDeltas;
+    JournaledPlayed->SaveRuntimeState(SavedDeltas);
+    TArray<uint8> UntouchedDeltas;
+    CreateJournaledComponent()->SaveRuntimeState(UntouchedDeltas);
+
+    // ACT / ASSERT - Deltas apply to a fresh component
+    TestTrue("Delta load into a fresh component succeeds", JournaledFresh->LoadRuntimeState(SavedDeltas));
+    TestEqual("Delta custom data restored", JournaledFresh->GetInstanceCustomDataValue(2, 1), 0.5f);
+
+    // ACT / ASSERT - Deltas that would leave an earlier write in place are rejected
+    TestFalse("Delta load missing a local change rejected", JournaledFresh->LoadRuntimeState(UntouchedDeltas));
+    TestEqual("Rejected delta load left custom data alone", JournaledFresh->GetInstanceCustomDataValue(2, 1), 0.5f);
+    TestTrue("Delta load overwriting every local change succeeds", JournaledFresh->LoadRuntimeState(SavedDeltas));
+
+    // ASSERT - Without its own journal a component cannot take deltas
+    UISMRuntimeComponent* Unjournaled = CreateJournaledComponent();
+    Unjournaled->GetCustomDataJournal().Disable();
+    TestFalse("Delta load without a journal rejected", Unjournaled->LoadRuntimeState(SavedDeltas));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentCoalescedEventsTest,
+    "ISMRuntime.Core.Component.CoalescedEvents",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentCoalescedEventsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* Component = FISMTestHelpers::CreateTestComponent(World, 20, 100.0f);
+    Component->bCoalesceInstanceEvents = true;
+
+    int32 NumBatches = 0;
+    TArray<int32> BatchInstances;
+    Component->OnInstancesChangedBatchNative.AddLambda([&](UISMRuntimeComponent*, TArrayView<const int32> Instances)
+    {
+        ++NumBatches;
+        BatchInstances = TArray<int32>(Instances.GetData(), Instances.Num());
+    });
+
+    TArray<int32> FlushedStateChanges;
+    Component->OnInstanceEventsFlushedNative.AddLambda([&](UISMRuntimeComponent*, EISMInstanceEvent Event, TArrayView<const int32> Instances)
+    {
+        if (Event == EISMInstanceEvent::StateChanged)
+        {
+            FlushedStateChanges = TArray<int32>(Instances.GetData(), Instances.Num());
+        }
+    });
+
+    int32 NumPerInstanceStateEvents = 0;
+    Component->OnInstanceStateChangedNative.AddLambda([&](UISMRuntimeComponent*, int32) { ++NumPerInstanceStateEvents; });
+
+    TArray<int32> OwnerChanges;
+    Component->OnInstanceOwnerChangedNative.AddLambda([&](UISMRuntimeComponent*, int32 InstanceIndex) { OwnerChanges.Add(InstanceIndex); });
+
+    // ACT - The same instance changed several times, plus a destruction and an owner change
+    Component->HideInstance(5);
+    Component->ShowInstance(5);
+    Component->HideInstance(5);
+    Component->AddInstanceTag(5, FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree"));
+    Component->DestroyInstance(6);
+    Component->GetOrCreateHandle(8).SetOwner(FGameplayTag::RequestGameplayTag("ISM.State.Selected"));
+    Component->GetOrCreateHandle(8).SetOwner(FGameplayTag::RequestGameplayTag("ISM.State.Destroyed"));
+
+    // ASSERT - Nothing reported yet, but the state is already visible
+    TestEqual("No batch before the flush", NumBatches, 0);
+    TestTrue("Events pending", Component->HasPendingInstanceEvents());
+    TestTrue("Destruction applied at once", Component->IsInstanceInState(6, EISMInstanceState::Destroyed));
+
+    // ACT
+    Component->FlushInstanceEvents();
+
+    // ASSERT - One batch with each instance once, in order
+    TestEqual("One batch", NumBatches, 1);
+    TestEqual("Batch lists the changed instances", BatchInstances, TArray<int32>({ 5, 6 }));
+    TestEqual("State span", FlushedStateChanges, TArray<int32>({ 5, 6 }));
+    TestEqual("Per-instance state events stay folded into the batch", NumPerInstanceStateEvents, 0);
+    TestEqual("Owner change reported once", OwnerChanges, TArray<int32>({ 8 }));
+    TestFalse("Nothing pending", Component->HasPendingInstanceEvents());
+
+    // ASSERT - A second flush has nothing to report
+    Component->FlushInstanceEvents();
+    TestEqual("Empty flush is silent", NumBatches, 1);
+
+    // ASSERT - Immediate mode again once coalescing is off
+    Component->bCoalesceInstanceEvents = false;
+    Component->HideInstance(9);
+    TestTrue("Immediate per-instance event", NumPerInstanceStateEvents > 0);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentBulkStateFlagsTest,
+    "ISMRuntime.Core.Component.BulkStateFlags",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentBulkStateFlagsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* Component = FISMTestHelpers::CreateTestComponent(World, 30, 100.0f);
+    Component->DestroyInstance(4);
+    Component->HideInstance(11);
+    const IISMStateProvider* Provider = Component;
+
+    // ACT - Gather through the interface, including an index with no state
+    const TArray<int32> Indices = { 11, 0, 4, 29, 500 };
+    TArray<uint8> Flags;
+    Flags.SetNumZeroed(Indices.Num());
+    Provider->GetStateFlags(Indices, Flags);
+
+    // ASSERT - Matches the per-instance reads
+    for (int32 i = 0; i < Indices.Num(); i++)
+    {
+        TestEqual(FString::Printf(TEXT("Flags of %d"), Indices[i]), Flags[i], Provider->GetInstanceStateFlags(Indices[i]));
+    }
+    TestEqual("No state reads zero", Flags[4], (uint8)0);
+
+    // ASSERT - Raw view is indexed by instance
+    const TConstArrayView<uint8> Raw = Provider->GetStateFlagsRaw();
+    TestEqual("Raw view covers every instance", Raw.Num(), 30);
+    TestTrue("Raw view sees destroyed", (Raw[4] & static_cast<uint8>(EISMInstanceState::Destroyed)) != 0);
+    TestTrue("Raw view sees hidden", (Raw[11] & static_cast<uint8>(EISMInstanceState::Hidden)) != 0);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentCustomDataVisibilityTest,
+    "ISMRuntime.Core.Component.CustomDataVisibility",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentCustomDataVisibilityTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Visibility in custom data slot 1
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* Component = FISMTestHelpers::CreateTestComponent(World, 20, 100.0f);
+    Component->SetCustomDataCount(2, true, 0.0f);
+    Component->VisibilityCustomDataSlot = 1;
+    TestTrue("Slot mode active", Component->UsesCustomDataVisibility());
+
+    int32 NumBatches = 0;
+    Component->OnInstancesChangedBatchNative.AddLambda([&](UISMRuntimeComponent*, TArrayView<const int32>) { ++NumBatches; });
+
+    // ACT
+    Component->BatchHideInstances({ 1, 2, 3 });
+
+    // ASSERT - Flags and slot changed, transforms left alone
+    FTransform Transform;
+    Component->ManagedISMComponent->GetInstanceTransform(2, Transform, true);
+    TestTrue("Hidden flag set", Component->IsInstanceInState(2, EISMInstanceState::Hidden));
+    TestEqual("Hidden in the slot", Component->GetInstanceCustomDataValue(2, 1), 1.0f);
+    TestEqual("Transform kept", Transform.GetScale3D(), FVector::OneVector);
+    TestEqual("Hidden instances inactive", Component->GetActiveInstanceCount(), 17);
+    TestEqual("One batch event", NumBatches, 1);
+    TestFalse("Hidden instance left out of queries", Component->GetInstancesInRadius(FVector(200.0f, 0.0f, 0.0f), 10.0f).Contains(2));
+
+    // ACT - Destroy and show
+    Component->DestroyInstance(5);
+    Component->BatchShowInstances({ 1, 2, 3 });
+
+    // ASSERT
+    Component->ManagedISMComponent->GetInstanceTransform(5, Transform, true);
+    TestEqual("Destroyed through the slot", Component->GetInstanceCustomDataValue(5, 1), 1.0f);
+    TestEqual("Destroyed instance scaled away so its collision goes", Transform.GetScale3D(), FVector::ZeroVector);
+    TestEqual("Shown in the slot", Component->GetInstanceCustomDataValue(2, 1), 0.0f);
+    TestFalse("Hidden flag cleared", Component->IsInstanceInState(2, EISMInstanceState::Hidden));
+    TestEqual("Shown instances active again", Component->GetActiveInstanceCount(), 19);
+
+    // ACT - Loading an untouched save brings the destroyed instance back
+    UISMRuntimeComponent* Pristine = FISMTestHelpers::CreateTestComponent(World, 20, 100.0f);
+    Pristine->SetCustomDataCount(2, true, 0.0f);
+    Pristine->VisibilityCustomDataSlot = 1;
+    TArray<uint8> Untouched;
+    Pristine->SaveRuntimeState(Untouched);
+    TestTrue("Load succeeds", Component->LoadRuntimeState(Untouched));
+
+    // ASSERT
+    Component->ManagedISMComponent->GetInstanceTransform(5, Transform, true);
+    TestEqual("Restored instance shown in the slot", Component->GetInstanceCustomDataValue(5, 1), 0.0f);
+    TestEqual("Restored instance scaled back", Transform.GetScale3D(), FVector::OneVector);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeComponentHeadlessTest,
+    "ISMRuntime.Core.Component.Headless",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeComponentHeadlessTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Forced headless, as on a dedicated server
+    UISMRuntimeSettings* Settings = GetMutableDefault<UISMRuntimeSettings>();
+    const EISMHeadlessMode SavedMode = Settings->HeadlessMode;
+    Settings->HeadlessMode = EISMHeadlessMode::Always;
+
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeComponent* Component = FISMTestHelpers::CreateTestComponent(World, 20, 100.0f);
+    Component->SetCustomDataCount(2, true, 0.0f);
+    Component->VisibilityCustomDataSlot = 1;
+    TestTrue("Component headless", Component->IsHeadless());
+
+    // ACT
+    Component->DestroyInstance(3);
+    Component->UpdateInstanceTransform(4, FTransform(FVector(5000.0f, 0.0f, 0.0f)), true, true);
+    Component->SetInstanceCustomDataValue(6, 0, 0.5f);
+
+    // ASSERT - Authoritative state is kept in full
+    TestTrue("Destroyed flag set", Component->IsInstanceDestroyed(3));
+    TestTrue("Destroyed tag set", Component->InstanceHasTag(3, FGameplayTag::RequestGameplayTag("ISM.State.Destroyed")));
+    TestEqual("Active count", Component->GetActiveInstanceCount(), 19);
+    TestEqual("Transform stored", Component->GetInstanceLocation(4), FVector(5000.0f, 0.0f, 0.0f));
+    TestTrue("Spatial index follows the move", Component->GetInstancesInRadius(FVector(5000.0f, 0.0f, 0.0f), 10.0f).Contains(4));
+    TestTrue("Bounds follow the move", Component->GetInstanceBounds().IsInsideOrOn(FVector(5000.0f, 0.0f, 0.0f)));
+    TestEqual("Custom data readable", Component->GetInstanceCustomDataValue(6, 0), 0.5f);
+
+    if (UISMFeedbackSubsystem* Feedback = World->GetSubsystem<UISMFeedbackSubsystem>())
+    {
+        TestTrue("Feedback headless", Feedback->IsHeadless());
+    }
+
+    // Cleanup
+    World->DestroyWorld(false);
+    Settings->HeadlessMode = SavedMode;
+
+    return true;
+}
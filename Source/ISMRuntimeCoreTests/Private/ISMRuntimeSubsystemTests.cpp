@@ -1,11 +1,19 @@
 // ISMRuntimeSubsystemTests.cpp
 #include "ISMRuntimeSubsystem.h"
 #include "ISMRuntimeComponent.h"
+#include "Settings/ISMRuntimeSettings.h"
+#include "ISMTestHelpers.h"
+#include "ISMQueryFilter.h"
+#include "ISMInstanceTagBits.h"
+#include "GameplayTagsManager.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Misc/AutomationTest.h"
 #include "Engine/World.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "GameFramework/Actor.h"
+#include "Components/BoxComponent.h"
+#include "Async/ParallelFor.h"
+#include "Batching/ISMBatchScheduler.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FISMRuntimeSubsystemBasicTest,
@@ -133,4 +141,1198 @@ bool FISMRuntimeSubsystemQueryTest::RunTest(const FString& Parameters)
     World->DestroyWorld(false);
     
     return true;
-}
\ No newline at end of file
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemBroadphaseTest,
+    "ISMRuntime.Core.Subsystem.ComponentBroadphase",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemBroadphaseTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Two components a few broadphase cells apart
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    auto MakeComponent = [World](const FVector& Origin)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < 3; i++)
+        {
+            ISM->AddInstance(FTransform(Origin + FVector(i * 100.0f, 0, 0)));
+        }
+
+        UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+        Comp->ManagedISMComponent = ISM;
+        Comp->RegisterComponent();
+        Comp->InitializeInstances();
+        return Comp;
+    };
+
+    UISMRuntimeComponent* NearComp = MakeComponent(FVector::ZeroVector);
+    UISMRuntimeComponent* FarComp = MakeComponent(FVector(100000.0f, 0, 0));
+
+    // ACT / ASSERT - Queries only reach the overlapping component
+    FISMQueryFilter Filter;
+    TArray<FISMInstanceReference> Results = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 500.0f, Filter);
+    TestEqual("Near query should find the near instances", Results.Num(), 3);
+
+    Results = Subsystem->QueryInstancesInBox(FBox(FVector(99000.0f, -500.0f, -500.0f), FVector(101000.0f, 500.0f, 500.0f)), Filter);
+    TestEqual("Far box should find the far instances", Results.Num(), 3);
+    TestTrue("Far box results belong to the far component", Results.Num() > 0 && Results[0].Component == FarComp);
+
+    FISMInstanceReference Nearest = Subsystem->FindNearestInstance(FVector(90000.0f, 0, 0), Filter);
+    TestTrue("Nearest should come from the far component", Nearest.Component == FarComp);
+
+    // ACT - Grow the near component into a new region, without the cached-bounds update
+    const int32 AddedIndex = NearComp->AddInstance(FTransform(FVector(0, 50000.0f, 0)), false);
+    Results = Subsystem->QueryInstancesInRadius(FVector(0, 50000.0f, 0), 200.0f, Filter);
+
+    // ASSERT
+    TestEqual("Added instance should be found in its new region", Results.Num(), 1);
+    TestTrue("Found instance is the added one", Results.Num() == 1 && Results[0].InstanceIndex == AddedIndex);
+
+    // ACT - Move it out again
+    NearComp->UpdateInstanceTransform(AddedIndex, FTransform(FVector(0, -50000.0f, 0)));
+    Results = Subsystem->QueryInstancesInRadius(FVector(0, -50000.0f, 0), 200.0f, Filter);
+
+    // ASSERT
+    TestEqual("Moved instance should be found at its new location", Results.Num(), 1);
+    TestEqual("Old location should be empty", Subsystem->QueryInstancesInRadius(FVector(0, 50000.0f, 0), 200.0f, Filter).Num(), 0);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemTagIndexTest,
+    "ISMRuntime.Core.Subsystem.ComponentTagIndex",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemTagIndexTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Tree, rock and tree+rock components sharing one spot
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    const FGameplayTag TreeTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation.Tree");
+    const FGameplayTag VegetationTag = FGameplayTag::RequestGameplayTag("ISM.Type.Vegetation");
+    const FGameplayTag RockTag = FGameplayTag::RequestGameplayTag("ISM.Type.Rock");
+
+    auto MakeComponent = [World](const FGameplayTagContainer& Tags)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+        ISM->RegisterComponent();
+        ISM->AddInstance(FTransform(FVector::ZeroVector));
+
+        UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+        Comp->ManagedISMComponent = ISM;
+        Comp->ISMComponentTags = Tags;
+        Comp->RegisterComponent();
+        Comp->InitializeInstances();
+        return Comp;
+    };
+
+    FGameplayTagContainer BothTags(TreeTag);
+    BothTags.AddTag(RockTag);
+
+    UISMRuntimeComponent* TreeComp = MakeComponent(FGameplayTagContainer(TreeTag));
+    UISMRuntimeComponent* RockComp = MakeComponent(FGameplayTagContainer(RockTag));
+    UISMRuntimeComponent* BothComp = MakeComponent(BothTags);
+
+    // ACT / ASSERT - Tag lookups are hierarchical, like FGameplayTagContainer::HasTag
+    TArray<UISMRuntimeComponent*> Trees = Subsystem->GetComponentsWithTag(TreeTag);
+    TestEqual("Two components carry the tree tag", Trees.Num(), 2);
+    TestTrue("Tree lookup holds the tree component", Trees.Contains(TreeComp));
+    TestTrue("Tree lookup holds the tree+rock component", Trees.Contains(BothComp));
+    TestEqual("Parent tag matches child-tagged components", Subsystem->GetComponentsWithTag(VegetationTag).Num(), 2);
+
+    // ACT / ASSERT - Required and excluded tags select candidates
+    FISMQueryFilter Filter;
+    Filter.RequiredTags.AddTag(VegetationTag);
+    Filter.ExcludedTags.AddTag(RockTag);
+    TArray<FISMInstanceReference> Results = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 100.0f, Filter);
+    TestEqual("Only the pure tree component passes", Results.Num(), 1);
+    TestTrue("Result belongs to the tree component", Results.Num() == 1 && Results[0].Component == TreeComp);
+
+    FISMQueryFilter RockFilter;
+    RockFilter.RequiredTags.AddTag(RockTag);
+    RockFilter.RequiredTags.AddTag(TreeTag);
+    Results = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 100.0f, RockFilter);
+    TestEqual("Both required tags intersect to one component", Results.Num(), 1);
+    TestTrue("Result belongs to the tree+rock component", Results.Num() == 1 && Results[0].Component == BothComp);
+
+    // ACT - Unregister drops the component from the posting lists
+    Subsystem->UnregisterRuntimeComponent(TreeComp);
+
+    // ASSERT
+    TestEqual("Unregistered component no longer listed", Subsystem->GetComponentsWithTag(TreeTag).Num(), 1);
+    TestEqual("Rock lookup unaffected", Subsystem->GetComponentsWithTag(RockTag).Num(), 2);
+    TestTrue("Other component remains", Subsystem->GetComponentsWithTag(RockTag).Contains(RockComp));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemTagIndexOverflowTest,
+    "ISMRuntime.Core.Subsystem.ComponentTagIndexOverflow",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemTagIndexOverflowTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Every registered tag on one component, more than the tag dictionary holds
+    FGameplayTagContainer AllTags;
+    UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+    if (AllTags.Num() <= FISMTagMask::MaxBits)
+    {
+        AddInfo(FString::Printf(TEXT("Only %d gameplay tags registered; the dictionary cannot overflow"), AllTags.Num()));
+        return true;
+    }
+
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    auto MakeComponent = [World](const FGameplayTagContainer& Tags)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+        ISM->RegisterComponent();
+        ISM->AddInstance(FTransform(FVector::ZeroVector));
+
+        UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+        Comp->ManagedISMComponent = ISM;
+        Comp->ISMComponentTags = Tags;
+        Comp->RegisterComponent();
+        Comp->InitializeInstances();
+        return Comp;
+    };
+
+    // The first tags take dictionary bits before the overflow is found
+    const FGameplayTag FirstTag = AllTags.GetByIndex(0);
+    UISMRuntimeComponent* Overflowing = MakeComponent(AllTags);
+    UISMRuntimeComponent* Tagged = MakeComponent(FGameplayTagContainer(FirstTag));
+
+    // ACT - Filter on a tag whose bit was added by the overflowing component
+    FISMQueryFilter Filter;
+    Filter.RequiredTags.AddTag(FirstTag);
+    TArray<FISMInstanceReference> Results = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 100.0f, Filter);
+
+    // ASSERT - Both components still pass, the overflowing one through its own tags
+    TestEqual("Both components pass", Results.Num(), 2);
+    TestTrue("Overflowing component found", Results.ContainsByPredicate([Overflowing](const FISMInstanceReference& Ref) { return Ref.Component == Overflowing; }));
+    TestTrue("Indexed component found", Results.ContainsByPredicate([Tagged](const FISMInstanceReference& Ref) { return Ref.Component == Tagged; }));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemParallelQueryTest,
+    "ISMRuntime.Core.Subsystem.ParallelQuery",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemParallelQueryTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Enough overlapping components for the query to fan out
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    constexpr int32 NumComponents = 40;
+    constexpr int32 InstancesPerComponent = 10;
+    for (int32 c = 0; c < NumComponents; c++)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < InstancesPerComponent; i++)
+        {
+            ISM->AddInstance(FTransform(FVector(i * 50.0f, c * 50.0f, 0)));
+        }
+
+        UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+        Comp->ManagedISMComponent = ISM;
+        Comp->RegisterComponent();
+        Comp->InitializeInstances();
+    }
+
+    FISMQueryFilter SerialFilter;
+    FISMQueryFilter ParallelFilter;
+    ParallelFilter.bAllowParallel = true;
+
+    // ACT
+    const TArray<FISMInstanceReference> Serial = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 100000.0f, SerialFilter);
+    const TArray<FISMInstanceReference> Parallel = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 100000.0f, ParallelFilter);
+
+    // ASSERT - Same results in the same order
+    TestEqual("Serial query finds every instance", Serial.Num(), NumComponents * InstancesPerComponent);
+    TestEqual("Parallel query finds every instance", Parallel.Num(), Serial.Num());
+
+    bool bSameOrder = Parallel.Num() == Serial.Num();
+    for (int32 i = 0; bSameOrder && i < Serial.Num(); i++)
+    {
+        bSameOrder = Serial[i].Component == Parallel[i].Component && Serial[i].InstanceIndex == Parallel[i].InstanceIndex;
+    }
+    TestTrue("Parallel results merge in serial order", bSameOrder);
+
+    // ACT / ASSERT - MaxResults still caps the merged results
+    ParallelFilter.MaxResults = 25;
+    TestEqual("MaxResults caps parallel results", Subsystem->QueryInstancesInBox(FBox(FVector(-100000.0f), FVector(100000.0f)), ParallelFilter).Num(), 25);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemQueryBatchTest,
+    "ISMRuntime.Core.Subsystem.QueryBatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemQueryBatchTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A few components on a line, queried by overlapping spheres
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    for (int32 c = 0; c < 4; c++)
+    {
+        AActor* Actor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < 20; i++)
+        {
+            ISM->AddInstance(FTransform(FVector(i * 100.0f, c * 300.0f, 0)));
+        }
+
+        UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+        Comp->ManagedISMComponent = ISM;
+        Comp->RegisterComponent();
+        Comp->InitializeInstances();
+    }
+
+    TArray<FISMQueryDescriptor> Queries;
+    for (int32 q = 0; q < 6; q++)
+    {
+        FISMQueryDescriptor& Query = Queries.AddDefaulted_GetRef();
+        Query.Center = FVector(q * 300.0f, q * 150.0f, 0);
+        Query.Radius = 250.0f + q * 50.0f;
+    }
+    Queries[2].Filter.MaxResults = 3;
+    Queries[3].Filter.bSortByDistance = true;
+
+    // ACT
+    const FISMQueryBatchResults Batch = Subsystem->SubmitQueryBatch(Queries, false);
+
+    // ASSERT - Each query matches its individual form as a set
+    TestEqual("One result range per query", Batch.Num(), Queries.Num());
+    for (int32 q = 0; q < Queries.Num(); q++)
+    {
+        const TArray<FISMInstanceReference> Single = Subsystem->QueryInstancesInRadius(Queries[q].Center, Queries[q].Radius, Queries[q].Filter);
+        const TConstArrayView<FISMInstanceHandle> Batched = Batch.GetQueryResults(q);
+        TestEqual(FString::Printf(TEXT("Query %d result count"), q), Batched.Num(), Single.Num());
+
+        if (Queries[q].Filter.MaxResults > 0)
+        {
+            continue;
+        }
+
+        bool bAllFound = true;
+        for (const FISMInstanceHandle& Ref : Batched)
+        {
+            bAllFound &= Single.ContainsByPredicate([&Ref](const FISMInstanceReference& Other)
+            {
+                return Other.Component == Ref.Component && Other.InstanceIndex == Ref.InstanceIndex;
+            });
+        }
+        TestTrue(FString::Printf(TEXT("Query %d results match"), q), bAllFound);
+    }
+
+    const TConstArrayView<FISMInstanceHandle> Sorted = Batch.GetQueryResults(3);
+    bool bSorted = true;
+    for (int32 i = 1; i < Sorted.Num(); i++)
+    {
+        bSorted &= FVector::DistSquared(Sorted[i - 1].GetLocation(), Queries[3].Center) <= FVector::DistSquared(Sorted[i].GetLocation(), Queries[3].Center);
+    }
+    TestTrue("bSortByDistance sorts within the query's range", bSorted);
+
+    // ACT / ASSERT - Deferred batches run on the next tick
+    int32 DeferredResults = INDEX_NONE;
+    Subsystem->SubmitQueryBatchDeferred(Queries, [&DeferredResults](const FISMQueryBatchResults& Results)
+    {
+        DeferredResults = Results.Results.Num();
+    });
+    TestEqual("Deferred batch waits for the tick", DeferredResults, INDEX_NONE);
+    TestTrue("Pending batch keeps the subsystem ticking", Subsystem->IsTickable());
+
+    Subsystem->Tick(0.016f);
+    TestEqual("Deferred batch delivers the same table", DeferredResults, Batch.Results.Num());
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemSortedMaxResultsTest,
+    "ISMRuntime.Core.Subsystem.SortedMaxResults",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemSortedMaxResultsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Farthest instances added first, so arrival order is the reverse of distance order
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    AActor* Actor = World->SpawnActor<AActor>();
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+    ISM->RegisterComponent();
+    for (int32 i = 19; i >= 0; i--)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+    Comp->ManagedISMComponent = ISM;
+    Comp->RegisterComponent();
+    Comp->InitializeInstances();
+
+    FISMQueryFilter Filter;
+    Filter.bSortByDistance = true;
+    Filter.MaxResults = 3;
+
+    // ACT
+    const TArray<FISMInstanceReference> Results = Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 5000.0f, Filter);
+    const TArray<int32> Indices = Comp->QueryInstances(FVector::ZeroVector, 5000.0f, Filter);
+
+    // ASSERT - The three nearest, nearest first
+    TestEqual("Subsystem query keeps MaxResults", Results.Num(), 3);
+    TestEqual("Component query keeps MaxResults", Indices.Num(), 3);
+    for (int32 i = 0; i < Results.Num(); i++)
+    {
+        TestTrue(FString::Printf(TEXT("Subsystem result %d is the %d-th nearest"), i, i), Results[i].GetLocation().Equals(FVector(i * 100.0f, 0, 0)));
+    }
+    for (int32 i = 0; i < Indices.Num(); i++)
+    {
+        TestTrue(FString::Printf(TEXT("Component result %d is the %d-th nearest"), i, i), Comp->GetInstanceLocation(Indices[i]).Equals(FVector(i * 100.0f, 0, 0)));
+    }
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemRedirectTest,
+    "ISMRuntime.Core.Subsystem.Redirect",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemRedirectTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A collision box proxying for an ISM with collision disabled
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    AActor* Actor = World->SpawnActor<AActor>();
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->RegisterComponent();
+    ISM->AddInstance(FTransform(FVector(0, 0, 0)));
+    ISM->AddInstance(FTransform(FVector(2000, 0, 0)));
+
+    UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+    Comp->ManagedISMComponent = ISM;
+    Comp->RegisterComponent();
+    Comp->InitializeInstances();
+
+    AActor* ProxyActor = World->SpawnActor<AActor>();
+    UBoxComponent* Proxy = NewObject<UBoxComponent>(ProxyActor);
+    Proxy->SetBoxExtent(FVector(50.0f));
+    Proxy->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    Proxy->SetCollisionResponseToAllChannels(ECR_Block);
+    Proxy->RegisterComponent();
+    Proxy->SetWorldLocation(FVector::ZeroVector);
+
+    const FVector Start(-500, 0, 0);
+    const FVector End(500, 0, 0);
+    FISMQueryFilter Filter;
+    FISMTraceResult Result;
+
+    // ACT / ASSERT - Unregistered proxy does not resolve
+    TestFalse("Unregistered proxy does not resolve", Subsystem->LineTraceISM(Start, End, ECC_Visibility, Result, Filter, 200.0f));
+
+    // ACT / ASSERT - Registered proxy resolves to the nearby instance
+    Subsystem->RegisterComponentRedirect(Proxy, Comp);
+    Subsystem->RegisterComponentRedirect(Proxy, Comp);
+    const bool bResolved = Subsystem->LineTraceISM(Start, End, ECC_Visibility, Result, Filter, 200.0f);
+    TestTrue("Redirect resolves", bResolved);
+    if (bResolved)
+    {
+        TestEqual("Resolved through the redirect", Result.ResolveMethod, EISMTraceResolveMethod::Redirect);
+        TestEqual("Nearest instance to the impact", Result.Handle.InstanceIndex, 0);
+    }
+
+    // ACT / ASSERT - Unregistering the only target removes the redirect
+    Subsystem->UnregisterComponentRedirect(Proxy, Comp);
+    TestFalse("Unregistered target no longer resolves", Subsystem->LineTraceISM(Start, End, ECC_Visibility, Result, Filter, 200.0f));
+
+    // ACT / ASSERT - A destroyed target is skipped, then dropped lazily
+    UISMRuntimeComponent* Doomed = NewObject<UISMRuntimeComponent>(Actor);
+    Subsystem->RegisterComponentRedirect(Proxy, Doomed);
+    Subsystem->RegisterComponentRedirect(Proxy, Comp);
+    Doomed->MarkAsGarbage();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    TestTrue("Live target still resolves past a destroyed one", Subsystem->LineTraceISM(Start, End, ECC_Visibility, Result, Filter, 200.0f));
+    Subsystem->Tick(0.0f);
+    TestTrue("Cleanup keeps the live target", Subsystem->LineTraceISM(Start, End, ECC_Visibility, Result, Filter, 200.0f));
+
+    // ACT / ASSERT - A collected runtime component's ISM entry is pruned, so the ISM can register again
+    UInstancedStaticMeshComponent* ReusedISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+    ReusedISM->RegisterComponent();
+    ReusedISM->AddInstance(FTransform(FVector(0, 5000, 0)));
+    UISMRuntimeComponent* FirstOwner = NewObject<UISMRuntimeComponent>(Actor);
+    FirstOwner->ManagedISMComponent = ReusedISM;
+    FirstOwner->RegisterComponent();
+    FirstOwner->InitializeInstances();
+    TestTrue("ISM maps to its runtime component", Subsystem->FindComponentForISM(ReusedISM) == FirstOwner);
+
+    FirstOwner->DestroyComponent();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    UISMRuntimeComponent* SecondOwner = NewObject<UISMRuntimeComponent>(Actor);
+    SecondOwner->ManagedISMComponent = ReusedISM;
+    SecondOwner->RegisterComponent();
+    SecondOwner->InitializeInstances();
+    TestTrue("ISM maps to its new runtime component", Subsystem->FindComponentForISM(ReusedISM) == SecondOwner);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemSphereSubscriptionTest,
+    "ISMRuntime.Core.Subsystem.SphereSubscription",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemSphereSubscriptionTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A row of instances 100 units apart along X
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    AActor* Actor = World->SpawnActor<AActor>();
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Actor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 20; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* Comp = NewObject<UISMRuntimeComponent>(Actor);
+    Comp->ManagedISMComponent = ISM;
+    Comp->RegisterComponent();
+    Comp->InitializeInstances();
+
+    FISMQueryFilter Filter;
+    FISMSphereSubscriptionDelta Delta;
+    const int32 Id = Subsystem->SubscribeSphere(FVector::ZeroVector, 250.0f, Filter);
+
+    // ACT / ASSERT - First update reports the initial contents
+    TestTrue("Update succeeds", Subsystem->UpdateSphereSubscription(Id, FVector::ZeroVector, 250.0f, Delta));
+    TestEqual("Initial members entered", Delta.Entered.Num(), 3);
+    TestEqual("Nothing exited", Delta.Exited.Num(), 0);
+
+    // ACT / ASSERT - Standing still reports nothing
+    Subsystem->UpdateSphereSubscription(Id, FVector::ZeroVector, 250.0f, Delta);
+    TestTrue("Stationary update is empty", Delta.IsEmpty());
+
+    // ACT / ASSERT - A small move only picks up the leading edge
+    Subsystem->UpdateSphereSubscription(Id, FVector(100, 0, 0), 250.0f, Delta);
+    TestEqual("One entered at the leading edge", Delta.Entered.Num(), 1);
+    TestEqual("Nothing left yet", Delta.Exited.Num(), 0);
+    if (Delta.Entered.Num() == 1)
+    {
+        TestEqual("Entered instance is at x=300", Delta.Entered[0].InstanceIndex, 3);
+    }
+
+    // ACT / ASSERT - A jump swaps most of the set
+    Subsystem->UpdateSphereSubscription(Id, FVector(600, 0, 0), 250.0f, Delta);
+    TestEqual("x=400..800 entered", Delta.Entered.Num(), 5);
+    TestEqual("x=0..300 exited", Delta.Exited.Num(), 4);
+
+    TArray<FISMInstanceHandle> Members;
+    Subsystem->GetSphereSubscriptionInstances(Id, Members);
+    TestEqual("Members match the sphere", Members.Num(), 5);
+
+    // ACT / ASSERT - Destroying a member is noticed without moving
+    Comp->DestroyInstance(6);
+    Subsystem->UpdateSphereSubscription(Id, FVector(600, 0, 0), 250.0f, Delta);
+    TestEqual("Destroyed member exited", Delta.Exited.Num(), 1);
+    TestEqual("Nothing entered", Delta.Entered.Num(), 0);
+    if (Delta.Exited.Num() == 1)
+    {
+        TestEqual("Exited instance is the destroyed one", Delta.Exited[0].InstanceIndex, 6);
+    }
+
+    // ACT / ASSERT - Unsubscribed ids are rejected
+    Subsystem->UnsubscribeSphere(Id);
+    TestFalse("Unknown id fails", Subsystem->UpdateSphereSubscription(Id, FVector::ZeroVector, 250.0f, Delta));
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemGlobalIdTest,
+    "ISMRuntime.Core.Subsystem.GlobalInstanceIds",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemGlobalIdTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Two registered components
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    TArray<UISMRuntimeComponent*> Components;
+    for (int32 c = 0; c < 2; c++)
+    {
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < 4; i++)
+        {
+            ISM->AddInstance(FTransform(FVector(i * 100.0f, c * 1000.0f, 0)));
+        }
+
+        UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+        RuntimeComp->ManagedISMComponent = ISM;
+        RuntimeComp->RegisterComponent();
+        RuntimeComp->InitializeInstances();
+        Components.Add(RuntimeComp);
+    }
+
+    // ACT
+    const FISMInstanceHandle Handle = Components[1]->GetInstanceHandle(3);
+    const FISMGlobalInstanceId Id = Subsystem->GetGlobalInstanceId(Handle);
+    const FISMGlobalInstanceId Other = Subsystem->GetGlobalInstanceId(Components[0]->GetInstanceHandle(3));
+
+    // ASSERT - IDs round-trip and differ across components
+    TestTrue("Registered instance has an ID", Id.IsValid());
+    TestEqual("ID packs the instance index", Id.GetInstanceIndex(), 3);
+    TestTrue("Components get distinct slots", Id != Other);
+    TestTrue("ID resolves to the same instance", Subsystem->ResolveGlobalInstanceId(Id) == Handle);
+    TestEqual("Registry resolves the component", Subsystem->GetInstanceRegistry().ResolveComponent(Id), Components[1]);
+
+    // ACT - Unregister, then take the freed slot with another component
+    Subsystem->UnregisterRuntimeComponent(Components[1]);
+    TestFalse("Unregistered IDs resolve to nothing", Subsystem->ResolveGlobalInstanceId(Id).IsValid());
+
+    Subsystem->RegisterRuntimeComponent(Components[1]);
+    const FISMGlobalInstanceId Reissued = Subsystem->GetGlobalInstanceId(Handle);
+
+    // ASSERT - Same slot, new generation
+    TestEqual("Slot is reused", Reissued.GetSlot(), Id.GetSlot());
+    TestTrue("Reissued ID differs", Reissued != Id);
+    TestNull("Old ID stays dead after reuse", Subsystem->GetInstanceRegistry().ResolveComponent(Id));
+
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemMemoryStatsTest,
+    "ISMRuntime.Core.Subsystem.MemoryStats",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemMemoryStatsTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A small and a large component
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    TArray<UISMRuntimeComponent*> Components;
+    for (int32 NumInstances : { 4, 400 })
+    {
+        AActor* TestActor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+        ISM->RegisterComponent();
+        for (int32 i = 0; i < NumInstances; i++)
+        {
+            ISM->AddInstance(FTransform(FVector(i * 100.0f, Components.Num() * 5000.0f, 0)));
+        }
+
+        UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+        RuntimeComp->ManagedISMComponent = ISM;
+        RuntimeComp->RegisterComponent();
+        RuntimeComp->InitializeInstances();
+        Components.Add(RuntimeComp);
+    }
+
+    // ACT
+    const FISMComponentMemoryStats Small = Components[0]->GetMemoryStats();
+    const FISMComponentMemoryStats Large = Components[1]->GetMemoryStats();
+    const FISMRuntimeStats Stats = Subsystem->GetRuntimeStats();
+
+    // ASSERT - Categories add up and scale with instance count
+    TestEqual("Total is the sum of the categories", Large.TotalBytes,
+        Large.InstanceStateBytes + Large.TagBytes + Large.HandleBytes + Large.SpatialIndexBytes + Large.OtherBytes);
+    TestTrue("Instance state is accounted", Large.InstanceStateBytes > 0);
+    TestTrue("Spatial index is accounted", Large.SpatialIndexBytes > 0);
+    TestTrue("More instances hold more memory", Large.TotalBytes > Small.TotalBytes);
+    TestEqual("GetAllocatedSize matches the breakdown", static_cast<int64>(Components[1]->GetAllocatedSize()), Large.TotalBytes);
+
+    // ASSERT - Roll-up lists every component, largest first, and the subsystem's own structures
+    TestEqual("One memory entry per component", Stats.ComponentMemory.Num(), 2);
+    if (Stats.ComponentMemory.Num() == 2)
+    {
+        TestEqual("Largest component listed first", Stats.ComponentMemory[0].Component, Components[1]);
+    }
+    TestTrue("Subsystem structures reported",
+        Stats.SystemMemory.ContainsByPredicate([](const FISMMemoryStatEntry& Entry) { return Entry.Name == TEXT("RuntimeSubsystem"); }));
+
+    int64 Sum = 0;
+    for (const FISMComponentMemoryStats& Memory : Stats.ComponentMemory)
+    {
+        Sum += Memory.TotalBytes;
+    }
+    for (const FISMMemoryStatEntry& Entry : Stats.SystemMemory)
+    {
+        Sum += Entry.Bytes;
+    }
+    TestEqual("Total is components plus systems", Stats.TotalMemoryBytes, Sum);
+
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemFrameBudgetTest,
+    "ISMRuntime.Core.Subsystem.FrameBudget",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemFrameBudgetTest::RunTest(const FString& Parameters)
+{
+    auto SpinFor = [](double Seconds)
+    {
+        const double Start = FPlatformTime::Seconds();
+        while (FPlatformTime::Seconds() - Start < Seconds)
+        {
+        }
+    };
+
+    const FName Housekeeping(TEXT("Housekeeping"));
+    const FName Urgent(TEXT("Urgent"));
+
+    // ARRANGE - Disabled by default
+    FISMFrameBudgetGovernor Governor;
+    Governor.BeginFrame();
+    {
+        FISMFrameBudgetScope Budget(&Governor, Housekeeping, EISMFrameBudgetPriority::Low);
+        TestFalse("Disabled governor leaves clients unbudgeted", Budget.IsBudgeted());
+        TestEqual("Disabled governor leaves own budgets alone", Budget.ClampBudgetSeconds(0.0), 0.0);
+    }
+
+    FISMFrameBudgetGovernor::FConfig Config;
+    Config.BudgetMs = 2.0f;
+    Config.OverloadFrames = 2;
+    Config.RecoveryFrames = 2;
+    Governor.Configure(Config);
+
+    int32 OverloadSignals = 0;
+    int32 RecoverySignals = 0;
+    Governor.OnOverloadChanged.AddLambda([&](bool bOverloaded) { (bOverloaded ? OverloadSignals : RecoverySignals)++; });
+
+    // ACT - Both clients run over the budget and the low priority one leaves work behind
+    bool bLowRanOut = false;
+    for (int32 Frame = 0; Frame < 4; ++Frame)
+    {
+        Governor.BeginFrame();
+        {
+            FISMFrameBudgetScope Budget(&Governor, Urgent, EISMFrameBudgetPriority::Critical);
+            SpinFor(0.0015);
+            TestFalse("Critical work is never budgeted", Budget.IsBudgeted());
+        }
+        {
+            FISMFrameBudgetScope Budget(&Governor, Housekeeping, EISMFrameBudgetPriority::Low);
+            SpinFor(0.0015);
+            bLowRanOut |= !Budget.HasTime();
+            TestTrue("Clamped budget stays positive", Budget.ClampBudgetSeconds(0.001) > 0.0);
+            Budget.Defer(10);
+        }
+    }
+    Governor.BeginFrame();
+
+    // ASSERT - Overload raised once, low priority squeezed out
+    TestTrue("Low priority client ran out behind critical work", bLowRanOut);
+    TestTrue("Governor reports overload", Governor.IsOverloaded());
+    TestEqual("Overload signalled once", OverloadSignals, 1);
+
+    const FISMFrameBudgetStats Stats = Governor.GetStats();
+    TestEqual("Both clients tracked", Stats.Clients.Num(), 2);
+    if (Stats.Clients.Num() == 2)
+    {
+        TestEqual("Highest priority listed first", Stats.Clients[0].Name, Urgent);
+        TestEqual("Deferred work recorded", Stats.Clients[1].DeferredItems, 10);
+        TestTrue("Deferring grows demand", Stats.Clients[1].DemandMs >= Config.MinSliceMs);
+    }
+
+    // ACT - Idle frames let demand decay
+    for (int32 Frame = 0; Frame < 30 && Governor.IsOverloaded(); ++Frame)
+    {
+        Governor.BeginFrame();
+    }
+
+    // ASSERT
+    TestFalse("Overload clears once demand fits", Governor.IsOverloaded());
+    TestEqual("Recovery signalled once", RecoverySignals, 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemManagedTickTest,
+    "ISMRuntime.Core.Subsystem.ManagedTick",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemManagedTickTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Two components that want every-frame ticks, one of them managed
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    TArray<UISMRuntimeComponent*> Components;
+    for (bool bManaged : { true, false })
+    {
+        AActor* TestActor = World->SpawnActor<AActor>();
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+        ISM->RegisterComponent();
+        ISM->AddInstance(FTransform(FVector(Components.Num() * 1000.0f, 0, 0)));
+
+        UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+        RuntimeComp->ManagedISMComponent = ISM;
+        RuntimeComp->bEnableTickOptimization = false;
+        RuntimeComp->bUseManagedTick = bManaged;
+        RuntimeComp->RegisterComponent();
+        RuntimeComp->InitializeInstances();
+        Components.Add(RuntimeComp);
+    }
+
+    // ASSERT - Only the managed one is in the subsystem's list, without a tick function of its own
+    TestEqual("Managed component ticks through the subsystem", Subsystem->GetNumManagedTicks(), 1);
+    TestFalse("Managed component has no tick function running", Components[0]->IsComponentTickEnabled());
+    TestTrue("Managed component reports its runtime tick", Components[0]->IsRuntimeTickEnabled());
+    TestTrue("Unmanaged component keeps its tick function", Components[1]->IsComponentTickEnabled());
+    TestTrue("Subsystem ticks while components are managed", Subsystem->IsTickable());
+
+    // ACT - A frame of managed ticking, then the component stops asking
+    Subsystem->Tick(0.016f);
+    TestEqual("Ticking keeps the component registered", Subsystem->GetNumManagedTicks(), 1);
+
+    Components[0]->SetRuntimeTickEnabled(false);
+
+    // ASSERT
+    TestEqual("Stopped component leaves the list", Subsystem->GetNumManagedTicks(), 0);
+    TestFalse("Stopped component reports no runtime tick", Components[0]->IsRuntimeTickEnabled());
+
+    // ACT - Unregistering drops a managed tick as well
+    Components[0]->SetRuntimeTickEnabled(true);
+    Subsystem->UnregisterRuntimeComponent(Components[0]);
+    TestEqual("Unregistered component leaves the list", Subsystem->GetNumManagedTicks(), 0);
+
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemTimeSlicedInitTest,
+    "ISMRuntime.Core.Subsystem.TimeSlicedInit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemTimeSlicedInitTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - 2500 instances in a row, built 1000 per step and one step per frame
+    UISMRuntimeSettings* Settings = GetMutableDefault<UISMRuntimeSettings>();
+    const int32 SavedSliceInstances = Settings->ComponentInitSliceInstances;
+    const float SavedBudgetMs = Settings->ComponentInitBudgetMs;
+    Settings->ComponentInitSliceInstances = 1000;
+    Settings->ComponentInitBudgetMs = 0.0f;
+
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+
+    AActor* TestActor = World->SpawnActor<AActor>();
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 2500; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->bTimeSlicedInit = true;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->BeginPlay();
+
+    UISMRuntimeComponent* Requested = nullptr;
+    Subsystem->RequestRuntimeComponent(ISM, [&Requested](UISMRuntimeComponent* Comp) { Requested = Comp; });
+
+    // ASSERT - Queued and registered, nothing built yet
+    TestTrue("Initialization queued", RuntimeComp->IsISMInitializing());
+    TestFalse("Not initialized yet", RuntimeComp->IsISMInitialized());
+    TestEqual("One queued component", Subsystem->GetNumQueuedInitializations(), 1);
+    TestEqual("No instances built", RuntimeComp->GetNumInitializedInstances(), 0);
+    TestNull("Callback waits for completion", Requested);
+
+    // ACT - One frame builds the first range
+    Subsystem->Tick(0.016f);
+
+    // ASSERT - The built range answers queries, the rest does not exist yet
+    TestEqual("First range built", RuntimeComp->GetNumInitializedInstances(), 1000);
+    TestTrue("Last instance of the range", RuntimeComp->IsInstanceInitialized(999));
+    TestFalse("First instance of the next range", RuntimeComp->IsInstanceInitialized(1000));
+    TestEqual("Built range is queryable", RuntimeComp->GetInstancesInRadius(FVector(500.0f, 0, 0), 250.0f).Num(), 5);
+    TestEqual("Unbuilt range is not", RuntimeComp->GetInstancesInRadius(FVector(200000.0f, 0, 0), 250.0f).Num(), 0);
+    TestEqual("World query sees the built range", Subsystem->QueryInstancesInRadius(FVector(500.0f, 0, 0), 250.0f, FISMQueryFilter()).Num(), 5);
+    TestNull("Callback still waiting", Requested);
+
+    // ACT - Two more frames finish it
+    Subsystem->Tick(0.016f);
+    Subsystem->Tick(0.016f);
+
+    // ASSERT
+    TestTrue("Initialized", RuntimeComp->IsISMInitialized());
+    TestFalse("No longer initializing", RuntimeComp->IsISMInitializing());
+    TestEqual("Queue drained", Subsystem->GetNumQueuedInitializations(), 0);
+    TestEqual("Callback fired on completion", Requested, RuntimeComp);
+    TestEqual("Every instance active", RuntimeComp->GetActiveInstanceCount(), 2500);
+    TestEqual("Last range queryable", RuntimeComp->GetInstancesInRadius(FVector(200000.0f, 0, 0), 250.0f).Num(), 5);
+
+    // Cleanup
+    Settings->ComponentInitSliceInstances = SavedSliceInstances;
+    Settings->ComponentInitBudgetMs = SavedBudgetMs;
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemDormancyTest,
+    "ISMRuntime.Core.Subsystem.Dormancy",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemDormancyTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - 10x10 grid over [0, 900], one destroyed and one hidden instance
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    UISMRuntimeComponent* RuntimeComp = FISMTestHelpers::CreateTestComponent(World, 100, 100.0f);
+    RuntimeComp->bAllowDormancy = true;
+    RuntimeComp->DormancyDistance = 10000.0f;
+    RuntimeComp->DestroyInstance(5);
+    RuntimeComp->HideInstance(7);
+
+    const TArray<FVector> FarViewer = { FVector(50000.0f, 0, 0) };
+    const TArray<FVector> NearViewer = { FVector(500.0f, 500.0f, 0) };
+    const TArray<FVector> WakeMarginViewer = { FVector(9900.0f, 0, 0) };
+
+    // ACT - Nobody near: the component goes dormant
+    Subsystem->UpdateComponentDormancy(NearViewer);
+    TestFalse("Stays awake with a viewer inside its bounds", RuntimeComp->IsDormant());
+    Subsystem->UpdateComponentDormancy(FarViewer);
+
+    // ASSERT - State compacted and out of world queries
+    TestTrue("Dormant", RuntimeComp->IsDormant());
+    TestEqual("Counted dormant", Subsystem->GetNumDormantComponents(), 1);
+    TestEqual("No instance state kept dense", RuntimeComp->GetInstanceStateStore().Num(), 0);
+    TestEqual("Spatial index dropped", RuntimeComp->GetSpatialIndex().GetCellCount(), 0);
+    TestEqual("World query skips it", Subsystem->QueryInstancesInRadius(FVector(500.0f, 500.0f, 0), 300.0f, FISMQueryFilter()).Num(), 0);
+    TestEqual("ISM untouched", RuntimeComp->GetInstanceCount(), 100);
+
+    // ACT - Still beyond the wake distance, then back in range
+    Subsystem->UpdateComponentDormancy(WakeMarginViewer);
+    TestTrue("Wake threshold sits inside the dormancy distance", RuntimeComp->IsDormant());
+    Subsystem->UpdateComponentDormancy(NearViewer);
+
+    // ASSERT - Rebuilt with the destroyed and hidden flags kept
+    TestFalse("Awake", RuntimeComp->IsDormant());
+    TestEqual("Active count restored", RuntimeComp->GetActiveInstanceCount(), 98);
+    TestTrue("Destroyed instance still destroyed", RuntimeComp->IsInstanceDestroyed(5));
+    TestTrue("Hidden instance still hidden", RuntimeComp->IsInstanceInState(7, EISMInstanceState::Hidden));
+    TestEqual("World query sees it again", Subsystem->QueryInstancesInRadius(FVector::ZeroVector, 150.0f, FISMQueryFilter()).Num(), 4);
+
+    // ACT - A mutation on a dormant component wakes it first
+    TestTrue("Sleeps again", RuntimeComp->EnterDormancy());
+    RuntimeComp->DestroyInstance(20);
+
+    // ASSERT
+    TestFalse("Woken by the mutation", RuntimeComp->IsDormant());
+    TestTrue("Mutation applied", RuntimeComp->IsInstanceDestroyed(20));
+    TestEqual("Active count after the mutation", RuntimeComp->GetActiveInstanceCount(), 97);
+
+    // Cleanup
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemRegistrationTest,
+    "ISMRuntime.Core.Subsystem.ComponentRegistration",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemRegistrationTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Three registered components
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    TArray<UISMRuntimeComponent*> Components;
+    for (int32 c = 0; c < 3; c++)
+    {
+        UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+        ISM->RegisterComponent();
+        ISM->AddInstance(FTransform(FVector(0, c * 1000.0f, 0)));
+
+        UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+        RuntimeComp->ManagedISMComponent = ISM;
+        RuntimeComp->RegisterComponent();
+        RuntimeComp->InitializeInstances();
+        Components.Add(RuntimeComp);
+    }
+
+    TestEqual("Live view holds every component", Subsystem->GetLiveComponents().Num(), 3);
+
+    // ACT - Registering twice is a no-op
+    Subsystem->RegisterRuntimeComponent(Components[0]);
+    TestEqual("Duplicate registration ignored", Subsystem->GetLiveComponents().Num(), 3);
+
+    // ACT - Unregister the first; the last one moves into its slot
+    Subsystem->UnregisterRuntimeComponent(Components[0]);
+    const TConstArrayView<UISMRuntimeComponent*> Live = Subsystem->GetLiveComponents();
+    TestEqual("View rebuilt after unregister", Live.Num(), 2);
+    TestFalse("Unregistered component left the view", Live.Contains(Components[0]));
+    TestTrue("Others stay registered", Live.Contains(Components[1]) && Live.Contains(Components[2]));
+
+    // ACT - The moved component still unregisters by its new slot
+    Subsystem->UnregisterRuntimeComponent(Components[2]);
+    TestEqual("Moved component unregistered", Subsystem->GetAllComponents().Num(), 1);
+    TestEqual("Remaining component", Subsystem->GetAllComponents()[0], Components[1]);
+
+    // ACT - Registering again takes a new slot
+    Subsystem->RegisterRuntimeComponent(Components[0]);
+    TestEqual("Re-registered", Subsystem->GetLiveComponents().Num(), 2);
+    TestTrue("Re-registered component in view", Subsystem->GetLiveComponents().Contains(Components[0]));
+
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemInstanceCommandTest,
+    "ISMRuntime.Core.Subsystem.InstanceCommands",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemInstanceCommandTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Eight instances with one custom data slot
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    AActor* TestActor = World->SpawnActor<AActor>();
+
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(TestActor);
+    ISM->RegisterComponent();
+    for (int32 i = 0; i < 8; i++)
+    {
+        ISM->AddInstance(FTransform(FVector(i * 100.0f, 0, 0)));
+    }
+
+    UISMRuntimeComponent* RuntimeComp = NewObject<UISMRuntimeComponent>(TestActor);
+    RuntimeComp->ManagedISMComponent = ISM;
+    RuntimeComp->RegisterComponent();
+    RuntimeComp->InitializeInstances();
+    RuntimeComp->SetCustomDataCount(1, true, 0.0f);
+
+    TArray<FISMGlobalInstanceId> Ids;
+    for (int32 i = 0; i < 8; i++)
+    {
+        Ids.Add(Subsystem->GetGlobalInstanceId(RuntimeComp->GetInstanceHandle(i)));
+    }
+
+    // ACT - Workers push one command each: even instances get custom data, odd ones are damaged, 7 is destroyed
+    ParallelFor(8, [Subsystem, &Ids](int32 i)
+    {
+        if (i == 7)
+        {
+            Subsystem->EnqueueInstanceCommand(FISMInstanceCommand::MakeDestroy(Ids[i]));
+        }
+        else if (i % 2 == 0)
+        {
+            Subsystem->EnqueueInstanceCommand(FISMInstanceCommand::MakeCustomData(Ids[i], 0, static_cast<float>(i + 1)));
+        }
+        else
+        {
+            Subsystem->EnqueueInstanceCommand(FISMInstanceCommand::MakeSetState(Ids[i], EISMInstanceState::Damaged, true));
+        }
+    });
+
+    TestFalse("Nothing applied before the drain", RuntimeComp->IsInstanceDestroyed(7));
+
+    const int32 NumApplied = Subsystem->FlushInstanceCommands();
+
+    // ASSERT
+    TestEqual("Every command applied", NumApplied, 8);
+    TestTrue("Destroy applied", RuntimeComp->IsInstanceDestroyed(7));
+    TestEqual("Custom data applied", RuntimeComp->GetInstanceCustomDataValue(4, 0), 5.0f);
+    TestTrue("State applied", RuntimeComp->IsInstanceInState(3, EISMInstanceState::Damaged));
+    TestFalse("Other states untouched", RuntimeComp->IsInstanceInState(2, EISMInstanceState::Damaged));
+
+    // ACT - A command for another generation of the slot is dropped
+    const int32 WrongGeneration = static_cast<int32>(RuntimeComp->GetInstanceGeneration(0)) + 1;
+    Subsystem->EnqueueInstanceCommand(FISMInstanceCommand::MakeCustomData(Ids[0], 0, 99.0f, WrongGeneration));
+    TestEqual("Stale command dropped", Subsystem->FlushInstanceCommands(), 0);
+    TestEqual("Stale command left the instance alone", RuntimeComp->GetInstanceCustomDataValue(0, 0), 1.0f);
+
+    // ACT - Commands for an unregistered component resolve to nothing
+    Subsystem->EnqueueInstanceCommand(FISMInstanceCommand::MakeDestroy(Ids[1]));
+    Subsystem->UnregisterRuntimeComponent(RuntimeComp);
+    TestEqual("Unregistered component's command dropped", Subsystem->FlushInstanceCommands(), 0);
+    TestFalse("Instance survives", RuntimeComp->IsInstanceDestroyed(1));
+
+    World->DestroyWorld(false);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMInstanceCommandQueueOverflowTest,
+    "ISMRuntime.Core.Subsystem.InstanceCommandQueueOverflow",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMInstanceCommandQueueOverflowTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A ring smaller than the pushes
+    FISMInstanceCommandQueue Queue(8);
+    TestEqual("Capacity rounded to a power of two", Queue.GetCapacity(), 8);
+
+    // ACT - Push past the ring from one thread
+    for (int32 i = 0; i < 20; i++)
+    {
+        Queue.Push(FISMInstanceCommand::MakeCustomData(FISMGlobalInstanceId(1, 1, i), 0, 0.0f));
+    }
+
+    TArray<FISMInstanceCommand> Commands;
+    const int32 NumDrained = Queue.Drain(Commands);
+
+    // ASSERT - Nothing lost, push order kept across the spill
+    TestEqual("Every push drained", NumDrained, 20);
+    TestEqual("Pushes past the ring overflowed", Queue.GetNumOverflowed(), static_cast<uint64>(12));
+    bool bInOrder = true;
+    for (int32 i = 0; i < Commands.Num(); i++)
+    {
+        bInOrder &= Commands[i].Id.GetInstanceIndex() == i;
+    }
+    TestTrue("Drained in push order", bInOrder);
+    TestTrue("Empty after drain", Queue.IsEmpty());
+
+    // ACT - Concurrent pushes after the drain go back to the ring
+    ParallelFor(64, [&Queue](int32 i)
+    {
+        Queue.Push(FISMInstanceCommand::MakeDestroy(FISMGlobalInstanceId(1, 1, i)));
+    });
+
+    Commands.Reset();
+    int32 NumAfter = 0;
+    while (!Queue.IsEmpty())
+    {
+        NumAfter += Queue.Drain(Commands);
+    }
+    TestEqual("Concurrent pushes all drained", NumAfter, 64);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMRuntimeSubsystemPerformanceProfileTest,
+    "ISMRuntime.Core.Subsystem.PerformanceProfile",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMRuntimeSubsystemPerformanceProfileTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    UISMBatchSchedulerBase* Scheduler = Subsystem->GetOrCreateBatchSchduler();
+    const EISMPerformanceProfile PreviousProfile = FISMPerformanceProfiles::GetActiveProfile();
+    const FISMBatchSchedulerSettings ClassDefaults = Scheduler->GetClass()->GetDefaultObject<UISMBatchSchedulerBase>()->Settings;
+
+    // ACT - Switch the running world to a profile that overrides the scheduler and frame budget
+    FISMPerformanceProfiles::SetActiveProfile(EISMPerformanceProfile::Handheld);
+    const FISMPerformanceProfileSettings& Handheld = FISMPerformanceProfiles::GetActive();
+
+    // ASSERT - Applied on the spot
+    TestTrue("Active profile", FISMPerformanceProfiles::GetActiveProfile() == EISMPerformanceProfile::Handheld);
+    if (Handheld.bOverride_MaxConcurrentChunks)
+    {
+        TestEqual("Scheduler concurrency from the profile", Scheduler->Settings.MaxConcurrentChunks, Handheld.MaxConcurrentChunks);
+    }
+    if (Handheld.bOverride_FrameBudgetMs)
+    {
+        TestEqual("Frame budget from the profile", Subsystem->GetFrameBudget().GetConfig().BudgetMs, Handheld.FrameBudgetMs);
+    }
+    TestEqual("Limits scale through the profile", FISMPerformanceProfileSettings::ScaleLimit(100, Handheld.PoolSizeScale),
+        FMath::Max(1, FMath::RoundToInt32(100 * Handheld.PoolSizeScale)));
+    TestEqual("Unlimited stays unlimited", FISMPerformanceProfileSettings::ScaleLimit(0, Handheld.PoolSizeScale), 0);
+
+    // ACT - Default restores what the profile overrode
+    FISMPerformanceProfiles::SetActiveProfile(EISMPerformanceProfile::Default);
+
+    // ASSERT
+    if (!FISMPerformanceProfiles::GetActive().bOverride_MaxConcurrentChunks)
+    {
+        TestEqual("Scheduler concurrency back to the class default", Scheduler->Settings.MaxConcurrentChunks, ClassDefaults.MaxConcurrentChunks);
+    }
+
+    FISMPerformanceProfiles::SetActiveProfile(PreviousProfile);
+    World->DestroyWorld(false);
+
+    return true;
+}
@@ -176,6 +176,646 @@ bool FISMSpatialIndexCellBoundaryTest::RunTest(const FString& Parameters)
     
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexFlatStorageTest,
+    "ISMRuntime.Core.SpatialIndex.FlatStorage",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexFlatStorageTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Same data in both layouts
+    TArray<FVector> Locations;
+    for (int32 i = 0; i < 500; i++)
+    {
+        Locations.Add(FVector((i % 25) * 400.0f, (i / 25) * 400.0f, 0.0f));
+    }
+
+    FISMSpatialIndex Hashed(1000.0f, EISMSpatialIndexStorage::Hashed);
+    FISMSpatialIndex Flat(1000.0f, EISMSpatialIndexStorage::Flat);
+    Hashed.Rebuild(Locations);
+    Flat.Rebuild(Locations);
+
+    // ASSERT - Identical contents after rebuild
+    TestEqual("Cell counts should match", Flat.GetCellCount(), Hashed.GetCellCount());
+    TestEqual("Instance counts should match", Flat.GetTotalInstances(), Hashed.GetTotalInstances());
+
+    TArray<int32> HashedResults;
+    TArray<int32> FlatResults;
+    Hashed.QueryRadius(FVector(3000, 3000, 0), 1500.0f, HashedResults);
+    Flat.QueryRadius(FVector(3000, 3000, 0), 1500.0f, FlatResults);
+    HashedResults.Sort();
+    FlatResults.Sort();
+    TestEqual("Radius query results should match", FlatResults, HashedResults);
+
+    // ACT - Incremental patching (overlay adds + tombstoned removes)
+    Flat.RemoveInstance(0, Locations[0]);
+    Flat.AddInstance(1000, FVector(50, 50, 0));
+    Flat.UpdateInstance(1, Locations[1], FVector(9000, 9000, 0));
+
+    TArray<int32> PatchedResults;
+    Flat.QueryRadius(FVector::ZeroVector, 500.0f, PatchedResults);
+    TestFalse("Removed instance should not be returned", PatchedResults.Contains(0));
+    TestTrue("Overlay instance should be returned", PatchedResults.Contains(1000));
+    TestFalse("Moved instance should leave its old cell", PatchedResults.Contains(1));
+    TestEqual("Total should reflect one add and one remove", Flat.GetTotalInstances(), 500);
+
+    // ACT - Compaction keeps the same results
+    Flat.CompactFlatStorage();
+    TArray<int32> CompactedResults;
+    Flat.QueryRadius(FVector::ZeroVector, 500.0f, CompactedResults);
+    PatchedResults.Sort();
+    CompactedResults.Sort();
+    TestEqual("Compaction should not change query results", CompactedResults, PatchedResults);
+
+    // ACT - Switching back to hashed preserves contents
+    Flat.SetStorageMode(EISMSpatialIndexStorage::Hashed);
+    TestEqual("Mode switch should preserve instance count", Flat.GetTotalInstances(), 500);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexExactQueryTest,
+    "ISMRuntime.Core.SpatialIndex.ExactQueries",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexExactQueryTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - All instances share one cell, only some are inside the sphere
+    FISMSpatialIndex SpatialIndex(1000.0f);
+    SpatialIndex.AddInstance(0, FVector(100, 100, 0));
+    SpatialIndex.AddInstance(1, FVector(200, 100, 0));
+    SpatialIndex.AddInstance(2, FVector(900, 900, 0));
+    SpatialIndex.AddInstance(3, FVector(150, 150, 0));
+    SpatialIndex.AddInstance(4, FVector(950, 100, 0)); // 5 entries: exercises SIMD lanes + scalar tail
+
+    // ACT
+    TArray<int32> Coarse;
+    TArray<int32> Exact;
+    SpatialIndex.QueryRadius(FVector(100, 100, 0), 200.0f, Coarse);
+    SpatialIndex.QueryRadiusExact(FVector(100, 100, 0), 200.0f, Exact);
+
+    // ASSERT
+    TestEqual("Coarse query returns the whole cell", Coarse.Num(), 5);
+    TestEqual("Exact query culls by distance", Exact.Num(), 3);
+    TestTrue("Should contain instance 0", Exact.Contains(0));
+    TestTrue("Should contain instance 1", Exact.Contains(1));
+    TestTrue("Should contain instance 3", Exact.Contains(3));
+
+    TArray<int32> BoxResults;
+    SpatialIndex.QueryBoxExact(FBox(FVector(800, 0, -10), FVector(1000, 1000, 10)), BoxResults);
+    TestEqual("Exact box query culls by position", BoxResults.Num(), 2);
+    TestTrue("Box should contain instance 2", BoxResults.Contains(2));
+    TestTrue("Box should contain instance 4", BoxResults.Contains(4));
+
+    // ACT - Move within the same cell, exact query must see the new position
+    SpatialIndex.UpdateInstance(2, FVector(900, 900, 0), FVector(120, 120, 0));
+    SpatialIndex.QueryRadiusExact(FVector(100, 100, 0), 200.0f, Exact);
+    TestTrue("Same-cell move should update stored position", Exact.Contains(2));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexHierarchicalTest,
+    "ISMRuntime.Core.SpatialIndex.Hierarchical",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexHierarchicalTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Small base cells, tuned for 3m queries
+    TArray<FVector> Locations;
+    for (int32 i = 0; i < 2000; i++)
+    {
+        Locations.Add(FVector((i % 50) * 200.0f, (i / 50) * 200.0f, 0.0f));
+    }
+
+    FISMSpatialIndex SingleLevel(300.0f);
+    FISMSpatialIndex MultiLevel(300.0f);
+    MultiLevel.SetHierarchyLevels(3);
+    SingleLevel.Rebuild(Locations);
+    MultiLevel.Rebuild(Locations);
+
+    TestEqual("Should report 3 levels", MultiLevel.GetHierarchyLevelCount(), 3);
+
+    // ACT - Small and large exact queries must agree with the single-level grid
+    const float Radii[] = { 300.0f, 5000.0f };
+    for (float Radius : Radii)
+    {
+        TArray<int32> Expected;
+        TArray<int32> Actual;
+        SingleLevel.QueryRadiusExact(FVector(5000, 4000, 0), Radius, Expected);
+        MultiLevel.QueryRadiusExact(FVector(5000, 4000, 0), Radius, Actual);
+        Expected.Sort();
+        Actual.Sort();
+        TestEqual(FString::Printf(TEXT("Radius %.0f results should match"), Radius), Actual, Expected);
+    }
+
+    // ACT - Incremental changes propagate to coarse levels
+    MultiLevel.RemoveInstance(0, Locations[0]);
+    MultiLevel.UpdateInstance(1, Locations[1], FVector(50000, 50000, 0));
+
+    TArray<int32> Large;
+    MultiLevel.QueryRadiusExact(FVector::ZeroVector, 5000.0f, Large);
+    TestFalse("Removed instance should not appear on coarse level", Large.Contains(0));
+    TestFalse("Moved instance should leave its coarse cell", Large.Contains(1));
+
+    MultiLevel.QueryRadiusExact(FVector(50000, 50000, 0), 5000.0f, Large);
+    TestTrue("Moved instance should be found at its destination", Large.Contains(1));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexBoundsOverlapTest,
+    "ISMRuntime.Core.SpatialIndex.BoundsOverlap",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexBoundsOverlapTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE
+    FISMSpatialIndex Index(1000.0f);
+
+    // 0: small mesh whose AABB crosses into the neighbouring cell
+    Index.AddInstance(0, FVector(950, 500, 0));
+    Index.SetInstanceBounds(0, FBox(FVector(850, 400, -100), FVector(1150, 600, 100)));
+
+    // 1: huge mesh, far bigger than a cell - goes to the oversized list
+    Index.SetInstanceBounds(1, FBox(FVector(-5000, -5000, -100), FVector(5000, 5000, 100)));
+    Index.AddInstance(1, FVector(0, 0, 0));
+
+    // 2: no bounds - tested by position
+    Index.AddInstance(2, FVector(3000, 3000, 0));
+
+    TestEqual("Huge mesh should be oversized", Index.GetOversizedInstanceCount(), 1);
+    TestTrue("Reach should be bounded by cell size", Index.GetMaxBoundsReach() <= Index.GetCellSize());
+
+    // ACT - Box entirely inside the neighbouring cell, touching only instance 0's AABB and the huge mesh
+    TArray<int32> Results;
+    Index.QueryOverlappingBox(FBox(FVector(1100, 450, -10), FVector(1200, 550, 10)), Results);
+
+    // ASSERT
+    TestTrue("Crossing AABB found without padding", Results.Contains(0));
+    TestTrue("Oversized AABB found", Results.Contains(1));
+    TestFalse("Distant point not found", Results.Contains(2));
+
+    // ACT - Sphere around the bounds-less instance
+    Index.QueryOverlappingSphere(FVector(3000, 3000, 0), 10.0f, Results);
+    TestTrue("Bounds-less instance found by position", Results.Contains(2));
+    TestFalse("Instance 0 not in distant sphere", Results.Contains(0));
+
+    // ACT - Bounds follow moves, removal forgets them
+    Index.UpdateInstance(0, FVector(950, 500, 0), FVector(20950, 500, 0));
+    Index.SetInstanceBounds(0, FBox(FVector(20850, 400, -100), FVector(21150, 600, 100)));
+    Index.RemoveInstance(1, FVector(0, 0, 0));
+
+    Index.QueryOverlappingBox(FBox(FVector(21100, 450, -10), FVector(21200, 550, 10)), Results);
+    TestTrue("Moved AABB found at destination", Results.Contains(0));
+    TestEqual("Removed oversized instance dropped", Index.GetOversizedInstanceCount(), 0);
+    TestFalse("Removed instance not returned", Results.Contains(1));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexKNearestTest,
+    "ISMRuntime.Core.SpatialIndex.KNearest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexKNearestTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Pseudo-random scatter across many cells
+    FRandomStream Random(1234);
+    TArray<FVector> Locations;
+    for (int32 i = 0; i < 500; i++)
+    {
+        Locations.Add(FVector(Random.FRandRange(-20000, 20000), Random.FRandRange(-20000, 20000), Random.FRandRange(-500, 500)));
+    }
+
+    FISMSpatialIndex Index(1000.0f);
+    Index.Rebuild(Locations);
+
+    const FVector Query(1234, -567, 0);
+
+    // Brute-force reference ordering
+    TArray<int32> Expected;
+    for (int32 i = 0; i < Locations.Num(); i++)
+    {
+        Expected.Add(i);
+    }
+    Expected.Sort([&](int32 A, int32 B)
+    {
+        return FVector::DistSquared(Locations[A], Query) < FVector::DistSquared(Locations[B], Query);
+    });
+
+    // ACT
+    TArray<FISMSpatialNeighbor> Neighbors;
+    Index.FindKNearest(Query, 8, Neighbors);
+
+    // ASSERT - Same 8, nearest first
+    TestEqual("Should return 8 neighbours", Neighbors.Num(), 8);
+    for (int32 i = 0; i < Neighbors.Num(); i++)
+    {
+        TestEqual(FString::Printf(TEXT("Neighbour %d should match brute force"), i), Neighbors[i].InstanceIndex, Expected[i]);
+    }
+
+    // ACT - Filter skips the nearest, max distance caps results
+    Index.FindKNearest(Query, 1, Neighbors, -1.0f, [&](int32 Idx) { return Idx != Expected[0]; });
+    TestTrue("Filtered query returns the runner-up", Neighbors.Num() == 1 && Neighbors[0].InstanceIndex == Expected[1]);
+
+    const float Limit = FVector::Dist(Locations[Expected[2]], Query) + 1.0f;
+    Index.FindKNearest(Query, 50, Neighbors, Limit);
+    TestEqual("Max distance should cap results", Neighbors.Num(), 3);
+
+    // ACT - Query far outside the occupied area still finds the closest
+    Index.FindKNearest(FVector(200000, 0, 0), 1, Neighbors);
+    TestEqual("Far query should still find a result", Neighbors.Num(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexApplyMovesTest,
+    "ISMRuntime.Core.SpatialIndex.ApplyMoves",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexApplyMovesTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Same data in a per-instance index and a batched index, for both storage modes
+    const EISMSpatialIndexStorage Modes[] = { EISMSpatialIndexStorage::Hashed, EISMSpatialIndexStorage::Flat };
+    for (EISMSpatialIndexStorage Mode : Modes)
+    {
+        TArray<FVector> Locations;
+        for (int32 i = 0; i < 400; i++)
+        {
+            Locations.Add(FVector((i % 20) * 150.0f, (i / 20) * 150.0f, 0.0f));
+        }
+
+        FISMSpatialIndex PerInstance(500.0f, Mode);
+        FISMSpatialIndex Batched(500.0f, Mode);
+        PerInstance.SetHierarchyLevels(2);
+        Batched.SetHierarchyLevels(2);
+        PerInstance.Rebuild(Locations);
+        Batched.Rebuild(Locations);
+
+        // ACT - Shift every other instance; some stay in their cell, most change cell
+        TArray<FISMSpatialIndexMove> Moves;
+        for (int32 i = 0; i < Locations.Num(); i += 2)
+        {
+            FISMSpatialIndexMove& Move = Moves.AddDefaulted_GetRef();
+            Move.InstanceIndex = i;
+            Move.OldLocation = Locations[i];
+            Move.NewLocation = Locations[i] + FVector(i % 3 == 0 ? 10.0f : 700.0f, 0.0f, 0.0f);
+            PerInstance.UpdateInstance(i, Move.OldLocation, Move.NewLocation);
+        }
+        Batched.ApplyMoves(Moves);
+
+        // ASSERT - Identical results for small (base grid) and large (coarse level) queries
+        TestEqual("Instance totals should match", Batched.GetTotalInstances(), PerInstance.GetTotalInstances());
+
+        const float Radii[] = { 400.0f, 3000.0f };
+        for (float Radius : Radii)
+        {
+            TArray<int32> Expected;
+            TArray<int32> Actual;
+            PerInstance.QueryRadiusExact(FVector(1500, 1500, 0), Radius, Expected);
+            Batched.QueryRadiusExact(FVector(1500, 1500, 0), Radius, Actual);
+            Expected.Sort();
+            Actual.Sort();
+            TestEqual(FString::Printf(TEXT("Radius %.0f results should match"), Radius), Actual, Expected);
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexRayQueryTest,
+    "ISMRuntime.Core.SpatialIndex.RayQuery",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexRayQueryTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - A row of 100-unit boxes along X, one off to the side
+    FISMSpatialIndex Index(1000.0f);
+    const float XPositions[] = { 5000.0f, 1500.0f, 3200.0f };
+    for (int32 i = 0; i < 3; i++)
+    {
+        const FVector Pivot(XPositions[i], 0, 0);
+        Index.AddInstance(i, Pivot);
+        Index.SetInstanceBounds(i, FBox(Pivot - FVector(50), Pivot + FVector(50)));
+    }
+    Index.AddInstance(3, FVector(3000, 400, 0));
+    Index.SetInstanceBounds(3, FBox(FVector(2950, 350, -50), FVector(3050, 450, 50)));
+
+    // ACT - Line trace down the row
+    TArray<FISMSpatialRayHit> Hits;
+    Index.QueryRay(FVector(0, 0, 0), FVector(10000, 0, 0), 0.0f, Hits);
+
+    // ASSERT - Ray order, side box missed
+    TestEqual("Should hit the three boxes on the line", Hits.Num(), 3);
+    if (Hits.Num() == 3)
+    {
+        TestEqual("First hit is nearest", Hits[0].InstanceIndex, 1);
+        TestEqual("Second hit", Hits[1].InstanceIndex, 2);
+        TestEqual("Third hit", Hits[2].InstanceIndex, 0);
+        TestTrue("Entry distance at box face", FMath::IsNearlyEqual(Hits[0].Distance, 1450.0f, 1.0f));
+    }
+
+    // ACT - First hit only, and a sweep wide enough to touch the side box
+    Index.QueryRay(FVector(0, 0, 0), FVector(10000, 0, 0), 0.0f, Hits, true);
+    TestTrue("First-hit query returns only the nearest", Hits.Num() == 1 && Hits[0].InstanceIndex == 1);
+
+    Index.QueryRay(FVector(0, 0, 0), FVector(10000, 0, 0), 400.0f, Hits);
+    TestEqual("Sweep should also catch the side box", Hits.Num(), 4);
+
+    // ACT - Segment ending before the far boxes; diagonal ray with filter
+    Index.QueryRay(FVector(0, 0, 0), FVector(2000, 0, 0), 0.0f, Hits);
+    TestEqual("Short segment should only reach the first box", Hits.Num(), 1);
+
+    Index.QueryRay(FVector(0, 0, 0), FVector(10000, 0, 0), 0.0f, Hits, true, [](int32 Idx) { return Idx != 1; });
+    TestTrue("Filtered first hit skips instance 1", Hits.Num() == 1 && Hits[0].InstanceIndex == 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexShrinkTest,
+    "ISMRuntime.Core.SpatialIndex.Shrink",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexShrinkTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - Pack 2000 instances into few cells, then remove most of them
+    FISMSpatialIndex Index(1000.0f);
+    Index.SetAutoShrinkThreshold(0);
+
+    for (int32 i = 0; i < 2000; i++)
+    {
+        Index.AddInstance(i, FVector((i % 4) * 1000.0f + 10.0f, 0, 0));
+    }
+
+    for (int32 i = 10; i < 2000; i++)
+    {
+        Index.RemoveInstance(i, FVector((i % 4) * 1000.0f + 10.0f, 0, 0));
+    }
+
+    const SIZE_T Before = Index.GetAllocatedSize();
+
+    // ACT
+    Index.Shrink();
+
+    // ASSERT - Less memory, same contents
+    TestTrue("Shrink should release memory", Index.GetAllocatedSize() < Before);
+    TestEqual("Remaining instances unchanged", Index.GetTotalInstances(), 10);
+
+    TArray<int32> Results;
+    Index.QueryRadiusExact(FVector(10, 0, 0), 5.0f, Results);
+    TestEqual("Queries still work after shrink", Results.Num(), 3);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexTagPrunedTest,
+    "ISMRuntime.Core.SpatialIndex.TagPrunedQueries",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexTagPrunedTest::RunTest(const FString& Parameters)
+{
+    const EISMSpatialIndexStorage Modes[] = { EISMSpatialIndexStorage::Hashed, EISMSpatialIndexStorage::Flat };
+    for (EISMSpatialIndexStorage Mode : Modes)
+    {
+        // ARRANGE - A 20x20 grid; bit 0 on every third instance, bit 1 on the even ones
+        TArray<FVector> Locations;
+        for (int32 i = 0; i < 400; i++)
+        {
+            Locations.Add(FVector((i % 20) * 150.0f, (i / 20) * 150.0f, 0.0f));
+        }
+
+        FISMSpatialIndex Index(500.0f, Mode);
+        Index.Rebuild(Locations);
+
+        TArray<FISMTagMask> Masks;
+        Masks.SetNum(Locations.Num());
+        for (int32 i = 0; i < Locations.Num(); i++)
+        {
+            if (i % 3 == 0) Masks[i].SetBit(0);
+            if (i % 2 == 0) Masks[i].SetBit(1);
+            Index.SetInstanceTagMask(i, Masks[i]);
+        }
+
+        // ACT - Move some tagged instances across cells, untag others, add a late instance
+        TArray<FISMSpatialIndexMove> Moves;
+        for (int32 i = 0; i < Locations.Num(); i += 9)
+        {
+            FISMSpatialIndexMove& Move = Moves.AddDefaulted_GetRef();
+            Move.InstanceIndex = i;
+            Move.OldLocation = Locations[i];
+            Move.NewLocation = Locations[i] + FVector(700.0f, 0.0f, 0.0f);
+            Locations[i] = Move.NewLocation;
+        }
+        Index.ApplyMoves(Moves);
+
+        for (int32 i = 3; i < Locations.Num(); i += 30)
+        {
+            Masks[i] = FISMTagMask();
+            Index.SetInstanceTagMask(i, Masks[i]);
+        }
+
+        const int32 Late = Locations.Add(FVector(1510.0f, 1490.0f, 0.0f));
+        Masks.AddDefaulted();
+        Masks[Late].SetBit(0);
+        Masks[Late].SetBit(1);
+        Index.SetInstanceTagMask(Late, Masks[Late]);
+        Index.AddInstance(Late, Locations[Late]);
+
+        // ASSERT - Same hits as an unpruned query followed by a mask test, before and after Shrink
+        FISMTagMask Both;
+        Both.SetBit(0);
+        Both.SetBit(1);
+
+        for (int32 Pass = 0; Pass < 2; Pass++)
+        {
+            TArray<int32> Unpruned;
+            Index.QueryRadiusExact(FVector(1500, 1500, 0), 1200.0f, Unpruned);
+            TArray<int32> Expected;
+            for (int32 Idx : Unpruned)
+            {
+                if (Masks[Idx].HasAll(Both))
+                {
+                    Expected.Add(Idx);
+                }
+            }
+
+            TArray<int32> Actual;
+            Index.ForEachInstanceInRadiusWithTags(FVector(1500, 1500, 0), 1200.0f, Both, [&Actual](int32 Idx)
+            {
+                Actual.Add(Idx);
+                return true;
+            });
+
+            Expected.Sort();
+            Actual.Sort();
+            TestTrue("Query should find tagged instances", Expected.Num() > 0);
+            TestEqual(FString::Printf(TEXT("Pass %d pruned results match the unpruned filter"), Pass), Actual, Expected);
+            TestTrue("Late instance is found", Actual.Contains(Late));
+
+            Index.Shrink();
+        }
+
+        TArray<int32> Unfiltered;
+        Index.ForEachInstanceInBoxWithTags(FBox(FVector(-1), FVector(5000, 5000, 1)), FISMTagMask(), [&Unfiltered](int32 Idx)
+        {
+            Unfiltered.Add(Idx);
+            return true;
+        });
+        TestEqual("Empty mask visits every instance", Unfiltered.Num(), Locations.Num());
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexBulkAddTest,
+    "ISMRuntime.Core.SpatialIndex.BulkAdd",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexBulkAddTest::RunTest(const FString& Parameters)
+{
+    const EISMSpatialIndexStorage Modes[] = { EISMSpatialIndexStorage::Hashed, EISMSpatialIndexStorage::Flat };
+    for (EISMSpatialIndexStorage Mode : Modes)
+    {
+        // ARRANGE - 100 existing instances, then 900 more appended in bulk vs one at a time
+        TArray<FVector> Locations;
+        for (int32 i = 0; i < 1000; i++)
+        {
+            Locations.Add(FVector((i % 40) * 130.0f, (i / 40) * 130.0f, (i % 3) * 50.0f));
+        }
+
+        FISMSpatialIndex Bulk(500.0f, Mode);
+        FISMSpatialIndex Single(500.0f, Mode);
+        Bulk.SetHierarchyLevels(2);
+        Single.SetHierarchyLevels(2);
+        for (int32 i = 0; i < 100; i++)
+        {
+            Bulk.AddInstance(i, Locations[i]);
+            Single.AddInstance(i, Locations[i]);
+        }
+
+        // ACT
+        TArray<int32> NewIndices;
+        for (int32 i = 100; i < Locations.Num(); i++)
+        {
+            NewIndices.Add(i);
+            Single.AddInstance(i, Locations[i]);
+        }
+        Bulk.AddInstances(NewIndices, TConstArrayView<FVector>(Locations).Slice(100, NewIndices.Num()));
+
+        // ASSERT
+        TestEqual(TEXT("Bulk add holds every instance"), Bulk.GetTotalInstances(), Single.GetTotalInstances());
+
+        const FBox Boxes[] = {
+            FBox(FVector(-1.0f), FVector(10000.0f)),
+            FBox(FVector(600.0f, 600.0f, -1.0f), FVector(1900.0f, 2400.0f, 60.0f)),
+        };
+        for (const FBox& Box : Boxes)
+        {
+            TArray<int32> BulkHits;
+            TArray<int32> SingleHits;
+            Bulk.QueryBoxExact(Box, BulkHits);
+            Single.QueryBoxExact(Box, SingleHits);
+            BulkHits.Sort();
+            SingleHits.Sort();
+            TestTrue(TEXT("Bulk add answers box queries like per-instance adds"), BulkHits == SingleHits);
+        }
+
+        TArray<int32> BulkRadius;
+        TArray<int32> SingleRadius;
+        Bulk.QueryRadius(FVector(2000.0f, 1500.0f, 0.0f), 800.0f, BulkRadius);
+        Single.QueryRadius(FVector(2000.0f, 1500.0f, 0.0f), 800.0f, SingleRadius);
+        BulkRadius.Sort();
+        SingleRadius.Sort();
+        TestTrue(TEXT("Bulk add answers radius queries like per-instance adds"), BulkRadius == SingleRadius);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexExportImportTest,
+    "ISMRuntime.Core.SpatialIndex.ExportImportCells",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexExportImportTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - hashed source exported once, imported into both storage modes
+    TArray<FVector> Locations;
+    for (int32 i = 0; i < 500; i++)
+    {
+        Locations.Add(FVector((i % 25) * 170.0f, (i / 25) * 170.0f, (i % 4) * 40.0f));
+    }
+
+    FISMSpatialIndex Source(500.0f);
+    for (int32 i = 0; i < Locations.Num(); i++)
+    {
+        Source.AddInstance(i, Locations[i]);
+    }
+
+    TArray<FIntVector> CellKeys;
+    TArray<int32> CellOffsets;
+    TArray<int32> CellInstances;
+    Source.ExportCells(CellKeys, CellOffsets, CellInstances);
+
+    TestEqual(TEXT("Export lists every instance once"), CellInstances.Num(), Locations.Num());
+    TestEqual(TEXT("Export has one offset per cell plus the end"), CellOffsets.Num(), CellKeys.Num() + 1);
+
+    const EISMSpatialIndexStorage Modes[] = { EISMSpatialIndexStorage::Hashed, EISMSpatialIndexStorage::Flat };
+    for (EISMSpatialIndexStorage Mode : Modes)
+    {
+        // ACT
+        FISMSpatialIndex Imported(500.0f, Mode);
+        const bool bImported = Imported.ImportCells(CellKeys, CellOffsets, CellInstances, Locations);
+
+        // ASSERT
+        TestTrue(TEXT("Exported cells import"), bImported);
+        TestEqual(TEXT("Import holds every instance"), Imported.GetTotalInstances(), Source.GetTotalInstances());
+
+        TArray<int32> SourceHits;
+        TArray<int32> ImportedHits;
+        const FBox Box(FVector(300.0f, 300.0f, -1.0f), FVector(2100.0f, 1400.0f, 100.0f));
+        Source.QueryBoxExact(Box, SourceHits);
+        Imported.QueryBoxExact(Box, ImportedHits);
+        SourceHits.Sort();
+        ImportedHits.Sort();
+        TestTrue(TEXT("Import answers box queries like the source"), SourceHits == ImportedHits);
+
+        // Imported index stays mutable
+        Imported.RemoveInstance(0, Locations[0]);
+        TestEqual(TEXT("Import supports removal"), Imported.GetTotalInstances(), Locations.Num() - 1);
+    }
+
+    // Malformed cells are rejected
+    FISMSpatialIndex Rejecting(500.0f);
+    TArray<int32> BadInstances = CellInstances;
+    BadInstances[0] = Locations.Num() + 10;
+    TestFalse(TEXT("Out-of-range instance is rejected"), Rejecting.ImportCells(CellKeys, CellOffsets, BadInstances, Locations));
+
+    return true;
+}
+
 ///------------------------------------------------------
 // ISMSpatialIndexTests.cpp (complex tests)
 
@@ -230,3 +870,60 @@ bool FISMSpatialIndexPerformanceTest::RunTest(const FString& Parameters)
     
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FISMSpatialIndexTelemetryTest,
+    "ISMRuntime.Core.SpatialIndex.QueryTelemetry",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProgramContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FISMSpatialIndexTelemetryTest::RunTest(const FString& Parameters)
+{
+    // ARRANGE - three instances share cell (0,0,0), one sits alone further out
+    FISMSpatialIndex SpatialIndex(1000.0f);
+    SpatialIndex.AddInstance(0, FVector(0, 0, 0));
+    SpatialIndex.AddInstance(1, FVector(100, 0, 0));
+    SpatialIndex.AddInstance(2, FVector(900, 0, 0));
+    SpatialIndex.AddInstance(3, FVector(5000, 0, 0));
+
+    TArray<int32> Results;
+    SpatialIndex.QueryRadiusExact(FVector::ZeroVector, 200.0f, Results);
+    TestNull("Telemetry should be off by default", SpatialIndex.GetQueryTelemetry());
+
+    // ACT
+    SpatialIndex.SetQueryTelemetryEnabled(true);
+    SpatialIndex.QueryRadiusExact(FVector::ZeroVector, 200.0f, Results);
+
+    // Copies (snapshots) count into the same block
+    const FISMSpatialIndex Copy = SpatialIndex;
+    Copy.ForEachInstanceInRadius(FVector::ZeroVector, 200.0f, [](int32) { return true; });
+
+    // ASSERT
+    const FISMSpatialQueryTelemetry* Telemetry = SpatialIndex.GetQueryTelemetry();
+    if (!TestNotNull("Telemetry should be on", Telemetry))
+    {
+        return false;
+    }
+    TestEqual("Both queries should be counted", Telemetry->NumQueries.load(), static_cast<uint64>(2));
+    TestEqual("Each query walks the three instances of the origin cell", Telemetry->NumCandidates.load(), static_cast<uint64>(6));
+    TestEqual("Each query hits two of them", Telemetry->NumHits.load(), static_cast<uint64>(4));
+
+    const float Recommended = SpatialIndex.GetRecommendedCellSize();
+    TestTrue(FString::Printf(TEXT("Recommended cell size %.0f should be about twice the 200 query radius"), Recommended),
+        Recommended >= 256.0f && Recommended <= 512.0f);
+
+    TArray<int32> Histogram;
+    SpatialIndex.GetCellOccupancyHistogram(Histogram, 4);
+    TestEqual("Histogram should have the requested buckets", Histogram.Num(), 4);
+    TestEqual("One cell holds a single instance", Histogram[0], 1);
+    TestEqual("One cell holds 2-3 instances", Histogram[1], 1);
+
+    SpatialIndex.ResetQueryTelemetry();
+    TestEqual("Reset should zero the counters", Telemetry->NumQueries.load(), static_cast<uint64>(0));
+    TestEqual("Reset should clear the recommendation", SpatialIndex.GetRecommendedCellSize(), 0.0f);
+
+    SpatialIndex.SetQueryTelemetryEnabled(false);
+    TestNull("Telemetry should be off again", SpatialIndex.GetQueryTelemetry());
+
+    return true;
+}
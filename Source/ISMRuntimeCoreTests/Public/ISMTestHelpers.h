@@ -109,6 +109,54 @@ public:
         
         return Locations;
     }
+
+    /**
+     * Generate reproducible locations in a volume, optionally clustered.
+     * With NumClusters > 0 every location falls within ClusterRadius (XY) of one of NumClusters
+     * centers spread uniformly over Bounds, denser towards the center; Z stays uniform.
+     */
+    static TArray<FVector> GenerateClusteredLocations(
+        int32 Count,
+        const FBox& Bounds,
+        int32 NumClusters,
+        float ClusterRadius,
+        int32 Seed)
+    {
+        FRandomStream Stream(Seed);
+
+        TArray<FVector2D> Centers;
+        Centers.Reserve(NumClusters);
+        for (int32 i = 0; i < NumClusters; i++)
+        {
+            Centers.Add(FVector2D(
+                Stream.FRandRange(Bounds.Min.X, Bounds.Max.X),
+                Stream.FRandRange(Bounds.Min.Y, Bounds.Max.Y)));
+        }
+
+        TArray<FVector> Locations;
+        Locations.Reserve(Count);
+
+        for (int32 i = 0; i < Count; i++)
+        {
+            FVector Location(
+                Stream.FRandRange(Bounds.Min.X, Bounds.Max.X),
+                Stream.FRandRange(Bounds.Min.Y, Bounds.Max.Y),
+                Stream.FRandRange(Bounds.Min.Z, Bounds.Max.Z)
+            );
+
+            if (Centers.Num() > 0)
+            {
+                const FVector2D& Center = Centers[Stream.RandHelper(Centers.Num())];
+                const float Angle = Stream.FRandRange(0.0f, 2.0f * PI);
+                const float Distance = ClusterRadius * Stream.FRand() * Stream.FRand();
+                Location.X = FMath::Clamp(Center.X + Distance * FMath::Cos(Angle), Bounds.Min.X, Bounds.Max.X);
+                Location.Y = FMath::Clamp(Center.Y + Distance * FMath::Sin(Angle), Bounds.Min.Y, Bounds.Max.Y);
+            }
+            Locations.Add(Location);
+        }
+
+        return Locations;
+    }
 };
 
 /** Scoped test world that auto-cleans up */
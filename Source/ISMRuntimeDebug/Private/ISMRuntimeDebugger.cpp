@@ -9,6 +9,7 @@
 #include "SceneView.h"
 #include "SceneManagement.h"
 #include "DrawDebugHelpers.h"
+#include "Components/LineBatchComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
@@ -51,6 +52,17 @@ void UISMRuntimeDebugger::BeginPlay()
     }
 }
 
+// ------------------------------------------------------------
+//  EndPlay
+// ------------------------------------------------------------
+
+void UISMRuntimeDebugger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ReleaseBatchedDraws({});
+
+    Super::EndPlay(EndPlayReason);
+}
+
 // ------------------------------------------------------------
 //  TickComponent
 // ------------------------------------------------------------
@@ -68,6 +80,8 @@ void UISMRuntimeDebugger::TickComponent(
 
     if (!bEnabled || !GetWorld())
     {
+        // Cached batches would otherwise keep drawing
+        ReleaseBatchedDraws({});
         return;
     }
 
@@ -190,6 +204,8 @@ void UISMRuntimeDebugger::DrawDebugForComponent(
     const bool bDrawIndex          = (ActiveFlags & (int32)EISMDebugDrawFlags::InstanceIndex)   != 0;
     const bool bDrawStateColor     = (ActiveFlags & (int32)EISMDebugDrawFlags::StateFlags)      != 0;
     const bool bDrawCompBounds     = (ActiveFlags & (int32)EISMDebugDrawFlags::ComponentBounds) != 0;
+    const bool bDrawSpatialHealth  = (ActiveFlags & (int32)EISMDebugDrawFlags::SpatialHealth)   != 0;
+    const bool bDrawOpCounters     = (ActiveFlags & (int32)EISMDebugDrawFlags::OpCounters)      != 0;
 
     // Component aggregate bounds — one draw, cheap
     if (bDrawCompBounds)
@@ -197,12 +213,29 @@ void UISMRuntimeDebugger::DrawDebugForComponent(
         DrawComponentBounds(Comp, BaseColor.CopyWithNewOpacity(0.6f), World);
     }
 
+    if (bDrawSpatialHealth)
+    {
+        DrawSpatialHealth(Comp, BaseColor, World);
+    }
+
+    if (bDrawOpCounters)
+    {
+        DrawOpCounters(Comp, BaseColor, World);
+    }
+
+    // Nothing left to draw per instance (AABBs may have gone to the batched path)
+    if (!bDrawAABB && !bDrawCenter && !bDrawIndex)
+    {
+        return;
+    }
+
     const int32 TotalInstances = Comp->GetInstanceCount();
     const float MaxDistSq      = (MaxDrawDistance > 0.0f)
         ? FMath::Square(MaxDrawDistance)
         : FLT_MAX;
     const float MaxLabelDistSq = FMath::Square(MaxLabelDistance);
 
+    const FISMInstanceStateStore& States = Comp->GetInstanceStateStore();
     int32 DrawnCount = 0;
 
     for (int32 i = 0; i < TotalInstances; ++i)
@@ -214,22 +247,22 @@ void UISMRuntimeDebugger::DrawDebugForComponent(
         }
 
         // State checks
-        const FISMInstanceState* State = Comp->GetInstanceState(i);
+        const bool bHasState = States.Contains(i);
 
-        if (bSkipDestroyedInstances && State && State->HasFlag(EISMInstanceState::Destroyed))
+        if (bSkipDestroyedInstances && States.HasFlag(i, EISMInstanceState::Destroyed))
         {
             continue;
         }
 
         // Resolve draw color for this instance
         FLinearColor InstanceColor = BaseColor;
-        if (bDrawStateColor && State)
+        if (bDrawStateColor && bHasState)
         {
-            if (State->HasFlag(EISMInstanceState::Destroyed))
+            if (States.HasFlag(i, EISMInstanceState::Destroyed))
             {
                 InstanceColor = DestroyedColor;
             }
-            else if (State->HasFlag(EISMInstanceState::Hidden))
+            else if (States.HasFlag(i, EISMInstanceState::Hidden))
             {
                 InstanceColor = HiddenColor;
             }
@@ -249,13 +282,14 @@ void UISMRuntimeDebugger::DrawDebugForComponent(
         {
             bool bVisible = false;
 
-            if (Comp->bComputeInstanceAABBs && State && State->bBoundsValid)
+            FBox WorldBounds;
+            if (Comp->bComputeInstanceAABBs && States.GetWorldBounds(i, WorldBounds))
             {
                 // Test the full AABB against the frustum — more accurate,
                 // avoids popping at frustum edges for large instances.
                 bVisible = Frustum.IntersectBox(
-                    State->WorldBounds.GetCenter(),
-                    State->WorldBounds.GetExtent()
+                    WorldBounds.GetCenter(),
+                    WorldBounds.GetExtent()
                 );
             }
             else
@@ -272,9 +306,10 @@ void UISMRuntimeDebugger::DrawDebugForComponent(
 
         // ---- Draw this instance ----
 
-        if (bDrawAABB && Comp->bComputeInstanceAABBs && State && State->bBoundsValid)
+        FBox DrawBounds;
+        if (bDrawAABB && Comp->bComputeInstanceAABBs && States.GetWorldBounds(i, DrawBounds))
         {
-            DrawInstanceAABB(State->WorldBounds, InstanceColor, LineThickness, World);
+            DrawInstanceAABB(DrawBounds, InstanceColor, LineThickness, World);
         }
 
         if (bDrawCenter)
@@ -300,6 +335,142 @@ void UISMRuntimeDebugger::DrawDebugForComponent(
     }
 }
 
+// ------------------------------------------------------------
+//  UpdateBatchedDraw
+//  Builds every instance AABB of a component into its own line
+//  batch in one go. The batch's scene proxy draws the lines every
+//  frame on its own, so the game thread only pays again when the
+//  component's instances change.
+// ------------------------------------------------------------
+
+static void AppendBoxLines(const FBox& Box, const FLinearColor& Color, float Thickness, TArray<FBatchedLine>& OutLines)
+{
+    const FVector& Min = Box.Min;
+    const FVector& Max = Box.Max;
+    const FVector Corners[8] =
+    {
+        FVector(Min.X, Min.Y, Min.Z), FVector(Max.X, Min.Y, Min.Z), FVector(Max.X, Max.Y, Min.Z), FVector(Min.X, Max.Y, Min.Z),
+        FVector(Min.X, Min.Y, Max.Z), FVector(Max.X, Min.Y, Max.Z), FVector(Max.X, Max.Y, Max.Z), FVector(Min.X, Max.Y, Max.Z),
+    };
+    static constexpr int32 Edges[12][2] =
+    {
+        { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+        { 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+        { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+    };
+
+    for (const auto& Edge : Edges)
+    {
+        // Zero lifetime - the lines stay until the batch is flushed
+        OutLines.Emplace(Corners[Edge[0]], Corners[Edge[1]], Color, 0.0f, Thickness, SDPG_World);
+    }
+}
+
+void UISMRuntimeDebugger::UpdateBatchedDraw(
+    const UISMRuntimeComponent* Comp,
+    const FLinearColor& BaseColor,
+    int32 ActiveFlags)
+{
+    if (!Comp || !GetOwner())
+    {
+        return;
+    }
+
+    FBatchedComponentDraw& Draw = BatchedDraws.FindOrAdd(Comp);
+    ULineBatchComponent* Lines = Draw.Lines.Get();
+    const uint64 QueryRevision = Comp->GetQueryRevision();
+
+    if (Lines
+        && Draw.QueryRevision == QueryRevision
+        && Draw.Color == BaseColor
+        && Draw.Flags == ActiveFlags
+        && Draw.Thickness == LineThickness
+        && Draw.bSkipDestroyed == bSkipDestroyedInstances)
+    {
+        return;
+    }
+
+    if (!Lines)
+    {
+        Lines = NewObject<ULineBatchComponent>(GetOwner(), NAME_None, RF_Transient);
+        Lines->RegisterComponent();
+        Draw.Lines = Lines;
+    }
+
+    Draw.QueryRevision = QueryRevision;
+    Draw.Color = BaseColor;
+    Draw.Flags = ActiveFlags;
+    Draw.Thickness = LineThickness;
+    Draw.bSkipDestroyed = bSkipDestroyedInstances;
+
+    const bool bDrawStateColor = (ActiveFlags & (int32)EISMDebugDrawFlags::StateFlags) != 0;
+    const FISMInstanceStateStore& States = Comp->GetInstanceStateStore();
+    const int32 TotalInstances = Comp->GetInstanceCount();
+
+    TArray<FBatchedLine> BoxLines;
+    if (Comp->bComputeInstanceAABBs)
+    {
+        BoxLines.Reserve(TotalInstances * 12);
+        for (int32 i = 0; i < TotalInstances; ++i)
+        {
+            const bool bDestroyed = States.HasFlag(i, EISMInstanceState::Destroyed);
+            if (bSkipDestroyedInstances && bDestroyed)
+            {
+                continue;
+            }
+
+            FBox WorldBounds;
+            if (!States.GetWorldBounds(i, WorldBounds) || !WorldBounds.IsValid)
+            {
+                continue;
+            }
+
+            FLinearColor InstanceColor = BaseColor;
+            if (bDrawStateColor)
+            {
+                if (bDestroyed)
+                {
+                    InstanceColor = DestroyedColor;
+                }
+                else if (States.HasFlag(i, EISMInstanceState::Hidden))
+                {
+                    InstanceColor = HiddenColor;
+                }
+            }
+
+            AppendBoxLines(WorldBounds, InstanceColor, LineThickness, BoxLines);
+        }
+    }
+
+    Lines->Flush();
+    if (BoxLines.Num() > 0)
+    {
+        Lines->DrawLines(BoxLines);
+    }
+}
+
+// ------------------------------------------------------------
+//  ReleaseBatchedDraws
+// ------------------------------------------------------------
+
+void UISMRuntimeDebugger::ReleaseBatchedDraws(const TSet<const UISMRuntimeComponent*>& KeepComponents)
+{
+    for (auto It = BatchedDraws.CreateIterator(); It; ++It)
+    {
+        const UISMRuntimeComponent* Comp = It.Key().Get();
+        if (Comp && KeepComponents.Contains(Comp))
+        {
+            continue;
+        }
+
+        if (ULineBatchComponent* Lines = It.Value().Lines.Get())
+        {
+            Lines->DestroyComponent();
+        }
+        It.RemoveCurrent();
+    }
+}
+
 // ------------------------------------------------------------
 //  DrawInstanceAABB
 //  Draws a box using batched debug lines. We call DrawDebugBox
@@ -365,6 +536,105 @@ void UISMRuntimeDebugger::DrawComponentBounds(
     }
 }
 
+// ------------------------------------------------------------
+//  DrawSpatialHealth
+//  One label above the component. Query figures need the
+//  component's bSpatialQueryTelemetry; occupancy is always shown.
+// ------------------------------------------------------------
+
+void UISMRuntimeDebugger::DrawSpatialHealth(
+    const UISMRuntimeComponent* Comp,
+    const FLinearColor& Color,
+    UWorld* World) const
+{
+    if (!Comp || !World || !Comp->ManagedISMComponent)
+    {
+        return;
+    }
+
+    const FISMSpatialIndexHealth Health = Comp->GetSpatialIndexHealth();
+
+    FString Label = FString::Printf(TEXT("%s\nCells %d, %.1f avg / %d max per cell"),
+        *Comp->GetName(), Health.CellCount, Health.AverageInstancesPerCell, Health.MaxInstancesPerCell);
+
+    if (Health.bTelemetryEnabled)
+    {
+        Label += FString::Printf(TEXT("\n%lld queries, %.1f candidates/query, %.0f%% false positives"),
+            Health.QueryCount, Health.MeanCandidatesPerQuery, Health.FalsePositiveRatio * 100.0f);
+        if (Health.RecommendedCellSize > 0.0f)
+        {
+            Label += FString::Printf(TEXT("\nCell size %.0f, recommended %.0f (median radius %.0f)"),
+                Health.CellSize, Health.RecommendedCellSize, Health.MedianQueryRadius);
+        }
+    }
+    else
+    {
+        Label += FString::Printf(TEXT("\nCell size %.0f (enable bSpatialQueryTelemetry for query stats)"), Health.CellSize);
+    }
+
+    const FBoxSphereBounds& Bounds = Comp->ManagedISMComponent->Bounds;
+    DrawDebugString(
+        World,
+        Bounds.Origin + FVector(0, 0, Bounds.BoxExtent.Z + 100.0f),
+        Label,
+        nullptr,
+        Color.ToFColor(true),
+        -1.0f,
+        false,
+        1.2f
+    );
+}
+
+// ------------------------------------------------------------
+//  DrawOpCounters
+//  Rates label below the health label. Hot instances need the
+//  component's bSampleHotInstances.
+// ------------------------------------------------------------
+
+void UISMRuntimeDebugger::DrawOpCounters(
+    const UISMRuntimeComponent* Comp,
+    const FLinearColor& Color,
+    UWorld* World) const
+{
+    if (!Comp || !World || !Comp->ManagedISMComponent)
+    {
+        return;
+    }
+
+    const FISMComponentOpStats Stats = Comp->GetOpStats(3);
+
+    FString Label = FString::Printf(TEXT("%s ops/s
+Add %.0f  Destroy %.0f  Transform %.0f  CustomData %.0f
+Query %.0f  Delegate %.0f"),
+        *Comp->GetName(),
+        Stats.GetRate(EISMComponentOp::Add), Stats.GetRate(EISMComponentOp::Destroy),
+        Stats.GetRate(EISMComponentOp::TransformUpdate), Stats.GetRate(EISMComponentOp::CustomDataWrite),
+        Stats.GetRate(EISMComponentOp::Query), Stats.GetRate(EISMComponentOp::DelegateBroadcast));
+
+    if (Stats.HotInstances.Num() > 0)
+    {
+        Label += TEXT("
+Hot:");
+        for (const FISMHotInstanceSample& Sample : Stats.HotInstances)
+        {
+            Label += FString::Printf(TEXT(" #%d (%d)"), Sample.InstanceIndex, Sample.Mutations);
+        }
+    }
+
+    // Just above the bounds, so it stays clear of the spatial health label
+    const FBoxSphereBounds& Bounds = Comp->ManagedISMComponent->Bounds;
+    DrawDebugString(
+        World,
+        Bounds.Origin + FVector(0, 0, Bounds.BoxExtent.Z + 20.0f),
+        Label,
+        nullptr,
+        Color.ToFColor(true),
+        -1.0f,
+        false,
+        1.2f
+    );
+}
+
 // ------------------------------------------------------------
 //  ResolveComponentColor
 //  Priority: ComponentOverride > DataAsset DebugColor > DefaultColor
@@ -473,6 +743,7 @@ void UISMRuntimeDebugger::DrawDebugForAllComponents(const FSceneView* View)
     }
 
     TArray<UISMRuntimeComponent*> Components = GetComponentsToDraw();
+    TSet<const UISMRuntimeComponent*> BatchedComponents;
 
     for (UISMRuntimeComponent* Comp : Components)
     {
@@ -484,6 +755,16 @@ void UISMRuntimeDebugger::DrawDebugForAllComponents(const FSceneView* View)
         FLinearColor Color = ResolveComponentColor(Comp);
         int32 ActiveFlags = ResolveComponentFlags(Comp);
 
+        // AABBs go to the cached line batch; the rest stays per instance
+        if (bBatchedInstanceDraw && (ActiveFlags & (int32)EISMDebugDrawFlags::InstanceAABB))
+        {
+            UpdateBatchedDraw(Comp, Color, ActiveFlags);
+            BatchedComponents.Add(Comp);
+            ActiveFlags &= ~(int32)EISMDebugDrawFlags::InstanceAABB;
+        }
+
         DrawDebugForComponent(Comp, Color, ActiveFlags, Frustum, CameraLocation, World);
     }
+
+    ReleaseBatchedDraws(BatchedComponents);
 }
\ No newline at end of file
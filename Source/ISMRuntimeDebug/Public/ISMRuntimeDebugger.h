@@ -7,6 +7,7 @@
 
 class UISMRuntimeComponent;
 class UISMRuntimeSubsystem;
+class ULineBatchComponent;
 
 /**
  * Which visual elements to draw per instance.
@@ -21,6 +22,8 @@ enum class EISMDebugDrawFlags : uint8
     InstanceCenter  = 1 << 2,   // Point at instance center
     InstanceIndex   = 1 << 3,   // Index label (expensive at scale, use with MaxLabelDistance)
     StateFlags      = 1 << 4,   // Color-code by active/destroyed/hidden state
+    SpatialHealth   = 1 << 5,   // Spatial index health label per component (query telemetry, recommended cell size)
+    OpCounters      = 1 << 6,   // Operation rates label per component (adds, destroys, updates, queries, broadcasts)
 };
 ENUM_CLASS_FLAGS(EISMDebugDrawFlags)
 
@@ -165,9 +168,20 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Debug|Performance")
     bool bSkipDestroyedInstances = false;
 
+    /**
+     * Draw InstanceAABB boxes (state-coloured with StateFlags) for every instance through one
+     * cached line batch per component, rebuilt only when the component's instances change
+     * (GetQueryRevision) or its color or flags do, instead of per-instance debug draws every tick.
+     * The batch ignores MaxDrawDistance, frustum culling and MaxInstancesPerComponent; centers and
+     * index labels keep the per-instance path.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Debug|Performance")
+    bool bBatchedInstanceDraw = false;
+
     // ===== Lifecycle =====
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType,
         FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -197,6 +211,15 @@ protected:
         const FVector& CameraLocation,
         UWorld* World) const;
 
+    /** Rebuild a component's cached line batch if it is out of date */
+    void UpdateBatchedDraw(
+        const UISMRuntimeComponent* Comp,
+        const FLinearColor& Color,
+        int32 ActiveFlags);
+
+    /** Destroy the line batches of components no longer drawn batched */
+    void ReleaseBatchedDraws(const TSet<const UISMRuntimeComponent*>& KeepComponents);
+
     /** Draw a single instance AABB */
     void DrawInstanceAABB(
         const FBox& WorldBounds,
@@ -210,6 +233,18 @@ protected:
         const FLinearColor& Color,
         UWorld* World) const;
 
+    /** Draw the component's spatial index health label */
+    void DrawSpatialHealth(
+        const UISMRuntimeComponent* Comp,
+        const FLinearColor& Color,
+        UWorld* World) const;
+
+    /** Draw the component's operation rates label */
+    void DrawOpCounters(
+        const UISMRuntimeComponent* Comp,
+        const FLinearColor& Color,
+        UWorld* World) const;
+
     /** Resolve the effective color for a component */
     FLinearColor ResolveComponentColor(const UISMRuntimeComponent* Comp) const;
 
@@ -221,4 +256,18 @@ protected:
 
     /** Get camera info for this frame */
     bool GetCameraInfo(FVector& OutLocation, FConvexVolume& OutFrustum) const;
+
+private:
+    /** One component's cached bBatchedInstanceDraw lines and what they were built from */
+    struct FBatchedComponentDraw
+    {
+        TWeakObjectPtr<ULineBatchComponent> Lines;
+        uint64 QueryRevision = 0;
+        FLinearColor Color = FLinearColor::White;
+        int32 Flags = 0;
+        float Thickness = 0.0f;
+        bool bSkipDestroyed = false;
+    };
+
+    TMap<TWeakObjectPtr<const UISMRuntimeComponent>, FBatchedComponentDraw> BatchedDraws;
 };
\ No newline at end of file
@@ -32,6 +32,7 @@ public class ISMRuntimeEditor : ModuleRules
                 "UMG",
                 "Slate",
                 "SlateCore",
+                "WorkspaceMenuStructure",
             }
         );
     }
@@ -0,0 +1,78 @@
+#include "ISMBakeUtilities.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMBakedInstanceState.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogISMBake, Log, All);
+
+bool FISMBakeUtilities::IsBakeStale(const UISMRuntimeComponent* Component)
+{
+    return Component && Component->BakedState && !Component->BakedState->IsUpToDateWith(Component);
+}
+
+bool FISMBakeUtilities::BakeComponent(UISMRuntimeComponent* Component)
+{
+    if (!Component)
+    {
+        return false;
+    }
+
+    if (!Component->IsISMInitialized())
+    {
+        // Build from the ISM itself; a stale bake would otherwise overwrite it during init
+        TObjectPtr<UISMBakedInstanceState> PreviousBake = Component->BakedState;
+        Component->BakedState = nullptr;
+        Component->InitializeInstances();
+        Component->BakedState = PreviousBake;
+    }
+
+    if (!Component->IsISMInitialized())
+    {
+        UE_LOG(LogISMBake, Warning, TEXT("ISMBake: %s could not be initialized for baking"), *Component->GetPathName());
+        return false;
+    }
+
+    Component->Modify();
+    if (!Component->BakedState)
+    {
+        Component->BakedState = NewObject<UISMBakedInstanceState>(Component, NAME_None, RF_Transactional);
+    }
+    Component->BakedState->Modify();
+
+    if (!Component->BakeState(Component->BakedState))
+    {
+        UE_LOG(LogISMBake, Warning, TEXT("ISMBake: %s does not fit the bake format"), *Component->GetPathName());
+        return false;
+    }
+
+    UE_LOG(LogISMBake, Verbose, TEXT("ISMBake: Baked %d instances of %s"), Component->BakedState->GetNumInstances(), *Component->GetPathName());
+    return true;
+}
+
+int32 FISMBakeUtilities::BakeWorld(UWorld* World, bool bOnlyStale)
+{
+    if (!World)
+    {
+        return 0;
+    }
+
+    int32 NumBaked = 0;
+    TArray<UISMRuntimeComponent*> Components;
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        It->GetComponents(Components);
+        for (UISMRuntimeComponent* Component : Components)
+        {
+            if (bOnlyStale && !IsBakeStale(Component))
+            {
+                continue;
+            }
+            if (BakeComponent(Component))
+            {
+                NumBaked++;
+            }
+        }
+    }
+    return NumBaked;
+}
@@ -0,0 +1,347 @@
+#include "ISMInstanceAnalyzer.h"
+#include "ISMBakeUtilities.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMInstanceDataAsset.h"
+#include "ISMMemoryStats.h"
+#include "CustomData/ISMCustomDataSchema.h"
+#include "Settings/ISMRuntimeSchemaSettings.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/Crc.h"
+
+namespace ISMInstanceAnalyzer
+{
+    // Approximate runtime bytes per instance of an initialized component: state store (flags,
+    // generations, bounds, update frames), spatial index (cell entry, SoA position, bounds, tag
+    // cell) and their bit columns. Per occupied cell: hashed entry plus cell bounds.
+    constexpr int64 BytesPerInstance = 96;
+    constexpr int64 BytesPerCell = 64;
+
+    // Candidates per query above which the cell size or the query is too coarse
+    constexpr float MaxHealthyCandidates = 256.0f;
+
+    // Cells per query above which the cell size is too fine for the radius
+    constexpr float MaxHealthyCells = 64.0f;
+
+    FIntVector ToCell(const FVector& Location, float CellSize)
+    {
+        return FIntVector(
+            FMath::FloorToInt32(Location.X / CellSize),
+            FMath::FloorToInt32(Location.Y / CellSize),
+            FMath::FloorToInt32(Location.Z / CellSize));
+    }
+
+    FString FormatBytes(int64 Bytes)
+    {
+        if (Bytes >= 1024 * 1024)
+        {
+            return FString::Printf(TEXT("%.2f MB"), Bytes / (1024.0 * 1024.0));
+        }
+        return FString::Printf(TEXT("%.1f KB"), Bytes / 1024.0);
+    }
+}
+
+TArray<float> FISMInstanceAnalyzer::GetDefaultQueryRadii()
+{
+    return { 500.0f, 2000.0f, 5000.0f };
+}
+
+FISMInstanceAnalysis FISMInstanceAnalyzer::Analyze(const UISMRuntimeComponent* Component, TConstArrayView<float> QueryRadii)
+{
+    using namespace ISMInstanceAnalyzer;
+
+    FISMInstanceAnalysis Analysis;
+    if (!Component)
+    {
+        return Analysis;
+    }
+
+    Analysis.ComponentName = Component->GetReadableName();
+    Analysis.InstanceDataName = GetNameSafe(Component->InstanceData);
+    Analysis.CellSize = FMath::Max(Component->SpatialIndexCellSize, 1.0f);
+
+    const UInstancedStaticMeshComponent* ISM = Component->ManagedISMComponent;
+    if (!ISM)
+    {
+        Analysis.Hints.Add(TEXT("No ManagedISMComponent - nothing to analyze."));
+        return Analysis;
+    }
+
+    // ===== Instances & Cells =====
+
+    const int32 NumInstances = ISM->GetInstanceCount();
+    Analysis.NumInstances = NumInstances;
+
+    TArray<FVector> Locations;
+    Locations.Reserve(NumInstances);
+    for (int32 i = 0; i < NumInstances; ++i)
+    {
+        FTransform Transform;
+        if (ISM->GetInstanceTransform(i, Transform, true))
+        {
+            Locations.Add(Transform.GetLocation());
+            Analysis.Bounds += Transform.GetLocation();
+        }
+    }
+
+    TMap<FIntVector, int32> CellCounts;
+    for (const FVector& Location : Locations)
+    {
+        CellCounts.FindOrAdd(ToCell(Location, Analysis.CellSize))++;
+    }
+    Analysis.NumOccupiedCells = CellCounts.Num();
+    for (const TPair<FIntVector, int32>& Cell : CellCounts)
+    {
+        Analysis.MaxInstancesPerCell = FMath::Max(Analysis.MaxInstancesPerCell, Cell.Value);
+    }
+    Analysis.AvgInstancesPerCell = CellCounts.Num() > 0 ? static_cast<float>(Locations.Num()) / CellCounts.Num() : 0.0f;
+
+    // Density over the footprint; content thinner than a cell is spread in XY, so volume would
+    // understate it
+    if (Locations.Num() > 1)
+    {
+        const FVector Size = Analysis.Bounds.GetSize();
+        const double Area = FMath::Max(Size.X, 1.0) * FMath::Max(Size.Y, 1.0);
+        const double Cell = FMath::Sqrt(Area * TargetInstancesPerCell / Locations.Num());
+        Analysis.RecommendedCellSize = FMath::Max(100.0f, FMath::RoundToFloat(static_cast<float>(Cell) / 100.0f) * 100.0f);
+    }
+
+    // Sampled query boxes: walk the box's cells or the occupied cells, whichever is fewer
+    const int32 SampleStride = FMath::Max(1, Locations.Num() / MaxQuerySamples);
+    for (const float Radius : QueryRadii)
+    {
+        FISMQueryRadiusCost& Cost = Analysis.QueryCosts.AddDefaulted_GetRef();
+        Cost.Radius = Radius;
+
+        int32 NumSamples = 0;
+        for (int32 i = 0; i < Locations.Num(); i += SampleStride)
+        {
+            const FIntVector MinCell = ToCell(Locations[i] - FVector(Radius), Analysis.CellSize);
+            const FIntVector MaxCell = ToCell(Locations[i] + FVector(Radius), Analysis.CellSize);
+            const int64 NumBoxCells = static_cast<int64>(MaxCell.X - MinCell.X + 1)
+                * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+
+            int32 NumOccupied = 0;
+            int32 NumCandidates = 0;
+            if (NumBoxCells <= CellCounts.Num())
+            {
+                for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+                for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+                {
+                    if (const int32* Count = CellCounts.Find(FIntVector(X, Y, Z)))
+                    {
+                        ++NumOccupied;
+                        NumCandidates += *Count;
+                    }
+                }
+            }
+            else
+            {
+                for (const TPair<FIntVector, int32>& Cell : CellCounts)
+                {
+                    const FIntVector& Key = Cell.Key;
+                    if (Key.X >= MinCell.X && Key.X <= MaxCell.X && Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y
+                        && Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+                    {
+                        ++NumOccupied;
+                        NumCandidates += Cell.Value;
+                    }
+                }
+            }
+
+            Cost.AvgCellsOverlapped += static_cast<float>(NumBoxCells);
+            Cost.AvgOccupiedCells += NumOccupied;
+            Cost.AvgCandidates += NumCandidates;
+            ++NumSamples;
+        }
+
+        if (NumSamples > 0)
+        {
+            Cost.AvgCellsOverlapped /= NumSamples;
+            Cost.AvgOccupiedCells /= NumSamples;
+            Cost.AvgCandidates /= NumSamples;
+        }
+    }
+
+    // ===== Memory =====
+
+    const int32 NumFloats = ISM->NumCustomDataFloats;
+    Analysis.NumCustomDataFloats = NumFloats;
+    Analysis.CustomDataBytes = static_cast<int64>(NumInstances) * NumFloats * sizeof(float);
+
+    if (Component->IsISMInitialized())
+    {
+        Analysis.RuntimeMemoryBytes = Component->GetMemoryStats().TotalBytes;
+        Analysis.bMemoryMeasured = true;
+    }
+    else
+    {
+        Analysis.RuntimeMemoryBytes = NumInstances * BytesPerInstance + Analysis.NumOccupiedCells * BytesPerCell;
+    }
+
+    // ===== Custom Data & DMI Signatures =====
+
+    FName SchemaName;
+    const FISMCustomDataSchema* Schema = Component->GetCustomDataSchema(&SchemaName);
+    Analysis.SchemaName = SchemaName;
+
+    TBitArray<> MappedSlots(false, NumFloats);
+    if (Schema)
+    {
+        for (const FISMCustomDataChannelDef& Channel : Schema->Channels)
+        {
+            const int32 Width = Channel.bIsVector ? Channel.ComponentCount : 1;
+            for (int32 c = 0; c < Width; ++c)
+            {
+                if (MappedSlots.IsValidIndex(Channel.DataIndex + c))
+                {
+                    MappedSlots[Channel.DataIndex + c] = true;
+                }
+            }
+        }
+    }
+
+    const TArray<float>& CustomData = ISM->PerInstanceSMCustomData;
+    const bool bHasCustomData = NumFloats > 0 && CustomData.Num() >= NumInstances * NumFloats;
+    for (int32 Slot = 0; Slot < NumFloats; ++Slot)
+    {
+        FISMCustomDataSlotUsage& Usage = Analysis.CustomDataSlots.AddDefaulted_GetRef();
+        Usage.Slot = Slot;
+        Usage.bMappedBySchema = MappedSlots[Slot];
+
+        TSet<float> Distinct;
+        for (int32 i = 0; bHasCustomData && i < NumInstances && Distinct.Num() < MaxDistinctValues; ++i)
+        {
+            Distinct.Add(CustomData[i * NumFloats + Slot]);
+        }
+        Usage.NumDistinctValues = Distinct.Num();
+    }
+
+    Analysis.ConfiguredMaxSharedPoolSize = UISMRuntimeDeveloperSettings::Get()->DefaultMaxSharedPoolSize;
+
+    const bool bUsesPICD = !Component->InstanceData || Component->InstanceData->bUsePICDConversion;
+    if (Schema && bUsesPICD)
+    {
+        // Pool signatures are template + mapped values, so slots sharing a material share DMIs
+        TSet<const UMaterialInterface*> Templates;
+        for (int32 Slot = 0; Slot < ISM->GetNumMaterials(); ++Slot)
+        {
+            if (Schema->AppliesToSlot(Slot) && Schema->UsesDMIForSlot(Slot))
+            {
+                ++Analysis.NumDMISlots;
+                if (const UMaterialInterface* Template = ISM->GetMaterial(Slot))
+                {
+                    Templates.Add(Template);
+                }
+            }
+        }
+
+        if (Templates.Num() > 0)
+        {
+            const int32 NumMapped = Schema->GetNumMappedValues();
+            TArray<float> Mapped;
+            Mapped.SetNumZeroed(NumMapped);
+            TSet<uint32> Signatures;
+            for (int32 i = 0; i < NumInstances; ++i)
+            {
+                const TConstArrayView<float> Row = bHasCustomData
+                    ? TConstArrayView<float>(CustomData.GetData() + i * NumFloats, NumFloats)
+                    : TConstArrayView<float>();
+                Schema->ExtractMappedValues(Row, Mapped);
+                Signatures.Add(FCrc::MemCrc32(Mapped.GetData(), Mapped.Num() * sizeof(float)));
+            }
+            Analysis.ExpectedDMISignatures = Signatures.Num() * Templates.Num();
+        }
+    }
+
+    // ===== Hints =====
+
+    if (Analysis.RecommendedCellSize > 0.0f
+        && (Analysis.CellSize > 2.0f * Analysis.RecommendedCellSize || Analysis.CellSize < 0.5f * Analysis.RecommendedCellSize))
+    {
+        Analysis.Hints.Add(FString::Printf(TEXT("SpatialIndexCellSize %.0f is far from %.0f, which holds about %d instances per cell at this density."),
+            Analysis.CellSize, Analysis.RecommendedCellSize, TargetInstancesPerCell));
+    }
+
+    for (const FISMQueryRadiusCost& Cost : Analysis.QueryCosts)
+    {
+        if (Cost.AvgCandidates > MaxHealthyCandidates)
+        {
+            Analysis.Hints.Add(FString::Printf(TEXT("Radius %.0f queries test %.0f candidates on average; use smaller cells or narrower queries."),
+                Cost.Radius, Cost.AvgCandidates));
+        }
+        else if (Cost.AvgCellsOverlapped > MaxHealthyCells)
+        {
+            Analysis.Hints.Add(FString::Printf(TEXT("Radius %.0f queries overlap %.0f cells; aim for a cell size near %.0f (2x the radius)."),
+                Cost.Radius, Cost.AvgCellsOverlapped, 2.0f * Cost.Radius));
+        }
+    }
+
+    for (const FISMCustomDataSlotUsage& Usage : Analysis.CustomDataSlots)
+    {
+        if (bHasCustomData && NumInstances > 1 && Usage.NumDistinctValues <= 1)
+        {
+            Analysis.Hints.Add(FString::Printf(TEXT("Custom data slot %d holds one value for every instance; move it to the material or data asset."), Usage.Slot));
+        }
+    }
+
+    if (Analysis.ConfiguredMaxSharedPoolSize > 0 && Analysis.ExpectedDMISignatures > Analysis.ConfiguredMaxSharedPoolSize)
+    {
+        Analysis.Hints.Add(FString::Printf(TEXT("%d DMI signatures exceed DefaultMaxSharedPoolSize %d; conversions will evict. Raise the pool or set channel QuantizationStep."),
+            Analysis.ExpectedDMISignatures, Analysis.ConfiguredMaxSharedPoolSize));
+    }
+    else if (Analysis.ExpectedDMISignatures > MaxDistinctValues)
+    {
+        Analysis.Hints.Add(FString::Printf(TEXT("%d distinct DMI signatures; set QuantizationStep on the schema channels so instances share DMIs."),
+            Analysis.ExpectedDMISignatures));
+    }
+
+    if (!Component->BakedState && NumInstances >= 10000)
+    {
+        Analysis.Hints.Add(TEXT("No BakedState for a large component; run ISM.BakeStaticState so level start adopts the spatial index instead of building it."));
+    }
+    else if (FISMBakeUtilities::IsBakeStale(Component))
+    {
+        Analysis.Hints.Add(TEXT("BakedState is stale and will be rebuilt at runtime; run ISM.BakeStaticState."));
+    }
+
+    return Analysis;
+}
+
+FString FISMInstanceAnalysis::ToString() const
+{
+    using namespace ISMInstanceAnalyzer;
+
+    TStringBuilder<2048> Report;
+    Report.Appendf(TEXT("%s (%s)\n"), *ComponentName, *InstanceDataName);
+    Report.Appendf(TEXT("  Instances: %d, bounds %s\n"), NumInstances, *Bounds.GetSize().ToCompactString());
+    Report.Appendf(TEXT("  Runtime memory: %s%s, ISM custom data: %s\n"),
+        *FormatBytes(RuntimeMemoryBytes), bMemoryMeasured ? TEXT("") : TEXT(" (estimated)"), *FormatBytes(CustomDataBytes));
+
+    Report.Appendf(TEXT("  Spatial index: cell size %.0f, %d cells, %.1f avg / %d max instances per cell, recommended %.0f\n"),
+        CellSize, NumOccupiedCells, AvgInstancesPerCell, MaxInstancesPerCell, RecommendedCellSize);
+    for (const FISMQueryRadiusCost& Cost : QueryCosts)
+    {
+        Report.Appendf(TEXT("    radius %6.0f: %.1f cells overlapped, %.1f occupied, %.1f candidates\n"),
+            Cost.Radius, Cost.AvgCellsOverlapped, Cost.AvgOccupiedCells, Cost.AvgCandidates);
+    }
+
+    Report.Appendf(TEXT("  Custom data: %d slots\n"), NumCustomDataFloats);
+    for (const FISMCustomDataSlotUsage& Usage : CustomDataSlots)
+    {
+        Report.Appendf(TEXT("    slot %d: %s%d distinct values%s\n"), Usage.Slot,
+            Usage.NumDistinctValues >= FISMInstanceAnalyzer::MaxDistinctValues ? TEXT(">=") : TEXT(""),
+            Usage.NumDistinctValues, Usage.bMappedBySchema ? TEXT(", mapped by schema") : TEXT(""));
+    }
+
+    Report.Appendf(TEXT("  Schema: %s, %d DMI slots, %d expected DMI signatures, pool limit %s\n"),
+        *SchemaName.ToString(), NumDMISlots, ExpectedDMISignatures,
+        ConfiguredMaxSharedPoolSize > 0 ? *FString::FromInt(ConfiguredMaxSharedPoolSize) : TEXT("unlimited"));
+
+    for (const FString& Hint : Hints)
+    {
+        Report.Appendf(TEXT("  ! %s\n"), *Hint);
+    }
+    return FString(Report.ToView());
+}
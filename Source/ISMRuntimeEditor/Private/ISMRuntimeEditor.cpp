@@ -1,13 +1,127 @@
 #include "ISMRuntimeEditor.h"
+#include "ISMBakeUtilities.h"
+#include "ISMInstanceAnalyzer.h"
+#include "SISMInstanceAnalyzer.h"
+#include "ISMRuntimeComponent.h"
+#include "Settings/ISMRuntimeSettings.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "UObject/ObjectSaveContext.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 #define LOCTEXT_NAMESPACE "FISMRuntimeEditorModule"
 
+DEFINE_LOG_CATEGORY_STATIC(LogISMRuntimeEditor, Log, All);
+
+static FAutoConsoleCommandWithWorldAndArgs GISMBakeStaticStateCommand(
+    TEXT("ISM.BakeStaticState"),
+    TEXT("Bake the runtime state (spatial index, instance bounds, cell bounds) of runtime components in this world into their BakedState. Only stale bakes unless the arg is 'all'."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+    {
+        const bool bAll = Args.Num() > 0 && Args[0] == TEXT("all");
+        const int32 NumBaked = FISMBakeUtilities::BakeWorld(World, !bAll);
+        UE_LOG(LogISMRuntimeEditor, Log, TEXT("ISM.BakeStaticState: baked %d components in %s"), NumBaked, *GetNameSafe(World));
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs GISMAnalyzeInstancesCommand(
+    TEXT("ISM.AnalyzeInstances"),
+    TEXT("Log the instance performance analysis (memory, spatial index cells, query costs, custom data, DMI signatures) of every runtime component in this world. Args: query radii, default 500 2000 5000."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+    {
+        TArray<float> Radii;
+        for (const FString& Arg : Args)
+        {
+            const float Radius = FCString::Atof(*Arg);
+            if (Radius > 0.0f)
+            {
+                Radii.Add(Radius);
+            }
+        }
+        if (Radii.Num() == 0)
+        {
+            Radii = FISMInstanceAnalyzer::GetDefaultQueryRadii();
+        }
+
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            TArray<UISMRuntimeComponent*> Components;
+            It->GetComponents(Components);
+            for (const UISMRuntimeComponent* Component : Components)
+            {
+                UE_LOG(LogISMRuntimeEditor, Log, TEXT("%s"), *FISMInstanceAnalyzer::Analyze(Component, Radii).ToString());
+            }
+        }
+    }));
+
+const FName FISMRuntimeEditor::InstanceAnalyzerTabName(TEXT("ISMInstanceAnalyzer"));
+
 void FISMRuntimeEditor::StartupModule()
 {
+    PreSaveWorldHandle = FEditorDelegates::PreSaveWorldWithContext.AddRaw(this, &FISMRuntimeEditor::HandlePreSaveWorld);
+
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(InstanceAnalyzerTabName,
+        FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+        {
+            return SNew(SDockTab)
+                .TabRole(ETabRole::NomadTab)
+                [
+                    SNew(SISMInstanceAnalyzer)
+                ];
+        }))
+        .SetDisplayName(LOCTEXT("InstanceAnalyzerTab", "ISM Instance Analyzer"))
+        .SetTooltipText(LOCTEXT("InstanceAnalyzerTooltip", "Estimate the runtime cost of the selected ISM runtime components"))
+        .SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsMiscCategory());
 }
 
 void FISMRuntimeEditor::ShutdownModule()
 {
+    FEditorDelegates::PreSaveWorldWithContext.Remove(PreSaveWorldHandle);
+    PreSaveWorldHandle.Reset();
+
+    if (FSlateApplication::IsInitialized())
+    {
+        FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(InstanceAnalyzerTabName);
+    }
+}
+
+void FISMRuntimeEditor::HandlePreSaveWorld(UWorld* World, FObjectPreSaveContext SaveContext)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    // A cook cannot dirty the level it is saving; stale bakes just fall back to runtime building
+    if (SaveContext.IsCooking())
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            TArray<UISMRuntimeComponent*> Components;
+            It->GetComponents(Components);
+            for (const UISMRuntimeComponent* Component : Components)
+            {
+                if (FISMBakeUtilities::IsBakeStale(Component))
+                {
+                    UE_LOG(LogISMRuntimeEditor, Warning, TEXT("ISMRuntimeEditor: BakedState of %s is stale - it will be built at runtime. Run ISM.BakeStaticState and resave."),
+                        *Component->GetPathName());
+                }
+            }
+        }
+        return;
+    }
+
+    if (GetDefault<UISMRuntimeSettings>()->bRebakeStaleStateOnSave)
+    {
+        const int32 NumBaked = FISMBakeUtilities::BakeWorld(World, true);
+        if (NumBaked > 0)
+        {
+            UE_LOG(LogISMRuntimeEditor, Log, TEXT("ISMRuntimeEditor: Rebaked %d stale runtime components in %s"), NumBaked, *World->GetName());
+        }
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,118 @@
+#include "SISMInstanceAnalyzer.h"
+#include "ISMInstanceAnalyzer.h"
+#include "ISMRuntimeComponent.h"
+#include "Editor.h"
+#include "Selection.h"
+#include "GameFramework/Actor.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "SISMInstanceAnalyzer"
+
+void SISMInstanceAnalyzer::Construct(const FArguments& InArgs)
+{
+    const FString DefaultRadii = FString::JoinBy(FISMInstanceAnalyzer::GetDefaultQueryRadii(), TEXT(", "),
+        [](float Radius) { return FString::SanitizeFloat(Radius, 0); });
+
+    ReportText = LOCTEXT("NoReport", "Select actors with ISM runtime components and press Analyze Selection.");
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f)
+        [
+            SNew(SHorizontalBox)
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SButton)
+                .Text(LOCTEXT("Analyze", "Analyze Selection"))
+                .OnClicked(this, &SISMInstanceAnalyzer::HandleAnalyzeClicked)
+            ]
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(12.0f, 0.0f, 4.0f, 0.0f)
+            [
+                SNew(STextBlock)
+                .Text(LOCTEXT("QueryRadii", "Query radii"))
+            ]
+
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SAssignNew(RadiiTextBox, SEditableTextBox)
+                .Text(FText::FromString(DefaultRadii))
+                .ToolTipText(LOCTEXT("QueryRadiiTooltip", "Comma separated radii of the queries this content typically sees"))
+            ]
+        ]
+
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        .Padding(4.0f)
+        [
+            SNew(SMultiLineEditableTextBox)
+            .IsReadOnly(true)
+            .Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+            .Text_Lambda([this]() { return ReportText; })
+        ]
+    ];
+}
+
+TArray<float> SISMInstanceAnalyzer::ParseQueryRadii() const
+{
+    TArray<FString> Parts;
+    RadiiTextBox->GetText().ToString().ParseIntoArray(Parts, TEXT(","));
+
+    TArray<float> Radii;
+    for (const FString& Part : Parts)
+    {
+        const float Radius = FCString::Atof(*Part.TrimStartAndEnd());
+        if (Radius > 0.0f)
+        {
+            Radii.Add(Radius);
+        }
+    }
+    return Radii.Num() > 0 ? Radii : FISMInstanceAnalyzer::GetDefaultQueryRadii();
+}
+
+FReply SISMInstanceAnalyzer::HandleAnalyzeClicked()
+{
+    const TArray<float> Radii = ParseQueryRadii();
+
+    FString Report;
+    int32 NumComponents = 0;
+    for (FSelectionIterator It(*GEditor->GetSelectedActors()); It; ++It)
+    {
+        const AActor* Actor = Cast<AActor>(*It);
+        if (!Actor)
+        {
+            continue;
+        }
+
+        TArray<UISMRuntimeComponent*> Components;
+        Actor->GetComponents(Components);
+        for (const UISMRuntimeComponent* Component : Components)
+        {
+            Report += FISMInstanceAnalyzer::Analyze(Component, Radii).ToString();
+            Report += TEXT("\n");
+            ++NumComponents;
+        }
+    }
+
+    ReportText = NumComponents > 0
+        ? FText::FromString(Report)
+        : LOCTEXT("NothingSelected", "No ISM runtime components on the selected actors.");
+    return FReply::Handled();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SEditableTextBox;
+
+/**
+ * Instance Performance Analyzer tab: runs FISMInstanceAnalyzer over the runtime components of the
+ * selected actors at the query radii typed in, and shows the reports.
+ */
+class SISMInstanceAnalyzer : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SISMInstanceAnalyzer) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    FReply HandleAnalyzeClicked();
+
+    /** Comma separated radii from the text box; the defaults if none parse */
+    TArray<float> ParseQueryRadii() const;
+
+    TSharedPtr<SEditableTextBox> RadiiTextBox;
+    FText ReportText;
+};
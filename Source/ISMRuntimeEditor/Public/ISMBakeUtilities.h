@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UISMRuntimeComponent;
+class UWorld;
+
+/**
+ * Editor-side baking of UISMRuntimeComponent state (UISMBakedInstanceState): instances, state, tags,
+ * spatial index cells, world locations, per-instance AABBs and cell bounds, so static content
+ * initializes at level start by adopting arrays instead of rebuilding them.
+ */
+class ISMRUNTIMEEDITOR_API FISMBakeUtilities
+{
+public:
+    /** Whether the component has a BakedState that no longer matches its ISM */
+    static bool IsBakeStale(const UISMRuntimeComponent* Component);
+
+    /**
+     * Initialize the component if needed (ignoring its current bake) and write its state into
+     * BakedState, creating one inside the component when it has none.
+     * @return false if the component could not be initialized or baked
+     */
+    static bool BakeComponent(UISMRuntimeComponent* Component);
+
+    /**
+     * Bake every runtime component in the world
+     * @param bOnlyStale only components whose existing BakedState is stale
+     * @return number of components baked
+     */
+    static int32 BakeWorld(UWorld* World, bool bOnlyStale);
+};
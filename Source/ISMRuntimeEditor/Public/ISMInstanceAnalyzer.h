@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UISMRuntimeComponent;
+
+/** Spatial index cost of one query radius, averaged over sampled instances */
+struct FISMQueryRadiusCost
+{
+    float Radius = 0.0f;
+
+    /** Cells in the query box, empty or not */
+    float AvgCellsOverlapped = 0.0f;
+
+    /** Non-empty cells in the query box */
+    float AvgOccupiedCells = 0.0f;
+
+    /** Instances in those cells: what the query tests before the exact distance check */
+    float AvgCandidates = 0.0f;
+};
+
+/** How one custom data slot is used across the component's instances */
+struct FISMCustomDataSlotUsage
+{
+    int32 Slot = 0;
+
+    /** Distinct values, counted up to FISMInstanceAnalyzer::MaxDistinctValues */
+    int32 NumDistinctValues = 0;
+
+    /** The schema maps this slot to a material parameter */
+    bool bMappedBySchema = false;
+};
+
+/** Result of FISMInstanceAnalyzer::Analyze */
+struct ISMRUNTIMEEDITOR_API FISMInstanceAnalysis
+{
+    FString ComponentName;
+    FString InstanceDataName;
+
+    int32 NumInstances = 0;
+    FBox Bounds = FBox(ForceInit);
+
+    /** GetMemoryStats of an initialized component, else an estimate from per-instance costs */
+    int64 RuntimeMemoryBytes = 0;
+    bool bMemoryMeasured = false;
+
+    /** Custom data held by the ISM itself, on top of RuntimeMemoryBytes */
+    int64 CustomDataBytes = 0;
+
+    // ===== Spatial Index =====
+
+    float CellSize = 0.0f;
+    int32 NumOccupiedCells = 0;
+    float AvgInstancesPerCell = 0.0f;
+    int32 MaxInstancesPerCell = 0;
+
+    /** Cell size holding about FISMInstanceAnalyzer::TargetInstancesPerCell instances at this density */
+    float RecommendedCellSize = 0.0f;
+
+    TArray<FISMQueryRadiusCost> QueryCosts;
+
+    // ===== Custom Data & Materials =====
+
+    int32 NumCustomDataFloats = 0;
+    TArray<FISMCustomDataSlotUsage> CustomDataSlots;
+
+    FName SchemaName = NAME_None;
+
+    /** Material slots converted actors get pooled DMIs for */
+    int32 NumDMISlots = 0;
+
+    /** Distinct shared pool signatures converting every instance would create */
+    int32 ExpectedDMISignatures = 0;
+
+    /** Project DefaultMaxSharedPoolSize; 0 is unlimited */
+    int32 ConfiguredMaxSharedPoolSize = 0;
+
+    /** What to change, most expensive first */
+    TArray<FString> Hints;
+
+    /** Multi-line report for the analyzer panel and the log */
+    FString ToString() const;
+};
+
+/**
+ * Editor-time cost analysis of a placed UISMRuntimeComponent and its UISMInstanceDataAsset, read
+ * from the ISM without initializing the component: instance count and memory, spatial index cell
+ * occupancy and query costs, custom data slot usage and the DMI pool signatures conversions would
+ * create. Lets expensive setups be caught in the level rather than in a profile.
+ */
+class ISMRUNTIMEEDITOR_API FISMInstanceAnalyzer
+{
+public:
+    /** Instances per cell RecommendedCellSize aims for */
+    static constexpr int32 TargetInstancesPerCell = 16;
+
+    /** Distinct values counted per custom data slot before counting stops */
+    static constexpr int32 MaxDistinctValues = 1024;
+
+    /** Instances sampled for query costs */
+    static constexpr int32 MaxQuerySamples = 64;
+
+    /** Query radii used when none are given: collector, interaction and explosion scale */
+    static TArray<float> GetDefaultQueryRadii();
+
+    static FISMInstanceAnalysis Analyze(const UISMRuntimeComponent* Component, TConstArrayView<float> QueryRadii);
+};
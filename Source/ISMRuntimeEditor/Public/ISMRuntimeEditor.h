@@ -2,9 +2,21 @@
 
 #include "Modules/ModuleManager.h"
 
+class UWorld;
+class FObjectPreSaveContext;
+
 class FISMRuntimeEditor : public IModuleInterface
 {
 public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+private:
+    /** Rebakes (or, when cooking, reports) stale runtime component bakes in a world being saved */
+    void HandlePreSaveWorld(UWorld* World, FObjectPreSaveContext SaveContext);
+
+    FDelegateHandle PreSaveWorldHandle;
+
+    /** Nomad tab hosting SISMInstanceAnalyzer, under Tools > Developer Tools */
+    static const FName InstanceAnalyzerTabName;
 };
@@ -0,0 +1,67 @@
+// ISMFeedbackComponentPool.cpp
+#include "ISMFeedbackComponentPool.h"
+#include "ISMRuntimeFeedbacks.h"
+
+USceneComponent* FISMFeedbackComponentPool::Acquire()
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedbacks);
+
+    while (Available.Num() > 0)
+    {
+        USceneComponent* Component = Available.Pop(EAllowShrinking::No);
+        
+        // Destroyed with its world or by outside code; forget it
+        if (IsValid(Component))
+        {
+            Active.Add(Component);
+            return Component;
+        }
+    }
+    return nullptr;
+}
+
+void FISMFeedbackComponentPool::AddActive(USceneComponent* Component)
+{
+    if (Component)
+    {
+        Active.Add(Component);
+        TotalCreated++;
+    }
+}
+
+bool FISMFeedbackComponentPool::Release(USceneComponent* Component)
+{
+    // Oldest first keeps GetOldestActive meaningful; pools are small so the shift is cheap
+    const int32 Index = Active.Find(Component);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    Active.RemoveAt(Index, 1, EAllowShrinking::No);
+    if (IsValid(Component))
+    {
+        Available.Add(Component);
+    }
+    return true;
+}
+
+void FISMFeedbackComponentPool::DestroyAll()
+{
+    for (TObjectPtr<USceneComponent>& Component : Available)
+    {
+        if (IsValid(Component))
+        {
+            Component->DestroyComponent();
+        }
+    }
+    for (TObjectPtr<USceneComponent>& Component : Active)
+    {
+        if (IsValid(Component))
+        {
+            Component->DestroyComponent();
+        }
+    }
+    Available.Reset();
+    Active.Reset();
+}
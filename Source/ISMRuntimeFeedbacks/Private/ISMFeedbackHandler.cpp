@@ -1,10 +1,16 @@
 // ISMFeedbackHandler.cpp
 #include "ISMFeedbackHandler.h"
+#include "ISMRuntimeFeedbacks.h"
+#include "ISMFeedbackProvider.h"
+#include "ISMFeedbackSettings.h"
+#include "Feedbacks/ISMFeedbackSubsystem.h"
 #include "Feedbacks/ISMFeedbackContext.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
 #include "Components/DecalComponent.h"
+#include "Components/AudioComponent.h"
 #include "Logging/LogMacros.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
@@ -13,14 +19,97 @@
 
 //DEFINE_LOG_CATEGORY_STATIC(LogTemp, Log, All);
 
+// ===== Base Handler =====
+
+bool UISMFeedbackHandler::ConsumeFeedbackBudget(UObject* WorldContext, EISMFeedbackBudgetCategory Category)
+{
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
+    UISMFeedbackProvider* Provider = GetFeedbackProvider(World);
+
+    // Handlers executed outside the provider (tools, tests) are not budgeted
+    return !Provider || Provider->TryConsumeBudget(Category);
+}
+
+UISMFeedbackProvider* UISMFeedbackHandler::GetFeedbackProvider(const UWorld* World)
+{
+    return World ? World->GetSubsystem<UISMFeedbackProvider>() : nullptr;
+}
+
+bool UISMFeedbackHandler::ExecuteProfiled(UISMFeedbackHandler* Handler, const FISMFeedbackContext& Context, UObject* WorldContext)
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Feedbacks);
+
+    if (!Handler)
+    {
+        return false;
+    }
+
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
+    UISMFeedbackSubsystem* FeedbackSubsystem = World ? World->GetSubsystem<UISMFeedbackSubsystem>() : nullptr;
+    if (!FeedbackSubsystem || !FeedbackSubsystem->bProfileFeedbackCosts)
+    {
+        return Handler->Execute(Context, WorldContext);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bResult = Handler->Execute(Context, WorldContext);
+    FeedbackSubsystem->RecordHandlerTiming(Handler->GetProfileName(), static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0));
+    return bResult;
+}
+
+FName UISMFeedbackHandler::GetProfileName() const
+{
+    if (CachedProfileName.IsNone())
+    {
+        CachedProfileName = FName(*GetPathName(GetOutermostObject()));
+    }
+    return CachedProfileName;
+}
+
+UObject* UISMFeedbackHandler::ResolveSoftAsset(const FSoftObjectPath& Path, UObject* WorldContext)
+{
+    if (Path.IsNull())
+    {
+        return nullptr;
+    }
+
+    if (UObject* Loaded = Path.ResolveObject())
+    {
+        return Loaded;
+    }
+
+    const UISMFeedbackSettings* Settings = UISMFeedbackSettings::Get();
+    if (Settings && Settings->bSkipUnloadedAssets)
+    {
+        UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
+        if (UISMFeedbackProvider* Provider = GetFeedbackProvider(World))
+        {
+            Provider->RequestAssetLoad(Path);
+            return nullptr;
+        }
+    }
+
+    return Path.TryLoad();
+}
+
 // ===== Leaf Handler: Audio =====
 
 bool UISMFeedbackHandler_Audio::Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext)
 {
+    if (!ConsumeFeedbackBudget(WorldContext, EISMFeedbackBudgetCategory::Audio))
+    {
+        return false;
+    }
+
     // Load sound if needed
-    USoundBase* LoadedSound = Sound.LoadSynchronous();
+    USoundBase* LoadedSound = Cast<USoundBase>(ResolveSoftAsset(Sound.ToSoftObjectPath(), WorldContext));
     if (!LoadedSound)
     {
+        if (!Sound.IsNull())
+        {
+            // Still streaming in
+            return false;
+        }
         UE_LOG(LogTemp, Warning, TEXT("Audio Handler: Sound not set or failed to load"));
         return false;
     }
@@ -46,6 +135,20 @@ bool UISMFeedbackHandler_Audio::Execute_Implementation(const FISMFeedbackContext
     //    FinalPitch *= Context.Scale;
     //}
 
+    // Play on a pooled component when available
+    if (UISMFeedbackProvider* Provider = GetFeedbackProvider(World))
+    {
+        if (UAudioComponent* AudioComp = Provider->AcquireAudioComponent(LoadedSound))
+        {
+            AudioComp->SetWorldLocation(Context.Location);
+            AudioComp->AttenuationSettings = AttenuationSettings;
+            AudioComp->SetVolumeMultiplier(FinalVolume);
+            AudioComp->SetPitchMultiplier(FinalPitch);
+            AudioComp->Play(0.0f);
+            return true;
+        }
+    }
+
     // Play sound
     UGameplayStatics::PlaySoundAtLocation(
         World,
@@ -68,14 +171,32 @@ void UISMFeedbackHandler_Audio::PreloadAssets_Implementation()
     }
 }
 
+void UISMFeedbackHandler_Audio::GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+    if (!Sound.IsNull())
+    {
+        OutAssets.Add(Sound.ToSoftObjectPath());
+    }
+}
+
 // ===== Leaf Handler: Niagara =====
 
 bool UISMFeedbackHandler_Niagara::Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext)
 {
+    if (!ConsumeFeedbackBudget(WorldContext, EISMFeedbackBudgetCategory::Niagara))
+    {
+        return false;
+    }
+
     // Load system if needed
-    UNiagaraSystem* LoadedSystem = System.LoadSynchronous();
+    UNiagaraSystem* LoadedSystem = Cast<UNiagaraSystem>(ResolveSoftAsset(System.ToSoftObjectPath(), WorldContext));
     if (!LoadedSystem)
     {
+        if (!System.IsNull())
+        {
+            // Still streaming in
+            return false;
+        }
         UE_LOG(LogTemp, Warning, TEXT("Niagara Handler: System not set or failed to load"));
         return false;
     }
@@ -97,15 +218,33 @@ bool UISMFeedbackHandler_Niagara::Execute_Implementation(const FISMFeedbackConte
     // Calculate scale
     FVector SpawnScale = FVector(Context.Scale * ScaleMultiplier);
 
+    // Pooled components go back when the system finishes, which is what auto-destroy asked for;
+    // persistent systems stay caller-owned
+    UNiagaraComponent* NiagaraComp = nullptr;
+    UISMFeedbackProvider* Provider = bAutoDestroy ? GetFeedbackProvider(World) : nullptr;
+    if (Provider)
+    {
+        NiagaraComp = Provider->AcquireNiagaraComponent(LoadedSystem);
+        if (NiagaraComp)
+        {
+            NiagaraComp->SetWorldLocationAndRotation(Context.Location, SpawnRotation);
+            NiagaraComp->SetWorldScale3D(SpawnScale);
+        }
+    }
+
     // Spawn system
-    UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-        World,
-        LoadedSystem,
-        Context.Location,
-        SpawnRotation,
-        SpawnScale,
-        bAutoDestroy
-    );
+    const bool bPooled = NiagaraComp != nullptr;
+    if (!NiagaraComp)
+    {
+        NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+            World,
+            LoadedSystem,
+            Context.Location,
+            SpawnRotation,
+            SpawnScale,
+            bAutoDestroy
+        );
+    }
 
     if (!NiagaraComp)
     {
@@ -122,6 +261,11 @@ bool UISMFeedbackHandler_Niagara::Execute_Implementation(const FISMFeedbackConte
         NiagaraComp->SetVectorParameter(TEXT("User.Normal"), Context.Normal);
     }
 
+    if (bPooled)
+    {
+        NiagaraComp->Activate(true);
+    }
+
     return true;
 }
 
@@ -133,10 +277,166 @@ void UISMFeedbackHandler_Niagara::PreloadAssets_Implementation()
     }
 }
 
+void UISMFeedbackHandler_Niagara::GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+    if (!System.IsNull())
+    {
+        OutAssets.Add(System.ToSoftObjectPath());
+    }
+}
+
+// ===== Leaf Handler: Batched Niagara =====
+
+bool UISMFeedbackHandler_NiagaraBatched::Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext)
+{
+    // One upload per request regardless of instance count
+    if (!ConsumeFeedbackBudget(WorldContext, EISMFeedbackBudgetCategory::Niagara))
+    {
+        return false;
+    }
+
+    UNiagaraSystem* LoadedSystem = Cast<UNiagaraSystem>(ResolveSoftAsset(System.ToSoftObjectPath(), WorldContext));
+    if (!LoadedSystem)
+    {
+        if (!System.IsNull())
+        {
+            // Still streaming in
+            return false;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("Batched Niagara Handler: System not set or failed to load"));
+        return false;
+    }
+
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+    if (!World)
+    {
+        return false;
+    }
+
+    FBatchState& State = BatchStates.FindOrAdd(TObjectKey<UWorld>(World));
+    UNiagaraComponent* NiagaraComp = GetPersistentComponent(World, LoadedSystem, State);
+    if (!NiagaraComp)
+    {
+        return false;
+    }
+
+    // New frame: the system consumed last frame's entries
+    if (State.Frame != GFrameCounter)
+    {
+        State.Frame = GFrameCounter;
+        State.Positions.Reset();
+        State.Rotations.Reset();
+        State.Scales.Reset();
+        State.Intensities.Reset();
+    }
+
+    const int32 Capacity = MaxEntriesPerFrame > 0 ? MaxEntriesPerFrame - State.Positions.Num() : MAX_int32;
+    if (Capacity <= 0)
+    {
+        return false;
+    }
+
+    auto AddEntry = [&State, &Context](const FTransform& Transform)
+    {
+        State.Positions.Add(Transform.GetLocation());
+        State.Rotations.Add(Transform.GetRotation());
+        State.Scales.Add(Transform.GetScale3D());
+        State.Intensities.Add(Context.Intensity);
+    };
+
+    if (Context.IsBatched())
+    {
+        const TArray<FTransform> Transforms = Context.GetTransformsForBatchedInstances();
+        const int32 NumToAdd = FMath::Min(Transforms.Num(), Capacity);
+        for (int32 i = 0; i < NumToAdd; i++)
+        {
+            AddEntry(Transforms[i]);
+        }
+    }
+    else
+    {
+        AddEntry(FTransform(Context.Rotation, Context.Location, FVector(Context.Scale)));
+    }
+
+    if (!PositionsParameter.IsNone())
+    {
+        UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayPosition(NiagaraComp, PositionsParameter, State.Positions);
+    }
+    if (!RotationsParameter.IsNone())
+    {
+        UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayQuat(NiagaraComp, RotationsParameter, State.Rotations);
+    }
+    if (!ScalesParameter.IsNone())
+    {
+        UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(NiagaraComp, ScalesParameter, State.Scales);
+    }
+    if (!IntensitiesParameter.IsNone())
+    {
+        UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(NiagaraComp, IntensitiesParameter, State.Intensities);
+    }
+    if (!CountParameter.IsNone())
+    {
+        NiagaraComp->SetIntParameter(CountParameter, State.Positions.Num());
+    }
+    if (!SerialParameter.IsNone())
+    {
+        NiagaraComp->SetIntParameter(SerialParameter, ++State.Serial);
+    }
+
+    return true;
+}
+
+void UISMFeedbackHandler_NiagaraBatched::PreloadAssets_Implementation()
+{
+    if (!System.IsNull())
+    {
+        System.LoadSynchronous();
+    }
+}
+
+void UISMFeedbackHandler_NiagaraBatched::GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+    if (!System.IsNull())
+    {
+        OutAssets.Add(System.ToSoftObjectPath());
+    }
+}
+
+UNiagaraComponent* UISMFeedbackHandler_NiagaraBatched::GetPersistentComponent(UWorld* World, UNiagaraSystem* LoadedSystem, FBatchState& State) const
+{
+    if (UNiagaraComponent* Existing = State.Component.Get())
+    {
+        if (Existing->GetAsset() == LoadedSystem)
+        {
+            return Existing;
+        }
+        Existing->DestroyComponent();
+    }
+
+    // World-space system at the origin; every entry carries its own world transform
+    UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+        World,
+        LoadedSystem,
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        FVector::OneVector,
+        false // Persistent
+    );
+
+    State.Component = NiagaraComp;
+    State.Frame = 0;
+    return NiagaraComp;
+}
+
 // ===== Leaf Handler: Decal =====
 
 bool UISMFeedbackHandler_Decal::Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext)
 {
+    if (!ConsumeFeedbackBudget(WorldContext, EISMFeedbackBudgetCategory::Decal))
+    {
+        return false;
+    }
+
     if (!DecalMaterial)
     {
         UE_LOG(LogTemp, Warning, TEXT("Decal Handler: DecalMaterial not set"));
@@ -158,6 +458,21 @@ bool UISMFeedbackHandler_Decal::Execute_Implementation(const FISMFeedbackContext
     }
     DecalSize *= Context.Scale;
 
+    // Timed decals come from the pool; permanent ones (Duration <= 0) are spawned and kept
+    if (Duration > 0.0f)
+    {
+        if (UISMFeedbackProvider* Provider = GetFeedbackProvider(World))
+        {
+            if (UDecalComponent* PooledDecal = Provider->AcquireDecalComponent(DecalMaterial, Duration))
+            {
+                PooledDecal->DecalSize = DecalSize;
+                PooledDecal->SetWorldLocationAndRotation(Context.Location, Context.Normal.Rotation());
+                PooledDecal->MarkRenderStateDirty();
+                return true;
+            }
+        }
+    }
+
     // Spawn decal
     UDecalComponent* Decal = UGameplayStatics::SpawnDecalAtLocation(
         World,
@@ -233,11 +548,12 @@ bool UISMFeedbackHandler_Debug::Execute_Implementation(const FISMFeedbackContext
 
 bool UISMFeedbackMatcherHandler::Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext)
 {
-    // 1. Derive tag from context (implemented by subclasses)
-    FGameplayTag DerivedTag = DeriveTag(Context);
+    EnsureLookupTables();
 
-    // 2. Find handler for derived tag
-    UISMFeedbackHandler* Handler = FindHandlerForTag(DerivedTag);
+    // 1-2. Derive tag from context and find its handler (subclasses may shortcut both)
+    const FMatchedHandler Match = MatchHandler(Context);
+    const FGameplayTag DerivedTag = Match.Tag;
+    UISMFeedbackHandler* Handler = Match.Handler;
 
     // 3. If not found, use default handler
     if (!Handler)
@@ -248,7 +564,7 @@ bool UISMFeedbackMatcherHandler::Execute_Implementation(const FISMFeedbackContex
     // 4. Execute handler if found
     if (Handler)
     {
-        return Handler->Execute(Context, WorldContext);
+        return ExecuteProfiled(Handler, Context, WorldContext);
     }
 
     // No handler found
@@ -278,23 +594,87 @@ void UISMFeedbackMatcherHandler::PreloadAssets_Implementation()
     }
 }
 
-UISMFeedbackHandler* UISMFeedbackMatcherHandler::FindHandlerForTag(FGameplayTag DerivedTag) const
+void UISMFeedbackMatcherHandler::GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const
 {
-    if (!DerivedTag.IsValid())
+    for (const FTagHandlerMatchEntry& Entry : HandlerDB)
     {
-        return nullptr;
+        if (Entry.Handler)
+        {
+            Entry.Handler->GatherSoftAssets(OutAssets);
+        }
+    }
+
+    if (DefaultHandler)
+    {
+        DefaultHandler->GatherSoftAssets(OutAssets);
     }
+}
+
+void UISMFeedbackMatcherHandler::PostLoad()
+{
+    Super::PostLoad();
+    RebuildLookupTables();
+}
 
-    // Search HandlerDB for matching tag
+#if WITH_EDITOR
+void UISMFeedbackMatcherHandler::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    bLookupTablesBuilt = false;
+}
+#endif
+
+void UISMFeedbackMatcherHandler::RebuildLookupTables()
+{
+    // Set first: subclass tables resolve handlers through FindHandlerForTag
+    bLookupTablesBuilt = true;
+    BuildLookupTables();
+}
+
+void UISMFeedbackMatcherHandler::EnsureLookupTables() const
+{
+    if (!bLookupTablesBuilt)
+    {
+        const_cast<UISMFeedbackMatcherHandler*>(this)->RebuildLookupTables();
+    }
+}
+
+void UISMFeedbackMatcherHandler::BuildLookupTables()
+{
+    HandlerLookup.Reset();
+    HandlerLookup.Reserve(HandlerDB.Num());
     for (const FTagHandlerMatchEntry& Entry : HandlerDB)
     {
-        if (Entry.Tag == DerivedTag)
+        if (Entry.Tag.IsValid() && !HandlerLookup.Contains(Entry.Tag))
         {
-            return Entry.Handler;
+            HandlerLookup.Add(Entry.Tag, Entry.Handler);
         }
     }
+}
+
+bool UISMFeedbackMatcherHandler::UsesNativeDeriveTag() const
+{
+    return !GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UISMFeedbackMatcherHandler, DeriveTag));
+}
+
+UISMFeedbackMatcherHandler::FMatchedHandler UISMFeedbackMatcherHandler::MatchHandler(const FISMFeedbackContext& Context) const
+{
+    FMatchedHandler Match;
+    Match.Tag = DeriveTag(Context);
+    Match.Handler = FindHandlerForTag(Match.Tag);
+    return Match;
+}
+
+UISMFeedbackHandler* UISMFeedbackMatcherHandler::FindHandlerForTag(FGameplayTag DerivedTag) const
+{
+    if (!DerivedTag.IsValid())
+    {
+        return nullptr;
+    }
 
-    return nullptr;
+    EnsureLookupTables();
+    UISMFeedbackHandler* const* Found = HandlerLookup.Find(DerivedTag);
+    return Found ? *Found : nullptr;
 }
 
 // ===== Concrete Matcher: Surface =====
@@ -334,6 +714,45 @@ FGameplayTag UISMFeedbackSurfaceMatcherHandler::DeriveTag_Implementation(const F
     return FGameplayTag();
 }
 
+void UISMFeedbackSurfaceMatcherHandler::BuildLookupTables()
+{
+    Super::BuildLookupTables();
+
+    SurfaceHandlers.Reset();
+    SurfaceHandlers.SetNum(SurfaceType_Max);
+    for (const TPair<TEnumAsByte<EPhysicalSurface>, FGameplayTag>& Pair : SurfaceToTagMap)
+    {
+        const int32 Index = static_cast<int32>(Pair.Key.GetValue());
+        if (SurfaceHandlers.IsValidIndex(Index) && Pair.Value.IsValid())
+        {
+            SurfaceHandlers[Index].Tag = Pair.Value;
+            SurfaceHandlers[Index].Handler = FindHandlerForTag(Pair.Value);
+        }
+    }
+}
+
+UISMFeedbackMatcherHandler::FMatchedHandler UISMFeedbackSurfaceMatcherHandler::MatchHandler(const FISMFeedbackContext& Context) const
+{
+    // A Blueprint DeriveTag may not map surfaces the way the table does
+    if (!UsesNativeDeriveTag())
+    {
+        return Super::MatchHandler(Context);
+    }
+
+    const UPhysicalMaterial* PhysMat = Context.PhysicalMaterial.Get();
+    if (!PhysMat)
+    {
+        PhysMat = Context.Subject.ParticipantPhysicalMaterial.Get();
+    }
+    if (!PhysMat)
+    {
+        return FMatchedHandler();
+    }
+
+    const int32 Index = static_cast<int32>(PhysMat->SurfaceType.GetValue());
+    return SurfaceHandlers.IsValidIndex(Index) ? SurfaceHandlers[Index] : FMatchedHandler();
+}
+
 // ===== Concrete Matcher: Intensity =====
 
 FGameplayTag UISMFeedbackIntensityMatcherHandler::DeriveTag_Implementation(const FISMFeedbackContext& Context) const
@@ -367,4 +786,75 @@ FGameplayTag UISMFeedbackIntensityMatcherHandler::DeriveTag_Implementation(const
         Intensity);
 
     return FGameplayTag();
+}
+
+void UISMFeedbackIntensityMatcherHandler::BuildLookupTables()
+{
+    Super::BuildLookupTables();
+
+    SortedThresholds.Reset(IntensityThresholds.Num());
+    for (const TPair<float, FGameplayTag>& Pair : IntensityThresholds)
+    {
+        FThresholdEntry& Entry = SortedThresholds.AddDefaulted_GetRef();
+        Entry.Threshold = Pair.Key;
+        Entry.Match.Tag = Pair.Value;
+        Entry.Match.Handler = FindHandlerForTag(Pair.Value);
+    }
+    SortedThresholds.Sort([](const FThresholdEntry& A, const FThresholdEntry& B) { return A.Threshold < B.Threshold; });
+
+    BucketStart.Reset();
+    BucketScale = 0.0f;
+    if (SortedThresholds.Num() < 2)
+    {
+        return;
+    }
+
+    const float Lowest = SortedThresholds[0].Threshold;
+    const float Range = SortedThresholds.Last().Threshold - Lowest;
+    BucketScale = Range > UE_KINDA_SMALL_NUMBER ? NumIntensityBuckets / Range : 0.0f;
+
+    BucketStart.SetNumUninitialized(NumIntensityBuckets);
+    int32 Index = 0;
+    for (int32 Bucket = 0; Bucket < NumIntensityBuckets; ++Bucket)
+    {
+        const float BucketLow = BucketScale > 0.0f ? Lowest + Bucket / BucketScale : Lowest;
+        while (Index + 1 < SortedThresholds.Num() && SortedThresholds[Index + 1].Threshold <= BucketLow)
+        {
+            ++Index;
+        }
+        BucketStart[Bucket] = Index;
+    }
+}
+
+int32 UISMFeedbackIntensityMatcherHandler::FindThresholdIndex(float Intensity) const
+{
+    if (SortedThresholds.Num() == 0 || Intensity < SortedThresholds[0].Threshold)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Index = 0;
+    if (BucketStart.Num() > 0)
+    {
+        const int32 Bucket = FMath::Clamp(FMath::FloorToInt32((Intensity - SortedThresholds[0].Threshold) * BucketScale), 0, NumIntensityBuckets - 1);
+        Index = BucketStart[Bucket];
+    }
+
+    // Thresholds closer together than a bucket are resolved by stepping forward
+    while (Index + 1 < SortedThresholds.Num() && Intensity >= SortedThresholds[Index + 1].Threshold)
+    {
+        ++Index;
+    }
+    return Index;
+}
+
+UISMFeedbackMatcherHandler::FMatchedHandler UISMFeedbackIntensityMatcherHandler::MatchHandler(const FISMFeedbackContext& Context) const
+{
+    if (!UsesNativeDeriveTag())
+    {
+        return Super::MatchHandler(Context);
+    }
+
+    const int32 Index = FindThresholdIndex(Context.Intensity);
+    return SortedThresholds.IsValidIndex(Index) ? SortedThresholds[Index].Match : FMatchedHandler();
 }
\ No newline at end of file
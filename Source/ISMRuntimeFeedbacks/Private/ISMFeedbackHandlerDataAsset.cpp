@@ -59,7 +59,7 @@ bool UISMFeedbackHandlerDataAsset::ExecuteFeedback(
     }
 
     // Execute handler
-    return Handler->Execute(Context, WorldContext);
+    return UISMFeedbackHandler::ExecuteProfiled(Handler, Context, WorldContext);
 }
 
 void UISMFeedbackHandlerDataAsset::PreloadAllHandlers()
@@ -91,6 +91,14 @@ void UISMFeedbackHandlerDataAsset::PreloadAllHandlers()
 
 
 
+void UISMFeedbackHandlerDataAsset::GatherSoftAssetsForTag(FGameplayTag FeedbackTag, TArray<FSoftObjectPath>& OutAssets) const
+{
+    if (const UISMFeedbackHandler* Handler = FindHandler(FeedbackTag))
+    {
+        Handler->GatherSoftAssets(OutAssets);
+    }
+}
+
 // ===== Composite Handler: Multi Handler =====
 
 bool UISMFeedbackMultiHandler::Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext)
@@ -108,7 +116,7 @@ bool UISMFeedbackMultiHandler::Execute_Implementation(const FISMFeedbackContext&
     {
         if (Handler)
         {
-            bool bSuccess = Handler->Execute(Context, WorldContext);
+            bool bSuccess = ExecuteProfiled(Handler, Context, WorldContext);
             bAnySuccess = bAnySuccess || bSuccess;
         }
     }
@@ -126,4 +134,15 @@ void UISMFeedbackMultiHandler::PreloadAssets_Implementation()
             Handler->PreloadAssets();
         }
     }
-}
\ No newline at end of file
+}
+
+void UISMFeedbackMultiHandler::GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+    for (const UISMFeedbackHandler* Handler : Handlers)
+    {
+        if (Handler)
+        {
+            Handler->GatherSoftAssets(OutAssets);
+        }
+    }
+}
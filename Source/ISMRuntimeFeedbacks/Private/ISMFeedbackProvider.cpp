@@ -3,6 +3,10 @@
 #include "ISMFeedbackSettings.h"
 #include "Feedbacks/ISMFeedbackSubsystem.h"  // Note: Feedbacks subfolder
 #include "Engine/World.h"
+#include "TimerManager.h"
+#include "Components/AudioComponent.h"
+#include "Components/DecalComponent.h"
+#include "NiagaraComponent.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogISMFeedbackProvider, Log, All);
 
@@ -33,6 +37,9 @@ void UISMFeedbackProvider::Deinitialize()
     // Unregister from feedback subsystem
     UnregisterFromFeedbackSubsystem();
     
+    DestroyComponentPools();
+    ReleaseAssetLoadHandles();
+    
     // Clear database reference
     LoadedDatabase = nullptr;
     
@@ -79,7 +86,7 @@ bool UISMFeedbackProvider::HandleFeedback_Implementation(const FISMFeedbackConte
     }
     
     // Execute handler
-    bool bSuccess = Handler->Execute(Context, GetWorld());
+    bool bSuccess = UISMFeedbackHandler::ExecuteProfiled(Handler, Context, GetWorld());
     
     if (Settings && Settings->bEnableDebugLogging)
     {
@@ -127,6 +134,13 @@ void UISMFeedbackProvider::ReloadDatabase()
 {
     UE_LOG(LogISMFeedbackProvider, Log, TEXT("Reloading handler database..."));
     LoadDatabaseFromSettings();
+    
+    // Handler assets may have changed; stream the new ones for tags already in use
+    ReleaseAssetLoadHandles();
+    if (UISMFeedbackSubsystem* FeedbackSubsystem = CachedFeedbackSubsystem.Get())
+    {
+        StreamAssetsForTags(FeedbackSubsystem->GetRelevantFeedbackTags());
+    }
 }
 
 void UISMFeedbackProvider::PreloadAllAssets()
@@ -141,6 +155,345 @@ void UISMFeedbackProvider::PreloadAllAssets()
     LoadedDatabase->PreloadAllHandlers();
 }
 
+// ===== Streaming =====
+
+void UISMFeedbackProvider::OnFeedbackTagsRelevant_Implementation(const FGameplayTagContainer& FeedbackTags)
+{
+    const UISMFeedbackSettings* Settings = UISMFeedbackSettings::Get();
+    if (Settings && Settings->bStreamAssetsOnRelevance)
+    {
+        StreamAssetsForTags(FeedbackTags);
+    }
+}
+
+void UISMFeedbackProvider::StreamAssetsForTags(const FGameplayTagContainer& Tags)
+{
+    if (!LoadedDatabase)
+    {
+        return;
+    }
+    
+    const UISMFeedbackSettings* Settings = UISMFeedbackSettings::Get();
+    const int32 Priority = Settings ? Settings->AsyncLoadPriority : FStreamableManager::DefaultAsyncLoadPriority;
+    
+    TArray<FSoftObjectPath> Paths;
+    for (const FGameplayTag& Tag : Tags)
+    {
+        if (TagLoadHandles.Contains(Tag))
+        {
+            continue;
+        }
+        
+        Paths.Reset();
+        LoadedDatabase->GatherSoftAssetsForTag(Tag, Paths);
+        Paths.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull() || Path.ResolveObject() != nullptr; });
+        if (Paths.Num() == 0)
+        {
+            // Nothing to stream, but don't gather again
+            TagLoadHandles.Add(Tag, nullptr);
+            continue;
+        }
+        
+        TagLoadHandles.Add(Tag, StreamableManager.RequestAsyncLoad(MoveTemp(Paths), FStreamableDelegate(), Priority));
+    }
+}
+
+void UISMFeedbackProvider::RequestAssetLoad(const FSoftObjectPath& Path)
+{
+    if (Path.IsNull() || AssetLoadHandles.Contains(Path) || Path.ResolveObject())
+    {
+        return;
+    }
+    
+    const UISMFeedbackSettings* Settings = UISMFeedbackSettings::Get();
+    const int32 Priority = Settings ? Settings->AsyncLoadPriority : FStreamableManager::DefaultAsyncLoadPriority;
+    AssetLoadHandles.Add(Path, StreamableManager.RequestAsyncLoad(Path, FStreamableDelegate(), Priority));
+}
+
+int32 UISMFeedbackProvider::GetNumPendingAssetLoads() const
+{
+    int32 Count = 0;
+    for (const TPair<FGameplayTag, TSharedPtr<FStreamableHandle>>& Pair : TagLoadHandles)
+    {
+        Count += (Pair.Value.IsValid() && Pair.Value->IsLoadingInProgress()) ? 1 : 0;
+    }
+    for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : AssetLoadHandles)
+    {
+        Count += (Pair.Value.IsValid() && Pair.Value->IsLoadingInProgress()) ? 1 : 0;
+    }
+    return Count;
+}
+
+void UISMFeedbackProvider::ReleaseAssetLoadHandles()
+{
+    for (TPair<FGameplayTag, TSharedPtr<FStreamableHandle>>& Pair : TagLoadHandles)
+    {
+        if (Pair.Value.IsValid())
+        {
+            Pair.Value->ReleaseHandle();
+        }
+    }
+    for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : AssetLoadHandles)
+    {
+        if (Pair.Value.IsValid())
+        {
+            Pair.Value->ReleaseHandle();
+        }
+    }
+    TagLoadHandles.Reset();
+    AssetLoadHandles.Reset();
+}
+
+// ===== Budgets =====
+
+bool UISMFeedbackProvider::TryConsumeBudget(EISMFeedbackBudgetCategory Category)
+{
+    if (BudgetFrame != GFrameCounter)
+    {
+        BudgetFrame = GFrameCounter;
+        FMemory::Memzero(BudgetUsed);
+    }
+    
+    const UISMFeedbackSettings* Settings = UISMFeedbackSettings::Get();
+    const int32 Limit = Settings ? Settings->GetBudgetLimit(Category) : -1;
+    int32& Used = BudgetUsed[static_cast<int32>(Category)];
+    
+    if (Limit >= 0 && Used >= Limit)
+    {
+        BudgetRejections++;
+        return false;
+    }
+    
+    Used++;
+    return true;
+}
+
+// ===== Component Pools =====
+
+UAudioComponent* UISMFeedbackProvider::AcquireAudioComponent(USoundBase* Sound)
+{
+    if (!Sound)
+    {
+        return nullptr;
+    }
+    
+    return Cast<UAudioComponent>(AcquirePooledComponent(Sound, [this, Sound](AActor* Owner) -> USceneComponent*
+    {
+        UAudioComponent* AudioComp = NewObject<UAudioComponent>(Owner);
+        AudioComp->bAutoActivate = false;
+        AudioComp->bAutoDestroy = false;
+        AudioComp->bStopWhenOwnerDestroyed = true;
+        AudioComp->SetSound(Sound);
+        AudioComp->OnAudioFinishedNative.AddUObject(this, &UISMFeedbackProvider::OnPooledAudioFinished);
+        AudioComp->RegisterComponent();
+        return AudioComp;
+    }));
+}
+
+UNiagaraComponent* UISMFeedbackProvider::AcquireNiagaraComponent(UNiagaraSystem* System)
+{
+    if (!System)
+    {
+        return nullptr;
+    }
+    
+    return Cast<UNiagaraComponent>(AcquirePooledComponent(System, [this, System](AActor* Owner) -> USceneComponent*
+    {
+        UNiagaraComponent* NiagaraComp = NewObject<UNiagaraComponent>(Owner);
+        NiagaraComp->SetAutoActivate(false);
+        NiagaraComp->SetAutoDestroy(false);
+        NiagaraComp->SetAsset(System);
+        NiagaraComp->OnSystemFinished.AddDynamic(this, &UISMFeedbackProvider::OnPooledNiagaraFinished);
+        NiagaraComp->RegisterComponent();
+        return NiagaraComp;
+    }));
+}
+
+UDecalComponent* UISMFeedbackProvider::AcquireDecalComponent(UMaterialInterface* Material, float LifeSpan)
+{
+    if (!Material)
+    {
+        return nullptr;
+    }
+    
+    UDecalComponent* Decal = Cast<UDecalComponent>(AcquirePooledComponent(Material, [Material](AActor* Owner) -> USceneComponent*
+    {
+        UDecalComponent* DecalComp = NewObject<UDecalComponent>(Owner);
+        DecalComp->SetDecalMaterial(Material);
+        DecalComp->SetVisibility(false);
+        DecalComp->RegisterComponent();
+        return DecalComp;
+    }));
+    
+    UWorld* World = GetWorld();
+    const FPooledComponentLease* Lease = Decal ? ActiveLeases.Find(Decal) : nullptr;
+    if (!Lease || !World)
+    {
+        return Decal;
+    }
+    
+    // Decals don't report finishing; hand it back after its lifetime unless it was recycled meanwhile
+    Decal->SetVisibility(true);
+    FTimerHandle Handle;
+    World->GetTimerManager().SetTimer(Handle, FTimerDelegate::CreateWeakLambda(this,
+        [this, WeakDecal = TWeakObjectPtr<UDecalComponent>(Decal), Serial = Lease->Serial]()
+        {
+            if (UDecalComponent* Expired = WeakDecal.Get())
+            {
+                ReleasePooledComponent(Expired, Serial);
+            }
+        }), FMath::Max(LifeSpan, UE_KINDA_SMALL_NUMBER), false);
+    
+    return Decal;
+}
+
+int32 UISMFeedbackProvider::GetNumPooledComponents() const
+{
+    int32 Total = 0;
+    for (const TPair<TObjectPtr<UObject>, FISMFeedbackComponentPool>& Pair : ComponentPools)
+    {
+        Total += Pair.Value.Num();
+    }
+    return Total;
+}
+
+USceneComponent* UISMFeedbackProvider::AcquirePooledComponent(UObject* Asset, TFunctionRef<USceneComponent*(AActor*)> CreateComponent)
+{
+    const UISMFeedbackSettings* Settings = UISMFeedbackSettings::Get();
+    if (!Settings || !Settings->bPoolFeedbackComponents)
+    {
+        return nullptr;
+    }
+    
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+    
+    if (!IsValid(PoolActor))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        PoolActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!PoolActor)
+        {
+            return nullptr;
+        }
+        
+        USceneComponent* Root = NewObject<USceneComponent>(PoolActor);
+        PoolActor->SetRootComponent(Root);
+        Root->RegisterComponent();
+    }
+    
+    FISMFeedbackComponentPool* Pool = ComponentPools.Find(Asset);
+    if (!Pool)
+    {
+        Pool = &ComponentPools.Add(Asset);
+        
+        // Prewarm the rest of the initial set; one more is created below for this request
+        for (int32 i = 1; i < Settings->PrewarmComponentsPerAsset; i++)
+        {
+            if (USceneComponent* Created = CreateComponent(PoolActor))
+            {
+                Pool->AddActive(Created);
+                Pool->Release(Created);
+            }
+        }
+    }
+    
+    USceneComponent* Component = Pool->Acquire();
+    if (!Component && Pool->Num() >= Settings->MaxComponentsPerAsset)
+    {
+        // Full: cut the oldest effect short rather than grow without bound
+        if (USceneComponent* Oldest = Pool->GetOldestActive())
+        {
+            Pool->StealCount++;
+            StopPooledComponent(Oldest);
+            ReleasePooledComponent(Oldest);
+            
+            // Releasing may have reshaped the map if a finish callback ran; look the pool up again
+            Pool = ComponentPools.Find(Asset);
+            Component = Pool ? Pool->Acquire() : nullptr;
+        }
+    }
+    
+    if (!Component && Pool)
+    {
+        Component = CreateComponent(PoolActor);
+        Pool->AddActive(Component);
+    }
+    
+    if (Component)
+    {
+        FPooledComponentLease& Lease = ActiveLeases.Add(Component);
+        Lease.Asset = Asset;
+        Lease.Serial = NextLeaseSerial++;
+    }
+    return Component;
+}
+
+void UISMFeedbackProvider::ReleasePooledComponent(USceneComponent* Component, uint32 Serial)
+{
+    const FPooledComponentLease* Lease = ActiveLeases.Find(Component);
+    if (!Lease || (Serial != 0 && Lease->Serial != Serial))
+    {
+        return;
+    }
+    
+    UObject* Asset = Lease->Asset.ResolveObjectPtr();
+    ActiveLeases.Remove(Component);
+    
+    if (UDecalComponent* Decal = Cast<UDecalComponent>(Component))
+    {
+        Decal->SetVisibility(false);
+    }
+    
+    if (FISMFeedbackComponentPool* Pool = Asset ? ComponentPools.Find(Asset) : nullptr)
+    {
+        Pool->Release(Component);
+    }
+}
+
+void UISMFeedbackProvider::StopPooledComponent(USceneComponent* Component)
+{
+    if (UAudioComponent* AudioComp = Cast<UAudioComponent>(Component))
+    {
+        AudioComp->Stop();
+    }
+    else if (UNiagaraComponent* NiagaraComp = Cast<UNiagaraComponent>(Component))
+    {
+        NiagaraComp->DeactivateImmediate();
+    }
+}
+
+void UISMFeedbackProvider::OnPooledNiagaraFinished(UNiagaraComponent* Component)
+{
+    ReleasePooledComponent(Component);
+}
+
+void UISMFeedbackProvider::OnPooledAudioFinished(UAudioComponent* Component)
+{
+    ReleasePooledComponent(Component);
+}
+
+void UISMFeedbackProvider::DestroyComponentPools()
+{
+    ActiveLeases.Reset();
+    for (TPair<TObjectPtr<UObject>, FISMFeedbackComponentPool>& Pair : ComponentPools)
+    {
+        Pair.Value.DestroyAll();
+    }
+    ComponentPools.Reset();
+    
+    if (IsValid(PoolActor))
+    {
+        PoolActor->Destroy();
+    }
+    PoolActor = nullptr;
+}
+
 // ===== Helper Methods =====
 
 void UISMFeedbackProvider::LoadDatabaseFromSettings()
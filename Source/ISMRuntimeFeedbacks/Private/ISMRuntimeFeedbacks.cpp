@@ -1,5 +1,7 @@
 #include "ISMRuntimeFeedbacks.h"
 
+LLM_DEFINE_TAG(ISMRuntime_Feedbacks);
+
 #define LOCTEXT_NAMESPACE "FISMRuntimeFeedbacksModule"
 
 void FISMRuntimeFeedbacks::StartupModule()
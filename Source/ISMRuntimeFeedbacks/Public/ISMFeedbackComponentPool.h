@@ -0,0 +1,57 @@
+// ISMFeedbackComponentPool.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "ISMFeedbackComponentPool.generated.h"
+
+/**
+ * Pool of feedback components (audio, Niagara or decal) for a single asset.
+ * 
+ * Owned by UISMFeedbackProvider, one per world, keyed by the sound, system or decal material.
+ * Leaf handlers take a component, configure and play it, and the provider puts it back when
+ * the component reports it has finished - so combat feedback reuses a handful of registered
+ * components instead of creating and garbage collecting one per hit.
+ * 
+ * The pool only tracks membership; creating, resetting and stopping components is the
+ * provider's job since it differs per component type.
+ * 
+ * Thread Safety: Game thread only.
+ */
+USTRUCT()
+struct ISMRUNTIMEFEEDBACKS_API FISMFeedbackComponentPool
+{
+    GENERATED_BODY()
+    
+    /** Idle components ready to be handed out */
+    UPROPERTY()
+    TArray<TObjectPtr<USceneComponent>> Available;
+    
+    /** Components handed out, oldest first */
+    UPROPERTY()
+    TArray<TObjectPtr<USceneComponent>> Active;
+    
+    /** Components ever created for this pool */
+    int32 TotalCreated = 0;
+    
+    /** Times the pool was full and the oldest active component was recycled early */
+    int32 StealCount = 0;
+    
+    /** Take an idle component (null if none) and mark it active */
+    USceneComponent* Acquire();
+    
+    /** Mark a freshly created component active */
+    void AddActive(USceneComponent* Component);
+    
+    /** Move an active component back to the idle list. False if it was not active here. */
+    bool Release(USceneComponent* Component);
+    
+    /** Longest-running active component, the candidate for stealing */
+    USceneComponent* GetOldestActive() const { return Active.Num() > 0 ? Active[0].Get() : nullptr; }
+    
+    /** Components owned by this pool */
+    int32 Num() const { return Available.Num() + Active.Num(); }
+    
+    /** Destroy every component and empty the pool */
+    void DestroyAll();
+};
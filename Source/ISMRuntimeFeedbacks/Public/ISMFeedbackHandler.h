@@ -7,8 +7,31 @@
 #include "Sound/SoundBase.h"
 #include "NiagaraSystem.h"
 #include "Feedbacks/ISMFeedbackContext.h"
+#include "UObject/ObjectKey.h"
 #include "ISMFeedbackHandler.generated.h"
 
+class UNiagaraComponent;
+class UISMFeedbackProvider;
+
+/**
+ * Per-frame budget a leaf handler draws from before spawning anything.
+ * Limits live in UISMFeedbackSettings.
+ */
+UENUM(BlueprintType)
+enum class EISMFeedbackBudgetCategory : uint8
+{
+    /** Audio voices (PlaySoundAtLocation) */
+    Audio,
+
+    /** Niagara system spawns */
+    Niagara,
+
+    /** Decal spawns */
+    Decal,
+
+    MAX UMETA(Hidden)
+};
+
 /**
  * Base feedback handler interface.
  * Both leaf handlers (audio, VFX) and composite handlers (matchers) implement this.
@@ -41,11 +64,44 @@ public:
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ISM Feedback")
     void PreloadAssets();
     virtual void PreloadAssets_Implementation() {}
+    
+    /** Soft assets this handler (and its children) may load; used for async streaming */
+    virtual void GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const {}
 
 
    // UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ISM Feedback")
    // void InitializeHandler();
    // virtual void InitializeHandler_Implementation() {}
+
+    /**
+     * Execute Handler, reporting its time to the feedback subsystem's per-handler timings when
+     * cost profiling is on. Composite handlers call this for their children, so a composite's
+     * time includes theirs.
+     */
+    static bool ExecuteProfiled(UISMFeedbackHandler* Handler, const FISMFeedbackContext& Context, UObject* WorldContext);
+
+    /** Name this handler is profiled under: its path inside the owning asset */
+    FName GetProfileName() const;
+
+protected:
+    /**
+     * Take one unit of this frame's budget for Category from the world's feedback provider.
+     * False means the budget is spent and the handler should skip its spawn.
+     */
+    static bool ConsumeFeedbackBudget(UObject* WorldContext, EISMFeedbackBudgetCategory Category);
+
+    /** The world's feedback provider, owner of the component pools; null outside game worlds */
+    static UISMFeedbackProvider* GetFeedbackProvider(const UWorld* World);
+
+    /**
+     * Loaded asset behind Path. Not yet loaded: with UISMFeedbackSettings::bSkipUnloadedAssets,
+     * request an async load and return null (this request is skipped silently); otherwise load
+     * synchronously as before.
+     */
+    static UObject* ResolveSoftAsset(const FSoftObjectPath& Path, UObject* WorldContext);
+
+private:
+    mutable FName CachedProfileName;
 };
 
 // ===== Leaf Handlers (Direct Execution) =====
@@ -77,6 +133,7 @@ public:
     
     virtual bool Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext) override;
     virtual void PreloadAssets_Implementation() override;
+    virtual void GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const override;
 };
 
 /**
@@ -106,6 +163,80 @@ public:
         
     virtual bool Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext) override;
     virtual void PreloadAssets_Implementation() override;
+    virtual void GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+};
+
+/**
+ * Leaf handler: Feeds batched contexts into one persistent Niagara system per world.
+ * 
+ * Instead of spawning a system per context, every request appends its instances to
+ * array user parameters on a long-lived component (Niagara array data interfaces):
+ *   PositionsParameter   - Array Position: instance locations
+ *   RotationsParameter   - Array Quat: instance rotations
+ *   ScalesParameter      - Array Vector: instance scales
+ *   IntensitiesParameter - Array Float: context intensity per instance
+ *   CountParameter       - int: entries written this frame
+ *   SerialParameter      - int: bumped on every push
+ * 
+ * A 1,000-instance batched destroy is one array upload instead of 1,000 spawns.
+ * Arrays accumulate across requests within a frame and restart on the next one.
+ * 
+ * System setup: an emitter spawns CountParameter particles whenever SerialParameter
+ * changes, each reading its entry from the arrays by Exec Index.
+ * Empty parameter names skip that array.
+ */
+UCLASS(BlueprintType, meta=(DisplayName="Batched Niagara Handler"))
+class ISMRUNTIMEFEEDBACKS_API UISMFeedbackHandler_NiagaraBatched : public UISMFeedbackHandler
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX")
+    TSoftObjectPtr<UNiagaraSystem> System;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Parameters")
+    FName PositionsParameter = TEXT("User.Positions");
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Parameters")
+    FName RotationsParameter = TEXT("User.Rotations");
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Parameters")
+    FName ScalesParameter = TEXT("User.Scales");
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Parameters")
+    FName IntensitiesParameter = TEXT("User.Intensities");
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Parameters")
+    FName CountParameter = TEXT("User.Count");
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Parameters")
+    FName SerialParameter = TEXT("User.BatchSerial");
+    
+    /** Entries kept per frame; further instances are dropped (0 = unlimited) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX", meta=(ClampMin="0"))
+    int32 MaxEntriesPerFrame = 4096;
+    
+    virtual bool Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext) override;
+    virtual void PreloadAssets_Implementation() override;
+    virtual void GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+    
+private:
+    /** Persistent component and this frame's accumulated arrays, per world */
+    struct FBatchState
+    {
+        TWeakObjectPtr<UNiagaraComponent> Component;
+        uint64 Frame = 0;
+        int32 Serial = 0;
+        TArray<FVector> Positions;
+        TArray<FQuat> Rotations;
+        TArray<FVector> Scales;
+        TArray<float> Intensities;
+    };
+    
+    TMap<TObjectKey<UWorld>, FBatchState> BatchStates;
+    
+    /** Find or spawn the world's persistent component */
+    UNiagaraComponent* GetPersistentComponent(UWorld* World, UNiagaraSystem* LoadedSystem, FBatchState& State) const;
 };
 
 /**
@@ -238,10 +369,51 @@ public:
     virtual bool Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext) override;
     
     virtual void PreloadAssets_Implementation() override;
+    virtual void GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+    
+    virtual void PostLoad() override;
+    
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+    
+    /**
+     * Rebuild the hashed lookups from HandlerDB and the subclass mappings.
+     * Call after editing them at runtime; built lazily on first execution otherwise.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    void RebuildLookupTables();
     
 protected:
+    /** Child handler chosen for a context, with the tag that selected it (for logging) */
+    struct FMatchedHandler
+    {
+        FGameplayTag Tag;
+        UISMFeedbackHandler* Handler = nullptr;
+    };
+    
+    /**
+     * Pick the child handler for Context. Default: DeriveTag() then a hashed tag lookup.
+     * Native subclasses override this to skip tag derivation entirely.
+     */
+    virtual FMatchedHandler MatchHandler(const FISMFeedbackContext& Context) const;
+    
+    /** Fill the lookup tables; subclasses extend it with their own (call Super first) */
+    virtual void BuildLookupTables();
+    
+    /** Build the tables if they were invalidated */
+    void EnsureLookupTables() const;
+    
+    /** Whether DeriveTag is the native implementation (not overridden in a Blueprint subclass) */
+    bool UsesNativeDeriveTag() const;
+    
     /** Find handler for derived tag */
     UISMFeedbackHandler* FindHandlerForTag(FGameplayTag DerivedTag) const;
+    
+    /** HandlerDB hashed by tag; the first entry wins, matching the editor list order */
+    TMap<FGameplayTag, UISMFeedbackHandler*> HandlerLookup;
+    
+    bool bLookupTablesBuilt = false;
 };
 
 /**
@@ -293,6 +465,14 @@ public:
      * Looks up Context.PhysicalMaterial.SurfaceType in SurfaceToTagMap.
      */
     virtual FGameplayTag DeriveTag_Implementation(const FISMFeedbackContext& Context) const override;
+    
+protected:
+    /** Surface type indexes straight into SurfaceHandlers */
+    virtual FMatchedHandler MatchHandler(const FISMFeedbackContext& Context) const override;
+    virtual void BuildLookupTables() override;
+    
+    /** Surface type → tag and child handler (null handler = DefaultHandler), one slot per EPhysicalSurface */
+    TArray<FMatchedHandler> SurfaceHandlers;
 };
 
 /**
@@ -320,4 +500,29 @@ public:
     TMap<float, FGameplayTag> IntensityThresholds; // Key = min threshold, Value = tag
     
     virtual FGameplayTag DeriveTag_Implementation(const FISMFeedbackContext& Context) const override;
+    
+protected:
+    /** Quantized intensity bucket → highest threshold met, with at most a step or two forward */
+    virtual FMatchedHandler MatchHandler(const FISMFeedbackContext& Context) const override;
+    virtual void BuildLookupTables() override;
+    
+    /** Index into SortedThresholds of the highest threshold met, or INDEX_NONE */
+    int32 FindThresholdIndex(float Intensity) const;
+    
+    struct FThresholdEntry
+    {
+        float Threshold = 0.0f;
+        FMatchedHandler Match;
+    };
+    
+    /** IntensityThresholds ascending */
+    TArray<FThresholdEntry> SortedThresholds;
+    
+    /** Per bucket over [lowest, highest threshold]: highest SortedThresholds index at or below the bucket start */
+    TArray<int32> BucketStart;
+    
+    /** Buckets per unit intensity */
+    float BucketScale = 0.0f;
+    
+    static constexpr int32 NumIntensityBuckets = 64;
 };
\ No newline at end of file
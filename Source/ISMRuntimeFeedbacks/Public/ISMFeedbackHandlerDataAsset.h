@@ -146,6 +146,9 @@ public:
      */
     UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
     void PreloadAllHandlers();
+    
+    /** Soft assets behind the handler for a tag, for async streaming */
+    void GatherSoftAssetsForTag(FGameplayTag FeedbackTag, TArray<FSoftObjectPath>& OutAssets) const;
 };
 
 /**
@@ -169,4 +172,5 @@ public:
     
     virtual bool Execute_Implementation(const FISMFeedbackContext& Context, UObject* WorldContext) override;
     virtual void PreloadAssets_Implementation() override;
+    virtual void GatherSoftAssets(TArray<FSoftObjectPath>& OutAssets) const override;
 };
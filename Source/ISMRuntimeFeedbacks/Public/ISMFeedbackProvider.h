@@ -6,8 +6,14 @@
 #include "Feedbacks/ISMFeedbackInterface.h"  // Note: Feedbacks subfolder
 #include "Feedbacks/ISMFeedbackContext.h"     // Note: Feedbacks subfolder
 #include "ISMFeedbackHandlerDataAsset.h"
+#include "ISMFeedbackComponentPool.h"
+#include "Engine/StreamableManager.h"
 #include "ISMFeedbackProvider.generated.h"
 
+class UAudioComponent;
+class UNiagaraComponent;
+class UDecalComponent;
+
 /**
  * World subsystem that provides feedback handling for ISMRuntimeFeedback module.
  * 
@@ -87,6 +93,12 @@ public:
      */
     virtual void OnFeedbackProviderUnregistered_Implementation() override;
     
+    /**
+     * Tags have become relevant in this world.
+     * Starts async loads of their handler assets (bStreamAssetsOnRelevance).
+     */
+    virtual void OnFeedbackTagsRelevant_Implementation(const FGameplayTagContainer& FeedbackTags) override;
+    
     // ===== Public API =====
     
     /**
@@ -109,6 +121,51 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
     void PreloadAllAssets();
     
+    /** Load Path asynchronously if it is not already loaded or in flight */
+    void RequestAssetLoad(const FSoftObjectPath& Path);
+    
+    /** Async loads started and not yet complete */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    int32 GetNumPendingAssetLoads() const;
+    
+    // ===== Budgets =====
+    
+    /**
+     * Take one unit of this frame's budget for Category.
+     * Counters reset on the first call of each engine frame.
+     * 
+     * @return False if the category's per-frame limit is already spent
+     */
+    bool TryConsumeBudget(EISMFeedbackBudgetCategory Category);
+    
+    /** Spawns refused by budgets since initialization */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    int32 GetBudgetRejections() const { return BudgetRejections; }
+    
+    // ===== Component Pools =====
+    
+    /**
+     * Pooled, idle component for Sound. Configure, then Play(); it returns to the pool when
+     * playback finishes. Null when pooling is disabled in settings.
+     */
+    UAudioComponent* AcquireAudioComponent(USoundBase* Sound);
+    
+    /**
+     * Pooled, inactive component for System. Configure, then Activate(true); it returns to
+     * the pool when the system finishes. Null when pooling is disabled in settings.
+     */
+    UNiagaraComponent* AcquireNiagaraComponent(UNiagaraSystem* System);
+    
+    /**
+     * Pooled decal for Material, shown for LifeSpan seconds and then returned to the pool.
+     * Null when pooling is disabled in settings.
+     */
+    UDecalComponent* AcquireDecalComponent(UMaterialInterface* Material, float LifeSpan);
+    
+    /** Components alive across all pools */
+    UFUNCTION(BlueprintCallable, Category = "ISM Feedback")
+    int32 GetNumPooledComponents() const;
+    
 protected:
     // ===== Internal State =====
     
@@ -122,6 +179,65 @@ protected:
     /** Whether we're currently registered */
     bool bIsRegistered = false;
     
+    /** Budget used this frame, per EISMFeedbackBudgetCategory */
+    int32 BudgetUsed[static_cast<int32>(EISMFeedbackBudgetCategory::MAX)] = {};
+    
+    /** Engine frame BudgetUsed belongs to */
+    uint64 BudgetFrame = 0;
+    
+    int32 BudgetRejections = 0;
+    
+    /** Async asset loads; handles keep the loaded assets resident */
+    FStreamableManager StreamableManager;
+    
+    /** One handle per relevant tag's handler assets */
+    TMap<FGameplayTag, TSharedPtr<FStreamableHandle>> TagLoadHandles;
+    
+    /** Handles for single assets requested on demand by handlers */
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> AssetLoadHandles;
+    
+    /** Start async loads for Tags' handler assets, skipping tags already streamed */
+    void StreamAssetsForTags(const FGameplayTagContainer& Tags);
+    
+    void ReleaseAssetLoadHandles();
+    
+    /** Pools keyed by sound, Niagara system or decal material */
+    UPROPERTY(Transient)
+    TMap<TObjectPtr<UObject>, FISMFeedbackComponentPool> ComponentPools;
+    
+    /** Asset an active pooled component was acquired for, plus a serial to reject stale decal timers */
+    struct FPooledComponentLease
+    {
+        TObjectKey<UObject> Asset;
+        uint32 Serial = 0;
+    };
+    TMap<TObjectKey<USceneComponent>, FPooledComponentLease> ActiveLeases;
+    
+    uint32 NextLeaseSerial = 1;
+    
+    /** Owner of all pooled components; spawned on first use */
+    UPROPERTY(Transient)
+    TObjectPtr<AActor> PoolActor = nullptr;
+    
+    /**
+     * Shared acquire path: reuse an idle component, create one (prewarming a new pool),
+     * or recycle the oldest active one once MaxComponentsPerAsset is reached.
+     */
+    USceneComponent* AcquirePooledComponent(UObject* Asset, TFunctionRef<USceneComponent*(AActor*)> CreateComponent);
+    
+    /** Return a component to its pool; ignored if Serial no longer matches its lease (0 = any) */
+    void ReleasePooledComponent(USceneComponent* Component, uint32 Serial = 0);
+    
+    /** Stop a component so it can be reused; its finish callback releases it */
+    void StopPooledComponent(USceneComponent* Component);
+    
+    UFUNCTION()
+    void OnPooledNiagaraFinished(UNiagaraComponent* Component);
+    
+    void OnPooledAudioFinished(UAudioComponent* Component);
+    
+    void DestroyComponentPools();
+    
     // ===== Helper Methods =====
     
     /**
@@ -69,6 +69,78 @@ public:
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
     bool bPreloadAllHandlers = false;
     
+    // ===== Budgets =====
+    
+    /**
+     * Per-frame spawn budgets per handler category. -1 = unlimited.
+     * 
+     * Queued feedback reaches the provider most significant first (see
+     * UISMFeedbackSubsystem::bScoreSignificance), so once a budget is spent the rest of
+     * the frame's requests in that category are the ones the player would notice least.
+     * A mass event costs at most this many voices/systems/decals in one frame.
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Budgets", meta=(ClampMin="-1"))
+    int32 MaxAudioPerFrame = 16;
+    
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Budgets", meta=(ClampMin="-1"))
+    int32 MaxNiagaraPerFrame = 24;
+    
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Budgets", meta=(ClampMin="-1"))
+    int32 MaxDecalsPerFrame = 12;
+    
+    // ===== Pooling =====
+    
+    /**
+     * Reuse audio, Niagara and decal components across feedback instead of spawning one per
+     * execution. Components return to their pool when they finish playing (decals when their
+     * Duration elapses).
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Pooling")
+    bool bPoolFeedbackComponents = true;
+    
+    /** Components created up front the first time an asset is used */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Pooling", meta=(EditCondition="bPoolFeedbackComponents", ClampMin="0"))
+    int32 PrewarmComponentsPerAsset = 2;
+    
+    /**
+     * Most components kept per asset. When all are playing, the oldest is stopped and reused.
+     * Keep at or above the matching per-frame budget times the effect's typical lifetime in frames.
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Pooling", meta=(EditCondition="bPoolFeedbackComponents", ClampMin="1"))
+    int32 MaxComponentsPerAsset = 16;
+    
+    // ===== Streaming =====
+    
+    /**
+     * Start loading a tag's handler assets asynchronously as soon as the tag becomes relevant
+     * (a component using it begins play), so the first trigger finds them resident.
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming")
+    bool bStreamAssetsOnRelevance = true;
+    
+    /**
+     * When a handler's asset is not loaded yet, request it asynchronously and skip this feedback
+     * instead of loading it synchronously (a hitch). The next trigger after it arrives plays.
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming")
+    bool bSkipUnloadedAssets = false;
+    
+    /** FStreamableManager priority for these loads; higher loads first */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming")
+    int32 AsyncLoadPriority = 0;
+    
+    /** Budget limit for a category */
+    int32 GetBudgetLimit(EISMFeedbackBudgetCategory Category) const
+    {
+        switch (Category)
+        {
+            case EISMFeedbackBudgetCategory::Audio:   return MaxAudioPerFrame;
+            case EISMFeedbackBudgetCategory::Niagara: return MaxNiagaraPerFrame;
+            case EISMFeedbackBudgetCategory::Decal:   return MaxDecalsPerFrame;
+            default:                                  return -1;
+        }
+    }
+    
     // ===== Debug Settings =====
     
     /**
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/** LLM tag for this module's hot paths, shown as ISMRuntime/Feedbacks (see ISMRuntimeProfiling.h) */
+LLM_DECLARE_TAG_API(ISMRuntime_Feedbacks, ISMRUNTIMEFEEDBACKS_API);
 
 class FISMRuntimeFeedbacks : public IModuleInterface
 {
@@ -1,5 +1,6 @@
 // ISMInteractionComponent.cpp
 #include "ISMInteractionComponent.h"
+#include "ISMRuntimeInteraction.h"
 
 #include "ISMRuntimeComponent.h"
 #include "ISMRuntimeSubsystem.h"
@@ -75,16 +76,19 @@ void UISMInteractionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void UISMInteractionComponent::TickComponent(float DeltaTime, ELevelTick TickType,
     FActorComponentTickFunction* ThisTickFunction)
 {
+    LLM_SCOPE_BYTAG(ISMRuntime_Interaction);
+
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
     // Skip targeting while carrying — the focused instance isn't meaningful
     // while hands are full. Games can override this by subclassing.
     if (IsCarrying())
     {
+        bHasResolvedView = false;
         return;
     }
 
-    FISMInstanceHandle NewTarget = ResolveTargetThisFrame();
+    FISMInstanceHandle NewTarget = bCoherentFocus ? ResolveTargetCoherent(DeltaTime) : ResolveTargetThisFrame();
 
     if (NewTarget != FocusedHandle)
     {
@@ -246,6 +250,71 @@ FISMInstanceHandle UISMInteractionComponent::ResolveTargetThisFrame() const
     }
 }
 
+FISMInstanceHandle UISMInteractionComponent::ResolveTargetCoherent(float DeltaTime)
+{
+    TimeSinceFullResolve += DeltaTime;
+
+    const FVector Origin = GetComponentLocation();
+    const FVector Forward = GetForwardVector();
+
+    bool bViewMoved = !bHasResolvedView
+        || FVector::DistSquared(Origin, LastResolveLocation) > FMath::Square(FocusReresolveDistance);
+    if (!bViewMoved && TargetingMode == EISMTargetingMode::Raycast)
+    {
+        bViewMoved = (Forward | LastResolveForward) < FMath::Cos(FMath::DegreesToRadians(FocusReresolveAngle));
+    }
+
+    // Nothing was found from this view last time; nothing new is looked for until the next full query
+    if (!bViewMoved && TimeSinceFullResolve < FocusReresolveInterval
+        && (!FocusedHandle.IsValid() || IsFocusRetained(Origin, Forward)))
+    {
+        return FocusedHandle;
+    }
+
+    LastResolveLocation = Origin;
+    LastResolveForward = Forward;
+    TimeSinceFullResolve = 0.0f;
+    bHasResolvedView = true;
+
+    return ResolveTargetThisFrame();
+}
+
+bool UISMInteractionComponent::IsFocusRetained(const FVector& Origin, const FVector& Forward) const
+{
+    // Converted instances are targeted through their actor; leave them to the full query
+    if (!FocusedHandle.IsValid() || FocusedHandle.IsConvertedToActor())
+    {
+        return false;
+    }
+
+    UISMRuntimeComponent* Comp = FocusedHandle.Component.Get();
+    const int32 Index = FocusedHandle.InstanceIndex;
+    if (!Comp->IsInstanceActive(Index) || !Comp->InstancePassesTagFilter(Index, TargetFilter.RequiredTags, TargetFilter.ExcludedTags))
+    {
+        return false;
+    }
+
+    if (FocusedHandle.IsPossessed() && !FocusedHandle.IsPossessedBy(GetOwner()))
+    {
+        return false;
+    }
+
+    switch (TargetingMode)
+    {
+    case EISMTargetingMode::Raycast:
+    {
+        // Occluders appearing in front of a still view are picked up by the next full query
+        float Distance = 0.0f;
+        FVector Normal;
+        return Comp->IntersectInstanceOrientedBounds(Index, Origin, Forward, InteractionRange, 0.0f, Distance, Normal);
+    }
+    case EISMTargetingMode::SphereOverlap:
+        return FVector::DistSquared(Origin, Comp->GetInstanceLocation(Index)) <= FMath::Square(InteractionRange);
+    default:
+        return false;
+    }
+}
+
 FISMInstanceHandle UISMInteractionComponent::ResolveByRaycast() const
 {
     auto Fail = [&](FString msg) -> FISMInstanceHandle
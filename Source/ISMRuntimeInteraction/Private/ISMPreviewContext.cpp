@@ -3,9 +3,14 @@
 
 #include "ISMRuntimeComponent.h"
 #include "ISMSelectionSet.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMInstanceDataAsset.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
 
 UISMPreviewContext::UISMPreviewContext()
 {
@@ -46,16 +51,14 @@ bool UISMPreviewContext::BeginPreview(UISMSelectionSet* InSelectionSet, EISMPrev
         return false;
     }
 
-    // Convert each selected instance to a preview actor
+    // Build the preview at each selected instance — read before hiding, which moves them
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(PreviewHandles.Num());
     for (const FISMInstanceHandle& Handle : PreviewHandles)
     {
-        AActor* PreviewActor = SpawnPreviewActorForHandle(Handle);
-        PreviewActors.Add(PreviewActor); // nullptr entries kept — parallel array
-        if (PreviewActor)
-        {
-            ApplyPreviewMaterial(PreviewActor);
-        }
+        Transforms.Add(Handle.GetTransform());
     }
+    BuildPreview(PreviewHandles, Transforms);
 
     // For destroy preview, hide the source instances (they're now represented by preview actors)
     // For move preview, same — source is hidden, preview is at destination
@@ -111,30 +114,17 @@ bool UISMPreviewContext::BeginPlacementPreview(UISMRuntimeComponent* TargetCompo
 
     PlacementHandle = TargetComponent->GetInstanceHandle(ReservedIndex);
 
-    // Spawn a single preview actor at the initial transform
-    UWorld* World = GetWorld();
-    if (World && PreviewActorClass)
-    {
-        FActorSpawnParameters Params;
-        Params.SpawnCollisionHandlingOverride =
-            ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-        AActor* PreviewActor = World->SpawnActor<AActor>(
-            PreviewActorClass, InitialTransform, Params);
+    // A single preview at the initial transform
+    BuildPreview({ PlacementHandle }, { InitialTransform });
 
-        PreviewActors.Add(PreviewActor);
+    PreviewState = EISMPreviewState::Pending;
 
-        if (PreviewActor)
-        {
-            ApplyPreviewMaterial(PreviewActor);
-        }
-    }
-    else
+    if (bValidatePlacement)
     {
-        PreviewActors.Add(nullptr);
+        bPlacementValid = true;
+        PlacementNeighbourhood = FBox(ForceInit);
+        UpdatePlacementValidity(InitialTransform, false);
     }
-
-    PreviewState = EISMPreviewState::Pending;
     return true;
 }
 
@@ -147,12 +137,25 @@ void UISMPreviewContext::UpdatePlacementTransform(const FTransform& NewTransform
     if (!EnsurePending(TEXT("UpdatePlacementTransform"))) return;
     if (PreviewType != EISMPreviewType::Placement) return;
 
-    // Move the preview actor
-    if (PreviewActors.Num() > 0 && PreviewActors[0].IsValid())
+    // Move the preview
+    if (bUseInstancedPreview)
+    {
+        if (PreviewInstances.Num() > 0 && PreviewISMs.IsValidIndex(PreviewInstances[0].ISMIndex))
+        {
+            if (UInstancedStaticMeshComponent* ISM = PreviewISMs[PreviewInstances[0].ISMIndex])
+            {
+                ISM->UpdateInstanceTransform(PreviewInstances[0].InstanceIndex, NewTransform, true, true, true);
+            }
+        }
+    }
+    else if (PreviewActors.Num() > 0 && PreviewActors[0].IsValid())
     {
         PreviewActors[0]->SetActorTransform(NewTransform);
     }
 
+    // Checked before our own write below, which moves the target component's revision
+    const bool bCacheCurrent = bValidatePlacement && IsPlacementCacheCurrent();
+
     // Update the reserved instance transform in the spatial index
     // so AABB queries see the current pending location
     if (PlacementHandle.IsValid())
@@ -165,6 +168,111 @@ void UISMPreviewContext::UpdatePlacementTransform(const FTransform& NewTransform
             );
         }
     }
+
+    if (bValidatePlacement)
+    {
+        UpdatePlacementValidity(NewTransform, bCacheCurrent);
+    }
+}
+
+// ============================================================
+//  UpdatePreviewTransforms / RefreshPreview
+// ============================================================
+
+void UISMPreviewContext::UpdatePreviewTransforms(const TArray<FTransform>& NewTransforms)
+{
+    if (!EnsurePending(TEXT("UpdatePreviewTransforms"))) return;
+    if (PreviewType == EISMPreviewType::Placement) return;
+
+    if (NewTransforms.Num() != PreviewHandles.Num())
+    {
+        UE_LOG(LogTemp, Warning,
+            TEXT("UISMPreviewContext::UpdatePreviewTransforms - %d transforms for %d handles"),
+            NewTransforms.Num(), PreviewHandles.Num());
+        return;
+    }
+
+    if (!bUseInstancedPreview)
+    {
+        for (int32 i = 0; i < PreviewActors.Num(); ++i)
+        {
+            if (PreviewActors[i].IsValid())
+            {
+                PreviewActors[i]->SetActorTransform(NewTransforms[i]);
+            }
+        }
+        return;
+    }
+
+    // Render state is dirtied once per ISM rather than per instance
+    for (int32 i = 0; i < PreviewInstances.Num(); ++i)
+    {
+        const FPreviewInstance& Instance = PreviewInstances[i];
+        if (PreviewISMs.IsValidIndex(Instance.ISMIndex) && PreviewISMs[Instance.ISMIndex])
+        {
+            PreviewISMs[Instance.ISMIndex]->UpdateInstanceTransform(Instance.InstanceIndex, NewTransforms[i], true, false, true);
+        }
+    }
+    for (UInstancedStaticMeshComponent* ISM : PreviewISMs)
+    {
+        if (ISM) ISM->MarkRenderStateDirty();
+    }
+}
+
+void UISMPreviewContext::RefreshPreview()
+{
+    if (!EnsurePending(TEXT("RefreshPreview"))) return;
+    if (PreviewType == EISMPreviewType::Placement) return;
+
+    UISMSelectionSet* Selection = SourceSelectionSet.Get();
+    if (!Selection) return;
+
+    TArray<FISMInstanceHandle> NewHandles = Selection->GetValidSelectedHandles();
+
+    TMap<FISMInstanceHandle, int32> OldPreviewIdx;
+    OldPreviewIdx.Reserve(PreviewHandles.Num());
+    for (int32 i = 0; i < PreviewHandles.Num(); ++i)
+    {
+        OldPreviewIdx.Add(PreviewHandles[i], i);
+    }
+
+    // Still-selected handles stay where they are previewed; new ones start at their instance,
+    // read before they are hidden below
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(NewHandles.Num());
+    for (const FISMInstanceHandle& Handle : NewHandles)
+    {
+        FTransform Transform;
+        const int32* OldIdx = OldPreviewIdx.Find(Handle);
+        if (!OldIdx || !GetPreviewTransform(*OldIdx, Transform))
+        {
+            const UISMRuntimeComponent* Comp = Handle.Component.Get();
+            const FTransform* LastVisible = (OldIdx && Comp) ? Comp->GetInstanceStateStore().GetLastVisibleTransform(Handle.InstanceIndex) : nullptr;
+            Transform = LastVisible ? *LastVisible : Handle.GetTransform();
+        }
+        Transforms.Add(Transform);
+    }
+
+    const TSet<FISMInstanceHandle> NewSet(NewHandles);
+    for (const FISMInstanceHandle& Handle : PreviewHandles)
+    {
+        if (!NewSet.Contains(Handle) && Handle.IsValid())
+        {
+            Handle.Component->ShowInstance(Handle.InstanceIndex);
+        }
+    }
+    for (const FISMInstanceHandle& Handle : NewHandles)
+    {
+        if (!OldPreviewIdx.Contains(Handle))
+        {
+            Handle.Component->HideInstance(Handle.InstanceIndex);
+        }
+    }
+
+    // Instanced previews keep their ISMs and only rewrite the instances
+    CleanupPreviewActors(false);
+    PreviewHandles = MoveTemp(NewHandles);
+    BuildPreview(PreviewHandles, Transforms);
 }
 
 // ============================================================
@@ -216,10 +324,10 @@ void UISMPreviewContext::Confirm()
             const FISMInstanceHandle& Handle = PreviewHandles[i];
             if (!Handle.IsValid()) continue;
 
-            FTransform FinalTransform = Handle.GetTransform();
-            if (PreviewActors.IsValidIndex(i) && PreviewActors[i].IsValid())
+            FTransform FinalTransform;
+            if (!GetPreviewTransform(i, FinalTransform))
             {
-                FinalTransform = PreviewActors[i]->GetActorTransform();
+                FinalTransform = Handle.GetTransform();
             }
 
             if (UISMRuntimeComponent* Comp = Handle.Component.Get())
@@ -297,13 +405,29 @@ const TArray<AActor*> UISMPreviewContext::GetPreviewActors() const
     return Result;
 }
 
+TArray<UInstancedStaticMeshComponent*> UISMPreviewContext::GetPreviewISMs() const
+{
+    TArray<UInstancedStaticMeshComponent*> Result;
+    for (UInstancedStaticMeshComponent* ISM : PreviewISMs)
+    {
+        if (ISM) Result.Add(ISM);
+    }
+    return Result;
+}
+
 // ============================================================
 //  Internal Helpers
 // ============================================================
 
 AActor* UISMPreviewContext::SpawnPreviewActorForHandle(const FISMInstanceHandle& Handle)
 {
-    if (!Handle.IsValid() || !PreviewActorClass) return nullptr;
+    if (!Handle.IsValid()) return nullptr;
+    return SpawnPreviewActor(Handle.GetTransform());
+}
+
+AActor* UISMPreviewContext::SpawnPreviewActor(const FTransform& Transform)
+{
+    if (!PreviewActorClass) return nullptr;
 
     UWorld* World = GetWorld();
     if (!World) return nullptr;
@@ -311,10 +435,126 @@ AActor* UISMPreviewContext::SpawnPreviewActorForHandle(const FISMInstanceHandle&
     FActorSpawnParameters Params;
     Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-    return World->SpawnActor<AActor>(PreviewActorClass, Handle.GetTransform(), Params);
+    return World->SpawnActor<AActor>(PreviewActorClass, Transform, Params);
 }
 
-void UISMPreviewContext::CleanupPreviewActors()
+void UISMPreviewContext::BuildPreview(const TArray<FISMInstanceHandle>& Handles, const TArray<FTransform>& Transforms)
+{
+    if (!bUseInstancedPreview)
+    {
+        for (int32 i = 0; i < Handles.Num(); ++i)
+        {
+            AActor* PreviewActor = Handles[i].IsValid() ? SpawnPreviewActor(Transforms[i]) : nullptr;
+            PreviewActors.Add(PreviewActor); // nullptr entries kept — parallel array
+            if (PreviewActor)
+            {
+                ApplyPreviewMaterial(PreviewActor);
+            }
+        }
+        return;
+    }
+
+    // Bucket the handles by preview ISM so each mesh takes one AddInstances
+    PreviewInstances.Init(FPreviewInstance(), Handles.Num());
+    TArray<TArray<int32>> HandlesPerISM;
+    for (int32 i = 0; i < Handles.Num(); ++i)
+    {
+        UISMRuntimeComponent* Comp = Handles[i].IsValid() ? Handles[i].Component.Get() : nullptr;
+        UInstancedStaticMeshComponent* ISM = Comp ? FindOrCreatePreviewISM(Comp->ManagedISMComponent) : nullptr;
+        if (!ISM) continue;
+
+        const int32 ISMIndex = PreviewISMs.Find(ISM);
+        if (HandlesPerISM.Num() <= ISMIndex)
+        {
+            HandlesPerISM.SetNum(ISMIndex + 1);
+        }
+        HandlesPerISM[ISMIndex].Add(i);
+        PreviewInstances[i].ISMIndex = ISMIndex;
+    }
+
+    TArray<FTransform> ISMTransforms;
+    for (int32 ISMIndex = 0; ISMIndex < HandlesPerISM.Num(); ++ISMIndex)
+    {
+        const TArray<int32>& HandleIndices = HandlesPerISM[ISMIndex];
+        if (HandleIndices.IsEmpty()) continue;
+
+        UInstancedStaticMeshComponent* ISM = PreviewISMs[ISMIndex];
+        ISMTransforms.Reset();
+        for (int32 HandleIdx : HandleIndices)
+        {
+            ISMTransforms.Add(Transforms[HandleIdx]);
+        }
+
+        const int32 First = ISM->GetInstanceCount();
+        ISM->AddInstances(ISMTransforms, false, true, false);
+
+        const bool bWriteCustomData = ISM->NumCustomDataFloats > PreviewMaterialDataIndex && PreviewMaterialDataIndex >= 0;
+        for (int32 k = 0; k < HandleIndices.Num(); ++k)
+        {
+            PreviewInstances[HandleIndices[k]].InstanceIndex = First + k;
+            if (bWriteCustomData)
+            {
+                ISM->SetCustomDataValue(First + k, PreviewMaterialDataIndex, PreviewMaterialDataValue, false);
+            }
+        }
+        ISM->MarkRenderStateDirty();
+    }
+}
+
+bool UISMPreviewContext::GetPreviewTransform(int32 PreviewIdx, FTransform& OutTransform) const
+{
+    if (bUseInstancedPreview)
+    {
+        if (!PreviewInstances.IsValidIndex(PreviewIdx)) return false;
+        const FPreviewInstance& Instance = PreviewInstances[PreviewIdx];
+        const UInstancedStaticMeshComponent* ISM = PreviewISMs.IsValidIndex(Instance.ISMIndex) ? PreviewISMs[Instance.ISMIndex].Get() : nullptr;
+        return ISM && ISM->GetInstanceTransform(Instance.InstanceIndex, OutTransform, true);
+    }
+
+    if (PreviewActors.IsValidIndex(PreviewIdx) && PreviewActors[PreviewIdx].IsValid())
+    {
+        OutTransform = PreviewActors[PreviewIdx]->GetActorTransform();
+        return true;
+    }
+    return false;
+}
+
+UInstancedStaticMeshComponent* UISMPreviewContext::FindOrCreatePreviewISM(const UInstancedStaticMeshComponent* Source)
+{
+    UStaticMesh* Mesh = Source ? Source->GetStaticMesh() : nullptr;
+    AActor* Owner = GetOwner();
+    if (!Mesh || !Owner) return nullptr;
+
+    for (UInstancedStaticMeshComponent* ISM : PreviewISMs)
+    {
+        if (ISM && ISM->GetStaticMesh() == Mesh) return ISM;
+    }
+
+    // World-space and unattached, so instances take the handles' world transforms as they are
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(Owner, NAME_None, RF_Transient);
+    ISM->SetStaticMesh(Mesh);
+    ISM->SetMobility(EComponentMobility::Movable);
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->SetCastShadow(false);
+    ISM->SetUsingAbsoluteLocation(true);
+    ISM->SetUsingAbsoluteRotation(true);
+    ISM->SetUsingAbsoluteScale(true);
+    ISM->SetWorldTransform(FTransform::Identity);
+    if (PreviewMaterialDataIndex >= 0)
+    {
+        ISM->SetNumCustomDataFloats(PreviewMaterialDataIndex + 1);
+    }
+    for (int32 SlotIdx = 0; SlotIdx < Source->GetNumMaterials(); ++SlotIdx)
+    {
+        ISM->SetMaterial(SlotIdx, PreviewMaterial ? PreviewMaterial.Get() : Source->GetMaterial(SlotIdx));
+    }
+    ISM->RegisterComponent();
+
+    PreviewISMs.Add(ISM);
+    return ISM;
+}
+
+void UISMPreviewContext::CleanupPreviewActors(bool bDestroyPreviewISMs)
 {
     for (TWeakObjectPtr<AActor>& Ptr : PreviewActors)
     {
@@ -324,6 +564,18 @@ void UISMPreviewContext::CleanupPreviewActors()
         }
     }
     PreviewActors.Reset();
+
+    for (UInstancedStaticMeshComponent* ISM : PreviewISMs)
+    {
+        if (!ISM) continue;
+        if (bDestroyPreviewISMs) ISM->DestroyComponent();
+        else                     ISM->ClearInstances();
+    }
+    if (bDestroyPreviewISMs)
+    {
+        PreviewISMs.Reset();
+    }
+    PreviewInstances.Reset();
 }
 
 void UISMPreviewContext::ApplyPreviewMaterial(AActor* PreviewActor) const
@@ -361,6 +613,95 @@ void UISMPreviewContext::ApplyPreviewMaterial(AActor* PreviewActor) const
     }
 }
 
+bool UISMPreviewContext::IsPlacementCacheCurrent() const
+{
+    if (!PlacementNeighbourhood.IsValid) return false;
+
+    const UWorld* World = GetWorld();
+    const UISMRuntimeSubsystem* Subsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+    if (!Subsystem) return false;
+
+    // A component added, removed or reordered counts as a change
+    const TArray<UISMRuntimeComponent*> Components = Subsystem->GetAllComponents();
+    if (Components.Num() != PlacementCacheRevisions.Num()) return false;
+    for (int32 i = 0; i < Components.Num(); ++i)
+    {
+        if (PlacementCacheRevisions[i].Key.Get() != Components[i]
+            || PlacementCacheRevisions[i].Value != Components[i]->GetQueryRevision())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UISMPreviewContext::RecordPlacementCacheRevisions()
+{
+    PlacementCacheRevisions.Reset();
+
+    const UWorld* World = GetWorld();
+    const UISMRuntimeSubsystem* Subsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+    if (!Subsystem) return;
+
+    for (UISMRuntimeComponent* Comp : Subsystem->GetAllComponents())
+    {
+        PlacementCacheRevisions.Emplace(Comp, Comp->GetQueryRevision());
+    }
+}
+
+void UISMPreviewContext::UpdatePlacementValidity(const FTransform& Transform, bool bCacheCurrent)
+{
+    UISMRuntimeComponent* TargetComp = PlacementHandle.Component.Get();
+    if (!TargetComp) return;
+
+    // The reserved instance is hidden, so its own AABB can't be used; build it from the same
+    // local bounds instance AABBs come from
+    FBox LocalBounds(ForceInit);
+    if (TargetComp->InstanceData)
+    {
+        LocalBounds = TargetComp->InstanceData->GetEffectiveLocalBounds();
+    }
+    else if (const UStaticMesh* Mesh = TargetComp->ManagedISMComponent ? TargetComp->ManagedISMComponent->GetStaticMesh() : nullptr)
+    {
+        LocalBounds = Mesh->GetBoundingBox();
+    }
+    if (!LocalBounds.IsValid) return;
+
+    const FBox PlacementBounds = LocalBounds.TransformBy(Transform);
+
+    if (!bCacheCurrent || !PlacementNeighbourhood.IsInsideOrOn(PlacementBounds))
+    {
+        const UWorld* World = GetWorld();
+        const UISMRuntimeSubsystem* Subsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+        if (!Subsystem) return;
+
+        PlacementNeighbourhood = PlacementBounds.ExpandBy(PlacementCachePadding);
+        PlacementCandidates.Reset();
+        Subsystem->QueryInstancesOverlappingBox(PlacementNeighbourhood, PlacementFilter, PlacementCandidates);
+        PlacementCandidates.RemoveSwap(PlacementHandle, EAllowShrinking::No);
+    }
+    RecordPlacementCacheRevisions();
+
+    // Live AABBs, so candidates that moved within the neighbourhood are tested where they are now
+    PlacementOverlaps.Reset();
+    for (const FISMInstanceHandle& Candidate : PlacementCandidates)
+    {
+        if (!Candidate.IsValid()) continue;
+        const FBox CandidateBounds = Candidate.Component->GetInstanceWorldBounds(Candidate.InstanceIndex);
+        if (CandidateBounds.IsValid && CandidateBounds.Intersect(PlacementBounds))
+        {
+            PlacementOverlaps.Add(Candidate);
+        }
+    }
+
+    const bool bWasValid = bPlacementValid;
+    bPlacementValid = PlacementOverlaps.IsEmpty();
+    if (bPlacementValid != bWasValid)
+    {
+        OnPlacementValidityChanged.Broadcast(bPlacementValid);
+    }
+}
+
 bool UISMPreviewContext::EnsurePending(const FString& OperationName) const
 {
     if (PreviewState != EISMPreviewState::Pending)
@@ -1,5 +1,7 @@
 #include "ISMRuntimeInteraction.h"
 
+LLM_DEFINE_TAG(ISMRuntime_Interaction);
+
 #define LOCTEXT_NAMESPACE "FISMRuntimeInteractionModule"
 
 void FISMRuntimeInteraction::StartupModule()
@@ -2,8 +2,11 @@
 #include "ISMSelectionSet.h"
 
 #include "ISMRuntimeComponent.h"
+#include "ISMPhysicsComponent.h"
 #include "ISMRuntimeSubsystem.h"
+#include "ISMCompiledQueryFilter.h"
 #include "Engine/World.h"
+#include "GameFramework/Actor.h"
 
 UISMSelectionSet::UISMSelectionSet()
 {
@@ -20,30 +23,28 @@ void UISMSelectionSet::SelectInstance(const FISMInstanceHandle& Handle, EISMSele
     {
     case EISMSelectionMode::Replace:
         ApplySelectionTagBatch(SelectedHandles, false);
-        SelectedHandles.Reset();
-        SelectedHandles.Add(Handle);
+        ResetSelection();
+        AddToSelection(Handle);
         ApplySelectionTag(Handle, true);
         break;
 
     case EISMSelectionMode::Add:
-        if (!IsSelected(Handle))
-        {
-            SelectedHandles.Add(Handle);
+        if (AddToSelection(Handle))
             ApplySelectionTag(Handle, true);
-        }
         break;
 
     case EISMSelectionMode::Remove:
-        if (SelectedHandles.RemoveSingle(Handle) > 0)
+        if (RemoveFromSelection(Handle))
             ApplySelectionTag(Handle, false);
         break;
 
     case EISMSelectionMode::Toggle:
-        if (IsSelected(Handle)) { SelectedHandles.RemoveSingle(Handle); ApplySelectionTag(Handle, false); }
-        else { SelectedHandles.Add(Handle);          ApplySelectionTag(Handle, true); }
+        if (RemoveFromSelection(Handle)) ApplySelectionTag(Handle, false);
+        else { AddToSelection(Handle);   ApplySelectionTag(Handle, true); }
         break;
     }
 
+    CompactSelection();
     EnforceSelectionLimit();
     BroadcastSelectionChanged();
 }
@@ -56,9 +57,10 @@ void UISMSelectionSet::SelectInstances(const TArray<FISMInstanceHandle>& Handles
     if (Mode == EISMSelectionMode::Replace)
     {
         ApplySelectionTagBatch(SelectedHandles, false);
-        SelectedHandles.Reset();
+        ResetSelection();
+        SelectedHandles.Reserve(Handles.Num());
         for (const FISMInstanceHandle& H : Handles)
-            if (H.IsValid()) SelectedHandles.Add(H);
+            if (H.IsValid()) AddToSelection(H);
         ApplySelectionTagBatch(SelectedHandles, true);
     }
     else
@@ -70,20 +72,21 @@ void UISMSelectionSet::SelectInstances(const TArray<FISMInstanceHandle>& Handles
             switch (Mode)
             {
             case EISMSelectionMode::Add:
-                if (!IsSelected(H)) { SelectedHandles.Add(H); ToAdd.Add(H); }
+                if (AddToSelection(H)) ToAdd.Add(H);
                 break;
             case EISMSelectionMode::Remove:
-                if (SelectedHandles.RemoveSingle(H) > 0) ToRemove.Add(H);
+                if (RemoveFromSelection(H)) ToRemove.Add(H);
                 break;
             case EISMSelectionMode::Toggle:
-                if (IsSelected(H)) { SelectedHandles.RemoveSingle(H); ToRemove.Add(H); }
-                else { SelectedHandles.Add(H);          ToAdd.Add(H); }
+                if (RemoveFromSelection(H)) ToRemove.Add(H);
+                else { AddToSelection(H);   ToAdd.Add(H); }
                 break;
             default: break;
             }
         }
         ApplySelectionTagBatch(ToAdd, true);
         ApplySelectionTagBatch(ToRemove, false);
+        CompactSelection();
     }
 
     EnforceSelectionLimit();
@@ -92,23 +95,37 @@ void UISMSelectionSet::SelectInstances(const TArray<FISMInstanceHandle>& Handles
 
 void UISMSelectionSet::SelectInstancesInRadius(const FVector& Center, float Radius,
     const FISMQueryFilter& Filter, EISMSelectionMode Mode)
+{
+    SelectInstancesInRadius(Center, Radius, Filter.Compile(), Mode);
+}
+
+void UISMSelectionSet::SelectInstancesInBox(const FBox& Box,
+    const FISMQueryFilter& Filter, EISMSelectionMode Mode)
+{
+    SelectInstancesInBox(Box, Filter.Compile(), Mode);
+}
+
+void UISMSelectionSet::SelectInstancesInRadius(const FVector& Center, float Radius,
+    const FISMCompiledQueryFilter& Filter, EISMSelectionMode Mode)
 {
     UWorld* World = GetWorld();
     if (!World) return;
     UISMRuntimeSubsystem* Sub = World->GetSubsystem<UISMRuntimeSubsystem>();
     if (!Sub) return;
-    TArray<FISMInstanceHandle> Found = Sub->QueryInstancesInRadius(Center, Radius, Filter);
+    TArray<FISMInstanceHandle> Found;
+    Sub->QueryInstancesInRadius(Center, Radius, Filter, Found);
     if (!Found.IsEmpty()) SelectInstances(Found, Mode);
 }
 
 void UISMSelectionSet::SelectInstancesInBox(const FBox& Box,
-    const FISMQueryFilter& Filter, EISMSelectionMode Mode)
+    const FISMCompiledQueryFilter& Filter, EISMSelectionMode Mode)
 {
     UWorld* World = GetWorld();
     if (!World) return;
     UISMRuntimeSubsystem* Sub = World->GetSubsystem<UISMRuntimeSubsystem>();
     if (!Sub) return;
-    TArray<FISMInstanceHandle> Found = Sub->QueryInstancesInBox(Box, Filter);
+    TArray<FISMInstanceHandle> Found;
+    Sub->QueryInstancesInBox(Box, Filter, Found);
     if (!Found.IsEmpty()) SelectInstances(Found, Mode);
 }
 
@@ -121,13 +138,13 @@ void UISMSelectionSet::ClearSelection()
 {
     if (SelectedHandles.IsEmpty()) return;
     ApplySelectionTagBatch(SelectedHandles, false);
-    SelectedHandles.Reset();
+    ResetSelection();
     BroadcastSelectionChanged();
 }
 
 bool UISMSelectionSet::IsSelected(const FISMInstanceHandle& Handle) const
 {
-    return SelectedHandles.Contains(Handle);
+    return FindPosition(Handle) != INDEX_NONE;
 }
 
 TArray<FISMInstanceHandle> UISMSelectionSet::GetValidSelectedHandles() const
@@ -140,47 +157,105 @@ TArray<FISMInstanceHandle> UISMSelectionSet::GetValidSelectedHandles() const
 
 void UISMSelectionSet::DestroySelected()
 {
-    PruneInvalidHandles();
-    if (SelectedHandles.IsEmpty()) return;
-
-    ApplySelectionTagBatch(SelectedHandles, false);
-    for (const FISMInstanceHandle& H : SelectedHandles)
+    const bool bPruned = PruneInvalidHandles();
+    if (SelectedHandles.IsEmpty())
     {
-        if (!H.IsValid()) continue;
-        if (UISMRuntimeComponent* Comp = H.Component.Get())
-            Comp->DestroyInstance(H.InstanceIndex);
+        if (bPruned) BroadcastSelectionChanged();
+        return;
     }
-    SelectedHandles.Reset();
+
+    ApplySelectionTagBatch(SelectedHandles, false);
+    for (const TPair<UISMRuntimeComponent*, TArray<int32>>& Group : GroupByComponent(SelectedHandles))
+        Group.Key->BatchDestroyInstances(Group.Value);
+    ResetSelection();
     BroadcastSelectionChanged();
 }
 
 TArray<AActor*> UISMSelectionSet::ConvertSelectedToActors(const FISMConversionContext& Context)
 {
-    PruneInvalidHandles();
+    if (PruneInvalidHandles()) BroadcastSelectionChanged();
     TArray<AActor*> Result;
+
+    // Physics components convert per component in one pool request; everything else one by one
+    TMap<UISMPhysicsComponent*, TArray<int32>> PhysicsBatches;
     for (const FISMInstanceHandle& H : SelectedHandles)
     {
         if (!H.IsValid()) continue;
         if (UISMRuntimeComponent* Comp = H.Component.Get())
         {
             FISMInstanceHandle& MutableHandle = Comp->GetOrCreateHandle(H.InstanceIndex);
+            UISMPhysicsComponent* PhysicsComp = Cast<UISMPhysicsComponent>(Comp);
+            if (PhysicsComp && !MutableHandle.IsConvertedToActor())
+            {
+                PhysicsBatches.FindOrAdd(PhysicsComp).Add(H.InstanceIndex);
+                continue;
+            }
             if (AActor* Actor = MutableHandle.ConvertToActor(Context))
                 Result.Add(Actor);
         }
     }
+
+    for (const TPair<UISMPhysicsComponent*, TArray<int32>>& Batch : PhysicsBatches)
+    {
+        Result.Append(Batch.Key->ConvertInstancesToPhysics(Batch.Value, Context.ImpactPoint, Context.ImpactForce, Context.Instigator));
+    }
     return Result;
 }
 
 void UISMSelectionSet::ReturnSelectedToISM(bool bDestroyActors, bool bUpdateTransforms)
 {
-    PruneInvalidHandles();
+    if (PruneInvalidHandles()) BroadcastSelectionChanged();
+
+    // Physics actors are pool-owned and go back through their per-actor path
+    TMap<UISMRuntimeComponent*, TArray<int32>> Batches;
     for (const FISMInstanceHandle& H : SelectedHandles)
     {
         if (!H.IsValid() || !H.IsConvertedToActor()) continue;
         if (UISMRuntimeComponent* Comp = H.Component.Get())
         {
             FISMInstanceHandle& MutableHandle = Comp->GetOrCreateHandle(H.InstanceIndex);
-            MutableHandle.ReturnToISM(bDestroyActors, bUpdateTransforms);
+            if (Cast<UISMPhysicsComponent>(Comp) || !MutableHandle.GetConvertedActor())
+            {
+                MutableHandle.ReturnToISM(bDestroyActors, bUpdateTransforms);
+                continue;
+            }
+            Batches.FindOrAdd(Comp).Add(H.InstanceIndex);
+        }
+    }
+
+    TArray<FISMInstanceHandle> Handles;
+    TArray<FTransform> FinalTransforms;
+    for (const TPair<UISMRuntimeComponent*, TArray<int32>>& Batch : Batches)
+    {
+        UISMRuntimeComponent* Comp = Batch.Key;
+        Handles.Reset();
+        FinalTransforms.Reset();
+        for (int32 Index : Batch.Value)
+        {
+            const FISMInstanceHandle& Handle = Comp->GetOrCreateHandle(Index);
+            const FTransform* PreConversionTransform = bUpdateTransforms
+                ? nullptr
+                : Comp->GetInstanceStateStore().GetLastVisibleTransform(Index);
+            Handles.Add(Handle);
+            FinalTransforms.Add(PreConversionTransform ? *PreConversionTransform
+                : bUpdateTransforms ? Handle.GetConvertedActor()->GetActorTransform()
+                : Comp->GetInstanceTransform(Index));
+        }
+
+        Comp->ReturnConvertedInstances(Handles, FinalTransforms);
+
+        // The actor side of FISMInstanceHandle::ReturnToISM, which the batch leaves to us
+        for (int32 i = 0; i < Handles.Num(); ++i)
+        {
+            FISMInstanceHandle& MutableHandle = Comp->GetOrCreateHandle(Handles[i].InstanceIndex);
+            AActor* Actor = MutableHandle.GetConvertedActor();
+            if (!Actor) continue;
+
+            bool bShouldDestroyActor = bDestroyActors;
+            Comp->OnReleaseConvertedActor.ExecuteIfBound(Actor, bShouldDestroyActor);
+            Comp->OnInstanceReturnedToISM.ExecuteIfBound(MutableHandle, FinalTransforms[i]);
+            if (bShouldDestroyActor) Actor->Destroy();
+            MutableHandle.ClearConvertedActor();
         }
     }
 }
@@ -189,6 +264,101 @@ void UISMSelectionSet::ReturnSelectedToISM(bool bDestroyActors, bool bUpdateTran
 //  Protected Helpers
 // ============================================================
 
+int32 UISMSelectionSet::FindPosition(const FISMInstanceHandle& Handle) const
+{
+    const FComponentSelection* Entry = ComponentSelections.Find(Handle.Component);
+    if (!Entry || !Entry->Positions.IsValidIndex(Handle.InstanceIndex)) return INDEX_NONE;
+
+    // Same slot, different generation: a recycled instance is not the one selected
+    const int32 Position = Entry->Positions[Handle.InstanceIndex];
+    return (Position != INDEX_NONE && SelectedHandles[Position] == Handle) ? Position : INDEX_NONE;
+}
+
+bool UISMSelectionSet::AddToSelection(const FISMInstanceHandle& Handle)
+{
+    if (Handle.InstanceIndex < 0) return false;
+
+    FComponentSelection& Entry = ComponentSelections.FindOrAdd(Handle.Component);
+    if (Entry.Positions.IsValidIndex(Handle.InstanceIndex))
+    {
+        const int32 Existing = Entry.Positions[Handle.InstanceIndex];
+        if (Existing != INDEX_NONE)
+        {
+            if (SelectedHandles[Existing] == Handle) return false;
+
+            // A stale handle for the recycled slot gives way to the live one
+            SelectedHandles[Existing] = FISMInstanceHandle();
+            ++NumPendingRemovals;
+            --Entry.NumSelected;
+        }
+    }
+    else
+    {
+        const int32 OldNum = Entry.Positions.Num();
+        Entry.Positions.SetNumUninitialized(Handle.InstanceIndex + 1);
+        for (int32 i = OldNum; i < Entry.Positions.Num(); ++i)
+            Entry.Positions[i] = INDEX_NONE;
+    }
+
+    Entry.Positions[Handle.InstanceIndex] = SelectedHandles.Add(Handle);
+    ++Entry.NumSelected;
+    return true;
+}
+
+bool UISMSelectionSet::RemoveFromSelection(const FISMInstanceHandle& Handle)
+{
+    const int32 Position = FindPosition(Handle);
+    if (Position == INDEX_NONE) return false;
+
+    FComponentSelection& Entry = ComponentSelections.FindChecked(Handle.Component);
+    Entry.Positions[Handle.InstanceIndex] = INDEX_NONE;
+    --Entry.NumSelected;
+
+    // Cleared entries have no index, which no selected handle has
+    SelectedHandles[Position] = FISMInstanceHandle();
+    ++NumPendingRemovals;
+    return true;
+}
+
+void UISMSelectionSet::CompactSelection()
+{
+    if (NumPendingRemovals == 0) return;
+    NumPendingRemovals = 0;
+
+    int32 Write = 0;
+    FComponentSelection* Entry = nullptr;
+    const UISMRuntimeComponent* EntryComponent = nullptr;
+    for (int32 Read = 0; Read < SelectedHandles.Num(); ++Read)
+    {
+        FISMInstanceHandle& H = SelectedHandles[Read];
+        if (H.InstanceIndex == INDEX_NONE) continue;
+
+        if (Write != Read)
+        {
+            // Neighbouring handles usually share a component; skip the lookup for runs
+            if (!Entry || H.Component.Get() != EntryComponent)
+            {
+                Entry = ComponentSelections.Find(H.Component);
+                EntryComponent = H.Component.Get();
+            }
+            if (Entry) Entry->Positions[H.InstanceIndex] = Write;
+            SelectedHandles[Write] = MoveTemp(H);
+        }
+        ++Write;
+    }
+    SelectedHandles.SetNum(Write, EAllowShrinking::No);
+
+    for (auto It = ComponentSelections.CreateIterator(); It; ++It)
+        if (It.Value().NumSelected <= 0) It.RemoveCurrent();
+}
+
+void UISMSelectionSet::ResetSelection()
+{
+    SelectedHandles.Reset();
+    ComponentSelections.Reset();
+    NumPendingRemovals = 0;
+}
+
 void UISMSelectionSet::ApplySelectionTag(const FISMInstanceHandle& Handle, bool bAdd) const
 {
     if (!SelectedTag.IsValid() || !Handle.IsValid()) return;
@@ -201,15 +371,60 @@ void UISMSelectionSet::ApplySelectionTag(const FISMInstanceHandle& Handle, bool
 
 void UISMSelectionSet::ApplySelectionTagBatch(const TArray<FISMInstanceHandle>& Handles, bool bAdd) const
 {
+    if (!SelectedTag.IsValid() || Handles.IsEmpty()) return;
+    for (const TPair<UISMRuntimeComponent*, TArray<int32>>& Group : GroupByComponent(Handles))
+    {
+        if (bAdd) Group.Key->BatchAddInstanceTag(Group.Value, SelectedTag);
+        else      Group.Key->BatchRemoveInstanceTag(Group.Value, SelectedTag);
+    }
+}
+
+TMap<UISMRuntimeComponent*, TArray<int32>> UISMSelectionSet::GroupByComponent(const TArray<FISMInstanceHandle>& Handles)
+{
+    TMap<UISMRuntimeComponent*, TArray<int32>> Groups;
+    TArray<int32>* Group = nullptr;
+    const UISMRuntimeComponent* GroupComponent = nullptr;
     for (const FISMInstanceHandle& H : Handles)
-        ApplySelectionTag(H, bAdd);
+    {
+        if (!H.IsValid()) continue;
+        UISMRuntimeComponent* Comp = H.Component.Get();
+        if (!Group || Comp != GroupComponent)
+        {
+            Group = &Groups.FindOrAdd(Comp);
+            GroupComponent = Comp;
+        }
+        Group->Add(H.InstanceIndex);
+    }
+    return Groups;
 }
 
-void UISMSelectionSet::PruneInvalidHandles()
+bool UISMSelectionSet::PruneInvalidHandles()
 {
-    const int32 Before = SelectedHandles.Num();
-    SelectedHandles.RemoveAll([](const FISMInstanceHandle& H) { return !H.IsValid(); });
-    if (SelectedHandles.Num() != Before) BroadcastSelectionChanged();
+    int32 Removed = 0;
+    for (auto It = ComponentSelections.CreateIterator(); It; ++It)
+    {
+        FComponentSelection& Entry = It.Value();
+        const UISMRuntimeComponent* Comp = It.Key().Get();
+
+        // Handles only go stale when their component dies or their slot is recycled (an add,
+        // which moves the query revision)
+        const uint64 Revision = Comp ? Comp->GetQueryRevision() : 0;
+        if (Comp && Revision == Entry.ValidatedRevision) continue;
+        Entry.ValidatedRevision = Revision;
+
+        for (int32& Position : Entry.Positions)
+        {
+            if (Position == INDEX_NONE || SelectedHandles[Position].IsValid()) continue;
+            SelectedHandles[Position] = FISMInstanceHandle();
+            Position = INDEX_NONE;
+            --Entry.NumSelected;
+            ++NumPendingRemovals;
+            ++Removed;
+        }
+    }
+
+    CompactSelection();
+    return Removed > 0;
 }
 
 void UISMSelectionSet::BroadcastSelectionChanged()
@@ -219,10 +434,13 @@ void UISMSelectionSet::BroadcastSelectionChanged()
 
 void UISMSelectionSet::EnforceSelectionLimit()
 {
-    if (MaxSelection <= 0) return;
-    while (SelectedHandles.Num() > MaxSelection)
-    {
-        ApplySelectionTag(SelectedHandles[0], false);
-        SelectedHandles.RemoveAt(0);
-    }
-}
\ No newline at end of file
+    if (MaxSelection <= 0 || SelectedHandles.Num() <= MaxSelection) return;
+
+    // Oldest entries go first, in one tag batch and one compaction
+    const int32 Excess = SelectedHandles.Num() - MaxSelection;
+    TArray<FISMInstanceHandle> Evicted(SelectedHandles.GetData(), Excess);
+    ApplySelectionTagBatch(Evicted, false);
+    for (const FISMInstanceHandle& H : Evicted)
+        RemoveFromSelection(H);
+    CompactSelection();
+}
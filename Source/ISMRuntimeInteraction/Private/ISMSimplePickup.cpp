@@ -1,5 +1,6 @@
 // ISMSimplePickup.cpp
 #include "ISMSimplePickup.h"
+#include "ISMRuntimeInteraction.h"
 
 #include "ISMInteractionComponent.h"
 #include "ISMRuntimeSubsystem.h"
@@ -74,6 +75,8 @@ void UISMSimplePickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void UISMSimplePickup::TickComponent(float DeltaTime, ELevelTick TickType,
     FActorComponentTickFunction* ThisTickFunction)
 {
+    LLM_SCOPE_BYTAG(ISMRuntime_Interaction);
+
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
     if (IsHolding() && HoldMode == EISMPickupHoldMode::Kinematic)
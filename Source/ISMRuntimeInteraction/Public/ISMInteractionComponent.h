@@ -127,6 +127,33 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Interaction|Targeting")
     FGameplayTag FocusTag;
 
+    /**
+     * Keep the current focus between full targeting queries.
+     * While the view holds still, the focused instance is revalidated with one cheap check
+     * (Raycast: the ray still enters its oriented bounds; SphereOverlap: it is still in range)
+     * instead of a full trace or radius query. A full query runs when the view moves past
+     * FocusReresolveDistance / FocusReresolveAngle, every FocusReresolveInterval, or when the
+     * check fails. Focus events are unchanged; a newly closer instance can take up to
+     * FocusReresolveInterval to win focus.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Interaction|Targeting")
+    bool bCoherentFocus = false;
+
+    /** Coherent focus: maximum time between full targeting queries (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Interaction|Targeting",
+        meta = (EditCondition = "bCoherentFocus", ClampMin = "0.0"))
+    float FocusReresolveInterval = 0.2f;
+
+    /** Coherent focus: origin movement (cm) that forces a full targeting query */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Interaction|Targeting",
+        meta = (EditCondition = "bCoherentFocus", ClampMin = "0.0"))
+    float FocusReresolveDistance = 5.0f;
+
+    /** Coherent focus: view rotation (degrees) that forces a full targeting query. Raycast only. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Interaction|Targeting",
+        meta = (EditCondition = "bCoherentFocus", ClampMin = "0.0", ClampMax = "180.0"))
+    float FocusReresolveAngle = 2.0f;
+
     // ===== Selection =====
 
     /**
@@ -296,6 +323,12 @@ protected:
     /** Cached subsystem reference */
     TWeakObjectPtr<UISMRuntimeSubsystem> CachedSubsystem;
 
+    /** Coherent focus: view at the last full targeting query, and time since it ran */
+    FVector LastResolveLocation = FVector::ZeroVector;
+    FVector LastResolveForward = FVector::ForwardVector;
+    float TimeSinceFullResolve = 0.0f;
+    bool bHasResolvedView = false;
+
     // ===== Internal Targeting =====
 
     /**
@@ -304,6 +337,15 @@ protected:
      */
     FISMInstanceHandle ResolveTargetThisFrame() const;
 
+    /**
+     * Coherent focus: keep the current focus while the view holds still and it passes
+     * IsFocusRetained, otherwise run ResolveTargetThisFrame.
+     */
+    FISMInstanceHandle ResolveTargetCoherent(float DeltaTime);
+
+    /** The cheap per-frame check that the current focus is still targetable from this view */
+    bool IsFocusRetained(const FVector& Origin, const FVector& Forward) const;
+
     /** Raycast targeting implementation */
     FISMInstanceHandle ResolveByRaycast() const;
 
@@ -5,10 +5,13 @@
 #include "Interfaces/ISMConvertible.h"
 #include "ISMInstanceHandle.h"
 #include "ISMSelectionSet.h"
+#include "ISMQueryFilter.h"
 #include "Delegates/DelegateCombinations.h"
 #include "ISMPreviewContext.generated.h"
 
 class UISMRuntimeComponent;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
 
 /**
  * What kind of pending action the preview represents.
@@ -60,6 +63,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnISMPreviewResolved,
     EISMPreviewState, State,
     const TArray<FISMInstanceHandle>&, AffectedHandles);
 
+/** Fired when a validated placement preview starts or stops overlapping other instances */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnISMPlacementValidityChanged, bool, bIsValid);
+
 /**
  * Wraps a selection set into a coherent pending operation with confirm/cancel
  * semantics. Manages the lifecycle of preview actors and reserved instance slots.
@@ -79,6 +85,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnISMPreviewResolved,
  *   4. Confirm() clears Reserved flag, instance becomes real
  *   5. Cancel() removes the reserved instance entirely
  *
+ * With bUseInstancedPreview the previews are instances of one transient ISM per mesh
+ * rather than preview actors.
+ *
  * This component is intended to be short-lived — created when a preview
  * begins, destroyed when it resolves. It does not persist between operations.
  */
@@ -115,6 +124,42 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Preview")
     float PreviewMaterialDataValue = 1.0f;
 
+    /**
+     * Render the preview through one transient ISM per mesh instead of an actor per handle.
+     * Large destroy/move previews then cost one component per mesh, and RefreshPreview /
+     * UpdatePreviewTransforms rewrite instances in bulk. PreviewActorClass is not used.
+     * Set before BeginPreview / BeginPlacementPreview.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Preview")
+    bool bUseInstancedPreview = false;
+
+    /**
+     * Instanced preview: material for every slot of the preview ISMs.
+     * If null the source ISM's materials are used, with PreviewMaterialDataValue written to
+     * per-instance custom data PreviewMaterialDataIndex for the material to read.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Preview", meta = (EditCondition = "bUseInstancedPreview"))
+    TObjectPtr<UMaterialInterface> PreviewMaterial = nullptr;
+
+    /**
+     * Placement preview: test the placement's world bounds against other instances' AABBs on
+     * every move (see IsPlacementValid). Candidates are gathered once for a neighbourhood
+     * PlacementCachePadding around the placement; moves inside it only re-test that set, and it
+     * is re-queried when the placement leaves it or any component's instances change.
+     * Set before BeginPlacementPreview.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Preview|Placement")
+    bool bValidatePlacement = false;
+
+    /** Instances that can block a placement; empty = all */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Preview|Placement", meta = (EditCondition = "bValidatePlacement"))
+    FISMQueryFilter PlacementFilter;
+
+    /** How far (cm) the cached neighbourhood reaches past the placement's bounds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Preview|Placement",
+        meta = (EditCondition = "bValidatePlacement", ClampMin = "0.0"))
+    float PlacementCachePadding = 500.0f;
+
     // ===== Lifecycle =====
 
     /**
@@ -146,6 +191,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Preview")
     void UpdatePlacementTransform(const FTransform& NewTransform);
 
+    /**
+     * Move or place the previews of a Destroy/Move preview in one call.
+     * @param NewTransforms World transforms parallel to GetPreviewHandles()
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Preview")
+    void UpdatePreviewTransforms(const TArray<FTransform>& NewTransforms);
+
+    /**
+     * Re-sync a Destroy/Move preview with its selection set after the selection changed.
+     * Deselected instances are shown again, newly selected ones hidden, and handles still
+     * selected keep their preview transform. The preview is rebuilt in bulk.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Preview")
+    void RefreshPreview();
+
     /**
      * Confirm the pending operation.
      * Destroy preview: destroys original instances, removes preview actors.
@@ -184,16 +244,32 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Preview")
     const TArray<FISMInstanceHandle>& GetPreviewHandles() const { return PreviewHandles; }
 
+    /** Validated placement: true while the placement overlaps no instance passing PlacementFilter */
+    UFUNCTION(BlueprintCallable, Category = "ISM Preview")
+    bool IsPlacementValid() const { return bPlacementValid; }
+
+    /** Validated placement: the instances the placement currently overlaps */
+    UFUNCTION(BlueprintCallable, Category = "ISM Preview")
+    const TArray<FISMInstanceHandle>& GetPlacementOverlaps() const { return PlacementOverlaps; }
+
     /** Get all spawned preview actors */
     UFUNCTION(BlueprintCallable, Category = "ISM Preview")
     const TArray<AActor*> GetPreviewActors() const;
 
+    /** Get the transient preview ISMs, one per mesh (instanced preview only) */
+    UFUNCTION(BlueprintCallable, Category = "ISM Preview")
+    TArray<UInstancedStaticMeshComponent*> GetPreviewISMs() const;
+
     // ===== Events =====
 
     /** Fired when the preview is confirmed or cancelled */
     UPROPERTY(BlueprintAssignable, Category = "ISM Preview|Events")
     FOnISMPreviewResolved OnPreviewResolved;
 
+    /** Fired when a validated placement preview becomes blocked or clear */
+    UPROPERTY(BlueprintAssignable, Category = "ISM Preview|Events")
+    FOnISMPlacementValidityChanged OnPlacementValidityChanged;
+
 protected:
     // ===== Internal State =====
 
@@ -218,6 +294,35 @@ protected:
     UPROPERTY()
     FISMInstanceHandle PlacementHandle;
 
+    /** Instanced preview: transient ISMs, one per mesh */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UInstancedStaticMeshComponent>> PreviewISMs;
+
+    /** Where a handle's preview lives in PreviewISMs */
+    struct FPreviewInstance
+    {
+        int32 ISMIndex = INDEX_NONE;
+        int32 InstanceIndex = INDEX_NONE;
+    };
+
+    /** Instanced preview: one per handle (parallel to PreviewHandles; the placement preview uses entry 0) */
+    TArray<FPreviewInstance> PreviewInstances;
+
+    // ===== Placement Validation =====
+
+    bool bPlacementValid = true;
+
+    TArray<FISMInstanceHandle> PlacementOverlaps;
+
+    /** Neighbourhood the cached candidates were gathered for; invalid = nothing cached */
+    FBox PlacementNeighbourhood = FBox(ForceInit);
+
+    /** Instances whose AABB overlapped the neighbourhood when it was gathered */
+    TArray<FISMInstanceHandle> PlacementCandidates;
+
+    /** Every registered component's query revision when the cache was last confirmed current */
+    TArray<TPair<TWeakObjectPtr<UISMRuntimeComponent>, uint64>> PlacementCacheRevisions;
+
     /** The selection set this preview was built from (weak ref, not owned) */
     UPROPERTY()
     TWeakObjectPtr<UISMSelectionSet> SourceSelectionSet;
@@ -227,12 +332,40 @@ protected:
     /** Spawn a preview actor for the given handle */
     AActor* SpawnPreviewActorForHandle(const FISMInstanceHandle& Handle);
 
-    /** Remove and destroy all preview actors */
-    void CleanupPreviewActors();
+    /** Spawn a preview actor at a world transform */
+    AActor* SpawnPreviewActor(const FTransform& Transform);
+
+    /**
+     * Build the preview of Handles at Transforms (parallel arrays): preview actors, or with
+     * bUseInstancedPreview one AddInstances per preview ISM
+     */
+    void BuildPreview(const TArray<FISMInstanceHandle>& Handles, const TArray<FTransform>& Transforms);
+
+    /** Current world transform of the preview of handle i (or the placement preview for 0) */
+    bool GetPreviewTransform(int32 PreviewIdx, FTransform& OutTransform) const;
+
+    /** The preview ISM for Source's mesh, created on first use */
+    UInstancedStaticMeshComponent* FindOrCreatePreviewISM(const UInstancedStaticMeshComponent* Source);
+
+    /** Remove and destroy all preview actors, and clear or destroy the preview ISMs */
+    void CleanupPreviewActors(bool bDestroyPreviewISMs = true);
 
     /** Apply the preview material data value to a spawned preview actor */
     void ApplyPreviewMaterial(AActor* PreviewActor) const;
 
+    /** No component's instances changed since PlacementCacheRevisions was recorded */
+    bool IsPlacementCacheCurrent() const;
+
+    /** Record every registered component's query revision into PlacementCacheRevisions */
+    void RecordPlacementCacheRevisions();
+
+    /**
+     * Re-test the placement at Transform, re-gathering the neighbourhood first if it is stale
+     * or no longer contains the placement. Fires OnPlacementValidityChanged on a change.
+     * @param bCacheCurrent Result of IsPlacementCacheCurrent taken before this move's own write
+     */
+    void UpdatePlacementValidity(const FTransform& Transform, bool bCacheCurrent);
+
     /** Validate that the preview is in Pending state before an operation */
     bool EnsurePending(const FString& OperationName) const;
 };
\ No newline at end of file
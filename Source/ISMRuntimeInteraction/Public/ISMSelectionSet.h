@@ -40,6 +40,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnISMSelectionChanged, const TArray
  * current selection. Provides batch operations used by the interaction module
  * and the preview conversion system.
  *
+ * Membership is indexed per component by instance index, so IsSelected, deselect and
+ * per-handle dedup are O(1) and a 5k box select stays linear. Removals are compacted once
+ * per operation. Tag writes and destruction are grouped per component.
+ *
  * Designed to be either:
  *   (a) A component on the player/controller — owns persistent selection state
  *   (b) A transient struct owned by a preview context — scoped to one operation
@@ -106,6 +110,12 @@ public:
     void SelectInstancesInBox(const FBox& Box,
         const FISMQueryFilter& Filter, EISMSelectionMode Mode = EISMSelectionMode::Replace);
 
+    /** Native forms taking a filter compiled once (FISMQueryFilter::Compile) and reused across frames */
+    void SelectInstancesInRadius(const FVector& Center, float Radius,
+        const FISMCompiledQueryFilter& Filter, EISMSelectionMode Mode = EISMSelectionMode::Replace);
+    void SelectInstancesInBox(const FBox& Box,
+        const FISMCompiledQueryFilter& Filter, EISMSelectionMode Mode = EISMSelectionMode::Replace);
+
     /** Deselect a single instance */
     UFUNCTION(BlueprintCallable, Category = "ISM Selection")
     void DeselectInstance(const FISMInstanceHandle& Handle);
@@ -151,7 +161,9 @@ public:
 
     /**
      * Return all selected converted instances back to ISM.
-     * Only affects instances that are currently converted.
+     * Only affects instances that are currently converted. The ISM side of each component's
+     * returns is written in one ReturnConvertedInstances batch; physics components keep their
+     * pooled per-actor path.
      */
     UFUNCTION(BlueprintCallable, Category = "ISM Selection|Batch")
     void ReturnSelectedToISM(bool bDestroyActors = true, bool bUpdateTransforms = true);
@@ -167,14 +179,54 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "ISM Selection")
     TArray<FISMInstanceHandle> SelectedHandles;
 
+    /** Selection index for one component */
+    struct FComponentSelection
+    {
+        /** Position in SelectedHandles by instance index, INDEX_NONE when not selected */
+        TArray<int32> Positions;
+
+        int32 NumSelected = 0;
+
+        /** Component query revision at the last stale-handle check; unchanged means no slot was recycled */
+        uint64 ValidatedRevision = 0;
+    };
+
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, FComponentSelection> ComponentSelections;
+
+    /** Entries of SelectedHandles cleared by RemoveFromSelection and awaiting CompactSelection */
+    int32 NumPendingRemovals = 0;
+
+    /** Position of Handle in SelectedHandles, INDEX_NONE if not selected */
+    int32 FindPosition(const FISMInstanceHandle& Handle) const;
+
+    /** Append Handle; false if already selected */
+    bool AddToSelection(const FISMInstanceHandle& Handle);
+
+    /** Clear Handle's entry in place; false if not selected. CompactSelection closes the gaps. */
+    bool RemoveFromSelection(const FISMInstanceHandle& Handle);
+
+    /** Drop cleared entries in one pass, keeping order, and reindex the moved ones */
+    void CompactSelection();
+
+    /** Empty the selection and its index (no tag writes) */
+    void ResetSelection();
+
     /** Write or remove the SelectedTag on an instance */
     void ApplySelectionTag(const FISMInstanceHandle& Handle, bool bAdd) const;
 
-    /** Apply tag changes for a batch of handles efficiently */
+    /** Apply tag changes for a batch of handles, one batched write per component */
     void ApplySelectionTagBatch(const TArray<FISMInstanceHandle>& Handles, bool bAdd) const;
 
-    /** Remove stale handles (component destroyed, instance destroyed, etc.) */
-    void PruneInvalidHandles();
+    /** Instance indices of Handles grouped by component, valid handles only */
+    static TMap<UISMRuntimeComponent*, TArray<int32>> GroupByComponent(const TArray<FISMInstanceHandle>& Handles);
+
+    /**
+     * Remove stale handles (component destroyed, instance destroyed, etc.).
+     * Only components whose query revision moved since their last check are rescanned.
+     * Does not broadcast: returns true if anything was removed so callers can fold it
+     * into their own single BroadcastSelectionChanged.
+     */
+    bool PruneInvalidHandles();
 
     /** Broadcast OnSelectionChanged */
     void BroadcastSelectionChanged();
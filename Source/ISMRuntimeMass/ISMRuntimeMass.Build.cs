@@ -0,0 +1,30 @@
+// Copyright Max Harris
+
+using UnrealBuildTool;
+
+public class ISMRuntimeMass : ModuleRules
+{
+    public ISMRuntimeMass(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "ISMRuntimeCore",
+                "GameplayTags",
+                "MassEntity",
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+
+            }
+        );
+    }
+}
@@ -0,0 +1,380 @@
+// ISMMassBridgeSubsystem.cpp
+#include "ISMMassBridgeSubsystem.h"
+#include "ISMMassFragments.h"
+#include "ISMRuntimeMass.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMRuntimeProfiling.h"
+#include "Batching/ISMBatchScheduler.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassCommandBuffer.h"
+
+bool UISMMassBridgeSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMMassBridgeSubsystem::Deinitialize()
+{
+    FMassEntityManager* EntityManager = GetEntityManager();
+    for (TPair<TObjectKey<UISMRuntimeComponent>, FMirroredComponent>& Pair : MirroredComponents)
+    {
+        UnbindComponent(Pair.Value);
+        if (EntityManager)
+        {
+            TArray<FMassEntityHandle> Entities;
+            Pair.Value.Entities.GenerateValueArray(Entities);
+            DestroyEntities(*EntityManager, Entities);
+        }
+    }
+    MirroredComponents.Reset();
+    Super::Deinitialize();
+}
+
+FMassEntityManager* UISMMassBridgeSubsystem::GetEntityManager() const
+{
+    UWorld* World = GetWorld();
+    UMassEntitySubsystem* EntitySubsystem = World ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+    return EntitySubsystem ? &EntitySubsystem->GetMutableEntityManager() : nullptr;
+}
+
+UISMMassBridgeSubsystem::FMirroredComponent& UISMMassBridgeSubsystem::FindOrAddMirrored(
+    UISMRuntimeComponent* Component, const FISMMassMirrorSettings& Settings, FMassEntityManager& EntityManager)
+{
+    if (FMirroredComponent* Existing = MirroredComponents.Find(Component))
+    {
+        return *Existing;
+    }
+
+    FMirroredComponent& Mirrored = MirroredComponents.Add(Component);
+    Mirrored.Component = Component;
+    Mirrored.Settings = Settings;
+    Mirrored.Settings.FirstCustomDataSlot = FMath::Max(0, Settings.FirstCustomDataSlot);
+    Mirrored.Settings.NumCustomDataSlots = FMath::Clamp(Settings.NumCustomDataSlots, 0, FISMMassCustomDataFragment::MaxSlots);
+
+    // Components with the same settings share an archetype; FISMMassComponentFragment splits the chunks
+    TArray<const UScriptStruct*, TInlineAllocator<8>> Composition = {
+        FISMMassMirroredTag::StaticStruct(),
+        FISMMassComponentFragment::StaticStruct(),
+        FISMMassInstanceFragment::StaticStruct(),
+        FISMMassStateFragment::StaticStruct(),
+        FISMMassSyncFragment::StaticStruct(),
+    };
+    if (Mirrored.Settings.NumCustomDataSlots > 0)
+    {
+        Composition.Add(FISMMassCustomDataFragment::StaticStruct());
+    }
+    if (Mirrored.Settings.bMirrorTags)
+    {
+        Composition.Add(FISMMassTagsFragment::StaticStruct());
+    }
+    Mirrored.Archetype = EntityManager.CreateArchetype(Composition);
+
+    Mirrored.StateChangedHandle = Component->OnInstanceStateChangedNative.AddUObject(this, &UISMMassBridgeSubsystem::HandleInstanceChanged);
+    Mirrored.TagsChangedHandle = Component->OnInstanceTagsChangedNative.AddUObject(this, &UISMMassBridgeSubsystem::HandleInstanceChanged);
+    Mirrored.DestroyedHandle = Component->OnInstanceDestroyedNative.AddUObject(this, &UISMMassBridgeSubsystem::HandleInstanceChanged);
+    Mirrored.BatchChangedHandle = Component->OnInstancesChangedBatchNative.AddUObject(this, &UISMMassBridgeSubsystem::HandleInstancesChanged);
+    return Mirrored;
+}
+
+void UISMMassBridgeSubsystem::UnbindComponent(FMirroredComponent& Mirrored) const
+{
+    UISMRuntimeComponent* Component = Mirrored.Component.Get();
+    if (!Component)
+    {
+        return;
+    }
+
+    Component->OnInstanceStateChangedNative.Remove(Mirrored.StateChangedHandle);
+    Component->OnInstanceTagsChangedNative.Remove(Mirrored.TagsChangedHandle);
+    Component->OnInstanceDestroyedNative.Remove(Mirrored.DestroyedHandle);
+    Component->OnInstancesChangedBatchNative.Remove(Mirrored.BatchChangedHandle);
+}
+
+int32 UISMMassBridgeSubsystem::MirrorInstances(UISMRuntimeComponent* Component, TConstArrayView<int32> InstanceIndices, const FISMMassMirrorSettings& Settings)
+{
+    ISM_TRACE_SCOPE(UISMMassBridgeSubsystem::MirrorInstances);
+    LLM_SCOPE_BYTAG(ISMRuntime_Mass);
+
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!Component || !EntityManager || InstanceIndices.IsEmpty())
+    {
+        return 0;
+    }
+
+    FMirroredComponent& Mirrored = FindOrAddMirrored(Component, Settings, *EntityManager);
+
+    TArray<int32> NewIndices;
+    NewIndices.Reserve(InstanceIndices.Num());
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        if (Component->IsValidInstanceIndex(InstanceIndex) && !Component->IsInstanceDestroyed(InstanceIndex)
+            && !Mirrored.Entities.Contains(InstanceIndex))
+        {
+            NewIndices.Add(InstanceIndex);
+        }
+    }
+    if (NewIndices.IsEmpty())
+    {
+        return 0;
+    }
+
+    FISMMassComponentFragment ComponentFragment;
+    ComponentFragment.Component = Component;
+    FMassArchetypeSharedFragmentValues SharedValues;
+    SharedValues.AddConstSharedFragment(EntityManager->GetOrCreateConstSharedFragment(ComponentFragment));
+    SharedValues.Sort();
+
+    TArray<FMassEntityHandle> Entities;
+    EntityManager->BatchCreateEntities(Mirrored.Archetype, SharedValues, NewIndices.Num(), Entities);
+    check(Entities.Num() == NewIndices.Num());
+
+    Mirrored.Entities.Reserve(Mirrored.Entities.Num() + NewIndices.Num());
+    for (int32 i = 0; i < NewIndices.Num(); i++)
+    {
+        Mirrored.Entities.Add(NewIndices[i], Entities[i]);
+        CopyToEntity(*EntityManager, Mirrored, NewIndices[i], Entities[i]);
+    }
+    return NewIndices.Num();
+}
+
+void UISMMassBridgeSubsystem::CopyToEntity(FMassEntityManager& EntityManager, const FMirroredComponent& Mirrored, int32 InstanceIndex, FMassEntityHandle Entity) const
+{
+    const UISMRuntimeComponent* Component = Mirrored.Component.Get();
+    if (!Component || !EntityManager.IsEntityActive(Entity))
+    {
+        return;
+    }
+
+    FISMMassInstanceFragment& Instance = EntityManager.GetFragmentDataChecked<FISMMassInstanceFragment>(Entity);
+    Instance.InstanceIndex = InstanceIndex;
+    Instance.Generation = Component->GetInstanceGeneration(InstanceIndex);
+
+    EntityManager.GetFragmentDataChecked<FISMMassStateFragment>(Entity).StateFlags = Component->GetInstanceStateFlags(InstanceIndex);
+
+    // The component is the source of truth again; pending entity edits are superseded
+    EntityManager.GetFragmentDataChecked<FISMMassSyncFragment>(Entity).DirtyFields = 0;
+
+    if (Mirrored.Settings.NumCustomDataSlots > 0)
+    {
+        FISMMassCustomDataFragment& CustomData = EntityManager.GetFragmentDataChecked<FISMMassCustomDataFragment>(Entity);
+        CustomData.FirstSlot = Mirrored.Settings.FirstCustomDataSlot;
+        CustomData.NumSlots = Mirrored.Settings.NumCustomDataSlots;
+        for (int32 i = 0; i < CustomData.NumSlots; i++)
+        {
+            CustomData.Values[i] = Component->GetInstanceCustomDataValue(InstanceIndex, CustomData.FirstSlot + i);
+        }
+    }
+
+    if (Mirrored.Settings.bMirrorTags)
+    {
+        FGameplayTagContainer& Tags = EntityManager.GetFragmentDataChecked<FISMMassTagsFragment>(Entity).Tags;
+        Tags = Component->GetInstanceTags(InstanceIndex);
+        Tags.RemoveTags(Component->ISMComponentTags);
+    }
+}
+
+void UISMMassBridgeSubsystem::DestroyEntities(FMassEntityManager& EntityManager, TConstArrayView<FMassEntityHandle> Entities) const
+{
+    if (Entities.IsEmpty())
+    {
+        return;
+    }
+
+    // Structural changes are not allowed while processors run
+    if (EntityManager.IsProcessing())
+    {
+        EntityManager.Defer().DestroyEntities(Entities);
+        return;
+    }
+    EntityManager.BatchDestroyEntities(Entities);
+}
+
+void UISMMassBridgeSubsystem::ReleaseInstances(UISMRuntimeComponent* Component, TConstArrayView<int32> InstanceIndices)
+{
+    FMirroredComponent* Mirrored = MirroredComponents.Find(Component);
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!Mirrored || !EntityManager)
+    {
+        return;
+    }
+
+    TArray<FMassEntityHandle> Entities;
+    Entities.Reserve(InstanceIndices.Num());
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        FMassEntityHandle Entity;
+        if (Mirrored->Entities.RemoveAndCopyValue(InstanceIndex, Entity))
+        {
+            Entities.Add(Entity);
+        }
+    }
+    DestroyEntities(*EntityManager, Entities);
+}
+
+void UISMMassBridgeSubsystem::ReleaseComponent(UISMRuntimeComponent* Component)
+{
+    FMirroredComponent Mirrored;
+    if (!MirroredComponents.RemoveAndCopyValue(Component, Mirrored))
+    {
+        return;
+    }
+
+    UnbindComponent(Mirrored);
+    if (FMassEntityManager* EntityManager = GetEntityManager())
+    {
+        TArray<FMassEntityHandle> Entities;
+        Mirrored.Entities.GenerateValueArray(Entities);
+        DestroyEntities(*EntityManager, Entities);
+    }
+}
+
+void UISMMassBridgeSubsystem::PruneStaleComponents()
+{
+    FMassEntityManager* EntityManager = GetEntityManager();
+    for (auto It = MirroredComponents.CreateIterator(); It; ++It)
+    {
+        if (It->Value.Component.IsValid())
+        {
+            continue;
+        }
+
+        if (EntityManager)
+        {
+            TArray<FMassEntityHandle> Entities;
+            It->Value.Entities.GenerateValueArray(Entities);
+            DestroyEntities(*EntityManager, Entities);
+        }
+        It.RemoveCurrent();
+    }
+}
+
+FMassEntityHandle UISMMassBridgeSubsystem::GetInstanceEntity(const UISMRuntimeComponent* Component, int32 InstanceIndex) const
+{
+    const FMirroredComponent* Mirrored = MirroredComponents.Find(Component);
+    const FMassEntityHandle* Entity = Mirrored ? Mirrored->Entities.Find(InstanceIndex) : nullptr;
+    return Entity ? *Entity : FMassEntityHandle();
+}
+
+int32 UISMMassBridgeSubsystem::GetNumMirroredInstances() const
+{
+    int32 Num = 0;
+    for (const TPair<TObjectKey<UISMRuntimeComponent>, FMirroredComponent>& Pair : MirroredComponents)
+    {
+        Num += Pair.Value.Entities.Num();
+    }
+    return Num;
+}
+
+void UISMMassBridgeSubsystem::RefreshInstances(UISMRuntimeComponent* Component, TConstArrayView<int32> InstanceIndices)
+{
+    FMirroredComponent* Mirrored = MirroredComponents.Find(Component);
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!Mirrored || !EntityManager)
+    {
+        return;
+    }
+
+    TArray<int32> Released;
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        const FMassEntityHandle* Entity = Mirrored->Entities.Find(InstanceIndex);
+        if (!Entity)
+        {
+            continue;
+        }
+
+        if (!Component->IsValidInstanceIndex(InstanceIndex) || Component->IsInstanceDestroyed(InstanceIndex))
+        {
+            Released.Add(InstanceIndex);
+            continue;
+        }
+        CopyToEntity(*EntityManager, *Mirrored, InstanceIndex, *Entity);
+    }
+
+    if (!Released.IsEmpty())
+    {
+        ReleaseInstances(Component, Released);
+    }
+}
+
+void UISMMassBridgeSubsystem::HandleInstanceChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
+{
+    if (bApplyingSync)
+    {
+        return;
+    }
+    RefreshInstances(Component, MakeArrayView(&InstanceIndex, 1));
+}
+
+void UISMMassBridgeSubsystem::HandleInstancesChanged(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices)
+{
+    if (bApplyingSync)
+    {
+        return;
+    }
+    RefreshInstances(Component, InstanceIndices);
+}
+
+void UISMMassBridgeSubsystem::ApplySync(UISMRuntimeComponent* Component, const FISMBatchMutationResult& Result,
+    TConstArrayView<TPair<int32, FGameplayTagContainer>> TagWrites)
+{
+    ISM_TRACE_SCOPE(UISMMassBridgeSubsystem::ApplySync);
+    LLM_SCOPE_BYTAG(ISMRuntime_Mass);
+
+    if (!Component || !MirroredComponents.Contains(Component))
+    {
+        return;
+    }
+
+    TGuardValue<bool> ApplyingGuard(bApplyingSync, true);
+
+    if (!Result.Streams.IsEmpty() || !Result.Mutations.IsEmpty())
+    {
+        UWorld* World = GetWorld();
+        UISMRuntimeSubsystem* RuntimeSubsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+        if (UISMBatchSchedulerBase* Scheduler = RuntimeSubsystem ? RuntimeSubsystem->GetOrCreateBatchSchduler() : nullptr)
+        {
+            Scheduler->ApplyExternalResult(Result);
+        }
+    }
+
+    if (TagWrites.IsEmpty())
+    {
+        return;
+    }
+
+    // Mutation results carry no tags; diff against the instance's own tags and batch per tag
+    TMap<FGameplayTag, TArray<int32>> Added;
+    TMap<FGameplayTag, TArray<int32>> Removed;
+    for (const TPair<int32, FGameplayTagContainer>& Write : TagWrites)
+    {
+        FGameplayTagContainer Current = Component->GetInstanceTags(Write.Key);
+        Current.RemoveTags(Component->ISMComponentTags);
+
+        for (const FGameplayTag& Tag : Write.Value)
+        {
+            if (!Current.HasTagExact(Tag))
+            {
+                Added.FindOrAdd(Tag).Add(Write.Key);
+            }
+        }
+        for (const FGameplayTag& Tag : Current)
+        {
+            if (!Write.Value.HasTagExact(Tag))
+            {
+                Removed.FindOrAdd(Tag).Add(Write.Key);
+            }
+        }
+    }
+
+    for (const TPair<FGameplayTag, TArray<int32>>& Pair : Removed)
+    {
+        Component->BatchRemoveInstanceTag(Pair.Value, Pair.Key);
+    }
+    for (const TPair<FGameplayTag, TArray<int32>>& Pair : Added)
+    {
+        Component->BatchAddInstanceTag(Pair.Value, Pair.Key);
+    }
+}
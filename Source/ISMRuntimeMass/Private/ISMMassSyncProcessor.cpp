@@ -0,0 +1,115 @@
+// ISMMassSyncProcessor.cpp
+#include "ISMMassSyncProcessor.h"
+#include "ISMMassBridgeSubsystem.h"
+#include "ISMMassFragments.h"
+#include "ISMRuntimeMass.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeProfiling.h"
+#include "Batching/ISMBatchTypes.h"
+#include "MassExecutionContext.h"
+
+UISMMassSyncProcessor::UISMMassSyncProcessor()
+    : EntityQuery(*this)
+{
+    ProcessingPhase = EMassProcessingPhase::PostPhysics;
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+    bRequiresGameThreadExecution = true;
+}
+
+void UISMMassSyncProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+    EntityQuery.AddTagRequirement<FISMMassMirroredTag>(EMassFragmentPresence::All);
+    EntityQuery.AddConstSharedRequirement<FISMMassComponentFragment>();
+    EntityQuery.AddRequirement<FISMMassInstanceFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FISMMassStateFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FISMMassSyncFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FISMMassCustomDataFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+    EntityQuery.AddRequirement<FISMMassTagsFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+}
+
+void UISMMassSyncProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    ISM_TRACE_SCOPE(UISMMassSyncProcessor::Execute);
+    LLM_SCOPE_BYTAG(ISMRuntime_Mass);
+
+    UWorld* World = EntityManager.GetWorld();
+    UISMMassBridgeSubsystem* Bridge = World ? World->GetSubsystem<UISMMassBridgeSubsystem>() : nullptr;
+    if (!Bridge)
+    {
+        return;
+    }
+    Bridge->PruneStaleComponents();
+
+    struct FComponentSync
+    {
+        FISMBatchMutationResult Result;
+        TArray<TPair<int32, FGameplayTagContainer>> TagWrites;
+    };
+    TMap<UISMRuntimeComponent*, FComponentSync> Syncs;
+
+    EntityQuery.ForEachEntityChunk(Context, [&Syncs](FMassExecutionContext& ChunkContext)
+    {
+        UISMRuntimeComponent* Component = ChunkContext.GetConstSharedFragment<FISMMassComponentFragment>().Component.Get();
+        if (!Component)
+        {
+            return;
+        }
+
+        const TConstArrayView<FISMMassInstanceFragment> Instances = ChunkContext.GetFragmentView<FISMMassInstanceFragment>();
+        const TConstArrayView<FISMMassStateFragment> States = ChunkContext.GetFragmentView<FISMMassStateFragment>();
+        const TArrayView<FISMMassSyncFragment> SyncFlags = ChunkContext.GetMutableFragmentView<FISMMassSyncFragment>();
+        const TConstArrayView<FISMMassCustomDataFragment> CustomData = ChunkContext.GetFragmentView<FISMMassCustomDataFragment>();
+        const TConstArrayView<FISMMassTagsFragment> Tags = ChunkContext.GetFragmentView<FISMMassTagsFragment>();
+
+        FComponentSync* Sync = nullptr;
+        for (int32 i = 0; i < ChunkContext.GetNumEntities(); i++)
+        {
+            FISMMassSyncFragment& SyncFlag = SyncFlags[i];
+            if (!SyncFlag.IsDirty())
+            {
+                continue;
+            }
+
+            const EISMMassField Dirty = static_cast<EISMMassField>(SyncFlag.DirtyFields);
+            SyncFlag.DirtyFields = 0;
+
+            // The slot was recycled after mirroring; the edit belongs to an instance that is gone
+            const FISMMassInstanceFragment& Instance = Instances[i];
+            if (Component->GetInstanceGeneration(Instance.InstanceIndex) != Instance.Generation)
+            {
+                continue;
+            }
+
+            if (!Sync)
+            {
+                Sync = &Syncs.FindOrAdd(Component);
+                Sync->Result.TargetComponent = Component;
+            }
+
+            if (EnumHasAnyFlags(Dirty, EISMMassField::StateFlags))
+            {
+                const uint8 Flags = States[i].StateFlags;
+                Sync->Result.Streams.AddStateFlags(Instance.InstanceIndex, Flags, static_cast<uint8>(~Flags));
+                Sync->Result.WrittenFields |= EISMSnapshotField::StateFlags;
+            }
+            if (EnumHasAnyFlags(Dirty, EISMMassField::CustomData) && !CustomData.IsEmpty())
+            {
+                const FISMMassCustomDataFragment& Data = CustomData[i];
+                for (int32 Slot = 0; Slot < Data.NumSlots; Slot++)
+                {
+                    Sync->Result.Streams.AddCustomData(Instance.InstanceIndex, Data.FirstSlot + Slot, Data.Values[Slot]);
+                }
+                Sync->Result.WrittenFields |= EISMSnapshotField::CustomData;
+            }
+            if (EnumHasAnyFlags(Dirty, EISMMassField::Tags) && !Tags.IsEmpty())
+            {
+                Sync->TagWrites.Emplace(Instance.InstanceIndex, Tags[i].Tags);
+            }
+        }
+    });
+
+    for (TPair<UISMRuntimeComponent*, FComponentSync>& Pair : Syncs)
+    {
+        Bridge->ApplySync(Pair.Key, Pair.Value.Result, Pair.Value.TagWrites);
+    }
+}
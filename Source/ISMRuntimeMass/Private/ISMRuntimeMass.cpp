@@ -0,0 +1,17 @@
+#include "ISMRuntimeMass.h"
+
+LLM_DEFINE_TAG(ISMRuntime_Mass);
+
+#define LOCTEXT_NAMESPACE "FISMRuntimeMassModule"
+
+void FISMRuntimeMass::StartupModule()
+{
+}
+
+void FISMRuntimeMass::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FISMRuntimeMass, ISMRuntimeMass)
@@ -0,0 +1,121 @@
+// ISMMassBridgeSubsystem.h
+// ISMRuntimeMass Module
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "MassEntityTypes.h"
+#include "GameplayTagContainer.h"
+#include "ISMMassBridgeSubsystem.generated.h"
+
+class UISMRuntimeComponent;
+struct FMassEntityManager;
+struct FISMBatchMutationResult;
+
+/** What a component's mirrored entities carry besides instance index and state flags */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEMASS_API FISMMassMirrorSettings
+{
+    GENERATED_BODY()
+
+    /** First custom data slot mirrored into FISMMassCustomDataFragment */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Mass", meta = (ClampMin = "0"))
+    int32 FirstCustomDataSlot = 0;
+
+    /** Custom data slots mirrored from FirstCustomDataSlot on; 0 leaves the fragment out */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Mass", meta = (ClampMin = "0", ClampMax = "4"))
+    int32 NumCustomDataSlots = 0;
+
+    /** Add FISMMassTagsFragment with the instance's own tags */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Mass")
+    bool bMirrorTags = false;
+};
+
+/**
+ * Mirrors selected instances of runtime components as lightweight Mass entities.
+ *
+ * Each mirrored instance gets one entity (see ISMMassFragments.h) that Mass processors can
+ * simulate in parallel. Changes made through the component (state, tags, custom data, destroy)
+ * are copied into the fragments as they are broadcast; changes made on the entities are written
+ * back by UISMMassSyncProcessor through the component's batch scheduler, so listeners see one
+ * batched notification per component per frame. Instances are released when destroyed, and
+ * components once they are garbage collected (PruneStaleComponents).
+ */
+UCLASS()
+class ISMRUNTIMEMASS_API UISMMassBridgeSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual void Deinitialize() override;
+
+    /**
+     * Create entities for InstanceIndices of Component. Already mirrored and destroyed instances
+     * are skipped. Settings apply to the whole component, so calls after the first one for a
+     * component keep its original settings. Returns the number of entities created.
+     */
+    int32 MirrorInstances(UISMRuntimeComponent* Component, TConstArrayView<int32> InstanceIndices, const FISMMassMirrorSettings& Settings);
+
+    /** Destroy the entities of InstanceIndices; deferred if Mass is processing */
+    void ReleaseInstances(UISMRuntimeComponent* Component, TConstArrayView<int32> InstanceIndices);
+
+    /** Destroy every entity of Component and stop listening to it */
+    void ReleaseComponent(UISMRuntimeComponent* Component);
+
+    /** Destroy the entities of components that no longer exist; run by UISMMassSyncProcessor */
+    void PruneStaleComponents();
+
+    /** Entity mirroring InstanceIndex, unset if it is not mirrored */
+    FMassEntityHandle GetInstanceEntity(const UISMRuntimeComponent* Component, int32 InstanceIndex) const;
+
+    /** Copy the component's current values into the entities of InstanceIndices */
+    void RefreshInstances(UISMRuntimeComponent* Component, TConstArrayView<int32> InstanceIndices);
+
+    /** Mirrored instances across all components */
+    UFUNCTION(BlueprintCallable, Category = "ISM Mass")
+    int32 GetNumMirroredInstances() const;
+
+    /**
+     * Write entity changes back to Component: Result through the batch scheduler, TagWrites
+     * (instance, its full set of own tags) through the tag batch API. Called by
+     * UISMMassSyncProcessor; the component's own change broadcasts are not copied back into
+     * the entities while this runs.
+     */
+    void ApplySync(UISMRuntimeComponent* Component, const FISMBatchMutationResult& Result,
+        TConstArrayView<TPair<int32, FGameplayTagContainer>> TagWrites);
+
+private:
+    struct FMirroredComponent
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+        FISMMassMirrorSettings Settings;
+        FMassArchetypeHandle Archetype;
+        TMap<int32, FMassEntityHandle> Entities;
+
+        FDelegateHandle StateChangedHandle;
+        FDelegateHandle TagsChangedHandle;
+        FDelegateHandle DestroyedHandle;
+        FDelegateHandle BatchChangedHandle;
+    };
+
+    FMassEntityManager* GetEntityManager() const;
+
+    FMirroredComponent& FindOrAddMirrored(UISMRuntimeComponent* Component, const FISMMassMirrorSettings& Settings, FMassEntityManager& EntityManager);
+
+    void CopyToEntity(FMassEntityManager& EntityManager, const FMirroredComponent& Mirrored, int32 InstanceIndex, FMassEntityHandle Entity) const;
+
+    void DestroyEntities(FMassEntityManager& EntityManager, TConstArrayView<FMassEntityHandle> Entities) const;
+
+    void UnbindComponent(FMirroredComponent& Mirrored) const;
+
+    void HandleInstanceChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
+    void HandleInstancesChanged(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices);
+
+    TMap<TObjectKey<UISMRuntimeComponent>, FMirroredComponent> MirroredComponents;
+
+    /** Set during ApplySync so the write-back's own broadcasts are not mirrored again */
+    bool bApplyingSync = false;
+};
@@ -0,0 +1,112 @@
+// ISMMassFragments.h
+// ISMRuntimeMass Module
+//
+// Fragments of the entities UISMMassBridgeSubsystem mirrors ISM instances as.
+//
+// Simulation processors query FISMMassMirroredTag entities, change FISMMassStateFragment,
+// FISMMassCustomDataFragment or FISMMassTagsFragment and mark the field on FISMMassSyncFragment.
+// UISMMassSyncProcessor writes the marked fields back once per frame as one batched mutation
+// result per component. Entities of one component share a chunk through FISMMassComponentFragment,
+// so a processor can call component APIs once per chunk rather than per entity.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "GameplayTagContainer.h"
+#include "ISMMassFragments.generated.h"
+
+class UISMRuntimeComponent;
+
+/** Fields UISMMassSyncProcessor writes back */
+enum class EISMMassField : uint8
+{
+    None       = 0,
+    StateFlags = 1 << 0,
+    CustomData = 1 << 1,
+    Tags       = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EISMMassField)
+
+/** Marks entities owned by the bridge */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassMirroredTag : public FMassTag
+{
+    GENERATED_BODY()
+};
+
+/** The component every entity of a chunk mirrors */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassComponentFragment : public FMassConstSharedFragment
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TWeakObjectPtr<UISMRuntimeComponent> Component;
+};
+
+/** Which instance an entity mirrors. Read-only for simulation processors. */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassInstanceFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    int32 InstanceIndex = INDEX_NONE;
+
+    /** Slot generation when mirrored; once the slot is recycled nothing is written back */
+    uint32 Generation = 0;
+};
+
+/** EISMInstanceState flags of the instance */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassStateFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    uint8 StateFlags = 0;
+};
+
+/** A window of consecutive custom data slots (FISMMassMirrorSettings) */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassCustomDataFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    static constexpr int32 MaxSlots = 4;
+
+    /** Values[i] is custom data slot FirstSlot + i */
+    float Values[MaxSlots] = {};
+    int32 FirstSlot = 0;
+    int32 NumSlots = 0;
+};
+
+/** Instance tags, without the component-wide ones. Only with FISMMassMirrorSettings::bMirrorTags. */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassTagsFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FGameplayTagContainer Tags;
+};
+
+template<>
+struct TMassFragmentTraits<FISMMassTagsFragment> final
+{
+    enum
+    {
+        AuthorAcceptsItsNotTriviallyCopyable = true
+    };
+};
+
+/** Fields changed by simulation since the last write-back */
+USTRUCT()
+struct ISMRUNTIMEMASS_API FISMMassSyncFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    void MarkDirty(EISMMassField Field) { DirtyFields |= static_cast<uint8>(Field); }
+    bool IsDirty() const { return DirtyFields != 0; }
+
+    /** EISMMassField bits */
+    uint8 DirtyFields = 0;
+};
@@ -0,0 +1,31 @@
+// ISMMassSyncProcessor.h
+// ISMRuntimeMass Module
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "ISMMassSyncProcessor.generated.h"
+
+/**
+ * Writes dirty mirrored entities (FISMMassSyncFragment) back to their runtime components.
+ *
+ * Runs on the game thread after the simulation phases. Each component gets one batched mutation
+ * result per frame with its state flag and custom data writes, plus one tag batch per changed
+ * tag; entities whose instance slot was recycled since mirroring are skipped.
+ */
+UCLASS()
+class ISMRUNTIMEMASS_API UISMMassSyncProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UISMMassSyncProcessor();
+
+protected:
+    virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Modules/ModuleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/** LLM tag for this module's hot paths, shown as ISMRuntime/Mass (see ISMRuntimeProfiling.h) */
+LLM_DECLARE_TAG_API(ISMRuntime_Mass, ISMRUNTIMEMASS_API);
+
+class FISMRuntimeMass : public IModuleInterface
+{
+public:
+    virtual void StartupModule() override;
+    virtual void ShutdownModule() override;
+};
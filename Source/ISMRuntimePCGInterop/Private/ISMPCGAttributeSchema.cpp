@@ -0,0 +1,181 @@
+// ISMPCGAttributeSchema.cpp
+
+#include "ISMPCGAttributeSchema.h"
+#include "ISMPCGDataChannel.h"
+
+const FISMPCGAttributeMapping* UISMPCGAttributeSchema::FindMapping(FName PCGAttributeName) const
+{
+    const int32* MappingIndex = GetCompiled().MappingIndexByName.Find(PCGAttributeName);
+    return MappingIndex && Mappings.IsValidIndex(*MappingIndex) ? &Mappings[*MappingIndex] : nullptr;
+}
+
+const FISMPCGCompiledSchema& UISMPCGAttributeSchema::GetCompiled() const
+{
+    const uint32 Hash = HashMappings(Mappings, bSerializeTagsAsAttributes);
+    if (CompiledSchema.IsValid() && CompiledSchema->SourceHash == Hash)
+    {
+        return *CompiledSchema;
+    }
+
+    TSharedPtr<FISMPCGCompiledSchema> Compiled = MakeShared<FISMPCGCompiledSchema>();
+    Compiled->SourceHash = Hash;
+    Compiled->bSerializeTagsAsAttributes = bSerializeTagsAsAttributes;
+
+    for (int32 MappingIndex = 0; MappingIndex < Mappings.Num(); ++MappingIndex)
+    {
+        const FISMPCGAttributeMapping& Mapping = Mappings[MappingIndex];
+
+        // First mapping for a name wins, as FindMapping always returned
+        Compiled->MappingIndexByName.FindOrAdd(Mapping.PCGAttributeName, MappingIndex);
+
+        switch (Mapping.TargetField)
+        {
+        case EISMPCGAttributeTarget::CustomDataSlot:
+            if (Mapping.CustomDataIndex >= 0)
+            {
+                Compiled->CustomDataOps.Add({ Mapping.PCGAttributeName, Mapping.CustomDataIndex, Mapping.DefaultValue });
+            }
+            break;
+        case EISMPCGAttributeTarget::StateFlag:
+            Compiled->StateFlagOps.Add(Mapping.PCGAttributeName);
+            break;
+        case EISMPCGAttributeTarget::GameplayTag:
+            if (Mapping.MappedTag.IsValid())
+            {
+                Compiled->TagOps.Add({ Mapping.PCGAttributeName, Mapping.MappedTag });
+            }
+            break;
+        case EISMPCGAttributeTarget::LocationX:
+            Compiled->LocationOps.Add({ Mapping.PCGAttributeName, 0 });
+            break;
+        case EISMPCGAttributeTarget::LocationY:
+            Compiled->LocationOps.Add({ Mapping.PCGAttributeName, 1 });
+            break;
+        case EISMPCGAttributeTarget::LocationZ:
+            Compiled->LocationOps.Add({ Mapping.PCGAttributeName, 2 });
+            break;
+        case EISMPCGAttributeTarget::Scale:
+            Compiled->ScaleOps.Add(Mapping.PCGAttributeName);
+            break;
+        default:
+            // Payload targets pass through by name
+            break;
+        }
+    }
+
+    CompiledSchema = MoveTemp(Compiled);
+    return *CompiledSchema;
+}
+
+uint32 UISMPCGAttributeSchema::HashMappings(const TArray<FISMPCGAttributeMapping>& InMappings, bool bInSerializeTags)
+{
+    uint32 Hash = HashCombine(GetTypeHash(InMappings.Num()), GetTypeHash(bInSerializeTags));
+    for (const FISMPCGAttributeMapping& Mapping : InMappings)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Mapping.PCGAttributeName));
+        Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Mapping.TargetField)));
+        Hash = HashCombine(Hash, GetTypeHash(Mapping.CustomDataIndex));
+        Hash = HashCombine(Hash, GetTypeHash(Mapping.MappedTag));
+        Hash = HashCombine(Hash, GetTypeHash(Mapping.DefaultValue));
+    }
+    return Hash;
+}
+
+// ===== Compiled Schema =====
+
+void FISMPCGCompiledSchema::WritePoint(FISMPCGInstancePoint& Point) const
+{
+    for (const FSlotOp& Op : CustomDataOps)
+    {
+        Point.FloatPayload.Add(Op.AttributeName, Point.CustomDataSlots.IsValidIndex(Op.Slot) ? Point.CustomDataSlots[Op.Slot] : Op.DefaultValue);
+    }
+    for (const FName& AttributeName : StateFlagOps)
+    {
+        Point.IntPayload.Add(AttributeName, Point.StateFlags);
+    }
+    for (const FTagOp& Op : TagOps)
+    {
+        Point.FloatPayload.Add(Op.AttributeName, Point.Tags.HasTag(Op.Tag) ? 1.0f : 0.0f);
+    }
+
+    const FVector Location = Point.Transform.GetLocation();
+    for (const FAxisOp& Op : LocationOps)
+    {
+        Point.FloatPayload.Add(Op.AttributeName, Location[Op.Axis]);
+    }
+    for (const FName& AttributeName : ScaleOps)
+    {
+        Point.FloatPayload.Add(AttributeName, Point.Transform.GetMaximumAxisScale());
+    }
+
+    if (bSerializeTagsAsAttributes)
+    {
+        for (const FGameplayTag& Tag : Point.Tags)
+        {
+            Point.FloatPayload.Add(Tag.GetTagName(), 1.0f);
+        }
+    }
+}
+
+void FISMPCGCompiledSchema::ReadPoint(FISMPCGInstancePoint& Point) const
+{
+    for (const FName& AttributeName : StateFlagOps)
+    {
+        if (const int32* Flags = Point.IntPayload.Find(AttributeName))
+        {
+            Point.StateFlags = static_cast<uint8>(*Flags);
+        }
+    }
+
+    if (Point.FloatPayload.IsEmpty())
+    {
+        return;
+    }
+
+    for (const FSlotOp& Op : CustomDataOps)
+    {
+        if (const float* Value = Point.FloatPayload.Find(Op.AttributeName))
+        {
+            Point.SetCustomDataSlot(Op.Slot, *Value);
+        }
+    }
+    for (const FTagOp& Op : TagOps)
+    {
+        if (const float* Value = Point.FloatPayload.Find(Op.AttributeName))
+        {
+            if (*Value > 0.5f)
+            {
+                Point.Tags.AddTag(Op.Tag);
+            }
+            else
+            {
+                Point.Tags.RemoveTag(Op.Tag);
+            }
+        }
+    }
+
+    if (LocationOps.Num() > 0)
+    {
+        FVector Location = Point.Transform.GetLocation();
+        bool bMoved = false;
+        for (const FAxisOp& Op : LocationOps)
+        {
+            if (const float* Value = Point.FloatPayload.Find(Op.AttributeName))
+            {
+                Location[Op.Axis] = *Value;
+                bMoved = true;
+            }
+        }
+        if (bMoved)
+        {
+            Point.Transform.SetLocation(Location);
+        }
+    }
+    for (const FName& AttributeName : ScaleOps)
+    {
+        if (const float* Value = Point.FloatPayload.Find(AttributeName))
+        {
+            Point.Transform.SetScale3D(FVector(*Value));
+        }
+    }
+}
@@ -0,0 +1,1262 @@
+// ISMPCGBridge.cpp
+
+#include "ISMPCGBridge.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMCompiledQueryFilter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Data/PCGPointArrayData.h"
+#include "Helpers/PCGHelpers.h"
+#include "Metadata/PCGMetadata.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+
+DEFINE_LOG_CATEGORY(LogISMRuntimePCGInterop);
+
+namespace ISMPCGBridgePrivate
+{
+    /** State bits a packet may not write: destruction and conversion have their own component paths */
+    constexpr uint8 ProtectedStateMask = static_cast<uint8>(EISMInstanceState::Destroyed) | static_cast<uint8>(EISMInstanceState::Converting);
+
+    TArray<FName> MakeCustomDataAttributeNames(int32 NumSlots)
+    {
+        TArray<FName> Names;
+        Names.Reserve(NumSlots);
+        for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+        {
+            Names.Add(FName(*FString::Printf(TEXT("ISM.CustomData.%d"), Slot)));
+        }
+        return Names;
+    }
+
+    double GetWorldTime(const UObject* WorldContext)
+    {
+        const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+        return World ? World->GetTimeSeconds() : 0.0;
+    }
+
+    FISMInstanceHandle MakeHandle(UISMRuntimeComponent* Component, int32 InstanceIndex)
+    {
+        FISMInstanceHandle Handle;
+        Handle.Component = Component;
+        Handle.InstanceIndex = InstanceIndex;
+        Handle.Generation = static_cast<int32>(Component->GetInstanceGeneration(InstanceIndex));
+        return Handle;
+    }
+
+    /** World transform of an instance, straight from the ISM's instance array */
+    FORCEINLINE FTransform GetInstanceWorldTransform(const UInstancedStaticMeshComponent* ISM, const FTransform& ComponentToWorld, int32 InstanceIndex)
+    {
+        return FTransform(ISM->PerInstanceSMData[InstanceIndex].Transform) * ComponentToWorld;
+    }
+
+    /** Non-destroyed instances of Component passing Filter, ascending */
+    void CollectExportIndices(const UISMRuntimeComponent* Component, const FISMQueryFilter& Filter, TArray<int32>& OutIndices)
+    {
+        const FISMCompiledQueryFilter Compiled(Filter);
+        const FISMCompiledComponentFilter Bound = Compiled.BindComponent(Component);
+        if (!Bound.bPasses)
+        {
+            return;
+        }
+
+        const int32 Count = FMath::Min(Component->GetInstanceCount(), Component->ManagedISMComponent->PerInstanceSMData.Num());
+        OutIndices.Reserve(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            if (!Component->IsInstanceDestroyed(Index) && Compiled.PassesInstance(Bound, Index))
+            {
+                OutIndices.Add(Index);
+            }
+        }
+    }
+
+    void FillPoint(UISMRuntimeComponent* Component, const FTransform& ComponentToWorld, int32 ComponentId, int32 InstanceIndex, FISMPCGInstancePoint& Point)
+    {
+        Point.SourceHandle = MakeHandle(Component, InstanceIndex);
+        Point.SourceComponentId = ComponentId;
+        Point.Transform = GetInstanceWorldTransform(Component->ManagedISMComponent, ComponentToWorld, InstanceIndex);
+        Point.StateFlags = Component->GetInstanceStateFlags(InstanceIndex);
+        Point.Tags = Component->GetInstanceTags(InstanceIndex);
+
+        const TConstArrayView<float> CustomData = Component->GetInstanceCustomDataView(InstanceIndex);
+        Point.CustomDataSlots.Append(CustomData.GetData(), CustomData.Num());
+    }
+
+    /** One metadata column per compiled schema op, each filled in a single pass over the points */
+    void WriteSchemaColumns(
+        const FISMPCGCompiledSchema& Compiled,
+        const UISMRuntimeComponent* Component,
+        TConstArrayView<int32> Indices,
+        const TPCGValueRange<FTransform>& TransformRange,
+        TConstArrayView<int32> StateFlagValues,
+        TConstArrayView<PCGMetadataEntryKey> EntryKeys,
+        UPCGMetadata* Metadata)
+    {
+        const int32 NumPoints = Indices.Num();
+        TArray<float> Values;
+        Values.SetNumUninitialized(NumPoints);
+
+        const UInstancedStaticMeshComponent* ISM = Component->ManagedISMComponent;
+        const int32 Stride = Component->GetNumCustomDataFloats();
+        const float* SourceData = ISM->PerInstanceSMCustomData.GetData();
+        const int32 NumStoredRows = Stride > 0 ? ISM->PerInstanceSMCustomData.Num() / Stride : 0;
+
+        auto WriteFloatColumn = [Metadata, EntryKeys, &Values](FName AttributeName, float DefaultValue)
+        {
+            if (FPCGMetadataAttribute<float>* Attribute = Metadata->CreateAttribute<float>(AttributeName, DefaultValue, true, true))
+            {
+                Attribute->SetValues(EntryKeys, Values);
+            }
+        };
+
+        for (const FISMPCGCompiledSchema::FSlotOp& Op : Compiled.CustomDataOps)
+        {
+            const bool bSlotStored = Op.Slot < Stride;
+            for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+            {
+                const int32 InstanceIndex = Indices[PointIndex];
+                Values[PointIndex] = bSlotStored && InstanceIndex < NumStoredRows ? SourceData[InstanceIndex * Stride + Op.Slot] : Op.DefaultValue;
+            }
+            WriteFloatColumn(Op.AttributeName, Op.DefaultValue);
+        }
+
+        for (const FISMPCGCompiledSchema::FTagOp& Op : Compiled.TagOps)
+        {
+            for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+            {
+                Values[PointIndex] = Component->InstanceHasTag(Indices[PointIndex], Op.Tag) ? 1.0f : 0.0f;
+            }
+            WriteFloatColumn(Op.AttributeName, 0.0f);
+        }
+
+        for (const FISMPCGCompiledSchema::FAxisOp& Op : Compiled.LocationOps)
+        {
+            for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+            {
+                Values[PointIndex] = TransformRange[PointIndex].GetLocation()[Op.Axis];
+            }
+            WriteFloatColumn(Op.AttributeName, 0.0f);
+        }
+
+        for (const FName& AttributeName : Compiled.ScaleOps)
+        {
+            for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+            {
+                Values[PointIndex] = TransformRange[PointIndex].GetMaximumAxisScale();
+            }
+            WriteFloatColumn(AttributeName, 1.0f);
+        }
+
+        for (const FName& AttributeName : Compiled.StateFlagOps)
+        {
+            if (FPCGMetadataAttribute<int32>* Attribute = Metadata->CreateAttribute<int32>(AttributeName, 0, false, true))
+            {
+                Attribute->SetValues(EntryKeys, StateFlagValues);
+            }
+        }
+    }
+
+    /** Points generated inside the graph never had a source - not stale, just not ours to apply */
+    FORCEINLINE bool IsGeneratedPoint(const FISMInstanceHandle& Handle)
+    {
+        return Handle.InstanceIndex == INDEX_NONE && Handle.Component.IsExplicitlyNull();
+    }
+
+    /** Whether Handle still names a live instance of Component; reads only, safe on workers while the game thread waits */
+    FORCEINLINE bool IsLiveTarget(const UISMRuntimeComponent* Component, const FISMInstanceHandle& Handle)
+    {
+        return Component->IsValidInstanceIndex(Handle.InstanceIndex)
+            && static_cast<uint32>(Handle.Generation) == Component->GetInstanceGeneration(Handle.InstanceIndex)
+            && !Component->IsInstanceDestroyed(Handle.InstanceIndex);
+    }
+
+    void ReportStaleHandle(const FISMInstanceHandle& Handle, EISMPCGStaleHandlePolicy Policy)
+    {
+        switch (Policy)
+        {
+        case EISMPCGStaleHandlePolicy::Warn:
+            UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("ISMPCGBridge: Skipping stale handle (instance %d of %s)"),
+                Handle.InstanceIndex, *GetNameSafe(Handle.Component.Get()));
+            break;
+        case EISMPCGStaleHandlePolicy::Assert:
+            ensureMsgf(false, TEXT("ISMPCGBridge: Stale handle (instance %d of %s)"), Handle.InstanceIndex, *GetNameSafe(Handle.Component.Get()));
+            break;
+        default:
+            break;
+        }
+    }
+
+    /** Fill an empty columnar packet with Indices (ascending) of Component, custom data copied in runs */
+    void FillColumnarPacket(UISMRuntimeComponent* Component, TConstArrayView<int32> Indices, FISMPCGColumnarPacket& Packet)
+    {
+        const int32 ComponentId = UISMPCGBridge::GetComponentId(Component);
+        Packet.SourceComponent = Component;
+        Packet.SourceComponentId = ComponentId;
+        Packet.CaptureTimeSeconds = GetWorldTime(Component);
+
+        const int32 Stride = Component->GetNumCustomDataFloats();
+        Packet.SetNumCustomDataSlots(Stride);
+        Packet.AddPoints(Indices.Num());
+
+        const UInstancedStaticMeshComponent* ISM = Component->ManagedISMComponent;
+        const FTransform ComponentToWorld = ISM->GetComponentTransform();
+        const FISMInstanceStateStore& States = Component->GetInstanceStateStore();
+        for (int32 PointIndex = 0; PointIndex < Indices.Num(); ++PointIndex)
+        {
+            const int32 InstanceIndex = Indices[PointIndex];
+            Packet.SourceHandles[PointIndex] = MakeHandle(Component, InstanceIndex);
+            Packet.SourceComponentIds[PointIndex] = ComponentId;
+            Packet.Transforms[PointIndex] = GetInstanceWorldTransform(ISM, ComponentToWorld, InstanceIndex);
+            Packet.StateFlags[PointIndex] = States.GetFlags(InstanceIndex);
+
+            for (const FGameplayTag& Tag : Component->GetInstanceTags(InstanceIndex))
+            {
+                Packet.SetTag(PointIndex, Packet.FindOrAddTag(Tag), true);
+            }
+        }
+
+        // Custom data in runs of consecutive instances: one block copy per run
+        if (Stride > 0)
+        {
+            int32 RunStart = 0;
+            while (RunStart < Indices.Num())
+            {
+                int32 RunEnd = RunStart + 1;
+                while (RunEnd < Indices.Num() && Indices[RunEnd] == Indices[RunEnd - 1] + 1)
+                {
+                    ++RunEnd;
+                }
+
+                const int32 RunLength = RunEnd - RunStart;
+                Component->ReadInstanceCustomDataRange(Indices[RunStart], RunLength, 0, Stride,
+                    TArrayView<float>(Packet.CustomData.GetData() + RunStart * Stride, RunLength * Stride));
+                RunStart = RunEnd;
+            }
+        }
+    }
+
+    /** Everything one packet writes to one component, flushed through the batched component paths */
+    struct FApplyBatch
+    {
+        UISMRuntimeComponent* Component = nullptr;
+        FTransform ComponentToWorld;
+        int32 Stride = 0;
+
+        TArray<int32> TransformIndices;
+        TArray<FTransform> Transforms;
+
+        TArray<int32> CustomDataIndices;
+        TArray<float> CustomData;
+
+        TArray<FISMStateFlagsWrite> StateWrites;
+        TArray<TPair<int32, FGameplayTag>> TagAdds;
+
+        explicit FApplyBatch(UISMRuntimeComponent* InComponent)
+            : Component(InComponent)
+            , ComponentToWorld(InComponent->ManagedISMComponent->GetComponentTransform())
+            , Stride(InComponent->GetNumCustomDataFloats())
+        {
+        }
+
+        void AddTransform(int32 InstanceIndex, const FTransform& NewTransform)
+        {
+            // Unchanged transforms would still dirty the spatial index and raise a move feedback
+            if (GetInstanceWorldTransform(Component->ManagedISMComponent, ComponentToWorld, InstanceIndex).Equals(NewTransform))
+            {
+                return;
+            }
+            TransformIndices.Add(InstanceIndex);
+            Transforms.Add(NewTransform);
+        }
+
+        /** Slots past Values.Num() keep their current value; an empty Values writes nothing */
+        void AddCustomData(int32 InstanceIndex, TConstArrayView<float> Values)
+        {
+            const int32 NumValues = FMath::Min(Values.Num(), Stride);
+            if (NumValues == 0)
+            {
+                return;
+            }
+
+            CustomDataIndices.Add(InstanceIndex);
+            const int32 RowStart = CustomData.AddUninitialized(Stride);
+            float* Row = CustomData.GetData() + RowStart;
+            if (NumValues < Stride)
+            {
+                const TConstArrayView<float> Current = Component->GetInstanceCustomDataView(InstanceIndex);
+                for (int32 Slot = NumValues; Slot < Stride; ++Slot)
+                {
+                    Row[Slot] = Current.IsValidIndex(Slot) ? Current[Slot] : 0.0f;
+                }
+            }
+            FMemory::Memcpy(Row, Values.GetData(), NumValues * sizeof(float));
+        }
+
+        void AddStateFlags(int32 InstanceIndex, uint8 Flags, bool bAdditive)
+        {
+            const uint8 Current = Component->GetInstanceStateStore().GetFlags(InstanceIndex);
+            const uint8 Target = (Flags & ~ProtectedStateMask) | (Current & ProtectedStateMask);
+
+            FISMStateFlagsWrite Write;
+            Write.InstanceIndex = InstanceIndex;
+            Write.SetMask = Target & ~Current;
+            Write.ClearMask = bAdditive ? 0 : (Current & ~Target);
+            if (Write.SetMask != 0 || Write.ClearMask != 0)
+            {
+                StateWrites.Add(Write);
+            }
+        }
+
+        void AddTags(int32 InstanceIndex, const FGameplayTagContainer& Tags)
+        {
+            for (const FGameplayTag& Tag : Tags)
+            {
+                TagAdds.Emplace(InstanceIndex, Tag);
+            }
+        }
+
+        /** Fold Other's writes in after this batch's own; both must target the same component */
+        void Append(FApplyBatch&& Other)
+        {
+            check(Other.Component == Component);
+            TransformIndices.Append(MoveTemp(Other.TransformIndices));
+            Transforms.Append(MoveTemp(Other.Transforms));
+            CustomDataIndices.Append(MoveTemp(Other.CustomDataIndices));
+            CustomData.Append(MoveTemp(Other.CustomData));
+            StateWrites.Append(MoveTemp(Other.StateWrites));
+            TagAdds.Append(MoveTemp(Other.TagAdds));
+        }
+
+        void Flush()
+        {
+            if (TransformIndices.Num() > 0)
+            {
+                // BatchUpdateInstanceTransforms takes each index once; the last write wins
+                TArray<int32> Order;
+                Order.SetNumUninitialized(TransformIndices.Num());
+                for (int32 Row = 0; Row < Order.Num(); ++Row)
+                {
+                    Order[Row] = Row;
+                }
+                Order.StableSort([this](int32 A, int32 B) { return TransformIndices[A] < TransformIndices[B]; });
+
+                TArray<int32> SortedIndices;
+                TArray<FTransform> SortedTransforms;
+                SortedIndices.Reserve(Order.Num());
+                SortedTransforms.Reserve(Order.Num());
+                for (const int32 Row : Order)
+                {
+                    if (SortedIndices.Num() > 0 && SortedIndices.Last() == TransformIndices[Row])
+                    {
+                        SortedTransforms.Last() = Transforms[Row];
+                        continue;
+                    }
+                    SortedIndices.Add(TransformIndices[Row]);
+                    SortedTransforms.Add(Transforms[Row]);
+                }
+                Component->BatchUpdateInstanceTransforms(SortedIndices, SortedTransforms);
+            }
+
+            if (CustomDataIndices.Num() > 0)
+            {
+                Component->WriteInstanceCustomData(CustomDataIndices, 0, Stride, CustomData);
+            }
+
+            if (StateWrites.Num() > 0)
+            {
+                Component->BatchWriteInstanceStateFlags(StateWrites);
+            }
+
+            for (const TPair<int32, FGameplayTag>& TagAdd : TagAdds)
+            {
+                Component->AddInstanceTag(TagAdd.Key, TagAdd.Value);
+            }
+        }
+    };
+
+    /** Packets at least this large validate and convert on workers */
+    constexpr int32 ParallelApplyMinPoints = 2048;
+
+    /** Points per worker item; a large component's points span several items, merged again before the flush */
+    constexpr int32 ApplyItemPoints = 1024;
+
+    /**
+     * Apply NumPoints packet points through per-component batches.
+     *
+     * The game thread partitions the points by handle component and resolves each component once.
+     * Workers then validate every handle against its partition's component and convert live points
+     * with AddPoint(Batch, PointIndex); component state is only read while the game thread waits.
+     * Back on the game thread, stale points are reported under Policy in packet order and each
+     * component's batches are merged and flushed, components in first-seen order.
+     *
+     * @return Number of points applied
+     */
+    template <typename HandleAtType, typename AddPointType>
+    int32 ApplyPartitioned(int32 NumPoints, EISMPCGStaleHandlePolicy Policy, HandleAtType HandleAt, AddPointType AddPoint)
+    {
+        struct FPartition
+        {
+            UISMRuntimeComponent* Component = nullptr;
+            TArray<int32> Points;
+        };
+
+        struct FItem
+        {
+            int32 Partition;
+            int32 First;
+            int32 Num;
+            FApplyBatch Batch;
+            TArray<int32> StalePoints;
+            int32 NumApplied = 0;
+
+            FItem(int32 InPartition, int32 InFirst, int32 InNum, UISMRuntimeComponent* Component)
+                : Partition(InPartition), First(InFirst), Num(InNum), Batch(Component)
+            {
+            }
+        };
+
+        // Weak pointers compare and hash without resolving; each component is resolved once, here
+        TArray<FPartition> Partitions;
+        TMap<TWeakObjectPtr<UISMRuntimeComponent>, int32> PartitionOfComponent;
+        TWeakObjectPtr<UISMRuntimeComponent> LastComponent;
+        int32 LastPartition = INDEX_NONE;
+        for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+        {
+            const FISMInstanceHandle& Handle = HandleAt(PointIndex);
+            if (IsGeneratedPoint(Handle))
+            {
+                continue;
+            }
+
+            // Packets are usually from one component; skip the lookup for runs of the same one
+            if (LastPartition == INDEX_NONE || Handle.Component != LastComponent)
+            {
+                int32& Partition = PartitionOfComponent.FindOrAdd(Handle.Component, INDEX_NONE);
+                if (Partition == INDEX_NONE)
+                {
+                    UISMRuntimeComponent* Component = Handle.Component.Get();
+                    Partition = Partitions.AddDefaulted();
+                    Partitions[Partition].Component = Component && Component->ManagedISMComponent ? Component : nullptr;
+                }
+                LastComponent = Handle.Component;
+                LastPartition = Partition;
+            }
+            Partitions[LastPartition].Points.Add(PointIndex);
+        }
+
+        TArray<int32> StalePoints;
+        TArray<FItem> Items;
+        for (int32 PartitionIndex = 0; PartitionIndex < Partitions.Num(); ++PartitionIndex)
+        {
+            const FPartition& Partition = Partitions[PartitionIndex];
+            if (!Partition.Component)
+            {
+                StalePoints.Append(Partition.Points);
+                continue;
+            }
+            for (int32 First = 0; First < Partition.Points.Num(); First += ApplyItemPoints)
+            {
+                Items.Emplace(PartitionIndex, First, FMath::Min(ApplyItemPoints, Partition.Points.Num() - First), Partition.Component);
+            }
+        }
+
+        const bool bParallel = NumPoints >= ParallelApplyMinPoints && Items.Num() > 1;
+        ParallelFor(Items.Num(), [&Partitions, &Items, &HandleAt, &AddPoint](int32 ItemIndex)
+        {
+            FItem& Item = Items[ItemIndex];
+            const FPartition& Partition = Partitions[Item.Partition];
+            for (int32 Row = Item.First; Row < Item.First + Item.Num; ++Row)
+            {
+                const int32 PointIndex = Partition.Points[Row];
+                if (!IsLiveTarget(Partition.Component, HandleAt(PointIndex)))
+                {
+                    Item.StalePoints.Add(PointIndex);
+                    continue;
+                }
+                AddPoint(Item.Batch, PointIndex);
+                ++Item.NumApplied;
+            }
+        }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+        if (Policy != EISMPCGStaleHandlePolicy::Skip)
+        {
+            for (const FItem& Item : Items)
+            {
+                StalePoints.Append(Item.StalePoints);
+            }
+            StalePoints.Sort();
+            for (const int32 PointIndex : StalePoints)
+            {
+                ReportStaleHandle(HandleAt(PointIndex), Policy);
+            }
+        }
+
+        // Items of one partition are contiguous and in point order, so appending keeps the last write last
+        int32 NumApplied = 0;
+        for (int32 ItemIndex = 0; ItemIndex < Items.Num();)
+        {
+            FItem& Head = Items[ItemIndex];
+            NumApplied += Head.NumApplied;
+            int32 Next = ItemIndex + 1;
+            for (; Next < Items.Num() && Items[Next].Partition == Head.Partition; ++Next)
+            {
+                Head.Batch.Append(MoveTemp(Items[Next].Batch));
+                NumApplied += Items[Next].NumApplied;
+            }
+            Head.Batch.Flush();
+            ItemIndex = Next;
+        }
+        return NumApplied;
+    }
+
+    /** A snapshot row in whichever layout the chunk was taken */
+    int32 GetSnapshotInstanceIndex(const FISMBatchSnapshot& Chunk, int32 Row)
+    {
+        return Chunk.SoA.Num() > 0 ? Chunk.SoA.InstanceIndices[Row] : Chunk.Instances[Row].InstanceIndex;
+    }
+
+    FTransform GetSnapshotTransform(const FISMBatchSnapshot& Chunk, int32 Row)
+    {
+        if (!EnumHasAnyFlags(Chunk.PopulatedFields, EISMSnapshotField::Transform))
+        {
+            return FTransform::Identity;
+        }
+        return Chunk.SoA.Num() > 0 ? Chunk.SoA.GetTransform(Row) : Chunk.Instances[Row].Transform;
+    }
+
+    uint8 GetSnapshotStateFlags(const FISMBatchSnapshot& Chunk, int32 Row)
+    {
+        if (!EnumHasAnyFlags(Chunk.PopulatedFields, EISMSnapshotField::StateFlags))
+        {
+            return 0;
+        }
+        return Chunk.SoA.Num() > 0 ? Chunk.SoA.StateFlags[Row] : Chunk.Instances[Row].StateFlags;
+    }
+
+    TConstArrayView<float> GetSnapshotCustomData(const FISMBatchSnapshot& Chunk, int32 Row)
+    {
+        if (!EnumHasAnyFlags(Chunk.PopulatedFields, EISMSnapshotField::CustomData))
+        {
+            return TConstArrayView<float>();
+        }
+        return Chunk.SoA.Num() > 0 ? Chunk.SoA.GetCustomData(Row) : TConstArrayView<float>(Chunk.Instances[Row].CustomData);
+    }
+}
+
+// ===== ISM → PCG Direction =====
+
+FISMPCGDataPacket UISMPCGBridge::ReadInstancesFromComponent(
+    UISMRuntimeComponent* Component,
+    UISMPCGAttributeSchema* Schema,
+    const FISMQueryFilter& Filter)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    FISMPCGDataPacket Packet;
+    if (!Component || !Component->ManagedISMComponent)
+    {
+        return Packet;
+    }
+
+    const int32 ComponentId = GetComponentId(Component);
+    Packet.SourceComponent = Component;
+    Packet.SourceComponentId = ComponentId;
+    Packet.CaptureTimeSeconds = GetWorldTime(Component);
+
+    TArray<int32> Indices;
+    CollectExportIndices(Component, Filter, Indices);
+
+    // Resolved once for the whole export
+    const FISMPCGCompiledSchema* Compiled = Schema ? &Schema->GetCompiled() : nullptr;
+
+    const FTransform ComponentToWorld = Component->ManagedISMComponent->GetComponentTransform();
+    Packet.Points.SetNum(Indices.Num());
+    for (int32 PointIndex = 0; PointIndex < Indices.Num(); ++PointIndex)
+    {
+        FISMPCGInstancePoint& Point = Packet.Points[PointIndex];
+        FillPoint(Component, ComponentToWorld, ComponentId, Indices[PointIndex], Point);
+        Point.PacketSequenceIndex = PointIndex;
+        if (Compiled)
+        {
+            Compiled->WritePoint(Point);
+        }
+    }
+
+    return Packet;
+}
+
+FISMPCGDataPacket UISMPCGBridge::ReadInstancesFromComponents(
+    const TArray<UISMRuntimeComponent*>& Components,
+    UISMPCGAttributeSchema* Schema,
+    const FISMQueryFilter& Filter)
+{
+    FISMPCGDataPacket Merged;
+    for (UISMRuntimeComponent* Component : Components)
+    {
+        FISMPCGDataPacket Packet = ReadInstancesFromComponent(Component, Schema, Filter);
+        if (Merged.CaptureTimeSeconds == 0.0)
+        {
+            Merged.CaptureTimeSeconds = Packet.CaptureTimeSeconds;
+        }
+
+        if (Merged.Points.Num() == 0)
+        {
+            Merged.Points = MoveTemp(Packet.Points);
+        }
+        else
+        {
+            Merged.AppendFrom(Packet);
+        }
+    }
+
+    for (int32 PointIndex = 0; PointIndex < Merged.Points.Num(); ++PointIndex)
+    {
+        Merged.Points[PointIndex].PacketSequenceIndex = PointIndex;
+    }
+
+    // A single source keeps its back-reference; merged packets route by per-point handles
+    if (Components.Num() == 1 && Components[0])
+    {
+        Merged.SourceComponent = Components[0];
+        Merged.SourceComponentId = GetComponentId(Components[0]);
+    }
+    return Merged;
+}
+
+FISMPCGColumnarPacket UISMPCGBridge::ReadInstancesToColumnarPacket(
+    UISMRuntimeComponent* Component,
+    const FISMQueryFilter& Filter)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    FISMPCGColumnarPacket Packet;
+    if (!Component || !Component->ManagedISMComponent)
+    {
+        return Packet;
+    }
+
+    TArray<int32> Indices;
+    CollectExportIndices(Component, Filter, Indices);
+    FillColumnarPacket(Component, Indices, Packet);
+    return Packet;
+}
+
+int32 UISMPCGBridge::ReadInstancesToPartitionedPacket(
+    UISMRuntimeComponent* Component,
+    const FISMQueryFilter& Filter,
+    const FBox& Bounds,
+    FISMPCGPartitionedPacket& InOutPacket)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    if (!Component || !Component->ManagedISMComponent)
+    {
+        return 0;
+    }
+
+    UISMRuntimeComponent* PacketSource = InOutPacket.SourceComponent.Get();
+    if (PacketSource && PacketSource != Component)
+    {
+        UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("ISMPCGBridge: Partitioned packet belongs to %s, not exporting %s into it"),
+            *PacketSource->GetName(), *Component->GetName());
+        return 0;
+    }
+
+    InOutPacket.SourceComponent = Component;
+    InOutPacket.SourceComponentId = GetComponentId(Component);
+    if (InOutPacket.CellSize <= 0.0f)
+    {
+        InOutPacket.CellSize = Component->SpatialIndexCellSize;
+    }
+
+    TArray<int32> Indices;
+    CollectExportIndices(Component, Filter, Indices);
+
+    // Buckets stay ascending, so each cell keeps the run-wise custom data copy
+    const UInstancedStaticMeshComponent* ISM = Component->ManagedISMComponent;
+    const FTransform ComponentToWorld = ISM->GetComponentTransform();
+    TMap<FIntVector, TArray<int32>> CellIndices;
+    for (const int32 InstanceIndex : Indices)
+    {
+        const FIntVector Cell = InOutPacket.LocationToCell(GetInstanceWorldTransform(ISM, ComponentToWorld, InstanceIndex).GetLocation());
+        if (Bounds.IsValid && !InOutPacket.GetCellBounds(Cell).Intersect(Bounds))
+        {
+            continue;
+        }
+        CellIndices.FindOrAdd(Cell).Add(InstanceIndex);
+    }
+
+    // Resident cells in the region that emptied since their last export
+    TArray<FIntVector> ResidentCells;
+    InOutPacket.GetCellsInBounds(Bounds, ResidentCells);
+    for (const FIntVector& Cell : ResidentCells)
+    {
+        if (!CellIndices.Contains(Cell))
+        {
+            InOutPacket.RemoveCell(Cell);
+        }
+    }
+
+    for (const TPair<FIntVector, TArray<int32>>& Pair : CellIndices)
+    {
+        FISMPCGColumnarPacket CellPacket;
+        FillColumnarPacket(Component, Pair.Value, CellPacket);
+        InOutPacket.SetCell(Pair.Key, MoveTemp(CellPacket));
+    }
+    return CellIndices.Num();
+}
+
+UPCGBasePointData* UISMPCGBridge::ReadInstancesToPointData(
+    UISMRuntimeComponent* Component,
+    const FISMQueryFilter& Filter,
+    UObject* Outer,
+    UISMPCGAttributeSchema* Schema)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    if (!Component || !Component->ManagedISMComponent)
+    {
+        return nullptr;
+    }
+
+    TArray<int32> Indices;
+    CollectExportIndices(Component, Filter, Indices);
+    const int32 NumPoints = Indices.Num();
+
+    UPCGPointArrayData* PointData = NewObject<UPCGPointArrayData>(Outer ? Outer : GetTransientPackage());
+    PointData->SetNumPoints(NumPoints);
+    PointData->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::Seed | EPCGPointNativeProperties::MetadataEntry);
+
+    UPCGMetadata* Metadata = PointData->MutableMetadata();
+    TPCGValueRange<FTransform> TransformRange = PointData->GetTransformValueRange();
+    TPCGValueRange<int32> SeedRange = PointData->GetSeedValueRange();
+    TPCGValueRange<int64> EntryRange = PointData->GetMetadataEntryValueRange();
+
+    const UInstancedStaticMeshComponent* ISM = Component->ManagedISMComponent;
+    const FTransform ComponentToWorld = ISM->GetComponentTransform();
+    const FISMInstanceStateStore& States = Component->GetInstanceStateStore();
+
+    TArray<PCGMetadataEntryKey> EntryKeys;
+    TArray<int32> InstanceIndexValues;
+    TArray<int32> StateFlagValues;
+    EntryKeys.SetNumUninitialized(NumPoints);
+    InstanceIndexValues.SetNumUninitialized(NumPoints);
+    StateFlagValues.SetNumUninitialized(NumPoints);
+
+    for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+    {
+        const int32 InstanceIndex = Indices[PointIndex];
+        const FTransform Transform = GetInstanceWorldTransform(ISM, ComponentToWorld, InstanceIndex);
+        TransformRange[PointIndex] = Transform;
+        SeedRange[PointIndex] = PCGHelpers::ComputeSeedFromPosition(Transform.GetLocation());
+
+        EntryKeys[PointIndex] = Metadata->AddEntry();
+        EntryRange[PointIndex] = EntryKeys[PointIndex];
+
+        InstanceIndexValues[PointIndex] = InstanceIndex;
+        StateFlagValues[PointIndex] = States.GetFlags(InstanceIndex);
+    }
+
+    Metadata->CreateAttribute<int32>(ISMPCGAttributes::InstanceIndex, INDEX_NONE, false, true)->SetValues(EntryKeys, InstanceIndexValues);
+    Metadata->CreateAttribute<int32>(ISMPCGAttributes::StateFlags, 0, false, true)->SetValues(EntryKeys, StateFlagValues);
+    Metadata->CreateAttribute<int32>(ISMPCGAttributes::ComponentId, GetComponentId(Component), false, true);
+
+    // One attribute per slot, gathered with the ISM's custom data stride
+    const int32 Stride = Component->GetNumCustomDataFloats();
+    const TArray<FName> SlotNames = MakeCustomDataAttributeNames(Stride);
+    const float* SourceData = ISM->PerInstanceSMCustomData.GetData();
+    const int32 NumStoredRows = Stride > 0 ? ISM->PerInstanceSMCustomData.Num() / Stride : 0;
+
+    TArray<float> SlotValues;
+    SlotValues.SetNumUninitialized(NumPoints);
+    for (int32 Slot = 0; Slot < Stride; ++Slot)
+    {
+        for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+        {
+            const int32 InstanceIndex = Indices[PointIndex];
+            SlotValues[PointIndex] = InstanceIndex < NumStoredRows ? SourceData[InstanceIndex * Stride + Slot] : 0.0f;
+        }
+        Metadata->CreateAttribute<float>(SlotNames[Slot], 0.0f, true, true)->SetValues(EntryKeys, SlotValues);
+    }
+
+    if (Schema)
+    {
+        WriteSchemaColumns(Schema->GetCompiled(), Component, Indices, TransformRange, StateFlagValues, EntryKeys, Metadata);
+    }
+
+    return PointData;
+}
+
+UPCGBasePointData* UISMPCGBridge::SnapshotsToPointData(
+    TConstArrayView<FISMBatchSnapshot> Chunks,
+    const FISMQueryFilter& Filter,
+    UObject* Outer)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    // (chunk, row) of every instance that passes, bound once per chunk
+    const FISMCompiledQueryFilter Compiled(Filter);
+    TArray<TPair<int32, int32>> Rows;
+    TArray<int32> ChunkComponentIds;
+    ChunkComponentIds.Init(INDEX_NONE, Chunks.Num());
+    int32 Stride = 0;
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        const FISMBatchSnapshot& Chunk = Chunks[ChunkIndex];
+        const UISMRuntimeComponent* Component = Chunk.SourceComponent.Get();
+        if (!Component || Chunk.IsEmpty())
+        {
+            continue;
+        }
+
+        const FISMCompiledComponentFilter Bound = Compiled.BindComponent(Component);
+        if (!Bound.bPasses)
+        {
+            continue;
+        }
+
+        ChunkComponentIds[ChunkIndex] = GetComponentId(Component);
+        Stride = FMath::Max(Stride, GetSnapshotCustomData(Chunk, 0).Num());
+        for (int32 Row = 0; Row < Chunk.Num(); ++Row)
+        {
+            if (Compiled.PassesInstance(Bound, GetSnapshotInstanceIndex(Chunk, Row)))
+            {
+                Rows.Emplace(ChunkIndex, Row);
+            }
+        }
+    }
+
+    const int32 NumPoints = Rows.Num();
+    UPCGPointArrayData* PointData = NewObject<UPCGPointArrayData>(Outer ? Outer : GetTransientPackage());
+    PointData->SetNumPoints(NumPoints);
+    PointData->AllocateProperties(EPCGPointNativeProperties::Transform | EPCGPointNativeProperties::Seed | EPCGPointNativeProperties::MetadataEntry);
+
+    UPCGMetadata* Metadata = PointData->MutableMetadata();
+    TPCGValueRange<FTransform> TransformRange = PointData->GetTransformValueRange();
+    TPCGValueRange<int32> SeedRange = PointData->GetSeedValueRange();
+    TPCGValueRange<int64> EntryRange = PointData->GetMetadataEntryValueRange();
+
+    TArray<PCGMetadataEntryKey> EntryKeys;
+    TArray<int32> InstanceIndexValues;
+    TArray<int32> ComponentIdValues;
+    TArray<int32> StateFlagValues;
+    EntryKeys.SetNumUninitialized(NumPoints);
+    InstanceIndexValues.SetNumUninitialized(NumPoints);
+    ComponentIdValues.SetNumUninitialized(NumPoints);
+    StateFlagValues.SetNumUninitialized(NumPoints);
+
+    for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+    {
+        const FISMBatchSnapshot& Chunk = Chunks[Rows[PointIndex].Key];
+        const int32 Row = Rows[PointIndex].Value;
+
+        const FTransform Transform = GetSnapshotTransform(Chunk, Row);
+        TransformRange[PointIndex] = Transform;
+        SeedRange[PointIndex] = PCGHelpers::ComputeSeedFromPosition(Transform.GetLocation());
+
+        EntryKeys[PointIndex] = Metadata->AddEntry();
+        EntryRange[PointIndex] = EntryKeys[PointIndex];
+
+        InstanceIndexValues[PointIndex] = GetSnapshotInstanceIndex(Chunk, Row);
+        ComponentIdValues[PointIndex] = ChunkComponentIds[Rows[PointIndex].Key];
+        StateFlagValues[PointIndex] = GetSnapshotStateFlags(Chunk, Row);
+    }
+
+    Metadata->CreateAttribute<int32>(ISMPCGAttributes::InstanceIndex, INDEX_NONE, false, true)->SetValues(EntryKeys, InstanceIndexValues);
+    Metadata->CreateAttribute<int32>(ISMPCGAttributes::ComponentId, INDEX_NONE, false, true)->SetValues(EntryKeys, ComponentIdValues);
+    Metadata->CreateAttribute<int32>(ISMPCGAttributes::StateFlags, 0, false, true)->SetValues(EntryKeys, StateFlagValues);
+
+    // Chunks of components with fewer slots read 0 for the rest
+    const TArray<FName> SlotNames = MakeCustomDataAttributeNames(Stride);
+    TArray<float> SlotValues;
+    SlotValues.SetNumUninitialized(NumPoints);
+    for (int32 Slot = 0; Slot < Stride; ++Slot)
+    {
+        for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+        {
+            const TConstArrayView<float> CustomData = GetSnapshotCustomData(Chunks[Rows[PointIndex].Key], Rows[PointIndex].Value);
+            SlotValues[PointIndex] = CustomData.IsValidIndex(Slot) ? CustomData[Slot] : 0.0f;
+        }
+        Metadata->CreateAttribute<float>(SlotNames[Slot], 0.0f, true, true)->SetValues(EntryKeys, SlotValues);
+    }
+
+    return PointData;
+}
+
+// ===== PCG → ISM Direction =====
+
+int32 UISMPCGBridge::ApplyPacketToInstances(
+    const FISMPCGDataPacket& Packet,
+    UISMPCGAttributeSchema* Schema,
+    bool bWriteTransforms,
+    bool bWriteStates,
+    bool bWriteTags,
+    bool bWriteCustomData)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    if (Packet.IsEmpty())
+    {
+        return 0;
+    }
+
+    const UObject* WorldContext = Packet.SourceComponent.Get();
+    for (int32 PointIndex = 0; !WorldContext && PointIndex < Packet.Points.Num(); ++PointIndex)
+    {
+        WorldContext = Packet.Points[PointIndex].SourceHandle.Component.Get();
+    }
+    if (!Packet.IsFresh(GetWorldTime(WorldContext)))
+    {
+        return 0;
+    }
+
+    bWriteTransforms &= Packet.CanWrite(EISMPCGWriteMask::Transforms);
+    bWriteStates &= Packet.CanWrite(EISMPCGWriteMask::StateFlagsW);
+    bWriteTags &= Packet.CanWrite(EISMPCGWriteMask::Tags);
+    bWriteCustomData &= Packet.CanWrite(EISMPCGWriteMask::CustomData);
+    const bool bAdditive = Packet.DataLifetime == EISMPCGDataLifetime::Accumulating;
+    const FISMPCGCompiledSchema* Compiled = Schema ? &Schema->GetCompiled() : nullptr;
+    const bool bUseSchema = Compiled && !Compiled->IsEmpty();
+
+    return ApplyPartitioned(Packet.Points.Num(), Packet.StaleHandlePolicy,
+        [&Packet](int32 PointIndex) -> const FISMInstanceHandle& { return Packet.Points[PointIndex].SourceHandle; },
+        [&](FApplyBatch& Batch, int32 PointIndex)
+        {
+            // Only copy when the schema has fields to fold back in
+            const FISMPCGInstancePoint* Point = &Packet.Points[PointIndex];
+            FISMPCGInstancePoint Resolved;
+            if (bUseSchema)
+            {
+                Resolved = *Point;
+                Compiled->ReadPoint(Resolved);
+                Point = &Resolved;
+            }
+
+            const int32 InstanceIndex = Point->SourceHandle.InstanceIndex;
+            if (bWriteTransforms)
+            {
+                Batch.AddTransform(InstanceIndex, Point->Transform);
+            }
+            if (bWriteCustomData)
+            {
+                Batch.AddCustomData(InstanceIndex, Point->CustomDataSlots);
+            }
+            if (bWriteStates)
+            {
+                Batch.AddStateFlags(InstanceIndex, Point->StateFlags, bAdditive);
+            }
+            if (bWriteTags)
+            {
+                Batch.AddTags(InstanceIndex, Point->Tags);
+            }
+        });
+}
+
+int32 UISMPCGBridge::ApplyColumnarPacketToInstances(
+    const FISMPCGColumnarPacket& Packet,
+    bool bWriteTransforms,
+    bool bWriteStates,
+    bool bWriteTags,
+    bool bWriteCustomData)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    if (Packet.IsEmpty())
+    {
+        return 0;
+    }
+
+    const UObject* WorldContext = Packet.SourceComponent.Get();
+    for (int32 PointIndex = 0; !WorldContext && PointIndex < Packet.Num(); ++PointIndex)
+    {
+        WorldContext = Packet.SourceHandles[PointIndex].Component.Get();
+    }
+    if (!Packet.IsFresh(GetWorldTime(WorldContext)))
+    {
+        return 0;
+    }
+
+    bWriteTransforms &= Packet.CanWrite(EISMPCGWriteMask::Transforms);
+    bWriteStates &= Packet.CanWrite(EISMPCGWriteMask::StateFlagsW);
+    bWriteTags &= Packet.CanWrite(EISMPCGWriteMask::Tags) && Packet.TagTable.Num() > 0;
+    bWriteCustomData &= Packet.CanWrite(EISMPCGWriteMask::CustomData) && Packet.NumCustomDataSlots > 0;
+    const bool bAdditive = Packet.DataLifetime == EISMPCGDataLifetime::Accumulating;
+
+    return ApplyPartitioned(Packet.Num(), Packet.StaleHandlePolicy,
+        [&Packet](int32 PointIndex) -> const FISMInstanceHandle& { return Packet.SourceHandles[PointIndex]; },
+        [&](FApplyBatch& Batch, int32 PointIndex)
+        {
+            const int32 InstanceIndex = Packet.SourceHandles[PointIndex].InstanceIndex;
+            if (bWriteTransforms)
+            {
+                Batch.AddTransform(InstanceIndex, Packet.Transforms[PointIndex]);
+            }
+            if (bWriteCustomData)
+            {
+                Batch.AddCustomData(InstanceIndex, Packet.GetCustomData(PointIndex));
+            }
+            if (bWriteStates)
+            {
+                Batch.AddStateFlags(InstanceIndex, Packet.StateFlags[PointIndex], bAdditive);
+            }
+            if (bWriteTags)
+            {
+                for (int32 TagBit = 0; TagBit < Packet.TagTable.Num(); ++TagBit)
+                {
+                    if (Packet.HasTag(PointIndex, TagBit))
+                    {
+                        Batch.TagAdds.Emplace(InstanceIndex, Packet.TagTable[TagBit]);
+                    }
+                }
+            }
+        });
+}
+
+int32 UISMPCGBridge::ApplyPartitionedPacketToInstances(
+    const FISMPCGPartitionedPacket& Packet,
+    bool bWriteTransforms,
+    bool bWriteStates,
+    bool bWriteTags,
+    bool bWriteCustomData)
+{
+    int32 NumApplied = 0;
+    for (const TPair<FIntVector, FISMPCGColumnarPacket>& Pair : Packet.Cells)
+    {
+        NumApplied += ApplyColumnarPacketToInstances(Pair.Value, bWriteTransforms, bWriteStates, bWriteTags, bWriteCustomData);
+    }
+    return NumApplied;
+}
+
+int32 UISMPCGBridge::ApplyPointDataToInstances(
+    const UPCGBasePointData* PointData,
+    UISMRuntimeComponent* Target,
+    bool bWriteTransforms,
+    bool bWriteCustomData)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    if (!PointData || !Target || !Target->ManagedISMComponent)
+    {
+        return 0;
+    }
+
+    const UPCGMetadata* Metadata = PointData->ConstMetadata();
+    const FPCGMetadataAttribute<int32>* IndexAttribute = Metadata ? Metadata->GetConstTypedAttribute<int32>(ISMPCGAttributes::InstanceIndex) : nullptr;
+    if (!IndexAttribute)
+    {
+        UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("ISMPCGBridge: Point data has no %s attribute, nothing to apply"),
+            *ISMPCGAttributes::InstanceIndex.ToString());
+        return 0;
+    }
+
+    FApplyBatch Batch(Target);
+
+    // Slots the graph did not output keep their current value
+    TArray<const FPCGMetadataAttribute<float>*> SlotAttributes;
+    if (bWriteCustomData)
+    {
+        for (const FName& SlotName : MakeCustomDataAttributeNames(Batch.Stride))
+        {
+            SlotAttributes.Add(Metadata->GetConstTypedAttribute<float>(SlotName));
+        }
+        bWriteCustomData = SlotAttributes.ContainsByPredicate([](const FPCGMetadataAttribute<float>* Attribute) { return Attribute != nullptr; });
+    }
+
+    const TConstPCGValueRange<FTransform> TransformRange = PointData->GetConstTransformValueRange();
+    const TConstPCGValueRange<int64> EntryRange = PointData->GetConstMetadataEntryValueRange();
+
+    TArray<float> Row;
+    Row.SetNumUninitialized(Batch.Stride);
+    int32 NumApplied = 0;
+    for (int32 PointIndex = 0; PointIndex < PointData->GetNumPoints(); ++PointIndex)
+    {
+        const PCGMetadataEntryKey EntryKey = EntryRange[PointIndex];
+        const int32 InstanceIndex = IndexAttribute->GetValueFromItemKey(EntryKey);
+        if (!Target->IsValidInstanceIndex(InstanceIndex) || Target->IsInstanceDestroyed(InstanceIndex))
+        {
+            continue;
+        }
+
+        if (bWriteTransforms)
+        {
+            Batch.AddTransform(InstanceIndex, TransformRange[PointIndex]);
+        }
+        if (bWriteCustomData)
+        {
+            const TConstArrayView<float> Current = Target->GetInstanceCustomDataView(InstanceIndex);
+            for (int32 Slot = 0; Slot < Batch.Stride; ++Slot)
+            {
+                const FPCGMetadataAttribute<float>* Attribute = SlotAttributes[Slot];
+                Row[Slot] = Attribute ? Attribute->GetValueFromItemKey(EntryKey) : (Current.IsValidIndex(Slot) ? Current[Slot] : 0.0f);
+            }
+            Batch.AddCustomData(InstanceIndex, Row);
+        }
+        ++NumApplied;
+    }
+
+    Batch.Flush();
+    return NumApplied;
+}
+
+TArray<int32> UISMPCGBridge::SpawnInstancesFromPacket(
+    const FISMPCGDataPacket& Packet,
+    UISMRuntimeComponent* Target,
+    UISMPCGAttributeSchema* Schema)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    TArray<int32> NewIndices;
+    if (!Target || !Target->ManagedISMComponent || Packet.IsEmpty())
+    {
+        return NewIndices;
+    }
+
+    // Resolve schema attributes up front so spawned transforms include mapped locations
+    TArray<FISMPCGInstancePoint> ResolvedPoints;
+    const FISMPCGCompiledSchema* Compiled = Schema ? &Schema->GetCompiled() : nullptr;
+    const bool bUseSchema = Compiled && !Compiled->IsEmpty();
+    if (bUseSchema)
+    {
+        ResolvedPoints = Packet.Points;
+        for (FISMPCGInstancePoint& Point : ResolvedPoints)
+        {
+            Compiled->ReadPoint(Point);
+        }
+    }
+    const TArray<FISMPCGInstancePoint>& Points = bUseSchema ? ResolvedPoints : Packet.Points;
+
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(Points.Num());
+    for (const FISMPCGInstancePoint& Point : Points)
+    {
+        Transforms.Add(Point.Transform);
+    }
+
+    NewIndices = Target->BatchAddInstances(Transforms, true, true);
+
+    const bool bWriteStates = Packet.CanWrite(EISMPCGWriteMask::StateFlagsW);
+    const bool bWriteTags = Packet.CanWrite(EISMPCGWriteMask::Tags);
+    const bool bWriteCustomData = Packet.CanWrite(EISMPCGWriteMask::CustomData);
+
+    FApplyBatch Batch(Target);
+    for (int32 PointIndex = 0; PointIndex < Points.Num() && PointIndex < NewIndices.Num(); ++PointIndex)
+    {
+        const int32 InstanceIndex = NewIndices[PointIndex];
+        if (InstanceIndex == INDEX_NONE)
+        {
+            continue;
+        }
+
+        const FISMPCGInstancePoint& Point = Points[PointIndex];
+        if (bWriteCustomData)
+        {
+            Batch.AddCustomData(InstanceIndex, Point.CustomDataSlots);
+        }
+        if (bWriteStates && Point.StateFlags != 0)
+        {
+            Batch.AddStateFlags(InstanceIndex, Point.StateFlags, true);
+        }
+        if (bWriteTags)
+        {
+            Batch.AddTags(InstanceIndex, Point.Tags);
+        }
+    }
+    Batch.Flush();
+
+    return NewIndices;
+}
+
+TArray<int32> UISMPCGBridge::SpawnInstancesFromColumnarPacket(
+    const FISMPCGColumnarPacket& Packet,
+    UISMRuntimeComponent* Target)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    TArray<int32> NewIndices;
+    if (!Target || !Target->ManagedISMComponent || Packet.IsEmpty())
+    {
+        return NewIndices;
+    }
+
+    const bool bWriteCustomData = Packet.CanWrite(EISMPCGWriteMask::CustomData) && Packet.NumCustomDataSlots > 0;
+    NewIndices = Target->BulkAppendInstances(Packet.Transforms,
+        bWriteCustomData ? TConstArrayView<float>(Packet.CustomData) : TConstArrayView<float>(),
+        bWriteCustomData ? Packet.NumCustomDataSlots : 0);
+    if (NewIndices.Num() != Packet.Num())
+    {
+        return NewIndices;
+    }
+
+    const bool bWriteStates = Packet.CanWrite(EISMPCGWriteMask::StateFlagsW);
+    const bool bWriteTags = Packet.CanWrite(EISMPCGWriteMask::Tags) && Packet.TagTable.Num() > 0;
+    if (!bWriteStates && !bWriteTags)
+    {
+        return NewIndices;
+    }
+
+    FApplyBatch Batch(Target);
+    for (int32 PointIndex = 0; PointIndex < NewIndices.Num(); ++PointIndex)
+    {
+        const int32 InstanceIndex = NewIndices[PointIndex];
+        if (bWriteStates && Packet.StateFlags[PointIndex] != 0)
+        {
+            Batch.AddStateFlags(InstanceIndex, Packet.StateFlags[PointIndex], true);
+        }
+        if (bWriteTags)
+        {
+            for (int32 TagBit = 0; TagBit < Packet.TagTable.Num(); ++TagBit)
+            {
+                if (Packet.HasTag(PointIndex, TagBit))
+                {
+                    Batch.TagAdds.Emplace(InstanceIndex, Packet.TagTable[TagBit]);
+                }
+            }
+        }
+    }
+    Batch.Flush();
+
+    return NewIndices;
+}
+
+// ===== Point Conversion Utilities =====
+
+FISMPCGInstancePoint UISMPCGBridge::InstanceToPoint(
+    UISMRuntimeComponent* Component,
+    int32 InstanceIndex,
+    UISMPCGAttributeSchema* Schema)
+{
+    using namespace ISMPCGBridgePrivate;
+
+    FISMPCGInstancePoint Point;
+    if (!Component || !Component->ManagedISMComponent || !Component->ManagedISMComponent->PerInstanceSMData.IsValidIndex(InstanceIndex))
+    {
+        return Point;
+    }
+
+    FillPoint(Component, Component->ManagedISMComponent->GetComponentTransform(), GetComponentId(Component), InstanceIndex, Point);
+    if (Schema)
+    {
+        Schema->GetCompiled().WritePoint(Point);
+    }
+    return Point;
+}
+
+void UISMPCGBridge::ApplyPointToInstance(
+    const FISMPCGInstancePoint& Point,
+    UISMPCGAttributeSchema* Schema,
+    bool bWriteTransform,
+    bool bWriteState,
+    bool bWriteTags,
+    bool bWriteCustomData)
+{
+    FISMPCGDataPacket Packet;
+    Packet.WriteMask = EISMPCGWriteMask::All;
+    Packet.Points.Add(Point);
+    ApplyPacketToInstances(Packet, Schema, bWriteTransform, bWriteState, bWriteTags, bWriteCustomData);
+}
+
+int32 UISMPCGBridge::GetComponentId(const UISMRuntimeComponent* Component)
+{
+    return Component ? static_cast<int32>(Component->GetUniqueID()) : INDEX_NONE;
+}
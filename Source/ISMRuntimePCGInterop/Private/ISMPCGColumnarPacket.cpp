@@ -0,0 +1,367 @@
+#include "ISMPCGColumnarPacket.h"
+
+void FISMPCGColumnarPacket::Reserve(int32 Count)
+{
+    SourceHandles.Reserve(Count);
+    SourceComponentIds.Reserve(Count);
+    Transforms.Reserve(Count);
+    StateFlags.Reserve(Count);
+    CustomData.Reserve(Count * NumCustomDataSlots);
+    TagBits.Reserve(Count * GetNumTagWords());
+
+    for (FISMPCGFloatColumn& Column : FloatColumns)
+    {
+        Column.Values.Reserve(Count);
+    }
+    for (FISMPCGIntColumn& Column : IntColumns)
+    {
+        Column.Values.Reserve(Count);
+    }
+    for (FISMPCGVectorColumn& Column : VectorColumns)
+    {
+        Column.Values.Reserve(Count);
+    }
+}
+
+int32 FISMPCGColumnarPacket::AddPoints(int32 Count)
+{
+    const int32 First = Num();
+    if (Count <= 0)
+    {
+        return First;
+    }
+
+    auto AppendFilled = [Count](auto& Values, const auto& Value)
+    {
+        Values.Reserve(Values.Num() + Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Values.Add(Value);
+        }
+    };
+
+    SourceHandles.AddDefaulted(Count);
+    AppendFilled(SourceComponentIds, INDEX_NONE);
+    AppendFilled(Transforms, FTransform::Identity);
+    StateFlags.AddZeroed(Count);
+    CustomData.AddZeroed(Count * NumCustomDataSlots);
+    TagBits.AddZeroed(Count * GetNumTagWords());
+
+    for (FISMPCGFloatColumn& Column : FloatColumns)
+    {
+        AppendFilled(Column.Values, Column.DefaultValue);
+    }
+    for (FISMPCGIntColumn& Column : IntColumns)
+    {
+        AppendFilled(Column.Values, Column.DefaultValue);
+    }
+    for (FISMPCGVectorColumn& Column : VectorColumns)
+    {
+        AppendFilled(Column.Values, Column.DefaultValue);
+    }
+
+    return First;
+}
+
+void FISMPCGColumnarPacket::ResetPoints()
+{
+    SourceHandles.Reset();
+    SourceComponentIds.Reset();
+    Transforms.Reset();
+    StateFlags.Reset();
+    CustomData.Reset();
+    TagBits.Reset();
+
+    for (FISMPCGFloatColumn& Column : FloatColumns)
+    {
+        Column.Values.Reset();
+    }
+    for (FISMPCGIntColumn& Column : IntColumns)
+    {
+        Column.Values.Reset();
+    }
+    for (FISMPCGVectorColumn& Column : VectorColumns)
+    {
+        Column.Values.Reset();
+    }
+}
+
+// ===== Schema =====
+
+FISMPCGFloatColumn& FISMPCGColumnarPacket::FindOrAddFloatColumn(FName Name, float Default)
+{
+    const int32 Index = FindColumnIndex(FloatColumns, Name);
+    if (Index != INDEX_NONE)
+    {
+        return FloatColumns[Index];
+    }
+
+    FISMPCGFloatColumn& Column = FloatColumns.AddDefaulted_GetRef();
+    Column.Name = Name;
+    Column.DefaultValue = Default;
+    Column.Values.Init(Default, Num());
+    return Column;
+}
+
+FISMPCGIntColumn& FISMPCGColumnarPacket::FindOrAddIntColumn(FName Name, int32 Default)
+{
+    const int32 Index = FindColumnIndex(IntColumns, Name);
+    if (Index != INDEX_NONE)
+    {
+        return IntColumns[Index];
+    }
+
+    FISMPCGIntColumn& Column = IntColumns.AddDefaulted_GetRef();
+    Column.Name = Name;
+    Column.DefaultValue = Default;
+    Column.Values.Init(Default, Num());
+    return Column;
+}
+
+FISMPCGVectorColumn& FISMPCGColumnarPacket::FindOrAddVectorColumn(FName Name, FVector Default)
+{
+    const int32 Index = FindColumnIndex(VectorColumns, Name);
+    if (Index != INDEX_NONE)
+    {
+        return VectorColumns[Index];
+    }
+
+    FISMPCGVectorColumn& Column = VectorColumns.AddDefaulted_GetRef();
+    Column.Name = Name;
+    Column.DefaultValue = Default;
+    Column.Values.Init(Default, Num());
+    return Column;
+}
+
+const FISMPCGFloatColumn* FISMPCGColumnarPacket::FindFloatColumn(FName Name) const
+{
+    const int32 Index = FindColumnIndex(FloatColumns, Name);
+    return Index != INDEX_NONE ? &FloatColumns[Index] : nullptr;
+}
+
+const FISMPCGIntColumn* FISMPCGColumnarPacket::FindIntColumn(FName Name) const
+{
+    const int32 Index = FindColumnIndex(IntColumns, Name);
+    return Index != INDEX_NONE ? &IntColumns[Index] : nullptr;
+}
+
+const FISMPCGVectorColumn* FISMPCGColumnarPacket::FindVectorColumn(FName Name) const
+{
+    const int32 Index = FindColumnIndex(VectorColumns, Name);
+    return Index != INDEX_NONE ? &VectorColumns[Index] : nullptr;
+}
+
+void FISMPCGColumnarPacket::SetNumCustomDataSlots(int32 Count)
+{
+    if (Count <= NumCustomDataSlots)
+    {
+        return;
+    }
+
+    // Re-stride in place from the back so no point overwrites one not yet moved
+    const int32 OldStride = NumCustomDataSlots;
+    CustomData.SetNumZeroed(Num() * Count);
+    for (int32 Point = Num() - 1; Point >= 0; --Point)
+    {
+        for (int32 Slot = Count - 1; Slot >= 0; --Slot)
+        {
+            CustomData[Point * Count + Slot] = Slot < OldStride ? CustomData[Point * OldStride + Slot] : 0.0f;
+        }
+    }
+    NumCustomDataSlots = Count;
+}
+
+int32 FISMPCGColumnarPacket::FindOrAddTag(const FGameplayTag& Tag)
+{
+    const int32 Existing = TagTable.IndexOfByKey(Tag);
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    const int32 OldWords = GetNumTagWords();
+    const int32 Bit = TagTable.Add(Tag);
+    const int32 NewWords = GetNumTagWords();
+    if (NewWords != OldWords)
+    {
+        // Widen every point's mask by one word, back to front
+        TagBits.SetNumZeroed(Num() * NewWords);
+        for (int32 Point = Num() - 1; Point >= 0; --Point)
+        {
+            for (int32 Word = NewWords - 1; Word >= 0; --Word)
+            {
+                TagBits[Point * NewWords + Word] = Word < OldWords ? TagBits[Point * OldWords + Word] : 0;
+            }
+        }
+    }
+    return Bit;
+}
+
+// ===== Per-Point Access =====
+
+bool FISMPCGColumnarPacket::HasTag(int32 PointIndex, int32 TagBit) const
+{
+    if (!TagTable.IsValidIndex(TagBit))
+    {
+        return false;
+    }
+    const int64 Word = TagBits[PointIndex * GetNumTagWords() + TagBit / 64];
+    return (Word & (int64(1) << (TagBit % 64))) != 0;
+}
+
+void FISMPCGColumnarPacket::SetTag(int32 PointIndex, int32 TagBit, bool bHasTag)
+{
+    if (!TagTable.IsValidIndex(TagBit))
+    {
+        return;
+    }
+    int64& Word = TagBits[PointIndex * GetNumTagWords() + TagBit / 64];
+    const int64 Mask = int64(1) << (TagBit % 64);
+    Word = bHasTag ? (Word | Mask) : (Word & ~Mask);
+}
+
+FGameplayTagContainer FISMPCGColumnarPacket::GetTags(int32 PointIndex) const
+{
+    FGameplayTagContainer Tags;
+    const int32 NumWords = GetNumTagWords();
+    for (int32 Word = 0; Word < NumWords; ++Word)
+    {
+        uint64 Bits = static_cast<uint64>(TagBits[PointIndex * NumWords + Word]);
+        while (Bits != 0)
+        {
+            const int32 Bit = Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+            Tags.AddTagFast(TagTable[Bit]);
+            Bits &= Bits - 1;
+        }
+    }
+    return Tags;
+}
+
+int32 FISMPCGColumnarPacket::FindByHandle(const FISMInstanceHandle& Handle) const
+{
+    return SourceHandles.IndexOfByKey(Handle);
+}
+
+// ===== Row Packet Conversion =====
+
+FISMPCGColumnarPacket FISMPCGColumnarPacket::FromPacket(const FISMPCGDataPacket& Packet)
+{
+    FISMPCGColumnarPacket Columnar;
+    Columnar.SourceComponent = Packet.SourceComponent;
+    Columnar.SourceComponentId = Packet.SourceComponentId;
+    Columnar.ChannelTag = Packet.ChannelTag;
+    Columnar.CaptureTimeSeconds = Packet.CaptureTimeSeconds;
+    Columnar.MaxAgeSeconds = Packet.MaxAgeSeconds;
+    Columnar.DataLifetime = Packet.DataLifetime;
+    Columnar.StaleHandlePolicy = Packet.StaleHandlePolicy;
+    Columnar.WriteMask = Packet.WriteMask;
+
+    // Schema first, so the point columns are laid out once
+    int32 MaxSlots = 0;
+    for (const FISMPCGInstancePoint& Point : Packet.Points)
+    {
+        MaxSlots = FMath::Max(MaxSlots, Point.CustomDataSlots.Num());
+        for (const FGameplayTag& Tag : Point.Tags)
+        {
+            Columnar.FindOrAddTag(Tag);
+        }
+        for (const TPair<FName, float>& Pair : Point.FloatPayload)
+        {
+            Columnar.FindOrAddFloatColumn(Pair.Key);
+        }
+        for (const TPair<FName, int32>& Pair : Point.IntPayload)
+        {
+            Columnar.FindOrAddIntColumn(Pair.Key);
+        }
+        for (const TPair<FName, FVector>& Pair : Point.VectorPayload)
+        {
+            Columnar.FindOrAddVectorColumn(Pair.Key);
+        }
+    }
+    Columnar.SetNumCustomDataSlots(MaxSlots);
+
+    TMap<FGameplayTag, int32> TagBitsByTag;
+    for (int32 Bit = 0; Bit < Columnar.TagTable.Num(); ++Bit)
+    {
+        TagBitsByTag.Add(Columnar.TagTable[Bit], Bit);
+    }
+
+    Columnar.AddPoints(Packet.Points.Num());
+    for (int32 Index = 0; Index < Packet.Points.Num(); ++Index)
+    {
+        const FISMPCGInstancePoint& Point = Packet.Points[Index];
+        Columnar.SourceHandles[Index] = Point.SourceHandle;
+        Columnar.SourceComponentIds[Index] = Point.SourceComponentId;
+        Columnar.Transforms[Index] = Point.Transform;
+        Columnar.StateFlags[Index] = Point.StateFlags;
+
+        if (Point.CustomDataSlots.Num() > 0)
+        {
+            FMemory::Memcpy(Columnar.GetCustomData(Index).GetData(), Point.CustomDataSlots.GetData(), Point.CustomDataSlots.Num() * sizeof(float));
+        }
+
+        for (const FGameplayTag& Tag : Point.Tags)
+        {
+            Columnar.SetTag(Index, TagBitsByTag.FindChecked(Tag), true);
+        }
+
+        for (FISMPCGFloatColumn& Column : Columnar.FloatColumns)
+        {
+            Column.Values[Index] = Point.GetFloat(Column.Name, Column.DefaultValue);
+        }
+        for (FISMPCGIntColumn& Column : Columnar.IntColumns)
+        {
+            Column.Values[Index] = Point.GetInt(Column.Name, Column.DefaultValue);
+        }
+        for (FISMPCGVectorColumn& Column : Columnar.VectorColumns)
+        {
+            Column.Values[Index] = Point.GetVector(Column.Name, Column.DefaultValue);
+        }
+    }
+
+    return Columnar;
+}
+
+FISMPCGDataPacket FISMPCGColumnarPacket::ToPacket() const
+{
+    FISMPCGDataPacket Packet;
+    Packet.SourceComponent = SourceComponent;
+    Packet.SourceComponentId = SourceComponentId;
+    Packet.ChannelTag = ChannelTag;
+    Packet.CaptureTimeSeconds = CaptureTimeSeconds;
+    Packet.MaxAgeSeconds = MaxAgeSeconds;
+    Packet.DataLifetime = DataLifetime;
+    Packet.StaleHandlePolicy = StaleHandlePolicy;
+    Packet.WriteMask = WriteMask;
+
+    Packet.Points.SetNum(Num());
+    for (int32 Index = 0; Index < Num(); ++Index)
+    {
+        FISMPCGInstancePoint& Point = Packet.Points[Index];
+        Point.SourceHandle = SourceHandles[Index];
+        Point.SourceComponentId = SourceComponentIds[Index];
+        Point.PacketSequenceIndex = Index;
+        Point.Transform = Transforms[Index];
+        Point.StateFlags = StateFlags[Index];
+        Point.CustomDataSlots = TArray<float>(GetCustomData(Index));
+        Point.Tags = GetTags(Index);
+
+        Point.FloatPayload.Reserve(FloatColumns.Num());
+        for (const FISMPCGFloatColumn& Column : FloatColumns)
+        {
+            Point.FloatPayload.Add(Column.Name, Column.Values[Index]);
+        }
+        Point.IntPayload.Reserve(IntColumns.Num());
+        for (const FISMPCGIntColumn& Column : IntColumns)
+        {
+            Point.IntPayload.Add(Column.Name, Column.Values[Index]);
+        }
+        Point.VectorPayload.Reserve(VectorColumns.Num());
+        for (const FISMPCGVectorColumn& Column : VectorColumns)
+        {
+            Point.VectorPayload.Add(Column.Name, Column.Values[Index]);
+        }
+    }
+
+    return Packet;
+}
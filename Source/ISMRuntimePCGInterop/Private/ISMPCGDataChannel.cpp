@@ -0,0 +1,77 @@
+// ISMPCGDataChannel.cpp
+
+#include "ISMPCGDataChannel.h"
+
+// ===== Packet Lookup =====
+
+const FISMPCGInstancePoint* FISMPCGDataPacket::FindByHandle(const FISMInstanceHandle& Handle) const
+{
+    if (IndexedPointCount != Points.Num())
+    {
+        BuildLookup();
+    }
+
+    const int32* PointIndex = HandleLookup.Find(Handle);
+    if (PointIndex && Points[*PointIndex].SourceHandle != Handle)
+    {
+        // Points were edited in place since the index was built
+        BuildLookup();
+        PointIndex = HandleLookup.Find(Handle);
+    }
+    return PointIndex ? &Points[*PointIndex] : nullptr;
+}
+
+const FISMPCGInstancePoint* FISMPCGDataPacket::FindByInstanceIndex(int32 InstanceIndex) const
+{
+    if (IndexedPointCount != Points.Num())
+    {
+        BuildLookup();
+    }
+
+    const int32* PointIndex = InstanceIndexLookup.Find(InstanceIndex);
+    if (PointIndex && Points[*PointIndex].SourceHandle.InstanceIndex != InstanceIndex)
+    {
+        BuildLookup();
+        PointIndex = InstanceIndexLookup.Find(InstanceIndex);
+    }
+    return PointIndex ? &Points[*PointIndex] : nullptr;
+}
+
+void FISMPCGDataPacket::AppendFrom(const FISMPCGDataPacket& Other)
+{
+    const bool bLookupCurrent = IndexedPointCount == Points.Num();
+    const int32 FirstNewPoint = Points.Num();
+
+    Points.Append(Other.Points);
+
+    if (bLookupCurrent)
+    {
+        IndexPoints(FirstNewPoint);
+    }
+}
+
+void FISMPCGDataPacket::BuildLookup() const
+{
+    HandleLookup.Reset();
+    InstanceIndexLookup.Reset();
+    HandleLookup.Reserve(Points.Num());
+    InstanceIndexLookup.Reserve(Points.Num());
+    IndexPoints(0);
+}
+
+void FISMPCGDataPacket::IndexPoints(int32 FirstPoint) const
+{
+    for (int32 PointIndex = FirstPoint; PointIndex < Points.Num(); ++PointIndex)
+    {
+        const FISMInstanceHandle& Handle = Points[PointIndex].SourceHandle;
+        if (!HandleLookup.Contains(Handle))
+        {
+            HandleLookup.Add(Handle, PointIndex);
+        }
+        if (!InstanceIndexLookup.Contains(Handle.InstanceIndex))
+        {
+            InstanceIndexLookup.Add(Handle.InstanceIndex, PointIndex);
+        }
+    }
+    IndexedPointCount = Points.Num();
+}
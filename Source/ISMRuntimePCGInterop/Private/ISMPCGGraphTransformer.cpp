@@ -0,0 +1,307 @@
+// ISMPCGGraphTransformer.cpp
+
+#include "ISMPCGGraphTransformer.h"
+#include "ISMRuntimePCGInterop.h"
+#include "ISMRuntimeComponent.h"
+
+namespace
+{
+    /** Bits the graph may not write back: destruction and conversion have their own component paths */
+    constexpr uint8 ProtectedStateMask = static_cast<uint8>(EISMInstanceState::Destroyed) | static_cast<uint8>(EISMInstanceState::Converting);
+
+    constexpr EISMSnapshotField CaptureReadMask = EISMSnapshotField::Transform | EISMSnapshotField::CustomData | EISMSnapshotField::StateFlags;
+
+    /** Compact a SoA chunk in place to the instances in Keep */
+    void FilterSoAChunk(FISMInstanceSoASnapshot& SoA, const TSet<int32>& Keep)
+    {
+        const bool bHasTransforms = SoA.Locations.Num() == SoA.Num();
+        const bool bHasStates = SoA.StateFlags.Num() == SoA.Num();
+        const int32 Stride = SoA.CustomDataStride;
+        const bool bHasCustomData = Stride > 0 && SoA.CustomData.Num() == SoA.Num() * Stride;
+
+        int32 Kept = 0;
+        for (int32 SnapshotIndex = 0; SnapshotIndex < SoA.Num(); ++SnapshotIndex)
+        {
+            if (!Keep.Contains(SoA.InstanceIndices[SnapshotIndex]))
+            {
+                continue;
+            }
+
+            if (Kept != SnapshotIndex)
+            {
+                SoA.InstanceIndices[Kept] = SoA.InstanceIndices[SnapshotIndex];
+                if (bHasTransforms)
+                {
+                    SoA.Locations[Kept] = SoA.Locations[SnapshotIndex];
+                    SoA.Rotations[Kept] = SoA.Rotations[SnapshotIndex];
+                    SoA.Scales[Kept] = SoA.Scales[SnapshotIndex];
+                }
+                if (bHasStates)
+                {
+                    SoA.StateFlags[Kept] = SoA.StateFlags[SnapshotIndex];
+                }
+                if (bHasCustomData)
+                {
+                    FMemory::Memmove(SoA.CustomData.GetData() + Kept * Stride, SoA.CustomData.GetData() + SnapshotIndex * Stride, Stride * sizeof(float));
+                }
+            }
+            ++Kept;
+        }
+
+        SoA.InstanceIndices.SetNum(Kept, EAllowShrinking::No);
+        if (bHasTransforms)
+        {
+            SoA.Locations.SetNum(Kept, EAllowShrinking::No);
+            SoA.Rotations.SetNum(Kept, EAllowShrinking::No);
+            SoA.Scales.SetNum(Kept, EAllowShrinking::No);
+        }
+        if (bHasStates)
+        {
+            SoA.StateFlags.SetNum(Kept, EAllowShrinking::No);
+        }
+        if (bHasCustomData)
+        {
+            SoA.CustomData.SetNum(Kept * Stride, EAllowShrinking::No);
+        }
+    }
+}
+
+FISMPCGGraphTransformer::FISMPCGGraphTransformer(FName InTransformerName)
+    : TransformerName(InTransformerName)
+{
+}
+
+FISMSnapshotRequest FISMPCGGraphTransformer::BuildRequest()
+{
+    FISMSnapshotRequest Request;
+    Request.TargetComponents = TargetComponents;
+    Request.SpatialBounds = SpatialBounds;
+    Request.bStructureOfArrays = true;
+
+    if (Phase == EISMPCGGraphPhase::Capturing)
+    {
+        Request.ReadMask = CaptureReadMask;
+        Request.WriteMask = EISMSnapshotField::None;
+    }
+    else
+    {
+        // Indices are enough for transforms and custom data; state writes are diffed against current flags
+        Request.ReadMask = EnumHasAnyFlags(WriteMask, EISMSnapshotField::StateFlags) ? EISMSnapshotField::StateFlags : EISMSnapshotField::None;
+        Request.WriteMask = WriteMask;
+    }
+    return Request;
+}
+
+void FISMPCGGraphTransformer::ProcessChunk(FISMBatchSnapshot Chunk, FISMMutationHandle Handle)
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_PCG);
+
+    switch (Phase.load())
+    {
+    case EISMPCGGraphPhase::Capturing:
+        ProcessCaptureChunk(MoveTemp(Chunk), Handle);
+        break;
+    case EISMPCGGraphPhase::Applying:
+        ProcessApplyChunk(Chunk, Handle);
+        break;
+    default:
+        // Cancelled while the chunk was queued
+        Handle.Abandon();
+        break;
+    }
+}
+
+void FISMPCGGraphTransformer::ProcessCaptureChunk(FISMBatchSnapshot&& Chunk, FISMMutationHandle& Handle)
+{
+    TSharedPtr<const FInstanceFilterMap, ESPMode::ThreadSafe> Filter;
+    {
+        FScopeLock Lock(&ChunkLock);
+        Filter = CaptureFilter;
+    }
+
+    if (Filter.IsValid())
+    {
+        const TSet<int32>* Keep = Filter->Find(Chunk.SourceComponent);
+        if (Keep)
+        {
+            FilterSoAChunk(Chunk.SoA, *Keep);
+        }
+        else
+        {
+            Chunk.SoA = FISMInstanceSoASnapshot();
+        }
+    }
+
+    {
+        FScopeLock Lock(&ChunkLock);
+        CapturedCellTokens.Add(TPair<TWeakObjectPtr<UISMRuntimeComponent>, FIntVector>(Chunk.SourceComponent, Chunk.CellCoordinates),
+            Chunk.ComponentGenerationToken);
+        if (!Chunk.IsEmpty())
+        {
+            CapturedChunks.Add(MoveTemp(Chunk));
+        }
+    }
+
+    // Nothing to write yet; the graph's output comes back through the apply cycle
+    Handle.Abandon();
+}
+
+void FISMPCGGraphTransformer::ProcessApplyChunk(const FISMBatchSnapshot& Chunk, FISMMutationHandle& Handle)
+{
+    TSharedPtr<const FResultsMap, ESPMode::ThreadSafe> StagedResults;
+    bool bCellCurrent = false;
+    {
+        FScopeLock Lock(&ChunkLock);
+        StagedResults = Results;
+
+        const int32* CapturedToken = CapturedCellTokens.Find(TPair<TWeakObjectPtr<UISMRuntimeComponent>, FIntVector>(Chunk.SourceComponent, Chunk.CellCoordinates));
+        bCellCurrent = CapturedToken && *CapturedToken == Chunk.ComponentGenerationToken;
+    }
+
+    const FISMPCGGraphComponentResults* ComponentResults = StagedResults.IsValid() ? StagedResults->Find(Chunk.SourceComponent) : nullptr;
+    if (!ComponentResults || !bCellCurrent)
+    {
+        Handle.Abandon();
+        return;
+    }
+
+    const bool bWriteTransforms = ComponentResults->bHasTransforms && EnumHasAnyFlags(WriteMask, EISMSnapshotField::Transform);
+    const bool bWriteStates = ComponentResults->bHasStateFlags && EnumHasAnyFlags(WriteMask, EISMSnapshotField::StateFlags)
+        && Chunk.SoA.StateFlags.Num() == Chunk.SoA.Num();
+    const bool bWriteCustomData = ComponentResults->WrittenSlots.Num() > 0 && EnumHasAnyFlags(WriteMask, EISMSnapshotField::CustomData);
+
+    FISMBatchMutationResult Result = Handle.AcquireResult();
+    Result.TargetComponent = Chunk.SourceComponent;
+    Result.WrittenFields = WriteMask;
+
+    int32 MatchedCount = 0;
+    const TArray<int32>& ChunkIndices = Chunk.SoA.InstanceIndices;
+    for (int32 SnapshotIndex = 0; SnapshotIndex < ChunkIndices.Num(); ++SnapshotIndex)
+    {
+        const int32 InstanceIndex = ChunkIndices[SnapshotIndex];
+        const int32* Row = ComponentResults->RowOfInstance.Find(InstanceIndex);
+        if (!Row)
+        {
+            continue;
+        }
+        ++MatchedCount;
+
+        if (bWriteTransforms)
+        {
+            Result.Streams.AddTransform(InstanceIndex, ComponentResults->Transforms[*Row]);
+        }
+
+        if (bWriteCustomData)
+        {
+            const float* Values = ComponentResults->CustomData.GetData() + *Row * ComponentResults->CustomDataStride;
+            for (const int32 Slot : ComponentResults->WrittenSlots)
+            {
+                Result.Streams.AddCustomData(InstanceIndex, Slot, Values[Slot]);
+            }
+        }
+
+        if (bWriteStates)
+        {
+            const uint8 Current = Chunk.SoA.StateFlags[SnapshotIndex];
+            const uint8 Target = (ComponentResults->StateFlags[*Row] & ~ProtectedStateMask) | (Current & ProtectedStateMask);
+            if (Target != Current)
+            {
+                Result.Streams.AddStateFlags(InstanceIndex, Target & ~Current, Current & ~Target);
+            }
+        }
+    }
+
+    AppliedCount.fetch_add(MatchedCount, std::memory_order_relaxed);
+    Handle.Release(MoveTemp(Result));
+}
+
+void FISMPCGGraphTransformer::OnRequestComplete()
+{
+    switch (Phase.load())
+    {
+    case EISMPCGGraphPhase::Capturing:
+        SetPhase(EISMPCGGraphPhase::Executing);
+        break;
+    case EISMPCGGraphPhase::Applying:
+        LastAppliedCount.store(AppliedCount.exchange(0), std::memory_order_relaxed);
+        Cancel();
+        break;
+    default:
+        break;
+    }
+}
+
+bool FISMPCGGraphTransformer::BeginCapture(const TArray<TWeakObjectPtr<UISMRuntimeComponent>>& Targets, const FBox& Bounds, EISMSnapshotField InWriteMask,
+    FInstanceFilterMap* OnlyInstances)
+{
+    if (Phase != EISMPCGGraphPhase::Idle || Targets.IsEmpty())
+    {
+        return false;
+    }
+
+    TargetComponents = Targets;
+    SpatialBounds = Bounds;
+    WriteMask = InWriteMask;
+    {
+        FScopeLock Lock(&ChunkLock);
+        CapturedChunks.Reset();
+        CapturedCellTokens.Reset();
+        CaptureFilter.Reset();
+        if (OnlyInstances)
+        {
+            CaptureFilter = MakeShared<const FInstanceFilterMap, ESPMode::ThreadSafe>(MoveTemp(*OnlyInstances));
+        }
+    }
+
+    SetPhase(EISMPCGGraphPhase::Capturing);
+    bDirty = true;
+    return true;
+}
+
+TArray<FISMBatchSnapshot> FISMPCGGraphTransformer::TakeCapturedChunks()
+{
+    FScopeLock Lock(&ChunkLock);
+    return MoveTemp(CapturedChunks);
+}
+
+void FISMPCGGraphTransformer::BeginApply(FResultsMap&& InResults)
+{
+    if (Phase != EISMPCGGraphPhase::Executing)
+    {
+        return;
+    }
+
+    if (InResults.IsEmpty() || WriteMask == EISMSnapshotField::None)
+    {
+        LastAppliedCount.store(0, std::memory_order_relaxed);
+        Cancel();
+        return;
+    }
+
+    {
+        FScopeLock Lock(&ChunkLock);
+        Results = MakeShared<const FResultsMap, ESPMode::ThreadSafe>(MoveTemp(InResults));
+    }
+
+    SetPhase(EISMPCGGraphPhase::Applying);
+    AppliedCount.store(0, std::memory_order_relaxed);
+    bDirty = true;
+}
+
+void FISMPCGGraphTransformer::Cancel()
+{
+    {
+        FScopeLock Lock(&ChunkLock);
+        CapturedChunks.Reset();
+        CaptureFilter.Reset();
+        Results.Reset();
+    }
+
+    bDirty = false;
+    SetPhase(EISMPCGGraphPhase::Idle);
+}
+
+void FISMPCGGraphTransformer::SetPhase(EISMPCGGraphPhase InPhase)
+{
+    Phase.store(InPhase);
+}
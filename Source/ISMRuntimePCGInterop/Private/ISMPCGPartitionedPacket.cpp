@@ -0,0 +1,61 @@
+// ISMPCGPartitionedPacket.cpp
+
+#include "ISMPCGPartitionedPacket.h"
+
+int32 FISMPCGPartitionedPacket::NumPoints() const
+{
+    int32 Total = 0;
+    for (const TPair<FIntVector, FISMPCGColumnarPacket>& Pair : Cells)
+    {
+        Total += Pair.Value.Num();
+    }
+    return Total;
+}
+
+FIntVector FISMPCGPartitionedPacket::LocationToCell(const FVector& Location) const
+{
+    if (CellSize <= 0.0f)
+    {
+        return FIntVector::ZeroValue;
+    }
+    return FIntVector(
+        FMath::FloorToInt32(Location.X / CellSize),
+        FMath::FloorToInt32(Location.Y / CellSize),
+        FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+FBox FISMPCGPartitionedPacket::GetCellBounds(const FIntVector& Cell) const
+{
+    const FVector Min = FVector(Cell) * CellSize;
+    return FBox(Min, Min + FVector(CellSize));
+}
+
+void FISMPCGPartitionedPacket::GetCellsInBounds(const FBox& Bounds, TArray<FIntVector>& OutCells) const
+{
+    for (const TPair<FIntVector, FISMPCGColumnarPacket>& Pair : Cells)
+    {
+        if (!Bounds.IsValid || GetCellBounds(Pair.Key).Intersect(Bounds))
+        {
+            OutCells.Add(Pair.Key);
+        }
+    }
+}
+
+bool FISMPCGPartitionedPacket::TakeCell(const FIntVector& Cell, FISMPCGColumnarPacket& OutPacket)
+{
+    return Cells.RemoveAndCopyValue(Cell, OutPacket);
+}
+
+int32 FISMPCGPartitionedPacket::RemoveCellsOutside(const FBox& Bounds)
+{
+    int32 NumRemoved = 0;
+    for (auto It = Cells.CreateIterator(); It; ++It)
+    {
+        if (!GetCellBounds(It.Key()).Intersect(Bounds))
+        {
+            It.RemoveCurrent();
+            ++NumRemoved;
+        }
+    }
+    return NumRemoved;
+}
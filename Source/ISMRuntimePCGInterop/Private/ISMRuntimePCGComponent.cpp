@@ -0,0 +1,609 @@
+// ISMRuntimePCGComponent.cpp
+
+#include "ISMRuntimePCGComponent.h"
+#include "ISMRuntimePCGInterop.h"
+#include "ISMPCGBridge.h"
+#include "ISMBakedInstanceState.h"
+#include "ISMPCGGraphTransformer.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "Batching/ISMBatchScheduler.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Data/PCGBasePointData.h"
+#include "Metadata/PCGMetadata.h"
+#include "Metadata/PCGMetadataAttributeTpl.h"
+#include "PCGComponent.h"
+#include "PCGGraph.h"
+#include "Engine/World.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+    /** Frame on which a periodic run last started, per world; at most one periodic start per frame */
+    TMap<TObjectKey<UWorld>, uint64> GLastPeriodicStartFrame;
+
+    /** Same component, same phase offset into its interval, run to run */
+    float ComputeStaggerFraction(const UObject* Object)
+    {
+        return static_cast<float>(GetTypeHash(Object->GetPathName()) % 1024) / 1024.0f;
+    }
+
+    FName MakeCustomDataAttributeName(int32 Slot)
+    {
+        return FName(*FString::Printf(TEXT("ISM.CustomData.%d"), Slot));
+    }
+}
+
+UISMRuntimePCGComponent::UISMRuntimePCGComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+// ===== Lifecycle =====
+
+void UISMRuntimePCGComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!PCGGraph)
+    {
+        UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("UISMRuntimePCGComponent on '%s': no PCGGraph assigned. Graph will not run."), *GetOwner()->GetName());
+        return;
+    }
+
+    if (!RegisterGraphTransformer())
+    {
+        return;
+    }
+
+    CreatePCGComponent();
+    ResolveSourceComponents();
+
+    // Start periodic components at different points of their interval
+    if (ExecutionMode == EISMPCGExecutionMode::Periodic)
+    {
+        TimeSinceLastExecution = -ExecutionInterval * ComputeStaggerFraction(this);
+    }
+}
+
+void UISMRuntimePCGComponent::EndPlay(const EEndPlayReason::Type EndReason)
+{
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& Source : ResolvedSources)
+    {
+        if (UISMRuntimeComponent* Component = Source.Get())
+        {
+            Component->OnInstanceStateChangedNative.RemoveAll(this);
+            Component->OnInstanceTagsChangedNative.RemoveAll(this);
+            Component->OnInstanceDestroyedNative.RemoveAll(this);
+            Component->OnInstanceAddedNative.RemoveAll(this);
+            Component->OnBatchInstancesAddedNative.RemoveAll(this);
+            Component->OnInstancesChangedBatchNative.RemoveAll(this);
+        }
+    }
+    ResolvedSources.Reset();
+    DirtyInstances.Reset();
+
+    // Unregister before releasing so the scheduler doesn't tick a dangling pointer
+    if (GraphTransformer.IsValid())
+    {
+        GraphTransformer->Cancel();
+        if (UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get())
+        {
+            Scheduler->UnregisterTransformer(GraphTransformer->GetTransformerName());
+        }
+        GraphTransformer.Reset();
+    }
+
+    if (PCGComponent)
+    {
+        PCGComponent->CancelGeneration();
+    }
+    GraphInput = nullptr;
+    RunComponentsById.Reset();
+
+    if (UWorld* World = GetWorld())
+    {
+        GLastPeriodicStartFrame.Remove(World);
+    }
+
+    Super::EndPlay(EndReason);
+}
+
+void UISMRuntimePCGComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_PCG);
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!GraphTransformer.IsValid())
+    {
+        return;
+    }
+
+    TimeSinceLastExecution += DeltaTime;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get();
+    const float StallTimeout = Scheduler ? Scheduler->Settings.HandleTimeoutSeconds : 5.0f;
+
+    switch (GraphTransformer->GetPhase())
+    {
+    case EISMPCGGraphPhase::Idle:
+        if (ShouldStartRun(DeltaTime))
+        {
+            StartRun();
+        }
+        break;
+
+    case EISMPCGGraphPhase::Capturing:
+    case EISMPCGGraphPhase::Applying:
+        // Cycles with no chunks get no completion callback; don't wait on them forever
+        if (Now - GraphTransformer->GetPhaseStartTime() > StallTimeout)
+        {
+            GraphTransformer->Cancel();
+        }
+        break;
+
+    case EISMPCGGraphPhase::Executing:
+        if (!bGraphRunning)
+        {
+            ExecuteGraph();
+        }
+        else if (!PCGComponent || !PCGComponent->IsGenerating())
+        {
+            OnGraphComplete();
+        }
+        break;
+    }
+}
+
+// ===== API =====
+
+void UISMRuntimePCGComponent::TriggerExecution()
+{
+    bExecutionPending = true;
+}
+
+bool UISMRuntimePCGComponent::IsExecuting() const
+{
+    return GraphTransformer.IsValid() && GraphTransformer->GetPhase() != EISMPCGGraphPhase::Idle;
+}
+
+int32 UISMRuntimePCGComponent::GetLastAppliedCount() const
+{
+    return GraphTransformer.IsValid() ? GraphTransformer->GetLastAppliedCount() : 0;
+}
+
+int32 UISMRuntimePCGComponent::BakeSourceStates()
+{
+    if (IsExecuting())
+    {
+        UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("UISMRuntimePCGComponent on '%s': cannot bake while a run is in flight"), *GetOwner()->GetName());
+        return 0;
+    }
+
+    int32 NumBaked = 0;
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& Source : ResolvedSources)
+    {
+        UISMRuntimeComponent* Component = Source.Get();
+        if (Component && Component->BakedState && Component->BakeState(Component->BakedState))
+        {
+            ++NumBaked;
+        }
+    }
+    return NumBaked;
+}
+
+bool UISMRuntimePCGComponent::AreAllSourcesBaked() const
+{
+    if (ResolvedSources.IsEmpty())
+    {
+        return false;
+    }
+
+    for (const TWeakObjectPtr<UISMRuntimeComponent>& Source : ResolvedSources)
+    {
+        const UISMRuntimeComponent* Component = Source.Get();
+        if (!Component || !Component->WasInitializedFromBakedState())
+        {
+            return false;
+        }
+    }
+
+    UE_LOG(LogISMRuntimePCGInterop, Verbose, TEXT("UISMRuntimePCGComponent on '%s': every source started from its bake, skipping the Precompute run"),
+        *GetOwner()->GetName());
+    return true;
+}
+
+// ===== Setup =====
+
+bool UISMRuntimePCGComponent::RegisterGraphTransformer()
+{
+    UISMRuntimeSubsystem* RuntimeSubsystem = GetWorld()->GetSubsystem<UISMRuntimeSubsystem>();
+    UISMBatchSchedulerBase* Scheduler = RuntimeSubsystem ? RuntimeSubsystem->GetOrCreateBatchSchduler() : nullptr;
+    if (!Scheduler)
+    {
+        UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("UISMRuntimePCGComponent on '%s': no batch scheduler. Graph will not run."), *GetOwner()->GetName());
+        return false;
+    }
+
+    const FName TransformerName(*FString::Printf(TEXT("ISMPCG.%s.%s"), *GetOwner()->GetName(), *GetName()));
+    TSharedPtr<FISMPCGGraphTransformer> Transformer = MakeShared<FISMPCGGraphTransformer>(TransformerName);
+    if (!Scheduler->RegisterTransformer(Transformer.Get()))
+    {
+        UE_LOG(LogISMRuntimePCGInterop, Warning, TEXT("UISMRuntimePCGComponent::RegisterGraphTransformer - Failed to register %s (name collision?)"),
+            *TransformerName.ToString());
+        return false;
+    }
+
+    CachedScheduler = Scheduler;
+    GraphTransformer = MoveTemp(Transformer);
+    return true;
+}
+
+void UISMRuntimePCGComponent::CreatePCGComponent()
+{
+    PCGComponent = NewObject<UPCGComponent>(GetOwner(), NAME_None, RF_Transient);
+    PCGComponent->SetGraph(PCGGraph);
+    PCGComponent->GenerationTrigger = EPCGComponentGenerationTrigger::GenerateOnDemand;
+    PCGComponent->RegisterComponent();
+}
+
+void UISMRuntimePCGComponent::ResolveSourceComponents()
+{
+    UISMRuntimeSubsystem* RuntimeSubsystem = GetWorld()->GetSubsystem<UISMRuntimeSubsystem>();
+    if (!RuntimeSubsystem)
+    {
+        return;
+    }
+
+    TArray<UInstancedStaticMeshComponent*> ISMs;
+    if (SourceISMs.Num() > 0)
+    {
+        for (UInstancedStaticMeshComponent* ISM : SourceISMs)
+        {
+            if (ISM)
+            {
+                ISMs.Add(ISM);
+            }
+        }
+    }
+    else
+    {
+        GetOwner()->GetComponents<UInstancedStaticMeshComponent>(ISMs);
+    }
+
+    PendingSourceCount = ISMs.Num();
+    for (UInstancedStaticMeshComponent* ISM : ISMs)
+    {
+        RuntimeSubsystem->RequestRuntimeComponent(ISM, [WeakThis = TWeakObjectPtr<UISMRuntimePCGComponent>(this)](UISMRuntimeComponent* Component)
+        {
+            if (UISMRuntimePCGComponent* This = WeakThis.Get())
+            {
+                This->OnSourceComponentReady(Component);
+            }
+        });
+    }
+}
+
+void UISMRuntimePCGComponent::OnSourceComponentReady(UISMRuntimeComponent* Component)
+{
+    PendingSourceCount = FMath::Max(PendingSourceCount - 1, 0);
+    if (!Component || ResolvedSources.Contains(Component))
+    {
+        return;
+    }
+
+    ResolvedSources.Add(Component);
+    if (ExecutionMode == EISMPCGExecutionMode::OnStateChange)
+    {
+        // Batch calls report through OnInstancesChangedBatchNative instead of the per-instance events
+        Component->OnInstanceStateChangedNative.AddUObject(this, &UISMRuntimePCGComponent::OnSourceInstanceChanged);
+        Component->OnInstanceTagsChangedNative.AddUObject(this, &UISMRuntimePCGComponent::OnSourceInstanceChanged);
+        Component->OnInstanceDestroyedNative.AddUObject(this, &UISMRuntimePCGComponent::OnSourceInstanceChanged);
+        Component->OnInstanceAddedNative.AddUObject(this, &UISMRuntimePCGComponent::OnSourceInstanceChanged);
+        Component->OnBatchInstancesAddedNative.AddUObject(this, &UISMRuntimePCGComponent::OnSourceInstancesAdded);
+        Component->OnInstancesChangedBatchNative.AddUObject(this, &UISMRuntimePCGComponent::OnSourceInstancesChanged);
+    }
+}
+
+void UISMRuntimePCGComponent::OnSourceInstanceChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
+{
+    MarkInstanceDirty(Component, InstanceIndex);
+}
+
+void UISMRuntimePCGComponent::OnSourceInstancesChanged(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices)
+{
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        MarkInstanceDirty(Component, InstanceIndex);
+    }
+}
+
+void UISMRuntimePCGComponent::OnSourceInstancesAdded(UISMRuntimeComponent* Component, const TArray<int32>& InstanceIndices)
+{
+    OnSourceInstancesChanged(Component, InstanceIndices);
+}
+
+void UISMRuntimePCGComponent::MarkInstanceDirty(UISMRuntimeComponent* Component, int32 InstanceIndex)
+{
+    // Our own write-back would otherwise retrigger the graph forever
+    if (GraphTransformer.IsValid() && GraphTransformer->GetPhase() == EISMPCGGraphPhase::Applying)
+    {
+        return;
+    }
+
+    if (!bDeltaCapture)
+    {
+        bSourceStateChanged = true;
+        return;
+    }
+
+    if (!Component || !Component->IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
+    }
+
+    const FVector Location = Component->GetInstanceLocation(InstanceIndex);
+    if (SpatialFilterRadius >= 0.0f && FVector::DistSquared(Location, GetOwner()->GetActorLocation()) > FMath::Square(SpatialFilterRadius))
+    {
+        return;
+    }
+
+    DirtyInstances.FindOrAdd(Component).Add(InstanceIndex);
+    DirtyBounds += Location;
+    bSourceStateChanged = true;
+}
+
+bool UISMRuntimePCGComponent::IsDeltaRun() const
+{
+    return ExecutionMode == EISMPCGExecutionMode::OnStateChange && bDeltaCapture && bFullCaptureDone;
+}
+
+// ===== Run =====
+
+bool UISMRuntimePCGComponent::ShouldStartRun(float DeltaTime)
+{
+    if (ResolvedSources.IsEmpty())
+    {
+        return false;
+    }
+
+    switch (ExecutionMode)
+    {
+    case EISMPCGExecutionMode::Precompute:
+        // Wait until every source is in so the one run sees all of them
+        if (!bPrecomputeStarted && PendingSourceCount == 0)
+        {
+            bPrecomputeStarted = true;
+            bExecutionPending = !AreAllSourcesBaked();
+        }
+        break;
+
+    case EISMPCGExecutionMode::Periodic:
+        if (TimeSinceLastExecution >= ExecutionInterval)
+        {
+            // Periodic components that come due together start on successive frames
+            uint64& LastStartFrame = GLastPeriodicStartFrame.FindOrAdd(GetWorld(), MAX_uint64);
+            if (LastStartFrame != GFrameCounter)
+            {
+                LastStartFrame = GFrameCounter;
+                bExecutionPending = true;
+            }
+        }
+        break;
+
+    case EISMPCGExecutionMode::OnStateChange:
+        if (bSourceStateChanged && TimeSinceLastExecution >= ExecutionInterval)
+        {
+            bExecutionPending = true;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return bExecutionPending;
+}
+
+bool UISMRuntimePCGComponent::StartRun()
+{
+    const bool bDeltaRun = IsDeltaRun();
+    if (bDeltaRun)
+    {
+        // Just the cells around what changed; the transformer keeps only the changed instances
+        if (!GraphTransformer->BeginCapture(ResolvedSources, DirtyBounds.ExpandBy(1.0), BuildWriteMask(), &DirtyInstances))
+        {
+            return false;
+        }
+    }
+    else if (!GraphTransformer->BeginCapture(ResolvedSources, BuildSpatialBounds(), BuildWriteMask()))
+    {
+        return false;
+    }
+
+    if (bDeltaRun)
+    {
+        LastRunLifetime = EISMPCGDataLifetime::Accumulating;
+    }
+    else
+    {
+        LastRunLifetime = ExecutionMode == EISMPCGExecutionMode::Precompute ? EISMPCGDataLifetime::Persistent : EISMPCGDataLifetime::Ephemeral;
+    }
+    bFullCaptureDone = true;
+    DirtyInstances.Reset();
+    DirtyBounds = FBox(ForceInit);
+
+    GraphTransformer->SetPhaseStartTime(GetWorld()->GetTimeSeconds());
+    bExecutionPending = false;
+    bSourceStateChanged = false;
+    bGraphRunning = false;
+    TimeSinceLastExecution = 0.0f;
+    return true;
+}
+
+void UISMRuntimePCGComponent::ExecuteGraph()
+{
+    const TArray<FISMBatchSnapshot> Chunks = GraphTransformer->TakeCapturedChunks();
+
+    RunComponentsById.Reset();
+    for (const FISMBatchSnapshot& Chunk : Chunks)
+    {
+        if (UISMRuntimeComponent* Component = Chunk.SourceComponent.Get())
+        {
+            RunComponentsById.Add(UISMPCGBridge::GetComponentId(Component), Component);
+        }
+    }
+
+    GraphInput = UISMPCGBridge::SnapshotsToPointData(Chunks, BuildQueryFilter(), this);
+    if (!GraphInput || !PCGComponent)
+    {
+        GraphTransformer->Cancel();
+        return;
+    }
+
+    PCGComponent->GenerateLocal(true);
+    bGraphRunning = true;
+}
+
+void UISMRuntimePCGComponent::OnGraphComplete()
+{
+    bGraphRunning = false;
+    GraphInput = nullptr;
+
+    TArray<const UPCGBasePointData*> OutputPoints;
+    if (PCGComponent)
+    {
+        for (const FPCGTaggedData& TaggedData : PCGComponent->GetGeneratedGraphOutput().TaggedData)
+        {
+            if (const UPCGBasePointData* PointData = Cast<UPCGBasePointData>(TaggedData.Data))
+            {
+                OutputPoints.Add(PointData);
+            }
+        }
+    }
+    LastGraphOutput = OutputPoints.Num() > 0 ? const_cast<UPCGBasePointData*>(OutputPoints[0]) : nullptr;
+
+    // Group output rows by component; points whose identity doesn't resolve are dropped
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, FISMPCGGraphComponentResults> Results;
+    for (const UPCGBasePointData* PointData : OutputPoints)
+    {
+        const UPCGMetadata* Metadata = PointData->ConstMetadata();
+        const FPCGMetadataAttribute<int32>* IndexAttribute = Metadata ? Metadata->GetConstTypedAttribute<int32>(ISMPCGAttributes::InstanceIndex) : nullptr;
+        const FPCGMetadataAttribute<int32>* ComponentAttribute = Metadata ? Metadata->GetConstTypedAttribute<int32>(ISMPCGAttributes::ComponentId) : nullptr;
+        if (!IndexAttribute || !ComponentAttribute)
+        {
+            continue;
+        }
+
+        const FPCGMetadataAttribute<int32>* StateAttribute = Metadata->GetConstTypedAttribute<int32>(ISMPCGAttributes::StateFlags);
+        TArray<const FPCGMetadataAttribute<float>*> SlotAttributes;
+
+        const TConstPCGValueRange<FTransform> TransformRange = PointData->GetConstTransformValueRange();
+        const TConstPCGValueRange<int64> EntryRange = PointData->GetConstMetadataEntryValueRange();
+
+        for (int32 PointIndex = 0; PointIndex < PointData->GetNumPoints(); ++PointIndex)
+        {
+            const PCGMetadataEntryKey EntryKey = EntryRange[PointIndex];
+            const TWeakObjectPtr<UISMRuntimeComponent>* Component = RunComponentsById.Find(ComponentAttribute->GetValueFromItemKey(EntryKey));
+            if (!Component || !Component->IsValid())
+            {
+                continue;
+            }
+
+            FISMPCGGraphComponentResults* ComponentResults = Results.Find(*Component);
+            if (!ComponentResults)
+            {
+                ComponentResults = &Results.Add(*Component);
+                ComponentResults->CustomDataStride = (*Component)->ManagedISMComponent ? (*Component)->ManagedISMComponent->NumCustomDataFloats : 0;
+                ComponentResults->bHasTransforms = bAutoApplyTransforms;
+                ComponentResults->bHasStateFlags = bAutoApplyStates && StateAttribute != nullptr;
+                if (bAutoApplyCustomData)
+                {
+                    for (int32 Slot = 0; Slot < ComponentResults->CustomDataStride; ++Slot)
+                    {
+                        if (Metadata->GetConstTypedAttribute<float>(MakeCustomDataAttributeName(Slot)))
+                        {
+                            ComponentResults->WrittenSlots.Add(Slot);
+                        }
+                    }
+                }
+            }
+
+            const int32 Stride = ComponentResults->CustomDataStride;
+            for (int32 Slot = SlotAttributes.Num(); Slot < Stride; ++Slot)
+            {
+                SlotAttributes.Add(Metadata->GetConstTypedAttribute<float>(MakeCustomDataAttributeName(Slot)));
+            }
+
+            // Last point for an instance wins
+            const int32 InstanceIndex = IndexAttribute->GetValueFromItemKey(EntryKey);
+            int32* ExistingRow = ComponentResults->RowOfInstance.Find(InstanceIndex);
+            const int32 Row = ExistingRow ? *ExistingRow : ComponentResults->Transforms.Num();
+            if (!ExistingRow)
+            {
+                ComponentResults->RowOfInstance.Add(InstanceIndex, Row);
+                ComponentResults->Transforms.AddDefaulted();
+                ComponentResults->StateFlags.AddZeroed();
+                ComponentResults->CustomData.AddZeroed(Stride);
+            }
+
+            ComponentResults->Transforms[Row] = TransformRange[PointIndex];
+            if (StateAttribute)
+            {
+                ComponentResults->StateFlags[Row] = static_cast<uint8>(StateAttribute->GetValueFromItemKey(EntryKey));
+            }
+            for (const int32 Slot : ComponentResults->WrittenSlots)
+            {
+                if (const FPCGMetadataAttribute<float>* SlotAttribute = SlotAttributes[Slot])
+                {
+                    ComponentResults->CustomData[Row * Stride + Slot] = SlotAttribute->GetValueFromItemKey(EntryKey);
+                }
+            }
+        }
+    }
+
+    RunComponentsById.Reset();
+    GraphTransformer->BeginApply(MoveTemp(Results));
+    GraphTransformer->SetPhaseStartTime(GetWorld()->GetTimeSeconds());
+
+    OnGraphExecuted.Broadcast(this, LastGraphOutput);
+}
+
+// ===== Helpers =====
+
+FISMQueryFilter UISMRuntimePCGComponent::BuildQueryFilter() const
+{
+    FISMQueryFilter Filter;
+    Filter.RequiredTags = InstanceTagFilter;
+    return Filter;
+}
+
+FBox UISMRuntimePCGComponent::BuildSpatialBounds() const
+{
+    if (SpatialFilterRadius < 0.0f)
+    {
+        return FBox(ForceInit);
+    }
+    return FBox::BuildAABB(GetOwner()->GetActorLocation(), FVector(SpatialFilterRadius));
+}
+
+EISMSnapshotField UISMRuntimePCGComponent::BuildWriteMask() const
+{
+    EISMSnapshotField Mask = EISMSnapshotField::None;
+    if (bAutoApplyTransforms)
+    {
+        Mask |= EISMSnapshotField::Transform;
+    }
+    if (bAutoApplyStates)
+    {
+        Mask |= EISMSnapshotField::StateFlags;
+    }
+    if (bAutoApplyCustomData)
+    {
+        Mask |= EISMSnapshotField::CustomData;
+    }
+    return Mask;
+}
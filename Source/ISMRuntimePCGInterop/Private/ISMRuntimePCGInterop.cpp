@@ -1,5 +1,7 @@
 #include "ISMRuntimePCGInterop.h"
 
+LLM_DEFINE_TAG(ISMRuntime_PCG);
+
 #define LOCTEXT_NAMESPACE "FISMRuntimePCGInteropModule"
 
 void FISMRuntimePCGInterop::StartupModule()
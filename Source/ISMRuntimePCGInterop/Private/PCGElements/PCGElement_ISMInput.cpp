@@ -0,0 +1,71 @@
+// PCGElement_ISMInput.cpp
+
+#include "PCGElements/PCGElement_ISMInput.h"
+#include "ISMRuntimePCGComponent.h"
+#include "ISMPCGBridge.h"
+#include "PCGComponent.h"
+#include "PCGContext.h"
+#include "PCGPin.h"
+#include "Data/PCGBasePointData.h"
+#include "GameFramework/Actor.h"
+
+#define LOCTEXT_NAMESPACE "PCGISMInputElement"
+
+#if WITH_EDITOR
+FText UPCGISMInputSettings::GetDefaultNodeTitle() const
+{
+    return LOCTEXT("NodeTitle", "ISM Runtime Input");
+}
+
+FText UPCGISMInputSettings::GetNodeTooltipText() const
+{
+    return LOCTEXT("NodeTooltip", "Instances captured by the owning actor's ISM Runtime PCG component for this run.");
+}
+#endif
+
+TArray<FPCGPinProperties> UPCGISMInputSettings::OutputPinProperties() const
+{
+    TArray<FPCGPinProperties> Properties;
+    Properties.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::Point);
+    return Properties;
+}
+
+FPCGElementPtr UPCGISMInputSettings::CreateElement() const
+{
+    return MakeShared<FPCGISMInputElement>();
+}
+
+bool FPCGISMInputElement::ExecuteInternal(FPCGContext* Context) const
+{
+    check(Context);
+
+    const UPCGComponent* SourceComponent = Cast<UPCGComponent>(Context->ExecutionSource.GetObject());
+    const AActor* Owner = SourceComponent ? SourceComponent->GetOwner() : nullptr;
+    if (!Owner)
+    {
+        return true;
+    }
+
+    // An actor can run several graphs; pick the runtime component driving this one
+    TInlineComponentArray<UISMRuntimePCGComponent*> RuntimePCGComponents(Owner);
+    for (const UISMRuntimePCGComponent* RuntimePCGComponent : RuntimePCGComponents)
+    {
+        if (RuntimePCGComponent->GetPCGComponent() != SourceComponent)
+        {
+            continue;
+        }
+
+        if (UPCGBasePointData* GraphInput = RuntimePCGComponent->GetGraphInput())
+        {
+            FPCGTaggedData& Output = Context->OutputData.TaggedData.Emplace_GetRef();
+            Output.Data = GraphInput;
+            Output.Pin = PCGPinConstants::DefaultOutputLabel;
+        }
+        return true;
+    }
+
+    UE_LOG(LogISMRuntimePCGInterop, Verbose, TEXT("ISM Runtime Input: '%s' is not driven by a UISMRuntimePCGComponent, no points output"), *Owner->GetName());
+    return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -5,6 +5,8 @@
 #include "GameplayTagContainer.h"
 #include "ISMPCGAttributeSchema.generated.h"
 
+struct FISMPCGInstancePoint;
+
 UENUM(BlueprintType)
 enum class EISMPCGAttributeTarget : uint8
 {
@@ -51,6 +53,46 @@ struct FISMPCGAttributeMapping
     float DefaultValue = 0.0f;
 };
 
+/**
+ * A schema with every mapping resolved once, grouped by target.
+ *
+ * Conversion code walks one group at a time with the slot, tag or axis already in hand, so there
+ * is no per-point switch on the target and no per-point mapping lookup. Built by
+ * UISMPCGAttributeSchema::GetCompiled and shared by every conversion until the mappings change.
+ */
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGCompiledSchema
+{
+    struct FSlotOp   { FName AttributeName; int32 Slot = 0; float DefaultValue = 0.0f; };
+    struct FTagOp    { FName AttributeName; FGameplayTag Tag; };
+    struct FAxisOp   { FName AttributeName; int32 Axis = 0; };
+
+    TArray<FSlotOp> CustomDataOps;
+    TArray<FTagOp>  TagOps;
+    TArray<FName>   StateFlagOps;
+    TArray<FAxisOp> LocationOps;
+    TArray<FName>   ScaleOps;
+
+    /** PCG attribute name → index into the schema's Mappings */
+    TMap<FName, int32> MappingIndexByName;
+
+    bool bSerializeTagsAsAttributes = false;
+
+    /** Hash of the mappings this was compiled from */
+    uint32 SourceHash = 0;
+
+    bool IsEmpty() const
+    {
+        return CustomDataOps.IsEmpty() && TagOps.IsEmpty() && StateFlagOps.IsEmpty() && LocationOps.IsEmpty()
+            && ScaleOps.IsEmpty() && !bSerializeTagsAsAttributes;
+    }
+
+    /** ISM → PCG: write mapped fields into the point's payloads */
+    void WritePoint(FISMPCGInstancePoint& Point) const;
+
+    /** PCG → ISM: fold mapped payloads back into the point's fields. Missing attributes leave fields alone. */
+    void ReadPoint(FISMPCGInstancePoint& Point) const;
+};
+
 /**
  * Data asset defining how PCG attributes map to ISM Runtime fields.
  * Assign one of these to any component or PCG element that uses the interop layer.
@@ -81,4 +123,15 @@ public:
 
     /** Find mapping for a given PCG attribute name */
     const FISMPCGAttributeMapping* FindMapping(FName PCGAttributeName) const;
+
+    /**
+     * Mappings resolved for conversion. Compiled on first use and again whenever the mappings
+     * change (checked by hash, so edits made from code are picked up too). Game thread.
+     */
+    const FISMPCGCompiledSchema& GetCompiled() const;
+
+private:
+    static uint32 HashMappings(const TArray<FISMPCGAttributeMapping>& InMappings, bool bInSerializeTags);
+
+    mutable TSharedPtr<FISMPCGCompiledSchema> CompiledSchema;
 };
\ No newline at end of file
@@ -3,10 +3,16 @@
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #include "ISMPCGDataChannel.h"
+#include "ISMPCGColumnarPacket.h"
+#include "ISMPCGPartitionedPacket.h"
 #include "ISMPCGAttributeSchema.h"
 #include "ISMQueryFilter.h"
+#include "Batching/ISMBatchTypes.h"
 #include "ISMPCGBridge.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogISMRuntimePCGInterop, Log, All);
+
+class UPCGBasePointData;
 class UPCGComponent;
 class UPCGGraphInterface;
 class UISMRuntimeComponent;
@@ -14,163 +20,255 @@ class UISMRuntimeComponent;
 /**
  * Options for dispatching a PCG graph with ISM data.
  */
-//USTRUCT(BlueprintType)
-//struct FISMPCGDispatchOptions
-//{
-//    GENERATED_BODY()
-//
-//    /** Schema to use for attribute translation. If null, uses passthrough. */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
-//    UISMPCGAttributeSchema* Schema = nullptr;
-//
-//    /** Filter to apply when reading instances into the packet */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
-//    FISMQueryFilter InstanceFilter;
-//
-//    /**
-//     * Whether to apply the resulting packet back to instances immediately,
-//     * or just return it (false = caller is responsible for applying results).
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
-//    bool bAutoApplyResults = true;
-//
-//    /**
-//     * Whether to only process instances visible in a radius.
-//     * -1 = no radius filter.
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
-//    float ProcessRadius = -1.0f;
-//
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
-//    FVector ProcessOrigin = FVector::ZeroVector;
-//};
-//
-///**
-//UCLASS()
-//class ISMRUNTIMEPCGINTEROP_API UISMPCGBridge : public UObject
-//{
-//    GENERATED_BODY()
-//
-//public:
-//
-//    // ===== ISM → PCG Direction =====
-//
-//    /**
-//     * Read all (or filtered) instances from a runtime component into a data packet.
-//     * This is the "export to PCG" path.
-//     *
-//     * @param Component  Source ISM Runtime component
-//     * @param Schema     How to map ISM fields to PCG attributes (nullable = passthrough)
-//     * @param Filter     Which instances to include
-//     * @return           Data packet ready to inject into a PCG graph
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
-//    static FISMPCGDataPacket ReadInstancesFromComponent(
-//        UISMRuntimeComponent* Component,
-//        UISMPCGAttributeSchema* Schema,
-//        const FISMQueryFilter& Filter);
-//
-//    /**
-//     * Read instances from multiple components, merging into one packet.
-//     * Useful for subsystem-level queries.
-//     */
-//    static FISMPCGDataPacket ReadInstancesFromComponents(
-//        const TArray<UISMRuntimeComponent*>& Components,
-//        UISMPCGAttributeSchema* Schema,
-//        const FISMQueryFilter& Filter);
-//
-//    // ===== PCG → ISM Direction =====
-//
-//    /**
-//     * Apply a data packet back to ISM instances.
-//     * This is the "import from PCG" path.
-//     *
-//     * Matches points back to their source handles and applies:
-//     * - Transform updates (if transform changed)
-//     * - State flag changes
-//     * - Tag additions/removals
-//     * - Custom data slot writes
-//     *
-//     * @param Packet     Data packet produced by PCG
-//     * @param Schema     How to interpret PCG attributes back to ISM fields
-//     * @param bWriteTransforms  Whether to update instance transforms from packet
-//     * @param bWriteStates      Whether to update state flags
-//     * @param bWriteTags        Whether to update gameplay tags
-//     * @param bWriteCustomData  Whether to write custom data slots
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
-//    static void ApplyPacketToInstances(
-//        const FISMPCGDataPacket& Packet,
-//        UISMPCGAttributeSchema* Schema,
-//        bool bWriteTransforms = false,
-//        bool bWriteStates = true,
-//        bool bWriteTags = true,
-//        bool bWriteCustomData = true);
-//
-//    /**
-//     * Apply a packet as NEW instances (for spawn-from-PCG workflows).
-//     * Points don't need source handles - they're added to the component fresh.
-//     *
-//     * @param Packet     Points to spawn
-//     * @param Target     Component to add instances to
-//     * @param Schema     Attribute mapping
-//     * @return           Array of new instance indices
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
-//    static TArray<int32> SpawnInstancesFromPacket(
-//        const FISMPCGDataPacket& Packet,
-//        UISMRuntimeComponent* Target,
-//        UISMPCGAttributeSchema* Schema);
-//
-//    // ===== PCG Graph Dispatch =====
-//
-//    /**
-//     * Synchronously dispatch a PCG graph with instance data as input.
-//     * The graph receives the packet via the ISMRuntimeInput PCG node,
-//     * processes it, and returns the result via the ISMRuntimeOutput PCG node.
-//     *
-//     * This is the "runtime PCG as a transform kernel" pattern.
-//     *
-//     * WARNING: Synchronous. Expensive for large instance counts.
-//     * Use for precompute or low-frequency gameplay events.
-//     *
-//     * @param Graph          The PCG graph to execute
-//     * @param InputPacket    Instance data to feed into the graph
-//     * @param OutResultPacket Result data from the graph's output pin
-//     * @param Options        Dispatch configuration
-//     * @return               True if graph executed successfully
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
-//    static bool DispatchGraphSync(
-//        UPCGGraphInterface* Graph,
-//        const FISMPCGDataPacket& InputPacket,
-//        FISMPCGDataPacket& OutResultPacket,
-//        const FISMPCGDispatchOptions& Options);
-//
-//    /**
-//     * Async graph dispatch. Callback fires on game thread when complete.
-//     * Prefer this for runtime use.
-//     */
-//    static void DispatchGraphAsync(
-//        UPCGGraphInterface* Graph,
-//        const FISMPCGDataPacket& InputPacket,
-//        const FISMPCGDispatchOptions& Options,
-//        TFunction<void(const FISMPCGDataPacket&)> OnComplete);
-//
-//    // ===== Point Conversion Utilities (low-level) =====
-//
-//    /** Convert a single ISM instance to an FISMPCGInstancePoint */
-//    static FISMPCGInstancePoint InstanceToPoint(
-//        UISMRuntimeComponent* Component,
-//        int32 InstanceIndex,
-//        UISMPCGAttributeSchema* Schema);
-//
-//    /** Apply a single point back to its source instance */
-//    static void ApplyPointToInstance(
-//        const FISMPCGInstancePoint& Point,
-//        UISMPCGAttributeSchema* Schema,
-//        bool bWriteTransform,
-//        bool bWriteState,
-//        bool bWriteTags,
-//        bool bWriteCustomData);
-//};
\ No newline at end of file
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGDispatchOptions
+{
+    GENERATED_BODY()
+
+    /** Schema to use for attribute translation. If null, uses passthrough. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
+    TObjectPtr<UISMPCGAttributeSchema> Schema = nullptr;
+
+    /** Filter to apply when reading instances into the packet */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
+    FISMQueryFilter InstanceFilter;
+
+    /**
+     * Whether to apply the resulting packet back to instances immediately,
+     * or just return it (false = caller is responsible for applying results).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
+    bool bAutoApplyResults = true;
+
+    /**
+     * Whether to only process instances visible in a radius.
+     * -1 = no radius filter.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
+    float ProcessRadius = -1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatch")
+    FVector ProcessOrigin = FVector::ZeroVector;
+};
+
+/**
+ * Static entry points for moving instance data between ISM Runtime components and PCG.
+ *
+ * Export reads transforms and custom data straight out of the managed ISM's
+ * PerInstanceSMData / PerInstanceSMCustomData arrays in one pass, never through
+ * per-instance GetInstanceTransform calls. Import groups points by component and goes
+ * through the batched component paths (BatchUpdateInstanceTransforms,
+ * WriteInstanceCustomData, BatchWriteInstanceStateFlags), so a packet costs one
+ * render-state update per component regardless of its size.
+ *
+ * Destroyed instances are never exported. On import, points whose handle no longer
+ * resolves follow the packet's StaleHandlePolicy.
+ */
+UCLASS()
+class ISMRUNTIMEPCGINTEROP_API UISMPCGBridge : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    // ===== ISM → PCG Direction =====
+
+    /**
+     * Read all (or filtered) instances from a runtime component into a data packet.
+     * This is the "export to PCG" path.
+     *
+     * @param Component  Source ISM Runtime component
+     * @param Schema     How to map ISM fields to PCG attributes (nullable = passthrough)
+     * @param Filter     Which instances to include
+     * @return           Data packet ready to inject into a PCG graph
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
+    static FISMPCGDataPacket ReadInstancesFromComponent(
+        UISMRuntimeComponent* Component,
+        UISMPCGAttributeSchema* Schema,
+        const FISMQueryFilter& Filter);
+
+    /**
+     * Read instances from multiple components, merging into one packet.
+     * Useful for subsystem-level queries.
+     */
+    static FISMPCGDataPacket ReadInstancesFromComponents(
+        const TArray<UISMRuntimeComponent*>& Components,
+        UISMPCGAttributeSchema* Schema,
+        const FISMQueryFilter& Filter);
+
+    /**
+     * Read instances into a columnar packet. Custom data runs of consecutive instances
+     * are copied as whole blocks; no per-point allocation. Prefer this for large exports.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
+    static FISMPCGColumnarPacket ReadInstancesToColumnarPacket(
+        UISMRuntimeComponent* Component,
+        const FISMQueryFilter& Filter);
+
+    /**
+     * Export the cells of a partitioned packet that overlap Bounds (all cells when invalid),
+     * bucketing instances by world location. Each exported cell replaces its resident packet;
+     * resident cells in Bounds that no longer hold instances are freed. Cells outside Bounds are
+     * untouched, so a streaming source can grow and trim its region one call at a time.
+     * The packet adopts the component's SpatialIndexCellSize if it has no cell size yet.
+     *
+     * @return Number of cells written
+     */
+    static int32 ReadInstancesToPartitionedPacket(
+        UISMRuntimeComponent* Component,
+        const FISMQueryFilter& Filter,
+        const FBox& Bounds,
+        FISMPCGPartitionedPacket& InOutPacket);
+
+    /**
+     * Read instances directly into PCG point data, for feeding a graph without a packet.
+     * Writes world transforms into the point transform range, and ISM.InstanceIndex,
+     * ISM.ComponentId, ISM.StateFlags and ISM.CustomData.N as metadata attributes.
+     *
+     * @param Outer   Outer for the new point data (e.g. the executing PCG component)
+     * @param Schema  Optional: each mapping becomes one more attribute column (tag serialization is row-packet only)
+     * @return        New point data, or null if the component has no managed ISM
+     */
+    static UPCGBasePointData* ReadInstancesToPointData(
+        UISMRuntimeComponent* Component,
+        const FISMQueryFilter& Filter,
+        UObject* Outer,
+        UISMPCGAttributeSchema* Schema = nullptr);
+
+    /**
+     * Build PCG point data from batch scheduler snapshots (either layout), with the same attributes
+     * as ReadInstancesToPointData. Fields missing from a chunk's PopulatedFields are left at their
+     * defaults. Game thread: resolves each chunk's component to bind Filter.
+     *
+     * @param Filter  Instances to keep, tested against the live component
+     * @param Outer   Outer for the new point data
+     */
+    static UPCGBasePointData* SnapshotsToPointData(
+        TConstArrayView<FISMBatchSnapshot> Chunks,
+        const FISMQueryFilter& Filter,
+        UObject* Outer);
+
+    // ===== PCG → ISM Direction =====
+
+    /**
+     * Apply a data packet back to ISM instances.
+     * This is the "import from PCG" path.
+     *
+     * Matches points back to their source handles and applies:
+     * - Transform updates (if transform changed)
+     * - State flag changes
+     * - Tag additions/removals
+     * - Custom data slot writes
+     *
+     * Each field is written only if both its parameter and the packet's WriteMask allow it.
+     * Stale packets (see FISMPCGDataPacket::IsFresh) are dropped entirely.
+     *
+     * Points are partitioned by source component. Large packets validate handles (under the
+     * packet's StaleHandlePolicy) and build each component's write streams on workers; only the
+     * batched writes themselves run on the game thread.
+     *
+     * @param Packet     Data packet produced by PCG
+     * @param Schema     How to interpret PCG attributes back to ISM fields
+     * @param bWriteTransforms  Whether to update instance transforms from packet
+     * @param bWriteStates      Whether to update state flags
+     * @param bWriteTags        Whether to update gameplay tags
+     * @param bWriteCustomData  Whether to write custom data slots
+     * @return           Number of points applied
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
+    static int32 ApplyPacketToInstances(
+        const FISMPCGDataPacket& Packet,
+        UISMPCGAttributeSchema* Schema,
+        bool bWriteTransforms = false,
+        bool bWriteStates = true,
+        bool bWriteTags = true,
+        bool bWriteCustomData = true);
+
+    /** ApplyPacketToInstances for a columnar packet. Tags are expanded from the tag table without building containers. */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
+    static int32 ApplyColumnarPacketToInstances(
+        const FISMPCGColumnarPacket& Packet,
+        bool bWriteTransforms = false,
+        bool bWriteStates = true,
+        bool bWriteTags = true,
+        bool bWriteCustomData = true);
+
+    /**
+     * ApplyColumnarPacketToInstances for every resident cell of a partitioned packet, one
+     * batched write per cell. To consume cells as they arrive, TakeCell and apply them singly.
+     */
+    static int32 ApplyPartitionedPacketToInstances(
+        const FISMPCGPartitionedPacket& Packet,
+        bool bWriteTransforms = false,
+        bool bWriteStates = true,
+        bool bWriteTags = true,
+        bool bWriteCustomData = true);
+
+    /**
+     * Apply PCG point data back to the instances of one component.
+     * Points are matched by their ISM.InstanceIndex attribute (as written by ReadInstancesToPointData);
+     * points without it, or whose index is destroyed, are skipped.
+     *
+     * @return Number of points applied
+     */
+    static int32 ApplyPointDataToInstances(
+        const UPCGBasePointData* PointData,
+        UISMRuntimeComponent* Target,
+        bool bWriteTransforms = false,
+        bool bWriteCustomData = true);
+
+    /**
+     * Apply a packet as NEW instances (for spawn-from-PCG workflows).
+     * Points don't need source handles - they're added to the component fresh.
+     *
+     * @param Packet     Points to spawn
+     * @param Target     Component to add instances to
+     * @param Schema     Attribute mapping
+     * @return           Array of new instance indices
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG Bridge")
+    static TArray<int32> SpawnInstancesFromPacket(
+        const FISMPCGDataPacket& Packet,
+        UISMRuntimeComponent* Target,
+        UISMPCGAttributeSchema* Schema);
+
+    /**
+     * Bulk spawn from columnar PCG output through UISMRuntimeComponent::BulkAppendInstances:
+     * transforms and custom data go in as whole columns, the spatial index takes one bulk insert
+     * and listeners see a single batch-added event. Destroyed slots are not reused.
+     * State flags and tags the packet may write are applied afterwards in one batch.
+     *
+     * @return Indices of the new instances, in packet point order
+     */
+    static TArray<int32> SpawnInstancesFromColumnarPacket(
+        const FISMPCGColumnarPacket& Packet,
+        UISMRuntimeComponent* Target);
+
+    // ===== PCG Graph Dispatch =====
+    //
+    // Graphs run through UISMRuntimePCGComponent, which captures instances with the batch
+    // scheduler, feeds them to the graph's ISM Runtime Input node (SnapshotsToPointData) and
+    // writes the output back as batch mutation results. For one-off runs outside the scheduler,
+    // feed graphs with ReadInstancesToPointData and apply with ApplyPointDataToInstances.
+
+    // ===== Point Conversion Utilities (low-level) =====
+
+    /** Convert a single ISM instance to an FISMPCGInstancePoint */
+    static FISMPCGInstancePoint InstanceToPoint(
+        UISMRuntimeComponent* Component,
+        int32 InstanceIndex,
+        UISMPCGAttributeSchema* Schema);
+
+    /** Apply a single point back to its source instance. Prefer ApplyPacketToInstances for more than a handful. */
+    static void ApplyPointToInstance(
+        const FISMPCGInstancePoint& Point,
+        UISMPCGAttributeSchema* Schema,
+        bool bWriteTransform,
+        bool bWriteState,
+        bool bWriteTags,
+        bool bWriteCustomData);
+
+    /** Stable ID written to SourceComponentId for a component */
+    static int32 GetComponentId(const UISMRuntimeComponent* Component);
+};
@@ -0,0 +1,254 @@
+// ISMPCGColumnarPacket.h
+// ISMRuntimePCGInterop Module
+//
+// Column-oriented alternative to FISMPCGDataPacket for large batches.
+//
+// FISMPCGDataPacket stores an array of FISMPCGInstancePoint, each owning its own custom data
+// array, three payload maps and a tag container, so a 50k-point packet costs hundreds of
+// thousands of small allocations. The columnar packet stores one array per field instead:
+//   - Transforms, state flags and handles are packed arrays indexed by point
+//   - Custom data is one float array with a fixed stride (slots per point)
+//   - Tags are a shared tag table plus a bitmask per point
+//   - Named payloads are typed columns sharing one schema: every point has every attribute
+//
+// This is the layout UPCGMetadata uses (one typed value array per attribute), so moving a
+// column to or from PCG attribute storage is a single bulk copy instead of a per-point map walk.
+// Convert with FromPacket/ToPacket where the row form is still needed.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ISMInstanceHandle.h"
+#include "ISMPCGDataChannel.h"
+#include "ISMPCGColumnarPacket.generated.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Attribute Columns
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** A named float attribute: one value per point */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGFloatColumn
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    FName Name;
+
+    /** Value for points that never set this attribute */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    float DefaultValue = 0.0f;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<float> Values;
+};
+
+/** A named int32 attribute: one value per point */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGIntColumn
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    FName Name;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    int32 DefaultValue = 0;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<int32> Values;
+};
+
+/** A named vector attribute: one value per point */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGVectorColumn
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    FName Name;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    FVector DefaultValue = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FVector> Values;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Columnar Packet
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * A batch of ISM instance points stored column by column.
+ *
+ * Every per-point array has exactly Num() entries (custom data and tag bits have Num() times
+ * their stride); AddPoints and the column accessors keep them in step. Packet metadata
+ * (source, channel, lifetime, write mask) matches FISMPCGDataPacket field for field.
+ *
+ * Row i of every column describes point i; PacketSequenceIndex is implicitly i.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGColumnarPacket
+{
+    GENERATED_BODY()
+
+    // ── Per-Point Columns ─────────────────────────────────────────────────────
+
+    /** Source instance per point; invalid for points generated inside a PCG graph */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FISMInstanceHandle> SourceHandles;
+
+    /** Source component ID per point (see FISMPCGInstancePoint::SourceComponentId) */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<int32> SourceComponentIds;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FTransform> Transforms;
+
+    /** EISMInstanceState bits per point */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<uint8> StateFlags;
+
+    /** Custom data slots per point; CustomData holds NumCustomDataSlots floats per point */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    int32 NumCustomDataSlots = 0;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<float> CustomData;
+
+    /** Every tag any point carries; bit N of a point's mask = TagTable[N] */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FGameplayTag> TagTable;
+
+    /** GetNumTagWords() words per point */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<int64> TagBits;
+
+    // ── Attribute Schema ──────────────────────────────────────────────────────
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FISMPCGFloatColumn> FloatColumns;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FISMPCGIntColumn> IntColumns;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Columns")
+    TArray<FISMPCGVectorColumn> VectorColumns;
+
+    // ── Source Metadata (as FISMPCGDataPacket) ────────────────────────────────
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    TWeakObjectPtr<UISMRuntimeComponent> SourceComponent;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    int32 SourceComponentId = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    FGameplayTag ChannelTag;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    double CaptureTimeSeconds = 0.0;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    float MaxAgeSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    EISMPCGDataLifetime DataLifetime = EISMPCGDataLifetime::Ephemeral;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    EISMPCGStaleHandlePolicy StaleHandlePolicy = EISMPCGStaleHandlePolicy::Skip;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    EISMPCGWriteMask WriteMask = EISMPCGWriteMask::StateFlagsW
+                               | EISMPCGWriteMask::Tags
+                               | EISMPCGWriteMask::CustomData;
+
+    // ── Size ──────────────────────────────────────────────────────────────────
+
+    int32 Num() const { return Transforms.Num(); }
+    bool IsEmpty() const { return Transforms.IsEmpty(); }
+
+    /** 64-bit words of TagBits per point */
+    int32 GetNumTagWords() const { return (TagTable.Num() + 63) / 64; }
+
+    /** Reserve every per-point column for Count points */
+    void Reserve(int32 Count);
+
+    /**
+     * Append Count points with identity transforms, invalid handles, no tags and every
+     * attribute at its column default. Returns the index of the first new point.
+     */
+    int32 AddPoints(int32 Count);
+
+    /** Drop all points, keeping the schema (columns, tag table, slot count) */
+    void ResetPoints();
+
+    bool IsFresh(double CurrentWorldTimeSeconds) const
+    {
+        if (MaxAgeSeconds <= 0.0f) return true;
+        return (CurrentWorldTimeSeconds - CaptureTimeSeconds) <= MaxAgeSeconds;
+    }
+
+    bool CanWrite(EISMPCGWriteMask Flag) const
+    {
+        return EnumHasAnyFlags(WriteMask, Flag);
+    }
+
+    // ── Schema ────────────────────────────────────────────────────────────────
+
+    /** Column for Name, added (filled with Default for existing points) if missing */
+    FISMPCGFloatColumn& FindOrAddFloatColumn(FName Name, float Default = 0.0f);
+    FISMPCGIntColumn& FindOrAddIntColumn(FName Name, int32 Default = 0);
+    FISMPCGVectorColumn& FindOrAddVectorColumn(FName Name, FVector Default = FVector::ZeroVector);
+
+    const FISMPCGFloatColumn* FindFloatColumn(FName Name) const;
+    const FISMPCGIntColumn* FindIntColumn(FName Name) const;
+    const FISMPCGVectorColumn* FindVectorColumn(FName Name) const;
+
+    /** Grow the custom data stride to at least Count slots, zero-filling new slots */
+    void SetNumCustomDataSlots(int32 Count);
+
+    /** Bit index of Tag in TagTable, adding it (and widening TagBits) if missing */
+    int32 FindOrAddTag(const FGameplayTag& Tag);
+
+    // ── Per-Point Access ──────────────────────────────────────────────────────
+
+    /** Custom data of one point, NumCustomDataSlots long */
+    TArrayView<float> GetCustomData(int32 PointIndex)
+    {
+        return TArrayView<float>(CustomData.GetData() + PointIndex * NumCustomDataSlots, NumCustomDataSlots);
+    }
+    TConstArrayView<float> GetCustomData(int32 PointIndex) const
+    {
+        return TConstArrayView<float>(CustomData.GetData() + PointIndex * NumCustomDataSlots, NumCustomDataSlots);
+    }
+
+    bool HasTag(int32 PointIndex, int32 TagBit) const;
+    void SetTag(int32 PointIndex, int32 TagBit, bool bHasTag);
+
+    /** Expand a point's tag bits back into a container */
+    FGameplayTagContainer GetTags(int32 PointIndex) const;
+
+    /** Index of the point for Handle, or INDEX_NONE */
+    int32 FindByHandle(const FISMInstanceHandle& Handle) const;
+
+    // ── Row Packet Conversion ─────────────────────────────────────────────────
+
+    /**
+     * Build a columnar packet from row points. The schema is the union of every point's
+     * payload keys and tags; points missing a key get the column default (0).
+     */
+    static FISMPCGColumnarPacket FromPacket(const FISMPCGDataPacket& Packet);
+
+    /** Expand to row points. Every point receives every column, so payload maps are full. */
+    FISMPCGDataPacket ToPacket() const;
+
+private:
+    template<typename ColumnType>
+    static int32 FindColumnIndex(const TArray<ColumnType>& Columns, FName Name)
+    {
+        return Columns.IndexOfByPredicate([Name](const ColumnType& Column) { return Column.Name == Name; });
+    }
+};
@@ -403,32 +403,41 @@ struct ISMRUNTIMEPCGINTEROP_API FISMPCGDataPacket
         return EnumHasAnyFlags(WriteMask, Flag);
     }
 
-    /** Find a point by its source handle. Returns nullptr if not found. */
-    const FISMPCGInstancePoint* FindByHandle(const FISMInstanceHandle& Handle) const
-    {
-        return Points.FindByPredicate([&Handle](const FISMPCGInstancePoint& P)
-        {
-            return P.SourceHandle == Handle;
-        });
-    }
+    /**
+     * Find a point by its source handle. Returns nullptr if not found.
+     *
+     * The first lookup builds a hash index over Points, so matching a whole packet back
+     * is linear. The index is rebuilt when the point count changes or a hit no longer
+     * matches; call InvalidateLookup after editing handles in place. Not safe to call
+     * concurrently on the same packet while the index is being built.
+     */
+    const FISMPCGInstancePoint* FindByHandle(const FISMInstanceHandle& Handle) const;
 
-    /** Find a point by its source instance index within a specific component. */
-    const FISMPCGInstancePoint* FindByInstanceIndex(int32 InstanceIndex) const
-    {
-        return Points.FindByPredicate([InstanceIndex](const FISMPCGInstancePoint& P)
-        {
-            return P.SourceHandle.InstanceIndex == InstanceIndex;
-        });
-    }
+    /** Find a point by its source instance index within a specific component. Same index rules as FindByHandle. */
+    const FISMPCGInstancePoint* FindByInstanceIndex(int32 InstanceIndex) const;
+
+    /** Drop the lookup index; the next Find rebuilds it. */
+    void InvalidateLookup() const { IndexedPointCount = INDEX_NONE; }
 
     /** Reserve capacity for a known number of points (avoid reallocations during capture). */
     void Reserve(int32 Count) { Points.Reserve(Count); }
 
-    /** Append another packet's points into this one. ChannelTag and metadata from this packet are preserved. */
-    void AppendFrom(const FISMPCGDataPacket& Other)
-    {
-        Points.Append(Other.Points);
-    }
+    /**
+     * Append another packet's points into this one. ChannelTag and metadata from this packet are preserved.
+     * A built lookup index is extended with the new points rather than rebuilt.
+     */
+    void AppendFrom(const FISMPCGDataPacket& Other);
+
+private:
+    void BuildLookup() const;
+    void IndexPoints(int32 FirstPoint) const;
+
+    /** Lazily built by FindByHandle / FindByInstanceIndex; first point wins for duplicates */
+    mutable TMap<FISMInstanceHandle, int32> HandleLookup;
+    mutable TMap<int32, int32> InstanceIndexLookup;
+
+    /** Points.Num() when the index was last brought up to date, INDEX_NONE when not built */
+    mutable int32 IndexedPointCount = INDEX_NONE;
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
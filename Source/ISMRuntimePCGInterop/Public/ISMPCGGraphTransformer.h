@@ -0,0 +1,156 @@
+// ISMPCGGraphTransformer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Batching/ISMBatchTransformer.h"
+
+class UISMRuntimeComponent;
+
+/** Where a PCG graph run is in its capture → execute → apply cycle */
+enum class EISMPCGGraphPhase : uint8
+{
+    /** Nothing in flight */
+    Idle,
+
+    /** Waiting for the scheduler to snapshot the source components */
+    Capturing,
+
+    /** Snapshots are in; the owner feeds them to the graph and waits for it */
+    Executing,
+
+    /** Graph output is staged; the scheduler is writing it back chunk by chunk */
+    Applying,
+};
+
+/**
+ * Graph output for one component, keyed by instance index.
+ * Built on the game thread between the Executing and Applying phases, read-only afterwards.
+ */
+struct FISMPCGGraphComponentResults
+{
+    /** Row of each instance in the arrays below */
+    TMap<int32, int32> RowOfInstance;
+
+    TArray<FTransform> Transforms;
+    TArray<uint8> StateFlags;
+
+    /** CustomDataStride floats per row; only slots listed in WrittenSlots are meaningful */
+    TArray<float> CustomData;
+    int32 CustomDataStride = 0;
+    TArray<int32> WrittenSlots;
+
+    bool bHasTransforms = false;
+    bool bHasStateFlags = false;
+};
+
+/**
+ * Batch transformer behind UISMRuntimePCGComponent: runs a PCG graph over the scheduler's snapshots
+ * and writes its output back as FISMBatchMutationResults.
+ *
+ * One graph run takes two scheduler cycles:
+ *   - Capture: reads transforms, custom data and state flags, keeps the chunks and abandons the
+ *     handles at once, so no chunk slot is held while the graph runs
+ *   - Apply: once results are staged, snapshots the same components again (indices only, plus
+ *     state flags when writing them) and emits streams for the instances the graph returned
+ *
+ * The owner drives the phases on the game thread: BeginCapture, TakeCapturedChunks when the phase
+ * reaches Executing, then BeginApply with the graph's output. Results are applied by the scheduler
+ * under its apply budget like any other transformer's.
+ *
+ * Delta capture: BeginCapture can name the instances to keep per component. Capture chunks are
+ * compacted to those before they are stored, so the graph only sees what changed; pass bounds
+ * around those instances to keep the snapshot itself small.
+ *
+ * Staleness: each cell's generation token is kept from the capture. Apply chunks of a cell whose
+ * token has moved since (a slot was recycled) are abandoned, as are cells the capture never saw.
+ *
+ * Threading:
+ *   - BeginCapture, TakeCapturedChunks, BeginApply and Cancel run on the game thread
+ *   - ProcessChunk stores capture chunks under ChunkLock; apply chunks take a reference to the
+ *     staged results under the same lock and read them without it. Results are immutable once
+ *     staged, so a cancelled run's chunks still finish against their own
+ */
+class ISMRUNTIMEPCGINTEROP_API FISMPCGGraphTransformer : public IISMBatchTransformer
+{
+public:
+    explicit FISMPCGGraphTransformer(FName InTransformerName);
+
+    // ===== IISMBatchTransformer =====
+
+    virtual FName GetTransformerName() const override { return TransformerName; }
+
+    /** Dirty when a capture or apply cycle is waiting to dispatch */
+    virtual bool IsDirty() const override { return bDirty; }
+    virtual void ClearDirty() override { bDirty = false; }
+
+    virtual FISMSnapshotRequest BuildRequest() override;
+    virtual void ProcessChunk(FISMBatchSnapshot Chunk, FISMMutationHandle Handle) override;
+
+    /** Advances Capturing → Executing and Applying → Idle */
+    virtual void OnRequestComplete() override;
+
+    // ===== Game Thread API =====
+
+    /**
+     * Start a run: snapshot Targets (cells overlapping Bounds, or all when Bounds is invalid).
+     * WriteMask is what the apply cycle will write. With OnlyInstances, only the listed instances
+     * of each component are captured (components missing from the map contribute none).
+     * Returns false if a run is already in flight.
+     */
+    bool BeginCapture(const TArray<TWeakObjectPtr<UISMRuntimeComponent>>& Targets, const FBox& Bounds, EISMSnapshotField InWriteMask,
+        TMap<TWeakObjectPtr<UISMRuntimeComponent>, TSet<int32>>* OnlyInstances = nullptr);
+
+    /** The capture's chunks; only meaningful in the Executing phase */
+    TArray<FISMBatchSnapshot> TakeCapturedChunks();
+
+    /** Stage graph output and start the apply cycle; with no results the run ends here */
+    void BeginApply(TMap<TWeakObjectPtr<UISMRuntimeComponent>, FISMPCGGraphComponentResults>&& InResults);
+
+    /** Drop the run, whatever its phase. Chunks already launched finish against the old results. */
+    void Cancel();
+
+    EISMPCGGraphPhase GetPhase() const { return Phase.load(); }
+
+    /** World seconds (from the owner) at which the current phase began, for stall detection */
+    double GetPhaseStartTime() const { return PhaseStartTime; }
+    void SetPhaseStartTime(double InTime) { PhaseStartTime = InTime; }
+
+    /** Instances written by the last completed apply cycle */
+    int32 GetLastAppliedCount() const { return LastAppliedCount.load(std::memory_order_relaxed); }
+
+private:
+    using FResultsMap = TMap<TWeakObjectPtr<UISMRuntimeComponent>, FISMPCGGraphComponentResults>;
+    using FInstanceFilterMap = TMap<TWeakObjectPtr<UISMRuntimeComponent>, TSet<int32>>;
+
+    void SetPhase(EISMPCGGraphPhase InPhase);
+
+    void ProcessCaptureChunk(FISMBatchSnapshot&& Chunk, FISMMutationHandle& Handle);
+    void ProcessApplyChunk(const FISMBatchSnapshot& Chunk, FISMMutationHandle& Handle);
+
+    FName TransformerName;
+
+    /** Set on the game thread; ProcessChunk reads it to tell capture chunks from apply chunks */
+    std::atomic<EISMPCGGraphPhase> Phase{EISMPCGGraphPhase::Idle};
+
+    /** Game thread only */
+    bool bDirty = false;
+    double PhaseStartTime = 0.0;
+
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> TargetComponents;
+    FBox SpatialBounds = FBox(ForceInit);
+    EISMSnapshotField WriteMask = EISMSnapshotField::None;
+
+    /** Capture output, guarded by ChunkLock */
+    TArray<FISMBatchSnapshot> CapturedChunks;
+    TMap<TPair<TWeakObjectPtr<UISMRuntimeComponent>, FIntVector>, int32> CapturedCellTokens;
+    FCriticalSection ChunkLock;
+
+    /** Delta capture filter, null for a full capture; swapped under ChunkLock, immutable once set */
+    TSharedPtr<const FInstanceFilterMap, ESPMode::ThreadSafe> CaptureFilter;
+
+    /** Staged graph output, swapped under ChunkLock */
+    TSharedPtr<const FResultsMap, ESPMode::ThreadSafe> Results;
+
+    std::atomic<int32> AppliedCount{0};
+    std::atomic<int32> LastAppliedCount{0};
+};
@@ -0,0 +1,80 @@
+// ISMPCGPartitionedPacket.h
+// ISMRuntimePCGInterop Module
+//
+// Spatially partitioned form of FISMPCGColumnarPacket for world-partition-scale runtime PCG.
+//
+// A monolithic packet holds every exported instance at once. The partitioned packet holds one
+// columnar packet per grid cell instead, so cells can be produced, consumed and freed one at a
+// time: export the cells around a streaming source, hand each to PCG as it is ready, apply and drop
+// it. Memory follows the cells of interest rather than the total instance count.
+//
+// Cells use the same floor(Location / CellSize) coordinates as FISMSpatialIndex, so with the
+// source component's SpatialIndexCellSize (or a PCG grid size) they line up with either grid.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISMPCGColumnarPacket.h"
+#include "ISMPCGPartitionedPacket.generated.h"
+
+/**
+ * Columnar packets keyed by spatial cell, all from one source component.
+ *
+ * Each cell is a complete FISMPCGColumnarPacket (with its own metadata and capture time), so any
+ * cell can be applied, dispatched or stored on its own. Keep one partitioned packet per source
+ * component and release it with the component's level; cells never mix components.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPCGINTEROP_API FISMPCGPartitionedPacket
+{
+    GENERATED_BODY()
+
+    /** Grid cell size in world units. <= 0 before the first export, which adopts the component's. */
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Partition")
+    float CellSize = 0.0f;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Partition")
+    TMap<FIntVector, FISMPCGColumnarPacket> Cells;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    TWeakObjectPtr<UISMRuntimeComponent> SourceComponent;
+
+    UPROPERTY(BlueprintReadWrite, Category = "PCG|ISM|Packet")
+    int32 SourceComponentId = INDEX_NONE;
+
+    // ── Size ──────────────────────────────────────────────────────────────────
+
+    int32 NumCells() const { return Cells.Num(); }
+    bool IsEmpty() const { return Cells.IsEmpty(); }
+
+    /** Points across every resident cell */
+    int32 NumPoints() const;
+
+    // ── Cell Coordinates ──────────────────────────────────────────────────────
+
+    FIntVector LocationToCell(const FVector& Location) const;
+    FBox GetCellBounds(const FIntVector& Cell) const;
+
+    /** Resident cells whose bounds overlap Bounds (every cell when Bounds is invalid) */
+    void GetCellsInBounds(const FBox& Bounds, TArray<FIntVector>& OutCells) const;
+
+    // ── Cell Lifetime ─────────────────────────────────────────────────────────
+
+    FISMPCGColumnarPacket* FindCell(const FIntVector& Cell) { return Cells.Find(Cell); }
+    const FISMPCGColumnarPacket* FindCell(const FIntVector& Cell) const { return Cells.Find(Cell); }
+
+    /** Store a cell, replacing any resident packet for it */
+    void SetCell(const FIntVector& Cell, FISMPCGColumnarPacket&& Packet) { Cells.Add(Cell, MoveTemp(Packet)); }
+
+    /** Move a cell out for consumption, freeing it here. Returns false if the cell isn't resident. */
+    bool TakeCell(const FIntVector& Cell, FISMPCGColumnarPacket& OutPacket);
+
+    /** Free a cell. Returns false if it wasn't resident. */
+    bool RemoveCell(const FIntVector& Cell) { return Cells.Remove(Cell) > 0; }
+
+    /** Free every cell that doesn't overlap Bounds; returns how many were freed */
+    int32 RemoveCellsOutside(const FBox& Bounds);
+
+    /** Free every cell */
+    void Reset() { Cells.Reset(); }
+};
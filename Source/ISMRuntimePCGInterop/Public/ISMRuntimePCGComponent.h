@@ -1,201 +1,277 @@
-//// ISMRuntimePCGComponent.h
-//#pragma once
-//#include "CoreMinimal.h"
-//#include "Components/ActorComponent.h"
-//#include "ISMPCGDataChannel.h"
-//#include "ISMPCGAttributeSchema.h"
-//#include "GameplayTagContainer.h"
-//#include "ISMRuntimePCGComponent.generated.h"
-//
-//class UPCGGraphInterface;
-//class UISMRuntimeComponent;
-//
-//UENUM(BlueprintType)
-//enum class EISMPCGExecutionMode : uint8
-//{
-//    /**
-//     * Run graph once at BeginPlay (or after PCG generation completes).
-//     * Results baked into ISM state. No further execution.
-//     */
-//    Precompute,
-//
-//    /**
-//     * Run graph periodically during gameplay.
-//     * Interval controlled by ExecutionInterval.
-//     */
-//    Periodic,
-//
-//    /**
-//     * Only run when explicitly triggered via TriggerExecution().
-//     * Caller controls when the graph fires.
-//     */
-//    OnDemand,
-//
-//    /**
-//     * Run graph when any instance in the query radius changes state.
-//     * Reactive pattern.
-//     */
-//    OnStateChange,
-//};
-//
-//DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPCGGraphExecuted,
-//    UISMRuntimePCGComponent*, Component,
-//    const FISMPCGDataPacket&, ResultPacket);
-//
-///**
-// * Actor component that attaches a PCG graph execution pipeline
-// * to any actor that has ISMRuntimeComponents.
-// *
-// * This component is the "glue" - it knows which ISM Runtime components
-// * to read from, which PCG graph to run, and what to do with the results.
-// *
-// * Other modules (physics, animation, etc.) attach this component
-// * when they want PCG-driven behavior. They don't need to know anything
-// * about how PCG interop works.
-// */
-//UCLASS(Blueprintable, ClassGroup=(ISMRuntime), meta=(BlueprintSpawnableComponent))
-//class ISMRUNTIMEPCGINTEROP_API UISMRuntimePCGComponent : public UActorComponent
-//{
-//    GENERATED_BODY()
-//
-//public:
-//    UISMRuntimePCGComponent();
-//
-//    // ===== Configuration =====
-//
-//    /** The PCG graph to execute */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Graph")
-//    UPCGGraphInterface* PCGGraph = nullptr;
-//
-//    /** How the graph should be executed */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Execution")
-//    EISMPCGExecutionMode ExecutionMode = EISMPCGExecutionMode::OnDemand;
-//
-//    /**
-//     * For Periodic mode: how often to run the graph (seconds).
-//     * Staggered across components to avoid frame spikes.
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Execution",
-//        meta=(EditCondition="ExecutionMode == EISMPCGExecutionMode::Periodic", ClampMin="0.1"))
-//    float ExecutionInterval = 1.0f;
-//
-//    /** Attribute schema for translating between PCG and ISM */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Translation")
-//    UISMPCGAttributeSchema* AttributeSchema = nullptr;
-//
-//    /**
-//     * Specific ISM Runtime components to read from.
-//     * If empty, auto-discovers all ISMRuntimeComponents on owning actor.
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Sources")
-//    TArray<UISMRuntimeComponent*> SourceComponents;
-//
-//    /**
-//     * Tag filter: only process instances with these tags.
-//     * Empty = all instances.
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Sources")
-//    FGameplayTagContainer InstanceTagFilter;
-//
-//    /**
-//     * Spatial filter: only process instances within this radius of this component's owner.
-//     * -1 = no filter.
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Sources")
-//    float SpatialFilterRadius = -1.0f;
-//
-//    /**
-//     * What to do with PCG results.
-//     * Callers can override these or subscribe to OnGraphExecuted
-//     * to handle results manually.
-//     */
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
-//    bool bAutoApplyTransforms = false;
-//
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
-//    bool bAutoApplyStates = true;
-//
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
-//    bool bAutoApplyTags = true;
-//
-//    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
-//    bool bAutoApplyCustomData = true;
-//
-//    // ===== API =====
-//
-//    /**
-//     * Manually trigger graph execution.
-//     * Always works regardless of ExecutionMode.
-//     * Async by default - subscribe to OnGraphExecuted for results.
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
-//    void TriggerExecution();
-//
-//    /**
-//     * Synchronous version of TriggerExecution.
-//     * Returns the result packet directly.
-//     * WARNING: Blocks game thread. Use only for precompute.
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
-//    FISMPCGDataPacket TriggerExecutionSync();
-//
-//    /**
-//     * Get the last result packet from the most recent execution.
-//     */
-//    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
-//    const FISMPCGDataPacket& GetLastResultPacket() const { return LastResultPacket; }
-//
-//    // ===== Events =====
-//
-//    /** Fires when graph execution completes (on game thread) */
-//    UPROPERTY(BlueprintAssignable, Category = "ISM PCG|Events")
-//    FOnPCGGraphExecuted OnGraphExecuted;
-//
-//    // ===== Lifecycle =====
-//
-//    virtual void BeginPlay() override;
-//    virtual void TickComponent(float DeltaTime, ELevelTick TickType,
-//        FActorComponentTickFunction* ThisTickFunction) override;
-//
-//protected:
-//    /** Cached result of last execution */
-//    FISMPCGDataPacket LastResultPacket;
-//
-//    /** Time accumulator for Periodic mode */
-//    float TimeSinceLastExecution = 0.0f;
-//
-//    /** Resolved source components (after auto-discovery) */
-//    TArray<TWeakObjectPtr<UISMRuntimeComponent>> ResolvedSources;
-//
-//    void ResolveSourceComponents();
-//    void ExecuteInternal(bool bSync);
-//    void OnGraphComplete(const FISMPCGDataPacket& Result);
-//
-//    FISMQueryFilter BuildQueryFilter() const;
-//};
-
-
-/*
-### Module Structure Summary
-```
-ISMRuntimePCGInterop/
-├── ISMRuntimePCGInterop.Build.cs
-│     Depends on: ISMRuntimeCore, PCGFramework (PCG module)
-│
-├── Public/
-│   ├── ISMPCGDataChannel.h          FISMPCGInstancePoint, FISMPCGDataPacket
-│   ├── ISMPCGAttributeSchema.h      UISMPCGAttributeSchema (data asset)
-│   ├── ISMPCGBridge.h               UISMPCGBridge (static translation API)
-│   ├── ISMRuntimePCGComponent.h     UISMRuntimePCGComponent (actor component)
-│   └── PCGElements/
-│       ├── PCGElement_ISMInput.h    PCG source node: instances → PCG points
-│       └── PCGElement_ISMOutput.h   PCG sink node: PCG points → ISM changes
-│
-└── Private/
-    ├── ISMPCGBridge.cpp
-    ├── ISMRuntimePCGComponent.cpp
-    └── PCGElements/
-        ├── PCGElement_ISMInput.cpp
-        └── PCGElement_ISMOutput.cpp
-
-        */
\ No newline at end of file
+// ISMRuntimePCGComponent.h
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ISMPCGDataChannel.h"
+#include "ISMPCGAttributeSchema.h"
+#include "ISMQueryFilter.h"
+#include "Batching/ISMBatchTypes.h"
+#include "GameplayTagContainer.h"
+#include "ISMRuntimePCGComponent.generated.h"
+
+class UPCGGraphInterface;
+class UPCGComponent;
+class UPCGBasePointData;
+class UISMRuntimeComponent;
+class UInstancedStaticMeshComponent;
+class UISMBatchSchedulerBase;
+class FISMPCGGraphTransformer;
+
+UENUM(BlueprintType)
+enum class EISMPCGExecutionMode : uint8
+{
+    /**
+     * Run graph once at BeginPlay (or after PCG generation completes).
+     * Results baked into ISM state. No further execution.
+     * Skipped when every source started from a compatible BakedState (see BakeSourceStates).
+     */
+    Precompute,
+
+    /**
+     * Run graph periodically during gameplay.
+     * Interval controlled by ExecutionInterval.
+     */
+    Periodic,
+
+    /**
+     * Only run when explicitly triggered via TriggerExecution().
+     * Caller controls when the graph fires.
+     */
+    OnDemand,
+
+    /**
+     * Run graph when any source instance changes state, tags, or is added or destroyed.
+     * Reactive pattern; runs are at least ExecutionInterval apart.
+     * With bDeltaCapture, each run only sees the instances that changed.
+     */
+    OnStateChange,
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPCGGraphExecuted,
+    UISMRuntimePCGComponent*, Component,
+    UPCGBasePointData*, GraphOutput);
+
+/**
+ * Actor component that attaches a PCG graph execution pipeline
+ * to any actor that has ISMRuntimeComponents.
+ *
+ * This component is the "glue" - it knows which ISM Runtime components
+ * to read from, which PCG graph to run, and what to do with the results.
+ *
+ * Runs go through the batch scheduler as an FISMPCGGraphTransformer:
+ *   1. Capture: the scheduler snapshots the sources off the game thread
+ *   2. Execute: the snapshots become the graph's ISM Input node data and the graph runs
+ *      on PCG's own async execution
+ *   3. Apply: output points carrying ISM.InstanceIndex / ISM.ComponentId are written back
+ *      as batch mutation results under the scheduler's apply budget
+ *
+ * Only one run is in flight at a time; triggers arriving mid-run are coalesced into the next.
+ *
+ * Other modules (physics, animation, etc.) attach this component
+ * when they want PCG-driven behavior. They don't need to know anything
+ * about how PCG interop works.
+ */
+UCLASS(Blueprintable, ClassGroup=(ISMRuntime), meta=(BlueprintSpawnableComponent))
+class ISMRUNTIMEPCGINTEROP_API UISMRuntimePCGComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UISMRuntimePCGComponent();
+
+    // ===== Configuration =====
+
+    /** The PCG graph to execute. Reads instances through a PCG ISM Input node. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Graph")
+    TObjectPtr<UPCGGraphInterface> PCGGraph = nullptr;
+
+    /** How the graph should be executed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Execution")
+    EISMPCGExecutionMode ExecutionMode = EISMPCGExecutionMode::OnDemand;
+
+    /**
+     * For Periodic mode: how often to run the graph (seconds).
+     * Staggered across components to avoid frame spikes.
+     * For OnStateChange mode: minimum time between runs.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Execution",
+        meta=(EditCondition="ExecutionMode == EISMPCGExecutionMode::Periodic || ExecutionMode == EISMPCGExecutionMode::OnStateChange", ClampMin="0.1"))
+    float ExecutionInterval = 1.0f;
+
+    /**
+     * For OnStateChange mode: capture only the instances that changed since the last run, so a
+     * reactive graph costs O(changes). The first run captures everything. Delta runs' results
+     * layer over current state (EISMPCGDataLifetime::Accumulating).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Execution",
+        meta=(EditCondition="ExecutionMode == EISMPCGExecutionMode::OnStateChange"))
+    bool bDeltaCapture = true;
+
+    /** Attribute schema for translating between PCG and ISM */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Translation")
+    TObjectPtr<UISMPCGAttributeSchema> AttributeSchema = nullptr;
+
+    /**
+     * Specific ISMs to read from (each must be managed by an ISMRuntimeComponent).
+     * If empty, uses every ISM on the owning actor.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Sources")
+    TArray<TObjectPtr<UInstancedStaticMeshComponent>> SourceISMs;
+
+    /**
+     * Tag filter: only process instances with these tags.
+     * Empty = all instances.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Sources")
+    FGameplayTagContainer InstanceTagFilter;
+
+    /**
+     * Spatial filter: only process instances within this radius of this component's owner.
+     * -1 = no filter.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Sources")
+    float SpatialFilterRadius = -1.0f;
+
+    /**
+     * What to do with PCG results.
+     * Callers can override these or subscribe to OnGraphExecuted
+     * to handle results manually.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
+    bool bAutoApplyTransforms = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
+    bool bAutoApplyStates = true;
+
+    /** Not applied yet: batch mutation results carry no tag stream */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
+    bool bAutoApplyTags = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PCG|Results")
+    bool bAutoApplyCustomData = true;
+
+    // ===== API =====
+
+    /**
+     * Manually trigger graph execution.
+     * Always works regardless of ExecutionMode.
+     * Async - subscribe to OnGraphExecuted for results. If a run is in flight,
+     * another starts once it finishes.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
+    void TriggerExecution();
+
+    /** True while a run is capturing, executing or applying */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
+    bool IsExecuting() const;
+
+    /** Output of the most recent graph run, null before the first */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
+    UPCGBasePointData* GetLastGraphOutput() const { return LastGraphOutput; }
+
+    /** Lifetime of the current or most recent run's results: Accumulating for delta runs */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
+    EISMPCGDataLifetime GetLastRunLifetime() const { return LastRunLifetime; }
+
+    /** Instances written back by the most recent completed apply */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
+    int32 GetLastAppliedCount() const;
+
+    /**
+     * Write each resolved source's current state into its BakedState asset (sources without one
+     * are skipped). Run it once a Precompute run has applied; cooked, the assets let level start
+     * skip the graph. Returns the number of sources baked.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM PCG")
+    int32 BakeSourceStates();
+
+    /** Points the ISM Input node hands to the graph for the current run */
+    UPCGBasePointData* GetGraphInput() const { return GraphInput; }
+
+    /** The PCG component this component runs its graph on */
+    UPCGComponent* GetPCGComponent() const { return PCGComponent; }
+
+    // ===== Events =====
+
+    /** Fires when graph execution completes (on game thread), before results are applied */
+    UPROPERTY(BlueprintAssignable, Category = "ISM PCG|Events")
+    FOnPCGGraphExecuted OnGraphExecuted;
+
+    // ===== Lifecycle =====
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+        FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+    /** Graph input for the current run, read by the ISM Input node */
+    UPROPERTY(Transient)
+    TObjectPtr<UPCGBasePointData> GraphInput = nullptr;
+
+    /** Cached result of last execution */
+    UPROPERTY(Transient)
+    TObjectPtr<UPCGBasePointData> LastGraphOutput = nullptr;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UPCGComponent> PCGComponent = nullptr;
+
+    /** Time accumulator for Periodic and OnStateChange modes */
+    float TimeSinceLastExecution = 0.0f;
+
+    /** A trigger arrived (or is waiting for the next start slot) */
+    bool bExecutionPending = false;
+
+    /** A source instance changed state since the last run started */
+    bool bSourceStateChanged = false;
+
+    /** Delta capture: instances changed since the last run started, and their world bounds */
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, TSet<int32>> DirtyInstances;
+    FBox DirtyBounds = FBox(ForceInit);
+
+    /** Delta capture waits for one full run before narrowing */
+    bool bFullCaptureDone = false;
+
+    EISMPCGDataLifetime LastRunLifetime = EISMPCGDataLifetime::Ephemeral;
+
+    /** Precompute mode has started its one run */
+    bool bPrecomputeStarted = false;
+
+    /** The graph was kicked off for the current run and is being polled */
+    bool bGraphRunning = false;
+
+    /** Source ISMs still waiting on RequestRuntimeComponent */
+    int32 PendingSourceCount = 0;
+
+    /** Resolved source components (after auto-discovery) */
+    TArray<TWeakObjectPtr<UISMRuntimeComponent>> ResolvedSources;
+
+    /** ISM.ComponentId → component for the run in flight */
+    TMap<int32, TWeakObjectPtr<UISMRuntimeComponent>> RunComponentsById;
+
+    TWeakObjectPtr<UISMBatchSchedulerBase> CachedScheduler;
+    TSharedPtr<FISMPCGGraphTransformer> GraphTransformer;
+
+    void ResolveSourceComponents();
+    void OnSourceComponentReady(UISMRuntimeComponent* Component);
+    void OnSourceInstanceChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
+    void OnSourceInstancesChanged(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices);
+    void OnSourceInstancesAdded(UISMRuntimeComponent* Component, const TArray<int32>& InstanceIndices);
+    void MarkInstanceDirty(UISMRuntimeComponent* Component, int32 InstanceIndex);
+    bool IsDeltaRun() const;
+
+    bool RegisterGraphTransformer();
+    void CreatePCGComponent();
+
+    /** Every resolved source initialized from its BakedState, so a Precompute run has nothing to add */
+    bool AreAllSourcesBaked() const;
+
+    bool ShouldStartRun(float DeltaTime);
+    bool StartRun();
+    void ExecuteGraph();
+    void OnGraphComplete();
+
+    FISMQueryFilter BuildQueryFilter() const;
+    FBox BuildSpatialBounds() const;
+    EISMSnapshotField BuildWriteMask() const;
+};
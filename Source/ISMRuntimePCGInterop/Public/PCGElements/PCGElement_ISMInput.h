@@ -0,0 +1,46 @@
+// PCGElement_ISMInput.h
+#pragma once
+#include "CoreMinimal.h"
+#include "PCGSettings.h"
+#include "PCGElement.h"
+#include "PCGElement_ISMInput.generated.h"
+
+/**
+ * PCG source node: hands the graph the instances captured for the current run of the owning
+ * actor's UISMRuntimePCGComponent, as points with ISM.InstanceIndex, ISM.ComponentId,
+ * ISM.StateFlags and ISM.CustomData.N attributes.
+ *
+ * Keep those identity attributes on points meant to be written back. Outside a
+ * UISMRuntimePCGComponent run the node outputs nothing.
+ */
+UCLASS(BlueprintType, ClassGroup = (Procedural))
+class ISMRUNTIMEPCGINTEROP_API UPCGISMInputSettings : public UPCGSettings
+{
+    GENERATED_BODY()
+
+public:
+#if WITH_EDITOR
+    virtual FName GetDefaultNodeName() const override { return FName(TEXT("ISMRuntimeInput")); }
+    virtual FText GetDefaultNodeTitle() const override;
+    virtual FText GetNodeTooltipText() const override;
+    virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::InputOutput; }
+#endif
+
+protected:
+    virtual TArray<FPCGPinProperties> InputPinProperties() const override { return {}; }
+    virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+    virtual FPCGElementPtr CreateElement() const override;
+};
+
+class FPCGISMInputElement : public IPCGElement
+{
+public:
+    /** Output changes every run */
+    virtual bool IsCacheable(const UPCGSettings* InSettings) const override { return false; }
+
+    /** Reads UObject state on the owning actor */
+    virtual bool CanExecuteOnlyOnMainThread(FPCGContext* Context) const override { return true; }
+
+protected:
+    virtual bool ExecuteInternal(FPCGContext* Context) const override;
+};
@@ -0,0 +1,241 @@
+#include "ISMActorDistanceBuckets.h"
+
+void FISMActorDistanceBuckets::Configure(float InBucketSize, int32 InNumBuckets)
+{
+    Reset();
+    BucketSize = FMath::Max(InBucketSize, 1.0f);
+    Buckets.SetNum(FMath::Max(InNumBuckets, 1));
+}
+
+bool FISMActorDistanceBuckets::Add(AActor* Actor, float Distance)
+{
+    if (!Actor)
+    {
+        return false;
+    }
+
+    if (Buckets.Num() == 0)
+    {
+        Buckets.SetNum(1);
+    }
+
+    if (const int32* Existing = EntryByActor.Find(Actor))
+    {
+        // Re-activated before a refresh noticed it left, or a destroyed actor's address reused
+        FEntry& Entry = Entries[*Existing];
+        Entry.Actor = Actor;
+        Entry.Key = Actor;
+        Entry.AddOrder = NextAddOrder++;
+        SetDistance(*Existing, Distance);
+        return false;
+    }
+
+    const int32 EntryIndex = Entries.AddDefaulted();
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.Actor = Actor;
+    Entry.Key = Actor;
+    Entry.Distance = Distance;
+    Entry.AddOrder = NextAddOrder++;
+    LinkToBucket(EntryIndex, BucketFor(Distance));
+    EntryByActor.Add(Actor, EntryIndex);
+    return true;
+}
+
+bool FISMActorDistanceBuckets::Remove(const AActor* Actor)
+{
+    const int32* EntryIndex = EntryByActor.Find(Actor);
+    if (!EntryIndex)
+    {
+        return false;
+    }
+    RemoveAt(*EntryIndex);
+    return true;
+}
+
+void FISMActorDistanceBuckets::Reset()
+{
+    Entries.Reset();
+    for (TArray<int32>& Bucket : Buckets)
+    {
+        Bucket.Reset();
+    }
+    EntryByActor.Reset();
+    RefreshCursor = 0;
+}
+
+int32 FISMActorDistanceBuckets::PopFarthest(int32 Count, TArray<AActor*>& OutActors)
+{
+    int32 NumPopped = 0;
+    for (int32 BucketIndex = Buckets.Num() - 1; BucketIndex >= 0 && NumPopped < Count; --BucketIndex)
+    {
+        TArray<int32>& Bucket = Buckets[BucketIndex];
+        while (Bucket.Num() > 0 && NumPopped < Count)
+        {
+            // A ring that is taken whole needs no ordering; one taken in part gives up its
+            // farthest cached distances first so small evictions stay exact
+            int32 FarthestSlot = Bucket.Num() - 1;
+            if (Count - NumPopped < Bucket.Num())
+            {
+                for (int32 Slot = 0; Slot < Bucket.Num(); ++Slot)
+                {
+                    if (Entries[Bucket[Slot]].Distance > Entries[Bucket[FarthestSlot]].Distance)
+                    {
+                        FarthestSlot = Slot;
+                    }
+                }
+            }
+
+            const int32 EntryIndex = Bucket[FarthestSlot];
+            if (AActor* Actor = Entries[EntryIndex].Actor.Get())
+            {
+                OutActors.Add(Actor);
+                ++NumPopped;
+            }
+            RemoveAt(EntryIndex);
+        }
+    }
+    return NumPopped;
+}
+
+int32 FISMActorDistanceBuckets::PopOldest(int32 Count, TArray<AActor*>& OutActors)
+{
+    if (Count <= 0 || Entries.Num() == 0)
+    {
+        return 0;
+    }
+
+    TArray<int32> Order;
+    Order.Reserve(Entries.Num());
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        Order.Add(EntryIndex);
+    }
+    Order.Sort([this](int32 A, int32 B) { return Entries[A].AddOrder < Entries[B].AddOrder; });
+    Order.SetNum(FMath::Min(Count, Order.Num()));
+
+    // Removing swaps entries around, so resolve the keys before removing any
+    TArray<TPair<const AActor*, AActor*>, TInlineAllocator<16>> Oldest;
+    for (const int32 EntryIndex : Order)
+    {
+        Oldest.Emplace(Entries[EntryIndex].Key, Entries[EntryIndex].Actor.Get());
+    }
+
+    int32 NumPopped = 0;
+    for (const TPair<const AActor*, AActor*>& Pair : Oldest)
+    {
+        Remove(Pair.Key);
+        if (Pair.Value)
+        {
+            OutActors.Add(Pair.Value);
+            ++NumPopped;
+        }
+    }
+    return NumPopped;
+}
+
+int32 FISMActorDistanceBuckets::PopBeyond(float MaxDistance, TArray<AActor*>& OutActors)
+{
+    int32 NumPopped = 0;
+    const int32 FirstBucket = BucketFor(MaxDistance);
+    for (int32 BucketIndex = Buckets.Num() - 1; BucketIndex >= FirstBucket; --BucketIndex)
+    {
+        TArray<int32>& Bucket = Buckets[BucketIndex];
+
+        // Walk backwards: removal swaps the bucket's last slot into the removed one
+        for (int32 Slot = Bucket.Num() - 1; Slot >= 0; --Slot)
+        {
+            const int32 EntryIndex = Bucket[Slot];
+            if (Entries[EntryIndex].Distance <= MaxDistance)
+            {
+                continue;
+            }
+            if (AActor* Actor = Entries[EntryIndex].Actor.Get())
+            {
+                OutActors.Add(Actor);
+                ++NumPopped;
+            }
+            RemoveAt(EntryIndex);
+        }
+    }
+    return NumPopped;
+}
+
+void FISMActorDistanceBuckets::GetActors(TArray<AActor*>& OutActors) const
+{
+    OutActors.Reserve(OutActors.Num() + Entries.Num());
+    for (const FEntry& Entry : Entries)
+    {
+        if (AActor* Actor = Entry.Actor.Get())
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+SIZE_T FISMActorDistanceBuckets::GetAllocatedSize() const
+{
+    SIZE_T Size = Entries.GetAllocatedSize() + Buckets.GetAllocatedSize() + EntryByActor.GetAllocatedSize();
+    for (const TArray<int32>& Bucket : Buckets)
+    {
+        Size += Bucket.GetAllocatedSize();
+    }
+    return Size;
+}
+
+int32 FISMActorDistanceBuckets::BucketFor(float Distance) const
+{
+    const int32 Bucket = FMath::FloorToInt32(FMath::Max(Distance, 0.0f) / BucketSize);
+    return FMath::Clamp(Bucket, 0, FMath::Max(Buckets.Num() - 1, 0));
+}
+
+void FISMActorDistanceBuckets::SetDistance(int32 EntryIndex, float Distance)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.Distance = Distance;
+
+    const int32 NewBucket = BucketFor(Distance);
+    if (NewBucket != Entry.Bucket)
+    {
+        UnlinkFromBucket(EntryIndex);
+        LinkToBucket(EntryIndex, NewBucket);
+    }
+}
+
+void FISMActorDistanceBuckets::LinkToBucket(int32 EntryIndex, int32 Bucket)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.Bucket = Bucket;
+    Entry.BucketSlot = Buckets[Bucket].Add(EntryIndex);
+}
+
+void FISMActorDistanceBuckets::UnlinkFromBucket(int32 EntryIndex)
+{
+    const FEntry& Entry = Entries[EntryIndex];
+    TArray<int32>& Bucket = Buckets[Entry.Bucket];
+
+    const int32 LastSlot = Bucket.Num() - 1;
+    if (Entry.BucketSlot != LastSlot)
+    {
+        const int32 MovedEntry = Bucket[LastSlot];
+        Bucket[Entry.BucketSlot] = MovedEntry;
+        Entries[MovedEntry].BucketSlot = Entry.BucketSlot;
+    }
+    Bucket.RemoveAt(LastSlot, EAllowShrinking::No);
+}
+
+void FISMActorDistanceBuckets::RemoveAt(int32 EntryIndex)
+{
+    UnlinkFromBucket(EntryIndex);
+    EntryByActor.Remove(Entries[EntryIndex].Key);
+
+    const int32 LastIndex = Entries.Num() - 1;
+    if (EntryIndex != LastIndex)
+    {
+        // Move the last entry down and repoint its bucket slot and map entry
+        Entries[EntryIndex] = MoveTemp(Entries[LastIndex]);
+        const FEntry& Moved = Entries[EntryIndex];
+        Buckets[Moved.Bucket][Moved.BucketSlot] = EntryIndex;
+        EntryByActor.Add(Moved.Key, EntryIndex);
+    }
+    Entries.RemoveAt(LastIndex, EAllowShrinking::No);
+}
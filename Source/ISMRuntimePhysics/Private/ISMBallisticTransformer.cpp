@@ -0,0 +1,206 @@
+#include "ISMBallisticTransformer.h"
+#include "ISMRuntimePhysics.h"
+#include "ISMRuntimeComponent.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+    /** Longest single integration step; longer gaps are split so bounces are not skipped */
+    constexpr double MaxBallisticStep = 1.0 / 30.0;
+
+    /** Box around in-flight instances is padded so a cell an instance just left is still snapshotted */
+    constexpr double BallisticBoundsPadding = 100.0;
+}
+
+FISMBallisticTransformer::FISMBallisticTransformer(UISMRuntimeComponent* InTargetComponent, FName InTransformerName)
+    : TargetComponent(InTargetComponent)
+    , TransformerName(InTransformerName)
+{
+}
+
+bool FISMBallisticTransformer::IsDirty() const
+{
+    FScopeLock Lock(&StateLock);
+    return InFlight.Num() > 0;
+}
+
+FISMSnapshotRequest FISMBallisticTransformer::BuildRequest()
+{
+    FISMSnapshotRequest Request;
+
+    UISMRuntimeComponent* Component = TargetComponent.Get();
+    if (!Component)
+    {
+        return Request;
+    }
+    Request.TargetComponents.Add(TargetComponent);
+
+    // Indices are all we need from the snapshot; the transform comes from our own state
+    Request.ReadMask = EISMSnapshotField::None;
+    Request.WriteMask = EISMSnapshotField::Transform;
+    Request.bStructureOfArrays = true;
+
+    FScopeLock Lock(&StateLock);
+
+    FBox Bounds(ForceInit);
+    for (auto It = InFlight.CreateIterator(); It; ++It)
+    {
+        // Instances removed or destroyed mid-flight are never snapshotted again
+        if (!Component->IsValidInstanceIndex(It.Key()) || Component->IsInstanceDestroyed(It.Key()))
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+        Bounds += It.Value().Location;
+    }
+
+    if (Bounds.IsValid)
+    {
+        Request.SpatialBounds = Bounds.ExpandBy(BallisticBoundsPadding);
+    }
+    return Request;
+}
+
+void FISMBallisticTransformer::ProcessChunk(FISMBatchSnapshot Chunk, FISMMutationHandle Handle)
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    const TArray<int32>& ChunkIndices = Chunk.SoA.InstanceIndices;
+
+    FISMBatchMutationResult Result = Handle.AcquireResult();
+    Result.TargetComponent = TargetComponent;
+    Result.WrittenFields = EISMSnapshotField::Transform;
+
+    {
+        FScopeLock Lock(&StateLock);
+
+        auto StepAndWrite = [this, &Result](int32 InstanceIndex, FISMBallisticInstanceState& State)
+        {
+            const bool bSettled = StepInstance(State, WorldTime, Settings);
+            Result.Streams.AddTransform(InstanceIndex, FTransform(State.Rotation, State.Location, State.Scale));
+            return bSettled;
+        };
+
+        // Walk whichever side is smaller: a few pebbles in a dense cell, or a big burst in a sparse one
+        if (InFlight.Num() < ChunkIndices.Num())
+        {
+            for (auto It = InFlight.CreateIterator(); It; ++It)
+            {
+                if (Algo::BinarySearch(ChunkIndices, It.Key()) == INDEX_NONE)
+                {
+                    continue;
+                }
+                if (StepAndWrite(It.Key(), It.Value()))
+                {
+                    It.RemoveCurrent();
+                }
+            }
+        }
+        else
+        {
+            for (const int32 InstanceIndex : ChunkIndices)
+            {
+                FISMBallisticInstanceState* State = InFlight.Find(InstanceIndex);
+                if (State && StepAndWrite(InstanceIndex, *State))
+                {
+                    InFlight.Remove(InstanceIndex);
+                }
+            }
+        }
+    }
+
+    Handle.Release(MoveTemp(Result));
+}
+
+void FISMBallisticTransformer::Launch(int32 InstanceIndex, const FTransform& RestTransform, const FVector& Velocity,
+    const FVector& AngularVelocity)
+{
+    FScopeLock Lock(&StateLock);
+
+    FISMBallisticInstanceState& State = InFlight.FindOrAdd(InstanceIndex);
+    State.Location = RestTransform.GetLocation();
+    State.Rotation = RestTransform.GetRotation();
+    State.Scale = RestTransform.GetScale3D();
+    State.RestRotation = State.Rotation;
+    State.Velocity = Velocity;
+    State.AngularVelocity = AngularVelocity;
+    State.GroundZ = State.Location.Z;
+    State.LaunchTime = WorldTime;
+    State.LastStepTime = WorldTime;
+}
+
+bool FISMBallisticTransformer::Land(int32 InstanceIndex, FTransform& OutTransform)
+{
+    FScopeLock Lock(&StateLock);
+
+    FISMBallisticInstanceState State;
+    if (!InFlight.RemoveAndCopyValue(InstanceIndex, State))
+    {
+        return false;
+    }
+    OutTransform = FTransform(State.Rotation, State.Location, State.Scale);
+    return true;
+}
+
+void FISMBallisticTransformer::UpdateFrameParams(double InWorldTime, const FISMBallisticSettings& InSettings)
+{
+    FScopeLock Lock(&StateLock);
+    WorldTime = InWorldTime;
+    Settings = InSettings;
+}
+
+bool FISMBallisticTransformer::IsInFlight(int32 InstanceIndex) const
+{
+    FScopeLock Lock(&StateLock);
+    return InFlight.Contains(InstanceIndex);
+}
+
+int32 FISMBallisticTransformer::GetInFlightCount() const
+{
+    FScopeLock Lock(&StateLock);
+    return InFlight.Num();
+}
+
+bool FISMBallisticTransformer::StepInstance(FISMBallisticInstanceState& State, double InWorldTime,
+    const FISMBallisticSettings& InSettings)
+{
+    bool bSettled = InWorldTime - State.LaunchTime >= InSettings.MaxFlightTime;
+
+    double Remaining = FMath::Min(InWorldTime - State.LastStepTime, static_cast<double>(InSettings.MaxFlightTime));
+    State.LastStepTime = InWorldTime;
+
+    while (!bSettled && Remaining > UE_KINDA_SMALL_NUMBER)
+    {
+        const double Step = FMath::Min(Remaining, MaxBallisticStep);
+        Remaining -= Step;
+
+        State.Velocity.Z += InSettings.GravityZ * Step;
+        State.Location += State.Velocity * Step;
+
+        const double SpinSpeed = State.AngularVelocity.Size();
+        if (SpinSpeed > UE_KINDA_SMALL_NUMBER)
+        {
+            State.Rotation = FQuat(State.AngularVelocity / SpinSpeed, SpinSpeed * Step) * State.Rotation;
+        }
+
+        // Ground clamp: the plane the instance was resting on before launch
+        if (State.Location.Z <= State.GroundZ && State.Velocity.Z < 0.0)
+        {
+            State.Location.Z = State.GroundZ;
+            State.Velocity.Z = -State.Velocity.Z * InSettings.Restitution;
+            State.Velocity.X *= InSettings.GroundFriction;
+            State.Velocity.Y *= InSettings.GroundFriction;
+            State.AngularVelocity *= InSettings.GroundFriction;
+
+            bSettled = State.Velocity.Z < InSettings.SettleSpeed;
+        }
+    }
+
+    if (bSettled)
+    {
+        // Rest the way it was placed rather than balanced on whatever edge it landed on
+        State.Location.Z = State.GroundZ;
+        State.Rotation = State.RestRotation;
+    }
+    return bSettled;
+}
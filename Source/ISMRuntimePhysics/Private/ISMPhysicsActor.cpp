@@ -1,16 +1,19 @@
 #include "ISMPhysicsActor.h"
 #include "ISMPhysicsDataAsset.h"
+#include "ISMPhysicsMeshComponent.h"
 #include "ISMInstanceHandle.h"
 #include "Components/StaticMeshComponent.h"
 #include "Logging/LogMacros.h"
 #include "ISMRuntimeComponent.h"
 #include "ISMRuntimePoolSubsystem.h"
+#include "ISMPhysicsRestSubsystem.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Kismet/GameplayStatics.h"
 #include "Feedbacks/ISMFeedbackSubsystem.h"
 #include "Feedbacks/ISMFeedbackContext.h"
 
 #include "DrawDebugHelpers.h"
+#include "TimerManager.h"
 
 
 DEFINE_LOG_CATEGORY(LogISMRuntimePhysics);
@@ -36,7 +39,7 @@ AISMPhysicsActor::AISMPhysicsActor()
 
 TObjectPtr<UStaticMeshComponent> AISMPhysicsActor::ConstructMeshComponent()
 {
-    return CreateDefaultSubobject<UStaticMeshComponent>(TEXT("PhysicsMesh"));
+    return CreateDefaultSubobject<UISMPhysicsMeshComponent>(TEXT("PhysicsMesh"));
 }
 
 //void AISMPhysicsActor::BeginPlay()
@@ -97,6 +100,27 @@ void AISMPhysicsActor::Tick(float DeltaTime)
         return;
     }
 
+    // In the batched rest pass or waiting for sleep the actor only ticks to draw debug info
+    if (RestPassIndex == INDEX_NONE && !bWaitingForSleep)
+    {
+        TickRestDetection(DeltaTime, GetLinearVelocityMagnitude(), GetAngularVelocityMagnitude());
+    }
+    
+#if WITH_EDITOR
+    if (bShowDebugInfo)
+    {
+        DrawDebugInfo();
+    }
+#endif
+}
+
+void AISMPhysicsActor::TickRestDetection(float DeltaTime, float LinearSpeed, float AngularSpeed)
+{
+    if (!PhysicsData.IsValid())
+    {
+        return;
+    }
+
     if (ShouldBeKinematic() != bIsKinematic)
     {
         if (bIsKinematic)
@@ -110,7 +134,7 @@ void AISMPhysicsActor::Tick(float DeltaTime)
     }
     
     // Update resting detection
-    UpdateRestingDetection(DeltaTime);
+    UpdateRestingDetection(DeltaTime, IsVelocityBelowThreshold(LinearSpeed, AngularSpeed));
     FString msg;
     // Auto-return if settled
     if (CanReturnToISM(msg))
@@ -118,13 +142,103 @@ void AISMPhysicsActor::Tick(float DeltaTime)
         UE_LOG(LogTemp, Log, TEXT("[%s] RETURNING TO ISM - Settled for %.2fs"), *GetName(), TimeAtRest);
         ReturnToISM();
     }
-    
-#if WITH_EDITOR
-    if (bShowDebugInfo)
+}
+
+bool AISMPhysicsActor::JoinRestPass()
+{
+    if (!PhysicsData.IsValid() || !PhysicsData->bUseBatchedRestDetection)
     {
-        DrawDebugInfo();
+        return false;
     }
-#endif
+
+    UISMPhysicsRestSubsystem* RestSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UISMPhysicsRestSubsystem>() : nullptr;
+    return RestSubsystem && RestSubsystem->RegisterActor(this);
+}
+
+bool AISMPhysicsActor::BeginRestDetection()
+{
+    return WaitForSleep() || JoinRestPass();
+}
+
+bool AISMPhysicsActor::WaitForSleep()
+{
+    if (!PhysicsData.IsValid() || !PhysicsData->bReturnOnSleep || !MeshComponent)
+    {
+        return false;
+    }
+
+    MeshComponent->OnComponentSleep.AddUniqueDynamic(this, &AISMPhysicsActor::OnMeshSleep);
+    bWaitingForSleep = true;
+
+    if (PhysicsData->SleepFallbackTimeout > 0.0f)
+    {
+        GetWorldTimerManager().SetTimer(SleepFallbackTimer, this, &AISMPhysicsActor::StartRestPolling,
+            PhysicsData->SleepFallbackTimeout, false);
+    }
+    return true;
+}
+
+void AISMPhysicsActor::StopWaitingForSleep()
+{
+    if (!bWaitingForSleep)
+    {
+        return;
+    }
+
+    bWaitingForSleep = false;
+    GetWorldTimerManager().ClearTimer(SleepFallbackTimer);
+    if (MeshComponent)
+    {
+        MeshComponent->OnComponentSleep.RemoveDynamic(this, &AISMPhysicsActor::OnMeshSleep);
+    }
+}
+
+void AISMPhysicsActor::StartRestPolling()
+{
+    StopWaitingForSleep();
+    if (!JoinRestPass())
+    {
+        SetActorTickEnabled(true);
+    }
+    UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("[%s] No sleep event in time, polling velocity"), *GetName());
+}
+
+void AISMPhysicsActor::OnMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+    if (!bWaitingForSleep || bIsKinematic || !PhysicsData.IsValid())
+    {
+        return;
+    }
+
+    // The solver only sleeps a body that has stayed below its own thresholds for a while,
+    // which stands in for our RestingCheckDelay
+    bWasAtRestLastFrame = true;
+    TimeAtRest = FMath::Max(TimeAtRest, PhysicsData->RestingCheckDelay);
+
+    FString Reason;
+    if (CanReturnToISM(Reason))
+    {
+        UE_LOG(LogISMRuntimePhysics, Log, TEXT("[%s] RETURNING TO ISM - Body went to sleep"), *GetName());
+        ReturnToISM();
+        return;
+    }
+
+    // Refused while asleep; polling notices once whatever held it back changes
+    StartRestPolling();
+}
+
+void AISMPhysicsActor::LeaveRestPass()
+{
+    if (RestPassIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (UISMPhysicsRestSubsystem* RestSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UISMPhysicsRestSubsystem>() : nullptr)
+    {
+        RestSubsystem->UnregisterActor(this);
+    }
+    RestPassIndex = INDEX_NONE;
 }
 
 // ===== IISMPoolable Interface =====
@@ -177,15 +291,32 @@ void AISMPhysicsActor::OnRequestedFromPool_Implementation(UISMPoolDataAsset* Dat
         SetActorTransform(InstanceTransform);
     }
     
+    // A different variant may have left material overrides and channel responses its own
+    // asset doesn't touch; start from the class defaults instead
+    if (LastConfiguredData.Get() != PhysicsDataAsset && LastConfiguredData.IsValid() && MeshComponent)
+    {
+        MeshComponent->EmptyOverrideMaterials();
+        const AISMPhysicsActor* Defaults = GetClass()->GetDefaultObject<AISMPhysicsActor>();
+        if (Defaults && Defaults->MeshComponent)
+        {
+            MeshComponent->SetCollisionResponseToChannels(Defaults->MeshComponent->GetCollisionResponseToChannels());
+        }
+    }
+    LastConfiguredData = PhysicsDataAsset;
+
     // Configure from data asset
     ApplyPhysicsSettings(PhysicsDataAsset);
     ApplyCollisionSettings(PhysicsDataAsset);
     ApplyVisualSettings(PhysicsDataAsset);
     
-    // Enable actor
+    // Enable actor; sleep events or the batched rest pass replace the per-actor tick
     SetActorHiddenInGame(false);
     SetActorEnableCollision(true);
-    SetActorTickEnabled(true);
+    bool bNeedsTick = !BeginRestDetection();
+#if WITH_EDITORONLY_DATA
+    bNeedsTick |= bShowDebugInfo;
+#endif
+    SetActorTickEnabled(bNeedsTick);
     
     // Enable physics simulation
     if (MeshComponent)
@@ -234,8 +365,12 @@ void AISMPhysicsActor::OnReturnedToPool_Implementation(FTransform& OutFinalTrans
     bIsKinematicInitted = false;
 
 
-    // Play return sound
-    PlayReturnFeedback();
+    // Play return sound, unless the owner sent it for a whole batch of returns
+    if (!bReturnFeedbackHandled)
+    {
+        PlayReturnFeedback();
+    }
+    bReturnFeedbackHandled = false;
     
     // Stop physics
     if (MeshComponent)
@@ -244,13 +379,21 @@ void AISMPhysicsActor::OnReturnedToPool_Implementation(FTransform& OutFinalTrans
         MeshComponent->SetPhysicsLinearVelocity(FVector::ZeroVector);
         MeshComponent->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
     }
+
+    // The next request starts near; its owner re-tiers it from the first distance it measures
+    SetSimplifiedCollision(false);
     
     // Hide actor
     SetActorHiddenInGame(true);
     SetActorEnableCollision(false);
     SetActorTickEnabled(false);
+    LeaveRestPass();
+    StopWaitingForSleep();
     
-    if (MeshComponent)
+    // Dormant pools keep the mesh's own visibility and collision so reactivation only flips the
+    // actor-level flags back; switching the component too would rebuild its state both ways
+    const bool bDormant = PhysicsData.IsValid() && PhysicsData->bUseDormantReset;
+    if (MeshComponent && !bDormant)
     {
         MeshComponent->SetVisibility(false);
         MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -353,6 +496,9 @@ void AISMPhysicsActor::ApplyPhysicsSettings(UISMPhysicsDataAsset* PhysicsDataAss
         MeshComponent->SetPhysicsMaxAngularVelocityInRadians(PhysicsDataAsset->MaxAngularVelocity);
     }
     
+    // Sleep events are only dispatched to bodies that ask for them
+    MeshComponent->BodyInstance.bGenerateWakeEvents = PhysicsDataAsset->bReturnOnSleep;
+    
     // Lock rotation axes
     MeshComponent->BodyInstance.bLockXRotation = PhysicsDataAsset->bLockRotationX;
     MeshComponent->BodyInstance.bLockYRotation = PhysicsDataAsset->bLockRotationY;
@@ -395,11 +541,61 @@ void AISMPhysicsActor::ApplyCollisionSettings(UISMPhysicsDataAsset* PhysicsDataA
 	MeshComponent->SetCanEverAffectNavigation(PhysicsDataAsset->bCanEverEffectNavigation);
 	MeshComponent->SetWalkableSlopeOverride(PhysicsDataAsset->WalkableSlopeOverride);
 	MeshComponent->SetNotifyRigidBodyCollision(PhysicsDataAsset->bIsDestructable);
+	MeshComponent->SetGenerateOverlapEvents(PhysicsDataAsset->bGenerateOverlapEvents);
     
     UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("AISMPhysicsActor::ApplyCollisionSettings - Preset: %s, PhysicsCollision: %s"),
         *PhysicsDataAsset->CollisionPreset.ToString(), PhysicsDataAsset->bEnablePhysicsCollision ? TEXT("Enabled") : TEXT("Disabled"));
 }
 
+void AISMPhysicsActor::UpdateCollisionLOD(float CameraDistance)
+{
+    const UISMPhysicsDataAsset* PhysicsDataAsset = PhysicsData.Get();
+    if (!PhysicsDataAsset || !PhysicsDataAsset->bEnableCollisionLOD)
+    {
+        return;
+    }
+    SetSimplifiedCollision(PhysicsDataAsset->ShouldUseSimplifiedCollision(CameraDistance, bSimplifiedCollision));
+}
+
+void AISMPhysicsActor::SetSimplifiedCollision(bool bSimplified)
+{
+    if (bSimplified == bSimplifiedCollision || !MeshComponent)
+    {
+        return;
+    }
+
+    const UISMPhysicsDataAsset* PhysicsDataAsset = PhysicsData.Get();
+    if (bSimplified && (!PhysicsDataAsset || !PhysicsDataAsset->bEnableCollisionLOD))
+    {
+        return;
+    }
+    bSimplifiedCollision = bSimplified;
+
+    // Near iteration counts are whatever the class defaults give the body
+    FBodyInstance& Body = MeshComponent->BodyInstance;
+    if (bSimplified)
+    {
+        Body.SetPositionSolverIterationCount(static_cast<uint8>(FMath::Clamp(PhysicsDataAsset->FarPositionSolverIterations, 1, 255)));
+        Body.SetVelocitySolverIterationCount(static_cast<uint8>(FMath::Clamp(PhysicsDataAsset->FarVelocitySolverIterations, 1, 255)));
+    }
+    else if (const AISMPhysicsActor* Defaults = GetClass()->GetDefaultObject<AISMPhysicsActor>(); Defaults && Defaults->MeshComponent)
+    {
+        Body.SetPositionSolverIterationCount(Defaults->MeshComponent->BodyInstance.PositionSolverIterationCount);
+        Body.SetVelocitySolverIterationCount(Defaults->MeshComponent->BodyInstance.VelocitySolverIterationCount);
+    }
+
+    // Subclasses that construct a plain static mesh component only get the iteration change
+    if (UISMPhysicsMeshComponent* LODMesh = Cast<UISMPhysicsMeshComponent>(MeshComponent))
+    {
+        LODMesh->SetCollisionShape(bSimplified && PhysicsDataAsset
+            ? PhysicsDataAsset->SimplifiedCollisionShape
+            : EISMPhysicsCollisionShape::Mesh);
+    }
+
+    UE_LOG(LogISMRuntimePhysics, VeryVerbose, TEXT("AISMPhysicsActor::SetSimplifiedCollision - %s: %s"),
+        *GetName(), bSimplified ? TEXT("Simplified") : TEXT("Full"));
+}
+
 void AISMPhysicsActor::ApplyVisualSettings(UISMPhysicsDataAsset* PhysicsDataAsset)
 {
     if (!MeshComponent || !PhysicsDataAsset)
@@ -470,7 +666,7 @@ bool AISMPhysicsActor::IsAtRest() const
     return IsVelocityBelowThreshold(LinearVelocity, AngularVelocity);
 }
 
-void AISMPhysicsActor::UpdateRestingDetection(float DeltaTime)
+void AISMPhysicsActor::UpdateRestingDetection(float DeltaTime, bool bAtRest)
 {
     if (!PhysicsData.IsValid())
     {
@@ -482,8 +678,6 @@ void AISMPhysicsActor::UpdateRestingDetection(float DeltaTime)
         bWasAtRestLastFrame = false;
         return;
     }
-    const bool bAtRest = IsAtRest();
-
     if (bAtRest)
     {
         if (bWasAtRestLastFrame)
@@ -527,8 +721,9 @@ bool AISMPhysicsActor::ShouldReturnToISM() const
         return false;
     }
    
-    // Check if at rest for required duration
-    const bool bAtRest = IsAtRest();
+    // Check if at rest for required duration. The latest rest detection step already sampled
+    // the velocities, so this reads its result instead of querying the body again.
+    const bool bAtRest = bWasAtRestLastFrame;
     const bool bLongEnough = TimeAtRest >= PhysicsData->RestingCheckDelay;
 
     return bAtRest && bLongEnough;
@@ -578,9 +773,9 @@ void AISMPhysicsActor::ReturnSelfToPool()
     {
         if (UISMRuntimePoolSubsystem* Pool = World->GetSubsystem<UISMRuntimePoolSubsystem>())
         {
-            FTransform FinalTransform;
-            bool bUpdateTransform = false;
-            Pool->ReturnActor(this, FinalTransform, bUpdateTransform);
+            // The final transform already went back through the instance handle, so this can
+            // join the frame's batched returns
+            Pool->DeferReturnActor(this);
         }
     }
 }
@@ -798,11 +993,14 @@ void AISMPhysicsActor::DestroyLinkedISMInstance()
 #pragma endregion
 
 
-void AISMPhysicsActor::SetInstanceHandle(const FISMInstanceHandle& Handle)
+void AISMPhysicsActor::SetInstanceHandle(const FISMInstanceHandle& Handle, bool bApplyMaterials)
 {
     InstanceHandle = Handle;
     InstanceHandle.SetConvertedActor(this, GetPoolActivationCount());
-	InstanceHandle.RefreshConvertedActorMaterials(GetWorld());
+    if (bApplyMaterials)
+    {
+        InstanceHandle.RefreshConvertedActorMaterials(GetWorld());
+    }
     const FString CompName = Handle.Component.IsValid() ? Handle.Component.Get()->GetName() : TEXT("NULL");
     UE_LOG(LogTemp, Log, TEXT("PhysicsActor %s set instance handle: Component=%s, Index=%d"), *GetName(), *CompName, Handle.InstanceIndex);
 }
@@ -1,9 +1,19 @@
 #include "ISMPhysicsComponent.h"
+#include "ISMRuntimePhysics.h"
 #include "ISMPhysicsDataAsset.h"
 #include "ISMInstanceDataAsset.h"
 #include "ISMPhysicsActor.h"
+#include "ISMBallisticTransformer.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMFrameBudget.h"
+#include "ISMRuntimeProfiling.h"
+#include "Batching/ISMBatchScheduler.h"
 #include "ISMRuntimePoolSubsystem.h"
 #include "ISMInstanceHandle.h"
+#include "Settings/ISMPerformanceProfile.h"
+#include "CustomData/ISMCustomDataConversionSystem.h"
+#include "Feedbacks/ISMFeedbackSubsystem.h"
+#include "Feedbacks/ISMFeedbackContext.h"
 #include "Engine/World.h"
 #include "Camera/PlayerCameraManager.h"
 #include "GameFramework/PlayerController.h"
@@ -43,8 +53,25 @@ void UISMPhysicsComponent::BeginPlay()
         {
             UE_LOG(LogISMRuntimePhysics, Error, TEXT("UISMPhysicsComponent::BeginPlay - Failed to get pool subsystem!"));
         }
+        else
+        {
+            // Count as a user of our pool so it outlives regions that stream out before us
+            PoolSubsystem->RegisterComponent(this);
+        }
+
+        if (UISMRuntimeSubsystem* RuntimeSubsystem = World->GetSubsystem<UISMRuntimeSubsystem>())
+        {
+            CachedScheduler = RuntimeSubsystem->GetOrCreateBatchSchduler();
+        }
     }
     
+    // Enough rings that the simulation distance falls inside them; the last one catches the rest
+    const float SimulationDistance = GetEffectiveMaxSimulationDistance();
+    const int32 NumDistanceBuckets = SimulationDistance > 0.0f
+        ? FMath::CeilToInt32(SimulationDistance / FMath::Max(DistanceBucketSize, 1.0f)) + 2
+        : 32;
+    ActivePhysicsActors.Configure(DistanceBucketSize, NumDistanceBuckets);
+    
     // Validate configuration
     if (!PhysicsData)
     {
@@ -59,15 +86,46 @@ void UISMPhysicsComponent::BeginPlay()
 
 void UISMPhysicsComponent::EndPlay(const EEndPlayReason::Type EndReason)
 {
-    // Return all actors to pool
+    // Queued instances stay in the ISM; return all actors to pool
+    CancelQueuedConversions();
     ReturnAllToISM(true);
+
+    // Unregister before releasing so the scheduler doesn't tick a dangling pointer
+    if (BallisticTransformer.IsValid())
+    {
+        if (UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get())
+        {
+            Scheduler->UnregisterTransformer(BallisticTransformer->GetTransformerName());
+        }
+        BallisticTransformer.Reset();
+    }
+
+    if (PoolSubsystem.IsValid())
+    {
+        PoolSubsystem->UnregisterComponent(this);
+    }
     
     Super::EndPlay(EndReason);
 }
 
-void UISMPhysicsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UISMPhysicsComponent::TickRuntime(float DeltaTime)
 {
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    Super::TickRuntime(DeltaTime);
+
+    if (BallisticTransformer.IsValid())
+    {
+        BallisticTransformer->UpdateFrameParams(GetWorld()->GetTimeSeconds(), BuildBallisticSettings());
+    }
+
+    // Keeps the active count exact and the distance rings current for overflow handling
+    RefreshActiveActors();
+
+    if (ConversionQueue.Num() > 0)
+    {
+        ProcessConversionQueue(MaxConversionsPerFrame, true);
+    }
     
     if (!bEnableLimiters)
     {
@@ -77,13 +135,14 @@ void UISMPhysicsComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
     // Increment frame counter
     LimiterCheckFrameCounter++;
     
-    // Only check limiters every N frames
-    if (LimiterCheckFrameCounter >= LimiterCheckInterval)
+    // Only check limiters every N frames; a frame out of budget postpones the check to the next one
+    FISMFrameBudgetScope LimiterBudget(FISMFrameBudgetGovernor::Get(GetWorld()), TEXT("PhysicsLimiters"), EISMFrameBudgetPriority::Normal);
+    if (LimiterCheckFrameCounter >= LimiterCheckInterval && LimiterBudget.HasTime())
     {
         LimiterCheckFrameCounter = 0;
         
         // Enforce distance limits
-        if (MaxSimulationDistance > 0.0f)
+        if (GetEffectiveMaxSimulationDistance() > 0.0f)
         {
             EnforceDistanceLimits();
         }
@@ -93,9 +152,10 @@ void UISMPhysicsComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
         {
             EnforceLifetimeLimits();
         }
-        
-        // Cleanup invalid actors
-        CleanupInvalidActors();
+    }
+    else if (LimiterCheckFrameCounter >= LimiterCheckInterval)
+    {
+        LimiterBudget.Defer(1);
     }
     
 #if WITH_EDITOR
@@ -126,10 +186,26 @@ void UISMPhysicsComponent::OnInitializationComplete()
 {
     Super::OnInitializationComplete();
     
+    RefreshConversionThresholds();
+
     // Additional physics-specific initialization
     UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::OnInitializationComplete - %s"), *GetOwner()->GetName());
 }
 
+void UISMPhysicsComponent::OnInstanceAdded(int32 InstanceIndex, const FTransform& Transform)
+{
+    Super::OnInstanceAdded(InstanceIndex, Transform);
+
+    while (ConversionThresholds.Num() <= InstanceIndex)
+    {
+        // Gaps are filled by the next full refresh; until then they never convert
+        ConversionThresholds.Add(TNumericLimits<float>::Max());
+    }
+    const float Threshold = ComputeConversionThreshold(Transform);
+    ConversionThresholds[InstanceIndex] = Threshold;
+    MinConversionThreshold = FMath::Min(MinConversionThreshold, Threshold);
+}
+
 void UISMPhysicsComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 {
     // Cleanup all physics actors
@@ -143,6 +219,10 @@ void UISMPhysicsComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 AActor* UISMPhysicsComponent::ConvertInstanceToPhysics(int32 InstanceIndex, FVector ImpactPoint,
     FVector ImpactNormal, float ImpactForce, AActor* Instigator)
 {
+    ISM_TRACE_SCOPE(UISMPhysicsComponent::ConvertInstanceToPhysics);
+    SCOPE_CYCLE_COUNTER(STAT_ISMConversion);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
     // Validate instance
     if (!IsValidInstanceIndex(InstanceIndex))
     {
@@ -170,7 +250,7 @@ AActor* UISMPhysicsComponent::ConvertInstanceToPhysics(int32 InstanceIndex, FVec
     // Handle overflow if at max concurrent actors
     if (IsAtMaxConcurrentActors())
     {
-        HandleActorOverflow();
+        HandleActorOverflow(ActivePhysicsActors.Num() - GetEffectiveMaxConcurrentActors() + 1);
     }
 
     // Get instance handle
@@ -184,6 +264,9 @@ AActor* UISMPhysicsComponent::ConvertInstanceToPhysics(int32 InstanceIndex, FVec
     if (bApplyGeminiCurse && Handle.GetConvertedActor())
         HandlePrevPooledActorIfGeminiCursed(Handle);
 
+    // A full actor takes over from wherever ballistic lite flight has got to
+    LandBallisticInstance(InstanceIndex);
+
     // Spawn physics actor from pool
     AISMPhysicsActor* PhysicsActor = SpawnPhysicsActorFromPool(Handle);
     if (!PhysicsActor)
@@ -200,16 +283,25 @@ AActor* UISMPhysicsComponent::ConvertInstanceToPhysics(int32 InstanceIndex, FVec
 		UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ConvertInstanceToPhysics - Instance %d converted to actor %s. Activation Count = %d"), InstanceIndex, *PhysicsActor->GetName(), PhysicsActor->GetPoolActivationCount());
         // Mark the handle as converted (this tracks conversion state)
         Handle.SetConvertedActor(PhysicsActor, PhysicsActor->GetPoolActivationCount());
+        INC_DWORD_STAT(STAT_ISMInstancesConverted);
     }
 	Handle.RefreshConvertedActorMaterials(GetWorld());
     
+    // Pick the collision tier first: switching rebuilds the body and would drop a pending impulse
+    AISMPhysicsActor* TypedActor = Cast<AISMPhysicsActor>(PhysicsActor);
+    const float CameraDistance = TypedActor ? FVector::Dist(TypedActor->GetActorLocation(), GetCameraLocation()) : 0.0f;
+    if (TypedActor)
+    {
+        TypedActor->UpdateCollisionLOD(CameraDistance);
+    }
+
     // Apply conversion impulse
     ApplyConversionImpulse(PhysicsActor, ImpactPoint, ImpactNormal, ImpactForce);
     
     // Track the actor
-    if (AISMPhysicsActor* TypedActor = Cast<AISMPhysicsActor>(PhysicsActor))
+    if (TypedActor)
     {
-        ActivePhysicsActors.Add(TypedActor);
+        ActivePhysicsActors.Add(TypedActor, CameraDistance);
         RegisterActorReturnCallback(TypedActor);
     }
     
@@ -225,52 +317,228 @@ AActor* UISMPhysicsComponent::ConvertInstanceToPhysics(int32 InstanceIndex, FVec
     return PhysicsActor;
 }
 
-void UISMPhysicsComponent::ReturnAllToISM(bool bUpdateTransforms)
+TArray<AActor*> UISMPhysicsComponent::ConvertInstancesToPhysics(const TArray<int32>& InstanceIndices, FVector ImpactOrigin,
+    float ImpactForce, AActor* Instigator)
 {
-    UE_LOG(LogISMRuntimePhysics, Log, TEXT("UISMPhysicsComponent::ReturnAllToISM - Returning %d actors"), ActivePhysicsActors.Num());
-    
-    // Return all active physics actors
-    for (const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr : ActivePhysicsActors)
+    ISM_TRACE_SCOPE(UISMPhysicsComponent::ConvertInstancesToPhysics);
+    SCOPE_CYCLE_COUNTER(STAT_ISMConversion);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    TArray<AActor*> Result;
+    if (InstanceIndices.Num() == 0)
+    {
+        return Result;
+    }
+
+    if (!PoolSubsystem.IsValid() || !PhysicsData || !PhysicsData->GetPoolClass())
     {
-        if (AISMPhysicsActor* Actor = ActorPtr.Get())
+        UE_LOG(LogISMRuntimePhysics, Error, TEXT("UISMPhysicsComponent::ConvertInstancesToPhysics - Pool subsystem, PhysicsData or pooled actor class missing"));
+        return Result;
+    }
+
+    if (bApplyGeminiCurse)
+        LogGeminiCurseWarning(GetOwner()->GetName());
+
+    const bool bUseBallisticLite = PhysicsData->bEnableBallisticLite;
+    const FVector CameraLocation = bUseBallisticLite ? GetCameraLocation() : FVector::ZeroVector;
+    int32 NumBallistic = 0;
+
+    // Same checks as ConvertInstanceToPhysics, gathered so the pool sees one request
+    TArray<int32> ConvertIndices;
+    TArray<FISMInstanceHandle> Handles;
+    TSet<int32> Seen;
+    ConvertIndices.Reserve(InstanceIndices.Num());
+    Handles.Reserve(InstanceIndices.Num());
+
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        bool bAlreadySeen = false;
+        Seen.Add(InstanceIndex, &bAlreadySeen);
+        if (bAlreadySeen || !IsValidInstanceIndex(InstanceIndex))
+        {
+            continue;
+        }
+
+        if (!bApplyGeminiCurse && IsInstanceConverted(InstanceIndex))
         {
-            Actor->ReturnToISM();
+            continue;
         }
+
+        // Distant instances skip the actor path, and with it the distance limiter
+        if (bUseBallisticLite && ShouldUseBallisticLite(InstanceIndex, CameraLocation))
+        {
+            NumBallistic += LaunchInstanceBallistic(InstanceIndex, ImpactOrigin, ImpactForce) ? 1 : 0;
+            continue;
+        }
+
+        if (!ShouldAllowConversion(InstanceIndex, ImpactForce))
+        {
+            continue;
+        }
+
+        FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
+        if (!Handle.IsValid())
+        {
+            continue;
+        }
+
+        if (bApplyGeminiCurse && Handle.GetConvertedActor())
+            HandlePrevPooledActorIfGeminiCursed(Handle);
+
+        LandBallisticInstance(InstanceIndex);
+
+        ConvertIndices.Add(InstanceIndex);
+        Handles.Add(MoveTemp(Handle));
     }
-    
-    // Clear the array
-    ActivePhysicsActors.Empty();
-}
 
-TArray<AActor*> UISMPhysicsComponent::GetActivePhysicsActors() const
-{
-    TArray<AActor*> Result;
-    
-    for (const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr : ActivePhysicsActors)
+    if (NumBallistic > 0)
+    {
+        UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ConvertInstancesToPhysics - Launched %d distant instances as ballistic lite"), NumBallistic);
+    }
+
+    if (Handles.Num() == 0)
+    {
+        return Result;
+    }
+
+    // Free room for the whole batch in one eviction pass
+    const int32 MaxActors = GetEffectiveMaxConcurrentActors();
+    if (bEnableLimiters && MaxActors > 0)
     {
-        if (AISMPhysicsActor* Actor = ActorPtr.Get())
+        const int32 NumOver = ActivePhysicsActors.Num() + Handles.Num() - MaxActors;
+        if (NumOver > 0)
+        {
+            HandleActorOverflow(NumOver);
+        }
+    }
+
+    const FVector TrackingCameraLocation = GetCameraLocation();
+    TArray<AActor*> PooledActors;
+    PoolSubsystem->RequestActors(PhysicsData->GetPoolClass(), PhysicsData, Handles, PooledActors);
+
+    TArray<int32> ConvertedIndices;
+    ConvertedIndices.Reserve(PooledActors.Num());
+    Result.Reserve(PooledActors.Num());
+
+    // Materials are resolved for the whole batch once every actor holds its handle
+    TArray<FISMInstanceHandle> MaterialHandles;
+    TArray<AActor*> MaterialActors;
+    MaterialHandles.Reserve(PooledActors.Num());
+    MaterialActors.Reserve(PooledActors.Num());
+
+    for (int32 Index = 0; Index < PooledActors.Num(); ++Index)
+    {
+        AISMPhysicsActor* PhysicsActor = Cast<AISMPhysicsActor>(PooledActors[Index]);
+        if (!PhysicsActor)
+        {
+            UE_LOG(LogISMRuntimePhysics, Warning, TEXT("UISMPhysicsComponent::ConvertInstancesToPhysics - Spawned actor was not of type ISMPhysicsActor"));
+            continue;
+        }
+
+        // Marks the handle converted; materials follow in one batch below
+        PhysicsActor->SetInstanceHandle(Handles[Index], false);
+        MaterialHandles.Add(PhysicsActor->GetInstanceHandle());
+        MaterialActors.Add(PhysicsActor);
+
+        const int32 InstanceIndex = ConvertIndices[Index];
+        if (!bApplyGeminiCurse)
         {
-            Result.Add(Actor);
+            HideInstance(InstanceIndex, false);
+            Handles[Index].SetConvertedActor(PhysicsActor, PhysicsActor->GetPoolActivationCount());
+            INC_DWORD_STAT(STAT_ISMInstancesConverted);
         }
+
+        const FVector InstanceLocation = GetInstanceLocation(InstanceIndex);
+        const float CameraDistance = FVector::Dist(InstanceLocation, TrackingCameraLocation);
+        PhysicsActor->UpdateCollisionLOD(CameraDistance);
+        ApplyConversionImpulse(PhysicsActor, InstanceLocation, (InstanceLocation - ImpactOrigin).GetSafeNormal(), ImpactForce);
+
+        ActivePhysicsActors.Add(PhysicsActor, CameraDistance);
+        RegisterActorReturnCallback(PhysicsActor);
+
+        ConvertedIndices.Add(InstanceIndex);
+        Result.Add(PhysicsActor);
+    }
+
+    UISMCustomDataConversionSystem::ResolveAndApplyBatch(MaterialHandles, MaterialActors, GetWorld());
+
+    TotalConversions += Result.Num();
+
+    if (Result.Num() > 0)
+    {
+        OnPhysicsConversionBatch.Broadcast(ConvertedIndices, Result);
     }
+
+    UE_LOG(LogISMRuntimePhysics, Log, TEXT("UISMPhysicsComponent::ConvertInstancesToPhysics - Converted %d of %d instances (Active: %d, Total: %d)"),
+        Result.Num(), InstanceIndices.Num(), ActivePhysicsActors.Num(), TotalConversions);
+
+    return Result;
+}
+
+int32 UISMPhysicsComponent::LaunchInstancesBallistic(const TArray<int32>& InstanceIndices, FVector ImpactOrigin, float ImpactForce)
+{
+    int32 NumLaunched = 0;
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        NumLaunched += LaunchInstanceBallistic(InstanceIndex, ImpactOrigin, ImpactForce) ? 1 : 0;
+    }
+    return NumLaunched;
+}
+
+bool UISMPhysicsComponent::IsInstanceInBallisticFlight(int32 InstanceIndex) const
+{
+    return BallisticTransformer.IsValid() && BallisticTransformer->IsInFlight(InstanceIndex);
+}
+
+int32 UISMPhysicsComponent::GetBallisticInstanceCount() const
+{
+    return BallisticTransformer.IsValid() ? BallisticTransformer->GetInFlightCount() : 0;
+}
+
+void UISMPhysicsComponent::ReturnAllToISM(bool bUpdateTransforms)
+{
+    UE_LOG(LogISMRuntimePhysics, Log, TEXT("UISMPhysicsComponent::ReturnAllToISM - Returning %d actors"), ActivePhysicsActors.Num());
     
+    // Return all active physics actors
+    TArray<AActor*> Actors;
+    ActivePhysicsActors.GetActors(Actors);
+    ActivePhysicsActors.Reset();
+    ReturnTrackedActors(Actors, bUpdateTransforms);
+}
+
+TArray<AActor*> UISMPhysicsComponent::GetActivePhysicsActors() const
+{
+    TArray<AActor*> Result;
+    ActivePhysicsActors.GetActors(Result);
+    Result.RemoveAllSwap([this](const AActor* Actor) { return !IsActorStillActive(*Actor); });
     return Result;
 }
 
 bool UISMPhysicsComponent::IsAtMaxConcurrentActors() const
 {
-    if (!bEnableLimiters || MaxConcurrentActors <= 0)
+    const int32 MaxActors = GetEffectiveMaxConcurrentActors();
+    if (!bEnableLimiters || MaxActors <= 0)
     {
         return false;
     }
     
-    return ActivePhysicsActors.Num() >= MaxConcurrentActors;
+    return ActivePhysicsActors.Num() >= MaxActors;
+}
+
+int32 UISMPhysicsComponent::GetEffectiveMaxConcurrentActors() const
+{
+    return FISMPerformanceProfileSettings::ScaleLimit(MaxConcurrentActors, FISMPerformanceProfiles::GetActive().PhysicsActorLimitScale);
+}
+
+float UISMPhysicsComponent::GetEffectiveMaxSimulationDistance() const
+{
+    return MaxSimulationDistance * FISMPerformanceProfiles::GetActive().PhysicsDistanceScale;
 }
 
 bool UISMPhysicsComponent::ShouldAllowConversion(int32 InstanceIndex, float ImpactForce) const
 {
     // Check force threshold
-    if (PhysicsData && ImpactForce < PhysicsData->ConversionForceThreshold)
+    if (ImpactForce < GetConversionThreshold(InstanceIndex))
     {
         return false;
     }
@@ -282,13 +550,14 @@ bool UISMPhysicsComponent::ShouldAllowConversion(int32 InstanceIndex, float Impa
     }
     
     // Distance check (if limiters enabled)
-    if (bEnableLimiters && MaxSimulationDistance > 0.0f)
+    const float SimulationDistance = GetEffectiveMaxSimulationDistance();
+    if (bEnableLimiters && SimulationDistance > 0.0f)
     {
         const FVector InstanceLocation = GetInstanceLocation(InstanceIndex);
         const FVector CameraLocation = GetCameraLocation();
         const float Distance = FVector::Dist(InstanceLocation, CameraLocation);
         
-        if (Distance > MaxSimulationDistance)
+        if (Distance > SimulationDistance)
         {
             return false;
         }
@@ -297,6 +566,71 @@ bool UISMPhysicsComponent::ShouldAllowConversion(int32 InstanceIndex, float Impa
     return true;
 }
 
+float UISMPhysicsComponent::GetConversionThreshold(int32 InstanceIndex) const
+{
+    if (ConversionThresholds.IsValidIndex(InstanceIndex))
+    {
+        return ConversionThresholds[InstanceIndex];
+    }
+    // Not built yet (or index out of range): same answer the data asset alone would give
+    return IsValidInstanceIndex(InstanceIndex) ? ComputeConversionThreshold(GetInstanceTransform(InstanceIndex)) : 0.0f;
+}
+
+int32 UISMPhysicsComponent::FilterByConversionThreshold(TArray<int32>& Candidates, float ImpactForce) const
+{
+    if (!CanAnyInstanceConvert(ImpactForce))
+    {
+        Candidates.Reset();
+        return 0;
+    }
+
+    const int32 NumThresholds = ConversionThresholds.Num();
+    const float* Thresholds = ConversionThresholds.GetData();
+
+    // Branch-light compaction; indices past the table fall back to the slow lookup
+    int32 NumKept = 0;
+    for (int32 Read = 0; Read < Candidates.Num(); ++Read)
+    {
+        const int32 InstanceIndex = Candidates[Read];
+        const float Threshold = static_cast<uint32>(InstanceIndex) < static_cast<uint32>(NumThresholds)
+            ? Thresholds[InstanceIndex]
+            : GetConversionThreshold(InstanceIndex);
+        Candidates[NumKept] = InstanceIndex;
+        NumKept += ImpactForce >= Threshold ? 1 : 0;
+    }
+    Candidates.SetNum(NumKept, EAllowShrinking::No);
+    return NumKept;
+}
+
+void UISMPhysicsComponent::RefreshConversionThresholds()
+{
+    const int32 NumInstances = GetInstanceCount();
+    ConversionThresholds.SetNumUninitialized(NumInstances, EAllowShrinking::No);
+    MinConversionThreshold = NumInstances > 0 ? TNumericLimits<float>::Max() : 0.0f;
+
+    for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+    {
+        const float Threshold = ComputeConversionThreshold(GetInstanceTransform(InstanceIndex));
+        ConversionThresholds[InstanceIndex] = Threshold;
+        MinConversionThreshold = FMath::Min(MinConversionThreshold, Threshold);
+    }
+}
+
+float UISMPhysicsComponent::ComputeConversionThreshold(const FTransform& Transform) const
+{
+    if (!PhysicsData)
+    {
+        return 0.0f;
+    }
+
+    float Threshold = PhysicsData->ConversionForceThreshold;
+    if (PhysicsData->bConversionThresholdIsScaled)
+    {
+        Threshold *= Transform.GetScale3D().GetAbsMax();
+    }
+    return Threshold;
+}
+
 // ===== Conversion Helpers =====
 
 AISMPhysicsActor* UISMPhysicsComponent::SpawnPhysicsActorFromPool(const FISMInstanceHandle& InstanceHandle)
@@ -319,7 +653,7 @@ AISMPhysicsActor* UISMPhysicsComponent::SpawnPhysicsActorFromPool(const FISMInst
     }
     
     // Get pooled actor class from data asset
-    TSubclassOf<AActor> ActorClass = PhysicsData->PooledActorClass;
+    TSubclassOf<AActor> ActorClass = PhysicsData->GetPoolClass();
     if (!ActorClass)
     {
         UE_LOG(LogISMRuntimePhysics, Error, TEXT("UISMPhysicsComponent::SpawnPhysicsActorFromPool - PooledActorClass not set in data asset"));
@@ -346,15 +680,15 @@ AISMPhysicsActor* UISMPhysicsComponent::SpawnPhysicsActorFromPool(const FISMInst
     return ISMActor;
 }
 
-void UISMPhysicsComponent::HandleActorOverflow()
+void UISMPhysicsComponent::HandleActorOverflow(int32 NumToFree)
 {
-    if (ActivePhysicsActors.Num() == 0)
+    if (ActivePhysicsActors.Num() == 0 || NumToFree <= 0)
     {
         return;
     }
     
-    UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::HandleActorOverflow - Handling overflow (Behavior: %d)"),
-        static_cast<int32>(ActorOverflowBehavior));
+    UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::HandleActorOverflow - Freeing %d actors (Behavior: %d)"),
+        NumToFree, static_cast<int32>(ActorOverflowBehavior));
     
     switch (ActorOverflowBehavior)
     {
@@ -363,61 +697,141 @@ void UISMPhysicsComponent::HandleActorOverflow()
             break;
             
         case EActorOverflowBehavior::ReturnOldest:
-            ReturnOldestActor();
+            ReturnOldestActors(NumToFree);
             break;
             
         case EActorOverflowBehavior::ReturnFarthest:
-            ReturnFarthestActor();
+            ReturnFarthestActors(NumToFree);
             break;
     }
 }
 
-void UISMPhysicsComponent::ReturnOldestActor()
+void UISMPhysicsComponent::ReturnOldestActors(int32 Count)
 {
-    if (ActivePhysicsActors.Num() == 0)
+    // Entries can be stale until the next refresh reaches them; those don't count
+    int32 NumReturned = 0;
+    TArray<AActor*> Popped;
+    while (NumReturned < Count && ActivePhysicsActors.Num() > 0)
     {
-        return;
+        Popped.Reset();
+        ActivePhysicsActors.PopOldest(Count - NumReturned, Popped);
+        NumReturned += ReturnTrackedActors(Popped);
     }
-    
-    // First actor in array is oldest (since we add to end)
-    if (AISMPhysicsActor* OldestActor = ActivePhysicsActors[0].Get())
+
+    UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ReturnOldestActors - Returned %d oldest actors"), NumReturned);
+}
+
+void UISMPhysicsComponent::ReturnFarthestActors(int32 Count)
+{
+    int32 NumReturned = 0;
+    TArray<AActor*> Popped;
+    while (NumReturned < Count && ActivePhysicsActors.Num() > 0)
     {
-        UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ReturnOldestActor - Returning oldest actor"));
-        OldestActor->ReturnToISM();
+        Popped.Reset();
+        ActivePhysicsActors.PopFarthest(Count - NumReturned, Popped);
+        NumReturned += ReturnTrackedActors(Popped);
     }
+
+    UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ReturnFarthestActors - Returned %d farthest actors"), NumReturned);
 }
 
-void UISMPhysicsComponent::ReturnFarthestActor()
+int32 UISMPhysicsComponent::ReturnTrackedActors(TConstArrayView<AActor*> Actors, bool bUpdateTransforms)
 {
-    if (ActivePhysicsActors.Num() == 0)
+    int32 NumReturned = 0;
+
+    TArray<AActor*> Batch;
+    TArray<FISMInstanceHandle> Handles;
+    TArray<FTransform> FinalTransforms;
+    Batch.Reserve(Actors.Num());
+    Handles.Reserve(Actors.Num());
+    FinalTransforms.Reserve(Actors.Num());
+
+    for (AActor* Actor : Actors)
     {
-        return;
+        AISMPhysicsActor* PhysicsActor = Cast<AISMPhysicsActor>(Actor);
+        if (!PhysicsActor || !IsActorStillActive(*PhysicsActor))
+        {
+            continue;
+        }
+
+        // Duplicated instances, stale activations and actors the handle no longer points at
+        // keep the per-actor path and its checks
+        const FISMInstanceHandle& Handle = PhysicsActor->GetInstanceHandle();
+        if (bApplyGeminiCurse || !Handle.IsValid() || Handle.GetConvertedActor() != PhysicsActor
+            || Handle.CachedActorActivationCount != PhysicsActor->GetPoolActivationCount())
+        {
+            PhysicsActor->ReturnToISM();
+            ++NumReturned;
+            continue;
+        }
+
+        const FTransform* PreConversionTransform = bUpdateTransforms
+            ? nullptr
+            : GetInstanceStateStore().GetLastVisibleTransform(Handle.InstanceIndex);
+
+        Batch.Add(PhysicsActor);
+        Handles.Add(Handle);
+        FinalTransforms.Add(PreConversionTransform ? *PreConversionTransform : PhysicsActor->GetActorTransform());
     }
-    
-    const FVector CameraLocation = GetCameraLocation();
-    
-    AISMPhysicsActor* FarthestActor = nullptr;
-    float FarthestDistanceSq = 0.0f;
-    
-    for (const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr : ActivePhysicsActors)
+
+    if (Batch.Num() == 0)
+    {
+        return NumReturned;
+    }
+
+    ReturnConvertedInstances(Handles, FinalTransforms);
+
+    TArray<int32> ReturnedIndices;
+    ReturnedIndices.Reserve(Handles.Num());
+    for (const FISMInstanceHandle& Handle : Handles)
     {
-        if (AISMPhysicsActor* Actor = ActorPtr.Get())
+        ReturnedIndices.Add(Handle.InstanceIndex);
+    }
+
+    // Continuous feedback ends per actor on its own lifecycle tag; one-shot goes out once here
+    if (PhysicsData && !PhysicsData->IsContinous() && PhysicsData->ReturnFeedback.IsValid())
+    {
+        PlayBatchedReturnFeedback(ReturnedIndices);
+        for (AActor* Actor : Batch)
         {
-            const float DistanceSq = FVector::DistSquared(Actor->GetActorLocation(), CameraLocation);
-            if (DistanceSq > FarthestDistanceSq)
-            {
-                FarthestDistanceSq = DistanceSq;
-                FarthestActor = Actor;
-            }
+            CastChecked<AISMPhysicsActor>(Actor)->MarkReturnFeedbackHandled();
         }
     }
-    
-    if (FarthestActor)
+
+    if (PoolSubsystem.IsValid())
+    {
+        PoolSubsystem->ReturnActors(Batch);
+    }
+
+    TotalReturns += Batch.Num();
+    NumReturned += Batch.Num();
+
+    if (OnPhysicsReturn.IsBound())
+    {
+        for (int32 i = 0; i < Handles.Num(); ++i)
+        {
+            OnPhysicsReturn.Broadcast(Handles[i].InstanceIndex, FinalTransforms[i]);
+        }
+    }
+
+    UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ReturnTrackedActors - Returned %d actors in one batch (Total Returns: %d)"),
+        Batch.Num(), TotalReturns);
+
+    return NumReturned;
+}
+
+void UISMPhysicsComponent::PlayBatchedReturnFeedback(const TArray<int32>& InstanceIndices)
+{
+    UISMFeedbackSubsystem* FeedbackSys = GetFeedbackSubsystem();
+    if (!FeedbackSys || InstanceIndices.Num() == 0)
     {
-        UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::ReturnFarthestActor - Returning farthest actor (Distance: %.1f)"),
-            FMath::Sqrt(FarthestDistanceSq));
-        FarthestActor->ReturnToISM();
+        return;
     }
+
+    FISMFeedbackContext Context = FISMFeedbackContext::CreateFromInstanceBatched(PhysicsData->ReturnFeedback, this, InstanceIndices)
+        .WithInstigator(FISMFeedbackParticipant::FromActorComponent(this));
+    Context.Normal = FVector::DownVector;
+    FeedbackSys->RequestFeedback(Context);
 }
 
 void UISMPhysicsComponent::ApplyConversionImpulse(AActor* PhysicsActor, FVector ImpactPoint, 
@@ -446,6 +860,257 @@ void UISMPhysicsComponent::ApplyConversionImpulse(AActor* PhysicsActor, FVector
         ImpactForce, *ImpactPoint.ToString());
 }
 
+// ===== Conversion Queue =====
+
+bool UISMPhysicsComponent::QueueConversion(int32 InstanceIndex, FVector ImpactPoint, FVector ImpactNormal,
+    float ImpactForce, AActor* Instigator)
+{
+    return EnqueueConversion(InstanceIndex, ImpactPoint, ImpactNormal, ImpactForce, Instigator, false, GetCameraLocation());
+}
+
+int32 UISMPhysicsComponent::QueueConversions(const TArray<int32>& InstanceIndices, FVector ImpactOrigin,
+    float ImpactForce, AActor* Instigator)
+{
+    const FVector CameraLocation = GetCameraLocation();
+
+    int32 NumQueued = 0;
+    for (const int32 InstanceIndex : InstanceIndices)
+    {
+        NumQueued += EnqueueConversion(InstanceIndex, ImpactOrigin, FVector::ZeroVector, ImpactForce, Instigator, true, CameraLocation) ? 1 : 0;
+    }
+    return NumQueued;
+}
+
+bool UISMPhysicsComponent::EnqueueConversion(int32 InstanceIndex, const FVector& ImpactPoint, const FVector& ImpactNormal,
+    float ImpactForce, AActor* Instigator, bool bRadial, const FVector& CameraLocation)
+{
+    if (!IsValidInstanceIndex(InstanceIndex) || (!bApplyGeminiCurse && IsInstanceConverted(InstanceIndex)))
+    {
+        return false;
+    }
+
+    if (QueuedConversionIndices.Contains(InstanceIndex))
+    {
+        return true;
+    }
+
+    // Thrown away from the impact; a point impact is usually at the instance, so back off along its normal
+    const FVector LaunchOrigin = bRadial ? ImpactPoint : ImpactPoint - ImpactNormal.GetSafeNormal() * 100.0f;
+
+    // Far debris never gets an actor, so there is nothing to wait for
+    if (ShouldUseBallisticLite(InstanceIndex, CameraLocation))
+    {
+        return LaunchInstanceBallistic(InstanceIndex, LaunchOrigin, ImpactForce);
+    }
+
+    if (!ShouldAllowConversion(InstanceIndex, ImpactForce))
+    {
+        return false;
+    }
+
+    FQueuedConversion Entry;
+    Entry.InstanceIndex = InstanceIndex;
+    Entry.Generation = GetInstanceGeneration(InstanceIndex);
+    Entry.ImpactPoint = ImpactPoint;
+    Entry.ImpactNormal = ImpactNormal;
+    Entry.ImpactForce = ImpactForce;
+    Entry.Instigator = Instigator;
+    Entry.bRadial = bRadial;
+    Entry.Priority = ConversionQueuePriority == EISMConversionQueuePriority::ImpactForce
+        ? ImpactForce
+        : -FVector::Dist(GetInstanceLocation(InstanceIndex), CameraLocation);
+
+    ConversionQueue.HeapPush(MoveTemp(Entry), [](const FQueuedConversion& A, const FQueuedConversion& B) { return A.Priority > B.Priority; });
+    QueuedConversionIndices.Add(InstanceIndex);
+
+    if (bBallisticStandIn)
+    {
+        LaunchInstanceBallistic(InstanceIndex, LaunchOrigin, ImpactForce);
+    }
+    return true;
+}
+
+void UISMPhysicsComponent::ProcessConversionQueue(int32 MaxCount, bool bBudgeted)
+{
+    ISM_TRACE_SCOPE(UISMPhysicsComponent::ProcessConversionQueue);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    FISMFrameBudgetScope Budget(bBudgeted ? FISMFrameBudgetGovernor::Get(GetWorld()) : nullptr,
+        TEXT("PhysicsConversion"), EISMFrameBudgetPriority::Normal);
+
+    auto ByPriority = [](const FQueuedConversion& A, const FQueuedConversion& B) { return A.Priority > B.Priority; };
+
+    TArray<FQueuedConversion> Due;
+    while (ConversionQueue.Num() > 0 && Due.Num() < MaxCount)
+    {
+        FQueuedConversion Entry;
+        ConversionQueue.HeapPop(Entry, ByPriority, EAllowShrinking::No);
+        QueuedConversionIndices.Remove(Entry.InstanceIndex);
+
+        // Removed, recycled or converted by someone else while it waited
+        if (!IsValidInstanceIndex(Entry.InstanceIndex) || GetInstanceGeneration(Entry.InstanceIndex) != Entry.Generation
+            || (!bApplyGeminiCurse && IsInstanceConverted(Entry.InstanceIndex)))
+        {
+            continue;
+        }
+        Due.Add(MoveTemp(Entry));
+    }
+
+    // Entries from one QueueConversions call come out next to each other; they share a pool request
+    TArray<int32> RadialBatch;
+    int32 i = 0;
+    while (i < Due.Num())
+    {
+        if (i > 0 && !Budget.HasTime())
+        {
+            break;
+        }
+
+        const FQueuedConversion& First = Due[i];
+        if (!First.bRadial)
+        {
+            ConvertInstanceToPhysics(First.InstanceIndex, First.ImpactPoint, First.ImpactNormal, First.ImpactForce, First.Instigator.Get());
+            ++i;
+            continue;
+        }
+
+        RadialBatch.Reset();
+        int32 End = i;
+        for (; End < Due.Num() && Due[End].bRadial && Due[End].ImpactPoint == First.ImpactPoint
+            && Due[End].ImpactForce == First.ImpactForce && Due[End].Instigator == First.Instigator; ++End)
+        {
+            RadialBatch.Add(Due[End].InstanceIndex);
+        }
+        ConvertInstancesToPhysics(RadialBatch, First.ImpactPoint, First.ImpactForce, First.Instigator.Get());
+        i = End;
+    }
+
+    // Out of budget: the rest waits for next frame with its place in the queue
+    for (int32 Leftover = i; Leftover < Due.Num(); ++Leftover)
+    {
+        QueuedConversionIndices.Add(Due[Leftover].InstanceIndex);
+        ConversionQueue.HeapPush(MoveTemp(Due[Leftover]), ByPriority);
+    }
+    Budget.Defer(Due.Num() - i);
+}
+
+void UISMPhysicsComponent::FlushConversionQueue()
+{
+    ProcessConversionQueue(ConversionQueue.Num());
+}
+
+void UISMPhysicsComponent::CancelQueuedConversions()
+{
+    ConversionQueue.Reset();
+    QueuedConversionIndices.Reset();
+}
+
+// ===== Ballistic Lite =====
+
+bool UISMPhysicsComponent::ShouldUseBallisticLite(int32 InstanceIndex, const FVector& CameraLocation) const
+{
+    if (!PhysicsData || !PhysicsData->bEnableBallisticLite)
+    {
+        return false;
+    }
+
+    const float MinDistance = PhysicsData->BallisticLiteDistance;
+    return MinDistance <= 0.0f || FVector::DistSquared(GetInstanceLocation(InstanceIndex), CameraLocation) >= FMath::Square(MinDistance);
+}
+
+bool UISMPhysicsComponent::LaunchInstanceBallistic(int32 InstanceIndex, const FVector& ImpactOrigin, float ImpactForce)
+{
+    if (!PhysicsData || !IsValidInstanceIndex(InstanceIndex) || IsInstanceDestroyed(InstanceIndex))
+    {
+        return false;
+    }
+
+    // An actor already represents it; moving the hidden instance would show nowhere
+    if (IsInstanceConverted(InstanceIndex))
+    {
+        return false;
+    }
+
+    if (ImpactForce < GetConversionThreshold(InstanceIndex))
+    {
+        return false;
+    }
+
+    FISMBallisticTransformer* Transformer = GetOrCreateBallisticTransformer();
+    if (!Transformer)
+    {
+        return false;
+    }
+
+    const FTransform RestTransform = GetInstanceTransform(InstanceIndex);
+    const FVector AwayFromImpact = (RestTransform.GetLocation() - ImpactOrigin).GetSafeNormal();
+    const FVector LaunchDirection = (AwayFromImpact + FVector::UpVector * PhysicsData->BallisticUpwardBias).GetSafeNormal();
+
+    // Same impulse a rigid body would get; auto-calculated mass has no body to read it from
+    const float MassKg = PhysicsData->Mass > 0.0f ? PhysicsData->Mass : 1.0f;
+    const FVector Velocity = LaunchDirection * (ImpactForce / MassKg);
+    const FVector AngularVelocity = FMath::VRand() * FMath::FRandRange(0.0f, PhysicsData->BallisticMaxSpin);
+
+    Transformer->Launch(InstanceIndex, RestTransform, Velocity, AngularVelocity);
+    return true;
+}
+
+FISMBallisticTransformer* UISMPhysicsComponent::GetOrCreateBallisticTransformer()
+{
+    if (BallisticTransformer.IsValid())
+    {
+        return BallisticTransformer.Get();
+    }
+
+    UISMBatchSchedulerBase* Scheduler = CachedScheduler.Get();
+    if (!Scheduler)
+    {
+        UE_LOG(LogISMRuntimePhysics, Warning, TEXT("UISMPhysicsComponent::GetOrCreateBallisticTransformer - No batch scheduler on %s, ballistic lite is unavailable"),
+            *GetOwner()->GetName());
+        return nullptr;
+    }
+
+    const FName TransformerName(*FString::Printf(TEXT("ISMBallistic.%s.%s"), *GetOwner()->GetName(), *GetName()));
+    TSharedPtr<FISMBallisticTransformer> Transformer = MakeShared<FISMBallisticTransformer>(this, TransformerName);
+    Transformer->UpdateFrameParams(GetWorld()->GetTimeSeconds(), BuildBallisticSettings());
+
+    if (!Scheduler->RegisterTransformer(Transformer.Get()))
+    {
+        UE_LOG(LogISMRuntimePhysics, Warning, TEXT("UISMPhysicsComponent::GetOrCreateBallisticTransformer - Failed to register %s (name collision?)"),
+            *TransformerName.ToString());
+        return nullptr;
+    }
+
+    BallisticTransformer = MoveTemp(Transformer);
+    return BallisticTransformer.Get();
+}
+
+void UISMPhysicsComponent::LandBallisticInstance(int32 InstanceIndex)
+{
+    FTransform CurrentTransform;
+    if (BallisticTransformer.IsValid() && BallisticTransformer->Land(InstanceIndex, CurrentTransform))
+    {
+        UpdateInstanceTransform(InstanceIndex, CurrentTransform, true, false);
+    }
+}
+
+FISMBallisticSettings UISMPhysicsComponent::BuildBallisticSettings() const
+{
+    FISMBallisticSettings Settings;
+    if (const UWorld* World = GetWorld())
+    {
+        Settings.GravityZ = World->GetGravityZ();
+    }
+    if (PhysicsData)
+    {
+        Settings.Restitution = PhysicsData->BallisticRestitution;
+        Settings.GroundFriction = PhysicsData->BallisticGroundFriction;
+        Settings.SettleSpeed = PhysicsData->BallisticSettleSpeed;
+        Settings.MaxFlightTime = PhysicsData->BallisticMaxFlightTime;
+    }
+    return Settings;
+}
+
 // ===== Performance Limiters =====
 
 void UISMPhysicsComponent::EnforceDistanceLimits()
@@ -455,28 +1120,14 @@ void UISMPhysicsComponent::EnforceDistanceLimits()
         return;
     }
     
-    const FVector CameraLocation = GetCameraLocation();
-    const float MaxDistanceSq = MaxSimulationDistance * MaxSimulationDistance;
+    // Only the rings at or past the limit are read; distances are as fresh as the last refresh
+    TArray<AActor*> ActorsToReturn;
+    ActivePhysicsActors.PopBeyond(GetEffectiveMaxSimulationDistance(), ActorsToReturn);
     
-    TArray<AISMPhysicsActor*> ActorsToReturn;
-    
-    for (const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr : ActivePhysicsActors)
+    const int32 NumReturned = ReturnTrackedActors(ActorsToReturn);
+    if (NumReturned > 0)
     {
-        if (AISMPhysicsActor* Actor = ActorPtr.Get())
-        {
-            const float DistanceSq = FVector::DistSquared(Actor->GetActorLocation(), CameraLocation);
-            if (DistanceSq > MaxDistanceSq)
-            {
-                ActorsToReturn.Add(Actor);
-            }
-        }
-    }
-    
-    // Return actors beyond distance
-    for (AISMPhysicsActor* Actor : ActorsToReturn)
-    {
-        UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::EnforceDistanceLimits - Returning actor beyond max distance"));
-        Actor->ReturnToISM();
+        UE_LOG(LogISMRuntimePhysics, Verbose, TEXT("UISMPhysicsComponent::EnforceDistanceLimits - Returned %d actors beyond max distance"), NumReturned);
     }
 }
 
@@ -494,11 +1145,12 @@ void UISMPhysicsComponent::EnforceLifetimeLimits()
     }
     
     const double CurrentTime = World->GetTimeSeconds();
-    TArray<AISMPhysicsActor*> ActorsToReturn;
+    TArray<AActor*> ActiveActors;
+    ActivePhysicsActors.GetActors(ActiveActors);
     
-    for (const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr : ActivePhysicsActors)
+    for (AActor* ActorPtr : ActiveActors)
     {
-        if (AISMPhysicsActor* Actor = ActorPtr.Get())
+        if (AISMPhysicsActor* Actor = Cast<AISMPhysicsActor>(ActorPtr))
         {
             // Check if actor has exceeded max lifetime
             // We can't access TimeActivated directly, but we can use a workaround
@@ -532,13 +1184,27 @@ FVector UISMPhysicsComponent::GetCameraLocation() const
 
 // ===== Cleanup =====
 
-void UISMPhysicsComponent::CleanupInvalidActors()
+void UISMPhysicsComponent::RefreshActiveActors()
 {
-    // Remove null/invalid actors from tracking
-    ActivePhysicsActors.RemoveAll([](const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr)
+    if (ActivePhysicsActors.IsEmpty())
     {
-        return !ActorPtr.IsValid();
-    });
+        return;
+    }
+
+    ActivePhysicsActors.Refresh(DistanceRefreshPerTick, GetCameraLocation(),
+        [this](const AActor& Actor) { return IsActorStillActive(Actor); },
+        [](AActor& Actor, float Distance)
+        {
+            // IsActorStillActive already proved the cast
+            static_cast<AISMPhysicsActor&>(Actor).UpdateCollisionLOD(Distance);
+        });
+}
+
+bool UISMPhysicsComponent::IsActorStillActive(const AActor& Actor) const
+{
+    // Returned actors keep living in the pool, with their handle cleared or reassigned
+    const AISMPhysicsActor* PhysicsActor = Cast<AISMPhysicsActor>(&Actor);
+    return PhysicsActor && PhysicsActor->GetInstanceHandle().Component.Get() == this;
 }
 
 void UISMPhysicsComponent::RegisterActorReturnCallback(AISMPhysicsActor* PhysicsActor)
@@ -597,7 +1263,7 @@ void UISMPhysicsComponent::RegisterActorReturnCallback(AISMPhysicsActor* Physics
     // The actor will call ReturnToISM on its handle, which triggers the pool return
     
     // We could bind to OnInstanceReturnedToISM delegate here if needed
-    // For now, we rely on CleanupInvalidActors to remove returned actors
+    // RefreshActiveActors drops returned actors from tracking
 }
 
 // ===== Debug Visualization =====
@@ -613,26 +1279,26 @@ void UISMPhysicsComponent::DrawDebugVisualization() const
     }
     
     // Draw all active physics actors
-    for (const TWeakObjectPtr<AISMPhysicsActor>& ActorPtr : ActivePhysicsActors)
+    TArray<AActor*> ActiveActors;
+    ActivePhysicsActors.GetActors(ActiveActors);
+    for (const AActor* Actor : ActiveActors)
     {
-        if (const AISMPhysicsActor* Actor = ActorPtr.Get())
-        {
-            const FVector Location = Actor->GetActorLocation();
-            
-            // Draw sphere at actor location
-            DrawDebugSphere(World, Location, 50.0f, 12, DebugColor, false, -1.0f, 0, 2.0f);
-            
-            // Draw line to camera
-            const FVector CameraLocation = GetCameraLocation();
-            DrawDebugLine(World, Location, CameraLocation, FColor::Cyan, false, -1.0f, 0, 1.0f);
-        }
+        const FVector Location = Actor->GetActorLocation();
+        
+        // Draw sphere at actor location
+        DrawDebugSphere(World, Location, 50.0f, 12, DebugColor, false, -1.0f, 0, 2.0f);
+        
+        // Draw line to camera
+        const FVector CameraLocation = GetCameraLocation();
+        DrawDebugLine(World, Location, CameraLocation, FColor::Cyan, false, -1.0f, 0, 1.0f);
     }
     
     // Draw distance limit sphere (if enabled)
-    if (bEnableLimiters && MaxSimulationDistance > 0.0f)
+    const float SimulationDistance = GetEffectiveMaxSimulationDistance();
+    if (bEnableLimiters && SimulationDistance > 0.0f)
     {
         const FVector CameraLocation = GetCameraLocation();
-        DrawDebugSphere(World, CameraLocation, MaxSimulationDistance, 32, FColor::Orange, false, -1.0f, 0, 1.0f);
+        DrawDebugSphere(World, CameraLocation, SimulationDistance, 32, FColor::Orange, false, -1.0f, 0, 1.0f);
     }
     
     // Draw stats text
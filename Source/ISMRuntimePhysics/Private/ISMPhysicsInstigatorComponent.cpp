@@ -1,5 +1,7 @@
 #include "ISMPhysicsInstigatorComponent.h"
 #include "ISMPhysicsComponent.h"
+#include "ISMPhysicsActor.h"
+#include "ISMPhysicsInstigatorSubsystem.h"
 #include "ISMRuntimeSubsystem.h"
 #include "Components/PrimitiveComponent.h"
 #include "GameFramework/Actor.h"
@@ -27,6 +29,16 @@ void UISMPhysicsInstigatorComponent::BeginPlay()
     
     // Refresh physics components cache
     RefreshPhysicsComponentsCache();
+
+    if (bUseSharedBroadphase)
+    {
+        UWorld* World = GetWorld();
+        UISMPhysicsInstigatorSubsystem* Subsystem = World ? World->GetSubsystem<UISMPhysicsInstigatorSubsystem>() : nullptr;
+        if (Subsystem && Subsystem->RegisterInstigator(this))
+        {
+            InstigatorSubsystem = Subsystem;
+        }
+    }
     
     // Bind collision events if we have a root primitive
     BindCollisionEvents();
@@ -39,6 +51,12 @@ void UISMPhysicsInstigatorComponent::EndPlay(const EEndPlayReason::Type EndReaso
 {
     // Unbind collision events
     UnbindCollisionEvents();
+
+    if (UISMPhysicsInstigatorSubsystem* Subsystem = InstigatorSubsystem.Get())
+    {
+        Subsystem->UnregisterInstigator(this);
+    }
+    InstigatorSubsystem.Reset();
     
     Super::EndPlay(EndReason);
 }
@@ -71,8 +89,15 @@ void UISMPhysicsInstigatorComponent::TickComponent(float DeltaTime, ELevelTick T
         return;
     }
     
-    // Perform instigator update
-    PerformInstigatorUpdate();
+    // Perform instigator update, or join this frame's shared pass
+    if (UISMPhysicsInstigatorSubsystem* Subsystem = InstigatorSubsystem.Get())
+    {
+        Subsystem->RequestUpdate(this);
+    }
+    else
+    {
+        PerformInstigatorUpdate();
+    }
     
     // Periodically refresh component cache
     if (GFrameCounter - ComponentCacheUpdateFrame > ComponentCacheRefreshInterval)
@@ -101,26 +126,39 @@ void UISMPhysicsInstigatorComponent::TriggerPhysicsAtLocation(FVector WorldLocat
             continue;
         }
         
-        // Query instances within radius
+        if (!PhysicsComponent->CanAnyInstanceConvert(Force))
+        {
+            continue;
+        }
+
+        // Query instances within radius; too-sturdy ones go before the tag filter touches them
         TArray<int32> NearbyInstances = PhysicsComponent->GetInstancesInRadius(WorldLocation, Radius, false);
-        
-        // Try to convert each instance
-        for (int32 InstanceIndex : NearbyInstances)
+        PhysicsComponent->FilterByConversionThreshold(NearbyInstances, Force);
+        NearbyInstances.RemoveAll([this, PhysicsComponent](int32 InstanceIndex)
+            {
+                return !PassesFilter(PhysicsComponent, InstanceIndex);
+            });
+
+        if (PhysicsComponent->bDeferConversions)
         {
-            // Check filter
-            if (!PassesFilter(PhysicsComponent, InstanceIndex))
+            PhysicsComponent->QueueConversions(NearbyInstances, WorldLocation, Force, GetOwner());
+            for (const int32 InstanceIndex : NearbyInstances)
             {
-                continue;
+                if (PhysicsComponent->IsConversionQueued(InstanceIndex))
+                {
+                    OnInstigatorTriggered.Broadcast(PhysicsComponent, InstanceIndex, Force);
+                }
             }
-            
-            // Get instance location for impact point
-            const FVector InstanceLocation = PhysicsComponent->GetInstanceLocation(InstanceIndex);
-            const FVector ImpactNormal = (InstanceLocation - WorldLocation).GetSafeNormal();
-            
-            // Trigger conversion
-            if (PhysicsComponent->ConvertInstanceToPhysics(InstanceIndex, InstanceLocation, ImpactNormal, Force, GetOwner()))
+            continue;
+        }
+
+        // Convert the whole blast radius with one pool request
+        const TArray<AActor*> Converted = PhysicsComponent->ConvertInstancesToPhysics(NearbyInstances, WorldLocation, Force, GetOwner());
+        for (AActor* Actor : Converted)
+        {
+            if (const AISMPhysicsActor* PhysicsActor = Cast<AISMPhysicsActor>(Actor))
             {
-                OnInstigatorTriggered.Broadcast(PhysicsComponent, InstanceIndex, Force);
+                OnInstigatorTriggered.Broadcast(PhysicsComponent, PhysicsActor->GetInstanceHandle().InstanceIndex, Force);
             }
         }
     }
@@ -150,10 +188,8 @@ void UISMPhysicsInstigatorComponent::TriggerSingleInstance(UISMPhysicsComponent*
     const FVector ImpactNormal = (InstanceLocation - OwnerLocation).GetSafeNormal();
     
     // Trigger conversion
-    if (PhysicsComponent->ConvertInstanceToPhysics(InstanceIndex, ImpactPoint, ImpactNormal, Force, GetOwner()))
+    if (RequestConversion(PhysicsComponent, InstanceIndex, ImpactPoint, ImpactNormal, Force))
     {
-        OnInstigatorTriggered.Broadcast(PhysicsComponent, InstanceIndex, Force);
-        
         UE_LOG(LogTemp, Verbose, TEXT("UISMPhysicsInstigatorComponent::TriggerSingleInstance - Triggered instance %d with force %.1f"),
             InstanceIndex, Force);
     }
@@ -183,9 +219,15 @@ void UISMPhysicsInstigatorComponent::PerformInstigatorUpdate()
             continue;
         }
         
-        // Find nearby instances
+        if (!PhysicsComponent->CanAnyInstanceConvert(ImpactForce))
+        {
+            continue;
+        }
+
+        // Find nearby instances, dropping ones too sturdy for this hit before any per-instance work
         TArray<int32> NearbyInstances;
         QueryComponent(PhysicsComponent, NearbyInstances);
+        PhysicsComponent->FilterByConversionThreshold(NearbyInstances, ImpactForce);
         
         // Try to convert nearby instances
         for (int32 InstanceIndex : NearbyInstances)
@@ -207,10 +249,8 @@ void UISMPhysicsInstigatorComponent::PerformInstigatorUpdate()
             const FVector ImpactNormal = CachedVelocity.GetSafeNormal();
             
             // Trigger conversion
-            if (PhysicsComponent->ConvertInstanceToPhysics(InstanceIndex, InstanceLocation, ImpactNormal, ImpactForce, Owner))
+            if (RequestConversion(PhysicsComponent, InstanceIndex, InstanceLocation, ImpactNormal, ImpactForce))
             {
-                OnInstigatorTriggered.Broadcast(PhysicsComponent, InstanceIndex, ImpactForce);
-                
                 UE_LOG(LogTemp, Verbose, TEXT("UISMPhysicsInstigatorComponent::PerformInstigatorUpdate - Converted instance %d (Force: %.1f)"),
                     InstanceIndex, ImpactForce);
             }
@@ -218,6 +258,43 @@ void UISMPhysicsInstigatorComponent::PerformInstigatorUpdate()
     }
 }
 
+void UISMPhysicsInstigatorComponent::HandleEnteredInstances(TConstArrayView<FISMInstanceHandle> EnteredInstances)
+{
+    AActor* Owner = GetOwner();
+    if (!Owner || !bIsEnabled)
+    {
+        return;
+    }
+
+    // Force and direction come from the tick that asked for this update
+    const float ImpactForce = CalculateImpactForce();
+    const FVector ImpactNormal = CachedVelocity.GetSafeNormal();
+
+    for (const FISMInstanceHandle& Handle : EnteredInstances)
+    {
+        UISMPhysicsComponent* PhysicsComponent = Cast<UISMPhysicsComponent>(Handle.Component.Get());
+        if (!PhysicsComponent || !Handle.IsValid())
+        {
+            continue;
+        }
+
+        // Cheap threshold read first; tags can change at runtime, so they are checked here
+        // rather than baked into the subscription
+        if (ImpactForce < PhysicsComponent->GetConversionThreshold(Handle.InstanceIndex)
+            || !PassesFilter(PhysicsComponent, Handle.InstanceIndex))
+        {
+            continue;
+        }
+
+        const FVector InstanceLocation = PhysicsComponent->GetInstanceLocation(Handle.InstanceIndex);
+        if (RequestConversion(PhysicsComponent, Handle.InstanceIndex, InstanceLocation, ImpactNormal, ImpactForce))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("UISMPhysicsInstigatorComponent::HandleEnteredInstances - Converted instance %d (Force: %.1f)"),
+                Handle.InstanceIndex, ImpactForce);
+        }
+    }
+}
+
 void UISMPhysicsInstigatorComponent::RefreshPhysicsComponentsCache()
 {
     CachedPhysicsComponents.Empty();
@@ -286,6 +363,20 @@ void UISMPhysicsInstigatorComponent::QueryComponent(UISMPhysicsComponent* Physic
     OutInstances = PhysicsComponent->GetInstancesInRadius(OwnerLocation, QueryRadius, false);
 }
 
+bool UISMPhysicsInstigatorComponent::RequestConversion(UISMPhysicsComponent* PhysicsComponent, int32 InstanceIndex,
+    const FVector& ImpactPoint, const FVector& ImpactNormal, float Force)
+{
+    const bool bTriggered = PhysicsComponent->bDeferConversions
+        ? PhysicsComponent->QueueConversion(InstanceIndex, ImpactPoint, ImpactNormal, Force, GetOwner())
+        : PhysicsComponent->ConvertInstanceToPhysics(InstanceIndex, ImpactPoint, ImpactNormal, Force, GetOwner()) != nullptr;
+
+    if (bTriggered)
+    {
+        OnInstigatorTriggered.Broadcast(PhysicsComponent, InstanceIndex, Force);
+    }
+    return bTriggered;
+}
+
 float UISMPhysicsInstigatorComponent::CalculateImpactForce() const
 {
     if (!bUseVelocityBasedForce)
@@ -0,0 +1,169 @@
+#include "ISMPhysicsInstigatorSubsystem.h"
+#include "ISMRuntimePhysics.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMPhysicsInstigatorComponent.h"
+#include "ISMPhysicsComponent.h"
+#include "ISMQueryFilter.h"
+#include "Engine/World.h"
+
+bool UISMPhysicsInstigatorSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMPhysicsInstigatorSubsystem::Deinitialize()
+{
+    if (UISMRuntimeSubsystem* Runtime = GetRuntimeSubsystem())
+    {
+        for (const FInstigatorEntry& Entry : Entries)
+        {
+            Runtime->UnsubscribeSphere(Entry.SubscriptionId);
+        }
+    }
+    Entries.Reset();
+    NumPending = 0;
+
+    Super::Deinitialize();
+}
+
+UISMRuntimeSubsystem* UISMPhysicsInstigatorSubsystem::GetRuntimeSubsystem() const
+{
+    UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+}
+
+bool UISMPhysicsInstigatorSubsystem::RegisterInstigator(UISMPhysicsInstigatorComponent* Instigator)
+{
+    if (!Instigator)
+    {
+        return false;
+    }
+
+    if (Entries.ContainsByPredicate([Instigator](const FInstigatorEntry& Entry) { return Entry.Instigator.Get() == Instigator; }))
+    {
+        return true;
+    }
+
+    UISMRuntimeSubsystem* Runtime = GetRuntimeSubsystem();
+    if (!Runtime)
+    {
+        return false;
+    }
+
+    // Only physics components convert; destroyed and already converted instances have nothing to give
+    FISMQueryFilter Filter;
+    Filter.ExcludedStates = { EISMInstanceState::Destroyed, EISMInstanceState::Converting };
+    Filter.CustomFilter = [](const FISMInstanceReference& Instance)
+    {
+        return Cast<UISMPhysicsComponent>(Instance.Component.Get()) != nullptr;
+    };
+
+    FInstigatorEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Instigator = Instigator;
+    Entry.SubscriptionId = Runtime->SubscribeSphere(Instigator->GetComponentLocation(), Instigator->GetQueryRadius(), Filter);
+    return true;
+}
+
+void UISMPhysicsInstigatorSubsystem::UnregisterInstigator(UISMPhysicsInstigatorComponent* Instigator)
+{
+    const int32 Index = Entries.IndexOfByPredicate([Instigator](const FInstigatorEntry& Entry) { return Entry.Instigator.Get() == Instigator; });
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (UISMRuntimeSubsystem* Runtime = GetRuntimeSubsystem())
+    {
+        Runtime->UnsubscribeSphere(Entries[Index].SubscriptionId);
+    }
+
+    // Cleared rather than removed, so a conversion callback unregistering mid-pass is safe
+    Entries[Index].Instigator.Reset();
+    Entries[Index].SubscriptionId = INDEX_NONE;
+}
+
+void UISMPhysicsInstigatorSubsystem::RequestUpdate(UISMPhysicsInstigatorComponent* Instigator)
+{
+    for (FInstigatorEntry& Entry : Entries)
+    {
+        if (Entry.Instigator.Get() == Instigator)
+        {
+            if (!Entry.bUpdatePending)
+            {
+                Entry.bUpdatePending = true;
+                ++NumPending;
+            }
+            return;
+        }
+    }
+}
+
+void UISMPhysicsInstigatorSubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMPhysicsInstigatorSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    if (NumPending == 0)
+    {
+        RemoveStaleEntries();
+        return;
+    }
+
+    UISMRuntimeSubsystem* Runtime = GetRuntimeSubsystem();
+    if (!Runtime)
+    {
+        return;
+    }
+
+    // Index loop: conversions can register new instigators, which only append
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        if (!Entries[Index].bUpdatePending)
+        {
+            continue;
+        }
+        Entries[Index].bUpdatePending = false;
+        --NumPending;
+
+        UISMPhysicsInstigatorComponent* Instigator = Entries[Index].Instigator.Get();
+        if (!Instigator || Entries[Index].SubscriptionId == INDEX_NONE)
+        {
+            continue;
+        }
+
+        if (Runtime->UpdateSphereSubscription(Entries[Index].SubscriptionId, Instigator->GetComponentLocation(),
+            Instigator->GetQueryRadius(), Delta) && Delta.Entered.Num() > 0)
+        {
+            Instigator->HandleEnteredInstances(Delta.Entered);
+        }
+    }
+
+    RemoveStaleEntries();
+}
+
+void UISMPhysicsInstigatorSubsystem::RemoveStaleEntries()
+{
+    UISMRuntimeSubsystem* Runtime = nullptr;
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+    {
+        if (Entries[Index].Instigator.IsValid())
+        {
+            continue;
+        }
+
+        if (Entries[Index].SubscriptionId != INDEX_NONE)
+        {
+            Runtime = Runtime ? Runtime : GetRuntimeSubsystem();
+            if (Runtime)
+            {
+                Runtime->UnsubscribeSphere(Entries[Index].SubscriptionId);
+            }
+        }
+
+        if (Entries[Index].bUpdatePending)
+        {
+            --NumPending;
+        }
+        Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    }
+}
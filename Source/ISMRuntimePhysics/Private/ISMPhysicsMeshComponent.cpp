@@ -0,0 +1,99 @@
+#include "ISMPhysicsMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+
+bool UISMPhysicsMeshComponent::SetCollisionShape(EISMPhysicsCollisionShape Shape)
+{
+    if (Shape == CollisionShape)
+    {
+        return false;
+    }
+    if (Shape != EISMPhysicsCollisionShape::Mesh && !GetPrimitiveBodySetup(Shape))
+    {
+        return false;
+    }
+
+    // Recreating the body drops its velocity; a tier switch mid-flight must not stop the actor
+    const bool bSimulating = IsSimulatingPhysics();
+    const FVector LinearVelocity = bSimulating ? GetPhysicsLinearVelocity() : FVector::ZeroVector;
+    const FVector AngularVelocity = bSimulating ? GetPhysicsAngularVelocityInRadians() : FVector::ZeroVector;
+
+    CollisionShape = Shape;
+
+    if (IsPhysicsStateCreated())
+    {
+        RecreatePhysicsState();
+        if (bSimulating)
+        {
+            SetPhysicsLinearVelocity(LinearVelocity);
+            SetPhysicsAngularVelocityInRadians(AngularVelocity);
+        }
+    }
+    return true;
+}
+
+UBodySetup* UISMPhysicsMeshComponent::GetBodySetup()
+{
+    if (CollisionShape != EISMPhysicsCollisionShape::Mesh)
+    {
+        if (UBodySetup* PrimitiveSetup = GetPrimitiveBodySetup(CollisionShape))
+        {
+            return PrimitiveSetup;
+        }
+    }
+    return Super::GetBodySetup();
+}
+
+bool UISMPhysicsMeshComponent::SetStaticMesh(UStaticMesh* NewMesh)
+{
+    if (NewMesh != GetStaticMesh())
+    {
+        // Fitted to the old bounds; drop them before the base class rebuilds the physics state
+        BoxBodySetup = nullptr;
+        SphereBodySetup = nullptr;
+    }
+    return Super::SetStaticMesh(NewMesh);
+}
+
+UBodySetup* UISMPhysicsMeshComponent::GetPrimitiveBodySetup(EISMPhysicsCollisionShape Shape)
+{
+    TObjectPtr<UBodySetup>& Cached = Shape == EISMPhysicsCollisionShape::Box ? BoxBodySetup : SphereBodySetup;
+    if (Cached)
+    {
+        return Cached;
+    }
+
+    const UStaticMesh* Mesh = GetStaticMesh();
+    if (!Mesh)
+    {
+        return nullptr;
+    }
+
+    const FBox Bounds = Mesh->GetBoundingBox();
+    const FVector Extent = Bounds.GetExtent();
+
+    UBodySetup* Setup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+    Setup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+    Setup->bNeverNeedsCookedCollisionData = true;
+    if (const UBodySetup* MeshSetup = Mesh->GetBodySetup())
+    {
+        Setup->PhysMaterial = MeshSetup->PhysMaterial;
+    }
+
+    if (Shape == EISMPhysicsCollisionShape::Box)
+    {
+        FKBoxElem Box(Extent.X * 2.0f, Extent.Y * 2.0f, Extent.Z * 2.0f);
+        Box.Center = Bounds.GetCenter();
+        Setup->AggGeom.BoxElems.Add(Box);
+    }
+    else
+    {
+        FKSphereElem Sphere(Extent.GetMax());
+        Sphere.Center = Bounds.GetCenter();
+        Setup->AggGeom.SphereElems.Add(Sphere);
+    }
+    Setup->CreatePhysicsMeshes();
+
+    Cached = Setup;
+    return Setup;
+}
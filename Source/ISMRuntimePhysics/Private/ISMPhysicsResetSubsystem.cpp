@@ -0,0 +1,126 @@
+#include "ISMPhysicsResetSubsystem.h"
+#include "ISMRuntimePhysics.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMPhysicsResetTrigger.h"
+#include "ISMPhysicsActor.h"
+#include "ISMPhysicsComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "Engine/World.h"
+
+bool UISMPhysicsResetSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMPhysicsResetSubsystem::RegisterTrigger(AISMPhysicsResetTrigger* Trigger)
+{
+    if (!Trigger)
+    {
+        return;
+    }
+
+    const bool bRegistered = Entries.ContainsByPredicate([Trigger](const FTriggerEntry& Entry) { return Entry.Trigger.Get() == Trigger; });
+    if (!bRegistered)
+    {
+        FTriggerEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Trigger = Trigger;
+    }
+}
+
+void UISMPhysicsResetSubsystem::UnregisterTrigger(AISMPhysicsResetTrigger* Trigger)
+{
+    Entries.RemoveAllSwap([Trigger](const FTriggerEntry& Entry) { return Entry.Trigger.Get() == Trigger; }, EAllowShrinking::No);
+}
+
+void UISMPhysicsResetSubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMPhysicsResetSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    struct FDueTrigger
+    {
+        AISMPhysicsResetTrigger* Trigger;
+        FTransform WorldToBox;
+        FVector Extent;
+    };
+    TArray<FDueTrigger, TInlineAllocator<8>> Due;
+
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+    {
+        FTriggerEntry& Entry = Entries[Index];
+        AISMPhysicsResetTrigger* Trigger = Entry.Trigger.Get();
+        if (!Trigger)
+        {
+            Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+            continue;
+        }
+
+        Entry.PendingDeltaTime += DeltaTime;
+        if (Entry.PendingDeltaTime < Trigger->SweepInterval)
+        {
+            continue;
+        }
+        Entry.PendingDeltaTime = 0.0f;
+
+        // Resolved per sweep so moving or rescaled volumes stay correct
+        FTransform WorldToBox;
+        FVector Extent;
+        if (Trigger->GetSweepBox(WorldToBox, Extent))
+        {
+            Due.Add({ Trigger, WorldToBox, Extent });
+        }
+    }
+
+    if (Due.Num() == 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    UISMRuntimeSubsystem* RuntimeSubsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+    if (!RuntimeSubsystem)
+    {
+        return;
+    }
+
+    ActorScratch.Reset();
+    for (UISMRuntimeComponent* Component : RuntimeSubsystem->GetAllComponents())
+    {
+        if (const UISMPhysicsComponent* PhysicsComponent = Cast<UISMPhysicsComponent>(Component))
+        {
+            PhysicsComponent->AppendActivePhysicsActors(ActorScratch);
+        }
+    }
+
+    // Collect first: a reset returns the actor, which edits the owner's active set
+    TArray<TPair<AISMPhysicsResetTrigger*, AISMPhysicsActor*>, TInlineAllocator<16>> ToReset;
+    for (AActor* Actor : ActorScratch)
+    {
+        AISMPhysicsActor* PhysicsActor = Cast<AISMPhysicsActor>(Actor);
+        if (!PhysicsActor)
+        {
+            continue;
+        }
+
+        const FVector Location = PhysicsActor->GetActorLocation();
+        for (const FDueTrigger& Item : Due)
+        {
+            const FVector Local = Item.WorldToBox.TransformPosition(Location);
+            if (FMath::Abs(Local.X) <= Item.Extent.X && FMath::Abs(Local.Y) <= Item.Extent.Y && FMath::Abs(Local.Z) <= Item.Extent.Z)
+            {
+                ToReset.Emplace(Item.Trigger, PhysicsActor);
+                break;
+            }
+        }
+    }
+
+    for (const TPair<AISMPhysicsResetTrigger*, AISMPhysicsActor*>& Pair : ToReset)
+    {
+        Pair.Key->TryResetActor(Pair.Value);
+    }
+}
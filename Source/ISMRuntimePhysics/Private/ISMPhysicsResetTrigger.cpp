@@ -1,5 +1,6 @@
 #include "ISMPhysicsResetTrigger.h"
 #include "ISMPhysicsActor.h"
+#include "ISMPhysicsResetSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "GameplayTagContainer.h"
 #include "ISMInstanceHandle.h"
@@ -34,31 +35,74 @@ AISMPhysicsResetTrigger::AISMPhysicsResetTrigger()
 #endif
 }
 
-// ===== Overlap Events =====
-
-void AISMPhysicsResetTrigger::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AISMPhysicsResetTrigger::BeginPlay()
 {
-    if (!OtherActor)
+    Super::BeginPlay();
+
+    if (ResetMode != EISMResetTriggerMode::BoundsSweep)
     {
         return;
     }
-    
-    // Check if this is a physics actor
-    AISMPhysicsActor* PhysicsActor = Cast<AISMPhysicsActor>(OtherActor);
-    if (!PhysicsActor)
+
+    // The box only defines the volume now; keep it out of the broadphase entirely
+    if (TriggerVolume)
     {
-        return;
+        TriggerVolume->SetGenerateOverlapEvents(false);
+        TriggerVolume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     }
-    
-    // Check if we should reset this actor
-    if (!ShouldResetActor(PhysicsActor))
+
+    if (UISMPhysicsResetSubsystem* ResetSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UISMPhysicsResetSubsystem>() : nullptr)
+    {
+        ResetSubsystem->RegisterTrigger(this);
+    }
+}
+
+void AISMPhysicsResetTrigger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UISMPhysicsResetSubsystem* ResetSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UISMPhysicsResetSubsystem>() : nullptr)
+    {
+        ResetSubsystem->UnregisterTrigger(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+bool AISMPhysicsResetTrigger::TryResetActor(AISMPhysicsActor* PhysicsActor)
+{
+    if (!PhysicsActor || !ShouldResetActor(PhysicsActor))
+    {
+        return false;
+    }
+
+    ResetPhysicsActor(PhysicsActor);
+    return true;
+}
+
+bool AISMPhysicsResetTrigger::GetSweepBox(FTransform& OutWorldToBox, FVector& OutExtent) const
+{
+    if (!TriggerVolume)
+    {
+        return false;
+    }
+
+    // Scale stays in the transform so the unscaled extent is compared in box space
+    OutWorldToBox = TriggerVolume->GetComponentTransform().Inverse();
+    OutExtent = TriggerVolume->GetUnscaledBoxExtent();
+    return true;
+}
+
+// ===== Overlap Events =====
+
+void AISMPhysicsResetTrigger::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+    if (!OtherActor)
     {
         return;
     }
     
-    // Reset the actor
-    ResetPhysicsActor(PhysicsActor);
+    // Only physics actors are reset
+    TryResetActor(Cast<AISMPhysicsActor>(OtherActor));
 }
 
 bool AISMPhysicsResetTrigger::ShouldResetActor(AActor* Actor) const
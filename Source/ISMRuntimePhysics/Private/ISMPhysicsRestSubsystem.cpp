@@ -0,0 +1,148 @@
+#include "ISMPhysicsRestSubsystem.h"
+#include "ISMRuntimePhysics.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMPhysicsActor.h"
+#include "ISMPhysicsDataAsset.h"
+#include "Components/StaticMeshComponent.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+bool UISMPhysicsRestSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UISMPhysicsRestSubsystem::RegisterActor(AISMPhysicsActor* Actor)
+{
+    if (!Actor)
+    {
+        return false;
+    }
+
+    if (Actor->RestPassIndex == INDEX_NONE)
+    {
+        Actor->RestPassIndex = Entries.Num();
+        FRestEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Actor = Actor;
+    }
+    return true;
+}
+
+void UISMPhysicsRestSubsystem::UnregisterActor(AISMPhysicsActor* Actor)
+{
+    if (!Actor || !Entries.IsValidIndex(Actor->RestPassIndex) || Entries[Actor->RestPassIndex].Actor.Get() != Actor)
+    {
+        return;
+    }
+
+    RemoveEntryAt(Actor->RestPassIndex);
+}
+
+void UISMPhysicsRestSubsystem::RemoveEntryAt(int32 Index)
+{
+    if (AISMPhysicsActor* Removed = Entries[Index].Actor.Get())
+    {
+        Removed->RestPassIndex = INDEX_NONE;
+    }
+
+    Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Entries.IsValidIndex(Index))
+    {
+        if (AISMPhysicsActor* Moved = Entries[Index].Actor.Get())
+        {
+            Moved->RestPassIndex = Index;
+        }
+    }
+}
+
+void UISMPhysicsRestSubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMPhysicsRestSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Physics);
+
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    FVector CameraLocation = FVector::ZeroVector;
+    if (APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr)
+    {
+        if (APlayerCameraManager* CameraManager = PC->PlayerCameraManager)
+        {
+            CameraLocation = CameraManager->GetCameraLocation();
+        }
+    }
+
+    struct FDueActor
+    {
+        AISMPhysicsActor* Actor;
+        float DeltaTime;
+        float LinearSpeed;
+        float AngularSpeed;
+    };
+    TArray<FDueActor, TInlineAllocator<64>> Due;
+
+    // Pick the actors due this frame; reversed so removing a destroyed actor never skips one
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+    {
+        FRestEntry& Entry = Entries[Index];
+        AISMPhysicsActor* Actor = Entry.Actor.Get();
+        if (!Actor)
+        {
+            RemoveEntryAt(Index);
+            continue;
+        }
+
+        Entry.PendingDeltaTime += DeltaTime;
+
+        float Interval = 0.0f;
+        if (const UISMPhysicsDataAsset* Data = Actor->PhysicsData.Get())
+        {
+            const float FarDistance = Data->DistantRestCheckDistance;
+            if (FarDistance > 0.0f && FVector::DistSquared(Actor->GetActorLocation(), CameraLocation) > FMath::Square(FarDistance))
+            {
+                Interval = Data->DistantRestCheckInterval;
+            }
+        }
+
+        if (Entry.PendingDeltaTime >= Interval)
+        {
+            Due.Add({ Actor, Entry.PendingDeltaTime, 0.0f, 0.0f });
+            Entry.PendingDeltaTime = 0.0f;
+        }
+    }
+
+    if (Due.Num() == 0)
+    {
+        return;
+    }
+
+    // One scene lock for every velocity read instead of one per component call
+    FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr;
+    FPhysicsCommand::ExecuteRead(PhysScene, [&Due]()
+        {
+            for (FDueActor& Item : Due)
+            {
+                const UStaticMeshComponent* Mesh = Item.Actor->MeshComponent;
+                const FBodyInstance* Body = Mesh ? Mesh->GetBodyInstance() : nullptr;
+                if (!Body || !FPhysicsInterface::IsValid(Body->GetPhysicsActorHandle()))
+                {
+                    continue;
+                }
+
+                const FPhysicsActorHandle& Handle = Body->GetPhysicsActorHandle();
+                Item.LinearSpeed = FPhysicsInterface::GetLinearVelocity_AssumesLocked(Handle).Size();
+                Item.AngularSpeed = FPhysicsInterface::GetAngularVelocity_AssumesLocked(Handle).Size();
+            }
+        });
+
+    // Outside the lock: a settled actor returns to its pool here, which may unregister it
+    for (const FDueActor& Item : Due)
+    {
+        Item.Actor->TickRestDetection(Item.DeltaTime, Item.LinearSpeed, Item.AngularSpeed);
+    }
+}
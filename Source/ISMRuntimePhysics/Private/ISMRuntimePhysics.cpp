@@ -1,5 +1,7 @@
 #include "ISMRuntimePhysics.h"
 
+LLM_DEFINE_TAG(ISMRuntime_Physics);
+
 #define LOCTEXT_NAMESPACE "FISMRuntimePhysicsModule"
 
 void FISMRuntimePhysics::StartupModule()
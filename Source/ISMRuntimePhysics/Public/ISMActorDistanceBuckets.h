@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+/**
+ * Active actors bucketed into rings of fixed width around a reference point (the camera).
+ *
+ * Distances are cached per actor and refreshed a few actors at a time, so farthest-first
+ * eviction and distance culling read the outermost rings instead of measuring every actor.
+ * The cached distance of an actor is at most one full refresh sweep old.
+ *
+ * Entries are dense with swap removal; each bucket lists entry indices and each entry knows
+ * its slot in its bucket, so add, remove and re-bucketing are O(1).
+ */
+class ISMRUNTIMEPHYSICS_API FISMActorDistanceBuckets
+{
+public:
+    /** Ring width (cm) and ring count; the last ring holds everything beyond. Clears the set. */
+    void Configure(float InBucketSize, int32 InNumBuckets);
+
+    /**
+     * Track an actor at the given distance. Returns false if it was already tracked, in which
+     * case its distance and activation order are refreshed instead.
+     */
+    bool Add(AActor* Actor, float Distance);
+
+    /** Stop tracking an actor. Returns false if it was not tracked. */
+    bool Remove(const AActor* Actor);
+
+    bool Contains(const AActor* Actor) const { return EntryByActor.Contains(Actor); }
+
+    int32 Num() const { return Entries.Num(); }
+
+    bool IsEmpty() const { return Entries.IsEmpty(); }
+
+    void Reset();
+
+    /**
+     * Re-measure up to MaxEntries actors, continuing where the previous call stopped.
+     * Actors for which IsLive returns false (destroyed, returned, reassigned) are dropped.
+     *
+     * @param MaxEntries - Entries to visit; <= 0 visits all
+     * @param Reference - Point distances are measured from
+     * @param IsLive - Callable (AActor&) -> bool
+     */
+    template<typename LiveFn>
+    void Refresh(int32 MaxEntries, const FVector& Reference, LiveFn&& IsLive)
+    {
+        Refresh(MaxEntries, Reference, Forward<LiveFn>(IsLive), [](AActor&, float) {});
+    }
+
+    /**
+     * As above, and hands every live actor's new distance to OnMeasured so per-distance state
+     * (collision LOD) rides the same sweep instead of measuring again.
+     *
+     * @param OnMeasured - Callable (AActor&, float Distance) -> void
+     */
+    template<typename LiveFn, typename MeasuredFn>
+    void Refresh(int32 MaxEntries, const FVector& Reference, LiveFn&& IsLive, MeasuredFn&& OnMeasured)
+    {
+        const int32 NumToVisit = MaxEntries > 0 ? FMath::Min(MaxEntries, Entries.Num()) : Entries.Num();
+        for (int32 Visited = 0; Visited < NumToVisit && Entries.Num() > 0; ++Visited)
+        {
+            if (RefreshCursor >= Entries.Num())
+            {
+                RefreshCursor = 0;
+            }
+
+            AActor* Actor = Entries[RefreshCursor].Actor.Get();
+            if (!Actor || !IsLive(*Actor))
+            {
+                // The last entry moves into the cursor's slot, so visit it next without advancing
+                RemoveAt(RefreshCursor);
+                continue;
+            }
+
+            const float Distance = FVector::Dist(Actor->GetActorLocation(), Reference);
+            SetDistance(RefreshCursor, Distance);
+            ++RefreshCursor;
+            OnMeasured(*Actor, Distance);
+        }
+    }
+
+    /** Remove and return up to Count actors, farthest rings first */
+    int32 PopFarthest(int32 Count, TArray<AActor*>& OutActors);
+
+    /** Remove and return up to Count actors, earliest added first */
+    int32 PopOldest(int32 Count, TArray<AActor*>& OutActors);
+
+    /** Remove and return every actor whose cached distance exceeds MaxDistance */
+    int32 PopBeyond(float MaxDistance, TArray<AActor*>& OutActors);
+
+    /** Every tracked actor that is still valid, in no particular order */
+    void GetActors(TArray<AActor*>& OutActors) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+
+        /** Key in EntryByActor; kept raw so a stale entry can still be unmapped */
+        const AActor* Key = nullptr;
+
+        float Distance = 0.0f;
+        int32 Bucket = 0;
+        int32 BucketSlot = 0;
+
+        /** Monotonic add order, for oldest-first eviction */
+        uint64 AddOrder = 0;
+    };
+
+    int32 BucketFor(float Distance) const;
+    void SetDistance(int32 EntryIndex, float Distance);
+    void LinkToBucket(int32 EntryIndex, int32 Bucket);
+    void UnlinkFromBucket(int32 EntryIndex);
+    void RemoveAt(int32 EntryIndex);
+
+    TArray<FEntry> Entries;
+    TArray<TArray<int32>> Buckets;
+    TMap<const AActor*, int32> EntryByActor;
+
+    float BucketSize = 1000.0f;
+    int32 RefreshCursor = 0;
+    uint64 NextAddOrder = 0;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Batching/ISMBatchTransformer.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Tuning for ballistic lite motion, copied out of UISMPhysicsDataAsset on the game thread
+ * so ProcessChunk never reads the asset.
+ */
+struct FISMBallisticSettings
+{
+    /** World gravity (cm/s^2, negative is down) */
+    float GravityZ = -980.0f;
+
+    /** Fraction of vertical speed kept when bouncing off the ground */
+    float Restitution = 0.3f;
+
+    /** Fraction of horizontal speed kept per bounce */
+    float GroundFriction = 0.5f;
+
+    /** Vertical speed (cm/s) below which a bounce ends the flight */
+    float SettleSpeed = 50.0f;
+
+    /** Seconds after launch at which an instance is put down wherever it is */
+    float MaxFlightTime = 5.0f;
+};
+
+/** Flight state of one launched instance. Plain data, only touched under the transformer's lock. */
+struct FISMBallisticInstanceState
+{
+    FVector Location = FVector::ZeroVector;
+    FQuat Rotation = FQuat::Identity;
+    FVector Scale = FVector::OneVector;
+
+    /** Rotation the instance was placed with, restored when it settles */
+    FQuat RestRotation = FQuat::Identity;
+
+    FVector Velocity = FVector::ZeroVector;
+
+    /** World-space spin axis scaled by rad/s */
+    FVector AngularVelocity = FVector::ZeroVector;
+
+    /** Height it was resting at before launch; the ground plane it lands back on */
+    double GroundZ = 0.0;
+
+    double LaunchTime = 0.0;
+    double LastStepTime = 0.0;
+};
+
+/**
+ * Batch transformer behind UISMPhysicsComponent's ballistic lite conversions.
+ *
+ * Launched instances never get an actor or a rigid body: each scheduler cycle integrates
+ * gravity on the instance transform, bounces it off the height it was launched from and,
+ * once it settles or runs out of flight time, writes its final transform and forgets it.
+ * Ground is a flat plane at the launch height - there are no traces - which suits small
+ * cosmetic debris on open ground far from the camera.
+ *
+ * Threading:
+ *   - Launch, UpdateFrameParams and BuildRequest run on the game thread
+ *   - ProcessChunk steps the instances of its chunk under StateLock; frame params are read
+ *     under the same lock, since a chunk may still run when the next frame updates them
+ *   - Each instance is stepped by the world time since it was last stepped, so cycles the
+ *     scheduler defers or skips do not slow the flight down
+ *
+ * Lifetime:
+ *   Owned by UISMPhysicsComponent as a TSharedPtr, created on the first launch and
+ *   unregistered from the scheduler before destruction.
+ */
+class ISMRUNTIMEPHYSICS_API FISMBallisticTransformer : public IISMBatchTransformer
+{
+public:
+    FISMBallisticTransformer(UISMRuntimeComponent* InTargetComponent, FName InTransformerName);
+
+    // ===== IISMBatchTransformer =====
+
+    virtual FName GetTransformerName() const override { return TransformerName; }
+
+    /** Dirty while any instance is in flight */
+    virtual bool IsDirty() const override;
+    virtual void ClearDirty() override {}
+
+    /**
+     * Writes transforms only - flight state lives here, not in the snapshot.
+     * Spatial bounds: the box around every in-flight instance, so idle cells are not snapshotted.
+     */
+    virtual FISMSnapshotRequest BuildRequest() override;
+
+    /** Steps in-flight instances of the chunk and emits their transforms. Background thread safe. */
+    virtual void ProcessChunk(FISMBatchSnapshot Chunk, FISMMutationHandle Handle) override;
+
+    // ===== Game Thread API =====
+
+    /**
+     * Start flying an instance. Restarts the flight if it is already airborne.
+     *
+     * @param InstanceIndex - Instance to launch
+     * @param RestTransform - Its current transform; its height becomes the ground plane
+     * @param Velocity - Launch velocity (cm/s)
+     * @param AngularVelocity - Spin axis scaled by rad/s
+     */
+    void Launch(int32 InstanceIndex, const FTransform& RestTransform, const FVector& Velocity, const FVector& AngularVelocity);
+
+    /**
+     * Stop flying an instance, e.g. because a full physics actor takes it over.
+     * Returns false if it was not in flight; otherwise OutTransform is where it currently is.
+     */
+    bool Land(int32 InstanceIndex, FTransform& OutTransform);
+
+    /** Called by UISMPhysicsComponent each tick before the scheduler dispatches */
+    void UpdateFrameParams(double InWorldTime, const FISMBallisticSettings& InSettings);
+
+    bool IsInFlight(int32 InstanceIndex) const;
+
+    int32 GetInFlightCount() const;
+
+private:
+    /**
+     * Advance one instance to the given time. Returns true once it has settled, with the
+     * state holding its final transform.
+     */
+    static bool StepInstance(FISMBallisticInstanceState& State, double WorldTime, const FISMBallisticSettings& InSettings);
+
+    TWeakObjectPtr<UISMRuntimeComponent> TargetComponent;
+    FName TransformerName;
+
+    /** Written by UpdateFrameParams; everything below is guarded by StateLock */
+    double WorldTime = 0.0;
+    FISMBallisticSettings Settings;
+
+    TMap<int32, FISMBallisticInstanceState> InFlight;
+    mutable FCriticalSection StateLock;
+};
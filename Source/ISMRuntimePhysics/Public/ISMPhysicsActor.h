@@ -179,6 +179,17 @@ public:
      */
     void ApplyVisualSettings(UISMPhysicsDataAsset* PhysicsData);
 
+    /**
+     * Re-evaluate the data asset's collision LOD for the given camera distance and switch
+     * between full and simplified collision if the actor crossed the threshold.
+     */
+    void UpdateCollisionLOD(float CameraDistance);
+
+    /** Switch between full and simplified collision. Simplifying is a no-op without collision LOD. */
+    void SetSimplifiedCollision(bool bSimplified);
+
+    bool IsUsingSimplifiedCollision() const { return bSimplifiedCollision; }
+
 
 #pragma endregion
 
@@ -250,6 +261,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Physics")
     void ReturnToISM();
 
+    /**
+     * Run one rest detection step from already sampled velocities: switch kinematic state if
+     * needed, track rest time and return to ISM once settled. Called from Tick, or by
+     * UISMPhysicsRestSubsystem when the actor is in the batched pass.
+     *
+     * @param DeltaTime - Time since the previous step
+     * @param LinearSpeed - Linear velocity magnitude (cm/s)
+     * @param AngularSpeed - Angular velocity magnitude (rad/s)
+     */
+    void TickRestDetection(float DeltaTime, float LinearSpeed, float AngularSpeed);
+
     UFUNCTION(BlueprintNativeEvent, Category = "ISM Physics")
     bool CanReturnToISM(FString& Reason) const;
 
@@ -275,6 +297,12 @@ public:
      */
     void PlayReturnFeedback();
 
+    /**
+     * The owner already fired this actor's return feedback as part of a batch; the next
+     * pool return skips PlayReturnFeedback. Cleared by that return.
+     */
+    void MarkReturnFeedbackHandled() { bReturnFeedbackHandled = true; }
+
 
 	void PlayDestructionFeedback();
 
@@ -320,7 +348,11 @@ public:
 
 
 
-        void SetInstanceHandle(const struct FISMInstanceHandle& Handle);
+        /**
+         * Take over Handle and mark it converted to this actor. Batch conversions pass
+         * bApplyMaterials false and apply every actor's materials in one pass afterwards.
+         */
+        void SetInstanceHandle(const struct FISMInstanceHandle& Handle, bool bApplyMaterials = true);
 
 
         /**
@@ -363,6 +395,12 @@ protected:
     UPROPERTY()
     TWeakObjectPtr<UISMPhysicsDataAsset> PhysicsData;
 
+    /**
+     * Data asset the actor was last configured from. Survives returns so a shared proxy pool
+     * actor can tell when the next request is for a different variant.
+     */
+    TWeakObjectPtr<UISMPhysicsDataAsset> LastConfiguredData;
+
     /** Time spent at rest (below velocity threshold) */
     float TimeAtRest = 0.0f;
 
@@ -372,6 +410,46 @@ protected:
     /** Time when actor was requested from pool (for lifetime tracking) */
     double TimeActivated = 0.0;
 
+    /** Index in UISMPhysicsRestSubsystem while in the batched rest pass, INDEX_NONE otherwise */
+    int32 RestPassIndex = INDEX_NONE;
+    friend class UISMPhysicsRestSubsystem;
+
+    /** Join the batched rest pass if the data asset asks for it. Returns true if joined. */
+    bool JoinRestPass();
+
+    /** Leave the batched rest pass, if in it */
+    void LeaveRestPass();
+
+    /** Set by MarkReturnFeedbackHandled; one-shot return feedback was sent in a batch */
+    bool bReturnFeedbackHandled = false;
+
+    /** Currently using the data asset's far collision tier */
+    bool bSimplifiedCollision = false;
+
+    /** Waiting for the body's sleep event rather than polling velocity */
+    bool bWaitingForSleep = false;
+
+    /** Fires StartRestPolling if the body stays awake past SleepFallbackTimeout */
+    FTimerHandle SleepFallbackTimer;
+
+    /**
+     * Start rest detection for a freshly requested actor: wait for the sleep event, or join the
+     * batched rest pass. Returns false if neither applies and the actor must tick to poll.
+     */
+    bool BeginRestDetection();
+
+    /** Wait for the body's sleep event if the data asset asks for it. Returns true if waiting. */
+    bool WaitForSleep();
+
+    /** Stop waiting for the sleep event, if waiting */
+    void StopWaitingForSleep();
+
+    /** Fallback from the sleep event to velocity polling, batched if possible */
+    void StartRestPolling();
+
+    UFUNCTION()
+    void OnMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
     // ===== Helper Functions =====
 
     /**
@@ -382,11 +460,12 @@ protected:
 
     /**
      * Update resting detection.
-     * Called each tick to track rest duration.
+     * Called each rest detection step to track rest duration.
      *
-     * @param DeltaTime - Time since last tick
+     * @param DeltaTime - Time since the previous step
+     * @param bAtRest - Velocities sampled this step are below the thresholds
      */
-    void UpdateRestingDetection(float DeltaTime);
+    void UpdateRestingDetection(float DeltaTime, bool bAtRest);
 
     /**
      * Check if velocity is below threshold for resting.
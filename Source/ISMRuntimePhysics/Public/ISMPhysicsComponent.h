@@ -2,12 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "ISMRuntimeComponent.h"
+#include "ISMActorDistanceBuckets.h"
 #include "ISMPhysicsComponent.generated.h"
 
 // Forward declarations
 class UISMPhysicsDataAsset;
 class UISMRuntimePoolSubsystem;
 class AISMPhysicsActor;
+class UISMBatchSchedulerBase;
+class FISMBallisticTransformer;
+struct FISMBallisticSettings;
 
 /**
  * Query mode for detecting physics conversions.
@@ -38,6 +42,19 @@ enum class EActorOverflowBehavior : uint8
     ReturnFarthest  UMETA(DisplayName = "Return Farthest")
 };
 
+/**
+ * Order in which queued conversions are turned into actors.
+ */
+UENUM(BlueprintType)
+enum class EISMConversionQueuePriority : uint8
+{
+    /** Hardest impacts first */
+    ImpactForce     UMETA(DisplayName = "Impact Force"),
+
+    /** Instances nearest the player camera first */
+    CameraDistance  UMETA(DisplayName = "Camera Distance")
+};
+
 /**
  * Runtime component for managing physics-enabled ISM instances.
  * Extends UISMRuntimeComponent with physics conversion capabilities.
@@ -48,6 +65,7 @@ enum class EActorOverflowBehavior : uint8
  * - Performance limiters (distance, count, lifetime)
  * - Automatic return to ISM when actors settle
  * - Integration with pool subsystem for zero allocations
+ * - Ballistic lite debris for distant impacts (no actor, flown by the batch scheduler)
  * 
  * Usage:
  * 1. Attach to actor with ISM component
@@ -70,7 +88,7 @@ public:
     
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndReason) override;
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void TickRuntime(float DeltaTime) override;
 
     // ===== Configuration =====
     
@@ -143,6 +161,84 @@ public:
               Tooltip="Check limits every N frames. Higher = better performance."))
     int32 LimiterCheckInterval = 30;
 
+    /**
+     * Width (cm) of the camera distance rings active actors are bucketed into.
+     * Farthest-first eviction and distance culling only look at the outer rings.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics|Performance",
+        meta=(ClampMin="100.0", UIMin="100.0", UIMax="10000.0",
+              Tooltip="Width (cm) of the distance rings used for eviction and distance culling."))
+    float DistanceBucketSize = 1000.0f;
+
+    /**
+     * Active actors whose camera distance is re-measured per tick, round robin.
+     * Cached distances are at most ActiveActors / DistanceRefreshPerTick ticks old. 0 = all.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Performance",
+        meta=(ClampMin="0", UIMin="0", UIMax="256",
+              Tooltip="Actors re-measured per tick for distance rings. 0 = all every tick."))
+    int32 DistanceRefreshPerTick = 16;
+
+    // ===== Conversion Queue =====
+
+    /**
+     * Instigators queue their conversions here instead of spawning actors in the impact frame,
+     * and the queue is worked off MaxConversionsPerFrame at a time.
+     * ConvertInstanceToPhysics itself always converts immediately.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Conversion Queue")
+    bool bDeferConversions = false;
+
+    /** Queued conversions turned into actors per tick */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Conversion Queue",
+        meta=(ClampMin="1", UIMin="1", UIMax="64"))
+    int32 MaxConversionsPerFrame = 8;
+
+    /** Which queued conversions get their actors first */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Conversion Queue")
+    EISMConversionQueuePriority ConversionQueuePriority = EISMConversionQueuePriority::ImpactForce;
+
+    /**
+     * Start queued instances flying as ballistic lite debris right away, so the impact reads on
+     * the frame it happened. The actor takes over from wherever the flight has got to.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Conversion Queue")
+    bool bBallisticStandIn = true;
+
+    /**
+     * Queue one instance for conversion. Instances beyond BallisticLiteDistance are launched as
+     * ballistic lite at once instead of queuing.
+     *
+     * @return True if queued (or already queued) or launched; false if it fails the usual checks
+     */
+    UFUNCTION(BlueprintCallable, Category = "Physics|Conversion Queue")
+    bool QueueConversion(int32 InstanceIndex, FVector ImpactPoint, FVector ImpactNormal,
+        float ImpactForce, AActor* Instigator = nullptr);
+
+    /**
+     * Queue several instances pushed away from one impact origin, as ConvertInstancesToPhysics
+     * would. Instances of one call that come out of the queue together share one pool request.
+     *
+     * @return Number of instances queued or launched
+     */
+    UFUNCTION(BlueprintCallable, Category = "Physics|Conversion Queue")
+    int32 QueueConversions(const TArray<int32>& InstanceIndices, FVector ImpactOrigin,
+        float ImpactForce, AActor* Instigator = nullptr);
+
+    /** Convert everything still queued now, ignoring MaxConversionsPerFrame */
+    UFUNCTION(BlueprintCallable, Category = "Physics|Conversion Queue")
+    void FlushConversionQueue();
+
+    /** Drop everything still queued; stand-ins finish their flight and stay in the ISM */
+    UFUNCTION(BlueprintCallable, Category = "Physics|Conversion Queue")
+    void CancelQueuedConversions();
+
+    UFUNCTION(BlueprintPure, Category = "Physics|Conversion Queue")
+    int32 GetQueuedConversionCount() const { return ConversionQueue.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Physics|Conversion Queue")
+    bool IsConversionQueued(int32 InstanceIndex) const { return QueuedConversionIndices.Contains(InstanceIndex); }
+
     // ===== Conversion Management =====
     
     /**
@@ -158,10 +254,52 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Physics")
     AActor* ConvertInstanceToPhysics(int32 InstanceIndex, FVector ImpactPoint, FVector ImpactNormal, 
         float ImpactForce, AActor* Instigator = nullptr);
+
+    /**
+     * Convert several instances to physics actors with one pool request.
+     * Each instance is pushed away from ImpactOrigin, impacted at its own location. Fires
+     * OnPhysicsConversionBatch once instead of OnPhysicsConversion per instance.
+     *
+     * @param InstanceIndices - Instances to convert; ones failing the usual checks are skipped
+     * @param ImpactOrigin - Center of the impact (e.g. an explosion)
+     * @param ImpactForce - Magnitude of impact force
+     * @param Instigator - Actor that caused the impact (can be null)
+     * @return The spawned physics actors
+     */
+    UFUNCTION(BlueprintCallable, Category = "Physics")
+    TArray<AActor*> ConvertInstancesToPhysics(const TArray<int32>& InstanceIndices, FVector ImpactOrigin,
+        float ImpactForce, AActor* Instigator = nullptr);
+
+    /**
+     * Throw instances as ballistic lite debris: they fly on their ISM transform, bounce on the
+     * height they were resting at and settle there, with no actor or rigid body involved.
+     * Ignores BallisticLiteDistance and the actor limiters; the force threshold still applies and
+     * instances already converted to actors are skipped.
+     * ConvertInstancesToPhysics calls this for instances beyond BallisticLiteDistance.
+     *
+     * @param InstanceIndices - Instances to launch
+     * @param ImpactOrigin - Center of the impact; instances are thrown away from it
+     * @param ImpactForce - Impulse magnitude, divided by the data asset's Mass (1 kg when auto)
+     * @return Number of instances launched
+     */
+    UFUNCTION(BlueprintCallable, Category = "Physics|Ballistic")
+    int32 LaunchInstancesBallistic(const TArray<int32>& InstanceIndices, FVector ImpactOrigin, float ImpactForce);
+
+    /** Whether an instance is currently flying as ballistic lite debris */
+    UFUNCTION(BlueprintPure, Category = "Physics|Ballistic")
+    bool IsInstanceInBallisticFlight(int32 InstanceIndex) const;
+
+    /** Number of instances currently flying as ballistic lite debris */
+    UFUNCTION(BlueprintPure, Category = "Physics|Ballistic")
+    int32 GetBallisticInstanceCount() const;
     
     /**
      * Return all converted actors back to ISM.
-     * Useful for cleanup or reset.
+     * Useful for cleanup or reset. Done as one batch: one bulk transform write, one return
+     * feedback and one pool return for all actors.
+     *
+     * @param bUpdateTransforms - Move instances to where their actors ended up; false restores
+     *                            them where they were before conversion
      */
     UFUNCTION(BlueprintCallable, Category = "Physics")
     void ReturnAllToISM(bool bUpdateTransforms = true);
@@ -177,6 +315,9 @@ public:
      */
     UFUNCTION(BlueprintPure, Category = "Physics")
     int32 GetActivePhysicsActorCount() const { return ActivePhysicsActors.Num(); }
+
+    /** Append the active physics actors to OutActors without allocating a new array */
+    void AppendActivePhysicsActors(TArray<AActor*>& OutActors) const { ActivePhysicsActors.GetActors(OutActors); }
     
     /**
      * Check if at max concurrent actors limit.
@@ -184,6 +325,14 @@ public:
     UFUNCTION(BlueprintPure, Category = "Physics")
     bool IsAtMaxConcurrentActors() const;
     
+    /** MaxConcurrentActors scaled by the active performance profile; 0 is unlimited */
+    UFUNCTION(BlueprintPure, Category = "Physics")
+    int32 GetEffectiveMaxConcurrentActors() const;
+    
+    /** MaxSimulationDistance scaled by the active performance profile; 0 is unlimited */
+    UFUNCTION(BlueprintPure, Category = "Physics")
+    float GetEffectiveMaxSimulationDistance() const;
+    
     /**
      * Check if conversion should be allowed based on limiters.
      * 
@@ -193,6 +342,29 @@ public:
      */
     bool ShouldAllowConversion(int32 InstanceIndex, float ImpactForce) const;
 
+    /** Force an impact needs to convert an instance, read from the precomputed threshold table */
+    UFUNCTION(BlueprintPure, Category = "Physics")
+    float GetConversionThreshold(int32 InstanceIndex) const;
+
+    /** False when ImpactForce is below every instance's threshold, so a query can be skipped outright */
+    bool CanAnyInstanceConvert(float ImpactForce) const { return ImpactForce >= MinConversionThreshold; }
+
+    /**
+     * Drop candidates whose conversion threshold ImpactForce does not reach, in place.
+     * One compare per candidate against the dense threshold table, meant to run before
+     * tag filters and anything else that touches UObjects.
+     *
+     * @return Number of candidates left
+     */
+    int32 FilterByConversionThreshold(TArray<int32>& Candidates, float ImpactForce) const;
+
+    /**
+     * Rebuild the threshold table from current instance scales and the data asset.
+     * Done at initialization and per added instance; call it after rescaling instances at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Physics")
+    void RefreshConversionThresholds();
+
 protected:
     // ===== Internal State =====
 
@@ -202,9 +374,8 @@ protected:
     UPROPERTY()
     TWeakObjectPtr<UISMRuntimePoolSubsystem> PoolSubsystem;
     
-    /** Currently active physics actors */
-    UPROPERTY()
-    TArray<TWeakObjectPtr<AISMPhysicsActor>> ActivePhysicsActors;
+    /** Currently active physics actors, in camera distance rings */
+    FISMActorDistanceBuckets ActivePhysicsActors;
     
     /** Frame counter for limiter checks */
     int32 LimiterCheckFrameCounter = 0;
@@ -214,6 +385,46 @@ protected:
     
     /** Total returns this session (for stats) */
     int32 TotalReturns = 0;
+
+    /** Scheduler the ballistic transformer registers with (cached on BeginPlay) */
+    TWeakObjectPtr<UISMBatchSchedulerBase> CachedScheduler;
+
+    /** Flies ballistic lite instances; created on the first launch */
+    TSharedPtr<FISMBallisticTransformer> BallisticTransformer;
+
+    struct FQueuedConversion
+    {
+        int32 InstanceIndex = INDEX_NONE;
+
+        /** Slot generation when queued; a recycled slot is not converted */
+        uint32 Generation = 0;
+
+        FVector ImpactPoint = FVector::ZeroVector;
+        FVector ImpactNormal = FVector::ZeroVector;
+        float ImpactForce = 0.0f;
+        TWeakObjectPtr<AActor> Instigator;
+
+        /** Queued by QueueConversions: ImpactPoint is the shared origin */
+        bool bRadial = false;
+
+        /** Higher comes out first */
+        float Priority = 0.0f;
+    };
+
+    /** Max-heap on Priority */
+    TArray<FQueuedConversion> ConversionQueue;
+
+    /** Instances in ConversionQueue, so an instance is queued once */
+    TSet<int32> QueuedConversionIndices;
+
+    /** Conversion force threshold per instance index: data asset threshold, scaled if configured */
+    TArray<float> ConversionThresholds;
+
+    /** Smallest entry of ConversionThresholds */
+    float MinConversionThreshold = 0.0f;
+
+    /** Threshold for an instance of the given transform */
+    float ComputeConversionThreshold(const FTransform& Transform) const;
     
     // ===== Lifecycle Hooks =====
 
@@ -221,6 +432,9 @@ protected:
     
     /** Initialize physics subsystem integration */
     virtual void OnInitializationComplete() override;
+
+    /** Extend the conversion threshold table */
+    virtual void OnInstanceAdded(int32 InstanceIndex, const FTransform& Transform) override;
     
     /** Called when component is being destroyed */
     virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
@@ -238,19 +452,31 @@ protected:
 
     /**
      * Handle overflow when max concurrent actors reached.
-     * Returns an actor to pool based on overflow behavior.
+     * Returns actors to pool based on overflow behavior, all in one pass.
+     *
+     * @param NumToFree - Actors to return
      */
-    void HandleActorOverflow();
+    void HandleActorOverflow(int32 NumToFree = 1);
     
     /**
-     * Return oldest active actor to pool.
+     * Return the oldest active actors to pool.
      */
-    void ReturnOldestActor();
+    void ReturnOldestActors(int32 Count);
     
     /**
-     * Return farthest active actor from player camera.
+     * Return the active actors farthest from the player camera, outermost distance rings first.
+     */
+    void ReturnFarthestActors(int32 Count);
+
+    /**
+     * Return popped tracking entries that still belong to us to ISM, as one batch: final
+     * transforms go through ReturnConvertedInstances, one-shot return feedback is sent once for
+     * the batch and the actors go back through one pool ReturnActors call. Returns how many did.
      */
-    void ReturnFarthestActor();
+    int32 ReturnTrackedActors(TConstArrayView<AActor*> Actors, bool bUpdateTransforms = true);
+
+    /** One batched return feedback context for instances whose actors just returned together */
+    void PlayBatchedReturnFeedback(const TArray<int32>& InstanceIndices);
     
     /**
      * Apply initial physics impulse to converted actor.
@@ -262,6 +488,37 @@ protected:
      */
     void ApplyConversionImpulse(AActor* PhysicsActor, FVector ImpactPoint, FVector ImpactNormal, float ImpactForce);
 
+    // ===== Conversion Queue =====
+
+    /** Validate, prioritize and push one entry; the stand-in launch happens here */
+    bool EnqueueConversion(int32 InstanceIndex, const FVector& ImpactPoint, const FVector& ImpactNormal,
+        float ImpactForce, AActor* Instigator, bool bRadial, const FVector& CameraLocation);
+
+    /**
+     * Convert up to MaxCount queued entries, highest priority first. bBudgeted stops early once the
+     * shared frame budget runs out and returns the rest to the queue; the first conversion always runs.
+     */
+    void ProcessConversionQueue(int32 MaxCount, bool bBudgeted = false);
+
+    // ===== Ballistic Lite =====
+
+    /** Whether a batched conversion of this instance should go ballistic lite instead */
+    bool ShouldUseBallisticLite(int32 InstanceIndex, const FVector& CameraLocation) const;
+
+    /** Launch one instance; false if it fails the force or destroyed checks */
+    bool LaunchInstanceBallistic(int32 InstanceIndex, const FVector& ImpactOrigin, float ImpactForce);
+
+    /** Lazily create and register the ballistic transformer. Null if no scheduler is available. */
+    FISMBallisticTransformer* GetOrCreateBallisticTransformer();
+
+    /**
+     * Take an instance out of ballistic flight before a physics actor converts it,
+     * moving it to where it currently is so the actor starts there.
+     */
+    void LandBallisticInstance(int32 InstanceIndex);
+
+    FISMBallisticSettings BuildBallisticSettings() const;
+
     // ===== Performance Limiters =====
     
     /**
@@ -285,9 +542,13 @@ protected:
     // ===== Cleanup =====
     
     /**
-     * Remove invalid weak pointers from active actors list.
+     * Re-measure DistanceRefreshPerTick active actors and drop ones that were destroyed or
+     * returned to the pool since they were tracked.
      */
-    void CleanupInvalidActors();
+    void RefreshActiveActors();
+
+    /** Whether a tracked actor still represents one of our instances */
+    bool IsActorStillActive(const AActor& Actor) const;
     
     /**
      * Register callback for when physics actor returns to pool.
@@ -306,6 +567,16 @@ public:
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPhysicsConversion, int32, InstanceIndex, AActor*, PhysicsActor);
     UPROPERTY(BlueprintAssignable, Category = "Physics|Events")
     FOnPhysicsConversion OnPhysicsConversion;
+
+    /**
+     * Called once per ConvertInstancesToPhysics batch.
+     *
+     * @param InstanceIndices - Converted instances
+     * @param PhysicsActors - PhysicsActors[i] represents InstanceIndices[i]
+     */
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPhysicsConversionBatch, const TArray<int32>&, InstanceIndices, const TArray<AActor*>&, PhysicsActors);
+    UPROPERTY(BlueprintAssignable, Category = "Physics|Events")
+    FOnPhysicsConversionBatch OnPhysicsConversionBatch;
     
     /**
      * Called when a physics actor returns to ISM.
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "ISMPoolDataAsset.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ISMPhysicsMeshComponent.h"
 #include "ISMPhysicsDataAsset.generated.h"
 
 
@@ -145,6 +146,67 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision",
         meta=(Tooltip="Allow collision with other physics actors. Disable for performance."))
     bool bEnablePhysicsCollision = true;
+
+    /**
+     * Generate overlap events on the physics actor. Only overlap-mode reset triggers need them;
+     * turn off when every reset trigger uses BoundsSweep to save the broadphase work.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision",
+        meta=(Tooltip="Generate overlap events. Off is cheaper; overlap-mode reset triggers need it on."))
+    bool bGenerateOverlapEvents = true;
+
+    // ===== Collision LOD =====
+
+    /**
+     * Give converted actors beyond SimplifiedCollisionDistance from the camera a single bounds
+     * primitive and fewer solver iterations. Near actors keep the mesh collision and the body's
+     * default iteration counts. Switching rebuilds the body, so keep the hysteresis wide enough
+     * that actors hovering at the threshold do not flip every refresh.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision|LOD",
+        meta=(Tooltip="Use a simple primitive and fewer solver iterations for distant physics actors."))
+    bool bEnableCollisionLOD = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision|LOD",
+        meta=(ClampMin="0.0", UIMin="500.0", UIMax="20000.0", EditCondition="bEnableCollisionLOD", EditConditionHides,
+              Tooltip="Camera distance (cm) beyond which actors use simplified collision."))
+    float SimplifiedCollisionDistance = 3000.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision|LOD",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="2000.0", EditCondition="bEnableCollisionLOD", EditConditionHides,
+              Tooltip="Actors switch back to full collision only once this much (cm) inside the threshold."))
+    float CollisionLODHysteresis = 300.0f;
+
+    /**
+     * Collision of far actors. Mesh keeps the mesh collision and only lowers solver iterations.
+     * With automatic mass (Mass = 0) the primitive's volume sets the far mass.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision|LOD",
+        meta=(EditCondition="bEnableCollisionLOD", EditConditionHides,
+              Tooltip="Collision shape for distant actors."))
+    EISMPhysicsCollisionShape SimplifiedCollisionShape = EISMPhysicsCollisionShape::Box;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision|LOD",
+        meta=(ClampMin="1", ClampMax="255", UIMin="1", UIMax="8", EditCondition="bEnableCollisionLOD", EditConditionHides,
+              Tooltip="Position solver iterations for distant actors."))
+    int32 FarPositionSolverIterations = 2;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision|LOD",
+        meta=(ClampMin="1", ClampMax="255", UIMin="1", UIMax="4", EditCondition="bEnableCollisionLOD", EditConditionHides,
+              Tooltip="Velocity solver iterations for distant actors."))
+    int32 FarVelocitySolverIterations = 1;
+
+    /** Whether an actor at Distance from the camera should use simplified collision, given its current tier */
+    bool ShouldUseSimplifiedCollision(float Distance, bool bCurrentlySimplified) const
+    {
+        if (!bEnableCollisionLOD)
+        {
+            return false;
+        }
+        return bCurrentlySimplified
+            ? Distance > SimplifiedCollisionDistance - CollisionLODHysteresis
+            : Distance > SimplifiedCollisionDistance;
+    }
     
     // ===== Destruction Thresholds =====
 
@@ -186,7 +248,68 @@ public:
         meta=(ClampMin="0.0", UIMin="0.0", UIMax="10000.0",
               Tooltip="Minimum impact force to convert to physics. Lower = more sensitive."))
     float ConversionForceThreshold = 100.0f;
-    
+
+    /** Multiply ConversionForceThreshold by each instance's largest scale, so bigger copies are harder to knock loose */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion",
+        meta=(Tooltip="Conversion threshold is multiplied by the instance scale, so larger instances need a harder hit."))
+    bool bConversionThresholdIsScaled = false;
+
+    // ===== Ballistic Lite =====
+
+    /**
+     * Launch distant instances as ballistic lite debris instead of converting them to actors.
+     * They fly on their ISM transform via the batch scheduler - no actor, no rigid body, no
+     * collision - bounce on the height they were resting at and settle there.
+     * Applies to batched conversions (explosions) and LaunchInstancesBallistic.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(Tooltip="Fly distant instances on their ISM transform instead of spawning physics actors."))
+    bool bEnableBallisticLite = false;
+
+    /**
+     * Instances at least this far (cm) from the camera go ballistic lite on batched conversions.
+     * 0 = every batched conversion goes ballistic lite.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="20000.0",
+              EditCondition="bEnableBallisticLite", EditConditionHides,
+              Tooltip="Camera distance (cm) beyond which batched conversions go ballistic lite. 0 = always."))
+    float BallisticLiteDistance = 3000.0f;
+
+    /**
+     * Tilts the launch direction upward so debris on flat ground is thrown up rather than
+     * skidding along it. 0 = straight away from the impact.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="2.0",
+              EditCondition="bEnableBallisticLite", EditConditionHides))
+    float BallisticUpwardBias = 0.5f;
+
+    /** Fraction of vertical speed kept on each bounce */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.0", ClampMax="1.0", EditCondition="bEnableBallisticLite", EditConditionHides))
+    float BallisticRestitution = 0.3f;
+
+    /** Fraction of horizontal speed and spin kept on each bounce */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.0", ClampMax="1.0", EditCondition="bEnableBallisticLite", EditConditionHides))
+    float BallisticGroundFriction = 0.5f;
+
+    /** A bounce slower than this (cm/s) ends the flight */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="500.0", EditCondition="bEnableBallisticLite", EditConditionHides))
+    float BallisticSettleSpeed = 50.0f;
+
+    /** Seconds after launch at which an instance is put down wherever it is */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.1", UIMin="0.1", UIMax="30.0", EditCondition="bEnableBallisticLite", EditConditionHides))
+    float BallisticMaxFlightTime = 5.0f;
+
+    /** Maximum tumble (rad/s) given at launch; each instance gets a random axis and a share of it */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conversion|Ballistic",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="50.0", EditCondition="bEnableBallisticLite", EditConditionHides))
+    float BallisticMaxSpin = 10.0f;
+
     // ===== Resting Detection =====
     
     /**
@@ -240,6 +363,49 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resting|Debugging", meta = (Tooltip = "Log resting checks and state changes for debugging."))
 	bool bLogRestingChecks = false;
 
+    /**
+     * Run rest detection in the world's batched pass (UISMPhysicsRestSubsystem) instead of
+     * ticking every live actor. Velocities are read in bulk and distant actors are checked less often.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resting|Batching",
+        meta=(Tooltip="Check rest in one batched pass per frame instead of a tick per actor."))
+    bool bUseBatchedRestDetection = true;
+
+    /**
+     * Beyond this distance (cm) from the camera, rest is checked every DistantRestCheckInterval
+     * seconds instead of every frame. 0 = always every frame.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resting|Batching",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="50000.0",
+              EditCondition="bUseBatchedRestDetection", EditConditionHides,
+              Tooltip="Distance from the camera beyond which rest is checked less often. 0 = every frame."))
+    float DistantRestCheckDistance = 5000.0f;
+
+    /** Seconds between rest checks for actors beyond DistantRestCheckDistance */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resting|Batching",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="2.0",
+              EditCondition="bUseBatchedRestDetection", EditConditionHides,
+              Tooltip="Seconds between rest checks for distant actors."))
+    float DistantRestCheckInterval = 0.25f;
+
+    /**
+     * Return to ISM when the physics engine puts the body to sleep instead of polling its
+     * velocity. A settling actor then does no per-frame work at all; velocity polling only
+     * starts if the body is still awake after SleepFallbackTimeout, or if CanReturnToISM
+     * refuses the sleeping actor.
+     * ShouldBeKinematic is only re-evaluated once polling starts.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resting|Sleep",
+        meta=(Tooltip="Return to ISM on the body's sleep event instead of polling velocity."))
+    bool bReturnOnSleep = false;
+
+    /** Seconds to wait for the body to sleep before falling back to velocity polling. 0 = never fall back. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resting|Sleep",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="60.0",
+              EditCondition="bReturnOnSleep", EditConditionHides,
+              Tooltip="Seconds awake before velocity polling takes over. 0 = never."))
+    float SleepFallbackTimeout = 10.0f;
+
     
     
     /**
@@ -10,6 +10,8 @@
 // Forward declarations
 class UISMPhysicsComponent;
 class UPrimitiveComponent;
+class UISMPhysicsInstigatorSubsystem;
+struct FISMInstanceHandle;
 
 /**
  * Simple plug-and-play component for triggering physics conversions.
@@ -66,6 +68,15 @@ public:
      */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instigator|Performance")
     float UpdateInterval = 0.1f;
+
+    /**
+     * Detect through UISMPhysicsInstigatorSubsystem: all instigators' spheres are moved in one
+     * pass per frame and each only sees the instances that entered it since its last update.
+     * An instance that stays inside the sphere is tried once rather than on every update.
+     * Off = query every physics component around the owner on each update.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Instigator|Performance")
+    bool bUseSharedBroadphase = true;
     
     /**
      * Calculate impact force from owner's velocity.
@@ -171,6 +182,16 @@ protected:
      */
     void PerformInstigatorUpdate();
     
+    /** Shared broadphase this instigator is registered with, if bUseSharedBroadphase */
+    TWeakObjectPtr<UISMPhysicsInstigatorSubsystem> InstigatorSubsystem;
+
+    /**
+     * Try to convert instances that entered the query sphere since the previous update.
+     * Called by UISMPhysicsInstigatorSubsystem for its shared pass.
+     */
+    void HandleEnteredInstances(TConstArrayView<FISMInstanceHandle> EnteredInstances);
+    friend class UISMPhysicsInstigatorSubsystem;
+
     /**
      * Find all physics components in the world.
      * Results are cached for performance.
@@ -190,6 +211,15 @@ protected:
      */
     void QueryComponent(UISMPhysicsComponent* PhysicsComponent, TArray<int32>& OutInstances);
     
+    /**
+     * Convert one instance now, or queue it if the component defers conversions.
+     * Broadcasts OnInstigatorTriggered on success.
+     *
+     * @return True if converted or queued
+     */
+    bool RequestConversion(UISMPhysicsComponent* PhysicsComponent, int32 InstanceIndex,
+        const FVector& ImpactPoint, const FVector& ImpactNormal, float Force);
+
     /**
      * Calculate impact force based on owner velocity and mass.
      * 
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMPhysicsInstigatorSubsystem.generated.h"
+
+class UISMPhysicsInstigatorComponent;
+
+/**
+ * Shared broadphase for physics instigators.
+ *
+ * Each registered instigator owns a sphere subscription on UISMRuntimeSubsystem that only accepts
+ * instances of UISMPhysicsComponents. Instigators that are due this frame ask for an update; the
+ * subsystem then moves all of their spheres in one pass after the frame's component ticks, and hands
+ * each instigator only the instances that entered its sphere since its previous update. Components
+ * out of reach are culled by the runtime subsystem's component broadphase, and a component whose
+ * instances did not change is only tested in the shell between the old and new sphere.
+ */
+UCLASS()
+class ISMRUNTIMEPHYSICS_API UISMPhysicsInstigatorSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual void Deinitialize() override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMPhysicsInstigatorSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Give an instigator a subscription. Returns false if there is no runtime subsystem to query. */
+    bool RegisterInstigator(UISMPhysicsInstigatorComponent* Instigator);
+
+    /** Drop an instigator's subscription; no-op if it is not registered */
+    void UnregisterInstigator(UISMPhysicsInstigatorComponent* Instigator);
+
+    /** Move the instigator's sphere during this frame's pass and report what entered it */
+    void RequestUpdate(UISMPhysicsInstigatorComponent* Instigator);
+
+    /** Registered instigators */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Physics")
+    int32 GetNumInstigators() const { return Entries.Num(); }
+
+private:
+    struct FInstigatorEntry
+    {
+        TWeakObjectPtr<UISMPhysicsInstigatorComponent> Instigator;
+        int32 SubscriptionId = INDEX_NONE;
+        bool bUpdatePending = false;
+    };
+
+    /** A handful per world (players, AI), so lookups are linear */
+    TArray<FInstigatorEntry> Entries;
+
+    int32 NumPending = 0;
+
+    /** Reused across instigators and frames */
+    FISMSphereSubscriptionDelta Delta;
+
+    UISMRuntimeSubsystem* GetRuntimeSubsystem() const;
+
+    /** Remove entries whose instigator is gone, dropping their subscriptions */
+    void RemoveStaleEntries();
+};
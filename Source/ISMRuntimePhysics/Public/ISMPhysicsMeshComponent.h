@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StaticMeshComponent.h"
+#include "ISMPhysicsMeshComponent.generated.h"
+
+class UBodySetup;
+
+UENUM(BlueprintType)
+enum class EISMPhysicsCollisionShape : uint8
+{
+    /** The static mesh's own collision */
+    Mesh    UMETA(DisplayName = "Mesh Collision"),
+
+    /** One box fitted to the mesh bounds */
+    Box     UMETA(DisplayName = "Bounds Box"),
+
+    /** One sphere centred on the bounds, radius its largest half-extent */
+    Sphere  UMETA(DisplayName = "Bounds Sphere")
+};
+
+/**
+ * Mesh component of pooled physics actors.
+ *
+ * Can swap the mesh's collision for a single primitive fitted to its bounds without touching
+ * what is rendered, so distant converted actors cost Chaos one box or sphere instead of the
+ * mesh's full convex set. Primitive body setups are built on first use and kept until the
+ * static mesh changes.
+ */
+UCLASS(ClassGroup = (ISMRuntime), meta = (BlueprintSpawnableComponent))
+class ISMRUNTIMEPHYSICS_API UISMPhysicsMeshComponent : public UStaticMeshComponent
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Switch the collision shape. Rebuilds the physics state if it exists and carries the
+     * body's velocity across. Returns false if the shape was already active or cannot be built.
+     */
+    bool SetCollisionShape(EISMPhysicsCollisionShape Shape);
+
+    EISMPhysicsCollisionShape GetCollisionShape() const { return CollisionShape; }
+
+    // UPrimitiveComponent interface
+    virtual UBodySetup* GetBodySetup() override;
+
+    // UStaticMeshComponent interface
+    virtual bool SetStaticMesh(UStaticMesh* NewMesh) override;
+
+private:
+    /** Cached primitive setup for Shape, built from the current mesh bounds if missing */
+    UBodySetup* GetPrimitiveBodySetup(EISMPhysicsCollisionShape Shape);
+
+    EISMPhysicsCollisionShape CollisionShape = EISMPhysicsCollisionShape::Mesh;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBodySetup> BoxBodySetup;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBodySetup> SphereBodySetup;
+};
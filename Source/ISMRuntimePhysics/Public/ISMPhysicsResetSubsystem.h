@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ISMPhysicsResetSubsystem.generated.h"
+
+class AActor;
+class AISMPhysicsResetTrigger;
+
+/**
+ * Overlap-free reset volumes.
+ *
+ * Reset triggers in BoundsSweep mode register their box here instead of listening for overlaps.
+ * When any of them is due, the subsystem gathers the active actors of every UISMPhysicsComponent
+ * once and tests their locations against the due boxes, so physics actors can run with overlap
+ * events off and pay nothing in the broadphase for reset volumes.
+ */
+UCLASS()
+class ISMRUNTIMEPHYSICS_API UISMPhysicsResetSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMPhysicsResetSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Sweep the trigger's box every SweepInterval seconds */
+    void RegisterTrigger(AISMPhysicsResetTrigger* Trigger);
+
+    /** Stop sweeping the trigger; no-op if it is not registered */
+    void UnregisterTrigger(AISMPhysicsResetTrigger* Trigger);
+
+    /** Registered triggers */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Physics")
+    int32 GetNumTriggers() const { return Entries.Num(); }
+
+private:
+    struct FTriggerEntry
+    {
+        TWeakObjectPtr<AISMPhysicsResetTrigger> Trigger;
+
+        /** Time since this trigger's last sweep */
+        float PendingDeltaTime = 0.0f;
+    };
+
+    /** A handful per level, so lookups are linear */
+    TArray<FTriggerEntry> Entries;
+
+    /** Reused between sweeps */
+    TArray<AActor*> ActorScratch;
+};
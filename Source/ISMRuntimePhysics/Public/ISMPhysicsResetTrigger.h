@@ -10,6 +10,16 @@
 class UBoxComponent;
 class AISMPhysicsActor;
 
+UENUM(BlueprintType)
+enum class EISMResetTriggerMode : uint8
+{
+    /** Box overlap events; physics actors must generate overlaps */
+    Overlap         UMETA(DisplayName = "Overlap Events"),
+
+    /** Periodic location test against active physics actors; no overlap events needed */
+    BoundsSweep     UMETA(DisplayName = "Bounds Sweep")
+};
+
 /**
  * Simple volume trigger that instantly returns physics actors to ISM.
  * 
@@ -24,6 +34,10 @@ class AISMPhysicsActor;
  * 2. Scale box component to desired volume
  * 3. Done! Physics actors touching volume will return to ISM
  * 
+ * In BoundsSweep mode the box registers with UISMPhysicsResetSubsystem instead of generating
+ * overlaps, and actors whose origin is inside it reset within SweepInterval. Pair it with
+ * bGenerateOverlapEvents off on the physics data assets.
+ * 
  * Features:
  * - Instant return (no delay)
  * - Optional transform update (ISM instance moved to reset position or kept at original)
@@ -57,6 +71,28 @@ public:
      */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reset Trigger")
     bool bUpdateTransformOnReset = true;
+
+    /** How actors inside the volume are found. Read at BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reset Trigger")
+    EISMResetTriggerMode ResetMode = EISMResetTriggerMode::Overlap;
+
+    /** Seconds between bounds sweeps; 0 = every frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reset Trigger",
+        meta=(ClampMin="0.0", UIMin="0.0", UIMax="2.0", EditCondition="ResetMode == EISMResetTriggerMode::BoundsSweep", EditConditionHides))
+    float SweepInterval = 0.1f;
+
+    /**
+     * Reset the actor if it passes the tag filters.
+     *
+     * @return True if the actor was reset
+     */
+    bool TryResetActor(AISMPhysicsActor* PhysicsActor);
+
+    /**
+     * World-to-box transform and unscaled half extent of the volume, for bounds sweeps.
+     * Returns false if the volume is missing.
+     */
+    bool GetSweepBox(FTransform& OutWorldToBox, FVector& OutExtent) const;
     
     /**
      * Only reset physics actors with ALL of these tags.
@@ -88,6 +124,9 @@ public:
     //TObjectPtr<USoundBase> ResetSound;
 
 protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     // ===== Overlap Events =====
     
     /**
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ISMPhysicsRestSubsystem.generated.h"
+
+class AISMPhysicsActor;
+
+/**
+ * Batched rest detection for live physics actors.
+ *
+ * Actors whose data asset enables bUseBatchedRestDetection register here when requested from the
+ * pool and turn their own tick off. Each frame this subsystem picks the actors that are due (every
+ * frame near the camera, every DistantRestCheckInterval seconds beyond DistantRestCheckDistance),
+ * reads their velocities under one physics scene lock and runs their rest detection with the time
+ * accumulated since their last check.
+ */
+UCLASS()
+class ISMRUNTIMEPHYSICS_API UISMPhysicsRestSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMPhysicsRestSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Add an actor to the batched pass. Returns false if it could not be added. */
+    bool RegisterActor(AISMPhysicsActor* Actor);
+
+    /** Remove an actor from the batched pass; no-op if it is not registered */
+    void UnregisterActor(AISMPhysicsActor* Actor);
+
+    /** Actors in the batched pass */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Physics")
+    int32 GetNumActors() const { return Entries.Num(); }
+
+private:
+    struct FRestEntry
+    {
+        TWeakObjectPtr<AISMPhysicsActor> Actor;
+
+        /** Time since this actor's rest detection last ran */
+        float PendingDeltaTime = 0.0f;
+    };
+
+    /** Dense; each actor stores its index so removal is a swap */
+    TArray<FRestEntry> Entries;
+
+    void RemoveEntryAt(int32 Index);
+};
@@ -0,0 +1,27 @@
+// ISMPoolProfiling.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Stats shown under "stat ISMRuntimePools" and in Unreal Insights; CSV timings and per-class
+// counters go to the ISMPools category; pool allocations are tracked under the ISMRuntime/Pools
+// LLM tag. Defined in ISMRuntimePools.cpp.
+
+DECLARE_STATS_GROUP(TEXT("ISM Runtime Pools"), STATGROUP_ISMRuntimePools, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Request"), STAT_ISMPoolRequest, STATGROUP_ISMRuntimePools, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Return"), STAT_ISMPoolReturn, STATGROUP_ISMRuntimePools, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Spawn"), STAT_ISMPoolSpawn, STATGROUP_ISMRuntimePools, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Reset"), STAT_ISMPoolReset, STATGROUP_ISMRuntimePools, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Grow"), STAT_ISMPoolGrow, STATGROUP_ISMRuntimePools, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Actors"), STAT_ISMPoolActiveActors, STATGROUP_ISMRuntimePools, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Available Actors"), STAT_ISMPoolAvailableActors, STATGROUP_ISMRuntimePools, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Misses"), STAT_ISMPoolMisses, STATGROUP_ISMRuntimePools, );
+
+CSV_DECLARE_CATEGORY_EXTERN(ISMPools);
+
+LLM_DECLARE_TAG(ISMRuntime_Pools);
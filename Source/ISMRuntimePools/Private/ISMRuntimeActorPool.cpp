@@ -1,7 +1,11 @@
 #include "ISMRuntimeActorPool.h"
+#include "ISMPoolSlotComponent.h"
+#include "ISMPoolProfiling.h"
+#include "ISMRuntimeProfiling.h"
 #include "Interfaces/ISMPoolable.h"
 #include "ISMPoolDataAsset.h"
 #include "ISMInstanceHandle.h"
+#include "Settings/ISMPerformanceProfile.h"
 #include "Logging/LogMacros.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
@@ -24,12 +28,20 @@ void FISMRuntimeActorPool::Initialize(TSubclassOf<AActor> InActorClass, UISMPool
     PoolConfig = InConfig;
     OwningWorld = InWorld;
 
+    // Skip 0 so an untagged (default) slot component never matches a pool
+    static uint32 NextPoolId = 1;
+    PoolId = NextPoolId++;
+    if (NextPoolId == 0)
+    {
+        NextPoolId = 1;
+    }
+
     // Initialize statistics
     Stats = FISMPoolStats();
     Stats.CreationTime = InWorld->GetTimeSeconds();
 
     UE_LOG(LogTemp, Log, TEXT("FISMRuntimeActorPool::Initialize - Pool created for %s with initial size %d"),
-        *ActorClass->GetName(), InConfig->InitialPoolSize);
+        *ActorClass->GetName(), GetInitialPoolSize());
 }
 
 int32 FISMRuntimeActorPool::PreWarm()
@@ -39,16 +51,28 @@ int32 FISMRuntimeActorPool::PreWarm()
         return 0;
     }
 
-    const int32 TargetSize = PoolConfig->InitialPoolSize;
+    const int32 TargetSize = GetInitialPoolSize();
     int32 SpawnedCount = 0;
 
     const double StartTime = FPlatformTime::Seconds();
 
+    // Time-sliced pools spawn this frame's budget now and leave the rest to ProcessSpawnQueue
+    if (PoolConfig->IsSpawnTimeSliced())
+    {
+        const int32 Queued = QueueSpawns(TargetSize);
+        SpawnedCount = ProcessSpawnQueue();
+
+        UE_LOG(LogTemp, Log, TEXT("FISMRuntimeActorPool::PreWarm - Spawned %d actors for %s in %.2fms, %d queued"),
+            SpawnedCount, *ActorClass->GetName(), (FPlatformTime::Seconds() - StartTime) * 1000.0,
+            FMath::Max(0, Queued - SpawnedCount));
+
+        return SpawnedCount;
+    }
+
     for (int32 i = 0; i < TargetSize; ++i)
     {
-        if (AActor* Actor = SpawnPoolActor(true))
+        if (SpawnPoolActor(true))
         {
-            AvailableActors.Add(Actor);
             SpawnedCount++;
         }
         else
@@ -60,8 +84,8 @@ int32 FISMRuntimeActorPool::PreWarm()
 
     const double ElapsedTime = (FPlatformTime::Seconds() - StartTime) * 1000.0; // Convert to ms
 
-    Stats.TotalActors = SpawnedCount;
-    Stats.AvailableActors = SpawnedCount;
+    Stats.TotalActors += SpawnedCount;
+    Stats.AvailableActors = NumAvailable;
 
     UE_LOG(LogTemp, Log, TEXT("FISMRuntimeActorPool::PreWarm - Spawned %d actors for %s in %.2fms"),
         SpawnedCount, *ActorClass->GetName(), ElapsedTime);
@@ -73,6 +97,11 @@ int32 FISMRuntimeActorPool::PreWarm()
 
 AActor* FISMRuntimeActorPool::RequestActor(UISMPoolDataAsset* DataAsset, const FISMInstanceHandle& InstanceHandle)
 {
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::RequestActor);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolRequest);
+    LLM_SCOPE_BYTAG(ISMRuntime_Pools);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Request);
+
     if (!ValidateOperation(TEXT("RequestActor")))
     {
         return nullptr;
@@ -87,23 +116,46 @@ AActor* FISMRuntimeActorPool::RequestActor(UISMPoolDataAsset* DataAsset, const F
     AActor* Actor = nullptr;
 
     // Try to get an available actor
-    if (AvailableActors.Num() > 0)
+    if (NumAvailable > 0)
     {
-        UE_LOG(LogTemp, Verbose, TEXT("FISMRuntimeActorPool::RequestActor - %d available actors in pool for %s"), AvailableActors.Num(), *ActorClass->GetName());
-        // Get from end for better cache performance
-        TWeakObjectPtr<AActor> ActorPtr = AvailableActors.Pop();
-        Actor = ActorPtr.Get();
+        UE_LOG(LogTemp, Verbose, TEXT("FISMRuntimeActorPool::RequestActor - %d available actors in pool for %s"), NumAvailable, *ActorClass->GetName());
+        // Most recently returned first for better cache performance
+        const int32 Slot = PopAvailableSlot();
+        Actor = SlotActors[Slot];
 
-        if (!Actor)
+        if (!::IsValid(Actor))
         {
+            VacateSlot(Slot);
+
             // Actor was destroyed externally, try next
             CleanupInvalidActors();
 			UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::RequestActor - Found null actor in available list, cleaning up and trying again"));
             return RequestActor(DataAsset, InstanceHandle); // Recursive call
         }
+
+        QueueLowWatermarkRefill();
+    }
+    else if (PoolConfig->IsSpawnTimeSliced() && CanGrow())
+    {
+        FrameMisses++;
+
+        // Truly empty: spawn only the actor this request needs and let the queue refill the rest
+        if (SpawnPoolActor(false))
+        {
+            Actor = SlotActors[PopAvailableSlot()];
+            Stats.TotalActors++;
+            Stats.SynchronousSpawns++;
+
+            // It takes the place of a queued spawn, if there was one
+            Stats.PendingSpawns = FMath::Max(0, Stats.PendingSpawns - 1);
+        }
+
+        QueueLowWatermarkRefill();
     }
     else
     {
+        FrameMisses++;
+
         // Pool exhausted - try to grow
         if (CanGrow())
         {
@@ -113,21 +165,21 @@ AActor* FISMRuntimeActorPool::RequestActor(UISMPoolDataAsset* DataAsset, const F
             const int32 Grown = GrowPool();
             Stats.GrowCount++;
 
-            if (Grown > 0 && AvailableActors.Num() > 0)
+            if (Grown > 0 && NumAvailable > 0)
             {
-                TWeakObjectPtr<AActor> ActorPtr = AvailableActors.Pop();
-                Actor = ActorPtr.Get();
+                Actor = SlotActors[PopAvailableSlot()];
             }
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::RequestActor - Pool exhausted and cannot grow! MaxPoolSize=%d"), PoolConfig->MaxPoolSize);
-            if (ActiveActors.Num() > 0)
+            UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::RequestActor - Pool exhausted and cannot grow! MaxPoolSize=%d"), GetMaxPoolSize());
+            if (NumActive > 0)
             {
                 UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::RequestActor - Active actors:"));
-                for (const TWeakObjectPtr<AActor>& ActorPtr : ActiveActors)
+                for (int32 Slot = 0; Slot < SlotActors.Num(); ++Slot)
                 {
-                    if (AActor* ActiveActor = ActorPtr.Get())
+                    AActor* ActiveActor = SlotActors[Slot];
+                    if (SlotStates[Slot] == EISMPoolSlotState::Active && ::IsValid(ActiveActor))
                     {
                         UE_LOG(LogTemp, Warning, TEXT("  - %s"), *ActiveActor->GetName());
 						return ActiveActor; // Return an active actor as a last resort (potentially unsafe)
@@ -144,13 +196,10 @@ AActor* FISMRuntimeActorPool::RequestActor(UISMPoolDataAsset* DataAsset, const F
         return nullptr;
     }
 
-    // Move to active list
-    ActiveActors.Add(Actor);
-
     // Update stats
     Stats.TotalRequests++;
-    Stats.ActiveActors = ActiveActors.Num();
-    Stats.AvailableActors = AvailableActors.Num();
+    Stats.ActiveActors = NumActive;
+    Stats.AvailableActors = NumAvailable;
     Stats.PeakActiveActors = FMath::Max(Stats.PeakActiveActors, Stats.ActiveActors);
 
     // Call IISMPoolable::OnRequestedFromPool if implemented
@@ -167,8 +216,102 @@ AActor* FISMRuntimeActorPool::RequestActor(UISMPoolDataAsset* DataAsset, const F
     return Actor;
 }
 
+int32 FISMRuntimeActorPool::RequestActors(UISMPoolDataAsset* DataAsset, TConstArrayView<FISMInstanceHandle> InstanceHandles, TArray<AActor*>& OutActors)
+{
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::RequestActors);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolRequest);
+    LLM_SCOPE_BYTAG(ISMRuntime_Pools);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Request);
+
+    OutActors.Reset(InstanceHandles.Num());
+
+    if (InstanceHandles.Num() == 0 || !ValidateOperation(TEXT("RequestActors")))
+    {
+        return 0;
+    }
+
+    Stats.LastAccessFrame = GFrameCounter;
+
+    // Reserve the whole batch: one grow for the shortfall instead of one per exhausted request
+    const int32 Shortfall = InstanceHandles.Num() - NumAvailable;
+    if (Shortfall > 0)
+    {
+        FrameMisses += Shortfall;
+
+        if (CanGrow())
+        {
+            if (PoolConfig->IsSpawnTimeSliced())
+            {
+                // Spawn only what this batch needs; the queue refills the rest
+                const int32 Grown = GrowPool(Shortfall);
+                Stats.SynchronousSpawns += Grown;
+                Stats.PendingSpawns = FMath::Max(0, Stats.PendingSpawns - Grown);
+            }
+            else
+            {
+                GrowPool(FMath::Max(Shortfall, PoolConfig->PoolGrowSize));
+                Stats.GrowCount++;
+            }
+        }
+    }
+
+    bool bFoundInvalid = false;
+    while (OutActors.Num() < InstanceHandles.Num())
+    {
+        const int32 Slot = PopAvailableSlot();
+        if (Slot == INDEX_NONE)
+        {
+            break;
+        }
+
+        AActor* Actor = SlotActors[Slot];
+        if (!::IsValid(Actor))
+        {
+            // Destroyed externally; drop the slot and take the next one
+            VacateSlot(Slot);
+            bFoundInvalid = true;
+            continue;
+        }
+        OutActors.Add(Actor);
+    }
+
+    if (bFoundInvalid)
+    {
+        CleanupInvalidActors();
+    }
+
+    if (OutActors.Num() < InstanceHandles.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::RequestActors - Pool exhausted, served %d of %d for %s"),
+            OutActors.Num(), InstanceHandles.Num(), *ActorClass->GetName());
+    }
+
+    QueueLowWatermarkRefill();
+
+    // Update stats once for the batch
+    Stats.TotalRequests += OutActors.Num();
+    Stats.ActiveActors = NumActive;
+    Stats.AvailableActors = NumAvailable;
+    Stats.PeakActiveActors = FMath::Max(Stats.PeakActiveActors, Stats.ActiveActors);
+
+    for (int32 Index = 0; Index < OutActors.Num(); ++Index)
+    {
+        AActor* Actor = OutActors[Index];
+        if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
+        {
+            Poolable->Execute_OnRequestedFromPool(Actor, DataAsset, InstanceHandles[Index]);
+        }
+    }
+
+    return OutActors.Num();
+}
+
 bool FISMRuntimeActorPool::ReturnActor(AActor* Actor, FTransform& OutFinalTransform, bool& bUpdateTransform)
 {
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::ReturnActor);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolReturn);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Return);
+
     if (!Actor)
     {
         UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::ReturnActor - Null actor provided"));
@@ -181,24 +324,16 @@ bool FISMRuntimeActorPool::ReturnActor(AActor* Actor, FTransform& OutFinalTransf
         return false;
     }
 	UE_LOG(LogTemp, Verbose, TEXT("FISMRuntimeActorPool::ReturnActor - Returning actor %s to pool"), *Actor->GetName());
-	if (!ActiveActors.Contains(Actor) )
+    const int32 Slot = FindSlot(Actor);
+	if (Slot == INDEX_NONE)
     {
-        if (!AvailableActors.Contains(Actor))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::ReturnActor - Actor %s is not active or availble??"), *Actor->GetName());
-            // Update stats
-            Stats.TotalReturns++;
-            Stats.ActiveActors = ActiveActors.Num();
-            Stats.AvailableActors = AvailableActors.Num();
-			AvailableActors.Add(Actor);
-        }
-        UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::ReturnActor - Actor %s is already returned to the pool"),*Actor->GetName());
+        UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::ReturnActor - Actor %s does not belong to this pool!"), *Actor->GetName());
         return false;
     }
 
-	if (!ContainsActor(Actor))
+	if (SlotStates[Slot] != EISMPoolSlotState::Active)
     {
-        UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::ReturnActor - Actor %s does not belong to this pool!"), *Actor->GetName());
+        UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::ReturnActor - Actor %s is already returned to the pool"),*Actor->GetName());
         return false;
     }
 
@@ -219,13 +354,12 @@ bool FISMRuntimeActorPool::ReturnActor(AActor* Actor, FTransform& OutFinalTransf
     ResetActor(Actor);
 
     // Move from active to available
-    ActiveActors.Remove(Actor); // Don't shrink array for performance
-    AvailableActors.Add(Actor);
+    PushAvailableSlot(Slot);
 
     // Update stats
     Stats.TotalReturns++;
-    Stats.ActiveActors = ActiveActors.Num();
-    Stats.AvailableActors = AvailableActors.Num();
+    Stats.ActiveActors = NumActive;
+    Stats.AvailableActors = NumAvailable;
 
     // Check for leaks periodically (every 100 returns)
     if (Stats.TotalReturns % 100 == 0 && Stats.HasLeak())
@@ -237,19 +371,150 @@ bool FISMRuntimeActorPool::ReturnActor(AActor* Actor, FTransform& OutFinalTransf
     return true;
 }
 
-bool FISMRuntimeActorPool::ContainsActor(AActor* Actor) const
+int32 FISMRuntimeActorPool::ReturnActors(TConstArrayView<AActor*> Actors)
 {
-    if (!Actor)
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::ReturnActors);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolReturn);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Return);
+
+    if (Actors.Num() == 0 || !ValidateOperation(TEXT("ReturnActors")))
     {
-        return false;
+        return 0;
+    }
+
+    Stats.LastAccessFrame = GFrameCounter;
+
+    // Notify every actor before resetting any, so the reset pass runs back to back. A slot goes
+    // available only after its reset, and a duplicate in Actors fails the Active check the second time.
+    TArray<int32, TInlineAllocator<32>> Returned;
+    for (AActor* Actor : Actors)
+    {
+        const int32 Slot = FindSlot(Actor);
+        if (Slot == INDEX_NONE || SlotStates[Slot] != EISMPoolSlotState::Active || Returned.Contains(Slot))
+        {
+            continue;
+        }
+
+        if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
+        {
+            FTransform FinalTransform = FTransform::Identity;
+            bool bUpdateTransform = false;
+            Poolable->Execute_OnReturnedToPool(Actor, FinalTransform, bUpdateTransform);
+        }
+        Returned.Add(Slot);
+    }
+
+    for (const int32 Slot : Returned)
+    {
+        ResetActor(SlotActors[Slot]);
+        PushAvailableSlot(Slot);
     }
-    return AllActors.Contains(Actor);
+
+    Stats.TotalReturns += Returned.Num();
+    Stats.ActiveActors = NumActive;
+    Stats.AvailableActors = NumAvailable;
+
+    return Returned.Num();
+}
+
+bool FISMRuntimeActorPool::ContainsActor(AActor* Actor) const
+{
+    return FindSlot(Actor) != INDEX_NONE;
 }
 
 // ===== Pool Management =====
 
+int32 FISMRuntimeActorPool::QueueSpawns(int32 Count)
+{
+    if (!ValidateOperation(TEXT("QueueSpawns")))
+    {
+        return 0;
+    }
+
+    if (Count <= 0)
+    {
+        Count = PoolConfig->PoolGrowSize;
+    }
+
+    // Spawned plus queued actors must stay within MaxPoolSize
+    const int32 MaxSize = GetMaxPoolSize();
+    if (MaxSize > 0)
+    {
+        Count = FMath::Min(Count, MaxSize - Stats.TotalActors - Stats.PendingSpawns);
+    }
+    if (Count <= 0)
+    {
+        return 0;
+    }
+
+    Stats.PendingSpawns += Count;
+
+    UE_LOG(LogTemp, Verbose, TEXT("FISMRuntimeActorPool::QueueSpawns - Queued %d actors for %s (Pending: %d)"),
+        Count, *ActorClass->GetName(), Stats.PendingSpawns);
+
+    return Count;
+}
+
+int32 FISMRuntimeActorPool::ProcessSpawnQueue(double MaxSeconds)
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Pools);
+
+    if (!ValidateOperation(TEXT("ProcessSpawnQueue")))
+    {
+        return 0;
+    }
+
+    QueueLowWatermarkRefill();
+
+    if (Stats.PendingSpawns <= 0)
+    {
+        return 0;
+    }
+
+    const int32 MaxSpawns = PoolConfig->MaxSpawnsPerFrame;
+    double BudgetSeconds = PoolConfig->SpawnBudgetMs / 1000.0;
+    if (MaxSeconds > 0.0)
+    {
+        BudgetSeconds = BudgetSeconds > 0.0 ? FMath::Min(BudgetSeconds, MaxSeconds) : MaxSeconds;
+    }
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 MaxSize = GetMaxPoolSize();
+
+    int32 SpawnedCount = 0;
+    while (Stats.PendingSpawns > 0 && (MaxSpawns <= 0 || SpawnedCount < MaxSpawns))
+    {
+        // Always spawn at least one so a tight budget still drains the queue
+        if (SpawnedCount > 0 && BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+
+        if (MaxSize > 0 && Stats.TotalActors >= MaxSize)
+        {
+            Stats.PendingSpawns = 0;
+            break;
+        }
+
+        // A failed spawn still leaves the queue, otherwise it would be retried every frame
+        Stats.PendingSpawns--;
+        if (SpawnPoolActor(false))
+        {
+            Stats.TotalActors++;
+            SpawnedCount++;
+        }
+    }
+
+    Stats.AvailableActors = NumAvailable;
+    return SpawnedCount;
+}
+
 int32 FISMRuntimeActorPool::GrowPool(int32 Count)
 {
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::GrowPool);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolGrow);
+    LLM_SCOPE_BYTAG(ISMRuntime_Pools);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Grow);
+
     if (!ValidateOperation(TEXT("GrowPool")))
     {
         return 0;
@@ -258,7 +523,7 @@ int32 FISMRuntimeActorPool::GrowPool(int32 Count)
     if (!CanGrow())
     {
         UE_LOG(LogTemp, Warning, TEXT("FISMRuntimeActorPool::GrowPool - Cannot grow, MaxPoolSize reached (%d)"),
-            PoolConfig->MaxPoolSize);
+            GetMaxPoolSize());
         return 0;
     }
 
@@ -270,7 +535,7 @@ int32 FISMRuntimeActorPool::GrowPool(int32 Count)
 
     // Respect MaxPoolSize limit
     const int32 CurrentTotal = Stats.TotalActors;
-    const int32 MaxSize = PoolConfig->MaxPoolSize;
+    const int32 MaxSize = GetMaxPoolSize();
     if (MaxSize > 0 && CurrentTotal + Count > MaxSize)
     {
         Count = MaxSize - CurrentTotal;
@@ -283,16 +548,15 @@ int32 FISMRuntimeActorPool::GrowPool(int32 Count)
     int32 SpawnedCount = 0;
     for (int32 i = 0; i < Count; ++i)
     {
-        if (AActor* Actor = SpawnPoolActor(false))
+        if (SpawnPoolActor(false))
         {
-            AvailableActors.Add(Actor);
             SpawnedCount++;
         }
     }
 
     // Update stats
     Stats.TotalActors += SpawnedCount;
-    Stats.AvailableActors = AvailableActors.Num();
+    Stats.AvailableActors = NumAvailable;
 
     if (SpawnedCount > 0)
     {
@@ -328,29 +592,10 @@ int32 FISMRuntimeActorPool::ShrinkPool(bool bForceImmediate)
         return 0;
     }
 
-    int32 DestroyedCount = 0;
-
     // Only destroy available actors, never active ones
-    for (int32 i = AvailableActors.Num() - 1; i >= 0 && DestroyedCount < TargetDestroyCount; --i)
-    {
-        if (AActor* Actor = AvailableActors[i].Get())
-        {
-            // Call cleanup before destroying
-            if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
-            {
-                Poolable->Execute_OnPoolDestroyed(Actor);
-            }
-
-            Actor->Destroy();
-            DestroyedCount++;
-        }
-
-        AvailableActors.RemoveAt(i);
-    }
+    const int32 DestroyedCount = DestroyAvailable(TargetDestroyCount);
 
     // Update stats
-    Stats.TotalActors -= DestroyedCount;
-    Stats.AvailableActors = AvailableActors.Num();
     Stats.ShrinkCount++;
 
     if (DestroyedCount > 0)
@@ -362,31 +607,51 @@ int32 FISMRuntimeActorPool::ShrinkPool(bool bForceImmediate)
     return DestroyedCount;
 }
 
+int32 FISMRuntimeActorPool::TrimAvailable(int32 KeepAvailable)
+{
+    if (!ValidateOperation(TEXT("TrimAvailable")))
+    {
+        return 0;
+    }
+
+    const int32 DestroyedCount = DestroyAvailable(NumAvailable - FMath::Max(KeepAvailable, 0));
+    if (DestroyedCount > 0)
+    {
+        Stats.ShrinkCount++;
+
+        UE_LOG(LogTemp, Log, TEXT("FISMRuntimeActorPool::TrimAvailable - Destroyed %d unused actors (Total: %d)"),
+            DestroyedCount, Stats.TotalActors);
+    }
+
+    return DestroyedCount;
+}
+
 void FISMRuntimeActorPool::Cleanup()
 {
     UE_LOG(LogTemp, Log, TEXT("FISMRuntimeActorPool::Cleanup - Destroying pool with %d actors"), Stats.TotalActors);
 
     // Destroy all actors (both active and available)
-    auto DestroyActors = [](TArray<TWeakObjectPtr<AActor>>& Actors)
+    for (AActor* Actor : SlotActors)
+    {
+        if (::IsValid(Actor))
         {
-            for (TWeakObjectPtr<AActor>& ActorPtr : Actors)
+            // Call cleanup notification
+            if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
             {
-                if (AActor* Actor = ActorPtr.Get())
-                {
-                    // Call cleanup notification
-                    if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
-                    {
-                        Poolable->Execute_OnPoolDestroyed(Actor);
-                    }
-
-                    Actor->Destroy();
-                }
+                Poolable->Execute_OnPoolDestroyed(Actor);
             }
-            Actors.Empty();
-        };
 
-    DestroyActors(ActiveActors);
-    DestroyActors(AvailableActors);
+            Actor->Destroy();
+        }
+    }
+
+    SlotActors.Empty();
+    SlotStates.Empty();
+    SlotNext.Empty();
+    AvailableHead = INDEX_NONE;
+    VacantHead = INDEX_NONE;
+    NumAvailable = 0;
+    NumActive = 0;
 
     // Reset stats
     Stats = FISMPoolStats();
@@ -401,6 +666,26 @@ bool FISMRuntimeActorPool::IsValid() const
         OwningWorld.IsValid();
 }
 
+int32 FISMRuntimeActorPool::GetMaxPoolSize() const
+{
+    if (!PoolConfig.IsValid())
+    {
+        return 0;
+    }
+    return FISMPerformanceProfileSettings::ScaleLimit(PoolConfig->MaxPoolSize, FISMPerformanceProfiles::GetActive().PoolSizeScale);
+}
+
+int32 FISMRuntimeActorPool::GetInitialPoolSize() const
+{
+    if (!PoolConfig.IsValid())
+    {
+        return 0;
+    }
+    const int32 InitialSize = FISMPerformanceProfileSettings::ScaleLimit(PoolConfig->InitialPoolSize, FISMPerformanceProfiles::GetActive().PoolSizeScale);
+    const int32 MaxSize = GetMaxPoolSize();
+    return MaxSize > 0 ? FMath::Min(InitialSize, MaxSize) : InitialSize;
+}
+
 bool FISMRuntimeActorPool::CanGrow() const
 {
     if (!PoolConfig.IsValid())
@@ -408,7 +693,7 @@ bool FISMRuntimeActorPool::CanGrow() const
         return false;
     }
 
-    const int32 MaxSize = PoolConfig->MaxPoolSize;
+    const int32 MaxSize = GetMaxPoolSize();
     if (MaxSize <= 0)
     {
         return true; // Unlimited growth
@@ -444,10 +729,197 @@ int32 FISMRuntimeActorPool::GetShrinkCandidateCount() const
     return FMath::Max(0, ExcessCount);
 }
 
+// ===== Slot Storage =====
+
+void FISMRuntimeActorPool::AddSlot(AActor* Actor)
+{
+    int32 Slot = VacantHead;
+    if (Slot != INDEX_NONE)
+    {
+        VacantHead = SlotNext[Slot];
+        SlotActors[Slot] = Actor;
+    }
+    else
+    {
+        Slot = SlotActors.Add(Actor);
+        SlotStates.Add(EISMPoolSlotState::Vacant);
+        SlotNext.Add(INDEX_NONE);
+    }
+
+    UISMPoolSlotComponent* Tag = UISMPoolSlotComponent::Find(Actor);
+    if (!Tag)
+    {
+        // Never registered: it only has to be findable through the actor's owned components
+        Tag = NewObject<UISMPoolSlotComponent>(Actor, NAME_None, RF_Transient);
+    }
+    Tag->PoolId = PoolId;
+    Tag->PoolClass = ActorClass;
+    Tag->SlotIndex = Slot;
+
+    SlotStates[Slot] = EISMPoolSlotState::Active;
+    NumActive++;
+    PushAvailableSlot(Slot);
+}
+
+int32 FISMRuntimeActorPool::PopAvailableSlot()
+{
+    const int32 Slot = AvailableHead;
+    if (Slot == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    AvailableHead = SlotNext[Slot];
+    SlotNext[Slot] = INDEX_NONE;
+    SlotStates[Slot] = EISMPoolSlotState::Active;
+    NumAvailable--;
+    NumActive++;
+    return Slot;
+}
+
+void FISMRuntimeActorPool::PushAvailableSlot(int32 Slot)
+{
+    check(SlotStates[Slot] == EISMPoolSlotState::Active);
+
+    SlotStates[Slot] = EISMPoolSlotState::Available;
+    SlotNext[Slot] = AvailableHead;
+    AvailableHead = Slot;
+    NumActive--;
+    NumAvailable++;
+}
+
+void FISMRuntimeActorPool::VacateSlot(int32 Slot)
+{
+    if (SlotStates[Slot] == EISMPoolSlotState::Active)
+    {
+        NumActive--;
+    }
+
+    SlotActors[Slot] = nullptr;
+    SlotStates[Slot] = EISMPoolSlotState::Vacant;
+    SlotNext[Slot] = VacantHead;
+    VacantHead = Slot;
+}
+
+int32 FISMRuntimeActorPool::FindSlot(const AActor* Actor) const
+{
+    const UISMPoolSlotComponent* Tag = UISMPoolSlotComponent::Find(Actor);
+    if (!Tag || Tag->PoolId != PoolId || !SlotActors.IsValidIndex(Tag->SlotIndex))
+    {
+        return INDEX_NONE;
+    }
+
+    // The tag survives the actor leaving the pool; the slot must still hold it
+    return SlotActors[Tag->SlotIndex] == Actor ? Tag->SlotIndex : INDEX_NONE;
+}
+
+int32 FISMRuntimeActorPool::DestroyAvailable(int32 MaxCount)
+{
+    int32 DestroyedCount = 0;
+    int32 RemovedCount = 0;
+
+    while (RemovedCount < MaxCount && AvailableHead != INDEX_NONE)
+    {
+        const int32 Slot = PopAvailableSlot();
+        AActor* Actor = SlotActors[Slot];
+        if (::IsValid(Actor))
+        {
+            // Call cleanup before destroying
+            if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
+            {
+                Poolable->Execute_OnPoolDestroyed(Actor);
+            }
+
+            Actor->Destroy();
+            DestroyedCount++;
+        }
+
+        VacateSlot(Slot);
+        RemovedCount++;
+    }
+
+    Stats.TotalActors = NumActive + NumAvailable;
+    Stats.ActiveActors = NumActive;
+    Stats.AvailableActors = NumAvailable;
+    return DestroyedCount;
+}
+
 // ===== Internal Helpers =====
 
+void FISMRuntimeActorPool::EstimateActorCost(AActor* Actor)
+{
+    if (PoolConfig.IsValid() && PoolConfig->EstimatedActorCostKB > 0.0f)
+    {
+        Stats.EstimatedBytesPerActor = static_cast<int64>(PoolConfig->EstimatedActorCostKB * 1024.0f);
+        return;
+    }
+
+    // Object sizes plus whatever the actor and its components report as their own resources;
+    // shared assets such as meshes are not counted
+    FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+    int64 ObjectBytes = Actor->GetClass()->GetStructureSize();
+    Actor->GetResourceSizeEx(ResourceSize);
+
+    for (UActorComponent* Component : Actor->GetComponents())
+    {
+        if (Component)
+        {
+            ObjectBytes += Component->GetClass()->GetStructureSize();
+            Component->GetResourceSizeEx(ResourceSize);
+        }
+    }
+
+    Stats.EstimatedBytesPerActor = FMath::Max<int64>(ObjectBytes + static_cast<int64>(ResourceSize.GetTotalMemoryBytes()), 1);
+}
+
+int32 FISMRuntimeActorPool::PublishFrameCounters()
+{
+    const int32 Misses = FrameMisses;
+    FrameMisses = 0;
+
+#if CSV_PROFILER
+    if (!ActorClass)
+    {
+        return Misses;
+    }
+
+    if (CsvActiveStatName.IsNone())
+    {
+        const FString ClassName = ActorClass->GetName();
+        CsvActiveStatName = FName(*(ClassName + TEXT("_Active")));
+        CsvAvailableStatName = FName(*(ClassName + TEXT("_Available")));
+        CsvMissesStatName = FName(*(ClassName + TEXT("_Misses")));
+    }
+
+    FCsvProfiler::RecordCustomStat(CsvActiveStatName, CSV_CATEGORY_INDEX(ISMPools), NumActive, ECsvCustomStatOp::Set);
+    FCsvProfiler::RecordCustomStat(CsvAvailableStatName, CSV_CATEGORY_INDEX(ISMPools), NumAvailable, ECsvCustomStatOp::Set);
+    FCsvProfiler::RecordCustomStat(CsvMissesStatName, CSV_CATEGORY_INDEX(ISMPools), Misses, ECsvCustomStatOp::Set);
+#endif
+
+    return Misses;
+}
+
+void FISMRuntimeActorPool::QueueLowWatermarkRefill()
+{
+    if (!PoolConfig.IsValid() || !PoolConfig->IsSpawnTimeSliced())
+    {
+        return;
+    }
+
+    const int32 Watermark = FMath::Max(PoolConfig->RefillLowWatermark, 1);
+    if (NumAvailable + Stats.PendingSpawns < Watermark && QueueSpawns() > 0)
+    {
+        Stats.GrowCount++;
+    }
+}
+
 AActor* FISMRuntimeActorPool::SpawnPoolActor(bool bIsPreWarm)
 {
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::SpawnPoolActor);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolSpawn);
+    LLM_SCOPE_BYTAG(ISMRuntime_Pools);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Spawn);
+
     UWorld* World = OwningWorld.Get();
     if (!World)
     {
@@ -476,10 +948,23 @@ AActor* FISMRuntimeActorPool::SpawnPoolActor(bool bIsPreWarm)
         return nullptr;
     }
 
-    AllActors.Add(Actor);
+    // Tag before OnPoolSpawned so the actor can already be returned or looked up
+    AddSlot(Actor);
+
+    if (Stats.EstimatedBytesPerActor == 0)
+    {
+        EstimateActorCost(Actor);
+    }
 
     // Apply default reset to ensure clean state
-    ApplyDefaultReset(Actor);
+    if (PoolConfig.IsValid() && PoolConfig->bUseDormantReset)
+    {
+        ApplyDormantReset(Actor);
+    }
+    else
+    {
+        ApplyDefaultReset(Actor);
+    }
 
     // Call OnPoolSpawned if actor implements IISMPoolable
     if (IISMPoolable* Poolable = Cast<IISMPoolable>(Actor))
@@ -492,11 +977,21 @@ AActor* FISMRuntimeActorPool::SpawnPoolActor(bool bIsPreWarm)
 
 void FISMRuntimeActorPool::ResetActor(AActor* Actor)
 {
+    ISM_TRACE_SCOPE(FISMRuntimeActorPool::ResetActor);
+    SCOPE_CYCLE_COUNTER(STAT_ISMPoolReset);
+    CSV_SCOPED_TIMING_STAT(ISMPools, Reset);
+
     if (!Actor)
     {
         return;
     }
 
+    if (PoolConfig.IsValid() && PoolConfig->bUseDormantReset)
+    {
+        ApplyDormantReset(Actor);
+        return;
+    }
+
     // If actor implements IISMPoolable, it handled its own reset in OnReturnedToPool
     // Just apply default reset for safety
     if (!Actor->Implements<UISMPoolable>())
@@ -545,25 +1040,82 @@ void FISMRuntimeActorPool::ApplyDefaultReset(AActor* Actor)
     Actor->SetActorTickEnabled(false);
 }
 
+void FISMRuntimeActorPool::ApplyDormantReset(AActor* Actor)
+{
+    if (!Actor)
+    {
+        return;
+    }
+
+    // Each setter below marks render or physics state dirty even when nothing changes, so only
+    // flip what is not already dormant
+    Actor->ForEachComponent<UPrimitiveComponent>(false, [](UPrimitiveComponent* Primitive)
+        {
+            if (Primitive->IsSimulatingPhysics())
+            {
+                Primitive->SetPhysicsLinearVelocity(FVector::ZeroVector);
+                Primitive->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+                Primitive->SetSimulatePhysics(false);
+            }
+            if (Primitive->IsAnyRigidBodyAwake())
+            {
+                Primitive->PutAllRigidBodiesToSleep();
+            }
+        });
+
+    // Actor-level collision flag only updates filter data; the bodies stay in the scene
+    if (Actor->GetActorEnableCollision())
+    {
+        Actor->SetActorEnableCollision(false);
+    }
+
+    if (!Actor->IsHidden())
+    {
+        Actor->SetActorHiddenInGame(true);
+    }
+
+    if (Actor->IsActorTickEnabled())
+    {
+        Actor->SetActorTickEnabled(false);
+    }
+}
+
 void FISMRuntimeActorPool::UpdateStats()
 {
-    Stats.ActiveActors = ActiveActors.Num();
-    Stats.AvailableActors = AvailableActors.Num();
+    Stats.ActiveActors = NumActive;
+    Stats.AvailableActors = NumAvailable;
     Stats.TotalActors = Stats.ActiveActors + Stats.AvailableActors;
 }
 
 void FISMRuntimeActorPool::CleanupInvalidActors()
 {
-    // Remove null weak pointers from both arrays
-    AvailableActors.RemoveAll([](const TWeakObjectPtr<AActor>& ActorPtr)
+    // A destroyed available actor can sit anywhere in the singly linked list, so rebuild it
+    AvailableHead = INDEX_NONE;
+    NumAvailable = 0;
+    NumActive = 0;
+
+    for (int32 Slot = SlotActors.Num() - 1; Slot >= 0; --Slot)
+    {
+        if (SlotStates[Slot] == EISMPoolSlotState::Vacant)
         {
-            return !ActorPtr.IsValid();
-        });
+            continue;
+        }
 
-    ActiveActors.RemoveAll([](const TWeakObjectPtr<AActor>& ActorPtr)
+        if (!::IsValid(SlotActors[Slot]))
         {
-            return !ActorPtr.IsValid();
-        });
+            VacateSlot(Slot);
+        }
+        else if (SlotStates[Slot] == EISMPoolSlotState::Available)
+        {
+            SlotNext[Slot] = AvailableHead;
+            AvailableHead = Slot;
+            NumAvailable++;
+        }
+        else
+        {
+            NumActive++;
+        }
+    }
 
     // Update stats after cleanup
     UpdateStats();
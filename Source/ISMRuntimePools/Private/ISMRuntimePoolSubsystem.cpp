@@ -1,10 +1,16 @@
 #include "ISMRuntimePoolSubsystem.h"
+#include "ISMPoolSlotComponent.h"
+#include "ISMPoolProfiling.h"
 #include "ISMPoolDataAsset.h"
 #include "Interfaces/ISMPoolable.h"
 #include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMFrameBudget.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
+const FName UISMRuntimePoolSubsystem::FrameBudgetClient(TEXT("ActorPools"));
+
 // ===== Subsystem Lifecycle =====
 
 void UISMRuntimePoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -19,6 +25,15 @@ void UISMRuntimePoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     {
         StartCleanupTimer();
     }
+
+    // Report pool memory in the runtime subsystem's stats and ISM.MemReport
+    if (UISMRuntimeSubsystem* RuntimeSubsystem = Collection.InitializeDependency<UISMRuntimeSubsystem>())
+    {
+        GatherMemoryStatsHandle = RuntimeSubsystem->OnGatherMemoryStats.AddUObject(this, &UISMRuntimePoolSubsystem::GatherMemoryStats);
+    }
+
+    // Pools read their scaled sizes on demand; a switch only needs to shed what no longer fits
+    PerformanceProfileHandle = FISMPerformanceProfiles::OnProfileChanged().AddUObject(this, &UISMRuntimePoolSubsystem::HandlePerformanceProfileChanged);
 }
 
 void UISMRuntimePoolSubsystem::Deinitialize()
@@ -28,11 +43,20 @@ void UISMRuntimePoolSubsystem::Deinitialize()
     // Stop cleanup timer
     StopCleanupTimer();
 
+    if (UISMRuntimeSubsystem* RuntimeSubsystem = GetWorld()->GetSubsystem<UISMRuntimeSubsystem>())
+    {
+        RuntimeSubsystem->OnGatherMemoryStats.Remove(GatherMemoryStatsHandle);
+    }
+    GatherMemoryStatsHandle.Reset();
+    FISMPerformanceProfiles::OnProfileChanged().Remove(PerformanceProfileHandle);
+    PerformanceProfileHandle.Reset();
+
     // Destroy all pools
     DestroyAllPools();
 
     // Clear registered components
     RegisteredComponents.Empty();
+    ComponentPoolClasses.Empty();
 
     Super::Deinitialize();
 }
@@ -43,6 +67,177 @@ bool UISMRuntimePoolSubsystem::DoesSupportWorldType(EWorldType::Type WorldType)
     return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
 }
 
+void UISMRuntimePoolSubsystem::Tick(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(ISMRuntime_Pools);
+
+    // Returns first so this frame's returned actors count as available below
+    FlushDeferredReturns();
+
+    // Sample demand before draining so a predictive grow starts spawning this frame
+    if (AdaptiveSizingConfig.bEnableAdaptiveSizing)
+    {
+        AdaptiveSampleAccumulator += DeltaTime;
+        if (AdaptiveSampleAccumulator >= AdaptiveSizingConfig.SampleInterval)
+        {
+            const float SampleSeconds = AdaptiveSampleAccumulator;
+            AdaptiveSampleAccumulator = 0.0f;
+
+            for (auto& Pair : ActorPools)
+            {
+                if (Pair.Value.IsValid())
+                {
+                    ApplyAdaptiveSizing(Pair.Value, SampleSeconds);
+                }
+            }
+        }
+    }
+
+    // Spawning and cleanup are housekeeping; the shared frame budget holds them back when it runs short
+    FISMFrameBudgetScope Budget(FISMFrameBudgetGovernor::Get(GetWorld()), FrameBudgetClient, EISMFrameBudgetPriority::Low);
+    for (auto& Pair : ActorPools)
+    {
+        FISMRuntimeActorPool& Pool = Pair.Value;
+        if (!Pool.IsValid() || !Pool.PoolConfig->IsSpawnTimeSliced())
+        {
+            continue;
+        }
+
+        if (!Budget.HasTime())
+        {
+            Budget.Defer(Pool.Stats.PendingSpawns);
+            continue;
+        }
+        Pool.ProcessSpawnQueue(Budget.ClampBudgetSeconds(0.0));
+    }
+
+    if (bCleanupDeferred)
+    {
+        if (Budget.HasTime())
+        {
+            bCleanupDeferred = false;
+            RunPeriodicCleanup();
+        }
+        else
+        {
+            Budget.Defer(1);
+        }
+    }
+
+    if (BudgetConfig.bEnableBudget)
+    {
+        EnforcePoolBudget();
+    }
+
+    if (StreamingConfig.bReleaseOrphanedPools)
+    {
+        ReleaseOrphanedPools();
+    }
+
+    PublishFrameCounters();
+}
+
+void UISMRuntimePoolSubsystem::PublishFrameCounters()
+{
+    int32 TotalActive = 0;
+    int32 TotalAvailable = 0;
+    int32 TotalMisses = 0;
+
+    for (auto& Pair : ActorPools)
+    {
+        FISMRuntimeActorPool& Pool = Pair.Value;
+        TotalActive += Pool.GetNumActive();
+        TotalAvailable += Pool.GetNumAvailable();
+        TotalMisses += Pool.PublishFrameCounters();
+    }
+
+    SET_DWORD_STAT(STAT_ISMPoolActiveActors, TotalActive);
+    SET_DWORD_STAT(STAT_ISMPoolAvailableActors, TotalAvailable);
+    SET_DWORD_STAT(STAT_ISMPoolMisses, TotalMisses);
+    CSV_CUSTOM_STAT(ISMPools, TotalActive, TotalActive, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ISMPools, TotalAvailable, TotalAvailable, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ISMPools, TotalMisses, TotalMisses, ECsvCustomStatOp::Set);
+}
+
+bool UISMRuntimePoolSubsystem::IsOverBudget(int32 TotalActors, int64 TotalBytes) const
+{
+    const int64 MaxBytes = static_cast<int64>(BudgetConfig.MaxTotalMemoryMB * 1024.0 * 1024.0);
+    return (BudgetConfig.MaxTotalActors > 0 && TotalActors > BudgetConfig.MaxTotalActors)
+        || (MaxBytes > 0 && TotalBytes > MaxBytes);
+}
+
+int32 UISMRuntimePoolSubsystem::EnforcePoolBudget()
+{
+    int32 TotalActors = 0;
+    int64 TotalBytes = 0;
+    for (const auto& Pair : ActorPools)
+    {
+        TotalActors += Pair.Value.Stats.TotalActors;
+        TotalBytes += Pair.Value.Stats.GetEstimatedMemoryBytes();
+    }
+
+    if (!IsOverBudget(TotalActors, TotalBytes))
+    {
+        return 0;
+    }
+
+    // Coldest first: the pool requested from longest ago gives up its available actors first
+    TArray<FISMRuntimeActorPool*, TInlineAllocator<16>> Candidates;
+    for (auto& Pair : ActorPools)
+    {
+        if (Pair.Value.IsValid() && Pair.Value.GetNumAvailable() > 0)
+        {
+            Candidates.Add(&Pair.Value);
+        }
+    }
+    Candidates.Sort([](const FISMRuntimeActorPool& A, const FISMRuntimeActorPool& B)
+        {
+            return A.Stats.LastAccessFrame < B.Stats.LastAccessFrame;
+        });
+
+    const int64 MaxBytes = static_cast<int64>(BudgetConfig.MaxTotalMemoryMB * 1024.0 * 1024.0);
+    const int32 EvictionCap = BudgetConfig.MaxEvictionsPerTick > 0 ? BudgetConfig.MaxEvictionsPerTick : MAX_int32;
+    int32 Evicted = 0;
+
+    for (FISMRuntimeActorPool* Pool : Candidates)
+    {
+        if (Evicted >= EvictionCap || !IsOverBudget(TotalActors, TotalBytes))
+        {
+            break;
+        }
+
+        // Actors this pool must give up to meet whichever limit is further over
+        const int64 BytesPerActor = FMath::Max<int64>(Pool->Stats.EstimatedBytesPerActor, 1);
+        int64 Needed = BudgetConfig.MaxTotalActors > 0 ? TotalActors - BudgetConfig.MaxTotalActors : 0;
+        if (MaxBytes > 0 && TotalBytes > MaxBytes)
+        {
+            Needed = FMath::Max(Needed, FMath::DivideAndRoundUp(TotalBytes - MaxBytes, BytesPerActor));
+        }
+
+        const int32 ToEvict = static_cast<int32>(FMath::Min3<int64>(Needed, Pool->GetNumAvailable(), EvictionCap - Evicted));
+        if (ToEvict <= 0)
+        {
+            continue;
+        }
+
+        const int32 Destroyed = Pool->TrimAvailable(Pool->GetNumAvailable() - ToEvict);
+        Evicted += Destroyed;
+        TotalActors -= Destroyed;
+        TotalBytes -= Destroyed * Pool->Stats.EstimatedBytesPerActor;
+    }
+
+    if (Evicted > 0)
+    {
+        BudgetEvictions += Evicted;
+        GlobalStatsUpdateFrame = 0;
+
+        UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::EnforcePoolBudget - Evicted %d actors (Total: %d, %.1f MB)"),
+            Evicted, TotalActors, TotalBytes / (1024.0 * 1024.0));
+    }
+
+    return Evicted;
+}
+
 // ===== Pool Management =====
 
 FISMRuntimeActorPool* UISMRuntimePoolSubsystem::GetOrCreatePool(TSubclassOf<AActor> ActorClass, UISMPoolDataAsset* Config)
@@ -146,6 +341,8 @@ void UISMRuntimePoolSubsystem::DestroyAllPools()
 {
     UE_LOG(LogTemp, Log, TEXT("UISMRuntimePoolSubsystem::DestroyAllPools - Destroying %d pools"), ActorPools.Num());
 
+    DeferredReturns.Empty();
+
     // Cleanup all pools
     for (auto& Pair : ActorPools)
     {
@@ -194,6 +391,28 @@ AActor* UISMRuntimePoolSubsystem::RequestActor(TSubclassOf<AActor> ActorClass, U
     return Actor;
 }
 
+int32 UISMRuntimePoolSubsystem::RequestActors(TSubclassOf<AActor> ActorClass, UISMPoolDataAsset* DataAsset,
+    TConstArrayView<FISMInstanceHandle> InstanceHandles, TArray<AActor*>& OutActors)
+{
+    OutActors.Reset();
+
+    if (!ActorClass || !DataAsset)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UISMRuntimePoolSubsystem::RequestActors - ActorClass or DataAsset is null"));
+        return 0;
+    }
+
+    FISMRuntimeActorPool* Pool = GetOrCreatePool(ActorClass, DataAsset);
+    if (!Pool)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UISMRuntimePoolSubsystem::RequestActors - Failed to get or create pool for %s"),
+            *ActorClass->GetName());
+        return 0;
+    }
+
+    return Pool->RequestActors(DataAsset, InstanceHandles, OutActors);
+}
+
 bool UISMRuntimePoolSubsystem::ReturnActor(AActor* Actor, FTransform& OutFinalTransform, bool& bUpdateTransform)
 {
     if (!Actor)
@@ -222,26 +441,89 @@ FISMRuntimeActorPool* UISMRuntimePoolSubsystem::FindPoolForActor(AActor* Actor)
         return nullptr;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("FindPoolForActor: Looking for %s (Class: %s), Pools: %d"),
-        *Actor->GetName(), *Actor->GetClass()->GetName(), ActorPools.Num());
+    // Pools stamp their key on every actor they spawn
+    const UISMPoolSlotComponent* Tag = UISMPoolSlotComponent::Find(Actor);
+    if (!Tag)
+    {
+        return nullptr;
+    }
 
-    for (auto& Pair : ActorPools)
+    FISMRuntimeActorPool* Pool = ActorPools.Find(Tag->PoolClass);
+    return Pool && Pool->ContainsActor(Actor) ? Pool : nullptr;
+}
+
+int32 UISMRuntimePoolSubsystem::ReturnActors(const TArray<AActor*>& Actors)
+{
+    // Group by pool so each pool notifies and resets its actors in one pass
+    TArray<TPair<FISMRuntimeActorPool*, AActor*>, TInlineAllocator<32>> ByPool;
+    for (AActor* Actor : Actors)
     {
-        UE_LOG(LogTemp, Warning, TEXT("  Pool key class: %s, ContainsActor: %s"),
-            *Pair.Key->GetName(),
-            Pair.Value.ContainsActor(Actor) ? TEXT("YES") : TEXT("NO"));
+        if (FISMRuntimeActorPool* Pool = FindPoolForActor(Actor))
+        {
+            ByPool.Emplace(Pool, Actor);
+        }
+        else if (Actor)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("UISMRuntimePoolSubsystem::ReturnActors - Could not find pool for actor %s"),
+                *Actor->GetName());
+        }
     }
 
-    // Search all pools for this actor
-    for (auto& Pair : ActorPools)
+    ByPool.StableSort([](const TPair<FISMRuntimeActorPool*, AActor*>& A, const TPair<FISMRuntimeActorPool*, AActor*>& B)
+        {
+            return A.Key < B.Key;
+        });
+
+    int32 TotalReturned = 0;
+    TArray<AActor*, TInlineAllocator<32>> Group;
+    for (int32 i = 0; i < ByPool.Num();)
+    {
+        FISMRuntimeActorPool* Pool = ByPool[i].Key;
+        Group.Reset();
+        for (; i < ByPool.Num() && ByPool[i].Key == Pool; ++i)
+        {
+            Group.Add(ByPool[i].Value);
+        }
+        TotalReturned += Pool->ReturnActors(Group);
+    }
+
+    return TotalReturned;
+}
+
+void UISMRuntimePoolSubsystem::DeferReturnActor(AActor* Actor)
+{
+    if (!Actor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UISMRuntimePoolSubsystem::DeferReturnActor - Actor is null"));
+        return;
+    }
+
+    // Out of sight now; the full reset runs with the batch
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    DeferredReturns.Add(Actor);
+}
+
+int32 UISMRuntimePoolSubsystem::FlushDeferredReturns()
+{
+    if (DeferredReturns.Num() == 0)
+    {
+        return 0;
+    }
+
+    // Swap out first: a return callback may defer another actor
+    TArray<AActor*> Batch;
+    Batch.Reserve(DeferredReturns.Num());
+    for (AActor* Actor : DeferredReturns)
     {
-        if (Pair.Value.ContainsActor(Actor))
+        if (::IsValid(Actor))
         {
-            return &Pair.Value;
+            Batch.Add(Actor);
         }
     }
+    DeferredReturns.Reset();
 
-    return nullptr;
+    return ReturnActors(Batch);
 }
 
 // ===== Statistics =====
@@ -323,7 +605,7 @@ int32 UISMRuntimePoolSubsystem::CleanupStalePools()
     {
         const FISMPoolStats& Stats = Pair.Value.GetStats();
         const uint64 FramesSinceLastAccess = CurrentFrame - Stats.LastAccessFrame;
-        if(Pair.Value.ActiveActors.Num() > 0)
+        if(Pair.Value.GetNumActive() > 0)
         {
             continue; // Skip pools that are still active
 		}
@@ -363,6 +645,39 @@ int32 UISMRuntimePoolSubsystem::ShrinkAllPools()
     return TotalDestroyed;
 }
 
+void UISMRuntimePoolSubsystem::SetAdaptiveSizingConfig(const FISMPoolAdaptiveSizingConfig& NewConfig)
+{
+    // Restart telemetry so the first sample after enabling does not see every past request at once
+    if (NewConfig.bEnableAdaptiveSizing && !AdaptiveSizingConfig.bEnableAdaptiveSizing)
+    {
+        for (auto& Pair : ActorPools)
+        {
+            Pair.Value.Demand = FISMPoolDemandStats();
+            Pair.Value.Demand.LastSampleRequests = Pair.Value.Stats.TotalRequests;
+        }
+        AdaptiveSampleAccumulator = 0.0f;
+    }
+
+    AdaptiveSizingConfig = NewConfig;
+}
+
+bool UISMRuntimePoolSubsystem::GetPoolDemand(TSubclassOf<AActor> ActorClass, FISMPoolDemandStats& OutDemand) const
+{
+    if (!ActorClass)
+    {
+        return false;
+    }
+
+    const FISMRuntimeActorPool* Pool = ActorPools.Find(ActorClass);
+    if (!Pool)
+    {
+        return false;
+    }
+
+    OutDemand = Pool->Demand;
+    return true;
+}
+
 void UISMRuntimePoolSubsystem::SetCleanupConfig(const FISMPoolCleanupConfig& NewConfig)
 {
     const bool bWasEnabled = CleanupConfig.bEnableStalePoolCleanup;
@@ -403,6 +718,33 @@ void UISMRuntimePoolSubsystem::RegisterComponent(UISMRuntimeComponent* Component
 
     UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::RegisterComponent - Registered component %s (Total: %d)"),
         *Component->GetName(), RegisteredComponents.Num());
+
+    UISMPoolDataAsset* Config = Cast<UISMPoolDataAsset>(Component->InstanceData);
+    if (!Config || !Config->bEnablePooling || ComponentPoolClasses.Contains(Component))
+    {
+        return;
+    }
+
+    const TSubclassOf<AActor> ActorClass = Config->GetPoolClass();
+    const bool bPoolExisted = HasPool(ActorClass);
+    FISMRuntimeActorPool* Pool = GetOrCreatePool(ActorClass, Config);
+    if (!Pool)
+    {
+        return;
+    }
+
+    ComponentPoolClasses.Add(Component, ActorClass);
+    Pool->Stats.RegisteredUsers++;
+
+    // A pool that outlived its previous region hands its idle actors to this one
+    if (bPoolExisted && Pool->OrphanedTime >= 0.0)
+    {
+        Pool->Stats.HandoffActors += Pool->GetNumAvailable();
+
+        UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::RegisterComponent - %s took over %d idle %s actors"),
+            *Component->GetName(), Pool->GetNumAvailable(), *ActorClass->GetName());
+    }
+    Pool->OrphanedTime = -1.0;
 }
 
 void UISMRuntimePoolSubsystem::UnregisterComponent(UISMRuntimeComponent* Component)
@@ -414,10 +756,93 @@ void UISMRuntimePoolSubsystem::UnregisterComponent(UISMRuntimeComponent* Compone
 
     RegisteredComponents.Remove(Component);
 
+    TSubclassOf<AActor> ActorClass;
+    if (ComponentPoolClasses.RemoveAndCopyValue(Component, ActorClass))
+    {
+        ReleasePoolUser(ActorClass);
+    }
+
     UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::UnregisterComponent - Unregistered component %s (Total: %d)"),
         *Component->GetName(), RegisteredComponents.Num());
 }
 
+void UISMRuntimePoolSubsystem::ReleasePoolUser(TSubclassOf<AActor> ActorClass)
+{
+    FISMRuntimeActorPool* Pool = GetPool(ActorClass);
+    if (!Pool || Pool->Stats.RegisteredUsers <= 0)
+    {
+        return;
+    }
+
+    if (--Pool->Stats.RegisteredUsers == 0)
+    {
+        const UWorld* World = GetWorld();
+        Pool->OrphanedTime = World ? World->GetTimeSeconds() : 0.0;
+
+        UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::ReleasePoolUser - Last user of %s unregistered"),
+            *ActorClass->GetName());
+    }
+}
+
+void UISMRuntimePoolSubsystem::RemoveStaleComponents()
+{
+    TArray<TSubclassOf<AActor>, TInlineAllocator<8>> Released;
+    for (auto It = ComponentPoolClasses.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            Released.Add(It.Value());
+            It.RemoveCurrent();
+        }
+    }
+
+    for (TSubclassOf<AActor> ActorClass : Released)
+    {
+        ReleasePoolUser(ActorClass);
+    }
+}
+
+int32 UISMRuntimePoolSubsystem::ReleaseOrphanedPools()
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0;
+    }
+
+    RemoveStaleComponents();
+
+    const double Now = World->GetTimeSeconds();
+    TArray<TSubclassOf<AActor>, TInlineAllocator<8>> PoolsToDestroy;
+
+    for (auto& Pair : ActorPools)
+    {
+        FISMRuntimeActorPool& Pool = Pair.Value;
+        if (Pool.OrphanedTime < 0.0 || Now - Pool.OrphanedTime < StreamingConfig.OrphanGraceSeconds)
+        {
+            continue;
+        }
+
+        // Nobody is left to request from this pool, so stop refilling it too
+        Pool.Stats.PendingSpawns = 0;
+        Pool.TrimAvailable(0);
+
+        if (Pool.GetNumActive() == 0)
+        {
+            PoolsToDestroy.Add(Pair.Key);
+        }
+    }
+
+    for (TSubclassOf<AActor> ActorClass : PoolsToDestroy)
+    {
+        UE_LOG(LogTemp, Log, TEXT("UISMRuntimePoolSubsystem::ReleaseOrphanedPools - Destroying orphaned pool for %s"),
+            *ActorClass->GetName());
+        DestroyPool(ActorClass);
+    }
+
+    return PoolsToDestroy.Num();
+}
+
 TArray<UISMRuntimeComponent*> UISMRuntimePoolSubsystem::GetRegisteredComponents() const
 {
     TArray<UISMRuntimeComponent*> ValidComponents;
@@ -471,21 +896,134 @@ void UISMRuntimePoolSubsystem::StopCleanupTimer()
 
 void UISMRuntimePoolSubsystem::OnCleanupTimer()
 {
-    UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::OnCleanupTimer - Running periodic cleanup"));
+    FISMFrameBudgetScope Budget(FISMFrameBudgetGovernor::Get(GetWorld()), FrameBudgetClient, EISMFrameBudgetPriority::Low);
+    if (!Budget.HasTime())
+    {
+        bCleanupDeferred = true;
+        Budget.Defer(1);
+        return;
+    }
+
+    bCleanupDeferred = false;
+    RunPeriodicCleanup();
+}
+
+void UISMRuntimePoolSubsystem::RunPeriodicCleanup()
+{
+    UE_LOG(LogTemp, Verbose, TEXT("UISMRuntimePoolSubsystem::RunPeriodicCleanup - Running periodic cleanup"));
 
     // Cleanup stale pools
     const int32 DestroyedPools = CleanupStalePools();
 
-    // Optionally shrink pools
-    const int32 DestroyedActors = ShrinkAllPools();
+    // Optionally shrink pools; adaptive sizing does its own demand-aware shrinking
+    const int32 DestroyedActors = AdaptiveSizingConfig.bEnableAdaptiveSizing ? 0 : ShrinkAllPools();
 
     if (DestroyedPools > 0 || DestroyedActors > 0)
     {
-        UE_LOG(LogTemp, Log, TEXT("UISMRuntimePoolSubsystem::OnCleanupTimer - Destroyed %d pools, %d actors"),
+        UE_LOG(LogTemp, Log, TEXT("UISMRuntimePoolSubsystem::RunPeriodicCleanup - Destroyed %d pools, %d actors"),
             DestroyedPools, DestroyedActors);
     }
 }
 
+void UISMRuntimePoolSubsystem::ApplyAdaptiveSizing(FISMRuntimeActorPool& Pool, float SampleSeconds)
+{
+    const FISMPoolAdaptiveSizingConfig& Config = AdaptiveSizingConfig;
+    FISMPoolDemandStats& Demand = Pool.Demand;
+    FISMPoolStats& Stats = Pool.Stats;
+
+    if (SampleSeconds <= 0.0f)
+    {
+        return;
+    }
+
+    // Requests can go backwards only if the pool's stats were reset
+    const int32 NewRequests = FMath::Max(0, Stats.TotalRequests - Demand.LastSampleRequests);
+    Demand.LastSampleRequests = Stats.TotalRequests;
+    const float Rate = NewRequests / SampleSeconds;
+
+    // Half-life smoothing, independent of the sample interval
+    constexpr float Ln2 = 0.69314718f;
+    const float AverageAlpha = 1.0f - FMath::Exp(-SampleSeconds * Ln2 / Config.AverageHalfLife);
+    const float PeakDecay = FMath::Exp(-SampleSeconds * Ln2 / Config.PeakHalfLife);
+    Demand.AverageRequestRate += (Rate - Demand.AverageRequestRate) * AverageAlpha;
+    Demand.PeakRequestRate = FMath::Max(Rate,
+        Demand.AverageRequestRate + (Demand.PeakRequestRate - Demand.AverageRequestRate) * PeakDecay);
+
+    Demand.QuietSeconds = Rate > Demand.AverageRequestRate ? 0.0f : Demand.QuietSeconds + SampleSeconds;
+    Demand.TargetAvailable = FMath::CeilToInt(Demand.PeakRequestRate * Config.LeadTimeSeconds);
+
+    const UISMPoolDataAsset* PoolConfig = Pool.PoolConfig.Get();
+    const int32 Available = Pool.GetNumAvailable();
+    const int32 Ready = Available + Stats.PendingSpawns;
+
+    // Grow ahead of demand, in PoolGrowSize steps so a small shortfall does not spawn one actor per sample
+    if (Ready < Demand.TargetAvailable && Pool.CanGrow())
+    {
+        const int32 Shortfall = FMath::Max(Demand.TargetAvailable - Ready, PoolConfig->PoolGrowSize);
+        const int32 Grown = PoolConfig->IsSpawnTimeSliced() ? Pool.QueueSpawns(Shortfall) : Pool.GrowPool(Shortfall);
+        if (Grown > 0)
+        {
+            Demand.PredictiveGrows++;
+            Stats.GrowCount++;
+        }
+        return;
+    }
+
+    // Shrink only after a quiet period, and only the surplus beyond the hysteresis band
+    if (!PoolConfig->bAllowPoolShrinking || Demand.QuietSeconds < Config.QuietSecondsBeforeShrink)
+    {
+        return;
+    }
+
+    const int32 KeepAvailable = FMath::Max(
+        FMath::CeilToInt(Demand.TargetAvailable * Config.ShrinkHeadroom),
+        PoolConfig->PoolGrowSize);
+    if (Available > KeepAvailable + PoolConfig->PoolGrowSize && Pool.TrimAvailable(KeepAvailable) > 0)
+    {
+        Demand.PredictiveShrinks++;
+        Demand.QuietSeconds = 0.0f;
+    }
+}
+
+void UISMRuntimePoolSubsystem::HandlePerformanceProfileChanged(EISMPerformanceProfile Profile, const FISMPerformanceProfileSettings& ProfileSettings)
+{
+    int32 TotalTrimmed = 0;
+    for (TPair<TSubclassOf<AActor>, FISMRuntimeActorPool>& Pair : ActorPools)
+    {
+        FISMRuntimeActorPool& Pool = Pair.Value;
+        const int32 MaxSize = Pool.GetMaxPoolSize();
+        if (MaxSize <= 0 || Pool.GetStats().TotalActors <= MaxSize)
+        {
+            continue;
+        }
+
+        // Active actors are never reclaimed; the pool settles as they come back
+        const int32 Excess = Pool.GetStats().TotalActors - MaxSize;
+        TotalTrimmed += Pool.TrimAvailable(FMath::Max(0, Pool.GetNumAvailable() - Excess));
+    }
+
+    if (TotalTrimmed > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("UISMRuntimePoolSubsystem - Performance profile %s: trimmed %d pooled actors"),
+            *UEnum::GetValueAsString(Profile), TotalTrimmed);
+    }
+}
+
+void UISMRuntimePoolSubsystem::GatherMemoryStats(TArray<FISMMemoryStatEntry>& OutEntries) const
+{
+    FISMMemoryStatEntry& Entry = OutEntries.AddDefaulted_GetRef();
+    Entry.Name = TEXT("ActorPools");
+    Entry.Count = ActorPools.Num();
+
+    SIZE_T Bytes = ActorPools.GetAllocatedSize() + RegisteredComponents.GetAllocatedSize()
+        + ComponentPoolClasses.GetAllocatedSize() + DeferredReturns.GetAllocatedSize();
+    for (const auto& Pair : ActorPools)
+    {
+        Bytes += Pair.Value.GetAllocatedSize() + static_cast<SIZE_T>(Pair.Value.GetStats().GetEstimatedMemoryBytes());
+    }
+    Entry.Bytes = static_cast<int64>(Bytes);
+}
+
 void UISMRuntimePoolSubsystem::UpdateGlobalStats() const
 {
     FISMGlobalPoolStats Stats;
@@ -502,6 +1040,8 @@ void UISMRuntimePoolSubsystem::UpdateGlobalStats() const
         Stats.TotalActiveActors += PoolStats.ActiveActors;
         Stats.TotalAvailableActors += PoolStats.AvailableActors;
         Stats.TotalLeakedActors += PoolStats.GetLeakCount();
+        Stats.TotalEstimatedMemoryBytes += PoolStats.GetEstimatedMemoryBytes();
+        Stats.OrphanedPools += Pair.Value.OrphanedTime >= 0.0 ? 1 : 0;
 
         if (PoolStats.TotalActors > 0)
         {
@@ -516,6 +1056,9 @@ void UISMRuntimePoolSubsystem::UpdateGlobalStats() const
         Stats.AverageUtilization = TotalUtilizationSum / (float)PoolsWithActors / 100.0f;
     }
 
+    Stats.BudgetEvictions = BudgetEvictions;
+    Stats.bOverBudget = BudgetConfig.bEnableBudget && IsOverBudget(Stats.TotalActorsSpawned, Stats.TotalEstimatedMemoryBytes);
+
     // Cache results
     CachedGlobalStats = Stats;
     GlobalStatsUpdateFrame = GFrameCounter;
@@ -621,6 +1164,8 @@ void UISMRuntimePoolSubsystem::PrintPoolStatistics() const
             Stats.TotalRequests, Stats.TotalReturns, Stats.GetLeakCount());
         UE_LOG(LogTemp, Log, TEXT("    Grows: %d | Shrinks: %d"),
             Stats.GrowCount, Stats.ShrinkCount);
+        UE_LOG(LogTemp, Log, TEXT("    Pending Spawns: %d | Synchronous Spawns: %d"),
+            Stats.PendingSpawns, Stats.SynchronousSpawns);
 
         if (Stats.HasLeak())
         {
@@ -1,7 +1,21 @@
 #include "ISMRuntimePools.h"
+#include "ISMPoolProfiling.h"
 
 #define LOCTEXT_NAMESPACE "FISMRuntimePoolsModule"
 
+DEFINE_STAT(STAT_ISMPoolRequest);
+DEFINE_STAT(STAT_ISMPoolReturn);
+DEFINE_STAT(STAT_ISMPoolSpawn);
+DEFINE_STAT(STAT_ISMPoolReset);
+DEFINE_STAT(STAT_ISMPoolGrow);
+DEFINE_STAT(STAT_ISMPoolActiveActors);
+DEFINE_STAT(STAT_ISMPoolAvailableActors);
+DEFINE_STAT(STAT_ISMPoolMisses);
+
+CSV_DEFINE_CATEGORY(ISMPools, true);
+
+LLM_DEFINE_TAG(ISMRuntime_Pools);
+
 void FISMRuntimePools::StartupModule()
 {
 }
@@ -40,6 +40,34 @@ public:
         meta = (Tooltip = "Actor class to spawn when instances are converted. Should implement IISMPoolable interface."))
     TSubclassOf<AActor> PooledActorClass;
 
+    /**
+     * Draw actors from one pool shared by every asset whose actor class has the same native
+     * base (e.g. all AISMPhysicsActor Blueprint variants), instead of a pool per class.
+     *
+     * Only valid when the actor configures itself entirely from the data asset passed to
+     * OnRequestedFromPool - Blueprint-only components or defaults of PooledActorClass are not
+     * spawned. The pool takes its size settings from the first asset that requests from it.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Core",
+        meta = (Tooltip = "Share one pool of the native actor class with all assets that use it. The actor must configure itself from the data asset."))
+    bool bUseSharedProxyPool = false;
+
+    /** Class the pool subsystem spawns and keys the pool by: PooledActorClass, or its native base when sharing a proxy pool */
+    TSubclassOf<AActor> GetPoolClass() const
+    {
+        if (!bUseSharedProxyPool)
+        {
+            return PooledActorClass;
+        }
+
+        UClass* NativeClass = PooledActorClass.Get();
+        while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+        {
+            NativeClass = NativeClass->GetSuperClass();
+        }
+        return NativeClass;
+    }
+
     // ===== Pooling Behavior =====
 
     /**
@@ -119,6 +147,73 @@ public:
             EditCondition = "bEnablePooling && bAllowPoolShrinking", EditConditionHides))
     float ShrinkThreshold = 0.5f;
 
+    /**
+     * Park returned actors in a dormant state instead of resetting them.
+     *
+     * Dormant actors keep their components registered and their physics bodies alive: simulation
+     * is stopped and the body put to sleep, collision and rendering are switched off by flag, and
+     * the actor stays where it was returned. Nothing is teleported to the origin or rescaled, so
+     * no body shapes are rebuilt and returning and reactivating only flips flags that actually
+     * changed. Use for physics actors whose OnRequestedFromPool sets the full transform anyway.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pooling",
+        meta = (Tooltip = "Keep returned actors registered with their bodies asleep instead of resetting them.",
+            EditCondition = "bEnablePooling", EditConditionHides))
+    bool bUseDormantReset = false;
+
+    // ===== Time Slicing =====
+
+    /**
+     * Most actors the pool spawns per frame from its refill queue.
+     * PreWarm and growth queue their spawns instead of spawning the whole batch at once; a request
+     * only spawns synchronously when no actor is available at all, and then spawns just one.
+     *
+     * 0 = no actor cap (spawns are still limited by SpawnBudgetMs if set)
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pooling|Time Slicing",
+        meta = (ClampMin = "0", UIMin = "0", UIMax = "20",
+            Tooltip = "Actors spawned per frame from the refill queue. 0 = no cap.",
+            EditCondition = "bEnablePooling", EditConditionHides))
+    int32 MaxSpawnsPerFrame = 0;
+
+    /**
+     * Game thread time the pool may spend spawning queued actors per frame.
+     * At least one queued actor is spawned per frame so the queue always drains.
+     *
+     * 0 = no time limit. Time slicing is off when both this and MaxSpawnsPerFrame are 0.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pooling|Time Slicing",
+        meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "5.0", Units = "ms",
+            Tooltip = "Milliseconds per frame spent spawning queued actors. 0 = no limit.",
+            EditCondition = "bEnablePooling", EditConditionHides))
+    float SpawnBudgetMs = 0.0f;
+
+    /**
+     * Queue a PoolGrowSize refill whenever available plus queued actors drop below this,
+     * so the pool tops itself up in the background before a request finds it empty.
+     * Only used when time slicing is on.
+     *
+     * 0 = refill only once the pool is empty
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pooling|Time Slicing",
+        meta = (ClampMin = "0", UIMin = "0", UIMax = "50",
+            Tooltip = "Refill in the background while fewer actors than this are available.",
+            EditCondition = "bEnablePooling", EditConditionHides))
+    int32 RefillLowWatermark = 0;
+
+    /**
+     * Estimated memory cost of one pooled actor, used by the pool subsystem's global budget.
+     * 0 = measure the first spawned actor (object sizes plus reported resource sizes).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pooling|Budget",
+        meta = (ClampMin = "0.0", UIMin = "0.0", Units = "KB",
+            Tooltip = "Memory cost of one pooled actor for the global pool budget. 0 = measure on first spawn.",
+            EditCondition = "bEnablePooling", EditConditionHides))
+    float EstimatedActorCostKB = 0.0f;
+
+    /** True if spawns are spread over frames instead of done in whole batches */
+    bool IsSpawnTimeSliced() const { return MaxSpawnsPerFrame > 0 || SpawnBudgetMs > 0.0f; }
+
     // ===== Validation =====
 
 #if WITH_EDITOR
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ISMPoolSlotComponent.generated.h"
+
+/**
+ * Tag component added to every actor spawned by an FISMRuntimeActorPool.
+ *
+ * Carries the owner's slot in its pool, so returning an actor or checking which pool it belongs to
+ * indexes the pool's slot array instead of searching it. Never registered and never ticks -
+ * works for Blueprint actors and actors that don't implement IISMPoolable alike.
+ */
+UCLASS(Transient)
+class ISMRUNTIMEPOOLS_API UISMPoolSlotComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UISMPoolSlotComponent()
+    {
+        PrimaryComponentTick.bCanEverTick = false;
+        bAutoActivate = false;
+    }
+
+    /** Pool that spawned the owner; tells apart pools of the same class in different worlds */
+    uint32 PoolId = 0;
+
+    /** Key of that pool in UISMRuntimePoolSubsystem, so the owner's pool is found without a search */
+    TSubclassOf<AActor> PoolClass;
+
+    /** Owner's index in that pool's slot array */
+    int32 SlotIndex = INDEX_NONE;
+
+    /** Slot tag of a pooled actor, or null if the actor did not come from a pool */
+    static UISMPoolSlotComponent* Find(const AActor* Actor)
+    {
+        return Actor ? Actor->FindComponentByClass<UISMPoolSlotComponent>() : nullptr;
+    }
+};
@@ -50,6 +50,26 @@ struct ISMRUNTIMEPOOLS_API FISMPoolStats
     UPROPERTY(BlueprintReadOnly, Category = "Pool Stats")
     int32 ShrinkCount = 0;
 
+    /** Actors queued to be spawned by the time-sliced refill */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Stats")
+    int32 PendingSpawns = 0;
+
+    /** Requests that found the pool empty and had to spawn on the spot while time slicing */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Stats")
+    int32 SynchronousSpawns = 0;
+
+    /** Components registered with the subsystem as users of this pool (streamed-in regions) */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Stats")
+    int32 RegisteredUsers = 0;
+
+    /** Idle actors a newly registered user inherited instead of the pool spawning new ones */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Stats")
+    int32 HandoffActors = 0;
+
+    /** Estimated memory per pooled actor (EstimatedActorCostKB, or measured on first spawn) */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Stats")
+    int64 EstimatedBytesPerActor = 0;
+
     /** Frame number when this pool was last accessed (for stale pool cleanup) */
     uint64 LastAccessFrame = 0;
 
@@ -65,10 +85,61 @@ struct ISMRUNTIMEPOOLS_API FISMPoolStats
     /** Check if pool is currently exhausted (no available actors) */
     bool IsExhausted() const { return AvailableActors == 0; }
 
+    /** Estimated memory held by all spawned actors */
+    int64 GetEstimatedMemoryBytes() const { return EstimatedBytesPerActor * TotalActors; }
+
     /** Get pool utilization (0.0 to 1.0) */
     float GetUtilization() const { return TotalActors > 0 ? (float)ActiveActors / TotalActors : 0.0f; }
 };
 
+/** Lifecycle state of one slot in FISMRuntimeActorPool's slot array */
+enum class EISMPoolSlotState : uint8
+{
+    /** No actor; slot is on the vacant list for the next spawn */
+    Vacant,
+    /** Actor is pooled and on the available list */
+    Available,
+    /** Actor is handed out */
+    Active
+};
+
+/**
+ * Request-rate telemetry for a single actor pool, sampled by UISMRuntimePoolSubsystem's
+ * adaptive sizing policy.
+ */
+USTRUCT(BlueprintType)
+struct ISMRUNTIMEPOOLS_API FISMPoolDemandStats
+{
+    GENERATED_BODY()
+
+    /** Exponential moving average of requests per second */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Demand")
+    float AverageRequestRate = 0.0f;
+
+    /** Recent peak requests per second; decays towards the average during quiet periods */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Demand")
+    float PeakRequestRate = 0.0f;
+
+    /** Available actors the policy keeps ready to absorb the peak rate over its lead time */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Demand")
+    int32 TargetAvailable = 0;
+
+    /** Seconds since the request rate last exceeded the moving average */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Demand")
+    float QuietSeconds = 0.0f;
+
+    /** Grows started by the policy ahead of demand */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Demand")
+    int32 PredictiveGrows = 0;
+
+    /** Shrinks done by the policy after a quiet period */
+    UPROPERTY(BlueprintReadOnly, Category = "Pool Demand")
+    int32 PredictiveShrinks = 0;
+
+    /** FISMPoolStats::TotalRequests at the previous sample */
+    int32 LastSampleRequests = 0;
+};
+
 /**
  * Pool manager for a single actor class.
  *
@@ -83,6 +154,10 @@ struct ISMRUNTIMEPOOLS_API FISMPoolStats
  * - Shrinking: Destroy unused actors to reclaim memory
  * - Statistics: Track usage for monitoring and optimization
  *
+ * Storage: every spawned actor owns one slot of a dense array and carries the slot index in a
+ * UISMPoolSlotComponent. Available and vacant slots are threaded through intrusive free lists,
+ * so request, return and ownership checks are O(1) and never resolve a weak pointer.
+ *
  * Thread Safety: This struct is NOT thread-safe. All operations must occur on game thread.
  */
 USTRUCT()
@@ -103,20 +178,21 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
 
     // ===== Actor Storage =====
 
-    /** Actors ready to be used */
-    TArray<TWeakObjectPtr<AActor>> AvailableActors;
-
-    /** Actors currently in use (not in pool) */
-    TArray<TWeakObjectPtr<AActor>> ActiveActors;
-
-
-    TSet<AActor*> AllActors;
+    /** Actor in each slot; null for vacant slots and for actors destroyed outside the pool */
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> SlotActors;
 
     // ===== Statistics =====
 
     /** Runtime statistics for this pool */
     FISMPoolStats Stats;
 
+    /** Request-rate telemetry, updated only while adaptive sizing is enabled */
+    FISMPoolDemandStats Demand;
+
+    /** World time when the last registered user unregistered; negative while users remain or none ever registered */
+    double OrphanedTime = -1.0;
+
     // ===== Constructor & Initialization =====
 
     FISMRuntimeActorPool() = default;
@@ -133,8 +209,10 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
     /**
      * Pre-spawn initial actors to populate the pool.
      * Called automatically during initialization.
+     * When the config time-slices spawns, only this frame's budget is spawned and the
+     * rest is queued for ProcessSpawnQueue.
      *
-     * @return Number of actors successfully spawned
+     * @return Number of actors successfully spawned now
      */
     int32 PreWarm();
 
@@ -153,6 +231,20 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
      */
     AActor* RequestActor(UISMPoolDataAsset* DataAsset, const struct FISMInstanceHandle& InstanceHandle);
 
+    /**
+     * Request one actor per instance handle in one step.
+     *
+     * The whole batch is reserved up front: a single grow covers any shortfall (only the shortfall
+     * when time-sliced) and statistics update once. IISMPoolable::OnRequestedFromPool still runs per
+     * actor. Unlike RequestActor, an exhausted pool never hands out active actors.
+     *
+     * @param DataAsset - Data asset to pass to each actor's OnRequestedFromPool
+     * @param InstanceHandles - One handle per requested actor
+     * @param OutActors - OutActors[i] serves InstanceHandles[i]; shorter than the batch if the pool ran out
+     * @return Number of actors served
+     */
+    int32 RequestActors(UISMPoolDataAsset* DataAsset, TConstArrayView<FISMInstanceHandle> InstanceHandles, TArray<AActor*>& OutActors);
+
     /**
      * Return an actor to the pool.
      *
@@ -166,6 +258,17 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
      */
     bool ReturnActor(AActor* Actor, FTransform& OutFinalTransform, bool& bUpdateTransform);
 
+    /**
+     * Return several actors to the pool at once.
+     *
+     * Calls IISMPoolable::OnReturnedToPool on every actor first, then resets them all in one pass
+     * and updates statistics once. Final transforms reported by the actors are discarded.
+     *
+     * @param Actors - Actors to return; ones not active in this pool are skipped
+     * @return Number of actors returned
+     */
+    int32 ReturnActors(TConstArrayView<AActor*> Actors);
+
     /**
      * Check if an actor belongs to this pool.
      *
@@ -179,12 +282,35 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
     /**
      * Grow the pool by spawning additional actors.
      * Called automatically when RequestActor finds no available actors.
+     * Spawns synchronously; use QueueSpawns to spread growth over frames.
      *
      * @param Count - Number of actors to spawn (defaults to PoolGrowSize from config)
      * @return Number of actors successfully spawned
      */
     int32 GrowPool(int32 Count = -1);
 
+    /**
+     * Queue actors for the time-sliced refill, clamped so spawned plus queued actors stay
+     * within MaxPoolSize.
+     *
+     * @param Count - Number of actors to queue (defaults to PoolGrowSize from config)
+     * @return Number of actors actually queued
+     */
+    int32 QueueSpawns(int32 Count = -1);
+
+    /**
+     * Spawn queued actors within the config's per-frame budget (MaxSpawnsPerFrame / SpawnBudgetMs)
+     * and queue a refill if the pool is under its RefillLowWatermark.
+     * Called once per frame by UISMRuntimePoolSubsystem.
+     *
+     * @param MaxSeconds - Tighter cap on top of SpawnBudgetMs (the subsystem passes its frame budget share), 0 = none
+     * @return Number of actors spawned
+     */
+    int32 ProcessSpawnQueue(double MaxSeconds = 0.0);
+
+    /** Check if the pool has queued spawns left */
+    bool HasPendingSpawns() const { return Stats.PendingSpawns > 0; }
+
     /**
      * Shrink the pool by destroying unused actors.
      * Only destroys available actors, never active ones.
@@ -195,6 +321,15 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
      */
     int32 ShrinkPool(bool bForceImmediate = false);
 
+    /**
+     * Destroy available actors until at most KeepAvailable remain.
+     * Never touches active actors and ignores bAllowPoolShrinking; callers decide whether to shrink.
+     *
+     * @param KeepAvailable - Available actors to keep
+     * @return Number of actors destroyed
+     */
+    int32 TrimAvailable(int32 KeepAvailable);
+
     /**
      * Clean up the entire pool, destroying all actors.
      * Called when pool is no longer needed or during world cleanup.
@@ -207,9 +342,21 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
     /** Get current pool statistics */
     const FISMPoolStats& GetStats() const { return Stats; }
 
+    /** Number of actors ready to be used */
+    int32 GetNumAvailable() const { return NumAvailable; }
+
+    /** Number of actors currently in use (not in pool) */
+    int32 GetNumActive() const { return NumActive; }
+
     /** Check if pool is currently valid and operational */
     bool IsValid() const;
 
+    /** The config's MaxPoolSize scaled by the active performance profile; 0 is unlimited */
+    int32 GetMaxPoolSize() const;
+
+    /** The config's InitialPoolSize scaled by the active performance profile */
+    int32 GetInitialPoolSize() const;
+
     /** Check if pool can grow (hasn't reached MaxPoolSize) */
     bool CanGrow() const;
 
@@ -219,7 +366,62 @@ struct ISMRUNTIMEPOOLS_API FISMRuntimeActorPool
     /** Get the number of actors that would be destroyed if shrunk now */
     int32 GetShrinkCandidateCount() const;
 
+    /** Slot storage bytes; spawned actors are covered by Stats.GetEstimatedMemoryBytes */
+    SIZE_T GetAllocatedSize() const { return SlotActors.GetAllocatedSize() + SlotStates.GetAllocatedSize() + SlotNext.GetAllocatedSize(); }
+
+    // ===== Profiling =====
+
+    /**
+     * Record this pool's active, available and miss counts to the CSV profiler, then start
+     * counting misses for the next frame. Called once per frame by the subsystem.
+     *
+     * @return Requests since the previous call that found no available actor
+     */
+    int32 PublishFrameCounters();
+
 private:
+    // ===== Slot Storage =====
+
+    /** Per-slot state and free list link, parallel to SlotActors */
+    TArray<EISMPoolSlotState> SlotStates;
+    TArray<int32> SlotNext;
+
+    /** Heads of the available (LIFO, most recently returned first) and vacant slot lists */
+    int32 AvailableHead = INDEX_NONE;
+    int32 VacantHead = INDEX_NONE;
+
+    int32 NumAvailable = 0;
+    int32 NumActive = 0;
+
+    /** Written into each actor's slot tag; unique per pool */
+    uint32 PoolId = 0;
+
+    /** Requests this frame that found no available actor */
+    int32 FrameMisses = 0;
+
+    /** Per-class CSV stat names, built on first publish */
+    FName CsvActiveStatName;
+    FName CsvAvailableStatName;
+    FName CsvMissesStatName;
+
+    /** Give a freshly spawned actor a slot and tag it. The slot starts on the available list. */
+    void AddSlot(AActor* Actor);
+
+    /** Take the most recently returned available slot and mark it active. INDEX_NONE if none. */
+    int32 PopAvailableSlot();
+
+    /** Put an active slot back on the available list */
+    void PushAvailableSlot(int32 Slot);
+
+    /** Clear a slot's actor and move it to the vacant list. The slot must not be on the available list. */
+    void VacateSlot(int32 Slot);
+
+    /** Slot of an actor spawned by this pool, or INDEX_NONE */
+    int32 FindSlot(const AActor* Actor) const;
+
+    /** Destroy up to MaxCount available actors, most recently returned first. Returns the number destroyed. */
+    int32 DestroyAvailable(int32 MaxCount);
+
     // ===== Internal Helpers =====
 
     /**
@@ -230,6 +432,15 @@ private:
      */
     AActor* SpawnPoolActor(bool bIsPreWarm);
 
+    /**
+     * Queue a refill if time slicing is on and available plus queued actors are below the
+     * config's RefillLowWatermark (or the pool is empty).
+     */
+    void QueueLowWatermarkRefill();
+
+    /** Fill Stats.EstimatedBytesPerActor from the config or by measuring Actor */
+    void EstimateActorCost(AActor* Actor);
+
     /**
      * Reset an actor to clean state for return to pool.
      * Uses IISMPoolable interface if available, otherwise applies default reset.
@@ -247,14 +458,23 @@ private:
      */
     void ApplyDefaultReset(AActor* Actor);
 
+    /**
+     * Park an actor in the dormant state (see UISMPoolDataAsset::bUseDormantReset).
+     * - Stop simulation and put bodies to sleep (bodies are not destroyed)
+     * - Disable collision and hide by flag, skipping flags already in the right state
+     * - Disable ticking
+     * - Leave transform untouched
+     */
+    void ApplyDormantReset(AActor* Actor);
+
     /**
      * Update statistics after a request/return operation.
      */
     void UpdateStats();
 
     /**
-     * Remove invalid weak pointers from actor arrays.
-     * Called periodically to clean up destroyed actors.
+     * Vacate slots whose actor was destroyed outside the pool and rebuild the available list.
+     * Called when a destroyed actor is found.
      */
     void CleanupInvalidActors();
 
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "ISMRuntimeActorPool.h"
+#include "ISMMemoryStats.h"
+#include "Settings/ISMPerformanceProfile.h"
 #include "ISMRuntimePoolSubsystem.generated.h"
 
 // Forward declarations
@@ -33,6 +35,110 @@ struct FISMPoolCleanupConfig
     float CleanupCheckInterval = 60.0f;
 };
 
+/**
+ * Configuration for streaming-aware pool lifetime.
+ *
+ * Components register with the subsystem as users of their data asset's pool when their level
+ * streams in and unregister when it streams out. A pool whose last user unregistered keeps its idle
+ * actors for OrphanGraceSeconds so a region loading next can take them over; after that its idle
+ * actors are destroyed, and the pool itself once nothing is active.
+ */
+USTRUCT(BlueprintType)
+struct FISMPoolStreamingConfig
+{
+    GENERATED_BODY()
+
+    /** Shrink and destroy pools whose registered users have all unregistered */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool Streaming")
+    bool bReleaseOrphanedPools = true;
+
+    /** Seconds an orphaned pool keeps its idle actors for a newly loaded region to take over */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool Streaming",
+        meta = (EditCondition = "bReleaseOrphanedPools", ClampMin = "0.0", Units = "s"))
+    float OrphanGraceSeconds = 10.0f;
+};
+
+/**
+ * Configuration for the adaptive pool sizing policy.
+ *
+ * Every SampleInterval the policy measures each pool's request rate, keeps a moving average and a
+ * decaying peak, and holds enough available actors to serve the peak for LeadTimeSeconds. Pools
+ * grow ahead of demand (queued when the pool is time-sliced) and shrink only once demand has been
+ * quiet for QuietSecondsBeforeShrink and the surplus exceeds ShrinkHeadroom, so a pool does not
+ * oscillate between growing and shrinking around a steady rate.
+ */
+USTRUCT(BlueprintType)
+struct FISMPoolAdaptiveSizingConfig
+{
+    GENERATED_BODY()
+
+    /** Enable adaptive sizing. Replaces utilization-threshold shrinking on the cleanup timer. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing")
+    bool bEnableAdaptiveSizing = false;
+
+    /** Seconds between request-rate samples */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing",
+        meta = (EditCondition = "bEnableAdaptiveSizing", ClampMin = "0.1"))
+    float SampleInterval = 0.5f;
+
+    /** Half-life of the request-rate moving average, in seconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing",
+        meta = (EditCondition = "bEnableAdaptiveSizing", ClampMin = "0.1"))
+    float AverageHalfLife = 10.0f;
+
+    /** Half-life of the peak rate's decay towards the average, in seconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing",
+        meta = (EditCondition = "bEnableAdaptiveSizing", ClampMin = "0.1"))
+    float PeakHalfLife = 30.0f;
+
+    /** Seconds of peak-rate demand kept available ahead of time */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing",
+        meta = (EditCondition = "bEnableAdaptiveSizing", ClampMin = "0.0"))
+    float LeadTimeSeconds = 2.0f;
+
+    /** Shrink only when available actors exceed the target by this factor */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing",
+        meta = (EditCondition = "bEnableAdaptiveSizing", ClampMin = "1.0"))
+    float ShrinkHeadroom = 2.0f;
+
+    /** Seconds without above-average demand before a pool may shrink */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Adaptive Sizing",
+        meta = (EditCondition = "bEnableAdaptiveSizing", ClampMin = "0.0"))
+    float QuietSecondsBeforeShrink = 30.0f;
+};
+
+/**
+ * Global budget across all pools in the world.
+ *
+ * When the pooled actor count or estimated memory exceeds the budget, available actors are
+ * evicted from the coldest pools first (least recently requested). Active actors are never
+ * evicted, so the budget can be exceeded while they are in use.
+ */
+USTRUCT(BlueprintType)
+struct FISMPoolBudgetConfig
+{
+    GENERATED_BODY()
+
+    /** Enable the global pool budget */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool Budget")
+    bool bEnableBudget = false;
+
+    /** Maximum pooled actors across all pools. 0 = no actor limit. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool Budget",
+        meta = (EditCondition = "bEnableBudget", ClampMin = "0"))
+    int32 MaxTotalActors = 0;
+
+    /** Maximum estimated pooled actor memory across all pools, in MB. 0 = no memory limit. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool Budget",
+        meta = (EditCondition = "bEnableBudget", ClampMin = "0.0"))
+    float MaxTotalMemoryMB = 0.0f;
+
+    /** Actors evicted per tick at most, so getting back under budget is spread over frames. 0 = unlimited. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool Budget",
+        meta = (EditCondition = "bEnableBudget", ClampMin = "0"))
+    int32 MaxEvictionsPerTick = 16;
+};
+
 /**
  * Global statistics for all pools in the world.
  */
@@ -58,6 +164,22 @@ struct FISMGlobalPoolStats
 
     UPROPERTY(BlueprintReadOnly, Category = "Global Pool Stats")
     float AverageUtilization = 0.0f;
+
+    /** Sum of each pool's per-actor cost estimate times its spawned actors */
+    UPROPERTY(BlueprintReadOnly, Category = "Global Pool Stats")
+    int64 TotalEstimatedMemoryBytes = 0;
+
+    /** Actors evicted by the global budget since the subsystem started */
+    UPROPERTY(BlueprintReadOnly, Category = "Global Pool Stats")
+    int32 BudgetEvictions = 0;
+
+    /** Pooled actors or memory are over the budget (only possible while actors are active) */
+    UPROPERTY(BlueprintReadOnly, Category = "Global Pool Stats")
+    bool bOverBudget = false;
+
+    /** Pools whose registered users have all unregistered and are waiting out the grace period */
+    UPROPERTY(BlueprintReadOnly, Category = "Global Pool Stats")
+    int32 OrphanedPools = 0;
 };
 
 /**
@@ -85,7 +207,7 @@ struct FISMGlobalPoolStats
  * ```
  */
 UCLASS()
-class ISMRUNTIMEPOOLS_API UISMRuntimePoolSubsystem : public UWorldSubsystem
+class ISMRUNTIMEPOOLS_API UISMRuntimePoolSubsystem : public UTickableWorldSubsystem
 {
     GENERATED_BODY()
 
@@ -96,6 +218,15 @@ public:
     virtual void Deinitialize() override;
     virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
 
+    // FTickableGameObject - required pure virtual
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMRuntimePoolSubsystem, STATGROUP_Tickables);
+    }
+
+    /** Drains each pool's time-sliced spawn queue within its per-frame budget */
+    virtual void Tick(float DeltaTime) override;
+
     // ===== Pool Management =====
 
     /**
@@ -155,6 +286,19 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
     AActor* RequestActor(TSubclassOf<AActor> ActorClass, UISMPoolDataAsset* DataAsset, const FISMInstanceHandle& InstanceHandle);
 
+    /**
+     * Request one actor per instance handle from a class's pool in one step.
+     * See FISMRuntimeActorPool::RequestActors.
+     *
+     * @param ActorClass - Class of actor to request
+     * @param DataAsset - Data asset to configure the actors
+     * @param InstanceHandles - One handle per requested actor
+     * @param OutActors - OutActors[i] serves InstanceHandles[i]; shorter than the batch if the pool ran out
+     * @return Number of actors served
+     */
+    int32 RequestActors(TSubclassOf<AActor> ActorClass, UISMPoolDataAsset* DataAsset,
+        TConstArrayView<FISMInstanceHandle> InstanceHandles, TArray<AActor*>& OutActors);
+
     /**
      * Return an actor to its pool.
      *
@@ -168,8 +312,35 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
     bool ReturnActor(AActor* Actor, FTransform& OutFinalTransform, bool& bUpdateTransform);
 
+    /**
+     * Return several actors to their pools at once.
+     *
+     * Actors are grouped by pool and each group is notified and reset together (see
+     * FISMRuntimeActorPool::ReturnActors). Use when the final transforms are not needed.
+     *
+     * @param Actors - Actors to return
+     * @return Number of actors returned
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    int32 ReturnActors(const TArray<AActor*>& Actors);
+
+    /**
+     * Queue an actor to be returned with the rest of this frame's deferred returns on the next
+     * subsystem tick. The actor is hidden and stops colliding right away; it becomes available
+     * for requests once the batch runs.
+     *
+     * @param Actor - Actor to return
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    void DeferReturnActor(AActor* Actor);
+
+    /** Return all deferred actors now. Called automatically from Tick. */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    int32 FlushDeferredReturns();
+
     /**
      * Find which pool an actor belongs to.
+     * O(1): reads the pool stamped on the actor when the pool spawned it.
      *
      * @param Actor - Actor to search for
      * @return Pool containing the actor, or nullptr if not found in any pool
@@ -241,24 +412,83 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
     void SetCleanupConfig(const FISMPoolCleanupConfig& NewConfig);
 
+    /**
+     * Get/set global budget configuration.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    const FISMPoolBudgetConfig& GetBudgetConfig() const { return BudgetConfig; }
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    void SetBudgetConfig(const FISMPoolBudgetConfig& NewConfig) { BudgetConfig = NewConfig; }
+
+    /**
+     * Evict available actors from the coldest pools until the global budget is met or this
+     * tick's eviction cap is spent. Called automatically from Tick while the budget is enabled.
+     *
+     * @return Number of actors evicted
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    int32 EnforcePoolBudget();
+
+    /**
+     * Get/set adaptive sizing configuration.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    const FISMPoolAdaptiveSizingConfig& GetAdaptiveSizingConfig() const { return AdaptiveSizingConfig; }
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    void SetAdaptiveSizingConfig(const FISMPoolAdaptiveSizingConfig& NewConfig);
+
+    /**
+     * Get request-rate telemetry for a specific pool.
+     *
+     * @param ActorClass - Class whose pool demand to retrieve
+     * @param OutDemand - Filled with the pool's demand statistics
+     * @return True if pool exists
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    bool GetPoolDemand(TSubclassOf<AActor> ActorClass, FISMPoolDemandStats& OutDemand) const;
+
     // ===== Component Integration =====
 
     /**
      * Register a runtime component with the subsystem.
      * Components should call this during BeginPlay if they use pooling.
      *
+     * If the component's instance data is a pooling-enabled UISMPoolDataAsset, the component counts
+     * as a user of that asset's pool. The pool is created on first use; otherwise the component takes
+     * over the idle actors already in it, including those left by a region that streamed out.
+     *
      * @param Component - Component to register
      */
     void RegisterComponent(UISMRuntimeComponent* Component);
 
     /**
      * Unregister a runtime component from the subsystem.
-     * Components should call this during EndPlay.
+     * Components should call this during EndPlay. Its pool is orphaned when this was the last user.
      *
      * @param Component - Component to unregister
      */
     void UnregisterComponent(UISMRuntimeComponent* Component);
 
+    /**
+     * Get/set streaming lifetime configuration.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    const FISMPoolStreamingConfig& GetStreamingConfig() const { return StreamingConfig; }
+
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    void SetStreamingConfig(const FISMPoolStreamingConfig& NewConfig) { StreamingConfig = NewConfig; }
+
+    /**
+     * Destroy idle actors of pools orphaned for longer than the grace period, and the pools
+     * themselves once nothing is active. Called automatically from Tick.
+     *
+     * @return Number of pools released
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Pools")
+    int32 ReleaseOrphanedPools();
+
     /**
      * Get all registered components.
      */
@@ -276,13 +506,64 @@ protected:
     UPROPERTY()
     TArray<TWeakObjectPtr<UISMRuntimeComponent>> RegisteredComponents;
 
+    /** Pool each registered component counts as a user of */
+    UPROPERTY()
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, TSubclassOf<AActor>> ComponentPoolClasses;
+
+    /** Streaming lifetime configuration */
+    UPROPERTY()
+    FISMPoolStreamingConfig StreamingConfig;
+
+    /** Drop one user from a pool, orphaning it when none remain */
+    void ReleasePoolUser(TSubclassOf<AActor> ActorClass);
+
+    /** Release pool users of components destroyed without unregistering */
+    void RemoveStaleComponents();
+
+    /** Push this frame's pool counters to the stats system and CSV profiler */
+    void PublishFrameCounters();
+
+    /** UISMRuntimeSubsystem::OnGatherMemoryStats: pooled actor estimates plus pool bookkeeping */
+    void GatherMemoryStats(TArray<FISMMemoryStatEntry>& OutEntries) const;
+
+    FDelegateHandle GatherMemoryStatsHandle;
+
+    /** FISMPerformanceProfiles::OnProfileChanged: trim available actors of pools now over their scaled MaxPoolSize */
+    void HandlePerformanceProfileChanged(EISMPerformanceProfile Profile, const FISMPerformanceProfileSettings& ProfileSettings);
+
+    FDelegateHandle PerformanceProfileHandle;
+
     /** Cleanup configuration */
     UPROPERTY()
     FISMPoolCleanupConfig CleanupConfig;
 
+    /** Actors queued by DeferReturnActor; nulled by GC if destroyed first */
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> DeferredReturns;
+
+    /** Global budget configuration */
+    UPROPERTY()
+    FISMPoolBudgetConfig BudgetConfig;
+
+    /** Actors evicted by the budget so far */
+    int32 BudgetEvictions = 0;
+
+    /** True when the budget's limits are exceeded by the given totals */
+    bool IsOverBudget(int32 TotalActors, int64 TotalBytes) const;
+
+    /** Adaptive sizing configuration */
+    UPROPERTY()
+    FISMPoolAdaptiveSizingConfig AdaptiveSizingConfig;
+
+    /** Seconds accumulated towards the next adaptive sizing sample */
+    float AdaptiveSampleAccumulator = 0.0f;
+
     /** Timer handle for periodic cleanup checks */
     FTimerHandle CleanupTimerHandle;
 
+    /** The cleanup timer fired without frame budget left; Tick runs it once there is */
+    bool bCleanupDeferred = false;
+
     /** Cached global stats (updated when queried) */
     mutable FISMGlobalPoolStats CachedGlobalStats;
 
@@ -302,10 +583,26 @@ protected:
     void StopCleanupTimer();
 
     /**
-     * Timer callback for periodic cleanup.
+     * Timer callback for periodic cleanup. Defers to Tick when the frame budget is spent.
      */
     void OnCleanupTimer();
 
+    /**
+     * Destroy stale pools and shrink idle ones.
+     */
+    void RunPeriodicCleanup();
+
+    /** Name the pools' spawning and cleanup are timed under in the ISMRuntime frame budget */
+    static const FName FrameBudgetClient;
+
+    /**
+     * Sample one pool's request rate and grow or shrink it towards its demand target.
+     *
+     * @param Pool - Pool to resize
+     * @param SampleSeconds - Time since the previous sample
+     */
+    void ApplyAdaptiveSizing(FISMRuntimeActorPool& Pool, float SampleSeconds);
+
     /**
      * Update cached global statistics.
      */
@@ -0,0 +1,30 @@
+// Copyright Max Harris
+
+using UnrealBuildTool;
+
+public class ISMRuntimeReplication : ModuleRules
+{
+    public ISMRuntimeReplication(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "GameplayTags",
+                "NetCore",
+                "ISMRuntimeCore",
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+
+            }
+        );
+    }
+}
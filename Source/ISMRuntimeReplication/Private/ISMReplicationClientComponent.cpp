@@ -0,0 +1,203 @@
+#include "ISMReplicationClientComponent.h"
+#include "ISMRuntimeReplication.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMReplicationSubsystem.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMInstanceState.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+UISMReplicationClientComponent::UISMReplicationClientComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(true);
+}
+
+void UISMReplicationClientComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // A listen server's own player already sees the server's state
+    const APlayerController* Controller = Cast<APlayerController>(GetOwner());
+    if (!Controller || !Controller->HasAuthority() || Controller->IsLocalController())
+    {
+        return;
+    }
+
+    if (UISMReplicationSubsystem* Subsystem = GetWorld()->GetSubsystem<UISMReplicationSubsystem>())
+    {
+        Subsystem->RegisterClient(this);
+    }
+}
+
+void UISMReplicationClientComponent::EndPlay(const EEndPlayReason::Type EndReason)
+{
+    if (ReplicationClientIndex != INDEX_NONE)
+    {
+        if (UISMReplicationSubsystem* Subsystem = GetWorld()->GetSubsystem<UISMReplicationSubsystem>())
+        {
+            Subsystem->UnregisterClient(this);
+        }
+    }
+    ReceivedComponents.Reset();
+
+    Super::EndPlay(EndReason);
+}
+
+void UISMReplicationClientComponent::ClientReceiveDeltas_Implementation(const TArray<FISMReplicatedComponentDelta>& Deltas)
+{
+    ISM_TRACE_SCOPE(UISMReplicationClientComponent::ClientReceiveDeltas);
+    LLM_SCOPE_BYTAG(ISMRuntime_Replication);
+
+    for (const FISMReplicatedComponentDelta& Delta : Deltas)
+    {
+        ApplyDelta(Delta);
+    }
+}
+
+void UISMReplicationClientComponent::ApplyDelta(const FISMReplicatedComponentDelta& Delta)
+{
+    UISMRuntimeComponent* Component = Delta.Component;
+    if (!Component)
+    {
+        return;
+    }
+
+    // Dictionary entries are appended even if the instances cannot be applied, so later ids line up
+    FReceivedComponent& Received = ReceivedComponents.FindOrAdd(Component);
+    Received.Dictionary.Append(Delta.NewDictionaryTags);
+
+    if (!Component->IsISMInitialized())
+    {
+        return;
+    }
+
+    auto LookupTag = [&Received](int32 TagId)
+        {
+            return Received.Dictionary.IsValidIndex(TagId) ? Received.Dictionary[TagId] : FGameplayTag();
+        };
+
+    TArray<int32> ToDestroy;
+    TArray<int32> ToHide;
+    TArray<int32> ToShow;
+    TArray<FISMStateFlagsWrite> FlagWrites;
+    TArray<int32> CustomDataIndices;
+    TArray<float> CustomDataValues;
+    const int32 NumCustomData = Component->GetNumCustomDataFloats();
+
+    constexpr uint8 DestroyedFlag = static_cast<uint8>(EISMInstanceState::Destroyed);
+    constexpr uint8 HiddenFlag = static_cast<uint8>(EISMInstanceState::Hidden);
+
+    for (const FISMReplicatedInstance& Instance : Delta.Instances)
+    {
+        const int32 InstanceIndex = Instance.InstanceIndex;
+        if (!Component->IsValidInstanceIndex(InstanceIndex))
+        {
+            continue;
+        }
+
+        if (Instance.HasField(EISMReplicatedField::State))
+        {
+            const uint8 OldFlags = Component->GetInstanceStateFlags(InstanceIndex);
+            const uint8 NewFlags = Instance.StateFlags;
+            if ((NewFlags & DestroyedFlag) && !(OldFlags & DestroyedFlag))
+            {
+                ToDestroy.Add(InstanceIndex);
+            }
+            else if ((NewFlags & HiddenFlag) && !(OldFlags & HiddenFlag))
+            {
+                ToHide.Add(InstanceIndex);
+            }
+            else if (!(NewFlags & HiddenFlag) && (OldFlags & HiddenFlag))
+            {
+                ToShow.Add(InstanceIndex);
+            }
+
+            // Destroyed is only ever set, through DestroyInstance above
+            FlagWrites.Add({ InstanceIndex, static_cast<uint8>(NewFlags & ~DestroyedFlag), static_cast<uint8>(~NewFlags & ~DestroyedFlag) });
+        }
+
+        if (Instance.HasField(EISMReplicatedField::Owner))
+        {
+            FISMInstanceHandle& Handle = Component->GetOrCreateHandle(InstanceIndex);
+            const FGameplayTag OwnerTag = LookupTag(static_cast<int32>(Instance.OwnerId) - 1);
+            if (OwnerTag.IsValid())
+            {
+                Handle.SetOwner(OwnerTag);
+            }
+            else if (Handle.GetOwnerTag().IsValid())
+            {
+                Handle.ClearOwner();
+            }
+        }
+
+        if (Instance.HasField(EISMReplicatedField::Tags))
+        {
+            TArray<FGameplayTag> NewTags;
+            NewTags.Reserve(Instance.TagIds.Num());
+            for (uint16 TagId : Instance.TagIds)
+            {
+                const FGameplayTag Tag = LookupTag(TagId);
+                if (Tag.IsValid())
+                {
+                    NewTags.Add(Tag);
+                }
+            }
+
+            TArray<FGameplayTag>& AppliedTags = Received.AppliedTags.FindOrAdd(InstanceIndex);
+            for (const FGameplayTag& Tag : AppliedTags)
+            {
+                if (!NewTags.Contains(Tag))
+                {
+                    Component->RemoveInstanceTag(InstanceIndex, Tag);
+                }
+            }
+            for (const FGameplayTag& Tag : NewTags)
+            {
+                if (!AppliedTags.Contains(Tag))
+                {
+                    Component->AddInstanceTag(InstanceIndex, Tag);
+                }
+            }
+
+            if (NewTags.Num() > 0)
+            {
+                AppliedTags = MoveTemp(NewTags);
+            }
+            else
+            {
+                Received.AppliedTags.Remove(InstanceIndex);
+            }
+        }
+
+        if (Instance.HasField(EISMReplicatedField::CustomData) && NumCustomData > 0)
+        {
+            // Rows are padded or cut to this component's layout so the block is written in one call
+            CustomDataIndices.Add(InstanceIndex);
+            const int32 NumValues = FMath::Min(Instance.CustomData.Num(), NumCustomData);
+            CustomDataValues.Append(Instance.CustomData.GetData(), NumValues);
+            CustomDataValues.AddZeroed(NumCustomData - NumValues);
+        }
+    }
+
+    if (ToDestroy.Num() > 0)
+    {
+        Component->BatchDestroyInstances(ToDestroy);
+    }
+    for (int32 InstanceIndex : ToHide)
+    {
+        Component->HideInstance(InstanceIndex);
+    }
+    if (ToShow.Num() > 0)
+    {
+        Component->BatchShowInstances(ToShow);
+    }
+    if (FlagWrites.Num() > 0)
+    {
+        Component->BatchWriteInstanceStateFlags(FlagWrites);
+    }
+    if (CustomDataIndices.Num() > 0)
+    {
+        Component->WriteInstanceCustomData(CustomDataIndices, 0, NumCustomData, CustomDataValues);
+    }
+}
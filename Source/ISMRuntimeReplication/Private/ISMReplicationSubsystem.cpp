@@ -0,0 +1,540 @@
+#include "ISMReplicationSubsystem.h"
+#include "ISMRuntimeReplication.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMReplicationClientComponent.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMSpatialIndex.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+void UISMReplicationSubsystem::FInstanceFieldSet::Add(int32 InstanceIndex, uint8 InFields)
+{
+    if (InstanceIndex < 0 || InFields == 0)
+    {
+        return;
+    }
+    if (InstanceIndex >= Fields.Num())
+    {
+        Fields.SetNumZeroed(InstanceIndex + 1);
+    }
+    if (Fields[InstanceIndex] == 0)
+    {
+        Indices.Add(InstanceIndex);
+    }
+    Fields[InstanceIndex] |= InFields;
+}
+
+void UISMReplicationSubsystem::FInstanceFieldSet::Reset()
+{
+    for (int32 InstanceIndex : Indices)
+    {
+        Fields[InstanceIndex] = 0;
+    }
+    Indices.Reset();
+}
+
+bool UISMReplicationSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMReplicationSubsystem::Deinitialize()
+{
+    for (int32 Slot = Components.Num() - 1; Slot >= 0; --Slot)
+    {
+        RemoveComponentAt(Slot);
+    }
+    while (Clients.Num() > 0)
+    {
+        RemoveClientAt(Clients.Num() - 1);
+    }
+    Super::Deinitialize();
+}
+
+bool UISMReplicationSubsystem::RegisterClient(UISMReplicationClientComponent* Client)
+{
+    if (!Client)
+    {
+        return false;
+    }
+
+    if (Client->ReplicationClientIndex == INDEX_NONE)
+    {
+        Client->ReplicationClientIndex = Clients.Num();
+        FClientEntry& Entry = Clients.AddDefaulted_GetRef();
+        Entry.Client = Client;
+
+        // Late join: everything that has changed so far is pending for this client
+        Entry.Components.SetNum(Components.Num());
+        for (int32 Slot = 0; Slot < Components.Num(); Slot++)
+        {
+            const FInstanceFieldSet& EverChanged = Components[Slot].EverChanged;
+            for (int32 InstanceIndex : EverChanged.Indices)
+            {
+                Entry.Components[Slot].Pending.Add(InstanceIndex, EverChanged.Fields[InstanceIndex]);
+            }
+        }
+    }
+    return true;
+}
+
+void UISMReplicationSubsystem::UnregisterClient(UISMReplicationClientComponent* Client)
+{
+    if (!Client || !Clients.IsValidIndex(Client->ReplicationClientIndex) || Clients[Client->ReplicationClientIndex].Client.Get() != Client)
+    {
+        return;
+    }
+
+    RemoveClientAt(Client->ReplicationClientIndex);
+}
+
+void UISMReplicationSubsystem::RemoveClientAt(int32 Index)
+{
+    if (UISMReplicationClientComponent* Removed = Clients[Index].Client.Get())
+    {
+        Removed->ReplicationClientIndex = INDEX_NONE;
+    }
+
+    Clients.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Clients.IsValidIndex(Index))
+    {
+        if (UISMReplicationClientComponent* Moved = Clients[Index].Client.Get())
+        {
+            Moved->ReplicationClientIndex = Index;
+        }
+    }
+}
+
+void UISMReplicationSubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMReplicationSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Replication);
+
+    // Changes are tracked before any client connects, so late joiners still get them
+    const UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_Client || World->GetNetMode() == NM_Standalone)
+    {
+        return;
+    }
+
+    TimeSinceDiscovery += DeltaTime;
+    if (TimeSinceDiscovery >= ComponentDiscoveryInterval)
+    {
+        TimeSinceDiscovery = 0.0f;
+        DiscoverComponents();
+    }
+
+    CollectCustomDataChanges();
+    FanOutDirty();
+
+    // Reversed so removing a destroyed client never skips one
+    for (int32 Index = Clients.Num() - 1; Index >= 0; --Index)
+    {
+        FClientEntry& Entry = Clients[Index];
+        UISMReplicationClientComponent* Client = Entry.Client.Get();
+        if (!Client)
+        {
+            RemoveClientAt(Index);
+            continue;
+        }
+
+        Entry.PendingDeltaTime += DeltaTime;
+        if (Entry.PendingDeltaTime >= Client->NetUpdateInterval)
+        {
+            Entry.PendingDeltaTime = 0.0f;
+            SendUpdate(Entry, Client);
+        }
+    }
+}
+
+void UISMReplicationSubsystem::DiscoverComponents()
+{
+    for (int32 Slot = Components.Num() - 1; Slot >= 0; --Slot)
+    {
+        if (!Components[Slot].Component.IsValid())
+        {
+            RemoveComponentAt(Slot);
+        }
+    }
+
+    UISMRuntimeSubsystem* RuntimeSubsystem = GetWorld()->GetSubsystem<UISMRuntimeSubsystem>();
+    if (!RuntimeSubsystem)
+    {
+        return;
+    }
+
+    for (UISMRuntimeComponent* Component : RuntimeSubsystem->GetAllComponents())
+    {
+        if (Component && Component->IsISMInitialized() && !ComponentSlots.Contains(Component))
+        {
+            AddComponent(Component);
+        }
+    }
+}
+
+void UISMReplicationSubsystem::AddComponent(UISMRuntimeComponent* Component)
+{
+    const int32 Slot = Components.Num();
+    ComponentSlots.Add(Component, Slot);
+
+    FReplicatedComponent& Record = Components.AddDefaulted_GetRef();
+    Record.Component = Component;
+
+    FISMCustomDataJournal& Journal = Component->GetCustomDataJournal();
+    if (!Journal.IsEnabled())
+    {
+        Journal.Enable();
+    }
+    Record.JournalWatermark = Journal.GetWatermark();
+
+    Record.StateChangedHandle = Component->OnInstanceStateChangedNative.AddUObject(this, &UISMReplicationSubsystem::OnInstanceStateChanged);
+    Record.BatchStatesChangedHandle = Component->OnBatchInstanceStatesChangedNative.AddUObject(this, &UISMReplicationSubsystem::OnInstanceStatesChanged);
+    Record.BatchChangedHandle = Component->OnInstancesChangedBatchNative.AddUObject(this, &UISMReplicationSubsystem::OnInstancesChangedBatch);
+    Record.DestroyedHandle = Component->OnInstanceDestroyedNative.AddUObject(this, &UISMReplicationSubsystem::OnInstanceStateChanged);
+    Record.TagsChangedHandle = Component->OnInstanceTagsChangedNative.AddUObject(this, &UISMReplicationSubsystem::OnInstanceTagsChanged);
+    Record.OwnerChangedHandle = Component->OnInstanceOwnerChangedNative.AddUObject(this, &UISMReplicationSubsystem::OnInstanceOwnerChanged);
+
+    for (FClientEntry& Entry : Clients)
+    {
+        Entry.Components.AddDefaulted();
+    }
+}
+
+void UISMReplicationSubsystem::RemoveComponentAt(int32 Slot)
+{
+    FReplicatedComponent& Record = Components[Slot];
+    if (UISMRuntimeComponent* Component = Record.Component.Get())
+    {
+        Component->OnInstanceStateChangedNative.Remove(Record.StateChangedHandle);
+        Component->OnBatchInstanceStatesChangedNative.Remove(Record.BatchStatesChangedHandle);
+        Component->OnInstancesChangedBatchNative.Remove(Record.BatchChangedHandle);
+        Component->OnInstanceDestroyedNative.Remove(Record.DestroyedHandle);
+        Component->OnInstanceTagsChangedNative.Remove(Record.TagsChangedHandle);
+        Component->OnInstanceOwnerChangedNative.Remove(Record.OwnerChangedHandle);
+    }
+    ComponentSlots.Remove(Record.Component);
+
+    Components.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    for (FClientEntry& Entry : Clients)
+    {
+        Entry.Components.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    }
+
+    if (Components.IsValidIndex(Slot))
+    {
+        ComponentSlots.Add(Components[Slot].Component, Slot);
+    }
+}
+
+void UISMReplicationSubsystem::MarkDirty(UISMRuntimeComponent* Component, int32 InstanceIndex, EISMReplicatedField Fields)
+{
+    if (const int32* Slot = ComponentSlots.Find(Component))
+    {
+        Components[*Slot].Dirty.Add(InstanceIndex, static_cast<uint8>(Fields));
+    }
+}
+
+void UISMReplicationSubsystem::CollectCustomDataChanges()
+{
+    TArray<FISMCustomDataDelta> Deltas;
+    for (FReplicatedComponent& Record : Components)
+    {
+        UISMRuntimeComponent* Component = Record.Component.Get();
+        if (!Component)
+        {
+            continue;
+        }
+
+        const FISMCustomDataJournal& Journal = Component->GetCustomDataJournal();
+        if (Journal.GetWatermark() == Record.JournalWatermark)
+        {
+            continue;
+        }
+
+        Deltas.Reset();
+        if (Journal.CollectSince(Record.JournalWatermark, Deltas))
+        {
+            for (const FISMCustomDataDelta& Delta : Deltas)
+            {
+                Record.Dirty.Add(Delta.InstanceIndex, static_cast<uint8>(EISMReplicatedField::CustomData));
+            }
+        }
+        else
+        {
+            // Custom data was reset or relaid out; resend every row
+            const int32 NumInstances = Component->GetInstanceStateStore().Num();
+            for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+            {
+                Record.Dirty.Add(InstanceIndex, static_cast<uint8>(EISMReplicatedField::CustomData));
+            }
+        }
+        Record.JournalWatermark = Journal.GetWatermark();
+    }
+}
+
+void UISMReplicationSubsystem::FanOutDirty()
+{
+    for (int32 Slot = 0; Slot < Components.Num(); Slot++)
+    {
+        FReplicatedComponent& Record = Components[Slot];
+        if (Record.Dirty.Indices.Num() == 0)
+        {
+            continue;
+        }
+
+        for (int32 InstanceIndex : Record.Dirty.Indices)
+        {
+            const uint8 Fields = Record.Dirty.Fields[InstanceIndex];
+            Record.EverChanged.Add(InstanceIndex, Fields);
+            for (FClientEntry& Entry : Clients)
+            {
+                Entry.Components[Slot].Pending.Add(InstanceIndex, Fields);
+            }
+        }
+        Record.Dirty.Reset();
+    }
+}
+
+void UISMReplicationSubsystem::SendUpdate(FClientEntry& Entry, UISMReplicationClientComponent* Client)
+{
+    const APlayerController* Controller = Cast<APlayerController>(Client->GetOwner());
+    const int32 NumComponents = Components.Num();
+    if (!Controller || NumComponents == 0)
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    const double RelevancyDistanceSquared = FMath::Square(static_cast<double>(Client->RelevancyDistance));
+
+    int32 BytesLeft = Client->MaxBytesPerUpdate;
+    TArray<FISMReplicatedComponentDelta> Deltas;
+
+    const int32 FirstSlot = Entry.NextComponent % NumComponents;
+    for (int32 Step = 0; Step < NumComponents && BytesLeft > 0; Step++)
+    {
+        const int32 Slot = (FirstSlot + Step) % NumComponents;
+        FClientComponentState& State = Entry.Components[Slot];
+        if (State.Pending.Indices.Num() == 0)
+        {
+            continue;
+        }
+
+        FReplicatedComponent& Record = Components[Slot];
+        const UISMRuntimeComponent* Component = Record.Component.Get();
+        if (!Component || !Component->IsISMInitialized())
+        {
+            continue;
+        }
+
+        // Whole component out of range: nothing in it is relevant, leave it all pending
+        if (Component->IsBoundsValid()
+            && Component->GetInstanceBounds().ComputeSquaredDistanceToPoint(ViewLocation) > RelevancyDistanceSquared)
+        {
+            continue;
+        }
+
+        FISMReplicatedComponentDelta Delta;
+        BuildDelta(Record, State, ViewLocation, RelevancyDistanceSquared, BytesLeft, Delta);
+        if (Delta.Instances.Num() > 0)
+        {
+            Deltas.Add(MoveTemp(Delta));
+        }
+    }
+    Entry.NextComponent = (FirstSlot + 1) % NumComponents;
+
+    if (Deltas.Num() > 0)
+    {
+        Client->ClientReceiveDeltas(Deltas);
+    }
+}
+
+void UISMReplicationSubsystem::BuildDelta(FReplicatedComponent& Record, FClientComponentState& State, const FVector& ViewLocation,
+    double RelevancyDistanceSquared, int32& BytesLeft, FISMReplicatedComponentDelta& Delta)
+{
+    UISMRuntimeComponent* Component = Record.Component.Get();
+    const float CellSize = Component->GetSpatialIndex().GetCellSize();
+
+    // Relevancy is decided per spatial cell, so neighbouring instances arrive together
+    TMap<FIntVector, bool> CellRelevance;
+
+    // Dictionary entries go out with the first instance that uses them, at most
+    // MaxNewDictionaryTags per delta; instances needing more wait for the next update
+    int32 DictionaryEnd = State.NumDictionarySent;
+
+    FInstanceFieldSet& Pending = State.Pending;
+    int32 NumKept = 0;
+    for (int32 Read = 0; Read < Pending.Indices.Num(); Read++)
+    {
+        const int32 InstanceIndex = Pending.Indices[Read];
+        const uint8 Fields = Pending.Fields[InstanceIndex];
+
+        // The slot no longer exists; nothing to send
+        if (!Component->IsValidInstanceIndex(InstanceIndex))
+        {
+            Pending.Fields[InstanceIndex] = 0;
+            continue;
+        }
+
+        bool bSend = BytesLeft > 0;
+        if (bSend)
+        {
+            const FIntVector Cell = FISMSpatialIndex::LocationToCell(Component->GetInstanceLocation(InstanceIndex), CellSize);
+            if (const bool* bCached = CellRelevance.Find(Cell))
+            {
+                bSend = *bCached;
+            }
+            else
+            {
+                const FVector CellMin = FVector(Cell) * CellSize;
+                const FBox CellBox(CellMin, CellMin + FVector(CellSize));
+                bSend = CellBox.ComputeSquaredDistanceToPoint(ViewLocation) <= RelevancyDistanceSquared;
+                CellRelevance.Add(Cell, bSend);
+            }
+        }
+
+        if (bSend)
+        {
+            FISMReplicatedInstance Instance;
+            ReadInstance(Record, InstanceIndex, Fields, Instance);
+
+            int32 NeededEnd = DictionaryEnd;
+            for (const uint16 TagId : Instance.TagIds)
+            {
+                NeededEnd = FMath::Max(NeededEnd, TagId + 1);
+            }
+
+            if (NeededEnd - State.NumDictionarySent <= FISMReplicatedComponentDelta::MaxNewDictionaryTags)
+            {
+                int32 Bytes = FISMReplicatedComponentDelta::EstimateInstanceBytes(Instance);
+                for (int32 TagId = DictionaryEnd; TagId < NeededEnd; TagId++)
+                {
+                    Bytes += FISMReplicatedComponentDelta::EstimateDictionaryTagBytes(Record.Dictionary[TagId]);
+                }
+
+                if (Bytes <= BytesLeft)
+                {
+                    BytesLeft -= Bytes;
+                    for (; DictionaryEnd < NeededEnd; DictionaryEnd++)
+                    {
+                        Delta.NewDictionaryTags.Add(Record.Dictionary[DictionaryEnd]);
+                    }
+                    Delta.Instances.Add(MoveTemp(Instance));
+                    Pending.Fields[InstanceIndex] = 0;
+                    continue;
+                }
+                BytesLeft = 0;
+            }
+        }
+
+        Pending.Indices[NumKept++] = InstanceIndex;
+    }
+    Pending.Indices.SetNum(NumKept, EAllowShrinking::No);
+
+    if (Delta.Instances.Num() == 0)
+    {
+        return;
+    }
+
+    Delta.Component = Component;
+    Delta.Instances.Sort([](const FISMReplicatedInstance& A, const FISMReplicatedInstance& B)
+        {
+            return A.InstanceIndex < B.InstanceIndex;
+        });
+    State.NumDictionarySent = DictionaryEnd;
+}
+
+void UISMReplicationSubsystem::ReadInstance(FReplicatedComponent& Record, int32 InstanceIndex, uint8 Fields, FISMReplicatedInstance& Out)
+{
+    UISMRuntimeComponent* Component = Record.Component.Get();
+    Out.InstanceIndex = InstanceIndex;
+    Out.Fields = Fields;
+
+    if (Out.HasField(EISMReplicatedField::State))
+    {
+        Out.StateFlags = Component->GetInstanceStateFlags(InstanceIndex);
+    }
+
+    if (Out.HasField(EISMReplicatedField::Owner))
+    {
+        const FGameplayTag OwnerTag = Component->GetInstanceHandle(InstanceIndex).GetOwnerTag();
+        const int32 OwnerId = OwnerTag.IsValid() ? FindOrAddTagId(Record, OwnerTag) : INDEX_NONE;
+        Out.OwnerId = static_cast<uint16>(OwnerId + 1);
+    }
+
+    if (Out.HasField(EISMReplicatedField::Tags))
+    {
+        const FGameplayTagContainer Tags = Component->GetInstanceTags(InstanceIndex);
+        for (const FGameplayTag& Tag : Tags)
+        {
+            // Component tags are the same on every machine
+            if (Component->ISMComponentTags.HasTagExact(Tag))
+            {
+                continue;
+            }
+            const int32 TagId = FindOrAddTagId(Record, Tag);
+            if (TagId != INDEX_NONE)
+            {
+                Out.TagIds.Add(static_cast<uint16>(TagId));
+            }
+        }
+    }
+
+    if (Out.HasField(EISMReplicatedField::CustomData))
+    {
+        Out.CustomData.Append(Component->GetInstanceCustomDataView(InstanceIndex));
+    }
+}
+
+int32 UISMReplicationSubsystem::FindOrAddTagId(FReplicatedComponent& Record, FGameplayTag Tag)
+{
+    if (const uint16* Id = Record.DictionaryIds.Find(Tag))
+    {
+        return *Id;
+    }
+
+    // Owner ids are sent as id + 1, so the last uint16 stays free
+    if (Record.Dictionary.Num() >= MAX_uint16)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Id = Record.Dictionary.Add(Tag);
+    Record.DictionaryIds.Add(Tag, static_cast<uint16>(Id));
+    return Id;
+}
+
+void UISMReplicationSubsystem::OnInstanceStateChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
+{
+    MarkDirty(Component, InstanceIndex, EISMReplicatedField::State);
+}
+
+void UISMReplicationSubsystem::OnInstanceStatesChanged(UISMRuntimeComponent* Component, const TArray<int32>& InstanceIndices)
+{
+    for (int32 InstanceIndex : InstanceIndices)
+    {
+        MarkDirty(Component, InstanceIndex, EISMReplicatedField::State);
+    }
+}
+
+void UISMReplicationSubsystem::OnInstancesChangedBatch(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices)
+{
+    // A batch folds state, destruction and tag events together; the current values are sent anyway
+    for (int32 InstanceIndex : InstanceIndices)
+    {
+        MarkDirty(Component, InstanceIndex, EISMReplicatedField::State | EISMReplicatedField::Tags);
+    }
+}
+
+void UISMReplicationSubsystem::OnInstanceTagsChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
+{
+    MarkDirty(Component, InstanceIndex, EISMReplicatedField::Tags);
+}
+
+void UISMReplicationSubsystem::OnInstanceOwnerChanged(UISMRuntimeComponent* Component, int32 InstanceIndex)
+{
+    MarkDirty(Component, InstanceIndex, EISMReplicatedField::Owner);
+}
@@ -0,0 +1,163 @@
+#include "ISMReplicationTypes.h"
+#include "ISMRuntimeComponent.h"
+#include "UObject/CoreNet.h"
+
+namespace ISMReplication
+{
+    // Loading limits, so a malformed packet cannot make the receiver allocate without bound
+    constexpr uint32 MaxInstancesPerDelta = 1 << 16;
+    constexpr uint32 MaxTagsPerInstance = 256;
+    constexpr uint32 MaxCustomDataPerInstance = 1024;
+
+    /** Packed length prefix; false if a loaded count is over Max */
+    bool SerializeCount(FArchive& Ar, uint32& Count, uint32 Max)
+    {
+        Ar.SerializeIntPacked(Count);
+        if (Ar.IsLoading() && Count > Max)
+        {
+            Ar.SetError();
+            return false;
+        }
+        return true;
+    }
+}
+
+int32 FISMReplicatedComponentDelta::EstimateInstanceBytes(const FISMReplicatedInstance& Instance)
+{
+    // Index delta and field bits
+    int32 Bytes = 4;
+    if (Instance.HasField(EISMReplicatedField::State))
+    {
+        Bytes += 1;
+    }
+    if (Instance.HasField(EISMReplicatedField::Owner))
+    {
+        Bytes += 3;
+    }
+    if (Instance.HasField(EISMReplicatedField::Tags))
+    {
+        Bytes += 1 + 3 * Instance.TagIds.Num();
+    }
+    if (Instance.HasField(EISMReplicatedField::CustomData))
+    {
+        Bytes += 2 + 4 * Instance.CustomData.Num();
+    }
+    return Bytes;
+}
+
+int32 FISMReplicatedComponentDelta::EstimateDictionaryTagBytes(const FGameplayTag& Tag)
+{
+    // A name when tags are not fast-replicated; an index is far smaller
+    return 2 + static_cast<int32>(Tag.GetTagName().GetStringLength());
+}
+
+bool FISMReplicatedComponentDelta::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    bOutSuccess = true;
+
+    UObject* ComponentObject = Component;
+    bOutSuccess &= Map->SerializeObject(Ar, UISMRuntimeComponent::StaticClass(), ComponentObject);
+    if (Ar.IsLoading())
+    {
+        Component = Cast<UISMRuntimeComponent>(ComponentObject);
+    }
+
+    uint32 NumTags = NewDictionaryTags.Num();
+    if (!ISMReplication::SerializeCount(Ar, NumTags, FISMReplicatedComponentDelta::MaxNewDictionaryTags))
+    {
+        bOutSuccess = false;
+        return false;
+    }
+    if (Ar.IsLoading())
+    {
+        NewDictionaryTags.SetNum(NumTags);
+    }
+    for (FGameplayTag& Tag : NewDictionaryTags)
+    {
+        bool bTagSuccess = true;
+        Tag.NetSerialize(Ar, Map, bTagSuccess);
+        bOutSuccess &= bTagSuccess;
+    }
+
+    uint32 NumInstances = Instances.Num();
+    if (!ISMReplication::SerializeCount(Ar, NumInstances, ISMReplication::MaxInstancesPerDelta))
+    {
+        bOutSuccess = false;
+        return false;
+    }
+    if (Ar.IsLoading())
+    {
+        Instances.SetNum(NumInstances);
+    }
+
+    int32 PreviousIndex = INDEX_NONE;
+    for (FISMReplicatedInstance& Instance : Instances)
+    {
+        // Sorted and unique, so the gap to the previous index is never negative
+        uint32 IndexGap = Ar.IsSaving() ? static_cast<uint32>(Instance.InstanceIndex - PreviousIndex - 1) : 0;
+        Ar.SerializeIntPacked(IndexGap);
+        if (Ar.IsLoading())
+        {
+            Instance.InstanceIndex = PreviousIndex + 1 + static_cast<int32>(IndexGap);
+        }
+        PreviousIndex = Instance.InstanceIndex;
+
+        Ar << Instance.Fields;
+
+        if (Instance.HasField(EISMReplicatedField::State))
+        {
+            Ar << Instance.StateFlags;
+        }
+
+        if (Instance.HasField(EISMReplicatedField::Owner))
+        {
+            uint32 OwnerId = Instance.OwnerId;
+            Ar.SerializeIntPacked(OwnerId);
+            Instance.OwnerId = static_cast<uint16>(OwnerId);
+        }
+
+        if (Instance.HasField(EISMReplicatedField::Tags))
+        {
+            uint32 NumInstanceTags = Instance.TagIds.Num();
+            if (!ISMReplication::SerializeCount(Ar, NumInstanceTags, ISMReplication::MaxTagsPerInstance))
+            {
+                bOutSuccess = false;
+                return false;
+            }
+            if (Ar.IsLoading())
+            {
+                Instance.TagIds.SetNum(NumInstanceTags);
+            }
+            for (uint16& TagId : Instance.TagIds)
+            {
+                uint32 PackedId = TagId;
+                Ar.SerializeIntPacked(PackedId);
+                TagId = static_cast<uint16>(PackedId);
+            }
+        }
+
+        if (Instance.HasField(EISMReplicatedField::CustomData))
+        {
+            uint32 NumFloats = Instance.CustomData.Num();
+            if (!ISMReplication::SerializeCount(Ar, NumFloats, ISMReplication::MaxCustomDataPerInstance))
+            {
+                bOutSuccess = false;
+                return false;
+            }
+            if (Ar.IsLoading())
+            {
+                Instance.CustomData.SetNum(NumFloats);
+            }
+            for (float& Value : Instance.CustomData)
+            {
+                Ar << Value;
+            }
+        }
+    }
+
+    if (Ar.IsError())
+    {
+        bOutSuccess = false;
+    }
+    return true;
+}
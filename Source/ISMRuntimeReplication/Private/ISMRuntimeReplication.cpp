@@ -0,0 +1,17 @@
+#include "ISMRuntimeReplication.h"
+
+LLM_DEFINE_TAG(ISMRuntime_Replication);
+
+#define LOCTEXT_NAMESPACE "FISMRuntimeReplicationModule"
+
+void FISMRuntimeReplication::StartupModule()
+{
+}
+
+void FISMRuntimeReplication::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FISMRuntimeReplication, ISMRuntimeReplication)
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "ISMReplicationTypes.h"
+#include "ISMReplicationClientComponent.generated.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * Carries replicated ISM instance state to one player.
+ *
+ * Add to the PlayerController class. On the server it registers with UISMReplicationSubsystem,
+ * which sends it batched instance updates; on the owning client it applies them to the matching
+ * runtime components - destruction and hiding through the component's own calls so feedbacks
+ * play, the remaining state flags in one BatchWriteInstanceStateFlags per component.
+ */
+UCLASS(ClassGroup=(ISMRuntime), meta=(BlueprintSpawnableComponent))
+class ISMRUNTIMEREPLICATION_API UISMReplicationClientComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UISMReplicationClientComponent();
+
+    /** Instances whose spatial cell is farther than this from the player's view point wait until it comes closer */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Replication", meta = (ClampMin = "0"))
+    float RelevancyDistance = 15000.0f;
+
+    /** Seconds between updates to this player */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Replication", meta = (ClampMin = "0"))
+    float NetUpdateInterval = 0.1f;
+
+    /** Approximate payload cap per update; instances past it go out in later updates */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ISM Replication", meta = (ClampMin = "512"))
+    int32 MaxBytesPerUpdate = 4096;
+
+    /** Server to owning client: one update, a delta per component */
+    UFUNCTION(Client, Reliable)
+    void ClientReceiveDeltas(const TArray<FISMReplicatedComponentDelta>& Deltas);
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndReason) override;
+
+private:
+    friend class UISMReplicationSubsystem;
+
+    /** Slot in the subsystem's client list, INDEX_NONE when not registered */
+    int32 ReplicationClientIndex = INDEX_NONE;
+
+    struct FReceivedComponent
+    {
+        /** The server's tag dictionary for this component, as received so far */
+        TArray<FGameplayTag> Dictionary;
+
+        /** Replicated instance tags last applied, so tags added locally are left alone */
+        TMap<int32, TArray<FGameplayTag>> AppliedTags;
+    };
+
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, FReceivedComponent> ReceivedComponents;
+
+    void ApplyDelta(const FISMReplicatedComponentDelta& Delta);
+};
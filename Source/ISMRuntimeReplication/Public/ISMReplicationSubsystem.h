@@ -0,0 +1,157 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "ISMReplicationTypes.h"
+#include "ISMReplicationSubsystem.generated.h"
+
+class UISMRuntimeComponent;
+class UISMReplicationClientComponent;
+
+/**
+ * Server-side replication of ISM instance state.
+ *
+ * Every initialized runtime component is picked up from the runtime subsystem and watched through
+ * its native events; custom data changes are read from its custom data journal (which this
+ * subsystem enables). Changes are recorded as per-instance field bits - state flags, instance
+ * tags, owner, custom data - and fanned out to a pending bitset per client. Each client's
+ * NetUpdateInterval, the pending instances that are relevant to it (the component's bounds and
+ * then the instance's spatial cell within RelevancyDistance of the player's view point) go out
+ * with their current values in one reliable RPC, up to MaxBytesPerUpdate. Whatever does not fit,
+ * or is not relevant yet, stays pending, so repeated changes to one instance coalesce into a
+ * single send of its latest state.
+ *
+ * Components are picked up within ComponentDiscoveryInterval of initializing; a client joining late
+ * is sent every instance that has changed since then.
+ * Instance indices are assumed to match on server and clients (the same level and data assets);
+ * transforms and added instances are not replicated.
+ */
+UCLASS()
+class ISMRUNTIMEREPLICATION_API UISMReplicationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual void Deinitialize() override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMReplicationSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Start replicating to a client. Returns false if it could not be added. */
+    bool RegisterClient(UISMReplicationClientComponent* Client);
+
+    /** Stop replicating to a client; no-op if it is not registered */
+    void UnregisterClient(UISMReplicationClientComponent* Client);
+
+    /** Clients being replicated to */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Replication")
+    int32 GetNumClients() const { return Clients.Num(); }
+
+    /** Runtime components being watched */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Replication")
+    int32 GetNumReplicatedComponents() const { return Components.Num(); }
+
+private:
+    /** How often new runtime components are looked for */
+    static constexpr float ComponentDiscoveryInterval = 0.5f;
+
+    /** Per-instance field bits plus the list of instances that have any */
+    struct FInstanceFieldSet
+    {
+        TArray<uint8> Fields;
+        TArray<int32> Indices;
+
+        void Add(int32 InstanceIndex, uint8 InFields);
+        void Reset();
+    };
+
+    struct FReplicatedComponent
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+
+        /** Changed since the last fan-out to clients */
+        FInstanceFieldSet Dirty;
+
+        /** Changed since the component was picked up, for clients that register later */
+        FInstanceFieldSet EverChanged;
+
+        /** Journal serial the next custom data read starts from */
+        uint32 JournalWatermark = 0;
+
+        /** Owner and instance tags by id; ids are never reused, so clients only ever append */
+        TArray<FGameplayTag> Dictionary;
+        TMap<FGameplayTag, uint16> DictionaryIds;
+
+        FDelegateHandle StateChangedHandle;
+        FDelegateHandle BatchStatesChangedHandle;
+        FDelegateHandle BatchChangedHandle;
+        FDelegateHandle DestroyedHandle;
+        FDelegateHandle TagsChangedHandle;
+        FDelegateHandle OwnerChangedHandle;
+    };
+
+    struct FClientComponentState
+    {
+        /** Changed and not yet sent to this client */
+        FInstanceFieldSet Pending;
+
+        /** Dictionary entries this client has been sent */
+        int32 NumDictionarySent = 0;
+    };
+
+    struct FClientEntry
+    {
+        TWeakObjectPtr<UISMReplicationClientComponent> Client;
+
+        /** Parallel to Components */
+        TArray<FClientComponentState> Components;
+
+        /** Time since this client's last update */
+        float PendingDeltaTime = 0.0f;
+
+        /** Component the next update starts from, so a full budget does not starve later components */
+        int32 NextComponent = 0;
+    };
+
+    /** Dense; a component's slot is also its slot in every client's Components */
+    TArray<FReplicatedComponent> Components;
+    TMap<TWeakObjectPtr<UISMRuntimeComponent>, int32> ComponentSlots;
+
+    /** Dense; each client stores its index so removal is a swap */
+    TArray<FClientEntry> Clients;
+
+    float TimeSinceDiscovery = ComponentDiscoveryInterval;
+
+    void DiscoverComponents();
+    void AddComponent(UISMRuntimeComponent* Component);
+    void RemoveComponentAt(int32 Slot);
+    void RemoveClientAt(int32 Index);
+
+    void MarkDirty(UISMRuntimeComponent* Component, int32 InstanceIndex, EISMReplicatedField Fields);
+    void CollectCustomDataChanges();
+    void FanOutDirty();
+
+    void SendUpdate(FClientEntry& Entry, UISMReplicationClientComponent* Client);
+
+    /** Move the relevant pending instances of one component into Delta, spending BytesLeft */
+    void BuildDelta(FReplicatedComponent& Record, FClientComponentState& State, const FVector& ViewLocation,
+        double RelevancyDistanceSquared, int32& BytesLeft, FISMReplicatedComponentDelta& Delta);
+
+    void ReadInstance(FReplicatedComponent& Record, int32 InstanceIndex, uint8 Fields, FISMReplicatedInstance& Out);
+
+    /** Dictionary id for Tag, adding it if new; INDEX_NONE once the dictionary is full */
+    static int32 FindOrAddTagId(FReplicatedComponent& Record, FGameplayTag Tag);
+
+    void OnInstanceStateChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
+    void OnInstanceStatesChanged(UISMRuntimeComponent* Component, const TArray<int32>& InstanceIndices);
+    void OnInstancesChangedBatch(UISMRuntimeComponent* Component, TArrayView<const int32> InstanceIndices);
+    void OnInstanceTagsChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
+    void OnInstanceOwnerChanged(UISMRuntimeComponent* Component, int32 InstanceIndex);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ISMReplicationTypes.generated.h"
+
+class UISMRuntimeComponent;
+class UPackageMap;
+
+/** Per-instance fields a replicated update can carry, as bits of FISMReplicatedInstance::Fields */
+enum class EISMReplicatedField : uint8
+{
+    None       = 0,
+    State      = 1 << 0,
+    Tags       = 1 << 1,
+    Owner      = 1 << 2,
+    CustomData = 1 << 3,
+
+    All        = State | Tags | Owner | CustomData
+};
+ENUM_CLASS_FLAGS(EISMReplicatedField);
+
+/**
+ * Current value of the changed fields of one instance. Only the fields named in Fields are
+ * meaningful; the rest are left default and not serialized.
+ */
+struct FISMReplicatedInstance
+{
+    int32 InstanceIndex = INDEX_NONE;
+
+    /** EISMReplicatedField bits */
+    uint8 Fields = 0;
+
+    /** EISMInstanceState flags */
+    uint8 StateFlags = 0;
+
+    /** Owner tag as dictionary id + 1; 0 = no owner */
+    uint16 OwnerId = 0;
+
+    /** Instance tags (not the component's) as dictionary ids */
+    TArray<uint16, TInlineAllocator<4>> TagIds;
+
+    /** Every custom data slot of the instance */
+    TArray<float> CustomData;
+
+    bool HasField(EISMReplicatedField Field) const { return (Fields & static_cast<uint8>(Field)) != 0; }
+};
+
+/**
+ * One component's share of a replication update.
+ *
+ * Tags travel as ids into a per-component dictionary the server grows as it sees new tags; each
+ * delta carries the entries the receiving client has not been sent yet, so a tag's name crosses
+ * the wire once per client. Instances go out sorted by index and delta-encoded.
+ */
+USTRUCT()
+struct ISMRUNTIMEREPLICATION_API FISMReplicatedComponentDelta
+{
+    GENERATED_BODY()
+
+    /** Net-addressable component (placed in the level or owned by a replicated actor) */
+    UPROPERTY()
+    TObjectPtr<UISMRuntimeComponent> Component = nullptr;
+
+    /** Dictionary entries appended after the ones this client already has */
+    TArray<FGameplayTag> NewDictionaryTags;
+
+    /** Most NewDictionaryTags one delta may carry; the receiver rejects more */
+    static constexpr int32 MaxNewDictionaryTags = 1024;
+
+    /** Sorted by InstanceIndex, each index at most once */
+    TArray<FISMReplicatedInstance> Instances;
+
+    /** Approximate serialized size of one instance, for the sender's byte budget */
+    static int32 EstimateInstanceBytes(const FISMReplicatedInstance& Instance);
+
+    /** Approximate serialized size of one NewDictionaryTags entry */
+    static int32 EstimateDictionaryTagBytes(const FGameplayTag& Tag);
+
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FISMReplicatedComponentDelta> : public TStructOpsTypeTraitsBase2<FISMReplicatedComponentDelta>
+{
+    enum
+    {
+        WithNetSerializer = true
+    };
+};
@@ -1,5 +1,7 @@
 #include "ISMCollectorComponent.h"
+#include "ISMRuntimeResource.h"
 #include "ISMResourceComponent.h"
+#include "ISMResourceQuerySubsystem.h"
 #include "ISMRuntimeSubsystem.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Camera/CameraComponent.h"
@@ -28,14 +30,34 @@ void UISMCollectorComponent::BeginPlay()
     {
         CachedCamera = CameraComponent;
     }
+
+    if (bUseSharedDetection && DetectionMode == ECollectionDetectionMode::Radius)
+    {
+        if (UISMResourceQuerySubsystem* QuerySubsystem = GetWorld() ? GetWorld()->GetSubsystem<UISMResourceQuerySubsystem>() : nullptr)
+        {
+            QuerySubsystem->RegisterCollector(this);
+        }
+    }
+}
+
+void UISMCollectorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UISMResourceQuerySubsystem* QuerySubsystem = GetWorld() ? GetWorld()->GetSubsystem<UISMResourceQuerySubsystem>() : nullptr)
+    {
+        QuerySubsystem->UnregisterCollector(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void UISMCollectorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    LLM_SCOPE_BYTAG(ISMRuntime_Resource);
+
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    // Run detection if enabled
-    if (bAutoDetect && DetectionMode != ECollectionDetectionMode::Manual)
+    // Run detection if enabled; the shared pass detects for registered radius collectors
+    if (bAutoDetect && DetectionMode != ECollectionDetectionMode::Manual && !IsUsingSharedDetection())
     {
         DetectionTimer += DeltaTime;
 
@@ -118,6 +140,7 @@ void UISMCollectorComponent::AddCollectorTag(FGameplayTag Tag)
         return;
 
     CollectorTags.AddTag(Tag);
+    InvalidateCapabilityCache();
     OnCollectorTagsChangedInternal(CollectorTags);
 
     // Re-validate current target if tags changed
@@ -138,6 +161,7 @@ void UISMCollectorComponent::RemoveCollectorTag(FGameplayTag Tag)
         return;
 
     CollectorTags.RemoveTag(Tag);
+    InvalidateCapabilityCache();
     OnCollectorTagsChangedInternal(CollectorTags);
 
     // Re-validate current target
@@ -154,6 +178,7 @@ void UISMCollectorComponent::RemoveCollectorTag(FGameplayTag Tag)
 void UISMCollectorComponent::SetCollectorTags(const FGameplayTagContainer& NewTags)
 {
     CollectorTags = NewTags;
+    InvalidateCapabilityCache();
     OnCollectorTagsChangedInternal(CollectorTags);
 
     // Re-validate current target
@@ -167,6 +192,21 @@ void UISMCollectorComponent::SetCollectorTags(const FGameplayTagContainer& NewTa
     }
 }
 
+void UISMCollectorComponent::InvalidateCapabilityCache()
+{
+    CachedCollectorTags.Reset();
+    CapabilityCaches.Reset();
+}
+
+const FGameplayTagContainer& UISMCollectorComponent::GetEffectiveCollectorTags() const
+{
+    if (!CachedCollectorTags.IsSet())
+    {
+        CachedCollectorTags = GetCollectorTags();
+    }
+    return CachedCollectorTags.GetValue();
+}
+
 // ===== Virtual Hook Implementations =====
 
 FGameplayTagContainer UISMCollectorComponent::GetCollectorTags_Implementation() const
@@ -184,6 +224,12 @@ bool UISMCollectorComponent::CanCollectResource_Implementation(const FISMInstanc
         return false;
     }
 
+    if (bCacheCapabilities)
+    {
+        return ResourceComp->CanCollectorGatherInstanceCached(GetEffectiveCollectorTags(), Instance.InstanceIndex,
+            CapabilityCaches.FindOrAdd(ResourceComp), OutFailureReason);
+    }
+
     // Get current collector tags (may be dynamic)
     FGameplayTagContainer CurrentCollectorTags = GetCollectorTags();
 
@@ -202,6 +248,11 @@ float UISMCollectorComponent::GetCollectionSpeedMultiplier_Implementation(const
     if (!ResourceComp)
         return 1.0f;
 
+    if (bCacheCapabilities)
+    {
+        return ResourceComp->GetCachedSpeedMultiplier(GetEffectiveCollectorTags(), CapabilityCaches.FindOrAdd(ResourceComp));
+    }
+
     // Get speed multiplier from resource component's tag-based modifiers
     FGameplayTagContainer CurrentCollectorTags = GetCollectorTags();
     return ResourceComp->CalculateSpeedMultiplier(CurrentCollectorTags);
@@ -296,6 +347,16 @@ void UISMCollectorComponent::RunDetection()
         return;
     }
 
+    ApplyDetectedTarget(NewTarget, NewResourceComp);
+}
+
+bool UISMCollectorComponent::IsUsingSharedDetection() const
+{
+    return SharedDetectionIndex != INDEX_NONE && bAutoDetect && DetectionMode == ECollectionDetectionMode::Radius;
+}
+
+void UISMCollectorComponent::ApplyDetectedTarget(const FISMInstanceHandle& NewTarget, UISMResourceComponent* NewResourceComp)
+{
     // Check if target changed
     if (NewTarget != TargetedInstance)
     {
@@ -309,6 +370,11 @@ FISMInstanceHandle UISMCollectorComponent::DetectViaRaycast()
     FVector Start, End;
     GetRaycastPoints(Start, End);
 
+    if (bUseSpatialGridTrace)
+    {
+        return DetectViaGridTrace(Start, End);
+    }
+
     // Perform line trace
     FHitResult HitResult;
     FCollisionQueryParams QueryParams;
@@ -353,9 +419,7 @@ FISMInstanceHandle UISMCollectorComponent::DetectViaRaycast()
             // Found the resource component, get instance index from hit
             int32 InstanceIndex = HitResult.Item;
 
-            FISMInstanceHandle Handle;
-            Handle.InstanceIndex = InstanceIndex;
-            Handle.Component = ResourceComp;
+            const FISMInstanceHandle Handle = UISMRuntimeSubsystem::MakeInstanceReference(ResourceComp, InstanceIndex);
 
             // Check if we should consider this instance
             if (ShouldConsiderInstance(Handle, ResourceComp))
@@ -370,6 +434,54 @@ FISMInstanceHandle UISMCollectorComponent::DetectViaRaycast()
     return FISMInstanceHandle();
 }
 
+FISMInstanceHandle UISMCollectorComponent::DetectViaGridTrace(const FVector& Start, const FVector& End)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+        return FISMInstanceHandle();
+
+    UISMRuntimeSubsystem* Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    if (!Subsystem)
+        return FISMInstanceHandle();
+
+    FISMInstanceHandle BestHandle;
+    UISMResourceComponent* BestComp = nullptr;
+    float BestDistance = MAX_flt;
+    FVector TraceEnd = End;
+
+    TArray<FISMSpatialRayHit> Hits;
+    for (UISMRuntimeComponent* RuntimeComp : Subsystem->GetAllComponents())
+    {
+        UISMResourceComponent* ResourceComp = Cast<UISMResourceComponent>(RuntimeComp);
+        if (!ResourceComp || !ResourceComp->IsISMInitialized())
+            continue;
+
+        ResourceComp->TraceInstances(Start, TraceEnd, 0.0f, true, [this, ResourceComp](int32 InstanceIndex)
+            {
+                const FISMInstanceHandle Handle = UISMRuntimeSubsystem::MakeInstanceReference(ResourceComp, InstanceIndex);
+                return ResourceComp->IsInstanceActive(InstanceIndex) && ShouldConsiderInstance(Handle, ResourceComp);
+            }, Hits);
+
+        if (Hits.Num() > 0 && Hits[0].Distance < BestDistance)
+        {
+            BestDistance = Hits[0].Distance;
+            BestHandle = UISMRuntimeSubsystem::MakeInstanceReference(ResourceComp, Hits[0].InstanceIndex);
+            BestComp = ResourceComp;
+
+            // Later components only need to beat this hit
+            TraceEnd = Start + (End - Start).GetSafeNormal() * BestDistance;
+        }
+    }
+
+    if (BestComp)
+    {
+        // Cache the resource component for UpdateTarget
+        TargetedResourceComponent = BestComp;
+    }
+
+    return BestHandle;
+}
+
 FISMInstanceHandle UISMCollectorComponent::DetectViaRadius()
 {
     UWorld* World = GetWorld();
@@ -400,9 +512,7 @@ FISMInstanceHandle UISMCollectorComponent::DetectViaRadius()
 
         for (int32 InstanceIndex : NearbyInstances)
         {
-            FISMInstanceHandle Handle;
-            Handle.InstanceIndex = InstanceIndex;
-            Handle.Component = ResourceComp;
+            const FISMInstanceHandle Handle = UISMRuntimeSubsystem::MakeInstanceReference(ResourceComp, InstanceIndex);
 
             // Check if we should consider this instance
             if (!ShouldConsiderInstance(Handle, ResourceComp))
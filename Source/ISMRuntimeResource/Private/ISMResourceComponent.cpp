@@ -1,4 +1,5 @@
 #include "ISMResourceComponent.h"
+#include "ISMRuntimeResource.h"
 #include "ISMResourceDataAsset.h"
 #include "GameplayTagContainer.h"
 #include "ISMInstanceHandle.h"
@@ -8,7 +9,7 @@
 UISMResourceComponent::UISMResourceComponent()
 {
     PrimaryComponentTick.bCanEverTick = true;
-    PrimaryComponentTick.bStartWithTickEnabled = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false; // Enabled while collections run
 }
 
 void UISMResourceComponent::BeginPlay()
@@ -43,49 +44,104 @@ void UISMResourceComponent::BeginPlay()
         CollectorSpeedModifiers = ResourceData->CollectorSpeedModifiers;
         CollectorYieldModifiers = ResourceData->CollectorYieldModifiers;
     }
+
+    NotifyRequirementsChanged();
+}
+
+namespace
+{
+    struct FEarlierCollectionEvent
+    {
+        template <typename EventType>
+        bool operator()(const EventType& A, const EventType& B) const { return A.DueTime < B.DueTime; }
+    };
 }
 
-void UISMResourceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UISMResourceComponent::TickRuntime(float DeltaTime)
 {
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    LLM_SCOPE_BYTAG(ISMRuntime_Resource);
+
+    Super::TickRuntime(DeltaTime);
 
-    // Update all active collections
-    TArray<int32> CompletedInstances;
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    // Drop collections whose collector went away; reversed since cancelling may swap-remove
+    for (int32 Slot = ActiveCollections.Num() - 1; Slot >= 0; --Slot)
+    {
+        const FResourceCollectionProgress& Progress = ActiveCollections[Slot];
+        if (!Progress.bIsPaused && !Progress.Collector.IsValid())
+        {
+            CancelCollection(Progress.InstanceIndex);
+        }
+    }
 
-    for (auto& Pair : ActiveCollections)
+    // Due stage boundaries and completions. Hooks may start or cancel collections, so look each one up again.
+    TArray<FCollectionEvent, TInlineAllocator<8>> Completed;
+    while (CollectionEvents.Num() > 0 && CollectionEvents.HeapTop().DueTime <= Now)
     {
-        int32 InstanceIndex = Pair.Key;
-        FResourceCollectionProgress& Progress = Pair.Value;
+        FCollectionEvent Event;
+        CollectionEvents.HeapPop(Event, FEarlierCollectionEvent(), EAllowShrinking::No);
 
-        // Skip paused collections
-        if (Progress.bIsPaused)
+        FResourceCollectionProgress* Progress = FindCollection(Event.InstanceIndex);
+        if (!Progress || Progress->Serial != Event.Serial)
+        {
             continue;
+        }
 
-        // Check if collector is still valid
-        if (!Progress.Collector.IsValid())
+        const float CurrentProgress = Progress->GetProgress(Now);
+        if (CurrentProgress >= 1.0f)
         {
-            CancelCollection(InstanceIndex);
+            Completed.Add(Event);
             continue;
         }
 
-        // Update progress
-        UpdateCollectionProgress(InstanceIndex, Progress, DeltaTime);
+        AdvanceCollectionStage(*Progress, CurrentProgress);
+
+        Progress = FindCollection(Event.InstanceIndex);
+        if (Progress && Progress->Serial == Event.Serial)
+        {
+            ScheduleCollectionEvent(*Progress);
+        }
+    }
+
+    // Progress for UI, throttled
+    if (OnCollectionProgress.IsBound() && Now - LastProgressBroadcastTime >= ProgressBroadcastInterval)
+    {
+        LastProgressBroadcastTime = Now;
+
+        // Listeners may cancel collections, so broadcast from a copy
+        TArray<TPair<int32, float>, TInlineAllocator<8>> Running;
+        for (const FResourceCollectionProgress& Progress : ActiveCollections)
+        {
+            if (!Progress.bIsPaused)
+            {
+                Running.Emplace(Progress.InstanceIndex, Progress.GetProgress(Now));
+            }
+        }
 
-        // Check if completed
-        if (Progress.Progress >= 1.0f)
+        for (const TPair<int32, float>& Item : Running)
         {
-            CompletedInstances.Add(InstanceIndex);
+            if (const FResourceCollectionProgress* Progress = FindCollection(Item.Key))
+            {
+                FISMInstanceHandle Handle = GetInstanceHandle(Item.Key);
+                OnCollectionProgress.Broadcast(this, Handle, Progress->Collector.Get(), Item.Value);
+            }
         }
     }
 
     // Finalize completed collections
-    for (int32 InstanceIndex : CompletedInstances)
+    for (const FCollectionEvent& Event : Completed)
     {
-        if (FResourceCollectionProgress* Progress = ActiveCollections.Find(InstanceIndex))
+        if (FResourceCollectionProgress* Progress = FindCollection(Event.InstanceIndex))
         {
-            FinalizeCollection(InstanceIndex, *Progress);
+            if (Progress->Serial == Event.Serial)
+            {
+                FinalizeCollection(Event.InstanceIndex, *Progress);
+            }
         }
     }
+
+    UpdateCollectionTick(Now);
 }
 
 void UISMResourceComponent::BuildComponentTags()
@@ -101,7 +157,7 @@ void UISMResourceComponent::OnInstancePreDestroy(int32 InstanceIndex)
     Super::OnInstancePreDestroy(InstanceIndex);
 
     // Cancel any active collection on this instance
-    if (ActiveCollections.Contains(InstanceIndex))
+    if (CollectionSlots.Contains(InstanceIndex))
     {
         CancelCollection(InstanceIndex);
     }
@@ -113,24 +169,8 @@ bool UISMResourceComponent::CanCollectorGatherInstance(const FGameplayTagContain
     int32 InstanceIndex,
     FText& OutFailureReason) const
 {
-    // Validate instance
-    if (!IsValidInstanceIndex(InstanceIndex))
+    if (!CheckInstanceCollectable(InstanceIndex, OutFailureReason))
     {
-        OutFailureReason = NSLOCTEXT("ISMResource", "InvalidInstance", "Invalid instance");
-        return false;
-    }
-
-    // Check if already destroyed or collected
-    if (IsInstanceDestroyed(InstanceIndex))
-    {
-        OutFailureReason = NSLOCTEXT("ISMResource", "AlreadyCollected", "Already collected");
-        return false;
-    }
-
-    // Check if currently being collected by someone else
-    if (IsInstanceBeingCollected(InstanceIndex))
-    {
-        OutFailureReason = NSLOCTEXT("ISMResource", "BeingCollected", "Someone else is collecting this");
         return false;
     }
 
@@ -155,6 +195,69 @@ bool UISMResourceComponent::CanCollectorGatherInstance(const FGameplayTagContain
     return ValidateCollectionRequirements(CollectorTags, InstanceIndex, OutFailureReason);
 }
 
+bool UISMResourceComponent::CanCollectorGatherInstanceCached(const FGameplayTagContainer& CollectorTags,
+    int32 InstanceIndex,
+    FISMCollectorCapabilityCache& Cache,
+    FText& OutFailureReason) const
+{
+    if (!CheckInstanceCollectable(InstanceIndex, OutFailureReason))
+    {
+        return false;
+    }
+
+    SyncCapabilityCache(Cache);
+
+    const int32 RequirementId = GetInstanceRequirementId(InstanceIndex);
+    if (!Cache.RequirementResults.IsValidIndex(RequirementId))
+    {
+        Cache.RequirementResults.SetNumZeroed(RequirementQueries.Num() + 1);
+    }
+
+    uint8& Result = Cache.RequirementResults[RequirementId];
+    if (Result == 0)
+    {
+        const FGameplayTagQuery& Requirements = RequirementId == 0 ? CollectorRequirements : RequirementQueries[RequirementId - 1];
+        FText Unused;
+        Result = CheckTagRequirements(Requirements, CollectorTags, Unused) ? 1 : 2;
+    }
+
+    if (Result == 2)
+    {
+        OutFailureReason = !RequirementsFailureMessage.IsEmpty()
+            ? RequirementsFailureMessage
+            : NSLOCTEXT("ISMResource", "TagRequirementsFailed", "You don't meet the requirements");
+        return false;
+    }
+
+    return ValidateCollectionRequirements(CollectorTags, InstanceIndex, OutFailureReason);
+}
+
+bool UISMResourceComponent::CheckInstanceCollectable(int32 InstanceIndex, FText& OutFailureReason) const
+{
+    // Validate instance
+    if (!IsValidInstanceIndex(InstanceIndex))
+    {
+        OutFailureReason = NSLOCTEXT("ISMResource", "InvalidInstance", "Invalid instance");
+        return false;
+    }
+
+    // Check if already destroyed or collected
+    if (IsInstanceDestroyed(InstanceIndex))
+    {
+        OutFailureReason = NSLOCTEXT("ISMResource", "AlreadyCollected", "Already collected");
+        return false;
+    }
+
+    // Check if currently being collected by someone else
+    if (IsInstanceBeingCollected(InstanceIndex))
+    {
+        OutFailureReason = NSLOCTEXT("ISMResource", "BeingCollected", "Someone else is collecting this");
+        return false;
+    }
+
+    return true;
+}
+
 bool UISMResourceComponent::StartCollection(int32 InstanceIndex, AActor* Collector, const FGameplayTagContainer& CollectorTags)
 {
     if (!Collector)
@@ -192,16 +295,26 @@ bool UISMResourceComponent::StartCollection(int32 InstanceIndex, AActor* Collect
         return true;
     }
 
-    // Create progress tracker
-    FResourceCollectionProgress& Progress = ActiveCollections.Add(InstanceIndex);
+    // Create progress tracker (replaces a paused one)
+    FResourceCollectionProgress* Existing = FindCollection(InstanceIndex);
+    if (!Existing)
+    {
+        CollectionSlots.Add(InstanceIndex, ActiveCollections.Num());
+        Existing = &ActiveCollections.AddDefaulted_GetRef();
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    FResourceCollectionProgress& Progress = *Existing;
+    Progress = FResourceCollectionProgress();
+    Progress.InstanceIndex = InstanceIndex;
     Progress.Collector = Collector;
-    Progress.Progress = 0.0f;
-    Progress.StartTime = GetWorld()->GetTimeSeconds();
+    Progress.StartTime = Now;
     Progress.RequiredTime = EffectiveTime;
-    Progress.CurrentStage = 0;
     Progress.CachedCollectorTags = CollectorTags;
-    Progress.bIsPaused = false;
-    Progress.PausedTime = 0.0f;
+    Progress.Serial = ++NextCollectionSerial;
+
+    ScheduleCollectionEvent(Progress);
+    UpdateCollectionTick(Now);
 
     // Call internal hook
     OnCollectionStartedInternal(InstanceIndex, Collector);
@@ -218,7 +331,7 @@ bool UISMResourceComponent::StartCollection(int32 InstanceIndex, AActor* Collect
 
 void UISMResourceComponent::CancelCollection(int32 InstanceIndex, bool bResetProgress)
 {
-    FResourceCollectionProgress* Progress = ActiveCollections.Find(InstanceIndex);
+    FResourceCollectionProgress* Progress = FindCollection(InstanceIndex);
     if (!Progress)
         return;
 
@@ -230,17 +343,19 @@ void UISMResourceComponent::CancelCollection(int32 InstanceIndex, bool bResetPro
     if (bShouldResetProgress)
     {
         // Remove from active collections
-        ActiveCollections.Remove(InstanceIndex);
+        RemoveCollection(InstanceIndex);
 
         UE_LOG(LogTemp, Verbose, TEXT("Collection cancelled on instance %d (progress reset)"), InstanceIndex);
     }
     else
     {
-        // Just pause it
+        // Just pause it; its scheduled events no longer match
+        Progress->PausedProgress = Progress->GetProgress(GetWorld()->GetTimeSeconds());
         Progress->bIsPaused = true;
+        Progress->Serial = ++NextCollectionSerial;
 
         UE_LOG(LogTemp, Verbose, TEXT("Collection paused on instance %d (progress: %.2f)"),
-            InstanceIndex, Progress->Progress);
+            InstanceIndex, Progress->PausedProgress);
     }
 
     // Call internal hook
@@ -255,8 +370,8 @@ void UISMResourceComponent::CompleteCollectionImmediately(int32 InstanceIndex, A
 {
     // Create temporary progress for completion
     FResourceCollectionProgress Progress;
+    Progress.InstanceIndex = InstanceIndex;
     Progress.Collector = Collector;
-    Progress.Progress = 1.0f;
     Progress.StartTime = GetWorld()->GetTimeSeconds();
     Progress.RequiredTime = 0.0f;
     Progress.CurrentStage = CollectionStages - 1;
@@ -267,19 +382,19 @@ void UISMResourceComponent::CompleteCollectionImmediately(int32 InstanceIndex, A
 
 bool UISMResourceComponent::IsInstanceBeingCollected(int32 InstanceIndex) const
 {
-    const FResourceCollectionProgress* Progress = ActiveCollections.Find(InstanceIndex);
+    const FResourceCollectionProgress* Progress = FindCollection(InstanceIndex);
     return Progress && !Progress->bIsPaused;
 }
 
 float UISMResourceComponent::GetCollectionProgress(int32 InstanceIndex) const
 {
-    const FResourceCollectionProgress* Progress = ActiveCollections.Find(InstanceIndex);
-    return Progress ? Progress->Progress : 0.0f;
+    const FResourceCollectionProgress* Progress = FindCollection(InstanceIndex);
+    return Progress ? Progress->GetProgress(GetWorld()->GetTimeSeconds()) : 0.0f;
 }
 
 AActor* UISMResourceComponent::GetCollector(int32 InstanceIndex) const
 {
-    const FResourceCollectionProgress* Progress = ActiveCollections.Find(InstanceIndex);
+    const FResourceCollectionProgress* Progress = FindCollection(InstanceIndex);
     return Progress ? Progress->Collector.Get() : nullptr;
 }
 
@@ -315,6 +430,41 @@ float UISMResourceComponent::CalculateYieldMultiplier(const FGameplayTagContaine
     return FMath::Max(Multiplier, 0.0f); // Prevent negative
 }
 
+float UISMResourceComponent::GetCachedSpeedMultiplier(const FGameplayTagContainer& CollectorTags, FISMCollectorCapabilityCache& Cache) const
+{
+    SyncCapabilityCache(Cache);
+    if (Cache.SpeedMultiplier < 0.0f)
+    {
+        Cache.SpeedMultiplier = CalculateSpeedMultiplier(CollectorTags);
+    }
+    return Cache.SpeedMultiplier;
+}
+
+float UISMResourceComponent::GetCachedYieldMultiplier(const FGameplayTagContainer& CollectorTags, FISMCollectorCapabilityCache& Cache) const
+{
+    SyncCapabilityCache(Cache);
+    if (Cache.YieldMultiplier < 0.0f)
+    {
+        Cache.YieldMultiplier = CalculateYieldMultiplier(CollectorTags);
+    }
+    return Cache.YieldMultiplier;
+}
+
+void UISMResourceComponent::NotifyRequirementsChanged()
+{
+    // Never 0, so a fresh cache is always out of date
+    RequirementsRevision = RequirementsRevision == MAX_uint32 ? 1 : RequirementsRevision + 1;
+}
+
+void UISMResourceComponent::SyncCapabilityCache(FISMCollectorCapabilityCache& Cache) const
+{
+    if (Cache.RequirementsRevision != RequirementsRevision)
+    {
+        Cache.Reset();
+        Cache.RequirementsRevision = RequirementsRevision;
+    }
+}
+
 float UISMResourceComponent::GetEffectiveCollectionTime(const FGameplayTagContainer& CollectorTags, int32 Stage) const
 {
     float BaseTime = BaseCollectionTime;
@@ -339,11 +489,50 @@ void UISMResourceComponent::SetInstanceRequirements(int32 InstanceIndex, const F
         return;
 
     PerInstanceRequirements.Add(InstanceIndex, Requirements);
+    InstanceRequirementIds.Add(InstanceIndex, FindOrAddRequirementQuery(Requirements));
 }
 
 void UISMResourceComponent::ClearInstanceRequirements(int32 InstanceIndex)
 {
     PerInstanceRequirements.Remove(InstanceIndex);
+    InstanceRequirementIds.Remove(InstanceIndex);
+}
+
+int32 UISMResourceComponent::GetInstanceRequirementId(int32 InstanceIndex) const
+{
+    if (PerInstanceRequirements.Num() == 0)
+    {
+        return 0;
+    }
+
+    // Overrides written straight into the map (subclasses, loads) are picked up here
+    if (InstanceRequirementIds.Num() != PerInstanceRequirements.Num())
+    {
+        RebuildRequirementIds();
+    }
+
+    const int32* Id = InstanceRequirementIds.Find(InstanceIndex);
+    return Id ? *Id : 0;
+}
+
+int32 UISMResourceComponent::FindOrAddRequirementQuery(const FGameplayTagQuery& Query) const
+{
+    // Few distinct overrides in practice, so a linear scan beats hashing queries
+    const int32 Existing = RequirementQueries.IndexOfByKey(Query);
+    return (Existing != INDEX_NONE ? Existing : RequirementQueries.Add(Query)) + 1;
+}
+
+void UISMResourceComponent::RebuildRequirementIds() const
+{
+    // Ids are renumbered, so results cached under the old ones are void
+    RequirementsRevision = RequirementsRevision == MAX_uint32 ? 1 : RequirementsRevision + 1;
+
+    RequirementQueries.Reset();
+    InstanceRequirementIds.Reset();
+    for (const TPair<int32, FGameplayTagQuery>& Pair : PerInstanceRequirements)
+    {
+        InstanceRequirementIds.Add(Pair.Key, FindOrAddRequirementQuery(Pair.Value));
+    }
 }
 
 FGameplayTagQuery UISMResourceComponent::GetInstanceRequirements(int32 InstanceIndex) const
@@ -390,42 +579,95 @@ void UISMResourceComponent::OnCollectionCancelledInternal_Implementation(int32 I
 
 // ===== Helper Functions =====
 
-void UISMResourceComponent::UpdateCollectionProgress(int32 InstanceIndex, FResourceCollectionProgress& Progress, float DeltaTime)
+FResourceCollectionProgress* UISMResourceComponent::FindCollection(int32 InstanceIndex)
 {
-    // Update progress
-    float OldProgress = Progress.Progress;
-    Progress.Progress += (DeltaTime / Progress.RequiredTime);
+    const int32* Slot = CollectionSlots.Find(InstanceIndex);
+    return Slot ? &ActiveCollections[*Slot] : nullptr;
+}
 
-    // Check for stage completion (multi-stage only)
-    if (CollectionStages > 1)
+const FResourceCollectionProgress* UISMResourceComponent::FindCollection(int32 InstanceIndex) const
+{
+    const int32* Slot = CollectionSlots.Find(InstanceIndex);
+    return Slot ? &ActiveCollections[*Slot] : nullptr;
+}
+
+void UISMResourceComponent::RemoveCollection(int32 InstanceIndex)
+{
+    int32 Slot = INDEX_NONE;
+    if (!CollectionSlots.RemoveAndCopyValue(InstanceIndex, Slot))
     {
-        float ProgressPerStage = 1.0f / CollectionStages;
-        int32 NewStage = FMath::FloorToInt(Progress.Progress / ProgressPerStage);
+        return;
+    }
 
-        if (NewStage > Progress.CurrentStage && NewStage < CollectionStages)
-        {
-            Progress.CurrentStage = NewStage;
-            OnCollectionStageCompleted(InstanceIndex, Progress.Collector.Get(), NewStage, CollectionStages);
+    ActiveCollections.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    if (ActiveCollections.IsValidIndex(Slot))
+    {
+        CollectionSlots.Add(ActiveCollections[Slot].InstanceIndex, Slot);
+    }
+}
 
-            UE_LOG(LogTemp, Verbose, TEXT("Collection stage %d/%d completed on instance %d"),
-                NewStage, CollectionStages, InstanceIndex);
+void UISMResourceComponent::ScheduleCollectionEvent(const FResourceCollectionProgress& Progress)
+{
+    // Next stage boundary, or completion once the last stage is running
+    const int32 NextStage = Progress.CurrentStage + 1;
+    const double Fraction = (CollectionStages > 1 && NextStage < CollectionStages)
+        ? static_cast<double>(NextStage) / CollectionStages
+        : 1.0;
+
+    FCollectionEvent Event;
+    Event.DueTime = Progress.StartTime + Progress.RequiredTime * Fraction;
+    Event.InstanceIndex = Progress.InstanceIndex;
+    Event.Serial = Progress.Serial;
+    CollectionEvents.HeapPush(Event, FEarlierCollectionEvent());
+}
+
+void UISMResourceComponent::AdvanceCollectionStage(FResourceCollectionProgress& Progress, float CurrentProgress)
+{
+    if (CollectionStages <= 1)
+    {
+        return;
+    }
+
+    float ProgressPerStage = 1.0f / CollectionStages;
+    int32 NewStage = FMath::FloorToInt(CurrentProgress / ProgressPerStage);
+
+    if (NewStage > Progress.CurrentStage && NewStage < CollectionStages)
+    {
+        Progress.CurrentStage = NewStage;
+        OnCollectionStageCompleted(Progress.InstanceIndex, Progress.Collector.Get(), NewStage, CollectionStages);
+
+        UE_LOG(LogTemp, Verbose, TEXT("Collection stage %d/%d completed on instance %d"),
+            NewStage, CollectionStages, Progress.InstanceIndex);
+    }
+}
+
+void UISMResourceComponent::UpdateCollectionTick(double Now)
+{
+    // The base component asked for its own ticking; keep it every frame
+    const bool bBaseWantsTick = !bEnableTickOptimization || TickInterval > 0.0f;
+
+    if (CollectionEvents.Num() == 0)
+    {
+        if (!bBaseWantsTick)
+        {
+            SetRuntimeTickEnabled(false);
         }
+        return;
     }
 
-    // Broadcast progress update (throttle to avoid spam)
-    static float LastProgressBroadcastTime = 0.0f;
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentTime - LastProgressBroadcastTime > 0.1f) // Update UI at most 10 times per second
+    float Interval = FMath::Max(static_cast<float>(CollectionEvents.HeapTop().DueTime - Now), 0.0f);
+    if (OnCollectionProgress.IsBound())
     {
-        FISMInstanceHandle Handle = GetInstanceHandle(InstanceIndex);
-        OnCollectionProgress.Broadcast(this, Handle, Progress.Collector.Get(), Progress.Progress);
-        LastProgressBroadcastTime = CurrentTime;
+        Interval = FMath::Min(Interval, ProgressBroadcastInterval);
     }
+
+    SetRuntimeTickInterval(bBaseWantsTick ? 0.0f : Interval);
+    SetRuntimeTickEnabled(true);
 }
 
 void UISMResourceComponent::FinalizeCollection(int32 InstanceIndex, FResourceCollectionProgress& Progress)
 {
-    // Build collection data
+    // Build collection data (Progress may live in ActiveCollections, which the hooks below can reshuffle)
     FResourceCollectionData CollectionData = BuildCollectionData(InstanceIndex, Progress);
 
     // Call internal hook
@@ -435,7 +677,7 @@ void UISMResourceComponent::FinalizeCollection(int32 InstanceIndex, FResourceCol
     DestroyInstance(InstanceIndex);
 
     // Remove from active collections
-    ActiveCollections.Remove(InstanceIndex);
+    RemoveCollection(InstanceIndex);
 
     // Broadcast events - THIS IS WHERE GAME LOGIC HAPPENS
     OnResourceCollected.Broadcast(this, CollectionData);
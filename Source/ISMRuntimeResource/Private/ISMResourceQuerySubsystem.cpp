@@ -0,0 +1,229 @@
+#include "ISMResourceQuerySubsystem.h"
+#include "ISMRuntimeResource.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMCollectorComponent.h"
+#include "ISMResourceComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "ISMSpatialIndex.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+bool UISMResourceQuerySubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UISMResourceQuerySubsystem::RegisterCollector(UISMCollectorComponent* Collector)
+{
+    if (!Collector)
+    {
+        return false;
+    }
+
+    if (Collector->SharedDetectionIndex == INDEX_NONE)
+    {
+        Collector->SharedDetectionIndex = Entries.Num();
+        FCollectorEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Collector = Collector;
+    }
+    return true;
+}
+
+void UISMResourceQuerySubsystem::UnregisterCollector(UISMCollectorComponent* Collector)
+{
+    if (!Collector || !Entries.IsValidIndex(Collector->SharedDetectionIndex) || Entries[Collector->SharedDetectionIndex].Collector.Get() != Collector)
+    {
+        return;
+    }
+
+    RemoveEntryAt(Collector->SharedDetectionIndex);
+}
+
+void UISMResourceQuerySubsystem::RemoveEntryAt(int32 Index)
+{
+    if (UISMCollectorComponent* Removed = Entries[Index].Collector.Get())
+    {
+        Removed->SharedDetectionIndex = INDEX_NONE;
+    }
+
+    Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Entries.IsValidIndex(Index))
+    {
+        if (UISMCollectorComponent* Moved = Entries[Index].Collector.Get())
+        {
+            Moved->SharedDetectionIndex = Index;
+        }
+    }
+}
+
+void UISMResourceQuerySubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMResourceQuerySubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Resource);
+
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    struct FDueCollector
+    {
+        UISMCollectorComponent* Collector;
+        FVector Location;
+        float Radius;
+    };
+    TArray<FDueCollector, TInlineAllocator<64>> Due;
+    FBox DueBounds(ForceInit);
+
+    // Pick the collectors due this frame; reversed so removing a destroyed collector never skips one
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+    {
+        FCollectorEntry& Entry = Entries[Index];
+        UISMCollectorComponent* Collector = Entry.Collector.Get();
+        if (!Collector)
+        {
+            RemoveEntryAt(Index);
+            continue;
+        }
+
+        const AActor* Owner = Collector->GetOwner();
+        if (!Owner || !Collector->IsUsingSharedDetection())
+        {
+            Entry.PendingDeltaTime = 0.0f;
+            continue;
+        }
+
+        Entry.PendingDeltaTime += DeltaTime;
+        if (Entry.PendingDeltaTime >= Collector->DetectionInterval)
+        {
+            Entry.PendingDeltaTime = 0.0f;
+
+            const FVector Location = Owner->GetActorLocation();
+            const float Radius = Collector->DetectionRadius;
+            Due.Add({ Collector, Location, Radius });
+            DueBounds += FBox(Location - FVector(Radius), Location + FVector(Radius));
+        }
+    }
+
+    if (Due.Num() == 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    UISMRuntimeSubsystem* RuntimeSubsystem = World ? World->GetSubsystem<UISMRuntimeSubsystem>() : nullptr;
+    if (!RuntimeSubsystem)
+    {
+        return;
+    }
+
+    struct FCandidate
+    {
+        int32 DueIdx;
+        int32 ComponentOrder;
+        int32 InstanceIndex;
+        float DistSquared;
+    };
+    TArray<FCandidate> Candidates;
+    TArray<UISMResourceComponent*> ResourceComponents;
+
+    // One batched sphere pass per resource component, over only the collectors that reach its bounds
+    TArray<FISMSpatialSphereQuery, TInlineAllocator<64>> Spheres;
+    TArray<int32, TInlineAllocator<64>> SphereDueIdx;
+    for (UISMRuntimeComponent* RuntimeComp : RuntimeSubsystem->GetAllComponents())
+    {
+        UISMResourceComponent* ResourceComp = Cast<UISMResourceComponent>(RuntimeComp);
+        if (!ResourceComp || !ResourceComp->IsISMInitialized())
+        {
+            continue;
+        }
+
+        const bool bHasBounds = ResourceComp->IsBoundsValid();
+        const FBox ComponentBounds = ResourceComp->GetInstanceBounds();
+        if (bHasBounds && !ComponentBounds.Intersect(DueBounds))
+        {
+            continue;
+        }
+
+        Spheres.Reset();
+        SphereDueIdx.Reset();
+        for (int32 DueIdx = 0; DueIdx < Due.Num(); DueIdx++)
+        {
+            const FDueCollector& Item = Due[DueIdx];
+            if (bHasBounds && ComponentBounds.ComputeSquaredDistanceToPoint(Item.Location) > FMath::Square(Item.Radius))
+            {
+                continue;
+            }
+            Spheres.Add({ Item.Location, Item.Radius });
+            SphereDueIdx.Add(DueIdx);
+        }
+
+        if (Spheres.Num() == 0)
+        {
+            continue;
+        }
+
+        const int32 ComponentOrder = ResourceComponents.Add(ResourceComp);
+        ResourceComp->ForEachInstanceInRadiusBatch(Spheres, [&](int32 LocalIdx, int32 InstanceIndex)
+            {
+                const int32 DueIdx = SphereDueIdx[LocalIdx];
+                const float DistSquared = FVector::DistSquared(Due[DueIdx].Location, ResourceComp->GetInstanceLocation(InstanceIndex));
+
+                // Same strict test as the per-collector path
+                if (DistSquared < FMath::Square(Due[DueIdx].Radius))
+                {
+                    Candidates.Add({ DueIdx, ComponentOrder, InstanceIndex, DistSquared });
+                }
+            });
+    }
+
+    // Per collector, nearest first; component order then index keeps ties deterministic
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+        {
+            if (A.DueIdx != B.DueIdx)
+            {
+                return A.DueIdx < B.DueIdx;
+            }
+            if (A.DistSquared != B.DistSquared)
+            {
+                return A.DistSquared < B.DistSquared;
+            }
+            if (A.ComponentOrder != B.ComponentOrder)
+            {
+                return A.ComponentOrder < B.ComponentOrder;
+            }
+            return A.InstanceIndex < B.InstanceIndex;
+        });
+
+    int32 CandidateIdx = 0;
+    for (int32 DueIdx = 0; DueIdx < Due.Num(); DueIdx++)
+    {
+        UISMCollectorComponent* Collector = Due[DueIdx].Collector;
+
+        FISMInstanceHandle BestHandle;
+        UISMResourceComponent* BestComp = nullptr;
+        for (; CandidateIdx < Candidates.Num() && Candidates[CandidateIdx].DueIdx == DueIdx; CandidateIdx++)
+        {
+            if (BestComp)
+            {
+                continue;
+            }
+
+            const FCandidate& Candidate = Candidates[CandidateIdx];
+            UISMResourceComponent* ResourceComp = ResourceComponents[Candidate.ComponentOrder];
+
+            const FISMInstanceHandle Handle = UISMRuntimeSubsystem::MakeInstanceReference(ResourceComp, Candidate.InstanceIndex);
+            if (IsValid(Collector) && Collector->ShouldConsiderInstance(Handle, ResourceComp))
+            {
+                BestHandle = Handle;
+                BestComp = ResourceComp;
+            }
+        }
+
+        // A previous collector's target change may have torn this one down
+        if (IsValid(Collector))
+        {
+            Collector->ApplyDetectedTarget(BestHandle, BestComp);
+        }
+    }
+}
@@ -0,0 +1,228 @@
+#include "ISMResourceRegrowthSubsystem.h"
+#include "ISMRuntimeResource.h"
+#include "ISMRuntimeProfiling.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMInstanceStateStore.h"
+#include "Engine/World.h"
+
+namespace
+{
+    struct FEarlierSlotTick
+    {
+        template <typename EntryType>
+        bool operator()(const EntryType& A, const EntryType& B) const { return A.SlotTick < B.SlotTick; }
+    };
+}
+
+bool UISMResourceRegrowthSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UISMResourceRegrowthSubsystem::ScheduleRegrowth(UISMRuntimeComponent* Component, int32 InstanceIndex, float Delay, EISMRegrowthMode Mode)
+{
+    if (!Component || !Component->IsValidInstanceIndex(InstanceIndex))
+    {
+        return;
+    }
+
+    FRegrowthEntry Entry;
+    Entry.Component = Component;
+    Entry.InstanceIndex = InstanceIndex;
+    Entry.Mode = Mode;
+
+    if (Mode == EISMRegrowthMode::Respawn)
+    {
+        // An already destroyed instance sits at zero scale; its pre-destroy transform is kept
+        Entry.Transform = Component->GetInstanceTransform(InstanceIndex);
+        if (Entry.Transform.GetScale3D() == FVector::ZeroVector)
+        {
+            if (const FTransform* LastVisible = Component->GetInstanceStateStore().GetLastVisibleTransform(InstanceIndex))
+            {
+                Entry.Transform = *LastVisible;
+            }
+        }
+    }
+
+    Schedule(MoveTemp(Entry), Delay);
+}
+
+void UISMResourceRegrowthSubsystem::ScheduleRespawnAt(UISMRuntimeComponent* Component, const FTransform& Transform, float Delay)
+{
+    if (!Component)
+    {
+        return;
+    }
+
+    FRegrowthEntry Entry;
+    Entry.Component = Component;
+    Entry.Transform = Transform;
+    Entry.Mode = EISMRegrowthMode::Respawn;
+    Schedule(MoveTemp(Entry), Delay);
+}
+
+int64 UISMResourceRegrowthSubsystem::GetCurrentTick() const
+{
+    const UWorld* World = GetWorld();
+    return World ? static_cast<int64>(FMath::FloorToDouble(World->GetTimeSeconds() / RegrowthSlotSeconds)) : 0;
+}
+
+void UISMResourceRegrowthSubsystem::Schedule(FRegrowthEntry&& Entry, float Delay)
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // Idle wheel: restart it at the current slot rather than walking the slots that passed meanwhile
+    if (NumPending == 0)
+    {
+        NextTick = GetCurrentTick();
+    }
+
+    // The slot whose window holds the deadline; it fires once that window has fully elapsed
+    const double Deadline = World->GetTimeSeconds() + FMath::Max(Delay, 0.0f);
+    Entry.SlotTick = static_cast<int64>(FMath::FloorToDouble(Deadline / RegrowthSlotSeconds));
+    Insert(MoveTemp(Entry));
+}
+
+void UISMResourceRegrowthSubsystem::Insert(FRegrowthEntry&& Entry)
+{
+    if (Slots.Num() == 0)
+    {
+        Slots.SetNum(RegrowthSlotCount);
+    }
+
+    Entry.SlotTick = FMath::Max(Entry.SlotTick, NextTick);
+    if (Entry.SlotTick < NextTick + RegrowthSlotCount)
+    {
+        Slots[Entry.SlotTick % RegrowthSlotCount].Add(MoveTemp(Entry));
+    }
+    else
+    {
+        Overflow.HeapPush(MoveTemp(Entry), FEarlierSlotTick());
+    }
+    ++NumPending;
+}
+
+void UISMResourceRegrowthSubsystem::Tick(float DeltaTime)
+{
+    ISM_TRACE_SCOPE(UISMResourceRegrowthSubsystem::Tick);
+    LLM_SCOPE_BYTAG(ISMRuntime_Resource);
+
+    if (NumPending == 0)
+    {
+        return;
+    }
+
+    // Slots before CurrentTick have fully elapsed. A hitch longer than the horizon drains each slot once.
+    const int64 CurrentTick = GetCurrentTick();
+    const int64 EndTick = FMath::Min(CurrentTick, NextTick + RegrowthSlotCount);
+
+    TArray<FRegrowthEntry> Due;
+    for (; NextTick < EndTick; ++NextTick)
+    {
+        TArray<FRegrowthEntry>& Slot = Slots[NextTick % RegrowthSlotCount];
+        if (Slot.Num() > 0)
+        {
+            Due.Append(MoveTemp(Slot));
+            Slot.Reset();
+        }
+    }
+    NextTick = FMath::Max(NextTick, CurrentTick);
+
+    // Far deadlines that came within the horizon move onto the wheel; any already past fire now
+    while (Overflow.Num() > 0 && Overflow.HeapTop().SlotTick < NextTick + RegrowthSlotCount)
+    {
+        FRegrowthEntry Entry;
+        Overflow.HeapPop(Entry, FEarlierSlotTick(), EAllowShrinking::No);
+        if (Entry.SlotTick < NextTick)
+        {
+            Due.Add(MoveTemp(Entry));
+        }
+        else
+        {
+            Slots[Entry.SlotTick % RegrowthSlotCount].Add(MoveTemp(Entry));
+        }
+    }
+
+    if (Due.Num() == 0)
+    {
+        return;
+    }
+
+    NumPending -= Due.Num();
+    FireEntries(Due);
+}
+
+void UISMResourceRegrowthSubsystem::FireEntries(TArray<FRegrowthEntry>& Due)
+{
+    struct FComponentGroup
+    {
+        UISMRuntimeComponent* Component = nullptr;
+        TArray<FTransform> RespawnTransforms;
+        TArray<int32> ShowIndices;
+    };
+    TArray<FComponentGroup> Groups;
+    TMap<UISMRuntimeComponent*, int32> GroupByComponent;
+
+    for (FRegrowthEntry& Entry : Due)
+    {
+        UISMRuntimeComponent* Component = Entry.Component.Get();
+        if (!Component || !Component->IsISMInitialized())
+        {
+            continue;
+        }
+
+        int32& GroupIdx = GroupByComponent.FindOrAdd(Component, INDEX_NONE);
+        if (GroupIdx == INDEX_NONE)
+        {
+            GroupIdx = Groups.AddDefaulted();
+            Groups[GroupIdx].Component = Component;
+        }
+
+        if (Entry.Mode == EISMRegrowthMode::Show)
+        {
+            Groups[GroupIdx].ShowIndices.Add(Entry.InstanceIndex);
+        }
+        else
+        {
+            Groups[GroupIdx].RespawnTransforms.Add(Entry.Transform);
+        }
+    }
+
+    // One add and one show per component, each raising a single batched feedback
+    TArray<int32> Regrown;
+    for (FComponentGroup& Group : Groups)
+    {
+        // Listeners of an earlier group may have torn this component down
+        if (!IsValid(Group.Component))
+        {
+            continue;
+        }
+
+        Regrown.Reset();
+        if (Group.RespawnTransforms.Num() > 0)
+        {
+            for (int32 Index : Group.Component->BatchAddInstances(Group.RespawnTransforms, true, true))
+            {
+                if (Index != INDEX_NONE)
+                {
+                    Regrown.Add(Index);
+                }
+            }
+        }
+
+        if (Group.ShowIndices.Num() > 0)
+        {
+            Group.Component->BatchShowInstances(Group.ShowIndices, true);
+            Regrown.Append(Group.ShowIndices);
+        }
+
+        if (Regrown.Num() > 0)
+        {
+            OnInstancesRegrownNative.Broadcast(Group.Component, Regrown);
+        }
+    }
+}
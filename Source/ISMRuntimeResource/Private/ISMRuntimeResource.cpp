@@ -1,5 +1,7 @@
 #include "ISMRuntimeResource.h"
 
+LLM_DEFINE_TAG(ISMRuntime_Resource);
+
 #define LOCTEXT_NAMESPACE "FISMRuntimeResourceModule"
 
 void FISMRuntimeResource::StartupModule()
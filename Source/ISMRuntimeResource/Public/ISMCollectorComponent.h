@@ -5,6 +5,7 @@
 #include "GameplayTagContainer.h"
 #include "Delegates/DelegateCombinations.h"
 #include "ISMInstanceHandle.h"
+#include "ISMResourceComponent.h"
 #include "ISMCollectorComponent.generated.h"
 
 // Forward declarations
@@ -100,6 +101,7 @@ public:
     // ===== Lifecycle =====
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     // ===== Detection Settings =====
@@ -116,6 +118,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Detection", meta = (ClampMin = "10.0", EditCondition = "DetectionMode == ECollectionDetectionMode::Radius"))
     float DetectionRadius = 200.0f;
 
+    /**
+     * Detect through UISMResourceQuerySubsystem, which batches every radius collector's query into one
+     * pass per resource component each frame. Picks the same target as detecting alone.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Detection", meta = (EditCondition = "DetectionMode == ECollectionDetectionMode::Radius"))
+    bool bUseSharedDetection = true;
+
     /** Trace channel for raycast detection */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Detection", meta = (EditCondition = "DetectionMode == ECollectionDetectionMode::Raycast"))
     TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
@@ -124,6 +133,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Detection", meta = (EditCondition = "DetectionMode == ECollectionDetectionMode::Raycast"))
     bool bTraceComplex = false;
 
+    /**
+     * Raycast against resource instance bounds through the ISM spatial grid instead of the physics scene.
+     * Much cheaper and works for instances without collision, but other geometry does not block the ray.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Detection", meta = (EditCondition = "DetectionMode == ECollectionDetectionMode::Raycast"))
+    bool bUseSpatialGridTrace = false;
+
     /** Camera component to use for raycast origin (auto-detected if null) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Detection", meta = (EditCondition = "DetectionMode == ECollectionDetectionMode::Raycast"))
     UCameraComponent* CameraComponent;
@@ -156,6 +172,15 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Tags")
     bool bOnlyDetectValidTargets = true;
 
+    /**
+     * Keep each resource component's requirement results and speed multiplier for this collector's
+     * tags, so validating a candidate is an array lookup. Dropped when tags change through
+     * AddCollectorTag / RemoveCollectorTag / SetCollectorTags. If GetCollectorTags is overridden to
+     * pull tags from elsewhere, call InvalidateCapabilityCache when they change (or turn this off).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection|Tags")
+    bool bCacheCapabilities = true;
+
     // ===== Input Integration =====
 
     /**
@@ -251,6 +276,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Collection|Tags")
     void SetCollectorTags(const FGameplayTagContainer& NewTags);
 
+    /**
+     * Forget cached collector tags and per-resource requirement results (see bCacheCapabilities).
+     */
+    UFUNCTION(BlueprintCallable, Category = "Collection|Tags")
+    void InvalidateCapabilityCache();
+
     // ===== Events =====
 
     /** Called when targeted instance changes (for UI updates) */
@@ -394,6 +425,16 @@ public:
     /** Auto-detected camera component */
     TWeakObjectPtr<UCameraComponent> CachedCamera;
 
+    /** GetCollectorTags result while bCacheCapabilities */
+    mutable TOptional<FGameplayTagContainer> CachedCollectorTags;
+
+    /** Per resource component results for CachedCollectorTags */
+    mutable TMap<TWeakObjectPtr<UISMResourceComponent>, FISMCollectorCapabilityCache> CapabilityCaches;
+
+    /** Index in UISMResourceQuerySubsystem while in the shared detection pass, INDEX_NONE otherwise */
+    int32 SharedDetectionIndex = INDEX_NONE;
+    friend class UISMResourceQuerySubsystem;
+
     // ===== Helper Functions =====
 
     /** Run detection to find nearby collectible instance */
@@ -402,9 +443,21 @@ public:
     /** Perform raycast detection */
     FISMInstanceHandle DetectViaRaycast();
 
+    /** Raycast detection through the resource components' spatial grids (bUseSpatialGridTrace) */
+    FISMInstanceHandle DetectViaGridTrace(const FVector& Start, const FVector& End);
+
     /** Perform radius detection */
     FISMInstanceHandle DetectViaRadius();
 
+    /** GetCollectorTags, cached while bCacheCapabilities */
+    const FGameplayTagContainer& GetEffectiveCollectorTags() const;
+
+    /** Registered with UISMResourceQuerySubsystem and still auto-detecting by radius */
+    bool IsUsingSharedDetection() const;
+
+    /** Take a detection result, from RunDetection or the shared pass */
+    void ApplyDetectedTarget(const FISMInstanceHandle& NewTarget, UISMResourceComponent* NewResourceComp);
+
     /** Update the current target */
     void UpdateTarget(const FISMInstanceHandle& NewTarget, UISMResourceComponent* NewResourceComp);
 
@@ -105,22 +105,23 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnResourceCollectionEvent,
     AActor*, Collector);
 
 /**
- * Tracks ongoing collection progress for an instance
+ * Tracks ongoing collection progress for an instance.
+ * Progress is not stored while running: it follows from StartTime and RequiredTime (see GetProgress).
  */
 USTRUCT()
 struct FResourceCollectionProgress
 {
     GENERATED_BODY()
     
+    /** Instance being collected */
+    int32 InstanceIndex = INDEX_NONE;
+    
     /** Who is collecting this instance */
     UPROPERTY()
     TWeakObjectPtr<AActor> Collector;
     
-    /** Progress (0-1) */
-    float Progress = 0.0f;
-    
-    /** Time when collection started */
-    float StartTime = 0.0f;
+    /** World time when collection started */
+    double StartTime = 0.0;
     
     /** Total time required (accounting for speed multipliers) */
     float RequiredTime = 0.0f;
@@ -134,8 +135,51 @@ struct FResourceCollectionProgress
     /** Is this collection paused? */
     bool bIsPaused = false;
     
+    /** Progress when paused */
+    float PausedProgress = 0.0f;
+    
     /** Time spent paused (to adjust completion time) */
     float PausedTime = 0.0f;
+    
+    /** Changes on every start and pause, so scheduled events of an earlier run are ignored */
+    uint32 Serial = 0;
+    
+    /** Progress (0-1) at world time Now */
+    float GetProgress(double Now) const
+    {
+        if (bIsPaused)
+        {
+            return PausedProgress;
+        }
+        return RequiredTime > 0.0f ? FMath::Min(static_cast<float>((Now - StartTime) / RequiredTime), 1.0f) : 1.0f;
+    }
+};
+
+/**
+ * One collector's evaluated requirements and multipliers for one resource component.
+ * Owned by the collector (see UISMCollectorComponent::bCacheCapabilities) and filled lazily by the
+ * component's cached queries. Reset it when the collector's tags change; the component drops stale
+ * results itself when its requirements or modifiers change (NotifyRequirementsChanged).
+ */
+struct FISMCollectorCapabilityCache
+{
+    /** Component requirements revision the results were evaluated against */
+    uint32 RequirementsRevision = 0;
+
+    /** Per requirement id: 0 = not evaluated yet, 1 = met, 2 = not met */
+    TArray<uint8> RequirementResults;
+
+    /** Negative until evaluated */
+    float SpeedMultiplier = -1.0f;
+    float YieldMultiplier = -1.0f;
+
+    void Reset()
+    {
+        RequirementsRevision = 0;
+        RequirementResults.Reset();
+        SpeedMultiplier = -1.0f;
+        YieldMultiplier = -1.0f;
+    }
 };
 
 /**
@@ -148,6 +192,10 @@ struct FResourceCollectionProgress
  * - Speed/yield multipliers based on collector tags
  * - Event-driven resource handling (spawn pickups, add to inventory, etc.)
  * - Progress tracking for ongoing collections
+ *
+ * Collections are evaluated from world time rather than accumulated per frame: the component only
+ * ticks while a collection runs, at the next stage boundary or completion (or every
+ * ProgressBroadcastInterval while OnCollectionProgress has listeners), and not at all when idle.
  * 
  * Philosophy:
  * This component manages WHEN and IF collection happens, but not WHAT happens.
@@ -164,7 +212,7 @@ public:
     // ===== Lifecycle =====
     
     virtual void BeginPlay() override;
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void TickRuntime(float DeltaTime) override;
     
     // ===== Resource Configuration =====
     
@@ -176,7 +224,7 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Resource|Tags")
     FGameplayTagContainer ResourceTags;
     
-    /** Requirements that collector must meet (tag query) */
+    /** Requirements that collector must meet (tag query). Call NotifyRequirementsChanged after changing it at runtime. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Resource|Requirements")
     FGameplayTagQuery CollectorRequirements;
     
@@ -206,6 +254,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Resource|Collection", meta=(EditCondition="CollectionStages > 1"))
     bool bDivideTimeAcrossStages = false;
     
+    /** Seconds between OnCollectionProgress broadcasts while collections run */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Resource|Collection", meta=(ClampMin="0.0"))
+    float ProgressBroadcastInterval = 0.1f;
+    
     // ===== Tag-Based Modifiers =====
     
     /** Speed multipliers based on collector tags (multiplicative) */
@@ -228,6 +280,17 @@ public:
     bool CanCollectorGatherInstance(const FGameplayTagContainer& CollectorTags,
                                     int32 InstanceIndex,
                                     FText& OutFailureReason) const;
+
+    /**
+     * CanCollectorGatherInstance with the requirement query result looked up in Cache.
+     * Each distinct requirement query is matched against CollectorTags once per cache, so repeated
+     * checks from one collector cost an array lookup plus the instance state checks and
+     * ValidateCollectionRequirements. CollectorTags must be the tags Cache was filled with.
+     */
+    bool CanCollectorGatherInstanceCached(const FGameplayTagContainer& CollectorTags,
+                                          int32 InstanceIndex,
+                                          FISMCollectorCapabilityCache& Cache,
+                                          FText& OutFailureReason) const;
     
     /**
      * Start collecting an instance.
@@ -290,6 +353,17 @@ public:
      */
     UFUNCTION(BlueprintPure, Category = "Resource|Modifiers")
     float CalculateYieldMultiplier(const FGameplayTagContainer& CollectorTags) const;
+
+    /** CalculateSpeedMultiplier / CalculateYieldMultiplier evaluated once per cache */
+    float GetCachedSpeedMultiplier(const FGameplayTagContainer& CollectorTags, FISMCollectorCapabilityCache& Cache) const;
+    float GetCachedYieldMultiplier(const FGameplayTagContainer& CollectorTags, FISMCollectorCapabilityCache& Cache) const;
+
+    /**
+     * Invalidate every collector's cached results for this component.
+     * Call after changing CollectorRequirements or the modifier maps at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Resource|Requirements")
+    void NotifyRequirementsChanged();
     
     /**
      * Get the effective collection time for an instance (accounting for speed modifiers).
@@ -398,18 +472,66 @@ protected:
     
     // ===== Internal State =====
     
-    /** Active collections (sparse - only instances being collected) */
+    /** Active and paused collections, dense (removal swaps the last one in) */
     UPROPERTY()
-    TMap<int32, FResourceCollectionProgress> ActiveCollections;
+    TArray<FResourceCollectionProgress> ActiveCollections;
+    
+    /** Instance index → slot in ActiveCollections */
+    TMap<int32, int32> CollectionSlots;
+    
+    /** A running collection's next stage boundary or completion */
+    struct FCollectionEvent
+    {
+        double DueTime = 0.0;
+        int32 InstanceIndex = INDEX_NONE;
+        uint32 Serial = 0;
+    };
+    
+    /** Min-heap on DueTime; entries whose serial no longer matches their collection are skipped */
+    TArray<FCollectionEvent> CollectionEvents;
+    
+    uint32 NextCollectionSerial = 0;
+    double LastProgressBroadcastTime = 0.0;
     
     /** Per-instance requirement overrides (sparse) */
     UPROPERTY()
     TMap<int32, FGameplayTagQuery> PerInstanceRequirements;
+
+    /**
+     * Distinct queries in PerInstanceRequirements; requirement id N > 0 is RequirementQueries[N - 1],
+     * id 0 is CollectorRequirements. Rebuilt from PerInstanceRequirements when their sizes disagree.
+     */
+    mutable TArray<FGameplayTagQuery> RequirementQueries;
+    mutable TMap<int32, int32> InstanceRequirementIds;
+
+    /** Bumped when requirements, modifiers or requirement ids change; collector caches from older revisions are discarded */
+    mutable uint32 RequirementsRevision = 1;
+
+    /** Requirement id of an instance's effective query */
+    int32 GetInstanceRequirementId(int32 InstanceIndex) const;
+    int32 FindOrAddRequirementQuery(const FGameplayTagQuery& Query) const;
+    void RebuildRequirementIds() const;
+
+    /** Drop Cache's results if they predate the current requirements revision */
+    void SyncCapabilityCache(FISMCollectorCapabilityCache& Cache) const;
+
+    /** Instance checks shared by the cached and uncached paths: valid, not destroyed, not being collected */
+    bool CheckInstanceCollectable(int32 InstanceIndex, FText& OutFailureReason) const;
     
     // ===== Helper Functions =====
     
-    /** Update a collection's progress (called from Tick) */
-    void UpdateCollectionProgress(int32 InstanceIndex, FResourceCollectionProgress& Progress, float DeltaTime);
+    FResourceCollectionProgress* FindCollection(int32 InstanceIndex);
+    const FResourceCollectionProgress* FindCollection(int32 InstanceIndex) const;
+    void RemoveCollection(int32 InstanceIndex);
+    
+    /** Queue a running collection's next stage boundary or completion */
+    void ScheduleCollectionEvent(const FResourceCollectionProgress& Progress);
+    
+    /** Fire the stage hook if Progress crossed a stage boundary (called when a scheduled event comes due) */
+    void AdvanceCollectionStage(FResourceCollectionProgress& Progress, float CurrentProgress);
+    
+    /** Tick only until the next scheduled event; off when nothing runs */
+    void UpdateCollectionTick(double Now);
     
     /** Complete a collection (called when progress reaches 1.0 or CompleteCollectionImmediately) */
     void FinalizeCollection(int32 InstanceIndex, FResourceCollectionProgress& Progress);
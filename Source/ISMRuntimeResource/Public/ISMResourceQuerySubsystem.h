@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ISMResourceQuerySubsystem.generated.h"
+
+class UISMCollectorComponent;
+
+/**
+ * Shared radius detection for collectors.
+ *
+ * Radius-mode collectors with bUseSharedDetection register here at BeginPlay and stop running their
+ * own detection. Each frame this subsystem takes the collectors whose DetectionInterval has elapsed
+ * and, per resource component, runs all of their spheres in one cell-sorted pass over its spatial
+ * index (UISMRuntimeComponent::ForEachInstanceInRadiusBatch), skipping components whose bounds no
+ * sphere reaches. Each collector's candidates are then tried nearest first through
+ * ShouldConsiderInstance, so the filter runs until the first accepted instance rather than on every
+ * instance in range, and the winner is handed back as the collector's target.
+ */
+UCLASS()
+class ISMRUNTIMERESOURCE_API UISMResourceQuerySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMResourceQuerySubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Add a collector to the shared pass. Returns false if it could not be added. */
+    bool RegisterCollector(UISMCollectorComponent* Collector);
+
+    /** Remove a collector from the shared pass; no-op if it is not registered */
+    void UnregisterCollector(UISMCollectorComponent* Collector);
+
+    /** Collectors in the shared pass */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Resource")
+    int32 GetNumCollectors() const { return Entries.Num(); }
+
+private:
+    struct FCollectorEntry
+    {
+        TWeakObjectPtr<UISMCollectorComponent> Collector;
+
+        /** Time since this collector's detection last ran */
+        float PendingDeltaTime = 0.0f;
+    };
+
+    /** Dense; each collector stores its index so removal is a swap */
+    TArray<FCollectorEntry> Entries;
+
+    void RemoveEntryAt(int32 Index);
+};
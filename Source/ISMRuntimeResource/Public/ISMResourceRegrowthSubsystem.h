@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ISMResourceRegrowthSubsystem.generated.h"
+
+class UISMRuntimeComponent;
+
+/**
+ * How a depleted instance comes back
+ */
+UENUM(BlueprintType)
+enum class EISMRegrowthMode : uint8
+{
+    /** The instance was destroyed; a new one is added at its transform (the slot may be recycled) */
+    Respawn,
+
+    /** The instance was hidden; it is shown again under the same index */
+    Show
+};
+
+/** Native event for instances brought back in one batch: (component, new or shown indices) */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInstancesRegrownNative,
+    UISMRuntimeComponent* /*Component*/,
+    TConstArrayView<int32> /*InstanceIndices*/);
+
+/**
+ * Deadline scheduler for depleted resource instances.
+ *
+ * Game code depletes an instance (DestroyInstance or HideInstance) and schedules its regrowth here
+ * instead of running a timer per instance. Deadlines go into a timing wheel of RegrowthSlotCount
+ * slots, RegrowthSlotSeconds each; deadlines past the wheel's horizon wait in a heap and move onto
+ * the wheel as it turns. Each frame only the slots that have fully elapsed are read, so pending
+ * regrowths cost nothing until due and a frame costs O(due).
+ *
+ * Due instances are grouped per component and brought back with one BatchAddInstances (Respawn)
+ * or BatchShowInstances (Show) call each, which raises one batched spawn or show feedback.
+ * Regrowths fire up to one slot late, never early.
+ */
+UCLASS()
+class ISMRUNTIMERESOURCE_API UISMResourceRegrowthSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UISMResourceRegrowthSubsystem, STATGROUP_Tickables);
+    }
+
+    virtual void Tick(float DeltaTime) override;
+
+    /**
+     * Bring an instance back Delay seconds from now.
+     * Respawn captures the instance's current transform, so schedule before destroying it (or use
+     * ScheduleRespawnAt). Show keeps the index; hide the instance yourself.
+     */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Resource")
+    void ScheduleRegrowth(UISMRuntimeComponent* Component, int32 InstanceIndex, float Delay, EISMRegrowthMode Mode = EISMRegrowthMode::Respawn);
+
+    /** Add a new instance at Transform (world space) Delay seconds from now */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Resource")
+    void ScheduleRespawnAt(UISMRuntimeComponent* Component, const FTransform& Transform, float Delay);
+
+    /** Regrowths not yet fired */
+    UFUNCTION(BlueprintCallable, Category = "ISM Runtime|Resource")
+    int32 GetNumPending() const { return NumPending; }
+
+    /** Fired once per component per frame with the instances that came back */
+    FOnInstancesRegrownNative OnInstancesRegrownNative;
+
+private:
+    static constexpr int32 RegrowthSlotCount = 1024;
+    static constexpr double RegrowthSlotSeconds = 0.1;
+
+    struct FRegrowthEntry
+    {
+        TWeakObjectPtr<UISMRuntimeComponent> Component;
+        FTransform Transform;
+        int64 SlotTick = 0;
+        int32 InstanceIndex = INDEX_NONE;
+        EISMRegrowthMode Mode = EISMRegrowthMode::Respawn;
+    };
+
+    /** Wheel slot SlotTick % RegrowthSlotCount holds the entries due in that slot's window */
+    TArray<TArray<FRegrowthEntry>> Slots;
+
+    /** Entries beyond the wheel's horizon, min-heap on SlotTick */
+    TArray<FRegrowthEntry> Overflow;
+
+    /** First slot tick not yet fired */
+    int64 NextTick = INDEX_NONE;
+
+    int32 NumPending = 0;
+
+    void Schedule(FRegrowthEntry&& Entry, float Delay);
+    void Insert(FRegrowthEntry&& Entry);
+    int64 GetCurrentTick() const;
+    void FireEntries(TArray<FRegrowthEntry>& Due);
+};
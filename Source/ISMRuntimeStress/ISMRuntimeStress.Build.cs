@@ -0,0 +1,36 @@
+// Copyright Max Harris
+
+using UnrealBuildTool;
+
+public class ISMRuntimeStress : ModuleRules
+{
+    public ISMRuntimeStress(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "ISMRuntimeCore",
+            }
+        );
+
+        // Scenarios drive the whole stack, so every gameplay module is a dependency
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "GameplayTags",
+                "Json",
+                "ISMRuntimePools",
+                "ISMRuntimePhysics",
+                "ISMRuntimeResource",
+                "ISMRuntimeAnimation",
+                "ISMRuntimeInteraction",
+                "ISMRuntimePCGInterop",
+            }
+        );
+    }
+}
@@ -0,0 +1,15 @@
+#include "ISMRuntimeStress.h"
+
+#define LOCTEXT_NAMESPACE "FISMRuntimeStressModule"
+
+void FISMRuntimeStress::StartupModule()
+{
+}
+
+void FISMRuntimeStress::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FISMRuntimeStress, ISMRuntimeStress)
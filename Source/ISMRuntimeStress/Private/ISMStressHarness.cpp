@@ -0,0 +1,447 @@
+// ISMStressHarness.cpp
+#include "ISMStressHarness.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+
+#include "ISMRuntimeComponent.h"
+#include "ISMRuntimeSubsystem.h"
+#include "Batching/ISMBatchScheduler.h"
+#include "CustomData/ISMCustomDataSubsystem.h"
+#include "ISMRuntimePoolSubsystem.h"
+
+namespace ISMStress
+{
+    /** Percentiles shorter than this are too noisy to compare against a baseline */
+    constexpr double MinComparableMs = 0.5;
+
+    const TCHAR* const ComparedPercentiles[] = { TEXT("p50_frame_ms"), TEXT("p90_frame_ms"), TEXT("p99_frame_ms") };
+
+    FString GetReportDir()
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("ISMStress"));
+    }
+
+    FString GetBaselineDir()
+    {
+        FString Dir;
+        if (!FParse::Value(FCommandLine::Get(), TEXT("ISMStressBaselineDir="), Dir))
+        {
+            Dir = FPaths::Combine(GetReportDir(), TEXT("Baseline"));
+        }
+        return Dir;
+    }
+
+    // ============================================================
+    //  FConfig
+    // ============================================================
+
+    FConfig FConfig::FromCommandLine()
+    {
+        FConfig Config;
+        FParse::Value(FCommandLine::Get(), TEXT("ISMStressScale="), Config.Scale);
+        FParse::Value(FCommandLine::Get(), TEXT("ISMStressFrames="), Config.NumFrames);
+        Config.Scale = FMath::Max(Config.Scale, 0.01f);
+        Config.NumFrames = FMath::Max(Config.NumFrames, 1);
+
+        FString MeshPath;
+        if (FParse::Value(FCommandLine::Get(), TEXT("ISMStressMesh="), MeshPath))
+        {
+            Config.Mesh = LoadObject<UStaticMesh>(nullptr, *MeshPath);
+        }
+        return Config;
+    }
+
+    // ============================================================
+    //  FStressWorld
+    // ============================================================
+
+    FStressWorld::FStressWorld(const FConfig& InConfig)
+        : Config(InConfig)
+    {
+        // A game instance of our own, so game instance subsystems (the DMI pools) exist
+        GameInstance = NewObject<UGameInstance>(GEngine, NAME_None, RF_Transient);
+        GameInstance->AddToRoot();
+        GameInstance->InitializeStandalone();
+
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.OwningGameInstance = GameInstance;
+        WorldContext.SetCurrentWorld(World);
+        World->SetGameInstance(GameInstance);
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+
+        Subsystem = World->GetSubsystem<UISMRuntimeSubsystem>();
+    }
+
+    FStressWorld::~FStressWorld()
+    {
+        if (World)
+        {
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+        }
+        if (GameInstance)
+        {
+            GameInstance->Shutdown();
+            GameInstance->RemoveFromRoot();
+        }
+    }
+
+    AActor* FStressWorld::SpawnActor(const FVector& Location)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags = RF_Transient;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location), SpawnParams);
+        check(Actor);
+        if (!Actor->GetRootComponent())
+        {
+            USceneComponent* Root = NewObject<USceneComponent>(Actor, NAME_None, RF_Transient);
+            Actor->SetRootComponent(Root);
+            Actor->AddInstanceComponent(Root);
+            Root->RegisterComponent();
+            Root->SetWorldLocation(Location);
+        }
+        return Actor;
+    }
+
+    AActor* FStressWorld::SpawnFieldOwner(const TArray<FTransform>& Transforms, UInstancedStaticMeshComponent*& OutISM)
+    {
+        AActor* Owner = SpawnActor();
+
+        OutISM = NewObject<UInstancedStaticMeshComponent>(Owner, NAME_None, RF_Transient);
+        if (Config.Mesh)
+        {
+            OutISM->SetStaticMesh(Config.Mesh);
+        }
+        OutISM->SetupAttachment(Owner->GetRootComponent());
+        Owner->AddInstanceComponent(OutISM);
+        OutISM->RegisterComponent();
+        OutISM->AddInstances(Transforms, false, true);
+        return Owner;
+    }
+
+    void FStressWorld::RegisterField(AActor* Owner, UISMRuntimeComponent* Component)
+    {
+        Owner->AddInstanceComponent(Component);
+        Component->RegisterComponent();
+        if (!Component->IsISMInitialized())
+        {
+            Component->InitializeInstances();
+        }
+    }
+
+    void FStressWorld::Tick(float DeltaSeconds)
+    {
+        // The engine loop would advance the frame number; change tracking and frame gates key off it
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, DeltaSeconds);
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    }
+
+    // ============================================================
+    //  FReport
+    // ============================================================
+
+    double FReport::Percentile(double FFrameSample::* Field, double Percent) const
+    {
+        if (Frames.Num() == 0)
+        {
+            return 0.0;
+        }
+
+        TArray<double> Values;
+        Values.Reserve(Frames.Num());
+        for (const FFrameSample& Frame : Frames)
+        {
+            Values.Add(Frame.*Field);
+        }
+        Values.Sort();
+
+        const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Percent / 100.0 * Values.Num()) - 1, 0, Values.Num() - 1);
+        return Values[Rank];
+    }
+
+    double FReport::Mean(double FFrameSample::* Field) const
+    {
+        double Sum = 0.0;
+        for (const FFrameSample& Frame : Frames)
+        {
+            Sum += Frame.*Field;
+        }
+        return Frames.Num() > 0 ? Sum / Frames.Num() : 0.0;
+    }
+
+    // ============================================================
+    //  Run
+    // ============================================================
+
+    namespace
+    {
+        void SampleSystems(const FStressWorld& World, FFrameSample& Sample, FReport& Report)
+        {
+            UISMRuntimeSubsystem* Subsystem = World.GetSubsystem();
+
+            const FISMFrameBudgetStats Budget = Subsystem->GetFrameBudgetStats();
+            Sample.ISMGameThreadMs = Budget.UsedMs;
+
+            if (const UISMBatchSchedulerBase* Scheduler = Subsystem->GetBatchScheduler())
+            {
+                const FISMBatchSchedulerStats SchedulerStats = Scheduler->GetSchedulerStats();
+                Sample.SchedulerDispatchMs = SchedulerStats.LastDispatchTimeMs;
+                Sample.SchedulerApplyMs = SchedulerStats.LastApplyTimeMs;
+                Sample.InFlightChunks = SchedulerStats.InFlightChunkCount;
+                Sample.QueuedChunks = SchedulerStats.QueuedChunkCount;
+            }
+
+            const FISMRuntimeStats RuntimeStats = Subsystem->GetRuntimeStats();
+            Report.PeakISMMemoryBytes = FMath::Max(Report.PeakISMMemoryBytes, RuntimeStats.TotalMemoryBytes);
+            Report.NumInstances = FMath::Max(Report.NumInstances, RuntimeStats.TotalInstanceCount);
+
+            const int64 UsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+            Report.PeakUsedPhysicalBytes = FMath::Max(Report.PeakUsedPhysicalBytes, UsedPhysical);
+
+            if (const UISMRuntimePoolSubsystem* Pools = World.GetWorld()->GetSubsystem<UISMRuntimePoolSubsystem>())
+            {
+                const FISMGlobalPoolStats PoolStats = Pools->GetGlobalStats();
+                Report.PeakActivePoolActors = FMath::Max(Report.PeakActivePoolActors, PoolStats.TotalActiveActors);
+                Report.PoolActorsSpawned = PoolStats.TotalActorsSpawned;
+                Report.PoolLeakedActors = PoolStats.TotalLeakedActors;
+                Report.PoolBudgetEvictions = PoolStats.BudgetEvictions;
+            }
+
+            const UGameInstance* GameInstance = World.GetWorld()->GetGameInstance();
+            if (const UISMCustomDataSubsystem* CustomData = GameInstance ? GameInstance->GetSubsystem<UISMCustomDataSubsystem>() : nullptr)
+            {
+                const FISMDMIPoolStats Shared = CustomData->GetSharedPoolStats();
+                const FISMHotPoolStats Hot = CustomData->GetHotPoolStats();
+                Report.bHasDMIStats = true;
+                Report.PooledDMIs = Shared.TotalPooledDMIs;
+                Report.DMICacheHits = Shared.CacheHits;
+                Report.DMICacheMisses = Shared.CacheMisses;
+                Report.PeakActiveHotDMIs = FMath::Max(Report.PeakActiveHotDMIs, Hot.ActiveHotDMIs);
+                Report.HotDMIFallbacks = Hot.TransientFallbackCount;
+            }
+        }
+    }
+
+    bool Run(FScenario& Scenario, const FConfig& Config, FAutomationTestBase& Test, FReport& OutReport)
+    {
+        OutReport = FReport();
+        OutReport.Scenario = Scenario.GetName();
+
+        const int64 StartPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+        FStressWorld World(Config);
+        if (!World.GetSubsystem())
+        {
+            Test.AddError(TEXT("Stress world has no ISM runtime subsystem"));
+            return false;
+        }
+
+        const double SetupStart = FPlatformTime::Seconds();
+        if (!Scenario.Setup(World, Config, Test))
+        {
+            return false;
+        }
+
+        // One settling frame so BeginPlay work and first-frame registration stay out of the samples
+        World.Tick(Config.DeltaSeconds);
+        OutReport.SetupMs = (FPlatformTime::Seconds() - SetupStart) * 1000.0;
+
+        OutReport.Frames.Reserve(Config.NumFrames);
+        for (int32 Frame = 0; Frame < Config.NumFrames; ++Frame)
+        {
+            FFrameSample& Sample = OutReport.Frames.AddDefaulted_GetRef();
+
+            const double FrameStart = FPlatformTime::Seconds();
+            Scenario.Drive(World, Frame, Config.DeltaSeconds);
+            World.Tick(Config.DeltaSeconds);
+            Sample.FrameMs = (FPlatformTime::Seconds() - FrameStart) * 1000.0;
+
+            SampleSystems(World, Sample, OutReport);
+        }
+
+        OutReport.PhysicalGrowthBytes = OutReport.PeakUsedPhysicalBytes - StartPhysical;
+        Scenario.GetCounters(OutReport.Counters);
+        return true;
+    }
+
+    // ============================================================
+    //  Reports
+    // ============================================================
+
+    namespace
+    {
+        TSharedRef<FJsonObject> MakeReportJson(const FReport& Report)
+        {
+            const auto ToMB = [](int64 Bytes) { return static_cast<double>(Bytes) / (1024.0 * 1024.0); };
+
+            TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+            Json->SetStringField(TEXT("scenario"), Report.Scenario);
+            Json->SetNumberField(TEXT("instances"), Report.NumInstances);
+            Json->SetNumberField(TEXT("frames"), Report.Frames.Num());
+            Json->SetNumberField(TEXT("setup_ms"), Report.SetupMs);
+
+            Json->SetNumberField(TEXT("mean_frame_ms"), Report.Mean(&FFrameSample::FrameMs));
+            Json->SetNumberField(TEXT("p50_frame_ms"), Report.Percentile(&FFrameSample::FrameMs, 50.0));
+            Json->SetNumberField(TEXT("p90_frame_ms"), Report.Percentile(&FFrameSample::FrameMs, 90.0));
+            Json->SetNumberField(TEXT("p99_frame_ms"), Report.Percentile(&FFrameSample::FrameMs, 99.0));
+            Json->SetNumberField(TEXT("max_frame_ms"), Report.Max(&FFrameSample::FrameMs));
+
+            Json->SetNumberField(TEXT("mean_ism_game_thread_ms"), Report.Mean(&FFrameSample::ISMGameThreadMs));
+            Json->SetNumberField(TEXT("p99_ism_game_thread_ms"), Report.Percentile(&FFrameSample::ISMGameThreadMs, 99.0));
+            Json->SetNumberField(TEXT("mean_scheduler_dispatch_ms"), Report.Mean(&FFrameSample::SchedulerDispatchMs));
+            Json->SetNumberField(TEXT("mean_scheduler_apply_ms"), Report.Mean(&FFrameSample::SchedulerApplyMs));
+
+            int32 PeakInFlight = 0;
+            int32 PeakQueued = 0;
+            for (const FFrameSample& Frame : Report.Frames)
+            {
+                PeakInFlight = FMath::Max(PeakInFlight, Frame.InFlightChunks);
+                PeakQueued = FMath::Max(PeakQueued, Frame.QueuedChunks);
+            }
+            Json->SetNumberField(TEXT("peak_in_flight_chunks"), PeakInFlight);
+            Json->SetNumberField(TEXT("peak_queued_chunks"), PeakQueued);
+
+            Json->SetNumberField(TEXT("peak_used_physical_mb"), ToMB(Report.PeakUsedPhysicalBytes));
+            Json->SetNumberField(TEXT("physical_growth_mb"), ToMB(Report.PhysicalGrowthBytes));
+            Json->SetNumberField(TEXT("peak_ism_memory_mb"), ToMB(Report.PeakISMMemoryBytes));
+
+            Json->SetNumberField(TEXT("peak_active_pool_actors"), Report.PeakActivePoolActors);
+            Json->SetNumberField(TEXT("pool_actors_spawned"), Report.PoolActorsSpawned);
+            Json->SetNumberField(TEXT("pool_leaked_actors"), Report.PoolLeakedActors);
+            Json->SetNumberField(TEXT("pool_budget_evictions"), Report.PoolBudgetEvictions);
+
+            if (Report.bHasDMIStats)
+            {
+                Json->SetNumberField(TEXT("pooled_dmis"), Report.PooledDMIs);
+                Json->SetNumberField(TEXT("dmi_cache_hits"), Report.DMICacheHits);
+                Json->SetNumberField(TEXT("dmi_cache_misses"), Report.DMICacheMisses);
+                Json->SetNumberField(TEXT("peak_active_hot_dmis"), Report.PeakActiveHotDMIs);
+                Json->SetNumberField(TEXT("hot_dmi_fallbacks"), Report.HotDMIFallbacks);
+            }
+
+            TSharedRef<FJsonObject> Counters = MakeShared<FJsonObject>();
+            for (const TPair<FString, double>& Counter : Report.Counters)
+            {
+                Counters->SetNumberField(Counter.Key, Counter.Value);
+            }
+            Json->SetObjectField(TEXT("counters"), Counters);
+            return Json;
+        }
+
+        FString SerializeJson(const TSharedRef<FJsonObject>& Json)
+        {
+            FString Out;
+            const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+            FJsonSerializer::Serialize(Json, Writer);
+            return Out;
+        }
+    }
+
+    void WriteReport(const FReport& Report, FAutomationTestBase& Test)
+    {
+        Test.AddInfo(FString::Printf(TEXT("%s: %d instances, %d frames, frame ms p50 %.2f / p90 %.2f / p99 %.2f / max %.2f"),
+            *Report.Scenario, Report.NumInstances, Report.Frames.Num(),
+            Report.Percentile(&FFrameSample::FrameMs, 50.0), Report.Percentile(&FFrameSample::FrameMs, 90.0),
+            Report.Percentile(&FFrameSample::FrameMs, 99.0), Report.Max(&FFrameSample::FrameMs)));
+        Test.AddInfo(FString::Printf(TEXT("%s: ISM game thread %.2fms mean, scheduler dispatch %.2fms / apply %.2fms mean"),
+            *Report.Scenario, Report.Mean(&FFrameSample::ISMGameThreadMs),
+            Report.Mean(&FFrameSample::SchedulerDispatchMs), Report.Mean(&FFrameSample::SchedulerApplyMs)));
+        Test.AddInfo(FString::Printf(TEXT("%s: peak ISM memory %.1f MB, physical growth %.1f MB, peak %d pooled actors active (%d spawned, %d leaked)"),
+            *Report.Scenario, Report.PeakISMMemoryBytes / (1024.0 * 1024.0), Report.PhysicalGrowthBytes / (1024.0 * 1024.0),
+            Report.PeakActivePoolActors, Report.PoolActorsSpawned, Report.PoolLeakedActors));
+        for (const TPair<FString, double>& Counter : Report.Counters)
+        {
+            Test.AddInfo(FString::Printf(TEXT("%s: %s %.0f"), *Report.Scenario, *Counter.Key, Counter.Value));
+        }
+
+        FString Csv = TEXT("Frame,FrameMs,ISMGameThreadMs,DispatchMs,ApplyMs,InFlightChunks,QueuedChunks\n");
+        for (int32 Frame = 0; Frame < Report.Frames.Num(); ++Frame)
+        {
+            const FFrameSample& Sample = Report.Frames[Frame];
+            Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%.3f,%d,%d\n"), Frame, Sample.FrameMs, Sample.ISMGameThreadMs,
+                Sample.SchedulerDispatchMs, Sample.SchedulerApplyMs, Sample.InFlightChunks, Sample.QueuedChunks);
+        }
+
+        const FString Json = SerializeJson(MakeReportJson(Report));
+        const FString BaseName = FPaths::Combine(GetReportDir(), Report.Scenario);
+        if (!FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json"))) ||
+            !FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".frames.csv"))))
+        {
+            Test.AddWarning(FString::Printf(TEXT("Could not write stress report to %s"), *GetReportDir()));
+        }
+    }
+
+    void CompareToBaseline(const FReport& Report, FAutomationTestBase& Test)
+    {
+        const FString BaselinePath = FPaths::Combine(GetBaselineDir(), Report.Scenario + TEXT(".json"));
+        const TSharedRef<FJsonObject> Current = MakeReportJson(Report);
+
+        if (FParse::Param(FCommandLine::Get(), TEXT("ISMStressUpdateBaseline")))
+        {
+            if (!FFileHelper::SaveStringToFile(SerializeJson(Current), *BaselinePath))
+            {
+                Test.AddWarning(FString::Printf(TEXT("Could not write stress baseline %s"), *BaselinePath));
+            }
+            return;
+        }
+
+        FString BaselineText;
+        TSharedPtr<FJsonObject> Baseline;
+        if (!FFileHelper::LoadFileToString(BaselineText, *BaselinePath)
+            || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline) || !Baseline.IsValid())
+        {
+            Test.AddInfo(FString::Printf(TEXT("%s: no baseline in %s, run with -ISMStressUpdateBaseline to record one"), *Report.Scenario, *GetBaselineDir()));
+            return;
+        }
+
+        // A baseline recorded at another scale or length measures a different load
+        double BaselineInstances = 0.0;
+        if (Baseline->TryGetNumberField(TEXT("instances"), BaselineInstances) && FMath::RoundToInt32(BaselineInstances) != Report.NumInstances)
+        {
+            Test.AddWarning(FString::Printf(TEXT("%s: baseline has %d instances, this run %d; not comparing"),
+                *Report.Scenario, FMath::RoundToInt32(BaselineInstances), Report.NumInstances));
+            return;
+        }
+
+        float Tolerance = 0.25f;
+        FParse::Value(FCommandLine::Get(), TEXT("ISMStressTolerance="), Tolerance);
+
+        for (const TCHAR* Field : ComparedPercentiles)
+        {
+            double BaselineMs = 0.0;
+            const double CurrentMs = Current->GetNumberField(Field);
+            if (!Baseline->TryGetNumberField(Field, BaselineMs) || BaselineMs <= 0.0 || CurrentMs < MinComparableMs)
+            {
+                continue;
+            }
+
+            const double Ratio = CurrentMs / BaselineMs;
+            if (Ratio > 1.0 + Tolerance)
+            {
+                Test.AddError(FString::Printf(TEXT("%s %s regressed: %.2fms against a %.2fms baseline (%.0f%% slower, tolerance %.0f%%)"),
+                    *Report.Scenario, Field, CurrentMs, BaselineMs, (Ratio - 1.0) * 100.0, Tolerance * 100.0f));
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+// ISMStressHarness.h
+// Frame loop, measurements and reports shared by the scripted load scenarios in ISMStressScenarios.cpp.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+
+class FAutomationTestBase;
+class UGameInstance;
+class UInstancedStaticMeshComponent;
+class UISMRuntimeComponent;
+class UISMRuntimeSubsystem;
+class UStaticMesh;
+
+namespace ISMStress
+{
+    /**
+     * Run settings, from the command line:
+     *   -ISMStressScale=<Factor>      multiplies every scenario's instance and actor counts (default 1)
+     *   -ISMStressFrames=<N>          frames to run each scenario for (default 300)
+     *   -ISMStressMesh=<ObjectPath>   static mesh for every field, so rendering and collision cost is included
+     */
+    struct FConfig
+    {
+        float Scale = 1.0f;
+        int32 NumFrames = 300;
+        float DeltaSeconds = 1.0f / 60.0f;
+        UStaticMesh* Mesh = nullptr;
+
+        static FConfig FromCommandLine();
+
+        int32 Scaled(int32 BaseCount) const { return FMath::Max(FMath::RoundToInt32(BaseCount * Scale), 1); }
+    };
+
+    /** Game world with a game instance (for the DMI pools) that ticks like a played level */
+    class FStressWorld
+    {
+    public:
+        explicit FStressWorld(const FConfig& InConfig);
+        ~FStressWorld();
+
+        UWorld* GetWorld() const { return World; }
+        UISMRuntimeSubsystem* GetSubsystem() const { return Subsystem; }
+
+        AActor* SpawnActor(const FVector& Location = FVector::ZeroVector);
+
+        /**
+         * Spawn an actor holding an ISM with Transforms and a runtime component of class T,
+         * configured before registration so BeginPlay sees the settings.
+         */
+        template<typename T>
+        T* SpawnField(const TArray<FTransform>& Transforms, TFunctionRef<void(T&)> Configure)
+        {
+            UInstancedStaticMeshComponent* ISM = nullptr;
+            AActor* Owner = SpawnFieldOwner(Transforms, ISM);
+            T* Component = NewObject<T>(Owner, NAME_None, RF_Transient);
+            Component->ManagedISMComponent = ISM;
+            Configure(*Component);
+            RegisterField(Owner, Component);
+            return Component;
+        }
+
+        /** One frame: drive inputs, tick the world, drain game thread tasks */
+        void Tick(float DeltaSeconds);
+
+    private:
+        AActor* SpawnFieldOwner(const TArray<FTransform>& Transforms, UInstancedStaticMeshComponent*& OutISM);
+        void RegisterField(AActor* Owner, UISMRuntimeComponent* Component);
+
+        const FConfig& Config;
+        UWorld* World = nullptr;
+        UGameInstance* GameInstance = nullptr;
+        UISMRuntimeSubsystem* Subsystem = nullptr;
+    };
+
+    /** A scripted load: builds its content once, then drives it every frame */
+    class FScenario
+    {
+    public:
+        virtual ~FScenario() = default;
+
+        virtual const TCHAR* GetName() const = 0;
+
+        /** @return false (after logging) when the content could not be built */
+        virtual bool Setup(FStressWorld& World, const FConfig& Config, FAutomationTestBase& Test) = 0;
+
+        /** Called before the world ticks on every frame */
+        virtual void Drive(FStressWorld& World, int32 Frame, float DeltaSeconds) = 0;
+
+        /** Scenario-specific totals for the report (conversions, harvests, selections) */
+        virtual void GetCounters(TMap<FString, double>& OutCounters) const {}
+    };
+
+    struct FFrameSample
+    {
+        /** Drive, world tick and game thread task drain */
+        double FrameMs = 0.0;
+
+        /** Game thread time the ISMRuntime systems reported to the frame budget governor */
+        double ISMGameThreadMs = 0.0;
+
+        double SchedulerDispatchMs = 0.0;
+        double SchedulerApplyMs = 0.0;
+
+        /** Async batch chunks on worker threads when the frame ended */
+        int32 InFlightChunks = 0;
+        int32 QueuedChunks = 0;
+    };
+
+    struct FReport
+    {
+        FString Scenario;
+        int32 NumInstances = 0;
+        double SetupMs = 0.0;
+        TArray<FFrameSample> Frames;
+
+        int64 PeakUsedPhysicalBytes = 0;
+        int64 PhysicalGrowthBytes = 0;
+        int64 PeakISMMemoryBytes = 0;
+
+        int32 PeakActivePoolActors = 0;
+        int32 PoolActorsSpawned = 0;
+        int32 PoolLeakedActors = 0;
+        int32 PoolBudgetEvictions = 0;
+
+        bool bHasDMIStats = false;
+        int32 PooledDMIs = 0;
+        int32 DMICacheHits = 0;
+        int32 DMICacheMisses = 0;
+        int32 PeakActiveHotDMIs = 0;
+        int32 HotDMIFallbacks = 0;
+
+        TMap<FString, double> Counters;
+
+        /** Percentile (0-100) of a per-frame measurement */
+        double Percentile(double FFrameSample::* Field, double Percent) const;
+        double Mean(double FFrameSample::* Field) const;
+        double Max(double FFrameSample::* Field) const { return Percentile(Field, 100.0); }
+    };
+
+    /** Set the scenario up in a fresh world and run it for Config.NumFrames */
+    bool Run(FScenario& Scenario, const FConfig& Config, FAutomationTestBase& Test, FReport& OutReport);
+
+    /** Log the report and write Saved/Automation/ISMStress/<Scenario>.json and <Scenario>.frames.csv */
+    void WriteReport(const FReport& Report, FAutomationTestBase& Test);
+
+    /**
+     * Compare frame time percentiles with <BaselineDir>/<Scenario>.json:
+     *   -ISMStressBaselineDir=<Dir>   (default Saved/Automation/ISMStress/Baseline)
+     *   -ISMStressTolerance=<Ratio>   allowed slowdown (default 0.25)
+     *   -ISMStressUpdateBaseline      write this run as the new baseline instead
+     */
+    void CompareToBaseline(const FReport& Report, FAutomationTestBase& Test);
+}
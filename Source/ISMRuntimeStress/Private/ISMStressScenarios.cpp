@@ -0,0 +1,583 @@
+// ISMStressScenarios.cpp
+// Scripted production-scale loads that exercise the whole plugin stack at once - the complement of
+// the per-operation benchmarks in ISMRuntimeCoreTests (ISMCoreBenchmarks.cpp):
+//   MassExplosion     : repeated radial explosions queuing physics conversions and ballistic debris
+//   Collectors        : 64 moving collectors detecting and harvesting a resource field
+//   FullFieldWind     : CPU wind animation on every instance of a large field, gusting and veering
+//   PCGRegeneration   : a tile of a columnar-packet round trip (read, jitter, destroy, respawn) per frame
+//   Selection         : box selection of ~10k instances, replaced every frame
+//
+// Each scenario runs ISMStress::FConfig::NumFrames frames of a fixed 60Hz step in its own game world
+// and reports frame time percentiles, ISM game thread time against scheduler and worker load, memory
+// peaks and pool/DMI stats (see ISMStressHarness.h for the command line and report files).
+// Worker threads are not timed directly; capture an Insights trace (-trace=cpu,task) for that split.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Math/RandomStream.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+#include "ISMStressHarness.h"
+#include "ISMRuntimeComponent.h"
+#include "ISMQueryFilter.h"
+#include "ISMCompiledQueryFilter.h"
+#include "ISMPhysicsComponent.h"
+#include "ISMPhysicsDataAsset.h"
+#include "ISMPhysicsActor.h"
+#include "ISMResourceComponent.h"
+#include "ISMResourceDataAsset.h"
+#include "ISMCollectorComponent.h"
+#include "ISMAnimationComponent.h"
+#include "ISMAnimationDataAsset.h"
+#include "ISMWindFieldSubsystem.h"
+#include "ISMPCGBridge.h"
+#include "ISMPCGColumnarPacket.h"
+#include "ISMSelectionSet.h"
+
+namespace ISMStress
+{
+    constexpr int32 Seed = 4242;
+
+    /** Jittered square grid of Count instances centred on the origin */
+    TArray<FTransform> MakeField(int32 Count, float Spacing, FRandomStream& Stream)
+    {
+        const int32 Side = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Count)));
+        const float HalfExtent = 0.5f * Side * Spacing;
+
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(Count);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            const FVector Location(
+                (i % Side) * Spacing - HalfExtent + Stream.FRandRange(-0.3f, 0.3f) * Spacing,
+                (i / Side) * Spacing - HalfExtent + Stream.FRandRange(-0.3f, 0.3f) * Spacing,
+                0.0f);
+            Transforms.Add(FTransform(FRotator(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f), Location));
+        }
+        return Transforms;
+    }
+
+    /** Bucket a field into TilesPerSide x TilesPerSide tiles by location, one component each */
+    TArray<TArray<FTransform>> SplitIntoTiles(const TArray<FTransform>& Transforms, int32 TilesPerSide)
+    {
+        FBox Bounds(ForceInit);
+        for (const FTransform& Transform : Transforms)
+        {
+            Bounds += Transform.GetLocation();
+        }
+        const FVector Size = Bounds.GetSize().ComponentMax(FVector(1.0));
+
+        TArray<TArray<FTransform>> Tiles;
+        Tiles.SetNum(TilesPerSide * TilesPerSide);
+        for (const FTransform& Transform : Transforms)
+        {
+            const FVector Location = Transform.GetLocation();
+            const int32 X = FMath::Clamp(FMath::FloorToInt32((Location.X - Bounds.Min.X) / Size.X * TilesPerSide), 0, TilesPerSide - 1);
+            const int32 Y = FMath::Clamp(FMath::FloorToInt32((Location.Y - Bounds.Min.Y) / Size.Y * TilesPerSide), 0, TilesPerSide - 1);
+            Tiles[Y * TilesPerSide + X].Add(Transform);
+        }
+        return Tiles;
+    }
+
+    template<typename AssetType>
+    AssetType* LoadAssetOverride(const TCHAR* Param)
+    {
+        FString Path;
+        return FParse::Value(FCommandLine::Get(), Param, Path) ? LoadObject<AssetType>(nullptr, *Path) : nullptr;
+    }
+
+    // ============================================================
+    //  MassExplosion
+    // ============================================================
+
+    /**
+     * Explosions every half second, each queuing every instance in its radius for conversion.
+     * Near debris becomes pooled physics actors (bounded by the components' limiters), far debris
+     * flies ballistic lite on the batch scheduler. -ISMStressPhysicsData=<ObjectPath> swaps in a
+     * project physics asset for the transient default.
+     */
+    class FMassExplosionScenario : public FScenario
+    {
+    public:
+        virtual const TCHAR* GetName() const override { return TEXT("MassExplosion"); }
+
+        virtual bool Setup(FStressWorld& World, const FConfig& Config, FAutomationTestBase& Test) override
+        {
+            UISMPhysicsDataAsset* PhysicsData = LoadAssetOverride<UISMPhysicsDataAsset>(TEXT("ISMStressPhysicsData="));
+            if (!PhysicsData)
+            {
+                PhysicsData = NewObject<UISMPhysicsDataAsset>(GetTransientPackage());
+                PhysicsData->PooledActorClass = AISMPhysicsActor::StaticClass();
+            }
+
+            FRandomStream Stream(Seed);
+            const TArray<FTransform> Field = MakeField(Config.Scaled(40000), 250.0f, Stream);
+            for (const TArray<FTransform>& Tile : SplitIntoTiles(Field, 2))
+            {
+                Components.Add(World.SpawnField<UISMPhysicsComponent>(Tile, [PhysicsData](UISMPhysicsComponent& Component)
+                    {
+                        Component.PhysicsData = PhysicsData;
+                    }));
+            }
+
+            Centers.Reserve(16);
+            for (int32 i = 0; i < 16; ++i)
+            {
+                Centers.Add(Field[Stream.RandHelper(Field.Num())].GetLocation());
+            }
+            return true;
+        }
+
+        virtual void Drive(FStressWorld& World, int32 Frame, float DeltaSeconds) override
+        {
+            int32 ActiveActors = 0;
+            int32 Ballistic = 0;
+            for (UISMPhysicsComponent* Component : Components)
+            {
+                ActiveActors += Component->GetActivePhysicsActorCount();
+                Ballistic += Component->GetBallisticInstanceCount();
+            }
+            PeakActiveActors = FMath::Max(PeakActiveActors, ActiveActors);
+            PeakBallistic = FMath::Max(PeakBallistic, Ballistic);
+
+            if (Frame % ExplosionInterval != 0)
+            {
+                return;
+            }
+
+            const FVector Center = Centers[(Frame / ExplosionInterval) % Centers.Num()];
+            for (UISMPhysicsComponent* Component : Components)
+            {
+                const TArray<int32> Indices = Component->GetInstancesInRadius(Center, ExplosionRadius);
+                Queued += Component->QueueConversions(Indices, Center, ExplosionForce);
+            }
+            ++Explosions;
+        }
+
+        virtual void GetCounters(TMap<FString, double>& OutCounters) const override
+        {
+            OutCounters.Add(TEXT("Explosions"), Explosions);
+            OutCounters.Add(TEXT("QueuedConversions"), Queued);
+            OutCounters.Add(TEXT("PeakPhysicsActors"), PeakActiveActors);
+            OutCounters.Add(TEXT("PeakBallisticInstances"), PeakBallistic);
+        }
+
+    private:
+        static constexpr int32 ExplosionInterval = 30;
+        static constexpr float ExplosionRadius = 2500.0f;
+        static constexpr float ExplosionForce = 5000.0f;
+
+        TArray<UISMPhysicsComponent*> Components;
+        TArray<FVector> Centers;
+        int32 Explosions = 0;
+        int32 Queued = 0;
+        int32 PeakActiveActors = 0;
+        int32 PeakBallistic = 0;
+    };
+
+    // ============================================================
+    //  Collectors
+    // ============================================================
+
+    /**
+     * 64 collectors on radius detection walk circles through a resource field and start a timed
+     * harvest whenever they have a target. -ISMStressResourceData=<ObjectPath> swaps in a project
+     * resource asset.
+     */
+    class FCollectorsScenario : public FScenario
+    {
+    public:
+        virtual const TCHAR* GetName() const override { return TEXT("Collectors"); }
+
+        virtual bool Setup(FStressWorld& World, const FConfig& Config, FAutomationTestBase& Test) override
+        {
+            UISMResourceDataAsset* ResourceData = LoadAssetOverride<UISMResourceDataAsset>(TEXT("ISMStressResourceData="));
+            if (!ResourceData)
+            {
+                ResourceData = NewObject<UISMResourceDataAsset>(GetTransientPackage());
+                ResourceData->BaseCollectionTime = 0.5f;
+            }
+
+            FRandomStream Stream(Seed);
+            const TArray<FTransform> Field = MakeField(Config.Scaled(20000), 300.0f, Stream);
+            FieldRadius = 0.5f * FMath::Sqrt(static_cast<float>(Field.Num())) * 300.0f;
+
+            for (const TArray<FTransform>& Tile : SplitIntoTiles(Field, 2))
+            {
+                UISMResourceComponent* Resource = World.SpawnField<UISMResourceComponent>(Tile, [ResourceData](UISMResourceComponent& Component)
+                    {
+                        Component.ResourceData = ResourceData;
+                    });
+                Resource->OnResourceCollectedNative.AddLambda([this](UISMResourceComponent*, const FResourceCollectionData&)
+                    {
+                        ++Harvests;
+                    });
+            }
+
+            const int32 NumCollectors = Config.Scaled(64);
+            for (int32 i = 0; i < NumCollectors; ++i)
+            {
+                FWalker& Walker = Walkers.AddDefaulted_GetRef();
+                Walker.PathRadius = Stream.FRandRange(0.1f, 0.9f) * FieldRadius;
+                Walker.Phase = Stream.FRandRange(0.0f, UE_TWO_PI);
+                Walker.Actor = World.SpawnActor(PathLocation(Walker, 0.0f));
+
+                UISMCollectorComponent* Collector = NewObject<UISMCollectorComponent>(Walker.Actor, NAME_None, RF_Transient);
+                Collector->DetectionMode = ECollectionDetectionMode::Radius;
+                Collector->DetectionRadius = 400.0f;
+                Collector->CollectionMode = ECollectionMode::Timed;
+                Walker.Actor->AddInstanceComponent(Collector);
+                Collector->RegisterComponent();
+                Walker.Collector = Collector;
+            }
+            return true;
+        }
+
+        virtual void Drive(FStressWorld& World, int32 Frame, float DeltaSeconds) override
+        {
+            const float Time = Frame * DeltaSeconds;
+            int32 Collecting = 0;
+            for (const FWalker& Walker : Walkers)
+            {
+                Walker.Actor->SetActorLocation(PathLocation(Walker, Time));
+                if (Walker.Collector->IsCollecting())
+                {
+                    ++Collecting;
+                }
+                else if (Walker.Collector->HasValidTarget())
+                {
+                    Walker.Collector->StartInteraction();
+                    ++Started;
+                }
+            }
+            PeakCollecting = FMath::Max(PeakCollecting, Collecting);
+        }
+
+        virtual void GetCounters(TMap<FString, double>& OutCounters) const override
+        {
+            OutCounters.Add(TEXT("Collectors"), Walkers.Num());
+            OutCounters.Add(TEXT("HarvestsStarted"), Started);
+            OutCounters.Add(TEXT("HarvestsCompleted"), Harvests);
+            OutCounters.Add(TEXT("PeakCollecting"), PeakCollecting);
+        }
+
+    private:
+        struct FWalker
+        {
+            AActor* Actor = nullptr;
+            UISMCollectorComponent* Collector = nullptr;
+            float PathRadius = 0.0f;
+            float Phase = 0.0f;
+        };
+
+        /** Walking pace, along each collector's circle */
+        static constexpr float Speed = 300.0f;
+
+        FVector PathLocation(const FWalker& Walker, float Time) const
+        {
+            const float Angle = Walker.Phase + Time * Speed / FMath::Max(Walker.PathRadius, 1.0f);
+            return FVector(FMath::Cos(Angle) * Walker.PathRadius, FMath::Sin(Angle) * Walker.PathRadius, 90.0f);
+        }
+
+        TArray<FWalker> Walkers;
+        float FieldRadius = 0.0f;
+        int32 Started = 0;
+        int32 Harvests = 0;
+        int32 PeakCollecting = 0;
+    };
+
+    // ============================================================
+    //  FullFieldWind
+    // ============================================================
+
+    /** CPU-backend sway on every instance (no distance limit) driven by the gusting wind field */
+    class FFullFieldWindScenario : public FScenario
+    {
+    public:
+        virtual const TCHAR* GetName() const override { return TEXT("FullFieldWind"); }
+
+        virtual bool Setup(FStressWorld& World, const FConfig& Config, FAutomationTestBase& Test) override
+        {
+            UISMAnimationDataAsset* AnimationData = LoadAssetOverride<UISMAnimationDataAsset>(TEXT("ISMStressAnimationData="));
+            if (!AnimationData)
+            {
+                AnimationData = NewObject<UISMAnimationDataAsset>(GetTransientPackage());
+                AnimationData->MaxAnimationDistance = -1.0f;
+                FISMAnimationLayer& Sway = AnimationData->Layers.AddDefaulted_GetRef();
+                Sway.Amplitude = 5.0f;
+                Sway.Frequency = 0.5f;
+                Sway.WindInfluence = 1.0f;
+                Sway.bApplyAsRotation = true;
+            }
+
+            FRandomStream Stream(Seed);
+            const TArray<FTransform> Field = MakeField(Config.Scaled(100000), 150.0f, Stream);
+            for (const TArray<FTransform>& Tile : SplitIntoTiles(Field, 4))
+            {
+                UISMRuntimeComponent* Runtime = World.SpawnField<UISMRuntimeComponent>(Tile, [](UISMRuntimeComponent&) {});
+
+                UISMAnimationComponent* Animation = NewObject<UISMAnimationComponent>(Runtime->GetOwner(), NAME_None, RF_Transient);
+                Animation->TargetISM = Runtime->ManagedISMComponent;
+                Animation->AnimationData = AnimationData;
+                Animation->bUseWindField = true;
+                Animation->bUseCameraAsReferenceLocation = false;
+                Runtime->GetOwner()->AddInstanceComponent(Animation);
+                Animation->RegisterComponent();
+                Animations.Add(Animation);
+            }
+
+            WindField = World.GetWorld()->GetSubsystem<UISMWindFieldSubsystem>();
+            if (!WindField)
+            {
+                Test.AddError(TEXT("FullFieldWind: no wind field subsystem in the stress world"));
+                return false;
+            }
+            return true;
+        }
+
+        virtual void Drive(FStressWorld& World, int32 Frame, float DeltaSeconds) override
+        {
+            // Veer slowly and surge, so the field rebuilds and every instance's sway changes
+            const float Time = Frame * DeltaSeconds;
+            const FVector Direction(FMath::Cos(Time * 0.2f), FMath::Sin(Time * 0.2f), 0.0f);
+            WindField->SetWind(Direction, 1.0f + 0.5f * FMath::Sin(Time * 1.3f));
+
+            int32 Animated = 0;
+            for (const UISMAnimationComponent* Animation : Animations)
+            {
+                Animated += Animation->GetLastAnimatedInstanceCount();
+            }
+            AnimatedInstanceFrames += Animated;
+            PeakAnimated = FMath::Max(PeakAnimated, Animated);
+            ++NumFrames;
+        }
+
+        virtual void GetCounters(TMap<FString, double>& OutCounters) const override
+        {
+            OutCounters.Add(TEXT("PeakAnimatedInstances"), PeakAnimated);
+            OutCounters.Add(TEXT("MeanAnimatedInstances"), NumFrames > 0 ? static_cast<double>(AnimatedInstanceFrames) / NumFrames : 0.0);
+        }
+
+    private:
+        TArray<UISMAnimationComponent*> Animations;
+        UISMWindFieldSubsystem* WindField = nullptr;
+        int64 AnimatedInstanceFrames = 0;
+        int32 PeakAnimated = 0;
+        int32 NumFrames = 0;
+    };
+
+    // ============================================================
+    //  PCGRegeneration
+    // ============================================================
+
+    /**
+     * Regenerates one tile per frame the way a runtime PCG pass replaces its output: export the
+     * tile to a columnar packet, move the points, destroy the old instances and spawn the packet
+     * back. Graph execution itself needs project content, so this drives the bridge directly.
+     */
+    class FPCGRegenerationScenario : public FScenario
+    {
+    public:
+        virtual const TCHAR* GetName() const override { return TEXT("PCGRegeneration"); }
+
+        virtual bool Setup(FStressWorld& World, const FConfig& Config, FAutomationTestBase& Test) override
+        {
+            FRandomStream FieldStream(Seed);
+            const TArray<FTransform> Field = MakeField(Config.Scaled(50000), 200.0f, FieldStream);
+            for (const TArray<FTransform>& Tile : SplitIntoTiles(Field, 4))
+            {
+                Components.Add(World.SpawnField<UISMRuntimeComponent>(Tile, [](UISMRuntimeComponent&) {}));
+            }
+            return true;
+        }
+
+        virtual void Drive(FStressWorld& World, int32 Frame, float DeltaSeconds) override
+        {
+            UISMRuntimeComponent* Component = Components[Frame % Components.Num()];
+
+            FISMPCGColumnarPacket Packet = UISMPCGBridge::ReadInstancesToColumnarPacket(Component, FISMQueryFilter());
+            for (FTransform& Transform : Packet.Transforms)
+            {
+                Transform.AddToTranslation(FVector(Stream.FRandRange(-50.0f, 50.0f), Stream.FRandRange(-50.0f, 50.0f), 0.0f));
+            }
+
+            TArray<int32> Live;
+            Live.Reserve(Component->GetInstanceCount());
+            for (int32 InstanceIndex = 0; InstanceIndex < Component->GetInstanceCount(); ++InstanceIndex)
+            {
+                if (!Component->IsInstanceDestroyed(InstanceIndex))
+                {
+                    Live.Add(InstanceIndex);
+                }
+            }
+            Component->BatchDestroyInstances(Live);
+
+            Respawned += UISMPCGBridge::SpawnInstancesFromColumnarPacket(Packet, Component).Num();
+            ++Regenerations;
+        }
+
+        virtual void GetCounters(TMap<FString, double>& OutCounters) const override
+        {
+            OutCounters.Add(TEXT("Regenerations"), Regenerations);
+            OutCounters.Add(TEXT("InstancesRespawned"), static_cast<double>(Respawned));
+        }
+
+    private:
+        TArray<UISMRuntimeComponent*> Components;
+        FRandomStream Stream{ Seed + 1 };
+        int32 Regenerations = 0;
+        int64 Respawned = 0;
+    };
+
+    // ============================================================
+    //  Selection
+    // ============================================================
+
+    /** A drag box over ~10k instances, replacing the selection every frame and clearing it now and then */
+    class FSelectionScenario : public FScenario
+    {
+    public:
+        virtual const TCHAR* GetName() const override { return TEXT("Selection"); }
+
+        virtual bool Setup(FStressWorld& World, const FConfig& Config, FAutomationTestBase& Test) override
+        {
+            // A quarter of the field falls in the box
+            FRandomStream Stream(Seed);
+            const int32 NumInstances = Config.Scaled(40000);
+            const TArray<FTransform> Field = MakeField(NumInstances, 200.0f, Stream);
+            for (const TArray<FTransform>& Tile : SplitIntoTiles(Field, 4))
+            {
+                World.SpawnField<UISMRuntimeComponent>(Tile, [](UISMRuntimeComponent&) {});
+            }
+            HalfBox = 0.25f * FMath::Sqrt(static_cast<float>(NumInstances)) * 200.0f;
+
+            AActor* Selector = World.SpawnActor();
+            Selection = NewObject<UISMSelectionSet>(Selector, NAME_None, RF_Transient);
+            Selector->AddInstanceComponent(Selection);
+            Selection->RegisterComponent();
+
+            Filter = FISMQueryFilter().Compile();
+            return true;
+        }
+
+        virtual void Drive(FStressWorld& World, int32 Frame, float DeltaSeconds) override
+        {
+            if (Frame % ClearInterval == ClearInterval - 1)
+            {
+                Selection->ClearSelection();
+                return;
+            }
+
+            // Sweep the box back and forth across the field's middle
+            const float Offset = FMath::Sin(Frame * 0.1f) * HalfBox;
+            const FVector Center(Offset, 0.0f, 0.0f);
+            Selection->SelectInstancesInBox(FBox(Center - FVector(HalfBox, HalfBox, 1000.0f), Center + FVector(HalfBox, HalfBox, 1000.0f)),
+                Filter, EISMSelectionMode::Replace);
+
+            SelectedTotal += Selection->GetSelectionCount();
+            PeakSelected = FMath::Max(PeakSelected, Selection->GetSelectionCount());
+            ++Selections;
+        }
+
+        virtual void GetCounters(TMap<FString, double>& OutCounters) const override
+        {
+            OutCounters.Add(TEXT("Selections"), Selections);
+            OutCounters.Add(TEXT("PeakSelected"), PeakSelected);
+            OutCounters.Add(TEXT("MeanSelected"), Selections > 0 ? static_cast<double>(SelectedTotal) / Selections : 0.0);
+        }
+
+    private:
+        static constexpr int32 ClearInterval = 15;
+
+        UISMSelectionSet* Selection = nullptr;
+        FISMCompiledQueryFilter Filter;
+        float HalfBox = 0.0f;
+        int64 SelectedTotal = 0;
+        int32 PeakSelected = 0;
+        int32 Selections = 0;
+    };
+
+    // ============================================================
+    //  Registry
+    // ============================================================
+
+    using FScenarioFactory = TUniquePtr<FScenario>(*)();
+
+    struct FScenarioEntry
+    {
+        const TCHAR* Name;
+        FScenarioFactory Create;
+    };
+
+    template<typename T>
+    TUniquePtr<FScenario> MakeScenario() { return MakeUnique<T>(); }
+
+    const FScenarioEntry Scenarios[] =
+    {
+        { TEXT("MassExplosion"),   &MakeScenario<FMassExplosionScenario> },
+        { TEXT("Collectors"),      &MakeScenario<FCollectorsScenario> },
+        { TEXT("FullFieldWind"),   &MakeScenario<FFullFieldWindScenario> },
+        { TEXT("PCGRegeneration"), &MakeScenario<FPCGRegenerationScenario> },
+        { TEXT("Selection"),       &MakeScenario<FSelectionScenario> },
+    };
+
+    bool RunScenario(FAutomationTestBase& Test, const FString& Parameters)
+    {
+        const FScenarioEntry* Entry = nullptr;
+        for (const FScenarioEntry& Candidate : Scenarios)
+        {
+            if (Parameters == Candidate.Name)
+            {
+                Entry = &Candidate;
+                break;
+            }
+        }
+        if (!Entry)
+        {
+            Test.AddError(FString::Printf(TEXT("Unknown stress scenario '%s'"), *Parameters));
+            return false;
+        }
+
+        const FConfig Config = FConfig::FromCommandLine();
+        TUniquePtr<FScenario> Scenario = Entry->Create();
+
+        FReport Report;
+        if (!Run(*Scenario, Config, Test, Report))
+        {
+            return false;
+        }
+
+        WriteReport(Report, Test);
+        CompareToBaseline(Report, Test);
+        return true;
+    }
+}
+
+
+// ============================================================
+//  Stress runs
+// ============================================================
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(
+    FISMRuntime_Stress,
+    "ISMRuntime.Stress",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::StressFilter)
+
+void FISMRuntime_Stress::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const ISMStress::FScenarioEntry& Entry : ISMStress::Scenarios)
+    {
+        OutBeautifiedNames.Add(Entry.Name);
+        OutTestCommands.Add(Entry.Name);
+    }
+}
+
+bool FISMRuntime_Stress::RunTest(const FString& Parameters)
+{
+    return ISMStress::RunScenario(*this, Parameters);
+}
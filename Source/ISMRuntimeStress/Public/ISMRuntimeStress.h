@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Modules/ModuleManager.h"
+
+class FISMRuntimeStress : public IModuleInterface
+{
+public:
+    virtual void StartupModule() override;
+    virtual void ShutdownModule() override;
+};